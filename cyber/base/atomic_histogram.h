@@ -0,0 +1,133 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_BASE_ATOMIC_HISTOGRAM_H_
+#define CYBER_BASE_ATOMIC_HISTOGRAM_H_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace apollo {
+namespace cyber {
+namespace base {
+
+/**
+ * @class AtomicHistogram
+ * @brief Log-linear histogram of unsigned values, in the spirit of HDR
+ * histograms: every power of two range is split into kSubBuckets linear
+ * buckets, so a recorded value is off by at most 1/kSubBuckets. Record() is
+ * wait-free and can be called from any thread; readers see relaxed values.
+ */
+class AtomicHistogram {
+ public:
+  static constexpr uint32_t kSubBucketBits = 4;
+  static constexpr uint32_t kSubBuckets = 1 << kSubBucketBits;
+  // values at or above 2^kMaxBits are counted in the last bucket
+  static constexpr uint32_t kMaxBits = 48;
+  static constexpr size_t kBucketNum =
+      (kMaxBits - kSubBucketBits + 1) * kSubBuckets;
+
+  AtomicHistogram() { Reset(); }
+
+  void Record(uint64_t value) {
+    buckets_[BucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    sum_.fetch_add(value, std::memory_order_relaxed);
+    auto max = max_.load(std::memory_order_relaxed);
+    while (value > max &&
+           !max_.compare_exchange_weak(max, value, std::memory_order_relaxed)) {
+    }
+  }
+
+  uint64_t Count() const { return count_.load(std::memory_order_relaxed); }
+  uint64_t Sum() const { return sum_.load(std::memory_order_relaxed); }
+  uint64_t Max() const { return max_.load(std::memory_order_relaxed); }
+  uint64_t Mean() const {
+    auto count = Count();
+    return count == 0 ? 0 : Sum() / count;
+  }
+
+  /**
+   * @brief Smallest bucket bound under which `percentile` (0 to 100) percent
+   * of the recorded values fall, capped at Max().
+   */
+  uint64_t Percentile(double percentile) const {
+    auto count = Count();
+    if (count == 0) {
+      return 0;
+    }
+    auto target = static_cast<uint64_t>(percentile / 100.0 * count + 0.5);
+    target = target == 0 ? 1 : target;
+    uint64_t seen = 0;
+    for (size_t i = 0; i < kBucketNum; ++i) {
+      seen += buckets_[i].load(std::memory_order_relaxed);
+      if (seen >= target) {
+        auto bound = BucketUpperBound(i);
+        auto max = Max();
+        return bound < max ? bound : max;
+      }
+    }
+    return Max();
+  }
+
+  void Reset() {
+    for (auto& bucket : buckets_) {
+      bucket.store(0, std::memory_order_relaxed);
+    }
+    count_.store(0, std::memory_order_relaxed);
+    sum_.store(0, std::memory_order_relaxed);
+    max_.store(0, std::memory_order_relaxed);
+  }
+
+  static size_t BucketIndex(uint64_t value) {
+    if (value < kSubBuckets) {
+      return static_cast<size_t>(value);
+    }
+    uint32_t msb = 63 - __builtin_clzll(value);
+    if (msb >= kMaxBits) {
+      return kBucketNum - 1;
+    }
+    uint32_t shift = msb - kSubBucketBits;
+    auto sub = static_cast<size_t>(value >> shift) - kSubBuckets;
+    return (shift + 1) * kSubBuckets + sub;
+  }
+
+  static uint64_t BucketUpperBound(size_t index) {
+    if (index < kSubBuckets) {
+      return index;
+    }
+    uint64_t shift = index / kSubBuckets - 1;
+    uint64_t sub = index % kSubBuckets + kSubBuckets;
+    return ((sub + 1) << shift) - 1;
+  }
+
+ private:
+  AtomicHistogram(const AtomicHistogram&) = delete;
+  AtomicHistogram& operator=(const AtomicHistogram&) = delete;
+
+  std::array<std::atomic<uint64_t>, kBucketNum> buckets_;
+  std::atomic<uint64_t> count_;
+  std::atomic<uint64_t> sum_;
+  std::atomic<uint64_t> max_;
+};
+
+}  // namespace base
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_BASE_ATOMIC_HISTOGRAM_H_
@@ -0,0 +1,87 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/base/atomic_histogram.h"
+
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace cyber {
+namespace base {
+
+TEST(AtomicHistogramTest, BucketIndex) {
+  for (uint64_t i = 0; i < AtomicHistogram::kSubBuckets; ++i) {
+    EXPECT_EQ(i, AtomicHistogram::BucketIndex(i));
+    EXPECT_EQ(i, AtomicHistogram::BucketUpperBound(i));
+  }
+  size_t last = 0;
+  for (uint64_t v = 1; v < (1ULL << 20); v = v * 3 / 2 + 1) {
+    auto index = AtomicHistogram::BucketIndex(v);
+    EXPECT_GE(index, last);
+    EXPECT_GE(AtomicHistogram::BucketUpperBound(index), v);
+    // relative error is bounded by the sub bucket resolution
+    EXPECT_LE(AtomicHistogram::BucketUpperBound(index) - v,
+              v / AtomicHistogram::kSubBuckets);
+    last = index;
+  }
+  EXPECT_EQ(AtomicHistogram::kBucketNum - 1,
+            AtomicHistogram::BucketIndex(UINT64_MAX));
+}
+
+TEST(AtomicHistogramTest, Percentile) {
+  AtomicHistogram histogram;
+  EXPECT_EQ(0, histogram.Count());
+  EXPECT_EQ(0, histogram.Percentile(50));
+
+  for (uint64_t i = 1; i <= 1000; ++i) {
+    histogram.Record(i);
+  }
+  EXPECT_EQ(1000, histogram.Count());
+  EXPECT_EQ(500500, histogram.Sum());
+  EXPECT_EQ(500, histogram.Mean());
+  EXPECT_EQ(1000, histogram.Max());
+  EXPECT_NEAR(500, histogram.Percentile(50), 500 / 16);
+  EXPECT_NEAR(990, histogram.Percentile(99), 990 / 16);
+  EXPECT_EQ(1000, histogram.Percentile(100));
+
+  histogram.Reset();
+  EXPECT_EQ(0, histogram.Count());
+  EXPECT_EQ(0, histogram.Max());
+}
+
+TEST(AtomicHistogramTest, Concurrent) {
+  AtomicHistogram histogram;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&histogram, t]() {
+      for (uint64_t i = 0; i < 10000; ++i) {
+        histogram.Record(i + t);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(40000, histogram.Count());
+  EXPECT_EQ(10002, histogram.Max());
+}
+
+}  // namespace base
+}  // namespace cyber
+}  // namespace apollo
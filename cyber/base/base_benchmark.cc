@@ -0,0 +1,145 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+// Microbenchmarks of the lock free containers and the object pool. The
+// threaded cases share one instance among all threads. For results to keep
+// across releases, write them as json:
+//
+//   base_benchmark --benchmark_out=base.json --benchmark_out_format=json
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+#include "benchmark/benchmark.h"
+
+#include "cyber/base/atomic_hash_map.h"
+#include "cyber/base/bounded_queue.h"
+#include "cyber/base/concurrent_object_pool.h"
+#include "cyber/base/unbounded_queue.h"
+
+namespace apollo {
+namespace cyber {
+namespace base {
+
+namespace {
+
+constexpr uint64_t kKeyNum = 1024;
+
+struct Payload {
+  uint64_t data[8];
+};
+
+BoundedQueue<uint64_t>* SharedBoundedQueue() {
+  static BoundedQueue<uint64_t>* queue = []() {
+    auto queue = new BoundedQueue<uint64_t>();
+    queue->Init(1024);
+    return queue;
+  }();
+  return queue;
+}
+
+AtomicHashMap<uint64_t, uint64_t, 1024>* SharedHashMap() {
+  static AtomicHashMap<uint64_t, uint64_t, 1024>* map = []() {
+    auto map = new AtomicHashMap<uint64_t, uint64_t, 1024>();
+    for (uint64_t key = 0; key < kKeyNum; ++key) {
+      map->Set(key, key);
+    }
+    return map;
+  }();
+  return map;
+}
+
+// up to 8 threads, but not more than the cores, where spinning threads would
+// wait for the ones preempted
+void ThreadCounts(benchmark::internal::Benchmark* benchmark) {
+  const int max_threads =
+      std::max(1, std::min(8, static_cast<int>(
+                                  std::thread::hardware_concurrency())));
+  for (int threads = 1; threads <= max_threads; threads *= 2) {
+    benchmark->Threads(threads);
+  }
+}
+
+}  // namespace
+
+void BM_BoundedQueue(benchmark::State& state) {
+  auto queue = SharedBoundedQueue();
+  uint64_t value = 0;
+  for (auto _ : state) {
+    queue->Enqueue(value);
+    queue->Dequeue(&value);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_BoundedQueue)->Apply(ThreadCounts)->UseRealTime();
+
+void BM_UnboundedQueue(benchmark::State& state) {
+  static UnboundedQueue<uint64_t> queue;
+  uint64_t value = 0;
+  for (auto _ : state) {
+    queue.Enqueue(value);
+    queue.Dequeue(&value);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_UnboundedQueue)->Apply(ThreadCounts)->UseRealTime();
+
+void BM_AtomicHashMapGet(benchmark::State& state) {
+  auto map = SharedHashMap();
+  uint64_t key = 0;
+  uint64_t value = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(map->Get(key, &value));
+    key = (key + 1) % kKeyNum;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_AtomicHashMapGet)->Apply(ThreadCounts)->UseRealTime();
+
+// only updates existing keys, which allocates the new value and frees the
+// old one
+void BM_AtomicHashMapSet(benchmark::State& state) {
+  auto map = SharedHashMap();
+  uint64_t key = 0;
+  for (auto _ : state) {
+    map->Set(key, key);
+    key = (key + 1) % kKeyNum;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_AtomicHashMapSet)->Apply(ThreadCounts)->UseRealTime();
+
+void BM_CCObjectPool(benchmark::State& state) {
+  static auto pool = []() {
+    auto pool = std::make_shared<CCObjectPool<Payload>>(1024);
+    pool->ConstructAll();
+    return pool;
+  }();
+  for (auto _ : state) {
+    auto object = pool->GetObject();
+    benchmark::DoNotOptimize(object);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CCObjectPool)->Apply(ThreadCounts)->UseRealTime();
+
+}  // namespace base
+}  // namespace cyber
+}  // namespace apollo
+
+BENCHMARK_MAIN();
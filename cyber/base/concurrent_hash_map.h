@@ -0,0 +1,356 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_BASE_CONCURRENT_HASH_MAP_H_
+#define CYBER_BASE_CONCURRENT_HASH_MAP_H_
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "cyber/base/epoch_reclaimer.h"
+
+namespace apollo {
+namespace cyber {
+namespace base {
+
+/**
+ * @brief A lock-free hash map that grows, erases and iterates
+ *
+ * All entries live in one lock-free sorted list, ordered by the bit reversed
+ * hash of their key, and every bucket points to a dummy node of that list
+ * (split-ordered list). Doubling the bucket number never moves an entry, a
+ * new bucket is split off its parent bucket the first time it is used.
+ * Unlinked entries and replaced values are freed by the EpochReclaimer, so
+ * readers never see freed memory. Iteration is weakly consistent.
+ *
+ * @tparam K Type of key, must be default constructible and comparable
+ * @tparam V Type of value, must be copyable
+ * @tparam Hash Hash function of the key
+ */
+template <typename K, typename V, typename Hash = std::hash<K>>
+class ConcurrentHashMap {
+ public:
+  explicit ConcurrentHashMap(std::size_t bucket_num = 16) {
+    std::size_t num = 1;
+    while (num < bucket_num && num < kMaxBucketNum) {
+      num <<= 1;
+    }
+    bucket_num_.store(num, std::memory_order_relaxed);
+    BucketSlot(0)->store(new Node(0), std::memory_order_release);
+  }
+
+  ~ConcurrentHashMap() {
+    Node *node = BucketSlot(0)->load(std::memory_order_relaxed);
+    while (node != nullptr) {
+      Node *next = ToNode(node->next.load(std::memory_order_relaxed));
+      delete node;
+      node = next;
+    }
+    for (auto &segment : segments_) {
+      delete[] segment.load(std::memory_order_relaxed);
+    }
+  }
+
+  ConcurrentHashMap(const ConcurrentHashMap &other) = delete;
+  ConcurrentHashMap &operator=(const ConcurrentHashMap &other) = delete;
+
+  bool Has(const K &key) {
+    EpochReclaimer::Guard guard;
+    std::atomic<uintptr_t> *prev = nullptr;
+    Node *curr = nullptr;
+    return Find(key, &prev, &curr);
+  }
+
+  bool Get(const K &key, V *value) {
+    EpochReclaimer::Guard guard;
+    std::atomic<uintptr_t> *prev = nullptr;
+    Node *curr = nullptr;
+    if (!Find(key, &prev, &curr)) {
+      return false;
+    }
+    *value = *curr->value.load(std::memory_order_acquire);
+    return true;
+  }
+
+  /**
+   * @brief Insert the key if it is absent
+   *
+   * @return false if the key already exists, its value is left unchanged
+   */
+  bool Insert(const K &key, const V &value) {
+    return Emplace(key, value, false);
+  }
+
+  /**
+   * @brief Insert the key, or replace its value if it already exists
+   */
+  void Set(const K &key, const V &value) { Emplace(key, value, true); }
+
+  bool Erase(const K &key) {
+    EpochReclaimer::Guard guard;
+    std::atomic<uintptr_t> *prev = nullptr;
+    Node *curr = nullptr;
+    while (Find(key, &prev, &curr)) {
+      uintptr_t next = curr->next.load(std::memory_order_acquire);
+      if (IsMarked(next) ||
+          !curr->next.compare_exchange_strong(next, Mark(next),
+                                              std::memory_order_acq_rel,
+                                              std::memory_order_relaxed)) {
+        // erased or changed by another thread, look again
+        continue;
+      }
+      size_.fetch_sub(1, std::memory_order_relaxed);
+      uintptr_t expected = ToWord(curr);
+      if (prev->compare_exchange_strong(expected, next,
+                                        std::memory_order_acq_rel,
+                                        std::memory_order_relaxed)) {
+        EpochReclaimer::Instance()->Retire(curr);
+      } else {
+        // the next Find unlinks the marked node
+        Find(key, &prev, &curr);
+      }
+      return true;
+    }
+    return false;
+  }
+
+  /**
+   * @brief Call func(key, value) on every entry, entries inserted or erased
+   *        during the iteration may or may not be visited
+   */
+  template <typename Func>
+  void ForEach(const Func &func) {
+    EpochReclaimer::Guard guard;
+    Node *node = BucketSlot(0)->load(std::memory_order_acquire);
+    while (node != nullptr) {
+      uintptr_t next = node->next.load(std::memory_order_acquire);
+      if (!IsDummy(node->so_key) && !IsMarked(next)) {
+        func(node->key, *node->value.load(std::memory_order_acquire));
+      }
+      node = ToNode(next);
+    }
+  }
+
+  void Clear() {
+    std::vector<K> keys;
+    ForEach([&keys](const K &key, const V &value) { keys.push_back(key); });
+    for (const auto &key : keys) {
+      Erase(key);
+    }
+  }
+
+  std::size_t Size() const { return size_.load(std::memory_order_relaxed); }
+
+  std::size_t BucketNum() const {
+    return bucket_num_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  static constexpr std::size_t kSegmentNum = 32;
+  static constexpr std::size_t kMaxBucketNum = 1UL << (kSegmentNum - 1);
+  static constexpr std::size_t kMaxLoadFactor = 2;
+
+  struct Node {
+    explicit Node(uint64_t so_key) : so_key(so_key) {}
+    Node(uint64_t so_key, const K &key, const V &value)
+        : so_key(so_key), key(key), value(new V(value)) {}
+    ~Node() { delete value.load(std::memory_order_relaxed); }
+
+    const uint64_t so_key;
+    const K key = K();
+    std::atomic<V *> value = {nullptr};
+    // the lowest bit marks the node as erased
+    std::atomic<uintptr_t> next = {0};
+  };
+
+  static bool IsMarked(uintptr_t word) { return word & 1; }
+  static uintptr_t Mark(uintptr_t word) { return word | 1; }
+  static Node *ToNode(uintptr_t word) {
+    return reinterpret_cast<Node *>(word & ~static_cast<uintptr_t>(1));
+  }
+  static uintptr_t ToWord(Node *node) {
+    return reinterpret_cast<uintptr_t>(node);
+  }
+
+  static uint64_t Reverse(uint64_t x) {
+    x = ((x >> 1) & 0x5555555555555555ULL) | ((x & 0x5555555555555555ULL) << 1);
+    x = ((x >> 2) & 0x3333333333333333ULL) | ((x & 0x3333333333333333ULL) << 2);
+    x = ((x >> 4) & 0x0F0F0F0F0F0F0F0FULL) | ((x & 0x0F0F0F0F0F0F0F0FULL) << 4);
+    x = ((x >> 8) & 0x00FF00FF00FF00FFULL) | ((x & 0x00FF00FF00FF00FFULL) << 8);
+    x = ((x >> 16) & 0x0000FFFF0000FFFFULL) |
+        ((x & 0x0000FFFF0000FFFFULL) << 16);
+    return (x >> 32) | (x << 32);
+  }
+
+  // entries have odd split-order keys and dummy nodes even ones, so the
+  // dummy node of a bucket sorts before all entries of the bucket
+  static uint64_t EntryKey(uint64_t hash) {
+    return Reverse(hash | (1ULL << 63));
+  }
+  static uint64_t DummyKey(uint64_t bucket) { return Reverse(bucket); }
+  static bool IsDummy(uint64_t so_key) { return (so_key & 1) == 0; }
+
+  // segment 0 holds bucket 0, segment s holds buckets [2^(s-1), 2^s)
+  std::atomic<Node *> *BucketSlot(uint64_t bucket) {
+    std::size_t segment = bucket == 0 ? 0 : 64 - __builtin_clzll(bucket);
+    std::size_t size = segment == 0 ? 1 : 1UL << (segment - 1);
+    auto *slots = segments_[segment].load(std::memory_order_acquire);
+    if (slots == nullptr) {
+      auto *fresh = new std::atomic<Node *>[size]();
+      if (segments_[segment].compare_exchange_strong(
+              slots, fresh, std::memory_order_acq_rel,
+              std::memory_order_acquire)) {
+        slots = fresh;
+      } else {
+        delete[] fresh;
+      }
+    }
+    return &slots[segment == 0 ? 0 : bucket - size];
+  }
+
+  Node *Bucket(uint64_t bucket) {
+    auto *slot = BucketSlot(bucket);
+    Node *dummy = slot->load(std::memory_order_acquire);
+    if (dummy != nullptr) {
+      return dummy;
+    }
+    // split the bucket off its parent, the bucket without its highest bit
+    uint64_t parent = bucket & ~(1ULL << (63 - __builtin_clzll(bucket)));
+    Node *head = Bucket(parent);
+    dummy = new Node(DummyKey(bucket));
+    std::atomic<uintptr_t> *prev = nullptr;
+    Node *curr = nullptr;
+    while (true) {
+      if (Find(head, dummy->so_key, nullptr, &prev, &curr)) {
+        // another thread initialized the bucket first
+        delete dummy;
+        dummy = curr;
+        break;
+      }
+      dummy->next.store(ToWord(curr), std::memory_order_relaxed);
+      uintptr_t expected = ToWord(curr);
+      if (prev->compare_exchange_strong(expected, ToWord(dummy),
+                                        std::memory_order_acq_rel,
+                                        std::memory_order_relaxed)) {
+        break;
+      }
+    }
+    slot->store(dummy, std::memory_order_release);
+    return dummy;
+  }
+
+  bool Find(const K &key, std::atomic<uintptr_t> **prev_ptr,
+            Node **curr_ptr) {
+    uint64_t hash = static_cast<uint64_t>(Hash()(key));
+    Node *head =
+        Bucket(hash & (bucket_num_.load(std::memory_order_acquire) - 1));
+    return Find(head, EntryKey(hash), &key, prev_ptr, curr_ptr);
+  }
+
+  // find the node of so_key and key, or where to insert it, starting at the
+  // dummy node head and unlinking the erased nodes on the way
+  bool Find(Node *head, uint64_t so_key, const K *key,
+            std::atomic<uintptr_t> **prev_ptr, Node **curr_ptr) {
+    while (true) {
+      std::atomic<uintptr_t> *prev = &head->next;
+      Node *curr = ToNode(prev->load(std::memory_order_acquire));
+      bool restart = false;
+      while (curr != nullptr) {
+        uintptr_t next = curr->next.load(std::memory_order_acquire);
+        if (prev->load(std::memory_order_acquire) != ToWord(curr)) {
+          restart = true;
+          break;
+        }
+        if (IsMarked(next)) {
+          uintptr_t expected = ToWord(curr);
+          if (!prev->compare_exchange_strong(
+                  expected, next & ~static_cast<uintptr_t>(1),
+                  std::memory_order_acq_rel, std::memory_order_relaxed)) {
+            restart = true;
+            break;
+          }
+          EpochReclaimer::Instance()->Retire(curr);
+          curr = ToNode(next);
+          continue;
+        }
+        if (curr->so_key > so_key) {
+          break;
+        }
+        if (curr->so_key == so_key && (key == nullptr || curr->key == *key)) {
+          *prev_ptr = prev;
+          *curr_ptr = curr;
+          return true;
+        }
+        prev = &curr->next;
+        curr = ToNode(next);
+      }
+      if (!restart) {
+        *prev_ptr = prev;
+        *curr_ptr = curr;
+        return false;
+      }
+    }
+  }
+
+  bool Emplace(const K &key, const V &value, bool replace) {
+    EpochReclaimer::Guard guard;
+    uint64_t hash = static_cast<uint64_t>(Hash()(key));
+    std::atomic<uintptr_t> *prev = nullptr;
+    Node *curr = nullptr;
+    Node *node = nullptr;
+    while (true) {
+      if (Find(key, &prev, &curr)) {
+        delete node;
+        if (replace) {
+          V *old_value = curr->value.exchange(new V(value),
+                                              std::memory_order_acq_rel);
+          EpochReclaimer::Instance()->Retire(old_value);
+        }
+        return false;
+      }
+      if (node == nullptr) {
+        node = new Node(EntryKey(hash), key, value);
+      }
+      node->next.store(ToWord(curr), std::memory_order_relaxed);
+      uintptr_t expected = ToWord(curr);
+      if (prev->compare_exchange_strong(expected, ToWord(node),
+                                        std::memory_order_acq_rel,
+                                        std::memory_order_relaxed)) {
+        break;
+      }
+    }
+    std::size_t size = size_.fetch_add(1, std::memory_order_relaxed) + 1;
+    std::size_t bucket_num = bucket_num_.load(std::memory_order_relaxed);
+    if (size > kMaxLoadFactor * bucket_num && bucket_num < kMaxBucketNum) {
+      bucket_num_.compare_exchange_strong(bucket_num, bucket_num * 2,
+                                          std::memory_order_acq_rel,
+                                          std::memory_order_relaxed);
+    }
+    return true;
+  }
+
+  std::atomic<std::atomic<Node *> *> segments_[kSegmentNum] = {};
+  std::atomic<std::size_t> bucket_num_ = {1};
+  std::atomic<std::size_t> size_ = {0};
+};
+
+}  // namespace base
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_BASE_CONCURRENT_HASH_MAP_H_
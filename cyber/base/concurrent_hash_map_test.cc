@@ -0,0 +1,148 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/base/concurrent_hash_map.h"
+
+#include <atomic>
+#include <memory>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace cyber {
+namespace base {
+
+TEST(ConcurrentHashMapTest, int_int) {
+  ConcurrentHashMap<int, int> map(4);
+  int value = 0;
+  for (int i = 0; i < 1000; i++) {
+    EXPECT_TRUE(map.Insert(i, i));
+    EXPECT_TRUE(map.Has(i));
+    EXPECT_TRUE(map.Get(i, &value));
+    EXPECT_EQ(i, value);
+  }
+  EXPECT_EQ(1000, map.Size());
+  EXPECT_GE(map.BucketNum(), 500);
+
+  for (int i = 0; i < 1000; i++) {
+    EXPECT_FALSE(map.Insert(i, -1));
+    map.Set(i, 1000 - i);
+    EXPECT_TRUE(map.Get(i, &value));
+    EXPECT_EQ(1000 - i, value);
+  }
+  EXPECT_EQ(1000, map.Size());
+
+  for (int i = 0; i < 1000; i += 2) {
+    EXPECT_TRUE(map.Erase(i));
+    EXPECT_FALSE(map.Erase(i));
+    EXPECT_FALSE(map.Has(i));
+    EXPECT_FALSE(map.Get(i, &value));
+  }
+  EXPECT_EQ(500, map.Size());
+  for (int i = 1; i < 1000; i += 2) {
+    EXPECT_TRUE(map.Get(i, &value));
+    EXPECT_EQ(1000 - i, value);
+  }
+}
+
+TEST(ConcurrentHashMapTest, str_shared_ptr) {
+  ConcurrentHashMap<std::string, std::shared_ptr<int>> map;
+  auto value = std::make_shared<int>(1);
+  map.Set("test", value);
+  std::shared_ptr<int> result = nullptr;
+  EXPECT_TRUE(map.Get("test", &result));
+  EXPECT_EQ(value, result);
+  EXPECT_FALSE(map.Get("other", &result));
+  EXPECT_TRUE(map.Erase("test"));
+  EXPECT_FALSE(map.Has("test"));
+}
+
+TEST(ConcurrentHashMapTest, for_each_and_clear) {
+  ConcurrentHashMap<uint64_t, std::string> map;
+  for (uint64_t i = 0; i < 100; i++) {
+    map.Set(i, std::to_string(i));
+  }
+  std::set<uint64_t> keys;
+  map.ForEach([&keys](const uint64_t& key, const std::string& value) {
+    EXPECT_EQ(std::to_string(key), value);
+    keys.insert(key);
+  });
+  EXPECT_EQ(100, keys.size());
+
+  map.Clear();
+  EXPECT_EQ(0, map.Size());
+  int count = 0;
+  map.ForEach([&count](const uint64_t&, const std::string&) { ++count; });
+  EXPECT_EQ(0, count);
+}
+
+TEST(ConcurrentHashMapTest, concurrency) {
+  ConcurrentHashMap<int, std::string> map(2);
+  const int thread_num = 8;
+  const int key_num = 4096;
+  std::vector<std::thread> threads;
+  std::atomic<bool> stop = {false};
+
+  // readers iterate and look up while the map grows and shrinks
+  std::thread reader([&]() {
+    std::string value;
+    while (!stop.load()) {
+      map.ForEach([](const int& key, const std::string& value) {
+        EXPECT_EQ(std::to_string(key), value);
+      });
+      for (int i = 0; i < key_num; i += 64) {
+        if (map.Get(i, &value)) {
+          EXPECT_EQ(std::to_string(i), value);
+        }
+      }
+    }
+  });
+  for (int t = 0; t < thread_num; t++) {
+    threads.emplace_back([&, t]() {
+      for (int i = t; i < key_num; i += thread_num) {
+        EXPECT_TRUE(map.Insert(i, std::to_string(i)));
+        map.Set(i, std::to_string(i));
+      }
+      // every thread erases the odd keys of the next thread
+      for (int i = (t + 1) % thread_num; i < key_num; i += thread_num) {
+        if (i % 2 == 1) {
+          while (!map.Erase(i)) {
+            std::this_thread::yield();
+          }
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  stop = true;
+  reader.join();
+
+  EXPECT_EQ(key_num / 2, map.Size());
+  std::string value;
+  for (int i = 0; i < key_num; i++) {
+    EXPECT_EQ(i % 2 == 0, map.Get(i, &value));
+  }
+}
+
+}  // namespace base
+}  // namespace cyber
+}  // namespace apollo
@@ -0,0 +1,198 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_BASE_EPOCH_RECLAIMER_H_
+#define CYBER_BASE_EPOCH_RECLAIMER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+
+namespace apollo {
+namespace cyber {
+namespace base {
+
+/**
+ * @brief Epoch based reclamation of the memory of lock-free containers
+ *
+ * Readers enter a Guard before they load pointers of a container. A writer
+ * that unlinks an object hands it to Retire, and the object is only deleted
+ * once every thread that was inside a guard at that time has left it, that
+ * is once the global epoch moved twice.
+ */
+class EpochReclaimer {
+ public:
+  class Guard {
+   public:
+    Guard() { EpochReclaimer::Instance()->Enter(); }
+    ~Guard() { EpochReclaimer::Instance()->Leave(); }
+    Guard(const Guard &) = delete;
+    Guard &operator=(const Guard &) = delete;
+  };
+
+  // never destroyed, threads may still retire objects when main returns
+  static EpochReclaimer *Instance() {
+    static EpochReclaimer *instance = new EpochReclaimer();
+    return instance;
+  }
+
+  template <typename T>
+  void Retire(T *ptr) {
+    Retire(ptr, [](void *p) { delete static_cast<T *>(p); });
+  }
+
+  void Retire(void *ptr, void (*deleter)(void *)) {
+    ThreadState &state = LocalState();
+    state.limbo.push_back({ptr, deleter, epoch_.load()});
+    if (state.limbo.size() % kReclaimInterval == 0) {
+      TryAdvance();
+      Reclaim(&state.limbo);
+    }
+  }
+
+  uint64_t epoch() const { return epoch_.load(std::memory_order_relaxed); }
+
+ private:
+  static constexpr std::size_t kReclaimInterval = 64;
+
+  struct Retired {
+    void *ptr;
+    void (*deleter)(void *);
+    uint64_t epoch;
+  };
+
+  struct Record {
+    std::atomic<uint64_t> epoch = {0};
+    std::atomic<bool> active = {false};
+    std::atomic<bool> in_use = {true};
+    Record *next = nullptr;
+  };
+
+  struct ThreadState {
+    ~ThreadState() {
+      if (record == nullptr) {
+        return;
+      }
+      EpochReclaimer::Instance()->Release(this);
+    }
+    Record *record = nullptr;
+    int depth = 0;
+    std::deque<Retired> limbo;
+  };
+
+  EpochReclaimer() = default;
+
+  ThreadState &LocalState() {
+    static thread_local ThreadState state;
+    if (state.record == nullptr) {
+      state.record = Acquire();
+    }
+    return state;
+  }
+
+  void Enter() {
+    ThreadState &state = LocalState();
+    if (state.depth++ > 0) {
+      return;
+    }
+    Record *record = state.record;
+    record->active.store(true, std::memory_order_relaxed);
+    uint64_t epoch = 0;
+    do {
+      epoch = epoch_.load();
+      record->epoch.store(epoch, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+    } while (epoch != epoch_.load());
+  }
+
+  void Leave() {
+    ThreadState &state = LocalState();
+    if (--state.depth > 0) {
+      return;
+    }
+    state.record->active.store(false, std::memory_order_release);
+  }
+
+  // the epoch only moves once every thread inside a guard has seen it
+  void TryAdvance() {
+    uint64_t epoch = epoch_.load();
+    for (Record *record = records_.load(std::memory_order_acquire);
+         record != nullptr; record = record->next) {
+      if (record->active.load() && record->epoch.load() != epoch) {
+        return;
+      }
+    }
+    epoch_.compare_exchange_strong(epoch, epoch + 1);
+    std::unique_lock<std::mutex> lock(orphans_mutex_, std::try_to_lock);
+    if (lock.owns_lock()) {
+      Reclaim(&orphans_);
+    }
+  }
+
+  // objects are retired in epoch order, so a prefix of the list is safe
+  void Reclaim(std::deque<Retired> *limbo) {
+    uint64_t epoch = epoch_.load();
+    while (!limbo->empty() && limbo->front().epoch + 2 <= epoch) {
+      limbo->front().deleter(limbo->front().ptr);
+      limbo->pop_front();
+    }
+  }
+
+  // records are never freed, the ones of exited threads are reused
+  Record *Acquire() {
+    for (Record *record = records_.load(std::memory_order_acquire);
+         record != nullptr; record = record->next) {
+      bool in_use = false;
+      if (!record->in_use.load(std::memory_order_relaxed) &&
+          record->in_use.compare_exchange_strong(in_use, true)) {
+        return record;
+      }
+    }
+    Record *record = new Record();
+    Record *head = records_.load(std::memory_order_relaxed);
+    do {
+      record->next = head;
+    } while (!records_.compare_exchange_weak(head, record,
+                                             std::memory_order_acq_rel,
+                                             std::memory_order_relaxed));
+    return record;
+  }
+
+  // objects the exiting thread retired are freed by the next advance
+  void Release(ThreadState *state) {
+    {
+      std::lock_guard<std::mutex> lock(orphans_mutex_);
+      orphans_.insert(orphans_.end(), state->limbo.begin(),
+                      state->limbo.end());
+    }
+    state->limbo.clear();
+    state->record->active.store(false, std::memory_order_release);
+    state->record->in_use.store(false, std::memory_order_release);
+    state->record = nullptr;
+  }
+
+  std::atomic<uint64_t> epoch_ = {2};
+  std::atomic<Record *> records_ = {nullptr};
+  std::mutex orphans_mutex_;
+  std::deque<Retired> orphans_;
+};
+
+}  // namespace base
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_BASE_EPOCH_RECLAIMER_H_
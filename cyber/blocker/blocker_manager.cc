@@ -22,21 +22,19 @@ namespace blocker {
 
 BlockerManager::BlockerManager() {}
 
-BlockerManager::~BlockerManager() { blockers_.clear(); }
+BlockerManager::~BlockerManager() { blockers_.Clear(); }
 
 void BlockerManager::Observe() {
-  std::lock_guard<std::mutex> lock(blocker_mutex_);
-  for (auto& item : blockers_) {
-    item.second->Observe();
-  }
+  blockers_.ForEach(
+      [](const std::string& channel_name,
+         const std::shared_ptr<BlockerBase>& blocker) { blocker->Observe(); });
 }
 
 void BlockerManager::Reset() {
-  std::lock_guard<std::mutex> lock(blocker_mutex_);
-  for (auto& item : blockers_) {
-    item.second->Reset();
-  }
-  blockers_.clear();
+  blockers_.ForEach(
+      [](const std::string& channel_name,
+         const std::shared_ptr<BlockerBase>& blocker) { blocker->Reset(); });
+  blockers_.Clear();
 }
 
 }  // namespace blocker
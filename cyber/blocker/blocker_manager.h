@@ -18,10 +18,9 @@
 #define CYBER_BLOCKER_BLOCKER_MANAGER_H_
 
 #include <memory>
-#include <mutex>
 #include <string>
-#include <unordered_map>
 
+#include "cyber/base/concurrent_hash_map.h"
 #include "cyber/blocker/blocker.h"
 
 namespace apollo {
@@ -31,7 +30,7 @@ namespace blocker {
 class BlockerManager {
  public:
   using BlockerMap =
-      std::unordered_map<std::string, std::shared_ptr<BlockerBase>>;
+      base::ConcurrentHashMap<std::string, std::shared_ptr<BlockerBase>>;
 
   virtual ~BlockerManager();
 
@@ -73,7 +72,6 @@ class BlockerManager {
   BlockerManager& operator=(const BlockerManager&) = delete;
 
   BlockerMap blockers_;
-  std::mutex blocker_mutex_;
 };
 
 template <typename T>
@@ -122,32 +120,26 @@ bool BlockerManager::Unsubscribe(const std::string& channel_name,
 template <typename T>
 std::shared_ptr<Blocker<T>> BlockerManager::GetBlocker(
     const std::string& channel_name) {
-  std::shared_ptr<Blocker<T>> blocker = nullptr;
-  {
-    std::lock_guard<std::mutex> lock(blocker_mutex_);
-    auto search = blockers_.find(channel_name);
-    if (search != blockers_.end()) {
-      blocker = std::dynamic_pointer_cast<Blocker<T>>(search->second);
-    }
+  std::shared_ptr<BlockerBase> blocker = nullptr;
+  if (!blockers_.Get(channel_name, &blocker)) {
+    return nullptr;
   }
-  return blocker;
+  return std::dynamic_pointer_cast<Blocker<T>>(blocker);
 }
 
 template <typename T>
 std::shared_ptr<Blocker<T>> BlockerManager::GetOrCreateBlocker(
     const BlockerAttr& attr) {
-  std::shared_ptr<Blocker<T>> blocker = nullptr;
-  {
-    std::lock_guard<std::mutex> lock(blocker_mutex_);
-    auto search = blockers_.find(attr.channel_name);
-    if (search != blockers_.end()) {
-      blocker = std::dynamic_pointer_cast<Blocker<T>>(search->second);
-    } else {
-      blocker = std::make_shared<Blocker<T>>(attr);
-      blockers_[attr.channel_name] = blocker;
+  std::shared_ptr<BlockerBase> blocker = nullptr;
+  if (!blockers_.Get(attr.channel_name, &blocker)) {
+    blocker = std::make_shared<Blocker<T>>(attr);
+    // the blocker of another thread wins if it was inserted first
+    if (!blockers_.Insert(attr.channel_name, blocker) &&
+        !blockers_.Get(attr.channel_name, &blocker)) {
+      return nullptr;
     }
   }
-  return blocker;
+  return std::dynamic_pointer_cast<Blocker<T>>(blocker);
 }
 
 }  // namespace blocker
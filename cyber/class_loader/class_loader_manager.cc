@@ -25,13 +25,18 @@ ClassLoaderManager::~ClassLoaderManager() {}
 
 ClassLoader* ClassLoaderManager::GetClassLoaderByLibPath(
     const std::string& library_path) {
-  return libpath_loader_map_[library_path];
+  std::lock_guard<std::mutex> lck(libpath_loader_map_mutex_);
+  auto itr = libpath_loader_map_.find(library_path);
+  return itr != libpath_loader_map_.end() ? itr->second : nullptr;
 }
 
 std::vector<ClassLoader*> ClassLoaderManager::GetAllValidClassLoaders() {
+  std::lock_guard<std::mutex> lck(libpath_loader_map_mutex_);
   std::vector<ClassLoader*> class_loaders;
   for (auto& lib_class_loader : libpath_loader_map_) {
-    class_loaders.emplace_back(lib_class_loader.second);
+    if (lib_class_loader.second != nullptr) {
+      class_loaders.emplace_back(lib_class_loader.second);
+    }
   }
   return class_loaders;
 }
@@ -54,20 +59,33 @@ bool ClassLoaderManager::IsLibraryValid(const std::string& library_name) {
 }
 
 bool ClassLoaderManager::LoadLibrary(const std::string& library_path) {
+  {
+    std::lock_guard<std::mutex> lck(libpath_loader_map_mutex_);
+    if (IsLibraryValid(library_path)) {
+      return true;
+    }
+  }
+  // dlopen outside the lock, so classes of the libraries already loaded can
+  // be created while another one is still being loaded
+  auto class_loader = new class_loader::ClassLoader(library_path);
   std::lock_guard<std::mutex> lck(libpath_loader_map_mutex_);
-  if (!IsLibraryValid(library_path)) {
-    libpath_loader_map_[library_path] =
-        new class_loader::ClassLoader(library_path);
+  if (IsLibraryValid(library_path)) {
+    delete class_loader;
+  } else {
+    libpath_loader_map_[library_path] = class_loader;
   }
   return IsLibraryValid(library_path);
 }
 
 int ClassLoaderManager::UnloadLibrary(const std::string& library_path) {
   int num_remain_unload = 0;
-  if (IsLibraryValid(library_path)) {
-    ClassLoader* class_loader = GetClassLoaderByLibPath(library_path);
+  ClassLoader* class_loader = GetClassLoaderByLibPath(library_path);
+  if (class_loader != nullptr) {
     if ((num_remain_unload = class_loader->UnloadLibrary()) == 0) {
-      libpath_loader_map_[library_path] = nullptr;
+      {
+        std::lock_guard<std::mutex> lck(libpath_loader_map_mutex_);
+        libpath_loader_map_[library_path] = nullptr;
+      }
       delete class_loader;
     }
   }
@@ -75,7 +93,11 @@ int ClassLoaderManager::UnloadLibrary(const std::string& library_path) {
 }
 
 void ClassLoaderManager::UnloadAllLibrary() {
-  std::vector<std::string> valid_libraries = GetAllValidLibPath();
+  std::vector<std::string> valid_libraries;
+  {
+    std::lock_guard<std::mutex> lck(libpath_loader_map_mutex_);
+    valid_libraries = GetAllValidLibPath();
+  }
   for (auto& lib : valid_libraries) {
     UnloadLibrary(lib);
   }
@@ -19,6 +19,7 @@
 #include <arpa/inet.h>
 #include <ifaddrs.h>
 #include <netdb.h>
+#include <pthread.h>
 #include <sys/types.h>
 #include <unistd.h>
 
@@ -54,6 +55,9 @@ GlobalData::GlobalData() {
   InitHostInfo();
   ACHECK(InitConfig());
   process_id_ = getpid();
+  // a process forked after GlobalData is created (e.g. by the mainboard fork
+  // server) must not keep its parent's process id
+  pthread_atfork(nullptr, nullptr, &GlobalData::OnForkChild);
   auto prog_path = program_path();
   if (!prog_path.empty()) {
     process_group_ = GetFileName(prog_path) + "_" + std::to_string(process_id_);
@@ -68,6 +72,13 @@ GlobalData::GlobalData() {
 
 GlobalData::~GlobalData() {}
 
+void GlobalData::OnForkChild() {
+  auto instance = Instance(false);
+  if (instance != nullptr) {
+    instance->process_id_ = getpid();
+  }
+}
+
 int GlobalData::ProcessId() const { return process_id_; }
 
 void GlobalData::SetProcessGroup(const std::string& process_group) {
@@ -83,6 +83,7 @@ class GlobalData {
  private:
   void InitHostInfo();
   bool InitConfig();
+  static void OnForkChild();
 
   // global config
   CyberConfig config_;
@@ -192,6 +192,16 @@ bool Component<M0, NullType, NullType, NullType>::Initialize(
     }
   };
 
+  if (cyber_likely(is_reality_mode) && IsInlineChained(config.readers(0))) {
+    auto channel_id = GlobalData::RegisterChannel(reader_cfg.channel_name);
+    if (InlineChain::Instance()->Add<M0>(channel_id, func)) {
+      inline_chained_channels_.push_back(channel_id);
+      return true;
+    }
+    AWARN << reader_cfg.channel_name
+          << " is chained to another component already, reading it instead.";
+  }
+
   std::shared_ptr<Reader<M0>> reader = nullptr;
 
   if (cyber_likely(is_reality_mode)) {
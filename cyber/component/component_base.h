@@ -29,6 +29,7 @@
 #include "cyber/class_loader/class_loader.h"
 #include "cyber/common/environment.h"
 #include "cyber/common/file.h"
+#include "cyber/node/inline_chain.h"
 #include "cyber/node/node.h"
 #include "cyber/scheduler/scheduler.h"
 
@@ -53,6 +54,9 @@ class ComponentBase : public std::enable_shared_from_this<ComponentBase> {
     }
 
     Clear();
+    for (auto channel_id : inline_chained_channels_) {
+      InlineChain::Instance()->Remove(channel_id);
+    }
     for (auto& reader : readers_) {
       reader->Shutdown();
     }
@@ -89,6 +93,20 @@ class ComponentBase : public std::enable_shared_from_this<ComponentBase> {
     }
   }
 
+  /**
+   * @brief Whether the DAG chains the reader to the writer of its channel,
+   * see InlineChain. The `inline_chain` option of ReaderOption is looked up
+   * by name, it is off for the configs built without it.
+   */
+  static bool IsInlineChained(const proto::ReaderOption& reader) {
+    auto field = reader.GetDescriptor()->FindFieldByName("inline_chain");
+    if (field == nullptr || field->is_repeated() ||
+        field->cpp_type() != google::protobuf::FieldDescriptor::CPPTYPE_BOOL) {
+      return false;
+    }
+    return reader.GetReflection()->GetBool(reader, field);
+  }
+
   void LoadConfigFiles(const TimerComponentConfig& config) {
     if (!config.config_file_path().empty()) {
       if (config.config_file_path()[0] != '/') {
@@ -113,6 +131,7 @@ class ComponentBase : public std::enable_shared_from_this<ComponentBase> {
   std::shared_ptr<Node> node_ = nullptr;
   std::string config_file_path_ = "";
   std::vector<std::shared_ptr<ReaderBase>> readers_;
+  std::vector<uint64_t> inline_chained_channels_;
 };
 
 }  // namespace cyber
@@ -17,6 +17,7 @@
 #include "cyber/component/timer_component.h"
 
 #include "cyber/timer/timer.h"
+#include "cyber/timer/timer_phase_allocator.h"
 
 namespace apollo {
 namespace cyber {
@@ -46,12 +47,20 @@ bool TimerComponent::Initialize(const TimerComponentConfig& config) {
   std::shared_ptr<TimerComponent> self =
       std::dynamic_pointer_cast<TimerComponent>(shared_from_this());
   auto func = [self]() { self->Proc(); };
-  timer_.reset(new Timer(config.interval(), func, false));
+  TimerOption opt(config.interval(), func, false);
+  opt.phase_ms =
+      TimerPhaseAllocator::Instance()->Assign(config.name(), config.interval());
+  timer_.reset(new Timer(opt));
   timer_->Start();
   return true;
 }
 
-void TimerComponent::Clear() { timer_.reset(); }
+void TimerComponent::Clear() {
+  if (timer_ != nullptr) {
+    TimerPhaseAllocator::Instance()->Release(node_->Name());
+  }
+  timer_.reset();
+}
 
 uint64_t TimerComponent::GetInterval() const { return interval_; }
 
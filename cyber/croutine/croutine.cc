@@ -17,12 +17,13 @@
 #include "cyber/croutine/croutine.h"
 
 #include <algorithm>
+#include <cstdlib>
 #include <utility>
 
-#include "cyber/base/concurrent_object_pool.h"
 #include "cyber/common/global_data.h"
 #include "cyber/common/log.h"
 #include "cyber/croutine/detail/routine_context.h"
+#include "cyber/croutine/detail/stack_pool.h"
 
 namespace apollo {
 namespace cyber {
@@ -32,7 +33,6 @@ thread_local CRoutine *CRoutine::current_routine_ = nullptr;
 thread_local char *CRoutine::main_stack_ = nullptr;
 
 namespace {
-std::shared_ptr<base::CCObjectPool<RoutineContext>> context_pool = nullptr;
 std::once_flag pool_init_flag;
 
 void CRoutineEntry(void *arg) {
@@ -40,9 +40,19 @@ void CRoutineEntry(void *arg) {
   r->Run();
   CRoutine::Yield(RoutineState::FINISHED);
 }
+
+size_t PrefaultSize() {
+  // the top of a stack is touched by every croutine, fault it in up front
+  const char *value = std::getenv("CYBER_ROUTINE_STACK_PREFAULT_KB");
+  if (value == nullptr) {
+    return 16 * 1024;
+  }
+  return std::strtoull(value, nullptr, 10) * 1024;
+}
 }  // namespace
 
-CRoutine::CRoutine(const std::function<void()> &func) : func_(func) {
+CRoutine::CRoutine(const std::function<void()> &func, size_t stack_size)
+    : func_(func) {
   std::call_once(pool_init_flag, [&]() {
     uint32_t routine_num = common::GlobalData::Instance()->ComponentNums();
     auto &global_conf = common::GlobalData::Instance()->Config();
@@ -51,22 +61,22 @@ CRoutine::CRoutine(const std::function<void()> &func) : func_(func) {
       routine_num =
           std::max(routine_num, global_conf.scheduler_conf().routine_num());
     }
-    context_pool.reset(new base::CCObjectPool<RoutineContext>(routine_num));
+    StackPool::Instance()->Reserve(STACK_SIZE, routine_num, PrefaultSize());
   });
 
-  context_ = context_pool->GetObject();
-  if (context_ == nullptr) {
-    AWARN << "Maximum routine context number exceeded! Please check "
-             "[routine_num] in config file.";
-    context_.reset(new RoutineContext());
-  }
+  context_.stack =
+      StackPool::Instance()->Allocate(stack_size, &context_.stack_size);
+  ACHECK(context_.stack != nullptr)
+      << "Allocate croutine stack of " << stack_size << " bytes failed.";
 
-  MakeContext(CRoutineEntry, this, context_.get());
+  MakeContext(CRoutineEntry, this, &context_);
   state_ = RoutineState::READY;
   updated_.test_and_set(std::memory_order_release);
 }
 
-CRoutine::~CRoutine() { context_ = nullptr; }
+CRoutine::~CRoutine() {
+  StackPool::Instance()->Free(context_.stack, context_.stack_size);
+}
 
 RoutineState CRoutine::Resume() {
   if (cyber_unlikely(force_stop_)) {
@@ -39,7 +39,10 @@ enum class RoutineState { READY, FINISHED, SLEEP, IO_WAIT, DATA_WAIT };
 
 class CRoutine {
  public:
-  explicit CRoutine(const RoutineFunc &func);
+  /**
+   * @brief The stack comes from the StackPool class fitting `stack_size`.
+   */
+  explicit CRoutine(const RoutineFunc &func, size_t stack_size = STACK_SIZE);
   virtual ~CRoutine();
 
   // static interfaces
@@ -88,6 +91,11 @@ class CRoutine {
 
   std::chrono::steady_clock::time_point wake_time() const;
 
+  // Keeps the first notification time (ns) until TakeNotifyTime() is called
+  // for the resume it triggered.
+  void MarkNotified(uint64_t notify_time);
+  uint64_t TakeNotifyTime();
+
   void set_group_name(const std::string &group_name) {
     group_name_ = group_name;
   }
@@ -105,7 +113,7 @@ class CRoutine {
   RoutineFunc func_;
   RoutineState state_;
 
-  std::shared_ptr<RoutineContext> context_;
+  RoutineContext context_;
 
   std::atomic_flag lock_ = ATOMIC_FLAG_INIT;
   std::atomic_flag updated_ = ATOMIC_FLAG_INIT;
@@ -115,6 +123,7 @@ class CRoutine {
   int processor_id_ = -1;
   uint32_t priority_ = 0;
   uint64_t id_ = 0;
+  std::atomic<uint64_t> notify_time_ = {0};
 
   std::string group_name_;
 
@@ -136,9 +145,9 @@ inline CRoutine *CRoutine::GetCurrentRoutine() { return current_routine_; }
 
 inline char **CRoutine::GetMainStack() { return &main_stack_; }
 
-inline RoutineContext *CRoutine::GetContext() { return context_.get(); }
+inline RoutineContext *CRoutine::GetContext() { return &context_; }
 
-inline char **CRoutine::GetStack() { return &(context_->sp); }
+inline char **CRoutine::GetStack() { return &(context_.sp); }
 
 inline void CRoutine::Run() { func_(); }
 
@@ -190,6 +199,16 @@ inline RoutineState CRoutine::UpdateState() {
   return state_;
 }
 
+inline void CRoutine::MarkNotified(uint64_t notify_time) {
+  uint64_t expected = 0;
+  notify_time_.compare_exchange_strong(expected, notify_time,
+                                       std::memory_order_relaxed);
+}
+
+inline uint64_t CRoutine::TakeNotifyTime() {
+  return notify_time_.exchange(0, std::memory_order_relaxed);
+}
+
 inline uint32_t CRoutine::priority() const { return priority_; }
 
 inline void CRoutine::set_priority(uint32_t priority) { priority_ = priority; }
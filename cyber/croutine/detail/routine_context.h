@@ -40,13 +40,10 @@ constexpr size_t REGISTERS_SIZE = 56;
 
 typedef void (*func)(void*);
 struct RoutineContext {
-  char stack[STACK_SIZE];
+  char* stack = nullptr;  /// lowest address, page aligned
+  size_t stack_size = 0;
   char* sp = nullptr;
-#if defined __aarch64__
-} __attribute__((aligned(16)));
-#else
 };
-#endif
 
 void MakeContext(const func& f1, const void* arg, RoutineContext* ctx);
 
@@ -0,0 +1,201 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "cyber/croutine/detail/stack_pool.h"
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <string>
+
+#include "cyber/common/log.h"
+#include "cyber/croutine/detail/routine_context.h"
+
+namespace apollo {
+namespace cyber {
+namespace croutine {
+
+namespace {
+
+constexpr size_t kDefaultClassKb[] = {128, 512, STACK_SIZE / 1024};
+
+std::vector<size_t> ParseKbList(const char* value) {
+  std::vector<size_t> sizes;
+  std::stringstream ss(value);
+  std::string item;
+  while (std::getline(ss, item, ',')) {
+    char* end = nullptr;
+    uint64_t kb = std::strtoull(item.c_str(), &end, 10);
+    if (end != item.c_str() && kb > 0) {
+      sizes.push_back(kb * 1024);
+    }
+  }
+  return sizes;
+}
+
+}  // namespace
+
+StackPool::StackPool() {
+  long page_size = sysconf(_SC_PAGESIZE);
+  if (page_size > 0) {
+    page_size_ = static_cast<size_t>(page_size);
+  }
+  guard_size_ = page_size_;
+  const char* guard_kb = std::getenv("CYBER_ROUTINE_GUARD_KB");
+  if (guard_kb != nullptr) {
+    size_t size = std::strtoull(guard_kb, nullptr, 10) * 1024;
+    // at least one page, the guard is what makes an overflow fault
+    guard_size_ = std::max(page_size_, (size + page_size_ - 1) /
+                                           page_size_ * page_size_);
+  }
+
+  const char* class_kb = std::getenv("CYBER_ROUTINE_STACK_KB");
+  if (class_kb != nullptr) {
+    class_sizes_ = ParseKbList(class_kb);
+  }
+  if (class_sizes_.empty()) {
+    for (auto kb : kDefaultClassKb) {
+      class_sizes_.push_back(kb * 1024);
+    }
+  }
+  // the default stack must always be pooled
+  class_sizes_.push_back(STACK_SIZE);
+  for (auto& size : class_sizes_) {
+    size = (size + page_size_ - 1) / page_size_ * page_size_;
+  }
+  std::sort(class_sizes_.begin(), class_sizes_.end());
+  class_sizes_.erase(std::unique(class_sizes_.begin(), class_sizes_.end()),
+                     class_sizes_.end());
+  for (size_t i = 0; i < class_sizes_.size(); ++i) {
+    classes_.emplace_back(new SizeClass());
+  }
+}
+
+StackPool::~StackPool() {
+  for (size_t i = 0; i < classes_.size(); ++i) {
+    for (auto stack : classes_[i]->free_stacks) {
+      Unmap(stack, class_sizes_[i]);
+    }
+  }
+}
+
+char* StackPool::Allocate(size_t size, size_t* stack_size) {
+  int index = FindClass(size);
+  if (index < 0) {
+    *stack_size = (size + page_size_ - 1) / page_size_ * page_size_;
+    return Map(*stack_size);
+  }
+
+  *stack_size = class_sizes_[index];
+  auto& size_class = *classes_[index];
+  {
+    std::lock_guard<std::mutex> lock(size_class.mutex);
+    if (!size_class.free_stacks.empty()) {
+      char* stack = size_class.free_stacks.back();
+      size_class.free_stacks.pop_back();
+      return stack;
+    }
+  }
+  return Map(*stack_size);
+}
+
+void StackPool::Free(char* stack, size_t stack_size) {
+  if (stack == nullptr) {
+    return;
+  }
+  int index = FindClass(stack_size);
+  if (index >= 0 && class_sizes_[index] == stack_size) {
+    auto& size_class = *classes_[index];
+    std::lock_guard<std::mutex> lock(size_class.mutex);
+    if (size_class.free_stacks.size() < max_cached_.load()) {
+      size_class.free_stacks.push_back(stack);
+      return;
+    }
+  }
+  Unmap(stack, stack_size);
+}
+
+void StackPool::Reserve(size_t size, uint32_t num, size_t prefault) {
+  int index = FindClass(size);
+  if (index < 0) {
+    return;
+  }
+  size_t stack_size = class_sizes_[index];
+  prefault = std::min(prefault, stack_size);
+  std::vector<char*> stacks;
+  for (uint32_t i = 0; i < num; ++i) {
+    char* stack = Map(stack_size);
+    if (stack == nullptr) {
+      break;
+    }
+    // a croutine starts at the top of its stack and grows down
+    for (size_t offset = page_size_; offset <= prefault;
+         offset += page_size_) {
+      stack[stack_size - offset] = 0;
+    }
+    stacks.push_back(stack);
+  }
+  auto& size_class = *classes_[index];
+  std::lock_guard<std::mutex> lock(size_class.mutex);
+  size_class.free_stacks.insert(size_class.free_stacks.end(), stacks.begin(),
+                                stacks.end());
+}
+
+size_t StackPool::CachedCount(size_t stack_size) {
+  int index = FindClass(stack_size);
+  if (index < 0) {
+    return 0;
+  }
+  std::lock_guard<std::mutex> lock(classes_[index]->mutex);
+  return classes_[index]->free_stacks.size();
+}
+
+int StackPool::FindClass(size_t size) const {
+  auto it = std::lower_bound(class_sizes_.begin(), class_sizes_.end(), size);
+  if (it == class_sizes_.end()) {
+    return -1;
+  }
+  return static_cast<int>(it - class_sizes_.begin());
+}
+
+char* StackPool::Map(size_t stack_size) {
+  void* addr =
+      mmap(nullptr, guard_size_ + stack_size, PROT_READ | PROT_WRITE,
+           MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE | MAP_STACK, -1, 0);
+  if (addr == MAP_FAILED) {
+    AERROR << "map croutine stack of " << stack_size
+           << " bytes failed: " << std::strerror(errno);
+    return nullptr;
+  }
+  if (mprotect(addr, guard_size_, PROT_NONE) != 0) {
+    AWARN << "protect croutine stack guard failed: " << std::strerror(errno);
+  }
+  return static_cast<char*>(addr) + guard_size_;
+}
+
+void StackPool::Unmap(char* stack, size_t stack_size) {
+  munmap(stack - guard_size_, guard_size_ + stack_size);
+}
+
+}  // namespace croutine
+}  // namespace cyber
+}  // namespace apollo
@@ -0,0 +1,100 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#ifndef CYBER_CROUTINE_DETAIL_STACK_POOL_H_
+#define CYBER_CROUTINE_DETAIL_STACK_POOL_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "cyber/common/macros.h"
+
+namespace apollo {
+namespace cyber {
+namespace croutine {
+
+/**
+ * @class StackPool
+ * @brief Hands out croutine stacks from a set of size classes and keeps the
+ * released ones for reuse, so creating a croutine costs neither an
+ * allocation nor the page faults of a fresh stack once the pool is warm.
+ *
+ * Every stack is its own mapping with inaccessible guard pages below it: an
+ * overflow faults instead of silently corrupting the neighbouring stack.
+ * The size classes come from `CYBER_ROUTINE_STACK_KB` (e.g.
+ * "64,256,2048"), the guard size from `CYBER_ROUTINE_GUARD_KB`.
+ */
+class StackPool {
+ public:
+  virtual ~StackPool();
+
+  /**
+   * @brief Get a stack of at least `size` bytes from the smallest class that
+   * fits. Larger requests get a dedicated mapping which is not reused.
+   *
+   * @return the lowest usable address, nullptr if the mapping failed
+   */
+  char* Allocate(size_t size, size_t* stack_size);
+
+  /**
+   * @brief Give back a stack, `stack_size` as returned by `Allocate`.
+   */
+  void Free(char* stack, size_t stack_size);
+
+  /**
+   * @brief Map `num` stacks of the class fitting `size` ahead of time and
+   * touch their top `prefault` bytes, where a croutine starts.
+   */
+  void Reserve(size_t size, uint32_t num, size_t prefault);
+
+  /**
+   * @brief Number of released stacks kept per class, the rest is unmapped.
+   */
+  void SetMaxCached(size_t max_cached) { max_cached_ = max_cached; }
+
+  const std::vector<size_t>& size_classes() const { return class_sizes_; }
+  size_t guard_size() const { return guard_size_; }
+  size_t CachedCount(size_t stack_size);
+
+ private:
+  struct SizeClass {
+    std::mutex mutex;
+    std::vector<char*> free_stacks;
+  };
+
+  int FindClass(size_t size) const;
+  char* Map(size_t stack_size);
+  void Unmap(char* stack, size_t stack_size);
+
+  size_t page_size_ = 4096;
+  size_t guard_size_ = 4096;
+  std::atomic<size_t> max_cached_ = {1024};
+  std::vector<size_t> class_sizes_;
+  std::vector<std::unique_ptr<SizeClass>> classes_;
+
+  DECLARE_SINGLETON(StackPool)
+};
+
+}  // namespace croutine
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_CROUTINE_DETAIL_STACK_POOL_H_
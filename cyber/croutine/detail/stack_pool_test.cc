@@ -0,0 +1,117 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "cyber/croutine/detail/stack_pool.h"
+
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "cyber/croutine/detail/routine_context.h"
+
+namespace apollo {
+namespace cyber {
+namespace croutine {
+
+TEST(StackPoolTest, size_class) {
+  auto pool = StackPool::Instance();
+  auto& classes = pool->size_classes();
+  ASSERT_FALSE(classes.empty());
+  EXPECT_EQ(STACK_SIZE, classes.back());
+
+  size_t stack_size = 0;
+  char* stack = pool->Allocate(1, &stack_size);
+  ASSERT_NE(nullptr, stack);
+  EXPECT_EQ(classes.front(), stack_size);
+  pool->Free(stack, stack_size);
+
+  stack = pool->Allocate(classes.front() + 1, &stack_size);
+  ASSERT_NE(nullptr, stack);
+  EXPECT_GT(stack_size, classes.front());
+  pool->Free(stack, stack_size);
+
+  // larger than every class: a dedicated mapping, never cached
+  size_t cached = pool->CachedCount(STACK_SIZE);
+  stack = pool->Allocate(STACK_SIZE * 2, &stack_size);
+  ASSERT_NE(nullptr, stack);
+  EXPECT_EQ(STACK_SIZE * 2, stack_size);
+  stack[0] = 1;
+  stack[stack_size - 1] = 1;
+  pool->Free(stack, stack_size);
+  EXPECT_EQ(cached, pool->CachedCount(STACK_SIZE));
+}
+
+TEST(StackPoolTest, reuse) {
+  auto pool = StackPool::Instance();
+  size_t stack_size = 0;
+  char* stack = pool->Allocate(STACK_SIZE, &stack_size);
+  ASSERT_NE(nullptr, stack);
+  stack[stack_size - 1] = 1;
+  pool->Free(stack, stack_size);
+
+  size_t reused_size = 0;
+  EXPECT_EQ(stack, pool->Allocate(STACK_SIZE, &reused_size));
+  EXPECT_EQ(stack_size, reused_size);
+  pool->Free(stack, stack_size);
+
+  size_t cached = pool->CachedCount(STACK_SIZE);
+  pool->Reserve(STACK_SIZE, 4, 16 * 1024);
+  EXPECT_EQ(cached + 4, pool->CachedCount(STACK_SIZE));
+
+  pool->SetMaxCached(cached + 2);
+  std::vector<char*> stacks;
+  for (int i = 0; i < 6; ++i) {
+    stacks.push_back(pool->Allocate(STACK_SIZE, &stack_size));
+  }
+  for (auto s : stacks) {
+    pool->Free(s, stack_size);
+  }
+  EXPECT_EQ(cached + 2, pool->CachedCount(STACK_SIZE));
+  pool->SetMaxCached(1024);
+}
+
+TEST(StackPoolTest, concurrent) {
+  auto pool = StackPool::Instance();
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([pool]() {
+      for (int i = 0; i < 1000; ++i) {
+        size_t stack_size = 0;
+        char* stack = pool->Allocate(i % 2 ? 1 : STACK_SIZE, &stack_size);
+        ASSERT_NE(nullptr, stack);
+        stack[stack_size - 1] = static_cast<char>(i);
+        pool->Free(stack, stack_size);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+TEST(StackPoolDeathTest, guard_page) {
+  size_t stack_size = 0;
+  char* stack = StackPool::Instance()->Allocate(1, &stack_size);
+  ASSERT_NE(nullptr, stack);
+  EXPECT_DEATH({ *(static_cast<volatile char*>(stack) - 1) = 1; }, "");
+  StackPool::Instance()->Free(stack, stack_size);
+}
+
+}  // namespace croutine
+}  // namespace cyber
+}  // namespace apollo
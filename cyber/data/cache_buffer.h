@@ -17,6 +17,8 @@
 #ifndef CYBER_DATA_CACHE_BUFFER_H_
 #define CYBER_DATA_CACHE_BUFFER_H_
 
+#include <atomic>
+#include <chrono>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -26,6 +28,15 @@ namespace apollo {
 namespace cyber {
 namespace data {
 
+/**
+ * @class CacheBuffer
+ * @brief Ring buffer behind a ChannelBuffer. Writers always serialize on
+ * Mutex(). By default readers take it too; a buffer built with
+ * `lock_free_read` instead publishes every Fill through a sequence counter,
+ * so readers go through Read() without touching the mutex and retry when a
+ * writer got in between. That mode requires T to be a std::shared_ptr, slots
+ * are then accessed with the shared_ptr atomic functions.
+ */
 template <typename T>
 class CacheBuffer {
  public:
@@ -33,51 +44,123 @@ class CacheBuffer {
   using size_type = std::size_t;
   using FusionCallback = std::function<void(const T&)>;
 
-  explicit CacheBuffer(uint64_t size) {
+  explicit CacheBuffer(uint64_t size, bool lock_free_read = false)
+      : lock_free_read_(lock_free_read) {
     capacity_ = size + 1;
     buffer_.resize(capacity_);
   }
 
   CacheBuffer(const CacheBuffer& rhs) {
     std::lock_guard<std::mutex> lg(rhs.mutex_);
-    head_ = rhs.head_;
-    tail_ = rhs.tail_;
+    head_.store(rhs.head_.load(std::memory_order_relaxed),
+                std::memory_order_relaxed);
+    tail_.store(rhs.tail_.load(std::memory_order_relaxed),
+                std::memory_order_relaxed);
     buffer_ = rhs.buffer_;
     capacity_ = rhs.capacity_;
+    lock_free_read_ = rhs.lock_free_read_;
     fusion_callback_ = rhs.fusion_callback_;
+    if (rhs.deadline_ns_ > 0) {
+      SetDeadline(rhs.deadline_ns_);
+      for (uint64_t i = 0; i < capacity_; ++i) {
+        fill_times_[i].store(rhs.fill_times_[i].load());
+      }
+    }
   }
 
   T& operator[](const uint64_t& pos) { return buffer_[GetIndex(pos)]; }
   const T& at(const uint64_t& pos) const { return buffer_[GetIndex(pos)]; }
 
-  uint64_t Head() const { return head_ + 1; }
-  uint64_t Tail() const { return tail_; }
-  uint64_t Size() const { return tail_ - head_; }
+  uint64_t Head() const { return head() + 1; }
+  uint64_t Tail() const { return tail(); }
+  uint64_t Size() const { return tail() - head(); }
 
-  const T& Front() const { return buffer_[GetIndex(head_ + 1)]; }
-  const T& Back() const { return buffer_[GetIndex(tail_)]; }
+  const T& Front() const { return buffer_[GetIndex(head() + 1)]; }
+  const T& Back() const { return buffer_[GetIndex(tail())]; }
 
-  bool Empty() const { return tail_ == 0; }
-  bool Full() const { return capacity_ - 1 == tail_ - head_; }
+  bool Empty() const { return tail() == 0; }
+  bool Full() const { return capacity_ - 1 == tail() - head(); }
   uint64_t Capacity() const { return capacity_; }
 
+  bool LockFreeRead() const { return lock_free_read_; }
+
   void SetFusionCallback(const FusionCallback& callback) {
     fusion_callback_ = callback;
   }
 
+  /**
+   * @brief Time every Fill, so that Expired() tells the values which stayed
+   * longer than `deadline_ns` in the buffer. Set it before the first Fill.
+   */
+  void SetDeadline(uint64_t deadline_ns) {
+    deadline_ns_ = deadline_ns;
+    fill_times_.reset(deadline_ns > 0 ? new std::atomic<uint64_t>[capacity_]()
+                                      : nullptr);
+  }
+  uint64_t Deadline() const { return deadline_ns_; }
+
+  bool Expired(const uint64_t& pos, uint64_t now_ns) const {
+    return deadline_ns_ > 0 &&
+           now_ns - fill_times_[GetIndex(pos)].load(
+                        std::memory_order_relaxed) > deadline_ns_;
+  }
+
+  static uint64_t NowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+  }
+
   void Fill(const T& value) {
     if (fusion_callback_) {
       fusion_callback_(value);
+    } else if (lock_free_read_) {
+      PublishFill(value);
     } else {
       if (Full()) {
-        buffer_[GetIndex(head_)] = value;
-        ++head_;
-        ++tail_;
+        buffer_[GetIndex(head())] = value;
+        head_.store(head() + 1, std::memory_order_relaxed);
       } else {
-        buffer_[GetIndex(tail_ + 1)] = value;
-        ++tail_;
+        buffer_[GetIndex(tail() + 1)] = value;
       }
+      StampFill(tail() + 1);
+      tail_.store(tail() + 1, std::memory_order_relaxed);
+    }
+  }
+
+  /**
+   * @brief Run `reader` against a consistent snapshot of a lock_free_read
+   * buffer. Inside it use Head()/Tail()/Empty()/Size() as usual and Load()
+   * instead of at(). Whatever `reader` returns is only trusted if no Fill
+   * overlapped it, otherwise it is run again. After `max_retry` failed rounds
+   * the mutex is taken so a busy writer cannot starve the reader.
+   */
+  template <typename Reader>
+  bool Read(Reader&& reader, int max_retry = 16) const {
+    for (int i = 0; i < max_retry; ++i) {
+      uint64_t seq = seq_.load(std::memory_order_acquire);
+      if (seq & 1) {
+        continue;
+      }
+      bool ret = reader();
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (seq_.load(std::memory_order_relaxed) == seq) {
+        return ret;
+      }
+    }
+    std::lock_guard<std::mutex> lg(mutex_);
+    return reader();
+  }
+
+  /**
+   * @brief Copy of the slot at `pos`, safe against a concurrent Fill in
+   * lock_free_read mode.
+   */
+  T Load(const uint64_t& pos) const {
+    if (lock_free_read_) {
+      return LoadSlot(&buffer_[GetIndex(pos)]);
     }
+    return buffer_[GetIndex(pos)];
   }
 
   std::mutex& Mutex() { return mutex_; }
@@ -86,12 +169,59 @@ class CacheBuffer {
   CacheBuffer& operator=(const CacheBuffer& other) = delete;
   uint64_t GetIndex(const uint64_t& pos) const { return pos % capacity_; }
 
-  uint64_t head_ = 0;
-  uint64_t tail_ = 0;
+  uint64_t head() const { return head_.load(std::memory_order_relaxed); }
+  uint64_t tail() const { return tail_.load(std::memory_order_relaxed); }
+
+  template <typename U>
+  static U LoadSlot(const U* slot) {
+    return *slot;
+  }
+  template <typename U>
+  static std::shared_ptr<U> LoadSlot(const std::shared_ptr<U>* slot) {
+    return std::atomic_load(slot);
+  }
+  template <typename U>
+  static void StoreSlot(U* slot, const U& value) {
+    *slot = value;
+  }
+  template <typename U>
+  static void StoreSlot(std::shared_ptr<U>* slot,
+                        const std::shared_ptr<U>& value) {
+    std::atomic_store(slot, value);
+  }
+
+  void StampFill(uint64_t pos) {
+    if (deadline_ns_ > 0) {
+      fill_times_[GetIndex(pos)].store(NowNs(), std::memory_order_relaxed);
+    }
+  }
+
+  // caller holds mutex_, readers see an odd seq_ while the ring is changing
+  void PublishFill(const T& value) {
+    uint64_t seq = seq_.load(std::memory_order_relaxed);
+    seq_.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    if (Full()) {
+      StoreSlot(&buffer_[GetIndex(head())], value);
+      head_.store(head() + 1, std::memory_order_relaxed);
+    } else {
+      StoreSlot(&buffer_[GetIndex(tail() + 1)], value);
+    }
+    StampFill(tail() + 1);
+    tail_.store(tail() + 1, std::memory_order_relaxed);
+    seq_.store(seq + 2, std::memory_order_release);
+  }
+
+  std::atomic<uint64_t> head_ = {0};
+  std::atomic<uint64_t> tail_ = {0};
+  std::atomic<uint64_t> seq_ = {0};
   uint64_t capacity_ = 0;
+  bool lock_free_read_ = false;
   std::vector<T> buffer_;
   mutable std::mutex mutex_;
   FusionCallback fusion_callback_;
+  uint64_t deadline_ns_ = 0;
+  std::unique_ptr<std::atomic<uint64_t>[]> fill_times_;
 };
 
 }  // namespace data
@@ -0,0 +1,120 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+// Compares reader throughput of a mutex protected CacheBuffer against the
+// lock_free_read one. One writer fills the buffer at a fixed rate while
+// several readers keep calling Latest() and Fetch(), like fusion readers do.
+//
+//   cache_buffer_benchmark [readers] [seconds] [writer_hz]
+
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "cyber/data/channel_buffer.h"
+
+namespace apollo {
+namespace cyber {
+namespace data {
+
+struct Result {
+  uint64_t reads = 0;
+  uint64_t writes = 0;
+};
+
+Result Run(bool lock_free, int readers, int seconds, int writer_hz) {
+  auto buffer = std::make_shared<ChannelBuffer<int>>(
+      0, new CacheBuffer<std::shared_ptr<int>>(10, lock_free));
+  std::atomic<bool> stop(false);
+  std::atomic<uint64_t> reads(0);
+  Result result;
+
+  std::thread writer([&]() {
+    auto period = std::chrono::nanoseconds(1000000000LL / writer_hz);
+    auto next = std::chrono::steady_clock::now();
+    int i = 0;
+    while (!stop.load(std::memory_order_relaxed)) {
+      {
+        std::lock_guard<std::mutex> lock(buffer->Buffer()->Mutex());
+        buffer->Buffer()->Fill(std::make_shared<int>(++i));
+      }
+      next += period;
+      std::this_thread::sleep_until(next);
+    }
+    result.writes = i;
+  });
+
+  std::vector<std::thread> threads;
+  for (int r = 0; r < readers; ++r) {
+    threads.emplace_back([&]() {
+      uint64_t count = 0;
+      uint64_t index = 0;
+      std::shared_ptr<int> msg;
+      while (!stop.load(std::memory_order_relaxed)) {
+        buffer->Latest(msg);
+        if (buffer->Fetch(&index, msg)) {
+          ++index;
+        }
+        count += 2;
+      }
+      reads.fetch_add(count);
+    });
+  }
+
+  std::this_thread::sleep_for(std::chrono::seconds(seconds));
+  stop = true;
+  writer.join();
+  for (auto& t : threads) {
+    t.join();
+  }
+  result.reads = reads.load();
+  return result;
+}
+
+}  // namespace data
+}  // namespace cyber
+}  // namespace apollo
+
+int main(int argc, char* argv[]) {
+  int readers = argc > 1 ? std::atoi(argv[1]) : 4;
+  int seconds = argc > 2 ? std::atoi(argv[2]) : 3;
+  int writer_hz = argc > 3 ? std::atoi(argv[3]) : 1000;
+  if (readers <= 0 || seconds <= 0 || writer_hz <= 0) {
+    std::fprintf(stderr, "usage: %s [readers] [seconds] [writer_hz]\n",
+                 argv[0]);
+    return -1;
+  }
+
+  std::printf("%d readers, %d s, writer at %d Hz\n", readers, seconds,
+              writer_hz);
+  for (bool lock_free : {false, true}) {
+    auto result =
+        apollo::cyber::data::Run(lock_free, readers, seconds, writer_hz);
+    double ns_per_read =
+        1e9 * seconds * readers / static_cast<double>(result.reads);
+    std::printf("%-10s reads/s %12.0f  ns/read %8.1f  writes %" PRIu64 "\n",
+                lock_free ? "lock_free" : "mutex",
+                static_cast<double>(result.reads) / seconds, ns_per_read,
+                result.writes);
+  }
+  return 0;
+}
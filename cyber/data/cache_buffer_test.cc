@@ -53,6 +53,32 @@ TEST(CacheBufferTest, cache_buffer_test) {
   EXPECT_TRUE(buffer1.Full());
 }
 
+TEST(CacheBufferTest, lock_free_read) {
+  CacheBuffer<std::shared_ptr<int>> buffer(2, true);
+  EXPECT_TRUE(buffer.LockFreeRead());
+  buffer.Fill(std::make_shared<int>(1));
+  buffer.Fill(std::make_shared<int>(2));
+  buffer.Fill(std::make_shared<int>(3));
+  EXPECT_TRUE(buffer.Full());
+  EXPECT_EQ(2, buffer.Head());
+  EXPECT_EQ(3, buffer.Tail());
+
+  int sum = 0;
+  EXPECT_TRUE(buffer.Read([&]() {
+    sum = 0;
+    for (auto i = buffer.Head(); i <= buffer.Tail(); ++i) {
+      sum += *buffer.Load(i);
+    }
+    return true;
+  }));
+  EXPECT_EQ(5, sum);
+  EXPECT_FALSE(buffer.Read([]() { return false; }));
+
+  CacheBuffer<std::shared_ptr<int>> buffer1(buffer);
+  EXPECT_TRUE(buffer1.LockFreeRead());
+  EXPECT_EQ(3, *buffer1.Load(buffer1.Tail()));
+}
+
 }  // namespace data
 }  // namespace cyber
 }  // namespace apollo
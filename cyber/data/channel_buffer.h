@@ -20,11 +20,13 @@
 #include <algorithm>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 #include "cyber/common/global_data.h"
 #include "cyber/common/log.h"
 #include "cyber/data/data_notifier.h"
+#include "cyber/transport/common/channel_statistics.h"
 
 namespace apollo {
 namespace cyber {
@@ -45,63 +47,192 @@ class ChannelBuffer {
 
   bool FetchMulti(uint64_t fetch_size, std::vector<std::shared_ptr<T>>* vec);
 
+  /**
+   * @brief Fetch every message from `*index` to the latest one and move
+   * `*index` past it. Messages already overwritten are skipped with a warning.
+   *
+   * Fetch and FetchAll skip the messages older than the deadline of the
+   * buffer, if it has one, see CacheBuffer::SetDeadline.
+   */
+  bool FetchAll(uint64_t* index, std::vector<std::shared_ptr<T>>* vec);
+
   uint64_t channel_id() const { return channel_id_; }
   std::shared_ptr<BufferType> Buffer() const { return buffer_; }
 
  private:
+  // runs `reader` under the buffer mutex, or lock free if the buffer allows
+  template <typename Reader>
+  bool Read(Reader&& reader);
+  void WarnOverflow(uint64_t dropped, uint64_t index, uint64_t tail) const;
+  // moves `*next` past the messages older than the deadline of the buffer,
+  // which are the oldest ones, and returns how many there were
+  uint64_t SkipExpired(uint64_t* next, uint64_t tail) const;
+  void CountExpired(uint64_t expired) const;
+
   uint64_t channel_id_;
   std::shared_ptr<BufferType> buffer_;
 };
 
 template <typename T>
-bool ChannelBuffer<T>::Fetch(uint64_t* index,
-                             std::shared_ptr<T>& m) {  // NOLINT
-  std::lock_guard<std::mutex> lock(buffer_->Mutex());
-  if (buffer_->Empty()) {
-    return false;
+template <typename Reader>
+bool ChannelBuffer<T>::Read(Reader&& reader) {
+  if (buffer_->LockFreeRead()) {
+    return buffer_->Read(reader);
   }
+  std::lock_guard<std::mutex> lock(buffer_->Mutex());
+  return reader();
+}
 
-  if (*index == 0) {
-    *index = buffer_->Tail();
-  } else if (*index == buffer_->Tail() + 1) {
-    return false;
-  } else if (*index < buffer_->Head()) {
-    auto interval = buffer_->Tail() - *index;
-    AWARN << "channel[" << GlobalData::GetChannelById(channel_id_) << "] "
-          << "read buffer overflow, drop_message[" << interval << "] pre_index["
-          << *index << "] current_index[" << buffer_->Tail() << "] ";
-    *index = buffer_->Tail();
+template <typename T>
+void ChannelBuffer<T>::WarnOverflow(uint64_t dropped, uint64_t index,
+                                    uint64_t tail) const {
+  transport::ChannelStatistics::Instance()->AddDropped(channel_id_, dropped);
+  AWARN << "channel[" << GlobalData::GetChannelById(channel_id_) << "] "
+        << "read buffer overflow, drop_message[" << dropped << "] pre_index["
+        << index << "] current_index[" << tail << "] ";
+}
+
+template <typename T>
+uint64_t ChannelBuffer<T>::SkipExpired(uint64_t* next, uint64_t tail) const {
+  if (buffer_->Deadline() == 0) {
+    return 0;
+  }
+  uint64_t expired = 0;
+  auto now = BufferType::NowNs();
+  for (; *next <= tail && buffer_->Expired(*next, now); ++*next) {
+    ++expired;
   }
-  m = buffer_->at(*index);
-  return true;
+  return expired;
 }
 
 template <typename T>
-bool ChannelBuffer<T>::Latest(std::shared_ptr<T>& m) {  // NOLINT
-  std::lock_guard<std::mutex> lock(buffer_->Mutex());
-  if (buffer_->Empty()) {
+void ChannelBuffer<T>::CountExpired(uint64_t expired) const {
+  transport::ChannelStatistics::Instance()->AddDropped(channel_id_, expired);
+  ADEBUG << "channel[" << GlobalData::GetChannelById(channel_id_) << "] "
+         << "drop_message[" << expired << "] older than the deadline";
+}
+
+template <typename T>
+bool ChannelBuffer<T>::Fetch(uint64_t* index,
+                             std::shared_ptr<T>& m) {  // NOLINT
+  uint64_t next = 0;
+  uint64_t dropped = 0;
+  uint64_t expired = 0;
+  uint64_t tail = 0;
+  bool found = false;
+  auto fetch = [&]() {
+    next = *index;
+    dropped = 0;
+    if (buffer_->Empty()) {
+      return false;
+    }
+
+    tail = buffer_->Tail();
+    if (next == 0) {
+      next = tail;
+    } else if (next == tail + 1) {
+      return false;
+    } else if (next < buffer_->Head()) {
+      dropped = tail - next;
+      next = tail;
+    }
+    expired = SkipExpired(&next, tail);
+    found = next <= tail;
+    if (found) {
+      m = buffer_->Load(next);
+    }
+    return true;
+  };
+  if (!Read(fetch)) {
     return false;
   }
+  if (dropped > 0) {
+    WarnOverflow(dropped, *index, tail);
+  }
+  if (expired > 0) {
+    CountExpired(expired);
+  }
+  *index = next;
+  return found;
+}
 
-  m = buffer_->Back();
-  return true;
+template <typename T>
+bool ChannelBuffer<T>::Latest(std::shared_ptr<T>& m) {  // NOLINT
+  return Read([&]() {
+    if (buffer_->Empty()) {
+      return false;
+    }
+
+    m = buffer_->Load(buffer_->Tail());
+    return true;
+  });
 }
 
 template <typename T>
 bool ChannelBuffer<T>::FetchMulti(uint64_t fetch_size,
                                   std::vector<std::shared_ptr<T>>* vec) {
-  std::lock_guard<std::mutex> lock(buffer_->Mutex());
-  if (buffer_->Empty()) {
+  auto size = vec->size();
+  return Read([&]() {
+    vec->resize(size);
+    if (buffer_->Empty()) {
+      return false;
+    }
+
+    auto num = std::min(buffer_->Size(), fetch_size);
+    vec->reserve(size + num);
+    for (auto index = buffer_->Tail() - num + 1; index <= buffer_->Tail();
+         ++index) {
+      vec->emplace_back(buffer_->Load(index));
+    }
+    return true;
+  });
+}
+
+template <typename T>
+bool ChannelBuffer<T>::FetchAll(uint64_t* index,
+                                std::vector<std::shared_ptr<T>>* vec) {
+  auto size = vec->size();
+  uint64_t next = 0;
+  uint64_t dropped = 0;
+  uint64_t expired = 0;
+  uint64_t tail = 0;
+  bool found = false;
+  auto fetch = [&]() {
+    vec->resize(size);
+    next = *index;
+    dropped = 0;
+    tail = buffer_->Tail();
+    if (buffer_->Empty() || next == tail + 1) {
+      return false;
+    }
+
+    auto head = buffer_->Head();
+    if (next == 0) {
+      next = head;
+    } else if (next < head) {
+      dropped = head - next;
+      next = head;
+    }
+    expired = SkipExpired(&next, tail);
+    found = next <= tail;
+
+    vec->reserve(size + tail - next + 1);
+    for (; next <= tail; ++next) {
+      vec->emplace_back(buffer_->Load(next));
+    }
+    return true;
+  };
+  if (!Read(fetch)) {
     return false;
   }
-
-  auto num = std::min(buffer_->Size(), fetch_size);
-  vec->reserve(num);
-  for (auto index = buffer_->Tail() - num + 1; index <= buffer_->Tail();
-       ++index) {
-    vec->emplace_back(buffer_->at(index));
+  if (dropped > 0) {
+    WarnOverflow(dropped, *index, tail);
+  }
+  if (expired > 0) {
+    CountExpired(expired);
   }
-  return true;
+  *index = next;
+  return found;
 }
 
 }  // namespace data
@@ -16,7 +16,9 @@
 
 #include "cyber/data/channel_buffer.h"
 
+#include <chrono>
 #include <memory>
+#include <thread>
 #include <vector>
 
 #include "gtest/gtest.h"
@@ -69,6 +71,56 @@ TEST(ChannelBufferTest, Latest) {
   EXPECT_EQ(2, *msg);
 }
 
+TEST(ChannelBufferTest, FetchAll) {
+  auto cache_buffer = new CacheBuffer<std::shared_ptr<int>>(3);
+  auto buffer = std::make_shared<ChannelBuffer<int>>(channel0, cache_buffer);
+  std::vector<std::shared_ptr<int>> vector;
+  uint64_t index = 0;
+  EXPECT_FALSE(buffer->FetchAll(&index, &vector));
+
+  buffer->Buffer()->Fill(std::make_shared<int>(1));
+  buffer->Buffer()->Fill(std::make_shared<int>(2));
+  EXPECT_TRUE(buffer->FetchAll(&index, &vector));
+  ASSERT_EQ(2, vector.size());
+  EXPECT_EQ(1, *vector[0]);
+  EXPECT_EQ(2, *vector[1]);
+  EXPECT_EQ(3, index);
+  EXPECT_FALSE(buffer->FetchAll(&index, &vector));
+
+  // 3 and 4 fit, 5 and 6 push the oldest ones out
+  vector.clear();
+  for (int i = 3; i <= 6; ++i) {
+    buffer->Buffer()->Fill(std::make_shared<int>(i));
+  }
+  EXPECT_TRUE(buffer->FetchAll(&index, &vector));
+  ASSERT_EQ(3, vector.size());
+  EXPECT_EQ(4, *vector[0]);
+  EXPECT_EQ(6, *vector[2]);
+  EXPECT_EQ(7, index);
+}
+
+TEST(ChannelBufferTest, Deadline) {
+  auto cache_buffer = new CacheBuffer<std::shared_ptr<int>>(4);
+  cache_buffer->SetDeadline(20 * 1000 * 1000);
+  auto buffer = std::make_shared<ChannelBuffer<int>>(channel0, cache_buffer);
+  std::shared_ptr<int> msg;
+  std::vector<std::shared_ptr<int>> vector;
+  uint64_t index = 1;
+  buffer->Buffer()->Fill(std::make_shared<int>(1));
+  buffer->Buffer()->Fill(std::make_shared<int>(2));
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_FALSE(buffer->Fetch(&index, msg));
+  EXPECT_EQ(3, index);
+
+  buffer->Buffer()->Fill(std::make_shared<int>(3));
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  buffer->Buffer()->Fill(std::make_shared<int>(4));
+  EXPECT_TRUE(buffer->FetchAll(&index, &vector));
+  ASSERT_EQ(1, vector.size());
+  EXPECT_EQ(4, *vector[0]);
+  EXPECT_EQ(5, index);
+}
+
 TEST(ChannelBufferTest, FetchMulti) {
   auto cache_buffer = new CacheBuffer<std::shared_ptr<int>>(2);
   auto buffer = std::make_shared<ChannelBuffer<int>>(channel0, cache_buffer);
@@ -98,6 +150,63 @@ TEST(ChannelBufferTest, FetchMulti) {
   EXPECT_EQ(2, *vector[1]);
 }
 
+TEST(ChannelBufferTest, LockFreeRead) {
+  auto cache_buffer = new CacheBuffer<std::shared_ptr<int>>(3, true);
+  auto buffer = std::make_shared<ChannelBuffer<int>>(channel0, cache_buffer);
+  std::shared_ptr<int> msg;
+  uint64_t index = 0;
+  EXPECT_FALSE(buffer->Fetch(&index, msg));
+  EXPECT_FALSE(buffer->Latest(msg));
+
+  for (int i = 1; i <= 5; ++i) {
+    buffer->Buffer()->Fill(std::make_shared<int>(i));
+  }
+  index = 1;
+  EXPECT_TRUE(buffer->Fetch(&index, msg));
+  EXPECT_EQ(5, *msg);
+  EXPECT_EQ(5, index);
+  EXPECT_TRUE(buffer->Latest(msg));
+  EXPECT_EQ(5, *msg);
+
+  std::vector<std::shared_ptr<int>> vector;
+  EXPECT_TRUE(buffer->FetchMulti(2, &vector));
+  ASSERT_EQ(2, vector.size());
+  EXPECT_EQ(4, *vector[0]);
+  EXPECT_EQ(5, *vector[1]);
+
+  vector.clear();
+  index = 0;
+  EXPECT_TRUE(buffer->FetchAll(&index, &vector));
+  ASSERT_EQ(3, vector.size());
+  EXPECT_EQ(3, *vector[0]);
+  EXPECT_EQ(6, index);
+}
+
+TEST(ChannelBufferTest, LockFreeReadConcurrent) {
+  auto cache_buffer = new CacheBuffer<std::shared_ptr<int>>(4, true);
+  auto buffer = std::make_shared<ChannelBuffer<int>>(channel0, cache_buffer);
+  const int kCount = 100000;
+  std::thread writer([&buffer, kCount]() {
+    for (int i = 1; i <= kCount; ++i) {
+      std::lock_guard<std::mutex> lock(buffer->Buffer()->Mutex());
+      buffer->Buffer()->Fill(std::make_shared<int>(i));
+    }
+  });
+
+  // every fetched message must match its index, and indexes only grow
+  uint64_t index = 0;
+  uint64_t last = 0;
+  std::shared_ptr<int> msg;
+  while (last < kCount) {
+    if (buffer->Fetch(&index, msg)) {
+      ASSERT_EQ(index, static_cast<uint64_t>(*msg));
+      ASSERT_GT(index, last);
+      last = index++;
+    }
+  }
+  writer.join();
+}
+
 }  // namespace data
 }  // namespace cyber
 }  // namespace apollo
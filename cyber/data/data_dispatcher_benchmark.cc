@@ -0,0 +1,88 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+// Microbenchmark of the fan-out of DataDispatcher, which fills the cache
+// buffer of every reader of a channel and runs their notifiers. For results
+// to keep across releases, write them as json:
+//
+//   data_dispatcher_benchmark --benchmark_out_format=json
+//       --benchmark_out=data.json
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "cyber/common/util.h"
+#include "cyber/data/data_dispatcher.h"
+
+namespace apollo {
+namespace cyber {
+namespace data {
+
+namespace {
+
+struct Readers {
+  std::vector<std::shared_ptr<ChannelBuffer<int>>> buffers;
+  std::vector<std::shared_ptr<Notifier>> notifiers;
+};
+
+// the dispatcher keeps readers for good, so every reader number registers
+// its own channel once
+uint64_t RegisterReaders(int reader_num) {
+  static std::map<int, Readers> readers_map;
+  uint64_t channel_id =
+      common::Hash("/benchmark/data/" + std::to_string(reader_num));
+  if (readers_map.count(reader_num) > 0) {
+    return channel_id;
+  }
+  auto& readers = readers_map[reader_num];
+  for (int i = 0; i < reader_num; ++i) {
+    auto buffer = std::make_shared<ChannelBuffer<int>>(
+        channel_id, new CacheBuffer<std::shared_ptr<int>>(10));
+    DataDispatcher<int>::Instance()->AddBuffer(*buffer);
+    auto notifier = std::make_shared<Notifier>();
+    notifier->callback = []() {};
+    DataNotifier::Instance()->AddNotifier(channel_id, notifier);
+    readers.buffers.emplace_back(buffer);
+    readers.notifiers.emplace_back(notifier);
+  }
+  return channel_id;
+}
+
+}  // namespace
+
+void BM_DataDispatcherFanOut(benchmark::State& state) {
+  const uint64_t channel_id =
+      RegisterReaders(static_cast<int>(state.range(0)));
+  auto msg = std::make_shared<int>(0);
+  for (auto _ : state) {
+    if (!DataDispatcher<int>::Instance()->Dispatch(channel_id, msg)) {
+      state.SkipWithError("dispatch failed");
+      break;
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_DataDispatcherFanOut)->RangeMultiplier(4)->Range(1, 64);
+
+}  // namespace data
+}  // namespace cyber
+}  // namespace apollo
+
+BENCHMARK_MAIN();
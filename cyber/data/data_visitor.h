@@ -34,10 +34,12 @@ namespace cyber {
 namespace data {
 
 struct VisitorConfig {
-  VisitorConfig(uint64_t id, uint32_t size)
-      : channel_id(id), queue_size(size) {}
+  VisitorConfig(uint64_t id, uint32_t size, bool lock_free = false)
+      : channel_id(id), queue_size(size), lock_free_read(lock_free) {}
   uint64_t channel_id;
   uint32_t queue_size;
+  // read the channel buffer without taking its mutex, see CacheBuffer
+  bool lock_free_read;
 };
 
 template <typename T>
@@ -49,13 +51,17 @@ class DataVisitor : public DataVisitorBase {
  public:
   explicit DataVisitor(const std::vector<VisitorConfig>& configs)
       : buffer_m0_(configs[0].channel_id,
-                   new BufferType<M0>(configs[0].queue_size)),
+                   new BufferType<M0>(configs[0].queue_size,
+                                       configs[0].lock_free_read)),
         buffer_m1_(configs[1].channel_id,
-                   new BufferType<M1>(configs[1].queue_size)),
+                   new BufferType<M1>(configs[1].queue_size,
+                                       configs[1].lock_free_read)),
         buffer_m2_(configs[2].channel_id,
-                   new BufferType<M2>(configs[2].queue_size)),
+                   new BufferType<M2>(configs[2].queue_size,
+                                       configs[2].lock_free_read)),
         buffer_m3_(configs[3].channel_id,
-                   new BufferType<M3>(configs[3].queue_size)) {
+                   new BufferType<M3>(configs[3].queue_size,
+                                       configs[3].lock_free_read)) {
     DataDispatcher<M0>::Instance()->AddBuffer(buffer_m0_);
     DataDispatcher<M1>::Instance()->AddBuffer(buffer_m1_);
     DataDispatcher<M2>::Instance()->AddBuffer(buffer_m2_);
@@ -94,11 +100,14 @@ class DataVisitor<M0, M1, M2, NullType> : public DataVisitorBase {
  public:
   explicit DataVisitor(const std::vector<VisitorConfig>& configs)
       : buffer_m0_(configs[0].channel_id,
-                   new BufferType<M0>(configs[0].queue_size)),
+                   new BufferType<M0>(configs[0].queue_size,
+                                       configs[0].lock_free_read)),
         buffer_m1_(configs[1].channel_id,
-                   new BufferType<M1>(configs[1].queue_size)),
+                   new BufferType<M1>(configs[1].queue_size,
+                                       configs[1].lock_free_read)),
         buffer_m2_(configs[2].channel_id,
-                   new BufferType<M2>(configs[2].queue_size)) {
+                   new BufferType<M2>(configs[2].queue_size,
+                                       configs[2].lock_free_read)) {
     DataDispatcher<M0>::Instance()->AddBuffer(buffer_m0_);
     DataDispatcher<M1>::Instance()->AddBuffer(buffer_m1_);
     DataDispatcher<M2>::Instance()->AddBuffer(buffer_m2_);
@@ -135,9 +144,11 @@ class DataVisitor<M0, M1, NullType, NullType> : public DataVisitorBase {
  public:
   explicit DataVisitor(const std::vector<VisitorConfig>& configs)
       : buffer_m0_(configs[0].channel_id,
-                   new BufferType<M0>(configs[0].queue_size)),
+                   new BufferType<M0>(configs[0].queue_size,
+                                       configs[0].lock_free_read)),
         buffer_m1_(configs[1].channel_id,
-                   new BufferType<M1>(configs[1].queue_size)) {
+                   new BufferType<M1>(configs[1].queue_size,
+                                       configs[1].lock_free_read)) {
     DataDispatcher<M0>::Instance()->AddBuffer(buffer_m0_);
     DataDispatcher<M1>::Instance()->AddBuffer(buffer_m1_);
     data_notifier_->AddNotifier(buffer_m0_.channel_id(), notifier_);
@@ -169,13 +180,17 @@ template <typename M0>
 class DataVisitor<M0, NullType, NullType, NullType> : public DataVisitorBase {
  public:
   explicit DataVisitor(const VisitorConfig& configs)
-      : buffer_(configs.channel_id, new BufferType<M0>(configs.queue_size)) {
+      : buffer_(configs.channel_id,
+                new BufferType<M0>(configs.queue_size,
+                                   configs.lock_free_read)) {
     DataDispatcher<M0>::Instance()->AddBuffer(buffer_);
     data_notifier_->AddNotifier(buffer_.channel_id(), notifier_);
   }
 
-  DataVisitor(uint64_t channel_id, uint32_t queue_size)
-      : buffer_(channel_id, new BufferType<M0>(queue_size)) {
+  DataVisitor(uint64_t channel_id, uint32_t queue_size,
+              bool lock_free_read = false, uint64_t deadline_ns = 0)
+      : buffer_(channel_id, new BufferType<M0>(queue_size, lock_free_read)) {
+    buffer_.Buffer()->SetDeadline(deadline_ns);
     DataDispatcher<M0>::Instance()->AddBuffer(buffer_);
     data_notifier_->AddNotifier(buffer_.channel_id(), notifier_);
   }
@@ -188,6 +203,10 @@ class DataVisitor<M0, NullType, NullType, NullType> : public DataVisitorBase {
     return false;
   }
 
+  bool TryFetchAll(std::vector<std::shared_ptr<M0>>* msgs) {
+    return buffer_.FetchAll(&next_msg_index_, msgs);
+  }
+
  private:
   ChannelBuffer<M0> buffer_;
 };
@@ -22,6 +22,7 @@
 
 #include <csignal>
 #include <cstdio>
+#include <cstdlib>
 #include <ctime>
 #include <memory>
 #include <string>
@@ -33,12 +34,18 @@
 #include "cyber/common/global_data.h"
 #include "cyber/data/data_dispatcher.h"
 #include "cyber/logger/async_logger.h"
+#include "cyber/logger/binary_logger.h"
 #include "cyber/node/node.h"
 #include "cyber/scheduler/scheduler.h"
 #include "cyber/service_discovery/topology_manager.h"
+#include "cyber/sysmo/alloc_tracker.h"
+#include "cyber/sysmo/heap_stats_publisher.h"
+#include "cyber/sysmo/scheduler_load_publisher.h"
 #include "cyber/sysmo/sysmo.h"
+#include "cyber/sysmo/transport_stats_publisher.h"
 #include "cyber/task/task.h"
 #include "cyber/time/clock.h"
+#include "cyber/timer/precise_timing_wheel.h"
 #include "cyber/timer/timing_wheel.h"
 #include "cyber/transport/transport.h"
 
@@ -52,6 +59,9 @@ namespace {
 
 const std::string& kClockChannel = "/clock";
 const std::string& kClockNode = "clock";
+const std::string& kTransportStatsNode = "transport_stats";
+const std::string& kSchedulerLoadNode = "scheduler_load";
+const std::string& kHeapStatsNode = "heap_stats";
 
 bool g_atexit_registered = false;
 std::mutex g_mutex;
@@ -78,9 +88,51 @@ void InitLogger(const char* binary_name) {
       google::base::GetLogger(FLAGS_minloglevel));
   google::base::SetLogger(FLAGS_minloglevel, async_logger);
   async_logger->Start();
+
+  // CYBER_BINARY_LOG=glog formats ALOG_BINARY records on the logger thread,
+  // any other value is the binary log file to append them to
+  const char* binary_log = std::getenv("CYBER_BINARY_LOG");
+  if (binary_log != nullptr && binary_log[0] != '\0') {
+    std::string path = binary_log;
+    if (path == "glog") {
+      path.clear();
+    }
+    logger::BinaryLogger::Instance()->Start(path);
+  }
+}
+
+void StopLogger() {
+  logger::BinaryLogger::CleanUp();
+  delete async_logger;
 }
 
-void StopLogger() { delete async_logger; }
+// CYBER_ALLOC_TRACKER=1 counts the allocations of every croutine, and samples
+// one every CYBER_ALLOC_SAMPLE_BYTES (default 512 KB, 0 for none) allocated
+// on a thread for the heap profile, CYBER_ALLOC_MAX_SAMPLES (default 20000)
+// at most.
+void InitAllocTracker() {
+  const char* enabled = std::getenv("CYBER_ALLOC_TRACKER");
+  if (enabled == nullptr || std::atoi(enabled) == 0) {
+    return;
+  }
+  uint64_t sample_bytes = 512 * 1024;
+  const char* bytes = std::getenv("CYBER_ALLOC_SAMPLE_BYTES");
+  if (bytes != nullptr && bytes[0] != '\0') {
+    sample_bytes = std::strtoull(bytes, nullptr, 10);
+  }
+  uint32_t max_samples = 20000;
+  const char* samples = std::getenv("CYBER_ALLOC_MAX_SAMPLES");
+  if (samples != nullptr && samples[0] != '\0') {
+    max_samples = static_cast<uint32_t>(std::strtoul(samples, nullptr, 10));
+  }
+  if (AllocTracker::Enable(sample_bytes, max_samples)) {
+    AINFO << "Allocation tracker enabled, sampling every " << sample_bytes
+          << " bytes.";
+  } else {
+    AWARN << "Allocation tracker is not available, malloc is not interposed "
+             "in this build.";
+  }
+}
 
 }  // namespace
 
@@ -100,6 +152,7 @@ bool Init(const char* binary_name) {
   }
 
   InitLogger(binary_name);
+  InitAllocTracker();
   auto thread = const_cast<std::thread*>(async_logger->LogThread());
   scheduler::Instance()->SetInnerThreadAttr("async_log", thread);
   SysMo::Instance();
@@ -127,6 +180,24 @@ bool Init(const char* binary_name) {
         };
     clock_node->CreateReader<apollo::cyber::proto::Clock>(kClockChannel, cb);
   }
+
+  if (transport::ChannelStatistics::Instance()->enabled()) {
+    auto node_name = kTransportStatsNode + std::to_string(getpid());
+    TransportStatsPublisher::Instance()->Start(
+        std::unique_ptr<Node>(new Node(node_name)));
+  }
+
+  if (scheduler::LoadTimeline::Enabled()) {
+    auto node_name = kSchedulerLoadNode + std::to_string(getpid());
+    SchedulerLoadPublisher::Instance()->Start(
+        std::unique_ptr<Node>(new Node(node_name)));
+  }
+
+  if (AllocTracker::enabled()) {
+    auto node_name = kHeapStatsNode + std::to_string(getpid());
+    HeapStatsPublisher::Instance()->Start(
+        std::unique_ptr<Node>(new Node(node_name)));
+  }
   return true;
 }
 
@@ -135,9 +206,13 @@ void Clear() {
   if (GetState() == STATE_SHUTDOWN || GetState() == STATE_UNINITIALIZED) {
     return;
   }
+  TransportStatsPublisher::CleanUp();
+  SchedulerLoadPublisher::CleanUp();
+  HeapStatsPublisher::CleanUp();
   SysMo::CleanUp();
   TaskManager::CleanUp();
   TimingWheel::CleanUp();
+  PreciseTimingWheel::CleanUp();
   scheduler::CleanUp();
   service_discovery::TopologyManager::CleanUp();
   transport::Transport::CleanUp();
@@ -18,6 +18,7 @@
 #define CYBER_IO_POLL_DATA_H_
 
 #include <sys/epoll.h>
+#include <sys/socket.h>
 
 #include <cstdint>
 #include <functional>
@@ -39,6 +40,53 @@ struct PollRequest {
   std::function<void(const PollResponse&)> callback = nullptr;
 };
 
+enum class IoOp {
+  kRead,
+  kWrite,
+  kRecv,
+  kSend,
+  kRecvMsg,
+  kSendMsg,
+  // receives into the registered buffers until it fails or is canceled,
+  // with one response per message, see Poller::GetBuffer()
+  kRecvMultishot,
+  kTimeout,
+  kCancel,
+};
+
+struct IoResponse {
+  // bytes transferred, or -errno
+  int32_t res = 0;
+  uint32_t flags = 0;
+  // whether more responses of a multishot request follow
+  bool more = false;
+};
+
+struct IoRequest {
+  IoOp op = IoOp::kRead;
+  int fd = -1;
+  void* buf = nullptr;
+  uint32_t len = 0;
+  // flags of recv/send
+  int msg_flags = 0;
+  // for kRecvMsg and kSendMsg, valid until the response
+  msghdr* msg = nullptr;
+  // > 0, the request is canceled after it; the delay of kTimeout
+  int timeout_ms = -1;
+  // the id of the request kCancel cancels
+  uint64_t target = 0;
+  std::function<void(const IoResponse&)> callback = nullptr;
+};
+
+// a message received into a registered buffer, valid until it is released
+struct RecvBuffer {
+  uint16_t id = 0;
+  const char* data = nullptr;
+  uint32_t size = 0;
+  const sockaddr* addr = nullptr;
+  socklen_t addrlen = 0;
+};
+
 struct PollCtrlParam {
   int operation;
   int fd;
@@ -16,6 +16,8 @@
 
 #include "cyber/io/poll_handler.h"
 
+#include <cerrno>
+
 #include "cyber/common/log.h"
 #include "cyber/io/poller.h"
 #include "cyber/scheduler/scheduler_factory.h"
@@ -27,6 +29,29 @@ namespace io {
 using croutine::CRoutine;
 using croutine::RoutineState;
 
+IoWaiter::IoWaiter()
+    : routine_(CRoutine::GetCurrentRoutine()), fired_(false) {}
+
+void IoWaiter::Wait() {
+  while (!fired_.load()) {
+    // IO_WAIT is set before checking again, so that a Fire() in between
+    // still finds the routine to notify
+    routine_->set_state(RoutineState::IO_WAIT);
+    if (fired_.load()) {
+      routine_->set_state(RoutineState::READY);
+      break;
+    }
+    CRoutine::Yield();
+  }
+}
+
+void IoWaiter::Fire() {
+  fired_.store(true);
+  if (routine_ != nullptr) {
+    scheduler::Instance()->NotifyTask(routine_->id());
+  }
+}
+
 PollHandler::PollHandler(int fd)
     : fd_(fd), is_read_(false), is_blocking_(false), routine_(nullptr) {}
 
@@ -63,6 +88,25 @@ bool PollHandler::Unblock() {
   return Poller::Instance()->Unregister(request_);
 }
 
+int32_t PollHandler::Await(IoRequest req) {
+  if (CRoutine::GetCurrentRoutine() == nullptr) {
+    AERROR << "routine nullptr, please use IO in routine context.";
+    return -EPERM;
+  }
+
+  auto waiter = std::make_shared<IoWaiter>();
+  auto result = std::make_shared<int32_t>(0);
+  req.callback = [waiter, result](const IoResponse& rsp) {
+    *result = rsp.res;
+    waiter->Fire();
+  };
+  if (Poller::Instance()->Submit(req) == 0) {
+    return -ECANCELED;
+  }
+  waiter->Wait();
+  return *result;
+}
+
 bool PollHandler::Check(int timeout_ms) {
   if (timeout_ms == 0) {
     AINFO << "timeout[" << timeout_ms
@@ -27,6 +27,23 @@ namespace apollo {
 namespace cyber {
 namespace io {
 
+/**
+ * @class IoWaiter
+ * @brief Parks the croutine that created it in IO_WAIT until Fire(), which
+ * may be called from any thread, also before the croutine parks.
+ */
+class IoWaiter {
+ public:
+  IoWaiter();
+
+  void Wait();
+  void Fire();
+
+ private:
+  croutine::CRoutine* routine_;
+  std::atomic<bool> fired_;
+};
+
 class PollHandler {
  public:
   explicit PollHandler(int fd);
@@ -35,6 +52,14 @@ class PollHandler {
   bool Block(int timeout_ms, bool is_read);
   bool Unblock();
 
+  /**
+   * @brief Submit `req` to the io_uring backend of the poller and yield until
+   * it completes, see Poller::Submit().
+   *
+   * @return the result of the request, -errno on failure
+   */
+  int32_t Await(IoRequest req);
+
   int fd() const { return fd_; }
   void set_fd(int fd) { fd_ = fd; }
 
@@ -20,7 +20,9 @@
 #include <sys/epoll.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <csignal>
+#include <cstdlib>
 #include <cstring>
 
 #include "cyber/common/log.h"
@@ -35,6 +37,33 @@ using base::AtomicRWLock;
 using base::ReadLockGuard;
 using base::WriteLockGuard;
 
+namespace {
+
+constexpr uint16_t kBufferGroup = 0;
+// user data of the poll on the epoll fd, ids of requests start from 1
+constexpr uint64_t kEpollData = 0;
+// user data of the completions nobody waits for
+constexpr uint64_t kIgnoredData = UINT64_MAX;
+// room for the source address in front of each received message
+constexpr uint32_t kRecvAddrLen = sizeof(sockaddr_storage);
+
+int64_t EnvInt(const char* name, int64_t default_value) {
+  const char* value = std::getenv(name);
+  if (value == nullptr || *value == '\0') {
+    return default_value;
+  }
+  char* end = nullptr;
+  int64_t result = std::strtoll(value, &end, 10);
+  return *end == '\0' && result > 0 ? result : default_value;
+}
+
+void SetTimeout(int timeout_ms, __kernel_timespec* ts) {
+  ts->tv_sec = timeout_ms / 1000;
+  ts->tv_nsec = (timeout_ms % 1000) * 1000000LL;
+}
+
+}  // namespace
+
 Poller::Poller() {
   if (!Init()) {
     AERROR << "Poller init failed!";
@@ -143,6 +172,11 @@ bool Poller::Init() {
   };
   requests_[request->fd] = request;
 
+  if (EnvInt("CYBER_IO_URING", 0) == 1 && !InitUring()) {
+    AWARN << "io_uring is unavailable, fall back to epoll only.";
+    uring_.reset();
+  }
+
   PollCtrlParam ctrl_param{};
   ctrl_param.operation = EPOLL_CTL_ADD;
   ctrl_param.fd = pipe_fd_[0];
@@ -181,12 +215,111 @@ void Poller::Clear() {
     requests_.clear();
     ctrl_params_.clear();
   }
+
+  if (uring_ != nullptr) {
+    uring_->Clear();
+    // wake up whoever waits for the requests left
+    std::vector<IoOperationPtr> pending_ops;
+    {
+      std::lock_guard<std::mutex> lock(ops_mutex_);
+      pending_ops.swap(pending_ops_);
+    }
+    for (auto& item : ops_) {
+      pending_ops.emplace_back(std::move(item.second));
+    }
+    ops_.clear();
+    IoResponse response;
+    response.res = -ECANCELED;
+    for (auto& op : pending_ops) {
+      if (op->req.callback != nullptr) {
+        op->req.callback(response);
+      }
+    }
+  }
+}
+
+bool Poller::InitUring() {
+  uring_.reset(new Uring());
+  auto entries = static_cast<uint32_t>(EnvInt("CYBER_IO_URING_ENTRIES", 256));
+  if (!uring_->Init(entries)) {
+    return false;
+  }
+  auto buf_size =
+      static_cast<uint32_t>(EnvInt("CYBER_IO_URING_BUFFER_SIZE", 4096));
+  auto buf_num = EnvInt("CYBER_IO_URING_BUFFER_NUM", 1024);
+  if (buf_size <= sizeof(io_uring_recvmsg_out) + kRecvAddrLen ||
+      !uring_->RegisterBuffers(kBufferGroup, buf_size,
+                               static_cast<uint16_t>(buf_num))) {
+    // single shot requests still go through the ring
+    AWARN << "no registered buffers, multishot receive is disabled.";
+  }
+  return true;
+}
+
+uint64_t Poller::Submit(const IoRequest& req) {
+  if (is_shutdown_.load() || uring_ == nullptr) {
+    return 0;
+  }
+  if (req.op == IoOp::kRecvMultishot && !uring_->has_buffers()) {
+    return 0;
+  }
+  if (req.op != IoOp::kCancel && req.callback == nullptr) {
+    AERROR << "input is invalid";
+    return 0;
+  }
+
+  IoOperationPtr op(new IoOperation());
+  op->id = next_op_id_.fetch_add(1);
+  op->req = req;
+  uint64_t id = op->id;
+  {
+    std::lock_guard<std::mutex> lock(ops_mutex_);
+    pending_ops_.emplace_back(std::move(op));
+  }
+  if (waiting_.load()) {
+    Notify();
+  }
+  return id;
+}
+
+bool Poller::Cancel(uint64_t id) {
+  IoRequest req;
+  req.op = IoOp::kCancel;
+  req.target = id;
+  return Submit(req) != 0;
+}
+
+bool Poller::GetBuffer(const IoResponse& rsp, RecvBuffer* buffer) const {
+  if (rsp.res < 0 || !(rsp.flags & IORING_CQE_F_BUFFER) ||
+      !uring_->has_buffers()) {
+    return false;
+  }
+  buffer->id = static_cast<uint16_t>(rsp.flags >> IORING_CQE_BUFFER_SHIFT);
+  const char* base = uring_->Buffer(buffer->id);
+  auto out = reinterpret_cast<const io_uring_recvmsg_out*>(base);
+  uint32_t offset = sizeof(io_uring_recvmsg_out) + kRecvAddrLen;
+  buffer->addr = reinterpret_cast<const sockaddr*>(base + sizeof(*out));
+  buffer->addrlen = std::min(out->namelen, kRecvAddrLen);
+  buffer->data = base + offset;
+  // what did not fit in the buffer of a datagram is cut off
+  buffer->size = std::min(out->payloadlen,
+                          static_cast<uint32_t>(rsp.res) - offset);
+  return true;
+}
+
+void Poller::ReleaseBuffer(uint16_t id) {
+  std::lock_guard<std::mutex> lock(buffer_mutex_);
+  if (uring_->has_buffers()) {
+    uring_->ProvideBuffer(id);
+  }
 }
 
 void Poller::Poll(int timeout_ms) {
   epoll_event evt[kPollSize];
   auto before_time_ns = Time::Now().ToNanosecond();
-  int ready_num = epoll_wait(epoll_fd_, evt, kPollSize, timeout_ms);
+  int ready_num = uring_ != nullptr
+                      ? WaitUring(timeout_ms, evt)
+                      : epoll_wait(epoll_fd_, evt, kPollSize, timeout_ms);
   auto after_time_ns = Time::Now().ToNanosecond();
   int interval_ms =
       static_cast<int>((after_time_ns - before_time_ns) / 1000000);
@@ -244,6 +377,175 @@ void Poller::Poll(int timeout_ms) {
   }
 }
 
+int Poller::WaitUring(int timeout_ms, epoll_event* evt) {
+  // the epoll fd is polled once at a time, which completes right away while
+  // it has ready events, just like epoll_wait
+  if (!epoll_armed_) {
+    ReserveSqes(1);
+    auto sqe = uring_->GetSqe();
+    sqe->opcode = IORING_OP_POLL_ADD;
+    sqe->fd = epoll_fd_;
+    sqe->poll32_events = EPOLLIN;
+    sqe->user_data = kEpollData;
+    epoll_armed_ = true;
+  }
+
+  waiting_.store(true);
+  PrepareOperations();
+  int res = uring_->Enter(1, timeout_ms);
+  waiting_.store(false);
+  if (res < 0 && res != -ETIME && res != -EINTR && res != -EBUSY) {
+    AERROR << "io_uring enter failed, " << strerror(-res);
+  }
+
+  bool epoll_ready = false;
+  uring_->ForEachCqe([this, &epoll_ready](const io_uring_cqe& cqe) {
+    Complete(cqe, &epoll_ready);
+  });
+  if (!epoll_ready) {
+    return 0;
+  }
+  return epoll_wait(epoll_fd_, evt, kPollSize, 0);
+}
+
+void Poller::PrepareOperations() {
+  std::vector<IoOperationPtr> pending_ops;
+  {
+    std::lock_guard<std::mutex> lock(ops_mutex_);
+    if (pending_ops_.empty()) {
+      return;
+    }
+    pending_ops.swap(pending_ops_);
+  }
+
+  for (auto& op : pending_ops) {
+    if (!Prepare(op.get())) {
+      IoResponse response;
+      response.res = -EINVAL;
+      op->req.callback(response);
+      continue;
+    }
+    if (op->req.op != IoOp::kCancel) {
+      ops_[op->id] = std::move(op);
+    }
+  }
+}
+
+bool Poller::Prepare(IoOperation* op) {
+  const auto& req = op->req;
+  // an operation and its linked timeout are submitted together
+  ReserveSqes(2);
+  auto sqe = uring_->GetSqe();
+  sqe->fd = req.fd;
+  sqe->user_data = op->id;
+  sqe->addr = reinterpret_cast<uint64_t>(req.buf);
+  sqe->len = req.len;
+  sqe->msg_flags = static_cast<uint32_t>(req.msg_flags);
+  switch (req.op) {
+    case IoOp::kRead:
+      sqe->opcode = IORING_OP_READ;
+      // at the file position, like read
+      sqe->off = static_cast<uint64_t>(-1);
+      break;
+    case IoOp::kWrite:
+      sqe->opcode = IORING_OP_WRITE;
+      sqe->off = static_cast<uint64_t>(-1);
+      break;
+    case IoOp::kRecv:
+      sqe->opcode = IORING_OP_RECV;
+      break;
+    case IoOp::kSend:
+      sqe->opcode = IORING_OP_SEND;
+      break;
+    case IoOp::kRecvMsg:
+    case IoOp::kSendMsg:
+      sqe->opcode = req.op == IoOp::kRecvMsg ? IORING_OP_RECVMSG
+                                             : IORING_OP_SENDMSG;
+      sqe->addr = reinterpret_cast<uint64_t>(req.msg);
+      sqe->len = 1;
+      break;
+    case IoOp::kRecvMultishot:
+      // only the lengths of the header matter, the kernel lays out the
+      // address and the message in the buffer it picks
+      op->msg.msg_namelen = kRecvAddrLen;
+      sqe->opcode = IORING_OP_RECVMSG;
+      sqe->ioprio = IORING_RECV_MULTISHOT;
+      sqe->flags = IOSQE_BUFFER_SELECT;
+      sqe->buf_group = kBufferGroup;
+      sqe->addr = reinterpret_cast<uint64_t>(&op->msg);
+      sqe->len = 1;
+      return true;
+    case IoOp::kTimeout:
+      SetTimeout(std::max(req.timeout_ms, 0), &op->ts);
+      sqe->opcode = IORING_OP_TIMEOUT;
+      sqe->addr = reinterpret_cast<uint64_t>(&op->ts);
+      sqe->len = 1;
+      return true;
+    case IoOp::kCancel:
+      sqe->opcode = IORING_OP_ASYNC_CANCEL;
+      sqe->fd = -1;
+      sqe->addr = req.target;
+      sqe->len = 0;
+      sqe->user_data = kIgnoredData;
+      return true;
+    default:
+      sqe->opcode = IORING_OP_NOP;
+      sqe->user_data = kIgnoredData;
+      return false;
+  }
+
+  if (req.timeout_ms > 0) {
+    sqe->flags |= IOSQE_IO_LINK;
+    SetTimeout(req.timeout_ms, &op->ts);
+    auto timeout_sqe = uring_->GetSqe();
+    timeout_sqe->opcode = IORING_OP_LINK_TIMEOUT;
+    timeout_sqe->fd = -1;
+    timeout_sqe->addr = reinterpret_cast<uint64_t>(&op->ts);
+    timeout_sqe->len = 1;
+    timeout_sqe->user_data = kIgnoredData;
+  }
+  return true;
+}
+
+void Poller::ReserveSqes(uint32_t num) {
+  while (uring_->SqeSpace() < num) {
+    // the ring is full, submit what is prepared to make room
+    int res = uring_->Enter(0, 0);
+    if (res < 0 && res != -EINTR && res != -EBUSY) {
+      AERROR << "io_uring submit failed, " << strerror(-res);
+    }
+    uring_->ForEachCqe([this](const io_uring_cqe& cqe) {
+      bool epoll_ready = false;
+      Complete(cqe, &epoll_ready);
+    });
+  }
+}
+
+void Poller::Complete(const io_uring_cqe& cqe, bool* epoll_ready) {
+  if (cqe.user_data == kIgnoredData) {
+    return;
+  }
+  if (cqe.user_data == kEpollData) {
+    epoll_armed_ = false;
+    *epoll_ready = true;
+    return;
+  }
+
+  auto search = ops_.find(cqe.user_data);
+  if (search == ops_.end()) {
+    return;
+  }
+  IoResponse response;
+  response.res = cqe.res;
+  response.flags = cqe.flags;
+  response.more = (cqe.flags & IORING_CQE_F_MORE) != 0;
+  auto& op = search->second;
+  op->req.callback(response);
+  if (!response.more) {
+    ops_.erase(search);
+  }
+}
+
 void Poller::ThreadFunc() {
   // block all signals in this thread
   sigset_t signal_set;
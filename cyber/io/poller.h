@@ -28,6 +28,7 @@
 #include "cyber/base/atomic_rw_lock.h"
 #include "cyber/common/macros.h"
 #include "cyber/io/poll_data.h"
+#include "cyber/io/uring.h"
 
 namespace apollo {
 namespace cyber {
@@ -46,7 +47,48 @@ class Poller {
   bool Register(const PollRequest& req);
   bool Unregister(const PollRequest& req);
 
+  /**
+   * @brief Whether requests can be submitted: CYBER_IO_URING=1 selects the
+   * io_uring backend, which the kernel may not support.
+   */
+  bool UringEnabled() const { return uring_ != nullptr; }
+  bool BuffersEnabled() const {
+    return uring_ != nullptr && uring_->has_buffers();
+  }
+
+  /**
+   * @brief Queue `req` for the io_uring backend. The queued requests are
+   * submitted together with one system call, which also waits for the
+   * completions, on which the callback is called from the poller thread.
+   *
+   * @return the id of the request, 0 if it is not accepted
+   */
+  uint64_t Submit(const IoRequest& req);
+  bool Cancel(uint64_t id);
+
+  /**
+   * @brief The message of a kRecvMultishot response, which holds a
+   * registered buffer until ReleaseBuffer().
+   */
+  bool GetBuffer(const IoResponse& rsp, RecvBuffer* buffer) const;
+  void ReleaseBuffer(uint16_t id);
+
  private:
+  struct IoOperation {
+    uint64_t id = 0;
+    IoRequest req;
+    __kernel_timespec ts = {0, 0};
+    msghdr msg = {};
+  };
+  using IoOperationPtr = std::unique_ptr<IoOperation>;
+
+  bool InitUring();
+  int WaitUring(int timeout_ms, epoll_event* evt);
+  void PrepareOperations();
+  bool Prepare(IoOperation* op);
+  void ReserveSqes(uint32_t num);
+  void Complete(const io_uring_cqe& cqe, bool* epoll_ready);
+
   bool Init();
   void Clear();
   void Poll(int timeout_ms);
@@ -66,6 +108,18 @@ class Poller {
   CtrlParamMap ctrl_params_;
   base::AtomicRWLock poll_data_lock_;
 
+  std::unique_ptr<Uring> uring_;
+  // whether the epoll fd is polled by uring_
+  bool epoll_armed_ = false;
+  // whether the poller thread may be waiting, Submit() notifies it then
+  std::atomic<bool> waiting_ = {false};
+  std::atomic<uint64_t> next_op_id_ = {1};
+  std::vector<IoOperationPtr> pending_ops_;
+  std::mutex ops_mutex_;
+  // key: id, only touched by the poller thread
+  std::unordered_map<uint64_t, IoOperationPtr> ops_;
+  std::mutex buffer_mutex_;
+
   const int kPollSize = 32;
   const int kPollTimeoutMs = 100;
 
@@ -17,9 +17,14 @@
 #include "cyber/io/poller.h"
 
 #include <fcntl.h>
+#include <sys/socket.h>
 #include <unistd.h>
 
+#include <atomic>
+#include <mutex>
+#include <string>
 #include <thread>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -29,6 +34,82 @@ namespace apollo {
 namespace cyber {
 namespace io {
 
+// runs with the io_uring backend as poller_uring_test
+TEST(PollerTest, submit) {
+  auto poller = Poller::Instance();
+  ASSERT_NE(poller, nullptr);
+
+  std::atomic<int> res(1);
+  IoRequest request;
+  request.op = IoOp::kTimeout;
+  request.timeout_ms = 10;
+  request.callback = [&res](const IoResponse& rsp) { res = rsp.res; };
+  if (!poller->UringEnabled()) {
+    EXPECT_EQ(poller->Submit(request), 0);
+    return;
+  }
+  EXPECT_NE(poller->Submit(request), 0);
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_EQ(res, -ETIME);
+
+  int fds[2] = {-1, -1};
+  ASSERT_EQ(socketpair(AF_UNIX, SOCK_DGRAM | SOCK_NONBLOCK, 0, fds), 0);
+
+  // canceled after timeout_ms
+  char buf[8] = {0};
+  res = 1;
+  request.op = IoOp::kRecv;
+  request.fd = fds[0];
+  request.buf = buf;
+  request.len = sizeof(buf);
+  EXPECT_NE(poller->Submit(request), 0);
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_EQ(res, -ECANCELED);
+
+  res = 1;
+  request.timeout_ms = -1;
+  EXPECT_NE(poller->Submit(request), 0);
+  ASSERT_EQ(send(fds[1], "abc", 3, 0), 3);
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  EXPECT_EQ(res, 3);
+  EXPECT_EQ(std::string(buf, 3), "abc");
+
+  if (poller->BuffersEnabled()) {
+    std::mutex mutex;
+    std::vector<std::string> received;
+    std::atomic<bool> more(true);
+    request.op = IoOp::kRecvMultishot;
+    request.callback = [&](const IoResponse& rsp) {
+      RecvBuffer buffer;
+      if (poller->GetBuffer(rsp, &buffer)) {
+        std::lock_guard<std::mutex> lock(mutex);
+        received.emplace_back(buffer.data, buffer.size);
+        poller->ReleaseBuffer(buffer.id);
+      }
+      more = rsp.more;
+    };
+    auto id = poller->Submit(request);
+    EXPECT_NE(id, 0);
+    const std::vector<std::string> sent = {"a", "bb", "ccc"};
+    for (const auto& data : sent) {
+      ASSERT_EQ(send(fds[1], data.data(), data.size(), 0),
+                static_cast<ssize_t>(data.size()));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      EXPECT_EQ(received, sent);
+    }
+    EXPECT_TRUE(more);
+    EXPECT_TRUE(poller->Cancel(id));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_FALSE(more);
+  }
+
+  close(fds[0]);
+  close(fds[1]);
+}
+
 TEST(PollerTest, operation) {
   auto poller = Poller::Instance();
   ASSERT_NE(poller, nullptr);
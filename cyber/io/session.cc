@@ -16,18 +16,46 @@
 
 #include "cyber/io/session.h"
 
+#include <sys/uio.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <deque>
+#include <mutex>
+
 #include "cyber/common/log.h"
+#include "cyber/croutine/croutine.h"
+#include "cyber/io/poller.h"
 
 namespace apollo {
 namespace cyber {
 namespace io {
 
+using croutine::CRoutine;
+
+struct Session::RecvStream {
+  std::mutex mutex;
+  std::deque<IoResponse> responses;
+  // bytes of the first message taken already, for stream sockets
+  uint32_t offset = 0;
+  // id of the multishot receive, 0 if it is not armed
+  uint64_t id = 0;
+  bool is_stream = false;
+  bool disabled = false;
+  bool received = false;
+  bool closed = false;
+  std::shared_ptr<IoWaiter> waiter;
+};
+
 Session::Session() : Session(-1) {}
 
 Session::Session(int fd) : fd_(fd), poll_handler_(nullptr) {
   poll_handler_.reset(new PollHandler(fd_));
 }
 
+Session::~Session() { CloseRecvStream(); }
+
 int Session::Socket(int domain, int type, int protocol) {
   if (fd_ != -1) {
     AINFO << "session has hold a valid fd[" << fd_ << "]";
@@ -90,6 +118,7 @@ int Session::Close() {
   ACHECK(fd_ != -1);
 
   poll_handler_->Unblock();
+  CloseRecvStream();
   int res = close(fd_);
   fd_ = -1;
   return res;
@@ -99,6 +128,22 @@ ssize_t Session::Recv(void *buf, size_t len, int flags, int timeout_ms) {
   ACHECK(buf != nullptr);
   ACHECK(fd_ != -1);
 
+  if (UseUring()) {
+    ssize_t nbytes = -1;
+    if (flags == 0 && ReadRecvStream(buf, len, nullptr, nullptr, timeout_ms,
+                                     &nbytes)) {
+      return nbytes;
+    }
+    if (timeout_ms != 0) {
+      IoRequest req;
+      req.op = IoOp::kRecv;
+      req.buf = buf;
+      req.len = static_cast<uint32_t>(len);
+      req.msg_flags = flags;
+      return AwaitIo(req, timeout_ms);
+    }
+  }
+
   ssize_t nbytes = recv(fd_, buf, len, flags);
   if (timeout_ms == 0) {
     return nbytes;
@@ -121,6 +166,31 @@ ssize_t Session::RecvFrom(void *buf, size_t len, int flags,
   ACHECK(buf != nullptr);
   ACHECK(fd_ != -1);
 
+  if (UseUring()) {
+    ssize_t nbytes = -1;
+    if (flags == 0 && ReadRecvStream(buf, len, src_addr, addrlen, timeout_ms,
+                                     &nbytes)) {
+      return nbytes;
+    }
+    if (timeout_ms != 0) {
+      struct iovec iov = {buf, len};
+      struct msghdr msg = {};
+      msg.msg_name = src_addr;
+      msg.msg_namelen = addrlen != nullptr ? *addrlen : 0;
+      msg.msg_iov = &iov;
+      msg.msg_iovlen = 1;
+      IoRequest req;
+      req.op = IoOp::kRecvMsg;
+      req.msg = &msg;
+      req.msg_flags = flags;
+      nbytes = AwaitIo(req, timeout_ms);
+      if (nbytes >= 0 && addrlen != nullptr) {
+        *addrlen = msg.msg_namelen;
+      }
+      return nbytes;
+    }
+  }
+
   ssize_t nbytes = recvfrom(fd_, buf, len, flags, src_addr, addrlen);
   if (timeout_ms == 0) {
     return nbytes;
@@ -141,6 +211,15 @@ ssize_t Session::Send(const void *buf, size_t len, int flags, int timeout_ms) {
   ACHECK(buf != nullptr);
   ACHECK(fd_ != -1);
 
+  if (UseUring() && timeout_ms != 0) {
+    IoRequest req;
+    req.op = IoOp::kSend;
+    req.buf = const_cast<void *>(buf);
+    req.len = static_cast<uint32_t>(len);
+    req.msg_flags = flags;
+    return AwaitIo(req, timeout_ms);
+  }
+
   ssize_t nbytes = send(fd_, buf, len, flags);
   if (timeout_ms == 0) {
     return nbytes;
@@ -164,6 +243,20 @@ ssize_t Session::SendTo(const void *buf, size_t len, int flags,
   ACHECK(dest_addr != nullptr);
   ACHECK(fd_ != -1);
 
+  if (UseUring() && timeout_ms != 0) {
+    struct iovec iov = {const_cast<void *>(buf), len};
+    struct msghdr msg = {};
+    msg.msg_name = const_cast<struct sockaddr *>(dest_addr);
+    msg.msg_namelen = addrlen;
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    IoRequest req;
+    req.op = IoOp::kSendMsg;
+    req.msg = &msg;
+    req.msg_flags = flags;
+    return AwaitIo(req, timeout_ms);
+  }
+
   ssize_t nbytes = sendto(fd_, buf, len, flags, dest_addr, addrlen);
   if (timeout_ms == 0) {
     return nbytes;
@@ -184,6 +277,23 @@ ssize_t Session::Read(void *buf, size_t count, int timeout_ms) {
   ACHECK(buf != nullptr);
   ACHECK(fd_ != -1);
 
+  if (UseUring()) {
+    // once armed, the messages of the socket only come from the stream
+    ssize_t nbytes = -1;
+    if (recv_stream_ != nullptr && ReadRecvStream(buf, count, nullptr,
+                                                  nullptr, timeout_ms,
+                                                  &nbytes)) {
+      return nbytes;
+    }
+    if (timeout_ms != 0) {
+      IoRequest req;
+      req.op = IoOp::kRead;
+      req.buf = buf;
+      req.len = static_cast<uint32_t>(count);
+      return AwaitIo(req, timeout_ms);
+    }
+  }
+
   ssize_t nbytes = read(fd_, buf, count);
   if (timeout_ms == 0) {
     return nbytes;
@@ -204,6 +314,14 @@ ssize_t Session::Write(const void *buf, size_t count, int timeout_ms) {
   ACHECK(buf != nullptr);
   ACHECK(fd_ != -1);
 
+  if (UseUring() && timeout_ms != 0) {
+    IoRequest req;
+    req.op = IoOp::kWrite;
+    req.buf = const_cast<void *>(buf);
+    req.len = static_cast<uint32_t>(count);
+    return AwaitIo(req, timeout_ms);
+  }
+
   ssize_t nbytes = write(fd_, buf, count);
   if (timeout_ms == 0) {
     return nbytes;
@@ -220,6 +338,178 @@ ssize_t Session::Write(const void *buf, size_t count, int timeout_ms) {
   return nbytes;
 }
 
+bool Session::UseUring() const {
+  return Poller::Instance()->UringEnabled() &&
+         CRoutine::GetCurrentRoutine() != nullptr;
+}
+
+ssize_t Session::AwaitIo(IoRequest req, int timeout_ms) {
+  req.fd = fd_;
+  req.timeout_ms = timeout_ms;
+  int32_t res = poll_handler_->Await(req);
+  if (res < 0) {
+    // a request that timed out is canceled
+    errno = res == -ECANCELED && timeout_ms > 0 ? EAGAIN : -res;
+    return -1;
+  }
+  return res;
+}
+
+bool Session::ReadRecvStream(void *buf, size_t len, struct sockaddr *src_addr,
+                             socklen_t *addrlen, int timeout_ms,
+                             ssize_t *nbytes) {
+  auto poller = Poller::Instance();
+  if (recv_stream_ == nullptr) {
+    recv_stream_ = std::make_shared<RecvStream>();
+    int type = 0;
+    socklen_t optlen = sizeof(type);
+    recv_stream_->disabled =
+        !poller->BuffersEnabled() ||
+        getsockopt(fd_, SOL_SOCKET, SO_TYPE, &type, &optlen) != 0;
+    recv_stream_->is_stream = type == SOCK_STREAM;
+  }
+  auto stream = recv_stream_;
+  if (stream->disabled) {
+    return false;
+  }
+
+  while (true) {
+    std::shared_ptr<IoWaiter> waiter;
+    {
+      std::lock_guard<std::mutex> lock(stream->mutex);
+      if (!stream->responses.empty()) {
+        IoResponse rsp = stream->responses.front();
+        RecvBuffer buffer;
+        if (!poller->GetBuffer(rsp, &buffer)) {
+          stream->responses.pop_front();
+          if (rsp.res == -ENOBUFS) {
+            // it stopped as the buffers ran out, the rest is in the socket
+            continue;
+          }
+          if (rsp.res == -EINVAL && !stream->received) {
+            AWARN << "multishot receive is not supported, fall back.";
+            stream->disabled = true;
+            return false;
+          }
+          if (rsp.res < 0) {
+            errno = -rsp.res;
+          }
+          *nbytes = rsp.res < 0 ? -1 : 0;
+          return true;
+        }
+
+        stream->received = true;
+        size_t size = std::min(len, static_cast<size_t>(buffer.size) -
+                                        stream->offset);
+        memcpy(buf, buffer.data + stream->offset, size);
+        if (src_addr != nullptr && addrlen != nullptr) {
+          memcpy(src_addr, buffer.addr, std::min(*addrlen, buffer.addrlen));
+          *addrlen = buffer.addrlen;
+        }
+        // the rest of a datagram is discarded, like recv does
+        stream->offset += static_cast<uint32_t>(size);
+        if (!stream->is_stream || stream->offset == buffer.size) {
+          stream->offset = 0;
+          stream->responses.pop_front();
+          poller->ReleaseBuffer(buffer.id);
+        }
+        *nbytes = static_cast<ssize_t>(size);
+        return true;
+      }
+
+      if (stream->id == 0) {
+        IoRequest req;
+        req.op = IoOp::kRecvMultishot;
+        req.fd = fd_;
+        req.callback = [stream, poller](const IoResponse &rsp) {
+          std::shared_ptr<IoWaiter> waiter;
+          {
+            std::lock_guard<std::mutex> lock(stream->mutex);
+            if (!rsp.more) {
+              stream->id = 0;
+            }
+            if (stream->closed) {
+              RecvBuffer buffer;
+              if (poller->GetBuffer(rsp, &buffer)) {
+                poller->ReleaseBuffer(buffer.id);
+              }
+              return;
+            }
+            stream->responses.push_back(rsp);
+            waiter = stream->waiter;
+          }
+          if (waiter != nullptr) {
+            waiter->Fire();
+          }
+        };
+        stream->id = poller->Submit(req);
+        if (stream->id == 0) {
+          errno = ECANCELED;
+          *nbytes = -1;
+          return true;
+        }
+      }
+
+      if (timeout_ms == 0) {
+        errno = EAGAIN;
+        *nbytes = -1;
+        return true;
+      }
+      waiter = std::make_shared<IoWaiter>();
+      stream->waiter = waiter;
+    }
+
+    uint64_t timer = 0;
+    if (timeout_ms > 0) {
+      IoRequest req;
+      req.op = IoOp::kTimeout;
+      req.timeout_ms = timeout_ms;
+      req.callback = [waiter](const IoResponse &) { waiter->Fire(); };
+      timer = poller->Submit(req);
+    }
+    waiter->Wait();
+
+    bool timed_out = false;
+    {
+      std::lock_guard<std::mutex> lock(stream->mutex);
+      stream->waiter.reset();
+      timed_out = timeout_ms > 0 && stream->responses.empty();
+    }
+    if (timer != 0 && !timed_out) {
+      poller->Cancel(timer);
+    }
+    if (timed_out) {
+      errno = EAGAIN;
+      *nbytes = -1;
+      return true;
+    }
+  }
+}
+
+void Session::CloseRecvStream() {
+  auto poller = Poller::Instance(false);
+  if (recv_stream_ == nullptr || poller == nullptr) {
+    return;
+  }
+  uint64_t id = 0;
+  {
+    std::lock_guard<std::mutex> lock(recv_stream_->mutex);
+    recv_stream_->closed = true;
+    id = recv_stream_->id;
+    for (auto &rsp : recv_stream_->responses) {
+      RecvBuffer buffer;
+      if (poller->GetBuffer(rsp, &buffer)) {
+        poller->ReleaseBuffer(buffer.id);
+      }
+    }
+    recv_stream_->responses.clear();
+  }
+  if (id != 0) {
+    poller->Cancel(id);
+  }
+  recv_stream_.reset();
+}
+
 }  // namespace io
 }  // namespace cyber
 }  // namespace apollo
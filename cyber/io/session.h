@@ -30,6 +30,13 @@ namespace apollo {
 namespace cyber {
 namespace io {
 
+/**
+ * @class Session
+ * @brief Blocking-style socket IO inside croutines. With the io_uring backend
+ * of the poller, the operations of a croutine are submitted to it instead of
+ * retried after readiness, and Recv/RecvFrom with no flags take the messages
+ * of a multishot receive into registered buffers.
+ */
 class Session {
  public:
   using SessionPtr = std::shared_ptr<Session>;
@@ -37,7 +44,7 @@ class Session {
 
   Session();
   explicit Session(int fd);
-  virtual ~Session() = default;
+  virtual ~Session();
 
   int Socket(int domain, int type, int protocol);
   int Listen(int backlog);
@@ -64,13 +71,24 @@ class Session {
   int fd() const { return fd_; }
 
  private:
+  struct RecvStream;
+
   void set_fd(int fd) {
     fd_ = fd;
     poll_handler_->set_fd(fd);
   }
 
+  bool UseUring() const;
+  ssize_t AwaitIo(IoRequest req, int timeout_ms);
+  // false if the messages of this session can't come from a multishot
+  // receive, otherwise the result is put in `nbytes`
+  bool ReadRecvStream(void *buf, size_t len, struct sockaddr *src_addr,
+                      socklen_t *addrlen, int timeout_ms, ssize_t *nbytes);
+  void CloseRecvStream();
+
   int fd_;
   PollHandlerPtr poll_handler_;
+  std::shared_ptr<RecvStream> recv_stream_;
 };
 
 }  // namespace io
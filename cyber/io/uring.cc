@@ -0,0 +1,244 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/io/uring.h"
+
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace cyber {
+namespace io {
+
+namespace {
+
+int Setup(uint32_t entries, io_uring_params* params) {
+  return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+int Register(int fd, unsigned opcode, void* arg, unsigned nr_args) {
+  return static_cast<int>(
+      syscall(__NR_io_uring_register, fd, opcode, arg, nr_args));
+}
+
+void* MapRing(int fd, size_t size, off_t offset) {
+  void* ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                   MAP_SHARED | MAP_POPULATE, fd, offset);
+  return ptr == MAP_FAILED ? nullptr : ptr;
+}
+
+template <typename T>
+T* At(void* ring, uint32_t offset) {
+  return reinterpret_cast<T*>(static_cast<char*>(ring) + offset);
+}
+
+}  // namespace
+
+Uring::~Uring() { Clear(); }
+
+bool Uring::Init(uint32_t entries) {
+  io_uring_params params;
+  memset(&params, 0, sizeof(params));
+  // completions are only reaped by the thread that submits
+  params.flags = IORING_SETUP_SUBMIT_ALL | IORING_SETUP_COOP_TASKRUN;
+  ring_fd_ = Setup(entries, &params);
+  if (ring_fd_ < 0 && errno == EINVAL) {
+    memset(&params, 0, sizeof(params));
+    ring_fd_ = Setup(entries, &params);
+  }
+  if (ring_fd_ < 0) {
+    AWARN << "io_uring setup failed, " << strerror(errno);
+    return false;
+  }
+  if (!(params.features & IORING_FEAT_SINGLE_MMAP) ||
+      !(params.features & IORING_FEAT_EXT_ARG)) {
+    AWARN << "io_uring of this kernel is too old.";
+    Clear();
+    return false;
+  }
+
+  sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+  cq_ring_size_ =
+      params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+  sq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+  sq_ring_ = MapRing(ring_fd_, sq_ring_size_, IORING_OFF_SQ_RING);
+  cq_ring_ = sq_ring_;
+  sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+  void* sqes = MapRing(ring_fd_, sqes_size_, IORING_OFF_SQES);
+  if (sq_ring_ == nullptr || sqes == nullptr) {
+    AERROR << "map io_uring failed, " << strerror(errno);
+    if (sqes != nullptr) {
+      munmap(sqes, sqes_size_);
+    }
+    Clear();
+    return false;
+  }
+  sqes_ = static_cast<io_uring_sqe*>(sqes);
+
+  sq_head_ = At<uint32_t>(sq_ring_, params.sq_off.head);
+  sq_tail_ = At<uint32_t>(sq_ring_, params.sq_off.tail);
+  sq_mask_ = *At<uint32_t>(sq_ring_, params.sq_off.ring_mask);
+  sq_entries_ = params.sq_entries;
+  sqe_tail_ = *sq_tail_;
+  // entries are submitted in the order they are prepared
+  auto array = At<uint32_t>(sq_ring_, params.sq_off.array);
+  for (uint32_t i = 0; i < sq_entries_; ++i) {
+    array[i] = i;
+  }
+
+  cq_head_ = At<uint32_t>(cq_ring_, params.cq_off.head);
+  cq_tail_ = At<uint32_t>(cq_ring_, params.cq_off.tail);
+  cq_mask_ = *At<uint32_t>(cq_ring_, params.cq_off.ring_mask);
+  cqes_ = At<io_uring_cqe>(cq_ring_, params.cq_off.cqes);
+  return true;
+}
+
+void Uring::Clear() {
+  if (ring_fd_ >= 0) {
+    close(ring_fd_);
+    ring_fd_ = -1;
+  }
+  if (buf_ring_ != nullptr) {
+    munmap(buf_ring_, buf_ring_size_);
+    buf_ring_ = nullptr;
+  }
+  if (buffers_ != nullptr) {
+    munmap(buffers_, static_cast<size_t>(buf_size_) * buf_num_);
+    buffers_ = nullptr;
+  }
+  if (sqes_ != nullptr) {
+    munmap(sqes_, sqes_size_);
+    sqes_ = nullptr;
+  }
+  if (sq_ring_ != nullptr) {
+    munmap(sq_ring_, sq_ring_size_);
+    sq_ring_ = nullptr;
+    cq_ring_ = nullptr;
+  }
+}
+
+io_uring_sqe* Uring::GetSqe() {
+  uint32_t head = __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+  if (sqe_tail_ - head >= sq_entries_) {
+    return nullptr;
+  }
+  io_uring_sqe* sqe = &sqes_[sqe_tail_ & sq_mask_];
+  ++sqe_tail_;
+  memset(sqe, 0, sizeof(*sqe));
+  return sqe;
+}
+
+uint32_t Uring::SqeSpace() const {
+  uint32_t head = __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+  return sq_entries_ - (sqe_tail_ - head);
+}
+
+int Uring::Enter(uint32_t wait_nr, int timeout_ms) {
+  uint32_t to_submit = sqe_tail_ - *sq_tail_;
+  if (to_submit == 0 && wait_nr == 0) {
+    return 0;
+  }
+  __atomic_store_n(sq_tail_, sqe_tail_, __ATOMIC_RELEASE);
+
+  unsigned flags = IORING_ENTER_EXT_ARG;
+  if (wait_nr > 0) {
+    flags |= IORING_ENTER_GETEVENTS;
+  }
+  __kernel_timespec ts;
+  io_uring_getevents_arg arg;
+  memset(&arg, 0, sizeof(arg));
+  arg.sigmask_sz = _NSIG / 8;
+  if (wait_nr > 0 && timeout_ms >= 0) {
+    ts.tv_sec = timeout_ms / 1000;
+    ts.tv_nsec = (timeout_ms % 1000) * 1000000LL;
+    arg.ts = reinterpret_cast<uint64_t>(&ts);
+  }
+  int res = static_cast<int>(syscall(__NR_io_uring_enter, ring_fd_, to_submit,
+                                     wait_nr, flags, &arg, sizeof(arg)));
+  return res < 0 ? -errno : res;
+}
+
+bool Uring::RegisterBuffers(uint16_t group, uint32_t buf_size,
+                            uint16_t buf_num) {
+  if (buf_num == 0 || (buf_num & (buf_num - 1)) != 0 || buf_num > 32768) {
+    AERROR << "invalid buffer number " << buf_num;
+    return false;
+  }
+  buf_ring_size_ = buf_num * sizeof(io_uring_buf);
+  void* ring = mmap(nullptr, buf_ring_size_, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  void* buffers = mmap(nullptr, static_cast<size_t>(buf_size) * buf_num,
+                       PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS,
+                       -1, 0);
+  if (ring == MAP_FAILED || buffers == MAP_FAILED) {
+    AERROR << "allocate io_uring buffers failed, " << strerror(errno);
+    if (ring != MAP_FAILED) {
+      munmap(ring, buf_ring_size_);
+    }
+    if (buffers != MAP_FAILED) {
+      munmap(buffers, static_cast<size_t>(buf_size) * buf_num);
+    }
+    return false;
+  }
+
+  io_uring_buf_reg reg;
+  memset(&reg, 0, sizeof(reg));
+  reg.ring_addr = reinterpret_cast<uint64_t>(ring);
+  reg.ring_entries = buf_num;
+  reg.bgid = group;
+  if (Register(ring_fd_, IORING_REGISTER_PBUF_RING, &reg, 1) != 0) {
+    AWARN << "register io_uring buffers failed, " << strerror(errno);
+    munmap(ring, buf_ring_size_);
+    munmap(buffers, static_cast<size_t>(buf_size) * buf_num);
+    return false;
+  }
+
+  buf_ring_ = static_cast<io_uring_buf_ring*>(ring);
+  buffers_ = static_cast<char*>(buffers);
+  buf_size_ = buf_size;
+  buf_num_ = buf_num;
+  buf_tail_ = 0;
+  for (uint32_t id = 0; id < buf_num; ++id) {
+    ProvideBuffer(static_cast<uint16_t>(id));
+  }
+  return true;
+}
+
+void Uring::ProvideBuffer(uint16_t id) {
+  // in C++ the flexible array of io_uring_buf_ring starts after an empty
+  // struct, so the entries are addressed from the start of the ring; the
+  // tail is the reserved field of the first entry, so they are filled field
+  // by field
+  auto bufs = reinterpret_cast<io_uring_buf*>(buf_ring_);
+  io_uring_buf* buf = &bufs[buf_tail_ & (buf_num_ - 1)];
+  buf->addr = reinterpret_cast<uint64_t>(Buffer(id));
+  buf->len = buf_size_;
+  buf->bid = id;
+  ++buf_tail_;
+  __atomic_store_n(&bufs[0].resv, buf_tail_, __ATOMIC_RELEASE);
+}
+
+}  // namespace io
+}  // namespace cyber
+}  // namespace apollo
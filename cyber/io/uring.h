@@ -0,0 +1,129 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_IO_URING_H_
+#define CYBER_IO_URING_H_
+
+#include <linux/io_uring.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace apollo {
+namespace cyber {
+namespace io {
+
+/**
+ * @class Uring
+ * @brief An io_uring instance used through the raw system calls: the
+ * submission and completion rings mapped into this process, and one ring of
+ * provided buffers registered with the kernel, which picks a buffer for every
+ * receive that selects the group. Not thread safe.
+ */
+class Uring {
+ public:
+  Uring() = default;
+  virtual ~Uring();
+
+  bool Init(uint32_t entries);
+  void Clear();
+
+  /**
+   * @brief A zeroed submission entry to prepare, nullptr if the submission
+   * ring is full until Enter() is called.
+   */
+  io_uring_sqe* GetSqe();
+  uint32_t SqeSpace() const;
+
+  /**
+   * @brief Submit every entry prepared since the last call, and wait for
+   * `wait_nr` completions for at most `timeout_ms` (forever if negative),
+   * all in one system call.
+   *
+   * @return the number of entries submitted, -errno on failure (-ETIME when
+   * the wait timed out)
+   */
+  int Enter(uint32_t wait_nr, int timeout_ms);
+
+  /**
+   * @brief Hand the ready completions to `func` and consume them.
+   */
+  template <typename Func>
+  uint32_t ForEachCqe(const Func& func);
+
+  /**
+   * @brief Register `buf_num` buffers of `buf_size` bytes as `group`.
+   * `buf_num` is a power of two no larger than 32768.
+   */
+  bool RegisterBuffers(uint16_t group, uint32_t buf_size, uint16_t buf_num);
+
+  /**
+   * @brief Give buffer `id` back to the kernel once its data is consumed.
+   */
+  void ProvideBuffer(uint16_t id);
+
+  char* Buffer(uint16_t id) const { return buffers_ + id * buf_size_; }
+  uint32_t buf_size() const { return buf_size_; }
+  bool has_buffers() const { return buf_ring_ != nullptr; }
+  int fd() const { return ring_fd_; }
+
+ private:
+  int ring_fd_ = -1;
+
+  void* sq_ring_ = nullptr;
+  size_t sq_ring_size_ = 0;
+  void* cq_ring_ = nullptr;
+  size_t cq_ring_size_ = 0;
+  io_uring_sqe* sqes_ = nullptr;
+  size_t sqes_size_ = 0;
+
+  uint32_t* sq_head_ = nullptr;
+  uint32_t* sq_tail_ = nullptr;
+  uint32_t sq_mask_ = 0;
+  uint32_t sq_entries_ = 0;
+  // tail of the entries prepared, published to the kernel by Enter()
+  uint32_t sqe_tail_ = 0;
+
+  uint32_t* cq_head_ = nullptr;
+  uint32_t* cq_tail_ = nullptr;
+  uint32_t cq_mask_ = 0;
+  io_uring_cqe* cqes_ = nullptr;
+
+  io_uring_buf_ring* buf_ring_ = nullptr;
+  size_t buf_ring_size_ = 0;
+  char* buffers_ = nullptr;
+  uint32_t buf_size_ = 0;
+  uint16_t buf_num_ = 0;
+  uint16_t buf_tail_ = 0;
+};
+
+template <typename Func>
+uint32_t Uring::ForEachCqe(const Func& func) {
+  uint32_t head = *cq_head_;
+  uint32_t tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+  uint32_t count = tail - head;
+  for (; head != tail; ++head) {
+    func(cqes_[head & cq_mask_]);
+  }
+  __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+  return count;
+}
+
+}  // namespace io
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_IO_URING_H_
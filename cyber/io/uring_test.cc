@@ -0,0 +1,130 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/io/uring.h"
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace cyber {
+namespace io {
+
+TEST(UringTest, read) {
+  Uring ring;
+  // io_uring may be disabled on the host
+  if (!ring.Init(8)) {
+    return;
+  }
+
+  int pipe_fd[2] = {-1, -1};
+  ASSERT_EQ(pipe(pipe_fd), 0);
+  char buf[16] = {0};
+  // both are submitted with one call
+  for (int i = 0; i < 2; ++i) {
+    auto sqe = ring.GetSqe();
+    ASSERT_NE(sqe, nullptr);
+    sqe->opcode = IORING_OP_READ;
+    sqe->fd = pipe_fd[0];
+    sqe->addr = reinterpret_cast<uint64_t>(buf + i * 8);
+    sqe->len = 3;
+    sqe->off = static_cast<uint64_t>(-1);
+    sqe->user_data = i + 1;
+  }
+  EXPECT_EQ(ring.Enter(0, 0), 2);
+  EXPECT_EQ(ring.Enter(1, 10), -ETIME);
+
+  ASSERT_EQ(write(pipe_fd[1], "abcdef", 6), 6);
+  std::vector<io_uring_cqe> cqes;
+  while (cqes.size() < 2) {
+    ASSERT_GE(ring.Enter(1, 1000), 0);
+    ring.ForEachCqe(
+        [&cqes](const io_uring_cqe& cqe) { cqes.push_back(cqe); });
+  }
+  EXPECT_EQ(cqes[0].res, 3);
+  EXPECT_EQ(cqes[1].res, 3);
+  // reads pending together are not ordered
+  auto data = std::string(buf, 3) + std::string(buf + 8, 3);
+  EXPECT_TRUE(data == "abcdef" || data == "defabc");
+
+  close(pipe_fd[0]);
+  close(pipe_fd[1]);
+}
+
+TEST(UringTest, multishot_recv) {
+  Uring ring;
+  if (!ring.Init(8)) {
+    return;
+  }
+  if (!ring.RegisterBuffers(0, 512, 4)) {
+    return;
+  }
+  EXPECT_FALSE(ring.RegisterBuffers(1, 512, 3));
+
+  int fds[2] = {-1, -1};
+  ASSERT_EQ(socketpair(AF_UNIX, SOCK_DGRAM, 0, fds), 0);
+  msghdr msg;
+  memset(&msg, 0, sizeof(msg));
+  auto sqe = ring.GetSqe();
+  sqe->opcode = IORING_OP_RECVMSG;
+  sqe->fd = fds[0];
+  sqe->addr = reinterpret_cast<uint64_t>(&msg);
+  sqe->len = 1;
+  sqe->ioprio = IORING_RECV_MULTISHOT;
+  sqe->flags = IOSQE_BUFFER_SELECT;
+  sqe->buf_group = 0;
+  sqe->user_data = 7;
+  EXPECT_EQ(ring.Enter(0, 0), 1);
+
+  // more messages than buffers, the ones consumed are given back
+  const std::vector<std::string> sent = {"a", "bb", "ccc", "dddd", "eeeee",
+                                         "ffffff"};
+  std::vector<std::string> received;
+  for (size_t i = 0; i < sent.size(); ++i) {
+    ASSERT_EQ(send(fds[1], sent[i].data(), sent[i].size(), 0),
+              static_cast<ssize_t>(sent[i].size()));
+    bool more = false;
+    while (received.size() <= i) {
+      ASSERT_GE(ring.Enter(1, 1000), 0);
+      ring.ForEachCqe([&](const io_uring_cqe& cqe) {
+        ASSERT_EQ(cqe.user_data, 7);
+        ASSERT_GT(cqe.res, 0);
+        ASSERT_TRUE(cqe.flags & IORING_CQE_F_BUFFER);
+        more = (cqe.flags & IORING_CQE_F_MORE) != 0;
+        auto id = static_cast<uint16_t>(cqe.flags >> IORING_CQE_BUFFER_SHIFT);
+        auto out = reinterpret_cast<io_uring_recvmsg_out*>(ring.Buffer(id));
+        const char* payload = ring.Buffer(id) + sizeof(*out);
+        received.emplace_back(payload, out->payloadlen);
+        ring.ProvideBuffer(id);
+      });
+    }
+    EXPECT_TRUE(more);
+  }
+  EXPECT_EQ(received, sent);
+
+  close(fds[0]);
+  close(fds[1]);
+}
+
+}  // namespace io
+}  // namespace cyber
+}  // namespace apollo
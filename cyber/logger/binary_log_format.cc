@@ -0,0 +1,224 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "cyber/logger/binary_log_format.h"
+
+#include <cinttypes>
+#include <cstdio>
+#include <ctime>
+
+namespace apollo {
+namespace cyber {
+namespace logger {
+
+namespace {
+
+template <typename T>
+bool ReadValue(const char** data, const char* end, T* value) {
+  if (static_cast<size_t>(end - *data) < sizeof(T)) {
+    return false;
+  }
+  memcpy(value, *data, sizeof(T));
+  *data += sizeof(T);
+  return true;
+}
+
+bool AppendArg(const char** data, const char* end, std::string* text) {
+  uint8_t type = 0;
+  if (!ReadValue(data, end, &type)) {
+    return false;
+  }
+  switch (static_cast<BinaryArgType>(type)) {
+    case BinaryArgType::INT64: {
+      int64_t value = 0;
+      if (!ReadValue(data, end, &value)) {
+        return false;
+      }
+      text->append(std::to_string(value));
+      return true;
+    }
+    case BinaryArgType::UINT64: {
+      uint64_t value = 0;
+      if (!ReadValue(data, end, &value)) {
+        return false;
+      }
+      text->append(std::to_string(value));
+      return true;
+    }
+    case BinaryArgType::DOUBLE: {
+      double value = 0;
+      if (!ReadValue(data, end, &value)) {
+        return false;
+      }
+      char buffer[32];
+      snprintf(buffer, sizeof(buffer), "%g", value);
+      text->append(buffer);
+      return true;
+    }
+    case BinaryArgType::BOOL: {
+      uint8_t value = 0;
+      if (!ReadValue(data, end, &value)) {
+        return false;
+      }
+      text->append(value ? "true" : "false");
+      return true;
+    }
+    case BinaryArgType::STRING: {
+      uint32_t size = 0;
+      if (!ReadValue(data, end, &size) ||
+          static_cast<size_t>(end - *data) < size) {
+        return false;
+      }
+      text->append(*data, size);
+      *data += size;
+      return true;
+    }
+    case BinaryArgType::POINTER: {
+      uint64_t value = 0;
+      if (!ReadValue(data, end, &value)) {
+        return false;
+      }
+      char buffer[32];
+      snprintf(buffer, sizeof(buffer), "0x%" PRIx64, value);
+      text->append(buffer);
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+
+bool ReadString(std::istream* input, std::string* str) {
+  uint32_t size = 0;
+  if (!input->read(reinterpret_cast<char*>(&size), sizeof(size))) {
+    return false;
+  }
+  str->resize(size);
+  return static_cast<bool>(input->read(&(*str)[0], size));
+}
+
+}  // namespace
+
+bool FormatBinaryArgs(const std::string& format, const char* data,
+                      size_t size, std::string* text) {
+  const char* end = data + size;
+  text->clear();
+  text->reserve(format.size() + size);
+  size_t pos = 0;
+  while (pos < format.size()) {
+    size_t found = format.find("{}", pos);
+    if (found == std::string::npos || data == end) {
+      text->append(format, pos, std::string::npos);
+      break;
+    }
+    text->append(format, pos, found - pos);
+    if (!AppendArg(&data, end, text)) {
+      return false;
+    }
+    pos = found + 2;
+  }
+  // arguments without placeholder are appended
+  while (data != end) {
+    text->push_back(' ');
+    if (!AppendArg(&data, end, text)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::string FormatBinaryLogLine(const BinaryLogFormat& format,
+                                uint64_t timestamp_ns, uint32_t thread_id,
+                                const std::string& text) {
+  static const char kLevels[] = "IWEF";
+  char level = format.level >= 0 && format.level < 4 ? kLevels[format.level]
+                                                     : 'I';
+  time_t seconds = static_cast<time_t>(timestamp_ns / 1000000000);
+  struct tm tm_time;
+  localtime_r(&seconds, &tm_time);
+  const char* file = format.file.c_str();
+  const char* slash = strrchr(file, '/');
+  char prefix[128];
+  snprintf(prefix, sizeof(prefix), "%c%02d%02d %02d:%02d:%02d.%06u %5u %s:%u] ",
+           level, tm_time.tm_mon + 1, tm_time.tm_mday, tm_time.tm_hour,
+           tm_time.tm_min, tm_time.tm_sec,
+           static_cast<unsigned>(timestamp_ns % 1000000000 / 1000), thread_id,
+           slash != nullptr ? slash + 1 : file, format.line);
+  std::string line(prefix);
+  line.append("[").append(format.module).append("]").append(text);
+  line.push_back('\n');
+  return line;
+}
+
+bool BinaryLogDecoder::Decode(std::istream* input, std::ostream* output) {
+  char magic[kBinaryLogMagicSize];
+  if (!input->read(magic, sizeof(magic)) ||
+      memcmp(magic, kBinaryLogMagic, sizeof(magic)) != 0) {
+    return false;
+  }
+  std::string record;
+  std::string text;
+  char entry = 0;
+  while (input->get(entry)) {
+    if (entry == kBinaryLogFormatEntry) {
+      BinaryLogFormat format;
+      if (!input->read(reinterpret_cast<char*>(&format.id),
+                       sizeof(format.id)) ||
+          !input->read(reinterpret_cast<char*>(&format.level),
+                       sizeof(format.level)) ||
+          !input->read(reinterpret_cast<char*>(&format.line),
+                       sizeof(format.line)) ||
+          !ReadString(input, &format.module) ||
+          !ReadString(input, &format.file) ||
+          !ReadString(input, &format.format)) {
+        return false;
+      }
+      if (format.id >= formats_.size()) {
+        formats_.resize(format.id + 1);
+      }
+      formats_[format.id] = std::move(format);
+    } else if (entry == kBinaryLogRecordEntry) {
+      uint32_t thread_id = 0;
+      if (!input->read(reinterpret_cast<char*>(&thread_id),
+                       sizeof(thread_id)) ||
+          !ReadString(input, &record) ||
+          record.size() < kBinaryLogRecordHeaderSize) {
+        return false;
+      }
+      uint32_t id = 0;
+      uint64_t timestamp_ns = 0;
+      memcpy(&id, record.data(), sizeof(id));
+      memcpy(&timestamp_ns, record.data() + sizeof(id), sizeof(timestamp_ns));
+      if (id >= formats_.size() ||
+          !FormatBinaryArgs(formats_[id].format,
+                            record.data() + kBinaryLogRecordHeaderSize,
+                            record.size() - kBinaryLogRecordHeaderSize,
+                            &text)) {
+        return false;
+      }
+      *output << FormatBinaryLogLine(formats_[id], timestamp_ns, thread_id,
+                                     text);
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace logger
+}  // namespace cyber
+}  // namespace apollo
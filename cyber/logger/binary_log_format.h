@@ -0,0 +1,174 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#ifndef CYBER_LOGGER_BINARY_LOG_FORMAT_H_
+#define CYBER_LOGGER_BINARY_LOG_FORMAT_H_
+
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace apollo {
+namespace cyber {
+namespace logger {
+
+/**
+ * Wire format shared by BinaryLogger and the offline decoder.
+ *
+ * A record is `format id (u32) | timestamp ns (u64) | arguments`, every
+ * argument is a type byte followed by its value. A binary log file starts
+ * with kBinaryLogMagic followed by entries:
+ *   'F' id (u32) | level (i32) | line (u32) | module | file | format
+ *   'R' thread id (u32) | size (u32) | record
+ * where strings are `size (u32) | bytes`. Formats use `{}` placeholders
+ * which are replaced by the arguments in order.
+ */
+constexpr char kBinaryLogMagic[] = "CYBLOG01";
+constexpr size_t kBinaryLogMagicSize = sizeof(kBinaryLogMagic) - 1;
+constexpr char kBinaryLogFormatEntry = 'F';
+constexpr char kBinaryLogRecordEntry = 'R';
+constexpr size_t kBinaryLogRecordHeaderSize =
+    sizeof(uint32_t) + sizeof(uint64_t);
+
+enum class BinaryArgType : uint8_t {
+  INT64 = 1,
+  UINT64 = 2,
+  DOUBLE = 3,
+  BOOL = 4,
+  STRING = 5,
+  POINTER = 6,
+};
+
+struct BinaryLogFormat {
+  uint32_t id = 0;
+  int32_t level = 0;
+  uint32_t line = 0;
+  std::string module;
+  std::string file;
+  std::string format;
+};
+
+inline std::string_view BinaryArgString(const char* value) {
+  return value == nullptr ? std::string_view("(null)")
+                          : std::string_view(value);
+}
+
+/**
+ * @brief Encoded size of an argument.
+ */
+template <typename T>
+size_t BinaryArgSize(const T& value) {
+  using U = std::decay_t<T>;
+  if constexpr (std::is_same_v<U, std::string> ||
+                std::is_same_v<U, std::string_view>) {
+    return 1 + sizeof(uint32_t) + value.size();
+  } else if constexpr (std::is_same_v<U, const char*> ||
+                       std::is_same_v<U, char*>) {
+    return 1 + sizeof(uint32_t) + BinaryArgString(value).size();
+  } else if constexpr (std::is_same_v<U, bool>) {
+    return 2;
+  } else {
+    static_assert(std::is_arithmetic_v<U> || std::is_enum_v<U> ||
+                      std::is_pointer_v<U>,
+                  "unsupported binary log argument");
+    return 1 + sizeof(uint64_t);
+  }
+}
+
+/**
+ * @brief Encode an argument at `*data` and advance it.
+ */
+template <typename T>
+void EncodeBinaryArg(const T& value, char** data) {
+  using U = std::decay_t<T>;
+  auto put = [data](BinaryArgType type, const void* bytes, size_t size) {
+    **data = static_cast<char>(type);
+    memcpy(*data + 1, bytes, size);
+    *data += 1 + size;
+  };
+  if constexpr (std::is_same_v<U, std::string> ||
+                std::is_same_v<U, std::string_view> ||
+                std::is_same_v<U, const char*> || std::is_same_v<U, char*>) {
+    std::string_view str;
+    if constexpr (std::is_pointer_v<U>) {
+      str = BinaryArgString(value);
+    } else {
+      str = value;
+    }
+    uint32_t size = static_cast<uint32_t>(str.size());
+    put(BinaryArgType::STRING, &size, sizeof(size));
+    memcpy(*data, str.data(), size);
+    *data += size;
+  } else if constexpr (std::is_same_v<U, bool>) {
+    uint8_t byte = value ? 1 : 0;
+    put(BinaryArgType::BOOL, &byte, 1);
+  } else if constexpr (std::is_floating_point_v<U>) {
+    double number = static_cast<double>(value);
+    put(BinaryArgType::DOUBLE, &number, sizeof(number));
+  } else if constexpr (std::is_pointer_v<U>) {
+    uint64_t address = reinterpret_cast<uintptr_t>(value);
+    put(BinaryArgType::POINTER, &address, sizeof(address));
+  } else if constexpr (std::is_enum_v<U> || std::is_signed_v<U>) {
+    int64_t number = static_cast<int64_t>(value);
+    put(BinaryArgType::INT64, &number, sizeof(number));
+  } else {
+    uint64_t number = static_cast<uint64_t>(value);
+    put(BinaryArgType::UINT64, &number, sizeof(number));
+  }
+}
+
+/**
+ * @brief Substitute the encoded arguments into `format`.
+ *
+ * @return False if the arguments are truncated or of unknown type.
+ */
+bool FormatBinaryArgs(const std::string& format, const char* data,
+                      size_t size, std::string* text);
+
+/**
+ * @brief Render a record as a glog style line, including the newline.
+ */
+std::string FormatBinaryLogLine(const BinaryLogFormat& format,
+                                uint64_t timestamp_ns, uint32_t thread_id,
+                                const std::string& text);
+
+/**
+ * @class BinaryLogDecoder
+ * @brief Turns a binary log file back into text lines.
+ */
+class BinaryLogDecoder {
+ public:
+  /**
+   * @return False if the input is not a binary log or is corrupted, the
+   * lines decoded up to that point are still written.
+   */
+  bool Decode(std::istream* input, std::ostream* output);
+
+ private:
+  std::vector<BinaryLogFormat> formats_;
+};
+
+}  // namespace logger
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_LOGGER_BINARY_LOG_FORMAT_H_
@@ -0,0 +1,284 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "cyber/logger/binary_logger.h"
+
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <chrono>
+
+namespace apollo {
+namespace cyber {
+namespace logger {
+
+BinaryLogRing::BinaryLogRing(size_t capacity)
+    : capacity_(EntrySize(capacity)) {
+  data_.reset(new char[capacity_]);
+}
+
+char* BinaryLogRing::Reserve(size_t size) {
+  size_t entry = EntrySize(size);
+  if (entry > capacity_) {
+    return nullptr;
+  }
+  uint64_t head = head_.load(std::memory_order_relaxed);
+  uint64_t tail = tail_.load(std::memory_order_acquire);
+  size_t offset = head % capacity_;
+  size_t contiguous = capacity_ - offset;
+  size_t needed = entry > contiguous ? entry + contiguous : entry;
+  if (capacity_ - (head - tail) < needed) {
+    return nullptr;
+  }
+  if (entry > contiguous) {
+    memcpy(data_.get() + offset, &kWrapMarker, sizeof(kWrapMarker));
+    head += contiguous;
+    offset = 0;
+  }
+  uint32_t length = static_cast<uint32_t>(size);
+  memcpy(data_.get() + offset, &length, sizeof(length));
+  reserved_ = head + entry;
+  return data_.get() + offset + sizeof(length);
+}
+
+void BinaryLogRing::Commit() {
+  head_.store(reserved_, std::memory_order_release);
+}
+
+const char* BinaryLogRing::Peek(size_t* size) {
+  uint64_t tail = tail_.load(std::memory_order_relaxed);
+  uint64_t head = head_.load(std::memory_order_acquire);
+  if (tail == head) {
+    return nullptr;
+  }
+  size_t offset = tail % capacity_;
+  uint32_t length = 0;
+  memcpy(&length, data_.get() + offset, sizeof(length));
+  if (length == kWrapMarker) {
+    // a wrap marker is always published together with the next entry
+    tail += capacity_ - offset;
+    offset = 0;
+    memcpy(&length, data_.get(), sizeof(length));
+  }
+  peeked_ = tail + EntrySize(length);
+  *size = length;
+  return data_.get() + offset + sizeof(length);
+}
+
+void BinaryLogRing::Release() {
+  tail_.store(peeked_, std::memory_order_release);
+}
+
+const size_t BinaryLogger::kRingCapacity = 1 << 16;
+
+BinaryLogger::BinaryLogger() {}
+
+BinaryLogger::~BinaryLogger() { Stop(); }
+
+bool BinaryLogger::Start(const std::string& path) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (IsRunning()) {
+    AERROR << "binary logger has been started.";
+    return false;
+  }
+  if (!path.empty()) {
+    file_ = fopen(path.c_str(), "ab");
+    if (file_ == nullptr) {
+      AERROR << "Open binary log file failed, file: " << path
+             << ", errno: " << errno;
+      return false;
+    }
+    if (ftell(file_) == 0) {
+      fwrite(kBinaryLogMagic, 1, kBinaryLogMagicSize, file_);
+    }
+  }
+  // every file gets the complete format table, ids are per process
+  drain_formats_.clear();
+  running_.store(true, std::memory_order_release);
+  thread_ = std::thread(&BinaryLogger::RunThread, this);
+  return true;
+}
+
+void BinaryLogger::Stop() {
+  if (!running_.exchange(false)) {
+    return;
+  }
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+  Drain();
+  if (file_ != nullptr) {
+    fclose(file_);
+    file_ = nullptr;
+  }
+}
+
+uint32_t BinaryLogger::RegisterFormat(int level, const char* module,
+                                      const char* file, int line,
+                                      const char* format) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  BinaryLogFormat binary_format;
+  binary_format.id = static_cast<uint32_t>(formats_.size());
+  binary_format.level = level;
+  binary_format.line = static_cast<uint32_t>(line);
+  binary_format.module = module;
+  binary_format.file = file;
+  binary_format.format = format;
+  formats_.emplace_back(std::move(binary_format));
+  return formats_.back().id;
+}
+
+BinaryLogger::ThreadRing* BinaryLogger::LocalRing() {
+  struct Holder {
+    std::shared_ptr<ThreadRing> ring;
+    ~Holder() {
+      if (ring != nullptr) {
+        ring->closed.store(true, std::memory_order_release);
+      }
+    }
+  };
+  thread_local Holder holder;
+  if (cyber_unlikely(holder.ring == nullptr)) {
+    holder.ring = std::make_shared<ThreadRing>(
+        kRingCapacity, static_cast<uint32_t>(syscall(SYS_gettid)));
+    std::lock_guard<std::mutex> lock(mutex_);
+    rings_.push_back(holder.ring);
+  }
+  return holder.ring.get();
+}
+
+uint64_t BinaryLogger::NowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+
+void BinaryLogger::LogNow(const BinaryLogFormat& format,
+                          const std::string& text) {
+  google::LogMessage(format.file.c_str(), static_cast<int>(format.line),
+                     static_cast<google::LogSeverity>(format.level))
+          .stream()
+      << LEFT_BRACKET << format.module << RIGHT_BRACKET << text;
+}
+
+void BinaryLogger::LogUnbuffered(uint32_t format_id, const char* record,
+                                 size_t size) {
+  BinaryLogFormat format;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (format_id >= formats_.size()) {
+      return;
+    }
+    format = formats_[format_id];
+  }
+  std::string text;
+  FormatBinaryArgs(format.format, record + kBinaryLogRecordHeaderSize,
+                   size - kBinaryLogRecordHeaderSize, &text);
+  LogNow(format, text);
+}
+
+const BinaryLogFormat* BinaryLogger::FindFormat(uint32_t id) {
+  if (id >= drain_formats_.size()) {
+    size_t known = drain_formats_.size();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      drain_formats_.insert(drain_formats_.end(), formats_.begin() + known,
+                            formats_.end());
+    }
+    if (file_ != nullptr) {
+      for (size_t i = known; i < drain_formats_.size(); ++i) {
+        auto& format = drain_formats_[i];
+        auto put_string = [this](const std::string& str) {
+          uint32_t size = static_cast<uint32_t>(str.size());
+          fwrite(&size, sizeof(size), 1, file_);
+          fwrite(str.data(), 1, size, file_);
+        };
+        fputc(kBinaryLogFormatEntry, file_);
+        fwrite(&format.id, sizeof(format.id), 1, file_);
+        fwrite(&format.level, sizeof(format.level), 1, file_);
+        fwrite(&format.line, sizeof(format.line), 1, file_);
+        put_string(format.module);
+        put_string(format.file);
+        put_string(format.format);
+      }
+    }
+  }
+  return id < drain_formats_.size() ? &drain_formats_[id] : nullptr;
+}
+
+void BinaryLogger::RunThread() {
+  while (IsRunning()) {
+    if (!Drain()) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  }
+}
+
+bool BinaryLogger::Drain() {
+  std::vector<std::shared_ptr<ThreadRing>> rings;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    rings = rings_;
+  }
+  bool drained = false;
+  std::string text;
+  for (auto& thread_ring : rings) {
+    size_t size = 0;
+    const char* record = nullptr;
+    while ((record = thread_ring->ring.Peek(&size)) != nullptr) {
+      drained = true;
+      uint32_t id = 0;
+      memcpy(&id, record, sizeof(id));
+      const BinaryLogFormat* format = FindFormat(id);
+      if (format == nullptr) {
+        thread_ring->ring.Release();
+        continue;
+      }
+      if (file_ != nullptr) {
+        uint32_t length = static_cast<uint32_t>(size);
+        fputc(kBinaryLogRecordEntry, file_);
+        fwrite(&thread_ring->thread_id, sizeof(uint32_t), 1, file_);
+        fwrite(&length, sizeof(length), 1, file_);
+        fwrite(record, 1, size, file_);
+      } else {
+        FormatBinaryArgs(format->format, record + kBinaryLogRecordHeaderSize,
+                         size - kBinaryLogRecordHeaderSize, &text);
+        LogNow(*format, text);
+      }
+      thread_ring->ring.Release();
+    }
+  }
+  if (drained && file_ != nullptr) {
+    fflush(file_);
+  }
+
+  // rings of exited threads go away once they are empty
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto it = rings_.begin(); it != rings_.end();) {
+    if ((*it)->closed.load(std::memory_order_acquire) &&
+        (*it)->ring.Empty()) {
+      it = rings_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  return drained;
+}
+
+}  // namespace logger
+}  // namespace cyber
+}  // namespace apollo
@@ -0,0 +1,208 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#ifndef CYBER_LOGGER_BINARY_LOGGER_H_
+#define CYBER_LOGGER_BINARY_LOGGER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "cyber/base/macros.h"
+#include "cyber/common/log.h"
+#include "cyber/common/macros.h"
+#include "cyber/logger/binary_log_format.h"
+
+namespace apollo {
+namespace cyber {
+namespace logger {
+
+/**
+ * @class BinaryLogRing
+ * @brief Single producer single consumer byte ring holding length prefixed
+ * records. Entries are 8 byte aligned, a record that does not fit before the
+ * end of the ring is preceded by a wrap marker and starts over at offset 0.
+ */
+class BinaryLogRing {
+ public:
+  explicit BinaryLogRing(size_t capacity);
+
+  /**
+   * @brief Producer side, nullptr when the ring is full.
+   */
+  char* Reserve(size_t size);
+  void Commit();
+
+  /**
+   * @brief Consumer side, nullptr when the ring is empty.
+   */
+  const char* Peek(size_t* size);
+  void Release();
+
+  bool Empty() const {
+    return head_.load(std::memory_order_acquire) ==
+           tail_.load(std::memory_order_acquire);
+  }
+
+ private:
+  static constexpr uint32_t kWrapMarker = UINT32_MAX;
+  static size_t EntrySize(size_t size) {
+    return (sizeof(uint32_t) + size + 7) & ~static_cast<size_t>(7);
+  }
+
+  std::unique_ptr<char[]> data_;
+  const size_t capacity_;
+  // producer owned
+  alignas(CACHELINE_SIZE) std::atomic<uint64_t> head_ = {0};
+  uint64_t reserved_ = 0;
+  // consumer owned
+  alignas(CACHELINE_SIZE) std::atomic<uint64_t> tail_ = {0};
+  uint64_t peeked_ = 0;
+};
+
+/**
+ * @class BinaryLogger
+ * @brief Logger for hot loops. ALOG_BINARY only copies the format id and the
+ * raw arguments into a ring of the calling thread; the logger thread drains
+ * the rings and either formats the records into glog or appends them to a
+ * binary file which is decoded offline by cyber_log_decoder. Records are
+ * dropped, never blocked on, when a ring is full.
+ */
+class BinaryLogger {
+ public:
+  ~BinaryLogger();
+
+  /**
+   * @brief Start the logger thread.
+   *
+   * @param path binary file to append to, an empty path formats the records
+   * on the logger thread and hands them to glog.
+   */
+  bool Start(const std::string& path = "");
+  void Stop();
+  void Shutdown() { Stop(); }
+  bool IsRunning() const { return running_.load(std::memory_order_acquire); }
+
+  uint32_t RegisterFormat(int level, const char* module, const char* file,
+                          int line, const char* format);
+
+  template <typename... Args>
+  void Log(uint32_t format_id, const Args&... args);
+
+  uint64_t dropped_count() const {
+    return dropped_count_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  struct ThreadRing {
+    BinaryLogRing ring;
+    uint32_t thread_id;
+    std::atomic<bool> closed = {false};
+    ThreadRing(size_t capacity, uint32_t id) : ring(capacity), thread_id(id) {}
+  };
+
+  ThreadRing* LocalRing();
+  const BinaryLogFormat* FindFormat(uint32_t id);
+  void LogNow(const BinaryLogFormat& format, const std::string& text);
+  void LogUnbuffered(uint32_t format_id, const char* record, size_t size);
+  void RunThread();
+  bool Drain();
+  static uint64_t NowNs();
+
+  std::mutex mutex_;
+  std::vector<BinaryLogFormat> formats_;
+  std::vector<std::shared_ptr<ThreadRing>> rings_;
+  // copies of formats_ used by the logger thread without locking
+  std::vector<BinaryLogFormat> drain_formats_;
+  FILE* file_ = nullptr;
+  std::thread thread_;
+  std::atomic<bool> running_ = {false};
+  std::atomic<uint64_t> dropped_count_ = {0};
+
+  static const size_t kRingCapacity;
+
+  DECLARE_SINGLETON(BinaryLogger)
+};
+
+template <typename... Args>
+void BinaryLogger::Log(uint32_t format_id, const Args&... args) {
+  size_t size = kBinaryLogRecordHeaderSize;
+  ((size += BinaryArgSize(args)), ...);
+  char stack_record[256];
+  std::unique_ptr<char[]> heap_record;
+  char* record = nullptr;
+  ThreadRing* ring = nullptr;
+  if (cyber_likely(IsRunning())) {
+    ring = LocalRing();
+    record = ring->ring.Reserve(size);
+    if (record == nullptr) {
+      dropped_count_.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+  } else if (size <= sizeof(stack_record)) {
+    record = stack_record;
+  } else {
+    heap_record.reset(new char[size]);
+    record = heap_record.get();
+  }
+  uint64_t timestamp_ns = NowNs();
+  memcpy(record, &format_id, sizeof(format_id));
+  memcpy(record + sizeof(format_id), &timestamp_ns, sizeof(timestamp_ns));
+  char* data = record + kBinaryLogRecordHeaderSize;
+  (EncodeBinaryArg(args, &data), ...);
+  (void)data;
+  if (ring != nullptr) {
+    ring->ring.Commit();
+  } else {
+    LogUnbuffered(format_id, record, size);
+  }
+}
+
+}  // namespace logger
+}  // namespace cyber
+}  // namespace apollo
+
+#define ALOG_BINARY_SEVERITY_INFO google::INFO
+#define ALOG_BINARY_SEVERITY_WARN google::WARNING
+#define ALOG_BINARY_SEVERITY_ERROR google::ERROR
+
+/**
+ * ALOG_BINARY(INFO, "speed {} at {}", speed, name) logs through the
+ * BinaryLogger. Arguments are arithmetic values, pointers or strings, the
+ * format must be a string literal. Before the logger is started messages
+ * are formatted and sent to glog right away.
+ */
+#define ALOG_BINARY(severity, format, ...)                                 \
+  do {                                                                     \
+    static const uint32_t binary_log_format_id =                          \
+        ::apollo::cyber::logger::BinaryLogger::Instance()->RegisterFormat( \
+            ALOG_BINARY_SEVERITY_##severity, MODULE_NAME, __FILE__,        \
+            __LINE__, format);                                             \
+    ::apollo::cyber::logger::BinaryLogger::Instance()->Log(               \
+        binary_log_format_id, ##__VA_ARGS__);                              \
+  } while (0)
+
+#define ABINFO(format, ...) ALOG_BINARY(INFO, format, ##__VA_ARGS__)
+#define ABWARN(format, ...) ALOG_BINARY(WARN, format, ##__VA_ARGS__)
+#define ABERROR(format, ...) ALOG_BINARY(ERROR, format, ##__VA_ARGS__)
+
+#endif  // CYBER_LOGGER_BINARY_LOGGER_H_
@@ -0,0 +1,127 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "cyber/logger/binary_logger.h"
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace cyber {
+namespace logger {
+
+TEST(BinaryLogRingTest, WrapAround) {
+  BinaryLogRing ring(64);
+  size_t size = 0;
+  EXPECT_EQ(nullptr, ring.Peek(&size));
+  EXPECT_EQ(nullptr, ring.Reserve(100));
+
+  for (int i = 0; i < 100; ++i) {
+    std::string entry = std::to_string(i * 997);
+    char* data = ring.Reserve(entry.size());
+    ASSERT_NE(nullptr, data);
+    memcpy(data, entry.data(), entry.size());
+    ring.Commit();
+    const char* read = ring.Peek(&size);
+    ASSERT_NE(nullptr, read);
+    EXPECT_EQ(entry, std::string(read, size));
+    ring.Release();
+  }
+  EXPECT_TRUE(ring.Empty());
+
+  // 16 byte entries, the fifth does not fit
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_NE(nullptr, ring.Reserve(10));
+    ring.Commit();
+  }
+  EXPECT_EQ(nullptr, ring.Reserve(10));
+}
+
+TEST(BinaryLogFormatTest, FormatArgs) {
+  std::string name = "planning";
+  const char* none = nullptr;
+  char buffer[256];
+  char* data = buffer;
+  EncodeBinaryArg(-3, &data);
+  EncodeBinaryArg(42u, &data);
+  EncodeBinaryArg(1.5, &data);
+  EncodeBinaryArg(true, &data);
+  EncodeBinaryArg(name, &data);
+  EncodeBinaryArg(none, &data);
+  ASSERT_EQ(BinaryArgSize(-3) + BinaryArgSize(42u) + BinaryArgSize(1.5) +
+                BinaryArgSize(true) + BinaryArgSize(name) +
+                BinaryArgSize(none),
+            static_cast<size_t>(data - buffer));
+
+  std::string text;
+  ASSERT_TRUE(
+      FormatBinaryArgs("{} {} {} {} {}", buffer, data - buffer, &text));
+  EXPECT_EQ("-3 42 1.5 true planning (null)", text);
+  ASSERT_TRUE(FormatBinaryArgs("no args {}", buffer, 0, &text));
+  EXPECT_EQ("no args {}", text);
+  EXPECT_FALSE(FormatBinaryArgs("{}", buffer, 3, &text));
+}
+
+TEST(BinaryLoggerTest, WriteAndDecode) {
+  const std::string path = "binary_logger_test.blog";
+  remove(path.c_str());
+  auto logger = BinaryLogger::Instance();
+  ASSERT_TRUE(logger->Start(path));
+  ASSERT_FALSE(logger->Start(path));
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 2; ++t) {
+    threads.emplace_back([t] {
+      for (int i = 0; i < 100; ++i) {
+        ABINFO("thread {} message {}", t, i);
+      }
+      ABWARN("thread {} done", t);
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  logger->Stop();
+
+  std::ifstream input(path, std::ios::binary);
+  std::ostringstream output;
+  BinaryLogDecoder decoder;
+  ASSERT_TRUE(decoder.Decode(&input, &output));
+  std::istringstream lines(output.str());
+  std::string line;
+  int count = 0;
+  int warnings = 0;
+  while (std::getline(lines, line)) {
+    ++count;
+    if (line[0] == 'W') {
+      ++warnings;
+      EXPECT_NE(std::string::npos, line.find("done"));
+    }
+  }
+  EXPECT_EQ(202 - static_cast<int>(logger->dropped_count()), count);
+  EXPECT_EQ(2, warnings);
+  EXPECT_NE(std::string::npos, output.str().find("thread 1 message 99"));
+  ASSERT_FALSE(remove(path.c_str()));
+}
+
+}  // namespace logger
+}  // namespace cyber
+}  // namespace apollo
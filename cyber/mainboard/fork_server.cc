@@ -0,0 +1,376 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "cyber/mainboard/fork_server.h"
+
+#include <poll.h>
+#include <sys/signalfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace cyber {
+namespace mainboard {
+
+namespace {
+
+constexpr size_t kMaxRequestSize = 64 * 1024;
+constexpr int kStdFdNum = 3;
+
+std::atomic<int> forked_pid = {0};
+
+void ForwardSignal(int signal) {
+  int pid = forked_pid.load();
+  if (pid > 0) {
+    kill(pid, signal);
+  }
+}
+
+bool FillAddress(const std::string& socket_path, sockaddr_un* addr) {
+  if (socket_path.size() >= sizeof(addr->sun_path)) {
+    AERROR << "socket path is too long: " << socket_path;
+    return false;
+  }
+  std::memset(addr, 0, sizeof(*addr));
+  addr->sun_family = AF_UNIX;
+  std::strncpy(addr->sun_path, socket_path.c_str(),
+               sizeof(addr->sun_path) - 1);
+  return true;
+}
+
+bool SendInt(int fd, int value) {
+  return send(fd, &value, sizeof(value), MSG_NOSIGNAL) ==
+         static_cast<ssize_t>(sizeof(value));
+}
+
+}  // namespace
+
+ForkServer::ForkServer(const ModuleArgument& args, const RunFunc& run)
+    : args_(args), run_(run), controller_(args) {
+  sigemptyset(&old_mask_);
+}
+
+ForkServer::~ForkServer() {
+  if (listen_fd_ >= 0) {
+    close(listen_fd_);
+    unlink(args_.GetForkServer().c_str());
+  }
+  if (signal_fd_ >= 0) {
+    close(signal_fd_);
+  }
+}
+
+int ForkServer::Serve() {
+  // the server must stay single threaded to fork safely, so it blocks the
+  // signals it handles and reads them from a signalfd
+  sigset_t mask;
+  sigemptyset(&mask);
+  sigaddset(&mask, SIGCHLD);
+  sigaddset(&mask, SIGINT);
+  sigaddset(&mask, SIGTERM);
+  sigprocmask(SIG_BLOCK, &mask, &old_mask_);
+  signal_fd_ = signalfd(-1, &mask, SFD_CLOEXEC);
+  if (signal_fd_ < 0) {
+    AERROR << "create signalfd failed: " << std::strerror(errno);
+    return -1;
+  }
+
+  if (!controller_.LoadLibraries()) {
+    AERROR << "preload libraries failed.";
+    return -1;
+  }
+  if (!Listen()) {
+    return -1;
+  }
+  AINFO << "fork server is ready on " << args_.GetForkServer();
+
+  bool running = true;
+  while (running) {
+    std::vector<pollfd> fds;
+    fds.push_back({listen_fd_, POLLIN, 0});
+    fds.push_back({signal_fd_, POLLIN, 0});
+    std::vector<int> pids;
+    for (auto& child : children_) {
+      if (!child.second.interrupted) {
+        fds.push_back({child.second.conn, POLLIN, 0});
+        pids.push_back(child.first);
+      }
+    }
+    if (poll(fds.data(), fds.size(), -1) < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      AERROR << "poll failed: " << std::strerror(errno);
+      break;
+    }
+
+    if (fds[1].revents & POLLIN) {
+      signalfd_siginfo info;
+      if (read(signal_fd_, &info, sizeof(info)) ==
+          static_cast<ssize_t>(sizeof(info))) {
+        if (info.ssi_signo == SIGCHLD) {
+          Reap(false);
+        } else {
+          running = false;
+        }
+      }
+    }
+    // the client only ever closes its connection: interrupt its child
+    for (size_t i = 2; i < fds.size(); ++i) {
+      auto child = children_.find(pids[i - 2]);
+      if (fds[i].revents != 0 && child != children_.end()) {
+        kill(child->first, SIGINT);
+        child->second.interrupted = true;
+      }
+    }
+    if (running && (fds[0].revents & POLLIN)) {
+      Accept();
+    }
+  }
+
+  InterruptChildren();
+  return 0;
+}
+
+bool ForkServer::Request(const std::string& socket_path, int argc,
+                         char* const argv[], int* exit_code) {
+  sockaddr_un addr;
+  if (!FillAddress(socket_path, &addr)) {
+    return false;
+  }
+  int fd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+  if (fd < 0) {
+    return false;
+  }
+  if (connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+    AWARN << "fork server " << socket_path
+          << " is not reachable: " << std::strerror(errno);
+    close(fd);
+    return false;
+  }
+
+  std::string request;
+  for (int i = 0; i < argc; ++i) {
+    request.append(argv[i]);
+    request.push_back('\0');
+  }
+  int std_fds[kStdFdNum] = {STDIN_FILENO, STDOUT_FILENO, STDERR_FILENO};
+  char control[CMSG_SPACE(sizeof(std_fds))];
+  std::memset(control, 0, sizeof(control));
+  iovec iov = {&request[0], request.size()};
+  msghdr msg;
+  std::memset(&msg, 0, sizeof(msg));
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = control;
+  msg.msg_controllen = sizeof(control);
+  cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+  cmsg->cmsg_level = SOL_SOCKET;
+  cmsg->cmsg_type = SCM_RIGHTS;
+  cmsg->cmsg_len = CMSG_LEN(sizeof(std_fds));
+  std::memcpy(CMSG_DATA(cmsg), std_fds, sizeof(std_fds));
+
+  int pid = 0;
+  if (sendmsg(fd, &msg, MSG_NOSIGNAL) < 0 ||
+      recv(fd, &pid, sizeof(pid), 0) != static_cast<ssize_t>(sizeof(pid)) ||
+      pid <= 0) {
+    AWARN << "fork server " << socket_path << " refused the request.";
+    close(fd);
+    return false;
+  }
+  AINFO << "modules run in process " << pid << " forked by " << socket_path;
+
+  forked_pid.store(pid);
+  signal(SIGINT, ForwardSignal);
+  signal(SIGTERM, ForwardSignal);
+
+  int status = 0;
+  ssize_t n = 0;
+  while ((n = recv(fd, &status, sizeof(status), 0)) < 0 && errno == EINTR) {
+  }
+  close(fd);
+  if (n != static_cast<ssize_t>(sizeof(status))) {
+    AERROR << "fork server " << socket_path << " is gone, wait for " << pid;
+    while (kill(pid, 0) == 0) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    *exit_code = EXIT_FAILURE;
+    return true;
+  }
+  *exit_code = WIFEXITED(status) ? WEXITSTATUS(status)
+                                 : 128 + WTERMSIG(status);
+  return true;
+}
+
+bool ForkServer::Listen() {
+  sockaddr_un addr;
+  if (!FillAddress(args_.GetForkServer(), &addr)) {
+    return false;
+  }
+  listen_fd_ = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+  if (listen_fd_ < 0) {
+    AERROR << "create socket failed: " << std::strerror(errno);
+    return false;
+  }
+  unlink(addr.sun_path);
+  if (bind(listen_fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) !=
+          0 ||
+      listen(listen_fd_, 16) != 0) {
+    AERROR << "listen on " << args_.GetForkServer()
+           << " failed: " << std::strerror(errno);
+    close(listen_fd_);
+    listen_fd_ = -1;
+    return false;
+  }
+  return true;
+}
+
+void ForkServer::Accept() {
+  int conn = accept4(listen_fd_, nullptr, nullptr, SOCK_CLOEXEC);
+  if (conn < 0) {
+    return;
+  }
+
+  std::vector<char> buffer(kMaxRequestSize);
+  char control[CMSG_SPACE(sizeof(int) * kStdFdNum)];
+  iovec iov = {buffer.data(), buffer.size()};
+  msghdr msg;
+  std::memset(&msg, 0, sizeof(msg));
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = control;
+  msg.msg_controllen = sizeof(control);
+  ssize_t n = recvmsg(conn, &msg, MSG_CMSG_CLOEXEC);
+
+  int fds[kStdFdNum] = {-1, -1, -1};
+  int fd_num = 0;
+  cmsghdr* cmsg = n > 0 ? CMSG_FIRSTHDR(&msg) : nullptr;
+  if (cmsg != nullptr && cmsg->cmsg_level == SOL_SOCKET &&
+      cmsg->cmsg_type == SCM_RIGHTS) {
+    fd_num = static_cast<int>((cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int));
+    std::memcpy(fds, CMSG_DATA(cmsg), sizeof(int) * kStdFdNum);
+  }
+
+  std::vector<std::string> argv;
+  for (ssize_t pos = 0; pos < n;) {
+    std::string arg(buffer.data() + pos);
+    pos += arg.size() + 1;
+    argv.emplace_back(std::move(arg));
+  }
+
+  if (fd_num != kStdFdNum || (msg.msg_flags & MSG_TRUNC) || argv.empty()) {
+    AERROR << "invalid fork request.";
+    for (int i = 0; i < std::min(fd_num, kStdFdNum); ++i) {
+      close(fds[i]);
+    }
+    SendInt(conn, -1);
+    close(conn);
+    return;
+  }
+  Spawn(conn, argv, fds);
+}
+
+void ForkServer::Spawn(int conn, const std::vector<std::string>& argv,
+                       const int* fds) {
+  int pid = fork();
+  if (pid == 0) {
+    close(listen_fd_);
+    close(signal_fd_);
+    close(conn);
+    for (auto& child : children_) {
+      close(child.second.conn);
+    }
+    // the server may have been started with SIGINT ignored (e.g. in the
+    // background), the child has to stay interruptible
+    signal(SIGINT, SIG_DFL);
+    signal(SIGTERM, SIG_DFL);
+    sigprocmask(SIG_SETMASK, &old_mask_, nullptr);
+    for (int i = 0; i < kStdFdNum; ++i) {
+      dup2(fds[i], i);
+      if (fds[i] >= kStdFdNum) {
+        close(fds[i]);
+      }
+    }
+    std::vector<std::string> args(argv);
+    std::vector<char*> child_argv;
+    for (auto& arg : args) {
+      child_argv.push_back(&arg[0]);
+    }
+    child_argv.push_back(nullptr);
+    exit(run_(static_cast<int>(args.size()), child_argv.data()));
+  }
+
+  for (int i = 0; i < kStdFdNum; ++i) {
+    close(fds[i]);
+  }
+  if (pid < 0) {
+    AERROR << "fork failed: " << std::strerror(errno);
+    SendInt(conn, -1);
+    close(conn);
+    return;
+  }
+  AINFO << "forked process " << pid << " for " << argv[0];
+  SendInt(conn, pid);
+  children_[pid].conn = conn;
+}
+
+void ForkServer::Reap(bool block) {
+  int status = 0;
+  int pid = 0;
+  while ((pid = waitpid(-1, &status, block ? 0 : WNOHANG)) > 0) {
+    Finish(pid, status);
+    if (block && children_.empty()) {
+      break;
+    }
+  }
+}
+
+void ForkServer::Finish(int pid, int status) {
+  auto child = children_.find(pid);
+  if (child == children_.end()) {
+    return;
+  }
+  AINFO << "process " << pid << " exited with status " << status;
+  SendInt(child->second.conn, status);
+  close(child->second.conn);
+  children_.erase(child);
+}
+
+void ForkServer::InterruptChildren() {
+  for (auto& child : children_) {
+    kill(child.first, SIGINT);
+  }
+  if (!children_.empty()) {
+    Reap(true);
+  }
+}
+
+}  // namespace mainboard
+}  // namespace cyber
+}  // namespace apollo
@@ -0,0 +1,98 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#ifndef CYBER_MAINBOARD_FORK_SERVER_H_
+#define CYBER_MAINBOARD_FORK_SERVER_H_
+
+#include <signal.h>
+
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "cyber/mainboard/module_argument.h"
+#include "cyber/mainboard/module_controller.h"
+
+namespace apollo {
+namespace cyber {
+namespace mainboard {
+
+/**
+ * @class ForkServer
+ * @brief Keeps the libraries of a dag set loaded and statically initialized
+ * in a process that has not called cyber::Init, and forks a child from it for
+ * every request on a unix socket. A module restarted through the server is
+ * ready as soon as its components are initialized.
+ *
+ * A request carries the command line of a `mainboard --fork_client` process
+ * and its stdin/stdout/stderr. The server answers with the child's pid and,
+ * once the child exits, with its wait status, so the client can stand in for
+ * the module process towards its supervisor. Closing the client connection
+ * interrupts the child.
+ */
+class ForkServer {
+ public:
+  using RunFunc = std::function<int(int argc, char** argv)>;
+
+  ForkServer(const ModuleArgument& args, const RunFunc& run);
+  virtual ~ForkServer();
+
+  /**
+   * @brief Preload the libraries and serve requests until SIGINT or SIGTERM.
+   * The children are interrupted and waited for before returning.
+   *
+   * @return the exit code of the server process
+   */
+  int Serve();
+
+  /**
+   * @brief Run `argv` in a process forked by the server at `socket_path`
+   * and wait for it to exit.
+   *
+   * @return false if there is no server to take the request
+   */
+  static bool Request(const std::string& socket_path, int argc,
+                      char* const argv[], int* exit_code);
+
+ private:
+  struct Child {
+    int conn = -1;             /// connection of the requesting client
+    bool interrupted = false;  /// the client has gone
+  };
+
+  bool Listen();
+  void Accept();
+  void Spawn(int conn, const std::vector<std::string>& argv, const int* fds);
+  void Reap(bool block);
+  void Finish(int pid, int status);
+  void InterruptChildren();
+
+  ModuleArgument args_;
+  RunFunc run_;
+  ModuleController controller_;
+  int listen_fd_ = -1;
+  int signal_fd_ = -1;
+  sigset_t old_mask_;
+  std::unordered_map<int, Child> children_;  // pid -> child
+};
+
+}  // namespace mainboard
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_MAINBOARD_FORK_SERVER_H_
@@ -14,23 +14,29 @@
  * limitations under the License.
  *****************************************************************************/
 
+#include <getopt.h>
+
 #include "cyber/common/global_data.h"
 #include "cyber/common/log.h"
 #include "cyber/init.h"
+#include "cyber/mainboard/fork_server.h"
 #include "cyber/mainboard/module_argument.h"
 #include "cyber/mainboard/module_controller.h"
+#include "cyber/mainboard/profiler_service.h"
 #include "cyber/state.h"
+#include "cyber/sysmo/alloc_tracker.h"
 
+using apollo::cyber::AllocTracker;
+using apollo::cyber::mainboard::ForkServer;
 using apollo::cyber::mainboard::ModuleArgument;
 using apollo::cyber::mainboard::ModuleController;
+using apollo::cyber::mainboard::ProfilerService;
 
-int main(int argc, char** argv) {
-  // parse the argument
-  ModuleArgument module_args;
-  module_args.ParseArgument(argc, argv);
+namespace {
 
+int RunModules(const ModuleArgument& module_args, const char* binary_name) {
   // initialize cyber
-  apollo::cyber::Init(argv[0]);
+  apollo::cyber::Init(binary_name);
 
   // start module
   ModuleController controller(module_args);
@@ -40,9 +46,46 @@ int main(int argc, char** argv) {
     return -1;
   }
 
+  // The heap profile of CYBER_ALLOC_TRACKER is served without --profiler.
+  ProfilerService profiler_service;
+  if ((module_args.GetProfiler() || AllocTracker::enabled()) &&
+      !profiler_service.Init(module_args.GetProcessGroup())) {
+    AWARN << "Profiler service is not available.";
+  }
+
   apollo::cyber::WaitForShutdown();
   controller.Clear();
   AINFO << "exit mainboard.";
 
   return 0;
 }
+
+int RunForked(int argc, char** argv) {
+  // the fork server has already parsed its own command line
+  optind = 0;
+  ModuleArgument module_args;
+  module_args.ParseArgument(argc, argv);
+  return RunModules(module_args, argv[0]);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  // parse the argument
+  ModuleArgument module_args;
+  module_args.ParseArgument(argc, argv);
+
+  if (!module_args.GetForkServer().empty()) {
+    ForkServer server(module_args, RunForked);
+    return server.Serve();
+  }
+
+  int exit_code = 0;
+  if (!module_args.GetForkClient().empty() &&
+      ForkServer::Request(module_args.GetForkClient(), argc, argv,
+                          &exit_code)) {
+    return exit_code;
+  }
+
+  return RunModules(module_args, argv[0]);
+}
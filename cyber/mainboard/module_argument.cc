@@ -34,6 +34,13 @@ void ModuleArgument::DisplayUsage() {
            "namespace for running this module, default in manager process\n"
         << "    -s, --sched_name=sched_name: sched policy "
            "conf for hole process, sched_name should be conf in cyber.pb.conf\n"
+        << "    -f, --fork_server=SOCKET: preload the libraries of the dag "
+           "confs and fork initialized processes for requests on SOCKET\n"
+        << "    -c, --fork_client=SOCKET: start the modules in a process "
+           "forked by the fork server on SOCKET, locally if unreachable\n"
+        << "    --no_preload: load the module libraries one by one\n"
+        << "    --profiler: serve /cyber/profiler/<process_group>, which "
+           "takes cpu and heap profiles of the process on request\n"
         << "Example:\n"
         << "    " << binary_name_ << " -h\n"
         << "    " << binary_name_ << " -d dag_conf_file1 -d dag_conf_file2 "
@@ -64,12 +71,16 @@ void ModuleArgument::ParseArgument(const int argc, char* const argv[]) {
 void ModuleArgument::GetOptions(const int argc, char* const argv[]) {
   opterr = 0;  // extern int opterr
   int long_index = 0;
-  const std::string short_opts = "hd:p:s:";
+  const std::string short_opts = "hd:p:s:f:c:";
   static const struct option long_opts[] = {
       {"help", no_argument, nullptr, 'h'},
       {"dag_conf", required_argument, nullptr, 'd'},
       {"process_name", required_argument, nullptr, 'p'},
       {"sched_name", required_argument, nullptr, 's'},
+      {"fork_server", required_argument, nullptr, 'f'},
+      {"fork_client", required_argument, nullptr, 'c'},
+      {"no_preload", no_argument, nullptr, 'n'},
+      {"profiler", no_argument, nullptr, 'P'},
       {NULL, no_argument, nullptr, 0}};
 
   // log command for info
@@ -108,6 +119,18 @@ void ModuleArgument::GetOptions(const int argc, char* const argv[]) {
       case 's':
         sched_name_ = std::string(optarg);
         break;
+      case 'f':
+        fork_server_ = std::string(optarg);
+        break;
+      case 'c':
+        fork_client_ = std::string(optarg);
+        break;
+      case 'n':
+        preload_ = false;
+        break;
+      case 'P':
+        profiler_ = true;
+        break;
       case 'h':
         DisplayUsage();
         exit(0);
@@ -42,12 +42,20 @@ class ModuleArgument {
   const std::string& GetProcessGroup() const;
   const std::string& GetSchedName() const;
   const std::list<std::string>& GetDAGConfList() const;
+  const std::string& GetForkServer() const;
+  const std::string& GetForkClient() const;
+  bool GetPreload() const;
+  bool GetProfiler() const;
 
  private:
   std::list<std::string> dag_conf_list_;
   std::string binary_name_;
   std::string process_group_;
   std::string sched_name_;
+  std::string fork_server_;
+  std::string fork_client_;
+  bool preload_ = true;
+  bool profiler_ = false;
 };
 
 inline const std::string& ModuleArgument::GetBinaryName() const {
@@ -66,6 +74,18 @@ inline const std::list<std::string>& ModuleArgument::GetDAGConfList() const {
   return dag_conf_list_;
 }
 
+inline const std::string& ModuleArgument::GetForkServer() const {
+  return fork_server_;
+}
+
+inline const std::string& ModuleArgument::GetForkClient() const {
+  return fork_client_;
+}
+
+inline bool ModuleArgument::GetPreload() const { return preload_; }
+
+inline bool ModuleArgument::GetProfiler() const { return profiler_; }
+
 }  // namespace mainboard
 }  // namespace cyber
 }  // namespace apollo
@@ -16,6 +16,9 @@
 
 #include "cyber/mainboard/module_controller.h"
 
+#include <fcntl.h>
+#include <unistd.h>
+
 #include <utility>
 
 #include "cyber/common/environment.h"
@@ -27,6 +30,7 @@ namespace cyber {
 namespace mainboard {
 
 void ModuleController::Clear() {
+  StopPreload();
   for (auto& component : component_list_) {
     component->Shutdown();
   }
@@ -35,10 +39,59 @@ void ModuleController::Clear() {
 }
 
 bool ModuleController::LoadAll() {
+  std::vector<std::string> paths;
+  std::vector<DagConfig> dag_configs;
+  if (!GetDagConfigs(&paths, &dag_configs)) {
+    return false;
+  }
+  for (auto& dag_config : dag_configs) {
+    total_component_nums += GetComponentNum(dag_config);
+  }
+  if (has_timer_component) {
+    total_component_nums += scheduler::Instance()->TaskPoolSize();
+  }
+  common::GlobalData::Instance()->SetComponentNums(total_component_nums);
+  if (args_.GetPreload()) {
+    PreloadLibraries(dag_configs);
+  }
+  for (size_t i = 0; i < dag_configs.size(); ++i) {
+    AINFO << "Start initialize dag: " << paths[i];
+    if (!LoadModule(dag_configs[i])) {
+      AERROR << "Failed to load module: " << paths[i];
+      return false;
+    }
+  }
+  StopPreload();
+  return true;
+}
+
+bool ModuleController::LoadLibraries() {
+  std::vector<std::string> paths;
+  std::vector<DagConfig> dag_configs;
+  if (!GetDagConfigs(&paths, &dag_configs)) {
+    return false;
+  }
+  for (auto& dag_config : dag_configs) {
+    for (auto& module_config : dag_config.module_config()) {
+      std::string load_path = GetLibraryPath(module_config.module_library());
+      if (!common::PathExists(load_path)) {
+        AERROR << "Path does not exist: " << load_path;
+        return false;
+      }
+      if (!class_loader_manager_.LoadLibrary(load_path)) {
+        AERROR << "Failed to load library: " << load_path;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool ModuleController::GetDagConfigs(std::vector<std::string>* paths,
+                                     std::vector<DagConfig>* dag_configs) {
   const std::string work_root = common::WorkRoot();
   const std::string current_path = common::GetCurrentPath();
   const std::string dag_root_path = common::GetAbsolutePath(work_root, "dag");
-  std::vector<std::string> paths;
   for (auto& dag_conf : args_.GetDAGConfList()) {
     std::string module_path = "";
     if (dag_conf == common::GetFileName(dag_conf)) {
@@ -54,40 +107,88 @@ bool ModuleController::LoadAll() {
         module_path = common::GetAbsolutePath(work_root, dag_conf);
       }
     }
-    total_component_nums += GetComponentNum(module_path);
-    paths.emplace_back(std::move(module_path));
-  }
-  if (has_timer_component) {
-    total_component_nums += scheduler::Instance()->TaskPoolSize();
-  }
-  common::GlobalData::Instance()->SetComponentNums(total_component_nums);
-  for (auto module_path : paths) {
-    AINFO << "Start initialize dag: " << module_path;
-    if (!LoadModule(module_path)) {
-      AERROR << "Failed to load module: " << module_path;
+    DagConfig dag_config;
+    if (!common::GetProtoFromFile(module_path, &dag_config)) {
+      AERROR << "Get proto failed, file: " << module_path;
       return false;
     }
+    paths->emplace_back(std::move(module_path));
+    dag_configs->emplace_back(std::move(dag_config));
   }
   return true;
 }
 
-bool ModuleController::LoadModule(const DagConfig& dag_config) {
-  const std::string work_root = common::WorkRoot();
+std::string ModuleController::GetLibraryPath(
+    const std::string& module_library) {
+  if (module_library.front() == '/') {
+    return module_library;
+  }
+  return common::GetAbsolutePath(common::WorkRoot(), module_library);
+}
 
-  for (auto module_config : dag_config.module_config()) {
-    std::string load_path;
-    if (module_config.module_library().front() == '/') {
-      load_path = module_config.module_library();
-    } else {
-      load_path =
-          common::GetAbsolutePath(work_root, module_config.module_library());
+void ModuleController::PreloadLibraries(
+    const std::vector<DagConfig>& dag_configs) {
+  std::vector<std::string> libraries;
+  for (auto& dag_config : dag_configs) {
+    for (auto& module_config : dag_config.module_config()) {
+      std::string load_path = GetLibraryPath(module_config.module_library());
+      if (preloaded_.count(load_path) == 0 &&
+          common::PathExists(load_path)) {
+        preloaded_[load_path] = std::shared_future<bool>();
+        libraries.emplace_back(std::move(load_path));
+      }
+    }
+  }
+  if (libraries.empty()) {
+    return;
+  }
+
+  // dlopen has to be serialized (class registration and the dynamic linker
+  // both hold a global lock while static initializers run), but the reads
+  // of all the files can start at once.
+  for (auto& library : libraries) {
+    int fd = open(library.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd >= 0) {
+      posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+      close(fd);
     }
+  }
 
+  auto promises =
+      std::make_shared<std::vector<std::promise<bool>>>(libraries.size());
+  for (size_t i = 0; i < libraries.size(); ++i) {
+    preloaded_[libraries[i]] = (*promises)[i].get_future().share();
+  }
+  preload_stop_.store(false);
+  preload_thread_ = std::thread([this, libraries, promises]() {
+    for (size_t i = 0; i < libraries.size(); ++i) {
+      bool loaded = !preload_stop_.load() &&
+                    class_loader_manager_.LoadLibrary(libraries[i]);
+      (*promises)[i].set_value(loaded);
+    }
+  });
+}
+
+void ModuleController::StopPreload() {
+  preload_stop_.store(true);
+  if (preload_thread_.joinable()) {
+    preload_thread_.join();
+  }
+  preloaded_.clear();
+}
+
+bool ModuleController::LoadModule(const DagConfig& dag_config) {
+  for (auto module_config : dag_config.module_config()) {
+    std::string load_path = GetLibraryPath(module_config.module_library());
     if (!common::PathExists(load_path)) {
       AERROR << "Path does not exist: " << load_path;
       return false;
     }
 
+    auto preloaded = preloaded_.find(load_path);
+    if (preloaded != preloaded_.end()) {
+      preloaded->second.wait();
+    }
     class_loader_manager_.LoadLibrary(load_path);
 
     for (auto& component : module_config.components()) {
@@ -113,24 +214,12 @@ bool ModuleController::LoadModule(const DagConfig& dag_config) {
   return true;
 }
 
-bool ModuleController::LoadModule(const std::string& path) {
-  DagConfig dag_config;
-  if (!common::GetProtoFromFile(path, &dag_config)) {
-    AERROR << "Get proto failed, file: " << path;
-    return false;
-  }
-  return LoadModule(dag_config);
-}
-
-int ModuleController::GetComponentNum(const std::string& path) {
-  DagConfig dag_config;
+int ModuleController::GetComponentNum(const DagConfig& dag_config) {
   int component_nums = 0;
-  if (common::GetProtoFromFile(path, &dag_config)) {
-    for (auto module_config : dag_config.module_config()) {
-      component_nums += module_config.components_size();
-      if (module_config.timer_components_size() > 0) {
-        has_timer_component = true;
-      }
+  for (auto module_config : dag_config.module_config()) {
+    component_nums += module_config.components_size();
+    if (module_config.timer_components_size() > 0) {
+      has_timer_component = true;
     }
   }
   return component_nums;
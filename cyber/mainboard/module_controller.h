@@ -16,8 +16,12 @@
 #ifndef CYBER_MAINBOARD_MODULE_CONTROLLER_H_
 #define CYBER_MAINBOARD_MODULE_CONTROLLER_H_
 
+#include <atomic>
+#include <future>
 #include <memory>
 #include <string>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
 #include "cyber/proto/dag_conf.pb.h"
@@ -35,22 +39,38 @@ using apollo::cyber::proto::DagConfig;
 class ModuleController {
  public:
   explicit ModuleController(const ModuleArgument& args);
-  virtual ~ModuleController() = default;
+  virtual ~ModuleController() { StopPreload(); }
 
   bool Init();
   bool LoadAll();
   void Clear();
 
+  /**
+   * @brief Load the libraries of all dags without creating any component,
+   * used by the fork server to keep them initialized for its children.
+   */
+  bool LoadLibraries();
+
  private:
-  bool LoadModule(const std::string& path);
   bool LoadModule(const DagConfig& dag_config);
-  int GetComponentNum(const std::string& path);
+  int GetComponentNum(const DagConfig& dag_config);
+  bool GetDagConfigs(std::vector<std::string>* paths,
+                     std::vector<DagConfig>* dag_configs);
+  std::string GetLibraryPath(const std::string& module_library);
+  void PreloadLibraries(const std::vector<DagConfig>& dag_configs);
+  void StopPreload();
   int total_component_nums = 0;
   bool has_timer_component = false;
 
   ModuleArgument args_;
   class_loader::ClassLoaderManager class_loader_manager_;
   std::vector<std::shared_ptr<ComponentBase>> component_list_;
+
+  /// libraries are dlopen-ed in dag order by `preload_thread_` while the
+  /// components of the ones already loaded are initialized
+  std::unordered_map<std::string, std::shared_future<bool>> preloaded_;
+  std::thread preload_thread_;
+  std::atomic<bool> preload_stop_{false};
 };
 
 inline ModuleController::ModuleController(const ModuleArgument& args)
@@ -0,0 +1,107 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/mainboard/profiler_service.h"
+
+#include <unistd.h>
+
+#include "cyber/common/log.h"
+#include "cyber/cyber.h"
+#include "cyber/sysmo/alloc_tracker.h"
+#include "cyber/sysmo/sampling_profiler.h"
+#include "cyber/time/time.h"
+
+namespace apollo {
+namespace cyber {
+namespace mainboard {
+
+using apollo::cyber::proto::ProfilerRequest;
+using apollo::cyber::proto::ProfilerResponse;
+
+const char ProfilerService::kServicePrefix[] = "/cyber/profiler/";
+
+ProfilerService::~ProfilerService() {
+  auto profiler = SamplingProfiler::Instance(false);
+  if (profiler != nullptr && profiler->IsRunning()) {
+    uint64_t num_samples = 0;
+    uint64_t num_dropped = 0;
+    std::string error;
+    profiler->Stop("", &num_samples, &num_dropped, &error);
+  }
+}
+
+bool ProfilerService::Init(const std::string& process_group) {
+  process_group_ = process_group;
+  node_ = CreateNode("profiler_" + process_group + "_" +
+                     std::to_string(getpid()));
+  if (node_ == nullptr) {
+    AERROR << "Failed to create the profiler node.";
+    return false;
+  }
+  service_ = node_->CreateService<ProfilerRequest, ProfilerResponse>(
+      kServicePrefix + process_group,
+      [this](const std::shared_ptr<ProfilerRequest>& request,
+             std::shared_ptr<ProfilerResponse>& response) {
+        OnRequest(request, response);
+      });
+  if (service_ == nullptr) {
+    AERROR << "Failed to create the profiler service.";
+    return false;
+  }
+  AINFO << "Profiler service on " << kServicePrefix << process_group;
+  return true;
+}
+
+void ProfilerService::OnRequest(
+    const std::shared_ptr<ProfilerRequest>& request,
+    const std::shared_ptr<ProfilerResponse>& response) {
+  auto profiler = SamplingProfiler::Instance();
+  std::string error;
+  if (request->command() == ProfilerRequest::START) {
+    response->set_success(profiler->Start(request->frequency(),
+                                          request->max_samples(), &error));
+  } else {
+    const bool heap = request->command() == ProfilerRequest::HEAP_PROFILE;
+    std::string output_file = request->output_file();
+    if (output_file.empty()) {
+      output_file = "/tmp/" + process_group_ + "." +
+                    std::to_string(getpid()) + "." +
+                    std::to_string(static_cast<uint64_t>(
+                        Time::Now().ToSecond())) +
+                    (heap ? ".heap.pprof" : ".pprof");
+    }
+    uint64_t num_samples = 0;
+    uint64_t num_dropped = 0;
+    if (heap) {
+      response->set_success(AllocTracker::WriteProfile(
+          output_file, &num_samples, &num_dropped, &error));
+    } else {
+      response->set_success(
+          profiler->Stop(output_file, &num_samples, &num_dropped, &error));
+    }
+    response->set_output_file(output_file);
+    response->set_num_samples(num_samples);
+    response->set_num_dropped(num_dropped);
+  }
+  if (!error.empty()) {
+    response->set_message(error);
+    AWARN << "Profiler request failed: " << error;
+  }
+}
+
+}  // namespace mainboard
+}  // namespace cyber
+}  // namespace apollo
@@ -0,0 +1,61 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_MAINBOARD_PROFILER_SERVICE_H_
+#define CYBER_MAINBOARD_PROFILER_SERVICE_H_
+
+#include <memory>
+#include <string>
+
+#include "cyber/proto/profiler.pb.h"
+
+#include "cyber/node/node.h"
+
+namespace apollo {
+namespace cyber {
+namespace mainboard {
+
+/**
+ * @class ProfilerService
+ * @brief Starts and stops the SamplingProfiler of the process on requests to
+ * /cyber/profiler/<process_group>, so that the cpu profile of a running
+ * module is taken without restarting it. Writes the heap profile of the
+ * AllocTracker as well.
+ */
+class ProfilerService {
+ public:
+  static const char kServicePrefix[];
+
+  ProfilerService() = default;
+  virtual ~ProfilerService();
+
+  bool Init(const std::string& process_group);
+
+ private:
+  void OnRequest(const std::shared_ptr<proto::ProfilerRequest>& request,
+                 const std::shared_ptr<proto::ProfilerResponse>& response);
+
+  std::string process_group_;
+  std::unique_ptr<Node> node_;
+  std::shared_ptr<Service<proto::ProfilerRequest, proto::ProfilerResponse>>
+      service_;
+};
+
+}  // namespace mainboard
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_MAINBOARD_PROFILER_SERVICE_H_
@@ -0,0 +1,111 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/message/arena_pool.h"
+
+#include <algorithm>
+
+namespace apollo {
+namespace cyber {
+namespace message {
+
+constexpr std::size_t ArenaPool::kInitialBlockSize;
+constexpr std::size_t ArenaPool::kMaxBlockSize;
+constexpr std::size_t ArenaPool::kMaxPooledArenas;
+
+ArenaPool::PooledArena::PooledArena(std::size_t block_size)
+    : block_(new char[block_size]), block_size_(block_size) {
+  google::protobuf::ArenaOptions options;
+  options.initial_block = block_.get();
+  options.initial_block_size = block_size_;
+  arena_.reset(new google::protobuf::Arena(options));
+}
+
+ArenaPool::ArenaPool() {}
+
+ArenaPool::~ArenaPool() {
+  std::lock_guard<std::mutex> lock(pool_mutex_);
+  for (auto pooled : pool_) {
+    delete pooled;
+  }
+  pool_.clear();
+}
+
+ArenaPool::PooledArena* ArenaPool::Acquire() {
+  {
+    std::lock_guard<std::mutex> lock(pool_mutex_);
+    if (!pool_.empty()) {
+      auto pooled = pool_.back();
+      pool_.pop_back();
+      return pooled;
+    }
+  }
+  return new PooledArena(kInitialBlockSize);
+}
+
+void ArenaPool::Release(PooledArena* pooled) {
+  // the blocks beyond the initial one are freed by the reset, so an arena
+  // that needed them is rebuilt on a block large enough for next time
+  const std::size_t used =
+      static_cast<std::size_t>(pooled->arena()->SpaceAllocated());
+  pooled->arena()->Reset();
+  if (used > pooled->block_size() && pooled->block_size() < kMaxBlockSize) {
+    std::size_t block_size = pooled->block_size();
+    while (block_size < used && block_size < kMaxBlockSize) {
+      block_size *= 2;
+    }
+    delete pooled;
+    pooled = new PooledArena(std::min(block_size, kMaxBlockSize));
+  }
+  {
+    std::lock_guard<std::mutex> lock(pool_mutex_);
+    if (pool_.size() < kMaxPooledArenas) {
+      pool_.emplace_back(pooled);
+      return;
+    }
+  }
+  delete pooled;
+}
+
+std::size_t ArenaPool::pooled_size() {
+  std::lock_guard<std::mutex> lock(pool_mutex_);
+  return pool_.size();
+}
+
+const std::atomic<bool>* ArenaPool::ChannelFlag(uint64_t channel_id) {
+  return MutableChannelFlag(channel_id);
+}
+
+void ArenaPool::EnableForChannel(uint64_t channel_id) {
+  MutableChannelFlag(channel_id)->store(true, std::memory_order_relaxed);
+}
+
+bool ArenaPool::IsEnabledForChannel(uint64_t channel_id) {
+  return ChannelFlag(channel_id)->load(std::memory_order_relaxed);
+}
+
+std::atomic<bool>* ArenaPool::MutableChannelFlag(uint64_t channel_id) {
+  std::lock_guard<std::mutex> lock(flags_mutex_);
+  auto& flag = flags_[channel_id];
+  if (flag == nullptr) {
+    flag.reset(new std::atomic<bool>(false));
+  }
+  return flag.get();
+}
+
+}  // namespace message
+}  // namespace cyber
+}  // namespace apollo
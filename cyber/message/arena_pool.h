@@ -0,0 +1,142 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_MESSAGE_ARENA_POOL_H_
+#define CYBER_MESSAGE_ARENA_POOL_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "google/protobuf/arena.h"
+#include "google/protobuf/message.h"
+
+#include "cyber/common/macros.h"
+
+namespace apollo {
+namespace cyber {
+namespace message {
+
+/**
+ * @class ArenaPool
+ * @brief Recycles the protobuf arenas of messages made by NewArenaMessage().
+ *
+ * Such a message and all its nested fields live on an arena taken from the
+ * pool, and the arena is reset and put back when the last shared_ptr to the
+ * message is released. Each arena starts on a block of its own, which is
+ * grown to what the messages it held needed, so that the nested messages and
+ * repeated fields of a message of a size seen before are not allocated one
+ * by one. String contents are still allocated on the heap.
+ *
+ * Receivers are shared by all the readers of a channel in a process, so
+ * parsing onto arenas is enabled per channel.
+ */
+class ArenaPool {
+ public:
+  class PooledArena {
+   public:
+    explicit PooledArena(std::size_t block_size);
+
+    google::protobuf::Arena* arena() { return arena_.get(); }
+    std::size_t block_size() const { return block_size_; }
+
+   private:
+    // the arena goes before the block it is built on
+    std::unique_ptr<char[]> block_;
+    std::size_t block_size_;
+    std::unique_ptr<google::protobuf::Arena> arena_;
+  };
+
+  static constexpr std::size_t kInitialBlockSize = 16 * 1024;
+  static constexpr std::size_t kMaxBlockSize = 4 * 1024 * 1024;
+  static constexpr std::size_t kMaxPooledArenas = 64;
+
+  ~ArenaPool();
+
+  PooledArena* Acquire();
+  void Release(PooledArena* pooled);
+
+  std::size_t pooled_size();
+
+  /**
+   * @brief The flag of `channel_id`, for the dispatchers to check per message.
+   * It is never freed.
+   */
+  const std::atomic<bool>* ChannelFlag(uint64_t channel_id);
+  void EnableForChannel(uint64_t channel_id);
+  bool IsEnabledForChannel(uint64_t channel_id);
+
+ private:
+  std::atomic<bool>* MutableChannelFlag(uint64_t channel_id);
+
+  std::mutex pool_mutex_;
+  std::vector<PooledArena*> pool_;
+
+  std::mutex flags_mutex_;
+  std::unordered_map<uint64_t, std::unique_ptr<std::atomic<bool>>> flags_;
+
+  DECLARE_SINGLETON(ArenaPool)
+};
+
+/**
+ * @brief Make a message on a pooled arena, e.g. to parse a large nested
+ * message into, or for a Writer to fill in and publish.
+ */
+template <typename MessageT,
+          typename std::enable_if<
+              std::is_base_of<google::protobuf::Message, MessageT>::value,
+              int>::type = 0>
+std::shared_ptr<MessageT> NewArenaMessage() {
+  auto pool = ArenaPool::Instance();
+  if (pool == nullptr) {
+    return std::make_shared<MessageT>();
+  }
+  auto pooled = pool->Acquire();
+  auto msg =
+      google::protobuf::Arena::CreateMessage<MessageT>(pooled->arena());
+  // the arena owns the message, so only the arena is handed back
+  return std::shared_ptr<MessageT>(
+      msg, [pool, pooled](MessageT*) { pool->Release(pooled); });
+}
+
+template <typename MessageT,
+          typename std::enable_if<
+              !std::is_base_of<google::protobuf::Message, MessageT>::value,
+              int>::type = 0>
+std::shared_ptr<MessageT> NewArenaMessage() {
+  return std::make_shared<MessageT>();
+}
+
+/**
+ * @brief Make a message to parse a received one into. Messages which are
+ * not protobuf ones never live on arenas.
+ */
+template <typename MessageT>
+std::shared_ptr<MessageT> NewMessage(bool use_arena) {
+  return use_arena ? NewArenaMessage<MessageT>()
+                   : std::make_shared<MessageT>();
+}
+
+}  // namespace message
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_MESSAGE_ARENA_POOL_H_
@@ -0,0 +1,100 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/message/arena_pool.h"
+
+#include <memory>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "cyber/proto/unit_test.pb.h"
+
+namespace apollo {
+namespace cyber {
+namespace message {
+
+TEST(ArenaPoolTest, arena_message) {
+  auto pool = ArenaPool::Instance();
+  const std::size_t pooled_size = pool->pooled_size();
+  {
+    auto msg = NewArenaMessage<proto::UnitTest>();
+    EXPECT_NE(msg->GetArena(), nullptr);
+    msg->set_class_name("ArenaPoolTest");
+    msg->set_case_name("arena_message");
+
+    std::string str;
+    EXPECT_TRUE(msg->SerializeToString(&str));
+    auto parsed = NewArenaMessage<proto::UnitTest>();
+    EXPECT_NE(parsed->GetArena(), msg->GetArena());
+    EXPECT_TRUE(parsed->ParseFromString(str));
+    EXPECT_EQ(parsed->class_name(), "ArenaPoolTest");
+    EXPECT_EQ(parsed->case_name(), "arena_message");
+
+    // the arena is still in use by the copy
+    auto copy = msg;
+    msg.reset();
+    EXPECT_EQ(copy->case_name(), "arena_message");
+  }
+  // both arenas are back, and the next message reuses one of them
+  EXPECT_EQ(pool->pooled_size(), pooled_size + 2);
+  auto msg = NewArenaMessage<proto::UnitTest>();
+  EXPECT_EQ(pool->pooled_size(), pooled_size + 1);
+  EXPECT_TRUE(msg->class_name().empty());
+}
+
+TEST(ArenaPoolTest, large_message) {
+  auto pool = ArenaPool::Instance();
+  auto pooled = pool->Acquire();
+  google::protobuf::Arena::CreateArray<char>(
+      pooled->arena(), 2 * ArenaPool::kInitialBlockSize);
+  pool->Release(pooled);
+
+  // the arena is rebuilt on a block large enough for the same message
+  pooled = pool->Acquire();
+  EXPECT_GE(pooled->block_size(), 2 * ArenaPool::kInitialBlockSize);
+  EXPECT_LE(pooled->block_size(), ArenaPool::kMaxBlockSize);
+  pool->Release(pooled);
+}
+
+TEST(ArenaPoolTest, new_message) {
+  auto msg = NewMessage<proto::UnitTest>(false);
+  EXPECT_EQ(msg->GetArena(), nullptr);
+  msg = NewMessage<proto::UnitTest>(true);
+  EXPECT_NE(msg->GetArena(), nullptr);
+
+  // only protobuf messages live on arenas
+  auto str = NewMessage<std::string>(true);
+  EXPECT_TRUE(str->empty());
+}
+
+TEST(ArenaPoolTest, channel_flag) {
+  auto pool = ArenaPool::Instance();
+  const uint64_t channel_id = 12345;
+  auto flag = pool->ChannelFlag(channel_id);
+  EXPECT_FALSE(flag->load());
+  EXPECT_FALSE(pool->IsEnabledForChannel(channel_id));
+
+  pool->EnableForChannel(channel_id);
+  EXPECT_TRUE(flag->load());
+  EXPECT_TRUE(pool->IsEnabledForChannel(channel_id));
+  EXPECT_EQ(pool->ChannelFlag(channel_id), flag);
+  EXPECT_FALSE(pool->IsEnabledForChannel(channel_id + 1));
+}
+
+}  // namespace message
+}  // namespace cyber
+}  // namespace apollo
@@ -0,0 +1,138 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_MESSAGE_RAW_MESSAGE_VIEW_H_
+#define CYBER_MESSAGE_RAW_MESSAGE_VIEW_H_
+
+#include <cstring>
+#include <memory>
+#include <string>
+
+#include "cyber/message/protobuf_factory.h"
+
+namespace apollo {
+namespace cyber {
+namespace message {
+
+/**
+ * @class RawMessageView
+ * @brief Read-only view of serialized bytes. When delivered by the shared
+ * memory transport the view points straight into the segment block and keeps
+ * it read-locked through `holder`, so no copy or parse happens on the reader
+ * side. On the intra/rtps paths it falls back to owning a copy of the bytes.
+ */
+class RawMessageView {
+ public:
+  RawMessageView() : data_(nullptr), size_(0) {}
+
+  RawMessageView(const RawMessageView &other)
+      : holder_(other.holder_), size_(other.size_), storage_(other.storage_) {
+    data_ = holder_ != nullptr ? other.data_ : storage_.data();
+  }
+
+  RawMessageView &operator=(const RawMessageView &other) {
+    if (this != &other) {
+      holder_ = other.holder_;
+      storage_ = other.storage_;
+      data_ = holder_ != nullptr ? other.data_ : storage_.data();
+      size_ = other.size_;
+    }
+    return *this;
+  }
+
+  ~RawMessageView() {}
+
+  void Attach(const std::shared_ptr<const void> &holder, const void *data,
+              size_t size) {
+    holder_ = holder;
+    storage_.clear();
+    data_ = reinterpret_cast<const char *>(data);
+    size_ = size;
+  }
+
+  const char *data() const { return data_; }
+  size_t size() const { return size_; }
+  bool is_zero_copy() const { return holder_ != nullptr; }
+
+  class Descriptor {
+   public:
+    std::string full_name() const { return "apollo.cyber.message.RawMessage"; }
+    std::string name() const { return "apollo.cyber.message.RawMessage"; }
+  };
+
+  static const Descriptor *descriptor() {
+    static Descriptor desc;
+    return &desc;
+  }
+
+  static void GetDescriptorString(const std::string &type,
+                                  std::string *desc_str) {
+    ProtobufFactory::Instance()->GetDescriptorString(type, desc_str);
+  }
+
+  bool SerializeToArray(void *data, int size) const {
+    if (data == nullptr || size < ByteSize()) {
+      return false;
+    }
+    if (size_ > 0) {
+      memcpy(data, data_, size_);
+    }
+    return true;
+  }
+
+  bool SerializeToString(std::string *str) const {
+    if (str == nullptr) {
+      return false;
+    }
+    str->assign(data_, size_);
+    return true;
+  }
+
+  bool ParseFromArray(const void *data, int size) {
+    if (data == nullptr || size <= 0) {
+      return false;
+    }
+    holder_.reset();
+    storage_.assign(reinterpret_cast<const char *>(data), size);
+    data_ = storage_.data();
+    size_ = storage_.size();
+    return true;
+  }
+
+  bool ParseFromString(const std::string &str) {
+    holder_.reset();
+    storage_ = str;
+    data_ = storage_.data();
+    size_ = storage_.size();
+    return true;
+  }
+
+  int ByteSize() const { return static_cast<int>(size_); }
+
+  static std::string TypeName() { return "apollo.cyber.message.RawMessage"; }
+
+ private:
+  std::shared_ptr<const void> holder_;
+  const char *data_;
+  size_t size_;
+  std::string storage_;
+};
+
+}  // namespace message
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_MESSAGE_RAW_MESSAGE_VIEW_H_
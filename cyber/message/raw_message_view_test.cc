@@ -0,0 +1,81 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/message/raw_message_view.h"
+
+#include <cstring>
+#include <memory>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "cyber/message/message_traits.h"
+
+namespace apollo {
+namespace cyber {
+namespace message {
+
+TEST(RawMessageViewTest, constructor) {
+  RawMessageView view;
+  EXPECT_EQ(view.size(), 0);
+  EXPECT_FALSE(view.is_zero_copy());
+}
+
+TEST(RawMessageViewTest, attach) {
+  auto buf = std::make_shared<std::string>("attached");
+  RawMessageView view;
+  view.Attach(buf, buf->data(), buf->size());
+  EXPECT_TRUE(view.is_zero_copy());
+  EXPECT_EQ(view.data(), buf->data());
+  EXPECT_EQ(view.size(), buf->size());
+
+  // copies share the attached buffer instead of duplicating it
+  RawMessageView copy(view);
+  EXPECT_EQ(copy.data(), buf->data());
+  EXPECT_EQ(buf.use_count(), 3);
+}
+
+TEST(RawMessageViewTest, parse_and_serialize) {
+  RawMessageView view;
+  std::string str("parse_from_array");
+  EXPECT_FALSE(view.ParseFromArray(nullptr, static_cast<int>(str.size())));
+  EXPECT_TRUE(view.ParseFromArray(str.data(), static_cast<int>(str.size())));
+  EXPECT_FALSE(view.is_zero_copy());
+  EXPECT_NE(view.data(), str.data());
+  EXPECT_EQ(ByteSize(view), static_cast<int>(str.size()));
+
+  RawMessageView copy;
+  copy = view;
+  EXPECT_NE(copy.data(), view.data());
+
+  std::string out;
+  EXPECT_TRUE(copy.SerializeToString(&out));
+  EXPECT_EQ(out, str);
+
+  char buf[64] = {0};
+  EXPECT_FALSE(copy.SerializeToArray(buf, 4));
+  EXPECT_TRUE(copy.SerializeToArray(buf, 64));
+  EXPECT_EQ(memcmp(buf, str.data(), str.size()), 0);
+}
+
+TEST(RawMessageViewTest, message_type) {
+  EXPECT_EQ(RawMessageView::TypeName(), "apollo.cyber.message.RawMessage");
+  EXPECT_TRUE(HasSerializer<RawMessageView>::value);
+}
+
+}  // namespace message
+}  // namespace cyber
+}  // namespace apollo
@@ -0,0 +1,51 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/node/inline_chain.h"
+
+namespace apollo {
+namespace cyber {
+
+using base::AtomicRWLock;
+using base::ReadLockGuard;
+using base::WriteLockGuard;
+
+InlineChain::InlineChain() {}
+
+bool InlineChain::Add(uint64_t channel_id,
+                      const std::shared_ptr<Chain>& chain) {
+  WriteLockGuard<AtomicRWLock> lock(rw_lock_);
+  if (!chains_.emplace(channel_id, chain).second) {
+    return false;
+  }
+  size_.store(static_cast<int>(chains_.size()), std::memory_order_release);
+  return true;
+}
+
+void InlineChain::Remove(uint64_t channel_id) {
+  WriteLockGuard<AtomicRWLock> lock(rw_lock_);
+  chains_.erase(channel_id);
+  size_.store(static_cast<int>(chains_.size()), std::memory_order_release);
+}
+
+std::shared_ptr<InlineChain::Chain> InlineChain::Find(uint64_t channel_id) {
+  ReadLockGuard<AtomicRWLock> lock(rw_lock_);
+  auto iter = chains_.find(channel_id);
+  return iter == chains_.end() ? nullptr : iter->second;
+}
+
+}  // namespace cyber
+}  // namespace apollo
@@ -0,0 +1,115 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_NODE_INLINE_CHAIN_H_
+#define CYBER_NODE_INLINE_CHAIN_H_
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <typeinfo>
+#include <unordered_map>
+
+#include "cyber/base/atomic_rw_lock.h"
+#include "cyber/base/rw_lock_guard.h"
+#include "cyber/common/macros.h"
+
+namespace apollo {
+namespace cyber {
+
+/**
+ * @class InlineChain
+ * @brief The in-process consumers which run directly in the croutine of the
+ * writer of their channel.
+ *
+ * A chained consumer has no reader: the writer of the channel calls it after
+ * transmitting a message to the readers, if any, handing over the same
+ * shared_ptr. This saves the dispatch, the channel buffer and the scheduler
+ * wake-up of a reader, at the cost of running the consumer on the writer's
+ * time. A channel takes at most one chained consumer.
+ */
+class InlineChain {
+ public:
+  template <typename MessageT>
+  using Handler = std::function<void(const std::shared_ptr<MessageT>&)>;
+
+  template <typename MessageT>
+  bool Add(uint64_t channel_id, const Handler<MessageT>& handler);
+
+  void Remove(uint64_t channel_id);
+
+  bool Has(uint64_t channel_id) {
+    return size_.load(std::memory_order_acquire) > 0 &&
+           Find(channel_id) != nullptr;
+  }
+
+  /**
+   * @brief Run the consumer chained to `channel_id`, if there is one.
+   *
+   * @return true if a consumer was run
+   */
+  template <typename MessageT>
+  bool Run(uint64_t channel_id, const std::shared_ptr<MessageT>& msg);
+
+ private:
+  using ErasedHandler = std::function<void(const std::shared_ptr<void>&)>;
+
+  struct Chain {
+    std::string type_name;
+    ErasedHandler handler;
+  };
+
+  bool Add(uint64_t channel_id, const std::shared_ptr<Chain>& chain);
+  std::shared_ptr<Chain> Find(uint64_t channel_id);
+
+  base::AtomicRWLock rw_lock_;
+  std::unordered_map<uint64_t, std::shared_ptr<Chain>> chains_;
+  std::atomic<int> size_ = {0};
+
+  DECLARE_SINGLETON(InlineChain)
+};
+
+template <typename MessageT>
+bool InlineChain::Add(uint64_t channel_id, const Handler<MessageT>& handler) {
+  auto chain = std::make_shared<Chain>();
+  chain->type_name = typeid(MessageT).name();
+  chain->handler = [handler](const std::shared_ptr<void>& msg) {
+    handler(std::static_pointer_cast<MessageT>(msg));
+  };
+  return Add(channel_id, chain);
+}
+
+template <typename MessageT>
+bool InlineChain::Run(uint64_t channel_id,
+                      const std::shared_ptr<MessageT>& msg) {
+  if (size_.load(std::memory_order_acquire) == 0) {
+    return false;
+  }
+  auto chain = Find(channel_id);
+  if (chain == nullptr || chain->type_name != typeid(MessageT).name()) {
+    return false;
+  }
+  // the lock is not held here, so the consumer may write to chained channels
+  chain->handler(std::static_pointer_cast<void>(msg));
+  return true;
+}
+
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_NODE_INLINE_CHAIN_H_
@@ -0,0 +1,76 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/node/inline_chain.h"
+
+#include <memory>
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace cyber {
+
+TEST(InlineChainTest, run) {
+  auto chain = InlineChain::Instance();
+  const uint64_t channel_id = 1;
+  auto msg = std::make_shared<std::string>("chained");
+  EXPECT_FALSE(chain->Has(channel_id));
+  EXPECT_FALSE(chain->Run(channel_id, msg));
+
+  std::shared_ptr<std::string> received;
+  EXPECT_TRUE(chain->Add<std::string>(
+      channel_id,
+      [&received](const std::shared_ptr<std::string>& msg) {
+        received = msg;
+      }));
+  EXPECT_TRUE(chain->Has(channel_id));
+  EXPECT_FALSE(chain->Has(channel_id + 1));
+
+  // the very message is handed over
+  EXPECT_TRUE(chain->Run(channel_id, msg));
+  EXPECT_EQ(received, msg);
+  EXPECT_FALSE(chain->Run(channel_id + 1, msg));
+
+  // nor a second consumer, nor a message of another type
+  EXPECT_FALSE(chain->Add<std::string>(
+      channel_id, [](const std::shared_ptr<std::string>&) {}));
+  EXPECT_FALSE(chain->Run(channel_id, std::make_shared<int>(1)));
+
+  chain->Remove(channel_id);
+  EXPECT_FALSE(chain->Has(channel_id));
+  received = nullptr;
+  EXPECT_FALSE(chain->Run(channel_id, msg));
+  EXPECT_EQ(received, nullptr);
+}
+
+TEST(InlineChainTest, nested_run) {
+  // a chained consumer may write to a channel chained in turn
+  auto chain = InlineChain::Instance();
+  int received = 0;
+  EXPECT_TRUE(chain->Add<int>(2, [chain](const std::shared_ptr<int>& msg) {
+    chain->Run(3, std::make_shared<int>(*msg + 1));
+  }));
+  EXPECT_TRUE(chain->Add<int>(
+      3, [&received](const std::shared_ptr<int>& msg) { received = *msg; }));
+  EXPECT_TRUE(chain->Run(2, std::make_shared<int>(1)));
+  EXPECT_EQ(received, 2);
+  chain->Remove(2);
+  chain->Remove(3);
+}
+
+}  // namespace cyber
+}  // namespace apollo
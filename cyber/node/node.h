@@ -109,6 +109,23 @@ class Node {
                     const CallbackFunc<MessageT>& reader_func = nullptr)
       -> std::shared_ptr<cyber::Reader<MessageT>>;
 
+  /**
+   * @brief Create a Reader that hands all messages queued since the last
+   * callback to `batch_func` at once. This saves one croutine resume per
+   * message on high rate channels, `config.pending_queue_size` bounds the
+   * batch.
+   *
+   * @tparam MessageT Message Type
+   * @param config instance of `ReaderConfig`,
+   * include channel name, qos and pending queue size
+   * @param batch_func invoked with the received messages in arrival order
+   * @return std::shared_ptr<cyber::Reader<MessageT>> result Reader Object
+   */
+  template <typename MessageT>
+  auto CreateBatchReader(const ReaderConfig& config,
+                         const BatchCallbackFunc<MessageT>& batch_func)
+      -> std::shared_ptr<cyber::Reader<MessageT>>;
+
   /**
    * @brief Create a Reader object with `RoleAttributes`
    *
@@ -233,6 +250,24 @@ auto Node::CreateReader(const ReaderConfig& config,
   return reader;
 }
 
+template <typename MessageT>
+auto Node::CreateBatchReader(const ReaderConfig& config,
+                             const BatchCallbackFunc<MessageT>& batch_func)
+    -> std::shared_ptr<cyber::Reader<MessageT>> {
+  std::lock_guard<std::mutex> lg(readers_mutex_);
+  if (readers_.find(config.channel_name) != readers_.end()) {
+    AWARN << "Failed to create reader: reader with the same channel already "
+             "exists.";
+    return nullptr;
+  }
+  auto reader = node_channel_impl_->template CreateBatchReader<MessageT>(
+      config, batch_func);
+  if (reader != nullptr) {
+    readers_.emplace(std::make_pair(config.channel_name, reader));
+  }
+  return reader;
+}
+
 template <typename MessageT>
 auto Node::CreateReader(const std::string& channel_name,
                         const CallbackFunc<MessageT>& reader_func)
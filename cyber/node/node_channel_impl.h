@@ -44,11 +44,19 @@ struct ReaderConfig {  ///< configurations for a Reader
     qos_profile.set_durability(proto::QosDurabilityPolicy::DURABILITY_VOLATILE);
 
     pending_queue_size = DEFAULT_PENDING_QUEUE_SIZE;
+    lock_free_buffer = false;
+    arena_allocation = false;
+    latest_only = false;
+    deadline_ms = 0;
   }
   ReaderConfig(const ReaderConfig& other)
       : channel_name(other.channel_name),
         qos_profile(other.qos_profile),
-        pending_queue_size(other.pending_queue_size) {}
+        pending_queue_size(other.pending_queue_size),
+        lock_free_buffer(other.lock_free_buffer),
+        arena_allocation(other.arena_allocation),
+        latest_only(other.latest_only),
+        deadline_ms(other.deadline_ms) {}
 
   std::string channel_name;       //< channel reads
   proto::QosProfile qos_profile;  //< the qos configuration
@@ -57,6 +65,30 @@ struct ReaderConfig {  ///< configurations for a Reader
    * Older messages will dropped if you have no time to handle
    */
   uint32_t pending_queue_size;
+  /**
+   * @brief read the ChannelBuffer without its mutex, worth it for channels
+   * that are fetched far more often than written, e.g. by fusion readers
+   */
+  bool lock_free_buffer;
+  /**
+   * @brief parse the received messages onto pooled protobuf arenas, worth
+   * it for large nested messages, e.g. perception or prediction obstacles.
+   * It applies to every reader of the channel in the process.
+   */
+  bool arena_allocation;
+  /**
+   * @brief only the newest message is of use, e.g. to a planner slower than
+   * its input. The pending queue then holds one message, and writers of
+   * other processes do not even serialize messages while all the readers of
+   * the process are latest-only and in their callback.
+   */
+  bool latest_only;
+  /**
+   * @brief drop the messages which waited longer than this in the pending
+   * queue, 0 for no deadline. Dropped messages are counted per channel in
+   * transport::ChannelStatistics, like the ones lost to overflow.
+   */
+  uint32_t deadline_ms;
 };
 
 /**
@@ -132,13 +164,21 @@ class NodeChannelImpl {
   template <typename MessageT>
   auto CreateReader(const proto::RoleAttributes& role_attr,
                     const CallbackFunc<MessageT>& reader_func,
-                    uint32_t pending_queue_size = DEFAULT_PENDING_QUEUE_SIZE)
+                    uint32_t pending_queue_size = DEFAULT_PENDING_QUEUE_SIZE,
+                    bool lock_free_buffer = false,
+                    bool arena_allocation = false, bool latest_only = false,
+                    uint32_t deadline_ms = 0)
       -> std::shared_ptr<Reader<MessageT>>;
 
   template <typename MessageT>
   auto CreateReader(const proto::RoleAttributes& role_attr)
       -> std::shared_ptr<Reader<MessageT>>;
 
+  template <typename MessageT>
+  auto CreateBatchReader(const ReaderConfig& config,
+                         const BatchCallbackFunc<MessageT>& batch_func)
+      -> std::shared_ptr<Reader<MessageT>>;
+
   template <typename MessageT>
   void FillInAttr(proto::RoleAttributes* attr);
 
@@ -194,14 +234,19 @@ auto NodeChannelImpl::CreateReader(const ReaderConfig& config,
   proto::RoleAttributes role_attr;
   role_attr.set_channel_name(config.channel_name);
   role_attr.mutable_qos_profile()->CopyFrom(config.qos_profile);
-  return this->template CreateReader<MessageT>(role_attr, reader_func,
-                                               config.pending_queue_size);
+  return this->template CreateReader<MessageT>(
+      role_attr, reader_func, config.pending_queue_size,
+      config.lock_free_buffer, config.arena_allocation, config.latest_only,
+      config.deadline_ms);
 }
 
 template <typename MessageT>
 auto NodeChannelImpl::CreateReader(const proto::RoleAttributes& role_attr,
                                    const CallbackFunc<MessageT>& reader_func,
-                                   uint32_t pending_queue_size)
+                                   uint32_t pending_queue_size,
+                                   bool lock_free_buffer,
+                                   bool arena_allocation, bool latest_only,
+                                   uint32_t deadline_ms)
     -> std::shared_ptr<Reader<MessageT>> {
   if (!role_attr.has_channel_name() || role_attr.channel_name().empty()) {
     AERROR << "Can't create a reader with empty channel name!";
@@ -218,6 +263,10 @@ auto NodeChannelImpl::CreateReader(const proto::RoleAttributes& role_attr,
   } else {
     reader_ptr = std::make_shared<Reader<MessageT>>(new_attr, reader_func,
                                                     pending_queue_size);
+    reader_ptr->SetLockFreeBuffer(lock_free_buffer);
+    reader_ptr->SetArenaAllocation(arena_allocation);
+    reader_ptr->SetLatestOnly(latest_only);
+    reader_ptr->SetDeadline(deadline_ms);
   }
 
   RETURN_VAL_IF_NULL(reader_ptr, nullptr);
@@ -231,6 +280,46 @@ auto NodeChannelImpl::CreateReader(const proto::RoleAttributes& role_attr)
   return this->template CreateReader<MessageT>(role_attr, nullptr);
 }
 
+template <typename MessageT>
+auto NodeChannelImpl::CreateBatchReader(
+    const ReaderConfig& config, const BatchCallbackFunc<MessageT>& batch_func)
+    -> std::shared_ptr<Reader<MessageT>> {
+  if (config.channel_name.empty()) {
+    AERROR << "Can't create a reader with empty channel name!";
+    return nullptr;
+  }
+
+  proto::RoleAttributes new_attr;
+  new_attr.set_channel_name(config.channel_name);
+  new_attr.mutable_qos_profile()->CopyFrom(config.qos_profile);
+  FillInAttr<MessageT>(&new_attr);
+
+  std::shared_ptr<Reader<MessageT>> reader_ptr = nullptr;
+  if (!is_reality_mode_) {
+    // messages are handed over one by one in simulation mode
+    CallbackFunc<MessageT> func = nullptr;
+    if (batch_func != nullptr) {
+      func = [batch_func](const std::shared_ptr<MessageT>& msg) {
+        batch_func({msg});
+      };
+    }
+    reader_ptr =
+        std::make_shared<blocker::IntraReader<MessageT>>(new_attr, func);
+  } else {
+    reader_ptr = std::make_shared<Reader<MessageT>>(new_attr, nullptr,
+                                                    config.pending_queue_size);
+    reader_ptr->SetBatchCallback(batch_func);
+    reader_ptr->SetLockFreeBuffer(config.lock_free_buffer);
+    reader_ptr->SetArenaAllocation(config.arena_allocation);
+    reader_ptr->SetLatestOnly(config.latest_only);
+    reader_ptr->SetDeadline(config.deadline_ms);
+  }
+
+  RETURN_VAL_IF_NULL(reader_ptr, nullptr);
+  RETURN_VAL_IF(!reader_ptr->Init(), nullptr);
+  return reader_ptr;
+}
+
 template <typename MessageT>
 void NodeChannelImpl::FillInAttr(proto::RoleAttributes* attr) {
   attr->set_host_name(node_attr_.host_name());
@@ -32,10 +32,12 @@
 #include "cyber/common/global_data.h"
 #include "cyber/croutine/routine_factory.h"
 #include "cyber/data/data_visitor.h"
+#include "cyber/message/arena_pool.h"
 #include "cyber/node/reader_base.h"
 #include "cyber/scheduler/scheduler_factory.h"
 #include "cyber/service_discovery/topology_manager.h"
 #include "cyber/time/time.h"
+#include "cyber/transport/shm/busy_readers.h"
 #include "cyber/transport/transport.h"
 
 namespace apollo {
@@ -44,6 +46,10 @@ namespace cyber {
 template <typename M0>
 using CallbackFunc = std::function<void(const std::shared_ptr<M0>&)>;
 
+template <typename M0>
+using BatchCallbackFunc =
+    std::function<void(const std::vector<std::shared_ptr<M0>>&)>;
+
 using proto::RoleType;
 
 const uint32_t DEFAULT_PENDING_QUEUE_SIZE = 1;
@@ -141,6 +147,43 @@ class Reader : public ReaderBase {
    */
   uint32_t PendingQueueSize() const override;
 
+  /**
+   * @brief Deliver all messages queued since the last callback in one call
+   * instead of resuming the reader croutine once per message. Must be set
+   * before Init(), the per-message callback is not used then.
+   *
+   * @param batch_func invoked with the messages in arrival order
+   */
+  void SetBatchCallback(const BatchCallbackFunc<MessageT>& batch_func) {
+    batch_reader_func_ = batch_func;
+  }
+
+  /**
+   * @brief Let the croutine fetch from the channel buffer without taking its
+   * mutex, see data::CacheBuffer. Must be set before Init().
+   */
+  void SetLockFreeBuffer(bool lock_free) { lock_free_buffer_ = lock_free; }
+
+  /**
+   * @brief Parse the messages received on the channel onto pooled protobuf
+   * arenas, see message::ArenaPool. Must be set before Init().
+   */
+  void SetArenaAllocation(bool arena_allocation) {
+    arena_allocation_ = arena_allocation;
+  }
+
+  /**
+   * @brief Only take the newest message, see ReaderConfig::latest_only. Must
+   * be set before Init().
+   */
+  void SetLatestOnly(bool latest_only) { latest_only_ = latest_only; }
+
+  /**
+   * @brief Drop the messages pending for longer than `deadline_ms`, 0 for
+   * none. Must be set before Init().
+   */
+  void SetDeadline(uint32_t deadline_ms) { deadline_ms_ = deadline_ms; }
+
   /**
    * @brief Push `msg` to Blocker's `PublishQueue`
    *
@@ -212,11 +255,36 @@ class Reader : public ReaderBase {
   uint32_t pending_queue_size_;
 
  private:
+  // marks a latest-only reader busy for the lifetime of the scope
+  class BusyScope {
+   public:
+    explicit BusyScope(const Reader* reader)
+        : channel_id_(reader->latest_only_ ? reader->role_attr_.channel_id()
+                                           : 0) {
+      if (channel_id_ != 0) {
+        transport::BusyReaders::Instance()->SetBusy(channel_id_, true);
+      }
+    }
+    ~BusyScope() {
+      if (channel_id_ != 0) {
+        transport::BusyReaders::Instance()->SetBusy(channel_id_, false);
+      }
+    }
+
+   private:
+    uint64_t channel_id_;
+  };
+
   void JoinTheTopology();
   void LeaveTheTopology();
   void OnChannelChange(const proto::ChangeMsg& change_msg);
 
   CallbackFunc<MessageT> reader_func_;
+  BatchCallbackFunc<MessageT> batch_reader_func_;
+  bool lock_free_buffer_ = false;
+  bool arena_allocation_ = false;
+  bool latest_only_ = false;
+  uint32_t deadline_ms_ = 0;
   ReceiverPtr receiver_ = nullptr;
   std::string croutine_name_;
 
@@ -259,30 +327,54 @@ bool Reader<MessageT>::Init() {
   if (init_.exchange(true)) {
     return true;
   }
-  std::function<void(const std::shared_ptr<MessageT>&)> func;
-  if (reader_func_ != nullptr) {
-    func = [this](const std::shared_ptr<MessageT>& msg) {
-      this->Enqueue(msg);
-      this->reader_func_(msg);
-    };
-  } else {
-    func = [this](const std::shared_ptr<MessageT>& msg) { this->Enqueue(msg); };
-  }
   auto sched = scheduler::Instance();
   croutine_name_ = role_attr_.node_name() + "_" + role_attr_.channel_name();
+  if (latest_only_) {
+    pending_queue_size_ = 1;
+  }
   auto dv = std::make_shared<data::DataVisitor<MessageT>>(
-      role_attr_.channel_id(), pending_queue_size_);
+      role_attr_.channel_id(), pending_queue_size_, lock_free_buffer_,
+      static_cast<uint64_t>(deadline_ms_) * 1000000);
   // Using factory to wrap templates.
-  croutine::RoutineFactory factory =
-      croutine::CreateRoutineFactory<MessageT>(std::move(func), dv);
+  croutine::RoutineFactory factory;
+  if (batch_reader_func_ != nullptr) {
+    auto func = [this](const std::vector<std::shared_ptr<MessageT>>& msgs) {
+      for (auto& msg : msgs) {
+        this->Enqueue(msg);
+      }
+      BusyScope busy(this);
+      this->batch_reader_func_(msgs);
+    };
+    factory =
+        croutine::CreateBatchRoutineFactory<MessageT>(std::move(func), dv);
+  } else {
+    std::function<void(const std::shared_ptr<MessageT>&)> func;
+    if (reader_func_ != nullptr) {
+      func = [this](const std::shared_ptr<MessageT>& msg) {
+        this->Enqueue(msg);
+        BusyScope busy(this);
+        this->reader_func_(msg);
+      };
+    } else {
+      func = [this](const std::shared_ptr<MessageT>& msg) {
+        this->Enqueue(msg);
+      };
+    }
+    factory = croutine::CreateRoutineFactory<MessageT>(std::move(func), dv);
+  }
   if (!sched->CreateTask(factory, croutine_name_)) {
     AERROR << "Create Task Failed!";
     init_.store(false);
     return false;
   }
 
+  if (arena_allocation_) {
+    message::ArenaPool::Instance()->EnableForChannel(role_attr_.channel_id());
+  }
   receiver_ = ReceiverManager<MessageT>::Instance()->GetReceiver(role_attr_);
   this->role_attr_.set_id(receiver_->id().HashValue());
+  transport::BusyReaders::Instance()->AddReader(
+      role_attr_.channel_id(), role_attr_.id(), latest_only_);
   channel_manager_ =
       service_discovery::TopologyManager::Instance()->channel_manager();
   JoinTheTopology();
@@ -296,6 +388,8 @@ void Reader<MessageT>::Shutdown() {
     return;
   }
   LeaveTheTopology();
+  transport::BusyReaders::Instance()->RemoveReader(role_attr_.channel_id(),
+                                                   latest_only_);
   receiver_ = nullptr;
   channel_manager_ = nullptr;
 
@@ -17,6 +17,7 @@
 #ifndef CYBER_NODE_WRITER_H_
 #define CYBER_NODE_WRITER_H_
 
+#include <cstddef>
 #include <memory>
 #include <string>
 #include <vector>
@@ -24,6 +25,8 @@
 #include "cyber/proto/topology_change.pb.h"
 
 #include "cyber/common/log.h"
+#include "cyber/message/arena_pool.h"
+#include "cyber/node/inline_chain.h"
 #include "cyber/node/writer_base.h"
 #include "cyber/service_discovery/topology_manager.h"
 #include "cyber/transport/transport.h"
@@ -84,6 +87,51 @@ class Writer : public WriterBase {
    */
   virtual bool Write(const std::shared_ptr<MessageT>& msg_ptr);
 
+  /**
+   * @brief Make a message on a pooled protobuf arena, to fill in and pass to
+   * `Write`. The arena is reused once the transport and the intra readers
+   * release the message, so building large nested messages this way saves
+   * most of their allocations.
+   *
+   * @return std::shared_ptr<MessageT> an empty message
+   */
+  std::shared_ptr<MessageT> NewMessage() const {
+    return message::NewArenaMessage<MessageT>();
+  }
+
+  /**
+   * @brief Borrow a shared memory block of at least `msg_size` bytes to
+   * serialize a message into directly, so the transport does not copy it.
+   * Only available when shared memory readers are connected and no
+   * component is chained to the channel; on false, fall back to `Write`.
+   * A loaned block must be handed back through either `WriteLoaned` or
+   * `ReturnLoan`.
+   *
+   * @param msg_size the number of bytes the caller is going to fill
+   * @param block the loaned block, its `buf` is writable for `msg_size` bytes
+   * @return true if a block was loaned
+   * @return false if no zero-copy path is available
+   */
+  bool Loan(std::size_t msg_size, transport::WritableBlock* block);
+
+  /**
+   * @brief Publish a block previously obtained by `Loan`
+   *
+   * @param block the loaned block
+   * @param msg_size the number of bytes actually written to `block.buf`,
+   * not larger than the size passed to `Loan`
+   * @return true if write successfully
+   * @return false if write failed
+   */
+  bool WriteLoaned(const transport::WritableBlock& block, std::size_t msg_size);
+
+  /**
+   * @brief Give a loaned block back without publishing it
+   *
+   * @param block the loaned block
+   */
+  void ReturnLoan(const transport::WritableBlock& block);
+
   /**
    * @brief Is there any Reader that subscribes our Channel?
    * You can publish message when this return true
@@ -166,7 +214,37 @@ bool Writer<MessageT>::Write(const MessageT& msg) {
 template <typename MessageT>
 bool Writer<MessageT>::Write(const std::shared_ptr<MessageT>& msg_ptr) {
   RETURN_VAL_IF(!WriterBase::IsInit(), false);
-  return transmitter_->Transmit(msg_ptr);
+  bool transmitted = transmitter_->Transmit(msg_ptr);
+  // the readers are not kept waiting for the chained component
+  bool chained =
+      InlineChain::Instance()->Run(this->role_attr_.channel_id(), msg_ptr);
+  return transmitted || chained;
+}
+
+template <typename MessageT>
+bool Writer<MessageT>::Loan(std::size_t msg_size,
+                            transport::WritableBlock* block) {
+  RETURN_VAL_IF(!WriterBase::IsInit(), false);
+  RETURN_VAL_IF_NULL(block, false);
+  // a chained component needs the message itself, so go through Write
+  RETURN_VAL_IF(InlineChain::Instance()->Has(this->role_attr_.channel_id()),
+                false);
+  return transmitter_->AcquireBlock(msg_size, block);
+}
+
+template <typename MessageT>
+bool Writer<MessageT>::WriteLoaned(const transport::WritableBlock& block,
+                                   std::size_t msg_size) {
+  RETURN_VAL_IF(!WriterBase::IsInit(), false);
+  return transmitter_->TransmitBlock(block, msg_size);
+}
+
+template <typename MessageT>
+void Writer<MessageT>::ReturnLoan(const transport::WritableBlock& block) {
+  if (!WriterBase::IsInit()) {
+    return;
+  }
+  transmitter_->ReleaseBlock(block);
 }
 
 template <typename MessageT>
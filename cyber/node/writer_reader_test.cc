@@ -164,6 +164,49 @@ TEST(WriterReaderTest, messaging) {
   reader_b.Shutdown();
 }
 
+TEST(WriterReaderTest, batch_messaging) {
+  proto::RoleAttributes attr;
+  attr.set_node_name("writer");
+  attr.set_channel_name("batch_messaging");
+  auto channel_id = common::GlobalData::RegisterChannel(attr.channel_name());
+  attr.set_channel_id(channel_id);
+
+  Writer<proto::UnitTest> writer(attr);
+  EXPECT_TRUE(writer.Init());
+
+  std::mutex mtx;
+  size_t recv_num = 0;
+  size_t callback_num = 0;
+  attr.set_node_name("batch_reader");
+  Reader<proto::UnitTest> reader(attr, nullptr, 10);
+  reader.SetBatchCallback(
+      [&](const std::vector<std::shared_ptr<proto::UnitTest>>& msgs) {
+        std::lock_guard<std::mutex> lck(mtx);
+        EXPECT_FALSE(msgs.empty());
+        recv_num += msgs.size();
+        callback_num++;
+      });
+  EXPECT_TRUE(reader.Init());
+
+  auto msg = std::make_shared<proto::UnitTest>();
+  msg->set_class_name("WriterReaderTest");
+  msg->set_case_name("batch_messaging");
+  for (int i = 0; i < 5; ++i) {
+    writer.Write(msg);
+  }
+  std::this_thread::sleep_for(std::chrono::duration<int, std::milli>(500));
+
+  {
+    std::lock_guard<std::mutex> lck(mtx);
+    EXPECT_EQ(recv_num, 5);
+    EXPECT_GE(callback_num, 1);
+    EXPECT_LE(callback_num, 5);
+  }
+
+  writer.Shutdown();
+  reader.Shutdown();
+}
+
 TEST(WriterReaderTest, observe) {
   proto::RoleAttributes attr;
   attr.set_node_name("node");
@@ -24,7 +24,7 @@ namespace cyber {
 
 ParameterClient::ParameterClient(const std::shared_ptr<Node>& node,
                                  const std::string& service_node_name)
-    : node_(node) {
+    : node_(node), shm_table_(service_node_name) {
   get_parameter_client_ = node_->CreateClient<ParamName, Param>(
       FixParameterServiceName(service_node_name, GET_PARAMETER_SERVICE_NAME));
 
@@ -37,6 +37,14 @@ ParameterClient::ParameterClient(const std::shared_ptr<Node>& node,
 
 bool ParameterClient::GetParameter(const std::string& param_name,
                                    Parameter* parameter) {
+  // a server on this host shares its parameters, no need to ask it then
+  std::string value;
+  Param param;
+  if (shm_table_.Get(param_name, &value) && param.ParseFromString(value)) {
+    parameter->FromProtoParam(param);
+    return true;
+  }
+
   auto request = std::make_shared<ParamName>();
   request->set_value(param_name);
   auto response = get_parameter_client_->SendRequest(request);
@@ -52,6 +60,48 @@ bool ParameterClient::GetParameter(const std::string& param_name,
   return true;
 }
 
+bool ParameterClient::GetParameters(const std::vector<std::string>& param_names,
+                                    std::vector<Parameter>* parameters) {
+  // the ones in the shared memory table of the server are not asked for
+  std::vector<Param> params(param_names.size());
+  std::vector<size_t> requested;
+  std::vector<std::shared_ptr<ParamName>> requests;
+  std::string value;
+  for (size_t i = 0; i < param_names.size(); ++i) {
+    if (shm_table_.Get(param_names[i], &value) &&
+        params[i].ParseFromString(value)) {
+      continue;
+    }
+    requested.push_back(i);
+    requests.emplace_back(std::make_shared<ParamName>());
+    requests.back()->set_value(param_names[i]);
+  }
+  bool all_exist = true;
+  if (!requests.empty()) {
+    auto responses = get_parameter_client_->SendRequests(requests);
+    for (size_t k = 0; k < responses.size(); ++k) {
+      if (responses[k] == nullptr) {
+        AERROR << "Call " << get_parameter_client_->ServiceName() << " for "
+               << param_names[requested[k]] << " failed";
+        all_exist = false;
+        continue;
+      }
+      params[requested[k]].CopyFrom(*responses[k]);
+    }
+  }
+  for (size_t i = 0; i < params.size(); ++i) {
+    if (params[i].type() == ParamType::NOT_SET) {
+      AWARN << "Parameter " << param_names[i] << " not exists yet.";
+      all_exist = false;
+      continue;
+    }
+    Parameter parameter;
+    parameter.FromProtoParam(params[i]);
+    parameters->emplace_back(parameter);
+  }
+  return all_exist;
+}
+
 bool ParameterClient::SetParameter(const Parameter& parameter) {
   auto request = std::make_shared<Param>(parameter.ToProtoParam());
   auto response = set_parameter_client_->SendRequest(request);
@@ -78,5 +128,12 @@ bool ParameterClient::ListParameters(std::vector<Parameter>* parameters) {
   return true;
 }
 
+uint32_t ParameterClient::ParametersVersion() { return shm_table_.Version(); }
+
+bool ParameterClient::WaitForParametersChange(uint32_t version,
+                                              int timeout_ms) {
+  return shm_table_.WaitForChange(version, timeout_ms);
+}
+
 }  // namespace cyber
 }  // namespace apollo
@@ -24,6 +24,7 @@
 #include "cyber/proto/parameter.pb.h"
 
 #include "cyber/parameter/parameter.h"
+#include "cyber/parameter/parameter_shm_table.h"
 #include "cyber/service/client.h"
 
 namespace apollo {
@@ -65,6 +66,19 @@ class ParameterClient {
    */
   bool GetParameter(const std::string& param_name, Parameter* parameter);
 
+  /**
+   * @brief Get the Parameter objects of all the names at once, the requests
+   * are pipelined instead of waiting for each response in turn
+   *
+   * @param param_names
+   * @param parameters the pointer to store the parameters which exist, in the
+   * order of `param_names`
+   * @return true all the parameters exist
+   * @return false call service fail or timeout, or some parameters not exist
+   */
+  bool GetParameters(const std::vector<std::string>& param_names,
+                     std::vector<Parameter>* parameters);
+
   /**
    * @brief Set the Parameter object
    *
@@ -85,11 +99,30 @@ class ParameterClient {
    */
   bool ListParameters(std::vector<Parameter>* parameters);
 
+  /**
+   * @brief The number of parameter changes so far, as seen in the shared
+   * memory table of the server, so only for a server on the same host
+   *
+   * @return uint32_t the version, 0 if the server is not on this host
+   */
+  uint32_t ParametersVersion();
+
+  /**
+   * @brief Wait for a parameter of a server on the same host to be set
+   *
+   * @param version the version seen last
+   * @param timeout_ms
+   * @return true the parameters changed since `version`
+   * @return false timeout, or the server is not on this host
+   */
+  bool WaitForParametersChange(uint32_t version, int timeout_ms);
+
  private:
   std::shared_ptr<Node> node_;
   std::shared_ptr<GetParameterClient> get_parameter_client_;
   std::shared_ptr<SetParameterClient> set_parameter_client_;
   std::shared_ptr<ListParametersClient> list_parameters_client_;
+  ParameterShmTable shm_table_;
 };
 
 }  // namespace cyber
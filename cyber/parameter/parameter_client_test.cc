@@ -76,6 +76,28 @@ TEST_F(ParameterClientTest, get_parameter) {
   EXPECT_FALSE(pc_->GetParameter("int", &parameter));
 }
 
+TEST_F(ParameterClientTest, get_parameters) {
+  ps_->SetParameter(Parameter("int", 1));
+  ps_->SetParameter(Parameter("string", "value"));
+  std::vector<Parameter> parameters;
+  EXPECT_TRUE(pc_->GetParameters({"int", "string"}, &parameters));
+  EXPECT_EQ(2, parameters.size());
+  EXPECT_EQ("int", parameters[0].Name());
+  EXPECT_EQ(1, parameters[0].AsInt64());
+  EXPECT_EQ("string", parameters[1].Name());
+  EXPECT_EQ("value", parameters[1].AsString());
+
+  parameters.clear();
+  EXPECT_FALSE(pc_->GetParameters({"double", "int"}, &parameters));
+  EXPECT_EQ(1, parameters.size());
+  EXPECT_EQ("int", parameters[0].Name());
+
+  ps_.reset();
+  parameters.clear();
+  EXPECT_FALSE(pc_->GetParameters({"int"}, &parameters));
+  EXPECT_TRUE(parameters.empty());
+}
+
 TEST_F(ParameterClientTest, list_parameter) {
   ps_->SetParameter(Parameter("int", 1));
   std::vector<Parameter> parameters;
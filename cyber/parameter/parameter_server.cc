@@ -23,8 +23,9 @@ namespace apollo {
 namespace cyber {
 
 ParameterServer::ParameterServer(const std::shared_ptr<Node>& node)
-    : node_(node) {
+    : node_(node), shm_table_(node->Name()) {
   auto name = node_->Name();
+  shm_table_.Create();
   get_parameter_service_ = node_->CreateService<ParamName, Param>(
       FixParameterServiceName(name, GET_PARAMETER_SERVICE_NAME),
       [this](const std::shared_ptr<ParamName>& request,
@@ -43,6 +44,7 @@ ParameterServer::ParameterServer(const std::shared_ptr<Node>& node)
              std::shared_ptr<BoolResult>& response) {
         std::lock_guard<std::mutex> lock(param_map_mutex_);
         param_map_[request->name()] = *request;
+        shm_table_.Put(request->name(), request->SerializeAsString());
         response->set_value(true);
       });
 
@@ -60,7 +62,9 @@ ParameterServer::ParameterServer(const std::shared_ptr<Node>& node)
 
 void ParameterServer::SetParameter(const Parameter& parameter) {
   std::lock_guard<std::mutex> lock(param_map_mutex_);
-  param_map_[parameter.Name()] = parameter.ToProtoParam();
+  auto& param = param_map_[parameter.Name()];
+  param = parameter.ToProtoParam();
+  shm_table_.Put(param.name(), param.SerializeAsString());
 }
 
 bool ParameterServer::GetParameter(const std::string& parameter_name,
@@ -25,6 +25,7 @@
 #include "cyber/proto/parameter.pb.h"
 
 #include "cyber/parameter/parameter.h"
+#include "cyber/parameter/parameter_shm_table.h"
 #include "cyber/service/service.h"
 
 namespace apollo {
@@ -38,7 +39,9 @@ class Node;
  * If you want to set a key-value, and hope other nodes to get the value,
  * Routing, sensor internal/external references are set by Parameter Service
  * ParameterServer can set a parameter, and then you can get/list
- * paramter(s) by start a ParameterClient to send responding request
+ * paramter(s) by start a ParameterClient to send responding request.
+ * The parameters are also kept in a ParameterShmTable, which the clients on
+ * the same host read without a request
  * @warning You should only have one ParameterServer works
  */
 class ParameterServer {
@@ -87,6 +90,7 @@ class ParameterServer {
 
   std::mutex param_map_mutex_;
   std::unordered_map<std::string, Param> param_map_;
+  ParameterShmTable shm_table_;
 };
 
 }  // namespace cyber
@@ -0,0 +1,371 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/parameter/parameter_shm_table.h"
+
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <ctime>
+#include <new>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace cyber {
+
+namespace {
+
+constexpr uint64_t kMagic = 0x43594245525041ULL;  // "CYBERPA"
+constexpr uint32_t kInvalidSize = UINT32_MAX;
+// a server which died while setting a parameter leaves its seqlock odd
+constexpr int kMaxReadRetries = 1000;
+
+// stable across processes and builds, unlike std::hash
+uint64_t NameHash(const std::string& name) {
+  uint64_t hash = 14695981039346656037ULL;
+  for (unsigned char c : name) {
+    hash ^= c;
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+// shared (not FUTEX_PRIVATE) operations, the word lives in shm
+long FutexWait(std::atomic<uint32_t>* addr, uint32_t expected,
+               const struct timespec* timeout) {
+  return syscall(SYS_futex, reinterpret_cast<uint32_t*>(addr), FUTEX_WAIT,
+                 expected, timeout, nullptr, 0);
+}
+
+long FutexWakeAll(std::atomic<uint32_t>* addr) {
+  return syscall(SYS_futex, reinterpret_cast<uint32_t*>(addr), FUTEX_WAKE,
+                 INT_MAX, nullptr, nullptr, 0);
+}
+
+}  // namespace
+
+constexpr uint32_t ParameterShmTable::kCapacity;
+constexpr uint32_t ParameterShmTable::kMaxNameSize;
+constexpr uint32_t ParameterShmTable::kMaxValueSize;
+
+struct alignas(64) ParameterShmTable::Header {
+  uint64_t magic;
+  uint32_t capacity;
+  std::atomic<int32_t> owner_pid;
+  std::atomic<uint32_t> closed;
+  std::atomic<uint32_t> version;
+};
+
+struct alignas(64) ParameterShmTable::Slot {
+  // the name is written once, before the slot is marked used
+  std::atomic<uint32_t> used;
+  std::atomic<uint32_t> seq;
+  std::atomic<uint32_t> value_size;
+  uint32_t name_size;
+  uint64_t name_hash;
+  char name[kMaxNameSize];
+  char value[kMaxValueSize];
+};
+
+ParameterShmTable::ParameterShmTable(const std::string& server_node_name)
+    : shm_name_("/apollo_cyber_parameter_" +
+                std::to_string(NameHash(server_node_name))) {}
+
+ParameterShmTable::~ParameterShmTable() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  CloseLocked();
+  for (auto shm : retired_) {
+    munmap(shm, ShmSize());
+  }
+  retired_.clear();
+}
+
+std::size_t ParameterShmTable::ShmSize() {
+  return sizeof(Header) + sizeof(Slot) * kCapacity;
+}
+
+bool ParameterShmTable::Create() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (shm_ != nullptr) {
+    return true;
+  }
+  int fd = shm_open(shm_name_.c_str(), O_RDWR, 0644);
+  if (fd >= 0) {
+    struct stat st;
+    void* old = MAP_FAILED;
+    if (fstat(fd, &st) == 0 &&
+        static_cast<std::size_t>(st.st_size) >= sizeof(Header)) {
+      old = mmap(nullptr, sizeof(Header), PROT_READ | PROT_WRITE, MAP_SHARED,
+                 fd, 0);
+    }
+    close(fd);
+    if (old != MAP_FAILED) {
+      auto old_header = static_cast<Header*>(old);
+      pid_t pid = old_header->owner_pid.load();
+      bool alive = old_header->magic == kMagic &&
+                   old_header->closed.load() == 0 && pid > 0 &&
+                   (kill(pid, 0) == 0 || errno == EPERM);
+      if (alive) {
+        munmap(old, sizeof(Header));
+        AWARN << "parameter table " << shm_name_ << " is owned by " << pid
+              << ", parameters are served without it.";
+        return false;
+      }
+      // let the clients of the server which is gone map the new table
+      old_header->closed.store(1);
+      old_header->version.fetch_add(1);
+      FutexWakeAll(&old_header->version);
+      munmap(old, sizeof(Header));
+    }
+    shm_unlink(shm_name_.c_str());
+  }
+
+  fd = shm_open(shm_name_.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+  if (fd < 0) {
+    AERROR << "create parameter table failed: " << strerror(errno);
+    return false;
+  }
+  // the new pages are zeroed, so all the slots are unused
+  if (ftruncate(fd, ShmSize()) < 0) {
+    AERROR << "ftruncate failed: " << strerror(errno);
+    close(fd);
+    shm_unlink(shm_name_.c_str());
+    return false;
+  }
+  shm_ = mmap(nullptr, ShmSize(), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (shm_ == MAP_FAILED) {
+    AERROR << "attach parameter table failed: " << strerror(errno);
+    shm_ = nullptr;
+    shm_unlink(shm_name_.c_str());
+    return false;
+  }
+  header_ = new (shm_) Header();
+  header_->capacity = kCapacity;
+  header_->owner_pid.store(getpid());
+  header_->closed.store(0);
+  header_->version.store(0);
+  slots_ = reinterpret_cast<Slot*>(static_cast<char*>(shm_) + sizeof(Header));
+  is_server_ = true;
+  // published last, clients check it on open
+  std::atomic_thread_fence(std::memory_order_release);
+  header_->magic = kMagic;
+  return true;
+}
+
+bool ParameterShmTable::OpenLocked() {
+  int fd = shm_open(shm_name_.c_str(), O_RDONLY, 0644);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < ShmSize()) {
+    close(fd);
+    return false;
+  }
+  void* shm = mmap(nullptr, ShmSize(), PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (shm == MAP_FAILED) {
+    return false;
+  }
+  auto header = static_cast<Header*>(shm);
+  if (header->magic != kMagic || header->capacity != kCapacity ||
+      header->closed.load(std::memory_order_acquire) != 0) {
+    munmap(shm, ShmSize());
+    return false;
+  }
+  shm_ = shm;
+  header_ = header;
+  slots_ = reinterpret_cast<Slot*>(static_cast<char*>(shm_) + sizeof(Header));
+  return true;
+}
+
+void ParameterShmTable::CloseLocked() {
+  if (shm_ == nullptr) {
+    return;
+  }
+  if (is_server_) {
+    header_->closed.store(1, std::memory_order_release);
+    header_->version.fetch_add(1, std::memory_order_release);
+    FutexWakeAll(&header_->version);
+    munmap(shm_, ShmSize());
+    shm_unlink(shm_name_.c_str());
+    is_server_ = false;
+  } else {
+    // WaitForChange() may still be waiting on it
+    retired_.push_back(shm_);
+  }
+  shm_ = nullptr;
+  header_ = nullptr;
+  slots_ = nullptr;
+}
+
+ParameterShmTable::Slot* ParameterShmTable::FindSlot(const std::string& name,
+                                                     uint64_t name_hash,
+                                                     bool for_write) const {
+  for (uint32_t i = 0; i < kCapacity; ++i) {
+    Slot* slot = &slots_[(name_hash + i) % kCapacity];
+    if (slot->used.load(std::memory_order_acquire) == 0) {
+      return for_write ? slot : nullptr;
+    }
+    if (slot->name_hash == name_hash && slot->name_size == name.size() &&
+        std::memcmp(slot->name, name.data(), name.size()) == 0) {
+      return slot;
+    }
+  }
+  return nullptr;
+}
+
+bool ParameterShmTable::Put(const std::string& name,
+                            const std::string& value) {
+  if (name.size() > kMaxNameSize) {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!is_server_) {
+    return false;
+  }
+  const uint64_t name_hash = NameHash(name);
+  Slot* slot = FindSlot(name, name_hash, true);
+  if (slot == nullptr) {
+    AWARN << "parameter table " << shm_name_ << " is full, " << name
+          << " is served without it.";
+    return false;
+  }
+
+  const bool stored = value.size() <= kMaxValueSize;
+  uint32_t seq = slot->seq.load(std::memory_order_relaxed);
+  slot->seq.store(seq + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  if (stored) {
+    std::memcpy(slot->value, value.data(), value.size());
+    slot->value_size.store(static_cast<uint32_t>(value.size()),
+                           std::memory_order_relaxed);
+  } else {
+    // clients must not read an older value
+    slot->value_size.store(kInvalidSize, std::memory_order_relaxed);
+  }
+  slot->seq.store(seq + 2, std::memory_order_release);
+
+  if (slot->used.load(std::memory_order_relaxed) == 0) {
+    slot->name_hash = name_hash;
+    slot->name_size = static_cast<uint32_t>(name.size());
+    std::memcpy(slot->name, name.data(), name.size());
+    slot->used.store(1, std::memory_order_release);
+  }
+  header_->version.fetch_add(1, std::memory_order_release);
+  FutexWakeAll(&header_->version);
+  return stored;
+}
+
+bool ParameterShmTable::Get(const std::string& name, std::string* value) {
+  if (name.size() > kMaxNameSize) {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (header_ == nullptr && !OpenLocked()) {
+    return false;
+  }
+  if (header_->closed.load(std::memory_order_acquire) != 0) {
+    CloseLocked();
+    if (!OpenLocked()) {
+      return false;
+    }
+  }
+  const Slot* slot = FindSlot(name, NameHash(name), false);
+  if (slot == nullptr) {
+    return false;
+  }
+  char buffer[kMaxValueSize];
+  for (int retry = 0; retry < kMaxReadRetries; ++retry) {
+    uint32_t seq = slot->seq.load(std::memory_order_acquire);
+    if (seq & 1) {
+      continue;
+    }
+    uint32_t size = slot->value_size.load(std::memory_order_relaxed);
+    if (size <= kMaxValueSize) {
+      std::memcpy(buffer, slot->value, size);
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot->seq.load(std::memory_order_relaxed) != seq) {
+      continue;
+    }
+    if (size > kMaxValueSize) {
+      return false;
+    }
+    value->assign(buffer, size);
+    return true;
+  }
+  return false;
+}
+
+uint32_t ParameterShmTable::Version() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (header_ == nullptr && !OpenLocked()) {
+    return 0;
+  }
+  return header_->version.load(std::memory_order_acquire);
+}
+
+bool ParameterShmTable::WaitForChange(uint32_t version, int timeout_ms) {
+  Header* header = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (header_ == nullptr && !OpenLocked()) {
+      return false;
+    }
+    header = header_;
+  }
+  struct timespec deadline;
+  clock_gettime(CLOCK_MONOTONIC, &deadline);
+  deadline.tv_sec += timeout_ms / 1000;
+  deadline.tv_nsec += (timeout_ms % 1000) * 1000000L;
+  if (deadline.tv_nsec >= 1000000000L) {
+    ++deadline.tv_sec;
+    deadline.tv_nsec -= 1000000000L;
+  }
+  while (header->version.load(std::memory_order_acquire) == version) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    struct timespec timeout;
+    timeout.tv_sec = deadline.tv_sec - now.tv_sec;
+    timeout.tv_nsec = deadline.tv_nsec - now.tv_nsec;
+    if (timeout.tv_nsec < 0) {
+      --timeout.tv_sec;
+      timeout.tv_nsec += 1000000000L;
+    }
+    if (timeout.tv_sec < 0) {
+      return false;
+    }
+    if (FutexWait(&header->version, version, &timeout) != 0 &&
+        errno == ETIMEDOUT) {
+      return header->version.load(std::memory_order_acquire) != version;
+    }
+  }
+  return true;
+}
+
+}  // namespace cyber
+}  // namespace apollo
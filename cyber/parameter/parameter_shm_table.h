@@ -0,0 +1,115 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_PARAMETER_PARAMETER_SHM_TABLE_H_
+#define CYBER_PARAMETER_PARAMETER_SHM_TABLE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace apollo {
+namespace cyber {
+
+/**
+ * @class ParameterShmTable
+ * @brief A host-wide shared memory table of the parameters of one
+ * ParameterServer, which clients on the same host read without a service
+ * call.
+ *
+ * The server creates the table and is its only writer; clients map it read
+ * only. Each parameter has a slot holding its serialized value, protected by
+ * a seqlock, so reads never block the server and retry only while the very
+ * parameter is being set. Slots are never freed, as parameters are never
+ * removed. A parameter which does not fit, in size or in number, is left out
+ * of the table and clients fall back to the service for it.
+ *
+ * The table version is bumped on every change, and a futex on it lets clients
+ * wait for changes.
+ */
+class ParameterShmTable {
+ public:
+  static constexpr uint32_t kCapacity = 512;
+  static constexpr uint32_t kMaxNameSize = 128;
+  static constexpr uint32_t kMaxValueSize = 1024;
+
+  explicit ParameterShmTable(const std::string& server_node_name);
+  ~ParameterShmTable();
+
+  /**
+   * @brief Create the table as the server, replacing the one of a server of
+   * the same name which is gone.
+   */
+  bool Create();
+
+  /**
+   * @brief Set the serialized value of a parameter, by the server only.
+   *
+   * @return false if the value is not in the table, clients then ask the
+   * server for it
+   */
+  bool Put(const std::string& name, const std::string& value);
+
+  /**
+   * @brief Get the serialized value of a parameter, by the clients. The table
+   * is mapped on first use, and mapped again if its server was replaced.
+   *
+   * @return false if there is no table or the parameter is not in it
+   */
+  bool Get(const std::string& name, std::string* value);
+
+  /**
+   * @brief The number of changes of the table so far, 0 without a table.
+   */
+  uint32_t Version();
+
+  /**
+   * @brief Wait until the version differs from `version`.
+   *
+   * @return true if it changed before the timeout
+   */
+  bool WaitForChange(uint32_t version, int timeout_ms);
+
+  const std::string& shm_name() const { return shm_name_; }
+
+ private:
+  struct Header;
+  struct Slot;
+
+  static std::size_t ShmSize();
+
+  bool OpenLocked();
+  void CloseLocked();
+  Slot* FindSlot(const std::string& name, uint64_t name_hash,
+                 bool for_write) const;
+
+  std::string shm_name_;
+  bool is_server_ = false;
+  std::mutex mutex_;
+  void* shm_ = nullptr;
+  Header* header_ = nullptr;
+  Slot* slots_ = nullptr;
+  // the mappings of replaced tables, unmapped on destruction only
+  std::vector<void*> retired_;
+};
+
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_PARAMETER_PARAMETER_SHM_TABLE_H_
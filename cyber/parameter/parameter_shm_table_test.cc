@@ -0,0 +1,110 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/parameter/parameter_shm_table.h"
+
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace cyber {
+
+TEST(ParameterShmTableTest, put_get) {
+  ParameterShmTable server("parameter_shm_table_test");
+  ParameterShmTable client("parameter_shm_table_test");
+  std::string value;
+  EXPECT_FALSE(client.Get("int", &value));
+  EXPECT_EQ(0, client.Version());
+
+  ASSERT_TRUE(server.Create());
+  EXPECT_TRUE(server.Put("int", "1"));
+  EXPECT_TRUE(client.Get("int", &value));
+  EXPECT_EQ("1", value);
+  EXPECT_FALSE(client.Get("double", &value));
+  EXPECT_FALSE(client.Put("int", "2"));
+
+  EXPECT_TRUE(server.Put("int", "2"));
+  EXPECT_TRUE(client.Get("int", &value));
+  EXPECT_EQ("2", value);
+  EXPECT_EQ(2, client.Version());
+
+  // an older value is not read once the parameter is too large
+  std::string large(ParameterShmTable::kMaxValueSize + 1, 'a');
+  EXPECT_FALSE(server.Put("int", large));
+  EXPECT_FALSE(client.Get("int", &value));
+  EXPECT_FALSE(server.Put(std::string(200, 'n'), "1"));
+}
+
+TEST(ParameterShmTableTest, full) {
+  ParameterShmTable server("parameter_shm_table_test");
+  ASSERT_TRUE(server.Create());
+  for (uint32_t i = 0; i < ParameterShmTable::kCapacity; ++i) {
+    EXPECT_TRUE(server.Put(std::to_string(i), std::to_string(i)));
+  }
+  EXPECT_FALSE(server.Put("one more", "1"));
+
+  ParameterShmTable client("parameter_shm_table_test");
+  std::string value;
+  for (uint32_t i = 0; i < ParameterShmTable::kCapacity; ++i) {
+    EXPECT_TRUE(client.Get(std::to_string(i), &value));
+    EXPECT_EQ(std::to_string(i), value);
+  }
+  EXPECT_FALSE(client.Get("one more", &value));
+}
+
+TEST(ParameterShmTableTest, replaced) {
+  ParameterShmTable client("parameter_shm_table_test");
+  std::string value;
+  {
+    ParameterShmTable server("parameter_shm_table_test");
+    ASSERT_TRUE(server.Create());
+    // a second live server of the same name is left out
+    ParameterShmTable other("parameter_shm_table_test");
+    EXPECT_FALSE(other.Create());
+
+    EXPECT_TRUE(server.Put("int", "1"));
+    EXPECT_TRUE(client.Get("int", &value));
+  }
+  EXPECT_FALSE(client.Get("int", &value));
+
+  ParameterShmTable server("parameter_shm_table_test");
+  ASSERT_TRUE(server.Create());
+  EXPECT_TRUE(server.Put("int", "3"));
+  EXPECT_TRUE(client.Get("int", &value));
+  EXPECT_EQ("3", value);
+}
+
+TEST(ParameterShmTableTest, wait_for_change) {
+  ParameterShmTable server("parameter_shm_table_test");
+  ASSERT_TRUE(server.Create());
+  ParameterShmTable client("parameter_shm_table_test");
+  uint32_t version = client.Version();
+  EXPECT_FALSE(client.WaitForChange(version, 10));
+
+  std::thread setter([&server]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    server.Put("int", "1");
+  });
+  EXPECT_TRUE(client.WaitForChange(version, 1000));
+  EXPECT_NE(version, client.Version());
+  setter.join();
+}
+
+}  // namespace cyber
+}  // namespace apollo
@@ -0,0 +1,114 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_PYTHON_INTERNAL_PY_BUFFER_H_
+#define CYBER_PYTHON_INTERNAL_PY_BUFFER_H_
+
+#include <string>
+#include <utility>
+
+#include <Python.h>
+
+namespace apollo {
+namespace cyber {
+
+/**
+ * @brief A read only Python object owning bytes handed over by C++, which
+ * exports them through the buffer protocol instead of copying them into a
+ * bytes object. An item format, in struct module syntax, makes it a typed
+ * column, e.g. numpy.frombuffer(view, dtype=numpy.float64) on a "d" buffer
+ * uses the doubles in place.
+ */
+struct PyByteBuffer {
+  PyObject_HEAD
+  std::string* data;
+  const char* format;
+  Py_ssize_t itemsize;
+  Py_ssize_t shape;
+};
+
+inline void PyByteBuffer_Dealloc(PyObject* obj) {
+  delete reinterpret_cast<PyByteBuffer*>(obj)->data;
+  Py_TYPE(obj)->tp_free(obj);
+}
+
+inline int PyByteBuffer_GetBuffer(PyObject* obj, Py_buffer* view, int flags) {
+  auto* self = reinterpret_cast<PyByteBuffer*>(obj);
+  if (PyBuffer_FillInfo(view, obj, &(*self->data)[0], self->data->size(), 1,
+                        flags) < 0) {
+    return -1;
+  }
+  // without the format or the shape asked for, it is seen as plain bytes
+  if ((flags & PyBUF_FORMAT) == PyBUF_FORMAT &&
+      (flags & PyBUF_ND) == PyBUF_ND) {
+    view->format = const_cast<char*>(self->format);
+    view->itemsize = self->itemsize;
+    view->shape = &self->shape;
+    if ((flags & PyBUF_STRIDES) == PyBUF_STRIDES) {
+      view->strides = &self->itemsize;
+    }
+  }
+  return 0;
+}
+
+inline PyTypeObject* PyByteBufferType() {
+  static PyBufferProcs buffer_procs = {PyByteBuffer_GetBuffer, nullptr};
+  static PyTypeObject type = {PyVarObject_HEAD_INIT(nullptr, 0)};
+  if (type.tp_name == nullptr) {
+    type.tp_name = "cyber.ByteBuffer";
+    type.tp_basicsize = sizeof(PyByteBuffer);
+    type.tp_dealloc = PyByteBuffer_Dealloc;
+    type.tp_as_buffer = &buffer_procs;
+    type.tp_flags = Py_TPFLAGS_DEFAULT;
+    type.tp_doc = "Read only bytes owned by cyber";
+    if (PyType_Ready(&type) < 0) {
+      type.tp_name = nullptr;
+      return nullptr;
+    }
+  }
+  return &type;
+}
+
+/**
+ * @brief Hand `data` over to Python as a memoryview, without copy.
+ *
+ * @param format struct format of an item, "B" for bytes
+ * @param itemsize size of an item, which the size of `data` is a multiple of
+ */
+inline PyObject* NewPyMemoryView(std::string&& data, const char* format = "B",
+                                 Py_ssize_t itemsize = 1) {
+  PyTypeObject* type = PyByteBufferType();
+  if (type == nullptr) {
+    return nullptr;
+  }
+  PyByteBuffer* buffer = PyObject_New(PyByteBuffer, type);
+  if (buffer == nullptr) {
+    return nullptr;
+  }
+  buffer->data = new std::string(std::move(data));
+  buffer->format = format;
+  buffer->itemsize = itemsize;
+  buffer->shape = static_cast<Py_ssize_t>(buffer->data->size()) / itemsize;
+  PyObject* view =
+      PyMemoryView_FromObject(reinterpret_cast<PyObject*>(buffer));
+  Py_DECREF(buffer);
+  return view;
+}
+
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_PYTHON_INTERNAL_PY_BUFFER_H_
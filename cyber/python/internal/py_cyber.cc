@@ -21,6 +21,9 @@
 
 #include <Python.h>
 
+#include "cyber/python/internal/py_buffer.h"
+
+using apollo::cyber::NewPyMemoryView;
 using apollo::cyber::Node;
 using apollo::cyber::PyChannelUtils;
 using apollo::cyber::PyClient;
@@ -231,6 +234,36 @@ PyObject *cyber_PyReader_read(PyObject *self, PyObject *args) {
   return C_STR_TO_PY_BYTES(reader_ret);
 }
 
+PyObject *cyber_PyReader_read_view(PyObject *self, PyObject *args) {
+  PyObject *pyobj_reader = nullptr;
+  PyObject *pyobj_iswait = nullptr;
+
+  if (!PyArg_ParseTuple(args,
+                        const_cast<char *>("OO:cyber_PyReader_read_view"),
+                        &pyobj_reader, &pyobj_iswait)) {
+    AERROR << "cyber_PyReader_read_view:PyArg_ParseTuple failed!";
+    Py_INCREF(Py_None);
+    return Py_None;
+  }
+  PyReader *reader =
+      PyObjectToPtr<PyReader *>(pyobj_reader, "apollo_cyber_pyreader");
+  if (nullptr == reader) {
+    AERROR << "cyber_PyReader_read_view:PyReader ptr is null!";
+    Py_INCREF(Py_None);
+    return Py_None;
+  }
+
+  int r = PyObject_IsTrue(pyobj_iswait);
+  if (r == -1) {
+    AERROR << "cyber_PyReader_read_view:pyobj_iswait is error!";
+    Py_INCREF(Py_None);
+    return Py_None;
+  }
+
+  // the message is handed over to python as is, not copied into bytes
+  return NewPyMemoryView(reader->read(r == 1));
+}
+
 PyObject *cyber_PyReader_register_func(PyObject *self, PyObject *args) {
   PyObject *pyobj_regist_fun = nullptr;
   PyObject *pyobj_reader = nullptr;
@@ -849,6 +882,7 @@ static PyMethodDef _cyber_methods[] = {
     {"delete_PyReader", cyber_delete_PyReader, METH_VARARGS, ""},
     {"PyReader_register_func", cyber_PyReader_register_func, METH_VARARGS, ""},
     {"PyReader_read", cyber_PyReader_read, METH_VARARGS, ""},
+    {"PyReader_read_view", cyber_PyReader_read_view, METH_VARARGS, ""},
 
     // PyClient fun
     {"new_PyClient", cyber_new_PyClient, METH_VARARGS, ""},
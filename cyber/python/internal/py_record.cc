@@ -18,9 +18,17 @@
 #include <limits>
 #include <set>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include <Python.h>
 
+#include "cyber/python/internal/py_buffer.h"
+
+using apollo::cyber::NewPyMemoryView;
+using apollo::cyber::record::BagColumns;
+using apollo::cyber::record::BagMessage;
+using apollo::cyber::record::BagMessages;
 using apollo::cyber::record::PyRecordReader;
 using apollo::cyber::record::PyRecordWriter;
 
@@ -37,6 +45,34 @@ T PyObjectToPtr(PyObject *pyobj, const std::string &type_ptr) {
   return obj_ptr;
 }
 
+// steals the reference to value
+void SetDictItem(PyObject *dict, const char *key, PyObject *value) {
+  ACHECK(value) << "Failed to build " << key;
+  PyDict_SetItemString(dict, key, value);
+  Py_DECREF(value);
+}
+
+PyObject *BagMessageToPyDict(BagMessage &&result, bool data_view) {
+  PyObject *pyobj_bag_message = PyDict_New();
+
+  SetDictItem(pyobj_bag_message, "channel_name",
+              Py_BuildValue("s", result.channel_name.c_str()));
+  if (data_view) {
+    SetDictItem(pyobj_bag_message, "data",
+                NewPyMemoryView(std::move(result.data)));
+  } else {
+    SetDictItem(pyobj_bag_message, "data",
+                Py_BuildValue("y#", result.data.c_str(), result.data.length()));
+  }
+  SetDictItem(pyobj_bag_message, "data_type",
+              Py_BuildValue("s", result.data_type.c_str()));
+  SetDictItem(pyobj_bag_message, "timestamp",
+              Py_BuildValue("K", result.timestamp));
+  PyDict_SetItemString(pyobj_bag_message, "end",
+                       result.end ? Py_True : Py_False);
+  return pyobj_bag_message;
+}
+
 PyObject *cyber_new_PyRecordReader(PyObject *self, PyObject *args) {
   char *filepath = nullptr;
   Py_ssize_t len = 0;
@@ -89,35 +125,125 @@ PyObject *cyber_PyRecordReader_ReadMessage(PyObject *self, PyObject *args) {
     return nullptr;
   }
 
-  const auto result = reader->ReadMessage(begin_time, end_time);
-  PyObject *pyobj_bag_message = PyDict_New();
+  return BagMessageToPyDict(reader->ReadMessage(begin_time, end_time), false);
+}
 
-  PyObject *bld_name = Py_BuildValue("s", result.channel_name.c_str());
-  PyDict_SetItemString(pyobj_bag_message, "channel_name", bld_name);
-  Py_DECREF(bld_name);
+PyObject *cyber_PyRecordReader_ReadMessageView(PyObject *self,
+                                               PyObject *args) {
+  PyObject *pyobj_reader = nullptr;
+  uint64_t begin_time = 0;
+  uint64_t end_time = std::numeric_limits<uint64_t>::max();
+  if (!PyArg_ParseTuple(
+          args, const_cast<char *>("OKK:PyRecordReader_ReadMessageView"),
+          &pyobj_reader, &begin_time, &end_time)) {
+    return nullptr;
+  }
+
+  auto *reader = reinterpret_cast<PyRecordReader *>(PyCapsule_GetPointer(
+      pyobj_reader, "apollo_cyber_record_pyrecordfilereader"));
+  if (nullptr == reader) {
+    AERROR << "PyRecordReader_ReadMessageView ptr is null!";
+    return nullptr;
+  }
 
-  PyObject *bld_data =
-      Py_BuildValue("y#", result.data.c_str(), result.data.length());
+  return BagMessageToPyDict(reader->ReadMessage(begin_time, end_time), true);
+}
+
+PyObject *cyber_PyRecordReader_ReadMessages(PyObject *self, PyObject *args) {
+  PyObject *pyobj_reader = nullptr;
+  uint64_t max_count = 0;
+  uint64_t begin_time = 0;
+  uint64_t end_time = std::numeric_limits<uint64_t>::max();
+  if (!PyArg_ParseTuple(args,
+                        const_cast<char *>("OKKK:PyRecordReader_ReadMessages"),
+                        &pyobj_reader, &max_count, &begin_time, &end_time)) {
+    return nullptr;
+  }
 
-  ACHECK(bld_data) << "Py_BuildValue returns NULL.";
-  PyDict_SetItemString(pyobj_bag_message, "data", bld_data);
-  Py_DECREF(bld_data);
+  auto *reader = reinterpret_cast<PyRecordReader *>(PyCapsule_GetPointer(
+      pyobj_reader, "apollo_cyber_record_pyrecordfilereader"));
+  if (nullptr == reader) {
+    AERROR << "PyRecordReader_ReadMessages ptr is null!";
+    return nullptr;
+  }
 
-  PyObject *bld_type = Py_BuildValue("s", result.data_type.c_str());
-  PyDict_SetItemString(pyobj_bag_message, "data_type", bld_type);
-  Py_DECREF(bld_type);
+  BagMessages result = reader->ReadMessages(max_count, begin_time, end_time);
+  PyObject *pyobj_bag_messages = PyDict_New();
+  SetDictItem(pyobj_bag_messages, "data",
+              NewPyMemoryView(std::move(result.data)));
+  SetDictItem(pyobj_bag_messages, "offsets",
+              NewPyMemoryView(std::move(result.offsets), "Q",
+                              sizeof(uint64_t)));
+  SetDictItem(pyobj_bag_messages, "timestamps",
+              NewPyMemoryView(std::move(result.timestamps), "Q",
+                              sizeof(uint64_t)));
+  SetDictItem(pyobj_bag_messages, "channels",
+              NewPyMemoryView(std::move(result.channels), "I",
+                              sizeof(uint32_t)));
+  PyObject *pyobj_names = PyList_New(result.channel_names.size());
+  for (size_t i = 0; i < result.channel_names.size(); ++i) {
+    PyList_SetItem(pyobj_names, i,
+                   Py_BuildValue("s", result.channel_names[i].c_str()));
+  }
+  SetDictItem(pyobj_bag_messages, "channel_names", pyobj_names);
+  PyDict_SetItemString(pyobj_bag_messages, "end",
+                       result.end ? Py_True : Py_False);
+  return pyobj_bag_messages;
+}
 
-  PyObject *bld_time = Py_BuildValue("s", "timestamp");
-  PyObject *bld_rtime = Py_BuildValue("K", result.timestamp);
-  PyDict_SetItem(pyobj_bag_message, bld_time, bld_rtime);
-  Py_DECREF(bld_time);
-  Py_DECREF(bld_rtime);
+PyObject *cyber_PyRecordReader_ReadColumns(PyObject *self, PyObject *args) {
+  PyObject *pyobj_reader = nullptr;
+  char *channel_name = nullptr;
+  PyObject *pyobj_fields = nullptr;
+  uint64_t begin_time = 0;
+  uint64_t end_time = std::numeric_limits<uint64_t>::max();
+  if (!PyArg_ParseTuple(args,
+                        const_cast<char *>("OsOKK:PyRecordReader_ReadColumns"),
+                        &pyobj_reader, &channel_name, &pyobj_fields,
+                        &begin_time, &end_time)) {
+    return nullptr;
+  }
 
-  PyObject *bld_end = Py_BuildValue("s", "end");
-  PyDict_SetItem(pyobj_bag_message, bld_end, result.end ? Py_True : Py_False);
-  Py_DECREF(bld_end);
+  auto *reader = reinterpret_cast<PyRecordReader *>(PyCapsule_GetPointer(
+      pyobj_reader, "apollo_cyber_record_pyrecordfilereader"));
+  if (nullptr == reader) {
+    AERROR << "PyRecordReader_ReadColumns ptr is null!";
+    return nullptr;
+  }
 
-  return pyobj_bag_message;
+  PyObject *pyobj_seq =
+      PySequence_Fast(pyobj_fields, "fields must be a sequence of str");
+  if (nullptr == pyobj_seq) {
+    return nullptr;
+  }
+  std::vector<std::string> fields;
+  for (Py_ssize_t i = 0; i < PySequence_Fast_GET_SIZE(pyobj_seq); ++i) {
+    const char *field =
+        PyUnicode_AsUTF8(PySequence_Fast_GET_ITEM(pyobj_seq, i));
+    if (nullptr == field) {
+      Py_DECREF(pyobj_seq);
+      return nullptr;
+    }
+    fields.emplace_back(field);
+  }
+  Py_DECREF(pyobj_seq);
+
+  BagColumns result;
+  if (!reader->ReadColumns(channel_name, fields, begin_time, end_time,
+                           &result)) {
+    Py_INCREF(Py_None);
+    return Py_None;
+  }
+  PyObject *pyobj_columns = PyDict_New();
+  SetDictItem(pyobj_columns, "timestamp",
+              NewPyMemoryView(std::move(result.timestamps), "Q",
+                              sizeof(uint64_t)));
+  for (size_t i = 0; i < fields.size(); ++i) {
+    SetDictItem(pyobj_columns, fields[i].c_str(),
+                NewPyMemoryView(std::move(result.columns[i]), "d",
+                                sizeof(double)));
+  }
+  return pyobj_columns;
 }
 
 PyObject *cyber_PyRecordReader_GetMessageNumber(PyObject *self,
@@ -522,6 +648,12 @@ static PyMethodDef _cyber_record_methods[] = {
     {"delete_PyRecordReader", cyber_delete_PyRecordReader, METH_VARARGS, ""},
     {"PyRecordReader_ReadMessage", cyber_PyRecordReader_ReadMessage,
      METH_VARARGS, ""},
+    {"PyRecordReader_ReadMessageView", cyber_PyRecordReader_ReadMessageView,
+     METH_VARARGS, ""},
+    {"PyRecordReader_ReadMessages", cyber_PyRecordReader_ReadMessages,
+     METH_VARARGS, ""},
+    {"PyRecordReader_ReadColumns", cyber_PyRecordReader_ReadColumns,
+     METH_VARARGS, ""},
     {"PyRecordReader_GetMessageNumber", cyber_PyRecordReader_GetMessageNumber,
      METH_VARARGS, ""},
     {"PyRecordReader_GetMessageType", cyber_PyRecordReader_GetMessageType,
@@ -19,6 +19,7 @@
 
 #include <unistd.h>
 
+#include <cmath>
 #include <iostream>
 #include <limits>
 #include <memory>
@@ -26,6 +27,11 @@
 #include <set>
 #include <string>
 #include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "google/protobuf/message.h"
 
 #include "cyber/message/protobuf_factory.h"
 #include "cyber/message/py_message.h"
@@ -47,9 +53,42 @@ struct BagMessage {
   bool end = true;
 };
 
+/**
+ * A batch of messages, stored as columns which are handed over to Python
+ * without copy. The items of the columns other than `data` are in native
+ * byte order.
+ */
+struct BagMessages {
+  // the contents of the messages back to back
+  std::string data;
+  // uint64 items, message i being [offsets[i], offsets[i + 1]) of data
+  std::string offsets;
+  // uint64 items
+  std::string timestamps;
+  // uint32 items, indexes in channel_names
+  std::string channels;
+  std::vector<std::string> channel_names;
+  bool end = true;
+};
+
+/**
+ * Fields of the messages of one channel, as columns of doubles.
+ */
+struct BagColumns {
+  // uint64 items
+  std::string timestamps;
+  // double items, one column per field
+  std::vector<std::string> columns;
+};
+
+template <typename T>
+void AppendItem(T value, std::string* column) {
+  column->append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
 class PyRecordReader {
  public:
-  explicit PyRecordReader(const std::string& file) {
+  explicit PyRecordReader(const std::string& file) : file_(file) {
     record_reader_.reset(new RecordReader(file));
   }
 
@@ -64,14 +103,97 @@ class PyRecordReader {
     }
 
     ret_msg.end = false;
-    ret_msg.channel_name = record_message.channel_name;
-    ret_msg.data = record_message.content;
-    ret_msg.timestamp = record_message.time;
     ret_msg.data_type =
         record_reader_->GetMessageType(record_message.channel_name);
+    ret_msg.channel_name = std::move(record_message.channel_name);
+    ret_msg.data = std::move(record_message.content);
+    ret_msg.timestamp = record_message.time;
     return ret_msg;
   }
 
+  /**
+   * @brief Read up to `max_count` messages at once, which saves a Python
+   * object per message.
+   */
+  BagMessages ReadMessages(
+      uint64_t max_count, uint64_t begin_time = 0,
+      uint64_t end_time = std::numeric_limits<uint64_t>::max()) {
+    BagMessages ret_msgs;
+    std::unordered_map<std::string, uint32_t> channel_indexes;
+    RecordMessage record_message;
+    uint64_t count = 0;
+    AppendItem<uint64_t>(0, &ret_msgs.offsets);
+    for (; count < max_count; ++count) {
+      if (!record_reader_->ReadMessage(&record_message, begin_time,
+                                       end_time)) {
+        break;
+      }
+      auto iter = channel_indexes.find(record_message.channel_name);
+      if (iter == channel_indexes.end()) {
+        iter = channel_indexes
+                   .emplace(record_message.channel_name,
+                            static_cast<uint32_t>(channel_indexes.size()))
+                   .first;
+        ret_msgs.channel_names.push_back(record_message.channel_name);
+      }
+      ret_msgs.data.append(record_message.content);
+      AppendItem<uint64_t>(ret_msgs.data.size(), &ret_msgs.offsets);
+      AppendItem<uint64_t>(record_message.time, &ret_msgs.timestamps);
+      AppendItem<uint32_t>(iter->second, &ret_msgs.channels);
+    }
+    ret_msgs.end = count < max_count;
+    return ret_msgs;
+  }
+
+  /**
+   * @brief Read fields of all the messages of a channel as columns of
+   * doubles, from the beginning of the record and independently of
+   * ReadMessage.
+   *
+   * @param fields dot separated paths of singular numeric, bool or enum
+   * fields, e.g. "pose.position.x"; an unset field reads its default
+   */
+  bool ReadColumns(const std::string& channel_name,
+                   const std::vector<std::string>& fields,
+                   uint64_t begin_time, uint64_t end_time,
+                   BagColumns* columns) {
+    auto* factory = message::ProtobufFactory::Instance();
+    factory->RegisterMessage(record_reader_->GetProtoDesc(channel_name));
+    std::unique_ptr<google::protobuf::Message> message(
+        factory->GenerateMessageByType(
+            record_reader_->GetMessageType(channel_name)));
+    if (message == nullptr) {
+      AERROR << "Unknown message type of channel " << channel_name;
+      return false;
+    }
+    std::vector<FieldPath> field_paths(fields.size());
+    for (size_t i = 0; i < fields.size(); ++i) {
+      if (!ResolveField(message->GetDescriptor(), fields[i],
+                        &field_paths[i])) {
+        return false;
+      }
+    }
+
+    columns->columns.assign(fields.size(), std::string());
+    RecordReader reader(file_);
+    RecordMessage record_message;
+    while (reader.ReadMessage(&record_message, begin_time, end_time)) {
+      if (record_message.channel_name != channel_name) {
+        continue;
+      }
+      if (!message->ParseFromString(record_message.content)) {
+        AWARN << "Failed to parse a message of channel " << channel_name;
+        continue;
+      }
+      AppendItem<uint64_t>(record_message.time, &columns->timestamps);
+      for (size_t i = 0; i < field_paths.size(); ++i) {
+        AppendItem<double>(FieldValue(*message, field_paths[i]),
+                           &columns->columns[i]);
+      }
+    }
+    return true;
+  }
+
   uint64_t GetMessageNumber(const std::string& channel_name) {
     return record_reader_->GetMessageNumber(channel_name);
   }
@@ -97,6 +219,69 @@ class PyRecordReader {
   }
 
  private:
+  using FieldDescriptor = google::protobuf::FieldDescriptor;
+  using FieldPath = std::vector<const FieldDescriptor*>;
+
+  static bool ResolveField(const google::protobuf::Descriptor* descriptor,
+                           const std::string& field, FieldPath* field_path) {
+    size_t begin = 0;
+    while (true) {
+      size_t end = field.find('.', begin);
+      const FieldDescriptor* field_desc =
+          descriptor == nullptr
+              ? nullptr
+              : descriptor->FindFieldByName(field.substr(begin, end - begin));
+      if (field_desc == nullptr || field_desc->is_repeated()) {
+        AERROR << "No singular field " << field;
+        return false;
+      }
+      field_path->push_back(field_desc);
+      if (end == std::string::npos) {
+        break;
+      }
+      descriptor = field_desc->message_type();
+      begin = end + 1;
+    }
+    auto cpp_type = field_path->back()->cpp_type();
+    if (cpp_type == FieldDescriptor::CPPTYPE_MESSAGE ||
+        cpp_type == FieldDescriptor::CPPTYPE_STRING) {
+      AERROR << "Field " << field << " is not numeric";
+      return false;
+    }
+    return true;
+  }
+
+  static double FieldValue(const google::protobuf::Message& message,
+                           const FieldPath& field_path) {
+    const google::protobuf::Message* msg = &message;
+    for (size_t i = 0; i + 1 < field_path.size(); ++i) {
+      msg = &msg->GetReflection()->GetMessage(*msg, field_path[i]);
+    }
+    const auto* reflection = msg->GetReflection();
+    const FieldDescriptor* field = field_path.back();
+    switch (field->cpp_type()) {
+      case FieldDescriptor::CPPTYPE_INT32:
+        return reflection->GetInt32(*msg, field);
+      case FieldDescriptor::CPPTYPE_INT64:
+        return static_cast<double>(reflection->GetInt64(*msg, field));
+      case FieldDescriptor::CPPTYPE_UINT32:
+        return reflection->GetUInt32(*msg, field);
+      case FieldDescriptor::CPPTYPE_UINT64:
+        return static_cast<double>(reflection->GetUInt64(*msg, field));
+      case FieldDescriptor::CPPTYPE_DOUBLE:
+        return reflection->GetDouble(*msg, field);
+      case FieldDescriptor::CPPTYPE_FLOAT:
+        return reflection->GetFloat(*msg, field);
+      case FieldDescriptor::CPPTYPE_BOOL:
+        return reflection->GetBool(*msg, field) ? 1.0 : 0.0;
+      case FieldDescriptor::CPPTYPE_ENUM:
+        return reflection->GetEnumValue(*msg, field);
+      default:
+        return std::nan("");
+    }
+  }
+
+  std::string file_;
   std::unique_ptr<RecordReader> record_reader_;
 };
 
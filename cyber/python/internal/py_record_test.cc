@@ -16,6 +16,7 @@
 
 #include "cyber/python/internal/py_record.h"
 
+#include <limits>
 #include <set>
 #include <string>
 #include "gtest/gtest.h"
@@ -75,5 +76,65 @@ TEST(CyberRecordTest, record_readerwriter) {
   EXPECT_TRUE(header.is_complete());
 }
 
+TEST(CyberRecordTest, record_read_messages_and_columns) {
+  proto::Header header;
+  std::string proto_desc;
+  message::ProtobufFactory::GetDescriptorString(header, &proto_desc);
+
+  record::PyRecordWriter rec_writer;
+  rec_writer.SetSizeOfFileSegmentation(0);
+  rec_writer.SetIntervalOfFileSegmentation(0);
+  EXPECT_TRUE(rec_writer.Open(TEST_RECORD_FILE));
+  rec_writer.WriteChannel(CHAN_1, header.GetTypeName(), proto_desc);
+  rec_writer.WriteChannel(CHAN_2, MSG_TYPE, PROTO_DESC);
+  for (uint64_t i = 0; i < 3; ++i) {
+    header.set_begin_time(i * 10);
+    header.set_is_complete(i % 2 == 0);
+    std::string content;
+    header.SerializeToString(&content);
+    rec_writer.WriteMessage(CHAN_1, content, 100 + i);
+    rec_writer.WriteMessage(CHAN_2, MSG_DATA, 100 + i);
+  }
+  rec_writer.Close();
+
+  record::PyRecordReader rec_reader(TEST_RECORD_FILE);
+  record::BagMessages bag_msgs = rec_reader.ReadMessages(4);
+  EXPECT_FALSE(bag_msgs.end);
+  ASSERT_EQ(4 * sizeof(uint64_t), bag_msgs.timestamps.size());
+  ASSERT_EQ(5 * sizeof(uint64_t), bag_msgs.offsets.size());
+  ASSERT_EQ(4 * sizeof(uint32_t), bag_msgs.channels.size());
+  ASSERT_EQ(2, bag_msgs.channel_names.size());
+  auto* offsets = reinterpret_cast<const uint64_t*>(bag_msgs.offsets.data());
+  auto* channels = reinterpret_cast<const uint32_t*>(bag_msgs.channels.data());
+  EXPECT_EQ(bag_msgs.data.size(), offsets[4]);
+  EXPECT_EQ(CHAN_2, bag_msgs.channel_names[channels[1]]);
+  EXPECT_EQ(MSG_DATA,
+            bag_msgs.data.substr(offsets[1], offsets[2] - offsets[1]));
+
+  bag_msgs = rec_reader.ReadMessages(4);
+  EXPECT_TRUE(bag_msgs.end);
+  EXPECT_EQ(2 * sizeof(uint64_t), bag_msgs.timestamps.size());
+
+  record::BagColumns columns;
+  EXPECT_FALSE(rec_reader.ReadColumns(CHAN_1, {"no_such_field"}, 0,
+                                      std::numeric_limits<uint64_t>::max(),
+                                      &columns));
+  ASSERT_TRUE(rec_reader.ReadColumns(CHAN_1, {"begin_time", "is_complete"}, 0,
+                                     std::numeric_limits<uint64_t>::max(),
+                                     &columns));
+  ASSERT_EQ(3 * sizeof(uint64_t), columns.timestamps.size());
+  ASSERT_EQ(2, columns.columns.size());
+  auto* times = reinterpret_cast<const uint64_t*>(columns.timestamps.data());
+  auto* begin_times =
+      reinterpret_cast<const double*>(columns.columns[0].data());
+  auto* is_complete =
+      reinterpret_cast<const double*>(columns.columns[1].data());
+  for (uint64_t i = 0; i < 3; ++i) {
+    EXPECT_EQ(100 + i, times[i]);
+    EXPECT_DOUBLE_EQ(i * 10.0, begin_times[i]);
+    EXPECT_DOUBLE_EQ(i % 2 == 0 ? 1.0 : 0.0, is_complete[i]);
+  }
+}
+
 }  // namespace cyber
 }  // namespace apollo
@@ -0,0 +1,129 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "cyber/record/file/chunk_codec.h"
+
+#include <limits>
+
+#include "lz4.h"
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace cyber {
+namespace record {
+
+using apollo::cyber::proto::CompressType;
+
+namespace {
+
+void PutFrameHeader(CompressType type, uint64_t raw_size, std::string* frame) {
+  frame->push_back(static_cast<char>(type));
+  for (int i = 0; i < 8; ++i) {
+    frame->push_back(static_cast<char>((raw_size >> (8 * i)) & 0xFF));
+  }
+}
+
+uint64_t GetRawSize(const char* frame) {
+  uint64_t raw_size = 0;
+  for (int i = 0; i < 8; ++i) {
+    raw_size |= static_cast<uint64_t>(static_cast<uint8_t>(frame[1 + i]))
+                << (8 * i);
+  }
+  return raw_size;
+}
+
+}  // namespace
+
+bool ChunkCodec::IsSupported(CompressType type) {
+  return type == CompressType::COMPRESS_NONE ||
+         type == CompressType::COMPRESS_LZ4;
+}
+
+bool ChunkCodec::Encode(CompressType type, const std::string& raw,
+                        std::string* frame) {
+  RETURN_VAL_IF_NULL(frame, false);
+  frame->clear();
+  if (type == CompressType::COMPRESS_LZ4 &&
+      raw.size() <= static_cast<size_t>(std::numeric_limits<int>::max())) {
+    int bound = LZ4_compressBound(static_cast<int>(raw.size()));
+    frame->reserve(kFrameHeaderSize + bound);
+    PutFrameHeader(type, raw.size(), frame);
+    frame->resize(kFrameHeaderSize + bound);
+    int size = LZ4_compress_default(raw.data(), &(*frame)[kFrameHeaderSize],
+                                    static_cast<int>(raw.size()), bound);
+    if (size > 0 && static_cast<size_t>(size) < raw.size()) {
+      frame->resize(kFrameHeaderSize + size);
+      return true;
+    }
+    frame->clear();
+  } else if (type != CompressType::COMPRESS_NONE) {
+    AWARN << "Unsupported chunk compress type " << type
+          << ", the chunk is stored uncompressed.";
+  }
+
+  frame->reserve(kFrameHeaderSize + raw.size());
+  PutFrameHeader(CompressType::COMPRESS_NONE, raw.size(), frame);
+  frame->append(raw);
+  return true;
+}
+
+bool ChunkCodec::Decode(const char* frame, size_t size, std::string* raw) {
+  RETURN_VAL_IF_NULL(raw, false);
+  if (frame == nullptr || size < kFrameHeaderSize) {
+    AERROR << "Chunk frame is too short: " << size;
+    return false;
+  }
+  auto type = static_cast<CompressType>(static_cast<uint8_t>(frame[0]));
+  uint64_t raw_size = GetRawSize(frame);
+  const char* payload = frame + kFrameHeaderSize;
+  size_t payload_size = size - kFrameHeaderSize;
+
+  switch (type) {
+    case CompressType::COMPRESS_NONE:
+      if (payload_size != raw_size) {
+        AERROR << "Chunk frame size mismatch, expect: " << raw_size
+               << ", actual: " << payload_size;
+        return false;
+      }
+      raw->assign(payload, payload_size);
+      return true;
+    case CompressType::COMPRESS_LZ4: {
+      if (raw_size > static_cast<uint64_t>(std::numeric_limits<int>::max()) ||
+          payload_size > static_cast<size_t>(std::numeric_limits<int>::max())) {
+        AERROR << "Lz4 chunk is too large: " << raw_size;
+        return false;
+      }
+      raw->resize(raw_size);
+      int ret = LZ4_decompress_safe(payload, &(*raw)[0],
+                                    static_cast<int>(payload_size),
+                                    static_cast<int>(raw_size));
+      if (ret < 0 || static_cast<uint64_t>(ret) != raw_size) {
+        AERROR << "Lz4 decompress chunk failed, ret: " << ret;
+        return false;
+      }
+      return true;
+    }
+    default:
+      AERROR << "Unsupported chunk compress type " << type;
+      return false;
+  }
+}
+
+}  // namespace record
+}  // namespace cyber
+}  // namespace apollo
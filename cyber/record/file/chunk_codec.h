@@ -0,0 +1,61 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#ifndef CYBER_RECORD_FILE_CHUNK_CODEC_H_
+#define CYBER_RECORD_FILE_CHUNK_CODEC_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "cyber/proto/record.pb.h"
+
+namespace apollo {
+namespace cyber {
+namespace record {
+
+/**
+ * @class ChunkCodec
+ * @brief Compression of chunk body sections. Records whose header asks for
+ * compression store every chunk body as a frame: one byte codec, the raw
+ * size as 8 bytes little endian, then the payload. The codec is kept per
+ * chunk so chunks that do not shrink are stored as they are.
+ */
+class ChunkCodec {
+ public:
+  static const size_t kFrameHeaderSize = 9;
+
+  /**
+   * @brief Build the frame of serialized chunk body `raw`. Unsupported
+   * codecs fall back to COMPRESS_NONE.
+   */
+  static bool Encode(proto::CompressType type, const std::string& raw,
+                     std::string* frame);
+
+  /**
+   * @brief Restore the serialized chunk body from a frame.
+   */
+  static bool Decode(const char* frame, size_t size, std::string* raw);
+
+  static bool IsSupported(proto::CompressType type);
+};
+
+}  // namespace record
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_RECORD_FILE_CHUNK_CODEC_H_
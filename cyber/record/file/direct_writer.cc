@@ -0,0 +1,169 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "cyber/record/file/direct_writer.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace cyber {
+namespace record {
+
+constexpr size_t DirectWriter::kAlignment;
+
+DirectWriter::DirectWriter(size_t buffer_size, size_t buffer_count)
+    : buffer_size_((buffer_size + kAlignment - 1) / kAlignment * kAlignment) {
+  if (buffer_size_ == 0) {
+    buffer_size_ = kAlignment;
+  }
+  // one buffer is filled while the others are written
+  for (size_t i = 0; i < std::max<size_t>(buffer_count, 2); ++i) {
+    void* data = nullptr;
+    if (posix_memalign(&data, kAlignment, buffer_size_) != 0) {
+      AERROR << "Allocate aligned buffer of " << buffer_size_ << " failed.";
+      break;
+    }
+    pool_.push_back(static_cast<char*>(data));
+  }
+}
+
+DirectWriter::~DirectWriter() {
+  Close();
+  for (auto data : pool_) {
+    free(data);
+  }
+}
+
+bool DirectWriter::Open(const std::string& path) {
+  if (fd_ >= 0 || pool_.size() < 2) {
+    return false;
+  }
+  fd_ = open(path.c_str(), O_CREAT | O_WRONLY | O_DIRECT,
+             S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+  if (fd_ < 0) {
+    AWARN << "Open file with O_DIRECT failed, file: " << path
+          << ", errno: " << errno;
+    return false;
+  }
+  free_.assign(pool_.begin() + 1, pool_.end());
+  current_ = Buffer{pool_.front(), 0, 0};
+  position_ = 0;
+  failed_ = false;
+  stop_ = false;
+  thread_ = std::thread(&DirectWriter::ThreadFunc, this);
+  return true;
+}
+
+bool DirectWriter::Write(const void* data, size_t size) {
+  auto src = static_cast<const char*>(data);
+  while (size > 0) {
+    size_t count = std::min(size, buffer_size_ - current_.size);
+    memcpy(current_.data + current_.size, src, count);
+    current_.size += count;
+    position_ += count;
+    src += count;
+    size -= count;
+    if (current_.size == buffer_size_ && !Submit()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool DirectWriter::Submit() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  pending_.push_back(current_);
+  cv_.notify_all();
+  cv_.wait(lock, [this] { return !free_.empty() || failed_; });
+  if (failed_) {
+    return false;
+  }
+  current_ = Buffer{free_.back(), 0, position_};
+  free_.pop_back();
+  return true;
+}
+
+void DirectWriter::ThreadFunc() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    cv_.wait(lock, [this] { return !pending_.empty() || stop_; });
+    if (pending_.empty()) {
+      return;
+    }
+    Buffer buffer = pending_.front();
+    lock.unlock();
+    // a partial last block is padded up, Close() truncates it again
+    size_t size = (buffer.size + kAlignment - 1) / kAlignment * kAlignment;
+    memset(buffer.data + buffer.size, 0, size - buffer.size);
+    size_t offset = 0;
+    bool ok = true;
+    while (offset < size) {
+      ssize_t count = pwrite(fd_, buffer.data + offset, size - offset,
+                             buffer.offset + offset);
+      if (count < 0 && errno == EINTR) {
+        continue;
+      }
+      if (count <= 0) {
+        AERROR << "Direct write failed, fd: " << fd_ << ", errno: " << errno;
+        ok = false;
+        break;
+      }
+      offset += count;
+    }
+    lock.lock();
+    pending_.pop_front();
+    free_.push_back(buffer.data);
+    failed_ = failed_ || !ok;
+    cv_.notify_all();
+  }
+}
+
+bool DirectWriter::Close() {
+  if (fd_ < 0) {
+    return !failed_;
+  }
+  if (current_.size > 0) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_.push_back(current_);
+    current_.size = 0;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  cv_.notify_all();
+  thread_.join();
+  if (ftruncate(fd_, position_) < 0) {
+    AERROR << "Truncate file failed, fd: " << fd_ << ", errno: " << errno;
+    failed_ = true;
+  }
+  close(fd_);
+  fd_ = -1;
+  return !failed_;
+}
+
+}  // namespace record
+}  // namespace cyber
+}  // namespace apollo
@@ -0,0 +1,92 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#ifndef CYBER_RECORD_FILE_DIRECT_WRITER_H_
+#define CYBER_RECORD_FILE_DIRECT_WRITER_H_
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace apollo {
+namespace cyber {
+namespace record {
+
+/**
+ * @class DirectWriter
+ * @brief Sequential file writer bypassing the page cache. Data is staged in
+ * a fixed pool of aligned buffers and written with O_DIRECT by a background
+ * thread, so recording neither grows the page cache nor evicts the pages
+ * other processes rely on. Write() blocks when every buffer is in flight.
+ */
+class DirectWriter {
+ public:
+  static constexpr size_t kAlignment = 4096;
+
+  DirectWriter(size_t buffer_size, size_t buffer_count);
+  ~DirectWriter();
+
+  /**
+   * @brief Fails when the file system does not support O_DIRECT.
+   */
+  bool Open(const std::string& path);
+  bool Write(const void* data, size_t size);
+  /**
+   * @brief Write out the pending data, cut the padding of the last block and
+   * close the file.
+   *
+   * @return False if any write failed.
+   */
+  bool Close();
+
+  int fd() const { return fd_; }
+  uint64_t Position() const { return position_; }
+
+ private:
+  struct Buffer {
+    char* data = nullptr;
+    size_t size = 0;
+    uint64_t offset = 0;
+  };
+
+  bool Submit();
+  void ThreadFunc();
+
+  size_t buffer_size_;
+  std::vector<char*> pool_;
+  std::vector<char*> free_;
+  std::deque<Buffer> pending_;
+  Buffer current_;
+  uint64_t position_ = 0;
+  int fd_ = -1;
+  bool failed_ = false;
+  bool stop_ = false;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::thread thread_;
+};
+
+}  // namespace record
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_RECORD_FILE_DIRECT_WRITER_H_
@@ -17,6 +17,7 @@
 #include "cyber/record/file/record_file_reader.h"
 
 #include "cyber/common/file.h"
+#include "cyber/record/file/chunk_codec.h"
 
 namespace apollo {
 namespace cyber {
@@ -127,6 +128,52 @@ bool RecordFileReader::ReadSection(Section* section) {
   return true;
 }
 
+bool RecordFileReader::ReadRawSection(int64_t size, std::string* data) {
+  if (size < 0) {
+    AERROR << "Invalid section size: " << size;
+    return false;
+  }
+  data->resize(size);
+  size_t offset = 0;
+  while (offset < data->size()) {
+    ssize_t count = read(fd_, &(*data)[offset], data->size() - offset);
+    if (count < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      AERROR << "Read fd failed, fd_: " << fd_ << ", errno: " << errno;
+      return false;
+    }
+    if (count == 0) {
+      end_of_file_ = true;
+      AERROR << "Section is truncated, expect: " << size
+             << ", actual: " << offset;
+      return false;
+    }
+    offset += count;
+  }
+  return true;
+}
+
+bool RecordFileReader::ReadCompressedSection(
+    int64_t size, google::protobuf::Message* message) {
+  std::string frame;
+  if (!ReadRawSection(size, &frame)) {
+    return false;
+  }
+
+  std::string raw;
+  if (!ChunkCodec::Decode(frame.data(), frame.size(), &raw)) {
+    AERROR << "Decode compressed section failed.";
+    return false;
+  }
+  if (!message->ParseFromString(raw)) {
+    AERROR << "Parse section message failed.";
+    return false;
+  }
+  return true;
+}
+
 bool RecordFileReader::SkipSection(int64_t size) {
   int64_t pos = CurrentPosition();
   if (size > INT64_MAX - pos) {
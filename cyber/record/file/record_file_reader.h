@@ -20,6 +20,7 @@
 #include <fstream>
 #include <memory>
 #include <string>
+#include <type_traits>
 #include <unordered_map>
 #include <utility>
 
@@ -53,11 +54,14 @@ class RecordFileReader : public RecordFileBase {
   bool SkipSection(int64_t size);
   template <typename T>
   bool ReadSection(int64_t size, T* message);
+  // the bytes of the section as stored, a compressed chunk body stays a frame
+  bool ReadRawSection(int64_t size, std::string* data);
   bool ReadIndex();
   bool EndOfFile() { return end_of_file_; }
 
  private:
   bool ReadHeader();
+  bool ReadCompressedSection(int64_t size, google::protobuf::Message* message);
   bool end_of_file_ = false;
 };
 
@@ -68,6 +72,10 @@ bool RecordFileReader::ReadSection(int64_t size, T* message) {
     AERROR << "Size value greater than the range of int value.";
     return false;
   }
+  if (std::is_same<T, proto::ChunkBody>::value &&
+      header_.compress() != proto::CompressType::COMPRESS_NONE) {
+    return ReadCompressedSection(size, message);
+  }
   FileInputStream raw_input(fd_, static_cast<int>(size));
   CodedInputStream coded_input(&raw_input);
   CodedInputStream::Limit limit = coded_input.PushLimit(static_cast<int>(size));
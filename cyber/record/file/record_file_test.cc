@@ -16,9 +16,14 @@
 
 #include <unistd.h>
 #include <atomic>
+#include <fstream>
+#include <iterator>
 #include <string>
+#include <vector>
 #include "gtest/gtest.h"
 
+#include "cyber/record/file/chunk_codec.h"
+#include "cyber/record/file/direct_writer.h"
 #include "cyber/record/file/record_file_base.h"
 #include "cyber/record/file/record_file_reader.h"
 #include "cyber/record/file/record_file_writer.h"
@@ -307,6 +312,226 @@ TEST(RecordFileTest, TestIndex) {
   ASSERT_FALSE(remove(kTestFile2));
 }
 
+TEST(RecordFileTest, TestCompressedFile) {
+  const std::string content(4096, 'x');
+  {
+    RecordFileWriter rfw;
+    ASSERT_TRUE(rfw.Open(kTestFile1));
+    Header header = HeaderBuilder::GetHeaderWithChunkParams(0, 0);
+    header.set_segment_interval(0);
+    header.set_segment_raw_size(0);
+    header.set_compress(proto::CompressType::COMPRESS_LZ4);
+    ASSERT_TRUE(rfw.WriteHeader(header));
+
+    Channel chan1;
+    chan1.set_name(kChan1);
+    chan1.set_message_type(kMsgType);
+    ASSERT_TRUE(rfw.WriteChannel(chan1));
+
+    for (int i = 1; i <= 10; ++i) {
+      SingleMessage msg;
+      msg.set_channel_name(chan1.name());
+      msg.set_content(content);
+      msg.set_time(i * 1e9);
+      ASSERT_TRUE(rfw.WriteMessage(msg));
+    }
+    rfw.Close();
+    ASSERT_EQ(10, rfw.GetHeader().message_number());
+  }
+
+  RecordFileReader rfr;
+  ASSERT_TRUE(rfr.Open(kTestFile1));
+  ASSERT_EQ(proto::CompressType::COMPRESS_LZ4, rfr.GetHeader().compress());
+  Section sec;
+  ASSERT_TRUE(rfr.ReadSection(&sec));
+  ASSERT_EQ(SectionType::SECTION_CHANNEL, sec.type);
+  ASSERT_TRUE(rfr.SkipSection(sec.size));
+  ASSERT_TRUE(rfr.ReadSection(&sec));
+  ASSERT_EQ(SectionType::SECTION_CHUNK_HEADER, sec.type);
+  ChunkHeader ckh;
+  ASSERT_TRUE(rfr.ReadSection<ChunkHeader>(sec.size, &ckh));
+  ASSERT_EQ(10 * content.size(), ckh.raw_size());
+
+  ASSERT_TRUE(rfr.ReadSection(&sec));
+  ASSERT_EQ(SectionType::SECTION_CHUNK_BODY, sec.type);
+  EXPECT_LT(sec.size, static_cast<int64_t>(content.size()));
+  ChunkBody ckb;
+  ASSERT_TRUE(rfr.ReadSection<ChunkBody>(sec.size, &ckb));
+  ASSERT_EQ(10, ckb.messages_size());
+  EXPECT_EQ(content, ckb.messages(9).content());
+  EXPECT_EQ(10e9, ckb.messages(9).time());
+
+  ASSERT_FALSE(remove(kTestFile1));
+}
+
+TEST(RecordFileTest, TestRawChunk) {
+  {
+    RecordFileWriter rfw;
+    ASSERT_TRUE(rfw.Open(kTestFile1));
+    Header header = HeaderBuilder::GetHeaderWithChunkParams(0, 0);
+    header.set_segment_interval(0);
+    header.set_segment_raw_size(0);
+    ASSERT_TRUE(rfw.WriteHeader(header));
+    for (int i = 1; i <= 3; ++i) {
+      SingleMessage msg;
+      msg.set_channel_name(i == 2 ? kChan2 : kChan1);
+      msg.set_content(kStr10B);
+      msg.set_time(i * 1e9);
+      ASSERT_TRUE(rfw.WriteMessage(msg));
+    }
+    rfw.Close();
+  }
+
+  RecordFileReader rfr;
+  ASSERT_TRUE(rfr.Open(kTestFile1));
+  Section sec;
+  ASSERT_TRUE(rfr.ReadSection(&sec));
+  ASSERT_EQ(SectionType::SECTION_CHUNK_HEADER, sec.type);
+  ChunkHeader ckh;
+  ASSERT_TRUE(rfr.ReadSection<ChunkHeader>(sec.size, &ckh));
+  ASSERT_TRUE(rfr.ReadSection(&sec));
+  ASSERT_EQ(SectionType::SECTION_CHUNK_BODY, sec.type);
+  std::string data;
+  ASSERT_TRUE(rfr.ReadRawSection(sec.size, &data));
+  ASSERT_EQ(sec.size, static_cast<int64_t>(data.size()));
+  rfr.Close();
+
+  {
+    // a message written before the copied chunk stays before it
+    RecordFileWriter rfw;
+    ASSERT_TRUE(rfw.Open(kTestFile2));
+    Header header = HeaderBuilder::GetHeaderWithChunkParams(0, 0);
+    ASSERT_TRUE(rfw.WriteHeader(header));
+    SingleMessage msg;
+    msg.set_channel_name(kChan2);
+    msg.set_content(kStr10B);
+    msg.set_time(0.5e9);
+    ASSERT_TRUE(rfw.WriteMessage(msg));
+    ASSERT_TRUE(rfw.WriteRawChunk(ckh, data, {{kChan1, 2}, {kChan2, 1}}));
+    EXPECT_EQ(2, rfw.GetMessageNumber(kChan1));
+    EXPECT_EQ(2, rfw.GetMessageNumber(kChan2));
+    rfw.Close();
+    EXPECT_EQ(2, rfw.GetHeader().chunk_number());
+    EXPECT_EQ(4, rfw.GetHeader().message_number());
+    EXPECT_EQ(3e9, rfw.GetHeader().end_time());
+  }
+
+  ASSERT_TRUE(rfr.Open(kTestFile2));
+  std::vector<uint64_t> times;
+  while (rfr.ReadSection(&sec)) {
+    if (sec.type == SectionType::SECTION_INDEX) {
+      break;
+    }
+    if (sec.type != SectionType::SECTION_CHUNK_BODY) {
+      ASSERT_TRUE(rfr.SkipSection(sec.size));
+      continue;
+    }
+    ChunkBody ckb;
+    ASSERT_TRUE(rfr.ReadSection<ChunkBody>(sec.size, &ckb));
+    for (const auto& msg : ckb.messages()) {
+      times.push_back(msg.time());
+    }
+  }
+  EXPECT_EQ(std::vector<uint64_t>({500000000, 1000000000, 2000000000,
+                                   3000000000}),
+            times);
+  ASSERT_FALSE(remove(kTestFile1));
+  ASSERT_FALSE(remove(kTestFile2));
+}
+
+TEST(ChunkCodecTest, RoundTrip) {
+  std::string raw(1000, 'a');
+  std::string frame;
+  std::string decoded;
+  ASSERT_TRUE(ChunkCodec::Encode(proto::CompressType::COMPRESS_LZ4, raw,
+                                 &frame));
+  EXPECT_EQ(proto::CompressType::COMPRESS_LZ4, frame[0]);
+  EXPECT_LT(frame.size(), raw.size());
+  ASSERT_TRUE(ChunkCodec::Decode(frame.data(), frame.size(), &decoded));
+  EXPECT_EQ(raw, decoded);
+
+  // incompressible data is stored as it is
+  raw = "0123456789";
+  ASSERT_TRUE(ChunkCodec::Encode(proto::CompressType::COMPRESS_LZ4, raw,
+                                 &frame));
+  EXPECT_EQ(proto::CompressType::COMPRESS_NONE, frame[0]);
+  EXPECT_EQ(ChunkCodec::kFrameHeaderSize + raw.size(), frame.size());
+  ASSERT_TRUE(ChunkCodec::Decode(frame.data(), frame.size(), &decoded));
+  EXPECT_EQ(raw, decoded);
+
+  EXPECT_FALSE(ChunkCodec::Decode(frame.data(), 4, &decoded));
+  frame.pop_back();
+  EXPECT_FALSE(ChunkCodec::Decode(frame.data(), frame.size(), &decoded));
+}
+
+TEST(RecordFileTest, TestDirectIO) {
+  const std::string content(100000, 'x');
+  {
+    RecordFileWriter rfw;
+    rfw.SetDirectIO(true);
+    ASSERT_TRUE(rfw.Open(kTestFile1));
+    Header header = HeaderBuilder::GetHeaderWithChunkParams(0, 0);
+    header.set_segment_interval(0);
+    header.set_segment_raw_size(0);
+    ASSERT_TRUE(rfw.WriteHeader(header));
+
+    Channel chan1;
+    chan1.set_name(kChan1);
+    chan1.set_message_type(kMsgType);
+    ASSERT_TRUE(rfw.WriteChannel(chan1));
+
+    for (int i = 1; i <= 100; ++i) {
+      SingleMessage msg;
+      msg.set_channel_name(chan1.name());
+      msg.set_content(content);
+      msg.set_time(i * 1e9);
+      ASSERT_TRUE(rfw.WriteMessage(msg));
+    }
+    rfw.Close();
+  }
+
+  RecordFileReader rfr;
+  ASSERT_TRUE(rfr.Open(kTestFile1));
+  ASSERT_TRUE(rfr.GetHeader().is_complete());
+  ASSERT_EQ(100, rfr.GetHeader().message_number());
+  Section sec;
+  ASSERT_TRUE(rfr.ReadSection(&sec));
+  ASSERT_EQ(SectionType::SECTION_CHANNEL, sec.type);
+  ASSERT_TRUE(rfr.SkipSection(sec.size));
+  ASSERT_TRUE(rfr.ReadSection(&sec));
+  ASSERT_EQ(SectionType::SECTION_CHUNK_HEADER, sec.type);
+  ASSERT_TRUE(rfr.SkipSection(sec.size));
+  ASSERT_TRUE(rfr.ReadSection(&sec));
+  ASSERT_EQ(SectionType::SECTION_CHUNK_BODY, sec.type);
+  ChunkBody ckb;
+  ASSERT_TRUE(rfr.ReadSection<ChunkBody>(sec.size, &ckb));
+  ASSERT_EQ(100, ckb.messages_size());
+  EXPECT_EQ(content, ckb.messages(99).content());
+  ASSERT_FALSE(remove(kTestFile1));
+}
+
+TEST(DirectWriterTest, TestWrite) {
+  DirectWriter writer(DirectWriter::kAlignment, 2);
+  if (!writer.Open(kTestFile2)) {
+    // file system without O_DIRECT support
+    return;
+  }
+  std::string data;
+  for (int i = 0; i < 3000; ++i) {
+    data += std::to_string(i);
+  }
+  ASSERT_TRUE(writer.Write(data.data(), 1));
+  ASSERT_TRUE(writer.Write(data.data() + 1, data.size() - 1));
+  ASSERT_EQ(data.size(), writer.Position());
+  ASSERT_TRUE(writer.Close());
+
+  std::ifstream file(kTestFile2, std::ios::binary);
+  std::string read((std::istreambuf_iterator<char>(file)),
+                   std::istreambuf_iterator<char>());
+  EXPECT_EQ(data, read);
+  ASSERT_FALSE(remove(kTestFile2));
+}
+
 }  // namespace record
 }  // namespace cyber
 }  // namespace apollo
@@ -18,6 +18,9 @@
 
 #include <fcntl.h>
 
+#include <cstdlib>
+#include <cstring>
+
 #include "cyber/common/file.h"
 #include "cyber/time/time.h"
 
@@ -31,10 +34,24 @@ using apollo::cyber::proto::ChunkBody;
 using apollo::cyber::proto::ChunkBodyCache;
 using apollo::cyber::proto::ChunkHeader;
 using apollo::cyber::proto::ChunkHeaderCache;
+using apollo::cyber::proto::CompressType;
 using apollo::cyber::proto::Header;
 using apollo::cyber::proto::SectionType;
 using apollo::cyber::proto::SingleIndex;
 
+namespace {
+
+// staging pool of a direct writer, bounds the memory held for a file
+constexpr size_t kDirectBufferSize = 4 << 20;
+constexpr size_t kDirectBufferCount = 4;
+
+}  // namespace
+
+RecordFileWriter::RecordFileWriter() {
+  const char* direct_io = std::getenv("CYBER_RECORD_DIRECT_IO");
+  direct_io_ = direct_io != nullptr && strcmp(direct_io, "1") == 0;
+}
+
 RecordFileWriter::~RecordFileWriter() { Close(); }
 
 bool RecordFileWriter::Open(const std::string& path) {
@@ -43,6 +60,17 @@ bool RecordFileWriter::Open(const std::string& path) {
   if (::apollo::cyber::common::PathExists(path_)) {
     AWARN << "File exist and overwrite, file: " << path_;
   }
+  if (direct_io_) {
+    direct_writer_.reset(
+        new DirectWriter(kDirectBufferSize, kDirectBufferCount));
+    if (direct_writer_->Open(path_)) {
+      fd_ = direct_writer_->fd();
+      chunk_active_ = std::make_unique<Chunk>();
+      return true;
+    }
+    AWARN << "Direct IO is not available, use buffered writes: " << path_;
+    direct_writer_.reset();
+  }
   fd_ = open(path_.data(), O_CREAT | O_WRONLY,
              S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
   if (fd_ < 0) {
@@ -59,12 +87,29 @@ void RecordFileWriter::Close() {
     return;
   }
   flush_task_.wait();
-  Flush(*chunk_active_);
+  if (!chunk_active_->empty()) {
+    Flush(*chunk_active_);
+  }
 
   if (!WriteIndex()) {
     AERROR << "Write index section failed, file: " << path_;
   }
 
+  if (direct_writer_ != nullptr) {
+    bool written = direct_writer_->Close();
+    direct_writer_.reset();
+    fd_ = open(path_.data(), O_WRONLY);
+    if (!written || fd_ < 0) {
+      AERROR << "Finish direct writes failed, file: " << path_
+             << ", errno: " << errno;
+      if (fd_ >= 0) {
+        close(fd_);
+      }
+      fd_ = -1;
+      return;
+    }
+  }
+
   header_.set_is_complete(true);
   if (!WriteHeader(header_)) {
     AERROR << "Overwrite header section failed, file: " << path_;
@@ -80,6 +125,14 @@ void RecordFileWriter::Close() {
 bool RecordFileWriter::WriteHeader(const Header& header) {
   std::lock_guard<std::mutex> lock(mutex_);
   header_ = header;
+  compress_ = header_.compress();
+  if (compress_ != CompressType::COMPRESS_NONE &&
+      !ChunkCodec::IsSupported(compress_)) {
+    AWARN << "Unsupported compress type " << compress_
+          << ", chunks are written uncompressed.";
+    compress_ = CompressType::COMPRESS_NONE;
+    header_.set_compress(compress_);
+  }
   if (!WriteSection<Header>(header_)) {
     AERROR << "Write header section fail";
     return false;
@@ -129,7 +182,8 @@ bool RecordFileWriter::WriteChannel(const Channel& channel) {
 }
 
 bool RecordFileWriter::WriteChunk(const ChunkHeader& chunk_header,
-                                  const ChunkBody& chunk_body) {
+                                  const ChunkBody& chunk_body,
+                                  const std::string* chunk_frame) {
   std::lock_guard<std::mutex> lock(mutex_);
   uint64_t pos = CurrentPosition();
   if (!WriteSection<ChunkHeader>(chunk_header)) {
@@ -147,7 +201,11 @@ bool RecordFileWriter::WriteChunk(const ChunkHeader& chunk_header,
   single_index->set_allocated_chunk_header_cache(chunk_header_cache);
 
   pos = CurrentPosition();
-  if (!WriteSection<ChunkBody>(chunk_body)) {
+  bool written =
+      chunk_frame != nullptr
+          ? WriteRawSection(SectionType::SECTION_CHUNK_BODY, *chunk_frame)
+          : WriteSection<ChunkBody>(chunk_body);
+  if (!written) {
     AERROR << "Write chunk body fail";
     return false;
   }
@@ -162,7 +220,7 @@ bool RecordFileWriter::WriteChunk(const ChunkHeader& chunk_header,
   single_index->set_type(SectionType::SECTION_CHUNK_BODY);
   single_index->set_position(pos);
   ChunkBodyCache* chunk_body_cache = new ChunkBodyCache();
-  chunk_body_cache->set_message_number(chunk_body.messages_size());
+  chunk_body_cache->set_message_number(chunk_header.message_number());
   single_index->set_allocated_chunk_body_cache(chunk_body_cache);
   return true;
 }
@@ -204,12 +262,92 @@ bool RecordFileWriter::WriteMessage(const proto::SingleMessage& message) {
   return true;
 }
 
+bool RecordFileWriter::WriteRawChunk(
+    const ChunkHeader& chunk_header, const std::string& chunk_data,
+    const std::unordered_map<std::string, uint64_t>& message_numbers) {
+  CHECK_GE(fd_, 0) << "First, call Open";
+  flush_task_.wait();
+  if (!chunk_active_->empty()) {
+    Flush(*chunk_active_);
+    chunk_active_ = std::make_unique<Chunk>();
+  }
+  for (const auto& item : message_numbers) {
+    channel_message_number_map_[item.first] += item.second;
+  }
+  if (!WriteChunk(chunk_header, ChunkBody(), &chunk_data)) {
+    AERROR << "Write raw chunk fail.";
+    return false;
+  }
+  return true;
+}
+
 void RecordFileWriter::Flush(const Chunk& chunk) {
-  if (!WriteChunk(chunk.header_, *(chunk.body_.get()))) {
+  if (compress_ == CompressType::COMPRESS_NONE) {
+    if (!WriteChunk(chunk.header_, *(chunk.body_.get()))) {
+      AERROR << "Write chunk fail.";
+    }
+    return;
+  }
+
+  // compress before taking the file lock, this is the expensive part
+  std::string raw;
+  std::string frame;
+  if (!chunk.body_->SerializeToString(&raw) ||
+      !ChunkCodec::Encode(compress_, raw, &frame)) {
+    AERROR << "Encode chunk fail.";
+    return;
+  }
+  if (!WriteChunk(chunk.header_, *(chunk.body_.get()), &frame)) {
     AERROR << "Write chunk fail.";
   }
 }
 
+bool RecordFileWriter::WriteRawSection(SectionType type,
+                                       const std::string& data) {
+  Section section;
+  /// zero out whole struct even if padded
+  memset(&section, 0, sizeof(section));
+  section.type = type;
+  section.size = static_cast<int64_t>(data.size());
+  if (!WriteBytes(&section, sizeof(section)) ||
+      !WriteBytes(data.data(), data.size())) {
+    return false;
+  }
+  header_.set_size(CurrentPosition());
+  return true;
+}
+
+bool RecordFileWriter::WriteBytes(const void* data, size_t size) {
+  if (direct_writer_ != nullptr) {
+    if (!direct_writer_->Write(data, size)) {
+      AERROR << "Direct write failed, file: " << path_;
+      return false;
+    }
+    return true;
+  }
+  auto bytes = static_cast<const char*>(data);
+  size_t offset = 0;
+  while (offset < size) {
+    ssize_t count = write(fd_, bytes + offset, size - offset);
+    if (count < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      AERROR << "Write fd failed, fd: " << fd_ << ", errno: " << errno;
+      return false;
+    }
+    offset += count;
+  }
+  return true;
+}
+
+int64_t RecordFileWriter::CurrentPosition() {
+  if (direct_writer_ != nullptr) {
+    return static_cast<int64_t>(direct_writer_->Position());
+  }
+  return RecordFileBase::CurrentPosition();
+}
+
 void RecordFileWriter::WaitForWrite() { flush_task_.wait(); }
 
 uint64_t RecordFileWriter::GetMessageNumber(
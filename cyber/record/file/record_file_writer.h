@@ -31,6 +31,8 @@
 #include "google/protobuf/text_format.h"
 
 #include "cyber/common/log.h"
+#include "cyber/record/file/chunk_codec.h"
+#include "cyber/record/file/direct_writer.h"
 #include "cyber/record/file/record_file_base.h"
 #include "cyber/record/file/section.h"
 #include "cyber/time/time.h"
@@ -75,17 +77,31 @@ struct Chunk {
 };
 
 /**
-Writes cyber record files on an asynchronous task
+Writes cyber record files on an asynchronous task. If the header asks for
+compression, chunk bodies are compressed on that task as well. With direct IO
+enabled (SetDirectIO or CYBER_RECORD_DIRECT_IO=1) the file is written through
+a DirectWriter and bypasses the page cache; only the final header rewrite goes
+through a buffered descriptor.
 */
 class RecordFileWriter : public RecordFileBase {
  public:
-  RecordFileWriter() = default;
+  RecordFileWriter();
   ~RecordFileWriter();
   bool Open(const std::string& path) override;
   void Close() override;
+  int64_t CurrentPosition() override;
+  // Takes effect on the next Open. Falls back to buffered writes when the
+  // file system rejects O_DIRECT.
+  void SetDirectIO(bool enable) { direct_io_ = enable; }
   bool WriteHeader(const proto::Header& header);
   bool WriteChannel(const proto::Channel& channel);
   bool WriteMessage(const proto::SingleMessage& message);
+  // Appends a chunk body section copied from another record of the same
+  // compress type, after the messages written so far. `message_numbers`
+  // counts the messages of the chunk by channel name.
+  bool WriteRawChunk(
+      const proto::ChunkHeader& chunk_header, const std::string& chunk_data,
+      const std::unordered_map<std::string, uint64_t>& message_numbers);
   uint64_t GetMessageNumber(const std::string& channel_name) const;
 
   // For testing
@@ -93,9 +109,12 @@ class RecordFileWriter : public RecordFileBase {
 
  private:
   bool WriteChunk(const proto::ChunkHeader& chunk_header,
-                  const proto::ChunkBody& chunk_body);
+                  const proto::ChunkBody& chunk_body,
+                  const std::string* chunk_frame = nullptr);
   template <typename T>
   bool WriteSection(const T& message);
+  bool WriteRawSection(proto::SectionType type, const std::string& data);
+  bool WriteBytes(const void* data, size_t size);
   bool WriteIndex();
   void Flush(const Chunk& chunk);
   bool IsChunkFlushEmpty();
@@ -105,6 +124,9 @@ class RecordFileWriter : public RecordFileBase {
   // Initialize with a dummy value to simplify checking later
   std::future<void> flush_task_ = std::async(std::launch::async, []() {});
   std::unordered_map<std::string, uint64_t> channel_message_number_map_;
+  proto::CompressType compress_ = proto::CompressType::COMPRESS_NONE;
+  bool direct_io_ = false;
+  std::unique_ptr<DirectWriter> direct_writer_;
 };
 
 template <typename T>
@@ -118,7 +140,11 @@ bool RecordFileWriter::WriteSection(const T& message) {
     type = proto::SectionType::SECTION_CHANNEL;
   } else if (std::is_same<T, proto::Header>::value) {
     type = proto::SectionType::SECTION_HEADER;
-    if (!SetPosition(0)) {
+    // a direct writer only appends, the header is rewritten after it closed
+    bool positioned = direct_writer_ != nullptr
+                          ? direct_writer_->Position() == 0
+                          : SetPosition(0);
+    if (!positioned) {
       AERROR << "Jump to position #0 failed";
       return false;
     }
@@ -133,32 +159,22 @@ bool RecordFileWriter::WriteSection(const T& message) {
   memset(&section, 0, sizeof(section));
   section.type = type;
   section.size = static_cast<int64_t>(message.ByteSizeLong());
-  ssize_t count = write(fd_, &section, sizeof(section));
-  if (count < 0) {
-    AERROR << "Write fd failed, fd: " << fd_ << ", errno: " << errno;
+  if (!WriteBytes(&section, sizeof(section))) {
     return false;
   }
-  if (count != sizeof(section)) {
-    AERROR << "Write fd failed, fd: " << fd_
-           << ", expect count: " << sizeof(section)
-           << ", actual count: " << count;
-    return false;
-  }
-  {
+  if (direct_writer_ != nullptr) {
+    std::string data;
+    if (!message.SerializeToString(&data) ||
+        !WriteBytes(data.data(), data.size())) {
+      return false;
+    }
+  } else {
     google::protobuf::io::FileOutputStream raw_output(fd_);
     message.SerializeToZeroCopyStream(&raw_output);
   }
   if (type == proto::SectionType::SECTION_HEADER) {
     static char blank[HEADER_LENGTH] = {'0'};
-    count = write(fd_, &blank, HEADER_LENGTH - message.ByteSizeLong());
-    if (count < 0) {
-      AERROR << "Write fd failed, fd: " << fd_ << ", errno: " << errno;
-      return false;
-    }
-    if (static_cast<size_t>(count) != HEADER_LENGTH - message.ByteSizeLong()) {
-      AERROR << "Write fd failed, fd: " << fd_
-             << ", expect count: " << sizeof(section)
-             << ", actual count: " << count;
+    if (!WriteBytes(&blank, HEADER_LENGTH - message.ByteSizeLong())) {
       return false;
     }
   }
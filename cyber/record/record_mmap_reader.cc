@@ -0,0 +1,343 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "cyber/record/record_mmap_reader.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include "google/protobuf/io/coded_stream.h"
+#include "google/protobuf/wire_format_lite.h"
+
+#include "cyber/common/log.h"
+#include "cyber/record/file/chunk_codec.h"
+#include "cyber/record/file/record_file_base.h"
+#include "cyber/record/file/section.h"
+
+namespace apollo {
+namespace cyber {
+namespace record {
+
+using apollo::cyber::proto::CompressType;
+using apollo::cyber::proto::SectionType;
+using google::protobuf::io::CodedInputStream;
+using google::protobuf::internal::WireFormatLite;
+
+namespace {
+
+// field numbers of ChunkBody and SingleMessage in record.proto
+constexpr int kChunkBodyMessages = 1;
+constexpr int kSingleMessageChannelName = 1;
+constexpr int kSingleMessageTime = 2;
+constexpr int kSingleMessageContent = 3;
+
+bool ReadBytesView(CodedInputStream* input, const char* base,
+                   std::string_view* view) {
+  uint32_t length = 0;
+  if (!input->ReadVarint32(&length)) {
+    return false;
+  }
+  int offset = input->CurrentPosition();
+  if (!input->Skip(static_cast<int>(length))) {
+    return false;
+  }
+  *view = std::string_view(base + offset, length);
+  return true;
+}
+
+bool ParseMessage(const char* data, size_t size, RecordMessageView* view) {
+  CodedInputStream input(reinterpret_cast<const uint8_t*>(data),
+                         static_cast<int>(size));
+  while (true) {
+    uint32_t tag = input.ReadTag();
+    if (tag == 0) {
+      return input.ConsumedEntireMessage();
+    }
+    int field = WireFormatLite::GetTagFieldNumber(tag);
+    auto wire_type = WireFormatLite::GetTagWireType(tag);
+    bool ok = true;
+    if (field == kSingleMessageChannelName &&
+        wire_type == WireFormatLite::WIRETYPE_LENGTH_DELIMITED) {
+      ok = ReadBytesView(&input, data, &view->channel_name);
+    } else if (field == kSingleMessageContent &&
+               wire_type == WireFormatLite::WIRETYPE_LENGTH_DELIMITED) {
+      ok = ReadBytesView(&input, data, &view->content);
+    } else if (field == kSingleMessageTime &&
+               wire_type == WireFormatLite::WIRETYPE_VARINT) {
+      ok = input.ReadVarint64(&view->time);
+    } else {
+      ok = WireFormatLite::SkipField(&input, tag);
+    }
+    if (!ok) {
+      return false;
+    }
+  }
+}
+
+void WillNeed(const char* data, size_t size) {
+  static const uintptr_t page_size = getpagesize();
+  uintptr_t offset = reinterpret_cast<uintptr_t>(data) % page_size;
+  madvise(const_cast<char*>(data - offset), size + offset, MADV_WILLNEED);
+}
+
+}  // namespace
+
+RecordMmapReader::RecordMmapReader(const std::string& file) {
+  file_ = file;
+  if (!Map(file)) {
+    return;
+  }
+  if (!LoadIndex()) {
+    AERROR << "Failed to load index of record file: " << file;
+    Unmap();
+    return;
+  }
+  is_opened_ = true;
+}
+
+RecordMmapReader::~RecordMmapReader() { Unmap(); }
+
+bool RecordMmapReader::Map(const std::string& file) {
+  int fd = open(file.c_str(), O_RDONLY);
+  if (fd < 0) {
+    AERROR << "Open record file failed, file: " << file << ", errno: " << errno;
+    return false;
+  }
+  struct stat st;
+  if (fstat(fd, &st) < 0 ||
+      st.st_size < static_cast<off_t>(sizeof(Section) + HEADER_LENGTH)) {
+    AERROR << "Record file is too small, file: " << file;
+    close(fd);
+    return false;
+  }
+  void* addr = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (addr == MAP_FAILED) {
+    AERROR << "Mmap record file failed, file: " << file << ", errno: " << errno;
+    return false;
+  }
+  // chunks are picked through the index, read ahead would be wasted
+  madvise(addr, st.st_size, MADV_RANDOM);
+  data_ = reinterpret_cast<const char*>(addr);
+  size_ = static_cast<size_t>(st.st_size);
+  return true;
+}
+
+void RecordMmapReader::Unmap() {
+  if (data_ != nullptr) {
+    munmap(const_cast<char*>(data_), size_);
+    data_ = nullptr;
+    size_ = 0;
+  }
+  is_opened_ = false;
+}
+
+bool RecordMmapReader::ReadSection(uint64_t position, SectionType type,
+                                   const char** data, size_t* size) const {
+  if (position > size_ || size_ - position < sizeof(Section)) {
+    AERROR << "Section position out of file: " << position;
+    return false;
+  }
+  Section section;
+  memcpy(&section, data_ + position, sizeof(section));
+  if (section.type != type) {
+    AERROR << "Check section type failed, expect: " << type
+           << ", actual: " << section.type;
+    return false;
+  }
+  uint64_t begin = position + sizeof(Section);
+  if (section.size < 0 ||
+      static_cast<uint64_t>(section.size) > size_ - begin ||
+      section.size > std::numeric_limits<int>::max()) {
+    AERROR << "Section size out of file: " << section.size;
+    return false;
+  }
+  *data = data_ + begin;
+  *size = static_cast<size_t>(section.size);
+  return true;
+}
+
+bool RecordMmapReader::LoadIndex() {
+  const char* data = nullptr;
+  size_t size = 0;
+  if (!ReadSection(0, SectionType::SECTION_HEADER, &data, &size) ||
+      !header_.ParseFromArray(data, static_cast<int>(size))) {
+    AERROR << "Read header section failed.";
+    return false;
+  }
+  if (!header_.is_complete()) {
+    AERROR << "Record file is not complete.";
+    return false;
+  }
+
+  proto::Index index;
+  if (!ReadSection(header_.index_position(), SectionType::SECTION_INDEX, &data,
+                   &size) ||
+      !index.ParseFromArray(data, static_cast<int>(size))) {
+    AERROR << "Read index section failed.";
+    return false;
+  }
+
+  // every chunk header is followed by its body in the index
+  const proto::ChunkHeaderCache* chunk_header = nullptr;
+  for (const auto& single_index : index.indexes()) {
+    switch (single_index.type()) {
+      case SectionType::SECTION_CHANNEL:
+        if (single_index.has_channel_cache()) {
+          channel_info_[single_index.channel_cache().name()] =
+              single_index.channel_cache();
+        }
+        break;
+      case SectionType::SECTION_CHUNK_HEADER:
+        chunk_header = single_index.has_chunk_header_cache()
+                           ? &single_index.chunk_header_cache()
+                           : nullptr;
+        break;
+      case SectionType::SECTION_CHUNK_BODY:
+        if (chunk_header == nullptr) {
+          AWARN << "Chunk body without header at " << single_index.position();
+          break;
+        }
+        chunks_.push_back({chunk_header->begin_time(),
+                           chunk_header->end_time(), single_index.position()});
+        chunk_header = nullptr;
+        break;
+      default:
+        break;
+    }
+  }
+  return true;
+}
+
+uint64_t RecordMmapReader::ReadMessages(const MessageVisitor& visitor,
+                                        uint64_t begin_time, uint64_t end_time,
+                                        const std::set<std::string>& channels) {
+  if (!IsValid() || begin_time > end_time) {
+    return 0;
+  }
+  if (!channels.empty() &&
+      std::none_of(channels.begin(), channels.end(),
+                   [this](const std::string& channel) {
+                     return channel_info_.count(channel) > 0;
+                   })) {
+    return 0;
+  }
+
+  uint64_t count = 0;
+  bool compressed = header_.compress() != CompressType::COMPRESS_NONE;
+  for (const auto& chunk : chunks_) {
+    if (chunk.end_time < begin_time || chunk.begin_time > end_time) {
+      continue;
+    }
+    const char* data = nullptr;
+    size_t size = 0;
+    if (!ReadSection(chunk.body_position, SectionType::SECTION_CHUNK_BODY,
+                     &data, &size)) {
+      continue;
+    }
+    WillNeed(data, size);
+    if (compressed) {
+      if (!ChunkCodec::Decode(data, size, &chunk_buffer_)) {
+        AERROR << "Decode chunk at " << chunk.body_position << " failed.";
+        continue;
+      }
+      data = chunk_buffer_.data();
+      size = chunk_buffer_.size();
+    }
+    if (size > static_cast<size_t>(std::numeric_limits<int>::max())) {
+      AERROR << "Chunk at " << chunk.body_position << " is too large.";
+      continue;
+    }
+
+    CodedInputStream input(reinterpret_cast<const uint8_t*>(data),
+                           static_cast<int>(size));
+    for (uint32_t tag = input.ReadTag(); tag != 0; tag = input.ReadTag()) {
+      if (WireFormatLite::GetTagFieldNumber(tag) != kChunkBodyMessages ||
+          WireFormatLite::GetTagWireType(tag) !=
+              WireFormatLite::WIRETYPE_LENGTH_DELIMITED) {
+        if (!WireFormatLite::SkipField(&input, tag)) {
+          break;
+        }
+        continue;
+      }
+      std::string_view bytes;
+      RecordMessageView view;
+      if (!ReadBytesView(&input, data, &bytes) ||
+          !ParseMessage(bytes.data(), bytes.size(), &view)) {
+        AERROR << "Broken message in chunk at " << chunk.body_position;
+        break;
+      }
+      if (view.time < begin_time || view.time > end_time) {
+        continue;
+      }
+      if (!channels.empty() &&
+          channels.count(std::string(view.channel_name)) == 0) {
+        continue;
+      }
+      ++count;
+      if (!visitor(view)) {
+        return count;
+      }
+    }
+  }
+  return count;
+}
+
+uint64_t RecordMmapReader::GetMessageNumber(
+    const std::string& channel_name) const {
+  auto search = channel_info_.find(channel_name);
+  if (search == channel_info_.end()) {
+    return 0;
+  }
+  return search->second.message_number();
+}
+
+const std::string& RecordMmapReader::GetMessageType(
+    const std::string& channel_name) const {
+  auto search = channel_info_.find(channel_name);
+  if (search == channel_info_.end()) {
+    return kEmptyString;
+  }
+  return search->second.message_type();
+}
+
+const std::string& RecordMmapReader::GetProtoDesc(
+    const std::string& channel_name) const {
+  auto search = channel_info_.find(channel_name);
+  if (search == channel_info_.end()) {
+    return kEmptyString;
+  }
+  return search->second.proto_desc();
+}
+
+std::set<std::string> RecordMmapReader::GetChannelList() const {
+  std::set<std::string> channel_list;
+  for (auto& item : channel_info_) {
+    channel_list.insert(item.first);
+  }
+  return channel_list;
+}
+
+}  // namespace record
+}  // namespace cyber
+}  // namespace apollo
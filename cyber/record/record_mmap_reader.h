@@ -0,0 +1,131 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#ifndef CYBER_RECORD_RECORD_MMAP_READER_H_
+#define CYBER_RECORD_RECORD_MMAP_READER_H_
+
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <set>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "cyber/proto/record.pb.h"
+
+#include "cyber/record/record_base.h"
+
+namespace apollo {
+namespace cyber {
+namespace record {
+
+/**
+ * @brief A message of a mapped record. Both views point into the mapped
+ * file, or into the chunk buffer of a compressed record.
+ */
+struct RecordMessageView {
+  std::string_view channel_name;
+  std::string_view content;
+  uint64_t time = 0;
+};
+
+/**
+ * @brief Record reader for extracting time ranges. The file is mapped and
+ * the index section is used to touch only the chunks that overlap the
+ * requested window, messages are handed out as views without being copied
+ * or parsed into protobufs. Only complete records (with an index) can be
+ * opened, use RecordReader for the others.
+ */
+class RecordMmapReader : public RecordBase {
+ public:
+  using ChannelInfoMap = std::unordered_map<std::string, proto::ChannelCache>;
+  /**
+   * @brief Called for every selected message, return false to stop.
+   */
+  using MessageVisitor = std::function<bool(const RecordMessageView&)>;
+
+  /**
+   * @brief The constructor with record file path as parameter.
+   *
+   * @param file
+   */
+  explicit RecordMmapReader(const std::string& file);
+
+  /**
+   * @brief The destructor, unmaps the file.
+   */
+  virtual ~RecordMmapReader();
+
+  /**
+   * @brief Is this record reader is valid.
+   *
+   * @return True for valid, false for not.
+   */
+  bool IsValid() const { return data_ != nullptr; }
+
+  /**
+   * @brief Visit the messages of `channels` whose time lies in
+   * [begin_time, end_time], in file order. An empty channel set selects all
+   * channels. Views into an uncompressed record stay valid as long as the
+   * reader lives, for compressed records only during the visitor call.
+   *
+   * @param visitor
+   * @param begin_time
+   * @param end_time
+   * @param channels
+   *
+   * @return Number of messages visited.
+   */
+  uint64_t ReadMessages(
+      const MessageVisitor& visitor, uint64_t begin_time = 0,
+      uint64_t end_time = std::numeric_limits<uint64_t>::max(),
+      const std::set<std::string>& channels = std::set<std::string>());
+
+  uint64_t GetMessageNumber(const std::string& channel_name) const override;
+  const std::string& GetMessageType(
+      const std::string& channel_name) const override;
+  const std::string& GetProtoDesc(
+      const std::string& channel_name) const override;
+  std::set<std::string> GetChannelList() const override;
+
+ private:
+  struct ChunkInfo {
+    uint64_t begin_time;
+    uint64_t end_time;
+    uint64_t body_position;
+  };
+
+  bool Map(const std::string& file);
+  void Unmap();
+  bool ReadSection(uint64_t position, proto::SectionType type,
+                   const char** data, size_t* size) const;
+  bool LoadIndex();
+
+  const char* data_ = nullptr;
+  size_t size_ = 0;
+  std::vector<ChunkInfo> chunks_;
+  ChannelInfoMap channel_info_;
+  std::string chunk_buffer_;
+};
+
+}  // namespace record
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_RECORD_RECORD_MMAP_READER_H_
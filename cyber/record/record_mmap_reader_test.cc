@@ -0,0 +1,135 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "cyber/record/record_mmap_reader.h"
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "cyber/record/file/record_file_writer.h"
+#include "cyber/record/header_builder.h"
+
+namespace apollo {
+namespace cyber {
+namespace record {
+
+constexpr char kChannelName1[] = "/test/channel1";
+constexpr char kChannelName2[] = "/test/channel2";
+constexpr char kMessageType1[] = "apollo.cyber.proto.Test";
+constexpr char kProtoDesc[] = "1234567890";
+constexpr char kTestFile[] = "record_mmap_reader_test.record";
+constexpr uint64_t kMessageNum = 32;
+
+// messages alternate between the channels, a chunk spans four of them
+void WriteTestFile(proto::CompressType compress) {
+  RecordFileWriter writer;
+  ASSERT_TRUE(writer.Open(kTestFile));
+  proto::Header header = HeaderBuilder::GetHeaderWithChunkParams(3, 0);
+  header.set_segment_interval(0);
+  header.set_segment_raw_size(0);
+  header.set_compress(compress);
+  ASSERT_TRUE(writer.WriteHeader(header));
+  for (auto name : {kChannelName1, kChannelName2}) {
+    proto::Channel channel;
+    channel.set_name(name);
+    channel.set_message_type(kMessageType1);
+    channel.set_proto_desc(kProtoDesc);
+    ASSERT_TRUE(writer.WriteChannel(channel));
+  }
+  for (uint64_t i = 0; i < kMessageNum; ++i) {
+    proto::SingleMessage message;
+    message.set_channel_name(i % 2 == 0 ? kChannelName1 : kChannelName2);
+    message.set_content(std::to_string(i));
+    message.set_time(i);
+    ASSERT_TRUE(writer.WriteMessage(message));
+    // give the asynchronous chunk flush time to finish
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  }
+  writer.Close();
+}
+
+TEST(RecordMmapReaderTest, ReadRange) {
+  WriteTestFile(proto::CompressType::COMPRESS_NONE);
+  RecordMmapReader reader(kTestFile);
+  ASSERT_TRUE(reader.IsValid());
+  ASSERT_EQ(2, reader.GetChannelList().size());
+  ASSERT_EQ(kMessageNum / 2, reader.GetMessageNumber(kChannelName1));
+  ASSERT_EQ(kMessageType1, reader.GetMessageType(kChannelName2));
+  ASSERT_EQ(kProtoDesc, reader.GetProtoDesc(kChannelName1));
+  ASSERT_EQ("", reader.GetMessageType("/test/none"));
+
+  std::vector<uint64_t> times;
+  auto collect = [&times](const RecordMessageView& view) {
+    EXPECT_EQ(std::to_string(view.time), view.content);
+    times.push_back(view.time);
+    return true;
+  };
+  ASSERT_EQ(kMessageNum, reader.ReadMessages(collect));
+  for (uint64_t i = 0; i < kMessageNum; ++i) {
+    ASSERT_EQ(i, times[i]);
+  }
+
+  times.clear();
+  ASSERT_EQ(11, reader.ReadMessages(collect, 10, 20));
+  ASSERT_EQ(10, times.front());
+  ASSERT_EQ(20, times.back());
+
+  times.clear();
+  ASSERT_EQ(5, reader.ReadMessages(collect, 10, 20, {kChannelName2}));
+  for (auto time : times) {
+    ASSERT_EQ(1, time % 2);
+  }
+
+  ASSERT_EQ(0, reader.ReadMessages(collect, 0, kMessageNum, {"/test/none"}));
+  ASSERT_EQ(0, reader.ReadMessages(collect, kMessageNum, kMessageNum * 2));
+
+  // the visitor stops the iteration
+  uint64_t visited = reader.ReadMessages(
+      [](const RecordMessageView& view) { return view.time < 5; });
+  ASSERT_EQ(6, visited);
+  ASSERT_FALSE(remove(kTestFile));
+}
+
+TEST(RecordMmapReaderTest, ReadCompressed) {
+  WriteTestFile(proto::CompressType::COMPRESS_LZ4);
+  RecordMmapReader reader(kTestFile);
+  ASSERT_TRUE(reader.IsValid());
+  uint64_t count = reader.ReadMessages(
+      [](const RecordMessageView& view) {
+        EXPECT_EQ(kChannelName1, view.channel_name);
+        EXPECT_EQ(std::to_string(view.time), view.content);
+        return true;
+      },
+      8, 23, {kChannelName1});
+  ASSERT_EQ(8, count);
+  ASSERT_FALSE(remove(kTestFile));
+}
+
+TEST(RecordMmapReaderTest, InvalidFile) {
+  RecordMmapReader reader("record_mmap_reader_test.none");
+  ASSERT_FALSE(reader.IsValid());
+  ASSERT_EQ(0, reader.ReadMessages(
+                   [](const RecordMessageView& view) { return true; }));
+}
+
+}  // namespace record
+}  // namespace cyber
+}  // namespace apollo
@@ -83,8 +83,8 @@ bool RecordReader::ReadMessage(RecordMessage* message, uint64_t begin_time,
   }
 
   while (message_index_ < chunk_->messages_size()) {
-    const auto& next_message = chunk_->messages(message_index_);
-    uint64_t time = next_message.time();
+    auto* next_message = chunk_->mutable_messages(message_index_);
+    uint64_t time = next_message->time();
     if (time > end_time) {
       return false;
     }
@@ -93,8 +93,9 @@ bool RecordReader::ReadMessage(RecordMessage* message, uint64_t begin_time,
       continue;
     }
 
-    message->channel_name = next_message.channel_name();
-    message->content = next_message.content();
+    message->channel_name = next_message->channel_name();
+    // a message of the chunk is read once, its content is handed over
+    message->content.swap(*next_message->mutable_content());
     message->time = time;
     return true;
   }
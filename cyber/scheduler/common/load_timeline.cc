@@ -0,0 +1,68 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/scheduler/common/load_timeline.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace apollo {
+namespace cyber {
+namespace scheduler {
+
+constexpr uint64_t LoadTimeline::kSlotNs;
+constexpr size_t LoadTimeline::kSlots;
+constexpr uint64_t LoadTimeline::kWindowNs;
+
+bool LoadTimeline::Enabled() {
+  static const bool enabled = [] {
+    const char* value = std::getenv("CYBER_SCHED_LOAD_TIMELINE");
+    return value != nullptr && std::atoi(value) != 0;
+  }();
+  return enabled;
+}
+
+void LoadTimeline::Record(uint64_t start_ns, uint64_t end_ns) {
+  if (end_ns <= start_ns) {
+    return;
+  }
+  // a run longer than the window covers every slot alike
+  if (end_ns - start_ns > kWindowNs) {
+    uint64_t rounds = (end_ns - start_ns) / kWindowNs;
+    for (auto& slot : busy_ns_) {
+      slot.fetch_add(rounds * kSlotNs, std::memory_order_relaxed);
+    }
+    start_ns += rounds * kWindowNs;
+  }
+  while (start_ns < end_ns) {
+    uint64_t slot = start_ns / kSlotNs;
+    uint64_t until = std::min(end_ns, (slot + 1) * kSlotNs);
+    busy_ns_[slot % kSlots].fetch_add(until - start_ns,
+                                      std::memory_order_relaxed);
+    start_ns = until;
+  }
+}
+
+void LoadTimeline::Collect(std::vector<uint64_t>* busy_ns) const {
+  busy_ns->resize(kSlots);
+  for (size_t i = 0; i < kSlots; ++i) {
+    (*busy_ns)[i] = busy_ns_[i].load(std::memory_order_relaxed);
+  }
+}
+
+}  // namespace scheduler
+}  // namespace cyber
+}  // namespace apollo
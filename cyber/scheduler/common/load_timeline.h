@@ -0,0 +1,64 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_SCHEDULER_COMMON_LOAD_TIMELINE_H_
+#define CYBER_SCHEDULER_COMMON_LOAD_TIMELINE_H_
+
+#include <sys/types.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace apollo {
+namespace cyber {
+namespace scheduler {
+
+/**
+ * @brief Busy time of one processor folded onto a one second window of the
+ * monotonic clock, in slots as long as a timer tick. Timers phased by the
+ * TimerPhaseAllocator fire at fixed slots of that window, so aligned timer
+ * bursts show up as peaks. Kept when CYBER_SCHED_LOAD_TIMELINE=1.
+ */
+class LoadTimeline {
+ public:
+  static constexpr uint64_t kSlotNs = 2000000;
+  static constexpr size_t kSlots = 500;
+  static constexpr uint64_t kWindowNs = kSlotNs * kSlots;
+
+  static bool Enabled();
+
+  // called by the owning processor only
+  void Record(uint64_t start_ns, uint64_t end_ns);
+
+  // busy nanoseconds per slot since the processor started
+  void Collect(std::vector<uint64_t>* busy_ns) const;
+
+ private:
+  std::atomic<uint64_t> busy_ns_[kSlots] = {};
+};
+
+struct ProcessorLoad {
+  pid_t processor_id = 0;
+  std::vector<uint64_t> busy_ns;
+};
+
+}  // namespace scheduler
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_SCHEDULER_COMMON_LOAD_TIMELINE_H_
@@ -0,0 +1,60 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/scheduler/common/load_timeline.h"
+
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace cyber {
+namespace scheduler {
+
+TEST(LoadTimelineTest, Record) {
+  std::unique_ptr<LoadTimeline> timeline(new LoadTimeline());
+  const uint64_t slot = LoadTimeline::kSlotNs;
+  const uint64_t window = LoadTimeline::kWindowNs;
+  std::vector<uint64_t> busy;
+  timeline->Collect(&busy);
+  ASSERT_EQ(LoadTimeline::kSlots, busy.size());
+  for (auto ns : busy) {
+    EXPECT_EQ(0, ns);
+  }
+
+  // inside slot 3 of two different windows
+  timeline->Record(3 * slot + 100, 3 * slot + 600);
+  timeline->Record(7 * window + 3 * slot, 7 * window + 3 * slot + 1000);
+  // across the end of the window into slot 0
+  timeline->Record(2 * window - 500, 2 * window + 200);
+  timeline->Collect(&busy);
+  EXPECT_EQ(1500, busy[3]);
+  EXPECT_EQ(500, busy[LoadTimeline::kSlots - 1]);
+  EXPECT_EQ(200, busy[0]);
+  EXPECT_EQ(0, busy[1]);
+
+  // longer than a window
+  timeline->Record(5 * slot, 5 * slot + window + slot);
+  timeline->Collect(&busy);
+  EXPECT_EQ(2 * slot, busy[5]);
+  EXPECT_EQ(slot + 200, busy[0]);
+  EXPECT_EQ(slot, busy[6]);
+}
+
+}  // namespace scheduler
+}  // namespace cyber
+}  // namespace apollo
@@ -0,0 +1,74 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/scheduler/common/routine_statistics.h"
+
+#include <map>
+#include <sstream>
+
+namespace apollo {
+namespace cyber {
+namespace scheduler {
+
+namespace {
+
+void AppendHistogram(const base::AtomicHistogram& histogram,
+                     std::ostringstream* oss) {
+  *oss << histogram.Count() << "/" << histogram.Percentile(50) / 1000 << "/"
+       << histogram.Percentile(99) / 1000 << "/" << histogram.Max() / 1000;
+}
+
+}  // namespace
+
+RoutineStatistics::RoutineStatistics() {}
+
+std::shared_ptr<RoutineStat> RoutineStatistics::GetStat(
+    const std::string& name) {
+  std::lock_guard<std::mutex> lk(mutex_);
+  auto& stat = stats_[name];
+  if (stat == nullptr) {
+    stat = std::make_shared<RoutineStat>();
+  }
+  return stat;
+}
+
+void RoutineStatistics::GetStats(
+    std::unordered_map<std::string, std::shared_ptr<RoutineStat>>* stats) {
+  std::lock_guard<std::mutex> lk(mutex_);
+  *stats = stats_;
+}
+
+std::string RoutineStatistics::Report() {
+  std::map<std::string, std::shared_ptr<RoutineStat>> sorted;
+  {
+    std::lock_guard<std::mutex> lk(mutex_);
+    sorted.insert(stats_.begin(), stats_.end());
+  }
+
+  std::ostringstream oss;
+  oss << "routine wait(count/p50/p99/max us) exec(count/p50/p99/max us)";
+  for (auto& item : sorted) {
+    oss << "\n" << item.first << " ";
+    AppendHistogram(item.second->wait_time, &oss);
+    oss << " ";
+    AppendHistogram(item.second->exec_time, &oss);
+  }
+  return oss.str();
+}
+
+}  // namespace scheduler
+}  // namespace cyber
+}  // namespace apollo
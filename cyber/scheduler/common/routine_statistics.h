@@ -0,0 +1,65 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_SCHEDULER_COMMON_ROUTINE_STATISTICS_H_
+#define CYBER_SCHEDULER_COMMON_ROUTINE_STATISTICS_H_
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "cyber/base/atomic_histogram.h"
+#include "cyber/common/macros.h"
+
+namespace apollo {
+namespace cyber {
+namespace scheduler {
+
+/**
+ * @brief Timing of one routine, in nanoseconds. wait_time is the delay from
+ * the first notification of the routine to the Resume() it triggered,
+ * exec_time is the on-cpu time of every Resume().
+ */
+struct RoutineStat {
+  base::AtomicHistogram wait_time;
+  base::AtomicHistogram exec_time;
+};
+
+class RoutineStatistics {
+ public:
+  std::shared_ptr<RoutineStat> GetStat(const std::string& name);
+  void GetStats(
+      std::unordered_map<std::string, std::shared_ptr<RoutineStat>>* stats);
+
+  /**
+   * @brief One line per routine with count, p50, p99 and max of both
+   * histograms in microseconds.
+   */
+  std::string Report();
+
+ private:
+  std::mutex mutex_;
+  std::unordered_map<std::string, std::shared_ptr<RoutineStat>> stats_;
+
+  DECLARE_SINGLETON(RoutineStatistics);
+};
+
+}  // namespace scheduler
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_SCHEDULER_COMMON_ROUTINE_STATISTICS_H_
@@ -33,11 +33,23 @@ alignas(CACHELINE_SIZE) GRP_WQ_CV ClassicContext::cv_wq_;
 alignas(CACHELINE_SIZE) RQ_LOCK_GROUP ClassicContext::rq_locks_;
 alignas(CACHELINE_SIZE) CR_GROUP ClassicContext::cr_group_;
 alignas(CACHELINE_SIZE) NOTIFY_GRP ClassicContext::notify_grp_;
+alignas(CACHELINE_SIZE) ISOLATED_GRP ClassicContext::isolated_grp_;
+alignas(CACHELINE_SIZE) IDLE_POLLS ClassicContext::idle_polls_;
+alignas(CACHELINE_SIZE) AtomicRWLock ClassicContext::idle_polls_lock_;
+
+namespace {
+// pauses between two scans of an isolated processor with nothing to do
+constexpr int kSpinRelaxNum = 64;
+}  // namespace
 
 ClassicContext::ClassicContext() { InitGroup(DEFAULT_GROUP_NAME); }
 
-ClassicContext::ClassicContext(const std::string& group_name) {
+ClassicContext::ClassicContext(const std::string& group_name, bool isolated)
+    : isolated_(isolated) {
   InitGroup(group_name);
+  if (isolated_) {
+    isolated_grp_.insert(group_name);
+  }
 }
 
 void ClassicContext::InitGroup(const std::string& group_name) {
@@ -73,6 +85,11 @@ std::shared_ptr<CRoutine> ClassicContext::NextRoutine() {
 }
 
 void ClassicContext::Wait() {
+  if (isolated_) {
+    Spin();
+    return;
+  }
+
   std::unique_lock<std::mutex> lk(mtx_wrapper_->Mutex());
   cw_->Cv().wait_for(lk, std::chrono::milliseconds(1000),
                      [&]() { return notify_grp_[current_grp] > 0; });
@@ -81,6 +98,23 @@ void ClassicContext::Wait() {
   }
 }
 
+void ClassicContext::Spin() {
+  bool busy = false;
+  {
+    ReadLockGuard<AtomicRWLock> lk(idle_polls_lock_);
+    for (auto& poll : idle_polls_) {
+      if (poll()) {
+        busy = true;
+      }
+    }
+  }
+  if (!busy) {
+    for (int i = 0; i < kSpinRelaxNum; ++i) {
+      cpu_relax();
+    }
+  }
+}
+
 void ClassicContext::Shutdown() {
   stop_.store(true);
   mtx_wrapper_->Mutex().lock();
@@ -90,6 +124,11 @@ void ClassicContext::Shutdown() {
 }
 
 void ClassicContext::Notify(const std::string& group_name) {
+  // isolated processors never sleep, they find the croutine by themselves
+  if (cyber_unlikely(!isolated_grp_.empty()) &&
+      isolated_grp_.count(group_name) != 0) {
+    return;
+  }
   (&mtx_wq_[group_name])->Mutex().lock();
   notify_grp_[group_name]++;
   (&mtx_wq_[group_name])->Mutex().unlock();
@@ -118,6 +157,11 @@ bool ClassicContext::RemoveCRoutine(const std::shared_ptr<CRoutine>& cr) {
   return false;
 }
 
+void ClassicContext::AddIdlePoll(const std::function<bool()>& poll) {
+  WriteLockGuard<AtomicRWLock> lk(idle_polls_lock_);
+  idle_polls_.emplace_back(poll);
+}
+
 }  // namespace scheduler
 }  // namespace cyber
 }  // namespace apollo
@@ -23,6 +23,7 @@
 #include <mutex>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "cyber/base/atomic_rw_lock.h"
@@ -48,11 +49,18 @@ using RQ_LOCK_GROUP = std::unordered_map<std::string, LOCK_QUEUE>;
 using GRP_WQ_MUTEX = std::unordered_map<std::string, MutexWrapper>;
 using GRP_WQ_CV = std::unordered_map<std::string, CvWrapper>;
 using NOTIFY_GRP = std::unordered_map<std::string, int>;
+using ISOLATED_GRP = std::unordered_set<std::string>;
+using IDLE_POLLS = std::vector<std::function<bool()>>;
 
 class ClassicContext : public ProcessorContext {
  public:
   ClassicContext();
-  explicit ClassicContext(const std::string &group_name);
+  /**
+   * @param isolated the processor of an isolated context never sleeps, it
+   * spins on its own CPU and runs the idle polls between croutines
+   */
+  explicit ClassicContext(const std::string &group_name,
+                          bool isolated = false);
 
   std::shared_ptr<CRoutine> NextRoutine() override;
   void Wait() override;
@@ -60,15 +68,26 @@ class ClassicContext : public ProcessorContext {
 
   static void Notify(const std::string &group_name);
   static bool RemoveCRoutine(const std::shared_ptr<CRoutine> &cr);
+  /**
+   * @brief `poll` is called by the processors of isolated contexts when
+   * they find nothing to run, it returns whether it did any work.
+   */
+  static void AddIdlePoll(const std::function<bool()> &poll);
 
   alignas(CACHELINE_SIZE) static CR_GROUP cr_group_;
   alignas(CACHELINE_SIZE) static RQ_LOCK_GROUP rq_locks_;
   alignas(CACHELINE_SIZE) static GRP_WQ_CV cv_wq_;
   alignas(CACHELINE_SIZE) static GRP_WQ_MUTEX mtx_wq_;
   alignas(CACHELINE_SIZE) static NOTIFY_GRP notify_grp_;
+  alignas(CACHELINE_SIZE) static ISOLATED_GRP isolated_grp_;
+  alignas(CACHELINE_SIZE) static IDLE_POLLS idle_polls_;
+  alignas(CACHELINE_SIZE) static base::AtomicRWLock idle_polls_lock_;
 
  private:
   void InitGroup(const std::string &group_name);
+  void Spin();
+
+  bool isolated_ = false;
 
   std::chrono::steady_clock::time_point wake_time_;
   bool need_sleep_ = false;
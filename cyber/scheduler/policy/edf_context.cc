@@ -0,0 +1,215 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/scheduler/policy/edf_context.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "cyber/base/macros.h"
+
+namespace apollo {
+namespace cyber {
+namespace scheduler {
+
+using apollo::cyber::croutine::RoutineState;
+
+constexpr std::chrono::milliseconds EdfRunQueue::kDefaultDeadline;
+
+void EdfRunQueue::SetDeadline(uint64_t crid,
+                              const std::chrono::nanoseconds& deadline) {
+  std::lock_guard<std::mutex> lk(mtx_);
+  if (deadline.count() > 0) {
+    relative_[crid] = deadline;
+  } else {
+    relative_.erase(crid);
+  }
+}
+
+void EdfRunQueue::Push(const std::shared_ptr<CRoutine>& cr,
+                       const Clock::time_point& release) {
+  {
+    std::lock_guard<std::mutex> lk(mtx_);
+    auto rel = relative_.find(cr->id());
+    auto deadline =
+        release + (rel != relative_.end()
+                       ? rel->second
+                       : std::chrono::nanoseconds(kDefaultDeadline));
+    auto itr = pending_.find(cr->id());
+    if (itr != pending_.end() && itr->second <= deadline) {
+      return;
+    }
+    pending_[cr->id()] = deadline;
+    heap_.emplace_back(Entry{deadline, seq_++, cr});
+    std::push_heap(heap_.begin(), heap_.end(), Later());
+    notify_++;
+  }
+  cv_.notify_one();
+}
+
+bool EdfRunQueue::Pop(std::shared_ptr<CRoutine>* cr,
+                      Clock::time_point* deadline) {
+  std::lock_guard<std::mutex> lk(mtx_);
+  while (!heap_.empty()) {
+    std::pop_heap(heap_.begin(), heap_.end(), Later());
+    auto entry = std::move(heap_.back());
+    heap_.pop_back();
+
+    // skip entries superseded by an earlier deadline or removed croutines
+    auto itr = pending_.find(entry.cr->id());
+    if (itr == pending_.end() || itr->second != entry.deadline) {
+      continue;
+    }
+    pending_.erase(itr);
+
+    // a croutine running elsewhere is pushed again by its runner if needed
+    if (!entry.cr->Acquire()) {
+      continue;
+    }
+    if (entry.cr->UpdateState() == RoutineState::READY) {
+      *cr = entry.cr;
+      *deadline = entry.deadline;
+      return true;
+    }
+    entry.cr->Release();
+  }
+  return false;
+}
+
+void EdfRunQueue::Remove(uint64_t crid) {
+  std::lock_guard<std::mutex> lk(mtx_);
+  pending_.erase(crid);
+  relative_.erase(crid);
+}
+
+void EdfRunQueue::OnFinished(const std::shared_ptr<CRoutine>& cr,
+                             const Clock::time_point& deadline) {
+  if (Clock::now() <= deadline) {
+    return;
+  }
+  std::lock_guard<std::mutex> lk(mtx_);
+  if (relative_.find(cr->id()) != relative_.end()) {
+    misses_[cr->name()]++;
+  }
+}
+
+uint64_t EdfRunQueue::DeadlineMisses(const std::string& name) {
+  std::lock_guard<std::mutex> lk(mtx_);
+  auto itr = misses_.find(name);
+  return itr != misses_.end() ? itr->second : 0;
+}
+
+void EdfRunQueue::GetDeadlineMisses(
+    std::unordered_map<std::string, uint64_t>* misses) {
+  std::lock_guard<std::mutex> lk(mtx_);
+  for (auto& miss : misses_) {
+    (*misses)[miss.first] += miss.second;
+  }
+}
+
+void EdfRunQueue::Wait(const std::chrono::microseconds& timeout,
+                       const std::atomic<bool>& stop) {
+  std::unique_lock<std::mutex> lk(mtx_);
+  cv_.wait_for(lk, timeout, [&]() { return notify_ > 0 || stop.load(); });
+  if (notify_ > 0) {
+    notify_--;
+  }
+}
+
+void EdfRunQueue::Shutdown() {
+  {
+    std::lock_guard<std::mutex> lk(mtx_);
+    notify_ = std::numeric_limits<unsigned char>::max();
+  }
+  cv_.notify_all();
+}
+
+std::shared_ptr<CRoutine> EdfContext::NextRoutine() {
+  if (cyber_unlikely(stop_.load())) {
+    return nullptr;
+  }
+
+  CheckLast();
+  WakeSleeping();
+
+  std::shared_ptr<CRoutine> cr = nullptr;
+  if (rq_->Pop(&cr, &last_deadline_)) {
+    last_ = cr;
+    return cr;
+  }
+  return nullptr;
+}
+
+void EdfContext::CheckLast() {
+  if (last_ == nullptr) {
+    return;
+  }
+  auto cr = last_;
+  last_ = nullptr;
+  rq_->OnFinished(cr, last_deadline_);
+
+  if (!cr->Acquire()) {
+    return;
+  }
+  auto state = cr->UpdateState();
+  cr->Release();
+  if (state == RoutineState::READY) {
+    rq_->Push(cr, EdfRunQueue::Clock::now());
+  } else if (state == RoutineState::SLEEP) {
+    sleeping_.emplace_back(cr);
+  }
+}
+
+void EdfContext::WakeSleeping() {
+  for (auto it = sleeping_.begin(); it != sleeping_.end();) {
+    auto cr = *it;
+    if (!cr->Acquire()) {
+      it = sleeping_.erase(it);
+      continue;
+    }
+    auto state = cr->UpdateState();
+    cr->Release();
+    if (state == RoutineState::SLEEP) {
+      ++it;
+      continue;
+    }
+    if (state == RoutineState::READY) {
+      rq_->Push(cr, cr->wake_time());
+    }
+    it = sleeping_.erase(it);
+  }
+}
+
+void EdfContext::Wait() {
+  auto timeout = std::chrono::microseconds(1000 * 1000);
+  auto now = std::chrono::steady_clock::now();
+  for (auto& cr : sleeping_) {
+    auto remaining = std::chrono::duration_cast<std::chrono::microseconds>(
+        cr->wake_time() - now);
+    timeout =
+        std::max(std::chrono::microseconds(0), std::min(timeout, remaining));
+  }
+  rq_->Wait(timeout, stop_);
+}
+
+void EdfContext::Shutdown() {
+  stop_.store(true);
+  rq_->Shutdown();
+}
+
+}  // namespace scheduler
+}  // namespace cyber
+}  // namespace apollo
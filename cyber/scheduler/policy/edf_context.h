@@ -0,0 +1,122 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_SCHEDULER_POLICY_EDF_CONTEXT_H_
+#define CYBER_SCHEDULER_POLICY_EDF_CONTEXT_H_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "cyber/croutine/croutine.h"
+#include "cyber/scheduler/processor_context.h"
+
+namespace apollo {
+namespace cyber {
+namespace scheduler {
+
+using croutine::CRoutine;
+
+/**
+ * @class EdfRunQueue
+ * @brief Ready croutines of one group ordered by absolute deadline. A
+ * croutine is released with deadline `release time + relative deadline`; if
+ * it is released again before it runs, the earlier deadline is kept.
+ * Croutines without a declared deadline get kDefaultDeadline and are not
+ * counted as misses.
+ */
+class EdfRunQueue {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  static constexpr std::chrono::milliseconds kDefaultDeadline{1000};
+
+  void SetDeadline(uint64_t crid, const std::chrono::nanoseconds& deadline);
+  void Push(const std::shared_ptr<CRoutine>& cr,
+            const Clock::time_point& release);
+  bool Pop(std::shared_ptr<CRoutine>* cr, Clock::time_point* deadline);
+  void Remove(uint64_t crid);
+
+  void OnFinished(const std::shared_ptr<CRoutine>& cr,
+                  const Clock::time_point& deadline);
+  uint64_t DeadlineMisses(const std::string& name);
+  void GetDeadlineMisses(std::unordered_map<std::string, uint64_t>* misses);
+
+  void Wait(const std::chrono::microseconds& timeout,
+            const std::atomic<bool>& stop);
+  void Shutdown();
+
+ private:
+  struct Entry {
+    Clock::time_point deadline;
+    uint64_t seq;
+    std::shared_ptr<CRoutine> cr;
+  };
+  struct Later {
+    bool operator()(const Entry& lhs, const Entry& rhs) const {
+      if (lhs.deadline != rhs.deadline) {
+        return lhs.deadline > rhs.deadline;
+      }
+      return lhs.seq > rhs.seq;
+    }
+  };
+
+  std::mutex mtx_;
+  std::condition_variable cv_;
+  int notify_ = 0;
+  uint64_t seq_ = 0;
+  std::vector<Entry> heap_;
+  // deadline of the pending job of every croutine in heap_
+  std::unordered_map<uint64_t, Clock::time_point> pending_;
+  std::unordered_map<uint64_t, std::chrono::nanoseconds> relative_;
+  std::unordered_map<std::string, uint64_t> misses_;
+};
+
+/**
+ * @class EdfContext
+ * @brief Runs the ready croutine of its group with the earliest deadline.
+ */
+class EdfContext : public ProcessorContext {
+ public:
+  explicit EdfContext(const std::shared_ptr<EdfRunQueue>& rq) : rq_(rq) {}
+
+  std::shared_ptr<CRoutine> NextRoutine() override;
+  void Wait() override;
+  void Shutdown() override;
+
+ private:
+  void CheckLast();
+  void WakeSleeping();
+
+  std::shared_ptr<EdfRunQueue> rq_;
+
+  // only touched by the processor thread bound to this context
+  std::shared_ptr<CRoutine> last_ = nullptr;
+  EdfRunQueue::Clock::time_point last_deadline_;
+  std::vector<std::shared_ptr<CRoutine>> sleeping_;
+};
+
+}  // namespace scheduler
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_SCHEDULER_POLICY_EDF_CONTEXT_H_
@@ -25,6 +25,7 @@
 #include "cyber/scheduler/policy/choreography_context.h"
 #include "cyber/scheduler/policy/classic_context.h"
 #include "cyber/scheduler/processor.h"
+#include "cyber/time/time.h"
 
 namespace apollo {
 namespace cyber {
@@ -242,6 +243,7 @@ bool SchedulerChoreography::NotifyProcessor(uint64_t crid) {
     if (it != id_cr_.end()) {
       cr = it->second;
       pid = cr->processor_id();
+      cr->MarkNotified(Time::MonoTime().ToNanosecond());
       if (cr->state() == RoutineState::DATA_WAIT ||
           cr->state() == RoutineState::IO_WAIT) {
         cr->SetUpdateFlag();
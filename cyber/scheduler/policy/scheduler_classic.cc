@@ -17,13 +17,16 @@
 #include "cyber/scheduler/policy/scheduler_classic.h"
 
 #include <algorithm>
+#include <cstdlib>
 #include <memory>
+#include <sstream>
 #include <utility>
 
 #include "cyber/common/environment.h"
 #include "cyber/common/file.h"
 #include "cyber/scheduler/policy/classic_context.h"
 #include "cyber/scheduler/processor.h"
+#include "cyber/time/time.h"
 
 namespace apollo {
 namespace cyber {
@@ -38,7 +41,28 @@ using apollo::cyber::common::PathExists;
 using apollo::cyber::common::WorkRoot;
 using apollo::cyber::croutine::RoutineState;
 
-SchedulerClassic::SchedulerClassic() {
+namespace {
+
+// comma separated names of the groups whose processors busy poll
+std::unordered_set<std::string> IsolatedGroups() {
+  std::unordered_set<std::string> groups;
+  const char* value = std::getenv("CYBER_SCHED_ISOLATED_GROUPS");
+  if (value == nullptr) {
+    return groups;
+  }
+  std::stringstream ss(value);
+  std::string name;
+  while (std::getline(ss, name, ',')) {
+    if (!name.empty()) {
+      groups.insert(name);
+    }
+  }
+  return groups;
+}
+
+}  // namespace
+
+SchedulerClassic::SchedulerClassic() : isolated_groups_(IsolatedGroups()) {
   std::string conf("conf/");
   conf.append(GlobalData::Instance()->ProcessGroup()).append(".conf");
   auto cfg_file = GetAbsolutePath(WorkRoot(), conf);
@@ -95,8 +119,14 @@ void SchedulerClassic::CreateProcessor() {
     std::vector<int> cpuset;
     ParseCpuset(group.cpuset(), &cpuset);
 
+    bool isolated = isolated_groups_.count(group_name) != 0;
+    if (isolated && (cpuset.size() < proc_num || affinity != "1to1")) {
+      AWARN << "isolated group " << group_name
+            << " should pin each processor to a cpu of its own.";
+    }
+
     for (uint32_t i = 0; i < proc_num; i++) {
-      auto ctx = std::make_shared<ClassicContext>(group_name);
+      auto ctx = std::make_shared<ClassicContext>(group_name, isolated);
       pctxs_.emplace_back(ctx);
 
       auto proc = std::make_shared<Processor>();
@@ -169,6 +199,7 @@ bool SchedulerClassic::NotifyProcessor(uint64_t crid) {
     ReadLockGuard<AtomicRWLock> lk(id_cr_lock_);
     if (id_cr_.find(crid) != id_cr_.end()) {
       auto cr = id_cr_[crid];
+      cr->MarkNotified(Time::MonoTime().ToNanosecond());
       if (cr->state() == RoutineState::DATA_WAIT ||
           cr->state() == RoutineState::IO_WAIT) {
         cr->SetUpdateFlag();
@@ -181,6 +212,21 @@ bool SchedulerClassic::NotifyProcessor(uint64_t crid) {
   return false;
 }
 
+bool SchedulerClassic::AddIdlePoll(const std::function<bool()>& poll) {
+  bool polled = false;
+  for (auto& group : classic_conf_.groups()) {
+    if (isolated_groups_.count(group.name()) != 0 &&
+        group.processor_num() > 0) {
+      polled = true;
+      break;
+    }
+  }
+  if (polled) {
+    ClassicContext::AddIdlePoll(poll);
+  }
+  return polled;
+}
+
 bool SchedulerClassic::RemoveTask(const std::string& name) {
   if (cyber_unlikely(stop_)) {
     return true;
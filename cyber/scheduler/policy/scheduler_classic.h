@@ -17,9 +17,11 @@
 #ifndef CYBER_SCHEDULER_POLICY_SCHEDULER_CLASSIC_H_
 #define CYBER_SCHEDULER_POLICY_SCHEDULER_CLASSIC_H_
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "cyber/croutine/croutine.h"
@@ -39,6 +41,7 @@ class SchedulerClassic : public Scheduler {
   bool RemoveCRoutine(uint64_t crid) override;
   bool RemoveTask(const std::string& name) override;
   bool DispatchTask(const std::shared_ptr<CRoutine>&) override;
+  bool AddIdlePoll(const std::function<bool()>& poll) override;
 
  private:
   friend Scheduler* Instance();
@@ -50,6 +53,8 @@ class SchedulerClassic : public Scheduler {
   std::unordered_map<std::string, ClassicTask> cr_confs_;
 
   ClassicConf classic_conf_;
+  // groups whose processors busy poll, from CYBER_SCHED_ISOLATED_GROUPS
+  std::unordered_set<std::string> isolated_groups_;
 };
 
 }  // namespace scheduler
@@ -0,0 +1,278 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/scheduler/policy/scheduler_edf.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "cyber/common/environment.h"
+#include "cyber/common/file.h"
+#include "cyber/scheduler/policy/classic_context.h"
+#include "cyber/scheduler/processor.h"
+#include "cyber/time/time.h"
+
+namespace apollo {
+namespace cyber {
+namespace scheduler {
+
+using apollo::cyber::base::ReadLockGuard;
+using apollo::cyber::base::WriteLockGuard;
+using apollo::cyber::common::GetAbsolutePath;
+using apollo::cyber::common::GetProtoFromFile;
+using apollo::cyber::common::GlobalData;
+using apollo::cyber::common::PathExists;
+using apollo::cyber::common::WorkRoot;
+using apollo::cyber::croutine::RoutineState;
+
+SchedulerEdf::SchedulerEdf() {
+  std::string conf("conf/");
+  conf.append(GlobalData::Instance()->ProcessGroup()).append(".conf");
+  auto cfg_file = GetAbsolutePath(WorkRoot(), conf);
+
+  apollo::cyber::proto::CyberConfig cfg;
+  if (PathExists(cfg_file) && GetProtoFromFile(cfg_file, &cfg)) {
+    for (auto& thr : cfg.scheduler_conf().threads()) {
+      inner_thr_confs_[thr.name()] = thr;
+    }
+
+    if (cfg.scheduler_conf().has_process_level_cpuset()) {
+      process_level_cpuset_ = cfg.scheduler_conf().process_level_cpuset();
+      ProcessLevelResourceControl();
+    }
+
+    classic_conf_ = cfg.scheduler_conf().classic_conf();
+    for (auto& group : classic_conf_.groups()) {
+      auto& group_name = group.name();
+      for (auto task : group.tasks()) {
+        task.set_group_name(group_name);
+        cr_confs_[task.name()] = task;
+      }
+    }
+  } else {
+    uint32_t proc_num = 2;
+    auto& global_conf = GlobalData::Instance()->Config();
+    if (global_conf.has_scheduler_conf() &&
+        global_conf.scheduler_conf().has_default_proc_num()) {
+      proc_num = global_conf.scheduler_conf().default_proc_num();
+    }
+    task_pool_size_ = proc_num;
+
+    auto sched_group = classic_conf_.add_groups();
+    sched_group->set_name(DEFAULT_GROUP_NAME);
+    sched_group->set_processor_num(proc_num);
+  }
+
+  CreateProcessor();
+}
+
+void SchedulerEdf::CreateProcessor() {
+  for (auto& group : classic_conf_.groups()) {
+    auto& group_name = group.name();
+    auto proc_num = group.processor_num();
+    if (task_pool_size_ == 0) {
+      task_pool_size_ = proc_num;
+    }
+
+    auto& affinity = group.affinity();
+    auto& processor_policy = group.processor_policy();
+    auto processor_prio = group.processor_prio();
+    std::vector<int> cpuset;
+    ParseCpuset(group.cpuset(), &cpuset);
+
+    auto rq = std::make_shared<EdfRunQueue>();
+    rqs_[group_name] = rq;
+    for (uint32_t i = 0; i < proc_num; i++) {
+      auto ctx = std::make_shared<EdfContext>(rq);
+      pctxs_.emplace_back(ctx);
+
+      auto proc = std::make_shared<Processor>();
+      proc->BindContext(ctx);
+      SetSchedAffinity(proc->Thread(), cpuset, affinity, i);
+      SetSchedPolicy(proc->Thread(), processor_policy, processor_prio,
+                     proc->Tid());
+      processors_.emplace_back(proc);
+    }
+  }
+}
+
+std::shared_ptr<EdfRunQueue> SchedulerEdf::GroupQueue(
+    const std::string& group_name) {
+  auto itr = rqs_.find(group_name);
+  return itr != rqs_.end() ? itr->second : nullptr;
+}
+
+void SchedulerEdf::SetDeadline(const std::string& name,
+                               const std::chrono::nanoseconds& deadline) {
+  {
+    std::lock_guard<std::mutex> lk(deadline_mtx_);
+    deadlines_[name] = deadline;
+  }
+
+  auto crid = GlobalData::GenerateHashId(name);
+  ReadLockGuard<AtomicRWLock> lk(id_cr_lock_);
+  auto itr = id_cr_.find(crid);
+  if (itr != id_cr_.end()) {
+    auto rq = GroupQueue(itr->second->group_name());
+    if (rq != nullptr) {
+      rq->SetDeadline(crid, deadline);
+    }
+  }
+}
+
+uint64_t SchedulerEdf::DeadlineMisses(const std::string& name) {
+  uint64_t misses = 0;
+  for (auto& rq : rqs_) {
+    misses += rq.second->DeadlineMisses(name);
+  }
+  return misses;
+}
+
+void SchedulerEdf::GetDeadlineMisses(
+    std::unordered_map<std::string, uint64_t>* misses) {
+  for (auto& rq : rqs_) {
+    rq.second->GetDeadlineMisses(misses);
+  }
+}
+
+bool SchedulerEdf::DispatchTask(const std::shared_ptr<CRoutine>& cr) {
+  // we use multi-key mutex to prevent race condition
+  // when del && add cr with same crid
+  MutexWrapper* wrapper = nullptr;
+  if (!id_map_mutex_.Get(cr->id(), &wrapper)) {
+    {
+      std::lock_guard<std::mutex> wl_lg(cr_wl_mtx_);
+      if (!id_map_mutex_.Get(cr->id(), &wrapper)) {
+        wrapper = new MutexWrapper();
+        id_map_mutex_.Set(cr->id(), wrapper);
+      }
+    }
+  }
+  std::lock_guard<std::mutex> lg(wrapper->Mutex());
+
+  {
+    WriteLockGuard<AtomicRWLock> lk(id_cr_lock_);
+    if (id_cr_.find(cr->id()) != id_cr_.end()) {
+      return false;
+    }
+    id_cr_[cr->id()] = cr;
+  }
+
+  if (cr_confs_.find(cr->name()) != cr_confs_.end()) {
+    ClassicTask task = cr_confs_[cr->name()];
+    cr->set_priority(task.prio());
+    cr->set_group_name(task.group_name());
+  } else {
+    // croutine that not exist in conf
+    cr->set_group_name(classic_conf_.groups(0).name());
+  }
+
+  auto rq = GroupQueue(cr->group_name());
+  if (rq == nullptr) {
+    AERROR << "group " << cr->group_name() << " has no processor.";
+    WriteLockGuard<AtomicRWLock> lk(id_cr_lock_);
+    id_cr_.erase(cr->id());
+    return false;
+  }
+
+  {
+    std::lock_guard<std::mutex> lk(deadline_mtx_);
+    auto itr = deadlines_.find(cr->name());
+    if (itr != deadlines_.end()) {
+      rq->SetDeadline(cr->id(), itr->second);
+    }
+  }
+  rq->Push(cr, EdfRunQueue::Clock::now());
+  return true;
+}
+
+bool SchedulerEdf::NotifyProcessor(uint64_t crid) {
+  if (cyber_unlikely(stop_)) {
+    return true;
+  }
+
+  {
+    ReadLockGuard<AtomicRWLock> lk(id_cr_lock_);
+    if (id_cr_.find(crid) != id_cr_.end()) {
+      auto cr = id_cr_[crid];
+      cr->MarkNotified(Time::MonoTime().ToNanosecond());
+      if (cr->state() == RoutineState::DATA_WAIT ||
+          cr->state() == RoutineState::IO_WAIT) {
+        cr->SetUpdateFlag();
+      }
+
+      auto rq = GroupQueue(cr->group_name());
+      if (rq != nullptr) {
+        rq->Push(cr, EdfRunQueue::Clock::now());
+      }
+      return true;
+    }
+  }
+  return false;
+}
+
+bool SchedulerEdf::RemoveTask(const std::string& name) {
+  if (cyber_unlikely(stop_)) {
+    return true;
+  }
+
+  auto crid = GlobalData::GenerateHashId(name);
+  return RemoveCRoutine(crid);
+}
+
+bool SchedulerEdf::RemoveCRoutine(uint64_t crid) {
+  // we use multi-key mutex to prevent race condition
+  // when del && add cr with same crid
+  MutexWrapper* wrapper = nullptr;
+  if (!id_map_mutex_.Get(crid, &wrapper)) {
+    {
+      std::lock_guard<std::mutex> wl_lg(cr_wl_mtx_);
+      if (!id_map_mutex_.Get(crid, &wrapper)) {
+        wrapper = new MutexWrapper();
+        id_map_mutex_.Set(crid, wrapper);
+      }
+    }
+  }
+  std::lock_guard<std::mutex> lg(wrapper->Mutex());
+
+  std::shared_ptr<CRoutine> cr = nullptr;
+  {
+    WriteLockGuard<AtomicRWLock> lk(id_cr_lock_);
+    if (id_cr_.find(crid) != id_cr_.end()) {
+      cr = id_cr_[crid];
+      id_cr_[crid]->Stop();
+      id_cr_.erase(crid);
+    } else {
+      return false;
+    }
+  }
+
+  auto rq = GroupQueue(cr->group_name());
+  if (rq != nullptr) {
+    rq->Remove(crid);
+  }
+  while (!cr->Acquire()) {
+    std::this_thread::sleep_for(std::chrono::microseconds(1));
+    AINFO_EVERY(1000) << "waiting for task " << cr->name() << " completion";
+  }
+  cr->Release();
+  return true;
+}
+
+}  // namespace scheduler
+}  // namespace cyber
+}  // namespace apollo
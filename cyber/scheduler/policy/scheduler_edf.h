@@ -0,0 +1,79 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_SCHEDULER_POLICY_SCHEDULER_EDF_H_
+#define CYBER_SCHEDULER_POLICY_SCHEDULER_EDF_H_
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "cyber/croutine/croutine.h"
+#include "cyber/proto/classic_conf.pb.h"
+#include "cyber/scheduler/policy/edf_context.h"
+#include "cyber/scheduler/scheduler.h"
+
+namespace apollo {
+namespace cyber {
+namespace scheduler {
+
+using apollo::cyber::croutine::CRoutine;
+using apollo::cyber::proto::ClassicConf;
+using apollo::cyber::proto::ClassicTask;
+
+/**
+ * @class SchedulerEdf
+ * @brief Earliest deadline first. Processors and groups come from
+ * classic_conf; within a group the ready croutine whose deadline is nearest
+ * runs first. A task's relative deadline (usually the period of the channel
+ * it reads) is declared with SetDeadline(), a run that ends after its
+ * deadline is counted as a miss.
+ */
+class SchedulerEdf : public Scheduler {
+ public:
+  bool RemoveCRoutine(uint64_t crid) override;
+  bool RemoveTask(const std::string& name) override;
+  bool DispatchTask(const std::shared_ptr<CRoutine>&) override;
+
+  void SetDeadline(const std::string& name,
+                   const std::chrono::nanoseconds& deadline);
+  uint64_t DeadlineMisses(const std::string& name);
+  void GetDeadlineMisses(std::unordered_map<std::string, uint64_t>* misses);
+
+ private:
+  friend Scheduler* Instance();
+  SchedulerEdf();
+
+  void CreateProcessor();
+  bool NotifyProcessor(uint64_t crid) override;
+  std::shared_ptr<EdfRunQueue> GroupQueue(const std::string& group_name);
+
+  std::unordered_map<std::string, ClassicTask> cr_confs_;
+  std::unordered_map<std::string, std::shared_ptr<EdfRunQueue>> rqs_;
+
+  std::mutex deadline_mtx_;
+  std::unordered_map<std::string, std::chrono::nanoseconds> deadlines_;
+
+  ClassicConf classic_conf_;
+};
+
+}  // namespace scheduler
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_SCHEDULER_POLICY_SCHEDULER_EDF_H_
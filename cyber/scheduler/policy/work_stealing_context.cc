@@ -0,0 +1,226 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/scheduler/policy/work_stealing_context.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace apollo {
+namespace cyber {
+namespace scheduler {
+
+using apollo::cyber::base::AtomicRWLock;
+using apollo::cyber::base::ReadLockGuard;
+using apollo::cyber::base::WriteLockGuard;
+using apollo::cyber::croutine::RoutineState;
+
+WorkStealingContext::WorkStealingContext(
+    const std::shared_ptr<WorkStealingGroup>& group, uint32_t index)
+    : group_(group), index_(index) {
+  for (auto& rq : ready_rqs_) {
+    rq.Init(kReadyQueueSize);
+  }
+}
+
+std::shared_ptr<CRoutine> WorkStealingContext::NextRoutine() {
+  if (cyber_unlikely(stop_.load())) {
+    return nullptr;
+  }
+
+  RequeueLast();
+  WakeSleeping();
+
+  std::shared_ptr<CRoutine> cr = nullptr;
+  if (cyber_unlikely(overflow_.exchange(false))) {
+    cr = ScanOwned();
+    if (cr != nullptr) {
+      // there may be more routines whose wakeup did not fit in the queue
+      overflow_.store(true);
+      last_ = cr;
+      return cr;
+    }
+  }
+
+  const auto& contexts = group_->contexts;
+  const auto size = static_cast<uint32_t>(contexts.size());
+  for (int i = MAX_PRIO - 1; i >= 0; --i) {
+    if (TakeReady(&ready_rqs_[i], &cr)) {
+      last_ = cr;
+      return cr;
+    }
+    for (uint32_t j = 1; j < size; ++j) {
+      auto victim = contexts[(index_ + j) % size];
+      if (TakeReady(&victim->ready_rqs_[i], &cr)) {
+        last_ = cr;
+        return cr;
+      }
+    }
+  }
+  return nullptr;
+}
+
+bool WorkStealingContext::TakeReady(CR_READY_QUEUE* rq,
+                                    std::shared_ptr<CRoutine>* cr) {
+  std::shared_ptr<CRoutine> candidate = nullptr;
+  while (rq->Dequeue(&candidate)) {
+    // a routine running elsewhere is requeued by its runner if needed
+    if (!candidate->Acquire()) {
+      continue;
+    }
+    if (candidate->UpdateState() == RoutineState::READY) {
+      *cr = candidate;
+      return true;
+    }
+    candidate->Release();
+  }
+  return false;
+}
+
+void WorkStealingContext::RequeueLast() {
+  if (last_ == nullptr) {
+    return;
+  }
+  auto cr = last_;
+  last_ = nullptr;
+  if (!cr->Acquire()) {
+    return;
+  }
+  auto state = cr->UpdateState();
+  cr->Release();
+
+  if (state == RoutineState::READY) {
+    auto owner = group_->contexts[cr->processor_id()];
+    owner->MakeReady(cr);
+  } else if (state == RoutineState::SLEEP) {
+    sleeping_.emplace_back(cr);
+  }
+}
+
+void WorkStealingContext::WakeSleeping() {
+  for (auto it = sleeping_.begin(); it != sleeping_.end();) {
+    auto cr = *it;
+    if (!cr->Acquire()) {
+      it = sleeping_.erase(it);
+      continue;
+    }
+    auto state = cr->UpdateState();
+    cr->Release();
+    if (state == RoutineState::SLEEP) {
+      ++it;
+      continue;
+    }
+    if (state == RoutineState::READY) {
+      group_->contexts[cr->processor_id()]->MakeReady(cr);
+    }
+    it = sleeping_.erase(it);
+  }
+}
+
+std::shared_ptr<CRoutine> WorkStealingContext::ScanOwned() {
+  for (int i = MAX_PRIO - 1; i >= 0; --i) {
+    ReadLockGuard<AtomicRWLock> lk(owned_lock_);
+    for (auto& cr : owned_[i]) {
+      if (!cr->Acquire()) {
+        continue;
+      }
+      if (cr->UpdateState() == RoutineState::READY) {
+        return cr;
+      }
+      cr->Release();
+    }
+  }
+  return nullptr;
+}
+
+void WorkStealingContext::MakeReady(const std::shared_ptr<CRoutine>& cr) {
+  if (!ready_rqs_[cr->priority()].Enqueue(cr)) {
+    overflow_.store(true);
+  }
+  NotifyGroup();
+}
+
+void WorkStealingContext::NotifyGroup() {
+  {
+    std::lock_guard<std::mutex> lk(group_->mtx);
+    group_->notify++;
+  }
+  group_->cv.notify_one();
+}
+
+void WorkStealingContext::Wait() {
+  auto timeout = std::chrono::microseconds(1000 * 1000);
+  if (!sleeping_.empty()) {
+    auto now = std::chrono::steady_clock::now();
+    for (auto& cr : sleeping_) {
+      auto remaining = std::chrono::duration_cast<std::chrono::microseconds>(
+          cr->wake_time() - now);
+      timeout = std::max(std::chrono::microseconds(0),
+                         std::min(timeout, remaining));
+    }
+  }
+
+  std::unique_lock<std::mutex> lk(group_->mtx);
+  // siblings may consume the shutdown notifications, so also check stop_
+  group_->cv.wait_for(lk, timeout,
+                      [&]() { return group_->notify > 0 || stop_.load(); });
+  if (group_->notify > 0) {
+    group_->notify--;
+  }
+}
+
+void WorkStealingContext::Shutdown() {
+  stop_.store(true);
+  {
+    std::lock_guard<std::mutex> lk(group_->mtx);
+    group_->notify = std::numeric_limits<unsigned char>::max();
+  }
+  group_->cv.notify_all();
+}
+
+bool WorkStealingContext::Enqueue(const std::shared_ptr<CRoutine>& cr) {
+  {
+    WriteLockGuard<AtomicRWLock> lk(owned_lock_);
+    owned_[cr->priority()].emplace_back(cr);
+  }
+  MakeReady(cr);
+  return true;
+}
+
+bool WorkStealingContext::RemoveCRoutine(const std::shared_ptr<CRoutine>& cr) {
+  auto crid = cr->id();
+  WriteLockGuard<AtomicRWLock> lk(owned_lock_);
+  auto& croutines = owned_[cr->priority()];
+  for (auto it = croutines.begin(); it != croutines.end(); ++it) {
+    if ((*it)->id() == crid) {
+      auto owned = *it;
+      owned->Stop();
+      while (!owned->Acquire()) {
+        std::this_thread::sleep_for(std::chrono::microseconds(1));
+        AINFO_EVERY(1000) << "waiting for task " << owned->name()
+                          << " completion";
+      }
+      croutines.erase(it);
+      owned->Release();
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace scheduler
+}  // namespace cyber
+}  // namespace apollo
@@ -0,0 +1,106 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_SCHEDULER_POLICY_WORK_STEALING_CONTEXT_H_
+#define CYBER_SCHEDULER_POLICY_WORK_STEALING_CONTEXT_H_
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "cyber/base/atomic_rw_lock.h"
+#include "cyber/base/bounded_queue.h"
+#include "cyber/croutine/croutine.h"
+#include "cyber/scheduler/policy/classic_context.h"
+#include "cyber/scheduler/processor_context.h"
+
+namespace apollo {
+namespace cyber {
+namespace scheduler {
+
+class WorkStealingContext;
+
+using CR_READY_QUEUE = base::BoundedQueue<std::shared_ptr<CRoutine>>;
+using MULTI_PRIO_READY_QUEUE = std::array<CR_READY_QUEUE, MAX_PRIO>;
+
+/**
+ * @brief Processors of one group share a wait queue and steal ready routines
+ * from each other. The context list is filled by the scheduler before any
+ * processor is bound, and is read-only afterwards.
+ */
+struct WorkStealingGroup {
+  std::string name;
+  std::vector<WorkStealingContext *> contexts;
+  std::mutex mtx;
+  std::condition_variable cv;
+  int notify = 0;
+};
+
+/**
+ * @class WorkStealingContext
+ * @brief Each processor owns the routines dispatched to it and keeps the ready
+ * ones in lock-free per-priority queues. A processor runs the highest
+ * priority routine it can find, taking it from its own queue first and from
+ * the same priority queue of its siblings otherwise.
+ */
+class WorkStealingContext : public ProcessorContext {
+ public:
+  WorkStealingContext(const std::shared_ptr<WorkStealingGroup> &group,
+                      uint32_t index);
+
+  std::shared_ptr<CRoutine> NextRoutine() override;
+  void Wait() override;
+  void Shutdown() override;
+
+  bool Enqueue(const std::shared_ptr<CRoutine> &cr);
+  bool RemoveCRoutine(const std::shared_ptr<CRoutine> &cr);
+  void MakeReady(const std::shared_ptr<CRoutine> &cr);
+
+  uint32_t index() const { return index_; }
+
+  static constexpr uint64_t kReadyQueueSize = 256;
+
+ private:
+  bool TakeReady(CR_READY_QUEUE *rq, std::shared_ptr<CRoutine> *cr);
+  void RequeueLast();
+  void WakeSleeping();
+  std::shared_ptr<CRoutine> ScanOwned();
+  void NotifyGroup();
+
+  std::shared_ptr<WorkStealingGroup> group_;
+  uint32_t index_ = 0;
+
+  MULTI_PRIO_READY_QUEUE ready_rqs_;
+  // set when a ready queue was full, the owned routines are scanned then
+  std::atomic<bool> overflow_ = {false};
+
+  base::AtomicRWLock owned_lock_;
+  std::array<std::vector<std::shared_ptr<CRoutine>>, MAX_PRIO> owned_;
+
+  // only touched by the processor thread bound to this context
+  std::shared_ptr<CRoutine> last_ = nullptr;
+  std::vector<std::shared_ptr<CRoutine>> sleeping_;
+};
+
+}  // namespace scheduler
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_SCHEDULER_POLICY_WORK_STEALING_CONTEXT_H_
@@ -33,7 +33,12 @@ namespace scheduler {
 
 using apollo::cyber::common::GlobalData;
 
-Processor::Processor() { running_.store(true); }
+Processor::Processor() {
+  running_.store(true);
+  if (LoadTimeline::Enabled()) {
+    snap_shot_->load_timeline.reset(new LoadTimeline());
+  }
+}
 
 Processor::~Processor() { Stop(); }
 
@@ -48,7 +53,18 @@ void Processor::Run() {
       if (croutine) {
         snap_shot_->execute_start_time.store(cyber::Time::Now().ToNanosecond());
         snap_shot_->routine_name = croutine->name();
+        auto stat = GetRoutineStat(croutine);
+        auto start = cyber::Time::MonoTime().ToNanosecond();
+        auto notify_time = croutine->TakeNotifyTime();
+        if (notify_time != 0 && start > notify_time) {
+          stat->wait_time.Record(start - notify_time);
+        }
         croutine->Resume();
+        auto end = cyber::Time::MonoTime().ToNanosecond();
+        stat->exec_time.Record(end - start);
+        if (snap_shot_->load_timeline) {
+          snap_shot_->load_timeline->Record(start, end);
+        }
         croutine->Release();
       } else {
         snap_shot_->execute_start_time.store(0);
@@ -61,6 +77,14 @@ void Processor::Run() {
   }
 }
 
+RoutineStat* Processor::GetRoutineStat(const std::shared_ptr<CRoutine>& cr) {
+  auto& stat = routine_stats_[cr->id()];
+  if (cyber_unlikely(stat == nullptr)) {
+    stat = RoutineStatistics::Instance()->GetStat(cr->name());
+  }
+  return stat.get();
+}
+
 void Processor::Stop() {
   if (!running_.exchange(false)) {
     return;
@@ -23,11 +23,14 @@
 #include <mutex>
 #include <string>
 #include <thread>
+#include <unordered_map>
 #include <vector>
 
 #include "cyber/proto/scheduler_conf.pb.h"
 
 #include "cyber/croutine/croutine.h"
+#include "cyber/scheduler/common/load_timeline.h"
+#include "cyber/scheduler/common/routine_statistics.h"
 #include "cyber/scheduler/processor_context.h"
 
 namespace apollo {
@@ -40,6 +43,8 @@ struct Snapshot {
   std::atomic<uint64_t> execute_start_time = {0};
   std::atomic<pid_t> processor_id = {0};
   std::string routine_name;
+  // null unless LoadTimeline::Enabled()
+  std::unique_ptr<LoadTimeline> load_timeline;
 };
 
 class Processor {
@@ -56,6 +61,8 @@ class Processor {
   std::shared_ptr<Snapshot> ProcSnapshot() { return snap_shot_; }
 
  private:
+  RoutineStat* GetRoutineStat(const std::shared_ptr<CRoutine>& cr);
+
   std::shared_ptr<ProcessorContext> context_;
 
   std::condition_variable cv_ctx_;
@@ -67,6 +74,9 @@ class Processor {
   std::atomic<bool> running_{false};
 
   std::shared_ptr<Snapshot> snap_shot_ = std::make_shared<Snapshot>();
+
+  // only used by the processor thread, saves the by name lookup per resume
+  std::unordered_map<uint64_t, std::shared_ptr<RoutineStat>> routine_stats_;
 };
 
 }  // namespace scheduler
@@ -16,18 +16,22 @@
 #include "cyber/scheduler/processor.h"
 
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "gtest/gtest.h"
 
 #include "cyber/cyber.h"
 #include "cyber/scheduler/common/pin_thread.h"
+#include "cyber/scheduler/common/routine_statistics.h"
 #include "cyber/scheduler/policy/choreography_context.h"
 
 namespace apollo {
 namespace cyber {
 namespace scheduler {
 
+using apollo::cyber::common::GlobalData;
+using apollo::cyber::croutine::RoutineState;
 using scheduler::ChoreographyContext;
 using scheduler::Processor;
 
@@ -52,6 +56,39 @@ TEST(ProcessorTest, all) {
   proc1->Stop();
 }
 
+TEST(ProcessorTest, routine_stat) {
+  auto proc = std::make_shared<Processor>();
+  auto context = std::make_shared<ChoreographyContext>();
+  std::atomic<int> resumed = {0};
+  auto cr = std::make_shared<CRoutine>([&]() {
+    resumed++;
+    CRoutine::GetCurrentRoutine()->HangUp();
+    resumed++;
+  });
+  cr->set_id(GlobalData::RegisterTaskName("routine_stat"));
+  cr->set_name("routine_stat");
+  context->Enqueue(cr);
+  proc->BindContext(context);
+  for (int i = 0; i < 100 && cr->state() != RoutineState::DATA_WAIT; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  EXPECT_EQ(1, resumed.load());
+
+  cr->MarkNotified(Time::MonoTime().ToNanosecond());
+  cr->SetUpdateFlag();
+  context->Notify();
+  for (int i = 0; i < 100 && resumed.load() < 2; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  EXPECT_EQ(2, resumed.load());
+  proc->Stop();
+
+  auto stat = RoutineStatistics::Instance()->GetStat("routine_stat");
+  EXPECT_EQ(2, stat->exec_time.Count());
+  EXPECT_EQ(1, stat->wait_time.Count());
+  EXPECT_GT(stat->exec_time.Max(), 0);
+}
+
 }  // namespace scheduler
 }  // namespace cyber
 }  // namespace apollo
@@ -122,6 +122,19 @@ void Scheduler::CheckSchedStatus() {
   snap_info.clear();
 }
 
+void Scheduler::CollectLoad(std::vector<ProcessorLoad>* loads) {
+  loads->clear();
+  for (auto processor : processors_) {
+    auto snap = processor->ProcSnapshot();
+    if (snap->load_timeline == nullptr) {
+      continue;
+    }
+    loads->emplace_back();
+    loads->back().processor_id = snap->processor_id.load();
+    snap->load_timeline->Collect(&loads->back().busy_ns);
+  }
+}
+
 void Scheduler::Shutdown() {
   if (cyber_unlikely(stop_.exchange(true))) {
     return;
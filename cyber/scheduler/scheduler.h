@@ -20,6 +20,7 @@
 #include <unistd.h>
 
 #include <atomic>
+#include <functional>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -37,6 +38,7 @@
 #include "cyber/common/types.h"
 #include "cyber/croutine/croutine.h"
 #include "cyber/croutine/routine_factory.h"
+#include "cyber/scheduler/common/load_timeline.h"
 #include "cyber/scheduler/common/mutex_wrapper.h"
 #include "cyber/scheduler/common/pin_thread.h"
 
@@ -79,6 +81,23 @@ class Scheduler {
 
   void CheckSchedStatus();
 
+  /**
+   * @brief The LoadTimeline of every processor, empty unless
+   * CYBER_SCHED_LOAD_TIMELINE is set.
+   */
+  void CollectLoad(std::vector<ProcessorLoad>* loads);
+
+  /**
+   * @brief Hand `poll` to the processors that never sleep, to run when they
+   * have nothing else to do. It returns whether it did any work.
+   *
+   * @return false if no processor runs it, the caller then has to wait for
+   * its events by itself
+   */
+  virtual bool AddIdlePoll(const std::function<bool()>& poll) {
+    return false;
+  }
+
   void SetInnerThreadConfs(
       const std::unordered_map<std::string, InnerThread>& confs) {
     inner_thr_confs_ = confs;
@@ -0,0 +1,106 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+// Microbenchmarks of the dispatch latency of the scheduler: the round trip of
+// one task from Async() until its future is ready, and of a batch of tasks
+// fanned out together. The scheduler is created once per process, so the
+// policy is the one of conf/<process_group>.conf, and every policy is run as
+// its own process. For results to keep across releases, write them as json:
+//
+//   scheduler_benchmark [process_group] --benchmark_out_format=json
+//       --benchmark_out=scheduler_<process_group>.json
+
+#include <future>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "cyber/common/global_data.h"
+#include "cyber/init.h"
+#include "cyber/scheduler/policy/scheduler_choreography.h"
+#include "cyber/scheduler/policy/scheduler_classic.h"
+#include "cyber/scheduler/policy/scheduler_edf.h"
+#include "cyber/scheduler/policy/scheduler_work_stealing.h"
+#include "cyber/scheduler/scheduler_factory.h"
+#include "cyber/task/task.h"
+
+namespace apollo {
+namespace cyber {
+namespace scheduler {
+
+namespace {
+
+std::string PolicyName() {
+  auto sched = Instance();
+  if (dynamic_cast<SchedulerChoreography*>(sched) != nullptr) {
+    return "choreography";
+  }
+  if (dynamic_cast<SchedulerWorkStealing*>(sched) != nullptr) {
+    return "work_stealing";
+  }
+  if (dynamic_cast<SchedulerEdf*>(sched) != nullptr) {
+    return "edf";
+  }
+  if (dynamic_cast<SchedulerClassic*>(sched) != nullptr) {
+    return "classic";
+  }
+  return "unknown";
+}
+
+}  // namespace
+
+void BM_AsyncRoundTrip(benchmark::State& state) {
+  state.SetLabel(PolicyName());
+  for (auto _ : state) {
+    Async([]() {}).get();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_AsyncRoundTrip)->UseRealTime();
+
+void BM_AsyncFanOut(benchmark::State& state) {
+  state.SetLabel(PolicyName());
+  std::vector<std::future<void>> futures;
+  futures.reserve(state.range(0));
+  for (auto _ : state) {
+    for (int64_t i = 0; i < state.range(0); ++i) {
+      futures.emplace_back(Async([]() {}));
+    }
+    for (auto& future : futures) {
+      future.get();
+    }
+    futures.clear();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_AsyncFanOut)->RangeMultiplier(4)->Range(4, 256)->UseRealTime();
+
+}  // namespace scheduler
+}  // namespace cyber
+}  // namespace apollo
+
+int main(int argc, char** argv) {
+  benchmark::Initialize(&argc, argv);
+  // what is left after the benchmark flags is the process group
+  if (argc > 1) {
+    apollo::cyber::common::GlobalData::Instance()->SetProcessGroup(argv[1]);
+  }
+  apollo::cyber::Init(argv[0]);
+  benchmark::RunSpecifiedBenchmarks();
+  apollo::cyber::Clear();
+  return 0;
+}
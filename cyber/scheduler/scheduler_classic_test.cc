@@ -60,6 +60,25 @@ TEST(SchedulerClassicTest, classic) {
   processor->Stop();
 }
 
+TEST(SchedulerClassicTest, isolated) {
+  static std::atomic<int> polls(0);
+  ClassicContext::AddIdlePoll([]() {
+    polls++;
+    return false;
+  });
+  auto ctx = std::make_shared<ClassicContext>("isolated_group", true);
+  // never waits for a notify, runs the idle polls instead
+  auto start = std::chrono::steady_clock::now();
+  ctx->Wait();
+  EXPECT_LT(std::chrono::steady_clock::now() - start,
+            std::chrono::milliseconds(100));
+  EXPECT_EQ(1, polls.load());
+
+  ClassicContext::Notify("isolated_group");
+  EXPECT_EQ(0, ClassicContext::notify_grp_["isolated_group"]);
+  ctx->Shutdown();
+}
+
 TEST(SchedulerClassicTest, sched_classic) {
   // read example_sched_classic.conf
   GlobalData::Instance()->SetProcessGroup("example_sched_classic");
@@ -0,0 +1,139 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/scheduler/policy/edf_context.h"
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "cyber/init.h"
+#include "cyber/scheduler/processor.h"
+
+namespace apollo {
+namespace cyber {
+namespace scheduler {
+
+namespace {
+
+std::shared_ptr<CRoutine> MakeRoutine(const croutine::RoutineFunc& func,
+                                      const std::string& name) {
+  auto cr = std::make_shared<CRoutine>(func);
+  cr->set_id(std::hash<std::string>()(name));
+  cr->set_name(name);
+  return cr;
+}
+
+}  // namespace
+
+TEST(SchedulerEdfTest, earliest_deadline_first) {
+  auto rq = std::make_shared<EdfRunQueue>();
+  std::mutex mtx;
+  std::vector<std::string> order;
+  auto record = [&](const std::string& name) {
+    return [&, name]() {
+      std::lock_guard<std::mutex> lk(mtx);
+      order.emplace_back(name);
+    };
+  };
+
+  auto logging = MakeRoutine(record("logging"), "logging");
+  auto prediction = MakeRoutine(record("prediction"), "prediction");
+  auto planning = MakeRoutine(record("planning"), "planning");
+  rq->SetDeadline(prediction->id(), std::chrono::milliseconds(100));
+  rq->SetDeadline(planning->id(), std::chrono::milliseconds(200));
+
+  // planning was released earlier, so its deadline is the nearest
+  auto now = EdfRunQueue::Clock::now();
+  rq->Push(logging, now);
+  rq->Push(prediction, now);
+  rq->Push(planning, now - std::chrono::milliseconds(150));
+  // a second release keeps the pending (earlier) deadline
+  rq->Push(prediction, now + std::chrono::milliseconds(500));
+
+  auto ctx = std::make_shared<EdfContext>(rq);
+  auto proc = std::make_shared<Processor>();
+  proc->BindContext(ctx);
+  for (int i = 0; i < 200; ++i) {
+    {
+      std::lock_guard<std::mutex> lk(mtx);
+      if (order.size() >= 3) {
+        break;
+      }
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  proc->Stop();
+
+  std::lock_guard<std::mutex> lk(mtx);
+  ASSERT_EQ(3, order.size());
+  EXPECT_EQ("planning", order[0]);
+  EXPECT_EQ("prediction", order[1]);
+  EXPECT_EQ("logging", order[2]);
+}
+
+TEST(SchedulerEdfTest, deadline_miss) {
+  auto rq = std::make_shared<EdfRunQueue>();
+  std::atomic<int> finished = {0};
+  auto slow = [&]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    finished++;
+  };
+
+  auto bounded = MakeRoutine(slow, "bounded");
+  auto unbounded = MakeRoutine(slow, "unbounded");
+  rq->SetDeadline(bounded->id(), std::chrono::milliseconds(1));
+  auto now = EdfRunQueue::Clock::now();
+  rq->Push(bounded, now);
+  rq->Push(unbounded, now - EdfRunQueue::kDefaultDeadline);
+
+  auto ctx = std::make_shared<EdfContext>(rq);
+  auto proc = std::make_shared<Processor>();
+  proc->BindContext(ctx);
+  for (int i = 0; i < 200 && finished.load() < 2; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  // the miss is recorded once the processor looks for the next routine
+  for (int i = 0; i < 200 && rq->DeadlineMisses("bounded") == 0; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  proc->Stop();
+
+  EXPECT_EQ(2, finished.load());
+  EXPECT_EQ(1, rq->DeadlineMisses("bounded"));
+  EXPECT_EQ(0, rq->DeadlineMisses("unbounded"));
+
+  std::unordered_map<std::string, uint64_t> misses;
+  rq->GetDeadlineMisses(&misses);
+  EXPECT_EQ(1, misses.size());
+  EXPECT_EQ(1, misses["bounded"]);
+}
+
+}  // namespace scheduler
+}  // namespace cyber
+}  // namespace apollo
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  apollo::cyber::Init(argv[0]);
+  auto res = RUN_ALL_TESTS();
+  apollo::cyber::Clear();
+  return res;
+}
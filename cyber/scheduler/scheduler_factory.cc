@@ -29,6 +29,8 @@
 #include "cyber/common/util.h"
 #include "cyber/scheduler/policy/scheduler_choreography.h"
 #include "cyber/scheduler/policy/scheduler_classic.h"
+#include "cyber/scheduler/policy/scheduler_edf.h"
+#include "cyber/scheduler/policy/scheduler_work_stealing.h"
 #include "cyber/scheduler/scheduler.h"
 
 namespace apollo {
@@ -66,6 +68,10 @@ Scheduler* Instance() {
         obj = new SchedulerClassic();
       } else if (!policy.compare("choreography")) {
         obj = new SchedulerChoreography();
+      } else if (!policy.compare("work_stealing")) {
+        obj = new SchedulerWorkStealing();
+      } else if (!policy.compare("edf")) {
+        obj = new SchedulerEdf();
       } else {
         AWARN << "Invalid scheduler policy: " << policy;
         obj = new SchedulerClassic();
@@ -0,0 +1,167 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/scheduler/policy/work_stealing_context.h"
+
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "cyber/init.h"
+#include "cyber/scheduler/processor.h"
+
+namespace apollo {
+namespace cyber {
+namespace scheduler {
+
+namespace {
+
+struct Group {
+  std::shared_ptr<WorkStealingGroup> group;
+  std::vector<std::shared_ptr<WorkStealingContext>> ctxs;
+  std::vector<std::shared_ptr<Processor>> procs;
+};
+
+Group MakeGroup(uint32_t proc_num) {
+  Group g;
+  g.group = std::make_shared<WorkStealingGroup>();
+  g.group->name = "work_stealing_test";
+  for (uint32_t i = 0; i < proc_num; ++i) {
+    auto ctx = std::make_shared<WorkStealingContext>(g.group, i);
+    g.group->contexts.emplace_back(ctx.get());
+    g.ctxs.emplace_back(ctx);
+  }
+  for (auto& ctx : g.ctxs) {
+    auto proc = std::make_shared<Processor>();
+    proc->BindContext(ctx);
+    g.procs.emplace_back(proc);
+  }
+  return g;
+}
+
+void StopGroup(Group* g) {
+  for (auto& proc : g->procs) {
+    proc->Stop();
+  }
+}
+
+std::shared_ptr<CRoutine> MakeRoutine(const croutine::RoutineFunc& func,
+                                      uint64_t id, uint32_t prio) {
+  auto cr = std::make_shared<CRoutine>(func);
+  cr->set_id(id);
+  cr->set_name("cr_" + std::to_string(id));
+  cr->set_priority(prio);
+  cr->set_processor_id(0);
+  return cr;
+}
+
+}  // namespace
+
+TEST(SchedulerWorkStealingTest, steal) {
+  auto g = MakeGroup(2);
+  std::mutex mtx;
+  std::set<std::thread::id> runners;
+  std::atomic<int> finished = {0};
+
+  // every routine is owned by processor 0, so processor 1 only runs what it
+  // steals
+  std::vector<std::shared_ptr<CRoutine>> crs;
+  for (uint64_t i = 0; i < 16; ++i) {
+    crs.emplace_back(MakeRoutine(
+        [&]() {
+          {
+            std::lock_guard<std::mutex> lk(mtx);
+            runners.insert(std::this_thread::get_id());
+          }
+          std::this_thread::sleep_for(std::chrono::milliseconds(5));
+          finished++;
+        },
+        i, 0));
+    EXPECT_TRUE(g.ctxs[0]->Enqueue(crs.back()));
+  }
+
+  for (int i = 0; i < 200 && finished.load() < 16; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  EXPECT_EQ(16, finished.load());
+  {
+    std::lock_guard<std::mutex> lk(mtx);
+    EXPECT_EQ(2, runners.size());
+  }
+
+  for (auto& cr : crs) {
+    EXPECT_TRUE(g.ctxs[0]->RemoveCRoutine(cr));
+  }
+  EXPECT_FALSE(g.ctxs[0]->RemoveCRoutine(crs[0]));
+  StopGroup(&g);
+}
+
+TEST(SchedulerWorkStealingTest, sleep_and_notify) {
+  auto g = MakeGroup(2);
+  std::atomic<int> wakeups = {0};
+
+  auto sleeper = MakeRoutine(
+      [&]() {
+        for (int i = 0; i < 5; ++i) {
+          CRoutine::GetCurrentRoutine()->Sleep(std::chrono::milliseconds(2));
+          wakeups++;
+        }
+      },
+      100, 1);
+  auto waiter = MakeRoutine(
+      [&]() {
+        CRoutine::GetCurrentRoutine()->HangUp();
+        wakeups++;
+      },
+      101, MAX_PRIO - 1);
+  EXPECT_TRUE(g.ctxs[0]->Enqueue(sleeper));
+  EXPECT_TRUE(g.ctxs[0]->Enqueue(waiter));
+
+  for (int i = 0; i < 200 && wakeups.load() < 5; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  EXPECT_EQ(5, wakeups.load());
+
+  while (waiter->state() != croutine::RoutineState::DATA_WAIT) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  waiter->SetUpdateFlag();
+  g.ctxs[0]->MakeReady(waiter);
+  for (int i = 0; i < 200 && wakeups.load() < 6; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  EXPECT_EQ(6, wakeups.load());
+
+  EXPECT_TRUE(g.ctxs[0]->RemoveCRoutine(sleeper));
+  EXPECT_TRUE(g.ctxs[0]->RemoveCRoutine(waiter));
+  StopGroup(&g);
+}
+
+}  // namespace scheduler
+}  // namespace cyber
+}  // namespace apollo
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  apollo::cyber::Init(argv[0]);
+  auto res = RUN_ALL_TESTS();
+  apollo::cyber::Clear();
+  return res;
+}
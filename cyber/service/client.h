@@ -25,6 +25,7 @@
 #include <tuple>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "cyber/common/log.h"
 #include "cyber/common/types.h"
@@ -123,6 +124,36 @@ class Client : public ClientBase {
    */
   SharedFuture AsyncSendRequest(SharedRequest request, CallbackType&& cb);
 
+  /**
+   * @brief Send Request object asynchronously and invoke `cb` after we get
+   * response
+   */
+  SharedFuture AsyncSendRequest(const Request& request, CallbackType&& cb);
+
+  /**
+   * @brief Send all the requests without waiting for the responses in
+   * between, they are matched to the requests by sequence number
+   *
+   * @param requests Request shared ptrs
+   * @return std::vector<SharedFuture> the futures in the order of `requests`
+   */
+  std::vector<SharedFuture> AsyncSendRequests(
+      const std::vector<SharedRequest>& requests);
+
+  /**
+   * @brief Request the Service with all the requests at once, pipelined
+   * instead of one round trip after the other
+   *
+   * @param requests Request shared ptrs
+   * @param timeout_s timeout of the whole batch, the responses not received
+   * by then are empty
+   * @return std::vector<SharedResponse> the responses in the order of
+   * `requests`
+   */
+  std::vector<SharedResponse> SendRequests(
+      const std::vector<SharedRequest>& requests,
+      const std::chrono::seconds& timeout_s = std::chrono::seconds(5));
+
   /**
    * @brief Is the Service is ready?
    */
@@ -152,6 +183,12 @@ class Client : public ClientBase {
   void HandleResponse(const std::shared_ptr<Response>& response,
                       const transport::MessageInfo& request_info);
 
+  SharedFuture AsyncSendRequest(SharedRequest request, CallbackType&& cb,
+                                uint64_t* sequence_number);
+
+  // forget a request which timed out, a late response is dropped then
+  void CancelRequest(uint64_t sequence_number);
+
   bool IsInit(void) const { return response_receiver_ != nullptr; }
 
   std::string node_name_;
@@ -227,7 +264,9 @@ Client<Request, Response>::SendRequest(SharedRequest request,
   if (!IsInit()) {
     return nullptr;
   }
-  auto future = AsyncSendRequest(request);
+  uint64_t sequence_number = 0;
+  auto future =
+      AsyncSendRequest(request, [](SharedFuture) {}, &sequence_number);
   if (!future.valid()) {
     return nullptr;
   }
@@ -235,6 +274,7 @@ Client<Request, Response>::SendRequest(SharedRequest request,
   if (status == std::future_status::ready) {
     return future.get();
   } else {
+    CancelRequest(sequence_number);
     return nullptr;
   }
 }
@@ -267,21 +307,89 @@ template <typename Request, typename Response>
 typename Client<Request, Response>::SharedFuture
 Client<Request, Response>::AsyncSendRequest(SharedRequest request,
                                             CallbackType&& cb) {
+  uint64_t sequence_number = 0;
+  return AsyncSendRequest(request, std::forward<CallbackType>(cb),
+                          &sequence_number);
+}
+
+template <typename Request, typename Response>
+typename Client<Request, Response>::SharedFuture
+Client<Request, Response>::AsyncSendRequest(const Request& request,
+                                            CallbackType&& cb) {
+  auto request_ptr = std::make_shared<Request>(request);
+  return AsyncSendRequest(request_ptr, std::forward<CallbackType>(cb));
+}
+
+template <typename Request, typename Response>
+typename Client<Request, Response>::SharedFuture
+Client<Request, Response>::AsyncSendRequest(SharedRequest request,
+                                            CallbackType&& cb,
+                                            uint64_t* sequence_number) {
   if (IsInit()) {
+    SharedPromise call_promise = std::make_shared<Promise>();
+    SharedFuture f(call_promise->get_future());
     std::lock_guard<std::mutex> lock(pending_requests_mutex_);
     sequence_number_++;
     transport::MessageInfo info(writer_id_, sequence_number_, writer_id_);
-    request_transmitter_->Transmit(request, info);
-    SharedPromise call_promise = std::make_shared<Promise>();
-    SharedFuture f(call_promise->get_future());
+    // registered before sending, the response may come back at once
     pending_requests_[info.seq_num()] =
         std::make_tuple(call_promise, std::forward<CallbackType>(cb), f);
+    request_transmitter_->Transmit(request, info);
+    *sequence_number = info.seq_num();
     return f;
   } else {
     return std::shared_future<std::shared_ptr<Response>>();
   }
 }
 
+template <typename Request, typename Response>
+std::vector<typename Client<Request, Response>::SharedFuture>
+Client<Request, Response>::AsyncSendRequests(
+    const std::vector<SharedRequest>& requests) {
+  std::vector<SharedFuture> futures;
+  futures.reserve(requests.size());
+  for (const auto& request : requests) {
+    futures.emplace_back(AsyncSendRequest(request));
+  }
+  return futures;
+}
+
+template <typename Request, typename Response>
+std::vector<typename Client<Request, Response>::SharedResponse>
+Client<Request, Response>::SendRequests(
+    const std::vector<SharedRequest>& requests,
+    const std::chrono::seconds& timeout_s) {
+  std::vector<SharedResponse> responses(requests.size());
+  if (!IsInit()) {
+    return responses;
+  }
+  std::vector<uint64_t> sequence_numbers(requests.size(), 0);
+  std::vector<SharedFuture> futures;
+  futures.reserve(requests.size());
+  for (size_t i = 0; i < requests.size(); ++i) {
+    futures.emplace_back(AsyncSendRequest(
+        requests[i], [](SharedFuture) {}, &sequence_numbers[i]));
+  }
+  auto deadline = std::chrono::steady_clock::now() + timeout_s;
+  for (size_t i = 0; i < futures.size(); ++i) {
+    if (!futures[i].valid()) {
+      continue;
+    }
+    if (futures[i].wait_until(deadline) == std::future_status::ready) {
+      responses[i] = futures[i].get();
+    } else {
+      CancelRequest(sequence_numbers[i]);
+    }
+  }
+  return responses;
+}
+
+template <typename Request, typename Response>
+void Client<Request, Response>::CancelRequest(uint64_t sequence_number) {
+  std::lock_guard<std::mutex> lock(pending_requests_mutex_);
+  pending_requests_.erase(sequence_number);
+}
+
 template <typename Request, typename Response>
 bool Client<Request, Response>::ServiceIsReady() const {
   return true;
@@ -292,21 +400,22 @@ void Client<Request, Response>::HandleResponse(
     const std::shared_ptr<Response>& response,
     const transport::MessageInfo& request_header) {
   ADEBUG << "client recv response.";
-  std::lock_guard<std::mutex> lock(pending_requests_mutex_);
   if (request_header.spare_id() != writer_id_) {
     return;
   }
-  uint64_t sequence_number = request_header.seq_num();
-  if (this->pending_requests_.count(sequence_number) == 0) {
-    return;
+  std::tuple<SharedPromise, CallbackType, SharedFuture> tuple;
+  {
+    std::lock_guard<std::mutex> lock(pending_requests_mutex_);
+    auto iter = this->pending_requests_.find(request_header.seq_num());
+    if (iter == this->pending_requests_.end()) {
+      return;
+    }
+    tuple = std::move(iter->second);
+    this->pending_requests_.erase(iter);
   }
-  auto tuple = this->pending_requests_[sequence_number];
-  auto call_promise = std::get<0>(tuple);
-  auto callback = std::get<1>(tuple);
-  auto future = std::get<2>(tuple);
-  this->pending_requests_.erase(sequence_number);
-  call_promise->set_value(response);
-  callback(future);
+  // out of the lock, so that the callback may send the next request
+  std::get<0>(tuple)->set_value(response);
+  std::get<1>(tuple)(std::get<2>(tuple));
 }
 
 }  // namespace cyber
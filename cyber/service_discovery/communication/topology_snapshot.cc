@@ -0,0 +1,292 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "cyber/service_discovery/communication/topology_snapshot.h"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace cyber {
+namespace service_discovery {
+
+namespace {
+
+// layout: magic | version(8) | host_len(4) | host | { len(4) | ChangeMsg }*
+constexpr char kMagic[] = "CYBTOPO1";
+constexpr size_t kMagicSize = 8;
+constexpr size_t kVersionOffset = kMagicSize;
+constexpr size_t kMinCompactRecords = 32;
+
+bool WriteAll(int fd, const void* data, size_t size) {
+  const char* ptr = static_cast<const char*>(data);
+  while (size > 0) {
+    ssize_t n = ::write(fd, ptr, size);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    ptr += n;
+    size -= n;
+  }
+  return true;
+}
+
+}  // namespace
+
+constexpr const char* TopologySnapshot::kDefaultDir;
+
+TopologySnapshot::TopologySnapshot(const std::string& name,
+                                   const std::string& host_name,
+                                   int process_id, const std::string& dir)
+    : name_(name), host_name_(host_name), process_id_(process_id), dir_(dir) {
+  path_ = dir_ + "/cyber_topo." + name_ + "." + std::to_string(process_id_);
+}
+
+TopologySnapshot::~TopologySnapshot() {
+  if (fd_ >= 0) {
+    ::close(fd_);
+    ::unlink(path_.c_str());
+  }
+}
+
+bool TopologySnapshot::Enabled() {
+  const char* value = std::getenv("CYBER_TOPOLOGY_SNAPSHOT");
+  return value != nullptr && std::strcmp(value, "0") != 0 &&
+         std::strcmp(value, "false") != 0;
+}
+
+bool TopologySnapshot::Open() {
+  std::lock_guard<std::mutex> lg(mutex_);
+  if (fd_ >= 0) {
+    return true;
+  }
+  fd_ = ::open(path_.c_str(), O_CREAT | O_TRUNC | O_WRONLY | O_CLOEXEC, 0644);
+  if (fd_ < 0) {
+    AERROR << "open topology snapshot " << path_
+           << " failed: " << std::strerror(errno);
+    return false;
+  }
+  if (!WriteHeader(fd_)) {
+    AERROR << "write topology snapshot header failed.";
+    ::close(fd_);
+    ::unlink(path_.c_str());
+    fd_ = -1;
+    return false;
+  }
+  return true;
+}
+
+void TopologySnapshot::Record(const proto::ChangeMsg& msg) {
+  std::lock_guard<std::mutex> lg(mutex_);
+  if (fd_ < 0) {
+    return;
+  }
+  std::string key = RoleKey(msg);
+  std::string data;
+  if (!msg.SerializeToString(&data)) {
+    return;
+  }
+  if (msg.operate_type() == proto::OperateType::OPT_JOIN) {
+    live_[key] = data;
+  } else {
+    live_.erase(key);
+  }
+  if (msg.timestamp() > version_) {
+    version_ = msg.timestamp();
+  }
+
+  if (++record_count_ > 2 * live_.size() + kMinCompactRecords) {
+    Compact();
+    return;
+  }
+  // the record goes first so a reader never sees a version it cannot read
+  if (!AppendRecord(fd_, data) ||
+      ::pwrite(fd_, &version_, sizeof(version_), kVersionOffset) !=
+          static_cast<ssize_t>(sizeof(version_))) {
+    AWARN << "append topology snapshot " << path_ << " failed.";
+  }
+}
+
+void TopologySnapshot::Load(std::vector<Peer>* peers) const {
+  RETURN_IF_NULL(peers);
+  DIR* dir = ::opendir(dir_.c_str());
+  if (dir == nullptr) {
+    return;
+  }
+  const std::string prefix = "cyber_topo." + name_ + ".";
+  struct dirent* entry = nullptr;
+  while ((entry = ::readdir(dir)) != nullptr) {
+    std::string file_name(entry->d_name);
+    if (file_name.compare(0, prefix.size(), prefix) != 0) {
+      continue;
+    }
+    char* end = nullptr;
+    long pid = std::strtol(file_name.c_str() + prefix.size(), &end, 10);
+    if (end == nullptr || *end != '\0' || pid <= 0 || pid == process_id_) {
+      continue;
+    }
+    std::string path = dir_ + "/" + file_name;
+    if (!IsAlive(static_cast<int>(pid))) {
+      ADEBUG << "remove stale topology snapshot " << path;
+      ::unlink(path.c_str());
+      continue;
+    }
+    Peer peer;
+    peer.process_id = static_cast<int>(pid);
+    if (ReadLog(path, &peer)) {
+      peers->emplace_back(std::move(peer));
+    }
+  }
+  ::closedir(dir);
+}
+
+std::string TopologySnapshot::RoleKey(const proto::ChangeMsg& msg) {
+  // a role leaves with the same attributes it joined with
+  return std::to_string(msg.role_type()) + ":" +
+         msg.role_attr().SerializeAsString();
+}
+
+bool TopologySnapshot::IsAlive(int process_id) {
+  return ::kill(process_id, 0) == 0 || errno == EPERM;
+}
+
+bool TopologySnapshot::ReadLog(const std::string& path, Peer* peer) const {
+  int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    return false;
+  }
+  std::string content;
+  char buf[64 * 1024];
+  ssize_t n = 0;
+  while ((n = ::read(fd, buf, sizeof(buf))) > 0) {
+    content.append(buf, n);
+  }
+  ::close(fd);
+
+  size_t pos = kMagicSize + sizeof(uint64_t) + sizeof(uint32_t);
+  if (content.size() < pos || content.compare(0, kMagicSize, kMagic) != 0) {
+    return false;
+  }
+  uint64_t version = 0;
+  uint32_t host_len = 0;
+  std::memcpy(&version, content.data() + kVersionOffset, sizeof(version));
+  std::memcpy(&host_len, content.data() + kVersionOffset + sizeof(version),
+              sizeof(host_len));
+  if (content.size() < pos + host_len ||
+      content.compare(pos, host_len, host_name_) != 0 ||
+      host_len != host_name_.size()) {
+    return false;
+  }
+  pos += host_len;
+
+  // replay Join/Leave pairs so only the roles still alive are returned
+  std::vector<std::string> order;
+  std::unordered_map<std::string, proto::ChangeMsg> live;
+  while (pos + sizeof(uint32_t) <= content.size()) {
+    uint32_t len = 0;
+    std::memcpy(&len, content.data() + pos, sizeof(len));
+    if (pos + sizeof(len) + len > content.size()) {
+      break;  // the tail is still being written
+    }
+    proto::ChangeMsg msg;
+    if (!msg.ParseFromArray(content.data() + pos + sizeof(len), len)) {
+      break;
+    }
+    pos += sizeof(len) + len;
+    if (msg.timestamp() > version) {
+      version = msg.timestamp();
+    }
+    std::string key = RoleKey(msg);
+    if (msg.operate_type() == proto::OperateType::OPT_JOIN) {
+      if (live.find(key) == live.end()) {
+        order.emplace_back(key);
+      }
+      live[key] = std::move(msg);
+    } else {
+      live.erase(key);
+    }
+  }
+
+  peer->version = version;
+  for (auto& key : order) {
+    auto it = live.find(key);
+    if (it != live.end()) {
+      peer->changes.emplace_back(std::move(it->second));
+      live.erase(it);
+    }
+  }
+  return true;
+}
+
+bool TopologySnapshot::WriteHeader(int fd) {
+  uint32_t host_len = static_cast<uint32_t>(host_name_.size());
+  return WriteAll(fd, kMagic, kMagicSize) &&
+         WriteAll(fd, &version_, sizeof(version_)) &&
+         WriteAll(fd, &host_len, sizeof(host_len)) &&
+         WriteAll(fd, host_name_.data(), host_name_.size());
+}
+
+bool TopologySnapshot::AppendRecord(int fd, const std::string& data) {
+  // a single write keeps the record contiguous for concurrent readers
+  std::string record;
+  uint32_t len = static_cast<uint32_t>(data.size());
+  record.reserve(sizeof(len) + data.size());
+  record.append(reinterpret_cast<const char*>(&len), sizeof(len));
+  record.append(data);
+  return WriteAll(fd, record.data(), record.size());
+}
+
+void TopologySnapshot::Compact() {
+  // readers open either the old or the new log, never a partial one
+  std::string tmp_path = path_ + ".tmp";
+  int fd =
+      ::open(tmp_path.c_str(), O_CREAT | O_TRUNC | O_WRONLY | O_CLOEXEC, 0644);
+  if (fd < 0) {
+    AWARN << "open " << tmp_path << " failed: " << std::strerror(errno);
+    return;
+  }
+  bool ok = WriteHeader(fd);
+  for (auto& item : live_) {
+    ok = ok && AppendRecord(fd, item.second);
+  }
+  if (!ok || ::rename(tmp_path.c_str(), path_.c_str()) != 0) {
+    AWARN << "compact topology snapshot " << path_ << " failed.";
+    ::close(fd);
+    ::unlink(tmp_path.c_str());
+    return;
+  }
+  ::close(fd_);
+  fd_ = fd;
+  record_count_ = live_.size();
+}
+
+}  // namespace service_discovery
+}  // namespace cyber
+}  // namespace apollo
@@ -0,0 +1,108 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#ifndef CYBER_SERVICE_DISCOVERY_COMMUNICATION_TOPOLOGY_SNAPSHOT_H_
+#define CYBER_SERVICE_DISCOVERY_COMMUNICATION_TOPOLOGY_SNAPSHOT_H_
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "cyber/proto/topology_change.pb.h"
+
+namespace apollo {
+namespace cyber {
+namespace service_discovery {
+
+/**
+ * @class TopologySnapshot
+ * @brief Per-process log of the roles a Manager has published, kept in shared
+ * memory (tmpfs) so that a process starting on the same host can bootstrap
+ * its topology from the logs of the live processes instead of waiting for the
+ * rtps history of every participant.
+ *
+ * Each process appends its own Join/Leave changes to
+ * `<dir>/cyber_topo.<name>.<pid>`. The file header holds the version (the
+ * timestamp of the newest change) so a reader knows which later rtps changes
+ * of that process it still has to apply. The log is compacted to the live
+ * roles once it grows well past them.
+ */
+class TopologySnapshot {
+ public:
+  struct Peer {
+    int process_id = 0;
+    uint64_t version = 0;
+    std::vector<proto::ChangeMsg> changes;  /// live Join changes, in order
+  };
+
+  static constexpr const char* kDefaultDir = "/dev/shm";
+
+  TopologySnapshot(const std::string& name, const std::string& host_name,
+                   int process_id, const std::string& dir = kDefaultDir);
+  virtual ~TopologySnapshot();
+
+  /**
+   * @brief Whether snapshots are enabled by `CYBER_TOPOLOGY_SNAPSHOT`
+   */
+  static bool Enabled();
+
+  /**
+   * @brief Create (or truncate) this process' log
+   */
+  bool Open();
+
+  /**
+   * @brief Append a change published by this process
+   */
+  void Record(const proto::ChangeMsg& msg);
+
+  /**
+   * @brief Read the logs of the other live processes on this host. Logs left
+   * behind by dead processes are removed.
+   */
+  void Load(std::vector<Peer>* peers) const;
+
+  const std::string& path() const { return path_; }
+
+ private:
+  static std::string RoleKey(const proto::ChangeMsg& msg);
+  static bool IsAlive(int process_id);
+
+  bool ReadLog(const std::string& path, Peer* peer) const;
+  bool WriteHeader(int fd);
+  bool AppendRecord(int fd, const std::string& data);
+  void Compact();
+
+  std::string name_;
+  std::string host_name_;
+  int process_id_;
+  std::string dir_;
+  std::string path_;
+  int fd_ = -1;
+  uint64_t version_ = 0;
+  size_t record_count_ = 0;
+  std::unordered_map<std::string, std::string> live_;
+  std::mutex mutex_;
+};
+
+}  // namespace service_discovery
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_SERVICE_DISCOVERY_COMMUNICATION_TOPOLOGY_SNAPSHOT_H_
@@ -0,0 +1,157 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "cyber/service_discovery/communication/topology_snapshot.h"
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <climits>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "cyber/common/file.h"
+
+namespace apollo {
+namespace cyber {
+namespace service_discovery {
+
+using proto::ChangeMsg;
+using proto::OperateType;
+using proto::RoleType;
+
+namespace {
+
+ChangeMsg MakeChange(const std::string& channel, OperateType opt,
+                     uint64_t timestamp) {
+  ChangeMsg msg;
+  msg.set_timestamp(timestamp);
+  msg.set_change_type(proto::ChangeType::CHANGE_CHANNEL);
+  msg.set_operate_type(opt);
+  msg.set_role_type(RoleType::ROLE_WRITER);
+  auto attr = msg.mutable_role_attr();
+  attr->set_host_name("host");
+  attr->set_channel_name(channel);
+  attr->set_channel_id(std::hash<std::string>()(channel));
+  attr->set_id(timestamp);
+  return msg;
+}
+
+std::string MakeTempDir() {
+  char dir[] = "/tmp/topology_snapshot_test.XXXXXX";
+  return ::mkdtemp(dir) != nullptr ? dir : "";
+}
+
+}  // namespace
+
+TEST(TopologySnapshotTest, record_and_load) {
+  std::string dir = MakeTempDir();
+  ASSERT_FALSE(dir.empty());
+
+  // this test process plays the peer, the loader pretends to be another one
+  std::unique_ptr<TopologySnapshot> peer(
+      new TopologySnapshot("channel", "host", getpid(), dir));
+  ASSERT_TRUE(peer->Open());
+  ChangeMsg joined = MakeChange("/a", OperateType::OPT_JOIN, 10);
+  ChangeMsg left = MakeChange("/b", OperateType::OPT_JOIN, 20);
+  peer->Record(joined);
+  peer->Record(left);
+  left.set_operate_type(OperateType::OPT_LEAVE);
+  left.set_timestamp(30);
+  peer->Record(left);
+
+  std::vector<TopologySnapshot::Peer> peers;
+  TopologySnapshot("channel", "host", 1, dir).Load(&peers);
+  ASSERT_EQ(1, peers.size());
+  EXPECT_EQ(getpid(), peers[0].process_id);
+  EXPECT_EQ(30, peers[0].version);
+  ASSERT_EQ(1, peers[0].changes.size());
+  EXPECT_EQ("/a", peers[0].changes[0].role_attr().channel_name());
+
+  peers.clear();
+  TopologySnapshot("channel", "other_host", 1, dir).Load(&peers);
+  EXPECT_TRUE(peers.empty());
+
+  peers.clear();
+  TopologySnapshot("node", "host", 1, dir).Load(&peers);
+  EXPECT_TRUE(peers.empty());
+
+  std::string path = peer->path();
+  EXPECT_TRUE(common::PathExists(path));
+  peer.reset();
+  EXPECT_FALSE(common::PathExists(path));
+  ::rmdir(dir.c_str());
+}
+
+TEST(TopologySnapshotTest, compact) {
+  std::string dir = MakeTempDir();
+  ASSERT_FALSE(dir.empty());
+  {
+    TopologySnapshot peer("channel", "host", getpid(), dir);
+    ASSERT_TRUE(peer.Open());
+    uint64_t timestamp = 0;
+    for (int i = 0; i < 200; ++i) {
+      std::string channel = "/channel_" + std::to_string(i % 10);
+      ChangeMsg msg = MakeChange(channel, OperateType::OPT_JOIN, ++timestamp);
+      msg.mutable_role_attr()->set_id(i % 10);
+      peer.Record(msg);
+      if (i < 190) {
+        msg.set_operate_type(OperateType::OPT_LEAVE);
+        msg.set_timestamp(++timestamp);
+        peer.Record(msg);
+      }
+    }
+
+    std::vector<TopologySnapshot::Peer> peers;
+    TopologySnapshot("channel", "host", 1, dir).Load(&peers);
+    ASSERT_EQ(1, peers.size());
+    EXPECT_EQ(timestamp, peers[0].version);
+    EXPECT_EQ(10, peers[0].changes.size());
+
+    struct stat st;
+    ASSERT_EQ(0, ::stat(peer.path().c_str(), &st));
+    // 390 records were written, the log holds a bounded number of them
+    EXPECT_LT(st.st_size, 64 * 60);
+  }
+  ::rmdir(dir.c_str());
+}
+
+TEST(TopologySnapshotTest, remove_stale) {
+  std::string dir = MakeTempDir();
+  ASSERT_FALSE(dir.empty());
+  std::string path;
+  {
+    TopologySnapshot dead("channel", "host", INT_MAX, dir);
+    ASSERT_TRUE(dead.Open());
+    dead.Record(MakeChange("/a", OperateType::OPT_JOIN, 1));
+    path = dead.path();
+
+    std::vector<TopologySnapshot::Peer> peers;
+    TopologySnapshot("channel", "host", 1, dir).Load(&peers);
+    EXPECT_TRUE(peers.empty());
+    EXPECT_FALSE(common::PathExists(path));
+  }
+  ::rmdir(dir.c_str());
+}
+
+}  // namespace service_discovery
+}  // namespace cyber
+}  // namespace apollo
@@ -16,6 +16,10 @@
 
 #include "cyber/service_discovery/specific_manager/manager.h"
 
+#include <algorithm>
+#include <utility>
+#include <vector>
+
 #include "cyber/common/global_data.h"
 #include "cyber/common/log.h"
 #include "cyber/message/message_traits.h"
@@ -40,7 +44,8 @@ Manager::Manager()
       channel_name_(""),
       publisher_(nullptr),
       subscriber_(nullptr),
-      listener_(nullptr) {
+      listener_(nullptr),
+      last_version_(0) {
   host_name_ = common::GlobalData::Instance()->HostName();
   process_id_ = common::GlobalData::Instance()->ProcessId();
 }
@@ -54,6 +59,17 @@ bool Manager::StartDiscovery(RtpsParticipant* participant) {
   if (is_discovery_started_.exchange(true)) {
     return true;
   }
+  if (TopologySnapshot::Enabled()) {
+    // apply the host's current roles before the rtps history arrives, so the
+    // replayed changes already covered by the snapshot are dropped
+    std::unique_ptr<TopologySnapshot> snapshot(
+        new TopologySnapshot(channel_name_, host_name_, process_id_));
+    if (snapshot->Open()) {
+      std::lock_guard<std::mutex> lg(lock_);
+      snapshot_ = std::move(snapshot);
+    }
+    LoadSnapshot();
+  }
   if (!CreatePublisher(participant) || !CreateSubscriber(participant)) {
     AERROR << "create publisher or subscriber failed.";
     StopDiscovery();
@@ -73,6 +89,7 @@ void Manager::StopDiscovery() {
       eprosima::fastrtps::Domain::removePublisher(publisher_);
       publisher_ = nullptr;
     }
+    snapshot_.reset();
   }
 
   if (subscriber_ != nullptr) {
@@ -169,7 +186,7 @@ bool Manager::NeedPublish(const ChangeMsg& msg) const {
 
 void Manager::Convert(const RoleAttributes& attr, RoleType role,
                       OperateType opt, ChangeMsg* msg) {
-  msg->set_timestamp(cyber::Time::Now().ToNanosecond());
+  msg->set_timestamp(NextVersion());
   msg->set_change_type(change_type_);
   msg->set_operate_type(opt);
   msg->set_role_type(role);
@@ -197,6 +214,12 @@ void Manager::OnRemoteChange(const std::string& msg_str) {
     return;
   }
   RETURN_IF(!Check(msg.role_attr()));
+  if (!AcceptVersion(msg)) {
+    ADEBUG << "drop replayed change of " << msg.role_attr().host_name() << "+"
+           << msg.role_attr().process_id() << ", version "
+           << msg.timestamp();
+    return;
+  }
   Dispose(msg);
 }
 
@@ -211,7 +234,13 @@ bool Manager::Publish(const ChangeMsg& msg) {
   {
     std::lock_guard<std::mutex> lg(lock_);
     if (publisher_ != nullptr) {
-      return publisher_->write(reinterpret_cast<void*>(&m));
+      if (!publisher_->write(reinterpret_cast<void*>(&m))) {
+        return false;
+      }
+      if (snapshot_ != nullptr) {
+        snapshot_->Record(msg);
+      }
+      return true;
     }
   }
   return true;
@@ -227,6 +256,52 @@ bool Manager::IsFromSameProcess(const ChangeMsg& msg) {
   return true;
 }
 
+uint64_t Manager::NextVersion() {
+  uint64_t now = cyber::Time::Now().ToNanosecond();
+  std::lock_guard<std::mutex> lg(version_lock_);
+  last_version_ = std::max(now, last_version_ + 1);
+  return last_version_;
+}
+
+bool Manager::AcceptVersion(const ChangeMsg& msg) {
+  std::string origin = msg.role_attr().host_name() + "+" +
+                       std::to_string(msg.role_attr().process_id());
+  std::lock_guard<std::mutex> lg(version_lock_);
+  auto& version = origin_versions_[origin];
+  if (msg.timestamp() <= version) {
+    return false;
+  }
+  version = msg.timestamp();
+  return true;
+}
+
+void Manager::ForgetOrigin(const std::string& host_name, int process_id) {
+  std::lock_guard<std::mutex> lg(version_lock_);
+  origin_versions_.erase(host_name + "+" + std::to_string(process_id));
+}
+
+void Manager::LoadSnapshot() {
+  TopologySnapshot loader(channel_name_, host_name_, process_id_);
+  std::vector<TopologySnapshot::Peer> peers;
+  loader.Load(&peers);
+  size_t role_num = 0;
+  for (auto& peer : peers) {
+    {
+      std::lock_guard<std::mutex> lg(version_lock_);
+      origin_versions_[host_name_ + "+" + std::to_string(peer.process_id)] =
+          peer.version;
+    }
+    for (auto& msg : peer.changes) {
+      if (Check(msg.role_attr())) {
+        Dispose(msg);
+        ++role_num;
+      }
+    }
+  }
+  ADEBUG << channel_name_ << " loaded " << role_num << " roles of "
+         << peers.size() << " processes from snapshot.";
+}
+
 }  // namespace service_discovery
 }  // namespace cyber
 }  // namespace apollo
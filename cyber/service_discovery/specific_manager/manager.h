@@ -19,8 +19,10 @@
 
 #include <atomic>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <string>
+#include <unordered_map>
 
 #include "fastrtps/Domain.h"
 #include "fastrtps/attributes/PublisherAttributes.h"
@@ -32,6 +34,7 @@
 #include "cyber/base/signal.h"
 #include "cyber/proto/topology_change.pb.h"
 #include "cyber/service_discovery/communication/subscriber_listener.h"
+#include "cyber/service_discovery/communication/topology_snapshot.h"
 
 namespace apollo {
 namespace cyber {
@@ -151,6 +154,17 @@ class Manager {
   void OnRemoteChange(const std::string& msg_str);
   bool IsFromSameProcess(const ChangeMsg& msg);
 
+  /**
+   * @brief Version vector of the topology: every process stamps its changes
+   * with a strictly increasing timestamp, so a change that is not newer than
+   * the last one applied from its process is a replay (rtps history or an
+   * already loaded snapshot) and is dropped.
+   */
+  uint64_t NextVersion();
+  bool AcceptVersion(const ChangeMsg& msg);
+  void ForgetOrigin(const std::string& host_name, int process_id);
+  void LoadSnapshot();
+
   std::atomic<bool> is_shutdown_;
   std::atomic<bool> is_discovery_started_;
   int allowed_role_;
@@ -162,6 +176,11 @@ class Manager {
   std::mutex lock_;
   eprosima::fastrtps::Subscriber* subscriber_;
   SubscriberListener* listener_;
+  std::unique_ptr<TopologySnapshot> snapshot_;
+
+  std::mutex version_lock_;
+  uint64_t last_version_;
+  std::unordered_map<std::string, uint64_t> origin_versions_;
 
   ChangeSignal signal_;
 };
@@ -0,0 +1,279 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/sysmo/alloc_tracker.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <new>
+#include <utility>
+
+#include "cyber/croutine/croutine.h"
+#include "cyber/sysmo/profile_encoder.h"
+#include "cyber/time/time.h"
+
+namespace apollo {
+namespace cyber {
+
+namespace {
+
+// The counters of a croutine, apart from those of the others to keep the
+// threads from contending on the cache lines.
+struct alignas(64) Slot {
+  std::atomic<uint64_t> hash;
+  std::atomic<bool> ready;
+  char name[AllocTracker::kMaxNameLength];
+  std::atomic<uint64_t> alloc_count;
+  std::atomic<uint64_t> alloc_bytes;
+  std::atomic<uint64_t> free_count;
+  std::atomic<uint64_t> free_bytes;
+};
+
+struct Sample {
+  std::atomic<bool> ready;
+  int slot;
+  int depth;
+  uint64_t size;
+  uintptr_t pcs[AllocTracker::kMaxDepth];
+};
+
+// Slot 0 counts the threads outside of croutines and the croutines past
+// kMaxCroutines. Zero initialized before anything runs.
+Slot slots[AllocTracker::kMaxCroutines + 1];
+
+std::atomic<Sample*> samples{nullptr};
+std::atomic<uint32_t> max_samples{0};
+std::atomic<uint64_t> next_sample{0};
+std::atomic<uint64_t> sample_bytes{0};
+uint64_t start_time = 0;
+
+// Read in malloc, the initial exec model keeps the first access of a thread
+// from allocating them through malloc.
+thread_local const croutine::CRoutine* cached_routine
+    __attribute__((tls_model("initial-exec"))) = nullptr;
+thread_local uint64_t cached_id __attribute__((tls_model("initial-exec"))) = 0;
+thread_local int cached_slot __attribute__((tls_model("initial-exec"))) = 0;
+thread_local uint64_t bytes_since_sample
+    __attribute__((tls_model("initial-exec"))) = 0;
+
+uint64_t HashName(const char* name) {
+  // FNV-1a, 0 marks a free slot.
+  uint64_t hash = 14695981039346656037UL;
+  for (; *name != '\0'; ++name) {
+    hash = (hash ^ static_cast<unsigned char>(*name)) * 1099511628211UL;
+  }
+  return hash == 0 ? 1 : hash;
+}
+
+void CopyName(const char* name, char* dest, size_t size) {
+  size_t i = 0;
+  for (; i + 1 < size && name[i] != '\0'; ++i) {
+    dest[i] = name[i];
+  }
+  dest[i] = '\0';
+}
+
+std::string SlotName(int slot) {
+  if (slot == 0 || !slots[slot].ready.load(std::memory_order_acquire)) {
+    return "";
+  }
+  return slots[slot].name;
+}
+
+}  // namespace
+
+std::atomic<bool> AllocTracker::enabled_{false};
+std::atomic<bool> AllocTracker::interposed_{false};
+
+bool AllocTracker::Enable(uint64_t bytes, uint32_t num_samples) {
+  static std::mutex mutex;
+  std::lock_guard<std::mutex> lock(mutex);
+  if (enabled() || !interposed()) {
+    return false;
+  }
+  if (bytes != 0 && num_samples != 0) {
+    // Value initialized, so that no sample is ready.
+    Sample* buffer = new (std::nothrow) Sample[num_samples]();
+    if (buffer == nullptr) {
+      return false;
+    }
+    samples.store(buffer, std::memory_order_release);
+    max_samples.store(num_samples, std::memory_order_relaxed);
+    sample_bytes.store(bytes, std::memory_order_relaxed);
+  }
+  start_time = Time::Now().ToNanosecond();
+  enabled_.store(true, std::memory_order_release);
+  return true;
+}
+
+int AllocTracker::CurrentSlot() {
+  const auto* routine = croutine::CRoutine::GetCurrentRoutine();
+  if (routine == nullptr) {
+    return 0;
+  }
+  // A croutine freed and another made at its address has another id, as
+  // long as the scheduler made them.
+  if (routine == cached_routine && routine->id() == cached_id) {
+    return cached_slot;
+  }
+  // The croutines are told apart by name, a new croutine of the same name
+  // adds to the same counters.
+  const char* name = routine->name().c_str();
+  const uint64_t hash = HashName(name);
+  int slot = 0;
+  for (int i = 0; i < kMaxCroutines; ++i) {
+    const int index = 1 + static_cast<int>((hash + i) % kMaxCroutines);
+    uint64_t expected = slots[index].hash.load(std::memory_order_acquire);
+    if (expected == 0 &&
+        slots[index].hash.compare_exchange_strong(expected, hash)) {
+      CopyName(name, slots[index].name, sizeof(slots[index].name));
+      slots[index].ready.store(true, std::memory_order_release);
+      slot = index;
+      break;
+    }
+    if (expected == hash) {
+      slot = index;
+      break;
+    }
+  }
+  cached_routine = routine;
+  cached_id = routine->id();
+  cached_slot = slot;
+  return slot;
+}
+
+void AllocTracker::OnAlloc(size_t size) {
+  const int slot = CurrentSlot();
+  slots[slot].alloc_count.fetch_add(1, std::memory_order_relaxed);
+  slots[slot].alloc_bytes.fetch_add(size, std::memory_order_relaxed);
+
+  const uint64_t interval = sample_bytes.load(std::memory_order_relaxed);
+  if (interval == 0) {
+    return;
+  }
+  bytes_since_sample += size;
+  if (bytes_since_sample >= interval) {
+    bytes_since_sample %= interval;
+    TakeSample(size, slot);
+  }
+}
+
+void AllocTracker::OnFree(size_t size) {
+  const int slot = CurrentSlot();
+  slots[slot].free_count.fetch_add(1, std::memory_order_relaxed);
+  slots[slot].free_bytes.fetch_add(size, std::memory_order_relaxed);
+}
+
+void AllocTracker::TakeSample(size_t size, int slot) {
+  Sample* buffer = samples.load(std::memory_order_acquire);
+  const uint64_t index = next_sample.fetch_add(1, std::memory_order_relaxed);
+  if (buffer == nullptr ||
+      index >= max_samples.load(std::memory_order_relaxed)) {
+    return;
+  }
+  Sample& sample = buffer[index];
+  sample.slot = slot;
+  sample.size = size;
+  const uintptr_t fp = reinterpret_cast<uintptr_t>(__builtin_frame_address(0));
+  // The callers are above the locals of this frame.
+  sample.depth = WalkFramePointers(fp, reinterpret_cast<uintptr_t>(&fp),
+                                   sample.pcs, kMaxDepth);
+  sample.ready.store(true, std::memory_order_release);
+}
+
+void AllocTracker::Collect(std::vector<AllocUsage>* usages) {
+  usages->clear();
+  for (int i = 0; i <= kMaxCroutines; ++i) {
+    if (i != 0 && !slots[i].ready.load(std::memory_order_acquire)) {
+      continue;
+    }
+    AllocUsage usage;
+    usage.croutine = SlotName(i);
+    usage.alloc_count = slots[i].alloc_count.load(std::memory_order_relaxed);
+    usage.alloc_bytes = slots[i].alloc_bytes.load(std::memory_order_relaxed);
+    usage.free_count = slots[i].free_count.load(std::memory_order_relaxed);
+    usage.free_bytes = slots[i].free_bytes.load(std::memory_order_relaxed);
+    usages->push_back(std::move(usage));
+  }
+}
+
+bool AllocTracker::WriteProfile(const std::string& output_file,
+                                uint64_t* num_samples, uint64_t* num_dropped,
+                                std::string* error) {
+  *num_samples = 0;
+  *num_dropped = 0;
+  if (!enabled()) {
+    *error = "the allocation tracker is not enabled";
+    return false;
+  }
+  const uint64_t interval = sample_bytes.load(std::memory_order_relaxed);
+  const Sample* buffer = samples.load(std::memory_order_acquire);
+  const uint64_t taken = next_sample.load(std::memory_order_relaxed);
+  const uint64_t kept =
+      std::min<uint64_t>(taken, max_samples.load(std::memory_order_relaxed));
+  *num_dropped = taken - kept;
+
+  ProfileEncoder encoder;
+  encoder.AddValueType(1, "alloc_objects", "count");
+  encoder.AddValueType(1, "alloc_space", "bytes");
+
+  // Merge the samples of the same stack and croutine. A block of size s is
+  // sampled with the odds of s / interval, so it stands for interval / s
+  // blocks of its size.
+  std::map<std::pair<std::vector<uintptr_t>, int>, std::pair<double, double>>
+      stacks;
+  for (uint64_t i = 0; i < kept; ++i) {
+    const Sample& sample = buffer[i];
+    // Still being taken.
+    if (!sample.ready.load(std::memory_order_acquire)) {
+      continue;
+    }
+    const double weight =
+        sample.size >= interval
+            ? 1.0
+            : static_cast<double>(interval) /
+                  static_cast<double>(std::max<uint64_t>(sample.size, 1));
+    auto& values = stacks[std::make_pair(
+        std::vector<uintptr_t>(sample.pcs, sample.pcs + sample.depth),
+        sample.slot)];
+    values.first += weight;
+    values.second += weight * static_cast<double>(sample.size);
+    ++*num_samples;
+  }
+
+  for (const auto& stack : stacks) {
+    std::vector<std::pair<std::string, std::string>> labels;
+    const std::string croutine = SlotName(stack.first.second);
+    if (!croutine.empty()) {
+      labels.emplace_back("croutine", croutine);
+    }
+    encoder.AddSample(encoder.AddStack(stack.first.first),
+                      {std::llround(stack.second.first),
+                       std::llround(stack.second.second)},
+                      labels);
+  }
+
+  encoder.AddVarint(9, start_time);
+  encoder.AddVarint(10, Time::Now().ToNanosecond() - start_time);
+  encoder.AddValueType(11, "space", "bytes");
+  encoder.AddVarint(12, interval);
+  return encoder.WriteFile(output_file, error);
+}
+
+}  // namespace cyber
+}  // namespace apollo
@@ -0,0 +1,108 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_SYSMO_ALLOC_TRACKER_H_
+#define CYBER_SYSMO_ALLOC_TRACKER_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace apollo {
+namespace cyber {
+
+struct AllocUsage {
+  // The croutine the memory was allocated or freed on, empty for the threads
+  // outside of croutines.
+  std::string croutine;
+  uint64_t alloc_count = 0;
+  uint64_t alloc_bytes = 0;
+  uint64_t free_count = 0;
+  uint64_t free_bytes = 0;
+};
+
+/**
+ * @class AllocTracker
+ * @brief Counts the allocations and frees of this process by the croutine
+ * they are made on, and samples the stacks of one allocation every
+ * sample_bytes allocated on a thread for the heap profile.
+ *
+ * The malloc_interposer library calls OnAlloc() and OnFree() from malloc and
+ * free, so that everything here runs inside of them: nothing allocates and
+ * the state lives in static storage. The sizes are the usable sizes of the
+ * blocks. A block freed on another croutine than the one allocating it is
+ * counted as freed there.
+ */
+class AllocTracker {
+ public:
+  // Croutines counted separately at most, the later ones are counted with
+  // the threads outside of croutines.
+  static constexpr int kMaxCroutines = 256;
+  static constexpr int kMaxDepth = 32;
+  static constexpr int kMaxNameLength = 48;
+
+  /**
+   * @brief Whether malloc reports here, which takes linking the
+   * malloc_interposer library into a build without sanitizers.
+   */
+  static bool interposed() {
+    return interposed_.load(std::memory_order_relaxed);
+  }
+  static void MarkInterposed() { interposed_.store(true); }
+
+  /**
+   * @brief Start counting, unless malloc is not interposed. Not undone, a
+   * block allocated while counting may be freed any time later.
+   * @param sample_bytes Bytes allocated on a thread between the samples of
+   * the heap profile, 0 to sample none.
+   * @param max_samples Samples kept at most, the later ones are dropped.
+   */
+  static bool Enable(uint64_t sample_bytes, uint32_t max_samples);
+
+  static bool enabled() { return enabled_.load(std::memory_order_relaxed); }
+
+  static void OnAlloc(size_t size);
+  static void OnFree(size_t size);
+
+  /**
+   * @brief The totals of every croutine seen since Enable().
+   */
+  static void Collect(std::vector<AllocUsage>* usages);
+
+  /**
+   * @brief Write the allocations sampled since Enable() as a pprof profile,
+   * with the croutine of each as a label.
+   * @param num_samples The number of samples written.
+   * @param num_dropped The number of samples dropped past max_samples.
+   */
+  static bool WriteProfile(const std::string& output_file,
+                           uint64_t* num_samples, uint64_t* num_dropped,
+                           std::string* error);
+
+ private:
+  static int CurrentSlot();
+  static void TakeSample(size_t size, int slot);
+
+  static std::atomic<bool> enabled_;
+  static std::atomic<bool> interposed_;
+};
+
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_SYSMO_ALLOC_TRACKER_H_
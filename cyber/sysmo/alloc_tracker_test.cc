@@ -0,0 +1,130 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/sysmo/alloc_tracker.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "cyber/croutine/croutine.h"
+
+namespace apollo {
+namespace cyber {
+
+namespace {
+
+constexpr int kNumBlocks = 1000;
+constexpr size_t kBlockSize = 1000;
+
+// Not inlined, so that the blocks are really allocated.
+__attribute__((noinline)) void AllocateBlocks(std::vector<void*>* blocks) {
+  for (int i = 0; i < kNumBlocks; ++i) {
+    blocks->push_back(malloc(kBlockSize));
+  }
+}
+
+__attribute__((noinline)) void FreeBlocks(std::vector<void*>* blocks) {
+  for (void* block : *blocks) {
+    free(block);
+  }
+  blocks->clear();
+}
+
+const AllocUsage* FindUsage(const std::vector<AllocUsage>& usages,
+                            const std::string& croutine) {
+  for (const auto& usage : usages) {
+    if (usage.croutine == croutine) {
+      return &usage;
+    }
+  }
+  return nullptr;
+}
+
+}  // namespace
+
+TEST(AllocTrackerTest, CountByCroutine) {
+  // The sanitizers keep their own malloc.
+  if (!AllocTracker::interposed()) {
+    EXPECT_FALSE(AllocTracker::Enable(64 * 1024, 10000));
+    return;
+  }
+  uint64_t num_samples = 0;
+  uint64_t num_dropped = 0;
+  std::string error;
+  EXPECT_FALSE(AllocTracker::WriteProfile("", &num_samples, &num_dropped,
+                                          &error));
+
+  ASSERT_TRUE(AllocTracker::Enable(64 * 1024, 10000));
+  EXPECT_TRUE(AllocTracker::enabled());
+  EXPECT_FALSE(AllocTracker::Enable(64 * 1024, 10000));
+
+  std::vector<void*> blocks;
+  blocks.reserve(kNumBlocks);
+  auto routine = std::make_shared<croutine::CRoutine>([&blocks]() {
+    AllocateBlocks(&blocks);
+    FreeBlocks(&blocks);
+  });
+  routine->set_name("alloc_tracker_test");
+  routine->Resume();
+
+  std::vector<AllocUsage> usages;
+  AllocTracker::Collect(&usages);
+  const AllocUsage* usage = FindUsage(usages, "alloc_tracker_test");
+  ASSERT_NE(usage, nullptr);
+  EXPECT_GE(usage->alloc_count, kNumBlocks);
+  EXPECT_GE(usage->alloc_bytes, kNumBlocks * kBlockSize);
+  EXPECT_GE(usage->free_count, kNumBlocks);
+  EXPECT_GE(usage->free_bytes, kNumBlocks * kBlockSize);
+
+  // Outside of croutines.
+  const AllocUsage* threads = FindUsage(usages, "");
+  ASSERT_NE(threads, nullptr);
+  const uint64_t alloc_count = threads->alloc_count;
+  AllocateBlocks(&blocks);
+  FreeBlocks(&blocks);
+  AllocTracker::Collect(&usages);
+  threads = FindUsage(usages, "");
+  ASSERT_NE(threads, nullptr);
+  EXPECT_GE(threads->alloc_count, alloc_count + kNumBlocks);
+
+  const std::string output_file = "alloc_tracker_test.pprof";
+  ASSERT_TRUE(AllocTracker::WriteProfile(output_file, &num_samples,
+                                         &num_dropped, &error))
+      << error;
+  // 2 MB allocated, every 64 KB sampled.
+  EXPECT_GE(num_samples, 20);
+  EXPECT_EQ(num_dropped, 0);
+
+  std::ifstream in(output_file, std::ios::binary);
+  const std::string profile((std::istreambuf_iterator<char>(in)),
+                            std::istreambuf_iterator<char>());
+  ASSERT_FALSE(profile.empty());
+  // Starts with the sample_type field of perftools.profiles.Profile.
+  EXPECT_EQ(profile[0], '\x0a');
+  EXPECT_NE(profile.find("alloc_space"), std::string::npos);
+  EXPECT_NE(profile.find("alloc_tracker_test"), std::string::npos);
+  std::remove(output_file.c_str());
+}
+
+}  // namespace cyber
+}  // namespace apollo
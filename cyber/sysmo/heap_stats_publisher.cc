@@ -0,0 +1,155 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/sysmo/heap_stats_publisher.h"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <vector>
+
+#include "cyber/binary.h"
+#include "cyber/common/global_data.h"
+#include "cyber/time/time.h"
+
+namespace apollo {
+namespace cyber {
+
+using apollo::cyber::common::GlobalData;
+
+namespace {
+
+uint64_t ResidentBytes() {
+  std::ifstream statm("/proc/self/statm");
+  uint64_t size = 0;
+  uint64_t resident = 0;
+  if (!(statm >> size >> resident)) {
+    return 0;
+  }
+  return resident * static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+}
+
+}  // namespace
+
+const char HeapStatsPublisher::kHeapStatsChannel[] = "/cyber/heap_stats";
+
+HeapStatsPublisher::HeapStatsPublisher() {}
+
+std::string HeapStatsPublisher::ModuleName(const std::string& croutine) {
+  return croutine.substr(0, croutine.find("_/"));
+}
+
+void HeapStatsPublisher::Start(std::unique_ptr<Node> node) {
+  if (start_ || node == nullptr || !AllocTracker::enabled()) {
+    return;
+  }
+  node_ = std::move(node);
+  writer_ = node_->CreateWriter<proto::HeapStats>(kHeapStatsChannel);
+  if (writer_ == nullptr) {
+    AERROR << "create writer of " << kHeapStatsChannel << " failed.";
+    node_.reset();
+    return;
+  }
+
+  const char* interval = std::getenv("CYBER_HEAP_STATS_INTERVAL_MS");
+  if (interval != nullptr && interval[0] != '\0') {
+    interval_ms_ = std::max(std::atoi(interval), 10);
+  }
+  last_report_time_ = Time::Now().ToNanosecond();
+  start_ = true;
+  thread_ = std::thread(&HeapStatsPublisher::Run, this);
+}
+
+void HeapStatsPublisher::Shutdown() {
+  if (!start_ || shut_down_.exchange(true)) {
+    return;
+  }
+
+  cv_.notify_all();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+  writer_.reset();
+  node_.reset();
+}
+
+void HeapStatsPublisher::Run() {
+  while (!shut_down_.load()) {
+    {
+      std::unique_lock<std::mutex> lk(lk_);
+      cv_.wait_for(lk, std::chrono::milliseconds(interval_ms_),
+                   [this] { return shut_down_.load(); });
+    }
+    if (shut_down_.load()) {
+      break;
+    }
+    Report(Time::Now().ToNanosecond());
+  }
+}
+
+void HeapStatsPublisher::Report(uint64_t now) {
+  std::vector<AllocUsage> usages;
+  AllocTracker::Collect(&usages);
+  double interval = static_cast<double>(now - last_report_time_) / 1e9;
+  last_report_time_ = now;
+
+  auto msg = std::make_shared<proto::HeapStats>();
+  msg->set_host_name(GlobalData::Instance()->HostName());
+  msg->set_process_id(GlobalData::Instance()->ProcessId());
+  msg->set_process_name(binary::GetName());
+  msg->set_timestamp(now);
+  msg->set_interval(interval);
+  msg->set_rss_bytes(ResidentBytes());
+
+  std::map<std::string, AllocUsage> modules;
+  for (const auto& usage : usages) {
+    auto& module = modules[ModuleName(usage.croutine)];
+    module.alloc_count += usage.alloc_count;
+    module.alloc_bytes += usage.alloc_bytes;
+    module.free_count += usage.free_count;
+    module.free_bytes += usage.free_bytes;
+    FillUsage(usage.croutine, usage, interval,
+              &last_croutines_[usage.croutine], msg->add_croutine());
+  }
+  for (const auto& module : modules) {
+    FillUsage(module.first, module.second, interval,
+              &last_modules_[module.first], msg->add_module());
+  }
+  writer_->Write(msg);
+}
+
+void HeapStatsPublisher::FillUsage(const std::string& name,
+                                   const AllocUsage& usage, double interval,
+                                   AllocUsage* last, proto::HeapUsage* stats) {
+  stats->set_name(name);
+  stats->set_alloc_count(usage.alloc_count);
+  stats->set_alloc_bytes(usage.alloc_bytes);
+  stats->set_free_count(usage.free_count);
+  stats->set_free_bytes(usage.free_bytes);
+  if (interval > 0) {
+    stats->set_alloc_rate((usage.alloc_count - last->alloc_count) / interval);
+    stats->set_alloc_byte_rate((usage.alloc_bytes - last->alloc_bytes) /
+                               interval);
+  }
+  *last = usage;
+}
+
+}  // namespace cyber
+}  // namespace apollo
@@ -0,0 +1,85 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_SYSMO_HEAP_STATS_PUBLISHER_H_
+#define CYBER_SYSMO_HEAP_STATS_PUBLISHER_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+#include "cyber/proto/heap_stats.pb.h"
+
+#include "cyber/common/macros.h"
+#include "cyber/node/node.h"
+#include "cyber/sysmo/alloc_tracker.h"
+
+namespace apollo {
+namespace cyber {
+
+/**
+ * @class HeapStatsPublisher
+ * @brief Publishes the allocations the AllocTracker counted in this process,
+ * by module and by croutine, on kHeapStatsChannel every
+ * CYBER_HEAP_STATS_INTERVAL_MS (default 1000) milliseconds.
+ */
+class HeapStatsPublisher {
+ public:
+  static const char kHeapStatsChannel[];
+
+  /**
+   * @brief The module a croutine works for: the node of the croutines of
+   * readers, named <node>_<channel>, and the croutine itself otherwise.
+   */
+  static std::string ModuleName(const std::string& croutine);
+
+  // takes over the node the writer is created on, Init() owns the right to
+  // construct it
+  void Start(std::unique_ptr<Node> node);
+  void Shutdown();
+
+ private:
+  void Run();
+  void Report(uint64_t now);
+  // Fills stats with usage and its rates since last, then moves it to last.
+  static void FillUsage(const std::string& name, const AllocUsage& usage,
+                        double interval, AllocUsage* last,
+                        proto::HeapUsage* stats);
+
+  std::unique_ptr<Node> node_;
+  std::shared_ptr<Writer<proto::HeapStats>> writer_;
+  std::unordered_map<std::string, AllocUsage> last_croutines_;
+  std::unordered_map<std::string, AllocUsage> last_modules_;
+  uint64_t last_report_time_ = 0;
+
+  int interval_ms_ = 1000;
+  std::atomic<bool> shut_down_{false};
+  bool start_ = false;
+  std::condition_variable cv_;
+  std::mutex lk_;
+  std::thread thread_;
+
+  DECLARE_SINGLETON(HeapStatsPublisher);
+};
+
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_SYSMO_HEAP_STATS_PUBLISHER_H_
@@ -0,0 +1,136 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+// Replaces the allocation functions of glibc with ones forwarding to them and
+// reporting to the AllocTracker, which costs a relaxed load per call until
+// AllocTracker::Enable(). The sanitizers bring their own, which are kept.
+
+#include <errno.h>
+#include <malloc.h>
+#include <unistd.h>
+
+#include <cstddef>
+#include <cstdint>
+
+#include "cyber/sysmo/alloc_tracker.h"
+
+#if defined(__has_feature)
+#if __has_feature(address_sanitizer) || __has_feature(thread_sanitizer) || \
+    __has_feature(memory_sanitizer)
+#define CYBER_NO_MALLOC_INTERPOSER
+#endif
+#endif
+#if defined(__SANITIZE_ADDRESS__) || defined(__SANITIZE_THREAD__) || \
+    !defined(__GLIBC__)
+#define CYBER_NO_MALLOC_INTERPOSER
+#endif
+
+#ifndef CYBER_NO_MALLOC_INTERPOSER
+
+using apollo::cyber::AllocTracker;
+
+extern "C" {
+
+void* __libc_malloc(size_t size);
+void __libc_free(void* ptr);
+void* __libc_calloc(size_t num, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void* __libc_memalign(size_t alignment, size_t size);
+void* __libc_valloc(size_t size);
+void* __libc_pvalloc(size_t size);
+}
+
+namespace {
+
+// Tells the tracker that the functions below are in place.
+struct Interposed {
+  Interposed() { AllocTracker::MarkInterposed(); }
+} interposed;
+
+inline void* Track(void* ptr) {
+  if (ptr != nullptr && AllocTracker::enabled()) {
+    AllocTracker::OnAlloc(malloc_usable_size(ptr));
+  }
+  return ptr;
+}
+
+}  // namespace
+
+extern "C" {
+
+void* malloc(size_t size) noexcept { return Track(__libc_malloc(size)); }
+
+void free(void* ptr) noexcept {
+  if (ptr != nullptr && AllocTracker::enabled()) {
+    AllocTracker::OnFree(malloc_usable_size(ptr));
+  }
+  __libc_free(ptr);
+}
+
+void* calloc(size_t num, size_t size) noexcept {
+  return Track(__libc_calloc(num, size));
+}
+
+void* realloc(void* ptr, size_t size) noexcept {
+  if (!AllocTracker::enabled()) {
+    return __libc_realloc(ptr, size);
+  }
+  const size_t old_size = ptr == nullptr ? 0 : malloc_usable_size(ptr);
+  void* result = __libc_realloc(ptr, size);
+  // The old block is kept when the new one fails.
+  if (ptr != nullptr && (result != nullptr || size == 0)) {
+    AllocTracker::OnFree(old_size);
+  }
+  return Track(result);
+}
+
+void* reallocarray(void* ptr, size_t num, size_t size) noexcept {
+  size_t total = 0;
+  if (__builtin_mul_overflow(num, size, &total)) {
+    errno = ENOMEM;
+    return nullptr;
+  }
+  return realloc(ptr, total);
+}
+
+void* memalign(size_t alignment, size_t size) noexcept {
+  return Track(__libc_memalign(alignment, size));
+}
+
+void* aligned_alloc(size_t alignment, size_t size) noexcept {
+  return Track(__libc_memalign(alignment, size));
+}
+
+int posix_memalign(void** ptr, size_t alignment, size_t size) noexcept {
+  if (alignment == 0 || alignment % sizeof(void*) != 0 ||
+      (alignment & (alignment - 1)) != 0) {
+    return EINVAL;
+  }
+  void* result = __libc_memalign(alignment, size);
+  if (result == nullptr) {
+    return ENOMEM;
+  }
+  *ptr = Track(result);
+  return 0;
+}
+
+void* valloc(size_t size) noexcept { return Track(__libc_valloc(size)); }
+
+void* pvalloc(size_t size) noexcept { return Track(__libc_pvalloc(size)); }
+
+}  // extern "C"
+
+#endif  // CYBER_NO_MALLOC_INTERPOSER
@@ -0,0 +1,237 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/sysmo/profile_encoder.h"
+
+#include <cxxabi.h>
+#include <dlfcn.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+
+namespace apollo {
+namespace cyber {
+
+namespace {
+
+// A frame pointer further than this from the one below is taken as garbage.
+constexpr uintptr_t kMaxFrameSize = 100000;
+
+}  // namespace
+
+int WalkFramePointers(uintptr_t fp, uintptr_t lower_bound, uintptr_t* pcs,
+                      int max_depth) {
+  // Only async signal safe calls from here on, and no allocation.
+  int depth = 0;
+  // Each frame holds the frame pointer of its caller and the return address.
+  while (depth < max_depth && fp > lower_bound &&
+         fp - lower_bound < kMaxFrameSize && fp % sizeof(uintptr_t) == 0) {
+    const uintptr_t* frame = reinterpret_cast<const uintptr_t*>(fp);
+    if (frame[1] == 0) {
+      break;
+    }
+    // Point into the call instruction rather than after it.
+    pcs[depth++] = frame[1] - 1;
+    lower_bound = fp;
+    fp = frame[0];
+  }
+  return depth;
+}
+
+ProfileEncoder::ProfileEncoder() {
+  Intern("");
+  ReadMappings();
+}
+
+void ProfileEncoder::ReadMappings() {
+  std::ifstream maps("/proc/self/maps");
+  std::string line;
+  while (std::getline(maps, line)) {
+    uint64_t start = 0;
+    uint64_t limit = 0;
+    uint64_t offset = 0;
+    char perms[5] = {0};
+    int path_pos = 0;
+    if (sscanf(line.c_str(), "%lx-%lx %4s %lx %*s %*s %n", &start, &limit,
+               perms, &offset, &path_pos) < 4 ||
+        perms[2] != 'x') {
+      continue;
+    }
+    mappings_.push_back({start, limit, offset, line.substr(path_pos)});
+  }
+}
+
+int64_t ProfileEncoder::Intern(const std::string& str) {
+  auto result = strings_.emplace(str, strings_.size());
+  if (result.second) {
+    string_table_.push_back(str);
+  }
+  return result.first->second;
+}
+
+void ProfileEncoder::AddValueType(int field, const std::string& type,
+                                  const std::string& unit) {
+  std::string message;
+  AppendVarint(1, Intern(type), &message);
+  AppendVarint(2, Intern(unit), &message);
+  AppendMessage(field, message, &profile_);
+}
+
+std::vector<uint64_t> ProfileEncoder::AddStack(
+    const std::vector<uintptr_t>& addresses) {
+  std::vector<uint64_t> location_ids;
+  location_ids.reserve(addresses.size());
+  for (const uintptr_t address : addresses) {
+    auto result = locations_.emplace(address, locations_.size() + 1);
+    location_ids.push_back(result.first->second);
+    if (!result.second) {
+      continue;
+    }
+    uint64_t mapping_id = 0;
+    for (size_t i = 0; i < mappings_.size(); ++i) {
+      if (address >= mappings_[i].start && address < mappings_[i].limit) {
+        mapping_id = i + 1;
+        break;
+      }
+    }
+    uint64_t function_id = 0;
+    Dl_info info;
+    if (dladdr(reinterpret_cast<void*>(address), &info) != 0 &&
+        info.dli_sname != nullptr) {
+      auto function = functions_.emplace(info.dli_sname, functions_.size() + 1);
+      function_id = function.first->second;
+      if (function.second) {
+        int status = 0;
+        char* demangled =
+            abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+        AddFunction(function_id, status == 0 ? demangled : info.dli_sname,
+                    info.dli_sname);
+        free(demangled);
+      }
+    }
+    AddLocation(result.first->second, mapping_id, address, function_id);
+  }
+  return location_ids;
+}
+
+void ProfileEncoder::AddFunction(uint64_t id, const std::string& name,
+                                 const std::string& system_name) {
+  std::string message;
+  AppendVarint(1, id, &message);
+  AppendVarint(2, Intern(name), &message);
+  AppendVarint(3, Intern(system_name), &message);
+  AppendMessage(5, message, &profile_);
+}
+
+void ProfileEncoder::AddLocation(uint64_t id, uint64_t mapping_id,
+                                 uint64_t address, uint64_t function_id) {
+  std::string message;
+  AppendVarint(1, id, &message);
+  if (mapping_id != 0) {
+    AppendVarint(2, mapping_id, &message);
+  }
+  AppendVarint(3, address, &message);
+  if (function_id != 0) {
+    std::string line;
+    AppendVarint(1, function_id, &line);
+    AppendMessage(4, line, &message);
+  }
+  AppendMessage(4, message, &profile_);
+}
+
+void ProfileEncoder::AddSample(
+    const std::vector<uint64_t>& location_ids,
+    const std::vector<int64_t>& values,
+    const std::vector<std::pair<std::string, std::string>>& labels) {
+  std::string message;
+  std::string packed;
+  for (const uint64_t id : location_ids) {
+    AppendRawVarint(id, &packed);
+  }
+  AppendMessage(1, packed, &message);
+  packed.clear();
+  for (const int64_t value : values) {
+    AppendRawVarint(static_cast<uint64_t>(value), &packed);
+  }
+  AppendMessage(2, packed, &message);
+  for (const auto& label : labels) {
+    std::string label_message;
+    AppendVarint(1, Intern(label.first), &label_message);
+    AppendVarint(2, Intern(label.second), &label_message);
+    AppendMessage(3, label_message, &message);
+  }
+  AppendMessage(2, message, &profile_);
+}
+
+void ProfileEncoder::AddVarint(int field, uint64_t value) {
+  AppendVarint(field, value, &profile_);
+}
+
+std::string ProfileEncoder::Finish() {
+  for (size_t i = 0; i < mappings_.size(); ++i) {
+    std::string message;
+    AppendVarint(1, i + 1, &message);
+    AppendVarint(2, mappings_[i].start, &message);
+    AppendVarint(3, mappings_[i].limit, &message);
+    AppendVarint(4, mappings_[i].offset, &message);
+    AppendVarint(5, Intern(mappings_[i].file), &message);
+    AppendMessage(3, message, &profile_);
+  }
+  mappings_.clear();
+  for (const auto& str : string_table_) {
+    AppendMessage(6, str, &profile_);
+  }
+  string_table_.clear();
+  return std::move(profile_);
+}
+
+bool ProfileEncoder::WriteFile(const std::string& output_file,
+                               std::string* error) {
+  const std::string profile = Finish();
+  std::ofstream out(output_file, std::ios::binary | std::ios::trunc);
+  out.write(profile.data(), profile.size());
+  out.close();
+  if (!out) {
+    *error = "failed to write " + output_file;
+    return false;
+  }
+  return true;
+}
+
+void ProfileEncoder::AppendRawVarint(uint64_t value, std::string* out) {
+  while (value >= 0x80) {
+    out->push_back(static_cast<char>(value | 0x80));
+    value >>= 7;
+  }
+  out->push_back(static_cast<char>(value));
+}
+
+void ProfileEncoder::AppendVarint(int field, uint64_t value,
+                                  std::string* out) {
+  AppendRawVarint(field << 3, out);
+  AppendRawVarint(value, out);
+}
+
+void ProfileEncoder::AppendMessage(int field, const std::string& message,
+                                   std::string* out) {
+  AppendRawVarint(field << 3 | 2, out);
+  AppendRawVarint(message.size(), out);
+  out->append(message);
+}
+
+}  // namespace cyber
+}  // namespace apollo
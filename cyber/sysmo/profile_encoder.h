@@ -0,0 +1,106 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_SYSMO_PROFILE_ENCODER_H_
+#define CYBER_SYSMO_PROFILE_ENCODER_H_
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace apollo {
+namespace cyber {
+
+/**
+ * @brief Walk the frame pointers up from the frame fp, whose caller frames
+ * lie above lower_bound, and store the return addresses into pcs.
+ * @return The number of addresses stored.
+ */
+int WalkFramePointers(uintptr_t fp, uintptr_t lower_bound, uintptr_t* pcs,
+                      int max_depth);
+
+/**
+ * @class ProfileEncoder
+ * @brief Writes the messages of perftools.profiles.Profile, see
+ * https://github.com/google/pprof/blob/master/proto/profile.proto, for the
+ * stacks of this process.
+ */
+class ProfileEncoder {
+ public:
+  // Index 0 of the string table is the empty string.
+  ProfileEncoder();
+
+  int64_t Intern(const std::string& str);
+
+  void AddValueType(int field, const std::string& type,
+                    const std::string& unit);
+
+  /**
+   * @brief The location ids of the addresses, adding the locations not seen
+   * before. The exported symbols are named here, pprof looks up the others in
+   * the mapped files.
+   */
+  std::vector<uint64_t> AddStack(const std::vector<uintptr_t>& addresses);
+
+  void AddSample(const std::vector<uint64_t>& location_ids,
+                 const std::vector<int64_t>& values,
+                 const std::vector<std::pair<std::string, std::string>>&
+                     labels);
+
+  void AddVarint(int field, uint64_t value);
+
+  std::string Finish();
+
+  /**
+   * @brief Finish the profile and write it to output_file.
+   */
+  bool WriteFile(const std::string& output_file, std::string* error);
+
+ private:
+  struct Mapping {
+    uint64_t start;
+    uint64_t limit;
+    uint64_t offset;
+    std::string file;
+  };
+
+  void ReadMappings();
+  void AddFunction(uint64_t id, const std::string& name,
+                   const std::string& system_name);
+  void AddLocation(uint64_t id, uint64_t mapping_id, uint64_t address,
+                   uint64_t function_id);
+
+  static void AppendRawVarint(uint64_t value, std::string* out);
+  static void AppendVarint(int field, uint64_t value, std::string* out);
+  static void AppendMessage(int field, const std::string& message,
+                            std::string* out);
+
+  std::string profile_;
+  std::unordered_map<std::string, int64_t> strings_;
+  std::vector<std::string> string_table_;
+  // The executable mappings of the process, which pprof symbolizes the
+  // addresses the function names are not found for with.
+  std::vector<Mapping> mappings_;
+  std::unordered_map<uintptr_t, uint64_t> locations_;
+  std::unordered_map<std::string, uint64_t> functions_;
+};
+
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_SYSMO_PROFILE_ENCODER_H_
@@ -0,0 +1,242 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/sysmo/sampling_profiler.h"
+
+#include <sys/prctl.h>
+#include <sys/time.h>
+#include <ucontext.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "cyber/common/log.h"
+#include "cyber/croutine/croutine.h"
+#include "cyber/sysmo/profile_encoder.h"
+#include "cyber/time/time.h"
+
+namespace apollo {
+namespace cyber {
+
+namespace {
+
+std::atomic<SamplingProfiler*> active_profiler{nullptr};
+
+void CopyName(const char* name, char* dest, size_t size) {
+  size_t i = 0;
+  for (; i + 1 < size && name[i] != '\0'; ++i) {
+    dest[i] = name[i];
+  }
+  dest[i] = '\0';
+}
+
+}  // namespace
+
+SamplingProfiler::SamplingProfiler() {}
+
+SamplingProfiler::~SamplingProfiler() {
+  if (IsRunning()) {
+    uint64_t num_samples = 0;
+    uint64_t num_dropped = 0;
+    std::string error;
+    Stop("", &num_samples, &num_dropped, &error);
+  }
+}
+
+bool SamplingProfiler::IsRunning() const {
+  return running_.load(std::memory_order_acquire);
+}
+
+bool SamplingProfiler::Start(uint32_t frequency, uint32_t max_samples,
+                             std::string* error) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (IsRunning()) {
+    *error = "the profiler is already running";
+    return false;
+  }
+  if (frequency == 0 || frequency > 1000 || max_samples == 0) {
+    *error = "the frequency must be in [1, 1000] and max_samples positive";
+    return false;
+  }
+  samples_.reset(new (std::nothrow) Sample[max_samples]);
+  if (samples_ == nullptr) {
+    *error = "failed to allocate the samples";
+    return false;
+  }
+  max_samples_ = max_samples;
+  next_sample_.store(0, std::memory_order_relaxed);
+  period_ = 1000000000UL / frequency;
+  start_time_ = Time::Now().ToNanosecond();
+
+  struct sigaction action;
+  memset(&action, 0, sizeof(action));
+  action.sa_sigaction = &SamplingProfiler::OnSignal;
+  action.sa_flags = SA_RESTART | SA_SIGINFO;
+  sigemptyset(&action.sa_mask);
+  active_profiler.store(this, std::memory_order_release);
+  running_.store(true, std::memory_order_release);
+  if (sigaction(SIGPROF, &action, &old_action_) != 0) {
+    running_.store(false, std::memory_order_release);
+    *error = std::string("sigaction: ") + strerror(errno);
+    return false;
+  }
+
+  struct itimerval timer;
+  timer.it_interval.tv_sec = static_cast<time_t>(period_ / 1000000000UL);
+  timer.it_interval.tv_usec =
+      static_cast<suseconds_t>(period_ % 1000000000UL / 1000);
+  timer.it_value = timer.it_interval;
+  if (setitimer(ITIMER_PROF, &timer, nullptr) != 0) {
+    running_.store(false, std::memory_order_release);
+    sigaction(SIGPROF, &old_action_, nullptr);
+    *error = std::string("setitimer: ") + strerror(errno);
+    return false;
+  }
+  AINFO << "Start sampling stacks at " << frequency << " Hz.";
+  return true;
+}
+
+bool SamplingProfiler::Stop(const std::string& output_file,
+                            uint64_t* num_samples, uint64_t* num_dropped,
+                            std::string* error) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!IsRunning()) {
+    *error = "the profiler is not running";
+    return false;
+  }
+  struct itimerval timer;
+  memset(&timer, 0, sizeof(timer));
+  setitimer(ITIMER_PROF, &timer, nullptr);
+  running_.store(false, std::memory_order_seq_cst);
+  // Wait for the handlers taking a sample on other threads. The signal stays
+  // handled, a pending one would kill the process otherwise.
+  while (in_handler_.load(std::memory_order_seq_cst) != 0) {
+    std::this_thread::yield();
+  }
+
+  const uint64_t taken = next_sample_.load(std::memory_order_relaxed);
+  *num_samples = std::min<uint64_t>(taken, max_samples_);
+  *num_dropped = taken - *num_samples;
+  const bool success =
+      output_file.empty() || WriteProfile(output_file, *num_samples, error);
+  samples_.reset();
+  AINFO << "Stop sampling stacks, " << *num_samples << " samples taken, "
+        << *num_dropped << " dropped.";
+  return success;
+}
+
+void SamplingProfiler::OnSignal(int signal, siginfo_t* info, void* context) {
+  UNUSED(signal);
+  UNUSED(info);
+  SamplingProfiler* profiler = active_profiler.load(std::memory_order_acquire);
+  if (profiler == nullptr) {
+    return;
+  }
+  const int saved_errno = errno;
+  profiler->in_handler_.fetch_add(1, std::memory_order_seq_cst);
+  if (profiler->running_.load(std::memory_order_seq_cst)) {
+    profiler->TakeSample(context);
+  }
+  profiler->in_handler_.fetch_sub(1, std::memory_order_seq_cst);
+  errno = saved_errno;
+}
+
+void SamplingProfiler::TakeSample(void* context) {
+  const uint64_t index = next_sample_.fetch_add(1, std::memory_order_relaxed);
+  if (index >= max_samples_) {
+    return;
+  }
+  Sample& sample = samples_[index];
+  sample.depth = 0;
+
+  // Only async signal safe calls from here on.
+  uintptr_t pc = 0;
+  uintptr_t fp = 0;
+  uintptr_t sp = 0;
+  const ucontext_t* ucontext = static_cast<const ucontext_t*>(context);
+#if defined(__x86_64__)
+  pc = static_cast<uintptr_t>(ucontext->uc_mcontext.gregs[REG_RIP]);
+  fp = static_cast<uintptr_t>(ucontext->uc_mcontext.gregs[REG_RBP]);
+  sp = static_cast<uintptr_t>(ucontext->uc_mcontext.gregs[REG_RSP]);
+#elif defined(__aarch64__)
+  pc = static_cast<uintptr_t>(ucontext->uc_mcontext.pc);
+  fp = static_cast<uintptr_t>(ucontext->uc_mcontext.regs[29]);
+  sp = static_cast<uintptr_t>(ucontext->uc_mcontext.sp);
+#else
+  UNUSED(ucontext);
+#endif
+  if (pc != 0) {
+    sample.pcs[sample.depth++] = pc;
+  }
+  sample.depth += WalkFramePointers(fp, sp, sample.pcs + sample.depth,
+                                    kMaxDepth - sample.depth);
+
+  const auto* routine = croutine::CRoutine::GetCurrentRoutine();
+  CopyName(routine == nullptr ? "" : routine->name().c_str(), sample.croutine,
+           sizeof(sample.croutine));
+  if (prctl(PR_GET_NAME, sample.thread) != 0) {
+    sample.thread[0] = '\0';
+  }
+}
+
+bool SamplingProfiler::WriteProfile(const std::string& output_file,
+                                    uint64_t num_samples,
+                                    std::string* error) const {
+  ProfileEncoder encoder;
+  encoder.AddValueType(1, "samples", "count");
+  encoder.AddValueType(1, "cpu", "nanoseconds");
+
+  // Merge the samples of the same stack and labels.
+  std::map<std::tuple<std::vector<uintptr_t>, std::string, std::string>,
+           int64_t>
+      stacks;
+  for (uint64_t i = 0; i < num_samples; ++i) {
+    const Sample& sample = samples_[i];
+    ++stacks[std::make_tuple(
+        std::vector<uintptr_t>(sample.pcs, sample.pcs + sample.depth),
+        std::string(sample.croutine), std::string(sample.thread))];
+  }
+
+  for (const auto& stack : stacks) {
+    std::vector<std::pair<std::string, std::string>> labels;
+    if (!std::get<1>(stack.first).empty()) {
+      labels.emplace_back("croutine", std::get<1>(stack.first));
+    }
+    if (!std::get<2>(stack.first).empty()) {
+      labels.emplace_back("thread", std::get<2>(stack.first));
+    }
+    encoder.AddSample(encoder.AddStack(std::get<0>(stack.first)),
+                      {stack.second, stack.second * static_cast<int64_t>(
+                                                        period_)},
+                      labels);
+  }
+
+  encoder.AddVarint(9, start_time_);
+  encoder.AddVarint(10, Time::Now().ToNanosecond() - start_time_);
+  encoder.AddValueType(11, "cpu", "nanoseconds");
+  encoder.AddVarint(12, period_);
+  return encoder.WriteFile(output_file, error);
+}
+
+}  // namespace cyber
+}  // namespace apollo
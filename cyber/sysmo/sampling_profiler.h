@@ -0,0 +1,95 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_SYSMO_SAMPLING_PROFILER_H_
+#define CYBER_SYSMO_SAMPLING_PROFILER_H_
+
+#include <signal.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "cyber/common/macros.h"
+
+namespace apollo {
+namespace cyber {
+
+/**
+ * @class SamplingProfiler
+ * @brief Samples the stacks of the threads of this process on SIGPROF, which
+ * the kernel sends every period of cpu time they take, and writes them as a
+ * pprof profile. The samples are labeled with the croutine they interrupted,
+ * named after its component, and with the name of the thread.
+ *
+ * The stacks are walked along the frame pointers, which is safe in a signal
+ * handler, so that only the leaf functions of code built with
+ * -fomit-frame-pointer are seen.
+ */
+class SamplingProfiler {
+ public:
+  static constexpr int kMaxDepth = 64;
+  static constexpr int kMaxNameLength = 48;
+
+  ~SamplingProfiler();
+
+  bool Start(uint32_t frequency, uint32_t max_samples, std::string* error);
+
+  /**
+   * @brief Stop sampling and write the samples taken since Start(), or drop
+   * them if output_file is empty.
+   * @param num_samples The number of samples written.
+   * @param num_dropped The number of samples dropped past max_samples.
+   */
+  bool Stop(const std::string& output_file, uint64_t* num_samples,
+            uint64_t* num_dropped, std::string* error);
+
+  bool IsRunning() const;
+
+ private:
+  struct Sample {
+    uintptr_t pcs[kMaxDepth];
+    int depth;
+    char croutine[kMaxNameLength];
+    char thread[16];
+  };
+
+  static void OnSignal(int signal, siginfo_t* info, void* context);
+  void TakeSample(void* context);
+  bool WriteProfile(const std::string& output_file, uint64_t num_samples,
+                    std::string* error) const;
+
+  std::mutex mutex_;
+  struct sigaction old_action_;
+  uint64_t start_time_ = 0;
+  uint64_t period_ = 0;
+  std::unique_ptr<Sample[]> samples_;
+  uint32_t max_samples_ = 0;
+
+  // Read and written by the signal handler.
+  std::atomic<bool> running_{false};
+  std::atomic<int> in_handler_{0};
+  std::atomic<uint64_t> next_sample_{0};
+
+  DECLARE_SINGLETON(SamplingProfiler)
+};
+
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_SYSMO_SAMPLING_PROFILER_H_
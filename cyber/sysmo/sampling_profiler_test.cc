@@ -0,0 +1,85 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/sysmo/sampling_profiler.h"
+
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace cyber {
+
+namespace {
+
+double Spin(std::chrono::milliseconds duration) {
+  const auto end = std::chrono::steady_clock::now() + duration;
+  double sum = 0.0;
+  while (std::chrono::steady_clock::now() < end) {
+    for (int i = 1; i < 1000; ++i) {
+      sum += std::sqrt(static_cast<double>(i));
+    }
+  }
+  return sum;
+}
+
+}  // namespace
+
+TEST(SamplingProfilerTest, WriteProfile) {
+  auto profiler = SamplingProfiler::Instance();
+  std::string error;
+  uint64_t num_samples = 0;
+  uint64_t num_dropped = 0;
+  EXPECT_FALSE(profiler->Stop("", &num_samples, &num_dropped, &error));
+  EXPECT_FALSE(profiler->Start(0, 100, &error));
+
+  ASSERT_TRUE(profiler->Start(1000, 100000, &error)) << error;
+  EXPECT_TRUE(profiler->IsRunning());
+  EXPECT_FALSE(profiler->Start(1000, 100000, &error));
+  EXPECT_GT(Spin(std::chrono::milliseconds(300)), 0.0);
+
+  const std::string output_file = "sampling_profiler_test.pprof";
+  ASSERT_TRUE(
+      profiler->Stop(output_file, &num_samples, &num_dropped, &error))
+      << error;
+  EXPECT_FALSE(profiler->IsRunning());
+  EXPECT_GT(num_samples, 0);
+  EXPECT_EQ(num_dropped, 0);
+
+  std::ifstream in(output_file, std::ios::binary);
+  const std::string profile((std::istreambuf_iterator<char>(in)),
+                            std::istreambuf_iterator<char>());
+  ASSERT_FALSE(profile.empty());
+  // Starts with the sample_type field of perftools.profiles.Profile.
+  EXPECT_EQ(profile[0], '\x0a');
+  EXPECT_NE(profile.find("cpu"), std::string::npos);
+  EXPECT_NE(profile.find("nanoseconds"), std::string::npos);
+  std::remove(output_file.c_str());
+
+  // Too few samples kept.
+  ASSERT_TRUE(profiler->Start(1000, 1, &error)) << error;
+  EXPECT_GT(Spin(std::chrono::milliseconds(100)), 0.0);
+  ASSERT_TRUE(profiler->Stop("", &num_samples, &num_dropped, &error));
+  EXPECT_EQ(num_samples, 1);
+  EXPECT_GT(num_dropped, 0);
+}
+
+}  // namespace cyber
+}  // namespace apollo
@@ -0,0 +1,143 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/sysmo/scheduler_load_publisher.h"
+
+#include <chrono>
+#include <utility>
+
+#include "cyber/binary.h"
+#include "cyber/common/global_data.h"
+#include "cyber/scheduler/common/load_timeline.h"
+#include "cyber/scheduler/scheduler_factory.h"
+#include "cyber/time/time.h"
+#include "cyber/timer/timer_phase_allocator.h"
+
+namespace apollo {
+namespace cyber {
+
+using apollo::cyber::common::GlobalData;
+using apollo::cyber::scheduler::LoadTimeline;
+using apollo::cyber::scheduler::ProcessorLoad;
+
+const char SchedulerLoadPublisher::kSchedulerLoadChannel[] =
+    "/cyber/scheduler_load";
+
+SchedulerLoadPublisher::SchedulerLoadPublisher() {}
+
+void SchedulerLoadPublisher::Start(std::unique_ptr<Node> node) {
+  if (start_ || node == nullptr || !LoadTimeline::Enabled()) {
+    return;
+  }
+  node_ = std::move(node);
+  writer_ = node_->CreateWriter<proto::SchedulerLoad>(kSchedulerLoadChannel);
+  if (writer_ == nullptr) {
+    AERROR << "create writer of " << kSchedulerLoadChannel << " failed.";
+    node_.reset();
+    return;
+  }
+  std::vector<ProcessorLoad> loads;
+  scheduler::Instance()->CollectLoad(&loads);
+  for (auto& load : loads) {
+    last_busy_ns_[load.processor_id] = std::move(load.busy_ns);
+  }
+  last_report_time_ = Time::MonoTime().ToNanosecond();
+  start_ = true;
+  thread_ = std::thread(&SchedulerLoadPublisher::Run, this);
+}
+
+void SchedulerLoadPublisher::Shutdown() {
+  if (!start_ || shut_down_.exchange(true)) {
+    return;
+  }
+
+  cv_.notify_all();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+  writer_.reset();
+  node_.reset();
+}
+
+void SchedulerLoadPublisher::Run() {
+  while (!shut_down_.load()) {
+    {
+      std::unique_lock<std::mutex> lk(lk_);
+      cv_.wait_for(lk, std::chrono::seconds(1),
+                   [this] { return shut_down_.load(); });
+    }
+    if (shut_down_.load()) {
+      break;
+    }
+    Report(Time::MonoTime().ToNanosecond());
+  }
+}
+
+void SchedulerLoadPublisher::Report(uint64_t now) {
+  std::vector<ProcessorLoad> loads;
+  scheduler::Instance()->CollectLoad(&loads);
+  std::vector<TimerPhase> timers;
+  TimerPhaseAllocator::Instance()->GetTimers(&timers);
+  uint64_t interval = now - last_report_time_;
+  last_report_time_ = now;
+  // every slot recurs once per window
+  double slot_ns = static_cast<double>(interval) / LoadTimeline::kSlots;
+
+  auto msg = std::make_shared<proto::SchedulerLoad>();
+  msg->set_host_name(GlobalData::Instance()->HostName());
+  msg->set_process_id(GlobalData::Instance()->ProcessId());
+  msg->set_process_name(binary::GetName());
+  msg->set_timestamp(Time::Now().ToNanosecond());
+  msg->set_interval(static_cast<double>(interval) / 1e9);
+  msg->set_slot_ms(static_cast<uint32_t>(LoadTimeline::kSlotNs / 1000000));
+  msg->set_window_ms(
+      static_cast<uint32_t>(LoadTimeline::kWindowNs / 1000000));
+  for (const auto& load : loads) {
+    auto& last = last_busy_ns_[load.processor_id];
+    last.resize(load.busy_ns.size(), 0);
+    auto processor = msg->add_processor();
+    processor->set_processor_id(load.processor_id);
+    double total = 0.0;
+    float peak = 0.0f;
+    uint32_t peak_slot = 0;
+    for (size_t i = 0; i < load.busy_ns.size(); ++i) {
+      double busy = static_cast<double>(load.busy_ns[i] - last[i]);
+      float ratio = slot_ns > 0 ? static_cast<float>(busy / slot_ns) : 0.0f;
+      processor->add_busy_ratio(ratio);
+      total += busy;
+      if (ratio > peak) {
+        peak = ratio;
+        peak_slot = static_cast<uint32_t>(i);
+      }
+    }
+    processor->set_peak_ratio(peak);
+    processor->set_peak_slot(peak_slot);
+    if (interval > 0) {
+      processor->set_mean_ratio(static_cast<float>(total / interval));
+    }
+    last = load.busy_ns;
+  }
+  for (const auto& timer : timers) {
+    auto phase = msg->add_timer();
+    phase->set_name(timer.name);
+    phase->set_period_ms(timer.period_ms);
+    phase->set_phase_ms(timer.phase_ms);
+  }
+  writer_->Write(msg);
+}
+
+}  // namespace cyber
+}  // namespace apollo
@@ -0,0 +1,72 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_SYSMO_SCHEDULER_LOAD_PUBLISHER_H_
+#define CYBER_SYSMO_SCHEDULER_LOAD_PUBLISHER_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "cyber/proto/scheduler_load.pb.h"
+
+#include "cyber/common/macros.h"
+#include "cyber/node/node.h"
+
+namespace apollo {
+namespace cyber {
+
+/**
+ * @class SchedulerLoadPublisher
+ * @brief Publishes the per processor LoadTimeline of this process and the
+ * phases of its timers on kSchedulerLoadChannel once a second, where
+ * cyber_monitor shows them. Runs when CYBER_SCHED_LOAD_TIMELINE=1.
+ */
+class SchedulerLoadPublisher {
+ public:
+  static const char kSchedulerLoadChannel[];
+
+  // takes over the node the writer is created on
+  void Start(std::unique_ptr<Node> node);
+  void Shutdown();
+
+ private:
+  void Run();
+  void Report(uint64_t now);
+
+  std::unique_ptr<Node> node_;
+  std::shared_ptr<Writer<proto::SchedulerLoad>> writer_;
+  // busy ns per slot at the last report, by processor id
+  std::unordered_map<int, std::vector<uint64_t>> last_busy_ns_;
+  uint64_t last_report_time_ = 0;
+
+  std::atomic<bool> shut_down_{false};
+  bool start_ = false;
+  std::condition_variable cv_;
+  std::mutex lk_;
+  std::thread thread_;
+
+  DECLARE_SINGLETON(SchedulerLoadPublisher);
+};
+
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_SYSMO_SCHEDULER_LOAD_PUBLISHER_H_
@@ -17,11 +17,13 @@
 #include "cyber/sysmo/sysmo.h"
 
 #include "cyber/common/environment.h"
+#include "cyber/scheduler/common/routine_statistics.h"
 
 namespace apollo {
 namespace cyber {
 
 using apollo::cyber::common::GetEnv;
+using apollo::cyber::scheduler::RoutineStatistics;
 
 SysMo::SysMo() { Start(); }
 
@@ -45,8 +47,12 @@ void SysMo::Shutdown() {
 }
 
 void SysMo::Checker() {
+  uint32_t checks = 0;
   while (cyber_unlikely(!shut_down_.load())) {
     scheduler::Instance()->CheckSchedStatus();
+    if (++checks % routine_stat_interval_ == 0) {
+      AINFO << RoutineStatistics::Instance()->Report();
+    }
     std::unique_lock<std::mutex> lk(lk_);
     cv_.wait_for(lk, std::chrono::milliseconds(sysmo_interval_ms_));
   }
@@ -43,6 +43,8 @@ class SysMo {
   bool start_ = false;
 
   int sysmo_interval_ms_ = 100;
+  // routine timing histograms are logged every this many checks
+  uint32_t routine_stat_interval_ = 10;
   std::condition_variable cv_;
   std::mutex lk_;
   std::thread sysmo_;
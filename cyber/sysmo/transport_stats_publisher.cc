@@ -0,0 +1,125 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/sysmo/transport_stats_publisher.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <vector>
+
+#include "cyber/binary.h"
+#include "cyber/common/global_data.h"
+#include "cyber/time/time.h"
+
+namespace apollo {
+namespace cyber {
+
+using apollo::cyber::common::GlobalData;
+using apollo::cyber::transport::ChannelSample;
+using apollo::cyber::transport::ChannelStatistics;
+
+const char TransportStatsPublisher::kTransportStatsChannel[] =
+    "/cyber/transport_stats";
+
+TransportStatsPublisher::TransportStatsPublisher() {}
+
+void TransportStatsPublisher::Start(std::unique_ptr<Node> node) {
+  if (start_ || node == nullptr || !ChannelStatistics::Instance()->enabled()) {
+    return;
+  }
+  node_ = std::move(node);
+  writer_ = node_->CreateWriter<proto::TransportStats>(kTransportStatsChannel);
+  if (writer_ == nullptr) {
+    AERROR << "create writer of " << kTransportStatsChannel << " failed.";
+    node_.reset();
+    return;
+  }
+
+  const char* interval = std::getenv("CYBER_TRANSPORT_STATS_INTERVAL_MS");
+  if (interval != nullptr && interval[0] != '\0') {
+    interval_ms_ = std::max(std::atoi(interval), 10);
+  }
+  last_report_time_ = Time::Now().ToNanosecond();
+  start_ = true;
+  thread_ = std::thread(&TransportStatsPublisher::Run, this);
+}
+
+void TransportStatsPublisher::Shutdown() {
+  if (!start_ || shut_down_.exchange(true)) {
+    return;
+  }
+
+  cv_.notify_all();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+  writer_.reset();
+  node_.reset();
+}
+
+void TransportStatsPublisher::Run() {
+  while (!shut_down_.load()) {
+    {
+      std::unique_lock<std::mutex> lk(lk_);
+      cv_.wait_for(lk, std::chrono::milliseconds(interval_ms_),
+                   [this] { return shut_down_.load(); });
+    }
+    if (shut_down_.load()) {
+      break;
+    }
+    Report(Time::Now().ToNanosecond());
+  }
+}
+
+void TransportStatsPublisher::Report(uint64_t now) {
+  std::vector<ChannelSample> samples;
+  ChannelStatistics::Instance()->Collect(&samples);
+  double interval = static_cast<double>(now - last_report_time_) / 1e9;
+  last_report_time_ = now;
+
+  auto msg = std::make_shared<proto::TransportStats>();
+  msg->set_host_name(GlobalData::Instance()->HostName());
+  msg->set_process_id(GlobalData::Instance()->ProcessId());
+  msg->set_process_name(binary::GetName());
+  msg->set_timestamp(now);
+  msg->set_interval(interval);
+  for (const auto& sample : samples) {
+    auto& last = last_samples_[sample.channel_id];
+    auto stats = msg->add_channel();
+    stats->set_channel_name(GlobalData::GetChannelById(sample.channel_id));
+    if (interval > 0) {
+      stats->set_tx_msg_rate((sample.tx_msgs - last.tx_msgs) / interval);
+      stats->set_tx_byte_rate((sample.tx_bytes - last.tx_bytes) / interval);
+      stats->set_rx_msg_rate((sample.rx_msgs - last.rx_msgs) / interval);
+      stats->set_rx_byte_rate((sample.rx_bytes - last.rx_bytes) / interval);
+    }
+    auto latency_count = sample.latency_count - last.latency_count;
+    if (latency_count > 0) {
+      stats->set_latency_avg_ns((sample.latency_sum - last.latency_sum) /
+                                latency_count);
+      stats->set_latency_max_ns(sample.latency_max);
+    }
+    stats->set_tx_msgs(sample.tx_msgs);
+    stats->set_rx_msgs(sample.rx_msgs);
+    stats->set_dropped_msgs(sample.dropped);
+    last = sample;
+  }
+  writer_->Write(msg);
+}
+
+}  // namespace cyber
+}  // namespace apollo
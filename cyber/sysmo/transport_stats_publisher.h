@@ -0,0 +1,74 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_SYSMO_TRANSPORT_STATS_PUBLISHER_H_
+#define CYBER_SYSMO_TRANSPORT_STATS_PUBLISHER_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+#include "cyber/proto/transport_stats.pb.h"
+
+#include "cyber/common/macros.h"
+#include "cyber/node/node.h"
+#include "cyber/transport/common/channel_statistics.h"
+
+namespace apollo {
+namespace cyber {
+
+/**
+ * @class TransportStatsPublisher
+ * @brief Publishes the ChannelStatistics of this process on
+ * kTransportStatsChannel every CYBER_TRANSPORT_STATS_INTERVAL_MS (default
+ * 1000) milliseconds, where cyber_monitor and recorders pick them up.
+ */
+class TransportStatsPublisher {
+ public:
+  static const char kTransportStatsChannel[];
+
+  // takes over the node the writer is created on, Init() owns the right to
+  // construct it
+  void Start(std::unique_ptr<Node> node);
+  void Shutdown();
+
+ private:
+  void Run();
+  void Report(uint64_t now);
+
+  std::unique_ptr<Node> node_;
+  std::shared_ptr<Writer<proto::TransportStats>> writer_;
+  std::unordered_map<uint64_t, transport::ChannelSample> last_samples_;
+  uint64_t last_report_time_ = 0;
+
+  int interval_ms_ = 1000;
+  std::atomic<bool> shut_down_{false};
+  bool start_ = false;
+  std::condition_variable cv_;
+  std::mutex lk_;
+  std::thread thread_;
+
+  DECLARE_SINGLETON(TransportStatsPublisher);
+};
+
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_SYSMO_TRANSPORT_STATS_PUBLISHER_H_
@@ -0,0 +1,429 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "cyber/timer/precise_timing_wheel.h"
+
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+#include <cstdlib>
+#include <ctime>
+#include <vector>
+
+#include "cyber/base/macros.h"
+#include "cyber/common/log.h"
+#include "cyber/scheduler/scheduler_factory.h"
+#include "cyber/task/task.h"
+
+namespace apollo {
+namespace cyber {
+
+namespace {
+
+uint64_t EnvMicroseconds(const char* name, uint64_t default_ns) {
+  const char* value = std::getenv(name);
+  if (value == nullptr || value[0] == '\0') {
+    return default_ns;
+  }
+  return std::strtoull(value, nullptr, 10) * 1000;
+}
+
+}  // namespace
+
+constexpr int PreciseTimingWheel::kLevels;
+constexpr int PreciseTimingWheel::kSlotBits;
+constexpr uint64_t PreciseTimingWheel::kSlots;
+constexpr uint64_t PreciseTimingWheel::kSlotMask;
+constexpr int PreciseTimingWheel::kUnlinked;
+constexpr int PreciseTimingWheel::kNearLevel;
+
+PreciseTimingWheel::PreciseTimingWheel() {}
+
+PreciseTimingWheel::~PreciseTimingWheel() { Shutdown(); }
+
+void PreciseTimingWheel::Configure(const PreciseTimerConfig& config) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (running_.load()) {
+    AWARN << "precise timing wheel is running, configure ignored.";
+    return;
+  }
+  config_ = config;
+  configured_ = true;
+}
+
+uint64_t PreciseTimingWheel::NowNs() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return static_cast<uint64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
+
+bool PreciseTimingWheel::Start() {
+  if (running_.load()) {
+    return true;
+  }
+  if (!configured_) {
+    config_.tick_ns = EnvMicroseconds("CYBER_TIMER_TICK_US", config_.tick_ns);
+    config_.spin_ns = EnvMicroseconds("CYBER_TIMER_SPIN_US", config_.spin_ns);
+  }
+  if (config_.tick_ns == 0) {
+    config_.tick_ns = PreciseTimerConfig().tick_ns;
+  }
+  timer_fd_ = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+  event_fd_ = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+  if (timer_fd_ < 0 || event_fd_ < 0) {
+    AERROR << "create timerfd/eventfd failed, errno: " << errno;
+    if (timer_fd_ >= 0) {
+      close(timer_fd_);
+    }
+    if (event_fd_ >= 0) {
+      close(event_fd_);
+    }
+    timer_fd_ = event_fd_ = -1;
+    return false;
+  }
+  start_ns_ = NowNs();
+  current_tick_ = 0;
+  armed_ns_ = 0;
+  running_.store(true);
+  thread_ = std::thread(&PreciseTimingWheel::ThreadFunc, this);
+  scheduler::Instance()->SetInnerThreadAttr("precise_timer", &thread_);
+  return true;
+}
+
+void PreciseTimingWheel::Shutdown() {
+  if (!running_.exchange(false)) {
+    return;
+  }
+  Wake();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  close(timer_fd_);
+  close(event_fd_);
+  timer_fd_ = event_fd_ = -1;
+  for (auto& level : slots_) {
+    for (auto& slot : level) {
+      slot = nullptr;
+    }
+  }
+  for (auto& word : level0_bitmap_) {
+    word = 0;
+  }
+  near_ = decltype(near_)();
+  nodes_.clear();
+}
+
+uint64_t PreciseTimingWheel::AddTimer(uint64_t period_ns,
+                                      const std::function<void()>& callback,
+                                      bool oneshot) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!Start()) {
+    return 0;
+  }
+  // the top level must not wrap around
+  uint64_t max_ticks = (1ULL << (kLevels * kSlotBits)) - kSlots;
+  if (period_ns == 0 || period_ns / config_.tick_ns >= max_ticks) {
+    AERROR << "period out of range: " << period_ns << "ns";
+    return 0;
+  }
+  if (nodes_.empty()) {
+    // the thread stopped ticking while the wheel was empty
+    current_tick_ = (NowNs() - start_ns_) / config_.tick_ns + 1;
+  }
+  auto node = std::make_shared<Node>();
+  node->id = next_id_++;
+  node->period_ns = period_ns;
+  node->deadline_ns = NowNs() + period_ns;
+  node->oneshot = oneshot;
+  node->callback = callback;
+  nodes_[node->id] = node;
+  Link(node.get());
+  if (armed_ns_ == 0 || node->deadline_ns < armed_ns_) {
+    Wake();
+  }
+  return node->id;
+}
+
+bool PreciseTimingWheel::Cancel(uint64_t timer_id) {
+  NodePtr node;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto search = nodes_.find(timer_id);
+    if (search == nodes_.end()) {
+      return false;
+    }
+    node = search->second;
+    Unlink(node.get());
+    nodes_.erase(search);
+  }
+  node->cancelled.store(true);
+  // wait for a callback in flight
+  std::lock_guard<std::mutex> lock(node->callback_mutex);
+  return true;
+}
+
+bool PreciseTimingWheel::GetDriftStats(uint64_t timer_id,
+                                       TimerDriftStats* stats) {
+  NodePtr node;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto search = nodes_.find(timer_id);
+    if (search == nodes_.end()) {
+      return false;
+    }
+    node = search->second;
+  }
+  std::lock_guard<std::mutex> lock(node->stats_mutex);
+  *stats = node->stats;
+  return true;
+}
+
+void PreciseTimingWheel::Link(Node* node) {
+  uint64_t tick =
+      (node->deadline_ns - start_ns_ + config_.tick_ns - 1) / config_.tick_ns;
+  if (tick < current_tick_) {
+    tick = current_tick_;
+  }
+  uint64_t delta = tick - current_tick_;
+  int level = 0;
+  while (level < kLevels - 1 && delta >= (1ULL << ((level + 1) * kSlotBits))) {
+    ++level;
+  }
+  uint64_t slot = (tick >> (level * kSlotBits)) & kSlotMask;
+  node->level = level;
+  node->slot = slot;
+  node->prev = nullptr;
+  node->next = slots_[level][slot];
+  if (node->next != nullptr) {
+    node->next->prev = node;
+  }
+  slots_[level][slot] = node;
+  if (level == 0) {
+    level0_bitmap_[slot / 64] |= 1ULL << (slot % 64);
+  }
+}
+
+void PreciseTimingWheel::Unlink(Node* node) {
+  if (node->level < 0) {
+    node->level = kUnlinked;
+    return;
+  }
+  if (node->prev != nullptr) {
+    node->prev->next = node->next;
+  } else {
+    slots_[node->level][node->slot] = node->next;
+  }
+  if (node->next != nullptr) {
+    node->next->prev = node->prev;
+  }
+  if (node->level == 0 && slots_[0][node->slot] == nullptr) {
+    level0_bitmap_[node->slot / 64] &= ~(1ULL << (node->slot % 64));
+  }
+  node->prev = node->next = nullptr;
+  node->level = kUnlinked;
+}
+
+void PreciseTimingWheel::Cascade(int level, uint64_t slot) {
+  Node* node = slots_[level][slot];
+  slots_[level][slot] = nullptr;
+  while (node != nullptr) {
+    Node* next = node->next;
+    node->level = kUnlinked;
+    Link(node);
+    node = next;
+  }
+}
+
+void PreciseTimingWheel::Expire(uint64_t now_ns) {
+  std::vector<std::pair<NodePtr, uint64_t>> expired;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // tick T holds deadlines in (T - 1, T] ticks, its slot is opened as soon
+    // as that window begins
+    uint64_t now_tick = (now_ns - start_ns_) / config_.tick_ns + 1;
+    if (nodes_.empty()) {
+      current_tick_ = now_tick + 1;
+      near_ = decltype(near_)();
+    }
+    while (current_tick_ <= now_tick) {
+      // a lower level wrapped, pull the next slot of the level above down
+      for (int level = 1; level < kLevels; ++level) {
+        uint64_t shift = level * kSlotBits;
+        if ((current_tick_ & ((1ULL << shift) - 1)) != 0) {
+          break;
+        }
+        Cascade(level, (current_tick_ >> shift) & kSlotMask);
+      }
+      uint64_t slot = current_tick_ & kSlotMask;
+      Node* node = slots_[0][slot];
+      slots_[0][slot] = nullptr;
+      level0_bitmap_[slot / 64] &= ~(1ULL << (slot % 64));
+      while (node != nullptr) {
+        Node* next = node->next;
+        node->prev = node->next = nullptr;
+        node->level = kNearLevel;
+        auto search = nodes_.find(node->id);
+        if (search != nodes_.end()) {
+          near_.emplace(node->deadline_ns, search->second);
+        }
+        node = next;
+      }
+      ++current_tick_;
+    }
+
+    while (!near_.empty() && near_.top().first <= now_ns) {
+      NodePtr node = near_.top().second;
+      near_.pop();
+      if (node->level != kNearLevel || nodes_.count(node->id) == 0) {
+        continue;
+      }
+      node->level = kUnlinked;
+      expired.emplace_back(node, node->deadline_ns);
+      if (node->oneshot) {
+        nodes_.erase(node->id);
+        continue;
+      }
+      node->deadline_ns += node->period_ns;
+      uint64_t missed = 0;
+      while (node->deadline_ns <= now_ns) {
+        node->deadline_ns += node->period_ns;
+        ++missed;
+      }
+      if (missed > 0) {
+        std::lock_guard<std::mutex> stats_lock(node->stats_mutex);
+        node->stats.missed_count += missed;
+      }
+      Link(node.get());
+    }
+  }
+  for (auto& item : expired) {
+    Fire(item.first, item.second);
+  }
+}
+
+void PreciseTimingWheel::Fire(const NodePtr& node, uint64_t deadline_ns) {
+  if (node->running.exchange(true)) {
+    std::lock_guard<std::mutex> lock(node->stats_mutex);
+    ++node->stats.missed_count;
+    return;
+  }
+  auto run = [node, deadline_ns]() {
+    std::lock_guard<std::mutex> lock(node->callback_mutex);
+    if (!node->cancelled.load()) {
+      int64_t drift = static_cast<int64_t>(NowNs() - deadline_ns);
+      {
+        std::lock_guard<std::mutex> stats_lock(node->stats_mutex);
+        auto& stats = node->stats;
+        ++stats.fire_count;
+        stats.last_drift_ns = drift;
+        if (drift > stats.max_drift_ns) {
+          stats.max_drift_ns = drift;
+        }
+        stats.mean_drift_ns +=
+            (static_cast<double>(drift) - stats.mean_drift_ns) /
+            static_cast<double>(stats.fire_count);
+      }
+      node->callback();
+    }
+    node->running.store(false);
+  };
+  if (config_.inline_callbacks) {
+    run();
+  } else {
+    cyber::Async(run);
+  }
+}
+
+uint64_t PreciseTimingWheel::NextWakeNs() const {
+  if (nodes_.empty()) {
+    return 0;
+  }
+  // next non-empty level 0 slot, or the next wrap where cascading happens
+  uint64_t index = current_tick_ & kSlotMask;
+  uint64_t distance = kSlots - index;
+  for (uint64_t slot = index; slot < kSlots;) {
+    uint64_t word = level0_bitmap_[slot / 64] >> (slot % 64);
+    if (word != 0) {
+      distance = slot + __builtin_ctzll(word) - index;
+      break;
+    }
+    slot = (slot / 64 + 1) * 64;
+  }
+  uint64_t wake_tick = current_tick_ + distance;
+  uint64_t wake_ns =
+      start_ns_ + (wake_tick > 0 ? wake_tick - 1 : 0) * config_.tick_ns;
+  if (!near_.empty() && near_.top().first < wake_ns) {
+    wake_ns = near_.top().first;
+  }
+  return wake_ns;
+}
+
+void PreciseTimingWheel::Wake() {
+  uint64_t one = 1;
+  if (event_fd_ >= 0 && write(event_fd_, &one, sizeof(one)) < 0 &&
+      errno != EAGAIN) {
+    AWARN << "wake precise timer thread failed, errno: " << errno;
+  }
+}
+
+void PreciseTimingWheel::ThreadFunc() {
+  struct pollfd fds[2];
+  fds[0].fd = timer_fd_;
+  fds[0].events = POLLIN;
+  fds[1].fd = event_fd_;
+  fds[1].events = POLLIN;
+  while (running_.load()) {
+    Expire(NowNs());
+    uint64_t wake_ns = 0;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      wake_ns = NextWakeNs();
+      armed_ns_ = wake_ns;
+    }
+    uint64_t sleep_ns = wake_ns;
+    if (wake_ns > config_.spin_ns) {
+      sleep_ns = wake_ns - config_.spin_ns;
+    }
+    struct itimerspec spec = {};
+    spec.it_value.tv_sec = sleep_ns / 1000000000;
+    spec.it_value.tv_nsec = sleep_ns % 1000000000;
+    timerfd_settime(timer_fd_, TFD_TIMER_ABSTIME, &spec, nullptr);
+    if (wake_ns == 0 || NowNs() < sleep_ns) {
+      if (poll(fds, 2, -1) < 0 && errno != EINTR) {
+        AERROR << "poll failed, errno: " << errno;
+      }
+    }
+    uint64_t value = 0;
+    bool woken = (fds[1].revents & POLLIN) != 0 &&
+                 read(event_fd_, &value, sizeof(value)) > 0;
+    if ((fds[0].revents & POLLIN) != 0) {
+      read(timer_fd_, &value, sizeof(value));
+    }
+    fds[0].revents = fds[1].revents = 0;
+    if (!woken && wake_ns != 0 && config_.spin_ns > 0) {
+      while (NowNs() < wake_ns && running_.load()) {
+        cpu_relax();
+      }
+    }
+  }
+}
+
+}  // namespace cyber
+}  // namespace apollo
@@ -0,0 +1,168 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#ifndef CYBER_TIMER_PRECISE_TIMING_WHEEL_H_
+#define CYBER_TIMER_PRECISE_TIMING_WHEEL_H_
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "cyber/common/macros.h"
+
+namespace apollo {
+namespace cyber {
+
+/**
+ * @brief Lateness of a timer, measured when its callback starts.
+ */
+struct TimerDriftStats {
+  uint64_t fire_count = 0;
+  // periods skipped because the timer fell behind or was still running
+  uint64_t missed_count = 0;
+  int64_t last_drift_ns = 0;
+  int64_t max_drift_ns = 0;
+  double mean_drift_ns = 0.0;
+};
+
+/**
+ * @brief Knobs of the PreciseTimingWheel, read from CYBER_TIMER_TICK_US and
+ * CYBER_TIMER_SPIN_US when not set through Configure().
+ */
+struct PreciseTimerConfig {
+  // wheel resolution
+  uint64_t tick_ns = 100000;
+  // busy-wait this long before a deadline instead of sleeping through it,
+  // pin the "precise_timer" inner thread to an isolated core when using it
+  uint64_t spin_ns = 0;
+  // run callbacks on the timer thread instead of the task pool
+  bool inline_callbacks = false;
+};
+
+/**
+ * @class PreciseTimingWheel
+ * @brief Hierarchical timing wheel with sub-millisecond resolution. Four
+ * levels of 256 slots cover about five days at the default 100us tick. The
+ * thread sleeps on a timerfd armed for the next non-empty slot, so idle
+ * ticks cost nothing; timers of a slot whose tick has begun wait in a small
+ * heap and fire at their exact deadline. Adding and cancelling timers is O(1)
+ * and periodic deadlines advance by the period, so lateness does not
+ * accumulate.
+ */
+class PreciseTimingWheel {
+ public:
+  ~PreciseTimingWheel();
+
+  /**
+   * @brief Takes effect if called before the first timer is added.
+   */
+  void Configure(const PreciseTimerConfig& config);
+
+  /**
+   * @return Timer id, 0 on failure.
+   */
+  uint64_t AddTimer(uint64_t period_ns, const std::function<void()>& callback,
+                    bool oneshot);
+
+  /**
+   * @brief Remove a timer and wait for a running callback to finish; must
+   * not be called from the timer's own callback.
+   */
+  bool Cancel(uint64_t timer_id);
+
+  bool GetDriftStats(uint64_t timer_id, TimerDriftStats* stats);
+
+  void Shutdown();
+
+ private:
+  static constexpr int kLevels = 4;
+  static constexpr int kSlotBits = 8;
+  static constexpr uint64_t kSlots = 1 << kSlotBits;
+  static constexpr uint64_t kSlotMask = kSlots - 1;
+
+  struct Node {
+    uint64_t id = 0;
+    uint64_t period_ns = 0;
+    uint64_t deadline_ns = 0;
+    bool oneshot = false;
+    // intrusive slot list, guarded by mutex_
+    Node* prev = nullptr;
+    Node* next = nullptr;
+    // kUnlinked, kNearLevel or the wheel level
+    int level = -1;
+    uint64_t slot = 0;
+    std::function<void()> callback;
+    // held while the callback runs
+    std::mutex callback_mutex;
+    std::atomic<bool> running = {false};
+    std::atomic<bool> cancelled = {false};
+    std::mutex stats_mutex;
+    TimerDriftStats stats;
+  };
+  using NodePtr = std::shared_ptr<Node>;
+  using NearEntry = std::pair<uint64_t, NodePtr>;
+  struct NearLater {
+    bool operator()(const NearEntry& a, const NearEntry& b) const {
+      return a.first > b.first;
+    }
+  };
+  static constexpr int kUnlinked = -1;
+  static constexpr int kNearLevel = -2;
+
+  bool Start();
+  void ThreadFunc();
+  void Link(Node* node);
+  void Unlink(Node* node);
+  void Cascade(int level, uint64_t slot);
+  void Expire(uint64_t now_ns);
+  void Fire(const NodePtr& node, uint64_t deadline_ns);
+  uint64_t NextWakeNs() const;
+  void Wake();
+  static uint64_t NowNs();
+
+  PreciseTimerConfig config_;
+  bool configured_ = false;
+  std::mutex mutex_;
+  Node* slots_[kLevels][kSlots] = {};
+  uint64_t level0_bitmap_[kSlots / 64] = {};
+  std::unordered_map<uint64_t, NodePtr> nodes_;
+  // timers of begun ticks ordered by deadline, cancelled ones are skipped
+  std::priority_queue<NearEntry, std::vector<NearEntry>, NearLater> near_;
+  uint64_t start_ns_ = 0;
+  // next tick to process
+  uint64_t current_tick_ = 0;
+  uint64_t armed_ns_ = 0;
+  uint64_t next_id_ = 1;
+  int timer_fd_ = -1;
+  int event_fd_ = -1;
+  std::atomic<bool> running_ = {false};
+  std::thread thread_;
+
+  DECLARE_SINGLETON(PreciseTimingWheel)
+};
+
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_TIMER_PRECISE_TIMING_WHEEL_H_
@@ -0,0 +1,97 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "cyber/timer/precise_timing_wheel.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace cyber {
+
+class PreciseTimingWheelTest : public ::testing::Test {
+ protected:
+  static void SetUpTestCase() {
+    PreciseTimerConfig config;
+    config.tick_ns = 50000;
+    config.inline_callbacks = true;
+    PreciseTimingWheel::Instance()->Configure(config);
+  }
+  static void TearDownTestCase() {
+    PreciseTimingWheel::Instance()->Shutdown();
+  }
+};
+
+TEST_F(PreciseTimingWheelTest, OneShot) {
+  auto wheel = PreciseTimingWheel::Instance();
+  std::atomic<int> count = {0};
+  uint64_t id = wheel->AddTimer(
+      2000000, [&count] { ++count; }, true);
+  ASSERT_NE(0, id);
+  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  EXPECT_EQ(0, count.load());
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  EXPECT_EQ(1, count.load());
+  // a fired oneshot timer is gone
+  EXPECT_FALSE(wheel->Cancel(id));
+}
+
+TEST_F(PreciseTimingWheelTest, PeriodicDrift) {
+  auto wheel = PreciseTimingWheel::Instance();
+  std::atomic<int> count = {0};
+  // 500us period, below the resolution of the millisecond wheel
+  uint64_t id = wheel->AddTimer(
+      500000, [&count] { ++count; }, false);
+  ASSERT_NE(0, id);
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  TimerDriftStats stats;
+  ASSERT_TRUE(wheel->GetDriftStats(id, &stats));
+  ASSERT_TRUE(wheel->Cancel(id));
+  int fired = count.load();
+  // deadlines advance by the period, lateness must not pile up
+  EXPECT_GT(fired, 150);
+  EXPECT_LE(fired, 201);
+  EXPECT_EQ(static_cast<uint64_t>(fired), stats.fire_count);
+  EXPECT_GE(stats.max_drift_ns, 0);
+  EXPECT_GE(stats.mean_drift_ns, 0.0);
+  std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  EXPECT_EQ(fired, count.load());
+  EXPECT_FALSE(wheel->GetDriftStats(id, &stats));
+}
+
+TEST_F(PreciseTimingWheelTest, LongPeriodCascade) {
+  auto wheel = PreciseTimingWheel::Instance();
+  std::atomic<int> count = {0};
+  // 30ms needs more than the 256 ticks of the first level
+  uint64_t id = wheel->AddTimer(
+      30000000, [&count] { ++count; }, true);
+  uint64_t cancelled = wheel->AddTimer(
+      10000000, [&count] { count += 100; }, true);
+  ASSERT_TRUE(wheel->Cancel(cancelled));
+  std::this_thread::sleep_for(std::chrono::milliseconds(25));
+  EXPECT_EQ(0, count.load());
+  std::this_thread::sleep_for(std::chrono::milliseconds(30));
+  EXPECT_EQ(1, count.load());
+  EXPECT_FALSE(wheel->Cancel(id));
+  EXPECT_EQ(0, wheel->AddTimer(0, [] {}, true));
+}
+
+}  // namespace cyber
+}  // namespace apollo
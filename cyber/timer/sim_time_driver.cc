@@ -0,0 +1,166 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/timer/sim_time_driver.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "cyber/common/log.h"
+#include "cyber/time/clock.h"
+
+namespace apollo {
+namespace cyber {
+
+constexpr uint64_t SimTimeDriver::kForever;
+
+SimTimeDriver::SimTimeDriver() {}
+
+bool SimTimeDriver::IsMockClock() {
+  return Clock::mode() == ClockMode::MODE_MOCK;
+}
+
+uint64_t SimTimeDriver::NowNs() { return Clock::Now().ToNanosecond(); }
+
+uint64_t SimTimeDriver::AddTimer(uint64_t period_ns,
+                                 const std::function<void()>& callback,
+                                 bool oneshot) {
+  if (period_ns == 0) {
+    AERROR << "sim timer period must be greater than 0";
+    return 0;
+  }
+  Event event;
+  event.period_ns = period_ns;
+  event.deadline_ns = NowNs() + period_ns;
+  event.oneshot = oneshot;
+  event.callback = callback;
+  return Schedule(std::move(event));
+}
+
+uint64_t SimTimeDriver::PostAt(uint64_t time_ns,
+                               const std::function<void()>& callback) {
+  Event event;
+  event.deadline_ns = time_ns;
+  event.callback = callback;
+  return Schedule(std::move(event));
+}
+
+uint64_t SimTimeDriver::Schedule(Event event) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  uint64_t id = next_id_++;
+  event.seq = next_seq_++;
+  queue_.emplace(event.deadline_ns, event.seq, id);
+  events_.emplace(id, std::move(event));
+  return id;
+}
+
+bool SimTimeDriver::Cancel(uint64_t id) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  auto it = events_.find(id);
+  if (it == events_.end()) {
+    return false;
+  }
+  if (id == running_id_) {
+    // keeps a periodic timer from being armed again
+    running_cancelled_ = true;
+    if (running_thread_ != std::this_thread::get_id()) {
+      fired_cv_.wait(lock, [this, id] { return running_id_ != id; });
+    }
+    return true;
+  }
+  const Event& event = it->second;
+  queue_.erase(Key(event.deadline_ns, event.seq, id));
+  events_.erase(it);
+  return true;
+}
+
+bool SimTimeDriver::RunOnce() {
+  if (!IsMockClock()) {
+    AERROR << "SimTimeDriver only works for ClockMode::MODE_MOCK";
+    return false;
+  }
+  uint64_t id = 0;
+  std::function<void()> callback;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (queue_.empty()) {
+      return false;
+    }
+    auto key = *queue_.begin();
+    queue_.erase(queue_.begin());
+    id = std::get<2>(key);
+    // the clock never moves back, an event posted for the past fires now
+    uint64_t now_ns = std::max(std::get<0>(key), NowNs());
+    Clock::SetNow(Time(now_ns));
+    callback = events_[id].callback;
+    running_id_ = id;
+    running_thread_ = std::this_thread::get_id();
+    running_cancelled_ = false;
+  }
+
+  callback();
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = events_.find(id);
+    Event& event = it->second;
+    if (event.oneshot || running_cancelled_) {
+      events_.erase(it);
+    } else {
+      // deadlines advance by the period, slow callbacks cost no virtual time
+      event.deadline_ns += event.period_ns;
+      event.seq = next_seq_++;
+      queue_.emplace(event.deadline_ns, event.seq, id);
+    }
+    running_id_ = 0;
+  }
+  fired_cv_.notify_all();
+  return true;
+}
+
+uint64_t SimTimeDriver::RunUntil(uint64_t end_ns) {
+  stopped_.store(false);
+  uint64_t fired = 0;
+  uint64_t next_ns = 0;
+  while (!stopped_.load() && NextEventTime(&next_ns) && next_ns <= end_ns) {
+    if (!RunOnce()) {
+      return fired;
+    }
+    ++fired;
+  }
+  if (end_ns != kForever && !stopped_.load() && IsMockClock() &&
+      NowNs() < end_ns) {
+    Clock::SetNow(Time(end_ns));
+  }
+  return fired;
+}
+
+bool SimTimeDriver::NextEventTime(uint64_t* time_ns) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (queue_.empty()) {
+    return false;
+  }
+  *time_ns = std::get<0>(*queue_.begin());
+  return true;
+}
+
+size_t SimTimeDriver::PendingNum() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return queue_.size();
+}
+
+}  // namespace cyber
+}  // namespace apollo
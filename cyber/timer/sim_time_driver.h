@@ -0,0 +1,130 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_TIMER_SIM_TIME_DRIVER_H_
+#define CYBER_TIMER_SIM_TIME_DRIVER_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
+
+#include "cyber/common/macros.h"
+
+namespace apollo {
+namespace cyber {
+
+/**
+ * @class SimTimeDriver
+ * @brief Runs the timers of the simulation run mode on virtual time.
+ *
+ * In simulation mode readers are called on the thread of the writer, so all
+ * the work an event causes is done when its callback returns. The driver
+ * therefore fires the pending events one by one in (deadline, arming order),
+ * jumping the mock clock straight to each deadline instead of sleeping until
+ * it, and a scenario runs as fast as its callbacks do. Timer::Start registers
+ * here in simulation mode; playback code posts its messages with PostAt.
+ * Requires ClockMode::MODE_MOCK.
+ */
+class SimTimeDriver {
+ public:
+  static constexpr uint64_t kForever = std::numeric_limits<uint64_t>::max();
+
+  /**
+   * @brief Fire callback period_ns after the current mock time, and every
+   * period_ns after that unless oneshot.
+   * @return Event id, 0 if period_ns is 0.
+   */
+  uint64_t AddTimer(uint64_t period_ns, const std::function<void()>& callback,
+                    bool oneshot);
+
+  /**
+   * @brief Fire callback once at the absolute mock time time_ns, or at the
+   * current time if that has passed.
+   * @return Event id.
+   */
+  uint64_t PostAt(uint64_t time_ns, const std::function<void()>& callback);
+
+  /**
+   * @brief Remove an event and wait for its running callback to finish, unless
+   * called from that callback.
+   */
+  bool Cancel(uint64_t id);
+
+  /**
+   * @brief Advance the mock clock to the earliest event and fire it.
+   * @return false if no event is pending or the clock is not a mock clock.
+   */
+  bool RunOnce();
+
+  /**
+   * @brief Fire the events due up to end_ns, then leave the clock at end_ns.
+   * Returns early once Stop is called.
+   * @return The number of events fired.
+   */
+  uint64_t RunUntil(uint64_t end_ns);
+
+  /**
+   * @brief Fire events until none is left or Stop is called.
+   */
+  uint64_t Run() { return RunUntil(kForever); }
+
+  void Stop() { stopped_.store(true); }
+
+  bool NextEventTime(uint64_t* time_ns);
+
+  size_t PendingNum();
+
+ private:
+  struct Event {
+    uint64_t period_ns = 0;
+    uint64_t deadline_ns = 0;
+    uint64_t seq = 0;
+    bool oneshot = true;
+    std::function<void()> callback;
+  };
+  // deadline, arming sequence, id
+  using Key = std::tuple<uint64_t, uint64_t, uint64_t>;
+
+  static bool IsMockClock();
+  static uint64_t NowNs();
+  uint64_t Schedule(Event event);
+
+  std::mutex mutex_;
+  std::condition_variable fired_cv_;
+  std::set<Key> queue_;
+  std::unordered_map<uint64_t, Event> events_;
+  uint64_t next_id_ = 1;
+  uint64_t next_seq_ = 0;
+  // the event whose callback runs, and the thread running it
+  uint64_t running_id_ = 0;
+  std::thread::id running_thread_;
+  bool running_cancelled_ = false;
+  std::atomic<bool> stopped_ = {false};
+
+  DECLARE_SINGLETON(SimTimeDriver)
+};
+
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_TIMER_SIM_TIME_DRIVER_H_
@@ -0,0 +1,127 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/timer/sim_time_driver.h"
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "cyber/common/global_data.h"
+#include "cyber/time/clock.h"
+#include "cyber/timer/timer.h"
+
+namespace apollo {
+namespace cyber {
+
+class SimTimeDriverTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    Clock::SetMode(ClockMode::MODE_MOCK);
+    Clock::SetNow(Time(uint64_t{1000000000}));
+  }
+  void TearDown() override { Clock::SetMode(ClockMode::MODE_CYBER); }
+};
+
+TEST_F(SimTimeDriverTest, DeterministicOrder) {
+  auto driver = SimTimeDriver::Instance();
+  std::vector<std::string> fired;
+  uint64_t fast = driver->AddTimer(
+      10000000, [&fired] { fired.push_back("fast"); }, false);
+  uint64_t slow = driver->AddTimer(
+      20000000, [&fired] { fired.push_back("slow"); }, false);
+  driver->PostAt(1015000000, [&fired] { fired.push_back("post"); });
+
+  // 60ms of virtual time without sleeping
+  EXPECT_EQ(10, driver->RunUntil(1060000000));
+  EXPECT_EQ(1060000000, Clock::Now().ToNanosecond());
+  // on equal deadlines the timer armed first fires first
+  std::vector<std::string> expected = {"fast", "post", "slow", "fast", "fast",
+                                       "slow", "fast", "fast", "slow", "fast"};
+  EXPECT_EQ(expected, fired);
+  EXPECT_TRUE(driver->Cancel(fast));
+  EXPECT_TRUE(driver->Cancel(slow));
+  EXPECT_FALSE(driver->Cancel(slow));
+  EXPECT_EQ(0, driver->PendingNum());
+}
+
+TEST_F(SimTimeDriverTest, ClockFollowsEvents) {
+  auto driver = SimTimeDriver::Instance();
+  std::vector<uint64_t> times;
+  auto record = [&times] { times.push_back(Clock::Now().ToNanosecond()); };
+  driver->AddTimer(5000000, record, true);
+  driver->PostAt(1003000000, record);
+  // an event in the past fires at the current time
+  driver->PostAt(1000, record);
+  EXPECT_EQ(3, driver->Run());
+  std::vector<uint64_t> expected = {1000000000, 1003000000, 1005000000};
+  EXPECT_EQ(expected, times);
+  EXPECT_FALSE(driver->RunOnce());
+}
+
+TEST_F(SimTimeDriverTest, CancelInCallback) {
+  auto driver = SimTimeDriver::Instance();
+  int count = 0;
+  uint64_t id = 0;
+  id = driver->AddTimer(
+      1000000,
+      [&] {
+        if (++count == 3) {
+          driver->Cancel(id);
+        }
+      },
+      false);
+  EXPECT_EQ(3, driver->Run());
+  EXPECT_EQ(3, count);
+  EXPECT_EQ(1003000000, Clock::Now().ToNanosecond());
+}
+
+TEST_F(SimTimeDriverTest, StopAndResume) {
+  auto driver = SimTimeDriver::Instance();
+  int count = 0;
+  uint64_t id = driver->AddTimer(
+      1000000,
+      [&] {
+        if (++count % 10 == 0) {
+          driver->Stop();
+        }
+      },
+      false);
+  EXPECT_EQ(10, driver->Run());
+  EXPECT_EQ(10, driver->Run());
+  EXPECT_EQ(20, count);
+  EXPECT_TRUE(driver->Cancel(id));
+}
+
+TEST_F(SimTimeDriverTest, TimerInSimulationMode) {
+  auto global_data = common::GlobalData::Instance();
+  global_data->EnableSimulationMode();
+  int count = 0;
+  {
+    // an hour of a 10ms timer
+    Timer timer(10, [&count] { ++count; }, false);
+    timer.Start();
+    SimTimeDriver::Instance()->RunUntil(1000000000 + 3600000000000);
+    EXPECT_EQ(360000, count);
+    timer.Stop();
+  }
+  EXPECT_EQ(0, SimTimeDriver::Instance()->PendingNum());
+  global_data->DisableSimulationMode();
+}
+
+}  // namespace cyber
+}  // namespace apollo
@@ -19,6 +19,7 @@
 #include <cmath>
 
 #include "cyber/common/global_data.h"
+#include "cyber/timer/sim_time_driver.h"
 
 namespace apollo {
 namespace cyber {
@@ -62,6 +63,14 @@ bool Timer::InitTimerTask() {
   task_.reset(new TimerTask(timer_id_));
   task_->interval_ms = timer_opt_.period;
   task_->next_fire_duration_ms = task_->interval_ms;
+  if (timer_opt_.phase_ms >= 0 && !timer_opt_.oneshot) {
+    // the first firing lands on the phase, the later ones keep it
+    uint64_t period = task_->interval_ms;
+    uint64_t now_ms = Time::MonoTime().ToNanosecond() / 1000000;
+    uint64_t offset =
+        (timer_opt_.phase_ms % period + period - now_ms % period) % period;
+    task_->next_fire_duration_ms = offset == 0 ? period : offset;
+  }
   if (timer_opt_.oneshot) {
     std::weak_ptr<TimerTask> task_weak_ptr = task_;
     task_->callback = [callback = this->timer_opt_.callback, task_weak_ptr]() {
@@ -128,10 +137,28 @@ bool Timer::InitTimerTask() {
 
 void Timer::Start() {
   if (!common::GlobalData::Instance()->IsRealityMode()) {
+    if (!started_.exchange(true)) {
+      uint64_t period_ns = timer_opt_.period_us > 0
+                               ? timer_opt_.period_us * 1000
+                               : uint64_t{timer_opt_.period} * 1000000;
+      sim_timer_id_ = SimTimeDriver::Instance()->AddTimer(
+          period_ns, timer_opt_.callback, timer_opt_.oneshot);
+      if (sim_timer_id_ == 0) {
+        started_.store(false);
+      }
+    }
     return;
   }
 
   if (!started_.exchange(true)) {
+    if (timer_opt_.period_us > 0) {
+      precise_timer_id_ = PreciseTimingWheel::Instance()->AddTimer(
+          timer_opt_.period_us * 1000, timer_opt_.callback, timer_opt_.oneshot);
+      if (precise_timer_id_ != 0) {
+        AINFO << "start precise timer [" << timer_id_ << "]";
+      }
+      return;
+    }
     if (InitTimerTask()) {
       timing_wheel_->AddTask(task_);
       AINFO << "start timer [" << task_->timer_id_ << "]";
@@ -140,6 +167,21 @@ void Timer::Start() {
 }
 
 void Timer::Stop() {
+  if (sim_timer_id_ != 0) {
+    if (started_.exchange(false)) {
+      SimTimeDriver::Instance()->Cancel(sim_timer_id_);
+      sim_timer_id_ = 0;
+    }
+    return;
+  }
+  if (precise_timer_id_ != 0) {
+    if (started_.exchange(false)) {
+      AINFO << "stop precise timer, the timer_id: " << timer_id_;
+      PreciseTimingWheel::Instance()->Cancel(precise_timer_id_);
+      precise_timer_id_ = 0;
+    }
+    return;
+  }
   if (started_.exchange(false) && task_) {
     AINFO << "stop timer, the timer_id: " << timer_id_;
     // using a shared pointer to hold task_->mutex before task_ reset
@@ -151,8 +193,16 @@ void Timer::Stop() {
   }
 }
 
+bool Timer::GetDriftStats(TimerDriftStats* stats) const {
+  if (precise_timer_id_ == 0) {
+    return false;
+  }
+  return PreciseTimingWheel::Instance()->GetDriftStats(precise_timer_id_,
+                                                       stats);
+}
+
 Timer::~Timer() {
-  if (task_) {
+  if (task_ || precise_timer_id_ != 0 || sim_timer_id_ != 0) {
     Stop();
   }
 }
@@ -20,6 +20,7 @@
 #include <atomic>
 #include <memory>
 
+#include "cyber/timer/precise_timing_wheel.h"
 #include "cyber/timer/timing_wheel.h"
 
 namespace apollo {
@@ -61,11 +62,26 @@ struct TimerOption {
    * False: perform the callback every timed period
    */
   bool oneshot;
+
+  /**
+   * @brief The period of the timer, unit is us. When non zero it overrides
+   * `period` and the timer runs on the PreciseTimingWheel, which keeps
+   * sub-millisecond precision and tracks drift statistics.
+   */
+  uint64_t period_us = 0;
+
+  /**
+   * @brief The phase of a periodic timer, unit is ms. When not negative the
+   * timer fires when the monotonic time in ms modulo `period` equals it, see
+   * TimerPhaseAllocator. Negative fires one period after Start.
+   */
+  int32_t phase_ms = -1;
 };
 
 /**
  * @class Timer
- * @brief Used to perform oneshot or periodic timing tasks
+ * @brief Used to perform oneshot or periodic timing tasks. In simulation run
+ * mode the timer fires on the virtual time of the SimTimeDriver.
  *
  */
 class Timer {
@@ -109,9 +125,18 @@ class Timer {
    */
   void Stop();
 
+  /**
+   * @brief Get the drift statistics of a started precise timer
+   *
+   * @return false for timers on the millisecond timing wheel
+   */
+  bool GetDriftStats(TimerDriftStats* stats) const;
+
  private:
   bool InitTimerTask();
   uint64_t timer_id_;
+  uint64_t precise_timer_id_ = 0;
+  uint64_t sim_timer_id_ = 0;
   TimerOption timer_opt_;
   TimingWheel* timing_wheel_ = nullptr;
   std::shared_ptr<TimerTask> task_;
@@ -0,0 +1,148 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/timer/timer_phase_allocator.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <sstream>
+#include <utility>
+
+#include "cyber/common/log.h"
+#include "cyber/timer/timing_wheel.h"
+
+namespace apollo {
+namespace cyber {
+
+namespace {
+
+constexpr uint32_t kSlotMs = TIMER_RESOLUTION_MS;
+
+}  // namespace
+
+constexpr uint32_t TimerPhaseAllocator::kWindowMs;
+
+TimerPhaseAllocator::TimerPhaseAllocator()
+    : load_(kWindowMs / kSlotMs, 0) {
+  const char* stagger = std::getenv("CYBER_TIMER_STAGGER");
+  stagger_ = stagger != nullptr && std::atoi(stagger) != 0;
+
+  const char* phases = std::getenv("CYBER_TIMER_PHASE_MS");
+  if (phases == nullptr) {
+    return;
+  }
+  std::stringstream ss(phases);
+  std::string item;
+  while (std::getline(ss, item, ',')) {
+    auto colon = item.rfind(':');
+    if (colon == std::string::npos || colon == 0) {
+      AWARN << "ignore timer phase " << item << ", expect name:ms";
+      continue;
+    }
+    configured_[item.substr(0, colon)] =
+        std::max(std::atoi(item.c_str() + colon + 1), 0);
+  }
+}
+
+int32_t TimerPhaseAllocator::Assign(const std::string& name,
+                                    uint32_t period_ms) {
+  if (period_ms == 0) {
+    return -1;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  int32_t phase_ms = -1;
+  auto it = configured_.find(name);
+  if (it != configured_.end()) {
+    phase_ms = static_cast<int32_t>(it->second % period_ms);
+  } else if (stagger_) {
+    phase_ms = static_cast<int32_t>(LeastLoadedPhase(period_ms));
+  } else {
+    return -1;
+  }
+  Occupy(period_ms, phase_ms, 1);
+  timers_.push_back({name, period_ms, phase_ms});
+  AINFO << "timer " << name << " period " << period_ms << "ms phase "
+        << phase_ms << "ms";
+  return phase_ms;
+}
+
+void TimerPhaseAllocator::Release(const std::string& name) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = std::find_if(
+      timers_.begin(), timers_.end(),
+      [&name](const TimerPhase& timer) { return timer.name == name; });
+  if (it == timers_.end()) {
+    return;
+  }
+  Occupy(it->period_ms, it->phase_ms, -1);
+  timers_.erase(it);
+}
+
+void TimerPhaseAllocator::GetTimers(std::vector<TimerPhase>* timers) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  *timers = timers_;
+}
+
+void TimerPhaseAllocator::GetLoad(std::vector<uint32_t>* load) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  *load = load_;
+}
+
+void TimerPhaseAllocator::SetStagger(bool stagger) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  stagger_ = stagger;
+}
+
+void TimerPhaseAllocator::SetPhase(const std::string& name,
+                                   int32_t phase_ms) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (phase_ms < 0) {
+    configured_.erase(name);
+  } else {
+    configured_[name] = phase_ms;
+  }
+}
+
+// periods that do not divide the window are counted as if they restarted
+// with it, close enough for the common 10, 20, 50 and 100ms timers
+void TimerPhaseAllocator::Occupy(uint32_t period_ms, uint32_t phase_ms,
+                                 int delta) {
+  for (uint32_t t = phase_ms % kWindowMs; t < kWindowMs; t += period_ms) {
+    load_[t / kSlotMs] += delta;
+  }
+}
+
+uint32_t TimerPhaseAllocator::LeastLoadedPhase(uint32_t period_ms) const {
+  uint32_t best_phase = 0;
+  std::pair<uint32_t, uint32_t> best_cost = {UINT32_MAX, UINT32_MAX};
+  uint32_t end = std::min(period_ms, kWindowMs);
+  for (uint32_t phase = 0; phase < end; phase += kSlotMs) {
+    // the busiest tick first, then the overlaps in total
+    std::pair<uint32_t, uint32_t> cost = {0, 0};
+    for (uint32_t t = phase; t < kWindowMs; t += period_ms) {
+      cost.first = std::max(cost.first, load_[t / kSlotMs]);
+      cost.second += load_[t / kSlotMs];
+    }
+    if (cost < best_cost) {
+      best_cost = cost;
+      best_phase = phase;
+    }
+  }
+  return best_phase;
+}
+
+}  // namespace cyber
+}  // namespace apollo
@@ -0,0 +1,88 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_TIMER_TIMER_PHASE_ALLOCATOR_H_
+#define CYBER_TIMER_TIMER_PHASE_ALLOCATOR_H_
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "cyber/common/macros.h"
+
+namespace apollo {
+namespace cyber {
+
+struct TimerPhase {
+  std::string name;
+  uint32_t period_ms = 0;
+  int32_t phase_ms = -1;
+};
+
+/**
+ * @class TimerPhaseAllocator
+ * @brief Picks the phase of named periodic timers, so that timers of the
+ * same or harmonic periods do not all fire on the same tick and land on the
+ * processors at once. A phase p makes a timer fire when the monotonic time in
+ * milliseconds modulo its period is p.
+ *
+ * Phases listed in CYBER_TIMER_PHASE_MS ("control:0,canbus:4") are used as
+ * they are. With CYBER_TIMER_STAGGER=1 the other timers get the phase whose
+ * firing ticks, over a one second window, are shared with the fewest timers
+ * registered before. Otherwise timers are not phased, as before.
+ */
+class TimerPhaseAllocator {
+ public:
+  static constexpr uint32_t kWindowMs = 1000;
+
+  /**
+   * @return The phase in ms, -1 if the timer is not phased.
+   */
+  int32_t Assign(const std::string& name, uint32_t period_ms);
+
+  void Release(const std::string& name);
+
+  void GetTimers(std::vector<TimerPhase>* timers);
+
+  /**
+   * @brief Number of phased timers firing in each TIMER_RESOLUTION_MS tick of
+   * the window.
+   */
+  void GetLoad(std::vector<uint32_t>* load);
+
+  void SetStagger(bool stagger);
+
+  void SetPhase(const std::string& name, int32_t phase_ms);
+
+ private:
+  void Occupy(uint32_t period_ms, uint32_t phase_ms, int delta);
+  uint32_t LeastLoadedPhase(uint32_t period_ms) const;
+
+  std::mutex mutex_;
+  bool stagger_ = false;
+  std::unordered_map<std::string, int32_t> configured_;
+  std::vector<TimerPhase> timers_;
+  std::vector<uint32_t> load_;
+
+  DECLARE_SINGLETON(TimerPhaseAllocator)
+};
+
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_TIMER_TIMER_PHASE_ALLOCATOR_H_
@@ -0,0 +1,84 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/timer/timer_phase_allocator.h"
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace cyber {
+
+TEST(TimerPhaseAllocatorTest, NotPhasedByDefault) {
+  auto allocator = TimerPhaseAllocator::Instance();
+  allocator->SetStagger(false);
+  EXPECT_EQ(-1, allocator->Assign("plain", 10));
+  std::vector<TimerPhase> timers;
+  allocator->GetTimers(&timers);
+  EXPECT_TRUE(timers.empty());
+}
+
+TEST(TimerPhaseAllocatorTest, Configured) {
+  auto allocator = TimerPhaseAllocator::Instance();
+  allocator->SetPhase("control", 3);
+  allocator->SetPhase("canbus", 25);
+  EXPECT_EQ(3, allocator->Assign("control", 10));
+  EXPECT_EQ(5, allocator->Assign("canbus", 10));
+  allocator->Release("control");
+  allocator->Release("canbus");
+  allocator->SetPhase("control", -1);
+  allocator->SetPhase("canbus", -1);
+}
+
+TEST(TimerPhaseAllocatorTest, Stagger) {
+  auto allocator = TimerPhaseAllocator::Instance();
+  allocator->SetStagger(true);
+  // same period timers spread over the ticks of the period
+  std::vector<std::string> names = {"a", "b", "c", "d"};
+  for (size_t i = 0; i < names.size(); ++i) {
+    EXPECT_EQ(static_cast<int32_t>(i * 2), allocator->Assign(names[i], 10));
+  }
+  // 8 and 18 are free for a 20ms timer
+  EXPECT_EQ(8, allocator->Assign("slow", 20));
+  // at 8 a 10ms timer only meets the 20ms one every other period
+  EXPECT_EQ(8, allocator->Assign("e", 10));
+
+  std::vector<uint32_t> load;
+  allocator->GetLoad(&load);
+  ASSERT_EQ(TimerPhaseAllocator::kWindowMs / 2, load.size());
+  EXPECT_EQ(1, load[0]);
+  EXPECT_EQ(2, load[4]);
+  EXPECT_EQ(1, load[9]);
+
+  for (const auto& name : names) {
+    allocator->Release(name);
+  }
+  allocator->Release("slow");
+  allocator->Release("e");
+  allocator->GetLoad(&load);
+  for (auto count : load) {
+    EXPECT_EQ(0, count);
+  }
+  std::vector<TimerPhase> timers;
+  allocator->GetTimers(&timers);
+  EXPECT_TRUE(timers.empty());
+  allocator->SetStagger(false);
+}
+
+}  // namespace cyber
+}  // namespace apollo
@@ -0,0 +1,55 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "cyber/logger/binary_log_format.h"
+
+using apollo::cyber::logger::BinaryLogDecoder;
+
+// Decodes binary log files written by BinaryLogger into glog style text.
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    std::cout << "usage: " << argv[0] << " file.blog [output.log]"
+              << std::endl;
+    return -1;
+  }
+  std::ifstream input(argv[1], std::ios::binary);
+  if (!input.is_open()) {
+    std::cerr << "open file failed: " << argv[1] << std::endl;
+    return -1;
+  }
+  std::ofstream file_output;
+  std::ostream* output = &std::cout;
+  if (argc > 2) {
+    file_output.open(argv[2]);
+    if (!file_output.is_open()) {
+      std::cerr << "open file failed: " << argv[2] << std::endl;
+      return -1;
+    }
+    output = &file_output;
+  }
+  BinaryLogDecoder decoder;
+  if (!decoder.Decode(&input, output)) {
+    std::cerr << "file is not a binary log or is truncated: " << argv[1]
+              << std::endl;
+    return -1;
+  }
+  return 0;
+}
@@ -22,7 +22,10 @@ namespace apollo {
 namespace cyber {
 namespace record {
 
+using apollo::cyber::proto::Channel;
 using apollo::cyber::proto::ChannelCache;
+using apollo::cyber::proto::ChunkHeader;
+using apollo::cyber::proto::SectionType;
 using apollo::cyber::record::kGB;
 using apollo::cyber::record::kKB;
 using apollo::cyber::record::kMB;
@@ -31,6 +34,50 @@ Info::Info() {}
 
 Info::~Info() {}
 
+bool Info::ScanSections(RecordFileReader* file_reader, proto::Header* hdr,
+                        proto::Index* idx) {
+  hdr->set_begin_time(0);
+  hdr->set_end_time(0);
+  hdr->set_message_number(0);
+  hdr->set_channel_number(0);
+  hdr->set_chunk_number(0);
+  if (!file_reader->Reset()) {
+    return false;
+  }
+  Section section;
+  // the last section of a record being written may be truncated
+  while (file_reader->ReadSection(&section)) {
+    if (section.type == SectionType::SECTION_CHANNEL) {
+      Channel chan;
+      if (!file_reader->ReadSection<Channel>(section.size, &chan)) {
+        break;
+      }
+      auto single_index = idx->add_indexes();
+      single_index->set_type(SectionType::SECTION_CHANNEL);
+      auto cache = single_index->mutable_channel_cache();
+      cache->set_name(chan.name());
+      cache->set_message_type(chan.message_type());
+      hdr->set_channel_number(hdr->channel_number() + 1);
+    } else if (section.type == SectionType::SECTION_CHUNK_HEADER) {
+      ChunkHeader chdr;
+      if (!file_reader->ReadSection<ChunkHeader>(section.size, &chdr)) {
+        break;
+      }
+      if (hdr->begin_time() == 0 || chdr.begin_time() < hdr->begin_time()) {
+        hdr->set_begin_time(chdr.begin_time());
+      }
+      if (chdr.end_time() > hdr->end_time()) {
+        hdr->set_end_time(chdr.end_time());
+      }
+      hdr->set_message_number(hdr->message_number() + chdr.message_number());
+      hdr->set_chunk_number(hdr->chunk_number() + 1);
+    } else if (!file_reader->SkipSection(section.size)) {
+      break;
+    }
+  }
+  return true;
+}
+
 bool Info::Display(const std::string& file) {
   RecordFileReader file_reader;
   if (!file_reader.Open(file)) {
@@ -38,6 +85,13 @@ bool Info::Display(const std::string& file) {
     return false;
   }
   proto::Header hdr = file_reader.GetHeader();
+  // an incomplete record has no index, its sections are walked instead with
+  // the chunk bodies skipped
+  proto::Index idx;
+  if (!hdr.is_complete() && !ScanSections(&file_reader, &hdr, &idx)) {
+    AERROR << "scan sections of the file fail. file: " << file;
+    return false;
+  }
 
   std::cout << setiosflags(std::ios::left);
   std::cout << setiosflags(std::ios::fixed);
@@ -90,14 +144,16 @@ bool Info::Display(const std::string& file) {
             << std::endl;
 
   // read index section
-  if (!file_reader.ReadIndex()) {
-    AERROR << "read index section of the file fail. file: " << file;
-    return false;
+  if (hdr.is_complete()) {
+    if (!file_reader.ReadIndex()) {
+      AERROR << "read index section of the file fail. file: " << file;
+      return false;
+    }
+    idx = file_reader.GetIndex();
   }
 
   // channel info
   std::cout << std::setw(w) << "channel_info: " << std::endl;
-  proto::Index idx = file_reader.GetIndex();
   for (int i = 0; i < idx.indexes_size(); ++i) {
     ChannelCache* cache = idx.mutable_indexes(i)->mutable_channel_cache();
     if (idx.mutable_indexes(i)->type() == proto::SectionType::SECTION_CHANNEL) {
@@ -105,7 +161,12 @@ bool Info::Display(const std::string& file) {
       std::cout << resetiosflags(std::ios::right);
       std::cout << std::setw(50) << cache->name();
       std::cout << setiosflags(std::ios::right);
-      std::cout << std::setw(8) << cache->message_number();
+      // messages by channel are only counted in the index
+      if (hdr.is_complete()) {
+        std::cout << std::setw(8) << cache->message_number();
+      } else {
+        std::cout << std::setw(8) << "-";
+      }
       std::cout << std::setw(0) << " messages: ";
       std::cout << cache->message_type();
       std::cout << std::endl;
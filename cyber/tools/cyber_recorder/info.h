@@ -36,6 +36,12 @@ class Info {
   Info();
   ~Info();
   bool Display(const std::string& file);
+
+ private:
+  // fills the summary of `hdr` and the channels of `idx` from the section
+  // headers, for records closed before their index was written
+  bool ScanSections(RecordFileReader* file_reader, proto::Header* hdr,
+                    proto::Index* idx);
 };
 
 }  // namespace record
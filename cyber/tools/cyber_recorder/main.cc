@@ -42,8 +42,8 @@ using apollo::cyber::record::Recoverer;
 using apollo::cyber::record::Spliter;
 
 const char INFO_OPTIONS[] = "h";
-const char RECORD_OPTIONS[] = "o:ac:i:m:h";
-const char PLAY_OPTIONS[] = "f:ac:k:lr:b:e:s:d:p:h";
+const char RECORD_OPTIONS[] = "o:ac:i:m:zh";
+const char PLAY_OPTIONS[] = "f:ac:k:lr:b:e:s:d:p:q:h";
 const char SPLIT_OPTIONS[] = "f:o:c:k:b:e:h";
 const char RECOVER_OPTIONS[] = "f:o:h";
 
@@ -137,6 +137,10 @@ void DisplayUsage(const std::string& binary, const std::string& command,
         std::cout << "\t-p, --preload <seconds>\t\t\t" << command
                   << " after trying to preload n second(s)" << std::endl;
         break;
+      case 'q':
+        std::cout << "\t-q, --prefetch <MB>\t\t\tread files in parallel, "
+                  << "n megabyte(s) ahead" << std::endl;
+        break;
       case 'i':
         std::cout << "\t-i, --segment-interval <seconds>\t" << command
                   << " segmented every n second(s)" << std::endl;
@@ -145,6 +149,10 @@ void DisplayUsage(const std::string& binary, const std::string& command,
         std::cout << "\t-m, --segment-size <MB>\t\t\t" << command
                   << " segmented every n megabyte(s)" << std::endl;
         break;
+      case 'z':
+        std::cout << "\t-z, --compress\t\t\t\t" << command
+                  << " with lz4 compressed chunks" << std::endl;
+        break;
       case 'h':
         std::cout << "\t-h, --help\t\t\t\tshow help message" << std::endl;
         break;
@@ -170,7 +178,7 @@ int main(int argc, char** argv) {
   }
 
   int long_index = 0;
-  const std::string short_opts = "f:c:k:o:alr:b:e:s:d:p:i:m:h";
+  const std::string short_opts = "f:c:k:o:alr:b:e:s:d:p:i:m:zh";
   static const struct option long_opts[] = {
       {"files", required_argument, nullptr, 'f'},
       {"white-channel", required_argument, nullptr, 'c'},
@@ -184,8 +192,10 @@ int main(int argc, char** argv) {
       {"start", required_argument, nullptr, 's'},
       {"delay", required_argument, nullptr, 'd'},
       {"preload", required_argument, nullptr, 'p'},
+      {"prefetch", required_argument, nullptr, 'q'},
       {"segment-interval", required_argument, nullptr, 'i'},
       {"segment-size", required_argument, nullptr, 'm'},
+      {"compress", no_argument, nullptr, 'z'},
       {"help", no_argument, nullptr, 'h'}};
 
   std::vector<std::string> opt_file_vec;
@@ -200,6 +210,7 @@ int main(int argc, char** argv) {
   uint64_t opt_start = 0;
   uint64_t opt_delay = 0;
   uint32_t opt_preload = 3;
+  uint64_t opt_prefetch_mb = 0;
   auto opt_header = HeaderBuilder::GetHeader();
 
   do {
@@ -308,6 +319,25 @@ int main(int argc, char** argv) {
           return -1;
         }
         break;
+      case 'q':
+        try {
+          int prefetch_mb = std::stoi(optarg);
+          if (prefetch_mb < 0) {
+            std::cout << "Argument is less than zero: -q/--prefetch "
+                      << std::string(optarg) << std::endl;
+            return -1;
+          }
+          opt_prefetch_mb = prefetch_mb;
+        } catch (std::invalid_argument& ia) {
+          std::cout << "Invalid argument: -q/--prefetch " << std::string(optarg)
+                    << std::endl;
+          return -1;
+        } catch (const std::out_of_range& e) {
+          std::cout << "Argument is out of range: -q/--prefetch "
+                    << std::string(optarg) << std::endl;
+          return -1;
+        }
+        break;
       case 'i':
         try {
           int interval_s = std::stoi(optarg);
@@ -346,6 +376,10 @@ int main(int argc, char** argv) {
           return -1;
         }
         break;
+      case 'z':
+        opt_header.set_compress(
+            apollo::cyber::proto::CompressType::COMPRESS_LZ4);
+        break;
       case 'h':
         DisplayUsage(binary, command);
         return 0;
@@ -398,6 +432,7 @@ int main(int argc, char** argv) {
     play_param.start_time_s = opt_start;
     play_param.delay_time_s = opt_delay;
     play_param.preload_time_s = opt_preload;
+    play_param.prefetch_bytes = opt_prefetch_mb * 1024 * 1024ULL;
     play_param.files_to_play.insert(opt_file_vec.begin(), opt_file_vec.end());
     play_param.black_channels.insert(opt_black_channels.begin(),
                                      opt_black_channels.end());
@@ -35,6 +35,8 @@ struct PlayParam {
   uint64_t start_time_s = 0;
   uint64_t delay_time_s = 0;
   uint32_t preload_time_s = 3;
+  // look-ahead budget of the parallel file prefetcher, 0 disables it
+  uint64_t prefetch_bytes = 0;
   std::set<std::string> files_to_play;
   std::set<std::string> channels_to_play;
   std::set<std::string> black_channels;
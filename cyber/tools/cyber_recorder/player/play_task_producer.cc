@@ -24,6 +24,7 @@
 #include "cyber/cyber.h"
 #include "cyber/message/protobuf_factory.h"
 #include "cyber/record/record_viewer.h"
+#include "cyber/tools/cyber_recorder/player/record_prefetcher.h"
 
 namespace apollo {
 namespace cyber {
@@ -244,6 +245,16 @@ void PlayTaskProducer::ThreadFunc() {
   uint32_t loop_num = 0;
   while (!is_stopped_.load()) {
     uint64_t plus_time_ns = loop_num * loop_time_ns;
+    if (play_param_.prefetch_bytes > 0) {
+      ProduceFromPrefetcher(plus_time_ns, preload_size, avg_interval_time_ns);
+      if (!play_param_.is_loop_playback) {
+        is_stopped_.store(true);
+        break;
+      }
+      ++loop_num;
+      continue;
+    }
+
     auto itr = record_viewer->begin();
     auto itr_end = record_viewer->end();
 
@@ -277,6 +288,33 @@ void PlayTaskProducer::ThreadFunc() {
   }
 }
 
+void PlayTaskProducer::ProduceFromPrefetcher(uint64_t plus_time_ns,
+                                             uint32_t preload_size,
+                                             uint64_t sleep_interval_ns) {
+  RecordPrefetcher prefetcher(record_readers_, play_param_.begin_time_ns,
+                              play_param_.end_time_ns,
+                              play_param_.channels_to_play,
+                              play_param_.prefetch_bytes);
+  prefetcher.Start();
+  RecordMessage message;
+  while (!is_stopped_.load() && prefetcher.Next(&message)) {
+    auto search = writers_.find(message.channel_name);
+    if (search == writers_.end()) {
+      continue;
+    }
+    while (!is_stopped_.load() && task_buffer_->Size() > preload_size) {
+      std::this_thread::sleep_for(std::chrono::nanoseconds(sleep_interval_ns));
+    }
+    auto raw_msg =
+        std::make_shared<message::RawMessage>(message.content);
+    auto task = std::make_shared<PlayTask>(raw_msg, search->second,
+                                           message.time,
+                                           message.time + plus_time_ns);
+    task_buffer_->Push(task);
+  }
+  prefetcher.Stop();
+}
+
 }  // namespace record
 }  // namespace cyber
 }  // namespace apollo
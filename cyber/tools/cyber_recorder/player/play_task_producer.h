@@ -64,6 +64,8 @@ class PlayTaskProducer {
   bool UpdatePlayParam();
   bool CreateWriters();
   void ThreadFunc();
+  void ProduceFromPrefetcher(uint64_t plus_time_ns, uint32_t preload_size,
+                             uint64_t sleep_interval_ns);
 
   PlayParam play_param_;
   TaskBufferPtr task_buffer_;
@@ -0,0 +1,136 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "cyber/tools/cyber_recorder/player/record_prefetcher.h"
+
+#include <algorithm>
+
+namespace apollo {
+namespace cyber {
+namespace record {
+
+RecordPrefetcher::RecordPrefetcher(const std::vector<RecordReaderPtr>& readers,
+                                   uint64_t begin_time, uint64_t end_time,
+                                   const std::set<std::string>& channels,
+                                   size_t budget_bytes)
+    : begin_time_(begin_time),
+      end_time_(end_time),
+      channels_(channels),
+      lane_budget_(0),
+      is_stopped_(true) {
+  for (auto& reader : readers) {
+    lanes_.emplace_back(new Lane());
+    lanes_.back()->reader = reader;
+  }
+  if (!lanes_.empty()) {
+    lane_budget_ = std::max<size_t>(budget_bytes / lanes_.size(), 1);
+  }
+  heads_.resize(lanes_.size());
+}
+
+RecordPrefetcher::~RecordPrefetcher() { Stop(); }
+
+void RecordPrefetcher::Start() {
+  if (!is_stopped_.exchange(false)) {
+    return;
+  }
+  for (auto& lane : lanes_) {
+    lane->reader->Reset();
+    lane->thread = std::thread(&RecordPrefetcher::ThreadFunc, this, lane.get());
+  }
+}
+
+void RecordPrefetcher::Stop() {
+  if (is_stopped_.exchange(true)) {
+    return;
+  }
+  for (auto& lane : lanes_) {
+    {
+      // the lock orders the flag against a reader about to wait
+      std::lock_guard<std::mutex> lock(lane->mutex);
+    }
+    lane->cv.notify_all();
+    if (lane->thread.joinable()) {
+      lane->thread.join();
+    }
+  }
+}
+
+void RecordPrefetcher::ThreadFunc(Lane* lane) {
+  RecordMessage message;
+  while (!is_stopped_.load() &&
+         lane->reader->ReadMessage(&message, begin_time_, end_time_)) {
+    if (!channels_.empty() && channels_.count(message.channel_name) == 0) {
+      continue;
+    }
+    size_t size = message.content.size();
+    std::unique_lock<std::mutex> lock(lane->mutex);
+    // an empty queue always takes the message, so large ones still progress
+    lane->cv.wait(lock, [this, lane] {
+      return is_stopped_.load() || lane->queue.empty() ||
+             lane->bytes < lane_budget_;
+    });
+    lane->bytes += size;
+    lane->queue.emplace_back(std::move(message));
+    lock.unlock();
+    lane->cv.notify_all();
+  }
+  {
+    std::lock_guard<std::mutex> lock(lane->mutex);
+    lane->finished = true;
+  }
+  lane->cv.notify_all();
+}
+
+bool RecordPrefetcher::Take(size_t index) {
+  auto& lane = lanes_[index];
+  std::unique_lock<std::mutex> lock(lane->mutex);
+  lane->cv.wait(lock, [this, &lane] {
+    return is_stopped_.load() || lane->finished || !lane->queue.empty();
+  });
+  if (lane->queue.empty()) {
+    return false;
+  }
+  heads_[index] = std::move(lane->queue.front());
+  lane->queue.pop_front();
+  lane->bytes -= heads_[index].content.size();
+  lock.unlock();
+  lane->cv.notify_all();
+  head_queue_.emplace(heads_[index].time, index);
+  return true;
+}
+
+bool RecordPrefetcher::Next(RecordMessage* message) {
+  if (!is_merging_) {
+    is_merging_ = true;
+    for (size_t i = 0; i < lanes_.size(); ++i) {
+      Take(i);
+    }
+  }
+  if (is_stopped_.load() || head_queue_.empty()) {
+    return false;
+  }
+  size_t index = head_queue_.top().second;
+  head_queue_.pop();
+  *message = std::move(heads_[index]);
+  Take(index);
+  return true;
+}
+
+}  // namespace record
+}  // namespace cyber
+}  // namespace apollo
@@ -0,0 +1,101 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#ifndef CYBER_TOOLS_CYBER_RECORDER_PLAYER_RECORD_PREFETCHER_H_
+#define CYBER_TOOLS_CYBER_RECORDER_PLAYER_RECORD_PREFETCHER_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <set>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "cyber/record/record_message.h"
+#include "cyber/record/record_reader.h"
+
+namespace apollo {
+namespace cyber {
+namespace record {
+
+/**
+ * @brief Reads several record files in parallel. Every file gets its own
+ * reader thread filling a bounded queue, Next() merges the queue heads by
+ * message time. The look-ahead budget (in bytes of message content) is
+ * split evenly over the files; each file's messages are expected in time
+ * order, which holds for files written by the recorder.
+ */
+class RecordPrefetcher {
+ public:
+  using RecordReaderPtr = std::shared_ptr<RecordReader>;
+
+  RecordPrefetcher(const std::vector<RecordReaderPtr>& readers,
+                   uint64_t begin_time, uint64_t end_time,
+                   const std::set<std::string>& channels, size_t budget_bytes);
+  virtual ~RecordPrefetcher();
+
+  void Start();
+  void Stop();
+
+  /**
+   * @brief Take the earliest message of all files, blocks until it is read.
+   *
+   * @return False once every file is exhausted or the prefetcher stopped.
+   */
+  bool Next(RecordMessage* message);
+
+ private:
+  struct Lane {
+    RecordReaderPtr reader;
+    std::deque<RecordMessage> queue;
+    size_t bytes = 0;
+    bool finished = false;
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::thread thread;
+  };
+  // (time, lane index), smallest time on top
+  using Head = std::pair<uint64_t, size_t>;
+  using HeadQueue =
+      std::priority_queue<Head, std::vector<Head>, std::greater<Head>>;
+
+  void ThreadFunc(Lane* lane);
+  bool Take(size_t index);
+
+  std::vector<std::unique_ptr<Lane>> lanes_;
+  std::vector<RecordMessage> heads_;
+  HeadQueue head_queue_;
+  uint64_t begin_time_;
+  uint64_t end_time_;
+  std::set<std::string> channels_;
+  size_t lane_budget_;
+  bool is_merging_ = false;
+  std::atomic<bool> is_stopped_;
+};
+
+}  // namespace record
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_TOOLS_CYBER_RECORDER_PLAYER_RECORD_PREFETCHER_H_
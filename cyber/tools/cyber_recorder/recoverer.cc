@@ -41,6 +41,7 @@ bool Recoverer::Proc() {
 
   // open output file
   proto::Header new_hdr = HeaderBuilder::GetHeader();
+  new_hdr.set_compress(reader_.GetHeader().compress());
   if (!writer_.Open(output_file_)) {
     AERROR << "open output file failed. file: " << output_file_;
     return false;
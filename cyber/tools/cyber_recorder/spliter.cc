@@ -16,12 +16,66 @@
 
 #include "cyber/tools/cyber_recorder/spliter.h"
 
+#include "google/protobuf/io/coded_stream.h"
+#include "google/protobuf/wire_format_lite.h"
+
+#include "cyber/record/file/chunk_codec.h"
+
 namespace apollo {
 namespace cyber {
 namespace record {
 
 using apollo::cyber::proto::Channel;
+using apollo::cyber::proto::CompressType;
 using apollo::cyber::proto::SectionType;
+using apollo::cyber::proto::SingleMessage;
+using google::protobuf::internal::WireFormatLite;
+
+namespace {
+
+// Counts the messages of serialized chunk body `raw` by channel. Only the
+// channel names are read, the contents are skipped over.
+bool CountMessages(const std::string& raw,
+                   std::unordered_map<std::string, uint64_t>* numbers) {
+  google::protobuf::io::CodedInputStream input(
+      reinterpret_cast<const uint8_t*>(raw.data()),
+      static_cast<int>(raw.size()));
+  uint32_t tag = 0;
+  while ((tag = input.ReadTag()) != 0) {
+    if (WireFormatLite::GetTagFieldNumber(tag) !=
+            ChunkBody::kMessagesFieldNumber ||
+        WireFormatLite::GetTagWireType(tag) !=
+            WireFormatLite::WIRETYPE_LENGTH_DELIMITED) {
+      if (!WireFormatLite::SkipField(&input, tag)) {
+        return false;
+      }
+      continue;
+    }
+    uint32_t length = 0;
+    if (!input.ReadVarint32(&length)) {
+      return false;
+    }
+    auto limit = input.PushLimit(static_cast<int>(length));
+    std::string channel_name;
+    while ((tag = input.ReadTag()) != 0) {
+      bool read = WireFormatLite::GetTagFieldNumber(tag) ==
+                          SingleMessage::kChannelNameFieldNumber
+                      ? WireFormatLite::ReadString(&input, &channel_name)
+                      : WireFormatLite::SkipField(&input, tag);
+      if (!read) {
+        return false;
+      }
+    }
+    if (!input.ConsumedEntireMessage()) {
+      return false;
+    }
+    input.PopLimit(limit);
+    ++(*numbers)[channel_name];
+  }
+  return input.ConsumedEntireMessage();
+}
+
+}  // namespace
 
 Spliter::Spliter(const std::string& input_file, const std::string& output_file,
                  const std::vector<std::string>& white_channels,
@@ -68,6 +122,7 @@ bool Spliter::Proc() {
 
   // open output file
   Header new_hdr = HeaderBuilder::GetHeader();
+  new_hdr.set_compress(header.compress());
   if (!writer_.Open(output_file_)) {
     AERROR << "open output file failed. file: " << output_file_;
     return false;
@@ -76,9 +131,12 @@ bool Spliter::Proc() {
     AERROR << "write header to output file failed. file: " << output_file_;
     return false;
   }
+  // chunk bodies are copied as they are when the output stores them alike
+  bool copy_chunks = writer_.GetHeader().compress() == header.compress();
 
   // read through record file
   bool skip_next_chunk_body(false);
+  ChunkHeader chunk_header;
   reader_.Reset();
   while (!reader_.EndOfFile()) {
     Section section;
@@ -96,23 +154,18 @@ bool Spliter::Proc() {
           AERROR << "read channel section fail.";
           return false;
         }
-        if (white_channels_.empty() ||
-            std::find(white_channels_.begin(), white_channels_.end(),
-                      chan.name()) != white_channels_.end()) {
-          if (std::find(black_channels_.begin(), black_channels_.end(),
-                        chan.name()) == black_channels_.end()) {
-            writer_.WriteChannel(chan);
-          }
+        if (IsChannelKept(chan.name())) {
+          writer_.WriteChannel(chan);
         }
         break;
       }
       case SectionType::SECTION_CHUNK_HEADER: {
-        ChunkHeader chdr;
-        if (!reader_.ReadSection<ChunkHeader>(section.size, &chdr)) {
+        if (!reader_.ReadSection<ChunkHeader>(section.size, &chunk_header)) {
           AERROR << "read chunk header section fail.";
           return false;
         }
-        if (begin_time_ > chdr.end_time() || end_time_ < chdr.begin_time()) {
+        if (begin_time_ > chunk_header.end_time() ||
+            end_time_ < chunk_header.begin_time()) {
           skip_next_chunk_body = true;
         }
         break;
@@ -123,32 +176,9 @@ bool Spliter::Proc() {
           skip_next_chunk_body = false;
           break;
         }
-        ChunkBody cbd;
-        if (!reader_.ReadSection<ChunkBody>(section.size, &cbd)) {
-          AERROR << "read chunk body section fail.";
+        if (!ProcChunkBody(section.size, chunk_header, copy_chunks)) {
           return false;
         }
-        for (int idx = 0; idx < cbd.messages_size(); ++idx) {
-          if (!white_channels_.empty() &&
-              std::find(white_channels_.begin(), white_channels_.end(),
-                        cbd.messages(idx).channel_name()) ==
-                  white_channels_.end()) {
-            continue;
-          }
-          if (std::find(black_channels_.begin(), black_channels_.end(),
-                        cbd.messages(idx).channel_name()) !=
-              black_channels_.end()) {
-            continue;
-          }
-          if (cbd.messages(idx).time() < begin_time_ ||
-              cbd.messages(idx).time() > end_time_) {
-            continue;
-          }
-          if (!writer_.WriteMessage(cbd.messages(idx))) {
-            AERROR << "add new message failed.";
-            return false;
-          }
-        }
         break;
       }
       default: {
@@ -162,6 +192,70 @@ bool Spliter::Proc() {
   return true;
 }  // end for Proc()
 
+bool Spliter::IsChannelKept(const std::string& channel_name) const {
+  if (!white_channels_.empty() &&
+      std::find(white_channels_.begin(), white_channels_.end(),
+                channel_name) == white_channels_.end()) {
+    return false;
+  }
+  return std::find(black_channels_.begin(), black_channels_.end(),
+                   channel_name) == black_channels_.end();
+}
+
+bool Spliter::ProcChunkBody(int64_t size, const ChunkHeader& chunk_header,
+                            bool copy_chunks) {
+  std::string data;
+  if (!reader_.ReadRawSection(size, &data)) {
+    AERROR << "read chunk body section fail.";
+    return false;
+  }
+  std::string decoded;
+  const std::string* raw = &data;
+  if (reader_.GetHeader().compress() != CompressType::COMPRESS_NONE) {
+    if (!ChunkCodec::Decode(data.data(), data.size(), &decoded)) {
+      AERROR << "decode chunk body section fail.";
+      return false;
+    }
+    raw = &decoded;
+  }
+
+  // a chunk whose messages are all kept is copied without parsing them
+  std::unordered_map<std::string, uint64_t> message_numbers;
+  bool in_range = chunk_header.begin_time() >= begin_time_ &&
+                  chunk_header.end_time() <= end_time_;
+  if (copy_chunks && in_range && CountMessages(*raw, &message_numbers) &&
+      std::all_of(message_numbers.begin(), message_numbers.end(),
+                  [this](const std::pair<const std::string, uint64_t>& item) {
+                    return IsChannelKept(item.first);
+                  })) {
+    if (!writer_.WriteRawChunk(chunk_header, data, message_numbers)) {
+      AERROR << "copy chunk failed.";
+      return false;
+    }
+    return true;
+  }
+
+  ChunkBody cbd;
+  if (!cbd.ParseFromString(*raw)) {
+    AERROR << "parse chunk body section fail.";
+    return false;
+  }
+  for (int idx = 0; idx < cbd.messages_size(); ++idx) {
+    if (!IsChannelKept(cbd.messages(idx).channel_name())) {
+      continue;
+    }
+    if (cbd.messages(idx).time() < begin_time_ ||
+        cbd.messages(idx).time() > end_time_) {
+      continue;
+    }
+    if (!writer_.WriteMessage(cbd.messages(idx))) {
+      AERROR << "add new message failed.";
+      return false;
+    }
+  }
+  return true;
+}
+
 }  // namespace record
 }  // namespace cyber
 }  // namespace apollo
@@ -21,6 +21,7 @@
 #include <limits>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "cyber/common/log.h"
@@ -49,6 +50,12 @@ class Spliter {
   bool Proc();
 
  private:
+  bool IsChannelKept(const std::string& channel_name) const;
+  // Writes the kept messages of the chunk body section of `size` bytes.
+  // The body is copied as it is when all of its messages are kept.
+  bool ProcChunkBody(int64_t size, const ChunkHeader& chunk_header,
+                     bool copy_chunks);
+
   RecordFileReader reader_;
   RecordFileWriter writer_;
   std::string input_file_;
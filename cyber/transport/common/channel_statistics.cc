@@ -0,0 +1,181 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/transport/common/channel_statistics.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <map>
+
+#include "cyber/time/time.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+namespace {
+
+// single writer per slot, so a load and a store are enough and avoid the
+// locked read-modify-write on the publish path
+inline void Bump(std::atomic<uint64_t>* counter, uint64_t value) {
+  counter->store(counter->load(std::memory_order_relaxed) + value,
+                 std::memory_order_relaxed);
+}
+
+}  // namespace
+
+// returns the thread's table to the pool when the thread exits
+struct ChannelStatistics::TableHolder {
+  ~TableHolder() {
+    if (table != nullptr) {
+      table->in_use.store(false, std::memory_order_release);
+    }
+  }
+
+  Table* table = nullptr;
+  uint64_t last_channel_id = 0;
+  Counters* last_counters = nullptr;
+};
+
+ChannelStatistics::ChannelStatistics() {
+  const char* env = std::getenv("CYBER_TRANSPORT_STATS");
+  enabled_ = env == nullptr || std::strcmp(env, "0") != 0;
+}
+
+ChannelStatistics::Table* ChannelStatistics::AcquireTable() {
+  for (auto table = tables_.load(std::memory_order_acquire); table != nullptr;
+       table = table->next) {
+    bool in_use = false;
+    if (!table->in_use.load(std::memory_order_relaxed) &&
+        table->in_use.compare_exchange_strong(in_use, true,
+                                              std::memory_order_acquire)) {
+      return table;
+    }
+  }
+  auto table = new Table();
+  table->next = tables_.load(std::memory_order_relaxed);
+  while (!tables_.compare_exchange_weak(table->next, table,
+                                        std::memory_order_release,
+                                        std::memory_order_relaxed)) {
+  }
+  return table;
+}
+
+ChannelStatistics::Counters* ChannelStatistics::Local(uint64_t channel_id) {
+  static thread_local TableHolder holder;
+  if (holder.last_counters != nullptr &&
+      holder.last_channel_id == channel_id) {
+    return holder.last_counters;
+  }
+  if (holder.table == nullptr) {
+    holder.table = AcquireTable();
+  }
+  auto table = holder.table;
+  auto& counters = table->index[channel_id];
+  if (counters == nullptr) {
+    counters = new Counters(channel_id);
+    counters->next = table->counters.load(std::memory_order_relaxed);
+    table->counters.store(counters, std::memory_order_release);
+  }
+  holder.last_channel_id = channel_id;
+  holder.last_counters = counters;
+  return counters;
+}
+
+void ChannelStatistics::AddTransmit(uint64_t channel_id, uint64_t bytes) {
+  if (!enabled_) {
+    return;
+  }
+  auto counters = Local(channel_id);
+  Bump(&counters->tx_msgs, 1);
+  Bump(&counters->tx_bytes, bytes);
+}
+
+void ChannelStatistics::AddTransmitBytes(uint64_t channel_id,
+                                         uint64_t bytes) {
+  if (!enabled_) {
+    return;
+  }
+  Bump(&Local(channel_id)->tx_bytes, bytes);
+}
+
+void ChannelStatistics::AddReceive(uint64_t channel_id, uint64_t bytes,
+                                   uint64_t send_time) {
+  if (!enabled_) {
+    return;
+  }
+  auto counters = Local(channel_id);
+  Bump(&counters->rx_msgs, 1);
+  Bump(&counters->rx_bytes, bytes);
+  if (send_time == 0) {
+    return;
+  }
+  auto now = Time::Now().ToNanosecond();
+  // clocks of different hosts may disagree, drop what cannot be right
+  if (now < send_time) {
+    return;
+  }
+  auto latency = now - send_time;
+  Bump(&counters->latency_sum, latency);
+  Bump(&counters->latency_count, 1);
+  if (latency > counters->latency_max.load(std::memory_order_relaxed)) {
+    counters->latency_max.store(latency, std::memory_order_relaxed);
+  }
+}
+
+void ChannelStatistics::AddDropped(uint64_t channel_id, uint64_t dropped) {
+  if (!enabled_) {
+    return;
+  }
+  Bump(&Local(channel_id)->dropped, dropped);
+}
+
+void ChannelStatistics::Collect(std::vector<ChannelSample>* samples) {
+  std::map<uint64_t, ChannelSample> merged;
+  for (auto table = tables_.load(std::memory_order_acquire); table != nullptr;
+       table = table->next) {
+    for (auto counters = table->counters.load(std::memory_order_acquire);
+         counters != nullptr; counters = counters->next) {
+      auto& sample = merged[counters->channel_id];
+      sample.channel_id = counters->channel_id;
+      sample.tx_msgs += counters->tx_msgs.load(std::memory_order_relaxed);
+      sample.tx_bytes += counters->tx_bytes.load(std::memory_order_relaxed);
+      sample.rx_msgs += counters->rx_msgs.load(std::memory_order_relaxed);
+      sample.rx_bytes += counters->rx_bytes.load(std::memory_order_relaxed);
+      sample.dropped += counters->dropped.load(std::memory_order_relaxed);
+      sample.latency_sum +=
+          counters->latency_sum.load(std::memory_order_relaxed);
+      sample.latency_count +=
+          counters->latency_count.load(std::memory_order_relaxed);
+      // a concurrent store may survive the reset, the next interval then
+      // reports a max from this one
+      auto max =
+          counters->latency_max.exchange(0, std::memory_order_relaxed);
+      if (max > sample.latency_max) {
+        sample.latency_max = max;
+      }
+    }
+  }
+  samples->clear();
+  samples->reserve(merged.size());
+  for (auto& item : merged) {
+    samples->push_back(item.second);
+  }
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
@@ -0,0 +1,112 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_TRANSPORT_COMMON_CHANNEL_STATISTICS_H_
+#define CYBER_TRANSPORT_COMMON_CHANNEL_STATISTICS_H_
+
+#include <atomic>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "cyber/common/macros.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+/**
+ * @brief Totals of one channel in this process since it started, except
+ * latency_max which covers the time since the previous Collect().
+ */
+struct ChannelSample {
+  uint64_t channel_id = 0;
+  uint64_t tx_msgs = 0;
+  uint64_t tx_bytes = 0;
+  uint64_t rx_msgs = 0;
+  uint64_t rx_bytes = 0;
+  uint64_t dropped = 0;
+  uint64_t latency_sum = 0;
+  uint64_t latency_count = 0;
+  uint64_t latency_max = 0;
+};
+
+/**
+ * @class ChannelStatistics
+ * @brief Per channel transport counters. Every thread bumps its own slots
+ * with plain relaxed stores, Collect() sums the slots of all threads without
+ * stopping them. Tables of exited threads are handed to the next new thread,
+ * so their counts are kept and memory is bounded by the peak thread count.
+ *
+ * Transmitters count published messages, the dispatchers count what arrived
+ * together with the publish-to-dispatch latency in nanoseconds, and
+ * ChannelBuffer counts the messages readers lost to overflow. Setting
+ * CYBER_TRANSPORT_STATS=0 turns all of it into a no-op.
+ */
+class ChannelStatistics {
+ public:
+  bool enabled() const { return enabled_; }
+
+  void AddTransmit(uint64_t channel_id, uint64_t bytes);
+  // bytes of a message already counted by AddTransmit, for transmitters
+  // that only learn the size once they serialized it
+  void AddTransmitBytes(uint64_t channel_id, uint64_t bytes);
+  // send_time is MessageInfo::send_time(), 0 skips the latency sample
+  void AddReceive(uint64_t channel_id, uint64_t bytes, uint64_t send_time);
+  void AddDropped(uint64_t channel_id, uint64_t dropped);
+
+  void Collect(std::vector<ChannelSample>* samples);
+
+ private:
+  struct Counters {
+    explicit Counters(uint64_t id) : channel_id(id) {}
+
+    const uint64_t channel_id;
+    std::atomic<uint64_t> tx_msgs{0};
+    std::atomic<uint64_t> tx_bytes{0};
+    std::atomic<uint64_t> rx_msgs{0};
+    std::atomic<uint64_t> rx_bytes{0};
+    std::atomic<uint64_t> dropped{0};
+    std::atomic<uint64_t> latency_sum{0};
+    std::atomic<uint64_t> latency_count{0};
+    std::atomic<uint64_t> latency_max{0};
+    Counters* next = nullptr;
+  };
+
+  struct Table {
+    std::atomic<bool> in_use{true};
+    // only touched by the owning thread
+    std::unordered_map<uint64_t, Counters*> index;
+    std::atomic<Counters*> counters{nullptr};
+    Table* next = nullptr;
+  };
+
+  struct TableHolder;
+
+  Counters* Local(uint64_t channel_id);
+  Table* AcquireTable();
+
+  bool enabled_ = true;
+  std::atomic<Table*> tables_{nullptr};
+
+  DECLARE_SINGLETON(ChannelStatistics);
+};
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_TRANSPORT_COMMON_CHANNEL_STATISTICS_H_
@@ -0,0 +1,103 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/transport/common/channel_statistics.h"
+
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "cyber/time/time.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+namespace {
+
+ChannelSample Find(uint64_t channel_id) {
+  std::vector<ChannelSample> samples;
+  ChannelStatistics::Instance()->Collect(&samples);
+  for (const auto& sample : samples) {
+    if (sample.channel_id == channel_id) {
+      return sample;
+    }
+  }
+  return ChannelSample();
+}
+
+}  // namespace
+
+TEST(ChannelStatisticsTest, sum_over_threads) {
+  auto stats = ChannelStatistics::Instance();
+  ASSERT_TRUE(stats->enabled());
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([stats]() {
+      for (int j = 0; j < 1000; ++j) {
+        stats->AddTransmit(1001, 10);
+        stats->AddTransmitBytes(1001, 1);
+        stats->AddReceive(1002, 20, 0);
+      }
+      stats->AddDropped(1002, 3);
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  auto tx = Find(1001);
+  EXPECT_EQ(4000, tx.tx_msgs);
+  EXPECT_EQ(44000, tx.tx_bytes);
+  EXPECT_EQ(0, tx.rx_msgs);
+
+  auto rx = Find(1002);
+  EXPECT_EQ(4000, rx.rx_msgs);
+  EXPECT_EQ(80000, rx.rx_bytes);
+  EXPECT_EQ(12, rx.dropped);
+  EXPECT_EQ(0, rx.latency_count);
+
+  // exited threads hand their tables over instead of losing the counts
+  std::thread([stats]() { stats->AddTransmit(1001, 0); }).join();
+  EXPECT_EQ(4001, Find(1001).tx_msgs);
+}
+
+TEST(ChannelStatisticsTest, latency) {
+  auto stats = ChannelStatistics::Instance();
+  auto now = Time::Now().ToNanosecond();
+  stats->AddReceive(2001, 0, now - 5000000);
+  stats->AddReceive(2001, 0, now - 1000000);
+  // a sender clock ahead of ours gives no sample
+  stats->AddReceive(2001, 0, now + 1000000000);
+
+  auto sample = Find(2001);
+  EXPECT_EQ(3, sample.rx_msgs);
+  EXPECT_EQ(2, sample.latency_count);
+  EXPECT_GE(sample.latency_max, 5000000);
+  EXPECT_GE(sample.latency_sum, 6000000);
+  EXPECT_LT(sample.latency_sum, 6000000 + 2000000000);
+
+  // max only covers the time since the previous collect
+  sample = Find(2001);
+  EXPECT_EQ(2, sample.latency_count);
+  EXPECT_EQ(0, sample.latency_max);
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
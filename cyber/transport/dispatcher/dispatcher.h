@@ -30,6 +30,7 @@
 #include "cyber/common/global_data.h"
 #include "cyber/common/log.h"
 #include "cyber/proto/role_attributes.pb.h"
+#include "cyber/transport/common/channel_statistics.h"
 #include "cyber/transport/message/listener_handler.h"
 #include "cyber/transport/message/message_info.h"
 
@@ -292,6 +292,9 @@ void IntraDispatcher::OnMessage(uint64_t channel_id,
   ADEBUG << "intra on message, channel:"
          << common::GlobalData::GetChannelById(channel_id);
   if (msg_listeners_.Get(channel_id, &handler_base)) {
+    // nothing is serialized on this path, only messages are counted
+    ChannelStatistics::Instance()->AddReceive(channel_id, 0,
+                                              message_info.send_time());
     auto handler =
         std::dynamic_pointer_cast<ListenerHandler<MessageT>>(*handler_base);
     if (handler) {
@@ -0,0 +1,416 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/transport/dispatcher/rdma_dispatcher.h"
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "cyber/common/global_data.h"
+#include "cyber/scheduler/scheduler_factory.h"
+#include "cyber/transport/rdma/rdma_conf.h"
+#include "cyber/transport/rdma/rdma_context.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+using common::GlobalData;
+
+namespace {
+constexpr int kHandshakeTimeoutMs = 500;
+constexpr uint32_t kMaxBlockNum = 1024;
+constexpr uint64_t kMaxBlockSize = 1ULL << 30;
+constexpr size_t kAlignment = 4096;
+}  // namespace
+
+RdmaDispatcher::RdmaDispatcher() {
+  if (!Init()) {
+    AINFO << "writers on other hosts can not use rdma to this process.";
+  }
+}
+
+RdmaDispatcher::~RdmaDispatcher() { Shutdown(); }
+
+void RdmaDispatcher::Shutdown() {
+  if (is_shutdown_.exchange(true)) {
+    return;
+  }
+
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+
+  {
+    WriteLockGuard<AtomicRWLock> lock(writers_lock_);
+    writers_.clear();
+  }
+  for (auto& item : connections_) {
+    Release(item.second.get());
+    close(item.first);
+  }
+  connections_.clear();
+  if (listen_fd_ >= 0) {
+    close(listen_fd_);
+    listen_fd_ = -1;
+  }
+  if (comp_channel_ != nullptr) {
+    ibv_destroy_comp_channel(comp_channel_);
+    comp_channel_ = nullptr;
+  }
+}
+
+bool RdmaDispatcher::IsConnected(uint64_t channel_id, uint64_t writer_id) {
+  ReadLockGuard<AtomicRWLock> lock(writers_lock_);
+  auto iter = writers_.find(channel_id);
+  return iter != writers_.end() && iter->second.count(writer_id) > 0;
+}
+
+bool RdmaDispatcher::Init() {
+  auto context = RdmaContext::Instance();
+  if (!context->Ready()) {
+    return false;
+  }
+  comp_channel_ = ibv_create_comp_channel(context->context());
+  if (comp_channel_ == nullptr) {
+    AERROR << "create rdma completion channel failed: " << strerror(errno);
+    return false;
+  }
+  fcntl(comp_channel_->fd, F_SETFL,
+        fcntl(comp_channel_->fd, F_GETFL) | O_NONBLOCK);
+
+  auto port = RdmaConf::ListenPort(GlobalData::Instance()->ProcessId());
+  int fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  int one = 1;
+  setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+  sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_ANY);
+  addr.sin_port = htons(port);
+  if (fd < 0 ||
+      bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+      listen(fd, 16) != 0) {
+    AERROR << "listen on rdma port " << port << " failed: " << strerror(errno);
+    if (fd >= 0) {
+      close(fd);
+    }
+    return false;
+  }
+  listen_fd_ = fd;
+
+  thread_ = std::thread(&RdmaDispatcher::ThreadFunc, this);
+  scheduler::Instance()->SetInnerThreadAttr("rdma_disp", &thread_);
+  return true;
+}
+
+void RdmaDispatcher::ThreadFunc() {
+  std::vector<pollfd> fds;
+  while (!is_shutdown_.load()) {
+    fds.clear();
+    fds.push_back({listen_fd_, POLLIN, 0});
+    fds.push_back({comp_channel_->fd, POLLIN, 0});
+    for (auto& item : connections_) {
+      fds.push_back({item.first, POLLIN, 0});
+    }
+    if (poll(fds.data(), fds.size(), 100) <= 0) {
+      continue;
+    }
+
+    if (fds[1].revents & POLLIN) {
+      ibv_cq* cq = nullptr;
+      void* cq_context = nullptr;
+      while (ibv_get_cq_event(comp_channel_, &cq, &cq_context) == 0) {
+        ibv_ack_cq_events(cq, 1);
+        ibv_req_notify_cq(cq, 0);
+        Poll(static_cast<Connection*>(cq_context));
+      }
+    }
+    // a writer closes its TCP connection when it goes away
+    char byte = 0;
+    for (size_t i = 2; i < fds.size(); ++i) {
+      auto iter = connections_.find(fds[i].fd);
+      if (iter->second->broken ||
+          ((fds[i].revents & (POLLIN | POLLHUP | POLLERR)) &&
+           recv(fds[i].fd, &byte, 1, MSG_DONTWAIT) <= 0)) {
+        Close(fds[i].fd);
+      }
+    }
+    if (fds[0].revents & POLLIN) {
+      Accept();
+    }
+  }
+}
+
+void RdmaDispatcher::Accept() {
+  int fd = accept4(listen_fd_, nullptr, nullptr, SOCK_CLOEXEC);
+  if (fd < 0) {
+    return;
+  }
+  timeval tv = {0, kHandshakeTimeoutMs * 1000};
+  setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+  setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+
+  std::string data;
+  RdmaRequest request;
+  if (!RecvAll(fd, RdmaRequest::kSize, &data) || !request.Decode(data)) {
+    AWARN << "invalid rdma connection request.";
+    close(fd);
+    return;
+  }
+  ConnectionPtr conn(new Connection());
+  conn->fd = fd;
+  RdmaReply reply;
+  bool ok = Setup(request, conn.get(), &reply);
+  if (!SendAll(fd, reply.Encode()) || !ok) {
+    Release(conn.get());
+    close(fd);
+    return;
+  }
+
+  ADEBUG << "rdma writer " << request.writer_id << " connected, channel: "
+         << GlobalData::GetChannelById(request.channel_id);
+  {
+    WriteLockGuard<AtomicRWLock> lock(writers_lock_);
+    ++writers_[conn->channel_id][conn->writer_id];
+  }
+  connections_[fd] = std::move(conn);
+}
+
+bool RdmaDispatcher::Setup(const RdmaRequest& request, Connection* conn,
+                           RdmaReply* reply) {
+  reply->status = RdmaReply::NO_READER;
+  if (request.process_id !=
+          static_cast<uint64_t>(GlobalData::Instance()->ProcessId()) ||
+      !HasChannel(request.channel_id)) {
+    return false;
+  }
+  reply->status = RdmaReply::NO_RESOURCE;
+  if (request.block_num == 0 || request.block_num > kMaxBlockNum ||
+      request.block_size == 0 || request.block_size > kMaxBlockSize) {
+    AERROR << "invalid rdma blocks: " << request.block_num << " x "
+           << request.block_size;
+    return false;
+  }
+  conn->channel_id = request.channel_id;
+  conn->writer_id = request.writer_id;
+  conn->block_size = request.block_size;
+  conn->block_num = request.block_num;
+  conn->credit_addr = request.credit_addr;
+  conn->credit_rkey = request.credit_rkey;
+
+  auto context = RdmaContext::Instance();
+  conn->cq = ibv_create_cq(context->context(),
+                           static_cast<int>(conn->block_num) * 3 + 1, conn,
+                           comp_channel_, 0);
+  if (conn->cq == nullptr || ibv_req_notify_cq(conn->cq, 0) != 0) {
+    AERROR << "create rdma completion queue failed: " << strerror(errno);
+    return false;
+  }
+  // acks go out through the send queue, one per message at most
+  conn->qp = context->CreateQp(conn->cq, conn->cq, conn->block_num * 2,
+                               conn->block_num);
+  uint64_t ring_size = conn->block_size * conn->block_num;
+  if (posix_memalign(reinterpret_cast<void**>(&conn->ring), kAlignment,
+                     ring_size) != 0) {
+    conn->ring = nullptr;
+  }
+  if (posix_memalign(reinterpret_cast<void**>(&conn->consumed), kAlignment,
+                     sizeof(uint64_t)) != 0) {
+    conn->consumed = nullptr;
+  }
+  if (conn->qp == nullptr || conn->ring == nullptr ||
+      conn->consumed == nullptr) {
+    AERROR << "allocate rdma reader resources failed.";
+    return false;
+  }
+  *conn->consumed = 0;
+  conn->ring_mr =
+      ibv_reg_mr(context->pd(), conn->ring, ring_size,
+                 IBV_ACCESS_LOCAL_WRITE | IBV_ACCESS_REMOTE_WRITE);
+  conn->consumed_mr = ibv_reg_mr(context->pd(), conn->consumed,
+                                 sizeof(uint64_t), IBV_ACCESS_LOCAL_WRITE);
+  if (conn->ring_mr == nullptr || conn->consumed_mr == nullptr) {
+    AERROR << "register rdma reader memory failed: " << strerror(errno);
+    return false;
+  }
+  for (uint32_t i = 0; i < conn->block_num; ++i) {
+    if (!PostRecv(conn)) {
+      return false;
+    }
+  }
+
+  uint32_t psn = static_cast<uint32_t>(lrand48()) & 0xffffff;
+  if (!context->ConnectQp(conn->qp, psn, request.qp)) {
+    return false;
+  }
+  reply->status = RdmaReply::OK;
+  reply->qp = context->LocalInfo(conn->qp, psn);
+  reply->ring_addr = reinterpret_cast<uint64_t>(conn->ring);
+  reply->ring_rkey = conn->ring_mr->rkey;
+  return true;
+}
+
+bool RdmaDispatcher::PostRecv(Connection* conn) {
+  // writes with immediate data consume a receive without scatter entries
+  ibv_recv_wr wr;
+  memset(&wr, 0, sizeof(wr));
+  ibv_recv_wr* bad_wr = nullptr;
+  if (ibv_post_recv(conn->qp, &wr, &bad_wr) != 0) {
+    AERROR << "post rdma receive failed: " << strerror(errno);
+    conn->broken = true;
+    return false;
+  }
+  return true;
+}
+
+void RdmaDispatcher::Poll(Connection* conn) {
+  ibv_wc wcs[16];
+  int n = 0;
+  while ((n = ibv_poll_cq(conn->cq, 16, wcs)) > 0) {
+    for (int i = 0; i < n; ++i) {
+      if (wcs[i].status != IBV_WC_SUCCESS) {
+        AERROR << "rdma connection of channel "
+               << GlobalData::GetChannelById(conn->channel_id)
+               << " failed: " << ibv_wc_status_str(wcs[i].status);
+        conn->broken = true;
+        continue;
+      }
+      if (wcs[i].opcode != IBV_WC_RECV_RDMA_WITH_IMM) {
+        continue;
+      }
+      ReadMessage(conn, ntohl(wcs[i].imm_data));
+      if (PostRecv(conn)) {
+        Acknowledge(conn);
+      }
+    }
+  }
+}
+
+void RdmaDispatcher::ReadMessage(Connection* conn, uint32_t block_index) {
+  if (is_shutdown_.load() || block_index >= conn->block_num) {
+    return;
+  }
+  const char* block = conn->ring + block_index * conn->block_size;
+  RdmaBlockHeader header;
+  memcpy(&header, block, sizeof(header));
+  if (sizeof(header) + header.msg_size + header.msg_info_size >
+      conn->block_size) {
+    AERROR << "invalid rdma block of channel "
+           << GlobalData::GetChannelById(conn->channel_id);
+    return;
+  }
+
+  auto rb = std::make_shared<RdmaBlock>();
+  rb->buf = block + sizeof(header);
+  rb->msg_size = header.msg_size;
+  MessageInfo msg_info;
+  if (!msg_info.DeserializeFrom(rb->buf + header.msg_size,
+                                header.msg_info_size)) {
+    AERROR << "error msg info of channel:"
+           << GlobalData::GetChannelById(conn->channel_id);
+    return;
+  }
+
+  ListenerHandlerBasePtr* handler_base = nullptr;
+  if (msg_listeners_.Get(conn->channel_id, &handler_base)) {
+    ChannelStatistics::Instance()->AddReceive(
+        conn->channel_id, header.msg_size, msg_info.send_time());
+    auto handler =
+        std::dynamic_pointer_cast<ListenerHandler<RdmaBlock>>(*handler_base);
+    // listeners parse the message before returning, the block is reused
+    // once it is acknowledged
+    handler->Run(rb, msg_info);
+  }
+}
+
+void RdmaDispatcher::Acknowledge(Connection* conn) {
+  ++*conn->consumed;
+  ibv_sge sge;
+  sge.addr = reinterpret_cast<uint64_t>(conn->consumed);
+  sge.length = sizeof(uint64_t);
+  sge.lkey = conn->consumed_mr->lkey;
+  ibv_send_wr wr;
+  memset(&wr, 0, sizeof(wr));
+  wr.sg_list = &sge;
+  wr.num_sge = 1;
+  wr.opcode = IBV_WR_RDMA_WRITE;
+  wr.send_flags = IBV_SEND_SIGNALED;
+  wr.wr.rdma.remote_addr = conn->credit_addr;
+  wr.wr.rdma.rkey = conn->credit_rkey;
+  ibv_send_wr* bad_wr = nullptr;
+  if (ibv_post_send(conn->qp, &wr, &bad_wr) != 0) {
+    AERROR << "post rdma ack failed: " << strerror(errno);
+    conn->broken = true;
+  }
+}
+
+void RdmaDispatcher::Close(int fd) {
+  auto iter = connections_.find(fd);
+  if (iter == connections_.end()) {
+    return;
+  }
+  auto& conn = iter->second;
+  {
+    WriteLockGuard<AtomicRWLock> lock(writers_lock_);
+    auto& writers = writers_[conn->channel_id];
+    if (--writers[conn->writer_id] <= 0) {
+      writers.erase(conn->writer_id);
+    }
+    if (writers.empty()) {
+      writers_.erase(conn->channel_id);
+    }
+  }
+  Release(conn.get());
+  close(fd);
+  connections_.erase(iter);
+}
+
+void RdmaDispatcher::Release(Connection* conn) {
+  if (conn->qp != nullptr) {
+    ibv_destroy_qp(conn->qp);
+    conn->qp = nullptr;
+  }
+  if (conn->cq != nullptr) {
+    ibv_destroy_cq(conn->cq);
+    conn->cq = nullptr;
+  }
+  if (conn->ring_mr != nullptr) {
+    ibv_dereg_mr(conn->ring_mr);
+    conn->ring_mr = nullptr;
+  }
+  if (conn->consumed_mr != nullptr) {
+    ibv_dereg_mr(conn->consumed_mr);
+    conn->consumed_mr = nullptr;
+  }
+  free(conn->ring);
+  conn->ring = nullptr;
+  free(conn->consumed);
+  conn->consumed = nullptr;
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
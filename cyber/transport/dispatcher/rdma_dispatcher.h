@@ -0,0 +1,169 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_TRANSPORT_DISPATCHER_RDMA_DISPATCHER_H_
+#define CYBER_TRANSPORT_DISPATCHER_RDMA_DISPATCHER_H_
+
+#include <infiniband/verbs.h>
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <thread>
+#include <unordered_map>
+
+#include "cyber/base/atomic_rw_lock.h"
+#include "cyber/common/log.h"
+#include "cyber/common/macros.h"
+#include "cyber/message/arena_pool.h"
+#include "cyber/message/message_traits.h"
+#include "cyber/transport/dispatcher/dispatcher.h"
+#include "cyber/transport/rdma/rdma_handshake.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+class RdmaDispatcher;
+using RdmaDispatcherPtr = RdmaDispatcher*;
+
+/**
+ * A message written by a writer on another host, valid while it is handled.
+ */
+struct RdmaBlock {
+  const char* buf = nullptr;
+  uint32_t msg_size = 0;
+};
+
+/**
+ * @class RdmaDispatcher
+ * @brief Takes RDMA connections of writers on other hosts for the channels
+ * this process reads, and hands the messages they write to the listeners.
+ * Writers find it at RdmaConf::ListenPort() of the process.
+ */
+class RdmaDispatcher : public Dispatcher {
+ public:
+  virtual ~RdmaDispatcher();
+
+  void Shutdown() override;
+
+  /**
+   * @brief Whether writers of other hosts can connect to this process.
+   */
+  bool Ready() const { return listen_fd_ >= 0; }
+
+  /**
+   * @brief Whether the writer `writer_id` sends `channel_id` over RDMA to
+   * this process, so that its copies coming over RTPS are duplicates.
+   */
+  bool IsConnected(uint64_t channel_id, uint64_t writer_id);
+
+  template <typename MessageT>
+  void AddListener(const RoleAttributes& self_attr,
+                   const MessageListener<MessageT>& listener);
+
+  template <typename MessageT>
+  void AddListener(const RoleAttributes& self_attr,
+                   const RoleAttributes& opposite_attr,
+                   const MessageListener<MessageT>& listener);
+
+ private:
+  struct Connection {
+    int fd = -1;
+    uint64_t channel_id = 0;
+    uint64_t writer_id = 0;
+    ibv_cq* cq = nullptr;
+    ibv_qp* qp = nullptr;
+    char* ring = nullptr;
+    ibv_mr* ring_mr = nullptr;
+    uint64_t* consumed = nullptr;
+    ibv_mr* consumed_mr = nullptr;
+    uint64_t block_size = 0;
+    uint32_t block_num = 0;
+    uint64_t credit_addr = 0;
+    uint32_t credit_rkey = 0;
+    bool broken = false;
+  };
+  using ConnectionPtr = std::unique_ptr<Connection>;
+
+  bool Init();
+  void ThreadFunc();
+  void Accept();
+  bool Setup(const RdmaRequest& request, Connection* conn, RdmaReply* reply);
+  bool PostRecv(Connection* conn);
+  void Poll(Connection* conn);
+  void ReadMessage(Connection* conn, uint32_t block_index);
+  void Acknowledge(Connection* conn);
+  void Close(int fd);
+  static void Release(Connection* conn);
+
+  int listen_fd_ = -1;
+  ibv_comp_channel* comp_channel_ = nullptr;
+  // key: fd of the TCP connection, only touched by thread_
+  std::unordered_map<int, ConnectionPtr> connections_;
+  // key: channel_id, value: writer ids with their number of connections
+  std::unordered_map<uint64_t, std::map<uint64_t, int>> writers_;
+  AtomicRWLock writers_lock_;
+  std::thread thread_;
+
+  DECLARE_SINGLETON(RdmaDispatcher)
+};
+
+template <typename MessageT>
+void RdmaDispatcher::AddListener(const RoleAttributes& self_attr,
+                                 const MessageListener<MessageT>& listener) {
+  const auto use_arena =
+      message::ArenaPool::Instance()->ChannelFlag(self_attr.channel_id());
+  auto listener_adapter = [listener, use_arena](
+                              const std::shared_ptr<RdmaBlock>& rb,
+                              const MessageInfo& msg_info) {
+    auto msg = message::NewMessage<MessageT>(
+        use_arena->load(std::memory_order_relaxed));
+    RETURN_IF(!message::ParseFromArray(rb->buf,
+                                       static_cast<int>(rb->msg_size),
+                                       msg.get()));
+    listener(msg, msg_info);
+  };
+
+  Dispatcher::AddListener<RdmaBlock>(self_attr, listener_adapter);
+}
+
+template <typename MessageT>
+void RdmaDispatcher::AddListener(const RoleAttributes& self_attr,
+                                 const RoleAttributes& opposite_attr,
+                                 const MessageListener<MessageT>& listener) {
+  const auto use_arena =
+      message::ArenaPool::Instance()->ChannelFlag(self_attr.channel_id());
+  auto listener_adapter = [listener, use_arena](
+                              const std::shared_ptr<RdmaBlock>& rb,
+                              const MessageInfo& msg_info) {
+    auto msg = message::NewMessage<MessageT>(
+        use_arena->load(std::memory_order_relaxed));
+    RETURN_IF(!message::ParseFromArray(rb->buf,
+                                       static_cast<int>(rb->msg_size),
+                                       msg.get()));
+    listener(msg, msg_info);
+  };
+
+  Dispatcher::AddListener<RdmaBlock>(self_attr, opposite_attr,
+                                     listener_adapter);
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_TRANSPORT_DISPATCHER_RDMA_DISPATCHER_H_
@@ -77,6 +77,8 @@ void RtpsDispatcher::OnMessage(uint64_t channel_id,
 
   ListenerHandlerBasePtr* handler_base = nullptr;
   if (msg_listeners_.Get(channel_id, &handler_base)) {
+    ChannelStatistics::Instance()->AddReceive(channel_id, msg_str->size(),
+                                              msg_info.send_time());
     auto handler =
         std::dynamic_pointer_cast<ListenerHandler<std::string>>(*handler_base);
     handler->Run(msg_str, msg_info);
@@ -15,6 +15,7 @@
  *****************************************************************************/
 
 #include "cyber/transport/dispatcher/shm_dispatcher.h"
+#include "cyber/base/macros.h"
 #include "cyber/common/global_data.h"
 #include "cyber/common/util.h"
 #include "cyber/scheduler/scheduler_factory.h"
@@ -38,6 +39,10 @@ void ShmDispatcher::Shutdown() {
   if (thread_.joinable()) {
     thread_.join();
   }
+  // wait for the processor in PollOnce, and keep the others out
+  while (polled_ && polling_.test_and_set(std::memory_order_acquire)) {
+    cpu_relax();
+  }
 
   {
     ReadLockGuard<AtomicRWLock> lock(segments_lock_);
@@ -60,14 +65,17 @@ void ShmDispatcher::ReadMessage(uint64_t channel_id, uint32_t block_index) {
   ADEBUG << "Reading sharedmem message: "
          << GlobalData::GetChannelById(channel_id)
          << " from block: " << block_index;
-  auto rb = std::make_shared<ReadableBlock>();
-  rb->index = block_index;
-  if (!segments_[channel_id]->AcquireBlockToRead(rb.get())) {
+  auto& segment = segments_[channel_id];
+  ReadableBlock block;
+  block.index = block_index;
+  if (!segment->AcquireBlockToRead(&block)) {
     AWARN << "fail to acquire block, channel: "
           << GlobalData::GetChannelById(channel_id)
           << " index: " << block_index;
     return;
   }
+  // the read lock is released once the last reference to rb is gone
+  auto rb = segment->PinReadBlock(block);
 
   MessageInfo msg_info;
   const char* msg_info_addr =
@@ -79,7 +87,6 @@ void ShmDispatcher::ReadMessage(uint64_t channel_id, uint32_t block_index) {
     AERROR << "error msg info of channel:"
            << GlobalData::GetChannelById(channel_id);
   }
-  segments_[channel_id]->ReleaseReadBlock(*rb);
 }
 
 void ShmDispatcher::OnMessage(uint64_t channel_id,
@@ -90,6 +97,8 @@ void ShmDispatcher::OnMessage(uint64_t channel_id,
   }
   ListenerHandlerBasePtr* handler_base = nullptr;
   if (msg_listeners_.Get(channel_id, &handler_base)) {
+    ChannelStatistics::Instance()->AddReceive(
+        channel_id, rb->block->msg_size(), msg_info.send_time());
     auto handler = std::dynamic_pointer_cast<ListenerHandler<ReadableBlock>>(
         *handler_base);
     handler->Run(rb, msg_info);
@@ -99,6 +108,41 @@ void ShmDispatcher::OnMessage(uint64_t channel_id,
   }
 }
 
+void ShmDispatcher::HandleReadableInfo(const ReadableInfo& readable_info) {
+  if (readable_info.host_id() != host_id_) {
+    ADEBUG << "shm readable info from other host.";
+    return;
+  }
+
+  uint64_t channel_id = readable_info.channel_id();
+  uint32_t block_index = readable_info.block_index();
+
+  ReadLockGuard<AtomicRWLock> lock(segments_lock_);
+  if (segments_.count(channel_id) == 0) {
+    return;
+  }
+  // check block index
+  if (previous_indexes_.count(channel_id) == 0) {
+    previous_indexes_[channel_id] = UINT32_MAX;
+  }
+  uint32_t& previous_index = previous_indexes_[channel_id];
+  if (block_index != 0 && previous_index != UINT32_MAX) {
+    if (block_index == previous_index) {
+      ADEBUG << "Receive SAME index " << block_index << " of channel "
+             << channel_id;
+    } else if (block_index < previous_index) {
+      ADEBUG << "Receive PREVIOUS message. last: " << previous_index
+             << ", now: " << block_index;
+    } else if (block_index - previous_index > 1) {
+      ADEBUG << "Receive JUMP message. last: " << previous_index
+             << ", now: " << block_index;
+    }
+  }
+  previous_index = block_index;
+
+  ReadMessage(channel_id, block_index);
+}
+
 void ShmDispatcher::ThreadFunc() {
   ReadableInfo readable_info;
   while (!is_shutdown_.load()) {
@@ -106,49 +150,34 @@ void ShmDispatcher::ThreadFunc() {
       ADEBUG << "listen failed.";
       continue;
     }
+    HandleReadableInfo(readable_info);
+  }
+}
 
-    if (readable_info.host_id() != host_id_) {
-      ADEBUG << "shm readable info from other host.";
-      continue;
-    }
-
-    uint64_t channel_id = readable_info.channel_id();
-    uint32_t block_index = readable_info.block_index();
-
-    {
-      ReadLockGuard<AtomicRWLock> lock(segments_lock_);
-      if (segments_.count(channel_id) == 0) {
-        continue;
-      }
-      // check block index
-      if (previous_indexes_.count(channel_id) == 0) {
-        previous_indexes_[channel_id] = UINT32_MAX;
-      }
-      uint32_t& previous_index = previous_indexes_[channel_id];
-      if (block_index != 0 && previous_index != UINT32_MAX) {
-        if (block_index == previous_index) {
-          ADEBUG << "Receive SAME index " << block_index << " of channel "
-                 << channel_id;
-        } else if (block_index < previous_index) {
-          ADEBUG << "Receive PREVIOUS message. last: " << previous_index
-                 << ", now: " << block_index;
-        } else if (block_index - previous_index > 1) {
-          ADEBUG << "Receive JUMP message. last: " << previous_index
-                 << ", now: " << block_index;
-        }
-      }
-      previous_index = block_index;
-
-      ReadMessage(channel_id, block_index);
-    }
+bool ShmDispatcher::PollOnce() {
+  if (is_shutdown_.load() ||
+      polling_.test_and_set(std::memory_order_acquire)) {
+    return false;
   }
+  ReadableInfo readable_info;
+  bool readable = !is_shutdown_.load() && notifier_->Listen(0, &readable_info);
+  if (readable) {
+    HandleReadableInfo(readable_info);
+  }
+  polling_.clear(std::memory_order_release);
+  return readable;
 }
 
 bool ShmDispatcher::Init() {
   host_id_ = common::Hash(GlobalData::Instance()->HostIp());
   notifier_ = NotifierFactory::CreateNotifier();
-  thread_ = std::thread(&ShmDispatcher::ThreadFunc, this);
-  scheduler::Instance()->SetInnerThreadAttr("shm_disp", &thread_);
+  // processors of isolated groups poll the notifier between their croutines
+  // rather than waking a thread for every message
+  polled_ = scheduler::Instance()->AddIdlePoll([this]() { return PollOnce(); });
+  if (!polled_) {
+    thread_ = std::thread(&ShmDispatcher::ThreadFunc, this);
+    scheduler::Instance()->SetInnerThreadAttr("shm_disp", &thread_);
+  }
   return true;
 }
 
@@ -17,6 +17,7 @@
 #ifndef CYBER_TRANSPORT_DISPATCHER_SHM_DISPATCHER_H_
 #define CYBER_TRANSPORT_DISPATCHER_SHM_DISPATCHER_H_
 
+#include <atomic>
 #include <cstring>
 #include <memory>
 #include <string>
@@ -27,7 +28,9 @@
 #include "cyber/common/global_data.h"
 #include "cyber/common/log.h"
 #include "cyber/common/macros.h"
+#include "cyber/message/arena_pool.h"
 #include "cyber/message/message_traits.h"
+#include "cyber/message/raw_message_view.h"
 #include "cyber/transport/dispatcher/dispatcher.h"
 #include "cyber/transport/shm/notifier_factory.h"
 #include "cyber/transport/shm/segment_factory.h"
@@ -42,6 +45,20 @@ using apollo::cyber::base::AtomicRWLock;
 using apollo::cyber::base::ReadLockGuard;
 using apollo::cyber::base::WriteLockGuard;
 
+template <typename MessageT>
+inline bool ParseFromBlock(const std::shared_ptr<ReadableBlock>& rb,
+                           MessageT* msg) {
+  return message::ParseFromArray(
+      rb->buf, static_cast<int>(rb->block->msg_size()), msg);
+}
+
+// views keep the pinned block alive instead of parsing a copy out of it
+inline bool ParseFromBlock(const std::shared_ptr<ReadableBlock>& rb,
+                           message::RawMessageView* msg) {
+  msg->Attach(rb, rb->buf, rb->block->msg_size());
+  return true;
+}
+
 class ShmDispatcher : public Dispatcher {
  public:
   // key: channel_id
@@ -65,7 +82,11 @@ class ShmDispatcher : public Dispatcher {
   void ReadMessage(uint64_t channel_id, uint32_t block_index);
   void OnMessage(uint64_t channel_id, const std::shared_ptr<ReadableBlock>& rb,
                  const MessageInfo& msg_info);
+  void HandleReadableInfo(const ReadableInfo& readable_info);
   void ThreadFunc();
+  // reads the pending notification if any, called by the processors that
+  // never sleep instead of running thread_
+  bool PollOnce();
   bool Init();
 
   uint64_t host_id_;
@@ -74,6 +95,9 @@ class ShmDispatcher : public Dispatcher {
   AtomicRWLock segments_lock_;
   std::thread thread_;
   NotifierPtr notifier_;
+  // held by the processor polling the notifier, there is one reader only
+  std::atomic_flag polling_ = ATOMIC_FLAG_INIT;
+  bool polled_ = false;
 
   DECLARE_SINGLETON(ShmDispatcher)
 };
@@ -82,11 +106,14 @@ template <typename MessageT>
 void ShmDispatcher::AddListener(const RoleAttributes& self_attr,
                                 const MessageListener<MessageT>& listener) {
   // FIXME: make it more clean
-  auto listener_adapter = [listener](const std::shared_ptr<ReadableBlock>& rb,
-                                     const MessageInfo& msg_info) {
-    auto msg = std::make_shared<MessageT>();
-    RETURN_IF(!message::ParseFromArray(
-        rb->buf, static_cast<int>(rb->block->msg_size()), msg.get()));
+  const auto use_arena =
+      message::ArenaPool::Instance()->ChannelFlag(self_attr.channel_id());
+  auto listener_adapter = [listener, use_arena](
+                              const std::shared_ptr<ReadableBlock>& rb,
+                              const MessageInfo& msg_info) {
+    auto msg = message::NewMessage<MessageT>(
+        use_arena->load(std::memory_order_relaxed));
+    RETURN_IF(!ParseFromBlock(rb, msg.get()));
     listener(msg, msg_info);
   };
 
@@ -99,11 +126,14 @@ void ShmDispatcher::AddListener(const RoleAttributes& self_attr,
                                 const RoleAttributes& opposite_attr,
                                 const MessageListener<MessageT>& listener) {
   // FIXME: make it more clean
-  auto listener_adapter = [listener](const std::shared_ptr<ReadableBlock>& rb,
-                                     const MessageInfo& msg_info) {
-    auto msg = std::make_shared<MessageT>();
-    RETURN_IF(!message::ParseFromArray(
-        rb->buf, static_cast<int>(rb->block->msg_size()), msg.get()));
+  const auto use_arena =
+      message::ArenaPool::Instance()->ChannelFlag(self_attr.channel_id());
+  auto listener_adapter = [listener, use_arena](
+                              const std::shared_ptr<ReadableBlock>& rb,
+                              const MessageInfo& msg_info) {
+    auto msg = message::NewMessage<MessageT>(
+        use_arena->load(std::memory_order_relaxed));
+    RETURN_IF(!ParseFromBlock(rb, msg.get()));
     listener(msg, msg_info);
   };
 
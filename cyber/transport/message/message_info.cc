@@ -24,7 +24,8 @@ namespace apollo {
 namespace cyber {
 namespace transport {
 
-const std::size_t MessageInfo::kSize = 2 * ID_SIZE + sizeof(uint64_t);
+const std::size_t MessageInfo::kLegacySize = 2 * ID_SIZE + sizeof(uint64_t);
+const std::size_t MessageInfo::kSize = kLegacySize + sizeof(uint64_t);
 
 MessageInfo::MessageInfo() : sender_id_(false), spare_id_(false) {}
 
@@ -39,7 +40,8 @@ MessageInfo::MessageInfo(const MessageInfo& another)
     : sender_id_(another.sender_id_),
       channel_id_(another.channel_id_),
       seq_num_(another.seq_num_),
-      spare_id_(another.spare_id_) {}
+      spare_id_(another.spare_id_),
+      send_time_(another.send_time_) {}
 
 MessageInfo::~MessageInfo() {}
 
@@ -49,6 +51,7 @@ MessageInfo& MessageInfo::operator=(const MessageInfo& another) {
     channel_id_ = another.channel_id_;
     seq_num_ = another.seq_num_;
     spare_id_ = another.spare_id_;
+    send_time_ = another.send_time_;
   }
   return *this;
 }
@@ -70,6 +73,8 @@ bool MessageInfo::SerializeTo(std::string* dst) const {
   dst->append(reinterpret_cast<char*>(const_cast<uint64_t*>(&seq_num_)),
               sizeof(seq_num_));
   dst->append(spare_id_.data(), ID_SIZE);
+  dst->append(reinterpret_cast<char*>(const_cast<uint64_t*>(&send_time_)),
+              sizeof(send_time_));
 
   return true;
 }
@@ -87,6 +92,9 @@ bool MessageInfo::SerializeTo(char* dst, std::size_t len) const {
          sizeof(seq_num_));
   ptr += sizeof(seq_num_);
   memcpy(ptr, spare_id_.data(), ID_SIZE);
+  ptr += ID_SIZE;
+  memcpy(ptr, reinterpret_cast<char*>(const_cast<uint64_t*>(&send_time_)),
+         sizeof(send_time_));
 
   return true;
 }
@@ -97,7 +105,7 @@ bool MessageInfo::DeserializeFrom(const std::string& src) {
 
 bool MessageInfo::DeserializeFrom(const char* src, std::size_t len) {
   RETURN_VAL_IF_NULL(src, false);
-  if (len != kSize) {
+  if (len != kSize && len != kLegacySize) {
     AWARN << "src size mismatch, given[" << len << "] target[" << kSize << "]";
     return false;
   }
@@ -108,6 +116,11 @@ bool MessageInfo::DeserializeFrom(const char* src, std::size_t len) {
   memcpy(reinterpret_cast<char*>(&seq_num_), ptr, sizeof(seq_num_));
   ptr += sizeof(seq_num_);
   spare_id_.set_data(ptr);
+  ptr += ID_SIZE;
+  send_time_ = 0;
+  if (len == kSize) {
+    memcpy(reinterpret_cast<char*>(&send_time_), ptr, sizeof(send_time_));
+  }
 
   return true;
 }
@@ -58,13 +58,22 @@ class MessageInfo {
   const Identity& spare_id() const { return spare_id_; }
   void set_spare_id(const Identity& spare_id) { spare_id_ = spare_id; }
 
+  // wall clock nanoseconds at which the sender published the message, 0 when
+  // the transport did not carry it
+  uint64_t send_time() const { return send_time_; }
+  void set_send_time(uint64_t send_time) { send_time_ = send_time; }
+
   static const std::size_t kSize;
+  // size written by senders that predate send_time, still accepted when
+  // deserializing
+  static const std::size_t kLegacySize;
 
  private:
   Identity sender_id_;
   uint64_t channel_id_ = 0;
   uint64_t seq_num_ = 0;
   Identity spare_id_;
+  uint64_t send_time_ = 0;
 };
 
 }  // namespace transport
@@ -70,6 +70,29 @@ TEST(MessageInfoTest, test) {
   EXPECT_EQ(msgInfo3, msgInfo4);
 }
 
+TEST(MessageInfoTest, send_time) {
+  Identity id;
+  MessageInfo info(id, 7);
+  info.set_send_time(123456789);
+
+  std::string str;
+  EXPECT_TRUE(info.SerializeTo(&str));
+  EXPECT_EQ(MessageInfo::kSize, str.size());
+
+  MessageInfo copy;
+  EXPECT_TRUE(copy.DeserializeFrom(str));
+  EXPECT_EQ(123456789, copy.send_time());
+  EXPECT_EQ(7, copy.seq_num());
+
+  // blocks written by senders without send_time still parse
+  MessageInfo legacy;
+  legacy.set_send_time(1);
+  EXPECT_TRUE(legacy.DeserializeFrom(str.data(), MessageInfo::kLegacySize));
+  EXPECT_EQ(0, legacy.send_time());
+  EXPECT_EQ(7, legacy.seq_num());
+  EXPECT_EQ(id, legacy.sender_id());
+}
+
 }  // namespace transport
 }  // namespace cyber
 }  // namespace apollo
@@ -0,0 +1,109 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/transport/rdma/rdma_conf.h"
+
+#include <cstdlib>
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+namespace {
+
+constexpr uint64_t kDefaultBlockSize = 4 * 1024 * 1024;
+constexpr uint32_t kDefaultBlockNum = 8;
+constexpr int kDefaultPort = 17000;
+
+std::string Env(const char* name) {
+  const char* value = std::getenv(name);
+  return value == nullptr ? std::string() : std::string(value);
+}
+
+int64_t EnvInt(const char* name, int64_t default_value) {
+  auto value = Env(name);
+  if (value.empty()) {
+    return default_value;
+  }
+  char* end = nullptr;
+  int64_t result = std::strtoll(value.c_str(), &end, 10);
+  return *end == '\0' && result >= 0 ? result : default_value;
+}
+
+}  // namespace
+
+const int RdmaConf::kPortRange = 4096;
+
+bool RdmaConf::Enabled(const std::string& channel_name) {
+  static const std::string channels = Env("CYBER_RDMA_CHANNELS");
+  return Selects(channels, channel_name);
+}
+
+bool RdmaConf::Selects(const std::string& channels,
+                       const std::string& channel_name) {
+  size_t begin = 0;
+  while (begin <= channels.size()) {
+    size_t end = channels.find(',', begin);
+    if (end == std::string::npos) {
+      end = channels.size();
+    }
+    auto item = channels.substr(begin, end - begin);
+    if (item == "*" || (!item.empty() && item == channel_name)) {
+      return true;
+    }
+    begin = end + 1;
+  }
+  return false;
+}
+
+const std::string& RdmaConf::DeviceName() {
+  static const std::string device_name = Env("CYBER_RDMA_DEVICE");
+  return device_name;
+}
+
+uint8_t RdmaConf::IbPort() {
+  static const uint8_t ib_port =
+      static_cast<uint8_t>(EnvInt("CYBER_RDMA_IB_PORT", 1));
+  return ib_port;
+}
+
+int RdmaConf::GidIndex() {
+  static const int gid_index =
+      static_cast<int>(EnvInt("CYBER_RDMA_GID_INDEX", 0));
+  return gid_index;
+}
+
+uint64_t RdmaConf::BlockSize() {
+  static const uint64_t block_size =
+      static_cast<uint64_t>(EnvInt("CYBER_RDMA_BLOCK_SIZE", kDefaultBlockSize));
+  return block_size;
+}
+
+uint32_t RdmaConf::BlockNum() {
+  static const uint32_t block_num =
+      static_cast<uint32_t>(EnvInt("CYBER_RDMA_BLOCK_NUM", kDefaultBlockNum));
+  return block_num == 0 ? kDefaultBlockNum : block_num;
+}
+
+uint16_t RdmaConf::ListenPort(int process_id) {
+  static const int port = static_cast<int>(EnvInt("CYBER_RDMA_PORT",
+                                                  kDefaultPort));
+  return static_cast<uint16_t>(port + process_id % kPortRange);
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
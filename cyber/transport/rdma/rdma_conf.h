@@ -0,0 +1,75 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_TRANSPORT_RDMA_RDMA_CONF_H_
+#define CYBER_TRANSPORT_RDMA_RDMA_CONF_H_
+
+#include <cstdint>
+#include <string>
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+/**
+ * @class RdmaConf
+ * @brief Settings of the inter-host RDMA transport, read once from the
+ * environment. The writer and reader hosts of a channel must both select it,
+ * otherwise their messages keep going over RTPS.
+ *
+ *  CYBER_RDMA_CHANNELS=<a,b>   comma separated channels sent over RDMA to
+ *                              readers on other hosts, "*" for all of them
+ *  CYBER_RDMA_DEVICE=<name>    verbs device, the first one by default
+ *  CYBER_RDMA_IB_PORT=<n>      port of the device, 1 by default
+ *  CYBER_RDMA_GID_INDEX=<n>    gid used to address the peer, 0 by default,
+ *                              usually the RoCE v2 one on RoCE networks
+ *  CYBER_RDMA_PORT=<n>         first TCP port readers take connections on,
+ *                              17000 by default
+ *  CYBER_RDMA_BLOCK_SIZE=<n>   initial size of a block, 4 MiB by default,
+ *                              grown for larger messages
+ *  CYBER_RDMA_BLOCK_NUM=<n>    blocks per writer and reader process, 8 by
+ *                              default
+ */
+class RdmaConf {
+ public:
+  static bool Enabled(const std::string& channel_name);
+
+  static const std::string& DeviceName();
+  static uint8_t IbPort();
+  static int GidIndex();
+  static uint64_t BlockSize();
+  static uint32_t BlockNum();
+
+  /**
+   * @brief TCP port the reader process `process_id` takes connections on.
+   */
+  static uint16_t ListenPort(int process_id);
+
+  /**
+   * @brief Whether `channel_name` is in the comma separated `channels`.
+   */
+  static bool Selects(const std::string& channels,
+                      const std::string& channel_name);
+
+  // listen ports are spread over this many ports after CYBER_RDMA_PORT
+  static const int kPortRange;
+};
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_TRANSPORT_RDMA_RDMA_CONF_H_
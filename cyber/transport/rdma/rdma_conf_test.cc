@@ -0,0 +1,47 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/transport/rdma/rdma_conf.h"
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+TEST(RdmaConfTest, selects) {
+  EXPECT_FALSE(RdmaConf::Selects("", "/apollo/camera"));
+  EXPECT_FALSE(RdmaConf::Selects(",", "/apollo/camera"));
+  EXPECT_TRUE(RdmaConf::Selects("*", "/apollo/camera"));
+  EXPECT_TRUE(RdmaConf::Selects("/apollo/camera", "/apollo/camera"));
+  EXPECT_TRUE(RdmaConf::Selects("/apollo/lidar,/apollo/camera",
+                                "/apollo/camera"));
+  EXPECT_FALSE(RdmaConf::Selects("/apollo/lidar,/apollo/camera",
+                                 "/apollo/cam"));
+  EXPECT_FALSE(RdmaConf::Selects("/apollo/camera_front", "/apollo/camera"));
+}
+
+TEST(RdmaConfTest, listen_port) {
+  EXPECT_EQ(RdmaConf::ListenPort(1), RdmaConf::ListenPort(0) + 1);
+  EXPECT_EQ(RdmaConf::ListenPort(RdmaConf::kPortRange + 5),
+            RdmaConf::ListenPort(5));
+  EXPECT_GT(RdmaConf::BlockNum(), 0);
+  EXPECT_GT(RdmaConf::BlockSize(), 0);
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
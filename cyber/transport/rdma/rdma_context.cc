@@ -0,0 +1,174 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/transport/rdma/rdma_context.h"
+
+#include <cerrno>
+#include <cstring>
+
+#include "cyber/common/log.h"
+#include "cyber/transport/rdma/rdma_conf.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+RdmaContext::RdmaContext() {
+  memset(&port_attr_, 0, sizeof(port_attr_));
+  memset(&gid_, 0, sizeof(gid_));
+  if (!Init()) {
+    AINFO << "no rdma device, inter-host messages stay on rtps.";
+  }
+}
+
+RdmaContext::~RdmaContext() {
+  if (pd_ != nullptr) {
+    ibv_dealloc_pd(pd_);
+    pd_ = nullptr;
+  }
+  if (context_ != nullptr) {
+    ibv_close_device(context_);
+    context_ = nullptr;
+  }
+}
+
+bool RdmaContext::Init() {
+  int num = 0;
+  ibv_device** devices = ibv_get_device_list(&num);
+  if (devices == nullptr) {
+    return false;
+  }
+  ibv_device* device = nullptr;
+  for (int i = 0; i < num && device == nullptr; ++i) {
+    if (RdmaConf::DeviceName().empty() ||
+        RdmaConf::DeviceName() == ibv_get_device_name(devices[i])) {
+      device = devices[i];
+    }
+  }
+  if (device != nullptr) {
+    context_ = ibv_open_device(device);
+  }
+  ibv_free_device_list(devices);
+  if (context_ == nullptr) {
+    return false;
+  }
+
+  if (ibv_query_port(context_, RdmaConf::IbPort(), &port_attr_) != 0 ||
+      ibv_query_gid(context_, RdmaConf::IbPort(), RdmaConf::GidIndex(),
+                    &gid_) != 0) {
+    AERROR << "query rdma port failed: " << strerror(errno);
+    return false;
+  }
+  pd_ = ibv_alloc_pd(context_);
+  if (pd_ == nullptr) {
+    AERROR << "alloc rdma protection domain failed: " << strerror(errno);
+    return false;
+  }
+  AINFO << "rdma device " << ibv_get_device_name(context_->device)
+        << " port " << static_cast<int>(RdmaConf::IbPort()) << " ready.";
+  return true;
+}
+
+ibv_qp* RdmaContext::CreateQp(ibv_cq* send_cq, ibv_cq* recv_cq,
+                              uint32_t max_send_wr, uint32_t max_recv_wr) {
+  ibv_qp_init_attr init_attr;
+  memset(&init_attr, 0, sizeof(init_attr));
+  init_attr.send_cq = send_cq;
+  init_attr.recv_cq = recv_cq;
+  init_attr.qp_type = IBV_QPT_RC;
+  init_attr.cap.max_send_wr = max_send_wr;
+  init_attr.cap.max_recv_wr = max_recv_wr;
+  init_attr.cap.max_send_sge = 1;
+  init_attr.cap.max_recv_sge = 1;
+  ibv_qp* qp = ibv_create_qp(pd_, &init_attr);
+  if (qp == nullptr) {
+    AERROR << "create rdma queue pair failed: " << strerror(errno);
+    return nullptr;
+  }
+
+  ibv_qp_attr attr;
+  memset(&attr, 0, sizeof(attr));
+  attr.qp_state = IBV_QPS_INIT;
+  attr.pkey_index = 0;
+  attr.port_num = RdmaConf::IbPort();
+  attr.qp_access_flags = IBV_ACCESS_REMOTE_WRITE;
+  if (ibv_modify_qp(qp, &attr,
+                    IBV_QP_STATE | IBV_QP_PKEY_INDEX | IBV_QP_PORT |
+                        IBV_QP_ACCESS_FLAGS) != 0) {
+    AERROR << "init rdma queue pair failed: " << strerror(errno);
+    ibv_destroy_qp(qp);
+    return nullptr;
+  }
+  return qp;
+}
+
+RdmaQpInfo RdmaContext::LocalInfo(ibv_qp* qp, uint32_t psn) const {
+  RdmaQpInfo info;
+  info.qp_num = qp->qp_num;
+  info.psn = psn;
+  info.lid = port_attr_.lid;
+  memcpy(info.gid, gid_.raw, sizeof(info.gid));
+  return info;
+}
+
+bool RdmaContext::ConnectQp(ibv_qp* qp, uint32_t local_psn,
+                            const RdmaQpInfo& remote) {
+  ibv_qp_attr attr;
+  memset(&attr, 0, sizeof(attr));
+  attr.qp_state = IBV_QPS_RTR;
+  attr.path_mtu = port_attr_.active_mtu;
+  attr.dest_qp_num = remote.qp_num;
+  attr.rq_psn = remote.psn;
+  attr.max_dest_rd_atomic = 1;
+  attr.min_rnr_timer = 12;
+  attr.ah_attr.dlid = remote.lid;
+  attr.ah_attr.port_num = RdmaConf::IbPort();
+  // RoCE has no lids, the peer is addressed by its gid
+  if (port_attr_.link_layer == IBV_LINK_LAYER_ETHERNET || remote.lid == 0) {
+    attr.ah_attr.is_global = 1;
+    memcpy(attr.ah_attr.grh.dgid.raw, remote.gid, sizeof(remote.gid));
+    attr.ah_attr.grh.sgid_index = static_cast<uint8_t>(RdmaConf::GidIndex());
+    attr.ah_attr.grh.hop_limit = 64;
+  }
+  if (ibv_modify_qp(qp, &attr,
+                    IBV_QP_STATE | IBV_QP_AV | IBV_QP_PATH_MTU |
+                        IBV_QP_DEST_QPN | IBV_QP_RQ_PSN |
+                        IBV_QP_MAX_DEST_RD_ATOMIC | IBV_QP_MIN_RNR_TIMER) !=
+      0) {
+    AERROR << "rdma queue pair to rtr failed: " << strerror(errno);
+    return false;
+  }
+
+  memset(&attr, 0, sizeof(attr));
+  attr.qp_state = IBV_QPS_RTS;
+  attr.sq_psn = local_psn;
+  attr.timeout = 14;
+  attr.retry_cnt = 7;
+  attr.rnr_retry = 7;
+  attr.max_rd_atomic = 1;
+  if (ibv_modify_qp(qp, &attr,
+                    IBV_QP_STATE | IBV_QP_SQ_PSN | IBV_QP_TIMEOUT |
+                        IBV_QP_RETRY_CNT | IBV_QP_RNR_RETRY |
+                        IBV_QP_MAX_QP_RD_ATOMIC) != 0) {
+    AERROR << "rdma queue pair to rts failed: " << strerror(errno);
+    return false;
+  }
+  return true;
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
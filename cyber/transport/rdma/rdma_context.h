@@ -0,0 +1,75 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_TRANSPORT_RDMA_RDMA_CONTEXT_H_
+#define CYBER_TRANSPORT_RDMA_RDMA_CONTEXT_H_
+
+#include <infiniband/verbs.h>
+
+#include <cstdint>
+
+#include "cyber/common/macros.h"
+#include "cyber/transport/rdma/rdma_handshake.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+/**
+ * @class RdmaContext
+ * @brief The verbs device and protection domain of the process, opened once.
+ * Without a usable device Ready() is false and channels stay on RTPS.
+ */
+class RdmaContext {
+ public:
+  virtual ~RdmaContext();
+
+  bool Ready() const { return pd_ != nullptr; }
+  ibv_context* context() const { return context_; }
+  ibv_pd* pd() const { return pd_; }
+
+  /**
+   * @brief Reliable connected queue pair, in the INIT state.
+   */
+  ibv_qp* CreateQp(ibv_cq* send_cq, ibv_cq* recv_cq, uint32_t max_send_wr,
+                   uint32_t max_recv_wr);
+
+  /**
+   * @brief What the peer needs to connect to `qp`.
+   */
+  RdmaQpInfo LocalInfo(ibv_qp* qp, uint32_t psn) const;
+
+  /**
+   * @brief Move `qp` through RTR to RTS, connected to `remote`.
+   */
+  bool ConnectQp(ibv_qp* qp, uint32_t local_psn, const RdmaQpInfo& remote);
+
+ private:
+  bool Init();
+
+  ibv_context* context_ = nullptr;
+  ibv_pd* pd_ = nullptr;
+  ibv_port_attr port_attr_;
+  ibv_gid gid_;
+
+  DECLARE_SINGLETON(RdmaContext)
+};
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_TRANSPORT_RDMA_RDMA_CONTEXT_H_
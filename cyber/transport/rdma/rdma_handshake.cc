@@ -0,0 +1,244 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/transport/rdma/rdma_handshake.h"
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+namespace {
+
+// bumped whenever the layout of the messages below changes
+constexpr char kMagic[4] = {'C', 'Y', 'R', '1'};
+
+class Encoder {
+ public:
+  explicit Encoder(std::string* dst) : dst_(dst) {
+    dst_->assign(kMagic, sizeof(kMagic));
+  }
+
+  template <typename T>
+  void Put(T value) {
+    for (int shift = (sizeof(T) - 1) * 8; shift >= 0; shift -= 8) {
+      dst_->push_back(static_cast<char>((value >> shift) & 0xff));
+    }
+  }
+
+  void Put(const RdmaQpInfo& qp) {
+    Put(qp.qp_num);
+    Put(qp.psn);
+    Put(qp.lid);
+    dst_->append(reinterpret_cast<const char*>(qp.gid), sizeof(qp.gid));
+  }
+
+ private:
+  std::string* dst_;
+};
+
+class Decoder {
+ public:
+  explicit Decoder(const std::string& src) : src_(src) {
+    pos_ = sizeof(kMagic);
+    ok_ = src_.compare(0, sizeof(kMagic), kMagic, sizeof(kMagic)) == 0;
+  }
+
+  template <typename T>
+  void Get(T* value) {
+    *value = 0;
+    if (!Has(sizeof(T))) {
+      return;
+    }
+    for (size_t i = 0; i < sizeof(T); ++i) {
+      *value = static_cast<T>((*value << 8) |
+                              static_cast<uint8_t>(src_[pos_++]));
+    }
+  }
+
+  void Get(RdmaQpInfo* qp) {
+    Get(&qp->qp_num);
+    Get(&qp->psn);
+    Get(&qp->lid);
+    if (Has(sizeof(qp->gid))) {
+      memcpy(qp->gid, src_.data() + pos_, sizeof(qp->gid));
+      pos_ += sizeof(qp->gid);
+    }
+  }
+
+  bool Done() const { return ok_ && pos_ == src_.size(); }
+
+ private:
+  bool Has(size_t size) {
+    ok_ = ok_ && pos_ + size <= src_.size();
+    return ok_;
+  }
+
+  const std::string& src_;
+  size_t pos_ = 0;
+  bool ok_ = false;
+};
+
+constexpr std::size_t kQpInfoSize = 4 + 4 + 2 + 16;
+
+bool WaitFd(int fd, int16_t events, int timeout_ms) {
+  pollfd pfd = {fd, events, 0};
+  int ret = 0;
+  do {
+    ret = poll(&pfd, 1, timeout_ms);
+  } while (ret < 0 && errno == EINTR);
+  return ret > 0 && (pfd.revents & events) != 0;
+}
+
+}  // namespace
+
+const std::size_t RdmaRequest::kSize =
+    sizeof(kMagic) + 6 * sizeof(uint64_t) + 2 * sizeof(uint32_t) + kQpInfoSize;
+
+const std::size_t RdmaReply::kSize =
+    sizeof(kMagic) + sizeof(uint64_t) + 2 * sizeof(uint32_t) + kQpInfoSize;
+
+std::string RdmaRequest::Encode() const {
+  std::string dst;
+  Encoder encoder(&dst);
+  encoder.Put(channel_id);
+  encoder.Put(writer_id);
+  encoder.Put(reader_id);
+  encoder.Put(process_id);
+  encoder.Put(block_size);
+  encoder.Put(block_num);
+  encoder.Put(qp);
+  encoder.Put(credit_addr);
+  encoder.Put(credit_rkey);
+  return dst;
+}
+
+bool RdmaRequest::Decode(const std::string& src) {
+  Decoder decoder(src);
+  decoder.Get(&channel_id);
+  decoder.Get(&writer_id);
+  decoder.Get(&reader_id);
+  decoder.Get(&process_id);
+  decoder.Get(&block_size);
+  decoder.Get(&block_num);
+  decoder.Get(&qp);
+  decoder.Get(&credit_addr);
+  decoder.Get(&credit_rkey);
+  return decoder.Done();
+}
+
+std::string RdmaReply::Encode() const {
+  std::string dst;
+  Encoder encoder(&dst);
+  encoder.Put(status);
+  encoder.Put(qp);
+  encoder.Put(ring_addr);
+  encoder.Put(ring_rkey);
+  return dst;
+}
+
+bool RdmaReply::Decode(const std::string& src) {
+  Decoder decoder(src);
+  decoder.Get(&status);
+  decoder.Get(&qp);
+  decoder.Get(&ring_addr);
+  decoder.Get(&ring_rkey);
+  return decoder.Done();
+}
+
+int ConnectTcp(const std::string& ip, uint16_t port, int timeout_ms) {
+  sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(port);
+  if (inet_pton(AF_INET, ip.c_str(), &addr.sin_addr) != 1) {
+    AERROR << "invalid ip: " << ip;
+    return -1;
+  }
+
+  int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  if (fd < 0) {
+    AERROR << "create socket failed: " << strerror(errno);
+    return -1;
+  }
+  int ret = connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+  if (ret < 0 && errno == EINPROGRESS && WaitFd(fd, POLLOUT, timeout_ms)) {
+    int error = 0;
+    socklen_t len = sizeof(error);
+    getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &len);
+    ret = error == 0 ? 0 : -1;
+  }
+  if (ret < 0) {
+    ADEBUG << "connect to " << ip << ":" << port << " failed.";
+    close(fd);
+    return -1;
+  }
+
+  fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) & ~O_NONBLOCK);
+  timeval tv = {timeout_ms / 1000, (timeout_ms % 1000) * 1000};
+  setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+  setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+  int one = 1;
+  setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+  return fd;
+}
+
+bool SendAll(int fd, const std::string& data) {
+  size_t sent = 0;
+  while (sent < data.size()) {
+    ssize_t n = send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      return false;
+    }
+    sent += static_cast<size_t>(n);
+  }
+  return true;
+}
+
+bool RecvAll(int fd, std::size_t size, std::string* data) {
+  data->resize(size);
+  size_t received = 0;
+  while (received < size) {
+    ssize_t n = recv(fd, &(*data)[received], size - received, 0);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      return false;
+    }
+    received += static_cast<size_t>(n);
+  }
+  return true;
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
@@ -0,0 +1,101 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_TRANSPORT_RDMA_RDMA_HANDSHAKE_H_
+#define CYBER_TRANSPORT_RDMA_RDMA_HANDSHAKE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+/**
+ * Addresses a queue pair, for the peer to connect to it.
+ */
+struct RdmaQpInfo {
+  uint32_t qp_num = 0;
+  uint32_t psn = 0;
+  uint16_t lid = 0;
+  uint8_t gid[16] = {0};
+};
+
+/**
+ * Sent by a writer over TCP to the process of a reader on another host. The
+ * reader registers block_num blocks of block_size bytes for it, which the
+ * writer fills with RDMA writes, and acknowledges the blocks it is done with
+ * by writing their count into the credit word of the writer.
+ */
+struct RdmaRequest {
+  uint64_t channel_id = 0;
+  uint64_t writer_id = 0;
+  uint64_t reader_id = 0;
+  uint64_t process_id = 0;
+  uint64_t block_size = 0;
+  uint32_t block_num = 0;
+  RdmaQpInfo qp;
+  uint64_t credit_addr = 0;
+  uint32_t credit_rkey = 0;
+
+  std::string Encode() const;
+  bool Decode(const std::string& src);
+
+  static const std::size_t kSize;
+};
+
+struct RdmaReply {
+  enum Status : uint32_t {
+    OK = 0,
+    NO_READER = 1,
+    NO_RESOURCE = 2,
+  };
+
+  uint32_t status = NO_READER;
+  RdmaQpInfo qp;
+  uint64_t ring_addr = 0;
+  uint32_t ring_rkey = 0;
+
+  std::string Encode() const;
+  bool Decode(const std::string& src);
+
+  static const std::size_t kSize;
+};
+
+/**
+ * Starts every block, the message and its MessageInfo follow.
+ */
+struct RdmaBlockHeader {
+  uint64_t seq = 0;
+  uint32_t msg_size = 0;
+  uint32_t msg_info_size = 0;
+};
+
+/**
+ * @brief TCP connection to `ip`:`port`, -1 if it cannot be made within
+ * `timeout_ms`. Reads and writes on it time out after `timeout_ms` as well.
+ */
+int ConnectTcp(const std::string& ip, uint16_t port, int timeout_ms);
+
+bool SendAll(int fd, const std::string& data);
+bool RecvAll(int fd, std::size_t size, std::string* data);
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_TRANSPORT_RDMA_RDMA_HANDSHAKE_H_
@@ -0,0 +1,138 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/transport/rdma/rdma_handshake.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+TEST(RdmaHandshakeTest, request) {
+  RdmaRequest request;
+  request.channel_id = 0x0102030405060708ULL;
+  request.writer_id = 11;
+  request.reader_id = 12;
+  request.process_id = 4321;
+  request.block_size = 4 << 20;
+  request.block_num = 8;
+  request.qp.qp_num = 0x123456;
+  request.qp.psn = 0xabcdef;
+  request.qp.lid = 7;
+  request.qp.gid[15] = 9;
+  request.credit_addr = 0x7f0000001000ULL;
+  request.credit_rkey = 0xdeadbeef;
+
+  std::string data = request.Encode();
+  EXPECT_EQ(RdmaRequest::kSize, data.size());
+  RdmaRequest decoded;
+  ASSERT_TRUE(decoded.Decode(data));
+  EXPECT_EQ(request.channel_id, decoded.channel_id);
+  EXPECT_EQ(request.writer_id, decoded.writer_id);
+  EXPECT_EQ(request.reader_id, decoded.reader_id);
+  EXPECT_EQ(request.process_id, decoded.process_id);
+  EXPECT_EQ(request.block_size, decoded.block_size);
+  EXPECT_EQ(request.block_num, decoded.block_num);
+  EXPECT_EQ(request.qp.qp_num, decoded.qp.qp_num);
+  EXPECT_EQ(request.qp.psn, decoded.qp.psn);
+  EXPECT_EQ(request.qp.lid, decoded.qp.lid);
+  EXPECT_EQ(0, memcmp(request.qp.gid, decoded.qp.gid, sizeof(request.qp.gid)));
+  EXPECT_EQ(request.credit_addr, decoded.credit_addr);
+  EXPECT_EQ(request.credit_rkey, decoded.credit_rkey);
+
+  EXPECT_FALSE(decoded.Decode(data.substr(0, data.size() - 1)));
+  EXPECT_FALSE(decoded.Decode(data + "x"));
+  data[0] = 'X';
+  EXPECT_FALSE(decoded.Decode(data));
+}
+
+TEST(RdmaHandshakeTest, reply) {
+  RdmaReply reply;
+  reply.status = RdmaReply::OK;
+  reply.qp.qp_num = 42;
+  reply.ring_addr = 0x7f0000002000ULL;
+  reply.ring_rkey = 77;
+
+  std::string data = reply.Encode();
+  EXPECT_EQ(RdmaReply::kSize, data.size());
+  RdmaReply decoded;
+  ASSERT_TRUE(decoded.Decode(data));
+  EXPECT_EQ(RdmaReply::OK, decoded.status);
+  EXPECT_EQ(42, decoded.qp.qp_num);
+  EXPECT_EQ(reply.ring_addr, decoded.ring_addr);
+  EXPECT_EQ(77, decoded.ring_rkey);
+  EXPECT_FALSE(decoded.Decode(RdmaRequest().Encode()));
+}
+
+TEST(RdmaHandshakeTest, tcp) {
+  int listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+  ASSERT_GE(listen_fd, 0);
+  sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  socklen_t len = sizeof(addr);
+  ASSERT_EQ(0, bind(listen_fd, reinterpret_cast<sockaddr*>(&addr), len));
+  ASSERT_EQ(0, listen(listen_fd, 1));
+  ASSERT_EQ(0,
+            getsockname(listen_fd, reinterpret_cast<sockaddr*>(&addr), &len));
+  uint16_t port = ntohs(addr.sin_port);
+
+  std::thread server([listen_fd]() {
+    int fd = accept(listen_fd, nullptr, nullptr);
+    std::string data;
+    if (RecvAll(fd, RdmaRequest::kSize, &data)) {
+      RdmaRequest request;
+      RdmaReply reply;
+      reply.status = request.Decode(data) ? RdmaReply::OK
+                                          : RdmaReply::NO_READER;
+      reply.ring_rkey = static_cast<uint32_t>(request.block_num);
+      SendAll(fd, reply.Encode());
+    }
+    close(fd);
+  });
+
+  int fd = ConnectTcp("127.0.0.1", port, 500);
+  ASSERT_GE(fd, 0);
+  RdmaRequest request;
+  request.block_num = 16;
+  ASSERT_TRUE(SendAll(fd, request.Encode()));
+  std::string data;
+  ASSERT_TRUE(RecvAll(fd, RdmaReply::kSize, &data));
+  RdmaReply reply;
+  ASSERT_TRUE(reply.Decode(data));
+  EXPECT_EQ(RdmaReply::OK, reply.status);
+  EXPECT_EQ(16, reply.ring_rkey);
+  EXPECT_FALSE(RecvAll(fd, 1, &data));
+  close(fd);
+  server.join();
+  close(listen_fd);
+
+  EXPECT_LT(ConnectTcp("not an ip", port, 100), 0);
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
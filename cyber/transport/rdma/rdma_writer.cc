@@ -0,0 +1,238 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/transport/rdma/rdma_writer.h"
+
+#include <arpa/inet.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+
+#include "cyber/common/log.h"
+#include "cyber/transport/rdma/rdma_conf.h"
+#include "cyber/transport/rdma/rdma_context.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+namespace {
+constexpr int kHandshakeTimeoutMs = 500;
+constexpr size_t kAlignment = 4096;
+}  // namespace
+
+RdmaWriter::RdmaWriter() {}
+
+RdmaWriter::~RdmaWriter() { Close(); }
+
+bool RdmaWriter::Connect(const std::string& ip, RdmaRequest request) {
+  auto context = RdmaContext::Instance();
+  if (!context->Ready()) {
+    return false;
+  }
+  Close();
+
+  block_size_ = request.block_size > 0 ? request.block_size
+                                       : RdmaConf::BlockSize();
+  block_num_ = RdmaConf::BlockNum();
+  in_flight_.assign(block_num_, false);
+  next_seq_ = 0;
+
+  cq_ = ibv_create_cq(context->context(), static_cast<int>(block_num_) + 1,
+                      nullptr, nullptr, 0);
+  if (cq_ != nullptr) {
+    qp_ = context->CreateQp(cq_, cq_, block_num_ + 1, 1);
+  }
+  if (posix_memalign(reinterpret_cast<void**>(&blocks_), kAlignment,
+                     block_size_ * block_num_) != 0) {
+    blocks_ = nullptr;
+  }
+  if (posix_memalign(reinterpret_cast<void**>(&credit_), kAlignment,
+                     sizeof(uint64_t)) != 0) {
+    credit_ = nullptr;
+  }
+  if (qp_ == nullptr || blocks_ == nullptr || credit_ == nullptr) {
+    AERROR << "allocate rdma writer resources failed.";
+    Close();
+    return false;
+  }
+  *credit_ = 0;
+  blocks_mr_ = ibv_reg_mr(context->pd(), blocks_, block_size_ * block_num_,
+                          IBV_ACCESS_LOCAL_WRITE);
+  credit_mr_ = ibv_reg_mr(context->pd(), credit_, sizeof(uint64_t),
+                          IBV_ACCESS_LOCAL_WRITE | IBV_ACCESS_REMOTE_WRITE);
+  if (blocks_mr_ == nullptr || credit_mr_ == nullptr) {
+    AERROR << "register rdma writer memory failed: " << strerror(errno);
+    Close();
+    return false;
+  }
+
+  uint32_t psn = static_cast<uint32_t>(lrand48()) & 0xffffff;
+  request.block_size = block_size_;
+  request.block_num = block_num_;
+  request.qp = context->LocalInfo(qp_, psn);
+  request.credit_addr = reinterpret_cast<uint64_t>(credit_);
+  request.credit_rkey = credit_mr_->rkey;
+
+  RdmaReply reply;
+  std::string data;
+  fd_ = ConnectTcp(ip, RdmaConf::ListenPort(static_cast<int>(
+                           request.process_id)),
+                   kHandshakeTimeoutMs);
+  if (fd_ < 0 || !SendAll(fd_, request.Encode()) ||
+      !RecvAll(fd_, RdmaReply::kSize, &data) || !reply.Decode(data) ||
+      reply.status != RdmaReply::OK) {
+    ADEBUG << "no rdma reader of channel " << request.channel_id << " at "
+           << ip << " process " << request.process_id;
+    Close();
+    return false;
+  }
+  if (!context->ConnectQp(qp_, psn, reply.qp)) {
+    Close();
+    return false;
+  }
+  ring_addr_ = reply.ring_addr;
+  ring_rkey_ = reply.ring_rkey;
+  broken_ = false;
+  return true;
+}
+
+bool RdmaWriter::Fits(std::size_t msg_size) const {
+  return sizeof(RdmaBlockHeader) + msg_size + MessageInfo::kSize <=
+         block_size_;
+}
+
+char* RdmaWriter::Acquire(std::size_t msg_size) {
+  if (broken_ || !Fits(msg_size)) {
+    return nullptr;
+  }
+  uint64_t credit = __atomic_load_n(credit_, __ATOMIC_ACQUIRE);
+  if (next_seq_ - credit >= block_num_) {
+    ADEBUG << "rdma reader lags " << next_seq_ - credit << " blocks behind.";
+    return nullptr;
+  }
+  uint32_t index = static_cast<uint32_t>(next_seq_ % block_num_);
+  // the reader is done with the block, so is the write that filled it
+  while (in_flight_[index] && !broken_) {
+    Reap(true);
+  }
+  if (broken_) {
+    return nullptr;
+  }
+  return blocks_ + index * block_size_ + sizeof(RdmaBlockHeader);
+}
+
+bool RdmaWriter::Post(std::size_t msg_size, const MessageInfo& msg_info) {
+  uint32_t index = static_cast<uint32_t>(next_seq_ % block_num_);
+  char* block = blocks_ + index * block_size_;
+  RdmaBlockHeader header;
+  header.seq = next_seq_;
+  header.msg_size = static_cast<uint32_t>(msg_size);
+  header.msg_info_size = static_cast<uint32_t>(MessageInfo::kSize);
+  memcpy(block, &header, sizeof(header));
+  if (!msg_info.SerializeTo(block + sizeof(header) + msg_size,
+                            MessageInfo::kSize)) {
+    AERROR << "serialize message info failed.";
+    return false;
+  }
+
+  ibv_sge sge;
+  sge.addr = reinterpret_cast<uint64_t>(block);
+  sge.length =
+      static_cast<uint32_t>(sizeof(header) + msg_size + MessageInfo::kSize);
+  sge.lkey = blocks_mr_->lkey;
+  ibv_send_wr wr;
+  memset(&wr, 0, sizeof(wr));
+  wr.wr_id = index;
+  wr.sg_list = &sge;
+  wr.num_sge = 1;
+  wr.opcode = IBV_WR_RDMA_WRITE_WITH_IMM;
+  wr.send_flags = IBV_SEND_SIGNALED;
+  wr.imm_data = htonl(index);
+  wr.wr.rdma.remote_addr = ring_addr_ + index * block_size_;
+  wr.wr.rdma.rkey = ring_rkey_;
+  ibv_send_wr* bad_wr = nullptr;
+  if (ibv_post_send(qp_, &wr, &bad_wr) != 0) {
+    AERROR << "post rdma write failed: " << strerror(errno);
+    broken_ = true;
+    return false;
+  }
+  in_flight_[index] = true;
+  ++next_seq_;
+  Reap(false);
+  return true;
+}
+
+bool RdmaWriter::Write(const std::string& data, const MessageInfo& msg_info) {
+  char* buf = Acquire(data.size());
+  if (buf == nullptr) {
+    return false;
+  }
+  memcpy(buf, data.data(), data.size());
+  return Post(data.size(), msg_info);
+}
+
+void RdmaWriter::Reap(bool wait) {
+  ibv_wc wcs[16];
+  int n = 0;
+  do {
+    n = ibv_poll_cq(cq_, 16, wcs);
+  } while (n == 0 && wait);
+  for (int i = 0; i < n; ++i) {
+    if (wcs[i].status != IBV_WC_SUCCESS) {
+      AERROR << "rdma write failed: " << ibv_wc_status_str(wcs[i].status);
+      broken_ = true;
+    }
+    in_flight_[wcs[i].wr_id] = false;
+  }
+  if (n < 0) {
+    broken_ = true;
+  }
+}
+
+void RdmaWriter::Close() {
+  broken_ = true;
+  if (fd_ >= 0) {
+    close(fd_);
+    fd_ = -1;
+  }
+  if (qp_ != nullptr) {
+    ibv_destroy_qp(qp_);
+    qp_ = nullptr;
+  }
+  if (cq_ != nullptr) {
+    ibv_destroy_cq(cq_);
+    cq_ = nullptr;
+  }
+  if (blocks_mr_ != nullptr) {
+    ibv_dereg_mr(blocks_mr_);
+    blocks_mr_ = nullptr;
+  }
+  if (credit_mr_ != nullptr) {
+    ibv_dereg_mr(credit_mr_);
+    credit_mr_ = nullptr;
+  }
+  free(blocks_);
+  blocks_ = nullptr;
+  free(credit_);
+  credit_ = nullptr;
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
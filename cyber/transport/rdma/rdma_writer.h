@@ -0,0 +1,103 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_TRANSPORT_RDMA_RDMA_WRITER_H_
+#define CYBER_TRANSPORT_RDMA_RDMA_WRITER_H_
+
+#include <infiniband/verbs.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "cyber/transport/message/message_info.h"
+#include "cyber/transport/rdma/rdma_handshake.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+/**
+ * @class RdmaWriter
+ * @brief The writer end of the connection to one reader process on another
+ * host. Messages are serialized into a registered local block and written
+ * with RDMA into the block of the same index on the reader, whose immediate
+ * data tells the reader which block is readable, like ReadableInfo does for
+ * shared memory. A block is reused once the reader acknowledged it; until
+ * then new messages are dropped instead of overwriting unread ones.
+ */
+class RdmaWriter {
+ public:
+  RdmaWriter();
+  virtual ~RdmaWriter();
+
+  /**
+   * @brief Connect to the process of a reader on another host.
+   *
+   * @param request channel, writer and reader ids and the reader process,
+   * the rest is filled in here
+   */
+  bool Connect(const std::string& ip, RdmaRequest request);
+
+  /**
+   * @brief Whether a message of `msg_size` bytes fits in a block.
+   */
+  bool Fits(std::size_t msg_size) const;
+
+  /**
+   * @brief Block to serialize a message of `msg_size` bytes into, nullptr if
+   * the reader has not released one yet or the connection broke. Post() or
+   * drop it before acquiring the next one.
+   */
+  char* Acquire(std::size_t msg_size);
+  bool Post(std::size_t msg_size, const MessageInfo& msg_info);
+
+  bool Write(const std::string& data, const MessageInfo& msg_info);
+
+  bool broken() const { return broken_; }
+  uint64_t block_size() const { return block_size_; }
+
+ private:
+  void Reap(bool wait);
+  void Close();
+
+  int fd_ = -1;
+  ibv_cq* cq_ = nullptr;
+  ibv_qp* qp_ = nullptr;
+  char* blocks_ = nullptr;
+  ibv_mr* blocks_mr_ = nullptr;
+  // blocks the reader is done with, written by the reader
+  uint64_t* credit_ = nullptr;
+  ibv_mr* credit_mr_ = nullptr;
+
+  uint64_t block_size_ = 0;
+  uint32_t block_num_ = 0;
+  uint64_t ring_addr_ = 0;
+  uint32_t ring_rkey_ = 0;
+  uint64_t next_seq_ = 0;
+  std::vector<bool> in_flight_;
+  bool broken_ = true;
+};
+
+using RdmaWriterPtr = std::shared_ptr<RdmaWriter>;
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_TRANSPORT_RDMA_RDMA_WRITER_H_
@@ -32,7 +32,9 @@
 #include "cyber/service_discovery/role/role.h"
 #include "cyber/task/task.h"
 #include "cyber/time/time.h"
+#include "cyber/transport/rdma/rdma_conf.h"
 #include "cyber/transport/receiver/intra_receiver.h"
+#include "cyber/transport/receiver/rdma_receiver.h"
 #include "cyber/transport/receiver/rtps_receiver.h"
 #include "cyber/transport/receiver/shm_receiver.h"
 #include "cyber/transport/rtps/participant.h"
@@ -85,6 +87,9 @@ class HybridReceiver : public Receiver<M> {
 
   HistoryPtr history_;
   ReceiverContainer receivers_;
+  // takes messages from writers on other hosts that chose RDMA, see
+  // RdmaConf, their copies arriving through diff_host mode are dropped
+  ReceiverPtr rdma_receiver_;
   TransmitterContainer transmitters_;
   std::mutex mutex_;
 
@@ -202,6 +207,21 @@ void HybridReceiver<M>::InitReceivers() {
   modes.insert(mode_->diff_host());
   auto listener = std::bind(&HybridReceiver<M>::OnNewMessage, this,
                             std::placeholders::_1, std::placeholders::_2);
+  typename Receiver<M>::MessageListener rtps_listener = listener;
+  if (RdmaConf::Enabled(this->attr_.channel_name()) &&
+      RdmaDispatcher::Instance()->Ready()) {
+    rdma_receiver_ = std::make_shared<RdmaReceiver<M>>(this->attr_, listener);
+    // registered before any writer shows up, so that it can connect at once
+    rdma_receiver_->Enable();
+    rtps_listener = [this](const std::shared_ptr<M>& msg,
+                           const MessageInfo& msg_info,
+                           const RoleAttributes& attr) {
+      if (!RdmaDispatcher::Instance()->IsConnected(
+              attr.channel_id(), msg_info.sender_id().HashValue())) {
+        this->OnNewMessage(msg, msg_info);
+      }
+    };
+  }
   for (auto& mode : modes) {
     switch (mode) {
       case OptionalMode::INTRA:
@@ -214,7 +234,7 @@ void HybridReceiver<M>::InitReceivers() {
         break;
       default:
         receivers_[mode] =
-            std::make_shared<RtpsReceiver<M>>(this->attr_, listener);
+            std::make_shared<RtpsReceiver<M>>(this->attr_, rtps_listener);
         break;
     }
   }
@@ -223,6 +243,7 @@ void HybridReceiver<M>::InitReceivers() {
 template <typename M>
 void HybridReceiver<M>::ClearReceivers() {
   receivers_.clear();
+  rdma_receiver_ = nullptr;
 }
 
 template <typename M>
@@ -57,6 +57,16 @@ void SubListener::onNewDataMessage(eprosima::fastrtps::Subscriber* sub) {
       m_info.related_sample_identity.sequence_number().low;
   msg_info_.set_seq_num(seq_num);
 
+  // the rtps header has no room for MessageInfo::send_time, use the time
+  // the writer stamped the sample with, fraction is in 1/2^32 seconds
+  const auto& stamp = m_info.sourceTimestamp;
+  uint64_t send_time = 0;
+  if (stamp.seconds > 0) {
+    send_time = static_cast<uint64_t>(stamp.seconds) * 1000000000UL +
+                ((static_cast<uint64_t>(stamp.fraction) * 1000000000UL) >> 32);
+  }
+  msg_info_.set_send_time(send_time);
+
   // fetch message string
   std::shared_ptr<std::string> msg_str =
       std::make_shared<std::string>(m.data());
@@ -0,0 +1,113 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/transport/shm/busy_readers.h"
+
+#include <algorithm>
+
+#include "cyber/common/log.h"
+#include "cyber/transport/shm/segment_factory.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+namespace {
+// the segment is created by the first message a writer of the host sends,
+// opening it is retried less and less often until then
+constexpr std::chrono::seconds kMinOpenRetryInterval(1);
+constexpr std::chrono::seconds kMaxOpenRetryInterval(64);
+}  // namespace
+
+BusyReaders::BusyReaders() {}
+
+void BusyReaders::AddReader(uint64_t channel_id, uint64_t receiver_id,
+                            bool latest_only) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& channel = channels_[channel_id];
+  channel.receiver_id = receiver_id;
+  ++channel.readers;
+  if (latest_only) {
+    ++channel.latest_only;
+  }
+  Update(channel_id, &channel);
+}
+
+void BusyReaders::RemoveReader(uint64_t channel_id, bool latest_only) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = channels_.find(channel_id);
+  if (iter == channels_.end()) {
+    return;
+  }
+  auto& channel = iter->second;
+  if (channel.readers > 0) {
+    --channel.readers;
+  }
+  if (latest_only && channel.latest_only > 0) {
+    --channel.latest_only;
+  }
+  Update(channel_id, &channel);
+  if (channel.readers == 0 && !channel.marked) {
+    channels_.erase(iter);
+  }
+}
+
+void BusyReaders::SetBusy(uint64_t channel_id, bool busy) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = channels_.find(channel_id);
+  if (iter == channels_.end()) {
+    return;
+  }
+  auto& channel = iter->second;
+  if (busy) {
+    ++channel.busy;
+  } else if (channel.busy > 0) {
+    --channel.busy;
+  }
+  Update(channel_id, &channel);
+}
+
+void BusyReaders::Update(uint64_t channel_id, Channel* channel) {
+  bool busy = channel->readers > 0 &&
+              channel->latest_only == channel->readers &&
+              channel->busy >= channel->latest_only;
+  if (busy == channel->marked) {
+    return;
+  }
+
+  auto now = std::chrono::steady_clock::now();
+  if (channel->segment == nullptr) {
+    if (!busy || now < channel->next_open) {
+      return;
+    }
+    channel->segment = SegmentFactory::CreateSegment(channel_id);
+  }
+  if (channel->segment->SetReaderBusy(channel->receiver_id, busy)) {
+    channel->marked = busy;
+    channel->open_retry_interval = kMinOpenRetryInterval;
+  } else if (!channel->marked) {
+    ADEBUG << "channel[" << channel_id << "] segment not ready, writers will "
+           << "keep sending to its busy readers.";
+    channel->segment = nullptr;
+    channel->next_open = now + channel->open_retry_interval;
+    channel->open_retry_interval =
+        std::min(channel->open_retry_interval * 2, kMaxOpenRetryInterval);
+  }
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
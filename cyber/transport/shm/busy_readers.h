@@ -0,0 +1,76 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_TRANSPORT_SHM_BUSY_READERS_H_
+#define CYBER_TRANSPORT_SHM_BUSY_READERS_H_
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+
+#include "cyber/common/macros.h"
+#include "cyber/transport/shm/segment.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+/**
+ * @class BusyReaders
+ * @brief Tells the writers of other processes on the host when the readers
+ * of a channel in this process would not take a new message.
+ *
+ * The readers of a channel in a process share one receiver id, which the
+ * writers see in the topology. That id is marked busy in the shared memory
+ * segment of the channel while all those readers are latest-only and in
+ * their callback, so the writers skip serializing messages for it.
+ */
+class BusyReaders {
+ public:
+  void AddReader(uint64_t channel_id, uint64_t receiver_id, bool latest_only);
+  void RemoveReader(uint64_t channel_id, bool latest_only);
+
+  /**
+   * @brief For latest-only readers, around their callback.
+   */
+  void SetBusy(uint64_t channel_id, bool busy);
+
+ private:
+  struct Channel {
+    uint64_t receiver_id = 0;
+    uint32_t readers = 0;
+    uint32_t latest_only = 0;
+    uint32_t busy = 0;
+    bool marked = false;
+    SegmentPtr segment = nullptr;
+    std::chrono::steady_clock::time_point next_open;
+    std::chrono::seconds open_retry_interval{1};
+  };
+
+  void Update(uint64_t channel_id, Channel* channel);
+
+  std::mutex mutex_;
+  std::unordered_map<uint64_t, Channel> channels_;
+
+  DECLARE_SINGLETON(BusyReaders)
+};
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_TRANSPORT_SHM_BUSY_READERS_H_
@@ -31,6 +31,7 @@ class NotifierFactory {
 
  private:
   static NotifierPtr CreateConditionNotifier();
+  static NotifierPtr CreateFutexNotifier();
   static NotifierPtr CreateMulticastNotifier();
 };
 
@@ -25,6 +25,7 @@
 #include "cyber/transport/shm/block.h"
 #include "cyber/transport/shm/segment.h"
 #include "cyber/transport/shm/shm_conf.h"
+#include "cyber/transport/shm/shm_placement.h"
 
 namespace apollo {
 namespace cyber {
@@ -42,7 +43,7 @@ bool PosixSegment::OpenOrCreate() {
   }
 
   // create managed_shm_
-  int fd = shm_open(shm_name_.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+  int fd = OpenShm(O_RDWR | O_CREAT | O_EXCL);
   if (fd < 0) {
     if (EEXIST == errno) {
       ADEBUG << "shm already exist, open only.";
@@ -65,11 +66,13 @@ bool PosixSegment::OpenOrCreate() {
   if (managed_shm_ == MAP_FAILED) {
     AERROR << "attach shm failed:" << strerror(errno);
     close(fd);
-    shm_unlink(shm_name_.c_str());
+    UnlinkShm();
     return false;
   }
 
   close(fd);
+  ShmPlacement::BindToNumaNode(managed_shm_, conf_.managed_shm_size(),
+                               ShmPlacement::NumaNode());
 
   // create field state_
   state_ = new (managed_shm_) State(conf_.ceiling_msg_size());
@@ -77,7 +80,7 @@ bool PosixSegment::OpenOrCreate() {
     AERROR << "create state failed.";
     munmap(managed_shm_, conf_.managed_shm_size());
     managed_shm_ = nullptr;
-    shm_unlink(shm_name_.c_str());
+    UnlinkShm();
     return false;
   }
 
@@ -92,7 +95,7 @@ bool PosixSegment::OpenOrCreate() {
     state_ = nullptr;
     munmap(managed_shm_, conf_.managed_shm_size());
     managed_shm_ = nullptr;
-    shm_unlink(shm_name_.c_str());
+    UnlinkShm();
     return false;
   }
 
@@ -101,8 +104,8 @@ bool PosixSegment::OpenOrCreate() {
   for (; i < conf_.block_num(); ++i) {
     uint8_t* addr =
         new (static_cast<char*>(managed_shm_) + sizeof(State) +
-             conf_.block_num() * sizeof(Block) + i * conf_.block_buf_size())
-            uint8_t[conf_.block_buf_size()];
+             conf_.block_num() * sizeof(Block) +
+             conf_.BlockBufOffset(i)) uint8_t[conf_.BlockBufSize(i)];
 
     if (addr == nullptr) {
       break;
@@ -123,7 +126,7 @@ bool PosixSegment::OpenOrCreate() {
     }
     munmap(managed_shm_, conf_.managed_shm_size());
     managed_shm_ = nullptr;
-    shm_unlink(shm_name_.c_str());
+    UnlinkShm();
     return false;
   }
 
@@ -138,7 +141,7 @@ bool PosixSegment::OpenOnly() {
   }
 
   // get managed_shm_
-  int fd = shm_open(shm_name_.c_str(), O_RDWR, 0644);
+  int fd = OpenShm(O_RDWR);
   if (fd == -1) {
     AERROR << "get shm failed: " << strerror(errno);
     return false;
@@ -188,7 +191,7 @@ bool PosixSegment::OpenOnly() {
   for (; i < conf_.block_num(); ++i) {
     uint8_t* addr = reinterpret_cast<uint8_t*>(
         static_cast<char*>(managed_shm_) + sizeof(State) +
-        conf_.block_num() * sizeof(Block) + i * conf_.block_buf_size());
+        conf_.block_num() * sizeof(Block) + conf_.BlockBufOffset(i));
 
     std::lock_guard<std::mutex> lg(block_buf_lock_);
     block_buf_addrs_[i] = addr;
@@ -205,7 +208,7 @@ bool PosixSegment::OpenOnly() {
     }
     munmap(managed_shm_, conf_.managed_shm_size());
     managed_shm_ = nullptr;
-    shm_unlink(shm_name_.c_str());
+    UnlinkShm();
     return false;
   }
 
@@ -216,13 +219,29 @@ bool PosixSegment::OpenOnly() {
 }
 
 bool PosixSegment::Remove() {
-  if (shm_unlink(shm_name_.c_str()) < 0) {
+  if (UnlinkShm() < 0) {
     AERROR << "shm_unlink failed: " << strerror(errno);
     return false;
   }
   return true;
 }
 
+int PosixSegment::OpenShm(int flags) {
+  if (ShmPlacement::UseHugePage()) {
+    auto path = ShmPlacement::HugeTlbfsDir() + "/" + shm_name_;
+    return open(path.c_str(), flags, 0644);
+  }
+  return shm_open(shm_name_.c_str(), flags, 0644);
+}
+
+int PosixSegment::UnlinkShm() {
+  if (ShmPlacement::UseHugePage()) {
+    auto path = ShmPlacement::HugeTlbfsDir() + "/" + shm_name_;
+    return unlink(path.c_str());
+  }
+  return shm_unlink(shm_name_.c_str());
+}
+
 void PosixSegment::Reset() {
   state_ = nullptr;
   blocks_ = nullptr;
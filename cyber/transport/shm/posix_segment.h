@@ -38,6 +38,10 @@ class PosixSegment : public Segment {
   bool OpenOnly() override;
   bool OpenOrCreate() override;
 
+  // shm_open/shm_unlink, or a file in hugetlbfs when huge pages are used
+  int OpenShm(int flags);
+  int UnlinkShm();
+
   std::string shm_name_;
 };
 
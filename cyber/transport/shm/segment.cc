@@ -59,7 +59,7 @@ bool Segment::AcquireBlockToWrite(std::size_t msg_size,
     return false;
   }
 
-  uint32_t index = GetNextWritableBlockIndex();
+  uint32_t index = GetNextWritableBlockIndex(msg_size);
   writable_block->index = index;
   writable_block->block = &blocks_[index];
   writable_block->buf = block_buf_addrs_[index];
@@ -89,6 +89,11 @@ bool Segment::AcquireBlockToRead(ReadableBlock* readable_block) {
 
   bool result = true;
   if (state_->need_remap()) {
+    if (pinned_blocks_.load() > 0) {
+      AWARN << "segment of channel " << channel_id_
+            << " needs remap but still has pinned blocks, skip reading.";
+      return false;
+    }
     result = Remap();
   }
 
@@ -113,6 +118,27 @@ void Segment::ReleaseReadBlock(const ReadableBlock& readable_block) {
   blocks_[index].ReleaseReadLock();
 }
 
+std::shared_ptr<ReadableBlock> Segment::PinReadBlock(const ReadableBlock& rb) {
+  pinned_blocks_.fetch_add(1);
+  auto self = shared_from_this();
+  return std::shared_ptr<ReadableBlock>(
+      new ReadableBlock(rb), [self](ReadableBlock* block) {
+        self->ReleaseReadBlock(*block);
+        self->pinned_blocks_.fetch_sub(1);
+        delete block;
+      });
+}
+
+bool Segment::SetReaderBusy(uint64_t reader_id, bool busy) {
+  if (!init_ && !OpenOnly()) {
+    return false;
+  }
+  if (state_->need_remap() && (pinned_blocks_.load() > 0 || !Remap())) {
+    return false;
+  }
+  return state_->SetReaderBusy(reader_id, busy);
+}
+
 bool Segment::Destroy() {
   if (!init_) {
     return true;
@@ -150,12 +176,21 @@ bool Segment::Recreate(const uint64_t& msg_size) {
   return OpenOrCreate();
 }
 
-uint32_t Segment::GetNextWritableBlockIndex() {
-  const auto block_num = conf_.block_num();
+uint32_t Segment::GetNextWritableBlockIndex(std::size_t msg_size) {
+  const auto& arenas = conf_.arenas();
+  const uint32_t first_arena = conf_.GetArenaIndex(msg_size);
   while (1) {
-    uint32_t try_idx = state_->FetchAddSeq(1) % block_num;
-    if (blocks_[try_idx].TryLockForWrite()) {
-      return try_idx;
+    // prefer the smallest size class that fits, spill over to larger ones
+    // only when every block of it is busy
+    for (uint32_t i = first_arena; i < arenas.size(); ++i) {
+      const auto& arena = arenas[i];
+      for (uint32_t retry = 0; retry < arena.block_num; ++retry) {
+        uint32_t try_idx = arena.first_block_index +
+                           state_->FetchAddSeq(1) % arena.block_num;
+        if (blocks_[try_idx].TryLockForWrite()) {
+          return try_idx;
+        }
+      }
     }
   }
   return 0;
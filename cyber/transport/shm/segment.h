@@ -17,6 +17,7 @@
 #ifndef CYBER_TRANSPORT_SHM_SEGMENT_H_
 #define CYBER_TRANSPORT_SHM_SEGMENT_H_
 
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -40,7 +41,7 @@ struct WritableBlock {
 };
 using ReadableBlock = WritableBlock;
 
-class Segment {
+class Segment : public std::enable_shared_from_this<Segment> {
  public:
   explicit Segment(uint64_t channel_id);
   virtual ~Segment() {}
@@ -51,6 +52,28 @@ class Segment {
   bool AcquireBlockToRead(ReadableBlock* readable_block);
   void ReleaseReadBlock(const ReadableBlock& readable_block);
 
+  /**
+   * @brief Hand out a read-locked block whose lock is released when the last
+   * copy of the returned pointer goes away. Used by zero-copy readers that
+   * keep referring to the block after the dispatcher returns. The segment
+   * is kept alive by the returned pointer and is not remapped while pinned
+   * blocks are outstanding.
+   */
+  std::shared_ptr<ReadableBlock> PinReadBlock(const ReadableBlock& rb);
+
+  /**
+   * @brief For a process whose readers of the channel are all latest-only,
+   * tell the writers whether they are all busy, see State::SetReaderBusy.
+   */
+  bool SetReaderBusy(uint64_t reader_id, bool busy);
+
+  /**
+   * @brief For writers, whether all of `reader_ids` are busy latest-only
+   * readers, false if there is none.
+   */
+  template <typename Container>
+  bool AreReadersBusy(const Container& reader_ids);
+
  protected:
   virtual bool Destroy();
   virtual void Reset() = 0;
@@ -67,13 +90,28 @@ class Segment {
   void* managed_shm_;
   std::mutex block_buf_lock_;
   std::unordered_map<uint32_t, uint8_t*> block_buf_addrs_;
+  std::atomic<uint32_t> pinned_blocks_ = {0};
 
  private:
   bool Remap();
   bool Recreate(const uint64_t& msg_size);
-  uint32_t GetNextWritableBlockIndex();
+  uint32_t GetNextWritableBlockIndex(std::size_t msg_size);
 };
 
+template <typename Container>
+bool Segment::AreReadersBusy(const Container& reader_ids) {
+  // the segment of a writer is created on its first message
+  if (!init_ || reader_ids.empty()) {
+    return false;
+  }
+  for (uint64_t reader_id : reader_ids) {
+    if (!state_->IsReaderBusy(reader_id)) {
+      return false;
+    }
+  }
+  return true;
+}
+
 }  // namespace transport
 }  // namespace cyber
 }  // namespace apollo
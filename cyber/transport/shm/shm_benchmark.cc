@@ -0,0 +1,138 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+// Microbenchmarks of the shared memory transport: writes and reads of a
+// segment block at several message sizes, and the round trip of every
+// notifier, from Notify() to the listener thread getting the readable info.
+// The segment type is the shm_type of the cyber config. For results to keep
+// across releases, write them as json:
+//
+//   shm_benchmark --benchmark_out=shm.json --benchmark_out_format=json
+
+#include <atomic>
+#include <cstring>
+#include <string>
+#include <thread>
+
+#include "benchmark/benchmark.h"
+
+#include "cyber/common/util.h"
+#include "cyber/transport/shm/condition_notifier.h"
+#include "cyber/transport/shm/futex_notifier.h"
+#include "cyber/transport/shm/multicast_notifier.h"
+#include "cyber/transport/shm/readable_info.h"
+#include "cyber/transport/shm/segment_factory.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+namespace {
+
+SegmentPtr CreateSegment(std::size_t msg_size) {
+  return SegmentFactory::CreateSegment(
+      common::Hash("/benchmark/shm/" + std::to_string(msg_size)));
+}
+
+bool Write(const SegmentPtr& segment, const std::string& msg,
+           uint32_t* index) {
+  WritableBlock wb;
+  if (!segment->AcquireBlockToWrite(msg.size(), &wb)) {
+    return false;
+  }
+  std::memcpy(wb.buf, msg.data(), msg.size());
+  wb.block->set_msg_size(msg.size());
+  segment->ReleaseWrittenBlock(wb);
+  *index = wb.index;
+  return true;
+}
+
+}  // namespace
+
+void BM_SegmentWrite(benchmark::State& state) {
+  auto segment = CreateSegment(state.range(0));
+  std::string msg(state.range(0), 'x');
+  uint32_t index = 0;
+  for (auto _ : state) {
+    if (!Write(segment, msg, &index)) {
+      state.SkipWithError("acquire block to write failed");
+      break;
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SegmentWrite)->RangeMultiplier(8)->Range(64, 4 << 20);
+
+void BM_SegmentRead(benchmark::State& state) {
+  auto segment = CreateSegment(state.range(0));
+  std::string msg(state.range(0), 'x');
+  ReadableBlock rb;
+  if (!Write(segment, msg, &rb.index)) {
+    state.SkipWithError("acquire block to write failed");
+    return;
+  }
+  for (auto _ : state) {
+    if (!segment->AcquireBlockToRead(&rb)) {
+      state.SkipWithError("acquire block to read failed");
+      break;
+    }
+    std::memcpy(&msg[0], rb.buf, rb.block->msg_size());
+    segment->ReleaseReadBlock(rb);
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SegmentRead)->RangeMultiplier(8)->Range(64, 4 << 20);
+
+template <typename NotifierT>
+void BM_NotifierRoundTrip(benchmark::State& state) {
+  NotifierBase* notifier = NotifierT::Instance();
+  const uint64_t channel_id = common::Hash("/benchmark/shm/notifier");
+  std::atomic<uint32_t> received = {0};
+  std::atomic<bool> stop = {false};
+  std::thread listener([&]() {
+    ReadableInfo info;
+    while (!stop.load(std::memory_order_relaxed)) {
+      // other processes on the host may notify too
+      if (notifier->Listen(100, &info) && info.channel_id() == channel_id) {
+        received.store(info.block_index(), std::memory_order_release);
+      }
+    }
+  });
+
+  uint32_t seq = 0;
+  ReadableInfo info(0, 0, channel_id);
+  for (auto _ : state) {
+    info.set_block_index(++seq);
+    if (!notifier->Notify(info)) {
+      state.SkipWithError("notify failed");
+      break;
+    }
+    while (received.load(std::memory_order_acquire) != seq) {
+      std::this_thread::yield();
+    }
+  }
+  stop = true;
+  listener.join();
+}
+BENCHMARK_TEMPLATE(BM_NotifierRoundTrip, ConditionNotifier)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_NotifierRoundTrip, FutexNotifier)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_NotifierRoundTrip, MulticastNotifier)->UseRealTime();
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
+
+BENCHMARK_MAIN();
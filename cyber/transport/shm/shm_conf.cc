@@ -16,6 +16,7 @@
 
 #include "cyber/transport/shm/shm_conf.h"
 #include "cyber/common/log.h"
+#include "cyber/transport/shm/shm_placement.h"
 
 namespace apollo {
 namespace cyber {
@@ -28,11 +29,69 @@ ShmConf::ShmConf(const uint64_t& real_msg_size) { Update(real_msg_size); }
 ShmConf::~ShmConf() {}
 
 void ShmConf::Update(const uint64_t& real_msg_size) {
-  ceiling_msg_size_ = GetCeilingMessageSize(real_msg_size);
+  static const uint64_t kSizeClasses[] = {
+      MESSAGE_SIZE_16K, MESSAGE_SIZE_128K, MESSAGE_SIZE_1M,
+      MESSAGE_SIZE_8M,  MESSAGE_SIZE_16M,  MESSAGE_SIZE_MORE};
+
+  ceiling_msg_size_ = GetCeilingMessageSize(
+      real_msg_size < MIN_CEILING_MSG_SIZE ? MIN_CEILING_MSG_SIZE
+                                           : real_msg_size);
   block_buf_size_ = GetBlockBufSize(ceiling_msg_size_);
-  block_num_ = GetBlockNum(ceiling_msg_size_);
-  managed_shm_size_ =
-      EXTRA_SIZE + STATE_SIZE + (BLOCK_SIZE + block_buf_size_) * block_num_;
+  block_num_ = 0;
+  managed_shm_size_ = EXTRA_SIZE + STATE_SIZE;
+  arenas_.clear();
+
+  uint64_t buf_offset = 0;
+  for (const auto& size_class : kSizeClasses) {
+    if (size_class > ceiling_msg_size_) {
+      break;
+    }
+    Arena arena;
+    arena.ceiling_msg_size = size_class;
+    arena.block_buf_size = GetBlockBufSize(size_class);
+    arena.block_num = GetBlockNum(size_class);
+    arena.first_block_index = block_num_;
+    arena.buf_offset = buf_offset;
+    arenas_.emplace_back(arena);
+
+    block_num_ += arena.block_num;
+    buf_offset += arena.block_buf_size * arena.block_num;
+    managed_shm_size_ += (BLOCK_SIZE + arena.block_buf_size) * arena.block_num;
+  }
+  managed_shm_size_ = ShmPlacement::AlignSize(managed_shm_size_);
+}
+
+uint32_t ShmConf::GetArenaIndex(const uint64_t& msg_size) const {
+  uint32_t i = 0;
+  for (; i < arenas_.size(); ++i) {
+    if (msg_size <= arenas_[i].ceiling_msg_size) {
+      break;
+    }
+  }
+  return i;
+}
+
+uint64_t ShmConf::BlockBufSize(const uint32_t& block_index) const {
+  auto arena = GetArena(block_index);
+  return arena == nullptr ? 0 : arena->block_buf_size;
+}
+
+uint64_t ShmConf::BlockBufOffset(const uint32_t& block_index) const {
+  auto arena = GetArena(block_index);
+  if (arena == nullptr) {
+    return 0;
+  }
+  return arena->buf_offset +
+         (block_index - arena->first_block_index) * arena->block_buf_size;
+}
+
+const ShmConf::Arena* ShmConf::GetArena(const uint32_t& block_index) const {
+  for (const auto& arena : arenas_) {
+    if (block_index < arena.first_block_index + arena.block_num) {
+      return &arena;
+    }
+  }
+  return nullptr;
 }
 
 const uint64_t ShmConf::EXTRA_SIZE = 1024 * 4;
@@ -40,19 +99,21 @@ const uint64_t ShmConf::STATE_SIZE = 1024;
 const uint64_t ShmConf::BLOCK_SIZE = 1024;
 const uint64_t ShmConf::MESSAGE_INFO_SIZE = 1024;
 
-const uint32_t ShmConf::BLOCK_NUM_16K = 512;
+const uint64_t ShmConf::MIN_CEILING_MSG_SIZE = 1024 * 1024 * 8;
+
+const uint32_t ShmConf::BLOCK_NUM_16K = 256;
 const uint64_t ShmConf::MESSAGE_SIZE_16K = 1024 * 16;
 
-const uint32_t ShmConf::BLOCK_NUM_128K = 128;
+const uint32_t ShmConf::BLOCK_NUM_128K = 64;
 const uint64_t ShmConf::MESSAGE_SIZE_128K = 1024 * 128;
 
-const uint32_t ShmConf::BLOCK_NUM_1M = 64;
+const uint32_t ShmConf::BLOCK_NUM_1M = 16;
 const uint64_t ShmConf::MESSAGE_SIZE_1M = 1024 * 1024;
 
-const uint32_t ShmConf::BLOCK_NUM_8M = 32;
+const uint32_t ShmConf::BLOCK_NUM_8M = 8;
 const uint64_t ShmConf::MESSAGE_SIZE_8M = 1024 * 1024 * 8;
 
-const uint32_t ShmConf::BLOCK_NUM_16M = 16;
+const uint32_t ShmConf::BLOCK_NUM_16M = 8;
 const uint64_t ShmConf::MESSAGE_SIZE_16M = 1024 * 1024 * 16;
 
 const uint32_t ShmConf::BLOCK_NUM_MORE = 8;
@@ -19,13 +19,31 @@
 
 #include <cstdint>
 #include <string>
+#include <vector>
 
 namespace apollo {
 namespace cyber {
 namespace transport {
 
+/**
+ * @class ShmConf
+ * @brief Layout of a segment. Blocks are grouped in arenas, one per message
+ * size class, so small messages never occupy large blocks and the segment
+ * only has to be recreated when a message exceeds the largest class.
+ * Block indexes are global: arena i owns
+ * [first_block_index, first_block_index + block_num).
+ */
 class ShmConf {
  public:
+  struct Arena {
+    uint64_t ceiling_msg_size = 0;
+    uint64_t block_buf_size = 0;
+    uint32_t block_num = 0;
+    uint32_t first_block_index = 0;
+    // offset of the first block buf, relative to the start of the buf area
+    uint64_t buf_offset = 0;
+  };
+
   ShmConf();
   explicit ShmConf(const uint64_t& real_msg_size);
   virtual ~ShmConf();
@@ -36,16 +54,24 @@ class ShmConf {
   const uint64_t& block_buf_size() { return block_buf_size_; }
   const uint32_t& block_num() { return block_num_; }
   const uint64_t& managed_shm_size() { return managed_shm_size_; }
+  const std::vector<Arena>& arenas() const { return arenas_; }
+
+  // index of the smallest arena that fits msg_size, arenas().size() if none
+  uint32_t GetArenaIndex(const uint64_t& msg_size) const;
+  uint64_t BlockBufSize(const uint32_t& block_index) const;
+  uint64_t BlockBufOffset(const uint32_t& block_index) const;
 
  private:
   uint64_t GetCeilingMessageSize(const uint64_t& real_msg_size);
   uint64_t GetBlockBufSize(const uint64_t& ceiling_msg_size);
   uint32_t GetBlockNum(const uint64_t& ceiling_msg_size);
+  const Arena* GetArena(const uint32_t& block_index) const;
 
   uint64_t ceiling_msg_size_;
   uint64_t block_buf_size_;
   uint32_t block_num_;
   uint64_t managed_shm_size_;
+  std::vector<Arena> arenas_;
 
   // Extra size, Byte
   static const uint64_t EXTRA_SIZE;
@@ -55,6 +81,9 @@ class ShmConf {
   static const uint64_t BLOCK_SIZE;
   // Message info size, Byte
   static const uint64_t MESSAGE_INFO_SIZE;
+  // Smallest ceiling a segment is created with, so that channels mixing
+  // small and large messages do not recreate it on the first large one
+  static const uint64_t MIN_CEILING_MSG_SIZE;
   // For message 0-10K
   static const uint32_t BLOCK_NUM_16K;
   static const uint64_t MESSAGE_SIZE_16K;
@@ -0,0 +1,83 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/transport/shm/shm_conf.h"
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+TEST(ShmConfTest, default_arenas) {
+  ShmConf conf;
+  const auto& arenas = conf.arenas();
+  ASSERT_EQ(arenas.size(), 4);
+  EXPECT_EQ(conf.ceiling_msg_size(), 1024 * 1024 * 8);
+
+  uint32_t block_num = 0;
+  uint64_t buf_offset = 0;
+  for (const auto& arena : arenas) {
+    EXPECT_EQ(arena.first_block_index, block_num);
+    EXPECT_EQ(arena.buf_offset, buf_offset);
+    EXPECT_GT(arena.block_buf_size, arena.ceiling_msg_size);
+    block_num += arena.block_num;
+    buf_offset += arena.block_num * arena.block_buf_size;
+  }
+  EXPECT_EQ(conf.block_num(), block_num);
+  EXPECT_GT(conf.managed_shm_size(), buf_offset);
+}
+
+TEST(ShmConfTest, arena_index) {
+  ShmConf conf;
+  EXPECT_EQ(conf.GetArenaIndex(0), 0);
+  EXPECT_EQ(conf.GetArenaIndex(1024 * 16), 0);
+  EXPECT_EQ(conf.GetArenaIndex(1024 * 16 + 1), 1);
+  EXPECT_EQ(conf.GetArenaIndex(1024 * 1024), 2);
+  EXPECT_EQ(conf.GetArenaIndex(1024 * 1024 * 8), 3);
+  EXPECT_EQ(conf.GetArenaIndex(1024 * 1024 * 8 + 1), conf.arenas().size());
+}
+
+TEST(ShmConfTest, block_layout) {
+  ShmConf conf;
+  const auto& small = conf.arenas().front();
+  const auto& large = conf.arenas().back();
+  EXPECT_EQ(conf.BlockBufOffset(0), 0);
+  EXPECT_EQ(conf.BlockBufOffset(1), small.block_buf_size);
+  EXPECT_EQ(conf.BlockBufSize(0), small.block_buf_size);
+
+  uint32_t last = conf.block_num() - 1;
+  EXPECT_EQ(conf.BlockBufSize(last), large.block_buf_size);
+  EXPECT_EQ(conf.BlockBufOffset(last),
+            large.buf_offset + (large.block_num - 1) * large.block_buf_size);
+  EXPECT_EQ(conf.BlockBufSize(conf.block_num()), 0);
+}
+
+TEST(ShmConfTest, update) {
+  ShmConf conf;
+  conf.Update(1024 * 1024 * 12);
+  EXPECT_EQ(conf.ceiling_msg_size(), 1024 * 1024 * 16);
+  EXPECT_EQ(conf.arenas().size(), 5);
+  EXPECT_EQ(conf.GetArenaIndex(1024 * 1024 * 12), 4);
+
+  ShmConf huge(1024 * 1024 * 64);
+  EXPECT_EQ(huge.arenas().size(), 6);
+  EXPECT_EQ(huge.block_buf_size(), huge.arenas().back().block_buf_size);
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
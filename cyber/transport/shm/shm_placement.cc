@@ -0,0 +1,126 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/transport/shm/shm_placement.h"
+
+#include <linux/mempolicy.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+namespace {
+
+constexpr uint64_t kDefaultHugePageSize = 2 * 1024 * 1024;
+
+std::string Env(const char* name) {
+  const char* value = std::getenv(name);
+  return value == nullptr ? std::string() : std::string(value);
+}
+
+uint64_t ReadHugePageSize() {
+  std::ifstream meminfo("/proc/meminfo");
+  std::string key;
+  uint64_t value = 0;
+  std::string unit;
+  while (meminfo >> key >> value) {
+    std::getline(meminfo, unit);
+    if (key == "Hugepagesize:") {
+      return value * 1024;
+    }
+  }
+  return kDefaultHugePageSize;
+}
+
+int CurrentNumaNode() {
+  unsigned int cpu = 0;
+  unsigned int node = 0;
+  if (syscall(SYS_getcpu, &cpu, &node, nullptr) < 0) {
+    AWARN << "getcpu failed: " << strerror(errno);
+    return -1;
+  }
+  return static_cast<int>(node);
+}
+
+}  // namespace
+
+bool ShmPlacement::UseHugePage() {
+  static const bool use_huge_page = Env("CYBER_SHM_HUGEPAGE") == "1";
+  return use_huge_page;
+}
+
+uint64_t ShmPlacement::HugePageSize() {
+  static const uint64_t huge_page_size = ReadHugePageSize();
+  return huge_page_size;
+}
+
+const std::string& ShmPlacement::HugeTlbfsDir() {
+  static const std::string dir = [] {
+    auto dir = Env("CYBER_SHM_HUGETLBFS");
+    return dir.empty() ? std::string("/dev/hugepages") : dir;
+  }();
+  return dir;
+}
+
+uint64_t ShmPlacement::AlignSize(uint64_t size) {
+  if (!UseHugePage()) {
+    return size;
+  }
+  auto page = HugePageSize();
+  return (size + page - 1) / page * page;
+}
+
+int ShmPlacement::NumaNode() {
+  static const std::string numa_node = Env("CYBER_SHM_NUMA_NODE");
+  if (numa_node.empty()) {
+    return -1;
+  }
+  if (numa_node == "auto") {
+    return CurrentNumaNode();
+  }
+  return std::atoi(numa_node.c_str());
+}
+
+bool ShmPlacement::BindToNumaNode(void* addr, uint64_t size, int node) {
+  if (node < 0) {
+    return true;
+  }
+  constexpr int kBitsPerMask = 8 * sizeof(unsigned long);  // NOLINT
+  std::vector<unsigned long> mask(node / kBitsPerMask + 1, 0);  // NOLINT
+  mask[node / kBitsPerMask] |= 1UL << (node % kBitsPerMask);
+  // preferred rather than bind, running out of memory on the node must not
+  // fault the writer
+  if (syscall(SYS_mbind, addr, size, MPOL_PREFERRED, mask.data(),
+              mask.size() * kBitsPerMask + 1, 0) < 0) {
+    AWARN << "mbind to numa node " << node << " failed: " << strerror(errno);
+    return false;
+  }
+  return true;
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
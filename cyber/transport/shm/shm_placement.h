@@ -0,0 +1,67 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_TRANSPORT_SHM_SHM_PLACEMENT_H_
+#define CYBER_TRANSPORT_SHM_SHM_PLACEMENT_H_
+
+#include <cstdint>
+#include <string>
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+/**
+ * @class ShmPlacement
+ * @brief Page size and NUMA placement of shared memory segments, read once
+ * from the environment. Writers and readers of a channel must agree on it.
+ *
+ *  CYBER_SHM_HUGEPAGE=1        back segments with huge pages, xsi segments
+ *                              use SHM_HUGETLB, posix segments are created
+ *                              in CYBER_SHM_HUGETLBFS (/dev/hugepages)
+ *  CYBER_SHM_NUMA_NODE=<n>     prefer memory of NUMA node n
+ *  CYBER_SHM_NUMA_NODE=auto    prefer the node of the cpu that creates the
+ *                              segment, i.e. follows the processor affinity
+ *                              the scheduler conf gives that thread
+ */
+class ShmPlacement {
+ public:
+  static bool UseHugePage();
+  static uint64_t HugePageSize();
+  static const std::string& HugeTlbfsDir();
+
+  /**
+   * @brief Round `size` up to the huge page size if huge pages are used.
+   */
+  static uint64_t AlignSize(uint64_t size);
+
+  /**
+   * @brief NUMA node new segments should be placed on, -1 if none.
+   */
+  static int NumaNode();
+
+  /**
+   * @brief Set the preferred NUMA node of a freshly mapped segment. Needs to
+   * be done before its pages are touched.
+   */
+  static bool BindToNumaNode(void* addr, uint64_t size, int node);
+};
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_TRANSPORT_SHM_SHM_PLACEMENT_H_
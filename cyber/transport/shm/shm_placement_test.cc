@@ -0,0 +1,52 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "cyber/transport/shm/shm_placement.h"
+
+#include <sys/mman.h>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+TEST(ShmPlacementTest, align_size) {
+  if (!ShmPlacement::UseHugePage()) {
+    EXPECT_EQ(ShmPlacement::AlignSize(12345), 12345);
+    return;
+  }
+  uint64_t page = ShmPlacement::HugePageSize();
+  ASSERT_GT(page, 0);
+  EXPECT_EQ(ShmPlacement::AlignSize(1), page);
+  EXPECT_EQ(ShmPlacement::AlignSize(page), page);
+  EXPECT_EQ(ShmPlacement::AlignSize(page + 1), 2 * page);
+}
+
+TEST(ShmPlacementTest, bind_to_numa_node) {
+  const uint64_t size = 4096 * 4;
+  void* addr = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  ASSERT_NE(addr, MAP_FAILED);
+  EXPECT_TRUE(ShmPlacement::BindToNumaNode(addr, size, -1));
+  EXPECT_TRUE(ShmPlacement::BindToNumaNode(addr, size, 0));
+  munmap(addr, size);
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
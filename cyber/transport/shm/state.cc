@@ -20,11 +20,46 @@ namespace apollo {
 namespace cyber {
 namespace transport {
 
+// the State of a segment has ShmConf::STATE_SIZE bytes
+static_assert(sizeof(State) <= 1024, "State does not fit in its space");
+
 State::State(const uint64_t& ceiling_msg_size)
     : ceiling_msg_size_(ceiling_msg_size) {}
 
 State::~State() {}
 
+bool State::SetReaderBusy(uint64_t reader_id, bool busy) {
+  if (reader_id == 0) {
+    return false;
+  }
+  if (!busy) {
+    for (auto& slot : busy_readers_) {
+      uint64_t expected = reader_id;
+      slot.compare_exchange_strong(expected, 0);
+    }
+    return true;
+  }
+  if (IsReaderBusy(reader_id)) {
+    return true;
+  }
+  for (auto& slot : busy_readers_) {
+    uint64_t expected = 0;
+    if (slot.compare_exchange_strong(expected, reader_id)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool State::IsReaderBusy(uint64_t reader_id) {
+  for (auto& slot : busy_readers_) {
+    if (slot.load(std::memory_order_acquire) == reader_id) {
+      return true;
+    }
+  }
+  return false;
+}
+
 }  // namespace transport
 }  // namespace cyber
 }  // namespace apollo
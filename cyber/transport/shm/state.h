@@ -52,11 +52,25 @@ class State {
   uint64_t ceiling_msg_size() { return ceiling_msg_size_.load(); }
   uint32_t reference_counts() { return reference_count_.load(); }
 
+  /**
+   * @brief Mark the latest-only readers of `reader_id` as busy processing a
+   * message, so that writers can skip serializing messages they would not
+   * take anyway. A reader crashing while busy leaves its slot taken, which
+   * is harmless as writers only look up the readers still in the topology.
+   *
+   * @return false if all the slots are taken
+   */
+  bool SetReaderBusy(uint64_t reader_id, bool busy);
+  bool IsReaderBusy(uint64_t reader_id);
+
+  static const uint32_t kMaxBusyReaders = 32;
+
  private:
   std::atomic<bool> need_remap_ = {false};
   std::atomic<uint32_t> seq_ = {0};
   std::atomic<uint32_t> reference_count_ = {0};
   std::atomic<uint64_t> ceiling_msg_size_;
+  std::atomic<uint64_t> busy_readers_[kMaxBusyReaders] = {};
 };
 
 }  // namespace transport
@@ -24,6 +24,7 @@
 #include "cyber/common/util.h"
 #include "cyber/transport/shm/segment.h"
 #include "cyber/transport/shm/shm_conf.h"
+#include "cyber/transport/shm/shm_placement.h"
 
 namespace apollo {
 namespace cyber {
@@ -44,7 +45,9 @@ bool XsiSegment::OpenOrCreate() {
   int retry = 0;
   int shmid = 0;
   while (retry < 2) {
-    shmid = shmget(key_, conf_.managed_shm_size(), 0644 | IPC_CREAT | IPC_EXCL);
+    shmid = shmget(key_, conf_.managed_shm_size(),
+                   0644 | IPC_CREAT | IPC_EXCL |
+                       (ShmPlacement::UseHugePage() ? SHM_HUGETLB : 0));
     if (shmid != -1) {
       break;
     }
@@ -74,6 +77,8 @@ bool XsiSegment::OpenOrCreate() {
     shmctl(shmid, IPC_RMID, 0);
     return false;
   }
+  ShmPlacement::BindToNumaNode(managed_shm_, conf_.managed_shm_size(),
+                               ShmPlacement::NumaNode());
 
   // create field state_
   state_ = new (managed_shm_) State(conf_.ceiling_msg_size());
@@ -105,8 +110,8 @@ bool XsiSegment::OpenOrCreate() {
   for (; i < conf_.block_num(); ++i) {
     uint8_t* addr =
         new (static_cast<char*>(managed_shm_) + sizeof(State) +
-             conf_.block_num() * sizeof(Block) + i * conf_.block_buf_size())
-            uint8_t[conf_.block_buf_size()];
+             conf_.block_num() * sizeof(Block) +
+             conf_.BlockBufOffset(i)) uint8_t[conf_.BlockBufSize(i)];
 
     std::lock_guard<std::mutex> _g(block_buf_lock_);
     block_buf_addrs_[i] = addr;
@@ -179,7 +184,7 @@ bool XsiSegment::OpenOnly() {
   for (; i < conf_.block_num(); ++i) {
     uint8_t* addr = reinterpret_cast<uint8_t*>(
         static_cast<char*>(managed_shm_) + sizeof(State) +
-        conf_.block_num() * sizeof(Block) + i * conf_.block_buf_size());
+        conf_.block_num() * sizeof(Block) + conf_.BlockBufOffset(i));
 
     if (addr == nullptr) {
       break;
@@ -14,6 +14,7 @@
  * limitations under the License.
  *****************************************************************************/
 
+#include <cstring>
 #include <memory>
 #include <string>
 #include <thread>
@@ -23,6 +24,7 @@
 #include "cyber/common/global_data.h"
 #include "cyber/common/util.h"
 #include "cyber/init.h"
+#include "cyber/message/raw_message_view.h"
 #include "cyber/proto/unit_test.pb.h"
 #include "cyber/transport/receiver/shm_receiver.h"
 #include "cyber/transport/transmitter/shm_transmitter.h"
@@ -149,6 +151,52 @@ TEST_F(ShmTransceiverTest, enable_and_disable) {
   EXPECT_EQ(msgs.size(), 0);
 }
 
+TEST_F(ShmTransceiverTest, loaned_block) {
+  using message::RawMessageView;
+  RoleAttributes attr;
+  attr.set_host_name(common::GlobalData::Instance()->HostName());
+  attr.set_host_ip(common::GlobalData::Instance()->HostIp());
+  attr.set_channel_name("shm_loan_channel");
+  attr.set_channel_id(common::Hash("shm_loan_channel"));
+
+  auto transmitter = std::make_shared<ShmTransmitter<RawMessageView>>(attr);
+  WritableBlock block;
+  // not enabled yet
+  EXPECT_FALSE(transmitter->AcquireBlock(16, &block));
+  transmitter->Enable();
+
+  std::vector<std::shared_ptr<RawMessageView>> views;
+  auto receiver = std::make_shared<ShmReceiver<RawMessageView>>(
+      attr, [&views](const std::shared_ptr<RawMessageView>& msg,
+                     const MessageInfo& msg_info, const RoleAttributes& attr) {
+        (void)msg_info;
+        (void)attr;
+        views.emplace_back(msg);
+      });
+  receiver->Enable();
+
+  const std::string payload("loaned_block");
+  ASSERT_TRUE(transmitter->AcquireBlock(payload.size(), &block));
+  memcpy(block.buf, payload.data(), payload.size());
+  EXPECT_TRUE(transmitter->TransmitBlock(block, payload.size()));
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+  ASSERT_EQ(views.size(), 1);
+  EXPECT_TRUE(views[0]->is_zero_copy());
+  EXPECT_EQ(std::string(views[0]->data(), views[0]->size()), payload);
+  EXPECT_EQ(transmitter->seq_num(), 1);
+
+  // a returned loan is not delivered
+  ASSERT_TRUE(transmitter->AcquireBlock(payload.size(), &block));
+  transmitter->ReleaseBlock(block);
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  EXPECT_EQ(views.size(), 1);
+
+  views.clear();
+  receiver->Disable();
+  transmitter->Disable();
+}
+
 }  // namespace transport
 }  // namespace cyber
 }  // namespace apollo
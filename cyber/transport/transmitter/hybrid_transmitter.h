@@ -28,12 +28,16 @@
 #include "cyber/common/global_data.h"
 #include "cyber/common/log.h"
 #include "cyber/common/types.h"
+#include "cyber/message/arena_pool.h"
+#include "cyber/message/message_traits.h"
 #include "cyber/proto/role_attributes.pb.h"
 #include "cyber/proto/transport_conf.pb.h"
 #include "cyber/task/task.h"
 #include "cyber/transport/message/history.h"
+#include "cyber/transport/rdma/rdma_conf.h"
 #include "cyber/transport/rtps/participant.h"
 #include "cyber/transport/transmitter/intra_transmitter.h"
+#include "cyber/transport/transmitter/rdma_transmitter.h"
 #include "cyber/transport/transmitter/rtps_transmitter.h"
 #include "cyber/transport/transmitter/shm_transmitter.h"
 #include "cyber/transport/transmitter/transmitter.h"
@@ -71,6 +75,11 @@ class HybridTransmitter : public Transmitter<M> {
 
   bool Transmit(const MessagePtr& msg, const MessageInfo& msg_info) override;
 
+  bool AcquireBlock(std::size_t msg_size, WritableBlock* block) override;
+  bool TransmitBlock(const WritableBlock& block, std::size_t msg_size,
+                     const MessageInfo& msg_info) override;
+  void ReleaseBlock(const WritableBlock& block) override;
+
  private:
   void InitMode();
   void ObtainConfig();
@@ -87,6 +96,10 @@ class HybridTransmitter : public Transmitter<M> {
   HistoryPtr history_;
   TransmitterMap transmitters_;
   ReceiverMap receivers_;
+  // readers on other hosts reached over RDMA rather than diff_host mode,
+  // see RdmaConf
+  std::shared_ptr<RdmaTransmitter<M>> rdma_transmitter_;
+  std::set<uint64_t> rdma_receivers_;
   std::mutex mutex_;
 
   CommunicationModePtr mode_;
@@ -118,6 +131,7 @@ HybridTransmitter<M>::~HybridTransmitter() {
 template <typename M>
 void HybridTransmitter<M>::Enable() {
   std::lock_guard<std::mutex> lock(mutex_);
+  this->enabled_ = true;
   for (auto& item : transmitters_) {
     item.second->Enable();
   }
@@ -126,6 +140,7 @@ void HybridTransmitter<M>::Enable() {
 template <typename M>
 void HybridTransmitter<M>::Disable() {
   std::lock_guard<std::mutex> lock(mutex_);
+  this->enabled_ = false;
   for (auto& item : transmitters_) {
     item.second->Disable();
   }
@@ -140,6 +155,12 @@ void HybridTransmitter<M>::Enable(const RoleAttributes& opposite_attr) {
 
   uint64_t id = opposite_attr.id();
   std::lock_guard<std::mutex> lock(mutex_);
+  if (relation == DIFF_HOST && rdma_transmitter_ != nullptr &&
+      rdma_transmitter_->Connect(opposite_attr)) {
+    rdma_receivers_.insert(id);
+    TransmitHistoryMsg(opposite_attr);
+    return;
+  }
   receivers_[mapping_table_[relation]].insert(id);
   transmitters_[mapping_table_[relation]]->Enable();
   TransmitHistoryMsg(opposite_attr);
@@ -154,6 +175,10 @@ void HybridTransmitter<M>::Disable(const RoleAttributes& opposite_attr) {
 
   uint64_t id = opposite_attr.id();
   std::lock_guard<std::mutex> lock(mutex_);
+  if (rdma_receivers_.erase(id) > 0) {
+    rdma_transmitter_->Disconnect(opposite_attr);
+    return;
+  }
   receivers_[mapping_table_[relation]].erase(id);
   if (receivers_[mapping_table_[relation]].empty()) {
     transmitters_[mapping_table_[relation]]->Disable();
@@ -165,12 +190,119 @@ bool HybridTransmitter<M>::Transmit(const MessagePtr& msg,
                                     const MessageInfo& msg_info) {
   std::lock_guard<std::mutex> lock(mutex_);
   history_->Add(msg, msg_info);
+
+  // Intra readers share `msg` itself. Every other transmitter serializes,
+  // so when more than one of them has readers the message is serialized
+  // once here and the bytes are handed to all of them.
+  std::vector<TransmitterPtr> serializing;
   for (auto& item : transmitters_) {
-    item.second->Transmit(msg, msg_info);
+    if (!this->enabled_ && receivers_[item.first].empty()) {
+      continue;
+    }
+    if (item.first == OptionalMode::INTRA) {
+      item.second->Transmit(msg, msg_info);
+    } else if (item.first == OptionalMode::SHM &&
+               item.second->AreReadersBusy(receivers_[item.first])) {
+      // every reader on the host only wants the latest message and is still
+      // busy with an earlier one, so it is not serialized for them
+      ChannelStatistics::Instance()->AddDropped(
+          this->attr_.channel_id(), receivers_[item.first].size());
+    } else {
+      serializing.emplace_back(item.second);
+    }
+  }
+  if (!rdma_receivers_.empty()) {
+    serializing.emplace_back(rdma_transmitter_);
+  }
+
+  if (serializing.size() == 1) {
+    serializing[0]->Transmit(msg, msg_info);
+  } else if (!serializing.empty()) {
+    std::string data;
+    if (!message::SerializeToString(*msg, &data)) {
+      AERROR << "serialize message failed.";
+      return false;
+    }
+    for (auto& transmitter : serializing) {
+      transmitter->TransmitSerialized(data, msg_info);
+    }
   }
   return true;
 }
 
+template <typename M>
+bool HybridTransmitter<M>::AcquireBlock(std::size_t msg_size,
+                                       WritableBlock* block) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = transmitters_.find(OptionalMode::SHM);
+  if (iter == transmitters_.end() || receivers_[OptionalMode::SHM].empty()) {
+    return false;
+  }
+  return iter->second->AcquireBlock(msg_size, block);
+}
+
+template <typename M>
+bool HybridTransmitter<M>::TransmitBlock(const WritableBlock& block,
+                                         std::size_t msg_size,
+                                         const MessageInfo& msg_info) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = transmitters_.find(OptionalMode::SHM);
+  if (iter == transmitters_.end()) {
+    return false;
+  }
+
+  // Intra readers and the history cache need a message object, build it
+  // from the block only if someone is actually going to consume it. The
+  // other transports take the serialized bytes as they are.
+  bool need_msg = this->attr_.qos_profile().durability() ==
+                  QosDurabilityPolicy::DURABILITY_TRANSIENT_LOCAL;
+  std::vector<TransmitterPtr> serializing;
+  for (auto& item : receivers_) {
+    if (item.first == OptionalMode::SHM || item.second.empty()) {
+      continue;
+    }
+    if (item.first == OptionalMode::INTRA) {
+      need_msg = true;
+    } else if (transmitters_.count(item.first) > 0) {
+      serializing.emplace_back(transmitters_[item.first]);
+    }
+  }
+  if (!rdma_receivers_.empty()) {
+    serializing.emplace_back(rdma_transmitter_);
+  }
+  if (need_msg) {
+    auto msg = message::NewMessage<M>(
+        message::ArenaPool::Instance()->IsEnabledForChannel(
+            this->attr_.channel_id()));
+    if (message::ParseFromArray(block.buf, static_cast<int>(msg_size),
+                                msg.get())) {
+      history_->Add(msg, msg_info);
+      auto intra = transmitters_.find(OptionalMode::INTRA);
+      if (intra != transmitters_.end()) {
+        intra->second->Transmit(msg, msg_info);
+      }
+    } else {
+      AERROR << "parse loaned block failed, intra readers miss it.";
+    }
+  }
+  if (!serializing.empty()) {
+    std::string data(reinterpret_cast<const char*>(block.buf), msg_size);
+    for (auto& transmitter : serializing) {
+      transmitter->TransmitSerialized(data, msg_info);
+    }
+  }
+  return iter->second->TransmitBlock(block, msg_size, msg_info);
+}
+
+template <typename M>
+void HybridTransmitter<M>::ReleaseBlock(const WritableBlock& block) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = transmitters_.find(OptionalMode::SHM);
+  if (iter != transmitters_.end()) {
+    iter->second->ReleaseBlock(block);
+  }
+}
+
 template <typename M>
 void HybridTransmitter<M>::InitMode() {
   mode_ = std::make_shared<proto::CommunicationMode>();
@@ -227,6 +359,12 @@ void HybridTransmitter<M>::InitTransmitters() {
         break;
     }
   }
+
+  if (RdmaConf::Enabled(this->attr_.channel_name()) &&
+      RdmaContext::Instance()->Ready()) {
+    rdma_transmitter_ = std::make_shared<RdmaTransmitter<M>>(this->attr_);
+    rdma_transmitter_->Enable();
+  }
 }
 
 template <typename M>
@@ -235,6 +373,11 @@ void HybridTransmitter<M>::ClearTransmitters() {
     item.second->Disable();
   }
   transmitters_.clear();
+  if (rdma_transmitter_ != nullptr) {
+    rdma_transmitter_->Disable();
+    rdma_transmitter_ = nullptr;
+  }
+  rdma_receivers_.clear();
 }
 
 template <typename M>
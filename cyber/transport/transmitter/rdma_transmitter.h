@@ -0,0 +1,226 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_TRANSPORT_TRANSMITTER_RDMA_TRANSMITTER_H_
+#define CYBER_TRANSPORT_TRANSMITTER_RDMA_TRANSMITTER_H_
+
+#include <cstring>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "cyber/common/log.h"
+#include "cyber/message/message_traits.h"
+#include "cyber/transport/rdma/rdma_conf.h"
+#include "cyber/transport/rdma/rdma_context.h"
+#include "cyber/transport/rdma/rdma_writer.h"
+#include "cyber/transport/transmitter/transmitter.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+/**
+ * @class RdmaTransmitter
+ * @brief Sends to the reader processes on other hosts it is connected to,
+ * with one RdmaWriter each. Readers it cannot connect to are left to RTPS.
+ */
+template <typename M>
+class RdmaTransmitter : public Transmitter<M> {
+ public:
+  using MessagePtr = std::shared_ptr<M>;
+
+  explicit RdmaTransmitter(const RoleAttributes& attr);
+  virtual ~RdmaTransmitter();
+
+  void Enable() override;
+  void Disable() override;
+
+  /**
+   * @brief Connect to the process of `opposite_attr`, a reader on another
+   * host. Its readers of the channel share the connection.
+   */
+  bool Connect(const RoleAttributes& opposite_attr);
+  void Disconnect(const RoleAttributes& opposite_attr);
+
+  bool Transmit(const MessagePtr& msg, const MessageInfo& msg_info) override;
+
+  bool TransmitSerialized(const std::string& data,
+                          const MessageInfo& msg_info) override;
+
+ private:
+  struct Peer {
+    RoleAttributes attr;
+    RdmaWriterPtr writer;
+  };
+
+  RdmaWriterPtr NewWriter(const RoleAttributes& opposite_attr,
+                          uint64_t block_size);
+  // the writer of `peer` with blocks that take `msg_size` bytes
+  RdmaWriter* WriterFor(Peer* peer, std::size_t msg_size);
+  bool Write(RdmaWriter* writer, const M& msg, std::size_t msg_size,
+             const MessageInfo& msg_info);
+
+  // key: reader id
+  std::unordered_map<uint64_t, Peer> peers_;
+};
+
+template <typename M>
+RdmaTransmitter<M>::RdmaTransmitter(const RoleAttributes& attr)
+    : Transmitter<M>(attr) {}
+
+template <typename M>
+RdmaTransmitter<M>::~RdmaTransmitter() {
+  Disable();
+}
+
+template <typename M>
+void RdmaTransmitter<M>::Enable() {
+  this->enabled_ = RdmaContext::Instance()->Ready();
+}
+
+template <typename M>
+void RdmaTransmitter<M>::Disable() {
+  peers_.clear();
+  this->enabled_ = false;
+}
+
+template <typename M>
+bool RdmaTransmitter<M>::Connect(const RoleAttributes& opposite_attr) {
+  if (!this->enabled_) {
+    return false;
+  }
+  auto writer = NewWriter(opposite_attr, RdmaConf::BlockSize());
+  if (writer == nullptr) {
+    return false;
+  }
+  peers_[opposite_attr.id()] = {opposite_attr, writer};
+  AINFO << "channel " << this->attr_.channel_name() << " goes over rdma to "
+        << opposite_attr.host_ip() << " process "
+        << opposite_attr.process_id();
+  return true;
+}
+
+template <typename M>
+void RdmaTransmitter<M>::Disconnect(const RoleAttributes& opposite_attr) {
+  peers_.erase(opposite_attr.id());
+}
+
+template <typename M>
+RdmaWriterPtr RdmaTransmitter<M>::NewWriter(
+    const RoleAttributes& opposite_attr, uint64_t block_size) {
+  RdmaRequest request;
+  request.channel_id = this->attr_.channel_id();
+  request.writer_id = this->attr_.id();
+  request.reader_id = opposite_attr.id();
+  request.process_id = static_cast<uint64_t>(opposite_attr.process_id());
+  request.block_size = block_size;
+  auto writer = std::make_shared<RdmaWriter>();
+  if (!writer->Connect(opposite_attr.host_ip(), request)) {
+    return nullptr;
+  }
+  return writer;
+}
+
+template <typename M>
+RdmaWriter* RdmaTransmitter<M>::WriterFor(Peer* peer, std::size_t msg_size) {
+  if (peer->writer->Fits(msg_size)) {
+    return peer->writer.get();
+  }
+  // like a shm segment is remapped, the blocks are recreated larger
+  uint64_t block_size = peer->writer->block_size();
+  while (block_size < msg_size + sizeof(RdmaBlockHeader) + MessageInfo::kSize) {
+    block_size *= 2;
+  }
+  auto writer = NewWriter(peer->attr, block_size);
+  if (writer == nullptr) {
+    AERROR << "grow rdma blocks of channel " << this->attr_.channel_name()
+           << " to " << block_size << " bytes failed.";
+    return nullptr;
+  }
+  peer->writer = writer;
+  return writer.get();
+}
+
+template <typename M>
+bool RdmaTransmitter<M>::Transmit(const MessagePtr& msg,
+                                  const MessageInfo& msg_info) {
+  if (!this->enabled_ || peers_.empty()) {
+    ADEBUG << "not enable.";
+    return false;
+  }
+  // serialized straight into the registered block of the only reader,
+  // otherwise once for all of them
+  std::size_t msg_size = message::ByteSize(*msg);
+  if (peers_.size() == 1) {
+    auto writer = WriterFor(&peers_.begin()->second, msg_size);
+    return writer != nullptr && Write(writer, *msg, msg_size, msg_info);
+  }
+  std::string data;
+  if (!message::SerializeToString(*msg, &data)) {
+    AERROR << "serialize message failed.";
+    return false;
+  }
+  return TransmitSerialized(data, msg_info);
+}
+
+template <typename M>
+bool RdmaTransmitter<M>::Write(RdmaWriter* writer, const M& msg,
+                               std::size_t msg_size,
+                               const MessageInfo& msg_info) {
+  char* buf = writer->Acquire(msg_size);
+  if (buf == nullptr) {
+    ChannelStatistics::Instance()->AddDropped(this->attr_.channel_id(), 1);
+    return false;
+  }
+  if (!message::SerializeToArray(msg, buf, static_cast<int>(msg_size))) {
+    AERROR << "serialize to array failed.";
+    return false;
+  }
+  if (!writer->Post(msg_size, msg_info)) {
+    return false;
+  }
+  ChannelStatistics::Instance()->AddTransmitBytes(this->attr_.channel_id(),
+                                                  msg_size);
+  return true;
+}
+
+template <typename M>
+bool RdmaTransmitter<M>::TransmitSerialized(const std::string& data,
+                                            const MessageInfo& msg_info) {
+  if (!this->enabled_) {
+    ADEBUG << "not enable.";
+    return false;
+  }
+  bool result = true;
+  for (auto& item : peers_) {
+    auto writer = WriterFor(&item.second, data.size());
+    if (writer == nullptr || !writer->Write(data, msg_info)) {
+      ChannelStatistics::Instance()->AddDropped(this->attr_.channel_id(), 1);
+      result = false;
+      continue;
+    }
+    ChannelStatistics::Instance()->AddTransmitBytes(this->attr_.channel_id(),
+                                                    data.size());
+  }
+  return result;
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_TRANSPORT_TRANSMITTER_RDMA_TRANSMITTER_H_
@@ -48,8 +48,12 @@ class RtpsTransmitter : public Transmitter<M> {
 
   bool Transmit(const MessagePtr& msg, const MessageInfo& msg_info) override;
 
+  bool TransmitSerialized(const std::string& data,
+                          const MessageInfo& msg_info) override;
+
  private:
   bool Transmit(const M& msg, const MessageInfo& msg_info);
+  bool Write(UnderlayMessage* m, const MessageInfo& msg_info);
 
   ParticipantPtr participant_;
   eprosima::fastrtps::Publisher* publisher_;
@@ -105,7 +109,25 @@ bool RtpsTransmitter<M>::Transmit(const M& msg, const MessageInfo& msg_info) {
 
   UnderlayMessage m;
   RETURN_VAL_IF(!message::SerializeToString(msg, &m.data()), false);
+  return Write(&m, msg_info);
+}
+
+template <typename M>
+bool RtpsTransmitter<M>::TransmitSerialized(const std::string& data,
+                                            const MessageInfo& msg_info) {
+  if (!this->enabled_) {
+    ADEBUG << "not enable.";
+    return false;
+  }
+
+  UnderlayMessage m;
+  m.data(data);
+  return Write(&m, msg_info);
+}
 
+template <typename M>
+bool RtpsTransmitter<M>::Write(UnderlayMessage* m,
+                               const MessageInfo& msg_info) {
   eprosima::fastrtps::rtps::WriteParams wparams;
 
   char* ptr =
@@ -122,7 +144,12 @@ bool RtpsTransmitter<M>::Transmit(const M& msg, const MessageInfo& msg_info) {
   if (participant_->is_shutdown()) {
     return false;
   }
-  return publisher_->write(reinterpret_cast<void*>(&m), wparams);
+  if (!publisher_->write(reinterpret_cast<void*>(m), wparams)) {
+    return false;
+  }
+  ChannelStatistics::Instance()->AddTransmitBytes(this->attr_.channel_id(),
+                                                  m->data().size());
+  return true;
 }
 
 }  // namespace transport
@@ -20,6 +20,7 @@
 #include <cstring>
 #include <iostream>
 #include <memory>
+#include <set>
 #include <string>
 
 #include "cyber/common/global_data.h"
@@ -48,8 +49,20 @@ class ShmTransmitter : public Transmitter<M> {
 
   bool Transmit(const MessagePtr& msg, const MessageInfo& msg_info) override;
 
+  bool AcquireBlock(std::size_t msg_size, WritableBlock* block) override;
+  bool TransmitBlock(const WritableBlock& block, std::size_t msg_size,
+                     const MessageInfo& msg_info) override;
+  void ReleaseBlock(const WritableBlock& block) override;
+
+  bool TransmitSerialized(const std::string& data,
+                          const MessageInfo& msg_info) override;
+
+  bool AreReadersBusy(const std::set<uint64_t>& reader_ids) override;
+
  private:
   bool Transmit(const M& msg, const MessageInfo& msg_info);
+  bool Publish(const WritableBlock& wb, std::size_t msg_size,
+               const MessageInfo& msg_info);
 
   SegmentPtr segment_;
   uint64_t channel_id_;
@@ -117,6 +130,68 @@ bool ShmTransmitter<M>::Transmit(const M& msg, const MessageInfo& msg_info) {
     segment_->ReleaseWrittenBlock(wb);
     return false;
   }
+  return Publish(wb, msg_size, msg_info);
+}
+
+template <typename M>
+bool ShmTransmitter<M>::AcquireBlock(std::size_t msg_size,
+                                     WritableBlock* block) {
+  RETURN_VAL_IF_NULL(block, false);
+  if (!this->enabled_) {
+    ADEBUG << "not enable.";
+    return false;
+  }
+
+  if (!segment_->AcquireBlockToWrite(msg_size, block)) {
+    AERROR << "acquire block failed.";
+    return false;
+  }
+  return true;
+}
+
+template <typename M>
+bool ShmTransmitter<M>::TransmitBlock(const WritableBlock& block,
+                                      std::size_t msg_size,
+                                      const MessageInfo& msg_info) {
+  if (!this->enabled_) {
+    ADEBUG << "not enable.";
+    return false;
+  }
+  return Publish(block, msg_size, msg_info);
+}
+
+template <typename M>
+void ShmTransmitter<M>::ReleaseBlock(const WritableBlock& block) {
+  if (segment_ != nullptr) {
+    segment_->ReleaseWrittenBlock(block);
+  }
+}
+
+template <typename M>
+bool ShmTransmitter<M>::TransmitSerialized(const std::string& data,
+                                           const MessageInfo& msg_info) {
+  if (!this->enabled_) {
+    ADEBUG << "not enable.";
+    return false;
+  }
+
+  WritableBlock wb;
+  if (!segment_->AcquireBlockToWrite(data.size(), &wb)) {
+    AERROR << "acquire block failed.";
+    return false;
+  }
+  memcpy(wb.buf, data.data(), data.size());
+  return Publish(wb, data.size(), msg_info);
+}
+
+template <typename M>
+bool ShmTransmitter<M>::AreReadersBusy(const std::set<uint64_t>& reader_ids) {
+  return this->enabled_ && segment_->AreReadersBusy(reader_ids);
+}
+
+template <typename M>
+bool ShmTransmitter<M>::Publish(const WritableBlock& wb, std::size_t msg_size,
+                                const MessageInfo& msg_info) {
   wb.block->set_msg_size(msg_size);
 
   char* msg_info_addr = reinterpret_cast<char*>(wb.buf) + msg_size;
@@ -133,7 +208,11 @@ bool ShmTransmitter<M>::Transmit(const M& msg, const MessageInfo& msg_info) {
   ADEBUG << "Writing sharedmem message: "
          << common::GlobalData::GetChannelById(channel_id_)
          << " to block: " << wb.index;
-  return notifier_->Notify(readable_info);
+  if (!notifier_->Notify(readable_info)) {
+    return false;
+  }
+  ChannelStatistics::Instance()->AddTransmitBytes(channel_id_, msg_size);
+  return true;
 }
 
 }  // namespace transport
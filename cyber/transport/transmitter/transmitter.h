@@ -17,13 +17,18 @@
 #ifndef CYBER_TRANSPORT_TRANSMITTER_TRANSMITTER_H_
 #define CYBER_TRANSPORT_TRANSMITTER_TRANSMITTER_H_
 
+#include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <set>
 #include <string>
 
 #include "cyber/event/perf_event_cache.h"
+#include "cyber/time/time.h"
+#include "cyber/transport/common/channel_statistics.h"
 #include "cyber/transport/common/endpoint.h"
 #include "cyber/transport/message/message_info.h"
+#include "cyber/transport/shm/segment.h"
 
 namespace apollo {
 namespace cyber {
@@ -49,6 +54,24 @@ class Transmitter : public Endpoint {
   virtual bool Transmit(const MessagePtr& msg);
   virtual bool Transmit(const MessagePtr& msg, const MessageInfo& msg_info) = 0;
 
+  // Zero-copy path: only transmitters backed by shared memory hand out
+  // blocks, the others keep the defaults and report the loan as unavailable.
+  virtual bool AcquireBlock(std::size_t msg_size, WritableBlock* block);
+  bool TransmitBlock(const WritableBlock& block, std::size_t msg_size);
+  virtual bool TransmitBlock(const WritableBlock& block, std::size_t msg_size,
+                             const MessageInfo& msg_info);
+  virtual void ReleaseBlock(const WritableBlock& block);
+
+  // Send bytes someone already serialized, so a message going out through
+  // several transports is serialized once. Only serializing transmitters
+  // implement it.
+  virtual bool TransmitSerialized(const std::string& data,
+                                  const MessageInfo& msg_info);
+
+  // Whether all of `reader_ids` are latest-only readers busy with an earlier
+  // message, see BusyReaders. Only shared memory transmitters can tell.
+  virtual bool AreReadersBusy(const std::set<uint64_t>& reader_ids);
+
   uint64_t NextSeqNum() { return ++seq_num_; }
 
   uint64_t seq_num() const { return seq_num_; }
@@ -71,11 +94,62 @@ Transmitter<M>::~Transmitter() {}
 template <typename M>
 bool Transmitter<M>::Transmit(const MessagePtr& msg) {
   msg_info_.set_seq_num(NextSeqNum());
+  msg_info_.set_send_time(Time::Now().ToNanosecond());
   PerfEventCache::Instance()->AddTransportEvent(
       TransPerf::TRANSMIT_BEGIN, attr_.channel_id(), msg_info_.seq_num());
+  // bytes are added by the transports that serialize
+  ChannelStatistics::Instance()->AddTransmit(attr_.channel_id(), 0);
   return Transmit(msg, msg_info_);
 }
 
+template <typename M>
+bool Transmitter<M>::AcquireBlock(std::size_t msg_size, WritableBlock* block) {
+  (void)msg_size;
+  (void)block;
+  return false;
+}
+
+template <typename M>
+bool Transmitter<M>::TransmitBlock(const WritableBlock& block,
+                                   std::size_t msg_size) {
+  msg_info_.set_seq_num(NextSeqNum());
+  msg_info_.set_send_time(Time::Now().ToNanosecond());
+  PerfEventCache::Instance()->AddTransportEvent(
+      TransPerf::TRANSMIT_BEGIN, attr_.channel_id(), msg_info_.seq_num());
+  // bytes are added by the transports that serialize
+  ChannelStatistics::Instance()->AddTransmit(attr_.channel_id(), 0);
+  return TransmitBlock(block, msg_size, msg_info_);
+}
+
+template <typename M>
+bool Transmitter<M>::TransmitBlock(const WritableBlock& block,
+                                   std::size_t msg_size,
+                                   const MessageInfo& msg_info) {
+  (void)block;
+  (void)msg_size;
+  (void)msg_info;
+  return false;
+}
+
+template <typename M>
+void Transmitter<M>::ReleaseBlock(const WritableBlock& block) {
+  (void)block;
+}
+
+template <typename M>
+bool Transmitter<M>::TransmitSerialized(const std::string& data,
+                                        const MessageInfo& msg_info) {
+  (void)data;
+  (void)msg_info;
+  return false;
+}
+
+template <typename M>
+bool Transmitter<M>::AreReadersBusy(const std::set<uint64_t>& reader_ids) {
+  (void)reader_ids;
+  return false;
+}
+
 template <typename M>
 void Transmitter<M>::Enable(const RoleAttributes& opposite_attr) {
   (void)opposite_attr;
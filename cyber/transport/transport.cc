@@ -41,6 +41,8 @@ void Transport::Shutdown() {
   intra_dispatcher_->Shutdown();
   shm_dispatcher_->Shutdown();
   rtps_dispatcher_->Shutdown();
+  // only processes reading channels sent over rdma start it
+  RdmaDispatcher::CleanUp();
   notifier_->Shutdown();
 
   if (participant_ != nullptr) {
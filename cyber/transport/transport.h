@@ -25,6 +25,7 @@
 
 #include "cyber/common/macros.h"
 #include "cyber/transport/dispatcher/intra_dispatcher.h"
+#include "cyber/transport/dispatcher/rdma_dispatcher.h"
 #include "cyber/transport/dispatcher/rtps_dispatcher.h"
 #include "cyber/transport/dispatcher/shm_dispatcher.h"
 #include "cyber/transport/qos/qos_profile_conf.h"
@@ -42,33 +42,71 @@ void AudioInfo::InsertChannelData(const std::size_t index,
                                   const ChannelData& channel_data,
                                   const MicrophoneConfig& microphone_config) {
   while (index >= signals_.size()) {
-    signals_.push_back(std::deque<double>());
+    signals_.push_back(ChannelSignal());
+  }
+  ChannelSignal& signal = signals_[index];
+  std::size_t max_signal_length = static_cast<std::size_t>(
+      FLAGS_cache_signal_time * microphone_config.sample_rate());
+  if (signal.samples.size() != max_signal_length) {
+    // Keeps the latest samples when the capacity changes.
+    std::vector<double> samples(max_signal_length);
+    signal.size = std::min(signal.size, max_signal_length);
+    for (std::size_t i = 0; i < signal.size; ++i) {
+      samples[i] = signal.samples[(signal.start + signal.samples.size() -
+                                   signal.size + i) %
+                                  signal.samples.size()];
+    }
+    signal.samples.swap(samples);
+    signal.start = 0;
+  }
+  if (max_signal_length == 0) {
+    return;
   }
   int width = microphone_config.sample_width();
   const std::string& data = channel_data.data();
   for (std::size_t i = 0; i < data.length(); i += width) {
-    int16_t signal = ((int16_t(data[i + 1])) << 8) | (0x00ff & data[i]);
-    signals_[index].push_back(static_cast<double>(signal));
-  }
-  std::size_t max_signal_length = static_cast<std::size_t>(
-      FLAGS_cache_signal_time * microphone_config.sample_rate());
-  while (signals_[index].size() > max_signal_length) {
-    signals_[index].pop_front();
+    int16_t sample = ((int16_t(data[i + 1])) << 8) | (0x00ff & data[i]);
+    if (signal.size < max_signal_length) {
+      signal.samples[(signal.start + signal.size) % max_signal_length] =
+          static_cast<double>(sample);
+      ++signal.size;
+    } else {
+      signal.samples[signal.start] = static_cast<double>(sample);
+      signal.start = (signal.start + 1) % max_signal_length;
+    }
   }
 }
 
 std::vector<std::vector<double>> AudioInfo::GetSignals(
     const int signal_length) {
   std::vector<std::vector<double>> signals;
+  GetSignals(signal_length, &signals);
+  return signals;
+}
+
+void AudioInfo::GetSignals(const int signal_length,
+                           std::vector<std::vector<double>>* signals) const {
+  signals->resize(signals_.size());
   for (std::size_t i = 0; i < signals_.size(); ++i) {
-    int start_index = static_cast<int>(signals_[i].size()) - signal_length;
-    start_index = std::max(0, start_index);
-    std::deque<double>::iterator iter = signals_[i].begin();
-    iter += start_index;
-    std::vector<double> signal(iter, signals_[i].end());
-    signals.push_back(signal);
+    const ChannelSignal& signal = signals_[i];
+    const std::size_t length =
+        std::min(signal.size, static_cast<std::size_t>(
+                                  std::max(0, signal_length)));
+    auto& output = (*signals)[i];
+    output.resize(length);
+    if (length == 0) {
+      continue;
+    }
+    // The latest samples may wrap around the end of the ring buffer.
+    const std::size_t capacity = signal.samples.size();
+    const std::size_t first =
+        (signal.start + signal.size - length) % capacity;
+    const std::size_t head = std::min(length, capacity - first);
+    std::copy(signal.samples.begin() + first,
+              signal.samples.begin() + first + head, output.begin());
+    std::copy(signal.samples.begin(), signal.samples.begin() + length - head,
+              output.begin() + head);
   }
-  return signals;
 }
 
 }  // namespace audio
@@ -14,7 +14,6 @@
  * limitations under the License.
  *****************************************************************************/
 
-#include <deque>
 #include <memory>
 #include <string>
 #include <vector>
@@ -34,14 +33,27 @@ class AudioInfo {
 
   std::vector<std::vector<double>> GetSignals(const int signal_length);
 
+  // Copies the latest signal_length samples of every channel, or all of them
+  // if there are fewer, into signals, reusing its storage.
+  void GetSignals(const int signal_length,
+                  std::vector<std::vector<double>>* signals) const;
+
  private:
+  // The latest samples of a channel, in a ring buffer of fixed capacity.
+  struct ChannelSignal {
+    std::vector<double> samples;
+    std::size_t start = 0;
+    std::size_t size = 0;
+  };
+
+
   void InsertChannelData(
       const std::size_t index,
       const apollo::drivers::microphone::config::ChannelData& channel_data,
       const apollo::drivers::microphone::config::MicrophoneConfig&
           microphone_config);
 
-  std::vector<std::deque<double>> signals_;
+  std::vector<ChannelSignal> signals_;
 };
 
 }  // namespace audio
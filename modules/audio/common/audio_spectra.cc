@@ -0,0 +1,99 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/audio/common/audio_spectra.h"
+
+#include <fftw3.h>
+
+#include <algorithm>
+#include <mutex>
+#include <unordered_map>
+
+namespace apollo {
+namespace audio {
+namespace {
+
+// Making a plan is much slower than executing it, and is not thread safe, so
+// the plans are made once per length and kept. They are executed on the
+// arrays of the caller, hence FFTW_UNALIGNED.
+fftw_plan GetPlan(const int n, const bool forward) {
+  static std::mutex mutex;
+  static std::unordered_map<int, fftw_plan> forward_plans;
+  static std::unordered_map<int, fftw_plan> backward_plans;
+  std::lock_guard<std::mutex> lock(mutex);
+  auto& plans = forward ? forward_plans : backward_plans;
+  auto iter = plans.find(n);
+  if (iter != plans.end()) {
+    return iter->second;
+  }
+  double* real = fftw_alloc_real(n);
+  fftw_complex* complex = fftw_alloc_complex(n / 2 + 1);
+  const unsigned flags = FFTW_ESTIMATE | FFTW_UNALIGNED;
+  fftw_plan plan = forward
+                       ? fftw_plan_dft_r2c_1d(n, real, complex, flags)
+                       : fftw_plan_dft_c2r_1d(n, complex, real, flags);
+  fftw_free(complex);
+  fftw_free(real);
+  plans.emplace(n, plan);
+  return plan;
+}
+
+}  // namespace
+
+void AudioSpectra::Compute(const std::vector<std::vector<double>>& signals) {
+  signal_length_ =
+      signals.empty() ? 0 : static_cast<int>(signals.front().size());
+  spectra_.resize(signals.size());
+  if (signal_length_ == 0) {
+    for (auto& spectrum : spectra_) {
+      spectrum.clear();
+    }
+    return;
+  }
+  const int n = 2 * signal_length_;
+  fftw_plan plan = GetPlan(n, true);
+  std::vector<double> padded(n);
+  for (std::size_t i = 0; i < signals.size(); ++i) {
+    const int length = std::min(signal_length_,
+                                static_cast<int>(signals[i].size()));
+    std::copy(signals[i].begin(), signals[i].begin() + length, padded.begin());
+    std::fill(padded.begin() + length, padded.end(), 0.0);
+    // std::complex<double> has the layout of fftw_complex.
+    spectra_[i].resize(signal_length_ + 1);
+    fftw_execute_dft_r2c(
+        plan, padded.data(),
+        reinterpret_cast<fftw_complex*>(spectra_[i].data()));
+  }
+}
+
+void AudioSpectra::InverseTransform(
+    const std::vector<std::complex<double>>& spectrum,
+    std::vector<double>* signal) const {
+  const int n = 2 * signal_length_;
+  signal->resize(n);
+  if (n == 0) {
+    return;
+  }
+  // The transform overwrites its input.
+  std::vector<std::complex<double>> input(spectrum);
+  input.resize(signal_length_ + 1);
+  fftw_execute_dft_c2r(GetPlan(n, false),
+                       reinterpret_cast<fftw_complex*>(input.data()),
+                       signal->data());
+}
+
+}  // namespace audio
+}  // namespace apollo
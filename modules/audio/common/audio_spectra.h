@@ -0,0 +1,63 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include <complex>
+#include <vector>
+
+namespace apollo {
+namespace audio {
+
+/**
+ * @brief The spectra of the signal windows of all channels, computed once per
+ * window and shared by the detections.
+ *
+ * The signals are zero padded to twice their length, as GCC-PHAT needs, and
+ * only the non-negative frequencies are kept. Bin 2 * k of a padded spectrum
+ * is bin k of the spectrum of the signal itself. The FFTW plans are made once
+ * per length and reused.
+ */
+class AudioSpectra {
+ public:
+  AudioSpectra() = default;
+
+  void Compute(const std::vector<std::vector<double>>& signals);
+
+  std::size_t num_channels() const { return spectra_.size(); }
+
+  // The length of the signals, before padding.
+  int signal_length() const { return signal_length_; }
+
+  // The signal_length() + 1 bins of a channel, bin k being the frequency
+  // k / (2 * signal_length()) of the sample rate.
+  const std::vector<std::complex<double>>& spectrum(
+      const std::size_t channel) const {
+    return spectra_[channel];
+  }
+
+  // Transforms a spectrum like the ones above back to a signal of twice
+  // signal_length(), without normalization.
+  void InverseTransform(const std::vector<std::complex<double>>& spectrum,
+                        std::vector<double>* signal) const;
+
+ private:
+  int signal_length_ = 0;
+  std::vector<std::vector<std::complex<double>>> spectra_;
+};
+
+}  // namespace audio
+}  // namespace apollo
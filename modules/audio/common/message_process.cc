@@ -16,6 +16,8 @@
 
 #include "modules/audio/common/message_process.h"
 
+#include <vector>
+
 namespace apollo {
 namespace audio {
 
@@ -30,20 +32,24 @@ void MessageProcess::OnMicrophone(
     SirenDetection* siren_detection,
     AudioDetection* audio_detection) {
   audio_info->Insert(audio_data);
+  // The chunk window and its spectra are shared by the direction and the
+  // moving detections.
+  std::vector<std::vector<double>> signals;
+  audio_info->GetSignals(audio_data.microphone_config().chunk(), &signals);
+  AudioSpectra spectra;
+  spectra.Compute(signals);
   auto direction_result =
       direction_detection->EstimateSoundSource(
-          audio_info->GetSignals(audio_data.microphone_config().chunk()),
-          respeaker_extrinsics_file,
+          spectra, respeaker_extrinsics_file,
           audio_data.microphone_config().sample_rate(),
           audio_data.microphone_config().mic_distance());
   *(audio_detection->mutable_position()) = direction_result.first;
   audio_detection->set_source_degree(direction_result.second);
 
-  bool is_siren = siren_detection->Evaluate(audio_info->GetSignals(72000));
+  audio_info->GetSignals(72000, &signals);
+  bool is_siren = siren_detection->Evaluate(signals);
   audio_detection->set_is_siren(is_siren);
-  auto signals =
-      audio_info->GetSignals(audio_data.microphone_config().chunk());
-  MovingResult moving_result = moving_detection->Detect(signals);
+  MovingResult moving_result = moving_detection->Detect(spectra);
   audio_detection->set_moving_result(moving_result);
 }
 
@@ -19,6 +19,7 @@
 #include <string>
 
 #include "modules/audio/common/audio_info.h"
+#include "modules/audio/common/audio_spectra.h"
 #include "modules/audio/inference/direction_detection.h"
 #include "modules/audio/inference/moving_detection.h"
 #include "modules/audio/inference/siren_detection.h"
@@ -22,8 +22,6 @@
 namespace apollo {
 namespace audio {
 
-using torch::indexing::None;
-using torch::indexing::Slice;
 using apollo::common::math::NormalizeAngle;
 
 DirectionDetection::DirectionDetection() {}
@@ -31,15 +29,13 @@ DirectionDetection::DirectionDetection() {}
 DirectionDetection::~DirectionDetection() {}
 
 std::pair<Point3D, double> DirectionDetection::EstimateSoundSource(
-    std::vector<std::vector<double>>&& channels_vec,
-    const std::string& respeaker_extrinsic_file, const int sample_rate,
-    const double mic_distance) {
+    const AudioSpectra& spectra, const std::string& respeaker_extrinsic_file,
+    const int sample_rate, const double mic_distance) {
   if (!respeaker2imu_ptr_.get()) {
     respeaker2imu_ptr_.reset(new Eigen::Matrix4d);
     LoadExtrinsics(respeaker_extrinsic_file, respeaker2imu_ptr_.get());
   }
-  double degree =
-      EstimateDirection(move(channels_vec), sample_rate, mic_distance);
+  double degree = EstimateDirection(spectra, sample_rate, mic_distance);
   Eigen::Vector4d source_position(kDistance * sin(degree),
                                   kDistance * cos(degree), 0, 1);
   source_position = (*respeaker2imu_ptr_) * source_position;
@@ -52,22 +48,20 @@ std::pair<Point3D, double> DirectionDetection::EstimateSoundSource(
   return {source_position_p3d, degree};
 }
 
-double DirectionDetection::EstimateDirection(
-    std::vector<std::vector<double>>&& channels_vec, const int sample_rate,
-    const double mic_distance) {
-  std::vector<torch::Tensor> channels_ts;
-  auto options = torch::TensorOptions().dtype(torch::kFloat64);
-  int size = static_cast<int>(channels_vec[0].size());
-  for (auto& signal : channels_vec) {
-    channels_ts.push_back(torch::from_blob(signal.data(), {size}, options));
+double DirectionDetection::EstimateDirection(const AudioSpectra& spectra,
+                                             const int sample_rate,
+                                             const double mic_distance) {
+  if (spectra.num_channels() < 4) {
+    AERROR << "Got " << spectra.num_channels() << " channels, expected 4";
+    return 0.0;
   }
 
   double tau0, tau1;
   double theta0, theta1;
   const double max_tau = mic_distance / kSoundSpeed;
-  tau0 = GccPhat(channels_ts[0], channels_ts[2], sample_rate, max_tau, 1);
+  tau0 = GccPhat(spectra, 0, 2, sample_rate, max_tau);
   theta0 = asin(tau0 / max_tau) * 180 / M_PI;
-  tau1 = GccPhat(channels_ts[1], channels_ts[3], sample_rate, max_tau, 1);
+  tau1 = GccPhat(spectra, 1, 3, sample_rate, max_tau);
   theta1 = asin(tau1 / max_tau) * 180 / M_PI;
 
   int best_guess = 0;
@@ -127,53 +121,42 @@ bool DirectionDetection::LoadExtrinsics(const std::string& yaml_file,
   return true;
 }
 
-double DirectionDetection::GccPhat(const torch::Tensor& sig,
-                                   const torch::Tensor& refsig, int fs,
-                                   double max_tau, int interp) {
-  const int n_sig = sig.size(0), n_refsig = refsig.size(0),
-            n = n_sig + n_refsig;
-  torch::Tensor psig = at::constant_pad_nd(sig, {0, n_refsig}, 0);
-  torch::Tensor prefsig = at::constant_pad_nd(refsig, {0, n_sig}, 0);
-  psig = at::rfft(psig, 1, false, true);
-  prefsig = at::rfft(prefsig, 1, false, true);
-
-  ConjugateTensor(&prefsig);
-  torch::Tensor r = ComplexMultiply(psig, prefsig);
-  torch::Tensor cc =
-      at::irfft(r / ComplexAbsolute(r), 1, false, true, {interp * n});
-  int max_shift = static_cast<int>(interp * n / 2);
+double DirectionDetection::GccPhat(const AudioSpectra& spectra,
+                                   const std::size_t channel,
+                                   const std::size_t ref_channel, int fs,
+                                   double max_tau) {
+  const auto& sig = spectra.spectrum(channel);
+  const auto& refsig = spectra.spectrum(ref_channel);
+  std::vector<std::complex<double>> r(sig.size());
+  for (std::size_t i = 0; i < r.size(); ++i) {
+    r[i] = sig[i] * std::conj(refsig[i]);
+    const double magnitude = std::abs(r[i]);
+    r[i] = magnitude > 0.0 ? r[i] / magnitude : 0.0;
+  }
+  std::vector<double> cc;
+  spectra.InverseTransform(r, &cc);
+  const int n = static_cast<int>(cc.size());
+  if (n == 0) {
+    return 0.0;
+  }
+  int max_shift = n / 2;
   if (max_tau != 0)
-    max_shift = std::min(static_cast<int>(interp * fs * max_tau), max_shift);
-
-  auto begin = cc.index({Slice(cc.size(0) - max_shift, None)});
-  auto end = cc.index({Slice(None, max_shift + 1)});
-  cc = at::cat({begin, end});
-  // find max cross correlation index
-  const int shift = at::argmax(at::abs(cc), 0).item<int>() - max_shift;
-  const double tau = shift / static_cast<double>(interp * fs);
+    max_shift = std::min(static_cast<int>(fs * max_tau), max_shift);
+
+  // find max cross correlation shift, cc being circular
+  int shift = -max_shift;
+  double max_cc = -1.0;
+  for (int i = -max_shift; i <= max_shift; ++i) {
+    const double abs_cc = std::fabs(cc[(i + n) % n]);
+    if (abs_cc > max_cc) {
+      max_cc = abs_cc;
+      shift = i;
+    }
+  }
+  const double tau = shift / static_cast<double>(fs);
 
   return tau;
 }
 
-void DirectionDetection::ConjugateTensor(torch::Tensor* tensor) {
-  tensor->index_put_({"...", 1}, -tensor->index({"...", 1}));
-}
-
-torch::Tensor DirectionDetection::ComplexMultiply(const torch::Tensor& a,
-                                                  const torch::Tensor& b) {
-  torch::Tensor real = a.index({"...", 0}) * b.index({"...", 0}) -
-                       a.index({"...", 1}) * b.index({"...", 1});
-  torch::Tensor imag = a.index({"...", 0}) * b.index({"...", 1}) +
-                       a.index({"...", 1}) * b.index({"...", 0});
-  return at::cat({real.reshape({-1, 1}), imag.reshape({-1, 1})}, 1);
-}
-
-torch::Tensor DirectionDetection::ComplexAbsolute(const torch::Tensor& tensor) {
-  torch::Tensor res = tensor * tensor;
-  res = at::sqrt(res.sum(1)).reshape({-1, 1});
-
-  return res;
-}
-
 }  // namespace audio
 }  // namespace apollo
@@ -31,10 +31,8 @@
 #undef ALIVE
 #endif
 
-#include "ATen/ATen.h"
-#include "torch/torch.h"
-
 #include "cyber/cyber.h"
+#include "modules/audio/common/audio_spectra.h"
 #include "modules/common/proto/geometry.pb.h"
 
 namespace apollo {
@@ -46,9 +44,10 @@ class DirectionDetection {
  public:
   DirectionDetection();
   ~DirectionDetection();
-  // Estimates the position of the source of the sound
+  // Estimates the position of the source of the sound from the spectra of
+  // the signals, shared with the other detections
   std::pair<Point3D, double> EstimateSoundSource(
-      std::vector<std::vector<double>>&& channels_vec,
+      const AudioSpectra& spectra,
       const std::string& respeaker_extrinsic_file,
       const int sample_rate, const double mic_distance);
 
@@ -58,21 +57,17 @@ class DirectionDetection {
   std::unique_ptr<Eigen::Matrix4d> respeaker2imu_ptr_;
 
   // Estimates the direction of the source of the sound
-  double EstimateDirection(std::vector<std::vector<double>>&& channels_vec,
-                           const int sample_rate, const double mic_distance);
+  double EstimateDirection(const AudioSpectra& spectra, const int sample_rate,
+                           const double mic_distance);
 
   bool LoadExtrinsics(const std::string& yaml_file,
                       Eigen::Matrix4d* respeaker_extrinsic);
 
-  // Computes the offset between the signal sig and the reference signal refsig
-  // using the Generalized Cross Correlation - Phase Transform (GCC-PHAT)method.
-  double GccPhat(const torch::Tensor& sig, const torch::Tensor& refsig, int fs,
-                 double max_tau, int interp);
-
-  // Libtorch does not support Complex type currently.
-  void ConjugateTensor(torch::Tensor* tensor);
-  torch::Tensor ComplexMultiply(const torch::Tensor& a, const torch::Tensor& b);
-  torch::Tensor ComplexAbsolute(const torch::Tensor& tensor);
+  // Computes the offset between the signal of a channel and the one of the
+  // reference channel using the Generalized Cross Correlation - Phase
+  // Transform (GCC-PHAT)method.
+  double GccPhat(const AudioSpectra& spectra, const std::size_t channel,
+                 const std::size_t ref_channel, int fs, double max_tau);
 };
 
 }  // namespace audio
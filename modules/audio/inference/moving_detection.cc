@@ -18,18 +18,27 @@
 
 #include <fftw3.h>
 
+#include <algorithm>
+
 namespace apollo {
 namespace audio {
 
 MovingResult MovingDetection::Detect(
     const std::vector<std::vector<double>>& signals) {
+  AudioSpectra spectra;
+  spectra.Compute(signals);
+  return Detect(spectra);
+}
+
+MovingResult MovingDetection::Detect(const AudioSpectra& spectra) {
   int approaching_count = 0;
   int departing_count = 0;
-  for (std::size_t i = 0; i < signals.size(); ++i) {
+  for (std::size_t i = 0; i < spectra.num_channels(); ++i) {
     while (signal_stats_.size() <= i) {
       signal_stats_.push_back({});
     }
-    MovingResult result = DetectSingleChannel(i, signals[i]);
+    MovingResult result = DetectSingleChannel(i, spectra.spectrum(i),
+                                              spectra.signal_length());
     if (result == APPROACHING) {
       ++approaching_count;
     } else if (result == DEPARTING) {
@@ -46,11 +55,13 @@ MovingResult MovingDetection::Detect(
 }
 
 MovingResult MovingDetection::DetectSingleChannel(
-    const std::size_t channel_index, const std::vector<double>& signals) {
+    const std::size_t channel_index,
+    const std::vector<std::complex<double>>& padded_spectrum,
+    const int signal_length) {
   static constexpr int kStartFrequency = 3;
   static constexpr int kFrameNumStored = 10;
-  std::vector<std::complex<double>> fft_results = fft1d(signals);
-  SignalStat signal_stat = GetSignalStat(fft_results, kStartFrequency);
+  SignalStat signal_stat =
+      GetSignalStat(padded_spectrum, signal_length, kStartFrequency);
   signal_stats_[channel_index].push_back(signal_stat);
   while (static_cast<int>(signal_stats_[channel_index].size()) >
          kFrameNumStored) {
@@ -114,6 +125,7 @@ std::vector<std::complex<double>> MovingDetection::fft1d(
 
   fftw_plan p = fftw_plan_dft_1d(n, in, out, FFTW_FORWARD, FFTW_ESTIMATE);
   fftw_execute(p);
+  fftw_destroy_plan(p);
 
   std::vector<std::complex<double>> output;
   output.reserve(n);
@@ -124,13 +136,16 @@ std::vector<std::complex<double>> MovingDetection::fft1d(
 }
 
 MovingDetection::SignalStat MovingDetection::GetSignalStat(
-    const std::vector<std::complex<double>>& fft_results,
-    const int start_frequency) {
+    const std::vector<std::complex<double>>& padded_spectrum,
+    const int signal_length, const int start_frequency) {
   double total_power = 0.0;
   int top_frequency = -1;
   double max_power = -1.0;
-  for (int i = start_frequency; i < static_cast<int>(fft_results.size()); ++i) {
-    double power = std::abs(fft_results[i]);
+  for (int i = start_frequency; i < signal_length; ++i) {
+    // Bin i of the signal is bin 2 * i of the padded one, and the bins above
+    // half of the signal length mirror the ones below.
+    double power =
+        std::abs(padded_spectrum[2 * std::min(i, signal_length - i)]);
     total_power += power;
     if (power > max_power) {
       max_power = power;
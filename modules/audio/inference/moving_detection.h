@@ -18,6 +18,7 @@
 #include <vector>
 #include <complex>
 
+#include "modules/audio/common/audio_spectra.h"
 #include "modules/audio/proto/audio.pb.h"
 
 namespace apollo {
@@ -36,8 +37,13 @@ class MovingDetection {
 
   MovingResult Detect(const std::vector<std::vector<double>>& signals);
 
+  // Detects from the spectra of the signals, shared with the other detections
+  MovingResult Detect(const AudioSpectra& spectra);
+
   MovingResult DetectSingleChannel(
-      const std::size_t channel_index, const std::vector<double>& signal);
+      const std::size_t channel_index,
+      const std::vector<std::complex<double>>& padded_spectrum,
+      const int signal_length);
 
  private:
   class SignalStat {
@@ -52,8 +58,8 @@ class MovingDetection {
   };
 
   SignalStat GetSignalStat(
-      const std::vector<std::complex<double>>& fft_results,
-      const int start_frequency);
+      const std::vector<std::complex<double>>& padded_spectrum,
+      const int signal_length, const int start_frequency);
 
   MovingResult AnalyzePower(const std::deque<SignalStat>& signal_stats);
 
@@ -35,6 +35,28 @@ TEST_F(MovingDetectionTest, fft1d) {
       moving_detection_.fft1d(signal);
 }
 
+TEST_F(MovingDetectionTest, spectra) {
+  std::vector<double> signal{1.0, 2.0, 3.0, 4.0, -1.0, -2.0, 5.0};
+  std::vector<std::complex<double>> fft_result =
+      moving_detection_.fft1d(signal);
+  AudioSpectra spectra;
+  spectra.Compute({signal, signal});
+  ASSERT_EQ(2U, spectra.num_channels());
+  ASSERT_EQ(7, spectra.signal_length());
+  ASSERT_EQ(8U, spectra.spectrum(1).size());
+  // The padded spectrum has the spectrum of the signal in its even bins.
+  for (int i = 0; i <= 3; ++i) {
+    EXPECT_NEAR(fft_result[i].real(), spectra.spectrum(1)[2 * i].real(), 1e-9);
+    EXPECT_NEAR(fft_result[i].imag(), spectra.spectrum(1)[2 * i].imag(), 1e-9);
+  }
+  std::vector<double> padded;
+  spectra.InverseTransform(spectra.spectrum(0), &padded);
+  ASSERT_EQ(14U, padded.size());
+  for (int i = 0; i < 14; ++i) {
+    EXPECT_NEAR(i < 7 ? signal[i] : 0.0, padded[i] / 14, 1e-9);
+  }
+}
+
 TEST_F(MovingDetectionTest, moving) {
   std::vector<std::vector<double>> signals{
     {1.0, 2.0, 3.0, 4.0, -1.0, -2.0},
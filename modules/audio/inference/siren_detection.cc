@@ -42,23 +42,30 @@ bool SirenDetection::Evaluate(const std::vector<std::vector<double>>& signals) {
     AERROR << "Got no signal in channel 0!";
     return false;
   }
-  if (signals[0].size() != 72000) {
-    AERROR << "signals[0].size() = " << signals[0].size() << ", skiping!";
+  if (static_cast<int64_t>(signals.size()) != kNumChannels) {
+    AERROR << "signals.size() = " << signals.size() << ", skiping!";
     return false;
   }
-  torch::Tensor audio_tensor = torch::empty(4 * 1 * 72000);
-  float* data = audio_tensor.data_ptr<float>();
-
+  for (const auto& channel : signals) {
+    if (static_cast<int64_t>(channel.size()) != kSignalLength) {
+      AERROR << "channel.size() = " << channel.size() << ", skiping!";
+      return false;
+    }
+  }
+  // All channels go through the model as one batch, in an input tensor which
+  // is allocated once.
+  if (!input_tensor_.defined()) {
+    input_tensor_ = torch::empty({kNumChannels, 1, kSignalLength});
+  }
+  float* data = input_tensor_.data_ptr<float>();
   for (const auto& channel : signals) {
     for (const auto& i : channel) {
       *data++ = static_cast<float>(i) / 32767.0;
     }
   }
 
-  torch::Tensor torch_input = torch::from_blob(audio_tensor.data_ptr<float>(),
-                                               {4, 1, 72000});
   std::vector<torch::jit::IValue> torch_inputs;
-  torch_inputs.push_back(torch_input.to(device_));
+  torch_inputs.push_back(input_tensor_.to(device_));
 
   auto start_time = std::chrono::system_clock::now();
   at::Tensor torch_output_tensor = torch_model_.forward(torch_inputs).toTensor()
@@ -41,8 +41,12 @@ class SirenDetection {
   void LoadModel();
 
  private:
+  static constexpr int64_t kNumChannels = 4;
+  static constexpr int64_t kSignalLength = 72000;
+
   torch::jit::script::Module torch_model_;
   torch::Device device_;
+  torch::Tensor input_tensor_;
 };
 
 }  // namespace audio
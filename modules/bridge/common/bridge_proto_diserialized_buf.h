@@ -63,6 +63,9 @@ class BridgeProtoDiserializedBuf : public ProtoDiserializedBufBase {
   virtual bool IsTheProto(const BridgeHeader &header);
 
   bool Initialize(const BridgeHeader &header);
+  // Forget the frames received, so that the buffer is reused for another
+  // message.
+  void Reset();
   bool Diserialized(std::shared_ptr<T> proto);
   virtual char *GetBuf(size_t offset) { return proto_buf_ + offset; }
   virtual uint32_t GetMsgID() const { return sequence_num_; }
@@ -74,6 +77,7 @@ class BridgeProtoDiserializedBuf : public ProtoDiserializedBufBase {
   std::string proto_name_ = "";
   std::vector<uint32_t> status_list_;
   char *proto_buf_ = nullptr;
+  size_t proto_buf_capacity_ = 0;
   bool is_ready_diser = false;
   uint32_t sequence_num_ = 0;
   std::shared_ptr<cyber::Writer<T>> writer_;
@@ -94,34 +98,38 @@ bool BridgeProtoDiserializedBuf<T>::Diserialized(std::shared_ptr<T> proto) {
   return true;
 }
 
+template <typename T>
+void BridgeProtoDiserializedBuf<T>::Reset() {
+  total_frames_ = 0;
+  total_size_ = 0;
+  proto_name_.clear();
+  status_list_.clear();
+  is_ready_diser = false;
+  sequence_num_ = 0;
+}
+
 template <typename T>
 void BridgeProtoDiserializedBuf<T>::UpdateStatus(uint32_t frame_index) {
   size_t status_size = status_list_.size();
-  if (status_size == 0) {
+  uint32_t status_index = frame_index / INT_BITS;
+  if (status_index >= status_size) {
     is_ready_diser = false;
     return;
   }
 
-  uint32_t status_index = frame_index / INT_BITS;
-  status_list_[status_index] |= (1 << (frame_index % INT_BITS));
+  status_list_[status_index] |= (1u << (frame_index % INT_BITS));
+  // The last word only has the bits of the frames left over.
+  uint32_t last_bits = static_cast<uint32_t>(total_frames_ % INT_BITS);
+  uint32_t last_mask = last_bits ? (1u << last_bits) - 1 : 0xffffffff;
   for (size_t i = 0; i < status_size; i++) {
-    if (i == status_size - 1) {
-      if (static_cast<int>(status_list_[i]) ==
-          (1 << total_frames_ % INT_BITS) - 1) {
-        AINFO << "diserialized is ready";
-        is_ready_diser = true;
-      } else {
-        is_ready_diser = false;
-        break;
-      }
-    } else {
-      if (status_list_[i] != 0xffffffff) {
-        is_ready_diser = false;
-        break;
-      }
-      is_ready_diser = true;
+    uint32_t mask = (i == status_size - 1) ? last_mask : 0xffffffff;
+    if (status_list_[i] != mask) {
+      is_ready_diser = false;
+      return;
     }
   }
+  AINFO << "diserialized is ready";
+  is_ready_diser = true;
 }
 
 template <typename T>
@@ -135,6 +143,8 @@ bool BridgeProtoDiserializedBuf<T>::IsTheProto(const BridgeHeader &header) {
 
 template <typename T>
 bool BridgeProtoDiserializedBuf<T>::Initialize(const BridgeHeader &header) {
+  proto_name_ = header.GetMsgName();
+  sequence_num_ = header.GetMsgID();
   total_size_ = header.GetMsgSize();
   total_frames_ = header.GetTotalFrames();
   if (total_frames_ == 0) {
@@ -148,8 +158,10 @@ bool BridgeProtoDiserializedBuf<T>::Initialize(const BridgeHeader &header) {
     }
   }
 
-  if (!proto_buf_) {
+  if (!proto_buf_ || proto_buf_capacity_ < total_size_) {
+    FREE_ARRY(proto_buf_);
     proto_buf_ = new char[total_size_];
+    proto_buf_capacity_ = total_size_;
   }
   return true;
 }
@@ -20,6 +20,9 @@
 #include <string>
 #include <vector>
 
+#include "google/protobuf/io/coded_stream.h"
+#include "google/protobuf/io/zero_copy_stream.h"
+
 #include "modules/bridge/common/bridge_header.h"
 #include "modules/bridge/common/macro.h"
 
@@ -49,57 +52,98 @@ class BridgeProtoSerializedBuf {
     size_t buf_len_;
   };
 
+  // Hands the payloads of the frames, each after its header, to protobuf, so
+  // that the proto is serialized in place instead of being copied into them.
+  class FramePayloadStream : public google::protobuf::io::ZeroCopyOutputStream {
+   public:
+    FramePayloadStream(const std::vector<Buf> &frames, size_t header_size)
+        : frames_(frames), header_size_(header_size) {}
+
+    bool Next(void **data, int *size) override {
+      if (index_ >= frames_.size()) {
+        return false;
+      }
+      const Buf &frame = frames_[index_++];
+      *data = frame.buf_ + header_size_;
+      *size = static_cast<int>(frame.buf_len_ - header_size_);
+      byte_count_ += *size;
+      return true;
+    }
+    void BackUp(int count) override { byte_count_ -= count; }
+    int64_t ByteCount() const override { return byte_count_; }
+
+   private:
+    const std::vector<Buf> &frames_;
+    const size_t header_size_;
+    size_t index_ = 0;
+    int64_t byte_count_ = 0;
+  };
+
  private:
+  // The frames one after the other, all in buf_.
   std::vector<Buf> frames_;
+  char *buf_ = nullptr;
 };
 
 template <typename T>
 BridgeProtoSerializedBuf<T>::~BridgeProtoSerializedBuf() {
-  for (auto frame : frames_) {
-    FREE_ARRY(frame.buf_);
-  }
+  FREE_ARRY(buf_);
 }
 
 template <typename T>
 bool BridgeProtoSerializedBuf<T>::Serialize(const std::shared_ptr<T> &proto,
                                             const std::string &msg_name) {
+  frames_.clear();
+  FREE_ARRY(buf_);
+
   bsize msg_len = static_cast<bsize>(proto->ByteSizeLong());
-  char *tmp = new char[msg_len]();
-  if (!proto->SerializeToArray(tmp, static_cast<int>(msg_len))) {
-    FREE_ARRY(tmp);
-    return false;
+  if (msg_len == 0) {
+    return true;
   }
-  bsize offset = 0;
-  bsize frame_index = 0;
   uint32_t total_frames = static_cast<uint32_t>(msg_len / FRAME_SIZE +
                                                 (msg_len % FRAME_SIZE ? 1 : 0));
 
-  while (offset < msg_len) {
+  // BridgeHeader points to its own items, so it is filled in place rather
+  // than copied.
+  auto fill_header = [&](bsize frame_index, bsize frame_size,
+                         BridgeHeader *header) {
+    header->SetHeaderVer(0);
+    header->SetMsgName(msg_name);
+    header->SetMsgID(proto->header().sequence_num());
+    header->SetTimeStamp(proto->header().timestamp_sec());
+    header->SetMsgSize(msg_len);
+    header->SetTotalFrames(total_frames);
+    header->SetFrameSize(frame_size);
+    header->SetIndex(frame_index);
+    header->SetFramePos(frame_index * FRAME_SIZE);
+  };
+
+  // The headers of all the frames are of the same size, only their values
+  // differ.
+  BridgeHeader first_header;
+  fill_header(0, 0, &first_header);
+  const hsize header_size = first_header.GetHeaderSize();
+  buf_ = new char[total_frames * header_size + msg_len];
+  frames_.reserve(total_frames);
+  char *cursor = buf_;
+  for (bsize frame_index = 0; frame_index < total_frames; ++frame_index) {
     bsize left = msg_len - frame_index * FRAME_SIZE;
     bsize cpy_size = (left > FRAME_SIZE) ? FRAME_SIZE : left;
 
-    BridgeHeader header;
-    header.SetHeaderVer(0);
-    header.SetMsgName(msg_name);
-    header.SetMsgID(proto->header().sequence_num());
-    header.SetTimeStamp(proto->header().timestamp_sec());
-    header.SetMsgSize(msg_len);
-    header.SetTotalFrames(total_frames);
-    header.SetFrameSize(cpy_size);
-    header.SetIndex(frame_index);
-    header.SetFramePos(frame_index * FRAME_SIZE);
-    hsize header_size = header.GetHeaderSize();
     Buf buf;
-    buf.buf_ = new char[cpy_size + header_size];
+    buf.buf_ = cursor;
     buf.buf_len_ = cpy_size + header_size;
+    BridgeHeader header;
+    fill_header(frame_index, cpy_size, &header);
     header.Serialize(buf.buf_, buf.buf_len_);
-    memcpy(buf.buf_ + header_size, tmp + frame_index * FRAME_SIZE, cpy_size);
     frames_.push_back(buf);
-    frame_index++;
-    offset += cpy_size;
+    cursor += buf.buf_len_;
   }
-  FREE_ARRY(tmp);
-  return true;
+
+  FramePayloadStream stream(frames_, header_size);
+  google::protobuf::io::CodedOutputStream coded_stream(&stream);
+  proto->SerializeWithCachedSizes(&coded_stream);
+  return !coded_stream.HadError();
 }
 
 }  // namespace bridge
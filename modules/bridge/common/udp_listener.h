@@ -19,23 +19,34 @@
 #include <arpa/inet.h>
 #include <fcntl.h>
 #include <netinet/in.h>
-#include <pthread.h>
 #include <sys/epoll.h>
-#include <sys/resource.h>
 #include <sys/socket.h>
 #include <sys/types.h>
-#include <sys/wait.h>
 #include <unistd.h>
 
+#include <cerrno>
+#include <cstring>
+
+#include "modules/bridge/common/macro.h"
+
 namespace apollo {
 namespace bridge {
 
 constexpr int MAXEPOLLSIZE = 100;
-
+// The number of datagrams received by one system call at most.
+constexpr unsigned int RECV_BATCH_SIZE = 32;
+constexpr size_t RECV_BUF_SIZE = 2 * FRAME_SIZE;
+
+/**
+ * Receive the datagrams of a port on the thread calling Listen(), and hand
+ * them to the receiver one by one, in the order they arrived. The frames of
+ * all the channels bridged on the port are received in batches, so one
+ * thread keeps up with many of them.
+ */
 template <typename T>
 class UDPListener {
  public:
-  typedef bool (T::*func)(int fd);
+  typedef bool (T::*func)(const char *buf, size_t size);
   UDPListener() {}
   UDPListener(T *receiver, uint16_t port, func msg_handle) {
     receiver_ = receiver;
@@ -46,30 +57,30 @@ class UDPListener {
     if (listener_sock_ != -1) {
       close(listener_sock_);
     }
+    if (kdpfd_ != -1) {
+      close(kdpfd_);
+    }
   }
 
   void SetMsgHandle(func msg_handle) { msg_handle_ = msg_handle; }
   bool Initialize(T *receiver, func msg_handle, uint16_t port);
   bool Listen();
 
-  static void *pthread_handle_message(void *param);
-
- public:
-  struct Param {
-    int fd_ = 0;
-    UDPListener<T> *listener_ = nullptr;
-  };
-
  private:
   bool setnonblocking(int sockfd);
-  void MessageHandle(int fd);
+  void ReceiveMessages(int fd);
+  void MessageHandle(const char *buf, size_t size);
 
  private:
   T *receiver_ = nullptr;
   uint16_t listened_port_ = 0;
   int listener_sock_ = -1;
   func msg_handle_ = nullptr;
-  int kdpfd_ = 0;
+  int kdpfd_ = -1;
+
+  char bufs_[RECV_BATCH_SIZE][RECV_BUF_SIZE];
+  struct iovec iovecs_[RECV_BATCH_SIZE];
+  struct mmsghdr msgs_[RECV_BATCH_SIZE];
 };
 
 template <typename T>
@@ -84,11 +95,6 @@ bool UDPListener<T>::Initialize(T *receiver, func msg_handle, uint16_t port) {
     return false;
   }
   listened_port_ = port;
-  struct rlimit rt;
-  rt.rlim_max = rt.rlim_cur = MAXEPOLLSIZE;
-  if (setrlimit(RLIMIT_NOFILE, &rt) == -1) {
-    return false;
-  }
 
   listener_sock_ = socket(AF_INET, SOCK_DGRAM, 0);
   if (listener_sock_ == -1) {
@@ -105,6 +111,7 @@ bool UDPListener<T>::Initialize(T *receiver, func msg_handle, uint16_t port) {
   if (bind(listener_sock_, (struct sockaddr *)&serv_addr,
            sizeof(struct sockaddr)) == -1) {
     close(listener_sock_);
+    listener_sock_ = -1;
     return false;
   }
   kdpfd_ = epoll_create(MAXEPOLLSIZE);
@@ -113,76 +120,74 @@ bool UDPListener<T>::Initialize(T *receiver, func msg_handle, uint16_t port) {
   ev.data.fd = listener_sock_;
   if (epoll_ctl(kdpfd_, EPOLL_CTL_ADD, listener_sock_, &ev) < 0) {
     close(listener_sock_);
+    listener_sock_ = -1;
     return false;
   }
+
+  memset(msgs_, 0, sizeof(msgs_));
+  for (unsigned int i = 0; i < RECV_BATCH_SIZE; ++i) {
+    iovecs_[i].iov_base = bufs_[i];
+    iovecs_[i].iov_len = RECV_BUF_SIZE;
+    msgs_[i].msg_hdr.msg_iov = &iovecs_[i];
+    msgs_[i].msg_hdr.msg_iovlen = 1;
+  }
   return true;
 }
 
 template <typename T>
 bool UDPListener<T>::Listen() {
-  int nfds = -1;
-  bool res = true;
   struct epoll_event events[MAXEPOLLSIZE];
   while (true) {
-    nfds = epoll_wait(kdpfd_, events, 10000, -1);
+    int nfds = epoll_wait(kdpfd_, events, MAXEPOLLSIZE, -1);
     if (nfds == -1) {
-      res = false;
+      if (errno == EINTR) {
+        continue;
+      }
       break;
     }
 
     for (int i = 0; i < nfds; ++i) {
       if (events[i].data.fd == listener_sock_) {
-        pthread_t thread;
-        pthread_attr_t attr;
-        pthread_attr_init(&attr);
-        pthread_attr_setscope(&attr, PTHREAD_SCOPE_SYSTEM);
-        pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
-        Param *par = new Param;
-        par->fd_ = events[i].data.fd;
-        par->listener_ = this;
-        if (pthread_create(&thread, &attr,
-                           &UDPListener<T>::pthread_handle_message,
-                           reinterpret_cast<void *>(par))) {
-          res = false;
-          return res;
-        }
+        ReceiveMessages(listener_sock_);
       }
     }
   }
   close(listener_sock_);
-  return res;
+  listener_sock_ = -1;
+  return false;
 }
 
 template <typename T>
-bool UDPListener<T>::setnonblocking(int sockfd) {
-  if (fcntl(sockfd, F_SETFL, fcntl(sockfd, F_GETFD, 0) | O_NONBLOCK) == -1) {
-    return false;
+void UDPListener<T>::ReceiveMessages(int fd) {
+  // The socket is edge triggered, drain it until it would block.
+  while (true) {
+    int nmsgs = recvmmsg(fd, msgs_, RECV_BATCH_SIZE, 0, nullptr);
+    if (nmsgs <= 0) {
+      if (nmsgs == -1 && errno == EINTR) {
+        continue;
+      }
+      return;
+    }
+    for (int i = 0; i < nmsgs; ++i) {
+      MessageHandle(bufs_[i], msgs_[i].msg_len);
+    }
   }
-  return true;
 }
 
 template <typename T>
-void *UDPListener<T>::pthread_handle_message(void *param) {
-  Param *par = static_cast<Param *>(param);
-  int fd = par->fd_;
-  UDPListener<T> *listener = par->listener_;
-  if (par) {
-    delete par;
-  }
-  par = nullptr;
-  if (!listener) {
-    pthread_exit(nullptr);
+bool UDPListener<T>::setnonblocking(int sockfd) {
+  if (fcntl(sockfd, F_SETFL, fcntl(sockfd, F_GETFL, 0) | O_NONBLOCK) == -1) {
+    return false;
   }
-  listener->MessageHandle(fd);
-  pthread_exit(nullptr);
+  return true;
 }
 
 template <typename T>
-void UDPListener<T>::MessageHandle(int fd) {
+void UDPListener<T>::MessageHandle(const char *buf, size_t size) {
   if (!receiver_ || !msg_handle_) {
     return;
   }
-  (receiver_->*msg_handle_)(fd);
+  (receiver_->*msg_handle_)(buf, size);
 }
 
 }  // namespace bridge
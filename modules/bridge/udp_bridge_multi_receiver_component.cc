@@ -110,17 +110,10 @@ bool UDPBridgeMultiReceiverComponent::IsTimeout(double time_stamp) {
   return false;
 }
 
-bool UDPBridgeMultiReceiverComponent::MsgHandle(int fd) {
-  struct sockaddr_in client_addr;
-  socklen_t sock_len = static_cast<socklen_t>(sizeof(client_addr));
-  int bytes = 0;
-  int total_recv = 2 * FRAME_SIZE;
-  char total_buf[2 * FRAME_SIZE] = {0};
-  bytes =
-      static_cast<int>(recvfrom(fd, total_buf, total_recv, 0,
-                                (struct sockaddr *)&client_addr, &sock_len));
+bool UDPBridgeMultiReceiverComponent::MsgHandle(const char *total_buf,
+                                                size_t bytes) {
   ADEBUG << "total recv " << bytes;
-  if (bytes <= 0 || bytes > total_recv) {
+  if (bytes < HEADER_FLAG_SIZE + sizeof(hsize) + 2 || bytes > RECV_BUF_SIZE) {
     return false;
   }
   char header_flag[sizeof(BRIDGE_HEADER_FLAG) + 1] = {0};
@@ -136,8 +129,9 @@ bool UDPBridgeMultiReceiverComponent::MsgHandle(int fd) {
   const char *cursor = total_buf + offset;
   memcpy(header_size_buf, cursor, sizeof(hsize));
   hsize header_size = *(reinterpret_cast<hsize *>(header_size_buf));
-  if (header_size > FRAME_SIZE) {
-    AINFO << "header size is more than FRAME_SIZE!";
+  if (header_size > FRAME_SIZE || header_size > bytes ||
+      header_size < HEADER_FLAG_SIZE + sizeof(hsize) + 2) {
+    AINFO << "header size is invalid!";
     return false;
   }
   offset += sizeof(hsize) + 1;
@@ -155,6 +149,15 @@ bool UDPBridgeMultiReceiverComponent::MsgHandle(int fd) {
   ADEBUG << "proto total frames: " << header.GetTotalFrames();
   ADEBUG << "proto frame index: " << header.GetIndex();
 
+  // Drop the frames which do not fit in the message or the datagram.
+  if (header.GetIndex() >= header.GetTotalFrames() ||
+      header.GetFramePos() > header.GetMsgSize() ||
+      header.GetFrameSize() > header.GetMsgSize() - header.GetFramePos() ||
+      header.GetFrameSize() > bytes - header_size) {
+    AINFO << "frame is out of the message!";
+    return false;
+  }
+
   std::lock_guard<std::mutex> lock(mutex_);
   std::shared_ptr<ProtoDiserializedBufBase> proto_buf =
       CreateBridgeProtoBuf(header);
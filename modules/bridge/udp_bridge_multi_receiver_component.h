@@ -53,7 +53,7 @@ class UDPBridgeMultiReceiverComponent final : public cyber::Component<> {
   bool IsTimeout(double time_stamp);
   void MsgDispatcher();
   bool InitSession(uint16_t port);
-  bool MsgHandle(int fd);
+  bool MsgHandle(const char *buf, size_t size);
 
  private:
   bool RemoveInvalidBuf(uint32_t msg_id, const std::string &msg_name);
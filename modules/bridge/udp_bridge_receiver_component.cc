@@ -16,6 +16,8 @@
 
 #include "modules/bridge/udp_bridge_receiver_component.h"
 
+#include <algorithm>
+
 #include "cyber/time/clock.h"
 #include "modules/bridge/common/macro.h"
 #include "modules/bridge/common/util.h"
@@ -30,11 +32,21 @@ template <typename T>
 UDPBridgeReceiverComponent<T>::UDPBridgeReceiverComponent()
     : monitor_logger_buffer_(common::monitor::MonitorMessageItem::CONTROL) {}
 
+namespace {
+
+// The number of released message buffers kept for reuse.
+constexpr size_t kMaxFreeBufs = 16;
+
+}  // namespace
+
 template <typename T>
 UDPBridgeReceiverComponent<T>::~UDPBridgeReceiverComponent() {
   for (auto proto : proto_list_) {
     FREE_POINTER(proto);
   }
+  for (auto proto : free_list_) {
+    FREE_POINTER(proto);
+  }
 }
 
 template <typename T>
@@ -82,8 +94,7 @@ BridgeProtoDiserializedBuf<T>
         proto_list_.begin();
     for (; itor != proto_list_.end();) {
       if ((*itor)->IsTheProto(header)) {
-        BridgeProtoDiserializedBuf<T> *tmp = *itor;
-        FREE_POINTER(tmp);
+        ReleaseBridgeProtoBuf(*itor);
         itor = proto_list_.erase(itor);
         break;
       }
@@ -97,15 +108,32 @@ BridgeProtoDiserializedBuf<T>
       return proto;
     }
   }
-  BridgeProtoDiserializedBuf<T> *proto_buf = new BridgeProtoDiserializedBuf<T>;
-  if (!proto_buf) {
+  BridgeProtoDiserializedBuf<T> *proto_buf = nullptr;
+  if (!free_list_.empty()) {
+    proto_buf = free_list_.back();
+    free_list_.pop_back();
+  } else {
+    proto_buf = new BridgeProtoDiserializedBuf<T>;
+  }
+  if (!proto_buf->Initialize(header)) {
+    ReleaseBridgeProtoBuf(proto_buf);
     return nullptr;
   }
-  proto_buf->Initialize(header);
   proto_list_.push_back(proto_buf);
   return proto_buf;
 }
 
+template <typename T>
+void UDPBridgeReceiverComponent<T>::ReleaseBridgeProtoBuf(
+    BridgeProtoDiserializedBuf<T> *proto_buf) {
+  if (free_list_.size() >= kMaxFreeBufs) {
+    FREE_POINTER(proto_buf);
+    return;
+  }
+  proto_buf->Reset();
+  free_list_.push_back(proto_buf);
+}
+
 template <typename T>
 bool UDPBridgeReceiverComponent<T>::IsProtoExist(const BridgeHeader &header) {
   for (auto proto : proto_list_) {
@@ -132,17 +160,10 @@ bool UDPBridgeReceiverComponent<T>::IsTimeout(double time_stamp) {
 }
 
 template <typename T>
-bool UDPBridgeReceiverComponent<T>::MsgHandle(int fd) {
-  struct sockaddr_in client_addr;
-  socklen_t sock_len = static_cast<socklen_t>(sizeof(client_addr));
-  int bytes = 0;
-  int total_recv = 2 * FRAME_SIZE;
-  char total_buf[2 * FRAME_SIZE] = {0};
-  bytes =
-      static_cast<int>(recvfrom(fd, total_buf, total_recv, 0,
-                                (struct sockaddr *)&client_addr, &sock_len));
+bool UDPBridgeReceiverComponent<T>::MsgHandle(const char *total_buf,
+                                              size_t bytes) {
   ADEBUG << "total recv " << bytes;
-  if (bytes <= 0 || bytes > total_recv) {
+  if (bytes < HEADER_FLAG_SIZE + sizeof(hsize) + 2 || bytes > RECV_BUF_SIZE) {
     return false;
   }
   char header_flag[sizeof(BRIDGE_HEADER_FLAG) + 1] = {0};
@@ -158,8 +179,9 @@ bool UDPBridgeReceiverComponent<T>::MsgHandle(int fd) {
   const char *cursor = total_buf + offset;
   memcpy(header_size_buf, cursor, sizeof(hsize));
   hsize header_size = *(reinterpret_cast<hsize *>(header_size_buf));
-  if (header_size > FRAME_SIZE) {
-    AINFO << "header size is more than FRAME_SIZE!";
+  if (header_size > FRAME_SIZE || header_size > bytes ||
+      header_size < HEADER_FLAG_SIZE + sizeof(hsize) + 2) {
+    AINFO << "header size is invalid!";
     return false;
   }
   offset += sizeof(hsize) + 1;
@@ -177,6 +199,15 @@ bool UDPBridgeReceiverComponent<T>::MsgHandle(int fd) {
   ADEBUG << "proto total frames: " << header.GetTotalFrames();
   ADEBUG << "proto frame index: " << header.GetIndex();
 
+  // Drop the frames which do not fit in the message or the datagram.
+  if (header.GetIndex() >= header.GetTotalFrames() ||
+      header.GetFramePos() > header.GetMsgSize() ||
+      header.GetFrameSize() > header.GetMsgSize() - header.GetFramePos() ||
+      header.GetFrameSize() > bytes - header_size) {
+    AINFO << "frame is out of the message!";
+    return false;
+  }
+
   std::lock_guard<std::mutex> lock(mutex_);
   BridgeProtoDiserializedBuf<T> *proto_buf = CreateBridgeProtoBuf(header);
   if (!proto_buf) {
@@ -192,7 +223,10 @@ bool UDPBridgeReceiverComponent<T>::MsgHandle(int fd) {
     proto_buf->Diserialized(pb_msg);
     writer_->Write(pb_msg);
     RemoveInvalidBuf(proto_buf->GetMsgID());
-    RemoveItem(&proto_list_, proto_buf);
+    proto_list_.erase(
+        std::remove(proto_list_.begin(), proto_list_.end(), proto_buf),
+        proto_list_.end());
+    ReleaseBridgeProtoBuf(proto_buf);
   }
   return true;
 }
@@ -206,8 +240,7 @@ bool UDPBridgeReceiverComponent<T>::RemoveInvalidBuf(uint32_t msg_id) {
       proto_list_.begin();
   for (; itor != proto_list_.end();) {
     if ((*itor)->GetMsgID() < msg_id) {
-      BridgeProtoDiserializedBuf<T> *tmp = *itor;
-      FREE_POINTER(tmp);
+      ReleaseBridgeProtoBuf(*itor);
       itor = proto_list_.erase(itor);
       continue;
     }
@@ -53,7 +53,7 @@ class UDPBridgeReceiverComponent final : public cyber::Component<> {
   bool Init() override;
 
   std::string Name() const { return FLAGS_bridge_module_name; }
-  bool MsgHandle(int fd);
+  bool MsgHandle(const char *buf, size_t size);
 
  private:
   bool InitSession(uint16_t port);
@@ -63,6 +63,8 @@ class UDPBridgeReceiverComponent final : public cyber::Component<> {
       const BridgeHeader &header);
   bool IsTimeout(double time_stamp);
   bool RemoveInvalidBuf(uint32_t msg_id);
+  // Keep the buffer of a message done with for the next ones.
+  void ReleaseBridgeProtoBuf(BridgeProtoDiserializedBuf<T> *proto_buf);
 
  private:
   common::monitor::MonitorLogBuffer monitor_logger_buffer_;
@@ -77,6 +79,8 @@ class UDPBridgeReceiverComponent final : public cyber::Component<> {
       std::make_shared<UDPListener<UDPBridgeReceiverComponent<T>>>();
 
   std::vector<BridgeProtoDiserializedBuf<T> *> proto_list_;
+  // The buffers released, reused instead of allocating new ones.
+  std::vector<BridgeProtoDiserializedBuf<T> *> free_list_;
 };
 
 RECEIVER_BRIDGE_COMPONENT_REGISTER(canbus::Chassis)
@@ -16,6 +16,8 @@
 
 #include "modules/bridge/udp_bridge_sender_component.h"
 
+#include <sys/uio.h>
+
 #include "modules/bridge/common/bridge_proto_serialized_buf.h"
 #include "modules/bridge/common/macro.h"
 #include "modules/bridge/common/util.h"
@@ -29,6 +31,13 @@ using apollo::bridge::UDPBridgeSenderRemoteInfo;
 using apollo::cyber::io::Session;
 using apollo::localization::LocalizationEstimate;
 
+template <typename T>
+UDPBridgeSenderComponent<T>::~UDPBridgeSenderComponent() {
+  if (sock_fd_ >= 0) {
+    close(sock_fd_);
+  }
+}
+
 template <typename T>
 bool UDPBridgeSenderComponent<T>::Init() {
   AINFO << "UDP bridge sender init, startin...";
@@ -43,13 +52,35 @@ bool UDPBridgeSenderComponent<T>::Init() {
   ADEBUG << "UDP Bridge remote ip is: " << remote_ip_;
   ADEBUG << "UDP Bridge remote port is: " << remote_port_;
   ADEBUG << "UDP Bridge for Proto is: " << proto_name_;
+  if (remote_port_ == 0 || remote_ip_.empty()) {
+    AERROR << "remote info is invalid!";
+    return false;
+  }
+
+  struct sockaddr_in server_addr;
+  server_addr.sin_addr.s_addr = inet_addr(remote_ip_.c_str());
+  server_addr.sin_family = AF_INET;
+  server_addr.sin_port = htons(static_cast<uint16_t>(remote_port_));
+  sock_fd_ = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK, 0);
+  if (sock_fd_ < 0) {
+    AERROR << "create socket failed!";
+    return false;
+  }
+  int res =
+      connect(sock_fd_, (struct sockaddr *)&server_addr, sizeof(server_addr));
+  if (res < 0) {
+    AERROR << "connect to the remote failed!";
+    close(sock_fd_);
+    sock_fd_ = -1;
+    return false;
+  }
   return true;
 }
 
 template <typename T>
 bool UDPBridgeSenderComponent<T>::Proc(const std::shared_ptr<T> &pb_msg) {
-  if (remote_port_ == 0 || remote_ip_.empty()) {
-    AERROR << "remote info is invalid!";
+  if (sock_fd_ < 0) {
+    AERROR << "remote is not connected!";
     return false;
   }
 
@@ -58,29 +89,33 @@ bool UDPBridgeSenderComponent<T>::Proc(const std::shared_ptr<T> &pb_msg) {
     return false;
   }
 
-  struct sockaddr_in server_addr;
-  server_addr.sin_addr.s_addr = inet_addr(remote_ip_.c_str());
-  server_addr.sin_family = AF_INET;
-  server_addr.sin_port = htons(static_cast<uint16_t>(remote_port_));
-  int sock_fd = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK, 0);
-
-  int res =
-      connect(sock_fd, (struct sockaddr *)&server_addr, sizeof(server_addr));
-  if (res < 0) {
-    close(sock_fd);
+  BridgeProtoSerializedBuf<T> proto_buf;
+  if (!proto_buf.Serialize(pb_msg, proto_name_)) {
+    AERROR << "serialize proto msg failed!";
     return false;
   }
 
-  BridgeProtoSerializedBuf<T> proto_buf;
-  proto_buf.Serialize(pb_msg, proto_name_);
-  for (size_t j = 0; j < proto_buf.GetSerializedBufCount(); j++) {
-    ssize_t nbytes = send(sock_fd, proto_buf.GetSerializedBuf(j),
-                          proto_buf.GetSerializedBufSize(j), 0);
-    if (nbytes != static_cast<ssize_t>(proto_buf.GetSerializedBufSize(j))) {
+  // Send the frames in batches of datagrams, one system call each.
+  const size_t frame_count = proto_buf.GetSerializedBufCount();
+  std::vector<struct iovec> iovecs(frame_count);
+  std::vector<struct mmsghdr> msgs(frame_count);
+  for (size_t j = 0; j < frame_count; j++) {
+    iovecs[j].iov_base = const_cast<char *>(proto_buf.GetSerializedBuf(j));
+    iovecs[j].iov_len = proto_buf.GetSerializedBufSize(j);
+    memset(&msgs[j], 0, sizeof(msgs[j]));
+    msgs[j].msg_hdr.msg_iov = &iovecs[j];
+    msgs[j].msg_hdr.msg_iovlen = 1;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  size_t sent = 0;
+  while (sent < frame_count) {
+    int nmsgs = sendmmsg(sock_fd_, msgs.data() + sent,
+                         static_cast<unsigned int>(frame_count - sent), 0);
+    if (nmsgs <= 0) {
       break;
     }
+    sent += nmsgs;
   }
-  close(sock_fd);
 
   return true;
 }
@@ -49,6 +49,7 @@ class UDPBridgeSenderComponent final : public cyber::Component<T> {
  public:
   UDPBridgeSenderComponent()
       : monitor_logger_buffer_(common::monitor::MonitorMessageItem::CONTROL) {}
+  ~UDPBridgeSenderComponent();
 
   bool Init() override;
   bool Proc(const std::shared_ptr<T> &pb_msg) override;
@@ -60,6 +61,8 @@ class UDPBridgeSenderComponent final : public cyber::Component<T> {
   unsigned int remote_port_ = 0;
   std::string remote_ip_ = "";
   std::string proto_name_ = "";
+  // The socket connected to the remote, opened once for all the messages.
+  int sock_fd_ = -1;
   std::mutex mutex_;
 };
 
@@ -85,6 +85,7 @@ bool CanbusComponent::Init() {
     AERROR << "Failed to init can sender.";
     return false;
   }
+  can_sender_.set_send_on_update(FLAGS_send_control_on_update);
   AINFO << "The can sender is successfully initialized.";
 
   vehicle_controller_ = vehicle_object->CreateVehicleController();
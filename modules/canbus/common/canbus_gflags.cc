@@ -28,6 +28,9 @@ DEFINE_string(canbus_conf_file,
 // Canbus gflags
 DEFINE_double(chassis_freq, 100, "Chassis feedback timer frequency.");
 DEFINE_int64(min_cmd_interval, 5, "Minimum control command interval in ms.");
+DEFINE_bool(send_control_on_update, false,
+            "Send the control frames as soon as a control command updates "
+            "them, instead of on their next period.");
 
 // chassis_detail message publish
 DEFINE_bool(enable_chassis_detail_pub, false, "Chassis Detail message publish");
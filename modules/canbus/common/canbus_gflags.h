@@ -28,6 +28,7 @@ DECLARE_string(canbus_conf_file);
 // Canbus gflags
 DECLARE_double(chassis_freq);
 DECLARE_int64(min_cmd_interval);
+DECLARE_bool(send_control_on_update);
 
 // chassis_detail message publish
 DECLARE_bool(enable_chassis_detail_pub);
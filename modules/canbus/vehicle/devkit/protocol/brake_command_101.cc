@@ -16,13 +16,13 @@
 
 #include "modules/canbus/vehicle/devkit/protocol/brake_command_101.h"
 
-#include "modules/drivers/canbus/common/byte.h"
+#include "modules/drivers/canbus/common/can_signal.h"
 
 namespace apollo {
 namespace canbus {
 namespace devkit {
 
-using ::apollo::drivers::canbus::Byte;
+using ::apollo::drivers::canbus::CanSignal;
 
 const int32_t Brakecommand101::ID = 0x101;
 
@@ -63,16 +63,8 @@ Brakecommand101* Brakecommand101::set_brake_dec(double brake_dec) {
 void Brakecommand101::set_p_brake_dec(uint8_t* data, double brake_dec) {
   brake_dec = ProtocolData::BoundedValue(0.0, 10.0, brake_dec);
   int x = brake_dec / 0.010000;
-  uint8_t t = 0;
 
-  t = x & 0x3;
-  Byte to_set0(data + 2);
-  to_set0.set_value(t, 6, 2);
-  x >>= 2;
-
-  t = x & 0xFF;
-  Byte to_set1(data + 1);
-  to_set1.set_value(t, 0, 8);
+  CanSignal<15, 10, true, false>::Encode(data, x);
 }
 
 Brakecommand101* Brakecommand101::set_checksum_101(int checksum_101) {
@@ -87,8 +79,7 @@ void Brakecommand101::set_p_checksum_101(uint8_t* data, int checksum_101) {
   checksum_101 = ProtocolData::BoundedValue(0, 255, checksum_101);
   int x = checksum_101;
 
-  Byte to_set(data + 7);
-  to_set.set_value(x, 0, 8);
+  CanSignal<63, 8, true, false>::Encode(data, x);
 }
 
 Brakecommand101* Brakecommand101::set_brake_pedal_target(
@@ -105,16 +96,8 @@ void Brakecommand101::set_p_brake_pedal_target(uint8_t* data,
   brake_pedal_target =
       ProtocolData::BoundedValue(0.0, 100.0, brake_pedal_target);
   int x = brake_pedal_target / 0.100000;
-  uint8_t t = 0;
-
-  t = x & 0xFF;
-  Byte to_set0(data + 4);
-  to_set0.set_value(t, 0, 8);
-  x >>= 8;
 
-  t = x & 0xFF;
-  Byte to_set1(data + 3);
-  to_set1.set_value(t, 0, 8);
+  CanSignal<31, 16, true, false>::Encode(data, x);
 }
 
 Brakecommand101* Brakecommand101::set_brake_en_ctrl(
@@ -131,8 +114,7 @@ void Brakecommand101::set_p_brake_en_ctrl(
     uint8_t* data, Brake_command_101::Brake_en_ctrlType brake_en_ctrl) {
   int x = brake_en_ctrl;
 
-  Byte to_set(data + 0);
-  to_set.set_value(x, 0, 1);
+  CanSignal<0, 1, true, false>::Encode(data, x);
 }
 
 }  // namespace devkit
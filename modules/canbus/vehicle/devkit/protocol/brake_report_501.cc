@@ -17,14 +17,14 @@
 #include "modules/canbus/vehicle/devkit/protocol/brake_report_501.h"
 
 #include "glog/logging.h"
-#include "modules/drivers/canbus/common/byte.h"
+#include "modules/drivers/canbus/common/can_signal.h"
 #include "modules/drivers/canbus/common/canbus_consts.h"
 
 namespace apollo {
 namespace canbus {
 namespace devkit {
 
-using ::apollo::drivers::canbus::Byte;
+using ::apollo::drivers::canbus::CanSignal;
 
 Brakereport501::Brakereport501() {}
 const int32_t Brakereport501::ID = 0x501;
@@ -48,13 +48,7 @@ void Brakereport501::Parse(const std::uint8_t* bytes, int32_t length,
 // 31, 'type': 'double', 'order': 'motorola', 'physical_unit': '%'}
 double Brakereport501::brake_pedal_actual(const std::uint8_t* bytes,
                                           int32_t length) const {
-  Byte t0(bytes + 3);
-  int32_t x = t0.get_byte(0, 8);
-
-  Byte t1(bytes + 4);
-  int32_t t = t1.get_byte(0, 8);
-  x <<= 8;
-  x |= t;
+  int32_t x = CanSignal<31, 16, true, false>::Decode(bytes);
 
   double ret = x * 0.100000;
   return ret;
@@ -67,8 +61,7 @@ double Brakereport501::brake_pedal_actual(const std::uint8_t* bytes,
 // 'motorola', 'physical_unit': ''}
 Brake_report_501::Brake_flt2Type Brakereport501::brake_flt2(
     const std::uint8_t* bytes, int32_t length) const {
-  Byte t0(bytes + 2);
-  int32_t x = t0.get_byte(0, 8);
+  int32_t x = CanSignal<23, 8, true, false>::Decode(bytes);
 
   Brake_report_501::Brake_flt2Type ret =
       static_cast<Brake_report_501::Brake_flt2Type>(x);
@@ -82,8 +75,7 @@ Brake_report_501::Brake_flt2Type Brakereport501::brake_flt2(
 // 'motorola', 'physical_unit': ''}
 Brake_report_501::Brake_flt1Type Brakereport501::brake_flt1(
     const std::uint8_t* bytes, int32_t length) const {
-  Byte t0(bytes + 1);
-  int32_t x = t0.get_byte(0, 8);
+  int32_t x = CanSignal<15, 8, true, false>::Decode(bytes);
 
   Brake_report_501::Brake_flt1Type ret =
       static_cast<Brake_report_501::Brake_flt1Type>(x);
@@ -97,8 +89,7 @@ Brake_report_501::Brake_flt1Type Brakereport501::brake_flt1(
 // 'bit': 1, 'type': 'enum', 'order': 'motorola', 'physical_unit': ''}
 Brake_report_501::Brake_en_stateType Brakereport501::brake_en_state(
     const std::uint8_t* bytes, int32_t length) const {
-  Byte t0(bytes + 0);
-  int32_t x = t0.get_byte(0, 2);
+  int32_t x = CanSignal<1, 2, true, false>::Decode(bytes);
 
   Brake_report_501::Brake_en_stateType ret =
       static_cast<Brake_report_501::Brake_en_stateType>(x);
@@ -16,13 +16,13 @@
 
 #include "modules/canbus/vehicle/devkit/protocol/gear_command_103.h"
 
-#include "modules/drivers/canbus/common/byte.h"
+#include "modules/drivers/canbus/common/can_signal.h"
 
 namespace apollo {
 namespace canbus {
 namespace devkit {
 
-using ::apollo::drivers::canbus::Byte;
+using ::apollo::drivers::canbus::CanSignal;
 
 const int32_t Gearcommand103::ID = 0x103;
 
@@ -65,8 +65,7 @@ void Gearcommand103::set_p_gear_target(
     uint8_t* data, Gear_command_103::Gear_targetType gear_target) {
   int x = gear_target;
 
-  Byte to_set(data + 1);
-  to_set.set_value(x, 0, 3);
+  CanSignal<10, 3, true, false>::Encode(data, x);
 }
 
 Gearcommand103* Gearcommand103::set_gear_en_ctrl(
@@ -83,8 +82,7 @@ void Gearcommand103::set_p_gear_en_ctrl(
     uint8_t* data, Gear_command_103::Gear_en_ctrlType gear_en_ctrl) {
   int x = gear_en_ctrl;
 
-  Byte to_set(data + 0);
-  to_set.set_value(x, 0, 1);
+  CanSignal<0, 1, true, false>::Encode(data, x);
 }
 
 Gearcommand103* Gearcommand103::set_checksum_103(int checksum_103) {
@@ -99,8 +97,7 @@ void Gearcommand103::set_p_checksum_103(uint8_t* data, int checksum_103) {
   checksum_103 = ProtocolData::BoundedValue(0, 255, checksum_103);
   int x = checksum_103;
 
-  Byte to_set(data + 7);
-  to_set.set_value(x, 0, 8);
+  CanSignal<63, 8, true, false>::Encode(data, x);
 }
 
 }  // namespace devkit
@@ -17,14 +17,14 @@
 #include "modules/canbus/vehicle/devkit/protocol/gear_report_503.h"
 
 #include "glog/logging.h"
-#include "modules/drivers/canbus/common/byte.h"
+#include "modules/drivers/canbus/common/can_signal.h"
 #include "modules/drivers/canbus/common/canbus_consts.h"
 
 namespace apollo {
 namespace canbus {
 namespace devkit {
 
-using ::apollo::drivers::canbus::Byte;
+using ::apollo::drivers::canbus::CanSignal;
 
 Gearreport503::Gearreport503() {}
 const int32_t Gearreport503::ID = 0x503;
@@ -43,8 +43,7 @@ void Gearreport503::Parse(const std::uint8_t* bytes, int32_t length,
 // 'motorola', 'physical_unit': ''}
 Gear_report_503::Gear_fltType Gearreport503::gear_flt(const std::uint8_t* bytes,
                                                       int32_t length) const {
-  Byte t0(bytes + 1);
-  int32_t x = t0.get_byte(0, 8);
+  int32_t x = CanSignal<15, 8, true, false>::Decode(bytes);
 
   Gear_report_503::Gear_fltType ret =
       static_cast<Gear_report_503::Gear_fltType>(x);
@@ -58,8 +57,7 @@ Gear_report_503::Gear_fltType Gearreport503::gear_flt(const std::uint8_t* bytes,
 // 'motorola', 'physical_unit': ''}
 Gear_report_503::Gear_actualType Gearreport503::gear_actual(
     const std::uint8_t* bytes, int32_t length) const {
-  Byte t0(bytes + 0);
-  int32_t x = t0.get_byte(0, 3);
+  int32_t x = CanSignal<2, 3, true, false>::Decode(bytes);
 
   Gear_report_503::Gear_actualType ret =
       static_cast<Gear_report_503::Gear_actualType>(x);
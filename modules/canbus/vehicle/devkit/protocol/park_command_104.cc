@@ -16,13 +16,13 @@
 
 #include "modules/canbus/vehicle/devkit/protocol/park_command_104.h"
 
-#include "modules/drivers/canbus/common/byte.h"
+#include "modules/drivers/canbus/common/can_signal.h"
 
 namespace apollo {
 namespace canbus {
 namespace devkit {
 
-using ::apollo::drivers::canbus::Byte;
+using ::apollo::drivers::canbus::CanSignal;
 
 const int32_t Parkcommand104::ID = 0x104;
 
@@ -62,8 +62,7 @@ void Parkcommand104::set_p_checksum_104(uint8_t* data, int checksum_104) {
   checksum_104 = ProtocolData::BoundedValue(0, 255, checksum_104);
   int x = checksum_104;
 
-  Byte to_set(data + 7);
-  to_set.set_value(x, 0, 8);
+  CanSignal<63, 8, true, false>::Encode(data, x);
 }
 
 Parkcommand104* Parkcommand104::set_park_target(
@@ -80,8 +79,7 @@ void Parkcommand104::set_p_park_target(
     uint8_t* data, Park_command_104::Park_targetType park_target) {
   int x = park_target;
 
-  Byte to_set(data + 1);
-  to_set.set_value(x, 0, 1);
+  CanSignal<8, 1, true, false>::Encode(data, x);
 }
 
 Parkcommand104* Parkcommand104::set_park_en_ctrl(
@@ -98,8 +96,7 @@ void Parkcommand104::set_p_park_en_ctrl(
     uint8_t* data, Park_command_104::Park_en_ctrlType park_en_ctrl) {
   int x = park_en_ctrl;
 
-  Byte to_set(data + 0);
-  to_set.set_value(x, 0, 1);
+  CanSignal<0, 1, true, false>::Encode(data, x);
 }
 
 }  // namespace devkit
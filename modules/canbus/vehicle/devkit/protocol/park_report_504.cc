@@ -17,14 +17,14 @@
 #include "modules/canbus/vehicle/devkit/protocol/park_report_504.h"
 
 #include "glog/logging.h"
-#include "modules/drivers/canbus/common/byte.h"
+#include "modules/drivers/canbus/common/can_signal.h"
 #include "modules/drivers/canbus/common/canbus_consts.h"
 
 namespace apollo {
 namespace canbus {
 namespace devkit {
 
-using ::apollo::drivers::canbus::Byte;
+using ::apollo::drivers::canbus::CanSignal;
 
 Parkreport504::Parkreport504() {}
 const int32_t Parkreport504::ID = 0x504;
@@ -44,8 +44,7 @@ void Parkreport504::Parse(const std::uint8_t* bytes, int32_t length,
 // 'physical_unit': ''}
 Park_report_504::Parking_actualType Parkreport504::parking_actual(
     const std::uint8_t* bytes, int32_t length) const {
-  Byte t0(bytes + 0);
-  int32_t x = t0.get_byte(0, 1);
+  int32_t x = CanSignal<0, 1, true, false>::Decode(bytes);
 
   Park_report_504::Parking_actualType ret =
       static_cast<Park_report_504::Parking_actualType>(x);
@@ -58,8 +57,7 @@ Park_report_504::Parking_actualType Parkreport504::parking_actual(
 // 'motorola', 'physical_unit': ''}
 Park_report_504::Park_fltType Parkreport504::park_flt(const std::uint8_t* bytes,
                                                       int32_t length) const {
-  Byte t0(bytes + 1);
-  int32_t x = t0.get_byte(0, 8);
+  int32_t x = CanSignal<15, 8, true, false>::Decode(bytes);
 
   Park_report_504::Park_fltType ret =
       static_cast<Park_report_504::Park_fltType>(x);
@@ -16,13 +16,13 @@
 
 #include "modules/canbus/vehicle/devkit/protocol/steering_command_102.h"
 
-#include "modules/drivers/canbus/common/byte.h"
+#include "modules/drivers/canbus/common/can_signal.h"
 
 namespace apollo {
 namespace canbus {
 namespace devkit {
 
-using ::apollo::drivers::canbus::Byte;
+using ::apollo::drivers::canbus::CanSignal;
 
 const int32_t Steeringcommand102::ID = 0x102;
 
@@ -66,8 +66,7 @@ void Steeringcommand102::set_p_steer_en_ctrl(
     uint8_t* data, Steering_command_102::Steer_en_ctrlType steer_en_ctrl) {
   int x = steer_en_ctrl;
 
-  Byte to_set(data + 0);
-  to_set.set_value(x, 0, 1);
+  CanSignal<0, 1, true, false>::Encode(data, x);
 }
 
 Steeringcommand102* Steeringcommand102::set_steer_angle_target(
@@ -84,16 +83,8 @@ void Steeringcommand102::set_p_steer_angle_target(uint8_t* data,
   steer_angle_target =
       ProtocolData::BoundedValue(-500.0, 500.0, steer_angle_target);
   int x = (steer_angle_target - -500.000000) / 0.100000;
-  uint8_t t = 0;
 
-  t = x & 0xFF;
-  Byte to_set0(data + 4);
-  to_set0.set_value(t, 0, 8);
-  x >>= 8;
-
-  t = x & 0xFF;
-  Byte to_set1(data + 3);
-  to_set1.set_value(t, 0, 8);
+  CanSignal<31, 16, true, false>::Encode(data, x);
 }
 
 Steeringcommand102* Steeringcommand102::set_steer_angle_spd(
@@ -110,8 +101,7 @@ void Steeringcommand102::set_p_steer_angle_spd(uint8_t* data,
   steer_angle_spd = ProtocolData::BoundedValue(0, 250, steer_angle_spd);
   int x = steer_angle_spd;
 
-  Byte to_set(data + 1);
-  to_set.set_value(x, 0, 8);
+  CanSignal<15, 8, true, false>::Encode(data, x);
 }
 
 Steeringcommand102* Steeringcommand102::set_checksum_102(int checksum_102) {
@@ -126,8 +116,7 @@ void Steeringcommand102::set_p_checksum_102(uint8_t* data, int checksum_102) {
   checksum_102 = ProtocolData::BoundedValue(0, 255, checksum_102);
   int x = checksum_102;
 
-  Byte to_set(data + 7);
-  to_set.set_value(x, 0, 8);
+  CanSignal<63, 8, true, false>::Encode(data, x);
 }
 
 }  // namespace devkit
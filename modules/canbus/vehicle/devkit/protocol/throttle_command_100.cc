@@ -16,13 +16,13 @@
 
 #include "modules/canbus/vehicle/devkit/protocol/throttle_command_100.h"
 
-#include "modules/drivers/canbus/common/byte.h"
+#include "modules/drivers/canbus/common/can_signal.h"
 
 namespace apollo {
 namespace canbus {
 namespace devkit {
 
-using ::apollo::drivers::canbus::Byte;
+using ::apollo::drivers::canbus::CanSignal;
 
 const int32_t Throttlecommand100::ID = 0x100;
 
@@ -64,16 +64,8 @@ void Throttlecommand100::set_p_throttle_acc(uint8_t* data,
                                             double throttle_acc) {
   throttle_acc = ProtocolData::BoundedValue(0.0, 10.0, throttle_acc);
   int x = throttle_acc / 0.010000;
-  uint8_t t = 0;
 
-  t = x & 0x3;
-  Byte to_set0(data + 2);
-  to_set0.set_value(t, 6, 2);
-  x >>= 2;
-
-  t = x & 0xFF;
-  Byte to_set1(data + 1);
-  to_set1.set_value(t, 0, 8);
+  CanSignal<15, 10, true, false>::Encode(data, x);
 }
 
 Throttlecommand100* Throttlecommand100::set_checksum_100(int checksum_100) {
@@ -88,8 +80,7 @@ void Throttlecommand100::set_p_checksum_100(uint8_t* data, int checksum_100) {
   checksum_100 = ProtocolData::BoundedValue(0, 255, checksum_100);
   int x = checksum_100;
 
-  Byte to_set(data + 7);
-  to_set.set_value(x, 0, 8);
+  CanSignal<63, 8, true, false>::Encode(data, x);
 }
 
 Throttlecommand100* Throttlecommand100::set_throttle_pedal_target(
@@ -106,16 +97,8 @@ void Throttlecommand100::set_p_throttle_pedal_target(
   throttle_pedal_target =
       ProtocolData::BoundedValue(0.0, 100.0, throttle_pedal_target);
   int x = throttle_pedal_target / 0.100000;
-  uint8_t t = 0;
-
-  t = x & 0xFF;
-  Byte to_set0(data + 4);
-  to_set0.set_value(t, 0, 8);
-  x >>= 8;
 
-  t = x & 0xFF;
-  Byte to_set1(data + 3);
-  to_set1.set_value(t, 0, 8);
+  CanSignal<31, 16, true, false>::Encode(data, x);
 }
 
 Throttlecommand100* Throttlecommand100::set_throttle_en_ctrl(
@@ -133,8 +116,7 @@ void Throttlecommand100::set_p_throttle_en_ctrl(
     Throttle_command_100::Throttle_en_ctrlType throttle_en_ctrl) {
   int x = throttle_en_ctrl;
 
-  Byte to_set(data + 0);
-  to_set.set_value(x, 0, 1);
+  CanSignal<0, 1, true, false>::Encode(data, x);
 }
 
 }  // namespace devkit
@@ -17,14 +17,14 @@
 #include "modules/canbus/vehicle/devkit/protocol/throttle_report_500.h"
 
 #include "glog/logging.h"
-#include "modules/drivers/canbus/common/byte.h"
+#include "modules/drivers/canbus/common/can_signal.h"
 #include "modules/drivers/canbus/common/canbus_consts.h"
 
 namespace apollo {
 namespace canbus {
 namespace devkit {
 
-using ::apollo::drivers::canbus::Byte;
+using ::apollo::drivers::canbus::CanSignal;
 
 Throttlereport500::Throttlereport500() {}
 const int32_t Throttlereport500::ID = 0x500;
@@ -50,13 +50,7 @@ void Throttlereport500::Parse(const std::uint8_t* bytes, int32_t length,
 // 31, 'type': 'double', 'order': 'motorola', 'physical_unit': '%'}
 double Throttlereport500::throttle_pedal_actual(const std::uint8_t* bytes,
                                                 int32_t length) const {
-  Byte t0(bytes + 3);
-  int32_t x = t0.get_byte(0, 8);
-
-  Byte t1(bytes + 4);
-  int32_t t = t1.get_byte(0, 8);
-  x <<= 8;
-  x |= t;
+  int32_t x = CanSignal<31, 16, true, false>::Decode(bytes);
 
   double ret = x * 0.100000;
   return ret;
@@ -70,8 +64,7 @@ double Throttlereport500::throttle_pedal_actual(const std::uint8_t* bytes,
 // 'physical_unit': ''}
 Throttle_report_500::Throttle_flt2Type Throttlereport500::throttle_flt2(
     const std::uint8_t* bytes, int32_t length) const {
-  Byte t0(bytes + 2);
-  int32_t x = t0.get_byte(0, 8);
+  int32_t x = CanSignal<23, 8, true, false>::Decode(bytes);
 
   Throttle_report_500::Throttle_flt2Type ret =
       static_cast<Throttle_report_500::Throttle_flt2Type>(x);
@@ -85,8 +78,7 @@ Throttle_report_500::Throttle_flt2Type Throttlereport500::throttle_flt2(
 // 'motorola', 'physical_unit': ''}
 Throttle_report_500::Throttle_flt1Type Throttlereport500::throttle_flt1(
     const std::uint8_t* bytes, int32_t length) const {
-  Byte t0(bytes + 1);
-  int32_t x = t0.get_byte(0, 8);
+  int32_t x = CanSignal<15, 8, true, false>::Decode(bytes);
 
   Throttle_report_500::Throttle_flt1Type ret =
       static_cast<Throttle_report_500::Throttle_flt1Type>(x);
@@ -101,8 +93,7 @@ Throttle_report_500::Throttle_flt1Type Throttlereport500::throttle_flt1(
 // 'physical_unit': ''}
 Throttle_report_500::Throttle_en_stateType Throttlereport500::throttle_en_state(
     const std::uint8_t* bytes, int32_t length) const {
-  Byte t0(bytes + 0);
-  int32_t x = t0.get_byte(0, 2);
+  int32_t x = CanSignal<1, 2, true, false>::Decode(bytes);
 
   Throttle_report_500::Throttle_en_stateType ret =
       static_cast<Throttle_report_500::Throttle_en_stateType>(x);
@@ -17,14 +17,14 @@
 #include "modules/canbus/vehicle/devkit/protocol/ultr_sensor_2_508.h"
 
 #include "glog/logging.h"
-#include "modules/drivers/canbus/common/byte.h"
+#include "modules/drivers/canbus/common/can_signal.h"
 #include "modules/drivers/canbus/common/canbus_consts.h"
 
 namespace apollo {
 namespace canbus {
 namespace devkit {
 
-using ::apollo::drivers::canbus::Byte;
+using ::apollo::drivers::canbus::CanSignal;
 
 Ultrsensor2508::Ultrsensor2508() {}
 const int32_t Ultrsensor2508::ID = 0x508;
@@ -50,13 +50,7 @@ void Ultrsensor2508::Parse(const std::uint8_t* bytes, int32_t length,
 // 'bit': 23, 'type': 'double', 'order': 'motorola', 'physical_unit': 'cm'}
 double Ultrsensor2508::uiuss9_tof_indirect(const std::uint8_t* bytes,
                                            int32_t length) const {
-  Byte t0(bytes + 2);
-  int32_t x = t0.get_byte(0, 8);
-
-  Byte t1(bytes + 3);
-  int32_t t = t1.get_byte(0, 8);
-  x <<= 8;
-  x |= t;
+  int32_t x = CanSignal<23, 16, true, false>::Decode(bytes);
 
   double ret = x / 58;
   return ret;
@@ -67,13 +61,7 @@ double Ultrsensor2508::uiuss9_tof_indirect(const std::uint8_t* bytes,
 // 'bit': 7, 'type': 'double', 'order': 'motorola', 'physical_unit': 'cm'}
 double Ultrsensor2508::uiuss8_tof_indirect(const std::uint8_t* bytes,
                                            int32_t length) const {
-  Byte t0(bytes + 0);
-  int32_t x = t0.get_byte(0, 8);
-
-  Byte t1(bytes + 1);
-  int32_t t = t1.get_byte(0, 8);
-  x <<= 8;
-  x |= t;
+  int32_t x = CanSignal<7, 16, true, false>::Decode(bytes);
 
   double ret = x / 58;
   return ret;
@@ -84,13 +72,7 @@ double Ultrsensor2508::uiuss8_tof_indirect(const std::uint8_t* bytes,
 // 'bit': 55, 'type': 'double', 'order': 'motorola', 'physical_unit': 'cm'}
 double Ultrsensor2508::uiuss11_tof_indirect(const std::uint8_t* bytes,
                                             int32_t length) const {
-  Byte t0(bytes + 6);
-  int32_t x = t0.get_byte(0, 8);
-
-  Byte t1(bytes + 7);
-  int32_t t = t1.get_byte(0, 8);
-  x <<= 8;
-  x |= t;
+  int32_t x = CanSignal<55, 16, true, false>::Decode(bytes);
 
   double ret = x / 58;
   return ret;
@@ -101,13 +83,7 @@ double Ultrsensor2508::uiuss11_tof_indirect(const std::uint8_t* bytes,
 // 'bit': 39, 'type': 'double', 'order': 'motorola', 'physical_unit': 'cm'}
 double Ultrsensor2508::uiuss10_tof_indirect(const std::uint8_t* bytes,
                                             int32_t length) const {
-  Byte t0(bytes + 4);
-  int32_t x = t0.get_byte(0, 8);
-
-  Byte t1(bytes + 5);
-  int32_t t = t1.get_byte(0, 8);
-  x <<= 8;
-  x |= t;
+  int32_t x = CanSignal<39, 16, true, false>::Decode(bytes);
 
   double ret = x / 58;
   return ret;
@@ -17,14 +17,14 @@
 #include "modules/canbus/vehicle/devkit/protocol/vcu_report_505.h"
 
 #include "glog/logging.h"
-#include "modules/drivers/canbus/common/byte.h"
+#include "modules/drivers/canbus/common/can_signal.h"
 #include "modules/drivers/canbus/common/canbus_consts.h"
 
 namespace apollo {
 namespace canbus {
 namespace devkit {
 
-using ::apollo::drivers::canbus::Byte;
+using ::apollo::drivers::canbus::CanSignal;
 
 Vcureport505::Vcureport505() {}
 const int32_t Vcureport505::ID = 0x505;
@@ -53,8 +53,7 @@ void Vcureport505::Parse(const std::uint8_t* bytes, int32_t length,
 // 'type': 'enum', 'order': 'motorola', 'physical_unit': ''}
 Vcu_report_505::Vehicle_mode_stateType Vcureport505::vehicle_mode_state(
     const std::uint8_t* bytes, int32_t length) const {
-  Byte t0(bytes + 4);
-  int32_t x = t0.get_byte(3, 2);
+  int32_t x = CanSignal<36, 2, true, false>::Decode(bytes);
 
   Vcu_report_505::Vehicle_mode_stateType ret =
       static_cast<Vcu_report_505::Vehicle_mode_stateType>(x);
@@ -68,8 +67,7 @@ Vcu_report_505::Vehicle_mode_stateType Vcureport505::vehicle_mode_state(
 // 'physical_unit': ''}
 Vcu_report_505::Frontcrash_stateType Vcureport505::frontcrash_state(
     const std::uint8_t* bytes, int32_t length) const {
-  Byte t0(bytes + 4);
-  int32_t x = t0.get_byte(1, 1);
+  int32_t x = CanSignal<33, 1, true, false>::Decode(bytes);
 
   Vcu_report_505::Frontcrash_stateType ret =
       static_cast<Vcu_report_505::Frontcrash_stateType>(x);
@@ -83,8 +81,7 @@ Vcu_report_505::Frontcrash_stateType Vcureport505::frontcrash_state(
 // 'physical_unit': ''}
 Vcu_report_505::Backcrash_stateType Vcureport505::backcrash_state(
     const std::uint8_t* bytes, int32_t length) const {
-  Byte t0(bytes + 4);
-  int32_t x = t0.get_byte(2, 1);
+  int32_t x = CanSignal<34, 1, true, false>::Decode(bytes);
 
   Vcu_report_505::Backcrash_stateType ret =
       static_cast<Vcu_report_505::Backcrash_stateType>(x);
@@ -97,8 +94,7 @@ Vcu_report_505::Backcrash_stateType Vcureport505::backcrash_state(
 // 'motorola', 'physical_unit': ''}
 Vcu_report_505::Aeb_stateType Vcureport505::aeb_state(const std::uint8_t* bytes,
                                                       int32_t length) const {
-  Byte t0(bytes + 4);
-  int32_t x = t0.get_byte(0, 1);
+  int32_t x = CanSignal<32, 1, true, false>::Decode(bytes);
 
   Vcu_report_505::Aeb_stateType ret =
       static_cast<Vcu_report_505::Aeb_stateType>(x);
@@ -109,16 +105,7 @@ Vcu_report_505::Aeb_stateType Vcureport505::aeb_state(const std::uint8_t* bytes,
 // 'is_signed_var': True, 'physical_range': '[-10|10]', 'bit': 7, 'type':
 // 'double', 'order': 'motorola', 'physical_unit': 'm/s^2'}
 double Vcureport505::acc(const std::uint8_t* bytes, int32_t length) const {
-  Byte t0(bytes + 0);
-  int32_t x = t0.get_byte(0, 8);
-
-  Byte t1(bytes + 1);
-  int32_t t = t1.get_byte(4, 4);
-  x <<= 4;
-  x |= t;
-
-  x <<= 20;
-  x >>= 20;
+  int32_t x = CanSignal<7, 12, true, true>::Decode(bytes);
 
   double ret = x * 0.010000;
   return ret;
@@ -128,13 +115,7 @@ double Vcureport505::acc(const std::uint8_t* bytes, int32_t length) const {
 // 16, 'is_signed_var': False, 'physical_range': '[0|65.535]', 'bit': 23,
 // 'type': 'double', 'order': 'motorola', 'physical_unit': 'm/s'}
 double Vcureport505::speed(const std::uint8_t* bytes, int32_t length) const {
-  Byte t0(bytes + 2);
-  int32_t x = t0.get_byte(0, 8);
-
-  Byte t1(bytes + 3);
-  int32_t t = t1.get_byte(0, 8);
-  x <<= 8;
-  x |= t;
+  int32_t x = CanSignal<23, 16, true, false>::Decode(bytes);
 
   double ret = x * 0.001000;
   return ret;
@@ -17,98 +17,243 @@
 
 #include <sqlite3.h>
 
+#include <mutex>
+#include <unordered_map>
+
 #include "gflags/gflags.h"
 
-#include "absl/strings/str_cat.h"
 #include "cyber/common/log.h"
-#include "modules/common/util/util.h"
 
 DEFINE_string(kv_db_path, "/apollo/data/kv_db.sqlite",
               "Path to Key-value DB file.");
+DEFINE_bool(kv_db_wal_mode, false,
+            "Open the Key-value DB in write-ahead-log mode, so writes sync "
+            "the disk less often and do not block readers.");
 
 namespace apollo {
 namespace common {
 namespace {
 
-// Self-maintained sqlite instance.
+// Process-wide sqlite connection with prepared statements, and a cache of
+// the values read. The cache is dropped when another connection, e.g. from
+// another process, changes the DB.
 class SqliteWraper {
  public:
-  static int Callback(void *data, int argc, char **argv, char **col_name) {
-    if (data != nullptr) {
-      std::string *data_str = static_cast<std::string *>(data);
-      *data_str = argc > 0 ? argv[0] : "";
+  static SqliteWraper *Instance() {
+    static SqliteWraper instance;
+    return &instance;
+  }
+
+  ~SqliteWraper() { Release(); }
+
+  bool Put(const std::vector<std::pair<std::string, std::string>> &kvs) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!Open()) {
+      return false;
+    }
+    const bool batch = kvs.size() > 1;
+    // one transaction syncs the disk once for the whole batch
+    if (batch && !SQL("BEGIN IMMEDIATE;")) {
+      return false;
+    }
+    for (const auto &kv : kvs) {
+      sqlite3_bind_text(put_stmt_, 1, kv.first.data(),
+                        static_cast<int>(kv.first.size()), SQLITE_STATIC);
+      sqlite3_bind_text(put_stmt_, 2, kv.second.data(),
+                        static_cast<int>(kv.second.size()), SQLITE_STATIC);
+      if (!Step(put_stmt_)) {
+        if (batch) {
+          SQL("ROLLBACK;");
+        }
+        return false;
+      }
+    }
+    if (batch && !SQL("COMMIT;")) {
+      SQL("ROLLBACK;");
+      return false;
+    }
+    for (const auto &kv : kvs) {
+      cache_[kv.first] = kv.second;
+    }
+    return true;
+  }
+
+  bool Delete(std::string_view key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!Open()) {
+      return false;
+    }
+    sqlite3_bind_text(delete_stmt_, 1, key.data(),
+                      static_cast<int>(key.size()), SQLITE_STATIC);
+    if (!Step(delete_stmt_)) {
+      return false;
+    }
+    cache_[std::string(key)].reset();
+    return true;
+  }
+
+  bool Get(std::string_view key, std::optional<std::string> *value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!Open()) {
+      return false;
+    }
+    SyncCache();
+    std::string key_str(key);
+    auto iter = cache_.find(key_str);
+    if (iter != cache_.end()) {
+      *value = iter->second;
+      return true;
+    }
+
+    sqlite3_bind_text(get_stmt_, 1, key.data(), static_cast<int>(key.size()),
+                      SQLITE_STATIC);
+    const int ret = sqlite3_step(get_stmt_);
+    if (ret == SQLITE_ROW) {
+      const auto *text = sqlite3_column_text(get_stmt_, 0);
+      value->emplace(text == nullptr ? ""
+                                     : reinterpret_cast<const char *>(text));
+    } else {
+      value->reset();
+    }
+    sqlite3_reset(get_stmt_);
+    sqlite3_clear_bindings(get_stmt_);
+    if (ret != SQLITE_ROW && ret != SQLITE_DONE) {
+      AERROR << "Failed to get " << key_str << ": " << sqlite3_errmsg(db_);
+      return false;
     }
-    return 0;
+    cache_.emplace(std::move(key_str), *value);
+    return true;
   }
 
-  SqliteWraper() {
-    // Open DB.
-    if (sqlite3_open(FLAGS_kv_db_path.c_str(), &db_) != 0) {
+ private:
+  SqliteWraper() = default;
+
+  // Opens the DB on first use, or again if FLAGS_kv_db_path changed.
+  bool Open() {
+    if (db_ != nullptr && path_ == FLAGS_kv_db_path) {
+      return true;
+    }
+    Release();
+    path_ = FLAGS_kv_db_path;
+    if (sqlite3_open(path_.c_str(), &db_) != SQLITE_OK) {
       AERROR << "Can't open Key-Value database: " << sqlite3_errmsg(db_);
       Release();
-      return;
+      return false;
+    }
+    // wait for writers of other processes instead of failing
+    sqlite3_busy_timeout(db_, 1000);
+    if (FLAGS_kv_db_wal_mode && (!SQL("PRAGMA journal_mode=WAL;") ||
+                                 !SQL("PRAGMA synchronous=NORMAL;"))) {
+      AWARN << "Failed to enable WAL mode for " << path_;
     }
 
     // Create table if it doesn't exist.
     static const char *kCreateTableSql =
         "CREATE TABLE IF NOT EXISTS key_value "
         "(key VARCHAR(128) PRIMARY KEY NOT NULL, value TEXT);";
-    if (!SQL(kCreateTableSql)) {
+    if (!SQL(kCreateTableSql) ||
+        !Prepare("INSERT OR REPLACE INTO key_value (key, value) "
+                 "VALUES (?, ?);",
+                 &put_stmt_) ||
+        !Prepare("SELECT value FROM key_value WHERE key=?;", &get_stmt_) ||
+        !Prepare("DELETE FROM key_value WHERE key=?;", &delete_stmt_) ||
+        !Prepare("PRAGMA data_version;", &data_version_stmt_)) {
       Release();
+      return false;
     }
+    return true;
   }
 
-  ~SqliteWraper() { Release(); }
+  void Release() {
+    for (auto **stmt :
+         {&put_stmt_, &get_stmt_, &delete_stmt_, &data_version_stmt_}) {
+      sqlite3_finalize(*stmt);
+      *stmt = nullptr;
+    }
+    if (db_ != nullptr) {
+      sqlite3_close(db_);
+      db_ = nullptr;
+    }
+    cache_.clear();
+    data_version_ = -1;
+  }
 
-  bool SQL(std::string_view sql, std::string *value = nullptr) {
-    AINFO << "Executing SQL: " << sql;
-    if (db_ == nullptr) {
-      AERROR << "DB is not open properly.";
+  bool Prepare(const char *sql, sqlite3_stmt **stmt) {
+    if (sqlite3_prepare_v2(db_, sql, -1, stmt, nullptr) != SQLITE_OK) {
+      AERROR << "Failed to prepare SQL " << sql << ": "
+             << sqlite3_errmsg(db_);
       return false;
     }
+    return true;
+  }
 
+  bool SQL(const char *sql) {
+    ADEBUG << "Executing SQL: " << sql;
     char *error = nullptr;
-    if (sqlite3_exec(db_, sql.data(), Callback, value, &error) != SQLITE_OK) {
-      AERROR << "Failed to execute SQL: " << error;
+    if (sqlite3_exec(db_, sql, nullptr, nullptr, &error) != SQLITE_OK) {
+      AERROR << "Failed to execute SQL " << sql << ": " << error;
       sqlite3_free(error);
       return false;
     }
     return true;
   }
 
- private:
-  void Release() {
-    if (db_ != nullptr) {
-      sqlite3_close(db_);
-      db_ = nullptr;
+  // Runs a statement without result rows.
+  bool Step(sqlite3_stmt *stmt) {
+    const bool ok = sqlite3_step(stmt) == SQLITE_DONE;
+    if (!ok) {
+      AERROR << "Failed to execute SQL " << sqlite3_sql(stmt) << ": "
+             << sqlite3_errmsg(db_);
     }
+    sqlite3_reset(stmt);
+    sqlite3_clear_bindings(stmt);
+    return ok;
   }
 
+  // Drops the cache if another connection committed since the last check.
+  void SyncCache() {
+    int data_version = -1;
+    if (sqlite3_step(data_version_stmt_) == SQLITE_ROW) {
+      data_version = sqlite3_column_int(data_version_stmt_, 0);
+    }
+    sqlite3_reset(data_version_stmt_);
+    if (data_version == -1 || data_version != data_version_) {
+      cache_.clear();
+    }
+    data_version_ = data_version;
+  }
+
+  std::mutex mutex_;
+  std::string path_;
   sqlite3 *db_ = nullptr;
+  sqlite3_stmt *put_stmt_ = nullptr;
+  sqlite3_stmt *get_stmt_ = nullptr;
+  sqlite3_stmt *delete_stmt_ = nullptr;
+  sqlite3_stmt *data_version_stmt_ = nullptr;
+  int data_version_ = -1;
+  std::unordered_map<std::string, std::optional<std::string>> cache_;
 };
 
 }  // namespace
 
 bool KVDB::Put(std::string_view key, std::string_view value) {
-  SqliteWraper sqlite;
-  return sqlite.SQL(
-      absl::StrCat("INSERT OR REPLACE INTO key_value (key, value) VALUES ('",
-                   key, "', '", value, "');"));
+  return SqliteWraper::Instance()->Put(
+      {{std::string(key), std::string(value)}});
+}
+
+bool KVDB::Put(
+    const std::vector<std::pair<std::string, std::string>> &key_values) {
+  return key_values.empty() || SqliteWraper::Instance()->Put(key_values);
 }
 
 bool KVDB::Delete(std::string_view key) {
-  SqliteWraper sqlite;
-  return sqlite.SQL(
-      absl::StrCat("DELETE FROM key_value WHERE key='", key, "';"));
+  return SqliteWraper::Instance()->Delete(key);
 }
 
 std::optional<std::string> KVDB::Get(std::string_view key) {
-  SqliteWraper sqlite;
-  std::string value;
-  const bool ret = sqlite.SQL(
-      absl::StrCat("SELECT value FROM key_value WHERE key='", key, "';"),
-      &value);
-  if (ret && !value.empty()) {
+  std::optional<std::string> value;
+  if (SqliteWraper::Instance()->Get(key, &value) && value.has_value() &&
+      !value->empty()) {
     return value;
   }
   return {};
@@ -17,6 +17,8 @@
 #pragma once
 
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "modules/common/util/future.h"
 
@@ -41,6 +43,13 @@ class KVDB {
    */
   static bool Put(std::string_view key, std::string_view value);
 
+  /**
+   * @brief Store all the {key, value} pairs to DB in one transaction.
+   * @return Success or not. Nothing is stored on failure.
+   */
+  static bool Put(
+      const std::vector<std::pair<std::string, std::string>>& key_values);
+
   /**
    * @brief Delete a key.
    * @return Success or not.
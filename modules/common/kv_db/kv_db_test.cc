@@ -15,10 +15,15 @@
  *****************************************************************************/
 #include "modules/common/kv_db/kv_db.h"
 
+#include <sqlite3.h>
+
 #include <thread>
 
+#include "gflags/gflags.h"
 #include "gtest/gtest.h"
 
+DECLARE_string(kv_db_path);
+
 namespace apollo {
 namespace common {
 
@@ -39,6 +44,34 @@ TEST(KVDBTest, CRUD) {
   EXPECT_FALSE(KVDB::Get("test_key").has_value());
 }
 
+TEST(KVDBTest, Batch) {
+  EXPECT_TRUE(KVDB::Put({{"test_key0", "val0"}, {"test_key1", "it's"}}));
+  EXPECT_EQ("val0", KVDB::Get("test_key0").value());
+  EXPECT_EQ("it's", KVDB::Get("test_key1").value());
+  EXPECT_TRUE(KVDB::Delete("test_key0"));
+  EXPECT_TRUE(KVDB::Delete("test_key1"));
+  EXPECT_FALSE(KVDB::Get("test_key0").has_value());
+  EXPECT_FALSE(KVDB::Get("test_key1").has_value());
+}
+
+TEST(KVDBTest, ExternalWrite) {
+  EXPECT_TRUE(KVDB::Put("test_key", "val0"));
+  EXPECT_EQ("val0", KVDB::Get("test_key").value());
+
+  // another connection, like kv_db_tool, updates the cached value
+  sqlite3 *db = nullptr;
+  ASSERT_EQ(SQLITE_OK, sqlite3_open(FLAGS_kv_db_path.c_str(), &db));
+  sqlite3_busy_timeout(db, 1000);
+  EXPECT_EQ(SQLITE_OK,
+            sqlite3_exec(db,
+                         "UPDATE key_value SET value='val1' "
+                         "WHERE key='test_key';",
+                         nullptr, nullptr, nullptr));
+  sqlite3_close(db);
+  EXPECT_EQ("val1", KVDB::Get("test_key").value());
+  EXPECT_TRUE(KVDB::Delete("test_key"));
+}
+
 TEST(KVDBTest, MultiThreads) {
   static const int N_THREADS = 10;
 
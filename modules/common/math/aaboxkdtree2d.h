@@ -16,14 +16,14 @@
 
 /**
  * @file
- * @brief Defines the templated AABoxKDTree2dNode class.
+ * @brief Defines the templated AABoxKDTree2d class.
  */
 
 #pragma once
 
 #include <algorithm>
+#include <cmath>
 #include <limits>
-#include <memory>
 #include <vector>
 
 #include "cyber/common/log.h"
@@ -53,63 +53,77 @@ struct AABoxKDTreeParams {
 };
 
 /**
- * @class AABoxKDTree2dNode
- * @brief The class of KD-tree node of axis-aligned bounding box.
+ * @class AABoxKDTree2d
+ * @brief The class of KD-tree of Aligned Axis Bounding Box(AABox).
+ *
+ * Nodes are stored in one array in depth-first order, so the left child of a
+ * node is the next element. The objects of all nodes are stored in shared
+ * arrays in the same order, so a node owns a contiguous range of them and the
+ * objects of a whole subtree are contiguous too. Queries walk the arrays by
+ * index instead of chasing per-node heap allocations.
  */
 template <class ObjectType>
-class AABoxKDTree2dNode {
+class AABoxKDTree2d {
  public:
   using ObjectPtr = const ObjectType *;
+
   /**
-   * @brief Constructor which takes a vector of objects,
-   *        parameters and depth of the node.
-   * @param objects Objects to build the KD-tree node.
+   * @brief Constructor which takes a vector of objects and parameters.
    * @param params Parameters to build the KD-tree.
-   * @param depth Depth of the KD-tree node.
    */
-  AABoxKDTree2dNode(const std::vector<ObjectPtr> &objects,
-                    const AABoxKDTreeParams &params, int depth)
-      : depth_(depth) {
-    ACHECK(!objects.empty());
-
-    ComputeBoundary(objects);
-    ComputePartition();
-
-    if (SplitToSubNodes(objects, params)) {
-      std::vector<ObjectPtr> left_subnode_objects;
-      std::vector<ObjectPtr> right_subnode_objects;
-      PartitionObjects(objects, &left_subnode_objects, &right_subnode_objects);
-
-      // Split to sub-nodes.
-      if (!left_subnode_objects.empty()) {
-        left_subnode_.reset(new AABoxKDTree2dNode<ObjectType>(
-            left_subnode_objects, params, depth + 1));
-      }
-      if (!right_subnode_objects.empty()) {
-        right_subnode_.reset(new AABoxKDTree2dNode<ObjectType>(
-            right_subnode_objects, params, depth + 1));
+  AABoxKDTree2d(const std::vector<ObjectType> &objects,
+                const AABoxKDTreeParams &params) {
+    if (!objects.empty()) {
+      std::vector<ObjectPtr> object_ptrs;
+      object_ptrs.reserve(objects.size());
+      for (const auto &object : objects) {
+        object_ptrs.push_back(&object);
       }
-    } else {
-      InitObjects(objects);
+      objects_sorted_by_min_.reserve(objects.size());
+      objects_sorted_by_max_.reserve(objects.size());
+      objects_sorted_by_min_bound_.reserve(objects.size());
+      objects_sorted_by_max_bound_.reserve(objects.size());
+      BuildNode(object_ptrs, params, 0);
     }
   }
 
   /**
-   * @brief Get the nearest object to a target point by the KD-tree
-   *        rooted at this node.
+   * @brief Get the nearest object to a target point.
    * @param point The target point. Search it's nearest object.
    * @return The nearest object to the target point.
    */
   ObjectPtr GetNearestObject(const Vec2d &point) const {
+    if (nodes_.empty()) {
+      return nullptr;
+    }
     ObjectPtr nearest_object = nullptr;
     double min_distance_sqr = std::numeric_limits<double>::infinity();
-    GetNearestObjectInternal(point, &min_distance_sqr, &nearest_object);
+    GetNearestObjectInternal(0, point, &min_distance_sqr, &nearest_object);
+    return nearest_object;
+  }
+
+  /**
+   * @brief Get the nearest object to a target point, starting from a known
+   *        candidate, which makes consecutive queries of nearby points cheap.
+   * @param point The target point. Search it's nearest object.
+   * @param hint A candidate object of this tree, nullptr for no candidate.
+   * @return The nearest object to the target point.
+   */
+  ObjectPtr GetNearestObject(const Vec2d &point, ObjectPtr hint) const {
+    if (nodes_.empty()) {
+      return nullptr;
+    }
+    if (hint == nullptr) {
+      return GetNearestObject(point);
+    }
+    ObjectPtr nearest_object = hint;
+    double min_distance_sqr = hint->DistanceSquareTo(point);
+    GetNearestObjectInternal(0, point, &min_distance_sqr, &nearest_object);
     return nearest_object;
   }
 
   /**
-   * @brief Get objects within a distance to a point by the KD-tree
-   *        rooted at this node.
+   * @brief Get objects within a distance to a point.
    * @param point The center point of the range to search objects.
    * @param distance The radius of the range to search objects.
    * @return All objects within the specified distance to the specified point.
@@ -117,7 +131,23 @@ class AABoxKDTree2dNode {
   std::vector<ObjectPtr> GetObjects(const Vec2d &point,
                                     const double distance) const {
     std::vector<ObjectPtr> result_objects;
-    GetObjectsInternal(point, distance, Square(distance), &result_objects);
+    if (!nodes_.empty()) {
+      GetObjectsInternal(0, point, distance, Square(distance),
+                         &result_objects);
+    }
+    return result_objects;
+  }
+
+  /**
+   * @brief Get objects whose axis-aligned bounding boxes overlap a box.
+   * @param box The axis-aligned box of the range to search objects.
+   * @return All objects whose bounding boxes overlap the specified box.
+   */
+  std::vector<ObjectPtr> GetObjects(const AABox2d &box) const {
+    std::vector<ObjectPtr> result_objects;
+    if (!nodes_.empty()) {
+      GetObjectsInBoxInternal(0, box, &result_objects);
+    }
     return result_objects;
   }
 
@@ -126,106 +156,230 @@ class AABoxKDTree2dNode {
    * @return The axis-aligned bounding box of the objects.
    */
   AABox2d GetBoundingBox() const {
-    return AABox2d({min_x_, min_y_}, {max_x_, max_y_});
+    if (nodes_.empty()) {
+      return AABox2d();
+    }
+    const Node &root = nodes_.front();
+    return AABox2d({root.min_x, root.min_y}, {root.max_x, root.max_y});
   }
 
  private:
-  void InitObjects(const std::vector<ObjectPtr> &objects) {
-    num_objects_ = static_cast<int>(objects.size());
-    objects_sorted_by_min_ = objects;
-    objects_sorted_by_max_ = objects;
-    std::sort(objects_sorted_by_min_.begin(), objects_sorted_by_min_.end(),
+  struct Node {
+    // Boundary
+    double min_x = 0.0;
+    double max_x = 0.0;
+    double min_y = 0.0;
+    double max_y = 0.0;
+    double mid_x = 0.0;
+    double mid_y = 0.0;
+
+    bool partition_x = true;
+    double partition_position = 0.0;
+
+    // indices in nodes_, -1 if absent
+    int left_subnode = -1;
+    int right_subnode = -1;
+
+    // Objects of this node are [objects_begin, objects_begin + num_objects)
+    // and objects of the subtree are [objects_begin, subtree_objects_end) of
+    // the object arrays.
+    int objects_begin = 0;
+    int num_objects = 0;
+    int subtree_objects_end = 0;
+
+    double LowerDistanceSquareToPoint(const Vec2d &point) const {
+      double dx = 0.0;
+      if (point.x() < min_x) {
+        dx = min_x - point.x();
+      } else if (point.x() > max_x) {
+        dx = point.x() - max_x;
+      }
+      double dy = 0.0;
+      if (point.y() < min_y) {
+        dy = min_y - point.y();
+      } else if (point.y() > max_y) {
+        dy = point.y() - max_y;
+      }
+      return dx * dx + dy * dy;
+    }
+
+    double UpperDistanceSquareToPoint(const Vec2d &point) const {
+      const double dx =
+          (point.x() > mid_x ? (point.x() - min_x) : (point.x() - max_x));
+      const double dy =
+          (point.y() > mid_y ? (point.y() - min_y) : (point.y() - max_y));
+      return dx * dx + dy * dy;
+    }
+  };
+
+  int BuildNode(const std::vector<ObjectPtr> &objects,
+                const AABoxKDTreeParams &params, const int depth) {
+    ACHECK(!objects.empty());
+    const int index = static_cast<int>(nodes_.size());
+    nodes_.emplace_back();
+    Node node;
+    ComputeBoundary(objects, &node);
+    ComputePartition(&node);
+    node.objects_begin = static_cast<int>(objects_sorted_by_min_.size());
+
+    if (SplitToSubNodes(objects, params, node, depth)) {
+      std::vector<ObjectPtr> left_subnode_objects;
+      std::vector<ObjectPtr> right_subnode_objects;
+      std::vector<ObjectPtr> other_objects;
+      PartitionObjects(objects, node, &left_subnode_objects,
+                       &right_subnode_objects, &other_objects);
+      AppendObjects(&other_objects, &node);
+      // The objects of this node have to be appended before the sub-nodes,
+      // and nodes_ may be reallocated by them.
+      nodes_[index] = node;
+
+      // Split to sub-nodes.
+      if (!left_subnode_objects.empty()) {
+        const int left_subnode =
+            BuildNode(left_subnode_objects, params, depth + 1);
+        nodes_[index].left_subnode = left_subnode;
+      }
+      if (!right_subnode_objects.empty()) {
+        const int right_subnode =
+            BuildNode(right_subnode_objects, params, depth + 1);
+        nodes_[index].right_subnode = right_subnode;
+      }
+    } else {
+      std::vector<ObjectPtr> leaf_objects = objects;
+      AppendObjects(&leaf_objects, &node);
+      nodes_[index] = node;
+    }
+    nodes_[index].subtree_objects_end =
+        static_cast<int>(objects_sorted_by_min_.size());
+    return index;
+  }
+
+  void AppendObjects(std::vector<ObjectPtr> *const objects, Node *const node) {
+    node->num_objects = static_cast<int>(objects->size());
+    const bool partition_x = node->partition_x;
+    std::sort(objects->begin(), objects->end(),
               [&](ObjectPtr obj1, ObjectPtr obj2) {
-                return partition_ == PARTITION_X
+                return partition_x
                            ? obj1->aabox().min_x() < obj2->aabox().min_x()
                            : obj1->aabox().min_y() < obj2->aabox().min_y();
               });
-    std::sort(objects_sorted_by_max_.begin(), objects_sorted_by_max_.end(),
+    for (ObjectPtr object : *objects) {
+      objects_sorted_by_min_.push_back(object);
+      objects_sorted_by_min_bound_.push_back(
+          partition_x ? object->aabox().min_x() : object->aabox().min_y());
+    }
+    std::sort(objects->begin(), objects->end(),
               [&](ObjectPtr obj1, ObjectPtr obj2) {
-                return partition_ == PARTITION_X
+                return partition_x
                            ? obj1->aabox().max_x() > obj2->aabox().max_x()
                            : obj1->aabox().max_y() > obj2->aabox().max_y();
               });
-    objects_sorted_by_min_bound_.reserve(num_objects_);
-    for (ObjectPtr object : objects_sorted_by_min_) {
-      objects_sorted_by_min_bound_.push_back(partition_ == PARTITION_X
-                                                 ? object->aabox().min_x()
-                                                 : object->aabox().min_y());
-    }
-    objects_sorted_by_max_bound_.reserve(num_objects_);
-    for (ObjectPtr object : objects_sorted_by_max_) {
-      objects_sorted_by_max_bound_.push_back(partition_ == PARTITION_X
-                                                 ? object->aabox().max_x()
-                                                 : object->aabox().max_y());
+    for (ObjectPtr object : *objects) {
+      objects_sorted_by_max_.push_back(object);
+      objects_sorted_by_max_bound_.push_back(
+          partition_x ? object->aabox().max_x() : object->aabox().max_y());
     }
   }
 
-  bool SplitToSubNodes(const std::vector<ObjectPtr> &objects,
-                       const AABoxKDTreeParams &params) {
-    if (params.max_depth >= 0 && depth_ >= params.max_depth) {
+  static bool SplitToSubNodes(const std::vector<ObjectPtr> &objects,
+                              const AABoxKDTreeParams &params,
+                              const Node &node, const int depth) {
+    if (params.max_depth >= 0 && depth >= params.max_depth) {
       return false;
     }
     if (static_cast<int>(objects.size()) <= std::max(1, params.max_leaf_size)) {
       return false;
     }
     if (params.max_leaf_dimension >= 0.0 &&
-        std::max(max_x_ - min_x_, max_y_ - min_y_) <=
+        std::max(node.max_x - node.min_x, node.max_y - node.min_y) <=
             params.max_leaf_dimension) {
       return false;
     }
     return true;
   }
 
-  double LowerDistanceSquareToPoint(const Vec2d &point) const {
-    double dx = 0.0;
-    if (point.x() < min_x_) {
-      dx = min_x_ - point.x();
-    } else if (point.x() > max_x_) {
-      dx = point.x() - max_x_;
-    }
-    double dy = 0.0;
-    if (point.y() < min_y_) {
-      dy = min_y_ - point.y();
-    } else if (point.y() > max_y_) {
-      dy = point.y() - max_y_;
+  static void ComputeBoundary(const std::vector<ObjectPtr> &objects,
+                              Node *const node) {
+    node->min_x = std::numeric_limits<double>::infinity();
+    node->min_y = std::numeric_limits<double>::infinity();
+    node->max_x = -std::numeric_limits<double>::infinity();
+    node->max_y = -std::numeric_limits<double>::infinity();
+    for (ObjectPtr object : objects) {
+      node->min_x = std::fmin(node->min_x, object->aabox().min_x());
+      node->max_x = std::fmax(node->max_x, object->aabox().max_x());
+      node->min_y = std::fmin(node->min_y, object->aabox().min_y());
+      node->max_y = std::fmax(node->max_y, object->aabox().max_y());
     }
-    return dx * dx + dy * dy;
+    node->mid_x = (node->min_x + node->max_x) / 2.0;
+    node->mid_y = (node->min_y + node->max_y) / 2.0;
+    ACHECK(!std::isinf(node->max_x) && !std::isinf(node->max_y) &&
+           !std::isinf(node->min_x) && !std::isinf(node->min_y))
+        << "the provided object box size is infinity";
   }
 
-  double UpperDistanceSquareToPoint(const Vec2d &point) const {
-    const double dx =
-        (point.x() > mid_x_ ? (point.x() - min_x_) : (point.x() - max_x_));
-    const double dy =
-        (point.y() > mid_y_ ? (point.y() - min_y_) : (point.y() - max_y_));
-    return dx * dx + dy * dy;
+  static void ComputePartition(Node *const node) {
+    if (node->max_x - node->min_x >= node->max_y - node->min_y) {
+      node->partition_x = true;
+      node->partition_position = (node->min_x + node->max_x) / 2.0;
+    } else {
+      node->partition_x = false;
+      node->partition_position = (node->min_y + node->max_y) / 2.0;
+    }
   }
 
-  void GetAllObjects(std::vector<ObjectPtr> *const result_objects) const {
-    result_objects->insert(result_objects->end(),
-                           objects_sorted_by_min_.begin(),
-                           objects_sorted_by_min_.end());
-    if (left_subnode_ != nullptr) {
-      left_subnode_->GetAllObjects(result_objects);
-    }
-    if (right_subnode_ != nullptr) {
-      right_subnode_->GetAllObjects(result_objects);
+  static void PartitionObjects(
+      const std::vector<ObjectPtr> &objects, const Node &node,
+      std::vector<ObjectPtr> *const left_subnode_objects,
+      std::vector<ObjectPtr> *const right_subnode_objects,
+      std::vector<ObjectPtr> *const other_objects) {
+    if (node.partition_x) {
+      for (ObjectPtr object : objects) {
+        if (object->aabox().max_x() <= node.partition_position) {
+          left_subnode_objects->push_back(object);
+        } else if (object->aabox().min_x() >= node.partition_position) {
+          right_subnode_objects->push_back(object);
+        } else {
+          other_objects->push_back(object);
+        }
+      }
+    } else {
+      for (ObjectPtr object : objects) {
+        if (object->aabox().max_y() <= node.partition_position) {
+          left_subnode_objects->push_back(object);
+        } else if (object->aabox().min_y() >= node.partition_position) {
+          right_subnode_objects->push_back(object);
+        } else {
+          other_objects->push_back(object);
+        }
+      }
     }
   }
 
-  void GetObjectsInternal(const Vec2d &point, const double distance,
-                          const double distance_sqr,
+  void GetAllObjects(const Node &node,
+                     std::vector<ObjectPtr> *const result_objects) const {
+    result_objects->insert(
+        result_objects->end(),
+        objects_sorted_by_min_.begin() + node.objects_begin,
+        objects_sorted_by_min_.begin() + node.subtree_objects_end);
+  }
+
+  void GetObjectsInternal(const int index, const Vec2d &point,
+                          const double distance, const double distance_sqr,
                           std::vector<ObjectPtr> *const result_objects) const {
-    if (LowerDistanceSquareToPoint(point) > distance_sqr) {
+    const Node &node = nodes_[index];
+    if (node.LowerDistanceSquareToPoint(point) > distance_sqr) {
       return;
     }
-    if (UpperDistanceSquareToPoint(point) <= distance_sqr) {
-      GetAllObjects(result_objects);
+    if (node.UpperDistanceSquareToPoint(point) <= distance_sqr) {
+      GetAllObjects(node, result_objects);
       return;
     }
-    const double pvalue = (partition_ == PARTITION_X ? point.x() : point.y());
-    if (pvalue < partition_position_) {
+    const double pvalue = (node.partition_x ? point.x() : point.y());
+    const int begin = node.objects_begin;
+    const int end = begin + node.num_objects;
+    if (pvalue < node.partition_position) {
       const double limit = pvalue + distance;
-      for (int i = 0; i < num_objects_; ++i) {
+      for (int i = begin; i < end; ++i) {
         if (objects_sorted_by_min_bound_[i] > limit) {
           break;
         }
@@ -236,7 +390,7 @@ class AABoxKDTree2dNode {
       }
     } else {
       const double limit = pvalue - distance;
-      for (int i = 0; i < num_objects_; ++i) {
+      for (int i = begin; i < end; ++i) {
         if (objects_sorted_by_max_bound_[i] < limit) {
           break;
         }
@@ -246,41 +400,78 @@ class AABoxKDTree2dNode {
         }
       }
     }
-    if (left_subnode_ != nullptr) {
-      left_subnode_->GetObjectsInternal(point, distance, distance_sqr,
-                                        result_objects);
+    if (node.left_subnode >= 0) {
+      GetObjectsInternal(node.left_subnode, point, distance, distance_sqr,
+                         result_objects);
     }
-    if (right_subnode_ != nullptr) {
-      right_subnode_->GetObjectsInternal(point, distance, distance_sqr,
-                                         result_objects);
+    if (node.right_subnode >= 0) {
+      GetObjectsInternal(node.right_subnode, point, distance, distance_sqr,
+                         result_objects);
     }
   }
 
-  void GetNearestObjectInternal(const Vec2d &point,
+  void GetObjectsInBoxInternal(
+      const int index, const AABox2d &box,
+      std::vector<ObjectPtr> *const result_objects) const {
+    const Node &node = nodes_[index];
+    if (box.max_x() < node.min_x || box.min_x() > node.max_x ||
+        box.max_y() < node.min_y || box.min_y() > node.max_y) {
+      return;
+    }
+    if (box.min_x() <= node.min_x && box.max_x() >= node.max_x &&
+        box.min_y() <= node.min_y && box.max_y() >= node.max_y) {
+      GetAllObjects(node, result_objects);
+      return;
+    }
+    const double limit = (node.partition_x ? box.max_x() : box.max_y());
+    const int begin = node.objects_begin;
+    const int end = begin + node.num_objects;
+    for (int i = begin; i < end; ++i) {
+      if (objects_sorted_by_min_bound_[i] > limit) {
+        break;
+      }
+      ObjectPtr object = objects_sorted_by_min_[i];
+      if (object->aabox().HasOverlap(box)) {
+        result_objects->push_back(object);
+      }
+    }
+    if (node.left_subnode >= 0) {
+      GetObjectsInBoxInternal(node.left_subnode, box, result_objects);
+    }
+    if (node.right_subnode >= 0) {
+      GetObjectsInBoxInternal(node.right_subnode, box, result_objects);
+    }
+  }
+
+  void GetNearestObjectInternal(const int index, const Vec2d &point,
                                 double *const min_distance_sqr,
                                 ObjectPtr *const nearest_object) const {
-    if (LowerDistanceSquareToPoint(point) >= *min_distance_sqr - kMathEpsilon) {
+    const Node &node = nodes_[index];
+    if (node.LowerDistanceSquareToPoint(point) >=
+        *min_distance_sqr - kMathEpsilon) {
       return;
     }
-    const double pvalue = (partition_ == PARTITION_X ? point.x() : point.y());
-    const bool search_left_first = (pvalue < partition_position_);
+    const double pvalue = (node.partition_x ? point.x() : point.y());
+    const bool search_left_first = (pvalue < node.partition_position);
     if (search_left_first) {
-      if (left_subnode_ != nullptr) {
-        left_subnode_->GetNearestObjectInternal(point, min_distance_sqr,
-                                                nearest_object);
+      if (node.left_subnode >= 0) {
+        GetNearestObjectInternal(node.left_subnode, point, min_distance_sqr,
+                                 nearest_object);
       }
     } else {
-      if (right_subnode_ != nullptr) {
-        right_subnode_->GetNearestObjectInternal(point, min_distance_sqr,
-                                                 nearest_object);
+      if (node.right_subnode >= 0) {
+        GetNearestObjectInternal(node.right_subnode, point, min_distance_sqr,
+                                 nearest_object);
       }
     }
     if (*min_distance_sqr <= kMathEpsilon) {
       return;
     }
 
+    const int begin = node.objects_begin;
+    const int end = begin + node.num_objects;
     if (search_left_first) {
-      for (int i = 0; i < num_objects_; ++i) {
+      for (int i = begin; i < end; ++i) {
         const double bound = objects_sorted_by_min_bound_[i];
         if (bound > pvalue && Square(bound - pvalue) > *min_distance_sqr) {
           break;
@@ -293,7 +484,7 @@ class AABoxKDTree2dNode {
         }
       }
     } else {
-      for (int i = 0; i < num_objects_; ++i) {
+      for (int i = begin; i < end; ++i) {
         const double bound = objects_sorted_by_max_bound_[i];
         if (bound < pvalue && Square(bound - pvalue) > *min_distance_sqr) {
           break;
@@ -310,160 +501,24 @@ class AABoxKDTree2dNode {
       return;
     }
     if (search_left_first) {
-      if (right_subnode_ != nullptr) {
-        right_subnode_->GetNearestObjectInternal(point, min_distance_sqr,
-                                                 nearest_object);
-      }
-    } else {
-      if (left_subnode_ != nullptr) {
-        left_subnode_->GetNearestObjectInternal(point, min_distance_sqr,
-                                                nearest_object);
-      }
-    }
-  }
-
-  void ComputeBoundary(const std::vector<ObjectPtr> &objects) {
-    min_x_ = std::numeric_limits<double>::infinity();
-    min_y_ = std::numeric_limits<double>::infinity();
-    max_x_ = -std::numeric_limits<double>::infinity();
-    max_y_ = -std::numeric_limits<double>::infinity();
-    for (ObjectPtr object : objects) {
-      min_x_ = std::fmin(min_x_, object->aabox().min_x());
-      max_x_ = std::fmax(max_x_, object->aabox().max_x());
-      min_y_ = std::fmin(min_y_, object->aabox().min_y());
-      max_y_ = std::fmax(max_y_, object->aabox().max_y());
-    }
-    mid_x_ = (min_x_ + max_x_) / 2.0;
-    mid_y_ = (min_y_ + max_y_) / 2.0;
-    ACHECK(!std::isinf(max_x_) && !std::isinf(max_y_) && !std::isinf(min_x_) &&
-           !std::isinf(min_y_))
-        << "the provided object box size is infinity";
-  }
-
-  void ComputePartition() {
-    if (max_x_ - min_x_ >= max_y_ - min_y_) {
-      partition_ = PARTITION_X;
-      partition_position_ = (min_x_ + max_x_) / 2.0;
-    } else {
-      partition_ = PARTITION_Y;
-      partition_position_ = (min_y_ + max_y_) / 2.0;
-    }
-  }
-
-  void PartitionObjects(const std::vector<ObjectPtr> &objects,
-                        std::vector<ObjectPtr> *const left_subnode_objects,
-                        std::vector<ObjectPtr> *const right_subnode_objects) {
-    left_subnode_objects->clear();
-    right_subnode_objects->clear();
-    std::vector<ObjectPtr> other_objects;
-    if (partition_ == PARTITION_X) {
-      for (ObjectPtr object : objects) {
-        if (object->aabox().max_x() <= partition_position_) {
-          left_subnode_objects->push_back(object);
-        } else if (object->aabox().min_x() >= partition_position_) {
-          right_subnode_objects->push_back(object);
-        } else {
-          other_objects.push_back(object);
-        }
+      if (node.right_subnode >= 0) {
+        GetNearestObjectInternal(node.right_subnode, point, min_distance_sqr,
+                                 nearest_object);
       }
     } else {
-      for (ObjectPtr object : objects) {
-        if (object->aabox().max_y() <= partition_position_) {
-          left_subnode_objects->push_back(object);
-        } else if (object->aabox().min_y() >= partition_position_) {
-          right_subnode_objects->push_back(object);
-        } else {
-          other_objects.push_back(object);
-        }
+      if (node.left_subnode >= 0) {
+        GetNearestObjectInternal(node.left_subnode, point, min_distance_sqr,
+                                 nearest_object);
       }
     }
-    InitObjects(other_objects);
   }
 
  private:
-  int num_objects_ = 0;
+  std::vector<Node> nodes_;
   std::vector<ObjectPtr> objects_sorted_by_min_;
   std::vector<ObjectPtr> objects_sorted_by_max_;
   std::vector<double> objects_sorted_by_min_bound_;
   std::vector<double> objects_sorted_by_max_bound_;
-  int depth_ = 0;
-
-  // Boundary
-  double min_x_ = 0.0;
-  double max_x_ = 0.0;
-  double min_y_ = 0.0;
-  double max_y_ = 0.0;
-  double mid_x_ = 0.0;
-  double mid_y_ = 0.0;
-
-  enum Partition {
-    PARTITION_X = 1,
-    PARTITION_Y = 2,
-  };
-  Partition partition_ = PARTITION_X;
-  double partition_position_ = 0.0;
-
-  std::unique_ptr<AABoxKDTree2dNode<ObjectType>> left_subnode_ = nullptr;
-  std::unique_ptr<AABoxKDTree2dNode<ObjectType>> right_subnode_ = nullptr;
-};
-
-/**
- * @class AABoxKDTree2d
- * @brief The class of KD-tree of Aligned Axis Bounding Box(AABox).
- */
-template <class ObjectType>
-class AABoxKDTree2d {
- public:
-  using ObjectPtr = const ObjectType *;
-
-  /**
-   * @brief Constructor which takes a vector of objects and parameters.
-   * @param params Parameters to build the KD-tree.
-   */
-  AABoxKDTree2d(const std::vector<ObjectType> &objects,
-                const AABoxKDTreeParams &params) {
-    if (!objects.empty()) {
-      std::vector<ObjectPtr> object_ptrs;
-      for (const auto &object : objects) {
-        object_ptrs.push_back(&object);
-      }
-      root_.reset(new AABoxKDTree2dNode<ObjectType>(object_ptrs, params, 0));
-    }
-  }
-
-  /**
-   * @brief Get the nearest object to a target point.
-   * @param point The target point. Search it's nearest object.
-   * @return The nearest object to the target point.
-   */
-  ObjectPtr GetNearestObject(const Vec2d &point) const {
-    return root_ == nullptr ? nullptr : root_->GetNearestObject(point);
-  }
-
-  /**
-   * @brief Get objects within a distance to a point.
-   * @param point The center point of the range to search objects.
-   * @param distance The radius of the range to search objects.
-   * @return All objects within the specified distance to the specified point.
-   */
-  std::vector<ObjectPtr> GetObjects(const Vec2d &point,
-                                    const double distance) const {
-    if (root_ == nullptr) {
-      return {};
-    }
-    return root_->GetObjects(point, distance);
-  }
-
-  /**
-   * @brief Get the axis-aligned bounding box of the objects.
-   * @return The axis-aligned bounding box of the objects.
-   */
-  AABox2d GetBoundingBox() const {
-    return root_ == nullptr ? AABox2d() : root_->GetBoundingBox();
-  }
-
- private:
-  std::unique_ptr<AABoxKDTree2dNode<ObjectType>> root_ = nullptr;
 };
 
 }  // namespace math
@@ -0,0 +1,153 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/*
+ * @file
+ * Times building an AABoxKDTree2d over the segments of a grid of curved lanes,
+ * and nearest object and range queries at random points, as the hdmap lane
+ * lookups do.
+ *
+ *   aaboxkdtree2d_benchmark [num_lanes] [num_queries] [iterations]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "modules/common/math/aaboxkdtree2d.h"
+#include "modules/common/math/line_segment2d.h"
+
+namespace apollo {
+namespace common {
+namespace math {
+
+class Segment {
+ public:
+  Segment(const Vec2d &start, const Vec2d &end)
+      : aabox_(start, end), line_segment_(start, end) {}
+  const AABox2d &aabox() const { return aabox_; }
+  double DistanceTo(const Vec2d &point) const {
+    return line_segment_.DistanceTo(point);
+  }
+  double DistanceSquareTo(const Vec2d &point) const {
+    return line_segment_.DistanceSquareTo(point);
+  }
+
+ private:
+  AABox2d aabox_;
+  LineSegment2d line_segment_;
+};
+
+// Lanes of 200 m with one segment per meter, laid on a 3.5 m by 250 m grid.
+std::vector<Segment> Lanes(const int num_lanes) {
+  std::vector<Segment> segments;
+  const int lanes_per_row = 20;
+  for (int i = 0; i < num_lanes; ++i) {
+    const double x0 = 250.0 * (i / lanes_per_row);
+    const double y0 = 3.5 * (i % lanes_per_row);
+    Vec2d prev(x0, y0);
+    for (int k = 1; k <= 200; ++k) {
+      const Vec2d point(x0 + k, y0 + 2.0 * std::sin(0.01 * k));
+      segments.emplace_back(prev, point);
+      prev = point;
+    }
+  }
+  return segments;
+}
+
+template <typename Function>
+void Time(const char *name, const int iterations, Function function) {
+  double total = 0.0;
+  double min = 1e9;
+  double max = 0.0;
+  double checksum = 0.0;
+  for (int i = 0; i < iterations; ++i) {
+    auto start = std::chrono::steady_clock::now();
+    checksum += function();
+    std::chrono::duration<double, std::milli> elapsed =
+        std::chrono::steady_clock::now() - start;
+    total += elapsed.count();
+    min = std::min(min, elapsed.count());
+    max = std::max(max, elapsed.count());
+  }
+  std::printf("%-12s %10.3f %10.3f %10.3f (checksum %g)\n", name,
+              total / iterations, min, max, checksum);
+}
+
+int Run(const int num_lanes, const int num_queries, const int iterations) {
+  const std::vector<Segment> segments = Lanes(num_lanes);
+  AABoxKDTreeParams params;
+  params.max_leaf_dimension = 5.0;
+  params.max_leaf_size = 16;
+  AABoxKDTree2d<Segment> kdtree(segments, params);
+
+  const AABox2d bounding_box = kdtree.GetBoundingBox();
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<double> x(bounding_box.min_x(),
+                                           bounding_box.max_x());
+  std::uniform_real_distribution<double> y(bounding_box.min_y(),
+                                           bounding_box.max_y());
+  std::vector<Vec2d> points;
+  for (int i = 0; i < num_queries; ++i) {
+    points.emplace_back(x(generator), y(generator));
+  }
+
+  std::printf("%zu segments, %d queries\n", segments.size(), num_queries);
+  std::printf("%-12s %10s %10s %10s\n", "operation", "mean(ms)", "min(ms)",
+              "max(ms)");
+  Time("build", iterations, [&]() {
+    AABoxKDTree2d<Segment> tree(segments, params);
+    return tree.GetBoundingBox().max_x();
+  });
+  Time("nearest", iterations, [&]() {
+    double sum = 0.0;
+    for (const auto &point : points) {
+      sum += kdtree.GetNearestObject(point)->DistanceTo(point);
+    }
+    return sum;
+  });
+  Time("within 10m", iterations, [&]() {
+    double sum = 0.0;
+    for (const auto &point : points) {
+      sum += static_cast<double>(kdtree.GetObjects(point, 10.0).size());
+    }
+    return sum;
+  });
+  Time("in box", iterations, [&]() {
+    double sum = 0.0;
+    for (const auto &point : points) {
+      const AABox2d box(point, 20.0, 20.0);
+      sum += static_cast<double>(kdtree.GetObjects(box).size());
+    }
+    return sum;
+  });
+  return 0;
+}
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
+
+int main(int argc, char **argv) {
+  int num_lanes = argc > 1 ? std::max(std::atoi(argv[1]), 1) : 500;
+  int num_queries = argc > 2 ? std::max(std::atoi(argv[2]), 1) : 10000;
+  int iterations = argc > 3 ? std::max(std::atoi(argv[3]), 1) : 20;
+  return apollo::common::math::Run(num_lanes, num_queries, iterations);
+}
@@ -88,6 +88,10 @@ TEST(AABoxKDTree2dNode, OverallTests) {
         const Object *nearest_object = kdtrees[k]->GetNearestObject(point);
         const double actual_distance = nearest_object->DistanceTo(point);
         EXPECT_NEAR(actual_distance, expected_distance, 1e-3);
+        const Object *hint = &objects[i % num_boxes];
+        const Object *hinted_object =
+            kdtrees[k]->GetNearestObject(point, hint);
+        EXPECT_NEAR(hinted_object->DistanceTo(point), expected_distance, 1e-3);
       }
     }
     for (int i = 0; i < kNumQueries; ++i) {
@@ -115,6 +119,25 @@ TEST(AABoxKDTree2dNode, OverallTests) {
         }
       }
     }
+    for (int i = 0; i < kNumQueries; ++i) {
+      const AABox2d box({RandomDouble(-kSize * 1.5, kSize * 1.5),
+                         RandomDouble(-kSize * 1.5, kSize * 1.5)},
+                        {RandomDouble(-kSize * 1.5, kSize * 1.5),
+                         RandomDouble(-kSize * 1.5, kSize * 1.5)});
+      for (int k = 0; k < kNumTrees; ++k) {
+        std::vector<const Object *> result_objects =
+            kdtrees[k]->GetObjects(box);
+        std::set<int> result_ids;
+        for (const Object *object : result_objects) {
+          result_ids.insert(object->id());
+        }
+        EXPECT_EQ(result_objects.size(), result_ids.size());
+        for (const auto &object : objects) {
+          EXPECT_EQ(object.aabox().HasOverlap(box),
+                    result_ids.count(object.id()) > 0);
+        }
+      }
+    }
   }
 }
 
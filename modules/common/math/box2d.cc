@@ -23,6 +23,7 @@
 #include "absl/strings/str_cat.h"
 #include "cyber/common/log.h"
 
+#include "modules/common/math/fast_trig.h"
 #include "modules/common/math/math_utils.h"
 #include "modules/common/math/polygon2d.h"
 
@@ -31,6 +32,9 @@ namespace common {
 namespace math {
 namespace {
 
+// Number of boxes packed for the separating axis tests at once.
+constexpr size_t kOverlapBlockSize = 8;
+
 double PtSegDistance(double query_x, double query_y, double start_x,
                      double start_y, double end_x, double end_y,
                      double length) {
@@ -57,9 +61,8 @@ Box2d::Box2d(const Vec2d &center, const double heading, const double length,
       width_(width),
       half_length_(length / 2.0),
       half_width_(width / 2.0),
-      heading_(heading),
-      cos_heading_(cos(heading)),
-      sin_heading_(sin(heading)) {
+      heading_(heading) {
+  SinCos(heading, &sin_heading_, &cos_heading_);
   CHECK_GT(length_, -kMathEpsilon);
   CHECK_GT(width_, -kMathEpsilon);
   InitCorners();
@@ -311,6 +314,79 @@ bool Box2d::HasOverlap(const Box2d &box) const {
                  box.half_width();
 }
 
+void Box2d::HasOverlap(const std::vector<Box2d> &boxes,
+                       std::vector<bool> *const overlaps) const {
+  overlaps->assign(boxes.size(), false);
+
+  const double dx1 = cos_heading_ * half_length_;
+  const double dy1 = sin_heading_ * half_length_;
+  const double dx2 = sin_heading_ * half_width_;
+  const double dy2 = -cos_heading_ * half_width_;
+
+  size_t indices[kOverlapBlockSize];
+  double shift_x[kOverlapBlockSize];
+  double shift_y[kOverlapBlockSize];
+  double cos_heading[kOverlapBlockSize];
+  double sin_heading[kOverlapBlockSize];
+  double half_length[kOverlapBlockSize];
+  double half_width[kOverlapBlockSize];
+  int overlap[kOverlapBlockSize];
+
+  size_t next = 0;
+  while (next < boxes.size()) {
+    size_t num_packed = 0;
+    for (; next < boxes.size() && num_packed < kOverlapBlockSize; ++next) {
+      const Box2d &box = boxes[next];
+      if (box.max_x() < min_x() || box.min_x() > max_x() ||
+          box.max_y() < min_y() || box.min_y() > max_y()) {
+        continue;
+      }
+      indices[num_packed] = next;
+      shift_x[num_packed] = box.center_x() - center_.x();
+      shift_y[num_packed] = box.center_y() - center_.y();
+      cos_heading[num_packed] = box.cos_heading();
+      sin_heading[num_packed] = box.sin_heading();
+      half_length[num_packed] = box.half_length();
+      half_width[num_packed] = box.half_width();
+      ++num_packed;
+    }
+
+    for (size_t i = 0; i < num_packed; ++i) {
+      const double dx3 = cos_heading[i] * half_length[i];
+      const double dy3 = sin_heading[i] * half_length[i];
+      const double dx4 = sin_heading[i] * half_width[i];
+      const double dy4 = -cos_heading[i] * half_width[i];
+      overlap[i] =
+          static_cast<int>(
+              std::abs(shift_x[i] * cos_heading_ + shift_y[i] * sin_heading_) <=
+              std::abs(dx3 * cos_heading_ + dy3 * sin_heading_) +
+                  std::abs(dx4 * cos_heading_ + dy4 * sin_heading_) +
+                  half_length_) &
+          static_cast<int>(
+              std::abs(shift_x[i] * sin_heading_ - shift_y[i] * cos_heading_) <=
+              std::abs(dx3 * sin_heading_ - dy3 * cos_heading_) +
+                  std::abs(dx4 * sin_heading_ - dy4 * cos_heading_) +
+                  half_width_) &
+          static_cast<int>(
+              std::abs(shift_x[i] * cos_heading[i] +
+                       shift_y[i] * sin_heading[i]) <=
+              std::abs(dx1 * cos_heading[i] + dy1 * sin_heading[i]) +
+                  std::abs(dx2 * cos_heading[i] + dy2 * sin_heading[i]) +
+                  half_length[i]) &
+          static_cast<int>(
+              std::abs(shift_x[i] * sin_heading[i] -
+                       shift_y[i] * cos_heading[i]) <=
+              std::abs(dx1 * sin_heading[i] - dy1 * cos_heading[i]) +
+                  std::abs(dx2 * sin_heading[i] - dy2 * cos_heading[i]) +
+                  half_width[i]);
+    }
+
+    for (size_t i = 0; i < num_packed; ++i) {
+      (*overlaps)[indices[i]] = overlap[i] != 0;
+    }
+  }
+}
+
 AABox2d Box2d::GetAABox() const {
   const double dx1 = std::abs(cos_heading_ * half_length_);
   const double dy1 = std::abs(sin_heading_ * half_length_);
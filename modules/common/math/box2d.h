@@ -219,6 +219,17 @@ class Box2d {
    */
   bool HasOverlap(const Box2d &box) const;
 
+  /**
+   * @brief Determines whether this box overlaps each of the given boxes, the
+   *        same as HasOverlap(box) on each of them. The boxes that pass the
+   *        axes-aligned pre-filter are packed in blocks, whose separating
+   *        axis tests are branch-free so that the compiler vectorizes them.
+   * @param boxes The other boxes
+   * @param overlaps Whether each of the boxes overlaps this box
+   */
+  void HasOverlap(const std::vector<Box2d> &boxes,
+                  std::vector<bool> *const overlaps) const;
+
   /**
    * @brief Gets the smallest axes-aligned box containing the current one
    * @return An axes-aligned box
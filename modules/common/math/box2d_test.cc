@@ -144,6 +144,26 @@ TEST(Box2dTest, HasOverlap) {
   EXPECT_FALSE(box1.HasOverlap(LineSegment2d({4, -4}, {4, 4})));
 }
 
+TEST(Box2dTest, HasOverlapBatch) {
+  for (int iter = 0; iter < 100; ++iter) {
+    const Box2d box({RandomDouble(-10, 10), RandomDouble(-10, 10)},
+                    RandomDouble(0, M_PI * 2.0), RandomDouble(1, 5),
+                    RandomDouble(1, 5));
+    std::vector<Box2d> boxes;
+    for (int i = 0; i < iter; ++i) {
+      boxes.emplace_back(Vec2d(RandomDouble(-20, 20), RandomDouble(-20, 20)),
+                         RandomDouble(0, M_PI * 2.0), RandomDouble(1, 5),
+                         RandomDouble(1, 5));
+    }
+    std::vector<bool> overlaps;
+    box.HasOverlap(boxes, &overlaps);
+    ASSERT_EQ(boxes.size(), overlaps.size());
+    for (size_t i = 0; i < boxes.size(); ++i) {
+      EXPECT_EQ(box.HasOverlap(boxes[i]), overlaps[i]);
+    }
+  }
+}
+
 TEST(Box2dTest, GetAABox) {
   AABox2d aabox1 = box1.GetAABox();
   AABox2d aabox2 = box2.GetAABox();
@@ -19,6 +19,7 @@
 #include <cmath>
 
 #include "cyber/common/log.h"
+#include "modules/common/math/fast_trig.h"
 #include "modules/common/math/math_utils.h"
 
 namespace apollo {
@@ -34,8 +35,9 @@ void CartesianFrenetConverter::cartesian_to_frenet(
   const double dx = x - rx;
   const double dy = y - ry;
 
-  const double cos_theta_r = std::cos(rtheta);
-  const double sin_theta_r = std::sin(rtheta);
+  double sin_theta_r = 0.0;
+  double cos_theta_r = 0.0;
+  SinCos(rtheta, &sin_theta_r, &cos_theta_r);
 
   const double cross_rd_nd = cos_theta_r * dy - sin_theta_r * dx;
   ptr_d_condition->at(0) =
@@ -75,8 +77,9 @@ void CartesianFrenetConverter::cartesian_to_frenet(
   const double dx = x - rx;
   const double dy = y - ry;
 
-  const double cos_theta_r = std::cos(rtheta);
-  const double sin_theta_r = std::sin(rtheta);
+  double sin_theta_r = 0.0;
+  double cos_theta_r = 0.0;
+  SinCos(rtheta, &sin_theta_r, &cos_theta_r);
 
   const double cross_rd_nd = cos_theta_r * dy - sin_theta_r * dx;
   *ptr_d = std::copysign(std::sqrt(dx * dx + dy * dy), cross_rd_nd);
@@ -93,8 +96,9 @@ void CartesianFrenetConverter::frenet_to_cartesian(
   ACHECK(std::abs(rs - s_condition[0]) < 1.0e-6)
       << "The reference point s and s_condition[0] don't match";
 
-  const double cos_theta_r = std::cos(rtheta);
-  const double sin_theta_r = std::sin(rtheta);
+  double sin_theta_r = 0.0;
+  double cos_theta_r = 0.0;
+  SinCos(rtheta, &sin_theta_r, &cos_theta_r);
 
   *ptr_x = rx - sin_theta_r * d_condition[0];
   *ptr_y = ry + cos_theta_r * d_condition[0];
@@ -102,7 +106,7 @@ void CartesianFrenetConverter::frenet_to_cartesian(
   const double one_minus_kappa_r_d = 1 - rkappa * d_condition[0];
 
   const double tan_delta_theta = d_condition[1] / one_minus_kappa_r_d;
-  const double delta_theta = std::atan2(d_condition[1], one_minus_kappa_r_d);
+  const double delta_theta = Atan2(d_condition[1], one_minus_kappa_r_d);
   const double cos_delta_theta = std::cos(delta_theta);
 
   *ptr_theta = NormalizeAngle(delta_theta + rtheta);
@@ -128,6 +132,106 @@ void CartesianFrenetConverter::frenet_to_cartesian(
                (d_condition[1] * delta_theta_prime - kappa_r_d_prime);
 }
 
+void CartesianFrenetConverter::cartesian_to_frenet(
+    const std::vector<PathPoint>& ref_points, const std::vector<Vec2d>& points,
+    std::vector<double>* const ptr_s, std::vector<double>* const ptr_d) {
+  ACHECK(ref_points.size() == points.size())
+      << "The reference points and the points don't match";
+  const std::size_t size = points.size();
+
+  std::vector<double> rtheta(size);
+  for (std::size_t i = 0; i < size; ++i) {
+    rtheta[i] = ref_points[i].theta();
+  }
+  std::vector<double> sin_theta_r;
+  std::vector<double> cos_theta_r;
+  SinCos(rtheta, &sin_theta_r, &cos_theta_r);
+
+  ptr_s->resize(size);
+  ptr_d->resize(size);
+  for (std::size_t i = 0; i < size; ++i) {
+    const double dx = points[i].x() - ref_points[i].x();
+    const double dy = points[i].y() - ref_points[i].y();
+    const double cross_rd_nd = cos_theta_r[i] * dy - sin_theta_r[i] * dx;
+    (*ptr_d)[i] = std::copysign(std::sqrt(dx * dx + dy * dy), cross_rd_nd);
+    (*ptr_s)[i] = ref_points[i].s();
+  }
+}
+
+void CartesianFrenetConverter::frenet_to_cartesian(
+    const std::vector<PathPoint>& ref_points,
+    const std::vector<std::array<double, 3>>& s_conditions,
+    const std::vector<std::array<double, 3>>& d_conditions,
+    std::vector<TrajectoryPoint>* const ptr_trajectory_points) {
+  ACHECK(ref_points.size() == s_conditions.size() &&
+         ref_points.size() == d_conditions.size())
+      << "The reference points and the conditions don't match";
+  const std::size_t size = ref_points.size();
+
+  std::vector<double> rtheta(size);
+  std::vector<double> one_minus_kappa_r_d(size);
+  std::vector<double> dl(size);
+  for (std::size_t i = 0; i < size; ++i) {
+    const PathPoint& ref_point = ref_points[i];
+    ACHECK(std::abs(ref_point.s() - s_conditions[i][0]) < 1.0e-6)
+        << "The reference point s and s_condition[0] don't match";
+    rtheta[i] = ref_point.theta();
+    one_minus_kappa_r_d[i] = 1 - ref_point.kappa() * d_conditions[i][0];
+    dl[i] = d_conditions[i][1];
+  }
+
+  std::vector<double> sin_theta_r;
+  std::vector<double> cos_theta_r;
+  SinCos(rtheta, &sin_theta_r, &cos_theta_r);
+  std::vector<double> delta_theta;
+  Atan2(dl, one_minus_kappa_r_d, &delta_theta);
+  std::vector<double> cos_delta_theta(size);
+  for (std::size_t i = 0; i < size; ++i) {
+    cos_delta_theta[i] = std::cos(delta_theta[i]);
+  }
+
+  ptr_trajectory_points->resize(size);
+  for (std::size_t i = 0; i < size; ++i) {
+    const PathPoint& ref_point = ref_points[i];
+    const std::array<double, 3>& s_condition = s_conditions[i];
+    const std::array<double, 3>& d_condition = d_conditions[i];
+    const double rkappa = ref_point.kappa();
+    const double rdkappa = ref_point.dkappa();
+
+    const double tan_delta_theta = d_condition[1] / one_minus_kappa_r_d[i];
+    const double kappa_r_d_prime =
+        rdkappa * d_condition[0] + rkappa * d_condition[1];
+    const double kappa =
+        (((d_condition[2] + kappa_r_d_prime * tan_delta_theta) *
+          cos_delta_theta[i] * cos_delta_theta[i]) /
+             (one_minus_kappa_r_d[i]) +
+         rkappa) *
+        cos_delta_theta[i] / (one_minus_kappa_r_d[i]);
+
+    const double d_dot = d_condition[1] * s_condition[1];
+    const double v = std::sqrt(one_minus_kappa_r_d[i] *
+                                   one_minus_kappa_r_d[i] * s_condition[1] *
+                                   s_condition[1] +
+                               d_dot * d_dot);
+
+    const double delta_theta_prime =
+        one_minus_kappa_r_d[i] / cos_delta_theta[i] * kappa - rkappa;
+    const double a =
+        s_condition[2] * one_minus_kappa_r_d[i] / cos_delta_theta[i] +
+        s_condition[1] * s_condition[1] / cos_delta_theta[i] *
+            (d_condition[1] * delta_theta_prime - kappa_r_d_prime);
+
+    TrajectoryPoint* trajectory_point = &(*ptr_trajectory_points)[i];
+    PathPoint* path_point = trajectory_point->mutable_path_point();
+    path_point->set_x(ref_point.x() - sin_theta_r[i] * d_condition[0]);
+    path_point->set_y(ref_point.y() + cos_theta_r[i] * d_condition[0]);
+    path_point->set_theta(NormalizeAngle(delta_theta[i] + rtheta[i]));
+    path_point->set_kappa(kappa);
+    trajectory_point->set_v(v);
+    trajectory_point->set_a(a);
+  }
+}
+
 double CartesianFrenetConverter::CalculateTheta(const double rtheta,
                                                 const double rkappa,
                                                 const double l,
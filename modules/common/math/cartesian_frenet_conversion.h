@@ -21,8 +21,10 @@
 #pragma once
 
 #include <array>
+#include <vector>
 
 #include "modules/common/math/vec2d.h"
+#include "modules/common/proto/pnc_point.pb.h"
 
 namespace apollo {
 namespace common {
@@ -76,6 +78,29 @@ class CartesianFrenetConverter {
                                   double* const ptr_kappa, double* const ptr_v,
                                   double* const ptr_a);
 
+  /**
+   * Convert a batch of points in Cartesian frame to s and d, each w.r.t. its
+   * matched reference point, e.g. from PathMatcher::MatchToPath(). The
+   * results are the same as those of the one-point overload above.
+   */
+  static void cartesian_to_frenet(const std::vector<PathPoint>& ref_points,
+                                  const std::vector<Vec2d>& points,
+                                  std::vector<double>* const ptr_s,
+                                  std::vector<double>* const ptr_d);
+
+  /**
+   * Convert a batch of states in Frenet frame, each w.r.t. its matched
+   * reference point, to the x, y, theta, kappa, v and a of trajectory points.
+   * The trigonometric functions are evaluated in passes of their own over
+   * packed arrays, which the compiler can vectorize, and the results are the
+   * same as those of the one-state overload above.
+   */
+  static void frenet_to_cartesian(
+      const std::vector<PathPoint>& ref_points,
+      const std::vector<std::array<double, 3>>& s_conditions,
+      const std::vector<std::array<double, 3>>& d_conditions,
+      std::vector<TrajectoryPoint>* const ptr_trajectory_points);
+
   // given sl point extract x, y, theta, kappa
   static double CalculateTheta(const double rtheta, const double rkappa,
                                const double l, const double dl);
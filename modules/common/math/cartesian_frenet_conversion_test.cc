@@ -18,8 +18,10 @@
 
 #include <array>
 #include <cmath>
+#include <vector>
 
 #include "gtest/gtest.h"
+#include "modules/common/math/path_matcher.h"
 
 namespace apollo {
 namespace common {
@@ -65,6 +67,133 @@ TEST(TestCartesianFrenetConversion, cartesian_to_frenet_test) {
   EXPECT_NEAR(a, a_out, 1.0e-6);
 }
 
+namespace {
+
+// An arc of radius 50 followed by a straight line.
+std::vector<PathPoint> MakeReferenceLine() {
+  std::vector<PathPoint> reference_line;
+  for (int i = 0; i <= 200; ++i) {
+    const double s = 0.5 * i;
+    const bool on_arc = s < 50.0;
+    const double theta = on_arc ? s / 50.0 : 1.0;
+    PathPoint point;
+    point.set_s(s);
+    point.set_x(on_arc ? 50.0 * std::sin(theta)
+                       : 50.0 * std::sin(1.0) + (s - 50.0) * std::cos(1.0));
+    point.set_y(on_arc ? 50.0 * (1.0 - std::cos(theta))
+                       : 50.0 * (1.0 - std::cos(1.0)) +
+                             (s - 50.0) * std::sin(1.0));
+    point.set_theta(theta);
+    point.set_kappa(on_arc ? 0.02 : 0.0);
+    point.set_dkappa(0.0);
+    reference_line.push_back(point);
+  }
+  return reference_line;
+}
+
+void ExpectSamePathPoint(const PathPoint& expected, const PathPoint& actual) {
+  EXPECT_EQ(expected.s(), actual.s());
+  EXPECT_EQ(expected.x(), actual.x());
+  EXPECT_EQ(expected.y(), actual.y());
+  EXPECT_EQ(expected.theta(), actual.theta());
+  EXPECT_EQ(expected.kappa(), actual.kappa());
+  EXPECT_EQ(expected.dkappa(), actual.dkappa());
+}
+
+}  // namespace
+
+TEST(TestCartesianFrenetConversion, batch_frenet_to_cartesian_test) {
+  const std::vector<PathPoint> reference_line = MakeReferenceLine();
+
+  // Out of order and out of range stations, to restart the matching hint.
+  std::vector<double> stations;
+  for (int i = 0; i < 120; ++i) {
+    stations.push_back(-1.0 + 0.9 * i);
+  }
+  stations.push_back(30.0);
+  stations.push_back(30.0);
+  stations.push_back(0.25);
+  stations.push_back(std::nan(""));
+  stations.push_back(99.9);
+
+  const std::vector<PathPoint> ref_points =
+      PathMatcher::MatchToPath(reference_line, stations);
+  ASSERT_EQ(stations.size(), ref_points.size());
+
+  std::vector<std::array<double, 3>> s_conditions;
+  std::vector<std::array<double, 3>> d_conditions;
+  std::vector<PathPoint> finite_ref_points;
+  for (std::size_t i = 0; i < stations.size(); ++i) {
+    ExpectSamePathPoint(PathMatcher::MatchToPath(reference_line, stations[i]),
+                        ref_points[i]);
+    if (std::isnan(stations[i])) {
+      continue;
+    }
+    finite_ref_points.push_back(ref_points[i]);
+    s_conditions.push_back({ref_points[i].s(), 5.0 + 0.01 * i, 0.3});
+    d_conditions.push_back({std::sin(0.1 * i), 0.05 * std::cos(0.2 * i),
+                            0.01 * std::sin(0.3 * i)});
+  }
+
+  std::vector<TrajectoryPoint> trajectory_points;
+  CartesianFrenetConverter::frenet_to_cartesian(
+      finite_ref_points, s_conditions, d_conditions, &trajectory_points);
+  ASSERT_EQ(finite_ref_points.size(), trajectory_points.size());
+
+  for (std::size_t i = 0; i < finite_ref_points.size(); ++i) {
+    const PathPoint& ref_point = finite_ref_points[i];
+    double x = 0.0;
+    double y = 0.0;
+    double theta = 0.0;
+    double kappa = 0.0;
+    double v = 0.0;
+    double a = 0.0;
+    CartesianFrenetConverter::frenet_to_cartesian(
+        ref_point.s(), ref_point.x(), ref_point.y(), ref_point.theta(),
+        ref_point.kappa(), ref_point.dkappa(), s_conditions[i],
+        d_conditions[i], &x, &y, &theta, &kappa, &v, &a);
+    const TrajectoryPoint& trajectory_point = trajectory_points[i];
+    EXPECT_EQ(x, trajectory_point.path_point().x());
+    EXPECT_EQ(y, trajectory_point.path_point().y());
+    EXPECT_EQ(theta, trajectory_point.path_point().theta());
+    EXPECT_EQ(kappa, trajectory_point.path_point().kappa());
+    EXPECT_EQ(v, trajectory_point.v());
+    EXPECT_EQ(a, trajectory_point.a());
+  }
+}
+
+TEST(TestCartesianFrenetConversion, batch_cartesian_to_frenet_test) {
+  const std::vector<PathPoint> reference_line = MakeReferenceLine();
+
+  std::vector<Vec2d> points;
+  for (int i = 0; i < 150; ++i) {
+    points.emplace_back(-5.0 + 0.7 * i, 3.0 * std::sin(0.05 * i) + 0.2 * i);
+  }
+
+  const std::vector<PathPoint> ref_points =
+      PathMatcher::MatchToPath(reference_line, points);
+  ASSERT_EQ(points.size(), ref_points.size());
+
+  std::vector<double> s;
+  std::vector<double> d;
+  CartesianFrenetConverter::cartesian_to_frenet(ref_points, points, &s, &d);
+  ASSERT_EQ(points.size(), s.size());
+  ASSERT_EQ(points.size(), d.size());
+
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    const PathPoint ref_point =
+        PathMatcher::MatchToPath(reference_line, points[i].x(), points[i].y());
+    ExpectSamePathPoint(ref_point, ref_points[i]);
+    double expected_s = 0.0;
+    double expected_d = 0.0;
+    CartesianFrenetConverter::cartesian_to_frenet(
+        ref_point.s(), ref_point.x(), ref_point.y(), ref_point.theta(),
+        points[i].x(), points[i].y(), &expected_s, &expected_d);
+    EXPECT_EQ(expected_s, s[i]);
+    EXPECT_EQ(expected_d, d[i]);
+  }
+}
+
 }  // namespace math
 }  // namespace common
 }  // namespace apollo
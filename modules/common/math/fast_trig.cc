@@ -0,0 +1,57 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/math/fast_trig.h"
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace common {
+namespace math {
+
+void SinCos(const std::vector<double> &angles, std::vector<double> *sines,
+            std::vector<double> *cosines) {
+  CHECK_NOTNULL(sines);
+  CHECK_NOTNULL(cosines);
+  const std::size_t size = angles.size();
+  sines->resize(size);
+  cosines->resize(size);
+  // Raw pointers, so that the compiler sees the arrays do not alias.
+  const double *const angle_data = angles.data();
+  double *const sine_data = sines->data();
+  double *const cosine_data = cosines->data();
+  for (std::size_t i = 0; i < size; ++i) {
+    SinCos(angle_data[i], &sine_data[i], &cosine_data[i]);
+  }
+}
+
+void Atan2(const std::vector<double> &ys, const std::vector<double> &xs,
+           std::vector<double> *angles) {
+  CHECK_NOTNULL(angles);
+  ACHECK(ys.size() == xs.size()) << "The ys and the xs don't match";
+  const std::size_t size = ys.size();
+  angles->resize(size);
+  const double *const y_data = ys.data();
+  const double *const x_data = xs.data();
+  double *const angle_data = angles->data();
+  for (std::size_t i = 0; i < size; ++i) {
+    angle_data[i] = Atan2(y_data[i], x_data[i]);
+  }
+}
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
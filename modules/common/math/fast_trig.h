@@ -0,0 +1,207 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Polynomial sine, cosine and arctangent without branches or calls,
+ * so that loops over them vectorize, and the SinCos() and Atan2() functions
+ * which use them when built with --define USE_FAST_TRIG=true, and the
+ * standard library otherwise.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+/**
+ * @namespace apollo::common::math
+ * @brief apollo::common::math
+ */
+namespace apollo {
+namespace common {
+namespace math {
+namespace internal {
+
+// Selects a if the condition holds, and b otherwise, with bit masks. Unlike
+// with the conditional operator, compilers do not move the computation of a
+// or b into a branch, which would keep the loops from vectorizing.
+inline double Select(const bool condition, const double a, const double b) {
+  uint64_t a_bits = 0;
+  uint64_t b_bits = 0;
+  std::memcpy(&a_bits, &a, sizeof(a_bits));
+  std::memcpy(&b_bits, &b, sizeof(b_bits));
+  const uint64_t mask = uint64_t{0} - static_cast<uint64_t>(condition);
+  const uint64_t bits = (a_bits & mask) | (b_bits & ~mask);
+  double selected = 0.0;
+  std::memcpy(&selected, &bits, sizeof(selected));
+  return selected;
+}
+
+}  // namespace internal
+
+/**
+ * @brief Computes the sine and the cosine of an angle. For angles within
+ * [-1e6, 1e6], the absolute error of both is below 2e-16, about one ulp of
+ * the results. Larger angles lose accuracy, and NaN or infinite ones give
+ * NaN.
+ * @param angle The angle in radians.
+ * @param sine The sine of the angle.
+ * @param cosine The cosine of the angle.
+ */
+inline void FastSinCos(const double angle, double *const sine,
+                       double *const cosine) {
+  // Cody-Waite reduction by pi / 2, with the constants of fdlibm, which keeps
+  // the products exact for multiples of up to 2^20.
+  static constexpr double kTwoOverPi = 6.36619772367581382433e-01;
+  static constexpr double kHalfPi1 = 1.57079632673412561417e+00;
+  static constexpr double kHalfPi2 = 6.07710050630396597660e-11;
+  static constexpr double kHalfPi3 = 2.02226624871116645580e-21;
+  // Adding 1.5 * 2^52 rounds to an integer, kept in the low mantissa bits.
+  static constexpr double kRoundingShift = 6755399441055744.0;
+  const double shifted = angle * kTwoOverPi + kRoundingShift;
+  const double k = shifted - kRoundingShift;
+  uint64_t bits = 0;
+  std::memcpy(&bits, &shifted, sizeof(bits));
+  const uint64_t quadrant = bits & 3;
+  const double r = ((angle - k * kHalfPi1) - k * kHalfPi2) - k * kHalfPi3;
+
+  // The minimax polynomials of the fdlibm kernels on [-pi / 4, pi / 4].
+  const double z = r * r;
+  const double sin_r =
+      r + r * z *
+              (-1.66666666666666324348e-01 +
+               z * (8.33333333332248946124e-03 +
+                    z * (-1.98412698298579493134e-04 +
+                         z * (2.75573137070700676789e-06 +
+                              z * (-2.50507602534068634195e-08 +
+                                   z * 1.58969099521155010221e-10)))));
+  const double half_z = 0.5 * z;
+  const double w = 1.0 - half_z;
+  const double cos_r =
+      w + (((1.0 - w) - half_z) +
+           z * z *
+               (4.16666666666666019037e-02 +
+                z * (-1.38888888888741095749e-03 +
+                     z * (2.48015872894767294178e-05 +
+                          z * (-2.75573143513906633035e-07 +
+                               z * (2.08757232129817482790e-09 +
+                                    z * -1.13596475577881948265e-11))))));
+
+  const double s = (quadrant & 1) ? cos_r : sin_r;
+  const double c = (quadrant & 1) ? sin_r : cos_r;
+  *sine = (quadrant & 2) ? -s : s;
+  *cosine = ((quadrant + 1) & 2) ? -c : c;
+}
+
+/**
+ * @brief Computes the angle of the vector (x, y), in [-pi, pi], as
+ * std::atan2() does, signed zeros included, with an absolute error below
+ * 5e-16. Only finite x and y are supported.
+ * @param y The y of the vector.
+ * @param x The x of the vector.
+ * @return The angle of the vector in radians.
+ */
+inline double FastAtan2(const double y, const double x) {
+  static constexpr double kPi = 3.14159265358979311600e+00;
+  static constexpr double kHalfPi = 1.57079632679489655800e+00;
+  static constexpr double kQuarterPi = 7.85398163397448278999e-01;
+  // The part of pi / 4 that kQuarterPi misses.
+  static constexpr double kQuarterPiTail = 3.06161699786838294307e-17;
+  const double abs_x = std::abs(x);
+  const double abs_y = std::abs(y);
+  const double max = std::max(abs_x, abs_y);
+  const double min = std::min(abs_x, abs_y);
+  // The tangent of the angle to the closest axis, in [0, 1].
+  const double t = min / internal::Select(max > 0.0, max, 1.0);
+
+  // The rational approximation of Cephes on [0, 0.66], where larger tangents
+  // are reduced by atan(t) = pi / 4 + atan((t - 1) / (t + 1)).
+  const bool reduce = t > 0.66;
+  const double u = internal::Select(reduce, (t - 1.0) / (t + 1.0), t);
+  const double z = u * u;
+  const double p =
+      (((-8.750608600031904122785e-01 * z - 1.615753718733365076637e+01) * z -
+        7.500855792314704667340e+01) *
+           z -
+       1.228866684490136173410e+02) *
+          z -
+      6.485021904942025371773e+01;
+  const double q =
+      ((((z + 2.485846490142306297962e+01) * z + 1.650270098316988542046e+02) *
+            z +
+        4.328810604912902668951e+02) *
+           z +
+       4.853903996359136964868e+02) *
+          z +
+      1.945506571482613964425e+02;
+  const double atan_u = u + u * z * p / q;
+  const double to_x_axis = internal::Select(
+      reduce, kQuarterPi + (atan_u + kQuarterPiTail), atan_u);
+
+  const double angle =
+      internal::Select(abs_y > abs_x, kHalfPi - to_x_axis, to_x_axis);
+  // Unlike std::signbit(), the comparison vectorizes.
+  const bool negative_x = std::copysign(1.0, x) < 0.0;
+  return std::copysign(internal::Select(negative_x, kPi - angle, angle), y);
+}
+
+/**
+ * @brief Computes the sine and the cosine of an angle, with FastSinCos() when
+ * built with --define USE_FAST_TRIG=true, and the standard library otherwise.
+ */
+inline void SinCos(const double angle, double *const sine,
+                   double *const cosine) {
+#if USE_FAST_TRIG == 1
+  FastSinCos(angle, sine, cosine);
+#else
+  *sine = std::sin(angle);
+  *cosine = std::cos(angle);
+#endif
+}
+
+/**
+ * @brief Computes the angle of the vector (x, y), with FastAtan2() when built
+ * with --define USE_FAST_TRIG=true, and the standard library otherwise.
+ */
+inline double Atan2(const double y, const double x) {
+#if USE_FAST_TRIG == 1
+  return FastAtan2(y, x);
+#else
+  return std::atan2(y, x);
+#endif
+}
+
+/**
+ * @brief Computes the sines and the cosines of many angles, as SinCos() does
+ * on each of them.
+ */
+void SinCos(const std::vector<double> &angles, std::vector<double> *sines,
+            std::vector<double> *cosines);
+
+/**
+ * @brief Computes the angles of many vectors, as Atan2() does on each of
+ * them.
+ */
+void Atan2(const std::vector<double> &ys, const std::vector<double> &xs,
+           std::vector<double> *angles);
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
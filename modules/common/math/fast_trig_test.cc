@@ -0,0 +1,108 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/math/fast_trig.h"
+
+#include <random>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace common {
+namespace math {
+
+TEST(FastTrigTest, SinCos) {
+  double sine = 0.0;
+  double cosine = 0.0;
+  FastSinCos(0.0, &sine, &cosine);
+  EXPECT_EQ(0.0, sine);
+  EXPECT_EQ(1.0, cosine);
+  // Where the angle misses the multiple of pi / 2 it stands for.
+  FastSinCos(M_PI_2, &sine, &cosine);
+  EXPECT_EQ(1.0, sine);
+  EXPECT_NEAR(std::cos(M_PI_2), cosine, 1e-30);
+  FastSinCos(-M_PI, &sine, &cosine);
+  EXPECT_NEAR(std::sin(-M_PI), sine, 1e-30);
+  EXPECT_EQ(-1.0, cosine);
+  FastSinCos(std::nan(""), &sine, &cosine);
+  EXPECT_TRUE(std::isnan(sine));
+  EXPECT_TRUE(std::isnan(cosine));
+
+  std::mt19937 generator(1);
+  for (const double range : {1.0, 10.0, 1e3, 1e6}) {
+    std::uniform_real_distribution<double> angles(-range, range);
+    for (int i = 0; i < 100000; ++i) {
+      const double angle = angles(generator);
+      FastSinCos(angle, &sine, &cosine);
+      EXPECT_NEAR(std::sin(static_cast<long double>(angle)), sine, 2e-16);
+      EXPECT_NEAR(std::cos(static_cast<long double>(angle)), cosine, 2e-16);
+    }
+  }
+}
+
+TEST(FastTrigTest, Atan2) {
+  // The signed zeros and the axes, as std::atan2() gives them.
+  for (const double y : {0.0, -0.0, 1.0, -1.0}) {
+    for (const double x : {0.0, -0.0, 1.0, -1.0}) {
+      EXPECT_EQ(std::atan2(y, x), FastAtan2(y, x)) << y << ", " << x;
+      EXPECT_EQ(std::signbit(std::atan2(y, x)), std::signbit(FastAtan2(y, x)));
+    }
+  }
+
+  std::mt19937 generator(1);
+  std::uniform_real_distribution<double> coordinates(-10.0, 10.0);
+  std::uniform_int_distribution<int> exponents(-30, 30);
+  for (int i = 0; i < 200000; ++i) {
+    const double y = std::ldexp(coordinates(generator), exponents(generator));
+    const double x = std::ldexp(coordinates(generator), exponents(generator));
+    EXPECT_NEAR(std::atan2(static_cast<long double>(y), x), FastAtan2(y, x),
+                5e-16)
+        << y << ", " << x;
+  }
+}
+
+TEST(FastTrigTest, Batch) {
+  std::mt19937 generator(1);
+  std::uniform_real_distribution<double> coordinates(-10.0, 10.0);
+  std::vector<double> ys;
+  std::vector<double> xs;
+  for (int i = 0; i < 1001; ++i) {
+    ys.push_back(coordinates(generator));
+    xs.push_back(coordinates(generator));
+  }
+
+  std::vector<double> angles;
+  Atan2(ys, xs, &angles);
+  ASSERT_EQ(ys.size(), angles.size());
+  std::vector<double> sines;
+  std::vector<double> cosines;
+  SinCos(angles, &sines, &cosines);
+  ASSERT_EQ(angles.size(), sines.size());
+  ASSERT_EQ(angles.size(), cosines.size());
+  for (std::size_t i = 0; i < angles.size(); ++i) {
+    EXPECT_DOUBLE_EQ(Atan2(ys[i], xs[i]), angles[i]);
+    double sine = 0.0;
+    double cosine = 0.0;
+    SinCos(angles[i], &sine, &cosine);
+    EXPECT_DOUBLE_EQ(sine, sines[i]);
+    EXPECT_DOUBLE_EQ(cosine, cosines[i]);
+    EXPECT_NEAR(1.0, sine * sine + cosine * cosine, 1e-15);
+  }
+}
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
@@ -0,0 +1,211 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/*
+ * @file
+ * Times the overlap tests of the ego box along a trajectory against the
+ * obstacles around it, one at a time and in batches, the same tests on the
+ * polygons of the boxes, and whether the points of a point cloud are in a
+ * region of interest polygon.
+ *
+ *   geometry_benchmark [num_obstacles] [num_points] [iterations]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "modules/common/math/box2d.h"
+#include "modules/common/math/polygon2d.h"
+
+namespace apollo {
+namespace common {
+namespace math {
+
+// Cars, trucks and pedestrians on a 40 m wide road ahead of the ego car.
+std::vector<Box2d> Obstacles(const int num_obstacles,
+                             std::mt19937 *const generator) {
+  std::uniform_real_distribution<double> x(-20.0, 150.0);
+  std::uniform_real_distribution<double> y(-20.0, 20.0);
+  std::uniform_real_distribution<double> heading(-0.2, 0.2);
+  std::vector<Box2d> obstacles;
+  for (int i = 0; i < num_obstacles; ++i) {
+    const Vec2d center(x(*generator), y(*generator));
+    switch (i % 10) {
+      case 0:
+        obstacles.emplace_back(center, heading(*generator), 12.0, 2.5);
+        break;
+      case 1:
+      case 2:
+        obstacles.emplace_back(center, M_PI * heading(*generator), 0.6, 0.6);
+        break;
+      default:
+        obstacles.emplace_back(center, heading(*generator), 4.7, 1.9);
+        break;
+    }
+  }
+  return obstacles;
+}
+
+// The ego box every 0.1 s of an 8 s trajectory turning left at 10 m/s.
+std::vector<Box2d> EgoBoxes() {
+  std::vector<Box2d> ego_boxes;
+  for (int i = 0; i < 80; ++i) {
+    const double s = 1.0 * i;
+    const double heading = 0.005 * s;
+    ego_boxes.emplace_back(Vec2d(s, 0.0025 * s * s), heading, 4.9, 2.1);
+  }
+  return ego_boxes;
+}
+
+// A road of 20 m by 100 m with a 20 m by 20 m side street, as a region of
+// interest polygon with vertices every 2 m on the curbs.
+Polygon2d RegionOfInterest() {
+  std::vector<Vec2d> points;
+  for (double x = 0.0; x < 100.0; x += 2.0) {
+    points.emplace_back(x, -10.0 + 0.5 * std::sin(0.1 * x));
+  }
+  for (double y = -10.0; y < 10.0; y += 2.0) {
+    points.emplace_back(100.0, y);
+  }
+  for (double x = 100.0; x > 0.0; x -= 2.0) {
+    if (x > 40.0 && x <= 60.0) {
+      points.emplace_back(x, 30.0);
+    } else {
+      points.emplace_back(x, 10.0 + 0.5 * std::sin(0.1 * x));
+    }
+  }
+  for (double y = 10.0; y > -10.0; y -= 2.0) {
+    points.emplace_back(0.0, y);
+  }
+  return Polygon2d(points);
+}
+
+template <typename Function>
+void Time(const char *name, const int iterations, Function function) {
+  double total = 0.0;
+  double min = 1e9;
+  double max = 0.0;
+  double checksum = 0.0;
+  for (int i = 0; i < iterations; ++i) {
+    auto start = std::chrono::steady_clock::now();
+    checksum += function();
+    std::chrono::duration<double, std::milli> elapsed =
+        std::chrono::steady_clock::now() - start;
+    total += elapsed.count();
+    min = std::min(min, elapsed.count());
+    max = std::max(max, elapsed.count());
+  }
+  std::printf("%-22s %10.3f %10.3f %10.3f (checksum %g)\n", name,
+              total / iterations, min, max, checksum);
+}
+
+int Run(const int num_obstacles, const int num_points, const int iterations) {
+  std::mt19937 generator(42);
+  const std::vector<Box2d> obstacles = Obstacles(num_obstacles, &generator);
+  const std::vector<Box2d> ego_boxes = EgoBoxes();
+  std::vector<Polygon2d> obstacle_polygons;
+  for (const auto &obstacle : obstacles) {
+    obstacle_polygons.emplace_back(obstacle);
+  }
+  std::vector<Polygon2d> ego_polygons;
+  for (const auto &ego_box : ego_boxes) {
+    ego_polygons.emplace_back(ego_box);
+  }
+
+  const Polygon2d roi = RegionOfInterest();
+  std::uniform_real_distribution<double> x(-20.0, 120.0);
+  std::uniform_real_distribution<double> y(-40.0, 40.0);
+  std::vector<Vec2d> points;
+  for (int i = 0; i < num_points; ++i) {
+    points.emplace_back(x(generator), y(generator));
+  }
+
+  std::printf("%d obstacles, %zu ego boxes, %d points, %d roi vertices\n",
+              num_obstacles, ego_boxes.size(), num_points, roi.num_points());
+  std::printf("%-22s %10s %10s %10s\n", "operation", "mean(ms)", "min(ms)",
+              "max(ms)");
+  Time("box overlap", iterations, [&]() {
+    double sum = 0.0;
+    for (const auto &ego_box : ego_boxes) {
+      for (const auto &obstacle : obstacles) {
+        sum += ego_box.HasOverlap(obstacle) ? 1.0 : 0.0;
+      }
+    }
+    return sum;
+  });
+  Time("box overlap batch", iterations, [&]() {
+    double sum = 0.0;
+    std::vector<bool> overlaps;
+    for (const auto &ego_box : ego_boxes) {
+      ego_box.HasOverlap(obstacles, &overlaps);
+      sum += static_cast<double>(
+          std::count(overlaps.begin(), overlaps.end(), true));
+    }
+    return sum;
+  });
+  // The overlap test without the separating axes.
+  Time("polygon distance", iterations, [&]() {
+    double sum = 0.0;
+    for (const auto &ego : ego_polygons) {
+      for (const auto &obstacle : obstacle_polygons) {
+        if (obstacle.max_x() < ego.min_x() || obstacle.min_x() > ego.max_x() ||
+            obstacle.max_y() < ego.min_y() || obstacle.min_y() > ego.max_y()) {
+          continue;
+        }
+        sum += ego.DistanceTo(obstacle) <= kMathEpsilon;
+      }
+    }
+    return sum;
+  });
+  Time("polygon overlap", iterations, [&]() {
+    double sum = 0.0;
+    for (const auto &ego_polygon : ego_polygons) {
+      for (const auto &obstacle_polygon : obstacle_polygons) {
+        sum += ego_polygon.HasOverlap(obstacle_polygon) ? 1.0 : 0.0;
+      }
+    }
+    return sum;
+  });
+  Time("points in roi", iterations, [&]() {
+    double sum = 0.0;
+    for (const auto &point : points) {
+      sum += roi.IsPointIn(point) ? 1.0 : 0.0;
+    }
+    return sum;
+  });
+  Time("points in roi batch", iterations, [&]() {
+    std::vector<bool> inside;
+    roi.IsPointIn(points, &inside);
+    return static_cast<double>(std::count(inside.begin(), inside.end(), true));
+  });
+  return 0;
+}
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
+
+int main(int argc, char **argv) {
+  int num_obstacles = argc > 1 ? std::max(std::atoi(argv[1]), 1) : 200;
+  int num_points = argc > 2 ? std::max(std::atoi(argv[2]), 1) : 100000;
+  int iterations = argc > 3 ? std::max(std::atoi(argv[3]), 1) : 20;
+  return apollo::common::math::Run(num_obstacles, num_points, iterations);
+}
@@ -76,6 +76,73 @@ void SolveLQRProblem(const Matrix &A, const Matrix &B, const Matrix &Q,
   SolveLQRProblem(A, B, Q, R, M, tolerance, max_num_iteration, ptr_K);
 }
 
+void LQRWorkspace::Resize(const Eigen::Index state_dim,
+                          const Eigen::Index control_dim) {
+  if (P_.rows() == state_dim && gain_.rows() == control_dim) {
+    return;
+  }
+  P_.resize(state_dim, state_dim);
+  P_next_.resize(state_dim, state_dim);
+  AT_P_.resize(state_dim, state_dim);
+  AT_P_B_.resize(state_dim, control_dim);
+  BT_P_.resize(control_dim, state_dim);
+  BT_P_A_.resize(control_dim, state_dim);
+  R_BT_P_B_.resize(control_dim, control_dim);
+  gain_.resize(control_dim, state_dim);
+  lu_ = Eigen::PartialPivLU<Matrix>(control_dim);
+}
+
+void SolveLQRProblem(const Matrix &A, const Matrix &B, const Matrix &Q,
+                     const Matrix &R, const double tolerance,
+                     const uint max_num_iteration, LQRWorkspace *workspace,
+                     Matrix *ptr_K) {
+  if (A.rows() != A.cols() || B.rows() != A.rows() || Q.rows() != Q.cols() ||
+      Q.rows() != A.rows() || R.rows() != R.cols() || R.rows() != B.cols()) {
+    AERROR << "LQR solver: one or more matrices have incompatible dimensions.";
+    return;
+  }
+  workspace->Resize(A.rows(), B.cols());
+  auto &ws = *workspace;
+
+  // Same iteration as above, with every product evaluated into the
+  // workspace and the inverse replaced by an LU solve
+  ws.P_ = Q;
+  uint num_iteration = 0;
+  double diff = std::numeric_limits<double>::max();
+  while (num_iteration++ < max_num_iteration && diff > tolerance) {
+    ws.AT_P_.noalias() = A.transpose() * ws.P_;
+    ws.AT_P_B_.noalias() = ws.AT_P_ * B;
+    ws.BT_P_.noalias() = B.transpose() * ws.P_;
+    ws.BT_P_A_.noalias() = ws.BT_P_ * A;
+    ws.R_BT_P_B_ = R;
+    ws.R_BT_P_B_.noalias() += ws.BT_P_ * B;
+    ws.lu_.compute(ws.R_BT_P_B_);
+    ws.gain_ = ws.lu_.solve(ws.BT_P_A_);
+
+    ws.P_next_.noalias() = ws.AT_P_ * A;
+    ws.P_next_.noalias() -= ws.AT_P_B_ * ws.gain_;
+    ws.P_next_ += Q;
+    // check the difference between P and P_next
+    diff = fabs((ws.P_next_ - ws.P_).maxCoeff());
+    ws.P_.swap(ws.P_next_);
+  }
+
+  if (num_iteration >= max_num_iteration) {
+    ADEBUG << "LQR solver cannot converge to a solution, "
+              "last consecutive result diff is: "
+           << diff;
+  } else {
+    ADEBUG << "LQR solver converged at iteration: " << num_iteration
+           << ", max consecutive result diff.: " << diff;
+  }
+  ws.BT_P_.noalias() = B.transpose() * ws.P_;
+  ws.BT_P_A_.noalias() = ws.BT_P_ * A;
+  ws.R_BT_P_B_ = R;
+  ws.R_BT_P_B_.noalias() += ws.BT_P_ * B;
+  ws.lu_.compute(ws.R_BT_P_B_);
+  *ptr_K = ws.lu_.solve(ws.BT_P_A_);
+}
+
 }  // namespace math
 }  // namespace common
 }  // namespace apollo
@@ -22,6 +22,7 @@
 #pragma once
 
 #include "Eigen/Core"
+#include "Eigen/LU"
 
 /**
  * @namespace apollo::common::math
@@ -64,6 +65,52 @@ void SolveLQRProblem(const Eigen::MatrixXd &A, const Eigen::MatrixXd &B,
                      const double tolerance, const uint max_num_iteration,
                      Eigen::MatrixXd *ptr_K);
 
+/**
+ * @class LQRWorkspace
+ * @brief Intermediate matrices of SolveLQRProblem. Once sized by a first
+ * solve, later solves with the same dimensions do not allocate.
+ */
+class LQRWorkspace {
+ private:
+  friend void SolveLQRProblem(const Eigen::MatrixXd &A,
+                              const Eigen::MatrixXd &B,
+                              const Eigen::MatrixXd &Q,
+                              const Eigen::MatrixXd &R,
+                              const double tolerance,
+                              const uint max_num_iteration,
+                              LQRWorkspace *workspace, Eigen::MatrixXd *ptr_K);
+
+  void Resize(const Eigen::Index state_dim, const Eigen::Index control_dim);
+
+  Eigen::MatrixXd P_;
+  Eigen::MatrixXd P_next_;
+  Eigen::MatrixXd AT_P_;
+  Eigen::MatrixXd AT_P_B_;
+  Eigen::MatrixXd BT_P_;
+  Eigen::MatrixXd BT_P_A_;
+  Eigen::MatrixXd R_BT_P_B_;
+  Eigen::MatrixXd gain_;
+  Eigen::PartialPivLU<Eigen::MatrixXd> lu_;
+};
+
+/**
+ * @brief Solver for discrete-time linear quadratic problem, keeping its
+ * intermediate matrices in a workspace to avoid allocations.
+ * @param A The system dynamic matrix
+ * @param B The control matrix
+ * @param Q The cost matrix for system state
+ * @param R The cost matrix for control output
+ * @param tolerance The numerical tolerance for solving Discrete
+ *        Algebraic Riccati equation (DARE)
+ * @param max_num_iteration The maximum iterations for solving ARE
+ * @param workspace The intermediate matrices (pointer)
+ * @param ptr_K The feedback control matrix (pointer)
+ */
+void SolveLQRProblem(const Eigen::MatrixXd &A, const Eigen::MatrixXd &B,
+                     const Eigen::MatrixXd &Q, const Eigen::MatrixXd &R,
+                     const double tolerance, const uint max_num_iteration,
+                     LQRWorkspace *workspace, Eigen::MatrixXd *ptr_K);
+
 }  // namespace math
 }  // namespace common
 }  // namespace apollo
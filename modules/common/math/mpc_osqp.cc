@@ -19,6 +19,23 @@
 namespace apollo {
 namespace common {
 namespace math {
+
+MpcOsqpWorkspace::~MpcOsqpWorkspace() { Reset(); }
+
+void MpcOsqpWorkspace::Reset() {
+  if (work_ != nullptr) {
+    osqp_cleanup(work_);
+    work_ = nullptr;
+  }
+  P_data_.clear();
+  P_indices_.clear();
+  P_indptr_.clear();
+  A_data_.clear();
+  A_indices_.clear();
+  A_indptr_.clear();
+  controls_.clear();
+}
+
 MpcOsqp::MpcOsqp(const Eigen::MatrixXd &matrix_a,
                  const Eigen::MatrixXd &matrix_b,
                  const Eigen::MatrixXd &matrix_q,
@@ -279,6 +296,10 @@ void MpcOsqp::FreeData(OSQPData *data) {
 }
 
 bool MpcOsqp::Solve(std::vector<double> *control_cmd) {
+  if (workspace_ != nullptr) {
+    return SolveCondensed(control_cmd);
+  }
+
   ADEBUG << "Before Calc Gradient";
   CalculateGradient();
   ADEBUG << "After Calc Gradient";
@@ -339,6 +360,209 @@ bool MpcOsqp::Solve(std::vector<double> *control_cmd) {
   return true;
 }
 
+// x(k) = A^k * x(0) + sum_j A^(k-1-j) * B * u(j), so the states are
+// eliminated and only the controls are optimized. State bounds become
+// affine constraints on the controls; states without finite bounds are left
+// out.
+void MpcOsqp::CalculateCondensedProblem(
+    std::vector<c_float> *P_data, std::vector<c_int> *P_indices,
+    std::vector<c_int> *P_indptr, std::vector<c_float> *q,
+    std::vector<c_float> *A_data, std::vector<c_int> *A_indices,
+    std::vector<c_int> *A_indptr, std::vector<c_float> *lower_bounds,
+    std::vector<c_float> *upper_bounds) {
+  const size_t num_control = control_dim_ * horizon_;
+
+  // free response A^k * x(0) and forced response of x(1) ... x(horizon)
+  Eigen::MatrixXd matrix_a_power =
+      Eigen::MatrixXd::Identity(state_dim_, state_dim_);
+  std::vector<Eigen::MatrixXd> impulse_response;
+  Eigen::VectorXd free_response(state_dim_ * horizon_);
+  for (size_t k = 0; k < horizon_; ++k) {
+    impulse_response.push_back(matrix_a_power * matrix_b_);
+    matrix_a_power = matrix_a_ * matrix_a_power;
+    free_response.segment(k * state_dim_, state_dim_) =
+        matrix_a_power * matrix_initial_x_;
+  }
+  Eigen::MatrixXd matrix_su =
+      Eigen::MatrixXd::Zero(state_dim_ * horizon_, num_control);
+  for (size_t k = 0; k < horizon_; ++k) {
+    for (size_t j = 0; j <= k; ++j) {
+      matrix_su.block(k * state_dim_, j * control_dim_, state_dim_,
+                      control_dim_) = impulse_response[k - j];
+    }
+  }
+
+  // same cost as the sparse formulation, x(0) only adds a constant
+  Eigen::VectorXd q_diag(state_dim_ * horizon_);
+  Eigen::VectorXd state_gradient(state_dim_ * horizon_);
+  const Eigen::VectorXd ref_gradient = -1.0 * matrix_q_ * matrix_x_ref_;
+  for (size_t k = 0; k < horizon_; ++k) {
+    q_diag.segment(k * state_dim_, state_dim_) = matrix_q_.diagonal();
+    state_gradient.segment(k * state_dim_, state_dim_) = ref_gradient;
+  }
+  Eigen::MatrixXd kernel =
+      matrix_su.transpose() * q_diag.asDiagonal() * matrix_su;
+  for (size_t i = 0; i < num_control; ++i) {
+    kernel(i, i) += matrix_r_(i % control_dim_, i % control_dim_);
+  }
+  const Eigen::VectorXd gradient =
+      matrix_su.transpose() *
+      (q_diag.asDiagonal() * free_response + state_gradient);
+
+  // dense upper triangular kernel
+  for (size_t col = 0; col < num_control; ++col) {
+    P_indptr->emplace_back(P_data->size());
+    for (size_t row = 0; row <= col; ++row) {
+      P_data->emplace_back(kernel(row, col));
+      P_indices->emplace_back(row);
+    }
+  }
+  P_indptr->emplace_back(P_data->size());
+  q->assign(gradient.data(), gradient.data() + num_control);
+
+  // control bounds first, then the bounded states
+  for (size_t k = 0; k < horizon_; ++k) {
+    for (size_t j = 0; j < control_dim_; ++j) {
+      lower_bounds->emplace_back(matrix_u_lower_(j, 0));
+      upper_bounds->emplace_back(matrix_u_upper_(j, 0));
+    }
+  }
+  std::vector<size_t> bounded_rows;
+  for (size_t row = 0; row < state_dim_ * horizon_; ++row) {
+    const double lower = matrix_x_lower_(row % state_dim_, 0);
+    const double upper = matrix_x_upper_(row % state_dim_, 0);
+    if (lower <= -OSQP_INFTY && upper >= OSQP_INFTY) {
+      continue;
+    }
+    bounded_rows.push_back(row);
+    lower_bounds->emplace_back(lower - free_response(row));
+    upper_bounds->emplace_back(upper - free_response(row));
+  }
+
+  // x(k) depends on u(j) for j < k only, keep that block pattern even where
+  // the values vanish so that the pattern does not change between cycles
+  for (size_t col = 0; col < num_control; ++col) {
+    A_indptr->emplace_back(A_data->size());
+    A_data->emplace_back(1.0);
+    A_indices->emplace_back(col);
+    const size_t step = col / control_dim_;
+    for (size_t i = 0; i < bounded_rows.size(); ++i) {
+      if (bounded_rows[i] / state_dim_ >= step) {
+        A_data->emplace_back(matrix_su(bounded_rows[i], col));
+        A_indices->emplace_back(num_control + i);
+      }
+    }
+  }
+  A_indptr->emplace_back(A_data->size());
+}
+
+bool MpcOsqp::SolveCondensed(std::vector<double> *control_cmd) {
+  std::vector<c_float> P_data;
+  std::vector<c_int> P_indices;
+  std::vector<c_int> P_indptr;
+  std::vector<c_float> q;
+  std::vector<c_float> A_data;
+  std::vector<c_int> A_indices;
+  std::vector<c_int> A_indptr;
+  std::vector<c_float> lower_bounds;
+  std::vector<c_float> upper_bounds;
+  CalculateCondensedProblem(&P_data, &P_indices, &P_indptr, &q, &A_data,
+                            &A_indices, &A_indptr, &lower_bounds,
+                            &upper_bounds);
+
+  const size_t num_control = control_dim_ * horizon_;
+  MpcOsqpWorkspace *workspace = workspace_;
+  const bool same_pattern = workspace->initialized() &&
+                            P_indices == workspace->P_indices_ &&
+                            P_indptr == workspace->P_indptr_ &&
+                            A_indices == workspace->A_indices_ &&
+                            A_indptr == workspace->A_indptr_;
+  if (!same_pattern) {
+    workspace->Reset();
+
+    OSQPData *data = reinterpret_cast<OSQPData *>(c_malloc(sizeof(OSQPData)));
+    data->n = num_control;
+    data->m = lower_bounds.size();
+    data->P = csc_matrix(num_control, num_control, P_data.size(),
+                         P_data.data(), P_indices.data(), P_indptr.data());
+    data->q = q.data();
+    data->A = csc_matrix(lower_bounds.size(), num_control, A_data.size(),
+                         A_data.data(), A_indices.data(), A_indptr.data());
+    data->l = lower_bounds.data();
+    data->u = upper_bounds.data();
+
+    OSQPSettings *settings = Settings();
+    settings->warm_start = true;
+
+    // osqp_setup() keeps its own copies of the data and the settings
+    workspace->work_ = osqp_setup(data, settings);
+    c_free(data->A);
+    c_free(data->P);
+    c_free(data);
+    c_free(settings);
+    if (workspace->work_ == nullptr) {
+      AERROR << "Failed to set up the osqp workspace";
+      return false;
+    }
+    workspace->P_data_ = std::move(P_data);
+    workspace->P_indices_ = std::move(P_indices);
+    workspace->P_indptr_ = std::move(P_indptr);
+    workspace->A_data_ = std::move(A_data);
+    workspace->A_indices_ = std::move(A_indices);
+    workspace->A_indptr_ = std::move(A_indptr);
+  } else {
+    OSQPWorkspace *work = workspace->work_;
+    // updating P or A refactorizes the KKT system, skip it when possible
+    if (P_data != workspace->P_data_ || A_data != workspace->A_data_) {
+      osqp_update_P_A(work, P_data.data(), OSQP_NULL,
+                      static_cast<c_int>(P_data.size()), A_data.data(),
+                      OSQP_NULL, static_cast<c_int>(A_data.size()));
+      workspace->P_data_ = std::move(P_data);
+      workspace->A_data_ = std::move(A_data);
+    }
+    osqp_update_lin_cost(work, q.data());
+    if (osqp_update_bounds(work, lower_bounds.data(), upper_bounds.data()) !=
+        0) {
+      AERROR << "Invalid bounds for the osqp workspace";
+      workspace->Reset();
+      return false;
+    }
+    osqp_update_max_iter(work, max_iteration_);
+    osqp_update_eps_abs(work, eps_abs_);
+
+    // the previous solution shifted by one step, holding the last control
+    std::vector<c_float> warm_start(num_control);
+    for (size_t i = 0; i < num_control; ++i) {
+      const size_t shifted = i + control_dim_;
+      warm_start[i] = workspace->controls_[shifted < num_control ? shifted : i];
+    }
+    osqp_warm_start_x(work, warm_start.data());
+  }
+
+  OSQPWorkspace *work = workspace->work_;
+  osqp_solve(work);
+
+  auto status = work->info->status_val;
+  ADEBUG << "status:" << status;
+  if (status < 0 || (status != 1 && status != 2)) {
+    AERROR << "failed optimization status:\t" << work->info->status;
+    workspace->Reset();
+    return false;
+  } else if (work->solution == nullptr) {
+    AERROR << "The solution from OSQP is nullptr";
+    workspace->Reset();
+    return false;
+  }
+
+  workspace->controls_.assign(work->solution->x,
+                              work->solution->x + num_control);
+  for (size_t i = 0; i < control_dim_; ++i) {
+    control_cmd->at(i) = work->solution->x[i];
+    ADEBUG << "control_cmd:" << i << ":" << control_cmd->at(i);
+  }
+  return true;
+}
+
 }  // namespace math
 }  // namespace common
 }  // namespace apollo
@@ -30,6 +30,42 @@
 namespace apollo {
 namespace common {
 namespace math {
+
+/*
+ * @brief:
+ * Keeps the osqp workspace of the condensed mpc problem and its last solution
+ * across control cycles.
+ */
+class MpcOsqpWorkspace {
+ public:
+  MpcOsqpWorkspace() = default;
+
+  MpcOsqpWorkspace(const MpcOsqpWorkspace &) = delete;
+
+  MpcOsqpWorkspace &operator=(const MpcOsqpWorkspace &) = delete;
+
+  ~MpcOsqpWorkspace();
+
+  void Reset();
+
+  bool initialized() const { return work_ != nullptr; }
+
+ private:
+  friend class MpcOsqp;
+
+  OSQPWorkspace *work_ = nullptr;
+
+  std::vector<c_float> P_data_;
+  std::vector<c_int> P_indices_;
+  std::vector<c_int> P_indptr_;
+  std::vector<c_float> A_data_;
+  std::vector<c_int> A_indices_;
+  std::vector<c_int> A_indptr_;
+
+  // controls of the previous solution over the horizon
+  std::vector<c_float> controls_;
+};
+
 class MpcOsqp {
  public:
   /**
@@ -55,7 +91,24 @@ class MpcOsqp {
   // control vector
   bool Solve(std::vector<double> *control_cmd);
 
+  /**
+   * @brief With a workspace, Solve() eliminates the states and optimizes the
+   * controls only. The osqp workspace is kept in the workspace and warm
+   * started from the previous solution shifted by one step.
+   */
+  void set_workspace(MpcOsqpWorkspace *workspace) { workspace_ = workspace; }
+
  private:
+  bool SolveCondensed(std::vector<double> *control_cmd);
+  void CalculateCondensedProblem(std::vector<c_float> *P_data,
+                                 std::vector<c_int> *P_indices,
+                                 std::vector<c_int> *P_indptr,
+                                 std::vector<c_float> *q,
+                                 std::vector<c_float> *A_data,
+                                 std::vector<c_int> *A_indices,
+                                 std::vector<c_int> *A_indptr,
+                                 std::vector<c_float> *lower_bounds,
+                                 std::vector<c_float> *upper_bounds);
   void CalculateKernel(std::vector<c_float> *P_data,
                        std::vector<c_int> *P_indices,
                        std::vector<c_int> *P_indptr);
@@ -96,6 +149,7 @@ class MpcOsqp {
   Eigen::VectorXd gradient_;
   Eigen::VectorXd lowerBound_;
   Eigen::VectorXd upperBound_;
+  MpcOsqpWorkspace *workspace_ = nullptr;
 };
 }  // namespace math
 }  // namespace common
@@ -174,6 +174,79 @@ TEST(MPCOSQPSolverTest, NullMatrix) {
   EXPECT_NEAR(0.0, control_cmd[0], 1e-7);
 }
 
+TEST(MPCOSQPSolverTest, CondensedWarmStartedLatency) {
+  const int states = 4;
+  const int controls = 1;
+  const int horizon = 10;
+  const int max_iter = 4000;
+  const double eps = 1e-6;
+  const double ts = 0.01;
+  const int num_cycles = 200;
+  const double max = std::numeric_limits<double>::max();
+
+  // discretized lateral error dynamics
+  Eigen::MatrixXd A(states, states);
+  A << 1, ts, 0, 0, 0, 1 - 0.5 * ts, 10 * ts, 0, 0, 0, 1, ts, 0, 0.1 * ts,
+      -0.2 * ts, 1 - 0.6 * ts;
+
+  Eigen::MatrixXd B(states, controls);
+  B << 0, 2 * ts, 0, 1.5 * ts;
+
+  Eigen::MatrixXd Q(states, states);
+  Q << 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0;
+
+  Eigen::MatrixXd R(controls, controls);
+  R << 3.25;
+
+  Eigen::MatrixXd lower_bound(controls, 1);
+  lower_bound << -0.5;
+
+  Eigen::MatrixXd upper_bound(controls, 1);
+  upper_bound << 0.5;
+
+  Eigen::MatrixXd state_lower_bound(states, 1);
+  state_lower_bound << -max, -max, -M_PI, -max;
+
+  Eigen::MatrixXd state_upper_bound(states, 1);
+  state_upper_bound << max, max, M_PI, max;
+
+  Eigen::MatrixXd reference_state(states, 1);
+  reference_state << 0, 0, 0, 0;
+
+  Eigen::MatrixXd state(states, 1);
+  state << 1.0, 0, 0.2, 0;
+
+  MpcOsqpWorkspace workspace;
+  std::chrono::duration<double> full_time(0.0);
+  std::chrono::duration<double> condensed_time(0.0);
+  for (int i = 0; i < num_cycles; ++i) {
+    std::vector<double> full_cmd(controls, 0);
+    MpcOsqp full_solver(A, B, Q, R, state, lower_bound, upper_bound,
+                        state_lower_bound, state_upper_bound, reference_state,
+                        max_iter, horizon, eps);
+    auto start_time = std::chrono::system_clock::now();
+    EXPECT_TRUE(full_solver.Solve(&full_cmd));
+    full_time += std::chrono::system_clock::now() - start_time;
+
+    std::vector<double> condensed_cmd(controls, 0);
+    MpcOsqp condensed_solver(A, B, Q, R, state, lower_bound, upper_bound,
+                             state_lower_bound, state_upper_bound,
+                             reference_state, max_iter, horizon, eps);
+    condensed_solver.set_workspace(&workspace);
+    start_time = std::chrono::system_clock::now();
+    EXPECT_TRUE(condensed_solver.Solve(&condensed_cmd));
+    condensed_time += std::chrono::system_clock::now() - start_time;
+
+    EXPECT_NEAR(full_cmd[0], condensed_cmd[0], 1e-3);
+    state = A * state + B * condensed_cmd[0];
+  }
+  EXPECT_TRUE(workspace.initialized());
+  AINFO << "Full OSQP average time: "
+        << full_time.count() * 1000 / num_cycles << " ms.";
+  AINFO << "Condensed OSQP average time: "
+        << condensed_time.count() * 1000 / num_cycles << " ms.";
+}
+
 }  // namespace math
 }  // namespace common
 }  // namespace apollo
@@ -22,6 +22,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <limits>
 #include <vector>
 
 #include "glog/logging.h"
@@ -53,6 +54,50 @@ PathPoint PathMatcher::MatchToPath(const std::vector<PathPoint>& reference_line,
     }
   }
 
+  return MatchToSegment(reference_line, index_min, x, y);
+}
+
+std::vector<PathPoint> PathMatcher::MatchToPath(
+    const std::vector<PathPoint>& reference_line,
+    const std::vector<Vec2d>& points) {
+  CHECK_GT(reference_line.size(), 0);
+
+  std::vector<double> xs;
+  std::vector<double> ys;
+  xs.reserve(reference_line.size());
+  ys.reserve(reference_line.size());
+  for (const auto& point : reference_line) {
+    xs.push_back(point.x());
+    ys.push_back(point.y());
+  }
+
+  std::vector<PathPoint> matched_points;
+  matched_points.reserve(points.size());
+  for (const auto& point : points) {
+    const double x = point.x();
+    const double y = point.y();
+    double dx = xs[0] - x;
+    double dy = ys[0] - y;
+    double distance_min = dx * dx + dy * dy;
+    std::size_t index_min = 0;
+
+    for (std::size_t i = 1; i < xs.size(); ++i) {
+      dx = xs[i] - x;
+      dy = ys[i] - y;
+      double distance_temp = dx * dx + dy * dy;
+      if (distance_temp < distance_min) {
+        distance_min = distance_temp;
+        index_min = i;
+      }
+    }
+    matched_points.push_back(MatchToSegment(reference_line, index_min, x, y));
+  }
+  return matched_points;
+}
+
+PathPoint PathMatcher::MatchToSegment(
+    const std::vector<PathPoint>& reference_line, const std::size_t index_min,
+    const double x, const double y) {
   std::size_t index_start = (index_min == 0) ? index_min : index_min - 1;
   std::size_t index_end =
       (index_min + 1 == reference_line.size()) ? index_min : index_min + 1;
@@ -101,6 +146,47 @@ PathPoint PathMatcher::MatchToPath(const std::vector<PathPoint>& reference_line,
   return InterpolateUsingLinearApproximation(*(it_lower - 1), *it_lower, s);
 }
 
+std::vector<PathPoint> PathMatcher::MatchToPath(
+    const std::vector<PathPoint>& reference_line,
+    const std::vector<double>& stations) {
+  auto comp = [](const PathPoint& point, const double s) {
+    return point.s() < s;
+  };
+
+  std::vector<PathPoint> matched_points;
+  matched_points.reserve(stations.size());
+  // All the reference points before the hint are below the last station.
+  auto hint = reference_line.begin();
+  double last_s = -std::numeric_limits<double>::infinity();
+  for (const double s : stations) {
+    if (!(s >= last_s)) {
+      hint = reference_line.begin();
+    }
+    last_s = s;
+
+    // Gallop from the hint to bound the binary search.
+    auto first = hint;
+    std::ptrdiff_t step = 1;
+    while (step < reference_line.end() - first && (first + step - 1)->s() < s) {
+      first += step;
+      step *= 2;
+    }
+    auto last = first + std::min(step, reference_line.end() - first);
+    auto it_lower = std::lower_bound(first, last, s, comp);
+    hint = it_lower;
+
+    if (it_lower == reference_line.begin()) {
+      matched_points.push_back(reference_line.front());
+    } else if (it_lower == reference_line.end()) {
+      matched_points.push_back(reference_line.back());
+    } else {
+      matched_points.push_back(
+          InterpolateUsingLinearApproximation(*(it_lower - 1), *it_lower, s));
+    }
+  }
+  return matched_points;
+}
+
 PathPoint PathMatcher::FindProjectionPoint(const PathPoint& p0,
                                            const PathPoint& p1, const double x,
                                            const double y) {
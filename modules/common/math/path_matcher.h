@@ -23,6 +23,7 @@
 #include <utility>
 #include <vector>
 
+#include "modules/common/math/vec2d.h"
 #include "modules/common/proto/pnc_point.pb.h"
 
 namespace apollo {
@@ -43,7 +44,30 @@ class PathMatcher {
   static PathPoint MatchToPath(const std::vector<PathPoint>& reference_line,
                                const double s);
 
+  /**
+   * @brief Match a batch of points to the reference line, the same as
+   * MatchToPath(reference_line, x, y) on each of them, but scanning a packed
+   * copy of the reference line positions.
+   */
+  static std::vector<PathPoint> MatchToPath(
+      const std::vector<PathPoint>& reference_line,
+      const std::vector<Vec2d>& points);
+
+  /**
+   * @brief Match a batch of stations to the reference line, the same as
+   * MatchToPath(reference_line, s) on each of them. The search starts from
+   * where the previous station matched, so that matching non-decreasing
+   * stations takes linear time overall.
+   */
+  static std::vector<PathPoint> MatchToPath(
+      const std::vector<PathPoint>& reference_line,
+      const std::vector<double>& stations);
+
  private:
+  static PathPoint MatchToSegment(const std::vector<PathPoint>& reference_line,
+                                  const std::size_t index_min, const double x,
+                                  const double y);
+
   static PathPoint FindProjectionPoint(const PathPoint& p0, const PathPoint& p1,
                                        const double x, const double y);
 };
@@ -30,6 +30,14 @@
 namespace apollo {
 namespace common {
 namespace math {
+namespace {
+
+// A separating gap on an edge normal is only trusted to keep the polygons
+// farther apart than kMathEpsilon when it is well above the rounding error
+// of the projections of map coordinates.
+constexpr double kSeparatingGap = 1e-6;
+
+}  // namespace
 
 Polygon2d::Polygon2d(const Box2d &box) {
   box.GetAllCorners(&points_);
@@ -125,8 +133,18 @@ bool Polygon2d::IsPointOnBoundary(const Vec2d &point) const {
       [&](const LineSegment2d &poly_seg) { return poly_seg.IsPointIn(point); });
 }
 
+bool Polygon2d::IsOutsideAABoundingBox(const Vec2d &point) const {
+  // Points within kMathEpsilon of an edge are on the boundary.
+  return point.x() < min_x_ - kMathEpsilon ||
+         point.x() > max_x_ + kMathEpsilon ||
+         point.y() < min_y_ - kMathEpsilon || point.y() > max_y_ + kMathEpsilon;
+}
+
 bool Polygon2d::IsPointIn(const Vec2d &point) const {
   CHECK_GE(points_.size(), 3);
+  if (IsOutsideAABoundingBox(point)) {
+    return false;
+  }
   if (IsPointOnBoundary(point)) {
     return true;
   }
@@ -144,15 +162,115 @@ bool Polygon2d::IsPointIn(const Vec2d &point) const {
   return c & 1;
 }
 
+void Polygon2d::IsPointIn(const std::vector<Vec2d> &points,
+                          std::vector<bool> *const inside) const {
+  CHECK_GE(points_.size(), 3);
+  inside->assign(points.size(), false);
+
+  // Edge i runs from vertex i to vertex i + 1, and is crossed by the ray
+  // cast from a point as the pair of vertex i and vertex i - 1 is.
+  const size_t num_edges = line_segments_.size();
+  std::vector<double> start_x(num_edges);
+  std::vector<double> start_y(num_edges);
+  std::vector<double> end_x(num_edges);
+  std::vector<double> end_y(num_edges);
+  std::vector<double> lower_x(num_edges);
+  std::vector<double> upper_x(num_edges);
+  std::vector<double> lower_y(num_edges);
+  std::vector<double> upper_y(num_edges);
+  std::vector<int> degenerate(num_edges);
+  std::vector<double> prev_x(num_points_);
+  std::vector<double> prev_y(num_points_);
+  for (size_t i = 0; i < num_edges; ++i) {
+    const LineSegment2d &edge = line_segments_[i];
+    start_x[i] = edge.start().x();
+    start_y[i] = edge.start().y();
+    end_x[i] = edge.end().x();
+    end_y[i] = edge.end().y();
+    lower_x[i] = std::min(start_x[i], end_x[i]) - kMathEpsilon;
+    upper_x[i] = std::max(start_x[i], end_x[i]) + kMathEpsilon;
+    lower_y[i] = std::min(start_y[i], end_y[i]) - kMathEpsilon;
+    upper_y[i] = std::max(start_y[i], end_y[i]) + kMathEpsilon;
+    degenerate[i] = static_cast<int>(edge.length() <= kMathEpsilon);
+  }
+  for (int i = 0; i < num_points_; ++i) {
+    prev_x[i] = points_[Prev(i)].x();
+    prev_y[i] = points_[Prev(i)].y();
+  }
+
+  for (size_t k = 0; k < points.size(); ++k) {
+    const Vec2d &point = points[k];
+    if (IsOutsideAABoundingBox(point)) {
+      continue;
+    }
+    const double x = point.x();
+    const double y = point.y();
+
+    int on_boundary = 0;
+    for (size_t i = 0; i < num_edges; ++i) {
+      const double prod =
+          (start_x[i] - x) * (end_y[i] - y) - (start_y[i] - y) * (end_x[i] - x);
+      const int on_edge = static_cast<int>(std::abs(prod) <= kMathEpsilon) &
+                          static_cast<int>(x >= lower_x[i]) &
+                          static_cast<int>(x <= upper_x[i]) &
+                          static_cast<int>(y >= lower_y[i]) &
+                          static_cast<int>(y <= upper_y[i]);
+      const int on_start =
+          static_cast<int>(std::abs(x - start_x[i]) <= kMathEpsilon) &
+          static_cast<int>(std::abs(y - start_y[i]) <= kMathEpsilon);
+      on_boundary |= degenerate[i] ? on_start : on_edge;
+    }
+    if (on_boundary) {
+      (*inside)[k] = true;
+      continue;
+    }
+
+    int c = 0;
+    for (int i = 0; i < num_points_; ++i) {
+      const double side = (start_x[i] - x) * (prev_y[i] - y) -
+                          (start_y[i] - y) * (prev_x[i] - x);
+      const int crosses = static_cast<int>((start_y[i] > y) != (prev_y[i] > y));
+      const int right = start_y[i] < prev_y[i] ? static_cast<int>(side > 0.0)
+                                               : static_cast<int>(side < 0.0);
+      c += crosses & right;
+    }
+    (*inside)[k] = (c & 1) != 0;
+  }
+}
+
 bool Polygon2d::HasOverlap(const Polygon2d &polygon) const {
   CHECK_GE(points_.size(), 3);
   if (polygon.max_x() < min_x() || polygon.min_x() > max_x() ||
       polygon.max_y() < min_y() || polygon.min_y() > max_y()) {
     return false;
   }
+  if (is_convex_ && polygon.is_convex_ &&
+      (HasSeparatingAxis(polygon) || polygon.HasSeparatingAxis(*this))) {
+    return false;
+  }
   return DistanceTo(polygon) <= kMathEpsilon;
 }
 
+bool Polygon2d::HasSeparatingAxis(const Polygon2d &polygon) const {
+  for (const auto &edge : line_segments_) {
+    if (edge.length() <= kMathEpsilon) {
+      continue;
+    }
+    // The points are counter-clockwise, so that this convex polygon lies
+    // behind the outward normal of each of its edges.
+    const Vec2d &unit = edge.unit_direction();
+    double min_projection = std::numeric_limits<double>::infinity();
+    for (const auto &point : polygon.points_) {
+      min_projection =
+          std::min(min_projection, -unit.CrossProd(point - edge.start()));
+    }
+    if (min_projection > kSeparatingGap) {
+      return true;
+    }
+  }
+  return false;
+}
+
 bool Polygon2d::Contains(const LineSegment2d &line_segment) const {
   if (line_segment.length() <= kMathEpsilon) {
     return IsPointIn(line_segment.start());
@@ -160,6 +160,17 @@ class Polygon2d {
    */
   bool IsPointIn(const Vec2d &point) const;
 
+  /**
+   * @brief Check if each of the points is within the polygon, the same as
+   *        IsPointIn(point) on each of them. The edges are packed once for
+   *        all the points, and tested without branches so that the compiler
+   *        vectorizes the loop over them.
+   * @param points The target points.
+   * @param inside Whether each of the points is within the polygon.
+   */
+  void IsPointIn(const std::vector<Vec2d> &points,
+                 std::vector<bool> *const inside) const;
+
   /**
    * @brief Check if a point is on the boundary of the polygon.
    * @param point The target point. To check if it is on the boundary
@@ -325,6 +336,11 @@ class Polygon2d {
   static bool ClipConvexHull(const LineSegment2d &line_segment,
                              std::vector<Vec2d> *const points);
 
+  // Whether an edge normal of this convex polygon separates the other one.
+  bool HasSeparatingAxis(const Polygon2d &polygon) const;
+
+  bool IsOutsideAABoundingBox(const Vec2d &point) const;
+
   std::vector<Vec2d> points_;
   int num_points_ = 0;
   std::vector<LineSegment2d> line_segments_;
@@ -128,6 +128,30 @@ TEST(Polygon2dTest, polygon_IsPointIn) {
   EXPECT_FALSE(poly5.IsPointIn({4.5, 2.0}));
 }
 
+TEST(Polygon2dTest, IsPointInBatch) {
+  const Polygon2d box_poly(Box2d({1, 2}, 0.3, 4, 2));
+  const Polygon2d concave_poly(
+      std::vector<Vec2d>{{0, 0}, {4, 0}, {4, 4}, {3, 4}, {2, 1}, {1, 4},
+                         {0, 4}, {0, 2}, {0, 2}});
+  for (const Polygon2d *poly : {&box_poly, &concave_poly}) {
+    std::vector<Vec2d> points = poly->points();
+    for (int i = 0; i < 2000; ++i) {
+      points.emplace_back(RandomDouble(-2, 6), RandomDouble(-2, 6));
+    }
+    points.emplace_back(2, 1);
+    points.emplace_back(2, 0);
+    points.emplace_back(0, 3);
+
+    std::vector<bool> inside;
+    poly->IsPointIn(points, &inside);
+    ASSERT_EQ(points.size(), inside.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+      EXPECT_EQ(poly->IsPointIn(points[i]), inside[i])
+          << points[i].DebugString();
+    }
+  }
+}
+
 TEST(Polygon2dTest, DistanceToPoint) {
   const Box2d box1(Box2d::CreateAABox({0, 0}, {1, 1}));
   const Polygon2d poly1(box1);
@@ -595,6 +619,29 @@ TEST(Polygon2dTest, Overlap) {
   }
 }
 
+TEST(Polygon2dTest, OverlapBySeparatingAxis) {
+  for (int iter = 0; iter < 10000; ++iter) {
+    const Polygon2d poly1(Box2d({RandomDouble(-5, 5), RandomDouble(-5, 5)},
+                                RandomDouble(0, M_PI * 2.0),
+                                RandomDouble(1, 5), RandomDouble(1, 5)));
+    const Polygon2d poly2(Box2d({RandomDouble(-5, 5), RandomDouble(-5, 5)},
+                                RandomDouble(0, M_PI * 2.0),
+                                RandomDouble(1, 5), RandomDouble(1, 5)));
+    const bool overlap = poly1.DistanceTo(poly2) <= kMathEpsilon;
+    EXPECT_EQ(overlap, poly1.HasOverlap(poly2));
+    EXPECT_EQ(overlap, poly2.HasOverlap(poly1));
+  }
+
+  // Touching polygons overlap.
+  const Polygon2d poly1(Box2d::CreateAABox({0, 0}, {2, 2}));
+  const Polygon2d poly2(Box2d({3, 1}, M_PI_4, sqrt(2.0), sqrt(2.0)));
+  const Polygon2d poly3(Box2d({3.5, 1}, M_PI_4, sqrt(2.0), sqrt(2.0)));
+  EXPECT_TRUE(poly1.HasOverlap(poly2));
+  EXPECT_TRUE(poly2.HasOverlap(poly1));
+  EXPECT_FALSE(poly1.HasOverlap(poly3));
+  EXPECT_FALSE(poly3.HasOverlap(poly1));
+}
+
 TEST(Polygon2dTest, BoundingBox) {
   Polygon2d poly1(Box2d::CreateAABox({0, 0}, {2, 2}));
   Box2d box = poly1.BoundingBoxWithHeading(0.0);
@@ -21,13 +21,17 @@
 #include "absl/strings/str_cat.h"
 
 #include "cyber/common/log.h"
+#include "modules/common/math/fast_trig.h"
 
 namespace apollo {
 namespace common {
 namespace math {
 
 Vec2d Vec2d::CreateUnitVec2d(const double angle) {
-  return Vec2d(std::cos(angle), std::sin(angle));
+  double sin_angle = 0.0;
+  double cos_angle = 0.0;
+  SinCos(angle, &sin_angle, &cos_angle);
+  return Vec2d(cos_angle, sin_angle);
 }
 
 double Vec2d::Length() const { return std::hypot(x_, y_); }
@@ -0,0 +1,106 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/util/async_proto_writer.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "cyber/common/file.h"
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace common {
+namespace util {
+
+AsyncProtoWriter::AsyncProtoWriter(const size_t max_pending)
+    : max_pending_(std::max<size_t>(max_pending, 1)) {
+  thread_ = std::thread(&AsyncProtoWriter::Run, this);
+}
+
+AsyncProtoWriter::~AsyncProtoWriter() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  job_cv_.notify_all();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+void AsyncProtoWriter::Write(
+    const std::string& file_name,
+    std::unique_ptr<google::protobuf::Message> message) {
+  if (message == nullptr) {
+    return;
+  }
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_cv_.wait(lock, [this] { return jobs_.size() < max_pending_; });
+    jobs_.push_back({file_name, std::move(message)});
+  }
+  job_cv_.notify_one();
+}
+
+void AsyncProtoWriter::Flush() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  done_cv_.wait(lock, [this] { return jobs_.empty() && !writing_; });
+}
+
+size_t AsyncProtoWriter::NumFailed() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return num_failed_;
+}
+
+void AsyncProtoWriter::Run() {
+  while (true) {
+    Job job;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      // drain the queue before stopping
+      job_cv_.wait(lock, [this] { return stop_ || !jobs_.empty(); });
+      if (jobs_.empty()) {
+        return;
+      }
+      job = std::move(jobs_.front());
+      jobs_.pop_front();
+      writing_ = true;
+    }
+    // a slot is free as soon as the job leaves the queue
+    done_cv_.notify_all();
+
+    const bool ok =
+        cyber::common::SetProtoToBinaryFile(*job.message, job.file_name);
+    if (!ok) {
+      AERROR << "Failed to write " << job.file_name;
+    }
+    job.message.reset();
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      writing_ = false;
+      if (!ok) {
+        ++num_failed_;
+      }
+    }
+    done_cv_.notify_all();
+  }
+}
+
+}  // namespace util
+}  // namespace common
+}  // namespace apollo
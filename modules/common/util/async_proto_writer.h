@@ -0,0 +1,100 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include "google/protobuf/message.h"
+
+namespace apollo {
+namespace common {
+namespace util {
+
+/**
+ * @class AsyncProtoWriter
+ * @brief Serializes protobuf messages to binary files on a background thread,
+ * so offline data dumps hand over a finished batch instead of blocking on
+ * serialization and disk. Files are written in the order they are queued.
+ */
+class AsyncProtoWriter {
+ public:
+  /**
+   * @param max_pending Write() blocks while this many messages are queued,
+   * which bounds the memory held by unwritten batches.
+   */
+  explicit AsyncProtoWriter(const size_t max_pending = 4);
+
+  /**
+   * @brief Writes every queued message, then stops the writer thread.
+   */
+  ~AsyncProtoWriter();
+
+  void Write(const std::string& file_name,
+             std::unique_ptr<google::protobuf::Message> message);
+
+  /**
+   * @brief Moves the content of the message into the queue and leaves it
+   * empty, without copying it.
+   */
+  template <typename T>
+  void WriteAndClear(const std::string& file_name, T* message) {
+    std::unique_ptr<T> batch(new T());
+    batch->Swap(message);
+    Write(file_name, std::move(batch));
+  }
+
+  /**
+   * @brief Blocks until every queued message is written.
+   */
+  void Flush();
+
+  /**
+   * @brief The number of files that failed to be written.
+   */
+  size_t NumFailed() const;
+
+ private:
+  struct Job {
+    std::string file_name;
+    std::unique_ptr<google::protobuf::Message> message;
+  };
+
+  void Run();
+
+  const size_t max_pending_;
+  std::deque<Job> jobs_;
+  bool writing_ = false;
+  bool stop_ = false;
+  size_t num_failed_ = 0;
+  mutable std::mutex mutex_;
+  // signaled when a job is queued or the writer stops
+  std::condition_variable job_cv_;
+  // signaled when a job is written
+  std::condition_variable done_cv_;
+  std::thread thread_;
+};
+
+}  // namespace util
+}  // namespace common
+}  // namespace apollo
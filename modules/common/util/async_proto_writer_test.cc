@@ -0,0 +1,70 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/util/async_proto_writer.h"
+
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "cyber/common/file.h"
+#include "modules/common/util/testdata/simple.pb.h"
+
+namespace apollo {
+namespace common {
+namespace util {
+
+TEST(AsyncProtoWriterTest, WriteAndFlush) {
+  const std::string dir = "/tmp/async_proto_writer_test";
+  ASSERT_TRUE(cyber::common::EnsureDirectory(dir));
+  AsyncProtoWriter writer(2);
+  for (int i = 0; i < 10; ++i) {
+    test::SimpleMessage message;
+    message.set_integer(i);
+    writer.WriteAndClear(dir + "/" + std::to_string(i) + ".bin", &message);
+    EXPECT_FALSE(message.has_integer());
+  }
+  writer.Flush();
+  EXPECT_EQ(0, writer.NumFailed());
+  for (int i = 0; i < 10; ++i) {
+    test::SimpleMessage message;
+    ASSERT_TRUE(cyber::common::GetProtoFromBinaryFile(
+        dir + "/" + std::to_string(i) + ".bin", &message));
+    EXPECT_EQ(i, message.integer());
+  }
+
+  test::SimpleMessage message;
+  writer.WriteAndClear(dir + "/missing/0.bin", &message);
+  writer.Flush();
+  EXPECT_EQ(1, writer.NumFailed());
+}
+
+TEST(AsyncProtoWriterTest, WriteOnDestruction) {
+  const std::string file_name = "/tmp/async_proto_writer_test_last.bin";
+  {
+    AsyncProtoWriter writer;
+    test::SimpleMessage message;
+    message.set_integer(42);
+    writer.WriteAndClear(file_name, &message);
+  }
+  test::SimpleMessage message;
+  ASSERT_TRUE(cyber::common::GetProtoFromBinaryFile(file_name, &message));
+  EXPECT_EQ(42, message.integer());
+}
+
+}  // namespace util
+}  // namespace common
+}  // namespace apollo
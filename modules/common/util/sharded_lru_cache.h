@@ -0,0 +1,239 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace apollo {
+namespace common {
+namespace util {
+
+/**
+ * @class ShardedLRUCache
+ * @brief A thread safe LRU cache. The keys are spread over shards by their
+ * hash, each with its own lock, hash table and recency list, so that lookups
+ * take constant time and threads working on different shards do not contend.
+ *
+ * The capacity is split evenly among the shards, and the least recently used
+ * entry of a shard is evicted when the shard is full, which approximates the
+ * least recently used entry of the whole cache.
+ */
+template <class K, class V, class Hash = std::hash<K>>
+class ShardedLRUCache {
+ public:
+  /**
+   * @brief Called with every entry evicted to make room for another one, with
+   * the lock of its shard held. The value may be moved from.
+   */
+  using EvictionCallback = std::function<void(const K&, V*)>;
+
+  explicit ShardedLRUCache(const size_t capacity,
+                           const size_t num_shards = kDefaultNumShards,
+                           EvictionCallback eviction_callback = nullptr)
+      : num_shards_(std::max<size_t>(num_shards, 1)),
+        shard_capacity_(
+            std::max<size_t>((capacity + num_shards_ - 1) / num_shards_, 1)),
+        shards_(new Shard[num_shards_]),
+        eviction_callback_(std::move(eviction_callback)) {}
+
+  /*
+   * for both add & update purposes, and marks the entry as the most recently
+   * used one
+   */
+  template <typename VV>
+  void Put(const K& key, VV&& val) {
+    Shard& shard = GetShard(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.index.find(key);
+    if (it != shard.index.end()) {
+      it->second->second = std::forward<VV>(val);
+      shard.entries.splice(shard.entries.begin(), shard.entries, it->second);
+      return;
+    }
+    if (shard.entries.size() >= shard_capacity_) {
+      auto& obsolete = shard.entries.back();
+      if (eviction_callback_) {
+        eviction_callback_(obsolete.first, &obsolete.second);
+      }
+      shard.index.erase(obsolete.first);
+      shard.entries.pop_back();
+      ++shard.evictions;
+    }
+    shard.entries.emplace_front(key, std::forward<VV>(val));
+    shard.index.emplace(key, shard.entries.begin());
+  }
+
+  /*
+   * copies the value out and marks the entry as the most recently used one
+   */
+  bool Get(const K& key, V* const val) {
+    return Visit(key, [val](const V& value) { *val = value; });
+  }
+
+  /*
+   * copies the value out without changing the recency or the metrics
+   */
+  bool GetSilently(const K& key, V* const val) const {
+    const Shard& shard = GetShard(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.index.find(key);
+    if (it == shard.index.end()) {
+      return false;
+    }
+    *val = it->second->second;
+    return true;
+  }
+
+  /*
+   * calls the visitor with the value, with the lock of its shard held, and
+   * marks the entry as the most recently used one. The visitor must not call
+   * back into the cache.
+   */
+  template <typename Visitor>
+  bool Visit(const K& key, Visitor&& visitor) {
+    Shard& shard = GetShard(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.index.find(key);
+    if (it == shard.index.end()) {
+      ++shard.misses;
+      return false;
+    }
+    ++shard.hits;
+    shard.entries.splice(shard.entries.begin(), shard.entries, it->second);
+    visitor(it->second->second);
+    return true;
+  }
+
+  bool Contains(const K& key) const {
+    const Shard& shard = GetShard(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    return shard.index.find(key) != shard.index.end();
+  }
+
+  /*
+   * removes the entry without calling the eviction callback, and moves its
+   * value out if val is not null
+   */
+  bool Remove(const K& key, V* const val = nullptr) {
+    Shard& shard = GetShard(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.index.find(key);
+    if (it == shard.index.end()) {
+      return false;
+    }
+    if (val != nullptr) {
+      *val = std::move(it->second->second);
+    }
+    shard.entries.erase(it->second);
+    shard.index.erase(it);
+    return true;
+  }
+
+  void Clear() {
+    for (size_t i = 0; i < num_shards_; ++i) {
+      std::lock_guard<std::mutex> lock(shards_[i].mutex);
+      shards_[i].index.clear();
+      shards_[i].entries.clear();
+    }
+  }
+
+  size_t size() const {
+    return Sum([](const Shard& shard) { return shard.entries.size(); });
+  }
+
+  size_t capacity() const { return shard_capacity_ * num_shards_; }
+
+  size_t num_shards() const { return num_shards_; }
+
+  uint64_t hits() const {
+    return Sum([](const Shard& shard) { return shard.hits; });
+  }
+
+  uint64_t misses() const {
+    return Sum([](const Shard& shard) { return shard.misses; });
+  }
+
+  uint64_t evictions() const {
+    return Sum([](const Shard& shard) { return shard.evictions; });
+  }
+
+  /*
+   * the ratio of the lookups by Get() and Visit() that found their key
+   */
+  double HitRatio() const {
+    const uint64_t num_hits = hits();
+    const uint64_t num_lookups = num_hits + misses();
+    return num_lookups == 0 ? 0.0
+                            : static_cast<double>(num_hits) /
+                                  static_cast<double>(num_lookups);
+  }
+
+ private:
+  static constexpr size_t kDefaultNumShards = 16;
+  static constexpr size_t kCacheLineSize = 64;
+
+  // Aligned so that the locks of neighbouring shards do not share a line.
+  struct alignas(kCacheLineSize) Shard {
+    using Entries = std::list<std::pair<K, V>>;
+
+    mutable std::mutex mutex;
+    Entries entries;
+    std::unordered_map<K, typename Entries::iterator, Hash> index;
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+  };
+
+  size_t ShardIndex(const K& key) const {
+    // Fibonacci hashing spreads identity hashes of consecutive integer keys.
+    const uint64_t hash =
+        static_cast<uint64_t>(Hash()(key)) * 0x9E3779B97F4A7C15ULL;
+    return static_cast<size_t>(hash >> 32) % num_shards_;
+  }
+
+  Shard& GetShard(const K& key) { return shards_[ShardIndex(key)]; }
+
+  const Shard& GetShard(const K& key) const {
+    return shards_[ShardIndex(key)];
+  }
+
+  template <typename Getter>
+  uint64_t Sum(const Getter& getter) const {
+    uint64_t sum = 0;
+    for (size_t i = 0; i < num_shards_; ++i) {
+      std::lock_guard<std::mutex> lock(shards_[i].mutex);
+      sum += getter(shards_[i]);
+    }
+    return sum;
+  }
+
+  const size_t num_shards_;
+  const size_t shard_capacity_;
+  std::unique_ptr<Shard[]> shards_;
+  const EvictionCallback eviction_callback_;
+};
+
+}  // namespace util
+}  // namespace common
+}  // namespace apollo
@@ -0,0 +1,139 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/util/sharded_lru_cache.h"
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace common {
+namespace util {
+
+TEST(ShardedLRUCache, General) {
+  std::vector<int> evicted;
+  ShardedLRUCache<int, int> cache(
+      4, 1, [&evicted](const int& key, int*) { evicted.push_back(key); });
+  EXPECT_EQ(4, cache.capacity());
+
+  for (int i = 0; i < 4; ++i) {
+    cache.Put(i, 10 * i);
+  }
+  int val = 0;
+  EXPECT_TRUE(cache.Get(0, &val));
+  EXPECT_EQ(0, val);
+  EXPECT_TRUE(cache.GetSilently(1, &val));
+  EXPECT_EQ(10, val);
+
+  // 1 is the least recently used, as GetSilently() does not count.
+  cache.Put(4, 40);
+  EXPECT_EQ(std::vector<int>({1}), evicted);
+  EXPECT_FALSE(cache.Contains(1));
+  EXPECT_FALSE(cache.Get(1, &val));
+
+  // Updates do not evict.
+  cache.Put(2, 21);
+  EXPECT_EQ(4, cache.size());
+  EXPECT_TRUE(cache.Get(2, &val));
+  EXPECT_EQ(21, val);
+  cache.Put(5, 50);
+  EXPECT_EQ(std::vector<int>({1, 3}), evicted);
+
+  EXPECT_TRUE(cache.Remove(0, &val));
+  EXPECT_EQ(0, val);
+  EXPECT_FALSE(cache.Remove(0));
+  EXPECT_EQ(3, cache.size());
+  EXPECT_EQ(std::vector<int>({1, 3}), evicted);
+
+  EXPECT_EQ(2, cache.hits());
+  EXPECT_EQ(1, cache.misses());
+  EXPECT_EQ(2, cache.evictions());
+  EXPECT_DOUBLE_EQ(2.0 / 3.0, cache.HitRatio());
+
+  cache.Clear();
+  EXPECT_EQ(0, cache.size());
+}
+
+TEST(ShardedLRUCache, MoveOnlyValues) {
+  std::vector<int> evicted;
+  ShardedLRUCache<int, std::unique_ptr<int>> cache(
+      2, 1, [&evicted](const int&, std::unique_ptr<int>* val) {
+        std::unique_ptr<int> owned = std::move(*val);
+        evicted.push_back(*owned);
+      });
+  cache.Put(1, std::unique_ptr<int>(new int(10)));
+  cache.Put(2, std::unique_ptr<int>(new int(20)));
+  EXPECT_TRUE(cache.Visit(1, [](std::unique_ptr<int>& val) { *val += 1; }));
+  cache.Put(3, std::unique_ptr<int>(new int(30)));
+  EXPECT_EQ(std::vector<int>({20}), evicted);
+
+  std::unique_ptr<int> val;
+  EXPECT_TRUE(cache.Remove(1, &val));
+  EXPECT_EQ(11, *val);
+}
+
+TEST(ShardedLRUCache, Shards) {
+  ShardedLRUCache<int, int> cache(100, 8);
+  EXPECT_EQ(8, cache.num_shards());
+  EXPECT_EQ(104, cache.capacity());
+  for (int i = 0; i < 1000; ++i) {
+    cache.Put(i, i);
+  }
+  EXPECT_LE(cache.size(), cache.capacity());
+  EXPECT_EQ(1000 - cache.size(), cache.evictions());
+  // The last keys put are the most recent ones of their shards.
+  int found = 0;
+  for (int i = 990; i < 1000; ++i) {
+    int val = 0;
+    found += cache.Get(i, &val);
+  }
+  EXPECT_EQ(10, found);
+}
+
+TEST(ShardedLRUCache, Concurrent) {
+  constexpr int kNumThreads = 8;
+  constexpr int kNumKeys = 256;
+  constexpr int kNumOps = 20000;
+  ShardedLRUCache<int, int> cache(kNumKeys / 2, 16);
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kNumThreads; ++t) {
+    threads.emplace_back([&cache, t]() {
+      for (int i = 0; i < kNumOps; ++i) {
+        const int key = (i * 7 + t * 13) % kNumKeys;
+        int val = 0;
+        if (cache.Get(key, &val)) {
+          EXPECT_EQ(key, val);
+        } else {
+          cache.Put(key, key);
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_LE(cache.size(), cache.capacity());
+  EXPECT_EQ(static_cast<uint64_t>(kNumThreads * kNumOps),
+            cache.hits() + cache.misses());
+}
+
+}  // namespace util
+}  // namespace common
+}  // namespace apollo
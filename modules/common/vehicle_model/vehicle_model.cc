@@ -16,6 +16,8 @@
 
 #include "modules/common/vehicle_model/vehicle_model.h"
 
+#include <cmath>
+
 #include "cyber/common/file.h"
 #include "modules/common/configs/config_gflags.h"
 
@@ -33,7 +35,6 @@ void VehicleModel::RearCenteredKinematicBicycleModel(
   double dt = vehicle_model_config.rc_kinematic_bicycle_model().dt();
   double cur_x = cur_vehicle_state.x();
   double cur_y = cur_vehicle_state.y();
-  double cur_z = cur_vehicle_state.z();
   double cur_phi = cur_vehicle_state.heading();
   double cur_v = cur_vehicle_state.linear_velocity();
   double cur_a = cur_vehicle_state.linear_acceleration();
@@ -70,18 +71,11 @@ void VehicleModel::RearCenteredKinematicBicycleModel(
     cur_v = next_v;
   }
 
-  predicted_vehicle_state->set_x(next_x);
-  predicted_vehicle_state->set_y(next_y);
-  predicted_vehicle_state->set_z(cur_z);
-  predicted_vehicle_state->set_heading(next_phi);
-  predicted_vehicle_state->set_kappa(cur_vehicle_state.kappa());
-  predicted_vehicle_state->set_linear_velocity(next_v);
-  predicted_vehicle_state->set_linear_acceleration(
-      cur_vehicle_state.linear_acceleration());
+  SetPredictedState(cur_vehicle_state, next_x, next_y, next_phi, next_v,
+                    predicted_vehicle_state);
 }
 
-VehicleState VehicleModel::Predict(const double predicted_time_horizon,
-                                   const VehicleState& cur_vehicle_state) {
+VehicleModelConfig VehicleModel::LoadConfig() {
   VehicleModelConfig vehicle_model_config;
 
   ACHECK(cyber::common::GetProtoFromFile(FLAGS_vehicle_model_config_filename,
@@ -93,6 +87,100 @@ VehicleState VehicleModel::Predict(const double predicted_time_horizon,
   ACHECK(vehicle_model_config.model_type() !=
          VehicleModelConfig::COM_CENTERED_DYNAMIC_BICYCLE_MODEL);
   ACHECK(vehicle_model_config.model_type() != VehicleModelConfig::MLP_MODEL);
+  return vehicle_model_config;
+}
+
+std::vector<double> VehicleModel::RearCenteredKinematicBicycleModelSteps(
+    const VehicleModelConfig& vehicle_model_config,
+    const double predicted_time_horizon) {
+  // The same steps as the loop of RearCenteredKinematicBicycleModel()
+  CHECK_GT(predicted_time_horizon, 0.0);
+  double dt = vehicle_model_config.rc_kinematic_bicycle_model().dt();
+  if (dt >= predicted_time_horizon) {
+    dt = predicted_time_horizon;
+  }
+  std::vector<double> steps;
+  double countdown_time = predicted_time_horizon;
+  static constexpr double kepsilon = 1e-8;
+  while (countdown_time > kepsilon) {
+    countdown_time -= dt;
+    if (countdown_time < kepsilon) {
+      steps.push_back(countdown_time + dt);
+      break;
+    }
+    steps.push_back(dt);
+  }
+  return steps;
+}
+
+template <typename StepCallback>
+void VehicleModel::RearCenteredKinematicBicycleModel(
+    const VehicleModelConfig& vehicle_model_config,
+    const double predicted_time_horizon,
+    const std::vector<VehicleState>& cur_vehicle_states,
+    const StepCallback& step_callback) {
+  const std::vector<double> steps = RearCenteredKinematicBicycleModelSteps(
+      vehicle_model_config, predicted_time_horizon);
+  const size_t num_states = cur_vehicle_states.size();
+  std::vector<double> x(num_states);
+  std::vector<double> y(num_states);
+  std::vector<double> phi(num_states);
+  std::vector<double> v(num_states);
+  std::vector<double> a(num_states);
+  std::vector<double> kappa(num_states);
+  for (size_t i = 0; i < num_states; ++i) {
+    x[i] = cur_vehicle_states[i].x();
+    y[i] = cur_vehicle_states[i].y();
+    phi[i] = cur_vehicle_states[i].heading();
+    v[i] = cur_vehicle_states[i].linear_velocity();
+    a[i] = cur_vehicle_states[i].linear_acceleration();
+    kappa[i] = cur_vehicle_states[i].kappa();
+  }
+
+  // The trigonometry is kept in a pass of its own, so that the other passes
+  // vectorize. Each state goes through the same operations in the same order
+  // as in the scalar model.
+  std::vector<double> intermediate_phi(num_states);
+  std::vector<double> cos_phi(num_states);
+  std::vector<double> sin_phi(num_states);
+  std::vector<double> distance(num_states);
+  for (size_t k = 0; k < steps.size(); ++k) {
+    const double dt = steps[k];
+    for (size_t i = 0; i < num_states; ++i) {
+      intermediate_phi[i] = phi[i] + 0.5 * dt * v[i] * kappa[i];
+    }
+    for (size_t i = 0; i < num_states; ++i) {
+      cos_phi[i] = std::cos(intermediate_phi[i]);
+      sin_phi[i] = std::sin(intermediate_phi[i]);
+    }
+    for (size_t i = 0; i < num_states; ++i) {
+      distance[i] = dt * (v[i] + 0.5 * dt * a[i]);
+      phi[i] = phi[i] + distance[i] * kappa[i];
+      x[i] = x[i] + distance[i] * cos_phi[i];
+      y[i] = y[i] + distance[i] * sin_phi[i];
+      v[i] = v[i] + dt * a[i];
+    }
+    step_callback(k, steps.size(), x, y, phi, v);
+  }
+}
+
+void VehicleModel::SetPredictedState(const VehicleState& cur_vehicle_state,
+                                     const double x, const double y,
+                                     const double phi, const double v,
+                                     VehicleState* predicted_vehicle_state) {
+  predicted_vehicle_state->set_x(x);
+  predicted_vehicle_state->set_y(y);
+  predicted_vehicle_state->set_z(cur_vehicle_state.z());
+  predicted_vehicle_state->set_heading(phi);
+  predicted_vehicle_state->set_kappa(cur_vehicle_state.kappa());
+  predicted_vehicle_state->set_linear_velocity(v);
+  predicted_vehicle_state->set_linear_acceleration(
+      cur_vehicle_state.linear_acceleration());
+}
+
+VehicleState VehicleModel::Predict(const double predicted_time_horizon,
+                                   const VehicleState& cur_vehicle_state) {
+  const VehicleModelConfig vehicle_model_config = LoadConfig();
 
   VehicleState predicted_vehicle_state;
   if (vehicle_model_config.model_type() ==
@@ -105,5 +193,67 @@ VehicleState VehicleModel::Predict(const double predicted_time_horizon,
   return predicted_vehicle_state;
 }
 
+void VehicleModel::Predict(
+    const double predicted_time_horizon,
+    const std::vector<VehicleState>& cur_vehicle_states,
+    std::vector<VehicleState>* predicted_vehicle_states) {
+  CHECK_NOTNULL(predicted_vehicle_states);
+  const VehicleModelConfig vehicle_model_config = LoadConfig();
+
+  predicted_vehicle_states->assign(cur_vehicle_states.size(), VehicleState());
+  if (vehicle_model_config.model_type() !=
+      VehicleModelConfig::REAR_CENTERED_KINEMATIC_BICYCLE_MODEL) {
+    return;
+  }
+  // Within the first step of the horizon, the states do not move
+  for (size_t i = 0; i < cur_vehicle_states.size(); ++i) {
+    const VehicleState& state = cur_vehicle_states[i];
+    SetPredictedState(state, state.x(), state.y(), state.heading(),
+                      state.linear_velocity(), &(*predicted_vehicle_states)[i]);
+  }
+  RearCenteredKinematicBicycleModel(
+      vehicle_model_config, predicted_time_horizon, cur_vehicle_states,
+      [&](const size_t step, const size_t num_steps,
+          const std::vector<double>& x, const std::vector<double>& y,
+          const std::vector<double>& phi, const std::vector<double>& v) {
+        if (step + 1 < num_steps) {
+          return;
+        }
+        for (size_t i = 0; i < cur_vehicle_states.size(); ++i) {
+          SetPredictedState(cur_vehicle_states[i], x[i], y[i], phi[i], v[i],
+                            &(*predicted_vehicle_states)[i]);
+        }
+      });
+}
+
+void VehicleModel::Rollout(
+    const double predicted_time_horizon,
+    const std::vector<VehicleState>& cur_vehicle_states,
+    std::vector<std::vector<VehicleState>>* predicted_trajectories) {
+  CHECK_NOTNULL(predicted_trajectories);
+  const VehicleModelConfig vehicle_model_config = LoadConfig();
+
+  predicted_trajectories->assign(cur_vehicle_states.size(),
+                                 std::vector<VehicleState>());
+  if (vehicle_model_config.model_type() !=
+      VehicleModelConfig::REAR_CENTERED_KINEMATIC_BICYCLE_MODEL) {
+    return;
+  }
+  RearCenteredKinematicBicycleModel(
+      vehicle_model_config, predicted_time_horizon, cur_vehicle_states,
+      [&](const size_t step, const size_t num_steps,
+          const std::vector<double>& x, const std::vector<double>& y,
+          const std::vector<double>& phi, const std::vector<double>& v) {
+        for (size_t i = 0; i < cur_vehicle_states.size(); ++i) {
+          auto& trajectory = (*predicted_trajectories)[i];
+          if (step == 0) {
+            trajectory.resize(num_steps);
+          }
+          SetPredictedState(cur_vehicle_states[i], x[i], y[i], phi[i], v[i],
+                            &trajectory[step]);
+        }
+      });
+}
+
 }  // namespace common
 }  // namespace apollo
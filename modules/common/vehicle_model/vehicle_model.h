@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "modules/common/configs/vehicle_config_helper.h"
 #include "modules/common/vehicle_model/proto/vehicle_model_config.pb.h"
 #include "modules/common/vehicle_state/proto/vehicle_state.pb.h"
@@ -30,12 +32,53 @@ class VehicleModel {
   static VehicleState Predict(const double predicted_time_horizon,
                               const VehicleState& cur_vehicle_state);
 
+  /**
+   * @brief Predicts the states of many vehicles at once, with the same result
+   * as Predict() on each of them. The config is loaded once, and the states
+   * are stepped together so that the arithmetic over them vectorizes.
+   */
+  static void Predict(const double predicted_time_horizon,
+                      const std::vector<VehicleState>& cur_vehicle_states,
+                      std::vector<VehicleState>* predicted_vehicle_states);
+
+  /**
+   * @brief Rolls out the states of many vehicles over the time horizon, and
+   * gives the state of each after every step of the model, the last of which
+   * is the state Predict() gives.
+   */
+  static void Rollout(
+      const double predicted_time_horizon,
+      const std::vector<VehicleState>& cur_vehicle_states,
+      std::vector<std::vector<VehicleState>>* predicted_trajectories);
+
  private:
+  static VehicleModelConfig LoadConfig();
+
+  // The steps of the model over the time horizon, the last one shortened to
+  // end on the horizon.
+  static std::vector<double> RearCenteredKinematicBicycleModelSteps(
+      const VehicleModelConfig& vehicle_model_config,
+      const double predicted_time_horizon);
+
   static void RearCenteredKinematicBicycleModel(
       const VehicleModelConfig& vehicle_model_config,
       const double predicted_time_horizon,
       const VehicleState& cur_vehicle_state,
       VehicleState* predicted_vehicle_state);
+
+  // Steps all the states together, and calls the callback with the index of
+  // each step and the states after it.
+  template <typename StepCallback>
+  static void RearCenteredKinematicBicycleModel(
+      const VehicleModelConfig& vehicle_model_config,
+      const double predicted_time_horizon,
+      const std::vector<VehicleState>& cur_vehicle_states,
+      const StepCallback& step_callback);
+
+  static void SetPredictedState(const VehicleState& cur_vehicle_state,
+                                const double x, const double y,
+                                const double phi, const double v,
+                                VehicleState* predicted_vehicle_state);
 };
 
 }  // namespace common
@@ -16,6 +16,9 @@
 
 #include "modules/common/vehicle_model/vehicle_model.h"
 
+#include <cmath>
+#include <vector>
+
 #include "cyber/common/file.h"
 #include "gtest/gtest.h"
 #include "modules/common/vehicle_state/proto/vehicle_state.pb.h"
@@ -78,5 +81,53 @@ TEST_F(VehicleModelTest, RearCenteredKinematicBicycleModel) {
   EXPECT_NEAR(expected_vehicle_state_.linear_velocity(),
               predicted_vehicle_state_.linear_velocity(), 2e-2);
 }
+
+TEST_F(VehicleModelTest, BatchPredictAndRollout) {
+  std::vector<VehicleState> cur_vehicle_states;
+  for (int i = 0; i < 13; ++i) {
+    VehicleState state;
+    state.set_x(10.0 * i);
+    state.set_y(-3.0 * i);
+    state.set_z(0.5);
+    state.set_heading(-M_PI + 0.5 * i);
+    state.set_kappa(0.02 * (i - 6));
+    state.set_linear_velocity(1.5 * i);
+    state.set_linear_acceleration(0.3 * (6 - i));
+    cur_vehicle_states.push_back(state);
+  }
+
+  for (const double predicted_time_horizon : {0.01, 0.1, 0.95, 3.0}) {
+    std::vector<VehicleState> predicted_vehicle_states;
+    VehicleModel::Predict(predicted_time_horizon, cur_vehicle_states,
+                          &predicted_vehicle_states);
+    std::vector<std::vector<VehicleState>> predicted_trajectories;
+    VehicleModel::Rollout(predicted_time_horizon, cur_vehicle_states,
+                          &predicted_trajectories);
+    ASSERT_EQ(cur_vehicle_states.size(), predicted_vehicle_states.size());
+    ASSERT_EQ(cur_vehicle_states.size(), predicted_trajectories.size());
+    for (size_t i = 0; i < cur_vehicle_states.size(); ++i) {
+      const VehicleState expected = VehicleModel::Predict(
+          predicted_time_horizon, cur_vehicle_states[i]);
+      const VehicleState& predicted = predicted_vehicle_states[i];
+      EXPECT_DOUBLE_EQ(expected.x(), predicted.x());
+      EXPECT_DOUBLE_EQ(expected.y(), predicted.y());
+      EXPECT_DOUBLE_EQ(expected.z(), predicted.z());
+      EXPECT_DOUBLE_EQ(expected.heading(), predicted.heading());
+      EXPECT_DOUBLE_EQ(expected.kappa(), predicted.kappa());
+      EXPECT_DOUBLE_EQ(expected.linear_velocity(),
+                       predicted.linear_velocity());
+      EXPECT_DOUBLE_EQ(expected.linear_acceleration(),
+                       predicted.linear_acceleration());
+
+      ASSERT_FALSE(predicted_trajectories[i].empty());
+      const VehicleState& last = predicted_trajectories[i].back();
+      EXPECT_DOUBLE_EQ(expected.x(), last.x());
+      EXPECT_DOUBLE_EQ(expected.y(), last.y());
+      EXPECT_DOUBLE_EQ(expected.heading(), last.heading());
+      EXPECT_DOUBLE_EQ(expected.linear_velocity(), last.linear_velocity());
+    }
+  }
+}
+
 }  // namespace common
 }  // namespace apollo
@@ -0,0 +1,42 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/control/common/allocation_counter.h"
+
+// defined by allocation_counter_hook when it is linked in
+extern "C" uint64_t ApolloControlThreadAllocations() __attribute__((weak));
+
+namespace apollo {
+namespace control {
+
+bool AllocationCounter::IsAvailable() {
+  return ApolloControlThreadAllocations != nullptr;
+}
+
+uint64_t AllocationCounter::ThreadAllocations() {
+  return IsAvailable() ? ApolloControlThreadAllocations() : 0;
+}
+
+ScopedAllocationCounter::ScopedAllocationCounter()
+    : start_(AllocationCounter::ThreadAllocations()) {}
+
+uint64_t ScopedAllocationCounter::count() const {
+  return AllocationCounter::ThreadAllocations() - start_;
+}
+
+}  // namespace control
+}  // namespace apollo
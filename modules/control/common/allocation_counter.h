@@ -0,0 +1,71 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file allocation_counter.h
+ * @brief Counts the heap allocations of the calling thread.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @namespace apollo::control
+ * @brief apollo::control
+ */
+namespace apollo {
+namespace control {
+
+/**
+ * @class AllocationCounter
+ * @brief Reads the per thread malloc counter maintained by the
+ * allocation_counter_hook library. Without the hook linked into the binary
+ * nothing is counted and every count is zero.
+ */
+class AllocationCounter {
+ public:
+  /**
+   * @brief whether the malloc hook is linked into the binary
+   */
+  static bool IsAvailable();
+
+  /**
+   * @brief number of malloc calls the calling thread made so far
+   */
+  static uint64_t ThreadAllocations();
+};
+
+/**
+ * @class ScopedAllocationCounter
+ * @brief Counts the malloc calls of the calling thread since construction.
+ */
+class ScopedAllocationCounter {
+ public:
+  ScopedAllocationCounter();
+
+  /**
+   * @brief number of malloc calls since construction
+   */
+  uint64_t count() const;
+
+ private:
+  uint64_t start_ = 0;
+};
+
+}  // namespace control
+}  // namespace apollo
@@ -0,0 +1,83 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file allocation_counter_hook.cc
+ * @brief Replaces the malloc family to count the allocations of every
+ * thread, see AllocationCounter. Only meant to be linked into tests and
+ * profiling builds.
+ */
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+
+extern "C" {
+
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t num, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void* __libc_memalign(size_t alignment, size_t size);
+void __libc_free(void* ptr);
+
+namespace {
+
+// initial-exec keeps the counter from allocating its own tls block
+__thread uint64_t thread_allocations __attribute__((tls_model("initial-exec")));
+
+}  // namespace
+
+uint64_t ApolloControlThreadAllocations() { return thread_allocations; }
+
+void* malloc(size_t size) {
+  ++thread_allocations;
+  return __libc_malloc(size);
+}
+
+void* calloc(size_t num, size_t size) {
+  ++thread_allocations;
+  return __libc_calloc(num, size);
+}
+
+void* realloc(void* ptr, size_t size) {
+  ++thread_allocations;
+  return __libc_realloc(ptr, size);
+}
+
+void* memalign(size_t alignment, size_t size) {
+  ++thread_allocations;
+  return __libc_memalign(alignment, size);
+}
+
+void* aligned_alloc(size_t alignment, size_t size) {
+  ++thread_allocations;
+  return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void** ptr, size_t alignment, size_t size) {
+  ++thread_allocations;
+  void* result = __libc_memalign(alignment, size);
+  if (result == nullptr) {
+    return ENOMEM;
+  }
+  *ptr = result;
+  return 0;
+}
+
+void free(void* ptr) { __libc_free(ptr); }
+
+}  // extern "C"
@@ -0,0 +1,49 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/control/common/allocation_counter.h"
+
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace control {
+
+TEST(AllocationCounterTest, CountsAllocations) {
+  ASSERT_TRUE(AllocationCounter::IsAvailable());
+
+  std::vector<int> values;
+  values.reserve(10);
+  {
+    ScopedAllocationCounter allocation_counter;
+    for (int i = 0; i < 10; ++i) {
+      values.push_back(i);
+    }
+    EXPECT_EQ(0, allocation_counter.count());
+  }
+  {
+    ScopedAllocationCounter allocation_counter;
+    std::unique_ptr<int> value(new int(1));
+    values.push_back(*value);
+    EXPECT_EQ(2, allocation_counter.count());
+  }
+}
+
+}  // namespace control
+}  // namespace apollo
@@ -116,3 +116,19 @@ DEFINE_bool(
 
 DEFINE_bool(use_control_submodules, false,
             "use control submodules instead of controller agent");
+
+DEFINE_bool(use_condensed_mpc_solver, false,
+            "True to solve the mpc problem over the controls only, reusing "
+            "the osqp workspace and warm starting across control cycles");
+
+DEFINE_bool(enable_realtime_control, false,
+            "True to reuse the control command and the controller buffers "
+            "across cycles, and report allocations in the control loop");
+
+DEFINE_int32(realtime_control_warmup_cycles, 10,
+             "Number of control cycles that may still allocate while the "
+             "reused buffers grow to their working size");
+
+DEFINE_bool(enable_trajectory_search_hint, true,
+            "True to search the nearest trajectory point around the point "
+            "matched in the previous query, instead of over all points");
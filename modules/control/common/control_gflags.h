@@ -78,3 +78,10 @@ DECLARE_bool(enable_feedback_augment_on_high_speed);
 DECLARE_bool(enable_gear_drive_negative_speed_protection);
 
 DECLARE_bool(use_control_submodules);
+
+DECLARE_bool(use_condensed_mpc_solver);
+
+DECLARE_bool(enable_realtime_control);
+DECLARE_int32(realtime_control_warmup_cycles);
+
+DECLARE_bool(enable_trajectory_search_hint);
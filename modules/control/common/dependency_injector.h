@@ -16,7 +16,10 @@
 
 #pragma once
 
+#include <memory>
+
 #include "modules/common/vehicle_state/vehicle_state_provider.h"
+#include "modules/control/common/trajectory_analyzer.h"
 
 namespace apollo {
 namespace control {
@@ -31,8 +34,14 @@ class DependencyInjector {
     return &vehicle_state_;
   }
 
+  std::shared_ptr<TrajectorySearchHint> trajectory_search_hint() {
+    return trajectory_search_hint_;
+  }
+
  private:
   apollo::common::VehicleStateProvider vehicle_state_;
+  std::shared_ptr<TrajectorySearchHint> trajectory_search_hint_ =
+      std::make_shared<TrajectorySearchHint>();
 };
 
 }  // namespace control
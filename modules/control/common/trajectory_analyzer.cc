@@ -35,6 +35,11 @@ namespace apollo {
 namespace control {
 namespace {
 
+// The vehicle moves forward along the trajectory by a few points per control
+// cycle, so the search window mostly extends ahead of the last match.
+constexpr size_t kBackwardSearchWindow = 5;
+constexpr size_t kForwardSearchWindow = 20;
+
 // Squared distance from the point to (x, y).
 double PointDistanceSquare(const TrajectoryPoint &point, const double x,
                            const double y) {
@@ -55,30 +60,48 @@ PathPoint TrajectoryPointToPathPoint(const TrajectoryPoint &point) {
 
 TrajectoryAnalyzer::TrajectoryAnalyzer(
     const planning::ADCTrajectory *planning_published_trajectory) {
+  Reset(planning_published_trajectory);
+}
+
+void TrajectoryAnalyzer::Reset(
+    const planning::ADCTrajectory *planning_published_trajectory) {
   header_time_ = planning_published_trajectory->header().timestamp_sec();
   seq_num_ = planning_published_trajectory->header().sequence_num();
 
-  for (int i = 0; i < planning_published_trajectory->trajectory_point_size();
-       ++i) {
-    trajectory_points_.push_back(
-        planning_published_trajectory->trajectory_point(i));
+  const size_t num_points = static_cast<size_t>(
+      planning_published_trajectory->trajectory_point_size());
+  while (trajectory_points_.size() > num_points) {
+    spare_points_.push_back(std::move(trajectory_points_.back()));
+    trajectory_points_.pop_back();
   }
+  while (trajectory_points_.size() < num_points) {
+    if (spare_points_.empty()) {
+      trajectory_points_.emplace_back();
+    } else {
+      trajectory_points_.push_back(std::move(spare_points_.back()));
+      spare_points_.pop_back();
+    }
+  }
+  // room for every point to become spare, so that shrinking never allocates
+  spare_points_.reserve(trajectory_points_.capacity());
+  // CopyFrom() keeps the sub messages of the reused points allocated
+  for (size_t i = 0; i < num_points; ++i) {
+    trajectory_points_[i].CopyFrom(
+        planning_published_trajectory->trajectory_point(static_cast<int>(i)));
+  }
+  point_index_.reset();
+}
+
+void TrajectoryAnalyzer::Reserve(const size_t num_points) {
+  trajectory_points_.reserve(num_points);
+  spare_points_.reserve(num_points);
 }
 
 PathPoint TrajectoryAnalyzer::QueryMatchedPathPoint(const double x,
                                                     const double y) const {
   CHECK_GT(trajectory_points_.size(), 0);
 
-  double d_min = PointDistanceSquare(trajectory_points_.front(), x, y);
-  size_t index_min = 0;
-
-  for (size_t i = 1; i < trajectory_points_.size(); ++i) {
-    double d_temp = PointDistanceSquare(trajectory_points_[i], x, y);
-    if (d_temp < d_min) {
-      d_min = d_temp;
-      index_min = i;
-    }
-  }
+  const size_t index_min = QueryNearestIndexByPosition(x, y);
 
   size_t index_start = index_min == 0 ? index_min : index_min - 1;
   size_t index_end =
@@ -147,12 +170,12 @@ void TrajectoryAnalyzer::ToTrajectoryFrame(const double x, const double y,
   *ptr_s_dot = v * cos_delta_theta / one_minus_kappa_r_d;
 }
 
-TrajectoryPoint TrajectoryAnalyzer::QueryNearestPointByAbsoluteTime(
+const TrajectoryPoint &TrajectoryAnalyzer::QueryNearestPointByAbsoluteTime(
     const double t) const {
   return QueryNearestPointByRelativeTime(t - header_time_);
 }
 
-TrajectoryPoint TrajectoryAnalyzer::QueryNearestPointByRelativeTime(
+const TrajectoryPoint &TrajectoryAnalyzer::QueryNearestPointByRelativeTime(
     const double t) const {
   auto func_comp = [](const TrajectoryPoint &point,
                       const double relative_time) {
@@ -181,19 +204,79 @@ TrajectoryPoint TrajectoryAnalyzer::QueryNearestPointByRelativeTime(
   }
 }
 
-TrajectoryPoint TrajectoryAnalyzer::QueryNearestPointByPosition(
+const TrajectoryPoint &TrajectoryAnalyzer::QueryNearestPointByPosition(
     const double x, const double y) const {
-  double d_min = PointDistanceSquare(trajectory_points_.front(), x, y);
-  size_t index_min = 0;
+  return trajectory_points_[QueryNearestIndexByPosition(x, y)];
+}
+
+size_t TrajectoryAnalyzer::QueryNearestIndexByPosition(const double x,
+                                                       const double y) const {
+  const size_t num_points = trajectory_points_.size();
+  if (!FLAGS_enable_trajectory_search_hint ||
+      num_points <= kBackwardSearchWindow + kForwardSearchWindow + 1) {
+    return QueryNearestIndexInWindow(x, y, 0, num_points);
+  }
+
+  auto &hint = *search_hint_;
+  size_t index_min = num_points;
+  if (hint.is_valid && hint.seq_num == seq_num_ && hint.index < num_points) {
+    const size_t begin = hint.index > kBackwardSearchWindow
+                             ? hint.index - kBackwardSearchWindow
+                             : 0;
+    const size_t end =
+        std::min(num_points, hint.index + kForwardSearchWindow + 1);
+    index_min = QueryNearestIndexInWindow(x, y, begin, end);
+  }
+  if (index_min == num_points) {
+    index_min = QueryNearestIndexByKDTree(x, y);
+  }
+
+  hint.is_valid = true;
+  hint.seq_num = seq_num_;
+  hint.index = index_min;
+  return index_min;
+}
 
-  for (size_t i = 1; i < trajectory_points_.size(); ++i) {
+size_t TrajectoryAnalyzer::QueryNearestIndexInWindow(const double x,
+                                                     const double y,
+                                                     const size_t begin,
+                                                     const size_t end) const {
+  double d_min = PointDistanceSquare(trajectory_points_[begin], x, y);
+  size_t index_min = begin;
+
+  for (size_t i = begin + 1; i < end; ++i) {
     double d_temp = PointDistanceSquare(trajectory_points_[i], x, y);
     if (d_temp < d_min) {
       d_min = d_temp;
       index_min = i;
     }
   }
-  return trajectory_points_[index_min];
+
+  if ((index_min == begin && begin > 0) ||
+      (index_min + 1 == end && end < trajectory_points_.size())) {
+    return trajectory_points_.size();
+  }
+  return index_min;
+}
+
+size_t TrajectoryAnalyzer::QueryNearestIndexByKDTree(const double x,
+                                                     const double y) const {
+  if (point_index_ == nullptr) {
+    auto point_index = std::make_shared<PointIndex>();
+    point_index->boxes.reserve(trajectory_points_.size());
+    for (size_t i = 0; i < trajectory_points_.size(); ++i) {
+      point_index->boxes.emplace_back(
+          common::math::Vec2d(trajectory_points_[i].path_point().x(),
+                              trajectory_points_[i].path_point().y()),
+          i);
+    }
+    common::math::AABoxKDTreeParams params;
+    params.max_leaf_size = 4;
+    point_index->kdtree.reset(new PointKDTree(point_index->boxes, params));
+    point_index_ = std::move(point_index);
+  }
+  return point_index_->kdtree->GetNearestObject(common::math::Vec2d(x, y))
+      ->index();
 }
 
 const std::vector<TrajectoryPoint> &TrajectoryAnalyzer::trajectory_points()
@@ -244,6 +327,7 @@ void TrajectoryAnalyzer::TrajectoryTransformToCOM(
     trajectory_points_[i].mutable_path_point()->set_x(com.x());
     trajectory_points_[i].mutable_path_point()->set_y(com.y());
   }
+  point_index_.reset();
 }
 
 common::math::Vec2d TrajectoryAnalyzer::ComputeCOMPosition(
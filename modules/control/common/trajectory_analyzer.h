@@ -21,10 +21,14 @@
 
 #pragma once
 
+#include <memory>
+#include <utility>
 #include <vector>
 
 #include "modules/planning/proto/planning.pb.h"
 
+#include "modules/common/math/aabox2d.h"
+#include "modules/common/math/aaboxkdtree2d.h"
 #include "modules/common/math/box2d.h"
 #include "modules/common/math/vec2d.h"
 #include "modules/common/proto/pnc_point.pb.h"
@@ -37,6 +41,18 @@
 namespace apollo {
 namespace control {
 
+/**
+ * @class TrajectorySearchHint
+ * @brief index of the trajectory point last matched to the vehicle position,
+ * shared by the analyzers of all controllers so that each of them starts
+ * its search where the previous one ended
+ */
+struct TrajectorySearchHint {
+  bool is_valid = false;
+  unsigned int seq_num = 0;
+  size_t index = 0;
+};
+
 /**
  * @class TrajectoryAnalyzer
  * @brief process point query and conversion related to trajectory
@@ -61,6 +77,30 @@ class TrajectoryAnalyzer {
    */
   ~TrajectoryAnalyzer() = default;
 
+  /**
+   * @brief replace the trajectory, reusing the points allocated for
+   * previous trajectories. Once the analyzer has held a trajectory at least
+   * as long as the new one, this does not allocate.
+   * @param planning_published_trajectory trajectory data generated by
+   * planning module
+   */
+  void Reset(const planning::ADCTrajectory *planning_published_trajectory);
+
+  /**
+   * @brief reserve room for trajectories of up to num_points points
+   * @param num_points number of trajectory points
+   */
+  void Reserve(const size_t num_points);
+
+  /**
+   * @brief share the search hint of position queries with other analyzers
+   * of the same trajectory
+   * @param search_hint the shared hint
+   */
+  void set_search_hint(std::shared_ptr<TrajectorySearchHint> search_hint) {
+    search_hint_ = std::move(search_hint);
+  }
+
   /**
    * @brief get sequence number of the trajectory
    * @return sequence number.
@@ -73,7 +113,8 @@ class TrajectoryAnalyzer {
    * @param t absolute time for query
    * @return a point of trajectory
    */
-  common::TrajectoryPoint QueryNearestPointByAbsoluteTime(const double t) const;
+  const common::TrajectoryPoint &QueryNearestPointByAbsoluteTime(
+      const double t) const;
 
   /**
    * @brief query a point of trajectory that its relative time is closest
@@ -81,7 +122,8 @@ class TrajectoryAnalyzer {
    * @param t relative time for query
    * @return a point of trajectory
    */
-  common::TrajectoryPoint QueryNearestPointByRelativeTime(const double t) const;
+  const common::TrajectoryPoint &QueryNearestPointByRelativeTime(
+      const double t) const;
 
   /**
    * @brief query a point of trajectory that its position is closest
@@ -90,8 +132,19 @@ class TrajectoryAnalyzer {
    * @param y value of y-coordination in the given position
    * @return a point of trajectory
    */
-  common::TrajectoryPoint QueryNearestPointByPosition(const double x,
-                                                      const double y) const;
+  const common::TrajectoryPoint &QueryNearestPointByPosition(
+      const double x, const double y) const;
+
+  /**
+   * @brief query the index of the trajectory point closest to the given
+   * position. The search starts in a window around the last matched point,
+   * and falls back to a kd-tree over the points when the window does not
+   * contain a local minimum of the distance.
+   * @param x value of x-coordination in the given position
+   * @param y value of y-coordination in the given position
+   * @return index of a point of trajectory
+   */
+  size_t QueryNearestIndexByPosition(const double x, const double y) const;
 
   /**
    * @brief query a point on trajectory that its position is closest
@@ -148,14 +201,55 @@ class TrajectoryAnalyzer {
   const std::vector<common::TrajectoryPoint> &trajectory_points() const;
 
  private:
+  class PointBox {
+   public:
+    PointBox(const common::math::Vec2d &point, const size_t index)
+        : point_(point), aabox_(point, 0.0, 0.0), index_(index) {}
+    const common::math::AABox2d &aabox() const { return aabox_; }
+    double DistanceTo(const common::math::Vec2d &point) const {
+      return point_.DistanceTo(point);
+    }
+    double DistanceSquareTo(const common::math::Vec2d &point) const {
+      return point_.DistanceSquareTo(point);
+    }
+    size_t index() const { return index_; }
+
+   private:
+    common::math::Vec2d point_;
+    common::math::AABox2d aabox_;
+    size_t index_;
+  };
+  using PointKDTree = common::math::AABoxKDTree2d<PointBox>;
+  // the kd-tree points into the boxes, so they are kept together
+  struct PointIndex {
+    std::vector<PointBox> boxes;
+    std::unique_ptr<PointKDTree> kdtree;
+  };
+
+  // index of the closest point among [begin, end), or the number of points
+  // when it is on a border of the range that is not a border of the
+  // trajectory, as the distance may keep decreasing outside of the range
+  size_t QueryNearestIndexInWindow(const double x, const double y,
+                                   const size_t begin, const size_t end) const;
+
+  size_t QueryNearestIndexByKDTree(const double x, const double y) const;
+
   common::PathPoint FindMinDistancePoint(const common::TrajectoryPoint &p0,
                                          const common::TrajectoryPoint &p1,
                                          const double x, const double y) const;
 
   std::vector<common::TrajectoryPoint> trajectory_points_;
+  // points dropped by shorter trajectories, kept for reuse by Reset()
+  std::vector<common::TrajectoryPoint> spare_points_;
 
   double header_time_ = 0.0;
   unsigned int seq_num_ = 0;
+
+  std::shared_ptr<TrajectorySearchHint> search_hint_ =
+      std::make_shared<TrajectorySearchHint>();
+  // built on the first query that misses the search window, over the
+  // current trajectory points
+  mutable std::shared_ptr<const PointIndex> point_index_;
 };
 
 }  // namespace control
@@ -16,9 +16,13 @@
 
 #include "modules/control/common/trajectory_analyzer.h"
 
+#include <limits>
+#include <memory>
+
 #include "cyber/common/log.h"
 #include "cyber/time/clock.h"
 #include "gtest/gtest.h"
+#include "modules/control/common/allocation_counter.h"
 
 using apollo::common::PathPoint;
 using apollo::common::TrajectoryPoint;
@@ -95,6 +99,41 @@ TEST_F(TrajectoryAnalyzerTest, Constructor) {
   EXPECT_EQ(trajectory_analyzer.seq_num(), 123);
 }
 
+TEST_F(TrajectoryAnalyzerTest, Reset) {
+  planning::ADCTrajectory long_trajectory;
+  SetTrajectory({1.0, 1.1, 1.2, 1.3, 1.4}, {1.0, 1.1, 1.2, 1.3, 1.4},
+                &long_trajectory);
+  planning::ADCTrajectory short_trajectory;
+  std::vector<double> xs = {2.0, 2.1, 2.2};
+  std::vector<double> ys = {3.0, 3.1, 3.2};
+  SetTrajectory(xs, ys, &short_trajectory);
+  short_trajectory.mutable_header()->set_sequence_num(124);
+
+  TrajectoryAnalyzer trajectory_analyzer(&long_trajectory);
+  const auto &points = trajectory_analyzer.trajectory_points();
+  {
+    ScopedAllocationCounter allocation_counter;
+    trajectory_analyzer.Reset(&short_trajectory);
+    EXPECT_EQ(0, allocation_counter.count());
+  }
+  EXPECT_EQ(trajectory_analyzer.seq_num(), 124);
+  ASSERT_EQ(points.size(), 3);
+  for (size_t i = 0; i < xs.size(); ++i) {
+    EXPECT_EQ(xs[i], points[i].path_point().x());
+    EXPECT_EQ(ys[i], points[i].path_point().y());
+  }
+
+  // growing back reuses the points dropped above
+  {
+    ScopedAllocationCounter allocation_counter;
+    trajectory_analyzer.Reset(&long_trajectory);
+    EXPECT_EQ(0, allocation_counter.count());
+  }
+  EXPECT_EQ(trajectory_analyzer.seq_num(), 123);
+  ASSERT_EQ(points.size(), 5);
+  EXPECT_EQ(1.4, points[4].path_point().x());
+}
+
 TEST_F(TrajectoryAnalyzerTest, QueryMatchedPathPoint) {
   planning::ADCTrajectory adc_trajectory;
   std::vector<double> xs = {1.0, 1.1, 1.2, 1.3, 1.8};
@@ -168,5 +207,70 @@ TEST_F(TrajectoryAnalyzerTest, QueryNearestPointByAbsoluteTimeInterpolation) {
   EXPECT_NEAR(point_6.path_point().x(), 1.0, 1e-6);
 }
 
+TEST_F(TrajectoryAnalyzerTest, QueryNearestIndexByPosition) {
+  // a hairpin: out along y = 0 and back along y = 4
+  planning::ADCTrajectory adc_trajectory;
+  std::vector<double> xs;
+  std::vector<double> ys;
+  for (int i = 0; i < 100; ++i) {
+    xs.push_back(0.5 * i);
+    ys.push_back(0.0);
+  }
+  for (int i = 0; i < 100; ++i) {
+    xs.push_back(49.5 - 0.5 * i);
+    ys.push_back(4.0);
+  }
+  SetTrajectory(xs, ys, &adc_trajectory);
+
+  auto search_hint = std::make_shared<TrajectorySearchHint>();
+  TrajectoryAnalyzer trajectory_analyzer(&adc_trajectory);
+  trajectory_analyzer.set_search_hint(search_hint);
+  const auto &points = trajectory_analyzer.trajectory_points();
+  auto brute_force_index = [&points](const double x, const double y) {
+    size_t index_min = 0;
+    double d_min = std::numeric_limits<double>::infinity();
+    for (size_t i = 0; i < points.size(); ++i) {
+      const double dx = points[i].path_point().x() - x;
+      const double dy = points[i].path_point().y() - y;
+      if (dx * dx + dy * dy < d_min) {
+        d_min = dx * dx + dy * dy;
+        index_min = i;
+      }
+    }
+    return index_min;
+  };
+
+  // driving along the trajectory, the hint keeps up with the vehicle
+  for (double x = -1.0; x < 52.0; x += 0.13) {
+    EXPECT_EQ(brute_force_index(x, 0.3),
+              trajectory_analyzer.QueryNearestIndexByPosition(x, 0.3));
+  }
+  for (double x = 52.0; x > -1.0; x -= 0.13) {
+    EXPECT_EQ(brute_force_index(x, 3.6),
+              trajectory_analyzer.QueryNearestIndexByPosition(x, 3.6));
+  }
+  EXPECT_TRUE(search_hint->is_valid);
+  EXPECT_EQ(123, search_hint->seq_num);
+  EXPECT_EQ(199, search_hint->index);
+
+  // jumping away from the hint falls back to the kd-tree
+  EXPECT_EQ(brute_force_index(10.1, 0.4),
+            trajectory_analyzer.QueryNearestIndexByPosition(10.1, 0.4));
+  EXPECT_EQ(brute_force_index(40.1, 3.9),
+            trajectory_analyzer.QueryNearestIndexByPosition(40.1, 3.9));
+
+  // another analyzer of the same trajectory starts from the shared hint
+  TrajectoryAnalyzer other_trajectory_analyzer(&adc_trajectory);
+  other_trajectory_analyzer.set_search_hint(search_hint);
+  EXPECT_EQ(brute_force_index(40.6, 3.9),
+            other_trajectory_analyzer.QueryNearestIndexByPosition(40.6, 3.9));
+  EXPECT_EQ(brute_force_index(40.6, 3.9), search_hint->index);
+  EXPECT_NEAR(40.5,
+              other_trajectory_analyzer.QueryNearestPointByPosition(40.6, 3.9)
+                  .path_point()
+                  .x(),
+              1e-6);
+}
+
 }  // namespace control
 }  // namespace apollo
@@ -22,6 +22,7 @@
 #include "modules/common/adapters/adapter_gflags.h"
 #include "modules/common/latency_recorder/latency_recorder.h"
 #include "modules/common/vehicle_state/vehicle_state_provider.h"
+#include "modules/control/common/allocation_counter.h"
 #include "modules/control/common/control_gflags.h"
 
 namespace apollo {
@@ -241,9 +242,17 @@ Status ControlComponent::ProduceControlCommand(
           latest_replan_trajectory_header_);
     }
     // controller agent
+    ScopedAllocationCounter allocation_counter;
     Status status_compute = controller_agent_.ComputeControlCommand(
         &local_view_.localization(), &local_view_.chassis(),
         &local_view_.trajectory(), control_command);
+    if (FLAGS_enable_realtime_control &&
+        ++realtime_cycles_ >
+            static_cast<uint64_t>(FLAGS_realtime_control_warmup_cycles) &&
+        allocation_counter.count() > 0) {
+      AERROR << "Control computation allocated " << allocation_counter.count()
+             << " times in realtime mode";
+    }
 
     if (!status_compute.ok()) {
       AERROR << "Control main function failed"
@@ -362,33 +371,39 @@ bool ControlComponent::Proc() {
     return false;
   }
 
-  ControlCommand control_command;
+  ControlCommand local_control_command;
+  ControlCommand *control_command = &local_control_command;
+  if (FLAGS_enable_realtime_control) {
+    // Clear() keeps the sub messages allocated for the next cycle
+    realtime_control_command_.Clear();
+    control_command = &realtime_control_command_;
+  }
 
-  Status status = ProduceControlCommand(&control_command);
+  Status status = ProduceControlCommand(control_command);
   AERROR_IF(!status.ok()) << "Failed to produce control command:"
                           << status.error_message();
 
   if (pad_received_) {
-    control_command.mutable_pad_msg()->CopyFrom(pad_msg_);
+    control_command->mutable_pad_msg()->CopyFrom(pad_msg_);
     pad_received_ = false;
   }
 
   // forward estop reason among following control frames.
   if (estop_) {
-    control_command.mutable_header()->mutable_status()->set_msg(estop_reason_);
+    control_command->mutable_header()->mutable_status()->set_msg(estop_reason_);
   }
 
   // set header
-  control_command.mutable_header()->set_lidar_timestamp(
+  control_command->mutable_header()->set_lidar_timestamp(
       local_view_.trajectory().header().lidar_timestamp());
-  control_command.mutable_header()->set_camera_timestamp(
+  control_command->mutable_header()->set_camera_timestamp(
       local_view_.trajectory().header().camera_timestamp());
-  control_command.mutable_header()->set_radar_timestamp(
+  control_command->mutable_header()->set_radar_timestamp(
       local_view_.trajectory().header().radar_timestamp());
 
-  common::util::FillHeader(node_->Name(), &control_command);
+  common::util::FillHeader(node_->Name(), control_command);
 
-  ADEBUG << control_command.ShortDebugString();
+  ADEBUG << control_command->ShortDebugString();
   if (control_conf_.is_control_test_mode()) {
     ADEBUG << "Skip publish control command in test mode";
     return true;
@@ -398,11 +413,11 @@ bool ControlComponent::Proc() {
   const double time_diff_ms = (end_time - start_time).ToSecond() * 1e3;
   ADEBUG << "total control time spend: " << time_diff_ms << " ms.";
 
-  control_command.mutable_latency_stats()->set_total_time_ms(time_diff_ms);
-  control_command.mutable_latency_stats()->set_total_time_exceeded(
+  control_command->mutable_latency_stats()->set_total_time_ms(time_diff_ms);
+  control_command->mutable_latency_stats()->set_total_time_exceeded(
       time_diff_ms > control_conf_.control_period() * 1e3);
   ADEBUG << "control cycle time is: " << time_diff_ms << " ms.";
-  status.Save(control_command.mutable_header()->mutable_status());
+  status.Save(control_command->mutable_header()->mutable_status());
 
   // measure latency
   if (local_view_.trajectory().header().has_lidar_timestamp()) {
@@ -413,7 +428,7 @@ bool ControlComponent::Proc() {
         end_time);
   }
 
-  control_cmd_writer_->Write(control_command);
+  control_cmd_writer_->Write(*control_command);
   return true;
 }
 
@@ -120,6 +120,10 @@ class ControlComponent final : public apollo::cyber::TimerComponent {
 
   LocalView local_view_;
 
+  // reused across cycles when FLAGS_enable_realtime_control is set
+  ControlCommand realtime_control_command_;
+  uint64_t realtime_cycles_ = 0;
+
   std::shared_ptr<DependencyInjector> injector_;
 };
 
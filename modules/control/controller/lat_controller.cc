@@ -148,6 +148,10 @@ bool LatController::LoadControlConf(const ControlConf *control_conf) {
 
 void LatController::ProcessLogs(const SimpleLateralDebug *debug,
                                 const canbus::Chassis *chassis) {
+  // the log string is built on every cycle, skip it when nobody reads it
+  if (!FLAGS_enable_csv_debug && !VLOG_IS_ON(4)) {
+    return;
+  }
   const std::string log_str = absl::StrCat(
       debug->lateral_error(), ",", debug->ref_heading(), ",", debug->heading(),
       ",", debug->heading_error(), ",", debug->heading_error_rate(), ",",
@@ -191,6 +195,7 @@ Status LatController::Init(std::shared_ptr<DependencyInjector> injector,
                            const ControlConf *control_conf) {
   control_conf_ = control_conf;
   injector_ = injector;
+  trajectory_analyzer_.set_search_hint(injector_->trajectory_search_hint());
   if (!LoadControlConf(control_conf_)) {
     AERROR << "failed to load control conf";
     return Status(ErrorCode::CONTROL_COMPUTE_ERROR,
@@ -200,6 +205,9 @@ Status LatController::Init(std::shared_ptr<DependencyInjector> injector,
   const int matrix_size = basic_state_size_ + preview_window_;
   matrix_a_ = Matrix::Zero(basic_state_size_, basic_state_size_);
   matrix_ad_ = Matrix::Zero(basic_state_size_, basic_state_size_);
+  matrix_i_ = Matrix::Identity(basic_state_size_, basic_state_size_);
+  matrix_ad_rhs_ = Matrix::Zero(basic_state_size_, basic_state_size_);
+  matrix_ad_lu_ = Eigen::PartialPivLU<Matrix>(basic_state_size_);
   matrix_adc_ = Matrix::Zero(matrix_size, matrix_size);
   /*
   A matrix (Gear Drive)
@@ -319,7 +327,7 @@ Status LatController::ComputeControlCommand(
     ControlCommand *cmd) {
   auto vehicle_state = injector_->vehicle_state();
 
-  auto target_tracking_trajectory = *planning_published_trajectory;
+  target_tracking_trajectory_.CopyFrom(*planning_published_trajectory);
 
   if (FLAGS_use_navigation_mode &&
       FLAGS_enable_navigation_mode_position_update) {
@@ -366,7 +374,7 @@ Status LatController::ComputeControlCommand(
       auto ty = -(sin_theta_diff * x_diff_veh + cos_theta_diff * y_diff_veh);
 
       auto ptr_trajectory_points =
-          target_tracking_trajectory.mutable_trajectory_point();
+          target_tracking_trajectory_.mutable_trajectory_point();
       std::for_each(
           ptr_trajectory_points->begin(), ptr_trajectory_points->end(),
           [&cos_theta_diff, &sin_theta_diff, &tx, &ty,
@@ -386,8 +394,7 @@ Status LatController::ComputeControlCommand(
     }
   }
 
-  trajectory_analyzer_ =
-      std::move(TrajectoryAnalyzer(&target_tracking_trajectory));
+  trajectory_analyzer_.Reset(&target_tracking_trajectory_);
 
   // Transform the coordinate of the planning trajectory from the center of the
   // rear-axis to the center of mass, if conditions matched
@@ -484,19 +491,19 @@ Status LatController::ComputeControlCommand(
                               std::fabs(vehicle_state->linear_velocity()));
     common::math::SolveLQRProblem(matrix_adc_, matrix_bdc_, matrix_q_updated_,
                                   matrix_r_, lqr_eps_, lqr_max_iteration_,
-                                  &matrix_k_);
+                                  &lqr_workspace_, &matrix_k_);
   } else {
     common::math::SolveLQRProblem(matrix_adc_, matrix_bdc_, matrix_q_,
                                   matrix_r_, lqr_eps_, lqr_max_iteration_,
-                                  &matrix_k_);
+                                  &lqr_workspace_, &matrix_k_);
   }
 
   // feedback = - K * state
   // Convert vehicle steer angle from rad to degree and then to steer degree
   // then to 100% ratio
-  const double steer_angle_feedback = -(matrix_k_ * matrix_state_)(0, 0) * 180 /
-                                      M_PI * steer_ratio_ /
-                                      steer_single_direction_max_degree_ * 100;
+  const double steer_angle_feedback =
+      -matrix_k_.row(0).dot(matrix_state_.col(0)) * 180 / M_PI * steer_ratio_ /
+      steer_single_direction_max_degree_ * 100;
 
   const double steer_angle_feedforward = ComputeFeedForward(debug->curvature());
 
@@ -684,11 +691,12 @@ void LatController::UpdateState(SimpleLateralDebug *debug) {
   // Next elements are depending on preview window size;
   for (int i = 0; i < preview_window_; ++i) {
     const double preview_time = ts_ * (i + 1);
-    const auto preview_point =
+    const auto &preview_point =
         trajectory_analyzer_.QueryNearestPointByRelativeTime(preview_time);
 
-    const auto matched_point = trajectory_analyzer_.QueryNearestPointByPosition(
-        preview_point.path_point().x(), preview_point.path_point().y());
+    const auto &matched_point =
+        trajectory_analyzer_.QueryNearestPointByPosition(
+            preview_point.path_point().x(), preview_point.path_point().y());
 
     const double dx =
         preview_point.path_point().x() - matched_point.path_point().x();
@@ -723,9 +731,9 @@ void LatController::UpdateMatrix() {
   matrix_a_(1, 3) = matrix_a_coeff_(1, 3) / v;
   matrix_a_(3, 1) = matrix_a_coeff_(3, 1) / v;
   matrix_a_(3, 3) = matrix_a_coeff_(3, 3) / v;
-  Matrix matrix_i = Matrix::Identity(matrix_a_.cols(), matrix_a_.cols());
-  matrix_ad_ = (matrix_i - ts_ * 0.5 * matrix_a_).inverse() *
-               (matrix_i + ts_ * 0.5 * matrix_a_);
+  matrix_ad_lu_.compute(matrix_i_ - ts_ * 0.5 * matrix_a_);
+  matrix_ad_rhs_ = matrix_i_ + ts_ * 0.5 * matrix_a_;
+  matrix_ad_ = matrix_ad_lu_.solve(matrix_ad_rhs_);
 }
 
 void LatController::UpdateMatrixCompound() {
@@ -769,20 +777,13 @@ void LatController::ComputeLateralErrors(
     const double x, const double y, const double theta, const double linear_v,
     const double angular_v, const double linear_a,
     const TrajectoryAnalyzer &trajectory_analyzer, SimpleLateralDebug *debug) {
-  TrajectoryPoint target_point;
-
-  if (FLAGS_query_time_nearest_point_only) {
-    target_point = trajectory_analyzer.QueryNearestPointByAbsoluteTime(
-        Clock::NowInSeconds() + query_relative_time_);
-  } else {
-    if (FLAGS_use_navigation_mode &&
-        !FLAGS_enable_navigation_mode_position_update) {
-      target_point = trajectory_analyzer.QueryNearestPointByAbsoluteTime(
-          Clock::NowInSeconds() + query_relative_time_);
-    } else {
-      target_point = trajectory_analyzer.QueryNearestPointByPosition(x, y);
-    }
-  }
+  const bool query_by_time = FLAGS_query_time_nearest_point_only ||
+                             (FLAGS_use_navigation_mode &&
+                              !FLAGS_enable_navigation_mode_position_update);
+  const TrajectoryPoint &target_point =
+      query_by_time ? trajectory_analyzer.QueryNearestPointByAbsoluteTime(
+                          Clock::NowInSeconds() + query_relative_time_)
+                    : trajectory_analyzer.QueryNearestPointByPosition(x, y);
   const double dx = x - target_point.path_point().x();
   const double dy = y - target_point.path_point().y();
 
@@ -837,7 +838,8 @@ void LatController::ComputeLateralErrors(
   if (injector_->vehicle_state()->gear() == canbus::Chassis::GEAR_REVERSE) {
     heading_error_feedback = heading_error;
   } else {
-    auto lookahead_point = trajectory_analyzer.QueryNearestPointByRelativeTime(
+    const auto &lookahead_point =
+        trajectory_analyzer.QueryNearestPointByRelativeTime(
         target_point.relative_time() +
         lookahead_station /
             (std::max(std::fabs(linear_v), 0.1) * std::cos(heading_error)));
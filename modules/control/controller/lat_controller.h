@@ -26,10 +26,12 @@
 #include <string>
 
 #include "Eigen/Core"
+#include "Eigen/LU"
 #include "modules/common/configs/proto/vehicle_config.pb.h"
 #include "modules/common/filters/digital_filter.h"
 #include "modules/common/filters/digital_filter_coefficients.h"
 #include "modules/common/filters/mean_filter.h"
+#include "modules/common/math/linear_quadratic_regulator.h"
 #include "modules/control/common/interpolation_1d.h"
 #include "modules/control/common/leadlag_controller.h"
 #include "modules/control/common/mrac_controller.h"
@@ -135,6 +137,9 @@ class LatController : public Controller {
 
   // a proxy to analyze the planning trajectory
   TrajectoryAnalyzer trajectory_analyzer_;
+  // the planning trajectory in the frame used for tracking, kept across
+  // cycles to reuse its allocations
+  planning::ADCTrajectory target_tracking_trajectory_;
 
   // the following parameters are vehicle physics related.
   // control time interval
@@ -179,6 +184,11 @@ class LatController : public Controller {
   Eigen::MatrixXd matrix_a_;
   // vehicle state matrix (discrete-time)
   Eigen::MatrixXd matrix_ad_;
+  // identity, right hand side and lu decomposition for discretizing
+  // matrix_a_ without allocating
+  Eigen::MatrixXd matrix_i_;
+  Eigen::MatrixXd matrix_ad_rhs_;
+  Eigen::PartialPivLU<Eigen::MatrixXd> matrix_ad_lu_;
   // vehicle state matrix compound; related to preview
   Eigen::MatrixXd matrix_adc_;
   // control matrix
@@ -204,6 +214,8 @@ class LatController : public Controller {
   int lqr_max_iteration_ = 0;
   // parameters for lqr solver; threshold for computation
   double lqr_eps_ = 0.0;
+  // intermediate matrices of the lqr solver
+  common::math::LQRWorkspace lqr_workspace_;
 
   common::DigitalFilter digital_filter_;
 
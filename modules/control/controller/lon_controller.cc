@@ -168,10 +168,12 @@ Status LonController::ComputeControlCommand(
                   "Fail to initialize calibration table.");
   }
 
-  if (trajectory_analyzer_ == nullptr ||
-      trajectory_analyzer_->seq_num() !=
-          trajectory_message_->header().sequence_num()) {
+  if (trajectory_analyzer_ == nullptr) {
     trajectory_analyzer_.reset(new TrajectoryAnalyzer(trajectory_message_));
+    trajectory_analyzer_->set_search_hint(injector_->trajectory_search_hint());
+  } else if (trajectory_analyzer_->seq_num() !=
+             trajectory_message_->header().sequence_num()) {
+    trajectory_analyzer_->Reset(trajectory_message_);
   }
   const LonControllerConf &lon_controller_conf =
       control_conf_->lon_controller_conf();
@@ -402,10 +404,10 @@ void LonController::ComputeLongitudinalErrors(
   double current_control_time = Time::Now().ToSecond();
   double preview_control_time = current_control_time + preview_time;
 
-  TrajectoryPoint reference_point =
+  const TrajectoryPoint &reference_point =
       trajectory_analyzer->QueryNearestPointByAbsoluteTime(
           current_control_time);
-  TrajectoryPoint preview_point =
+  const TrajectoryPoint &preview_point =
       trajectory_analyzer->QueryNearestPointByAbsoluteTime(
           preview_control_time);
 
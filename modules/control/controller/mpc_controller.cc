@@ -304,6 +304,7 @@ Status MPCController::ComputeControlCommand(
     ControlCommand *cmd) {
   trajectory_analyzer_ =
       std::move(TrajectoryAnalyzer(planning_published_trajectory));
+  trajectory_analyzer_.set_search_hint(injector_->trajectory_search_hint());
 
   SimpleMPCDebug *debug = cmd->mutable_debug()->mutable_simple_mpc_debug();
   debug->Clear();
@@ -391,6 +392,9 @@ Status MPCController::ComputeControlCommand(
       matrix_state_, lower_bound, upper_bound, lower_state_bound,
       upper_state_bound, reference_state, mpc_max_iteration_, horizon_,
       mpc_eps_);
+  if (FLAGS_use_condensed_mpc_solver) {
+    mpc_osqp.set_workspace(&mpc_osqp_workspace_);
+  }
   if (!mpc_osqp.Solve(&control_cmd)) {
     AERROR << "MPC OSQP solver failed";
   } else {
@@ -529,6 +533,7 @@ Status MPCController::ComputeControlCommand(
 Status MPCController::Reset() {
   previous_heading_error_ = 0.0;
   previous_lateral_error_ = 0.0;
+  mpc_osqp_workspace_.Reset();
   return Status::OK();
 }
 
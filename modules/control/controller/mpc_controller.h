@@ -205,6 +205,9 @@ class MPCController : public Controller {
   // 4 by 1 matrix; state matrix
   Eigen::MatrixXd matrix_state_;
 
+  // osqp workspace kept across cycles by the condensed mpc solver
+  common::math::MpcOsqpWorkspace mpc_osqp_workspace_;
+
   // heading error of last control cycle
   double previous_heading_error_ = 0.0;
   // lateral distance to reference trajectory of last control cycle
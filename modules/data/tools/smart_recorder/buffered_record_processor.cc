@@ -0,0 +1,292 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/data/tools/smart_recorder/buffered_record_processor.h"
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <set>
+
+#include "cyber/common/file.h"
+#include "cyber/common/log.h"
+#include "cyber/init.h"
+#include "cyber/record/record_message.h"
+#include "modules/common/adapters/adapter_gflags.h"
+#include "modules/monitor/common/monitor_manager.h"
+
+#include "modules/data/tools/smart_recorder/channel_pool.h"
+#include "modules/data/tools/smart_recorder/smart_recorder_gflags.h"
+
+namespace apollo {
+namespace data {
+
+namespace {
+
+using apollo::common::Header;
+using apollo::monitor::MonitorManager;
+using cyber::CreateNode;
+using cyber::ReaderConfig;
+using cyber::Time;
+using cyber::common::EnsureDirectory;
+using cyber::common::GetFileName;
+using cyber::message::RawMessage;
+using cyber::proto::ChangeMsg;
+using cyber::proto::RoleAttributes;
+using cyber::record::RecordMessage;
+using cyber::service_discovery::TopologyManager;
+
+constexpr uint64_t kSecondsToNanoSeconds = 1000000000UL;
+constexpr uint64_t kMBToBytes = 1024UL * 1024UL;
+
+uint64_t ContentSize(const std::shared_ptr<RawMessage>& content) {
+  return content->message.size();
+}
+
+}  // namespace
+
+BufferedRecordProcessor::BufferedRecordProcessor(
+    const std::string& source_record_dir,
+    const std::string& restored_output_dir)
+    : RecordProcessor(source_record_dir, restored_output_dir) {
+  default_output_filename_ = restored_output_dir_;
+  default_output_filename_.erase(
+      std::remove(default_output_filename_.begin(),
+                  default_output_filename_.end(), '-'),
+      default_output_filename_.end());
+  default_output_filename_ =
+      GetFileName(absl::StrCat(default_output_filename_, ".record"), false);
+}
+
+bool BufferedRecordProcessor::Init(const SmartRecordTrigger& trigger_conf) {
+  // Nothing is recorded to the input dir, but the base init checks it
+  if (!EnsureDirectory(source_record_dir_) ||
+      !EnsureDirectory(restored_output_dir_)) {
+    AERROR << "unable to init input/output dir: " << source_record_dir_ << "/"
+           << restored_output_dir_;
+    return false;
+  }
+  cyber::Init("smart_recorder");
+  smart_recorder_node_ = CreateNode(absl::StrCat("smart_recorder_", getpid()));
+  if (smart_recorder_node_ == nullptr) {
+    AERROR << "create smart recorder node failed: " << getpid();
+    return false;
+  }
+  recorder_status_writer_ =
+      smart_recorder_node_->CreateWriter<SmartRecorderStatus>(
+          FLAGS_recorder_status_topic);
+  max_backward_time_ = static_cast<uint64_t>(trigger_conf.max_backward_time() *
+                                             kSecondsToNanoSeconds);
+  max_buffer_size_ =
+      static_cast<uint64_t>(FLAGS_buffered_max_size_mb) * kMBToBytes;
+  // Init base
+  if (!RecordProcessor::Init(trigger_conf)) {
+    AERROR << "base init failed";
+    return false;
+  }
+  return true;
+}
+
+bool BufferedRecordProcessor::Process() {
+  InitReaders();
+  PublishStatus(RecordingState::RECORDING, "smart recorder started");
+  MonitorManager::Instance()->LogBuffer().INFO("SmartRecorder is recording...");
+  static constexpr auto kWaitTime = std::chrono::milliseconds(100);
+  static constexpr auto kPublishStatusInterval = std::chrono::seconds(3);
+  auto next_status_time =
+      std::chrono::steady_clock::now() + kPublishStatusInterval;
+  std::vector<BufferedMessage> messages;
+  while (!cyber::IsShutdown()) {
+    {
+      std::unique_lock<std::mutex> lock(pending_mutex_);
+      pending_cv_.wait_for(lock, kWaitTime,
+                           [this]() { return !pending_messages_.empty(); });
+      messages.swap(pending_messages_);
+    }
+    for (auto& message : messages) {
+      ProcessMessage(std::move(message));
+    }
+    messages.clear();
+    if (std::chrono::steady_clock::now() >= next_status_time) {
+      next_status_time += kPublishStatusInterval;
+      PublishStatus(RecordingState::RECORDING, "smart recorder recording");
+    }
+  }
+
+  TopologyManager::Instance()->channel_manager()->RemoveChangeListener(
+      change_conn_);
+  {
+    std::lock_guard<std::mutex> lock(pending_mutex_);
+    channel_readers_.clear();
+    messages.swap(pending_messages_);
+  }
+  for (auto& message : messages) {
+    ProcessMessage(std::move(message));
+  }
+  Drain(std::numeric_limits<uint64_t>::max());
+  AINFO << "wrote " << written_size_ << " bytes, dropped " << dropped_size_
+        << " bytes";
+  PublishStatus(RecordingState::STOPPED, "smart recorder stopped");
+  MonitorManager::Instance()->LogBuffer().INFO("SmartRecorder is stopped");
+  return true;
+}
+
+void BufferedRecordProcessor::InitReaders() {
+  auto channel_manager = TopologyManager::Instance()->channel_manager();
+  // Listen to new writers first, not to miss any of them
+  change_conn_ = channel_manager->AddChangeListener(
+      [this](const ChangeMsg& change_message) {
+        if (change_message.role_type() == cyber::proto::ROLE_WRITER) {
+          FindNewChannel(change_message.role_attr());
+        }
+      });
+  std::vector<RoleAttributes> role_attrs;
+  channel_manager->GetWriters(&role_attrs);
+  for (const auto& role_attr : role_attrs) {
+    FindNewChannel(role_attr);
+  }
+}
+
+void BufferedRecordProcessor::FindNewChannel(const RoleAttributes& role_attr) {
+  const std::string& channel_name = role_attr.channel_name();
+  const std::set<std::string>& all_channels =
+      ChannelPool::Instance()->GetAllChannels();
+  if (all_channels.find(channel_name) == all_channels.end() ||
+      role_attr.message_type().empty() || role_attr.proto_desc().empty()) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(pending_mutex_);
+  if (channel_readers_.find(channel_name) != channel_readers_.end()) {
+    return;
+  }
+  channel_types_[channel_name] =
+      std::make_pair(role_attr.message_type(), role_attr.proto_desc());
+  ReaderConfig config;
+  config.channel_name = channel_name;
+  config.pending_queue_size =
+      gflags::Int32FromEnv("CYBER_PENDING_QUEUE_SIZE", 50);
+  auto reader = smart_recorder_node_->CreateReader<RawMessage>(
+      config, [this, channel_name](const std::shared_ptr<RawMessage>& content) {
+        OnMessage(channel_name, content);
+      });
+  if (reader == nullptr) {
+    AERROR << "create reader failed: " << channel_name;
+    return;
+  }
+  channel_readers_[channel_name] = reader;
+}
+
+void BufferedRecordProcessor::OnMessage(
+    const std::string& channel_name,
+    const std::shared_ptr<RawMessage>& content) {
+  if (content == nullptr) {
+    return;
+  }
+  {
+    // Stamped under the lock, so that the pending messages are in time order
+    std::lock_guard<std::mutex> lock(pending_mutex_);
+    pending_messages_.push_back(
+        {channel_name, content, Time::Now().ToNanosecond(), false});
+  }
+  pending_cv_.notify_one();
+}
+
+void BufferedRecordProcessor::ProcessMessage(BufferedMessage message) {
+  // The triggers only look into the small channels, which spares copying the
+  // large messages into a RecordMessage
+  const std::set<std::string>& small_channels =
+      ChannelPool::Instance()->GetSmallChannels();
+  if (small_channels.find(message.channel_name) != small_channels.end()) {
+    const RecordMessage record_message(
+        message.channel_name, message.content->message, message.time);
+    for (const auto& trigger : triggers_) {
+      trigger->Pull(record_message);
+    }
+    message.restore = ShouldRestore(record_message);
+    UpdateIntervals();
+  }
+  const uint64_t time = message.time;
+  buffer_size_ += ContentSize(message.content);
+  buffer_.push_back(std::move(message));
+  // No trigger reaches further back than max_backward_time
+  Drain(time > max_backward_time_ ? time - max_backward_time_ : 0);
+}
+
+void BufferedRecordProcessor::UpdateIntervals() {
+  // The triggers add their intervals to the pool, which merges them into the
+  // last one when they overlap
+  const Interval interval = IntervalPool::Instance()->GetNextInterval();
+  if (interval.end_time == 0) {
+    return;
+  }
+  if (intervals_.empty() ||
+      interval.begin_time > intervals_.back().end_time) {
+    intervals_.push_back(interval);
+    return;
+  }
+  intervals_.back().begin_time =
+      std::min(intervals_.back().begin_time, interval.begin_time);
+  intervals_.back().end_time =
+      std::max(intervals_.back().end_time, interval.end_time);
+}
+
+void BufferedRecordProcessor::Drain(const uint64_t before_time) {
+  while (!buffer_.empty() &&
+         (buffer_.front().time < before_time ||
+          buffer_size_ > max_buffer_size_)) {
+    const BufferedMessage& message = buffer_.front();
+    const uint64_t size = ContentSize(message.content);
+    if (ShouldKeep(message)) {
+      if (writer_->IsNewChannel(message.channel_name)) {
+        std::lock_guard<std::mutex> lock(pending_mutex_);
+        const auto& channel_type = channel_types_[message.channel_name];
+        writer_->WriteChannel(message.channel_name, channel_type.first,
+                              channel_type.second);
+      }
+      writer_->WriteMessage(message.channel_name, message.content,
+                            message.time);
+      written_size_ += size;
+    } else {
+      dropped_size_ += size;
+    }
+    buffer_size_ -= size;
+    buffer_.pop_front();
+  }
+}
+
+bool BufferedRecordProcessor::ShouldKeep(const BufferedMessage& message) {
+  // The messages leave the buffer in time order, so that the intervals
+  // ending before them are done
+  while (!intervals_.empty() && intervals_.front().end_time < message.time) {
+    intervals_.pop_front();
+  }
+  return message.restore || (!intervals_.empty() &&
+                             intervals_.front().begin_time <= message.time);
+}
+
+void BufferedRecordProcessor::PublishStatus(const RecordingState state,
+                                            const std::string& message) const {
+  SmartRecorderStatus status;
+  Header* status_headerpb = status.mutable_header();
+  status_headerpb->set_timestamp_sec(Time::Now().ToSecond());
+  status.set_recording_state(state);
+  status.set_state_message(message);
+  AINFO << "send message with state " << state << ", " << message;
+  recorder_status_writer_->Write(status);
+}
+
+}  // namespace data
+}  // namespace apollo
@@ -0,0 +1,108 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+#include "cyber/cyber.h"
+#include "cyber/message/raw_message.h"
+#include "cyber/proto/topology_change.pb.h"
+
+#include "modules/data/tools/smart_recorder/interval_pool.h"
+#include "modules/data/tools/smart_recorder/proto/smart_recorder_status.pb.h"
+#include "modules/data/tools/smart_recorder/proto/smart_recorder_triggers.pb.h"
+#include "modules/data/tools/smart_recorder/record_processor.h"
+
+namespace apollo {
+namespace data {
+
+/**
+ * @class BufferedRecordProcessor
+ * @brief Realtime processor that subscribes to the channels itself and keeps
+ * the messages of the last max_backward_time in memory instead of recording
+ * them to disk first. The messages are written in time order as they leave
+ * the buffer, if they are restored by a trigger or fall into the interval of
+ * one, and dropped otherwise, so that only what is kept reaches the disk.
+ */
+class BufferedRecordProcessor : public RecordProcessor {
+ public:
+  BufferedRecordProcessor(const std::string& source_record_dir,
+                          const std::string& restored_output_dir);
+  bool Init(const SmartRecordTrigger& trigger_conf) override;
+  bool Process() override;
+  std::string GetDefaultOutputFile() const override {
+    return absl::StrCat(restored_output_dir_, "/", default_output_filename_);
+  };
+  virtual ~BufferedRecordProcessor() = default;
+
+ private:
+  struct BufferedMessage {
+    std::string channel_name;
+    std::shared_ptr<cyber::message::RawMessage> content;
+    uint64_t time;
+    // Whether a trigger restores the message regardless of the intervals.
+    bool restore;
+  };
+
+  void InitReaders();
+  void FindNewChannel(const cyber::proto::RoleAttributes& role_attr);
+  void OnMessage(const std::string& channel_name,
+                 const std::shared_ptr<cyber::message::RawMessage>& content);
+  void ProcessMessage(BufferedMessage message);
+  void UpdateIntervals();
+  // Writes or drops the messages received before the given time, and the
+  // oldest ones past the size limit of the buffer.
+  void Drain(const uint64_t before_time);
+  bool ShouldKeep(const BufferedMessage& message);
+  void PublishStatus(const RecordingState state,
+                     const std::string& message) const;
+
+  std::shared_ptr<cyber::Node> smart_recorder_node_ = nullptr;
+  std::shared_ptr<cyber::Writer<SmartRecorderStatus>> recorder_status_writer_ =
+      nullptr;
+  cyber::base::Connection<const cyber::proto::ChangeMsg&> change_conn_;
+  std::string default_output_filename_;
+  uint64_t max_backward_time_ = 0;
+  uint64_t max_buffer_size_ = 0;
+
+  // Guards the readers and the messages they received.
+  std::mutex pending_mutex_;
+  std::condition_variable pending_cv_;
+  std::unordered_map<std::string, std::shared_ptr<cyber::ReaderBase>>
+      channel_readers_;
+  // Message type and proto desc of the channels.
+  std::unordered_map<std::string, std::pair<std::string, std::string>>
+      channel_types_;
+  std::vector<BufferedMessage> pending_messages_;
+
+  std::deque<BufferedMessage> buffer_;
+  uint64_t buffer_size_ = 0;
+  std::deque<Interval> intervals_;
+  uint64_t written_size_ = 0;
+  uint64_t dropped_size_ = 0;
+};
+
+}  // namespace data
+}  // namespace apollo
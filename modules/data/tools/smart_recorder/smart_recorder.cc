@@ -22,11 +22,13 @@
 #include "cyber/common/file.h"
 #include "cyber/common/log.h"
 
+#include "modules/data/tools/smart_recorder/buffered_record_processor.h"
 #include "modules/data/tools/smart_recorder/post_record_processor.h"
 #include "modules/data/tools/smart_recorder/realtime_record_processor.h"
 #include "modules/data/tools/smart_recorder/smart_recorder_gflags.h"
 
 using apollo::cyber::common::GetProtoFromFile;
+using apollo::data::BufferedRecordProcessor;
 using apollo::data::PostRecordProcessor;
 using apollo::data::RealtimeRecordProcessor;
 using apollo::data::RecordProcessor;
@@ -51,6 +53,9 @@ int main(int argc, char** argv) {
   if (!FLAGS_real_time_trigger) {
     processor = std::unique_ptr<RecordProcessor>(new PostRecordProcessor(
         FLAGS_source_records_dir, FLAGS_restored_output_dir));
+  } else if (FLAGS_buffered_trigger) {
+    processor = std::unique_ptr<RecordProcessor>(new BufferedRecordProcessor(
+        FLAGS_source_records_dir, FLAGS_restored_output_dir));
   }
   if (!processor->Init(trigger_conf)) {
     AERROR << "failed to init record processor";
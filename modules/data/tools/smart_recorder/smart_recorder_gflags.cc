@@ -23,3 +23,10 @@ DEFINE_string(smart_recorder_config_filename,
               "smart_recorder_config.pb.txt",
               "The config file.");
 DEFINE_bool(real_time_trigger, true, "Whether to use realtime trigger.");
+DEFINE_bool(buffered_trigger, false,
+            "Whether the realtime trigger keeps the recent messages in memory "
+            "and only writes those it keeps, instead of recording all of "
+            "them to the source dir first.");
+DEFINE_int32(buffered_max_size_mb, 4096,
+             "The max size of the messages kept in memory by the buffered "
+             "trigger, past which the oldest ones leave the buffer early.");
@@ -22,3 +22,5 @@ DECLARE_string(source_records_dir);
 DECLARE_string(restored_output_dir);
 DECLARE_string(smart_recorder_config_filename);
 DECLARE_bool(real_time_trigger);
+DECLARE_bool(buffered_trigger);
+DECLARE_int32(buffered_max_size_mb);
@@ -58,6 +58,10 @@ DEFINE_double(sim_map_radius, 200.0,
               "The radius within which Dreamview will find all the map "
               "elements around the car.");
 
+DEFINE_double(map_tile_size, 100.0,
+              "The size in meters of the smallest map tiles whose element ids "
+              "are cached, or 0 to search the map on every request.");
+
 DEFINE_bool(enable_update_size_check, true,
             "True to check if the update byte number is less than threshold");
 
@@ -92,3 +96,15 @@ DEFINE_int32(monitor_msg_pending_queue_size, 10,
 DEFINE_string(default_data_collection_config_path,
               "/apollo/modules/dreamview/conf/data_collection_table.pb.txt",
               "Data collection table config path.");
+
+DEFINE_double(sim_control_time_factor, 1.0,
+              "How much faster than the wall clock SimControl runs. Other "
+              "than 1.0, SimControl drives the mock clock of the process and "
+              "publishes the steps due in each timer tick as a batch. Has no "
+              "effect in the simulation run mode, where the virtual clock "
+              "already runs as fast as the callbacks do.");
+
+DEFINE_bool(sim_world_serialize_without_client, true,
+            "Whether to serialize the simulation world for the frontend "
+            "while no client is connected. The world itself is updated "
+            "either way.");
@@ -38,6 +38,8 @@ DECLARE_string(ssl_certificate);
 
 DECLARE_double(sim_map_radius);
 
+DECLARE_double(map_tile_size);
+
 DECLARE_int32(dreamview_worker_num);
 
 DECLARE_bool(enable_update_size_check);
@@ -59,3 +61,7 @@ DECLARE_string(lidar_height_yaml);
 DECLARE_int32(monitor_msg_pending_queue_size);
 
 DECLARE_string(default_data_collection_config_path);
+
+DECLARE_double(sim_control_time_factor);
+
+DECLARE_bool(sim_world_serialize_without_client);
@@ -16,6 +16,9 @@
 
 #include "modules/dreamview/backend/handlers/websocket_handler.h"
 
+#include <algorithm>
+#include <utility>
+
 #include "cyber/common/log.h"
 #include "modules/common/util/map_util.h"
 
@@ -24,13 +27,30 @@ namespace dreamview {
 
 using apollo::common::util::ContainsKey;
 
+WebSocketHandler::~WebSocketHandler() {
+  std::unordered_map<Connection *, std::shared_ptr<ConnectionQueue>>
+      connections;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    connections.swap(connections_);
+  }
+  for (auto &kv : connections) {
+    CloseQueue(kv.second.get());
+  }
+}
+
 void WebSocketHandler::handleReadyState(CivetServer *server, Connection *conn) {
+  auto queue = std::make_shared<ConnectionQueue>();
+  queue->sender = std::thread(&WebSocketHandler::SendLoop, this, conn,
+                              queue.get());
+  size_t num_connections = 0;
   {
     std::unique_lock<std::mutex> lock(mutex_);
-    connections_.emplace(conn, std::make_shared<std::mutex>());
+    connections_.emplace(conn, queue);
+    num_connections = connections_.size();
   }
   AINFO << name_
-        << ": Accepted connection. Total connections: " << connections_.size();
+        << ": Accepted connection. Total connections: " << num_connections;
 
   // Trigger registered new connection handlers.
   for (const auto handler : connection_ready_handlers_) {
@@ -40,43 +60,59 @@ void WebSocketHandler::handleReadyState(CivetServer *server, Connection *conn) {
 
 void WebSocketHandler::handleClose(CivetServer *server,
                                    const Connection *conn) {
-  // Remove from the store of currently open connections. Copy the mutex out
+  // Remove from the store of currently open connections. Copy the queue out
   // so that it won't be reclaimed during map.erase().
   Connection *connection = const_cast<Connection *>(conn);
 
-  std::shared_ptr<std::mutex> connection_lock;
+  std::shared_ptr<ConnectionQueue> queue;
+  size_t num_connections = 0;
   {
     std::unique_lock<std::mutex> lock(mutex_);
-    connection_lock = connections_[connection];
+    auto iter = connections_.find(connection);
+    if (iter != connections_.end()) {
+      queue = iter->second;
+      connections_.erase(iter);
+    }
+    num_connections = connections_.size();
   }
-
-  {
-    // Make sure there's no data being sent via the connection
-    std::unique_lock<std::mutex> lock_connection(*connection_lock);
-    std::unique_lock<std::mutex> lock(mutex_);
-    connections_.erase(connection);
+  if (queue == nullptr) {
+    return;
   }
 
-  AINFO << name_
-        << ": Connection closed. Total connections: " << connections_.size();
+  // Make sure there's no data being sent via the connection.
+  CloseQueue(queue.get());
+
+  AINFO << name_ << ": Connection closed after sending " << queue->num_sent
+        << " messages, skipped " << queue->num_skipped << ", send latency "
+        << (queue->num_sent > 0 ? queue->total_latency_ms / queue->num_sent
+                                : 0.0)
+        << " ms on average, " << queue->max_latency_ms
+        << " ms at most. Total connections: " << num_connections;
+}
+
+size_t WebSocketHandler::NumConnections() const {
+  std::unique_lock<std::mutex> lock(mutex_);
+  return connections_.size();
 }
 
 bool WebSocketHandler::BroadcastData(const std::string &data, bool skippable) {
-  std::vector<Connection *> connections_to_send;
+  std::vector<std::shared_ptr<ConnectionQueue>> queues;
   {
     std::unique_lock<std::mutex> lock(mutex_);
     if (connections_.empty()) {
       return true;
     }
     for (auto &kv : connections_) {
-      Connection *conn = kv.first;
-      connections_to_send.push_back(conn);
+      queues.push_back(kv.second);
     }
   }
 
+  // All the connections share one copy of the data.
+  auto shared_data = std::make_shared<const std::string>(data);
   bool all_success = true;
-  for (Connection *conn : connections_to_send) {
-    if (!SendData(conn, data, skippable)) {
+  for (const auto &queue : queues) {
+    if (!Enqueue(queue.get(), shared_data, skippable,
+                 MG_WEBSOCKET_OPCODE_TEXT)) {
       all_success = false;
     }
   }
@@ -89,9 +125,10 @@ bool WebSocketHandler::SendBinaryData(Connection *conn, const std::string &data,
   return SendData(conn, data, skippable, MG_WEBSOCKET_OPCODE_BINARY);
 }
 
-bool WebSocketHandler::SendData(Connection *conn, const std::string &data,
-                                bool skippable, int op_code) {
-  std::shared_ptr<std::mutex> connection_lock;
+bool WebSocketHandler::SendBinaryData(
+    Connection *conn, const std::shared_ptr<const std::string> &data,
+    bool skippable) {
+  std::shared_ptr<ConnectionQueue> queue;
   {
     std::unique_lock<std::mutex> lock(mutex_);
     if (!ContainsKey(connections_, conn)) {
@@ -99,34 +136,102 @@ bool WebSocketHandler::SendData(Connection *conn, const std::string &data,
              << ": Trying to send to an uncached connection, skipping.";
       return false;
     }
-    // Copy the lock so that it still exists if the connection is closed after
-    // this block.
-    connection_lock = connections_[conn];
-  }
-
-  // Lock the connection while sending.
-  if (!connection_lock->try_lock()) {
-    // Skip sending data if:
-    // 1. Data is skippable according to sender and there's higher priority data
-    // being sent.
-    // 2. The connection has been closed.
-    if (skippable) {
-      AWARN << "Skip sending a droppable message!";
-      return false;
-    }
-    // Block to acquire the lock.
-    connection_lock->lock();
+    queue = connections_[conn];
+  }
+  return Enqueue(queue.get(), data, skippable, MG_WEBSOCKET_OPCODE_BINARY);
+}
+
+bool WebSocketHandler::SendData(Connection *conn, const std::string &data,
+                                bool skippable, int op_code) {
+  std::shared_ptr<ConnectionQueue> queue;
+  {
     std::unique_lock<std::mutex> lock(mutex_);
     if (!ContainsKey(connections_, conn)) {
+      AERROR << name_
+             << ": Trying to send to an uncached connection, skipping.";
       return false;
     }
+    // Copy the queue so that it still exists if the connection is closed
+    // after this block.
+    queue = connections_[conn];
   }
+  return Enqueue(queue.get(), std::make_shared<const std::string>(data),
+                 skippable, op_code);
+}
 
-  // Note that while we are holding the connection lock, the connection won't be
-  // closed and removed.
-  int ret = mg_websocket_write(conn, op_code, data.c_str(), data.size());
-  connection_lock->unlock();
+bool WebSocketHandler::Enqueue(ConnectionQueue *queue,
+                               std::shared_ptr<const std::string> data,
+                               bool skippable, int op_code) {
+  std::unique_lock<std::mutex> lock(queue->mutex);
+  if (queue->closed) {
+    return false;
+  }
+
+  OutgoingMessage message;
+  message.data = std::move(data);
+  message.op_code = op_code;
+  message.skippable = skippable;
+  message.enqueue_time = std::chrono::steady_clock::now();
+
+  if (skippable && (queue->sending || !queue->messages.empty())) {
+    // Some other data is being sent. Replace the skippable message still
+    // waiting behind it, if any, so that the client gets the latest one.
+    ++queue->num_skipped;
+    if (!queue->messages.empty() && queue->messages.back().skippable &&
+        queue->messages.back().op_code == op_code) {
+      queue->messages.back() = std::move(message);
+      return true;
+    }
+    AWARN << "Skip sending a droppable message!";
+    return false;
+  }
+  if (queue->messages.size() >= kMaxQueuedMessages) {
+    ++queue->num_skipped;
+    AWARN << name_ << ": Too many messages queued for a connection, dropping.";
+    return false;
+  }
+  queue->messages.push_back(std::move(message));
+  queue->cv.notify_one();
+  return true;
+}
+
+void WebSocketHandler::SendLoop(Connection *conn, ConnectionQueue *queue) {
+  while (true) {
+    OutgoingMessage message;
+    {
+      std::unique_lock<std::mutex> lock(queue->mutex);
+      queue->cv.wait(lock, [queue] {
+        return queue->closed || !queue->messages.empty();
+      });
+      if (queue->closed) {
+        return;
+      }
+      message = std::move(queue->messages.front());
+      queue->messages.pop_front();
+      queue->sending = true;
+    }
+
+    // Note that the connection won't be closed and removed until this thread
+    // quits.
+    const bool success = Write(conn, *message.data, message.op_code);
+    const double latency_ms =
+        std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - message.enqueue_time)
+            .count();
+
+    std::unique_lock<std::mutex> lock(queue->mutex);
+    queue->sending = false;
+    if (success) {
+      ++queue->num_sent;
+      queue->total_latency_ms += latency_ms;
+      queue->max_latency_ms = std::max(queue->max_latency_ms, latency_ms);
+    }
+  }
+}
 
+bool WebSocketHandler::Write(Connection *conn, const std::string &data,
+                             int op_code) {
+  int ret = mg_websocket_write(conn, op_code, data.c_str(), data.size());
   if (ret != static_cast<int>(data.size())) {
     // When data is empty, the header length (2) is returned.
     if (data.empty() && ret == 2) {
@@ -148,6 +253,17 @@ bool WebSocketHandler::SendData(Connection *conn, const std::string &data,
   return true;
 }
 
+void WebSocketHandler::CloseQueue(ConnectionQueue *queue) {
+  {
+    std::unique_lock<std::mutex> lock(queue->mutex);
+    queue->closed = true;
+  }
+  queue->cv.notify_all();
+  if (queue->sender.joinable()) {
+    queue->sender.join();
+  }
+}
+
 thread_local unsigned char WebSocketHandler::current_opcode_ = 0x00;
 thread_local std::stringstream WebSocketHandler::data_;
 
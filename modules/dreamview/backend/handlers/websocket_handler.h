@@ -20,6 +20,9 @@
 
 #pragma once
 
+#include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -57,6 +60,8 @@ class WebSocketHandler : public CivetWebSocketHandler {
 
   explicit WebSocketHandler(const std::string &name) : name_(name) {}
 
+  ~WebSocketHandler();
+
   /**
    * @brief Callback method for when the client intends to establish a websocket
    * connection, before websocket handshake.
@@ -121,10 +126,16 @@ class WebSocketHandler : public CivetWebSocketHandler {
   /**
    * @brief Sends the provided data to a specific connected client.
    *
+   * @details The data is queued for the connection, whose own thread writes
+   * it to the socket, so that a slow client does not hold up the caller nor
+   * the other clients.
+   *
    * @param conn The connection to send to.
    * @param data The message string to be sent.
    * @param skippable whether the data is allowed to be skipped if some other is
-   * being sent to this connection.
+   * being sent to this connection. A skippable message still waiting to be
+   * sent is replaced by the next one instead.
+   * @returns false if the data is skipped or the connection is gone
    */
   bool SendData(Connection *conn, const std::string &data,
                 bool skippable = false, int op_code = MG_WEBSOCKET_OPCODE_TEXT);
@@ -132,6 +143,18 @@ class WebSocketHandler : public CivetWebSocketHandler {
   bool SendBinaryData(Connection *conn, const std::string &data,
                       bool skippable = false);
 
+  /**
+   * @brief Sends binary data shared with other senders, without copying it.
+   */
+  bool SendBinaryData(Connection *conn,
+                      const std::shared_ptr<const std::string> &data,
+                      bool skippable = false);
+
+  /**
+   * @brief The number of clients currently connected.
+   */
+  size_t NumConnections() const;
+
   /**
    * @brief Add a new message handler for a message type.
    * @param type The name/key to identify the message type.
@@ -164,9 +187,46 @@ class WebSocketHandler : public CivetWebSocketHandler {
   // brief as possible.
   mutable std::mutex mutex_;
 
-  // The pool of all maintained connections. Each connection has a lock to
-  // guard against simultaneous write.
-  std::unordered_map<Connection *, std::shared_ptr<std::mutex>> connections_;
+  // A message waiting to be sent to a connection.
+  struct OutgoingMessage {
+    std::shared_ptr<const std::string> data;
+    int op_code = MG_WEBSOCKET_OPCODE_TEXT;
+    bool skippable = false;
+    std::chrono::steady_clock::time_point enqueue_time;
+  };
+
+  // The messages to a connection and the thread writing them to its socket.
+  struct ConnectionQueue {
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<OutgoingMessage> messages;
+    // Whether a message is being written to the socket.
+    bool sending = false;
+    bool closed = false;
+    std::thread sender;
+
+    // Statistics of the connection, logged when it is closed.
+    uint64_t num_sent = 0;
+    uint64_t num_skipped = 0;
+    double total_latency_ms = 0.0;
+    double max_latency_ms = 0.0;
+  };
+
+  // Messages beyond this many to a connection are dropped, the client is not
+  // keeping up with them anyway.
+  static constexpr size_t kMaxQueuedMessages = 64;
+
+  bool Enqueue(ConnectionQueue *queue,
+               std::shared_ptr<const std::string> data, bool skippable,
+               int op_code);
+  void SendLoop(Connection *conn, ConnectionQueue *queue);
+  bool Write(Connection *conn, const std::string &data, int op_code);
+  void CloseQueue(ConnectionQueue *queue);
+
+  // The pool of all maintained connections, each with its queue of messages
+  // to be sent.
+  std::unordered_map<Connection *, std::shared_ptr<ConnectionQueue>>
+      connections_;
 };
 
 }  // namespace dreamview
@@ -17,11 +17,13 @@
 #include "modules/dreamview/backend/map/map_service.h"
 
 #include <algorithm>
+#include <cmath>
 #include <fstream>
 #include <utility>
 
 #include "modules/common/util/json_util.h"
 #include "modules/common/util/string_util.h"
+#include "modules/dreamview/backend/common/dreamview_gflags.h"
 #include "modules/map/hdmap/hdmap_util.h"
 
 namespace apollo {
@@ -79,6 +81,16 @@ void ExtractRoadAndLaneIds(const std::vector<LaneInfoConstPtr> &lanes,
   std::sort(road_ids->begin(), road_ids->end());
 }
 
+// The ids of a tile are merged from the tiles around it, drop the elements
+// found in several of them.
+void SortAndUnique(RepeatedPtrField<std::string> *ids) {
+  std::sort(ids->begin(), ids->end());
+  ids->erase(std::unique(ids->begin(), ids->end()), ids->end());
+}
+
+// Bound the memory of the tile cache, which is dropped once it grows beyond.
+constexpr size_t kMaxCachedTiles = 4096;
+
 }  // namespace
 
 const char MapService::kMetaFileName[] = "/metaInfo.json";
@@ -96,6 +108,10 @@ bool MapService::ReloadMap(bool force_reload) {
 
   // Update the x,y-offsets if present.
   UpdateOffsets();
+  {
+    std::lock_guard<std::mutex> lock(tiles_mutex_);
+    tiles_.clear();
+  }
   return ret;
 }
 
@@ -162,6 +178,71 @@ void MapService::CollectMapElementIds(const PointENU &point, double radius,
   }
   boost::shared_lock<boost::shared_mutex> reader_lock(mutex_);
 
+  if (FLAGS_map_tile_size <= 0.0 || radius <= 0.0) {
+    SearchMapElementIds(point, radius, ids);
+    return;
+  }
+
+  int level = 0;
+  double tile_size = FLAGS_map_tile_size;
+  while (tile_size < radius) {
+    tile_size *= 2.0;
+    ++level;
+  }
+  const auto min_x = static_cast<int64_t>(
+      std::floor((point.x() - radius) / tile_size));
+  const auto max_x = static_cast<int64_t>(
+      std::floor((point.x() + radius) / tile_size));
+  const auto min_y = static_cast<int64_t>(
+      std::floor((point.y() - radius) / tile_size));
+  const auto max_y = static_cast<int64_t>(
+      std::floor((point.y() + radius) / tile_size));
+  for (int64_t x = min_x; x <= max_x; ++x) {
+    for (int64_t y = min_y; y <= max_y; ++y) {
+      ids->MergeFrom(*GetTileElementIds(TileKey(level, x, y), tile_size));
+    }
+  }
+
+  SortAndUnique(ids->mutable_lane());
+  SortAndUnique(ids->mutable_road());
+  SortAndUnique(ids->mutable_clear_area());
+  SortAndUnique(ids->mutable_crosswalk());
+  SortAndUnique(ids->mutable_junction());
+  SortAndUnique(ids->mutable_pnc_junction());
+  SortAndUnique(ids->mutable_parking_space());
+  SortAndUnique(ids->mutable_speed_bump());
+  SortAndUnique(ids->mutable_signal());
+  SortAndUnique(ids->mutable_stop_sign());
+  SortAndUnique(ids->mutable_yield());
+}
+
+std::shared_ptr<const MapElementIds> MapService::GetTileElementIds(
+    const TileKey &key, double tile_size) const {
+  {
+    std::lock_guard<std::mutex> lock(tiles_mutex_);
+    auto iter = tiles_.find(key);
+    if (iter != tiles_.end()) {
+      return iter->second;
+    }
+  }
+
+  // Search the circle around the tile, without holding the lock of the cache.
+  PointENU center;
+  center.set_x((static_cast<double>(std::get<1>(key)) + 0.5) * tile_size);
+  center.set_y((static_cast<double>(std::get<2>(key)) + 0.5) * tile_size);
+  auto tile = std::make_shared<MapElementIds>();
+  SearchMapElementIds(center, tile_size * M_SQRT1_2, tile.get());
+
+  std::lock_guard<std::mutex> lock(tiles_mutex_);
+  if (tiles_.size() >= kMaxCachedTiles) {
+    tiles_.clear();
+  }
+  tiles_[key] = tile;
+  return tile;
+}
+
+void MapService::SearchMapElementIds(const PointENU &point, double radius,
+                                     MapElementIds *ids) const {
   std::vector<LaneInfoConstPtr> lanes;
   if (SimMap()->GetLanes(point, radius, &lanes) != 0) {
     AERROR << "Fail to get lanes from sim_map.";
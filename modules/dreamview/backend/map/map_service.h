@@ -20,7 +20,11 @@
 
 #pragma once
 
+#include <map>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <tuple>
 #include <vector>
 
 #include <boost/thread/locks.hpp>
@@ -44,6 +48,16 @@ class MapService {
   inline double GetXOffset() const { return x_offset_; }
   inline double GetYOffset() const { return y_offset_; }
 
+  /**
+   * @brief Collect the ids of the map elements around a point.
+   *
+   * @details The map is divided into square tiles, whose element ids are
+   * searched once and cached. The tiles of each level are twice as large as
+   * those of the level below, the level whose tiles are at least as large as
+   * the radius is used, so that the ids are merged from 9 tiles at most.
+   * The result may then include elements up to a tile beyond the radius, but
+   * it only changes when the point crosses the border of a tile.
+   */
   void CollectMapElementIds(const apollo::common::PointENU &point,
                             double raidus, MapElementIds *ids) const;
 
@@ -87,6 +101,16 @@ class MapService {
 
  private:
   void UpdateOffsets();
+
+  // Search the map for the ids of the elements around a point. The caller
+  // holds the reader lock.
+  void SearchMapElementIds(const apollo::common::PointENU &point,
+                           double radius, MapElementIds *ids) const;
+
+  // The ids of the elements in a map tile, keyed by its level and indices.
+  using TileKey = std::tuple<int, int64_t, int64_t>;
+  std::shared_ptr<const MapElementIds> GetTileElementIds(
+      const TileKey &key, double tile_size) const;
   bool GetNearestLane(const double x, const double y,
                       apollo::hdmap::LaneInfoConstPtr *nearest_lane,
                       double *nearest_s, double *nearest_l) const;
@@ -115,6 +139,10 @@ class MapService {
 
   // RW lock to protect map data
   mutable boost::shared_mutex mutex_;
+
+  // The cached element ids of map tiles, cleared when the map is reloaded.
+  mutable std::map<TileKey, std::shared_ptr<const MapElementIds>> tiles_;
+  mutable std::mutex tiles_mutex_;
 };
 
 }  // namespace dreamview
@@ -20,6 +20,7 @@
 #include "gtest/gtest.h"
 
 #include "modules/common/configs/config_gflags.h"
+#include "modules/dreamview/backend/common/dreamview_gflags.h"
 
 using apollo::common::PointENU;
 using apollo::hdmap::Map;
@@ -54,6 +55,25 @@ TEST_F(MapServiceTest, CollectMapElementIds) {
   EXPECT_TRUE(map_element_ids.yield().empty());
 }
 
+TEST_F(MapServiceTest, CollectMapElementIdsFromTiles) {
+  PointENU p;
+  p.set_x(-1826.0);
+  p.set_y(-3027.0);
+  MapElementIds searched_ids;
+  FLAGS_map_tile_size = 0.0;
+  map_service->CollectMapElementIds(p, 10.0, &searched_ids);
+
+  FLAGS_map_tile_size = 4.0;
+  for (int i = 0; i < 2; ++i) {
+    MapElementIds map_element_ids;
+    map_service->CollectMapElementIds(p, 10.0, &map_element_ids);
+    EXPECT_EQ(1, map_element_ids.lane_size());
+    EXPECT_EQ("l1", map_element_ids.lane(0));
+    EXPECT_EQ(map_service->CalculateMapHash(searched_ids),
+              map_service->CalculateMapHash(map_element_ids));
+  }
+}
+
 TEST_F(MapServiceTest, RetrieveMapElements) {
   MapElementIds map_element_ids;
   map_element_ids.add_lane("l1");
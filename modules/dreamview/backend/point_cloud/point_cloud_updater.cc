@@ -23,7 +23,6 @@
 #include "cyber/time/clock.h"
 #include "modules/common/adapters/adapter_gflags.h"
 #include "modules/dreamview/backend/common/dreamview_gflags.h"
-#include "modules/dreamview/proto/point_cloud.pb.h"
 #include "nlohmann/json.hpp"
 #include "pcl/filters/voxel_grid.h"
 #include "yaml-cpp/yaml.h"
@@ -41,7 +40,6 @@ PointCloudUpdater::PointCloudUpdater(WebSocketHandler *websocket,
                                      SimulationWorldUpdater *simworld_updater)
     : node_(cyber::CreateNode("point_cloud")),
       websocket_(websocket),
-      point_cloud_str_(""),
       future_ready_(true),
       simworld_updater_(simworld_updater) {
   RegisterMessageHandlers();
@@ -85,17 +83,20 @@ void PointCloudUpdater::RegisterMessageHandlers() {
   websocket_->RegisterMessageHandler(
       "RequestPointCloud",
       [this](const Json &json, WebSocketHandler::Connection *conn) {
-        std::string to_send;
+        std::shared_ptr<const std::string> to_send;
         // If there is no point_cloud data for more than 2 seconds, reset.
-        if (point_cloud_str_ != "" &&
-            std::fabs(last_localization_time_ - last_point_cloud_time_) > 2.0) {
+        if (std::fabs(last_localization_time_ - last_point_cloud_time_) >
+            2.0) {
           boost::unique_lock<boost::shared_mutex> writer_lock(mutex_);
-          point_cloud_str_ = "";
+          point_cloud_str_.reset();
         }
         {
           boost::shared_lock<boost::shared_mutex> reader_lock(mutex_);
           to_send = point_cloud_str_;
         }
+        if (!to_send) {
+          to_send = std::make_shared<const std::string>();
+        }
         websocket_->SendBinaryData(conn, to_send, true);
       });
   websocket_->RegisterMessageHandler(
@@ -187,11 +188,28 @@ void PointCloudUpdater::UpdatePointCloud(
       async_future_ = std::move(f);
     }
   } else {
-    pcl_ptr = ConvertPCLPointCloud(point_cloud);
-    this->FilterPointCloud(pcl_ptr);
+    CopyPointCloud(*point_cloud);
   }
 }
 
+void PointCloudUpdater::CopyPointCloud(const drivers::PointCloud &point_cloud) {
+  float z_offset;
+  {
+    boost::shared_lock<boost::shared_mutex> reader_lock(mutex_);
+    z_offset = lidar_height_;
+  }
+  apollo::dreamview::PointCloud point_cloud_pb;
+  point_cloud_pb.mutable_num()->Reserve(3 * point_cloud.point_size());
+  for (const auto &pt : point_cloud.point()) {
+    if (!std::isnan(pt.x()) && !std::isnan(pt.y()) && !std::isnan(pt.z())) {
+      point_cloud_pb.add_num(pt.x());
+      point_cloud_pb.add_num(pt.y());
+      point_cloud_pb.add_num(pt.z() + z_offset);
+    }
+  }
+  PublishPointCloud(point_cloud_pb);
+}
+
 void PointCloudUpdater::FilterPointCloud(
     pcl::PointCloud<pcl::PointXYZ>::Ptr pcl_ptr) {
   pcl::PointCloud<pcl::PointXYZ>::Ptr pcl_filtered_ptr(
@@ -219,6 +237,8 @@ void PointCloudUpdater::FilterPointCloud(
     z_offset = lidar_height_;
   }
   apollo::dreamview::PointCloud point_cloud_pb;
+  point_cloud_pb.mutable_num()->Reserve(
+      static_cast<int>(3 * pcl_filtered_ptr->size()));
   for (size_t idx = 0; idx < pcl_filtered_ptr->size(); ++idx) {
     pcl::PointXYZ &pt = pcl_filtered_ptr->points[idx];
     if (!std::isnan(pt.x) && !std::isnan(pt.y) && !std::isnan(pt.z)) {
@@ -227,11 +247,18 @@ void PointCloudUpdater::FilterPointCloud(
       point_cloud_pb.add_num(pt.z + z_offset);
     }
   }
-  {
-    boost::unique_lock<boost::shared_mutex> writer_lock(mutex_);
-    point_cloud_pb.SerializeToString(&point_cloud_str_);
-    future_ready_ = true;
-  }
+  PublishPointCloud(point_cloud_pb);
+  future_ready_ = true;
+}
+
+void PointCloudUpdater::PublishPointCloud(
+    const apollo::dreamview::PointCloud &point_cloud_pb) {
+  // Serialize before taking the lock, so that the clients are not blocked on
+  // it meanwhile.
+  auto point_cloud_str = std::make_shared<std::string>();
+  point_cloud_pb.SerializeToString(point_cloud_str.get());
+  boost::unique_lock<boost::shared_mutex> writer_lock(mutex_);
+  point_cloud_str_ = std::move(point_cloud_str);
 }
 
 void PointCloudUpdater::UpdateLocalizationTime(
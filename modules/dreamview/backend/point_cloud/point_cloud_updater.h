@@ -33,6 +33,7 @@
 #include "modules/common/util/string_util.h"
 #include "modules/dreamview/backend/handlers/websocket_handler.h"
 #include "modules/dreamview/backend/simulation_world/simulation_world_updater.h"
+#include "modules/dreamview/proto/point_cloud.pb.h"
 #include "modules/drivers/proto/pointcloud.pb.h"
 #include "modules/localization/proto/localization.pb.h"
 
@@ -84,6 +85,12 @@ class PointCloudUpdater {
 
   void FilterPointCloud(pcl::PointCloud<pcl::PointXYZ>::Ptr pcl_ptr);
 
+  // Fill the frame to be pushed to frontend straight from the driver points,
+  // when they are not voxel filtered.
+  void CopyPointCloud(const drivers::PointCloud &point_cloud);
+
+  void PublishPointCloud(const apollo::dreamview::PointCloud &point_cloud_pb);
+
   void UpdateLocalizationTime(
       const std::shared_ptr<apollo::localization::LocalizationEstimate>
           &localization);
@@ -98,8 +105,9 @@ class PointCloudUpdater {
 
   bool enabled_ = false;
 
-  // The PointCloud to be pushed to frontend.
-  std::string point_cloud_str_;
+  // The PointCloud to be pushed to frontend. Each update is a new immutable
+  // frame, so that the clients send it without copying it.
+  std::shared_ptr<const std::string> point_cloud_str_;
 
   std::future<void> async_future_;
   std::atomic<bool> future_ready_;
@@ -17,6 +17,7 @@
 #include "modules/dreamview/backend/sim_control/sim_control.h"
 
 #include "cyber/common/file.h"
+#include "cyber/common/global_data.h"
 #include "cyber/time/clock.h"
 #include "modules/common/adapters/adapter_gflags.h"
 #include "modules/common/math/linear_interpolation.h"
@@ -38,6 +39,8 @@ using apollo::common::math::InterpolateUsingLinearApproximation;
 using apollo::common::math::InverseQuaternionRotate;
 using apollo::common::util::FillHeader;
 using apollo::cyber::Clock;
+using apollo::cyber::ClockMode;
+using apollo::cyber::Duration;
 using apollo::localization::LocalizationEstimate;
 using apollo::planning::ADCTrajectory;
 using apollo::prediction::PredictionObstacles;
@@ -257,8 +260,11 @@ void SimControl::Start() {
          next_point_.has_a() ? next_point_.a() : 0.0);
 
     InternalReset();
+    InitTimeFactor();
     sim_control_timer_->Start();
-    sim_prediction_timer_->Start();
+    if (time_factor_ == 0.0) {
+      sim_prediction_timer_->Start();
+    }
     enabled_ = true;
   }
 }
@@ -269,6 +275,11 @@ void SimControl::Stop() {
   if (enabled_) {
     sim_control_timer_->Stop();
     sim_prediction_timer_->Stop();
+    if (owns_mock_clock_) {
+      Clock::SetMode(ClockMode::MODE_CYBER);
+      owns_mock_clock_ = false;
+    }
+    time_factor_ = 0.0;
     enabled_ = false;
   }
 }
@@ -299,18 +310,76 @@ void SimControl::Freeze() {
   prev_point_ = next_point_;
 }
 
-void SimControl::RunOnce() {
-  std::lock_guard<std::mutex> lock(mutex_);
-
-  TrajectoryPoint trajectory_point;
-  Chassis::GearPosition gear_position;
-  if (!PerfectControlModel(&trajectory_point, &gear_position)) {
-    AERROR << "Failed to calculate next point with perfect control model";
+void SimControl::InitTimeFactor() {
+  time_factor_ = 0.0;
+  pending_steps_ = 0.0;
+  steps_since_prediction_ = 0;
+  if (FLAGS_sim_control_time_factor == 1.0 ||
+      !cyber::common::GlobalData::Instance()->IsRealityMode()) {
+    return;
+  }
+  if (FLAGS_sim_control_time_factor <= 0.0) {
+    AERROR << "Ignoring invalid sim_control_time_factor "
+           << FLAGS_sim_control_time_factor;
     return;
   }
+  if (Clock::mode() != ClockMode::MODE_MOCK) {
+    // Continue from the current time, the clock is handed back on Stop().
+    const auto now = Clock::Now();
+    Clock::SetMode(ClockMode::MODE_MOCK);
+    Clock::SetNow(now);
+    owns_mock_clock_ = true;
+  }
+  time_factor_ = FLAGS_sim_control_time_factor;
+  AINFO << "SimControl runs " << time_factor_ << " times as fast as the clock";
+}
 
-  PublishChassis(trajectory_point.v(), gear_position);
-  PublishLocalization(trajectory_point);
+void SimControl::RunOnce() {
+  int num_steps = 1;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (time_factor_ > 0.0) {
+      // A timer tick covers time_factor_ steps of the simulated clock, the
+      // fraction left is carried over to the next tick.
+      pending_steps_ += time_factor_;
+      num_steps = static_cast<int>(pending_steps_);
+      pending_steps_ -= num_steps;
+    }
+  }
+  for (int i = 0; i < num_steps; ++i) {
+    RunStep();
+  }
+}
+
+void SimControl::RunStep() {
+  bool publish_prediction = false;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (time_factor_ > 0.0) {
+      Clock::SetNow(Clock::Now() + Duration(kSimControlIntervalMs / 1000.0));
+      // The prediction timer runs on the wall clock, publish the dummy
+      // prediction on the simulated one instead.
+      if (++steps_since_prediction_ >=
+          kSimPredictionIntervalMs / kSimControlIntervalMs) {
+        steps_since_prediction_ = 0;
+        publish_prediction = true;
+      }
+    }
+
+    TrajectoryPoint trajectory_point;
+    Chassis::GearPosition gear_position;
+    if (!PerfectControlModel(&trajectory_point, &gear_position)) {
+      AERROR << "Failed to calculate next point with perfect control model";
+      return;
+    }
+
+    PublishChassis(trajectory_point.v(), gear_position);
+    PublishLocalization(trajectory_point);
+  }
+  // Outside of the lock, as the prediction reader of this node takes it.
+  if (publish_prediction) {
+    PublishDummyPrediction();
+  }
 }
 
 bool SimControl::PerfectControlModel(TrajectoryPoint* point,
@@ -111,6 +111,12 @@ class SimControl : SimControlInterface {
 
   void InitTimerAndIO();
 
+  // Decide on Start() whether SimControl runs on its own accelerated clock.
+  void InitTimeFactor();
+
+  // Advance the simulated car by one control interval and publish it.
+  void RunStep();
+
   void InitStartPoint(double start_velocity, double start_acceleration);
 
   // Reset the start point, which can be a dummy point on the map, a current
@@ -154,6 +160,15 @@ class SimControl : SimControlInterface {
   static constexpr double kSimControlIntervalMs = 10;
   static constexpr double kSimPredictionIntervalMs = 100;
 
+  // How many times as fast as the timer the mock clock is driven, or 0 when
+  // SimControl follows the clock of the process, see sim_control_time_factor.
+  double time_factor_ = 0.0;
+  // The fraction of a step not run yet at the accelerated rate.
+  double pending_steps_ = 0.0;
+  int steps_since_prediction_ = 0;
+  // Whether the clock was switched to the mock mode by SimControl.
+  bool owns_mock_clock_ = false;
+
   // The latest received planning trajectory.
   std::shared_ptr<apollo::planning::ADCTrajectory> current_trajectory_;
   // The index of the previous and next point with regard to the
@@ -189,6 +204,7 @@ class SimControl : SimControlInterface {
 
   FRIEND_TEST(SimControlTest, Test);
   FRIEND_TEST(SimControlTest, TestDummyPrediction);
+  FRIEND_TEST(SimControlTest, TestTimeFactor);
 };
 
 }  // namespace dreamview
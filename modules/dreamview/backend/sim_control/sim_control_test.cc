@@ -211,5 +211,54 @@ TEST_F(SimControlTest, TestDummyPrediction) {
     EXPECT_DOUBLE_EQ(prediction->header().timestamp_sec(), timestamp);
   }
 }
+
+TEST_F(SimControlTest, TestTimeFactor) {
+  sim_control_->Init(false);
+  sim_control_->enabled_ = true;
+
+  planning::ADCTrajectory adc_trajectory;
+  std::vector<double> xs = {0.0, 1.0, 2.0};
+  std::vector<double> ys = {0.0, 0.0, 0.0};
+  std::vector<double> ss = {0.0, 1.0, 2.0};
+  std::vector<double> vs = {10.0, 10.0, 10.0};
+  std::vector<double> as = {0.0, 0.0, 0.0};
+  std::vector<double> ths = {0.0, 0.0, 0.0};
+  std::vector<double> kappa_s = {0.0, 0.0, 0.0};
+  std::vector<double> ts = {0.0, 0.1, 0.2};
+  SetTrajectory(xs, ys, ss, vs, as, ths, kappa_s, ts, &adc_trajectory);
+  adc_trajectory.mutable_header()->set_timestamp_sec(100.0);
+
+  sim_control_->SetStartPoint(adc_trajectory.trajectory_point(0));
+  sim_control_->OnPlanning(std::make_shared<ADCTrajectory>(adc_trajectory));
+
+  Clock::SetMode(ClockMode::MODE_MOCK);
+  Clock::SetNowInSeconds(100.0);
+  sim_control_->time_factor_ = 2.5;
+
+  // Every tick advances the clock by 2.5 control intervals on average.
+  sim_control_->RunOnce();
+  EXPECT_NEAR(Clock::NowInSeconds(), 100.02, 1e-9);
+  sim_control_->RunOnce();
+  EXPECT_NEAR(Clock::NowInSeconds(), 100.05, 1e-9);
+
+  BlockerManager::Instance()->Observe();
+  auto localization =
+      BlockerManager::Instance()
+          ->GetBlocker<LocalizationEstimate>(FLAGS_localization_topic)
+          ->GetLatestObservedPtr();
+  EXPECT_NEAR(localization->header().timestamp_sec(), 100.05, 1e-9);
+  EXPECT_NEAR(localization->pose().position().x(), 0.5, 1e-6);
+
+  // The dummy prediction follows the simulated clock as well.
+  sim_control_->RunOnce();
+  sim_control_->RunOnce();
+  EXPECT_NEAR(Clock::NowInSeconds(), 100.1, 1e-9);
+  BlockerManager::Instance()->Observe();
+  auto prediction =
+      BlockerManager::Instance()
+          ->GetBlocker<PredictionObstacles>(FLAGS_prediction_topic)
+          ->GetLatestObservedPtr();
+  EXPECT_NEAR(prediction->header().timestamp_sec(), 100.1, 1e-9);
+}
 }  // namespace dreamview
 }  // namespace apollo
@@ -87,12 +87,14 @@ void SimulationWorldUpdater::RegisterMessageHandlers() {
   map_ws_->RegisterMessageHandler(
       "RetrieveRelativeMapData",
       [this](const Json &json, WebSocketHandler::Connection *conn) {
-        std::string to_send;
+        std::shared_ptr<const std::string> to_send;
         {
           boost::shared_lock<boost::shared_mutex> reader_lock(mutex_);
           to_send = relative_map_string_;
         }
-        map_ws_->SendBinaryData(conn, to_send, true);
+        if (to_send) {
+          map_ws_->SendBinaryData(conn, to_send, true);
+        }
       });
 
   websocket_->RegisterMessageHandler(
@@ -174,17 +176,20 @@ void SimulationWorldUpdater::RegisterMessageHandlers() {
         if (planning != json.end() && planning->is_boolean()) {
           enable_pnc_monitor = json["planning"];
         }
-        std::string to_send;
+        std::shared_ptr<const std::string> to_send;
         {
-          // Pay the price to copy the data instead of sending data over the
-          // wire while holding the lock.
+          // Only hold a reference to the frame while holding the lock, the
+          // timer replaces it instead of writing into it.
           boost::shared_lock<boost::shared_mutex> reader_lock(mutex_);
           to_send = enable_pnc_monitor ? simulation_world_with_planning_data_
                                        : simulation_world_;
         }
+        if (!to_send) {
+          return;
+        }
         if (FLAGS_enable_update_size_check && !enable_pnc_monitor &&
-            to_send.size() > FLAGS_max_update_size) {
-          AWARN << "update size is too big:" << to_send.size();
+            to_send->size() > FLAGS_max_update_size) {
+          AWARN << "update size is too big:" << to_send->size();
           return;
         }
         websocket_->SendBinaryData(conn, to_send, true);
@@ -411,15 +416,39 @@ void SimulationWorldUpdater::Start() {
 void SimulationWorldUpdater::OnTimer() {
   sim_world_service_.Update();
 
-  {
+  if (!FLAGS_sim_world_serialize_without_client &&
+      websocket_->NumConnections() == 0 && map_ws_->NumConnections() == 0) {
+    // Nobody is rendering the frames, drop the last ones so that a client
+    // connecting later does not get a stale one.
     boost::unique_lock<boost::shared_mutex> writer_lock(mutex_);
     last_pushed_adc_timestamp_sec_ =
         sim_world_service_.world().auto_driving_car().timestamp_sec();
-    sim_world_service_.GetWireFormatString(
-        FLAGS_sim_map_radius, &simulation_world_,
-        &simulation_world_with_planning_data_);
-    sim_world_service_.GetRelativeMap().SerializeToString(
-        &relative_map_string_);
+    simulation_world_.reset();
+    simulation_world_with_planning_data_.reset();
+    relative_map_string_.reset();
+    return;
+  }
+
+  // Serialize the frames before taking the lock, so that the clients are not
+  // blocked on it meanwhile.
+  const double adc_timestamp_sec =
+      sim_world_service_.world().auto_driving_car().timestamp_sec();
+  auto simulation_world = std::make_shared<std::string>();
+  auto simulation_world_with_planning_data = std::make_shared<std::string>();
+  sim_world_service_.GetWireFormatString(
+      FLAGS_sim_map_radius, simulation_world.get(),
+      simulation_world_with_planning_data.get());
+  auto relative_map_string = std::make_shared<std::string>();
+  sim_world_service_.GetRelativeMap().SerializeToString(
+      relative_map_string.get());
+
+  {
+    boost::unique_lock<boost::shared_mutex> writer_lock(mutex_);
+    last_pushed_adc_timestamp_sec_ = adc_timestamp_sec;
+    simulation_world_ = std::move(simulation_world);
+    simulation_world_with_planning_data_ =
+        std::move(simulation_world_with_planning_data);
+    relative_map_string_ = std::move(relative_map_string);
   }
 }
 
@@ -128,14 +128,15 @@ class SimulationWorldUpdater {
   apollo::routing::POI poi_;
 
   // The simulation_world in wire format to be pushed to frontend, which is
-  // updated by timer.
-  std::string simulation_world_;
-  std::string simulation_world_with_planning_data_;
+  // updated by timer. Each update is a new immutable frame, so that all the
+  // clients send the same one without copying it.
+  std::shared_ptr<const std::string> simulation_world_;
+  std::shared_ptr<const std::string> simulation_world_with_planning_data_;
 
   // Received relative map data in wire format.
-  std::string relative_map_string_;
+  std::shared_ptr<const std::string> relative_map_string_;
 
-  // Mutex to protect concurrent access to simulation_world_json_.
+  // Mutex to protect concurrent access to the frames above.
   // NOTE: Use boost until we have std version of rwlock support.
   boost::shared_mutex mutex_;
 
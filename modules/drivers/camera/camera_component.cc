@@ -16,10 +16,20 @@
 
 #include "modules/drivers/camera/camera_component.h"
 
+#include "google/protobuf/io/coded_stream.h"
+#include "google/protobuf/wire_format_lite.h"
+
+#include "modules/drivers/common/time_sync_gflags.h"
+
 namespace apollo {
 namespace drivers {
 namespace camera {
 
+using google::protobuf::io::CodedOutputStream;
+using google::protobuf::internal::WireFormatLite;
+
+constexpr size_t CameraComponent::kMaxMetadataSize;
+
 bool CameraComponent::Init() {
   camera_config_ = std::make_shared<Config>();
   if (!apollo::cyber::common::GetProtoFromFile(config_file_path_,
@@ -50,33 +60,36 @@ bool CameraComponent::Init() {
     return false;
   }
   raw_image_->is_new = 0;
-  // free memory in this struct desturctor
-  raw_image_->image =
-      reinterpret_cast<char*>(calloc(raw_image_->image_size, sizeof(char)));
-  if (raw_image_->image == nullptr) {
-    AERROR << "system calloc memory error, size:" << raw_image_->image_size;
-    return false;
+  // the frames are decoded straight into the published images
+  raw_image_->image = nullptr;
+
+  loaned_image_.mutable_header()->set_frame_id(camera_config_->frame_id());
+  loaned_image_.set_width(raw_image_->width);
+  loaned_image_.set_height(raw_image_->height);
+  if (camera_config_->output_type() == YUYV) {
+    loaned_image_.set_encoding("yuyv");
+    loaned_image_.set_step(2 * raw_image_->width);
+  } else if (camera_config_->output_type() == RGB) {
+    loaned_image_.set_encoding("rgb8");
+    loaned_image_.set_step(3 * raw_image_->width);
   }
+  data_offset_ =
+      WireFormatLite::TagSize(Image::kDataFieldNumber,
+                              WireFormatLite::TYPE_BYTES) +
+      CodedOutputStream::VarintSize32(
+          static_cast<uint32_t>(raw_image_->image_size));
 
   for (int i = 0; i < buffer_size_; ++i) {
-    auto pb_image = std::make_shared<Image>();
-    pb_image->mutable_header()->set_frame_id(camera_config_->frame_id());
-    pb_image->set_width(raw_image_->width);
-    pb_image->set_height(raw_image_->height);
-    pb_image->mutable_data()->reserve(raw_image_->image_size);
-
-    if (camera_config_->output_type() == YUYV) {
-      pb_image->set_encoding("yuyv");
-      pb_image->set_step(2 * raw_image_->width);
-    } else if (camera_config_->output_type() == RGB) {
-      pb_image->set_encoding("rgb8");
-      pb_image->set_step(3 * raw_image_->width);
-    }
-
+    auto pb_image = std::make_shared<Image>(loaned_image_);
+    pb_image->mutable_data()->resize(raw_image_->image_size);
     pb_image_buffer_.push_back(pb_image);
   }
 
   writer_ = node_->CreateWriter<Image>(camera_config_->channel_name());
+  if (FLAGS_camera_time_sync) {
+    time_sync_writer_ =
+        node_->CreateWriter<ClockSyncStatus>(FLAGS_time_sync_status_channel);
+  }
   async_result_ = cyber::Async(&CameraComponent::run, this);
   return true;
 }
@@ -90,26 +103,84 @@ void CameraComponent::run() {
       continue;
     }
 
-    if (!camera_device_->poll(raw_image_)) {
+    if (index_ >= buffer_size_) {
+      index_ = 0;
+    }
+    auto pb_image = pb_image_buffer_.at(index_);
+
+    // With shared memory readers the frame is decoded into a loaned block,
+    // after the tag of the data field, so that it is not copied again to be
+    // serialized. Otherwise it is decoded into the data of the image.
+    WritableBlock block;
+    const bool loaned = writer_->Loan(
+        data_offset_ + raw_image_->image_size + kMaxMetadataSize, &block);
+    char* image = loaned ? reinterpret_cast<char*>(block.buf) + data_offset_
+                         : &(*pb_image->mutable_data())[0];
+    if (!camera_device_->poll(raw_image_, image)) {
+      if (loaned) {
+        writer_->ReturnLoan(block);
+      }
       AERROR << "camera device poll failed";
       continue;
     }
 
-    cyber::Time image_time(raw_image_->tv_sec, 1000 * raw_image_->tv_usec);
-    if (index_ >= buffer_size_) {
-      index_ = 0;
+    const double measurement_time = SyncMeasurementTime();
+    const double timestamp_sec = cyber::Time::Now().ToSecond();
+    if (loaned) {
+      loaned_image_.mutable_header()->set_timestamp_sec(timestamp_sec);
+      loaned_image_.set_measurement_time(measurement_time);
+      if (!WriteLoaned(block)) {
+        AERROR << "write loaned image failed";
+      }
+    } else {
+      ++index_;
+      pb_image->mutable_header()->set_timestamp_sec(timestamp_sec);
+      pb_image->set_measurement_time(measurement_time);
+      writer_->Write(pb_image);
     }
-    auto pb_image = pb_image_buffer_.at(index_++);
-    pb_image->mutable_header()->set_timestamp_sec(
-        cyber::Time::Now().ToSecond());
-    pb_image->set_measurement_time(image_time.ToSecond());
-    pb_image->set_data(raw_image_->image, raw_image_->image_size);
-    writer_->Write(pb_image);
 
     cyber::SleepFor(std::chrono::microseconds(spin_rate_));
   }
 }
 
+double CameraComponent::SyncMeasurementTime() {
+  cyber::Time image_time(raw_image_->tv_sec, 1000 * raw_image_->tv_usec);
+  if (!FLAGS_camera_time_sync) {
+    return image_time.ToSecond();
+  }
+  clock_sync_.AddSample(image_time.ToSecond(), raw_image_->receive_time);
+  if (raw_image_->receive_time - last_time_sync_status_ >=
+      FLAGS_time_sync_status_interval) {
+    last_time_sync_status_ = raw_image_->receive_time;
+    auto status = std::make_shared<ClockSyncStatus>();
+    status->mutable_header()->set_timestamp_sec(raw_image_->receive_time);
+    status->mutable_header()->set_frame_id(camera_config_->frame_id());
+    clock_sync_.FillStatus(camera_config_->frame_id(), status.get());
+    time_sync_writer_->Write(status);
+  }
+  return clock_sync_.ToHostTime(image_time.ToSecond());
+}
+
+bool CameraComponent::WriteLoaned(const WritableBlock& block) {
+  uint8_t* target = WireFormatLite::WriteTagToArray(
+      Image::kDataFieldNumber, WireFormatLite::WIRETYPE_LENGTH_DELIMITED,
+      block.buf);
+  target = CodedOutputStream::WriteVarint32ToArray(
+      static_cast<uint32_t>(raw_image_->image_size), target);
+  target += raw_image_->image_size;
+
+  // the fields of a message may be serialized in any order
+  const size_t metadata_size = loaned_image_.ByteSizeLong();
+  if (metadata_size > kMaxMetadataSize) {
+    AERROR << "image metadata size " << metadata_size << " is more than "
+           << kMaxMetadataSize << " bytes.";
+    writer_->ReturnLoan(block);
+    return false;
+  }
+  target = loaned_image_.SerializeWithCachedSizesToArray(target);
+  return writer_->WriteLoaned(block, target - block.buf);
+}
+
 CameraComponent::~CameraComponent() {
   if (running_.load()) {
     running_.exchange(false);
@@ -24,8 +24,10 @@
 #include "cyber/cyber.h"
 #include "modules/drivers/camera/proto/config.pb.h"
 #include "modules/drivers/proto/sensor_image.pb.h"
+#include "modules/drivers/proto/time_sync.pb.h"
 
 #include "modules/drivers/camera/usb_cam.h"
+#include "modules/drivers/common/clock_sync.h"
 
 namespace apollo {
 namespace drivers {
@@ -34,6 +36,9 @@ namespace camera {
 using apollo::cyber::Component;
 using apollo::cyber::Reader;
 using apollo::cyber::Writer;
+using apollo::cyber::transport::WritableBlock;
+using apollo::drivers::ClockSync;
+using apollo::drivers::ClockSyncStatus;
 using apollo::drivers::Image;
 using apollo::drivers::camera::config::Config;
 
@@ -44,17 +49,31 @@ class CameraComponent : public Component<> {
 
  private:
   void run();
+  // serialize the fields of loaned_image_ after the image decoded into the
+  // block, and publish it
+  bool WriteLoaned(const WritableBlock& block);
+  // the measurement time of the latest image on the host clock
+  double SyncMeasurementTime();
 
   std::shared_ptr<Writer<Image>> writer_ = nullptr;
   std::unique_ptr<UsbCam> camera_device_;
   std::shared_ptr<Config> camera_config_;
   CameraImagePtr raw_image_ = nullptr;
   std::vector<std::shared_ptr<Image>> pb_image_buffer_;
+  // the fields other than data of the images decoded into a loaned block
+  Image loaned_image_;
+  // the size of the tag and length of the data field before the image
+  size_t data_offset_ = 0;
+  static constexpr size_t kMaxMetadataSize = 1024;
   uint32_t spin_rate_ = 200;
   uint32_t device_wait_ = 2000;
   int index_ = 0;
   int buffer_size_ = 16;
   const int32_t MAX_IMAGE_SIZE = 20 * 1024 * 1024;
+  // the clock of the V4L2 device against the host clock
+  ClockSync clock_sync_;
+  std::shared_ptr<Writer<ClockSyncStatus>> time_sync_writer_ = nullptr;
+  double last_time_sync_status_ = 0.0;
   std::future<void> async_result_;
   std::atomic<bool> running_ = {false};
 };
@@ -42,6 +42,8 @@ bool CompressComponent::Init() {
     return false;
   }
 
+  params_ = {cv::IMWRITE_JPEG_QUALITY, 95};
+
   writer_ = node_->CreateWriter<CompressedImage>(
       config_.compress_conf().output_channel());
   return true;
@@ -55,22 +57,17 @@ bool CompressComponent::Proc(const std::shared_ptr<Image>& image) {
   compressed_image->set_measurement_time(image->measurement_time());
   compressed_image->set_format(image->encoding() + "; jpeg compressed bgr8");
 
-  std::vector<int> params;
-  params.resize(3, 0);
-  params[0] = cv::IMWRITE_JPEG_QUALITY;
-  params[1] = 95;
-
   try {
     cv::Mat mat_image(image->height(), image->width(), CV_8UC3,
                       const_cast<char*>(image->data().data()), image->step());
     cv::Mat tmp_mat;
     cv::cvtColor(mat_image, tmp_mat, cv::COLOR_RGB2BGR);
-    std::vector<uint8_t> compress_buffer;
-    if (!cv::imencode(".jpg", tmp_mat, compress_buffer, params)) {
+    if (!cv::imencode(".jpg", tmp_mat, compress_buffer_, params_)) {
       AERROR << "cv::imencode (jpeg) failed on input image";
       return false;
     }
-    compressed_image->set_data(compress_buffer.data(), compress_buffer.size());
+    compressed_image->set_data(compress_buffer_.data(),
+                               compress_buffer_.size());
     writer_->Write(compressed_image);
   } catch (std::exception& e) {
     AERROR << "cv::imencode (jpeg) exception :" << e.what();
@@ -17,6 +17,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include "cyber/base/concurrent_object_pool.h"
 #include "cyber/cyber.h"
@@ -42,6 +43,9 @@ class CompressComponent : public Component<Image> {
   std::shared_ptr<CCObjectPool<CompressedImage>> image_pool_;
   std::shared_ptr<Writer<CompressedImage>> writer_ = nullptr;
   Config config_;
+  // reused across the images, so that encoding does not allocate
+  std::vector<int> params_;
+  std::vector<uint8_t> compress_buffer_;
 };
 
 CYBER_REGISTER_COMPONENT(CompressComponent)
@@ -34,6 +34,7 @@
  *
  *********************************************************************/
 
+#include <algorithm>
 #include <cmath>
 #include <string>
 
@@ -227,9 +228,11 @@ void UsbCam::mjpeg2rgb(char* mjpeg_buffer, int len, char* rgb_buffer,
 }
 
 bool UsbCam::poll(const CameraImagePtr& raw_image) {
+  return poll(raw_image, raw_image->image);
+}
+
+bool UsbCam::poll(const CameraImagePtr& raw_image, char* image) {
   raw_image->is_new = 0;
-  // free memory in this struct desturctor
-  memset(raw_image->image, 0, raw_image->image_size * sizeof(char));
 
   fd_set fds;
   struct timeval tv;
@@ -258,7 +261,7 @@ bool UsbCam::poll(const CameraImagePtr& raw_image) {
     reconnect();
   }
 
-  int get_new_image = read_frame(raw_image);
+  int get_new_image = read_frame(raw_image, image);
 
   if (!get_new_image) {
     return false;
@@ -768,10 +771,11 @@ bool UsbCam::stop_capturing(void) {
   return true;
 }
 
-bool UsbCam::read_frame(CameraImagePtr raw_image) {
+bool UsbCam::read_frame(CameraImagePtr raw_image, char* image) {
   struct v4l2_buffer buf;
   unsigned int i = 0;
   int len = 0;
+  bool processed = false;
 
   switch (config_->io_method()) {
     case IO_METHOD_READ:
@@ -795,7 +799,8 @@ bool UsbCam::read_frame(CameraImagePtr raw_image) {
         }
       }
 
-      process_image(buffers_[0].start, len, raw_image);
+      raw_image->receive_time = cyber::Time::Now().ToSecond();
+      processed = process_image(buffers_[0].start, len, raw_image, image);
 
       break;
 
@@ -824,6 +829,7 @@ bool UsbCam::read_frame(CameraImagePtr raw_image) {
       }
 
       assert(buf.index < n_buffers_);
+      raw_image->receive_time = cyber::Time::Now().ToSecond();
       len = buf.bytesused;
       raw_image->tv_sec = static_cast<int>(buf.timestamp.tv_sec);
       raw_image->tv_usec = static_cast<int>(buf.timestamp.tv_usec);
@@ -867,7 +873,8 @@ bool UsbCam::read_frame(CameraImagePtr raw_image) {
         AERROR << "Wrong Buffer Len: " << len
                << ", dev: " << config_->camera_dev();
       } else {
-        process_image(buffers_[buf.index].start, len, raw_image);
+        processed =
+            process_image(buffers_[buf.index].start, len, raw_image, image);
       }
 
       if (-1 == xioctl(fd_, VIDIOC_QBUF, &buf)) {
@@ -908,8 +915,10 @@ bool UsbCam::read_frame(CameraImagePtr raw_image) {
       }
 
       assert(i < n_buffers_);
+      raw_image->receive_time = cyber::Time::Now().ToSecond();
       len = buf.bytesused;
-      process_image(reinterpret_cast<void*>(buf.m.userptr), len, raw_image);
+      processed = process_image(reinterpret_cast<void*>(buf.m.userptr), len,
+                                raw_image, image);
 
       if (-1 == xioctl(fd_, VIDIOC_QBUF, &buf)) {
         AERROR << "VIDIOC_QBUF";
@@ -924,35 +933,42 @@ bool UsbCam::read_frame(CameraImagePtr raw_image) {
       break;
   }
 
-  return true;
+  return processed;
 }
 
-bool UsbCam::process_image(void* src, int len, CameraImagePtr dest) {
-  if (src == nullptr || dest == nullptr) {
+bool UsbCam::process_image(void* src, int len, CameraImagePtr dest,
+                           char* image) {
+  if (src == nullptr || dest == nullptr || image == nullptr) {
     AERROR << "process image error. src or dest is null";
     return false;
   }
   if (pixel_format_ == V4L2_PIX_FMT_YUYV ||
       pixel_format_ == V4L2_PIX_FMT_UYVY) {
+    const int yuyv_size = dest->width * dest->height * 2;
     if (pixel_format_ == V4L2_PIX_FMT_UYVY) {
-      unsigned char yuyvbuf[len];
-      unsigned char uyvybuf[len];
-      memcpy(yuyvbuf, src, len);
-      for (int index = 0; index < len; index = index + 2) {
-        uyvybuf[index] = yuyvbuf[index + 1];
-        uyvybuf[index + 1] = yuyvbuf[index];
+      // swap the bytes of each pair in a single pass, straight into the
+      // image when it is the output
+      unsigned char* uyvy = reinterpret_cast<unsigned char*>(src);
+      unsigned char* yuyv = config_->output_type() == YUYV
+                                ? reinterpret_cast<unsigned char*>(image)
+                                : uyvy;
+      const int size = std::min(len, yuyv_size) & ~1;
+      for (int index = 0; index < size; index += 2) {
+        const unsigned char u = uyvy[index];
+        yuyv[index] = uyvy[index + 1];
+        yuyv[index + 1] = u;
       }
-      memcpy(src, uyvybuf, len);
     }
     if (config_->output_type() == YUYV) {
-      memcpy(dest->image, src, dest->width * dest->height * 2);
+      if (pixel_format_ == V4L2_PIX_FMT_YUYV) {
+        memcpy(image, src, yuyv_size);
+      }
     } else if (config_->output_type() == RGB) {
 #ifdef __aarch64__
-      convert_yuv_to_rgb_buffer((unsigned char*)src,
-                                (unsigned char*)dest->image, dest->width,
-                                dest->height);
+      convert_yuv_to_rgb_buffer((unsigned char*)src, (unsigned char*)image,
+                                dest->width, dest->height);
 #else
-      yuyv2rgb_avx((unsigned char*)src, (unsigned char*)dest->image,
+      yuyv2rgb_avx((unsigned char*)src, (unsigned char*)image,
                    dest->width * dest->height);
 #endif
     } else {
@@ -87,6 +87,8 @@ struct CameraImage {
   int is_new;
   int tv_sec;
   int tv_usec;
+  // host time the frame was dequeued at, in seconds
+  double receive_time;
   char* image;
 
   ~CameraImage() {
@@ -112,6 +114,9 @@ class UsbCam {
   virtual bool init(const std::shared_ptr<Config>& camera_config);
   // user use this function to get camera frame data
   virtual bool poll(const CameraImagePtr& raw_image);
+  // get camera frame data into image, which holds raw_image->image_size
+  // bytes, instead of raw_image->image
+  virtual bool poll(const CameraImagePtr& raw_image, char* image);
 
   bool is_capturing();
   bool wait_for_device(void);
@@ -143,8 +148,8 @@ class UsbCam {
   bool set_adv_trigger(void);
   bool close_device(void);
   bool open_device(void);
-  bool read_frame(CameraImagePtr raw_image);
-  bool process_image(void* src, int len, CameraImagePtr dest);
+  bool read_frame(CameraImagePtr raw_image, char* image);
+  bool process_image(void* src, int len, CameraImagePtr dest, char* image);
   bool start_capturing(void);
   bool stop_capturing(void);
   void reconnect();
@@ -30,6 +30,7 @@
 #include "cyber/common/log.h"
 #include "modules/common/proto/error_code.pb.h"
 #include "modules/drivers/canbus/common/byte.h"
+#include "modules/drivers/canbus/common/canbus_consts.h"
 #include "modules/drivers/canbus/proto/can_card_parameter.pb.h"
 
 /**
@@ -143,6 +144,13 @@ class CanClient {
     return Send(frames, &n);
   }
 
+  /**
+   * @brief Get the maximum number of messages the client sends in a single
+   *        Send call.
+   * @return The maximum number of messages to send at once.
+   */
+  virtual int32_t MaxSendFrameNum() const { return MAX_CAN_SEND_FRAME_LEN; }
+
   /**
    * @brief Receive messages
    * @param frames The messages to receive.
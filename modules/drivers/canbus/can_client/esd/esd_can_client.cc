@@ -136,7 +136,13 @@ ErrorCode EsdCanClient::Send(const std::vector<CanFrame> &frames,
     AERROR << "Esd can client has not been initiated! Please init first!";
     return ErrorCode::CAN_CLIENT_ERROR_SEND_FAILED;
   }
-  for (size_t i = 0; i < frames.size() && i < MAX_CAN_SEND_FRAME_LEN; ++i) {
+  if (*frame_num > MAX_CAN_BATCH_SEND_FRAME_LEN) {
+    AERROR << "send can frame num " << *frame_num << " is more than "
+           << MAX_CAN_BATCH_SEND_FRAME_LEN;
+    return ErrorCode::CAN_CLIENT_ERROR_FRAME_NUM;
+  }
+  for (size_t i = 0;
+       i < frames.size() && i < MAX_CAN_BATCH_SEND_FRAME_LEN; ++i) {
     send_frames_[i].id = frames[i].id;
     send_frames_[i].len = frames[i].len;
     std::memcpy(send_frames_[i].data, frames[i].data, frames[i].len);
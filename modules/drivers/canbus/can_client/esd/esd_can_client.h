@@ -80,6 +80,14 @@ class EsdCanClient : public CanClient {
   apollo::common::ErrorCode Send(const std::vector<CanFrame> &frames,
                                  int32_t *const frame_num) override;
 
+  /**
+   * @brief Get the maximum number of messages sent in a single Send call.
+   * @return The maximum number of messages to send at once.
+   */
+  int32_t MaxSendFrameNum() const override {
+    return MAX_CAN_BATCH_SEND_FRAME_LEN;
+  }
+
   /**
    * @brief Receive messages
    * @param frames The messages to receive.
@@ -99,7 +107,7 @@ class EsdCanClient : public CanClient {
  private:
   NTCAN_HANDLE dev_handler_;
   CANCardParameter::CANChannelId port_;
-  CMSG send_frames_[MAX_CAN_SEND_FRAME_LEN];
+  CMSG send_frames_[MAX_CAN_BATCH_SEND_FRAME_LEN];
   CMSG recv_frames_[MAX_CAN_RECV_FRAME_LEN];
 };
 
@@ -78,6 +78,14 @@ class FakeCanClient : public CanClient {
   apollo::common::ErrorCode Send(const std::vector<CanFrame> &frames,
                                  int32_t *const frame_num) override;
 
+  /**
+   * @brief Get the maximum number of messages sent in a single Send call.
+   * @return The maximum number of messages to send at once.
+   */
+  int32_t MaxSendFrameNum() const override {
+    return MAX_CAN_BATCH_SEND_FRAME_LEN;
+  }
+
   /**
    * @brief Receive messages
    * @param frames The messages to receive.
@@ -157,7 +157,8 @@ ErrorCode SocketCanClientRaw::Send(const std::vector<CanFrame> &frames,
     AERROR << "Nvidia can client has not been initiated! Please init first!";
     return ErrorCode::CAN_CLIENT_ERROR_SEND_FAILED;
   }
-  for (size_t i = 0; i < frames.size() && i < MAX_CAN_SEND_FRAME_LEN; ++i) {
+  for (size_t i = 0;
+       i < frames.size() && i < MAX_CAN_BATCH_SEND_FRAME_LEN; ++i) {
     if (frames[i].len > CANBUS_MESSAGE_LENGTH || frames[i].len < 0) {
       AERROR << "frames[" << i << "].len = " << frames[i].len
              << ", which is not equal to can message data length ("
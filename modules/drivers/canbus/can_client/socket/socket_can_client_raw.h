@@ -93,6 +93,14 @@ class SocketCanClientRaw : public CanClient {
   apollo::common::ErrorCode Send(const std::vector<CanFrame> &frames,
                                  int32_t *const frame_num) override;
 
+  /**
+   * @brief Get the maximum number of messages sent in a single Send call.
+   * @return The maximum number of messages to send at once.
+   */
+  int32_t MaxSendFrameNum() const override {
+    return MAX_CAN_BATCH_SEND_FRAME_LEN;
+  }
+
   /**
    * @brief Receive messages
    * @param frames The messages to receive.
@@ -113,7 +121,7 @@ class SocketCanClientRaw : public CanClient {
   int dev_handler_ = 0;
   CANCardParameter::CANChannelId port_;
   CANCardParameter::CANInterface interface_;
-  can_frame send_frames_[MAX_CAN_SEND_FRAME_LEN];
+  can_frame send_frames_[MAX_CAN_BATCH_SEND_FRAME_LEN];
   can_frame recv_frames_[MAX_CAN_RECV_FRAME_LEN];
 };
 
@@ -23,6 +23,7 @@
 
 #include <algorithm>
 #include <array>
+#include <condition_variable>
 #include <memory>
 #include <mutex>
 #include <thread>
@@ -111,6 +112,12 @@ class SenderMessage {
    */
   int32_t curr_period() const;
 
+  /**
+   * @brief Get the period to send messages from protocol data.
+   * @return The period, in microseconds.
+   */
+  int32_t period() const;
+
  private:
   uint32_t message_id_ = 0;
   ProtocolData<SensorType> *protocol_data_ = nullptr;
@@ -149,6 +156,14 @@ class CanSender {
    */
   common::ErrorCode Init(CanClient *can_client, bool enable_log);
 
+  /**
+   * @brief Set whether the messages are sent as soon as they are updated,
+   *        instead of waiting for their next period.
+   * @param send_on_update If it is true, Update wakes the sender thread to
+   *        send all the messages at once. By default, it is false.
+   */
+  void set_send_on_update(bool send_on_update);
+
   /**
    * @brief Add a message with its ID, protocol data.
    * @param message_id The message ID.
@@ -167,7 +182,8 @@ class CanSender {
   apollo::common::ErrorCode Start();
 
   /*
-   * @brief Update the protocol data based the types.
+   * @brief Update the protocol data based the types, and send the messages
+   *        at once if send on update is enabled.
    */
   void Update();
 
@@ -187,15 +203,34 @@ class CanSender {
   FRIEND_TEST(CanSenderTest, OneRunCase);
 
  private:
+  /**
+   * @brief The time a message is next due, ordered as a min-heap.
+   */
+  struct ScheduledMessage {
+    int64_t due_time = 0;
+    size_t index = 0;
+    bool operator<(const ScheduledMessage &other) const {
+      return due_time > other.due_time;
+    }
+  };
+
   void PowerSendThreadFunc();
 
+  void SendFrames(const std::vector<CanFrame> &can_frames);
+
   bool NeedSend(const SenderMessage<SensorType> &msg,
                 const int32_t delta_period);
   bool is_init_ = false;
   bool is_running_ = false;
+  bool send_on_update_ = false;
+  bool update_pending_ = false;
 
   CanClient *can_client_ = nullptr;  // Owned by global canbus.cc
   std::vector<SenderMessage<SensorType>> send_messages_;
+  std::vector<ScheduledMessage> schedule_;
+  std::vector<CanFrame> batch_frames_;
+  std::mutex sender_mutex_;
+  std::condition_variable sender_cv_;
   std::unique_ptr<std::thread> thread_;
   bool enable_log_ = false;
 
@@ -269,6 +304,11 @@ int32_t SenderMessage<SensorType>::curr_period() const {
   return curr_period_;
 }
 
+template <typename SensorType>
+int32_t SenderMessage<SensorType>::period() const {
+  return period_;
+}
+
 template <typename SensorType>
 void CanSender<SensorType>::PowerSendThreadFunc() {
   CHECK_NOTNULL(can_client_);
@@ -277,52 +317,88 @@ void CanSender<SensorType>::PowerSendThreadFunc() {
   pthread_setschedparam(pthread_self(), SCHED_FIFO, &sch);
 
   const int32_t INIT_PERIOD = 5000;  // 5ms
-  int32_t delta_period = INIT_PERIOD;
-  int32_t new_delta_period = INIT_PERIOD;
-
-  int64_t tm_start = 0;
-  int64_t tm_end = 0;
-  int64_t sleep_interval = 0;
+  std::vector<CanFrame> can_frames;
 
   AINFO << "Can client sender thread starts.";
 
-  while (is_running_) {
-    tm_start = cyber::Time::Now().ToNanosecond() / 1e3;
-    new_delta_period = INIT_PERIOD;
-
-    for (auto &message : send_messages_) {
-      bool need_send = NeedSend(message, delta_period);
-      message.UpdateCurrPeriod(delta_period);
-      new_delta_period = std::min(new_delta_period, message.curr_period());
+  std::unique_lock<std::mutex> lock(sender_mutex_);
+  // All the messages are due at start, then each one is rescheduled by its
+  // own period, so that the thread only wakes when a message is due.
+  const int64_t start_time = cyber::Time::Now().ToMicrosecond();
+  schedule_.clear();
+  for (size_t i = 0; i < send_messages_.size(); ++i) {
+    schedule_.push_back({start_time, i});
+  }
+  std::make_heap(schedule_.begin(), schedule_.end());
 
-      if (!need_send) {
-        continue;
-      }
-      std::vector<CanFrame> can_frames;
-      CanFrame can_frame = message.CanFrame();
-      can_frames.push_back(can_frame);
-      if (can_client_->SendSingleFrame(can_frames) != common::ErrorCode::OK) {
-        AERROR << "Send msg failed:" << can_frame.CanFrameString();
+  while (is_running_) {
+    const int64_t now = cyber::Time::Now().ToMicrosecond();
+    if (update_pending_) {
+      update_pending_ = false;
+      for (auto &scheduled : schedule_) {
+        scheduled.due_time = now;
       }
-      if (enable_log()) {
-        ADEBUG << "send_can_frame#" << can_frame.CanFrameString();
+      std::make_heap(schedule_.begin(), schedule_.end());
+    }
+
+    can_frames.clear();
+    while (!schedule_.empty() && schedule_.front().due_time <= now) {
+      std::pop_heap(schedule_.begin(), schedule_.end());
+      ScheduledMessage &scheduled = schedule_.back();
+      auto &message = send_messages_[scheduled.index];
+      can_frames.push_back(message.CanFrame());
+
+      const int32_t period =
+          message.period() > 0 ? message.period() : INIT_PERIOD;
+      scheduled.due_time += period;
+      if (scheduled.due_time <= now) {
+        // Keep the period from now on instead of catching up with a burst.
+        scheduled.due_time = now + period;
       }
+      std::push_heap(schedule_.begin(), schedule_.end());
+    }
+
+    if (!can_frames.empty()) {
+      lock.unlock();
+      SendFrames(can_frames);
+      lock.lock();
+      continue;
     }
-    delta_period = new_delta_period;
-    tm_end = cyber::Time::Now().ToNanosecond() / 1e3;
-    sleep_interval = delta_period - (tm_end - tm_start);
 
-    if (sleep_interval > 0) {
-      std::this_thread::sleep_for(std::chrono::microseconds(sleep_interval));
+    const auto wake = [this] { return !is_running_ || update_pending_; };
+    if (schedule_.empty()) {
+      sender_cv_.wait(lock, wake);
     } else {
-      // do not sleep
-      AWARN << "Too much time for calculation: " << tm_end - tm_start
-            << "us is more than minimum period: " << delta_period << "us";
+      sender_cv_.wait_for(
+          lock, std::chrono::microseconds(schedule_.front().due_time - now),
+          wake);
     }
   }
   AINFO << "Can client sender thread stopped!";
 }
 
+template <typename SensorType>
+void CanSender<SensorType>::SendFrames(
+    const std::vector<CanFrame> &can_frames) {
+  const size_t batch_size =
+      static_cast<size_t>(std::max(can_client_->MaxSendFrameNum(), 1));
+  for (size_t begin = 0; begin < can_frames.size(); begin += batch_size) {
+    const size_t end = std::min(begin + batch_size, can_frames.size());
+    batch_frames_.assign(can_frames.begin() + begin, can_frames.begin() + end);
+    int32_t frame_num = static_cast<int32_t>(batch_frames_.size());
+    if (can_client_->Send(batch_frames_, &frame_num) != common::ErrorCode::OK) {
+      for (const auto &can_frame : batch_frames_) {
+        AERROR << "Send msg failed:" << can_frame.CanFrameString();
+      }
+    }
+    if (enable_log()) {
+      for (const auto &can_frame : batch_frames_) {
+        ADEBUG << "send_can_frame#" << can_frame.CanFrameString();
+      }
+    }
+  }
+}
+
 template <typename SensorType>
 common::ErrorCode CanSender<SensorType>::Init(CanClient *can_client,
                                               bool enable_log) {
@@ -340,6 +416,11 @@ common::ErrorCode CanSender<SensorType>::Init(CanClient *can_client,
   return common::ErrorCode::OK;
 }
 
+template <typename SensorType>
+void CanSender<SensorType>::set_send_on_update(bool send_on_update) {
+  send_on_update_ = send_on_update;
+}
+
 template <typename SensorType>
 void CanSender<SensorType>::AddMessage(uint32_t message_id,
                                        ProtocolData<SensorType> *protocol_data,
@@ -359,7 +440,11 @@ common::ErrorCode CanSender<SensorType>::Start() {
     AERROR << "Cansender has already started.";
     return common::ErrorCode::CANBUS_ERROR;
   }
-  is_running_ = true;
+  {
+    std::lock_guard<std::mutex> lock(sender_mutex_);
+    is_running_ = true;
+    update_pending_ = false;
+  }
   thread_.reset(new std::thread([this] { PowerSendThreadFunc(); }));
 
   return common::ErrorCode::OK;
@@ -370,13 +455,24 @@ void CanSender<SensorType>::Update() {
   for (auto &message : send_messages_) {
     message.Update();
   }
+  if (send_on_update_) {
+    {
+      std::lock_guard<std::mutex> lock(sender_mutex_);
+      update_pending_ = true;
+    }
+    sender_cv_.notify_one();
+  }
 }
 
 template <typename SensorType>
 void CanSender<SensorType>::Stop() {
   if (is_running_) {
     AINFO << "Stopping can sender ...";
-    is_running_ = false;
+    {
+      std::lock_guard<std::mutex> lock(sender_mutex_);
+      is_running_ = false;
+    }
+    sender_cv_.notify_one();
     if (thread_ != nullptr && thread_->joinable()) {
       thread_->join();
     }
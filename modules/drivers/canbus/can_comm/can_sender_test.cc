@@ -39,6 +39,7 @@ TEST(CanSenderTest, OneRunCase) {
   int32_t period = msg.curr_period();
   msg.UpdateCurrPeriod(-50);
   EXPECT_EQ(msg.curr_period(), period + 50);
+  EXPECT_EQ(msg.period(), period);
   EXPECT_EQ(msg.CanFrame().id, 1);
 
   sender.AddMessage(1, &mpd);
@@ -51,6 +52,28 @@ TEST(CanSenderTest, OneRunCase) {
   EXPECT_FALSE(sender.IsRunning());
 }
 
+TEST(CanSenderTest, SendOnUpdate) {
+  CanSender<::apollo::canbus::ChassisDetail> sender;
+  can::FakeCanClient can_client;
+  EXPECT_EQ(can_client.MaxSendFrameNum(), MAX_CAN_BATCH_SEND_FRAME_LEN);
+  sender.Init(&can_client, false);
+  sender.set_send_on_update(true);
+
+  ProtocolData<::apollo::canbus::ChassisDetail> mpd;
+  sender.AddMessage(1, &mpd);
+  sender.AddMessage(2, &mpd);
+  EXPECT_EQ(sender.Start(), common::ErrorCode::OK);
+  sender.Update();
+  sender.Update();
+  sender.Stop();
+  EXPECT_FALSE(sender.IsRunning());
+
+  // the sender can be restarted after it stopped
+  EXPECT_EQ(sender.Start(), common::ErrorCode::OK);
+  EXPECT_TRUE(sender.IsRunning());
+  sender.Stop();
+}
+
 }  // namespace canbus
 }  // namespace drivers
 }  // namespace apollo
@@ -20,6 +20,7 @@
  */
 #pragma once
 
+#include <atomic>
 #include <condition_variable>
 #include <memory>
 #include <mutex>
@@ -85,6 +86,14 @@ class MessageManager {
   virtual void Parse(const uint32_t message_id, const uint8_t *data,
                      int32_t length);
 
+  /**
+   * @brief parse a batch of received frames, then publish the sensor data
+   * they updated to GetSensorData. Called by the receiving thread only.
+   * @param frames the frames, with the id, data and len of a CanFrame
+   */
+  template <typename Frame>
+  void ParseBatch(const std::vector<Frame> &frames);
+
   void ClearSensorData();
 
   std::condition_variable *GetMutableCVar();
@@ -98,8 +107,9 @@ class MessageManager {
       const uint32_t message_id);
 
   /**
-   * @brief get chassis detail. used lock_guard in this function to avoid
-   * concurrent read/write issue.
+   * @brief get chassis detail. It is copied from the snapshot published by
+   * the last ParseBatch without locking if no frame was parsed since, and
+   * under the lock of the sensor data otherwise.
    * @param chassis_detail chassis_detail to be filled.
    */
   common::ErrorCode GetSensorData(SensorType *const sensor_data);
@@ -116,6 +126,12 @@ class MessageManager {
   template <class T, bool need_check>
   void AddSendProtocolData();
 
+  /**
+   * @brief copy the sensor data into a snapshot which GetSensorData reads
+   * without locking. Called by the receiving thread only.
+   */
+  void PublishSensorData();
+
   std::vector<std::unique_ptr<ProtocolData<SensorType>>> send_protocol_data_;
   std::vector<std::unique_ptr<ProtocolData<SensorType>>> recv_protocol_data_;
 
@@ -123,11 +139,37 @@ class MessageManager {
   std::unordered_map<uint32_t, CheckIdArg> check_ids_;
   std::set<uint32_t> received_ids_;
 
+  // protocol_data_map_ and check_ids_ indexed by the standard 11 bit ids, to
+  // look up the received frames without hashing
+  static constexpr uint32_t kDirectIdSize = 0x800;
+  std::vector<ProtocolData<SensorType> *> direct_protocol_data_ =
+      std::vector<ProtocolData<SensorType> *>(kDirectIdSize, nullptr);
+  std::vector<CheckIdArg *> direct_check_ids_ =
+      std::vector<CheckIdArg *>(kDirectIdSize, nullptr);
+
   std::mutex sensor_data_mutex_;
   SensorType sensor_data_;
   bool is_received_on_time_ = false;
 
   std::condition_variable cvar_;
+
+ private:
+  struct Snapshot {
+    SensorType sensor_data;
+    uint64_t version = 0;
+  };
+
+  void SetProtocolData(const uint32_t message_id,
+                       ProtocolData<SensorType> *protocol_data,
+                       bool need_check);
+
+  // bumped when sensor_data_ changes, the snapshot is up to date while it
+  // has the same version
+  std::atomic<uint64_t> sensor_data_version_ = {0};
+  // published with std::atomic_store, read with std::atomic_load
+  std::shared_ptr<Snapshot> snapshot_;
+  // the snapshot published before, reused once no reader holds it
+  std::shared_ptr<Snapshot> spare_snapshot_;
 };
 
 template <typename SensorType>
@@ -138,13 +180,7 @@ void MessageManager<SensorType>::AddRecvProtocolData() {
   if (dt == nullptr) {
     return;
   }
-  protocol_data_map_[T::ID] = dt;
-  if (need_check) {
-    check_ids_[T::ID].period = dt->GetPeriod();
-    check_ids_[T::ID].real_period = 0;
-    check_ids_[T::ID].last_time = 0;
-    check_ids_[T::ID].error_count = 0;
-  }
+  SetProtocolData(T::ID, dt, need_check);
 }
 
 template <typename SensorType>
@@ -155,12 +191,27 @@ void MessageManager<SensorType>::AddSendProtocolData() {
   if (dt == nullptr) {
     return;
   }
-  protocol_data_map_[T::ID] = dt;
+  SetProtocolData(T::ID, dt, need_check);
+}
+
+template <typename SensorType>
+void MessageManager<SensorType>::SetProtocolData(
+    const uint32_t message_id, ProtocolData<SensorType> *protocol_data,
+    bool need_check) {
+  protocol_data_map_[message_id] = protocol_data;
+  if (message_id < kDirectIdSize) {
+    direct_protocol_data_[message_id] = protocol_data;
+  }
   if (need_check) {
-    check_ids_[T::ID].period = dt->GetPeriod();
-    check_ids_[T::ID].real_period = 0;
-    check_ids_[T::ID].last_time = 0;
-    check_ids_[T::ID].error_count = 0;
+    // the elements of an unordered_map are not moved by a rehash
+    CheckIdArg &check_id = check_ids_[message_id];
+    check_id.period = protocol_data->GetPeriod();
+    check_id.real_period = 0;
+    check_id.last_time = 0;
+    check_id.error_count = 0;
+    if (message_id < kDirectIdSize) {
+      direct_check_ids_[message_id] = &check_id;
+    }
   }
 }
 
@@ -168,6 +219,13 @@ template <typename SensorType>
 ProtocolData<SensorType>
     *MessageManager<SensorType>::GetMutableProtocolDataById(
         const uint32_t message_id) {
+  if (message_id < kDirectIdSize) {
+    if (direct_protocol_data_[message_id] == nullptr) {
+      ADEBUG << "Unable to get protocol data because of invalid message_id:"
+             << Byte::byte_to_hex(message_id);
+    }
+    return direct_protocol_data_[message_id];
+  }
   if (protocol_data_map_.find(message_id) == protocol_data_map_.end()) {
     ADEBUG << "Unable to get protocol data because of invalid message_id:"
            << Byte::byte_to_hex(message_id);
@@ -187,29 +245,65 @@ void MessageManager<SensorType>::Parse(const uint32_t message_id,
   {
     std::lock_guard<std::mutex> lock(sensor_data_mutex_);
     protocol_data->Parse(data, length, &sensor_data_);
+    sensor_data_version_.fetch_add(1);
   }
   received_ids_.insert(message_id);
   // check if need to check period
-  const auto it = check_ids_.find(message_id);
-  if (it != check_ids_.end()) {
+  CheckIdArg *check_id = nullptr;
+  if (message_id < kDirectIdSize) {
+    check_id = direct_check_ids_[message_id];
+  } else {
+    const auto it = check_ids_.find(message_id);
+    if (it != check_ids_.end()) {
+      check_id = &it->second;
+    }
+  }
+  if (check_id != nullptr) {
     const int64_t time = Time::Now().ToNanosecond() / 1e3;
-    it->second.real_period = time - it->second.last_time;
+    check_id->real_period = time - check_id->last_time;
     // if period 1.5 large than base period, inc error_count
     const double period_multiplier = 1.5;
-    if (static_cast<double>(it->second.real_period) >
-        (static_cast<double>(it->second.period) * period_multiplier)) {
-      it->second.error_count += 1;
+    if (static_cast<double>(check_id->real_period) >
+        (static_cast<double>(check_id->period) * period_multiplier)) {
+      check_id->error_count += 1;
     } else {
-      it->second.error_count = 0;
+      check_id->error_count = 0;
     }
-    it->second.last_time = time;
+    check_id->last_time = time;
+  }
+}
+
+template <typename SensorType>
+template <typename Frame>
+void MessageManager<SensorType>::ParseBatch(const std::vector<Frame> &frames) {
+  for (const auto &frame : frames) {
+    Parse(frame.id, frame.data, frame.len);
   }
+  // the Parse of a derived manager may not bump the version itself
+  sensor_data_version_.fetch_add(1);
+  PublishSensorData();
+}
+
+template <typename SensorType>
+void MessageManager<SensorType>::PublishSensorData() {
+  std::shared_ptr<Snapshot> snapshot = std::move(spare_snapshot_);
+  if (snapshot == nullptr || snapshot.use_count() > 1) {
+    // a reader still copies the spare snapshot
+    snapshot = std::make_shared<Snapshot>();
+  }
+  {
+    std::lock_guard<std::mutex> lock(sensor_data_mutex_);
+    snapshot->sensor_data.CopyFrom(sensor_data_);
+    snapshot->version = sensor_data_version_.load();
+  }
+  spare_snapshot_ = std::atomic_exchange(&snapshot_, snapshot);
 }
 
 template <typename SensorType>
 void MessageManager<SensorType>::ClearSensorData() {
   std::lock_guard<std::mutex> lock(sensor_data_mutex_);
   sensor_data_.Clear();
+  sensor_data_version_.fetch_add(1);
 }
 
 template <typename SensorType>
@@ -224,6 +318,12 @@ ErrorCode MessageManager<SensorType>::GetSensorData(
     AERROR << "Failed to get sensor_data due to nullptr.";
     return ErrorCode::CANBUS_ERROR;
   }
+  const std::shared_ptr<Snapshot> snapshot = std::atomic_load(&snapshot_);
+  if (snapshot != nullptr &&
+      snapshot->version == sensor_data_version_.load()) {
+    sensor_data->CopyFrom(snapshot->sensor_data);
+    return ErrorCode::OK;
+  }
   std::lock_guard<std::mutex> lock(sensor_data_mutex_);
   sensor_data->CopyFrom(sensor_data_);
   return ErrorCode::OK;
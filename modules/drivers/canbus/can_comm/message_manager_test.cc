@@ -18,6 +18,7 @@
 
 #include <memory>
 #include <set>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -36,12 +37,23 @@ class MockProtocolData : public ProtocolData<::apollo::canbus::ChassisDetail> {
   MockProtocolData() {}
 };
 
+class MockBrakeProtocolData
+    : public ProtocolData<::apollo::canbus::ChassisDetail> {
+ public:
+  static const int32_t ID = 0x222;
+  void Parse(const uint8_t *bytes, int32_t length,
+             ::apollo::canbus::ChassisDetail *chassis_detail) const override {
+    chassis_detail->mutable_brake()->set_brake_input(bytes[0]);
+  }
+};
+
 class MockMessageManager
     : public MessageManager<::apollo::canbus::ChassisDetail> {
  public:
   MockMessageManager() {
     AddRecvProtocolData<MockProtocolData, true>();
     AddSendProtocolData<MockProtocolData, true>();
+    AddRecvProtocolData<MockBrakeProtocolData, false>();
   }
 };
 
@@ -58,6 +70,34 @@ TEST(MessageManagerTest, GetMutableProtocolDataById) {
   EXPECT_EQ(manager.GetSensorData(nullptr), ErrorCode::CANBUS_ERROR);
 }
 
+TEST(MessageManagerTest, ParseBatch) {
+  struct Frame {
+    uint32_t id;
+    uint8_t len;
+    uint8_t data[8];
+  };
+  std::vector<Frame> frames(2);
+  frames[0] = {MockBrakeProtocolData::ID, 8, {1}};
+  frames[1] = {0x7ff, 8, {0}};
+  MockMessageManager manager;
+  manager.ParseBatch(frames);
+
+  ::apollo::canbus::ChassisDetail chassis_detail;
+  EXPECT_EQ(manager.GetSensorData(&chassis_detail), ErrorCode::OK);
+  EXPECT_DOUBLE_EQ(chassis_detail.brake().brake_input(), 1.0);
+
+  // a frame parsed out of a batch is not hidden by the published snapshot
+  uint8_t data[8] = {0};
+  manager.Parse(MockBrakeProtocolData::ID, data, 8);
+  EXPECT_EQ(manager.GetSensorData(&chassis_detail), ErrorCode::OK);
+  EXPECT_DOUBLE_EQ(chassis_detail.brake().brake_input(), 0.0);
+
+  manager.ParseBatch(frames);
+  manager.ClearSensorData();
+  EXPECT_EQ(manager.GetSensorData(&chassis_detail), ErrorCode::OK);
+  EXPECT_FALSE(chassis_detail.has_brake());
+}
+
 }  // namespace canbus
 }  // namespace drivers
 }  // namespace apollo
@@ -0,0 +1,115 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Defines the CanSignal class template.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @namespace apollo::drivers::canbus
+ * @brief apollo::drivers::canbus
+ */
+namespace apollo {
+namespace drivers {
+namespace canbus {
+
+/**
+ * @class CanSignal
+ * @brief The decoder and encoder of one signal of a CAN frame. The bytes the
+ *        signal spans, its masks and shifts are fixed at compile time from
+ *        the DBC definition, so decoding is a few loads, shifts and one mask
+ *        instead of a Byte object per byte. The signedness and byte order
+ *        are template constants, the branches on them are folded away.
+ * @tparam kStartBit The start bit in the DBC, the most significant bit of a
+ *         motorola signal or the least significant bit of an intel signal.
+ * @tparam kLength The number of bits of the signal, at most 32.
+ * @tparam kMotorola If the signal is big endian (motorola) or little endian
+ *         (intel).
+ * @tparam kSigned If the raw value is two's complement.
+ */
+template <int kStartBit, int kLength, bool kMotorola = true,
+          bool kSigned = false>
+class CanSignal {
+  static_assert(kStartBit >= 0 && kStartBit < 64, "start bit out of frame");
+  static_assert(kLength > 0 && kLength <= 32, "signal longer than 32 bits");
+
+ public:
+  /**
+   * @brief Get the raw value of the signal from a frame.
+   * @param bytes The data of the frame.
+   * @return The raw value, sign extended for signed signals.
+   */
+  static int32_t Decode(const uint8_t *bytes) {
+    uint64_t raw = 0;
+    for (int i = kFirstByte; i <= kLastByte; ++i) {
+      raw |= static_cast<uint64_t>(bytes[i]) << ByteShift(i);
+    }
+    const uint64_t value = (raw >> kShift) & kMask;
+    if (kSigned && (value >> (kLength - 1)) != 0) {
+      return static_cast<int32_t>(value | ~kMask);
+    }
+    return static_cast<int32_t>(value);
+  }
+
+  /**
+   * @brief Set the raw value of the signal in a frame, leaving the other
+   *        bits of the frame unchanged.
+   * @param bytes The data of the frame.
+   * @param value The raw value, only its lowest kLength bits are used.
+   */
+  static void Encode(uint8_t *bytes, int32_t value) {
+    const uint64_t raw =
+        (static_cast<uint64_t>(static_cast<uint32_t>(value)) & kMask)
+        << kShift;
+    for (int i = kFirstByte; i <= kLastByte; ++i) {
+      const uint8_t mask = ByteMask(i);
+      bytes[i] = static_cast<uint8_t>((bytes[i] & ~mask) |
+                                      ((raw >> ByteShift(i)) & mask));
+    }
+  }
+
+ private:
+  static constexpr uint64_t kMask = (uint64_t{1} << kLength) - 1;
+  static constexpr int kFirstByte = kStartBit / 8;
+  // the bit at the far end of the signal: for motorola its least significant
+  // bit counted from the most significant bit of byte 0, for intel its most
+  // significant bit counted from bit 0 of byte 0
+  static constexpr int kLastBit =
+      kMotorola ? kFirstByte * 8 + 7 - kStartBit % 8 + kLength - 1
+                : kStartBit + kLength - 1;
+  static constexpr int kLastByte = kLastBit / 8;
+  static constexpr int kShift =
+      kMotorola ? kLastByte * 8 + 7 - kLastBit : kStartBit % 8;
+  static_assert(kLastByte < 8, "signal crosses the end of the frame");
+
+  // shift of byte i in the bytes of the signal read as one integer
+  static constexpr int ByteShift(int i) {
+    return kMotorola ? (kLastByte - i) * 8 : (i - kFirstByte) * 8;
+  }
+
+  static constexpr uint8_t ByteMask(int i) {
+    return static_cast<uint8_t>(((kMask << kShift) >> ByteShift(i)) & 0xFF);
+  }
+};
+
+}  // namespace canbus
+}  // namespace drivers
+}  // namespace apollo
@@ -0,0 +1,142 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/drivers/canbus/common/can_signal.h"
+
+#include <algorithm>
+#include <random>
+
+#include "gtest/gtest.h"
+
+#include "modules/drivers/canbus/common/byte.h"
+
+namespace apollo {
+namespace drivers {
+namespace canbus {
+
+namespace {
+
+// walks the signal bit by bit, as the DBC defines it
+int32_t ReferenceDecode(const uint8_t* bytes, int start_bit, int length,
+                        bool motorola, bool is_signed) {
+  int byte = start_bit / 8;
+  int bit = start_bit % 8;
+  uint32_t value = 0;
+  for (int i = 0; i < length; ++i) {
+    uint32_t b = (bytes[byte] >> bit) & 1;
+    if (motorola) {
+      value = (value << 1) | b;
+      if (--bit < 0) {
+        ++byte;
+        bit = 7;
+      }
+    } else {
+      value |= b << i;
+      if (++bit > 7) {
+        ++byte;
+        bit = 0;
+      }
+    }
+  }
+  if (is_signed && length < 32 && (value >> (length - 1)) != 0) {
+    value |= ~((1u << length) - 1);
+  }
+  return static_cast<int32_t>(value);
+}
+
+template <int kStartBit, int kLength, bool kMotorola, bool kSigned>
+void CheckSignal() {
+  using Signal = CanSignal<kStartBit, kLength, kMotorola, kSigned>;
+  std::mt19937 rng(kStartBit * 64 + kLength);
+  std::uniform_int_distribution<int> byte_dist(0, 255);
+  for (int n = 0; n < 100; ++n) {
+    uint8_t bytes[8];
+    for (auto& byte : bytes) {
+      byte = static_cast<uint8_t>(byte_dist(rng));
+    }
+    const int32_t value = Signal::Decode(bytes);
+    EXPECT_EQ(ReferenceDecode(bytes, kStartBit, kLength, kMotorola, kSigned),
+              value);
+
+    // encoding the decoded value leaves the frame as it is, and a new value
+    // only changes the bits of the signal
+    uint8_t copy[8];
+    std::copy(bytes, bytes + 8, copy);
+    Signal::Encode(copy, value);
+    EXPECT_TRUE(std::equal(bytes, bytes + 8, copy));
+    const uint32_t mask = kLength == 32 ? ~0u : (1u << kLength) - 1;
+    const uint32_t raw = static_cast<uint32_t>(
+        ReferenceDecode(bytes, kStartBit, kLength, kMotorola, false));
+    Signal::Encode(copy, static_cast<int32_t>(raw + 1));
+    EXPECT_EQ((raw + 1) & mask,
+              static_cast<uint32_t>(ReferenceDecode(copy, kStartBit, kLength,
+                                                    kMotorola, false)));
+    Signal::Encode(copy, value);
+    EXPECT_TRUE(std::equal(bytes, bytes + 8, copy));
+  }
+}
+
+}  // namespace
+
+TEST(CanSignalTest, Motorola) {
+  CheckSignal<0, 1, true, false>();
+  CheckSignal<1, 2, true, false>();
+  CheckSignal<7, 8, true, false>();
+  CheckSignal<15, 10, true, false>();
+  CheckSignal<31, 16, true, false>();
+  CheckSignal<7, 12, true, true>();
+  CheckSignal<39, 32, true, true>();
+  CheckSignal<63, 8, true, false>();
+}
+
+TEST(CanSignalTest, Intel) {
+  CheckSignal<0, 1, false, false>();
+  CheckSignal<6, 2, false, false>();
+  CheckSignal<8, 8, false, false>();
+  CheckSignal<12, 10, false, true>();
+  CheckSignal<16, 16, false, true>();
+  CheckSignal<3, 32, false, false>();
+  CheckSignal<56, 8, false, false>();
+}
+
+TEST(CanSignalTest, SameAsByte) {
+  // 12 bits signed motorola signal starting at bit 7, decoded with Byte
+  uint8_t bytes[8] = {0xF3, 0x9A, 0, 0, 0, 0, 0, 0};
+  Byte t0(bytes + 0);
+  int32_t x = t0.get_byte(0, 8);
+  Byte t1(bytes + 1);
+  int32_t t = t1.get_byte(4, 4);
+  x <<= 4;
+  x |= t;
+  x <<= 20;
+  x >>= 20;
+  EXPECT_EQ(x, (CanSignal<7, 12, true, true>::Decode(bytes)));
+
+  // 10 bits motorola signal starting at bit 15, encoded with Byte
+  uint8_t expected[8] = {0};
+  int32_t value = 0x2D7;
+  Byte to_set0(expected + 2);
+  to_set0.set_value(static_cast<uint8_t>(value & 0x3), 6, 2);
+  Byte to_set1(expected + 1);
+  to_set1.set_value(static_cast<uint8_t>((value >> 2) & 0xFF), 0, 8);
+  uint8_t actual[8] = {0};
+  CanSignal<15, 10>::Encode(actual, value);
+  EXPECT_TRUE(std::equal(expected, expected + 8, actual));
+}
+
+}  // namespace canbus
+}  // namespace drivers
+}  // namespace apollo
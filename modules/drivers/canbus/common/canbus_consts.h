@@ -32,6 +32,7 @@ namespace canbus {
 
 const int32_t CAN_FRAME_SIZE = 8;
 const int32_t MAX_CAN_SEND_FRAME_LEN = 1;
+const int32_t MAX_CAN_BATCH_SEND_FRAME_LEN = 10;
 const int32_t MAX_CAN_RECV_FRAME_LEN = 10;
 
 const int32_t CANBUS_MESSAGE_LENGTH = 8;  // according to ISO-11891-1
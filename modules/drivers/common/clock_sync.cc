@@ -0,0 +1,112 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/drivers/common/clock_sync.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace apollo {
+namespace drivers {
+
+ClockSync::ClockSync(const ClockSyncParams& params) : params_(params) {
+  params_.window_size = std::max<size_t>(params_.window_size, 1);
+}
+
+void ClockSync::AddSample(double device_time, double host_time) {
+  if (!std::isfinite(device_time) || !std::isfinite(host_time)) {
+    return;
+  }
+  if (IsSynced() && std::abs(host_time - ToHostTime(device_time)) >
+                        params_.reset_threshold) {
+    Reset();
+    ++num_resets_;
+  }
+  Sample sample;
+  sample.device_time = device_time;
+  sample.delay = host_time - device_time;
+  samples_.push_back(sample);
+  while (samples_.size() > params_.window_size) {
+    samples_.pop_front();
+  }
+  Fit();
+}
+
+void ClockSync::Reset() {
+  samples_.clear();
+  offset_ = 0.0;
+  drift_ = 0.0;
+  jitter_ = 0.0;
+}
+
+double ClockSync::ToHostTime(double device_time) const {
+  if (!IsSynced()) {
+    return device_time;
+  }
+  return device_time + offset_ +
+         drift_ * (device_time - samples_.back().device_time);
+}
+
+void ClockSync::FillStatus(const std::string& sensor,
+                           ClockSyncStatus* status) const {
+  status->set_sensor(sensor);
+  status->set_synced(IsSynced());
+  status->set_offset(offset_);
+  status->set_drift_ppm(drift_ * 1e6);
+  status->set_jitter(jitter_);
+  status->set_num_samples(static_cast<uint32_t>(samples_.size()));
+  status->set_num_resets(num_resets_);
+}
+
+void ClockSync::Fit() {
+  // The device times are taken from the latest sample, so that the fit stays
+  // accurate however large they are.
+  const double reference = samples_.back().device_time;
+  const double n = static_cast<double>(samples_.size());
+  double mean_x = 0.0;
+  double mean_y = 0.0;
+  for (const Sample& sample : samples_) {
+    mean_x += sample.device_time - reference;
+    mean_y += sample.delay;
+  }
+  mean_x /= n;
+  mean_y /= n;
+
+  double sxx = 0.0;
+  double sxy = 0.0;
+  for (const Sample& sample : samples_) {
+    const double dx = sample.device_time - reference - mean_x;
+    sxx += dx * dx;
+    sxy += dx * (sample.delay - mean_y);
+  }
+  const double span = reference - samples_.front().device_time;
+  drift_ = span >= params_.min_drift_span && sxx > 0.0 ? sxy / sxx : 0.0;
+
+  // The least delayed sample bounds the offset, the others are late by their
+  // transport latency.
+  double variance = 0.0;
+  offset_ = samples_.back().delay;
+  for (const Sample& sample : samples_) {
+    const double x = sample.device_time - reference;
+    const double residual = sample.delay - mean_y - drift_ * (x - mean_x);
+    variance += residual * residual;
+    offset_ = std::min(offset_, sample.delay - drift_ * x);
+  }
+  jitter_ = std::sqrt(variance / n);
+}
+
+}  // namespace drivers
+}  // namespace apollo
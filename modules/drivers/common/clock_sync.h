@@ -0,0 +1,111 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+
+#include "modules/drivers/proto/time_sync.pb.h"
+
+namespace apollo {
+namespace drivers {
+
+/**@brief The window and thresholds of ClockSync. */
+struct ClockSyncParams {
+  /**@brief The number of latest samples the clocks are fitted on. */
+  size_t window_size = 200;
+  /**@brief The number of samples before the device times are corrected. */
+  size_t min_samples = 10;
+  /**@brief A delay this far from the fit, in seconds, means that the device
+   * clock jumped, the samples before it are dropped. */
+  double reset_threshold = 1.0;
+  /**@brief The span of device time, in seconds, the drift is fitted over at
+   * least, the jitter of shorter spans hides it. */
+  double min_drift_span = 10.0;
+};
+
+/**
+ * @class ClockSync
+ * @brief Track the clock of a sensor against the host clock, which PTP or
+ *        PPS keeps on the reference time, from the device timestamps of its
+ *        messages and the host times they are received at.
+ *
+ * The delays between the two are fitted by a line over a window of samples,
+ * whose slope is the drift of the device clock. The line is then lowered to
+ * the least delayed sample, so that the transport latency of the others does
+ * not bias the offset.
+ */
+class ClockSync {
+ public:
+  explicit ClockSync(const ClockSyncParams& params = ClockSyncParams());
+
+  /**
+   * @brief Add a sample of the clocks.
+   * @param device_time The timestamp of a message by the sensor, in seconds.
+   * @param host_time The host time the message was received at, in seconds.
+   */
+  void AddSample(double device_time, double host_time);
+
+  /**@brief Drop the samples, to sync again from scratch. */
+  void Reset();
+
+  /**@brief Whether there are enough samples to correct device times. */
+  bool IsSynced() const { return samples_.size() >= params_.min_samples; }
+
+  /**
+   * @brief Convert a device timestamp to the host clock.
+   * @return The host time of the timestamp, or the timestamp as it is until
+   *         the clocks are synced.
+   */
+  double ToHostTime(double device_time) const;
+
+  /**@brief The host time minus the device time at the latest sample. */
+  double offset() const { return offset_; }
+
+  /**@brief The drift of the device clock against the host clock. */
+  double drift() const { return drift_; }
+
+  /**@brief The standard deviation of the delays around the fit. */
+  double jitter() const { return jitter_; }
+
+  size_t num_samples() const { return samples_.size(); }
+  uint32_t num_resets() const { return num_resets_; }
+
+  /**@brief Fill the statistics of the clocks, but the header. */
+  void FillStatus(const std::string& sensor, ClockSyncStatus* status) const;
+
+ private:
+  struct Sample {
+    double device_time = 0.0;
+    double delay = 0.0;
+  };
+
+  void Fit();
+
+  ClockSyncParams params_;
+  std::deque<Sample> samples_;
+  uint32_t num_resets_ = 0;
+
+  double offset_ = 0.0;
+  double drift_ = 0.0;
+  double jitter_ = 0.0;
+};
+
+}  // namespace drivers
+}  // namespace apollo
@@ -0,0 +1,75 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/drivers/common/clock_sync.h"
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace drivers {
+
+TEST(ClockSyncTest, OffsetAndDrift) {
+  ClockSync clock_sync;
+  EXPECT_FALSE(clock_sync.IsSynced());
+  EXPECT_DOUBLE_EQ(clock_sync.ToHostTime(5.0), 5.0);
+
+  // A device clock 100 s behind the host, running 50 ppm slow, with messages
+  // received 1 to 4 ms after they are stamped.
+  const double offset = 100.0;
+  const double drift = 50e-6;
+  for (int i = 0; i < 100; ++i) {
+    const double device_time = 1000.0 + 0.2 * i;
+    const double host_time = device_time + offset +
+                             drift * (device_time - 1000.0) + 0.001 +
+                             0.001 * (i % 4);
+    clock_sync.AddSample(device_time, host_time);
+  }
+  EXPECT_TRUE(clock_sync.IsSynced());
+  EXPECT_NEAR(clock_sync.drift(), drift, 1e-5);
+  EXPECT_GT(clock_sync.jitter(), 0.0);
+
+  // The correction follows the least delayed messages.
+  const double device_time = 1020.0;
+  EXPECT_NEAR(clock_sync.ToHostTime(device_time),
+              device_time + offset + 20.0 * drift + 0.001, 1e-4);
+
+  ClockSyncStatus status;
+  clock_sync.FillStatus("camera", &status);
+  EXPECT_EQ(status.sensor(), "camera");
+  EXPECT_TRUE(status.synced());
+  EXPECT_EQ(status.num_samples(), 100);
+  EXPECT_EQ(status.num_resets(), 0);
+}
+
+TEST(ClockSyncTest, ResetOnJump) {
+  ClockSyncParams params;
+  params.window_size = 20;
+  ClockSync clock_sync(params);
+  for (int i = 0; i < 30; ++i) {
+    clock_sync.AddSample(10.0 + 0.1 * i, 20.0 + 0.1 * i);
+  }
+  EXPECT_EQ(clock_sync.num_samples(), 20);
+  EXPECT_NEAR(clock_sync.offset(), 10.0, 1e-9);
+
+  // The device clock restarts from zero.
+  clock_sync.AddSample(0.0, 23.0);
+  EXPECT_EQ(clock_sync.num_resets(), 1);
+  EXPECT_EQ(clock_sync.num_samples(), 1);
+  EXPECT_FALSE(clock_sync.IsSynced());
+}
+
+}  // namespace drivers
+}  // namespace apollo
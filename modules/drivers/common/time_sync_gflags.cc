@@ -0,0 +1,30 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/drivers/common/time_sync_gflags.h"
+
+// statistics of the sensor clocks
+DEFINE_string(time_sync_status_channel, "/apollo/sensor/time_sync",
+              "Channel of the statistics of the sensor clocks against the "
+              "host clock.");
+DEFINE_double(time_sync_status_interval, 1.0,
+              "Interval in seconds between the statistics of a sensor "
+              "clock.");
+
+// sensors whose timestamps are corrected to the host clock
+DEFINE_bool(camera_time_sync, false,
+            "Correct the measurement time of the camera images from the "
+            "clock of the V4L2 device to the host clock.");
@@ -0,0 +1,76 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/drivers/common/udp_batch_receiver.h"
+
+#include <cerrno>
+#include <cstring>
+
+namespace apollo {
+namespace drivers {
+
+bool UdpBatchReceiver::Init(int sockfd) {
+  sockfd_ = sockfd;
+  memset(messages_, 0, sizeof(messages_));
+  const int enable = 1;
+  return setsockopt(sockfd_, SOL_SOCKET, SO_TIMESTAMPNS, &enable,
+                    sizeof(enable)) == 0;
+}
+
+int UdpBatchReceiver::Receive(uint8_t* const* buffers, size_t buffer_size,
+                              int num_buffers) {
+  if (num_buffers > kMaxBatchSize) {
+    num_buffers = kMaxBatchSize;
+  }
+  for (int i = 0; i < num_buffers; ++i) {
+    iovecs_[i].iov_base = buffers[i];
+    iovecs_[i].iov_len = buffer_size;
+    msghdr& header = messages_[i].msg_hdr;
+    header.msg_name = nullptr;
+    header.msg_namelen = 0;
+    header.msg_iov = &iovecs_[i];
+    header.msg_iovlen = 1;
+    header.msg_control = controls_[i];
+    header.msg_controllen = sizeof(controls_[i]);
+    header.msg_flags = 0;
+    messages_[i].msg_len = 0;
+  }
+  const int num_received =
+      recvmmsg(sockfd_, messages_, num_buffers, MSG_DONTWAIT, nullptr);
+  if (num_received < 0) {
+    return errno == EAGAIN || errno == EWOULDBLOCK ? 0 : -1;
+  }
+  return num_received;
+}
+
+uint64_t UdpBatchReceiver::GetStamp(int index) const {
+  // CMSG_NXTHDR takes a non-const header in older glibc.
+  msghdr* header = const_cast<msghdr*>(&messages_[index].msg_hdr);
+  for (cmsghdr* control = CMSG_FIRSTHDR(header); control != nullptr;
+       control = CMSG_NXTHDR(header, control)) {
+    if (control->cmsg_level == SOL_SOCKET &&
+        control->cmsg_type == SCM_TIMESTAMPNS) {
+      struct timespec stamp;
+      memcpy(&stamp, CMSG_DATA(control), sizeof(stamp));
+      return static_cast<uint64_t>(stamp.tv_sec) * 1000000000ULL +
+             static_cast<uint64_t>(stamp.tv_nsec);
+    }
+  }
+  return 0;
+}
+
+}  // namespace drivers
+}  // namespace apollo
@@ -0,0 +1,74 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+
+namespace apollo {
+namespace drivers {
+
+/**
+ * @class UdpBatchReceiver
+ * @brief Receive the datagrams waiting on a UDP socket with a single
+ *        recvmmsg() call, into buffers owned by the caller, along with the
+ *        time the kernel received each of them.
+ */
+class UdpBatchReceiver {
+ public:
+  static constexpr int kMaxBatchSize = 64;
+
+  UdpBatchReceiver() = default;
+
+  /**
+   * @brief Attach to a socket and ask the kernel to stamp its datagrams.
+   * @return false if the kernel does not stamp them, the datagrams are still
+   *         received.
+   */
+  bool Init(int sockfd);
+
+  /**
+   * @brief Receive the waiting datagrams without blocking.
+   * @param buffers The buffers to receive the datagrams into, longer datagrams
+   *        are truncated to the buffer size.
+   * @param num_buffers The number of buffers, at most kMaxBatchSize.
+   * @return The number of datagrams received, 0 if none is waiting, or -1 on
+   *         error with errno set.
+   */
+  int Receive(uint8_t* const* buffers, size_t buffer_size, int num_buffers);
+
+  /**@brief The received size of a datagram of the last batch. */
+  size_t GetSize(int index) const { return messages_[index].msg_len; }
+
+  /**@brief The kernel receive time of a datagram of the last batch, in
+   * nanoseconds, or 0 if the kernel did not stamp it. */
+  uint64_t GetStamp(int index) const;
+
+ private:
+  int sockfd_ = -1;
+  mmsghdr messages_[kMaxBatchSize];
+  iovec iovecs_[kMaxBatchSize];
+  alignas(cmsghdr) char controls_[kMaxBatchSize]
+                                 [CMSG_SPACE(sizeof(struct timespec))];
+};
+
+}  // namespace drivers
+}  // namespace apollo
@@ -0,0 +1,82 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/drivers/common/udp_batch_receiver.h"
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cstring>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace drivers {
+
+TEST(UdpBatchReceiverTest, ReceiveBatch) {
+  const int receiver_fd = socket(AF_INET, SOCK_DGRAM, 0);
+  const int sender_fd = socket(AF_INET, SOCK_DGRAM, 0);
+  ASSERT_GE(receiver_fd, 0);
+  ASSERT_GE(sender_fd, 0);
+  sockaddr_in address;
+  memset(&address, 0, sizeof(address));
+  address.sin_family = AF_INET;
+  address.sin_port = 0;
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  ASSERT_EQ(bind(receiver_fd, reinterpret_cast<sockaddr*>(&address),
+                 sizeof(address)),
+            0);
+  socklen_t address_size = sizeof(address);
+  ASSERT_EQ(getsockname(receiver_fd, reinterpret_cast<sockaddr*>(&address),
+                        &address_size),
+            0);
+
+  UdpBatchReceiver receiver;
+  EXPECT_TRUE(receiver.Init(receiver_fd));
+  uint8_t data[4][16];
+  uint8_t* buffers[4] = {data[0], data[1], data[2], data[3]};
+  EXPECT_EQ(receiver.Receive(buffers, sizeof(data[0]), 4), 0);
+
+  const uint8_t payloads[3][20] = {{1, 2, 3}, {4, 5}, {6}};
+  const size_t sizes[3] = {3, 2, 20};
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_EQ(sendto(sender_fd, payloads[i], sizes[i], 0,
+                     reinterpret_cast<sockaddr*>(&address), sizeof(address)),
+              static_cast<ssize_t>(sizes[i]));
+  }
+  usleep(10000);
+
+  ASSERT_EQ(receiver.Receive(buffers, sizeof(data[0]), 2), 2);
+  EXPECT_EQ(receiver.GetSize(0), 3);
+  EXPECT_EQ(receiver.GetSize(1), 2);
+  EXPECT_EQ(memcmp(data[0], payloads[0], 3), 0);
+  EXPECT_EQ(data[1][1], 5);
+  EXPECT_GT(receiver.GetStamp(0), 0);
+  EXPECT_LE(receiver.GetStamp(0), receiver.GetStamp(1));
+
+  // The longer datagram is truncated to the buffer size.
+  ASSERT_EQ(receiver.Receive(buffers, sizeof(data[0]), 4), 1);
+  EXPECT_EQ(receiver.GetSize(0), sizeof(data[0]));
+  EXPECT_EQ(data[0][0], 6);
+  EXPECT_EQ(receiver.Receive(buffers, sizeof(data[0]), 4), 0);
+
+  close(sender_fd);
+  close(receiver_fd);
+}
+
+}  // namespace drivers
+}  // namespace apollo
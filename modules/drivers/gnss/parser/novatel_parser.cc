@@ -18,7 +18,10 @@
 // messages must be
 // logged in order for this parser to work properly.
 //
+#include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstring>
 #include <iostream>
 #include <limits>
 #include <memory>
@@ -76,11 +79,23 @@ inline uint32_t crc32_word(uint32_t word) {
   return word;
 }
 
+std::array<uint32_t, 256> make_crc32_table() {
+  std::array<uint32_t, 256> table;
+  for (uint32_t i = 0; i < table.size(); ++i) {
+    table[i] = crc32_word(i);
+  }
+  return table;
+}
+
+// crc32_word of all the bytes, so that a block is checked with a lookup per
+// byte.
+const std::array<uint32_t, 256> CRC32_TABLE = make_crc32_table();
+
 inline uint32_t crc32_block(const uint8_t* buffer, size_t length) {
   uint32_t word = 0;
   while (length--) {
     uint32_t t1 = (word >> 8) & 0xFFFFFF;
-    uint32_t t2 = crc32_word((word ^ *buffer++) & 0xFF);
+    uint32_t t2 = CRC32_TABLE[(word ^ *buffer++) & 0xFF];
     word = t1 ^ t2;
   }
   return word;
@@ -113,6 +128,9 @@ class NovatelParser : public Parser {
  private:
   bool check_crc();
 
+  // Appends the available data to the buffer, up to length bytes in total.
+  void AppendData(size_t length);
+
   Parser::MessageType PrepareMessage(MessagePtr* message_ptr);
 
   // The handle_xxx functions return whether a message is ready.
@@ -229,10 +247,14 @@ Parser::MessageType NovatelParser::GetMessage(MessagePtr* message_ptr) {
 
   while (data_ < data_end_) {
     if (buffer_.empty()) {  // Looking for SYNC0
-      if (*data_ == novatel::SYNC_0) {
-        buffer_.push_back(*data_);
+      // memchr compares a word at a time instead of a byte.
+      const void* sync = std::memchr(data_, novatel::SYNC_0, data_end_ - data_);
+      if (sync == nullptr) {
+        data_ = data_end_;
+        break;
       }
-      ++data_;
+      data_ = static_cast<const uint8_t*>(sync);
+      buffer_.push_back(*data_++);
     } else if (buffer_.size() == 1) {  // Looking for SYNC1
       if (*data_ == novatel::SYNC_1) {
         buffer_.push_back(*data_++);
@@ -253,9 +275,8 @@ Parser::MessageType NovatelParser::GetMessage(MessagePtr* message_ptr) {
           buffer_.clear();
       }
     } else if (header_length_ > 0) {  // Working on header.
-      if (buffer_.size() < header_length_) {
-        buffer_.push_back(*data_++);
-      } else {
+      AppendData(header_length_);
+      if (buffer_.size() == header_length_) {
         if (header_length_ == sizeof(novatel::LongHeader)) {
           total_length_ = header_length_ + novatel::CRC_LENGTH +
                           reinterpret_cast<novatel::LongHeader*>(buffer_.data())
@@ -271,9 +292,12 @@ Parser::MessageType NovatelParser::GetMessage(MessagePtr* message_ptr) {
         }
         header_length_ = 0;
       }
-    } else if (total_length_ > 0) {
-      if (buffer_.size() < total_length_) {  // Working on body.
-        buffer_.push_back(*data_++);
+    }
+    // The message is prepared as soon as its last byte is received, not with
+    // the next data.
+    if (header_length_ == 0 && total_length_ > 0) {
+      AppendData(total_length_);  // Working on body.
+      if (buffer_.size() < total_length_) {
         continue;
       }
       MessageType type = PrepareMessage(message_ptr);
@@ -287,6 +311,16 @@ Parser::MessageType NovatelParser::GetMessage(MessagePtr* message_ptr) {
   return MessageType::NONE;
 }
 
+void NovatelParser::AppendData(size_t length) {
+  if (buffer_.size() >= length) {
+    return;
+  }
+  const size_t size =
+      std::min(length - buffer_.size(), static_cast<size_t>(data_end_ - data_));
+  buffer_.insert(buffer_.end(), data_, data_ + size);
+  data_ += size;
+}
+
 bool NovatelParser::check_crc() {
   size_t l = buffer_.size() - novatel::CRC_LENGTH;
   return crc32_block(buffer_.data(), l) ==
@@ -75,6 +75,8 @@ const int GPS_PACKET_SECOND_SIZE = 2;
 const int GPS_ITEM_NUM = 7;
 
 const double PI = 3.14159265358979323846;
+// azimuths are in hundredths of degree
+const int AZIMUTH_UNITS = 36000;
 
 static const double pandar40p_elev_angle_map[] = {
     6.96,   5.976,  4.988,   3.996,   2.999,   2.001,  1.667,   1.333,
@@ -71,8 +71,10 @@ void HesaiDriver::PollThread() {
   AINFO << "Poll thread start";
   while (running_) {
     auto start = std::chrono::steady_clock::now();
-    std::shared_ptr<HesaiPacket>& pkt = pkt_buffer_[pkt_index_];
-    if (input_->GetPacket(pkt.get()) == -1) {
+    // Receive a batch into the next packets of the buffer, up to its end.
+    int num_packets = input_->GetPackets(&pkt_buffer_[pkt_index_],
+                                         pkt_buffer_capacity_ - pkt_index_);
+    if (num_packets <= 0) {
       continue;
     }
     auto end = std::chrono::steady_clock::now();
@@ -84,10 +86,12 @@ void HesaiDriver::PollThread() {
     }
     {
       std::lock_guard<std::mutex> lck(packet_mutex_);
-      pkt_queue_.push_back(pkt);
+      for (int i = 0; i < num_packets; ++i) {
+        pkt_queue_.push_back(pkt_buffer_[pkt_index_ + i]);
+      }
       packet_condition_.notify_all();
     }
-    pkt_index_ = (pkt_index_ + 1) % pkt_buffer_capacity_;
+    pkt_index_ = (pkt_index_ + num_packets) % pkt_buffer_capacity_;
   }
 }
 
@@ -85,6 +85,7 @@ Hesai40Parser::Hesai40Parser(const std::shared_ptr<Node> &node,
     horizatal_azimuth_offset_map_[i] =
         pandar40p_horizatal_azimuth_offset_map[i];
   }
+  InitTrigTables();
 }
 
 Hesai40Parser::~Hesai40Parser() {}
@@ -182,6 +183,16 @@ void Hesai40Parser::CalcPointXYZIT(Hesai40Packet *pkt, int blockid) {
   double timestamp = unix_second + (static_cast<double>(pkt->usec)) / 1000000.0;
   CheckPktTime(timestamp);
 
+  // compute the coordinates of the whole block at once
+  double distances[LASER_COUNT];
+  float xs[LASER_COUNT];
+  float ys[LASER_COUNT];
+  float zs[LASER_COUNT];
+  for (int i = 0; i < LASER_COUNT; ++i) {
+    distances[i] = block->units[i].distance;
+  }
+  ComputeBlockXYZ(block->azimuth, distances, LASER_COUNT, xs, ys, zs);
+
   for (int i = 0; i < LASER_COUNT; ++i) {
     /* for all the units in a block */
     Hesai40PUnit &unit = block->units[i];
@@ -189,23 +200,10 @@ void Hesai40Parser::CalcPointXYZIT(Hesai40Packet *pkt, int blockid) {
     if (unit.distance <= 0.5 || unit.distance > 200.0) {
       continue;
     }
-    double xyDistance =
-        unit.distance * cosf(degreeToRadian(elev_angle_map_[i]));
-    float x = static_cast<float>(
-        xyDistance *
-        sinf(degreeToRadian(horizatal_azimuth_offset_map_[i] +
-                            (static_cast<double>(block->azimuth)) / 100.0)));
-    float y = static_cast<float>(
-        xyDistance *
-        cosf(degreeToRadian(horizatal_azimuth_offset_map_[i] +
-                            (static_cast<double>(block->azimuth)) / 100.0)));
-    float z = static_cast<float>(unit.distance *
-                                 sinf(degreeToRadian(elev_angle_map_[i])));
-
     PointXYZIT *new_point = raw_pointcloud_out_->add_point();
-    new_point->set_x(-y);
-    new_point->set_y(x);
-    new_point->set_z(z);
+    new_point->set_x(xs[i]);
+    new_point->set_y(ys[i]);
+    new_point->set_z(zs[i]);
     new_point->set_intensity(unit.intensity);
 
     if (pkt->echo == 0x39) {
@@ -14,6 +14,8 @@
  * limitations under the License.
  *****************************************************************************/
 
+#include <algorithm>
+
 #include "modules/drivers/hesai/hesai64_parser.h"
 
 namespace apollo {
@@ -104,6 +106,7 @@ Hesai64Parser::Hesai64Parser(const std::shared_ptr<Node> &node,
     horizatal_azimuth_offset_map_[j] =
         pandarGeneral_horizatal_azimuth_offset_map[j];
   }
+  InitTrigTables();
 
   min_packets_ = HESAI64_MIN_PACKETS;
   max_packets_ = HESAI64_MAX_PACKETS;
@@ -216,7 +219,19 @@ void Hesai64Parser::CalcPointXYZIT(Hesai64Packet *pkt, int blockid,
 
   CheckPktTime(timestamp);
 
-  for (int i = 0; i < chLaserNumber; i++) {
+  // compute the coordinates of the whole block at once
+  const int num_lasers =
+      std::min(static_cast<int>(chLaserNumber), LASER_COUNT_L64);
+  double distances[LASER_COUNT_L64];
+  float xs[LASER_COUNT_L64];
+  float ys[LASER_COUNT_L64];
+  float zs[LASER_COUNT_L64];
+  for (int i = 0; i < num_lasers; ++i) {
+    distances[i] = block->units[i].distance;
+  }
+  ComputeBlockXYZ(block->azimuth, distances, num_lasers, xs, ys, zs);
+
+  for (int i = 0; i < num_lasers; i++) {
     /* for all the units in a block */
     Hesai64Unit &unit = block->units[i];
 
@@ -225,23 +240,10 @@ void Hesai64Parser::CalcPointXYZIT(Hesai64Packet *pkt, int blockid,
       continue;
     }
 
-    double xyDistance =
-        unit.distance * cosf(degreeToRadian(elev_angle_map_[i]));
-    float x = static_cast<float>(
-        xyDistance *
-        sinf(degreeToRadian(horizatal_azimuth_offset_map_[i] +
-                            (static_cast<double>(block->azimuth)) / 100.0)));
-    float y = static_cast<float>(
-        xyDistance *
-        cosf(degreeToRadian(horizatal_azimuth_offset_map_[i] +
-                            (static_cast<double>(block->azimuth)) / 100.0)));
-    float z = static_cast<float>(unit.distance *
-                                 sinf(degreeToRadian(elev_angle_map_[i])));
-
     PointXYZIT *new_point = raw_pointcloud_out_->add_point();
-    new_point->set_x(-y);
-    new_point->set_y(x);
-    new_point->set_z(z);
+    new_point->set_x(xs[i]);
+    new_point->set_y(ys[i]);
+    new_point->set_z(zs[i]);
     new_point->set_intensity(unit.reflectivity);
 
     if (pkt->echo == 0x39) {
@@ -31,6 +31,15 @@ Parser::Parser(const std::shared_ptr<::apollo::cyber::Node>& node,
     : node_(node), conf_(conf) {
   tz_second_ = conf_.time_zone() * 3600;
   start_angle_ = static_cast<int>(conf_.start_angle() * 100);
+
+  cos_azimuth_table_.resize(AZIMUTH_UNITS);
+  sin_azimuth_table_.resize(AZIMUTH_UNITS);
+  for (int i = 0; i < AZIMUTH_UNITS; ++i) {
+    const double angle = degreeToRadian(static_cast<double>(i) / 100.0);
+    cos_azimuth_table_[i] = static_cast<float>(std::cos(angle));
+    sin_azimuth_table_[i] = static_cast<float>(std::sin(angle));
+  }
+  InitTrigTables();
 }
 
 Parser::~Parser() { Stop(); }
@@ -259,9 +268,44 @@ bool Parser::LoadCalibration(const std::string& content) {
     elev_angle_map_[i] = elev_angle[i];
     horizatal_azimuth_offset_map_[i] = azimuthOffset[i];
   }
+  InitTrigTables();
   return true;
 }
 
+void Parser::InitTrigTables() {
+  for (int i = 0; i < LASER_COUNT_L64; ++i) {
+    const double elev = degreeToRadian(elev_angle_map_[i]);
+    const double offset = degreeToRadian(horizatal_azimuth_offset_map_[i]);
+    cos_elev_[i] = static_cast<float>(std::cos(elev));
+    sin_elev_[i] = static_cast<float>(std::sin(elev));
+    cos_azimuth_offset_[i] = static_cast<float>(std::cos(offset));
+    sin_azimuth_offset_[i] = static_cast<float>(std::sin(offset));
+  }
+}
+
+void Parser::ComputeBlockXYZ(int azimuth, const double* distances,
+                             int num_lasers, float* xs, float* ys,
+                             float* zs) const {
+  const int index = azimuth % AZIMUTH_UNITS;
+  const float cos_azimuth = cos_azimuth_table_[index];
+  const float sin_azimuth = sin_azimuth_table_[index];
+  for (int i = 0; i < num_lasers; ++i) {
+    // sin(a + b) = sin(a)*cos(b) + cos(a)*sin(b)
+    // cos(a + b) = cos(a)*cos(b) - sin(a)*sin(b)
+    const float sin_angle = sin_azimuth_offset_[i] * cos_azimuth +
+                            cos_azimuth_offset_[i] * sin_azimuth;
+    const float cos_angle = cos_azimuth_offset_[i] * cos_azimuth -
+                            sin_azimuth_offset_[i] * sin_azimuth;
+    const float distance = static_cast<float>(distances[i]);
+    const float xy_distance = distance * cos_elev_[i];
+    const float x = xy_distance * sin_angle;
+    const float y = xy_distance * cos_angle;
+    xs[i] = -y;
+    ys[i] = x;
+    zs[i] = distance * sin_elev_[i];
+  }
+}
+
 void Parser::CheckPktTime(double time_sec) {
   double now = apollo::cyber::Time().Now().ToSecond();
   double diff = std::abs(now - time_sec);
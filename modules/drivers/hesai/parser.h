@@ -64,6 +64,14 @@ class Parser {
                               bool* is_end) = 0;
   void CheckPktTime(double time_sec);
   void ResetRawPointCloud();
+  // cache the sines and cosines of the calibration angles of the lasers,
+  // after elev_angle_map_ or horizatal_azimuth_offset_map_ change
+  void InitTrigTables();
+  // compute the coordinates of the points of a block, with the sines and
+  // cosines of the tables in a loop without branches which the compiler
+  // vectorizes, azimuth is in hundredths of degree
+  void ComputeBlockXYZ(int azimuth, const double* distances, int num_lasers,
+                       float* xs, float* ys, float* zs) const;
 
   bool is_calibration_ = false;
   std::shared_ptr<::apollo::cyber::Node> node_;
@@ -86,6 +94,12 @@ class Parser {
 
   double elev_angle_map_[LASER_COUNT_L64] = {0};
   double horizatal_azimuth_offset_map_[LASER_COUNT_L64] = {0};
+  float cos_elev_[LASER_COUNT_L64] = {0};
+  float sin_elev_[LASER_COUNT_L64] = {0};
+  float cos_azimuth_offset_[LASER_COUNT_L64] = {0};
+  float sin_azimuth_offset_[LASER_COUNT_L64] = {0};
+  std::vector<float> cos_azimuth_table_;
+  std::vector<float> sin_azimuth_table_;
 };
 
 }  // namespace hesai
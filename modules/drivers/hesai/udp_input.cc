@@ -22,6 +22,7 @@
 #include <sys/file.h>
 #include <sys/socket.h>
 
+#include <algorithm>
 #include <cerrno>
 #include <cstring>
 
@@ -58,6 +59,10 @@ Input::Input(uint16_t port, uint16_t gpsPort) {
     return;
   }
 
+  if (!lidarReceiver.Init(socketForLidar)) {
+    AWARN << "no kernel receive time stamps, port:" << port;
+  }
+
   if (port == gpsPort) {
     socketNumber = 1;
     return;
@@ -95,10 +100,10 @@ Input::~Input(void) {
   if (socketForLidar > 0) (void)close(socketForLidar);
 }
 
-// return : 0 - lidar
-//          1 - gps
+// return : number of packets received, a gps packet is received alone
 //         -1 - error
-int Input::GetPacket(HesaiPacket *pkt) {
+int Input::GetPackets(const std::shared_ptr<HesaiPacket> *pkts,
+                      int maxPackets) {
   struct pollfd fds[socketNumber];
   if (socketNumber == 2) {
     fds[0].fd = socketForGPS;
@@ -131,25 +136,45 @@ int Input::GetPacket(HesaiPacket *pkt) {
     return -1;
   }
 
-  senderAddressLen = sizeof(senderAddress);
-  ssize_t nbytes = 0;
   for (int i = 0; i != socketNumber; ++i) {
-    if (fds[i].revents & POLLIN) {
-      nbytes = recvfrom(fds[i].fd, &pkt->data[0], ETHERNET_MTU, 0,
-                        reinterpret_cast<sockaddr *>(&senderAddress),
-                        &senderAddressLen);
-      break;
+    if (!(fds[i].revents & POLLIN)) {
+      continue;
+    }
+    if (fds[i].fd == socketForGPS) {
+      HesaiPacket *pkt = pkts[0].get();
+      ssize_t nbytes = recvfrom(fds[i].fd, &pkt->data[0], ETHERNET_MTU, 0,
+                                reinterpret_cast<sockaddr *>(&senderAddress),
+                                &senderAddressLen);
+      if (nbytes < 0) {
+        if (errno != EWOULDBLOCK) {
+          AERROR << "recvfrom error";
+        }
+        return -1;
+      }
+      pkt->size = static_cast<uint32_t>(nbytes);
+      pkt->stamp = apollo::cyber::Time().Now().ToSecond();
+      return 1;
     }
-  }
 
-  if (nbytes < 0) {
-    if (errno != EWOULDBLOCK) {
-      AERROR << "recvfrom error";
+    // Receive the lidar packets right into the packet buffers.
+    uint8_t *buffers[UdpBatchReceiver::kMaxBatchSize];
+    int numBuffers = std::min(maxPackets, UdpBatchReceiver::kMaxBatchSize);
+    for (int j = 0; j < numBuffers; ++j) {
+      buffers[j] = &pkts[j]->data[0];
+    }
+    int numPackets = lidarReceiver.Receive(buffers, ETHERNET_MTU, numBuffers);
+    if (numPackets < 0) {
+      AERROR << "recvmmsg error";
       return -1;
     }
+    double now = apollo::cyber::Time().Now().ToSecond();
+    for (int j = 0; j < numPackets; ++j) {
+      uint64_t stamp = lidarReceiver.GetStamp(j);
+      pkts[j]->size = static_cast<uint32_t>(lidarReceiver.GetSize(j));
+      pkts[j]->stamp = stamp > 0 ? static_cast<double>(stamp) * 1e-9 : now;
+    }
+    return numPackets;
   }
-
-  pkt->size = nbytes;
   return 0;
 }
 
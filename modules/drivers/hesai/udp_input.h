@@ -18,6 +18,9 @@
 #define LIDAR_HESAI_SRC_INPUT_H_
 
 #include <cstdint>
+#include <memory>
+
+#include "modules/drivers/common/udp_batch_receiver.h"
 #include "modules/drivers/hesai/type_defs.h"
 
 namespace apollo {
@@ -28,12 +31,14 @@ class Input {
  public:
   Input(uint16_t port, uint16_t gpsPort);
   ~Input();
-  int GetPacket(HesaiPacket *pkt);
+  // Receive a gps packet, or a batch of the lidar packets available.
+  int GetPackets(const std::shared_ptr<HesaiPacket> *pkts, int maxPackets);
 
  private:
   int socketForLidar = -1;
   int socketForGPS = -1;
   int socketNumber = -1;
+  UdpBatchReceiver lidarReceiver;
 };
 
 }  // namespace hesai
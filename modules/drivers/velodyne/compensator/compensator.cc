@@ -153,69 +153,94 @@ void Compensator::MotionCompensation(
   // 0.0003 rad. So, we consider a rotation "significant" only if the scalar
   // part of quaternion is
   // less than cos(0.0003 / 2) = 1 - 1e-8.
-  if (abs_d < 1.0 - 1.0e-8) {
+  const bool significant_rotation = abs_d < 1.0 - 1.0e-8;
+
+  // gather the points by coordinate, so that the interpolation below runs
+  // over contiguous buffers
+  const int size = msg->point_size();
+  xs_.resize(size);
+  ys_.resize(size);
+  zs_.resize(size);
+  ts_.resize(size);
+  for (int i = 0; i < size; ++i) {
+    const auto& point = msg->point(i);
+    xs_[i] = point.x();
+    ys_[i] = point.y();
+    zs_[i] = point.z();
+    ts_[i] = static_cast<double>(timestamp_max - point.timestamp()) * f;
+  }
+
+  if (significant_rotation) {
     double theta = acos(abs_d);
     double sin_theta = sin(theta);
     double c1_sign = (d > 0) ? 1 : -1;
-    for (const auto& point : msg->point()) {
-      float x_scalar = point.x();
-      if (std::isnan(x_scalar)) {
+    c0_.resize(size);
+    c1_.resize(size);
+    // the points of a firing share their time, so the slerp coefficients
+    // are only computed again when it changes
+    for (int i = 0; i < size; ++i) {
+      const double t = ts_[i];
+      if (i > 0 && t == ts_[i - 1]) {
+        c0_[i] = c0_[i - 1];
+        c1_[i] = c1_[i - 1];
+        continue;
+      }
+      c0_[i] = sin((1 - t) * theta) / sin_theta;
+      c1_[i] = sin(t * theta) / sin_theta * c1_sign;
+    }
+
+    // rotate by qi = c0 * q0 + c1 * q1, with q0 the identity, then translate
+    const double q1_w = q1.w();
+    const double q1_x = q1.x();
+    const double q1_y = q1.y();
+    const double q1_z = q1.z();
+    for (int i = 0; i < size; ++i) {
+      const double w = c0_[i] + c1_[i] * q1_w;
+      const double qx = c1_[i] * q1_x;
+      const double qy = c1_[i] * q1_y;
+      const double qz = c1_[i] * q1_z;
+      const double px = xs_[i];
+      const double py = ys_[i];
+      const double pz = zs_[i];
+      // p + 2 * w * (q x p) + 2 * q x (q x p)
+      const double ux = 2.0 * (qy * pz - qz * py);
+      const double uy = 2.0 * (qz * px - qx * pz);
+      const double uz = 2.0 * (qx * py - qy * px);
+      xs_[i] = px + w * ux + (qy * uz - qz * uy) + ts_[i] * translation.x();
+      ys_[i] = py + w * uy + (qz * ux - qx * uz) + ts_[i] * translation.y();
+      zs_[i] = pz + w * uz + (qx * uy - qy * ux) + ts_[i] * translation.z();
+    }
+  } else {
+    // Not a "significant" rotation. Do translation only.
+    for (int i = 0; i < size; ++i) {
+      xs_[i] += ts_[i] * translation.x();
+      ys_[i] += ts_[i] * translation.y();
+      zs_[i] += ts_[i] * translation.z();
+    }
+  }
+
+  // the cleared points of a pooled message are reused by add_point
+  for (int i = 0; i < size; ++i) {
+    const auto& point = msg->point(i);
+    if (std::isnan(point.x())) {
+      if (significant_rotation) {
         // if (config_.organized()) {
         auto* point_new = msg_compensated->add_point();
         point_new->CopyFrom(point);
         // } else {
         //   AERROR << "nan point do not need motion compensation";
         // }
-        continue;
+      } else {
+        AERROR << "nan point do not need motion compensation";
       }
-      float y_scalar = point.y();
-      float z_scalar = point.z();
-      Eigen::Vector3d p(x_scalar, y_scalar, z_scalar);
-
-      uint64_t tp = point.timestamp();
-      double t = static_cast<double>(timestamp_max - tp) * f;
-
-      Eigen::Translation3d ti(t * translation);
-
-      double c0 = sin((1 - t) * theta) / sin_theta;
-      double c1 = sin(t * theta) / sin_theta * c1_sign;
-      Eigen::Quaterniond qi(c0 * q0.coeffs() + c1 * q1.coeffs());
-
-      Eigen::Affine3d trans = ti * qi;
-      p = trans * p;
-
-      auto* point_new = msg_compensated->add_point();
-      point_new->set_intensity(point.intensity());
-      point_new->set_timestamp(point.timestamp());
-      point_new->set_x(static_cast<float>(p.x()));
-      point_new->set_y(static_cast<float>(p.y()));
-      point_new->set_z(static_cast<float>(p.z()));
-    }
-    return;
-  }
-  // Not a "significant" rotation. Do translation only.
-  for (auto& point : msg->point()) {
-    float x_scalar = point.x();
-    if (std::isnan(x_scalar)) {
-      AERROR << "nan point do not need motion compensation";
       continue;
     }
-    float y_scalar = point.y();
-    float z_scalar = point.z();
-    Eigen::Vector3d p(x_scalar, y_scalar, z_scalar);
-
-    uint64_t tp = point.timestamp();
-    double t = static_cast<double>(timestamp_max - tp) * f;
-    Eigen::Translation3d ti(t * translation);
-
-    p = ti * p;
-
     auto* point_new = msg_compensated->add_point();
     point_new->set_intensity(point.intensity());
     point_new->set_timestamp(point.timestamp());
-    point_new->set_x(static_cast<float>(p.x()));
-    point_new->set_y(static_cast<float>(p.y()));
-    point_new->set_z(static_cast<float>(p.z()));
+    point_new->set_x(static_cast<float>(xs_[i]));
+    point_new->set_y(static_cast<float>(ys_[i]));
+    point_new->set_z(static_cast<float>(zs_[i]));
   }
 }
 
@@ -18,6 +18,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "Eigen/Eigen"
 
@@ -73,6 +74,15 @@ class Compensator {
 
   transform::Buffer* tf2_buffer_ptr_ = transform::Buffer::Instance();
   CompensatorConfig config_;
+
+  // the coordinates and interpolation coefficients of the points, kept
+  // between the clouds so that compensation does not allocate
+  std::vector<double> xs_;
+  std::vector<double> ys_;
+  std::vector<double> zs_;
+  std::vector<double> ts_;
+  std::vector<double> c0_;
+  std::vector<double> c1_;
 };
 
 }  // namespace velodyne
@@ -122,6 +122,11 @@ bool VelodyneDriver::Poll(const std::shared_ptr<VelodyneScan>& scan) {
   // publish message using time of last packet read
   ADEBUG << "Publishing a full Velodyne scan.";
   scan->mutable_header()->set_timestamp_sec(cyber::Time().Now().ToSecond());
+
+  return true;
+}
+
+void VelodyneDriver::StartScan(VelodyneScan* scan) {
   scan->mutable_header()->set_frame_id(config_.frame_id());
   scan->set_model(config_.model());
   scan->set_mode(config_.mode());
@@ -132,8 +137,15 @@ bool VelodyneDriver::Poll(const std::shared_ptr<VelodyneScan>& scan) {
 
   UpdateGpsTopHour(current_secs);
   scan->set_basetime(basetime_);
+}
 
-  return true;
+void VelodyneDriver::OnPacket(VelodyneScan* scan) {
+  if (scan->firing_pkts_size() == 1) {
+    StartScan(scan);
+  }
+  if (packet_callback_) {
+    packet_callback_(*scan);
+  }
 }
 
 int VelodyneDriver::PollStandard(std::shared_ptr<VelodyneScan> scan) {
@@ -151,6 +163,7 @@ int VelodyneDriver::PollStandard(std::shared_ptr<VelodyneScan> scan) {
       int rc = input_->get_firing_data_packet(packet);
 
       if (rc == 0) {
+        OnPacket(scan.get());
         break;  // got a full packet?
       } else if (rc < 0) {
         return rc;
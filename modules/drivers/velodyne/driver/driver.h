@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <string>
 
@@ -47,6 +48,12 @@ class VelodyneDriver {
   virtual void Init();
   virtual void PollPositioningPacket();
   void SetPacketRate(const double packet_rate) { packet_rate_ = packet_rate; }
+  // called with the scan being polled after each packet it receives, the
+  // header and base time of the scan are set from its first packet
+  void SetPacketCallback(
+      const std::function<void(const VelodyneScan &)> &callback) {
+    packet_callback_ = callback;
+  }
 
  protected:
   Config config_;
@@ -61,8 +68,11 @@ class VelodyneDriver {
   static uint64_t sync_counter;
 
   std::thread positioning_thread_;
+  std::function<void(const VelodyneScan &)> packet_callback_;
 
   virtual int PollStandard(std::shared_ptr<VelodyneScan> scan);
+  virtual void StartScan(VelodyneScan *scan);
+  void OnPacket(VelodyneScan *scan);
   bool SetBaseTime();
   void SetBaseTimeFromNmeaTime(NMEATimePtr nmea_time, uint64_t *basetime);
   void UpdateGpsTopHour(uint32_t current_time);
@@ -76,6 +86,9 @@ class Velodyne64Driver : public VelodyneDriver {
   void Init() override;
   bool Poll(const std::shared_ptr<VelodyneScan> &scan) override;
 
+ protected:
+  void StartScan(VelodyneScan *scan) override;
+
  private:
   bool CheckAngle(const VelodynePacket &packet);
   int PollStandardSync(std::shared_ptr<VelodyneScan> scan);
@@ -58,12 +58,16 @@ bool Velodyne64Driver::Poll(const std::shared_ptr<VelodyneScan>& scan) {
   // publish message using time of last packet read
   ADEBUG << "Publishing a full Velodyne scan.";
   scan->mutable_header()->set_timestamp_sec(cyber::Time().Now().ToSecond());
+
+  return true;
+}
+
+void Velodyne64Driver::StartScan(VelodyneScan* scan) {
+  // the parser of the 64 lasers sets the base time from the packets
   scan->mutable_header()->set_frame_id(config_.frame_id());
   scan->set_model(config_.model());
   scan->set_mode(config_.mode());
   scan->set_basetime(basetime_);
-
-  return true;
 }
 
 bool Velodyne64Driver::CheckAngle(const VelodynePacket& packet) {
@@ -95,6 +99,7 @@ int Velodyne64Driver::PollStandardSync(std::shared_ptr<VelodyneScan> scan) {
       int rc = input_->get_firing_data_packet(packet);
 
       if (rc == 0) {
+        OnPacket(scan.get());
         // check the angle for every packet if a packet has an angle
         if (CheckAngle(*packet) &&
             (scan->firing_pkts_size() > 0.5 * config_.npackets())) {
@@ -48,7 +48,11 @@ namespace velodyne {
  *  @param private_nh private node handle for driver
  *  @param udp_port UDP port number to connect
  */
-SocketInput::SocketInput() : sockfd_(-1), port_(0) {}
+SocketInput::SocketInput() : sockfd_(-1), port_(0) {
+  for (int i = 0; i < UdpBatchReceiver::kMaxBatchSize; ++i) {
+    batch_buffers_[i] = batch_data_[i];
+  }
+}
 
 /** @brief destructor */
 SocketInput::~SocketInput(void) { (void)close(sockfd_); }
@@ -86,45 +90,66 @@ void SocketInput::init(const int &port) {
     return;
   }
 
+  batch_size_ = 0;
+  batch_index_ = 0;
+  if (!batch_receiver_.Init(sockfd_)) {
+    AWARN << "No kernel receive time stamps on port " << port_
+          << ", packets are stamped when read";
+  }
+
   AINFO << "Velodyne socket fd is " << sockfd_ << ", port " << port_;
 }
 
 /** @brief Get one velodyne packet. */
 int SocketInput::get_firing_data_packet(VelodynePacket *pkt) {
-  // double time1 = ros::Time::now().toSec();
   double time1 = apollo::cyber::Time().Now().ToSecond();
   while (true) {
-    if (!input_available(POLL_TIMEOUT)) {
-      return SOCKET_TIMEOUT;
-    }
-    // Receive packets that should now be available from the
-    // socket using a blocking read.
-    uint8_t bytes[FIRING_DATA_PACKET_SIZE];
-    ssize_t nbytes =
-        recvfrom(sockfd_, bytes, FIRING_DATA_PACKET_SIZE, 0, nullptr, nullptr);
-
-    if (nbytes < 0) {
-      if (errno != EWOULDBLOCK) {
-        AERROR << "recvfail from port " << port_;
-        return RECIEVE_FAIL;
+    if (batch_index_ >= batch_size_) {
+      int rc = receive_firing_data_batch();
+      if (rc != 0) {
+        return rc;
       }
     }
-
-    if ((size_t)nbytes == FIRING_DATA_PACKET_SIZE) {
+    const int index = batch_index_++;
+    size_t nbytes = batch_receiver_.GetSize(index);
+    if (nbytes == FIRING_DATA_PACKET_SIZE) {
       // read successful, done now
-      pkt->set_data(bytes, FIRING_DATA_PACKET_SIZE);
+      pkt->set_data(batch_data_[index], FIRING_DATA_PACKET_SIZE);
+      uint64_t stamp = batch_receiver_.GetStamp(index);
+      if (stamp == 0) {
+        double time2 = apollo::cyber::Time().Now().ToSecond();
+        stamp = apollo::cyber::Time((time2 + time1) / 2.0).ToNanosecond();
+      }
+      pkt->set_stamp(stamp);
       break;
     }
 
     AERROR << "Incomplete Velodyne rising data packet read: " << nbytes
            << " bytes from port " << port_;
   }
-  double time2 = apollo::cyber::Time().Now().ToSecond();
-  pkt->set_stamp(apollo::cyber::Time((time2 + time1) / 2.0).ToNanosecond());
 
   return 0;
 }
 
+int SocketInput::receive_firing_data_batch() {
+  batch_size_ = 0;
+  batch_index_ = 0;
+  while (batch_size_ == 0) {
+    if (!input_available(POLL_TIMEOUT)) {
+      return SOCKET_TIMEOUT;
+    }
+    // Receive all the packets that are now available from the socket.
+    int nmsgs = batch_receiver_.Receive(batch_buffers_, FIRING_DATA_PACKET_SIZE,
+                                        UdpBatchReceiver::kMaxBatchSize);
+    if (nmsgs < 0) {
+      AERROR << "recvfail from port " << port_;
+      return RECIEVE_FAIL;
+    }
+    batch_size_ = nmsgs;
+  }
+  return 0;
+}
+
 int SocketInput::get_positioning_data_packet(NMEATimePtr nmea_time) {
   while (true) {
     if (!input_available(POLL_TIMEOUT)) {
@@ -19,6 +19,7 @@
 #include <unistd.h>
 #include <cstdio>
 
+#include "modules/drivers/common/udp_batch_receiver.h"
 #include "modules/drivers/velodyne/driver/input.h"
 
 namespace apollo {
@@ -44,6 +45,17 @@ class SocketInput : public Input {
   int sockfd_;
   int port_;
   bool input_available(int timeout);
+  /** @brief Receive the next batch of firing data packets. */
+  int receive_firing_data_batch();
+
+  /** Firing data packets are received by batches of up to
+   *  UdpBatchReceiver::kMaxBatchSize, to save a system call per packet. */
+  UdpBatchReceiver batch_receiver_;
+  uint8_t batch_data_[UdpBatchReceiver::kMaxBatchSize]
+                     [FIRING_DATA_PACKET_SIZE];
+  uint8_t* batch_buffers_[UdpBatchReceiver::kMaxBatchSize];
+  int batch_size_ = 0;
+  int batch_index_ = 0;
 };
 
 }  // namespace velodyne
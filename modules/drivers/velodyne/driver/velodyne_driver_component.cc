@@ -22,6 +22,7 @@
 
 #include "modules/common/util/message_util.h"
 #include "modules/drivers/velodyne/driver/velodyne_driver_component.h"
+#include "modules/drivers/velodyne/driver/velodyne_gflags.h"
 
 namespace apollo {
 namespace drivers {
@@ -42,6 +43,28 @@ bool VelodyneDriverComponent::Init() {
   }
   dvr_.reset(driver);
   dvr_->Init();
+  if (!FLAGS_velodyne_streaming_channel.empty()) {
+    conv_.reset(new Convert());
+    conv_->init(velodyne_config);
+    point_cloud_writer_ =
+        node_->CreateWriter<PointCloud>(FLAGS_velodyne_streaming_channel);
+    if (FLAGS_velodyne_sector_packets > 0) {
+      sector_writer_ =
+          node_->CreateWriter<PointCloud>(FLAGS_velodyne_sector_channel);
+    }
+    point_cloud_pool_.reset(new CCObjectPool<PointCloud>(pool_size_));
+    point_cloud_pool_->ConstructAll();
+    for (int i = 0; i < pool_size_; i++) {
+      auto point_cloud = point_cloud_pool_->GetObject();
+      if (point_cloud == nullptr) {
+        AERROR << "fail to getobject, i: " << i;
+        return false;
+      }
+      point_cloud->mutable_point()->Reserve(140000);
+    }
+    dvr_->SetPacketCallback(
+        [this](const VelodyneScan &scan) { OnPacket(scan); });
+  }
   // spawn device poll thread
   runing_ = true;
   device_thread_ = std::shared_ptr<std::thread>(
@@ -60,6 +83,9 @@ void VelodyneDriverComponent::device_poll() {
     if (ret) {
       common::util::FillHeader("velodyne", scan.get());
       writer_->Write(scan);
+      if (conv_ != nullptr) {
+        PublishPointcloud(scan);
+      }
     } else {
       AWARN << "device poll failed";
     }
@@ -69,6 +95,78 @@ void VelodyneDriverComponent::device_poll() {
   runing_ = false;
 }
 
+std::shared_ptr<PointCloud> VelodyneDriverComponent::GetPointCloud() {
+  std::shared_ptr<PointCloud> point_cloud = point_cloud_pool_->GetObject();
+  if (point_cloud == nullptr) {
+    AWARN << "point cloud pool return nullptr, will be create new.";
+    point_cloud = std::make_shared<PointCloud>();
+    point_cloud->mutable_point()->Reserve(140000);
+  }
+  point_cloud->Clear();
+  return point_cloud;
+}
+
+void VelodyneDriverComponent::OnPacket(const VelodyneScan &scan) {
+  const int num_packets = scan.firing_pkts_size();
+  if (num_packets == 1) {
+    point_cloud_ = GetPointCloud();
+    streaming_ = conv_->BeginScan(scan, point_cloud_);
+    sector_begin_packet_ = 0;
+    sector_begin_point_ = 0;
+  }
+  if (!streaming_) {
+    return;
+  }
+  conv_->ConvertPacket(scan.firing_pkts(num_packets - 1), point_cloud_);
+  if (sector_writer_ != nullptr &&
+      num_packets - sector_begin_packet_ >= FLAGS_velodyne_sector_packets) {
+    PublishSector(num_packets);
+  }
+}
+
+void VelodyneDriverComponent::PublishSector(int end_packet) {
+  const int end_point = point_cloud_->point_size();
+  if (end_point > sector_begin_point_) {
+    std::shared_ptr<PointCloud> sector = GetPointCloud();
+    *sector->mutable_header() = point_cloud_->header();
+    for (int i = sector_begin_point_; i < end_point; ++i) {
+      *sector->add_point() = point_cloud_->point(i);
+    }
+    const uint64_t timestamp =
+        sector->point(sector->point_size() - 1).timestamp();
+    sector->set_measurement_time(static_cast<double>(timestamp) / 1e9);
+    sector->mutable_header()->set_lidar_timestamp(timestamp);
+    sector->set_height(1);
+    sector->set_width(sector->point_size());
+    sector->set_is_dense(false);
+    sector_writer_->Write(sector);
+  }
+  sector_begin_packet_ = end_packet;
+  sector_begin_point_ = end_point;
+}
+
+void VelodyneDriverComponent::PublishPointcloud(
+    const std::shared_ptr<VelodyneScan> &scan) {
+  if (!streaming_) {
+    // the scan could not be converted packet by packet
+    point_cloud_ = GetPointCloud();
+    conv_->ConvertPacketsToPointcloud(scan, point_cloud_);
+  } else {
+    if (sector_writer_ != nullptr) {
+      PublishSector(scan->firing_pkts_size());
+    }
+    conv_->EndScan(point_cloud_);
+  }
+  streaming_ = false;
+  if (point_cloud_->point().empty()) {
+    AWARN << "point cloud converted while streaming is empty.";
+    return;
+  }
+  point_cloud_->mutable_header()->set_sequence_num(
+      scan->header().sequence_num());
+  point_cloud_writer_->Write(point_cloud_);
+}
+
 }  // namespace velodyne
 }  // namespace drivers
 }  // namespace apollo
@@ -19,9 +19,11 @@
 #include <string>
 #include <thread>
 
+#include "cyber/base/concurrent_object_pool.h"
 #include "cyber/cyber.h"
 
 #include "modules/drivers/velodyne/driver/driver.h"
+#include "modules/drivers/velodyne/parser/convert.h"
 #include "modules/drivers/velodyne/proto/config.pb.h"
 #include "modules/drivers/velodyne/proto/velodyne.pb.h"
 
@@ -32,6 +34,8 @@ namespace velodyne {
 using apollo::cyber::Component;
 using apollo::cyber::Reader;
 using apollo::cyber::Writer;
+using apollo::cyber::base::CCObjectPool;
+using apollo::drivers::PointCloud;
 using apollo::drivers::velodyne::VelodyneScan;
 
 class VelodyneDriverComponent : public Component<> {
@@ -45,11 +49,28 @@ class VelodyneDriverComponent : public Component<> {
 
  private:
   void device_poll();
+  // convert the last packet of the scan being polled
+  void OnPacket(const VelodyneScan &scan);
+  void PublishPointcloud(const std::shared_ptr<VelodyneScan> &scan);
+  void PublishSector(int end_packet);
+  std::shared_ptr<PointCloud> GetPointCloud();
   volatile bool runing_;  ///< device thread is running
   uint32_t seq_ = 0;
   std::shared_ptr<std::thread> device_thread_;
   std::shared_ptr<VelodyneDriver> dvr_;  ///< driver implementation class
   std::shared_ptr<apollo::cyber::Writer<VelodyneScan>> writer_;
+
+  // streaming conversion, the point cloud of a scan is filled while its
+  // packets are received instead of after the whole scan is published
+  std::unique_ptr<Convert> conv_ = nullptr;
+  std::shared_ptr<CCObjectPool<PointCloud>> point_cloud_pool_ = nullptr;
+  std::shared_ptr<Writer<PointCloud>> point_cloud_writer_;
+  std::shared_ptr<Writer<PointCloud>> sector_writer_;
+  std::shared_ptr<PointCloud> point_cloud_ = nullptr;
+  bool streaming_ = false;
+  int sector_begin_packet_ = 0;
+  int sector_begin_point_ = 0;
+  int pool_size_ = 8;
 };
 
 CYBER_REGISTER_COMPONENT(VelodyneDriverComponent)
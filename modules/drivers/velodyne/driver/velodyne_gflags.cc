@@ -0,0 +1,37 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/drivers/velodyne/driver/velodyne_gflags.h"
+
+// streaming conversion in the driver
+DEFINE_string(velodyne_streaming_channel, "",
+              "Channel of the point clouds the driver converts packet by "
+              "packet while it receives a scan, empty to only publish the "
+              "scans.");
+DEFINE_int32(velodyne_sector_packets, 0,
+             "Publish the points of every this many packets of a streamed "
+             "scan as a partial point cloud, 0 to disable.");
+DEFINE_string(velodyne_sector_channel, "",
+              "Channel of the partial point clouds of the streamed scans.");
+
+// fusion of the clouds of several lidars
+DEFINE_string(velodyne_fusion_view_channel, "",
+              "Channel of the fused views, which reference the source clouds "
+              "on their channels with their transforms instead of copying "
+              "their points, empty to disable.");
+DEFINE_bool(velodyne_fusion_merge, true,
+            "Publish the merged copy of the fused clouds on the fusion "
+            "channel.");
@@ -0,0 +1,28 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include "gflags/gflags.h"
+
+// streaming conversion in the driver
+DECLARE_string(velodyne_streaming_channel);
+DECLARE_int32(velodyne_sector_packets);
+DECLARE_string(velodyne_sector_channel);
+
+// fusion of the clouds of several lidars
+DECLARE_string(velodyne_fusion_view_channel);
+DECLARE_bool(velodyne_fusion_merge);
@@ -0,0 +1,95 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/drivers/velodyne/fusion/fused_point_cloud_view.h"
+
+namespace apollo {
+namespace drivers {
+namespace velodyne {
+
+void FusedPointCloudView::AddSource(const std::string& channel,
+                                   const PointCloud& cloud,
+                                   const Eigen::Affine3d* pose,
+                                   FusedPointCloud* fused) {
+  PointCloudSource* source = fused->add_source();
+  source->set_channel(channel);
+  source->set_frame_id(cloud.header().frame_id());
+  source->set_sequence_num(cloud.header().sequence_num());
+  source->set_lidar_timestamp(cloud.header().lidar_timestamp());
+  source->set_point_size(cloud.point_size());
+  if (pose != nullptr) {
+    for (int row = 0; row < 3; ++row) {
+      for (int col = 0; col < 4; ++col) {
+        source->add_pose((*pose)(row, col));
+      }
+    }
+  }
+}
+
+void FusedPointCloudView::Reset(const FusedPointCloud& fused) {
+  sources_.resize(fused.source_size());
+  for (int i = 0; i < fused.source_size(); ++i) {
+    Source& source = sources_[i];
+    source.info = fused.source(i);
+    source.cloud.reset();
+    source.has_pose = source.info.pose_size() == 12;
+    source.pose.setIdentity();
+    if (source.has_pose) {
+      for (int row = 0; row < 3; ++row) {
+        for (int col = 0; col < 4; ++col) {
+          source.pose(row, col) = source.info.pose(row * 4 + col);
+        }
+      }
+    }
+  }
+}
+
+bool FusedPointCloudView::Attach(
+    const std::string& channel,
+    const std::shared_ptr<const PointCloud>& cloud) {
+  for (Source& source : sources_) {
+    if (source.info.channel() == channel &&
+        source.info.sequence_num() == cloud->header().sequence_num() &&
+        source.info.lidar_timestamp() == cloud->header().lidar_timestamp()) {
+      source.cloud = cloud;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool FusedPointCloudView::IsComplete() const {
+  for (const Source& source : sources_) {
+    if (source.cloud == nullptr) {
+      return false;
+    }
+  }
+  return true;
+}
+
+int FusedPointCloudView::size() const {
+  int size = 0;
+  for (const Source& source : sources_) {
+    if (source.cloud != nullptr) {
+      size += source.cloud->point_size();
+    }
+  }
+  return size;
+}
+
+}  // namespace velodyne
+}  // namespace drivers
+}  // namespace apollo
@@ -0,0 +1,117 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Eigen/Eigen"
+
+// Eigen 3.3.7: #define ALIVE (0)
+// fastrtps: enum ChangeKind_t { ALIVE, ... };
+#if defined(ALIVE)
+#   undef ALIVE
+#endif
+
+#include "modules/drivers/proto/fused_pointcloud.pb.h"
+#include "modules/drivers/proto/pointcloud.pb.h"
+
+namespace apollo {
+namespace drivers {
+namespace velodyne {
+
+using apollo::drivers::FusedPointCloud;
+using apollo::drivers::PointCloud;
+using apollo::drivers::PointCloudSource;
+using apollo::drivers::PointXYZIT;
+
+/**
+ * @brief The points of a FusedPointCloud, read from the source clouds the
+ *   consumer receives on their own channels, and transformed into the frame
+ *   of the fused cloud as they are read.
+ */
+class FusedPointCloudView {
+ public:
+  /**
+   * @brief add a source to a fused cloud
+   * @param pose the transform into the frame of the fused cloud, or nullptr
+   *   if the points are in this frame already
+   */
+  static void AddSource(const std::string& channel, const PointCloud& cloud,
+                        const Eigen::Affine3d* pose, FusedPointCloud* fused);
+
+  /**
+   * @brief reset the view to the sources of a fused cloud, with no cloud
+   *   attached
+   */
+  void Reset(const FusedPointCloud& fused);
+
+  /**
+   * @brief attach a cloud received on a channel
+   * @return false if it is not the cloud a source of the view references
+   */
+  bool Attach(const std::string& channel,
+              const std::shared_ptr<const PointCloud>& cloud);
+
+  /**
+   * @brief whether the clouds of all the sources are attached
+   */
+  bool IsComplete() const;
+
+  int num_sources() const { return static_cast<int>(sources_.size()); }
+
+  /**
+   * @brief the number of points of the attached clouds
+   */
+  int size() const;
+
+  /**
+   * @brief call function(point, position) on the points of the attached
+   *   clouds, position being the point in the frame of the fused cloud
+   */
+  template <typename Function>
+  void ForEachPoint(Function function) const {
+    for (const Source& source : sources_) {
+      if (source.cloud == nullptr) {
+        continue;
+      }
+      for (const PointXYZIT& point : source.cloud->point()) {
+        Eigen::Vector3d position(point.x(), point.y(), point.z());
+        if (source.has_pose && !std::isnan(point.x())) {
+          position = source.pose * position;
+        }
+        function(point, position);
+      }
+    }
+  }
+
+ private:
+  struct Source {
+    PointCloudSource info;
+    bool has_pose = false;
+    Eigen::Affine3d pose = Eigen::Affine3d::Identity();
+    std::shared_ptr<const PointCloud> cloud;
+  };
+
+  std::vector<Source> sources_;
+};
+
+}  // namespace velodyne
+}  // namespace drivers
+}  // namespace apollo
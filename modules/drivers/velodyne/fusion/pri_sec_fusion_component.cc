@@ -17,8 +17,12 @@
 #include "modules/drivers/velodyne/fusion/pri_sec_fusion_component.h"
 
 #include <memory>
+#include <string>
 #include <thread>
 
+#include "modules/drivers/velodyne/driver/velodyne_gflags.h"
+#include "modules/drivers/velodyne/fusion/fused_point_cloud_view.h"
+
 namespace apollo {
 namespace drivers {
 namespace velodyne {
@@ -33,6 +37,10 @@ bool PriSecFusionComponent::Init() {
   buffer_ptr_ = apollo::transform::Buffer::Instance();
 
   fusion_writer_ = node_->CreateWriter<PointCloud>(conf_.fusion_channel());
+  if (!FLAGS_velodyne_fusion_view_channel.empty()) {
+    view_writer_ = node_->CreateWriter<FusedPointCloud>(
+        FLAGS_velodyne_fusion_view_channel);
+  }
 
   for (const auto& channel : conf_.input_channel()) {
     auto reader = node_->CreateReader<PointCloud>(channel);
@@ -43,7 +51,24 @@ bool PriSecFusionComponent::Init() {
 
 bool PriSecFusionComponent::Proc(
     const std::shared_ptr<PointCloud>& point_cloud) {
-  auto target = std::make_shared<PointCloud>(*point_cloud);
+  std::shared_ptr<PointCloud> target = nullptr;
+  if (FLAGS_velodyne_fusion_merge) {
+    target = std::make_shared<PointCloud>(*point_cloud);
+  }
+  // the view references the clouds on their channels instead of copying
+  // their points
+  std::shared_ptr<FusedPointCloud> view = nullptr;
+  if (view_writer_ != nullptr) {
+    view = std::make_shared<FusedPointCloud>();
+    *view->mutable_header() = point_cloud->header();
+    view->set_frame_id(point_cloud->header().frame_id());
+    view->set_measurement_time(point_cloud->measurement_time());
+    const std::string channel = ComponentBase::readers_.empty()
+                                    ? ""
+                                    : ComponentBase::readers_.front()
+                                          ->GetChannelName();
+    FusedPointCloudView::AddSource(channel, *point_cloud, nullptr, view.get());
+  }
   auto fusion_readers = readers_;
   auto start_time = Time::Now().ToSecond();
   while ((Time::Now().ToSecond() - start_time) < conf_.wait_time_s() &&
@@ -52,10 +77,11 @@ bool PriSecFusionComponent::Proc(
       (*itr)->Observe();
       if (!(*itr)->Empty()) {
         auto source = (*itr)->GetLatestObserved();
-        if (conf_.drop_expired_data() && IsExpired(target, source)) {
+        if (conf_.drop_expired_data() && IsExpired(point_cloud, source)) {
           ++itr;
         } else {
-          Fusion(target, source);
+          Fusion(point_cloud, (*itr)->GetChannelName(), source, target,
+                 view.get());
           itr = fusion_readers.erase(itr);
         }
       } else {
@@ -64,9 +90,15 @@ bool PriSecFusionComponent::Proc(
     }
     std::this_thread::sleep_for(std::chrono::milliseconds(5));
   }
-  auto diff = Time::Now().ToNanosecond() - target->header().lidar_timestamp();
+  auto diff =
+      Time::Now().ToNanosecond() - point_cloud->header().lidar_timestamp();
   AINFO << "Pointcloud fusion diff: " << diff / 1000000 << "ms";
-  fusion_writer_->Write(target);
+  if (target != nullptr) {
+    fusion_writer_->Write(target);
+  }
+  if (view != nullptr) {
+    view_writer_->Write(view);
+  }
 
   return true;
 }
@@ -151,12 +183,22 @@ void PriSecFusionComponent::AppendPointCloud(
   point_cloud->set_width(new_width);
 }
 
-bool PriSecFusionComponent::Fusion(std::shared_ptr<PointCloud> target,
-                                   std::shared_ptr<PointCloud> source) {
+bool PriSecFusionComponent::Fusion(const std::shared_ptr<PointCloud>& primary,
+                                   const std::string& channel,
+                                   std::shared_ptr<PointCloud> source,
+                                   std::shared_ptr<PointCloud> target,
+                                   FusedPointCloud* view) {
   Eigen::Affine3d pose;
-  if (QueryPoseAffine(target->header().frame_id(), source->header().frame_id(),
-                      &pose)) {
-    AppendPointCloud(target, source, pose);
+  if (QueryPoseAffine(primary->header().frame_id(),
+                      source->header().frame_id(), &pose)) {
+    if (target != nullptr) {
+      AppendPointCloud(target, source, pose);
+    }
+    if (view != nullptr) {
+      FusedPointCloudView::AddSource(channel, *source,
+                                     std::isnan(pose(0, 0)) ? nullptr : &pose,
+                                     view);
+    }
     return true;
   }
   return false;
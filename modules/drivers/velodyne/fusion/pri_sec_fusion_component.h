@@ -29,6 +29,7 @@
 #endif
 
 #include "cyber/cyber.h"
+#include "modules/drivers/proto/fused_pointcloud.pb.h"
 #include "modules/drivers/proto/pointcloud.pb.h"
 #include "modules/drivers/velodyne/proto/config.pb.h"
 #include "modules/transform/buffer.h"
@@ -48,8 +49,11 @@ class PriSecFusionComponent : public Component<PointCloud> {
   bool Proc(const std::shared_ptr<PointCloud>& point_cloud) override;
 
  private:
-  bool Fusion(std::shared_ptr<PointCloud> target,
-              std::shared_ptr<PointCloud> source);
+  // append the points of source to target if it is not null, and reference
+  // source from view if it is not null
+  bool Fusion(const std::shared_ptr<PointCloud>& primary,
+              const std::string& channel, std::shared_ptr<PointCloud> source,
+              std::shared_ptr<PointCloud> target, FusedPointCloud* view);
   bool IsExpired(const std::shared_ptr<PointCloud>& target,
                  const std::shared_ptr<PointCloud>& source);
   bool QueryPoseAffine(const std::string& target_frame_id,
@@ -62,6 +66,7 @@ class PriSecFusionComponent : public Component<PointCloud> {
   FusionConfig conf_;
   apollo::transform::Buffer* buffer_ptr_ = nullptr;
   std::shared_ptr<Writer<PointCloud>> fusion_writer_;
+  std::shared_ptr<Writer<FusedPointCloud>> view_writer_;
   std::vector<std::shared_ptr<Reader<PointCloud>>> readers_;
 };
 
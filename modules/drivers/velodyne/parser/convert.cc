@@ -42,7 +42,26 @@ void Convert::ConvertPacketsToPointcloud(
   ADEBUG << "Convert scan msg seq " << scan_msg->header().sequence_num();
 
   parser_->GeneratePointcloud(scan_msg, point_cloud);
+  FinishPointcloud(point_cloud);
+}
+
+bool Convert::BeginScan(const VelodyneScan& scan_msg,
+                        std::shared_ptr<PointCloud> point_cloud) {
+  ADEBUG << "Begin scan msg seq " << scan_msg.header().sequence_num();
+  return parser_->BeginScan(scan_msg, point_cloud);
+}
+
+void Convert::ConvertPacket(const VelodynePacket& pkt,
+                            std::shared_ptr<PointCloud> point_cloud) {
+  parser_->ConvertPacket(pkt, point_cloud);
+}
+
+void Convert::EndScan(std::shared_ptr<PointCloud> point_cloud) {
+  parser_->EndScan(point_cloud);
+  FinishPointcloud(point_cloud);
+}
 
+void Convert::FinishPointcloud(std::shared_ptr<PointCloud> point_cloud) {
   if (point_cloud == nullptr || point_cloud->point().empty()) {
     AERROR << "point cloud has no point";
     return;
@@ -45,7 +45,18 @@ class Convert {
   void ConvertPacketsToPointcloud(const std::shared_ptr<VelodyneScan>& scan_msg,
                                   std::shared_ptr<PointCloud> point_cloud_out);
 
+  // convert the packets of a scan one by one as the driver receives them,
+  // BeginScan returns false if the scan must be converted as a whole
+  bool BeginScan(const VelodyneScan& scan_msg,
+                 std::shared_ptr<PointCloud> point_cloud_out);
+  void ConvertPacket(const VelodynePacket& pkt,
+                     std::shared_ptr<PointCloud> point_cloud_out);
+  void EndScan(std::shared_ptr<PointCloud> point_cloud_out);
+
  private:
+  // order the points of a finished point cloud
+  void FinishPointcloud(std::shared_ptr<PointCloud> point_cloud);
+
   // RawData class for converting data to point cloud
   std::unique_ptr<VelodyneParser> parser_;
 
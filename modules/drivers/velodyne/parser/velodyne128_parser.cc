@@ -26,22 +26,25 @@ Velodyne128Parser::Velodyne128Parser(const Config& config)
   need_two_pt_correction_ = false;
 }
 
-void Velodyne128Parser::GeneratePointcloud(
-    const std::shared_ptr<VelodyneScan>& scan_msg,
-    std::shared_ptr<PointCloud> out_msg) {
+bool Velodyne128Parser::BeginScan(const VelodyneScan& scan_msg,
+                                  std::shared_ptr<PointCloud> out_msg) {
   // allocate a point cloud with same time and frame ID as raw data
-  out_msg->mutable_header()->set_frame_id(scan_msg->header().frame_id());
+  out_msg->mutable_header()->set_frame_id(scan_msg.header().frame_id());
   out_msg->mutable_header()->set_timestamp_sec(cyber::Time().Now().ToSecond());
   out_msg->set_height(1);
 
   // us
-  gps_base_usec_ = scan_msg->basetime();
+  gps_base_usec_ = scan_msg.basetime();
+  return true;
+}
 
-  for (int i = 0; i < scan_msg->firing_pkts_size(); ++i) {
-    Unpack(scan_msg->firing_pkts(i), out_msg);
-    last_time_stamp_ = out_msg->measurement_time();
-  }
+void Velodyne128Parser::ConvertPacket(const VelodynePacket& pkt,
+                                      std::shared_ptr<PointCloud> out_msg) {
+  Unpack(pkt, out_msg);
+  last_time_stamp_ = out_msg->measurement_time();
+}
 
+void Velodyne128Parser::EndScan(std::shared_ptr<PointCloud> out_msg) {
   size_t size = out_msg->point_size();
   if (size == 0) {
     // we discard this pointcloud if empty
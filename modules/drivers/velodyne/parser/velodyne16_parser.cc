@@ -26,23 +26,25 @@ Velodyne16Parser::Velodyne16Parser(const Config& config)
   need_two_pt_correction_ = false;
 }
 
-void Velodyne16Parser::GeneratePointcloud(
-    const std::shared_ptr<VelodyneScan>& scan_msg,
-    std::shared_ptr<PointCloud> out_msg) {
+bool Velodyne16Parser::BeginScan(const VelodyneScan& scan_msg,
+                                 std::shared_ptr<PointCloud> out_msg) {
   // allocate a point cloud with same time and frame ID as raw data
-  out_msg->mutable_header()->set_frame_id(scan_msg->header().frame_id());
+  out_msg->mutable_header()->set_frame_id(scan_msg.header().frame_id());
   out_msg->set_height(1);
   out_msg->mutable_header()->set_sequence_num(
-      scan_msg->header().sequence_num());
-  gps_base_usec_ = scan_msg->basetime();
-
-  size_t packets_size = scan_msg->firing_pkts_size();
-  for (size_t i = 0; i < packets_size; ++i) {
-    Unpack(scan_msg->firing_pkts(static_cast<int>(i)), out_msg);
-    last_time_stamp_ = out_msg->measurement_time();
-    ADEBUG << "stamp: " << std::fixed << last_time_stamp_;
-  }
+      scan_msg.header().sequence_num());
+  gps_base_usec_ = scan_msg.basetime();
+  return true;
+}
+
+void Velodyne16Parser::ConvertPacket(const VelodynePacket& pkt,
+                                     std::shared_ptr<PointCloud> out_msg) {
+  Unpack(pkt, out_msg);
+  last_time_stamp_ = out_msg->measurement_time();
+  ADEBUG << "stamp: " << std::fixed << last_time_stamp_;
+}
 
+void Velodyne16Parser::EndScan(std::shared_ptr<PointCloud> out_msg) {
   if (out_msg->point().empty()) {
     // we discard this pointcloud if empty
     AERROR << "All points is NAN!Please check velodyne:" << config_.model();
@@ -29,27 +29,27 @@ Velodyne32Parser::Velodyne32Parser(const Config& config)
   }
 }
 
-void Velodyne32Parser::GeneratePointcloud(
-    const std::shared_ptr<VelodyneScan>& scan_msg,
-    std::shared_ptr<PointCloud> out_msg) {
+bool Velodyne32Parser::BeginScan(const VelodyneScan& scan_msg,
+                                 std::shared_ptr<PointCloud> out_msg) {
   // allocate a point cloud with same time and frame ID as raw data
-  out_msg->mutable_header()->set_frame_id(scan_msg->header().frame_id());
+  out_msg->mutable_header()->set_frame_id(scan_msg.header().frame_id());
   out_msg->set_height(1);
   out_msg->mutable_header()->set_sequence_num(
-      scan_msg->header().sequence_num());
-  gps_base_usec_ = scan_msg->basetime();
+      scan_msg.header().sequence_num());
+  gps_base_usec_ = scan_msg.basetime();
+  return true;
+}
 
-  size_t packets_size = scan_msg->firing_pkts_size();
+void Velodyne32Parser::ConvertPacket(const VelodynePacket& pkt,
+                                     std::shared_ptr<PointCloud> out_msg) {
   if (config_.model() == VLP32C) {
-    for (size_t i = 0; i < packets_size; ++i) {
-      UnpackVLP32C(scan_msg->firing_pkts(static_cast<int>(i)), out_msg);
-    }
+    UnpackVLP32C(pkt, out_msg);
   } else {
-    for (size_t i = 0; i < packets_size; ++i) {
-      Unpack(scan_msg->firing_pkts(static_cast<int>(i)), out_msg);
-    }
+    Unpack(pkt, out_msg);
   }
+}
 
+void Velodyne32Parser::EndScan(std::shared_ptr<PointCloud> out_msg) {
   // set measurement and lidar_timestampe
   int size = out_msg->point_size();
   if (size == 0) {
@@ -182,10 +182,27 @@ void Velodyne32Parser::Unpack(const VelodynePacket& pkt,
   const RawPacket* raw = (const RawPacket*)pkt.data().c_str();
   double basetime = raw->gps_timestamp;  // usec
 
+  float real_distances[SCANS_PER_BLOCK];
+  uint16_t rotations[SCANS_PER_BLOCK];
+  float xs[SCANS_PER_BLOCK];
+  float ys[SCANS_PER_BLOCK];
+  float zs[SCANS_PER_BLOCK];
+
   for (int i = 0; i < BLOCKS_PER_PACKET; i++) {  // 12
+    // compute the coords of the whole block at once
+    for (int j = 0, k = 0; j < SCANS_PER_BLOCK; ++j, k += RAW_SCAN_SIZE) {
+      union RawDistance raw_distance;
+      raw_distance.bytes[0] = raw->blocks[i].data[k];
+      raw_distance.bytes[1] = raw->blocks[i].data[k + 1];
+      real_distances[j] = raw_distance.raw_distance * DISTANCE_RESOLUTION;
+      rotations[j] = raw->blocks[i].rotation;
+    }
+    ComputeBlockCoords(real_distances, rotations, 0, SCANS_PER_BLOCK, xs, ys,
+                       zs);
+
     for (int laser_id = 0, k = 0; laser_id < SCANS_PER_BLOCK;
          ++laser_id, k += RAW_SCAN_SIZE) {  // 32, 3
-      LaserCorrection& corrections = calibration_.laser_corrections_[laser_id];
+      const LaserCorrection& corrections = laser_table_.corrections[laser_id];
 
       union RawDistance raw_distance;
       raw_distance.bytes[0] = raw->blocks[i].data[k];
@@ -196,8 +213,7 @@ void Velodyne32Parser::Unpack(const VelodynePacket& pkt,
           basetime, (*inner_time_)[i][laser_id], static_cast<uint16_t>(i)));
 
       int rotation = static_cast<int>(raw->blocks[i].rotation);
-      float real_distance = raw_distance.raw_distance * DISTANCE_RESOLUTION;
-      float distance = real_distance + corrections.dist_correction;
+      float distance = real_distances[laser_id] + corrections.dist_correction;
 
       if (raw_distance.raw_distance == 0 ||
           !is_scan_valid(rotation, distance)) {
@@ -215,9 +231,9 @@ void Velodyne32Parser::Unpack(const VelodynePacket& pkt,
 
       apollo::drivers::PointXYZIT* point = pc->add_point();
       point->set_timestamp(timestamp);
-      // Position Calculation, append this point to the cloud
-      ComputeCoords(real_distance, corrections, static_cast<uint16_t>(rotation),
-                    point);
+      point->set_x(xs[laser_id]);
+      point->set_y(ys[laser_id]);
+      point->set_z(zs[laser_id]);
       point->set_intensity(raw->blocks[i].data[k + 2]);
       // append this point to the cloud
     }
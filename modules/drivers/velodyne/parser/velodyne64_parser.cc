@@ -154,34 +154,47 @@ void Velodyne64Parser::GeneratePointcloud(
       return;
     }
     calibration_ = online_calibration_.calibration();
+    InitLaserTable();
     if (config_.organized()) {
       InitOffsets();
     }
   }
+  VelodyneParser::GeneratePointcloud(scan_msg, pointcloud);
+}
+
+bool Velodyne64Parser::BeginScan(const VelodyneScan& scan_msg,
+                                 std::shared_ptr<PointCloud> pointcloud) {
+  // the online calibration is decoded from whole scans
+  if (config_.calibration_online() && !calibration_.initialized_) {
+    return false;
+  }
 
   // allocate a point cloud with same time and frame ID as raw data
-  pointcloud->mutable_header()->set_frame_id(scan_msg->header().frame_id());
+  pointcloud->mutable_header()->set_frame_id(scan_msg.header().frame_id());
   pointcloud->set_height(1);
   pointcloud->mutable_header()->set_sequence_num(
-      scan_msg->header().sequence_num());
-
-  bool skip = false;
-  size_t packets_size = scan_msg->firing_pkts_size();
-  for (size_t i = 0; i < packets_size; ++i) {
-    if (gps_base_usec_[0] == 0) {
-      // only set one time type when call this function, so cannot break
-      SetBaseTimeFromPackets(scan_msg->firing_pkts(static_cast<int>(i)));
-      // If base time not ready then set empty_unpack true
-      skip = true;
-    } else {
-      CheckGpsStatus(scan_msg->firing_pkts(static_cast<int>(i)));
-      Unpack(scan_msg->firing_pkts(static_cast<int>(i)), pointcloud);
-      last_time_stamp_ = pointcloud->measurement_time();
-      ADEBUG << "stamp: " << std::fixed << last_time_stamp_;
-    }
+      scan_msg.header().sequence_num());
+  skip_scan_ = false;
+  return true;
+}
+
+void Velodyne64Parser::ConvertPacket(const VelodynePacket& pkt,
+                                     std::shared_ptr<PointCloud> pointcloud) {
+  if (gps_base_usec_[0] == 0) {
+    // only set one time type when call this function, so cannot break
+    SetBaseTimeFromPackets(pkt);
+    // If base time not ready then set empty_unpack true
+    skip_scan_ = true;
+  } else {
+    CheckGpsStatus(pkt);
+    Unpack(pkt, pointcloud);
+    last_time_stamp_ = pointcloud->measurement_time();
+    ADEBUG << "stamp: " << std::fixed << last_time_stamp_;
   }
+}
 
-  if (skip) {
+void Velodyne64Parser::EndScan(std::shared_ptr<PointCloud> pointcloud) {
+  if (skip_scan_) {
     pointcloud->Clear();
   } else {
     int size = pointcloud->point_size();
@@ -245,6 +258,12 @@ void Velodyne64Parser::Unpack(const VelodynePacket& pkt,
   const RawPacket* raw = (const RawPacket*)pkt.data().c_str();
   double basetime = raw->gps_timestamp;  // usec
 
+  float real_distances[SCANS_PER_BLOCK];
+  uint16_t rotations[SCANS_PER_BLOCK];
+  float xs[SCANS_PER_BLOCK];
+  float ys[SCANS_PER_BLOCK];
+  float zs[SCANS_PER_BLOCK];
+
   for (int i = 0; i < BLOCKS_PER_PACKET; ++i) {  // 12
     if (mode_ != DUAL && !is_s2_ && ((i & 3) >> 1) > 0) {
       // i%4/2  even-numbered block contain duplicate data
@@ -255,13 +274,22 @@ void Velodyne64Parser::Unpack(const VelodynePacket& pkt,
     // NOTE: this is a change from the old velodyne_common implementation
     int bank_origin = (raw->blocks[i].laser_block_id == LOWER_BANK) ? 32 : 0;
 
+    // compute the coords of the whole block at once
+    for (int j = 0, k = 0; j < SCANS_PER_BLOCK; ++j, k += RAW_SCAN_SIZE) {
+      union RawDistance raw_distance;
+      raw_distance.bytes[0] = raw->blocks[i].data[k];
+      raw_distance.bytes[1] = raw->blocks[i].data[k + 1];
+      real_distances[j] = raw_distance.raw_distance * DISTANCE_RESOLUTION;
+      rotations[j] = raw->blocks[i].rotation;
+    }
+    ComputeBlockCoords(real_distances, rotations, bank_origin, SCANS_PER_BLOCK,
+                       xs, ys, zs);
+
     for (int j = 0, k = 0; j < SCANS_PER_BLOCK;
          ++j, k += RAW_SCAN_SIZE) {  // 32, 3
       // One point
-      uint8_t laser_number =
-          static_cast<uint8_t>(j + bank_origin);  // hardware laser number
-      LaserCorrection& corrections =
-          calibration_.laser_corrections_[laser_number];
+      const LaserCorrection& corrections =
+          laser_table_.corrections[j + bank_origin];
 
       union RawDistance raw_distance;
       raw_distance.bytes[0] = raw->blocks[i].data[k];
@@ -276,8 +304,7 @@ void Velodyne64Parser::Unpack(const VelodynePacket& pkt,
         pc->set_measurement_time(static_cast<double>(timestamp) / 1e9);
       }
 
-      float real_distance = raw_distance.raw_distance * DISTANCE_RESOLUTION;
-      float distance = real_distance + corrections.dist_correction;
+      float distance = real_distances[j] + corrections.dist_correction;
 
       if (raw_distance.raw_distance == 0 ||
           !is_scan_valid(raw->blocks[i].rotation, distance)) {
@@ -295,8 +322,9 @@ void Velodyne64Parser::Unpack(const VelodynePacket& pkt,
 
       apollo::drivers::PointXYZIT* point = pc->add_point();
       point->set_timestamp(timestamp);
-      // Position Calculation, append this point to the cloud
-      ComputeCoords(real_distance, corrections, raw->blocks[i].rotation, point);
+      point->set_x(xs[j]);
+      point->set_y(ys[j]);
+      point->set_z(zs[j]);
       point->set_intensity(IntensityCompensate(
           corrections, raw_distance.raw_distance, raw->blocks[i].data[k + 2]));
       // append this point to the cloud
@@ -14,6 +14,8 @@
  * limitations under the License.
  *****************************************************************************/
 
+#include <algorithm>
+
 #include "cyber/cyber.h"
 
 #include "modules/drivers/velodyne/parser/util.h"
@@ -23,6 +25,18 @@ namespace apollo {
 namespace drivers {
 namespace velodyne {
 
+void VelodyneParser::GeneratePointcloud(
+    const std::shared_ptr<VelodyneScan> &scan_msg,
+    std::shared_ptr<PointCloud> out_msg) {
+  if (!BeginScan(*scan_msg, out_msg)) {
+    return;
+  }
+  for (int i = 0; i < scan_msg->firing_pkts_size(); ++i) {
+    ConvertPacket(scan_msg->firing_pkts(i), out_msg);
+  }
+  EndScan(out_msg);
+}
+
 uint64_t VelodyneParser::GetGpsStamp(double current_packet_stamp,
                                      double *previous_packet_stamp,
                                      uint64_t *gps_base_usec) {
@@ -103,6 +117,45 @@ void VelodyneParser::setup() {
   init_angle_params(config_.view_direction(), config_.view_width());
   init_sin_cos_rot_table(sin_rot_table_, cos_rot_table_, ROTATION_MAX_UNITS,
                          ROTATION_RESOLUTION);
+  if (calibration_.initialized_) {
+    InitLaserTable();
+  }
+}
+
+void VelodyneParser::InitLaserTable() {
+  // the missing lasers get zero corrections, as std::map::operator[] gives
+  int size = 128;
+  if (!calibration_.laser_corrections_.empty()) {
+    size = std::max(size, calibration_.laser_corrections_.rbegin()->first + 1);
+  }
+  LaserTable &table = laser_table_;
+  table.corrections.assign(size, LaserCorrection());
+  for (const auto &entry : calibration_.laser_corrections_) {
+    if (entry.first >= 0) {
+      table.corrections[entry.first] = entry.second;
+    }
+  }
+  table.cos_rot.resize(size);
+  table.sin_rot.resize(size);
+  table.cos_vert.resize(size);
+  table.sin_vert.resize(size);
+  table.dist.resize(size);
+  table.dist_x.resize(size);
+  table.dist_y.resize(size);
+  table.vert_offset.resize(size);
+  table.horiz_offset.resize(size);
+  for (int i = 0; i < size; ++i) {
+    const LaserCorrection &corrections = table.corrections[i];
+    table.cos_rot[i] = corrections.cos_rot_correction;
+    table.sin_rot[i] = corrections.sin_rot_correction;
+    table.cos_vert[i] = corrections.cos_vert_correction;
+    table.sin_vert[i] = corrections.sin_vert_correction;
+    table.dist[i] = corrections.dist_correction;
+    table.dist_x[i] = corrections.dist_correction_x;
+    table.dist_y[i] = corrections.dist_correction_y;
+    table.vert_offset[i] = corrections.vert_offset_correction;
+    table.horiz_offset[i] = corrections.horiz_offset_correction;
+  }
 }
 
 bool VelodyneParser::is_scan_valid(int rotation, float range) {
@@ -200,6 +253,62 @@ void VelodyneParser::ComputeCoords(const float &raw_distance,
   point->set_z(static_cast<float>(z));
 }
 
+void VelodyneParser::ComputeBlockCoords(const float *raw_distances,
+                                        const uint16_t *rotations,
+                                        int laser_origin, int num_lasers,
+                                        float *xs, float *ys,
+                                        float *zs) const {
+  const float *cos_rot = laser_table_.cos_rot.data() + laser_origin;
+  const float *sin_rot = laser_table_.sin_rot.data() + laser_origin;
+  const float *cos_vert = laser_table_.cos_vert.data() + laser_origin;
+  const float *sin_vert = laser_table_.sin_vert.data() + laser_origin;
+  const float *dist = laser_table_.dist.data() + laser_origin;
+  const float *dist_x = laser_table_.dist_x.data() + laser_origin;
+  const float *dist_y = laser_table_.dist_y.data() + laser_origin;
+  const float *vert_offset = laser_table_.vert_offset.data() + laser_origin;
+  const float *horiz_offset = laser_table_.horiz_offset.data() + laser_origin;
+  const bool two_pt_correction = need_two_pt_correction_;
+
+  for (int i = 0; i < num_lasers; ++i) {
+    const double raw_distance = raw_distances[i];
+    const double distance = raw_distance + dist[i];
+    const double cos_rot_table = cos_rot_table_[rotations[i]];
+    const double sin_rot_table = sin_rot_table_[rotations[i]];
+    const double cos_rot_angle =
+        cos_rot_table * cos_rot[i] + sin_rot_table * sin_rot[i];
+    const double sin_rot_angle =
+        sin_rot_table * cos_rot[i] - cos_rot_table * sin_rot[i];
+
+    const double horiz = horiz_offset[i];
+
+    double xy_distance = distance * cos_vert[i];
+    const double xx =
+        std::fabs(xy_distance * sin_rot_angle - horiz * cos_rot_angle);
+    const double yy =
+        std::fabs(xy_distance * cos_rot_angle + horiz * sin_rot_angle);
+
+    // select the two points correction instead of branching on it
+    const bool two_pt = two_pt_correction && raw_distance <= 2500;
+    const double distance_corr_x =
+        two_pt ? (dist[i] - dist_x[i]) * (xx - 2.4) / 22.64 + dist_x[i]
+               : static_cast<double>(dist[i]);
+    const double distance_corr_y =
+        two_pt ? (dist[i] - dist_y[i]) * (yy - 1.93) / 23.11 + dist_y[i]
+               : static_cast<double>(dist[i]);
+
+    xy_distance = (raw_distance + distance_corr_x) * cos_vert[i];
+    const double x = xy_distance * sin_rot_angle - horiz * cos_rot_angle;
+    xy_distance = (raw_distance + distance_corr_y) * cos_vert[i];
+    const double y = xy_distance * cos_rot_angle + horiz * sin_rot_angle;
+    const double z = distance * sin_vert[i] + vert_offset[i];
+
+    /** Use standard ROS coordinate system (right-hand rule) */
+    xs[i] = static_cast<float>(y);
+    ys[i] = static_cast<float>(-x);
+    zs[i] = static_cast<float>(z);
+  }
+}
+
 VelodyneParser *VelodyneParserFactory::CreateParser(Config source_config) {
   Config config = source_config;
   if (config.model() == VLP16) {
@@ -56,6 +56,7 @@
 #include <limits>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <boost/format.hpp>
 
@@ -238,7 +239,22 @@ class VelodyneParser {
    *           errno value for failure
    */
   virtual void GeneratePointcloud(const std::shared_ptr<VelodyneScan>& scan_msg,
-                                  std::shared_ptr<PointCloud> out_msg) = 0;
+                                  std::shared_ptr<PointCloud> out_msg);
+
+  /** \brief Convert the packets of a scan one by one as they arrive.
+   *
+   *  BeginScan starts the point cloud of a scan, from its header and base
+   *  time, ConvertPacket appends the points of each packet and EndScan sets
+   *  the scan time. GeneratePointcloud does the same for a whole scan.
+   *
+   *  @returns false if the packets of the scan cannot be converted one by
+   *           one, e.g. the calibration is still to be read from them
+   */
+  virtual bool BeginScan(const VelodyneScan& scan_msg,
+                         std::shared_ptr<PointCloud> out_msg) = 0;
+  virtual void ConvertPacket(const VelodynePacket& pkt,
+                             std::shared_ptr<PointCloud> out_msg) = 0;
+  virtual void EndScan(std::shared_ptr<PointCloud> out_msg) = 0;
   virtual void setup();
   // Order point cloud fod IDL by velodyne model
   virtual void Order(std::shared_ptr<PointCloud> cloud) = 0;
@@ -252,6 +268,25 @@ class VelodyneParser {
   Calibration calibration_;
   float sin_rot_table_[ROTATION_MAX_UNITS];
   float cos_rot_table_[ROTATION_MAX_UNITS];
+
+  /** \brief The corrections of the lasers indexed by laser number.
+   *
+   *  The corrections used to compute the coordinates are also laid out by
+   *  field, so that ComputeBlockCoords reads them contiguously.
+   */
+  struct LaserTable {
+    std::vector<LaserCorrection> corrections;
+    std::vector<float> cos_rot;
+    std::vector<float> sin_rot;
+    std::vector<float> cos_vert;
+    std::vector<float> sin_vert;
+    std::vector<float> dist;
+    std::vector<float> dist_x;
+    std::vector<float> dist_y;
+    std::vector<float> vert_offset;
+    std::vector<float> horiz_offset;
+  };
+  LaserTable laser_table_;
   double last_time_stamp_;
   Config config_;
   // Last Velodyne packet time stamp. (Full time)
@@ -270,6 +305,24 @@ class VelodyneParser {
                      const LaserCorrection& corrections,
                      const uint16_t rotation, PointXYZIT* point);
 
+  /** \brief Fill laser_table_ from calibration_, once it is read. */
+  void InitLaserTable();
+
+  /**
+   * \brief Compute the coords of the points of consecutive lasers, as
+   *        ComputeCoords does. The loop has no branch and reads the
+   *        corrections by field, so that the compiler vectorizes it.
+   *
+   * @param raw_distances The distances of the points, in meters
+   * @param rotations The rotations of the points, in hundredths of degree
+   * @param laser_origin The laser number of the first point
+   * @param xs, ys, zs The coords of the points
+   */
+  void ComputeBlockCoords(const float* raw_distances,
+                          const uint16_t* rotations, int laser_origin,
+                          int num_lasers, float* xs, float* ys,
+                          float* zs) const;
+
   bool is_scan_valid(int rotation, float distance);
 
   /**
@@ -292,7 +345,12 @@ class Velodyne64Parser : public VelodyneParser {
   ~Velodyne64Parser() {}
 
   void GeneratePointcloud(const std::shared_ptr<VelodyneScan>& scan_msg,
-                          std::shared_ptr<PointCloud> out_msg);
+                          std::shared_ptr<PointCloud> out_msg) override;
+  bool BeginScan(const VelodyneScan& scan_msg,
+                 std::shared_ptr<PointCloud> out_msg) override;
+  void ConvertPacket(const VelodynePacket& pkt,
+                     std::shared_ptr<PointCloud> out_msg) override;
+  void EndScan(std::shared_ptr<PointCloud> out_msg) override;
   void Order(std::shared_ptr<PointCloud> cloud);
   void setup() override;
 
@@ -310,6 +368,8 @@ class Velodyne64Parser : public VelodyneParser {
   uint64_t gps_base_usec_[4];  // full time
   bool is_s2_;
   int offsets_[64];
+  // The base time was not ready for a packet of the scan.
+  bool skip_scan_ = false;
 
   OnlineCalibration online_calibration_;
 };  // class Velodyne64Parser
@@ -319,8 +379,11 @@ class Velodyne32Parser : public VelodyneParser {
   explicit Velodyne32Parser(const Config& config);
   ~Velodyne32Parser() {}
 
-  void GeneratePointcloud(const std::shared_ptr<VelodyneScan>& scan_msg,
-                          std::shared_ptr<PointCloud> out_msg);
+  bool BeginScan(const VelodyneScan& scan_msg,
+                 std::shared_ptr<PointCloud> out_msg) override;
+  void ConvertPacket(const VelodynePacket& pkt,
+                     std::shared_ptr<PointCloud> out_msg) override;
+  void EndScan(std::shared_ptr<PointCloud> out_msg) override;
   void Order(std::shared_ptr<PointCloud> cloud);
 
  private:
@@ -338,8 +401,11 @@ class Velodyne16Parser : public VelodyneParser {
   explicit Velodyne16Parser(const Config& config);
   ~Velodyne16Parser() {}
 
-  void GeneratePointcloud(const std::shared_ptr<VelodyneScan>& scan_msg,
-                          std::shared_ptr<PointCloud> out_msg);
+  bool BeginScan(const VelodyneScan& scan_msg,
+                 std::shared_ptr<PointCloud> out_msg) override;
+  void ConvertPacket(const VelodynePacket& pkt,
+                     std::shared_ptr<PointCloud> out_msg) override;
+  void EndScan(std::shared_ptr<PointCloud> out_msg) override;
   void Order(std::shared_ptr<PointCloud> cloud);
 
  private:
@@ -356,8 +422,11 @@ class Velodyne128Parser : public VelodyneParser {
   explicit Velodyne128Parser(const Config& config);
   ~Velodyne128Parser() {}
 
-  void GeneratePointcloud(const std::shared_ptr<VelodyneScan>& scan_msg,
-                          std::shared_ptr<PointCloud> out_msg);
+  bool BeginScan(const VelodyneScan& scan_msg,
+                 std::shared_ptr<PointCloud> out_msg) override;
+  void ConvertPacket(const VelodynePacket& pkt,
+                     std::shared_ptr<PointCloud> out_msg) override;
+  void EndScan(std::shared_ptr<PointCloud> out_msg) override;
   void Order(std::shared_ptr<PointCloud> cloud);
 
  private:
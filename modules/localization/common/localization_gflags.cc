@@ -75,6 +75,16 @@ DEFINE_double(lidar_imu_max_delay_time, 0.4,
               "Lidar msg and imu msg max delay time");
 DEFINE_double(lidar_map_coverage_theshold, 0.9,
               "Threshold to detect whether vehicle is out of map");
+DEFINE_double(lidar_map_preload_time, 2.0,
+              "Preload the map nodes the vehicle will enter in this time "
+              "(seconds), 0 to preload the neighboring nodes only");
+DEFINE_double(lidar_coarse_search_range, 0.0,
+              "Search the lidar position within this range (meters) on the "
+              "coarse map levels before the fine match, 0 to disable");
+DEFINE_int32(lidar_coarse_search_levels, 4,
+             "The number of map levels of the coarse lidar search");
+DEFINE_int32(lidar_coarse_search_candidates, 5,
+             "The number of candidates refined on each coarse search level");
 DEFINE_bool(lidar_debug_log_flag, false, "Lidar Debug switch.");
 DEFINE_int32(point_cloud_step, 2, "Point cloud step");
 DEFINE_bool(if_use_avx, false,
@@ -179,6 +189,11 @@ DEFINE_double(ndt_line_search_step_size, 0.1,
               "line search step size for ndt matching");
 DEFINE_double(ndt_transformation_epsilon, 0.01,
               "iteration convergence condition on transformation");
+DEFINE_int32(ndt_num_threads, 4,
+             "number of threads computing the ndt derivatives");
+DEFINE_bool(ndt_incremental_target, true,
+            "update the ndt target by the map nodes entering and leaving "
+            "the area instead of rebuilding it every frame");
 DEFINE_int32(ndt_filter_size_x, 48, "x size for ndt searching area");
 DEFINE_int32(ndt_filter_size_y, 48, "y size for ndt searching area");
 DEFINE_int32(ndt_bad_score_count_threshold, 10,
@@ -56,6 +56,10 @@ DECLARE_int32(lidar_yaw_align_mode);
 DECLARE_int32(lidar_filter_size);
 DECLARE_double(lidar_imu_max_delay_time);
 DECLARE_double(lidar_map_coverage_theshold);
+DECLARE_double(lidar_map_preload_time);
+DECLARE_double(lidar_coarse_search_range);
+DECLARE_int32(lidar_coarse_search_levels);
+DECLARE_int32(lidar_coarse_search_candidates);
 DECLARE_bool(lidar_debug_log_flag);
 DECLARE_int32(point_cloud_step);
 DECLARE_bool(if_use_avx);
@@ -132,6 +136,8 @@ DECLARE_int32(ndt_max_iterations);
 DECLARE_double(ndt_target_resolution);
 DECLARE_double(ndt_line_search_step_size);
 DECLARE_double(ndt_transformation_epsilon);
+DECLARE_int32(ndt_num_threads);
+DECLARE_bool(ndt_incremental_target);
 DECLARE_int32(ndt_filter_size_x);
 DECLARE_int32(ndt_filter_size_y);
 DECLARE_int32(ndt_bad_score_count_threshold);
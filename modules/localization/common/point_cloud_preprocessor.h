@@ -0,0 +1,219 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Transform, filter and downsample the online lidar points before
+ *        matching, on the coordinate arrays the lidar frames of both
+ *        localization backends keep.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "Eigen/Core"
+#include "Eigen/Geometry"
+
+namespace apollo {
+namespace localization {
+
+/**@brief The points kept by FilterPoints. */
+struct PointFilterParams {
+  /**@brief The range of the points from the sensor origin. */
+  double min_range = 0.0;
+  double max_range = std::numeric_limits<double>::infinity();
+  /**@brief The maximum height of the points in the sensor frame. */
+  double max_height = std::numeric_limits<double>::infinity();
+};
+
+/**
+ * @brief Apply a rigid transform to the points. The loop runs over the
+ *        separate coordinate arrays, so that the compiler vectorizes it.
+ */
+template <typename T>
+void TransformPoints(const Eigen::Affine3d& transform, std::vector<T>* xs,
+                     std::vector<T>* ys, std::vector<T>* zs) {
+  const Eigen::Matrix<T, 3, 3> r = transform.linear().cast<T>();
+  const Eigen::Matrix<T, 3, 1> t = transform.translation().cast<T>();
+  T* x = xs->data();
+  T* y = ys->data();
+  T* z = zs->data();
+  const size_t size = xs->size();
+  for (size_t i = 0; i < size; ++i) {
+    const T px = x[i];
+    const T py = y[i];
+    const T pz = z[i];
+    x[i] = r(0, 0) * px + r(0, 1) * py + r(0, 2) * pz + t(0);
+    y[i] = r(1, 0) * px + r(1, 1) * py + r(1, 2) * pz + t(1);
+    z[i] = r(2, 0) * px + r(2, 1) * py + r(2, 2) * pz + t(2);
+  }
+}
+
+/**
+ * @brief Remove in place the points with a coordinate which is not finite, or
+ *        out of the range or height of the params, keeping the order.
+ * @param intensities The intensities of the points, or nullptr.
+ * @return The number of points kept.
+ */
+template <typename T>
+size_t FilterPoints(const PointFilterParams& params, std::vector<T>* xs,
+                    std::vector<T>* ys, std::vector<T>* zs,
+                    std::vector<unsigned char>* intensities = nullptr) {
+  const double min_range2 = params.min_range * params.min_range;
+  const double max_range2 = params.max_range * params.max_range;
+  T* x = xs->data();
+  T* y = ys->data();
+  T* z = zs->data();
+  unsigned char* intensity = intensities ? intensities->data() : nullptr;
+  const size_t size = xs->size();
+  size_t kept = 0;
+  for (size_t i = 0; i < size; ++i) {
+    const double px = x[i];
+    const double py = y[i];
+    const double pz = z[i];
+    const double range2 = px * px + py * py + pz * pz;
+    // A nan coordinate fails all the comparisons.
+    if (!(range2 >= min_range2 && range2 <= max_range2 &&
+          pz <= params.max_height) ||
+        !std::isfinite(range2)) {
+      continue;
+    }
+    x[kept] = x[i];
+    y[kept] = y[i];
+    z[kept] = z[i];
+    if (intensity) {
+      intensity[kept] = intensity[i];
+    }
+    ++kept;
+  }
+  xs->resize(kept);
+  ys->resize(kept);
+  zs->resize(kept);
+  if (intensities) {
+    intensities->resize(kept);
+  }
+  return kept;
+}
+
+/**
+ * @class VoxelGridDownsampler
+ * @brief Replace the points in each cubic voxel by their centroid, with the
+ *        voxels of pcl::VoxelGrid. The scratch buffers are kept between the
+ *        frames, so that downsampling does not allocate once warmed up.
+ */
+class VoxelGridDownsampler {
+ public:
+  VoxelGridDownsampler() = default;
+  explicit VoxelGridDownsampler(double leaf_size) : leaf_size_(leaf_size) {}
+
+  void SetLeafSize(double leaf_size) { leaf_size_ = leaf_size; }
+  double GetLeafSize() const { return leaf_size_; }
+
+  /**
+   * @brief Downsample the points, sorted by voxel.
+   * @param centroids The centroids of the voxels with points.
+   * @return false if the leaf size is not positive or the points span too many
+   *         voxels to index, the points are then copied as they are.
+   */
+  template <typename T>
+  bool Filter(const std::vector<T>& xs, const std::vector<T>& ys,
+              const std::vector<T>& zs,
+              std::vector<Eigen::Matrix<T, 3, 1>>* centroids) {
+    centroids->clear();
+    const size_t size = xs.size();
+    if (size == 0) {
+      return true;
+    }
+    const double inverse_leaf_size = 1.0 / leaf_size_;
+    T min[3] = {xs[0], ys[0], zs[0]};
+    T max[3] = {xs[0], ys[0], zs[0]};
+    for (size_t i = 1; i < size; ++i) {
+      min[0] = std::min(min[0], xs[i]);
+      min[1] = std::min(min[1], ys[i]);
+      min[2] = std::min(min[2], zs[i]);
+      max[0] = std::max(max[0], xs[i]);
+      max[1] = std::max(max[1], ys[i]);
+      max[2] = std::max(max[2], zs[i]);
+    }
+    int64_t min_index[3];
+    bool indexable = leaf_size_ > 0.0;
+    for (int k = 0; k < 3 && indexable; ++k) {
+      const double low = std::floor(min[k] * inverse_leaf_size);
+      const double high = std::floor(max[k] * inverse_leaf_size);
+      indexable = std::isfinite(low) && std::isfinite(high) &&
+                  high - low < static_cast<double>(kAxisSize);
+      min_index[k] = static_cast<int64_t>(low);
+    }
+    if (!indexable) {
+      centroids->reserve(size);
+      for (size_t i = 0; i < size; ++i) {
+        centroids->emplace_back(xs[i], ys[i], zs[i]);
+      }
+      return false;
+    }
+
+    keys_.resize(size);
+    for (size_t i = 0; i < size; ++i) {
+      const uint64_t ix = static_cast<uint64_t>(
+          static_cast<int64_t>(std::floor(xs[i] * inverse_leaf_size)) -
+          min_index[0]);
+      const uint64_t iy = static_cast<uint64_t>(
+          static_cast<int64_t>(std::floor(ys[i] * inverse_leaf_size)) -
+          min_index[1]);
+      const uint64_t iz = static_cast<uint64_t>(
+          static_cast<int64_t>(std::floor(zs[i] * inverse_leaf_size)) -
+          min_index[2]);
+      keys_[i].first = ix | (iy << kAxisBits) | (iz << (2 * kAxisBits));
+      keys_[i].second = static_cast<uint32_t>(i);
+    }
+    std::sort(keys_.begin(), keys_.end());
+
+    size_t begin = 0;
+    while (begin < size) {
+      size_t end = begin;
+      double sum[3] = {0.0, 0.0, 0.0};
+      for (; end < size && keys_[end].first == keys_[begin].first; ++end) {
+        const uint32_t i = keys_[end].second;
+        sum[0] += xs[i];
+        sum[1] += ys[i];
+        sum[2] += zs[i];
+      }
+      const double count = static_cast<double>(end - begin);
+      centroids->emplace_back(static_cast<T>(sum[0] / count),
+                              static_cast<T>(sum[1] / count),
+                              static_cast<T>(sum[2] / count));
+      begin = end;
+    }
+    return true;
+  }
+
+ private:
+  static constexpr int kAxisBits = 21;
+  static constexpr uint64_t kAxisSize = uint64_t(1) << kAxisBits;
+
+  double leaf_size_ = 1.0;
+  /**@brief The voxel key and the index of each point. */
+  std::vector<std::pair<uint64_t, uint32_t>> keys_;
+};
+
+}  // namespace localization
+}  // namespace apollo
@@ -0,0 +1,101 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/localization/common/point_cloud_preprocessor.h"
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace localization {
+
+TEST(PointCloudPreprocessorTest, TransformPoints) {
+  std::vector<double> xs = {1.0, 0.0};
+  std::vector<double> ys = {0.0, 2.0};
+  std::vector<double> zs = {0.0, 3.0};
+  const Eigen::Affine3d transform =
+      Eigen::Translation3d(10.0, 20.0, 30.0) *
+      Eigen::AngleAxisd(M_PI / 2.0, Eigen::Vector3d::UnitZ());
+  TransformPoints(transform, &xs, &ys, &zs);
+  for (size_t i = 0; i < xs.size(); ++i) {
+    const Eigen::Vector3d expected =
+        transform * Eigen::Vector3d(i == 0 ? 1.0 : 0.0, 2.0 * i, 3.0 * i);
+    EXPECT_NEAR(xs[i], expected(0), 1e-9);
+    EXPECT_NEAR(ys[i], expected(1), 1e-9);
+    EXPECT_NEAR(zs[i], expected(2), 1e-9);
+  }
+}
+
+TEST(PointCloudPreprocessorTest, FilterPoints) {
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+  std::vector<float> xs = {1.0f, nan, 0.1f, 50.0f, 2.0f, 3.0f};
+  std::vector<float> ys = {0.0f, 0.0f, 0.0f, 0.0f, nan, 0.0f};
+  std::vector<float> zs = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 5.0f};
+  std::vector<unsigned char> intensities = {1, 2, 3, 4, 5, 6};
+
+  PointFilterParams params;
+  params.min_range = 0.5;
+  params.max_range = 10.0;
+  params.max_height = 4.0;
+  EXPECT_EQ(FilterPoints(params, &xs, &ys, &zs, &intensities), 1);
+  EXPECT_FLOAT_EQ(xs[0], 1.0f);
+  EXPECT_EQ(intensities[0], 1);
+
+  std::vector<float> xs2 = {1.0f, nan, 3.0f};
+  std::vector<float> ys2 = {0.0f, 0.0f, 0.0f};
+  std::vector<float> zs2 = {0.0f, 0.0f, 200.0f};
+  params = PointFilterParams();
+  params.max_height = 100.0;
+  EXPECT_EQ(FilterPoints(params, &xs2, &ys2, &zs2), 1);
+  EXPECT_EQ(ys2.size(), 1);
+  EXPECT_EQ(zs2.size(), 1);
+}
+
+TEST(PointCloudPreprocessorTest, VoxelGridDownsample) {
+  std::vector<float> xs = {0.1f, 0.3f, -0.2f, 1.5f, 0.2f};
+  std::vector<float> ys = {0.1f, 0.5f, 0.1f, 0.5f, 0.3f};
+  std::vector<float> zs = {0.2f, 0.4f, 0.1f, 0.5f, 0.3f};
+  std::vector<Eigen::Vector3f> centroids;
+  VoxelGridDownsampler downsampler(1.0);
+  EXPECT_TRUE(downsampler.Filter(xs, ys, zs, &centroids));
+  ASSERT_EQ(centroids.size(), 3);
+  EXPECT_NEAR(centroids[0].x(), -0.2f, 1e-6);
+  EXPECT_NEAR(centroids[1].x(), 0.2f, 1e-6);
+  EXPECT_NEAR(centroids[1].y(), 0.3f, 1e-6);
+  EXPECT_NEAR(centroids[1].z(), 0.3f, 1e-6);
+  EXPECT_NEAR(centroids[2].x(), 1.5f, 1e-6);
+
+  // The scratch buffers are reused for a smaller frame.
+  xs.resize(2);
+  ys.resize(2);
+  zs.resize(2);
+  EXPECT_TRUE(downsampler.Filter(xs, ys, zs, &centroids));
+  ASSERT_EQ(centroids.size(), 1);
+  EXPECT_NEAR(centroids[0].x(), 0.2f, 1e-6);
+
+  xs.push_back(1e7f);
+  ys.push_back(0.0f);
+  zs.push_back(0.0f);
+  downsampler.SetLeafSize(0.1);
+  EXPECT_FALSE(downsampler.Filter(xs, ys, zs, &centroids));
+  EXPECT_EQ(centroids.size(), 3);
+}
+
+}  // namespace localization
+}  // namespace apollo
@@ -0,0 +1,177 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief A fixed-size ring of timestamped samples guarded by a seqlock.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "Eigen/Core"
+
+namespace apollo {
+namespace localization {
+
+/**
+ * @class SeqlockRingBuffer
+ * @brief Keeps the latest N samples pushed in time order by a single writer
+ *        thread. Readers on any thread never block the writer: they copy the
+ *        samples they need and retry when a push raced the copy, so T is
+ *        expected to be a plain value type.
+ */
+template <typename T, size_t N>
+class SeqlockRingBuffer {
+ public:
+  struct Sample {
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+    double timestamp = 0.0;
+    T value;
+  };
+
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  /**
+   * @brief Append a sample, dropping the oldest one when the ring is full.
+   *        Only one thread may push.
+   * @return false if the sample is older than the latest one, it is dropped.
+   */
+  bool Push(double timestamp, const T& value) {
+    const uint64_t count = count_.load(std::memory_order_relaxed);
+    if (count > 0 && timestamp < samples_[(count - 1) % N].timestamp) {
+      return false;
+    }
+    const uint64_t sequence = sequence_.load(std::memory_order_relaxed);
+    sequence_.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    Sample& sample = samples_[count % N];
+    sample.timestamp = timestamp;
+    sample.value = value;
+    count_.store(count + 1, std::memory_order_relaxed);
+    sequence_.store(sequence + 2, std::memory_order_release);
+    return true;
+  }
+
+  /**@brief Remove all the samples, from the writer thread. */
+  void Clear() {
+    const uint64_t sequence = sequence_.load(std::memory_order_relaxed);
+    sequence_.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    count_.store(0, std::memory_order_relaxed);
+    sequence_.store(sequence + 2, std::memory_order_release);
+  }
+
+  /**@brief The number of samples in the ring. */
+  size_t Size() const {
+    return static_cast<size_t>(
+        std::min<uint64_t>(count_.load(std::memory_order_acquire), N));
+  }
+
+  /**@brief The number of samples pushed since the ring was cleared. */
+  uint64_t TotalCount() const {
+    return count_.load(std::memory_order_acquire);
+  }
+
+  /**@brief Get the latest sample. */
+  bool GetLatest(Sample* sample) const {
+    return Read([this, sample](uint64_t count) {
+      if (count == 0) {
+        return false;
+      }
+      *sample = samples_[(count - 1) % N];
+      return true;
+    });
+  }
+
+  /**
+   * @brief Copy the samples from the oldest to the latest.
+   * @param samples An array of at least N samples.
+   * @return The number of samples copied.
+   */
+  size_t GetSamples(Sample* samples) const {
+    size_t size = 0;
+    Read([this, samples, &size](uint64_t count) {
+      size = static_cast<size_t>(std::min<uint64_t>(count, N));
+      for (size_t i = 0; i < size; ++i) {
+        samples[i] = samples_[(count - size + i) % N];
+      }
+      return true;
+    });
+    return size;
+  }
+
+  /**
+   * @brief Binary search the two consecutive samples around a timestamp, to
+   *        interpolate between them.
+   * @param before The latest sample older than the timestamp.
+   * @param after The sample following it, not older than the timestamp.
+   * @return false if the timestamp is not within the samples in the ring.
+   */
+  bool FindBracket(double timestamp, Sample* before, Sample* after) const {
+    return Read([this, timestamp, before, after](uint64_t count) {
+      const uint64_t size = std::min<uint64_t>(count, N);
+      const uint64_t oldest = count - size;
+      // The first sample not older than the timestamp.
+      uint64_t low = 0;
+      uint64_t high = size;
+      while (low < high) {
+        const uint64_t middle = low + (high - low) / 2;
+        if (samples_[(oldest + middle) % N].timestamp < timestamp) {
+          low = middle + 1;
+        } else {
+          high = middle;
+        }
+      }
+      if (low == 0 || low == size) {
+        return false;
+      }
+      *before = samples_[(oldest + low - 1) % N];
+      *after = samples_[(oldest + low) % N];
+      return true;
+    });
+  }
+
+ private:
+  /**@brief Run a copying function on a consistent view of the ring, given the
+   * number of samples pushed, until no push raced it. */
+  template <typename Function>
+  bool Read(Function function) const {
+    while (true) {
+      const uint64_t sequence = sequence_.load(std::memory_order_acquire);
+      if (sequence & 1) {
+        continue;
+      }
+      const bool result = function(count_.load(std::memory_order_relaxed));
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (sequence_.load(std::memory_order_relaxed) == sequence) {
+        return result;
+      }
+    }
+  }
+
+  /**@brief Odd while a push is in progress. */
+  std::atomic<uint64_t> sequence_{0};
+  std::atomic<uint64_t> count_{0};
+  Sample samples_[N];
+};
+
+}  // namespace localization
+}  // namespace apollo
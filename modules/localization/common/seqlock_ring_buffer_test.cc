@@ -0,0 +1,102 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/localization/common/seqlock_ring_buffer.h"
+
+#include <atomic>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace localization {
+
+namespace {
+
+struct Value {
+  double a = 0.0;
+  double b = 0.0;
+};
+
+}  // namespace
+
+TEST(SeqlockRingBufferTest, PushAndFind) {
+  SeqlockRingBuffer<Value, 4> buffer;
+  SeqlockRingBuffer<Value, 4>::Sample before;
+  SeqlockRingBuffer<Value, 4>::Sample after;
+  EXPECT_EQ(buffer.Size(), 0);
+  EXPECT_FALSE(buffer.GetLatest(&before));
+  EXPECT_FALSE(buffer.FindBracket(1.0, &before, &after));
+
+  for (int i = 1; i <= 6; ++i) {
+    EXPECT_TRUE(buffer.Push(static_cast<double>(i), Value{i * 1.0, i * 2.0}));
+  }
+  EXPECT_FALSE(buffer.Push(5.5, Value()));
+  EXPECT_EQ(buffer.Size(), 4);
+  EXPECT_EQ(buffer.TotalCount(), 6);
+
+  EXPECT_TRUE(buffer.GetLatest(&after));
+  EXPECT_DOUBLE_EQ(after.timestamp, 6.0);
+
+  SeqlockRingBuffer<Value, 4>::Sample samples[4];
+  EXPECT_EQ(buffer.GetSamples(samples), 4);
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_DOUBLE_EQ(samples[i].timestamp, 3.0 + i);
+  }
+
+  EXPECT_TRUE(buffer.FindBracket(4.5, &before, &after));
+  EXPECT_DOUBLE_EQ(before.timestamp, 4.0);
+  EXPECT_DOUBLE_EQ(after.timestamp, 5.0);
+  EXPECT_DOUBLE_EQ(after.value.b, 10.0);
+  EXPECT_TRUE(buffer.FindBracket(6.0, &before, &after));
+  EXPECT_DOUBLE_EQ(before.timestamp, 5.0);
+  EXPECT_DOUBLE_EQ(after.timestamp, 6.0);
+  EXPECT_FALSE(buffer.FindBracket(3.0, &before, &after));
+  EXPECT_FALSE(buffer.FindBracket(6.5, &before, &after));
+}
+
+TEST(SeqlockRingBufferTest, ConcurrentReaders) {
+  SeqlockRingBuffer<Value, 16> buffer;
+  std::atomic<bool> done(false);
+  std::atomic<int> num_torn(0);
+  auto reader = [&]() {
+    SeqlockRingBuffer<Value, 16>::Sample before;
+    SeqlockRingBuffer<Value, 16>::Sample after;
+    while (!done) {
+      if (buffer.GetLatest(&after) &&
+          after.value.b != after.value.a * 2.0) {
+        ++num_torn;
+      }
+      if (buffer.FindBracket(after.timestamp - 2.5, &before, &after) &&
+          (after.timestamp - before.timestamp != 1.0 ||
+           before.value.a != before.timestamp)) {
+        ++num_torn;
+      }
+    }
+  };
+  std::thread reader1(reader);
+  std::thread reader2(reader);
+  for (int i = 0; i < 100000; ++i) {
+    buffer.Push(static_cast<double>(i), Value{i * 1.0, i * 2.0});
+  }
+  done = true;
+  reader1.join();
+  reader2.join();
+  EXPECT_EQ(num_torn, 0);
+}
+
+}  // namespace localization
+}  // namespace apollo
@@ -16,11 +16,13 @@
 
 #include "modules/localization/msf/common/util/compression.h"
 
+#include <cstdint>
 #include <cstring>
 
 #include <zlib.h>
 
 #include "cyber/common/log.h"
+#include "lz4.h"
 
 namespace apollo {
 namespace localization {
@@ -154,6 +156,55 @@ int ZlibStrategy::ZlibUncompress(BufferStr* src, BufferStr* dst) {
   return ret == Z_STREAM_END ? Z_OK : Z_DATA_ERROR;
 }
 
+const unsigned char Lz4Strategy::magic[4] = {'L', 'Z', '4', 'M'};
+const size_t Lz4Strategy::header_size = sizeof(magic) + sizeof(uint32_t);
+
+int Lz4Strategy::Encode(BufferStr* buf, BufferStr* buf_compressed) {
+  const int src_size = static_cast<int>(buf->size());
+  const int bound = LZ4_compressBound(src_size);
+  if (bound <= 0) {
+    return -1;
+  }
+  buf_compressed->resize(header_size + bound);
+  std::memcpy(&(*buf_compressed)[0], magic, sizeof(magic));
+  const uint32_t uncompressed_size = static_cast<uint32_t>(src_size);
+  std::memcpy(&(*buf_compressed)[sizeof(magic)], &uncompressed_size,
+              sizeof(uncompressed_size));
+  const int size = LZ4_compress_default(
+      reinterpret_cast<const char*>(buf->data()),
+      reinterpret_cast<char*>(&(*buf_compressed)[header_size]), src_size,
+      bound);
+  if (size <= 0) {
+    return -1;
+  }
+  buf_compressed->resize(header_size + size);
+  return 0;
+}
+
+int Lz4Strategy::Decode(BufferStr* buf, BufferStr* buf_uncompressed) {
+  if (!IsEncoded(*buf)) {
+    return -1;
+  }
+  uint32_t uncompressed_size = 0;
+  std::memcpy(&uncompressed_size, &(*buf)[sizeof(magic)],
+              sizeof(uncompressed_size));
+  buf_uncompressed->resize(uncompressed_size);
+  const int size = LZ4_decompress_safe(
+      reinterpret_cast<const char*>(&(*buf)[header_size]),
+      reinterpret_cast<char*>(buf_uncompressed->data()),
+      static_cast<int>(buf->size() - header_size),
+      static_cast<int>(uncompressed_size));
+  if (size < 0 || static_cast<uint32_t>(size) != uncompressed_size) {
+    return -1;
+  }
+  return 0;
+}
+
+bool Lz4Strategy::IsEncoded(const BufferStr& buf) {
+  return buf.size() >= header_size &&
+         std::memcmp(buf.data(), magic, sizeof(magic)) == 0;
+}
+
 }  // namespace msf
 }  // namespace localization
 }  // namespace apollo
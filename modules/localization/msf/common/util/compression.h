@@ -43,6 +43,22 @@ class ZlibStrategy : public CompressionStrategy {
   int ZlibUncompress(BufferStr* src, BufferStr* dst);
 };
 
+/**@brief LZ4 block compression, an order of magnitude faster to decode than
+ * zlib at a lower ratio. The encoded buffer starts with a magic number and the
+ * uncompressed size, so it is told apart from a zlib stream. */
+class Lz4Strategy : public CompressionStrategy {
+ public:
+  virtual int Encode(BufferStr* buf, BufferStr* buf_compressed);
+  virtual int Decode(BufferStr* buf, BufferStr* buf_uncompressed);
+
+  /**@brief Check if the buffer is encoded by Lz4Strategy. */
+  static bool IsEncoded(const BufferStr& buf);
+
+ protected:
+  static const unsigned char magic[4];
+  static const size_t header_size;
+};
+
 }  // namespace msf
 }  // namespace localization
 }  // namespace apollo
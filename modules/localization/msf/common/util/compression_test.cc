@@ -39,6 +39,28 @@ TEST(CompressionTestSuite, ZlibStrategyTest) {
   }
 }
 
+TEST(CompressionTestSuite, Lz4StrategyTest) {
+  Lz4Strategy lz4;
+  std::vector<unsigned char> buf_uncompressed;
+  std::vector<unsigned char> buf_compressed;
+  for (int i = 0; i < 4096; i++) {
+    buf_uncompressed.push_back((unsigned char)(i % 64));
+  }
+
+  std::vector<unsigned char> buf_uncompressed2;
+  EXPECT_EQ(lz4.Encode(&buf_uncompressed, &buf_compressed), 0);
+  EXPECT_TRUE(Lz4Strategy::IsEncoded(buf_compressed));
+  EXPECT_LT(buf_compressed.size(), buf_uncompressed.size());
+  EXPECT_EQ(lz4.Decode(&buf_compressed, &buf_uncompressed2), 0);
+  EXPECT_EQ(buf_uncompressed2, buf_uncompressed);
+
+  // a zlib stream is not taken for lz4
+  ZlibStrategy zlib;
+  zlib.Encode(&buf_uncompressed, &buf_compressed);
+  EXPECT_FALSE(Lz4Strategy::IsEncoded(buf_compressed));
+  EXPECT_LT(lz4.Decode(&buf_compressed, &buf_uncompressed2), 0);
+}
+
 }  // namespace msf
 }  // namespace localization
 }  // namespace apollo
@@ -0,0 +1,254 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/localization/msf/local_integ/coarse_to_fine_matcher.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <utility>
+
+namespace apollo {
+namespace localization {
+namespace msf {
+
+namespace {
+
+// The index of the cell of the next level containing a cell, rounded down.
+int ParentIndex(int index) { return index >= 0 ? index / 2 : (index - 1) / 2; }
+
+int64_t CellKey(int x, int y) {
+  return (static_cast<int64_t>(y) << 32) |
+         static_cast<int64_t>(static_cast<uint32_t>(x));
+}
+
+}  // namespace
+
+void CoarseToFineMatcher::Init(int num_levels, int num_candidates,
+                               double min_overlap) {
+  num_levels_ = std::max(num_levels, 1);
+  num_candidates_ = std::max(num_candidates, 1);
+  min_overlap_ = min_overlap;
+}
+
+void CoarseToFineMatcher::SetMap(const Eigen::Vector2d& left_top_corner,
+                                 double resolution, int width, int height,
+                                 const float* intensities,
+                                 const unsigned int* counts) {
+  left_top_corner_ = left_top_corner;
+  resolution_ = resolution;
+  map_levels_.resize(num_levels_);
+
+  MapLevel& finest = map_levels_[0];
+  finest.width = width;
+  finest.height = height;
+  finest.intensities.assign(intensities, intensities + width * height);
+  finest.counts.assign(counts, counts + width * height);
+
+  // Each cell of a level averages the samples of four cells of the previous
+  // one, as the levels of the pyramid map nodes do.
+  for (int level = 1; level < num_levels_; ++level) {
+    const MapLevel& fine = map_levels_[level - 1];
+    MapLevel& coarse = map_levels_[level];
+    coarse.width = (fine.width + 1) / 2;
+    coarse.height = (fine.height + 1) / 2;
+    coarse.intensities.assign(coarse.width * coarse.height, 0.0f);
+    coarse.counts.assign(coarse.width * coarse.height, 0);
+    for (int y = 0; y < fine.height; ++y) {
+      const int coarse_row = (y / 2) * coarse.width;
+      const int fine_row = y * fine.width;
+      for (int x = 0; x < fine.width; ++x) {
+        const unsigned int count = fine.counts[fine_row + x];
+        coarse.intensities[coarse_row + x / 2] +=
+            fine.intensities[fine_row + x] * static_cast<float>(count);
+        coarse.counts[coarse_row + x / 2] += count;
+      }
+    }
+    for (size_t i = 0; i < coarse.counts.size(); ++i) {
+      if (coarse.counts[i] > 0) {
+        coarse.intensities[i] /= static_cast<float>(coarse.counts[i]);
+      }
+    }
+  }
+}
+
+bool CoarseToFineMatcher::Match(const std::vector<double>& xs,
+                                const std::vector<double>& ys,
+                                const std::vector<unsigned char>& intensities,
+                                double search_range, Eigen::Vector2d* offset) {
+  if (map_levels_.empty() || xs.empty()) {
+    return false;
+  }
+  ComputeOnlineLevels(xs, ys, intensities);
+
+  const int range =
+      std::max(static_cast<int>(std::ceil(search_range / resolution_)), 0);
+  const int top = num_levels_ - 1;
+  const int top_range = (range + (1 << top) - 1) >> top;
+  candidates_.clear();
+  for (int y = -top_range; y <= top_range; ++y) {
+    for (int x = -top_range; x <= top_range; ++x) {
+      Candidate candidate;
+      candidate.x = x;
+      candidate.y = y;
+      candidate.cost = ComputeCost(top, x, y);
+      candidates_.push_back(candidate);
+    }
+  }
+  KeepBestCandidates(&candidates_);
+
+  // An offset of a level spans the offsets around its double on the finer
+  // level.
+  for (int level = top - 1; level >= 0; --level) {
+    const int level_range = (range + (1 << level) - 1) >> level;
+    refined_candidates_.clear();
+    for (const Candidate& coarse : candidates_) {
+      for (int y = 2 * coarse.y - 1; y <= 2 * coarse.y + 1; ++y) {
+        for (int x = 2 * coarse.x - 1; x <= 2 * coarse.x + 1; ++x) {
+          if (std::abs(x) > level_range || std::abs(y) > level_range) {
+            continue;
+          }
+          Candidate candidate;
+          candidate.x = x;
+          candidate.y = y;
+          refined_candidates_.push_back(candidate);
+        }
+      }
+    }
+    std::sort(refined_candidates_.begin(), refined_candidates_.end(),
+              [](const Candidate& a, const Candidate& b) {
+                return CellKey(a.x, a.y) < CellKey(b.x, b.y);
+              });
+    refined_candidates_.erase(
+        std::unique(refined_candidates_.begin(), refined_candidates_.end(),
+                    [](const Candidate& a, const Candidate& b) {
+                      return a.x == b.x && a.y == b.y;
+                    }),
+        refined_candidates_.end());
+    for (Candidate& candidate : refined_candidates_) {
+      candidate.cost = ComputeCost(level, candidate.x, candidate.y);
+    }
+    KeepBestCandidates(&refined_candidates_);
+    std::swap(candidates_, refined_candidates_);
+  }
+
+  if (candidates_.empty()) {
+    return false;
+  }
+  const Candidate& best = candidates_.front();
+  *offset = Eigen::Vector2d(best.x * resolution_, best.y * resolution_);
+  best_cost_ = best.cost;
+  return true;
+}
+
+void CoarseToFineMatcher::ComputeOnlineLevels(
+    const std::vector<double>& xs, const std::vector<double>& ys,
+    const std::vector<unsigned char>& intensities) {
+  online_levels_.resize(num_levels_);
+  online_count_ = static_cast<unsigned int>(xs.size());
+
+  // Sort the cells by their key to average the ones at the same place.
+  keyed_cells_.clear();
+  for (size_t i = 0; i < xs.size(); ++i) {
+    Cell cell;
+    cell.x = static_cast<int>(
+        std::floor((xs[i] - left_top_corner_[0]) / resolution_));
+    cell.y = static_cast<int>(
+        std::floor((ys[i] - left_top_corner_[1]) / resolution_));
+    cell.intensity = static_cast<float>(intensities[i]);
+    cell.count = 1;
+    keyed_cells_.emplace_back(CellKey(cell.x, cell.y), cell);
+  }
+
+  for (int level = 0; level < num_levels_; ++level) {
+    if (level > 0) {
+      keyed_cells_.clear();
+      for (Cell cell : online_levels_[level - 1]) {
+        cell.x = ParentIndex(cell.x);
+        cell.y = ParentIndex(cell.y);
+        keyed_cells_.emplace_back(CellKey(cell.x, cell.y), cell);
+      }
+    }
+    std::sort(keyed_cells_.begin(), keyed_cells_.end(),
+              [](const std::pair<int64_t, Cell>& a,
+                 const std::pair<int64_t, Cell>& b) {
+                return a.first < b.first;
+              });
+
+    std::vector<Cell>& cells = online_levels_[level];
+    cells.clear();
+    for (size_t begin = 0; begin < keyed_cells_.size();) {
+      Cell cell = keyed_cells_[begin].second;
+      double sum = static_cast<double>(cell.intensity) * cell.count;
+      size_t end = begin + 1;
+      for (; end < keyed_cells_.size() &&
+             keyed_cells_[end].first == keyed_cells_[begin].first;
+           ++end) {
+        const Cell& other = keyed_cells_[end].second;
+        sum += static_cast<double>(other.intensity) * other.count;
+        cell.count += other.count;
+      }
+      cell.intensity = static_cast<float>(sum / cell.count);
+      cells.push_back(cell);
+      begin = end;
+    }
+  }
+}
+
+double CoarseToFineMatcher::ComputeCost(int level, int offset_x,
+                                        int offset_y) const {
+  const MapLevel& map = map_levels_[level];
+  double sum = 0.0;
+  unsigned int count = 0;
+  for (const Cell& cell : online_levels_[level]) {
+    const int x = cell.x + offset_x;
+    const int y = cell.y + offset_y;
+    if (x < 0 || y < 0 || x >= map.width || y >= map.height) {
+      continue;
+    }
+    const int index = y * map.width + x;
+    if (map.counts[index] == 0) {
+      continue;
+    }
+    const double diff = cell.intensity - map.intensities[index];
+    sum += diff * diff * cell.count;
+    count += cell.count;
+  }
+  if (count == 0 || count < min_overlap_ * online_count_) {
+    return -1.0;
+  }
+  return sum / count;
+}
+
+void CoarseToFineMatcher::KeepBestCandidates(
+    std::vector<Candidate>* candidates) const {
+  candidates->erase(
+      std::remove_if(candidates->begin(), candidates->end(),
+                     [](const Candidate& c) { return c.cost < 0.0; }),
+      candidates->end());
+  const size_t size =
+      std::min(candidates->size(), static_cast<size_t>(num_candidates_));
+  std::partial_sort(candidates->begin(), candidates->begin() + size,
+                    candidates->end(),
+                    [](const Candidate& a, const Candidate& b) {
+                      return a.cost < b.cost;
+                    });
+  candidates->resize(size);
+}
+
+}  // namespace msf
+}  // namespace localization
+}  // namespace apollo
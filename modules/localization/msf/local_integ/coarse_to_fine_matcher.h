@@ -0,0 +1,136 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file coarse_to_fine_matcher.h
+ * @brief The class of CoarseToFineMatcher
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "Eigen/Core"
+
+/**
+ * @namespace apollo::localization::msf
+ * @brief apollo::localization::msf
+ */
+namespace apollo {
+namespace localization {
+namespace msf {
+
+/**
+ * @class CoarseToFineMatcher
+ * @brief Search the horizontal offset of the online points on the intensity
+ *        map with a pyramid of resolutions: the whole window is evaluated on
+ *        the coarsest level, and only the best candidates are refined on the
+ *        finer levels. The cost of a wide window then grows with the coarse
+ *        cells it spans instead of the map cells.
+ */
+class CoarseToFineMatcher {
+ public:
+  /**@brief An offset in map cells of a level, and its matching cost. */
+  struct Candidate {
+    int x = 0;
+    int y = 0;
+    double cost = 0.0;
+  };
+
+  CoarseToFineMatcher() = default;
+
+  /**
+   * @brief Set the search parameters.
+   * @param num_levels The number of levels, each level halves the resolution
+   *        of the previous one.
+   * @param num_candidates The number of candidates refined on each level.
+   * @param min_overlap The minimum ratio of the online points on observed map
+   *        cells for an offset to be valid.
+   */
+  void Init(int num_levels, int num_candidates, double min_overlap = 0.5);
+
+  /**
+   * @brief Set the map to match on, and build its coarser levels.
+   * @param left_top_corner The coordinate of the corner of the cell (0, 0).
+   * @param resolution The size of the map cells, in meters.
+   * @param intensities The mean intensities of the cells, row by row.
+   * @param counts The number of samples of the cells, row by row.
+   */
+  void SetMap(const Eigen::Vector2d& left_top_corner, double resolution,
+              int width, int height, const float* intensities,
+              const unsigned int* counts);
+
+  /**
+   * @brief Search the offset of the points in the map frame.
+   * @param search_range The maximum offset along each axis, in meters.
+   * @param offset The offset to add to the points to match the map.
+   * @return false if no offset in the range overlaps the map enough.
+   */
+  bool Match(const std::vector<double>& xs, const std::vector<double>& ys,
+             const std::vector<unsigned char>& intensities,
+             double search_range, Eigen::Vector2d* offset);
+
+  /**@brief The cost of the offset found by the last match. */
+  double GetBestCost() const { return best_cost_; }
+
+ private:
+  struct Cell {
+    int x = 0;
+    int y = 0;
+    float intensity = 0.0f;
+    unsigned int count = 0;
+  };
+
+  struct MapLevel {
+    int width = 0;
+    int height = 0;
+    std::vector<float> intensities;
+    std::vector<unsigned int> counts;
+  };
+
+  /**@brief Average the online points in the cells of each level. */
+  void ComputeOnlineLevels(const std::vector<double>& xs,
+                           const std::vector<double>& ys,
+                           const std::vector<unsigned char>& intensities);
+
+  /**@brief The mean squared intensity difference of the online cells shifted
+   * by the offset of a candidate, or a negative value if they do not overlap
+   * the map enough. */
+  double ComputeCost(int level, int offset_x, int offset_y) const;
+
+  /**@brief Keep the num_candidates_ valid candidates of least cost. */
+  void KeepBestCandidates(std::vector<Candidate>* candidates) const;
+
+  int num_levels_ = 3;
+  int num_candidates_ = 5;
+  double min_overlap_ = 0.5;
+
+  Eigen::Vector2d left_top_corner_ = Eigen::Vector2d::Zero();
+  double resolution_ = 0.125;
+  std::vector<MapLevel> map_levels_;
+  std::vector<std::vector<Cell>> online_levels_;
+  std::vector<std::pair<int64_t, Cell>> keyed_cells_;
+  unsigned int online_count_ = 0;
+  std::vector<Candidate> candidates_;
+  std::vector<Candidate> refined_candidates_;
+  double best_cost_ = 0.0;
+};
+
+}  // namespace msf
+}  // namespace localization
+}  // namespace apollo
@@ -0,0 +1,92 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/localization/msf/local_integ/coarse_to_fine_matcher.h"
+
+#include <cmath>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace localization {
+namespace msf {
+
+namespace {
+
+constexpr int kMapSize = 256;
+constexpr double kResolution = 0.125;
+
+float MapIntensity(int x, int y) {
+  return static_cast<float>(100.0 + 50.0 * std::sin(x / 7.0) +
+                            50.0 * std::cos(y / 11.0) +
+                            ((x / 16 + y / 24) % 3) * 20.0);
+}
+
+}  // namespace
+
+TEST(CoarseToFineMatcherTest, FindOffset) {
+  const Eigen::Vector2d left_top_corner(1000.0, 2000.0);
+  std::vector<float> intensities(kMapSize * kMapSize);
+  std::vector<unsigned int> counts(kMapSize * kMapSize, 1);
+  for (int y = 0; y < kMapSize; ++y) {
+    for (int x = 0; x < kMapSize; ++x) {
+      intensities[y * kMapSize + x] = MapIntensity(x, y);
+    }
+  }
+  CoarseToFineMatcher matcher;
+  matcher.Init(3, 5);
+  matcher.SetMap(left_top_corner, kResolution, kMapSize, kMapSize,
+                 intensities.data(), counts.data());
+
+  // The points of the cells in the middle of the map, displaced by the
+  // opposite of the offset.
+  const Eigen::Vector2d expected_offset(11 * kResolution, -6 * kResolution);
+  std::vector<double> xs;
+  std::vector<double> ys;
+  std::vector<unsigned char> point_intensities;
+  for (int y = 64; y < 192; ++y) {
+    for (int x = 64; x < 192; ++x) {
+      xs.push_back(left_top_corner[0] + (x + 0.5) * kResolution -
+                   expected_offset[0]);
+      ys.push_back(left_top_corner[1] + (y + 0.5) * kResolution -
+                   expected_offset[1]);
+      point_intensities.push_back(
+          static_cast<unsigned char>(MapIntensity(x, y)));
+    }
+  }
+
+  Eigen::Vector2d offset;
+  ASSERT_TRUE(matcher.Match(xs, ys, point_intensities, 3.0, &offset));
+  EXPECT_NEAR(offset[0], expected_offset[0], 1e-9);
+  EXPECT_NEAR(offset[1], expected_offset[1], 1e-9);
+  EXPECT_LT(matcher.GetBestCost(), 1.0);
+
+  // The offset is out of a narrower search range.
+  ASSERT_TRUE(matcher.Match(xs, ys, point_intensities, 0.5, &offset));
+  EXPECT_LE(std::abs(offset[0]), 0.5);
+  EXPECT_GT(matcher.GetBestCost(), 1.0);
+
+  // Points out of the map do not match.
+  for (double& x : xs) {
+    x += 1000.0;
+  }
+  EXPECT_FALSE(matcher.Match(xs, ys, point_intensities, 3.0, &offset));
+}
+
+}  // namespace msf
+}  // namespace localization
+}  // namespace apollo
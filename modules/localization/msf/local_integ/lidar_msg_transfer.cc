@@ -16,12 +16,12 @@
 
 #include "modules/localization/msf/local_integ/lidar_msg_transfer.h"
 
-#include "Eigen/Core"
-#include "Eigen/Geometry"
+#include <algorithm>
 
 #include "cyber/common/log.h"
 #include "cyber/time/time.h"
 #include "modules/localization/common/localization_gflags.h"
+#include "modules/localization/common/point_cloud_preprocessor.h"
 
 namespace apollo {
 namespace localization {
@@ -31,51 +31,32 @@ void LidarMsgTransfer::Transfer(const drivers::PointCloud &msg,
                                 LidarFrame *lidar_frame) {
   CHECK_NOTNULL(lidar_frame);
 
+  int num_points = msg.point_size();
   if (msg.height() > 1 && msg.width() > 1) {
-    for (unsigned int i = 0; i < msg.height(); ++i) {
-      for (unsigned int j = 0; j < msg.width(); ++j) {
-        Eigen::Vector3d pt3d;
-        pt3d[0] = static_cast<double>(msg.point(i * msg.width() + j).x());
-        pt3d[1] = static_cast<double>(msg.point(i * msg.width() + j).y());
-        pt3d[2] = static_cast<double>(msg.point(i * msg.width() + j).z());
-        if (!std::isnan(pt3d[0])) {
-          Eigen::Vector3d pt3d_tem = pt3d;
-
-          if (pt3d_tem[2] > max_height_) {
-            continue;
-          }
-          unsigned char intensity = static_cast<unsigned char>(
-              msg.point(i * msg.width() + j).intensity());
-          lidar_frame->pt_xs.push_back(pt3d[0]);
-          lidar_frame->pt_ys.push_back(pt3d[1]);
-          lidar_frame->pt_zs.push_back(pt3d[2]);
-          lidar_frame->intensities.push_back(intensity);
-        }
-      }
-    }
+    num_points = std::min(num_points,
+                          static_cast<int>(msg.height() * msg.width()));
   } else {
     AINFO << "Receiving un-organized-point-cloud, width " << msg.width()
           << " height " << msg.height() << "size " << msg.point_size();
-    for (int i = 0; i < msg.point_size(); ++i) {
-      Eigen::Vector3d pt3d;
-      pt3d[0] = static_cast<double>(msg.point(i).x());
-      pt3d[1] = static_cast<double>(msg.point(i).y());
-      pt3d[2] = static_cast<double>(msg.point(i).z());
-      if (!std::isnan(pt3d[0])) {
-        Eigen::Vector3d pt3d_tem = pt3d;
+  }
 
-        if (pt3d_tem[2] > max_height_) {
-          continue;
-        }
-        unsigned char intensity =
-            static_cast<unsigned char>(msg.point(i).intensity());
-        lidar_frame->pt_xs.push_back(pt3d[0]);
-        lidar_frame->pt_ys.push_back(pt3d[1]);
-        lidar_frame->pt_zs.push_back(pt3d[2]);
-        lidar_frame->intensities.push_back(intensity);
-      }
-    }
+  // Copy all the points at once, then drop the invalid ones in place.
+  lidar_frame->pt_xs.resize(num_points);
+  lidar_frame->pt_ys.resize(num_points);
+  lidar_frame->pt_zs.resize(num_points);
+  lidar_frame->intensities.resize(num_points);
+  for (int i = 0; i < num_points; ++i) {
+    const drivers::PointXYZIT &point = msg.point(i);
+    lidar_frame->pt_xs[i] = static_cast<double>(point.x());
+    lidar_frame->pt_ys[i] = static_cast<double>(point.y());
+    lidar_frame->pt_zs[i] = static_cast<double>(point.z());
+    lidar_frame->intensities[i] =
+        static_cast<unsigned char>(point.intensity());
   }
+  PointFilterParams filter_params;
+  filter_params.max_height = max_height_;
+  FilterPoints(filter_params, &lidar_frame->pt_xs, &lidar_frame->pt_ys,
+               &lidar_frame->pt_zs, &lidar_frame->intensities);
 
   lidar_frame->measurement_time =
       cyber::Time(msg.measurement_time()).ToSecond();
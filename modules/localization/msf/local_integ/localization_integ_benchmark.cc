@@ -0,0 +1,188 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/*
+ * @file
+ * Times composing the integrated localization of one imu sample, as
+ * LocalizationIntegImpl::ImuProcessImpl and MSFLocalization::OnRawImu do at
+ * the imu rate, with a fresh message per sample against a reused one. The
+ * sins integration itself lives in the prebuilt local_integ library and is not
+ * part of the timing.
+ *
+ *   localization_integ_benchmark [num_samples] [iterations]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "Eigen/Geometry"
+
+#include "modules/localization/msf/common/util/frame_transform.h"
+#include "modules/localization/msf/local_integ/localization_params.h"
+
+namespace apollo {
+namespace localization {
+namespace msf {
+
+struct Sample {
+  double time = 0.0;
+  double longitude = 0.0;
+  double latitude = 0.0;
+  double height = 0.0;
+  double yaw = 0.0;
+  double speed = 0.0;
+  // Specific force and angular rate of the body, as the imu measures them.
+  double acceleration[3] = {0.1, 0.4, 9.8};
+  double angular_velocity[3] = {0.0, 0.0, 0.04};
+};
+
+// A vehicle turning slowly at 10 m/s, sampled at 200 Hz.
+std::vector<Sample> Samples(const int num_samples) {
+  std::vector<Sample> samples(num_samples);
+  for (int i = 0; i < num_samples; ++i) {
+    Sample& sample = samples[i];
+    sample.time = 1.6e9 + 0.005 * i;
+    sample.yaw = 0.0002 * i;
+    sample.longitude = 2.0313 + 1.5e-8 * i * std::cos(sample.yaw);
+    sample.latitude = 0.6964 + 1.5e-8 * i * std::sin(sample.yaw);
+    sample.height = 40.0;
+    sample.speed = 10.0;
+  }
+  return samples;
+}
+
+// Fill the fields LocalizationIntegProcess::GetResult, the expert and
+// ImuProcessImpl set on the integrated localization.
+void Compose(const Sample& sample, LocalizationEstimate* localization) {
+  const Eigen::Quaterniond attitude(
+      Eigen::AngleAxisd(sample.yaw, Eigen::Vector3d::UnitZ()));
+  localization->set_measurement_time(sample.time);
+  localization->mutable_header()->set_timestamp_sec(sample.time);
+
+  Pose* pose = localization->mutable_pose();
+  UTMCoor utm_xy;
+  FrameTransform::LatlonToUtmXY(sample.longitude, sample.latitude, &utm_xy);
+  pose->mutable_position()->set_x(utm_xy.x);
+  pose->mutable_position()->set_y(utm_xy.y);
+  pose->mutable_position()->set_z(sample.height);
+  pose->mutable_orientation()->set_qx(attitude.x());
+  pose->mutable_orientation()->set_qy(attitude.y());
+  pose->mutable_orientation()->set_qz(attitude.z());
+  pose->mutable_orientation()->set_qw(attitude.w());
+  pose->mutable_linear_velocity()->set_x(sample.speed * std::cos(sample.yaw));
+  pose->mutable_linear_velocity()->set_y(sample.speed * std::sin(sample.yaw));
+  pose->mutable_linear_velocity()->set_z(0.0);
+  pose->set_heading(sample.yaw);
+
+  Uncertainty* uncertainty = localization->mutable_uncertainty();
+  uncertainty->mutable_position_std_dev()->set_x(0.05);
+  uncertainty->mutable_position_std_dev()->set_y(0.05);
+  uncertainty->mutable_position_std_dev()->set_z(0.1);
+  uncertainty->mutable_orientation_std_dev()->set_z(0.01);
+
+  localization->mutable_msf_status()->set_local_lidar_status(
+      MSF_LOCAL_LIDAR_NORMAL);
+  localization->mutable_sensor_status()->set_imu_delay_status(
+      IMU_DELAY_NORMAL);
+
+  const Eigen::Matrix3d rotation = attitude.toRotationMatrix();
+  const Eigen::Vector3d acceleration =
+      rotation * Eigen::Vector3d(sample.acceleration[0],
+                                 sample.acceleration[1],
+                                 sample.acceleration[2]);
+  const Eigen::Vector3d angular_velocity =
+      rotation * Eigen::Vector3d(sample.angular_velocity[0],
+                                 sample.angular_velocity[1],
+                                 sample.angular_velocity[2]);
+  pose->mutable_linear_acceleration()->set_x(acceleration(0));
+  pose->mutable_linear_acceleration()->set_y(acceleration(1));
+  pose->mutable_linear_acceleration()->set_z(acceleration(2) - 9.8);
+  pose->mutable_angular_velocity()->set_x(angular_velocity(0));
+  pose->mutable_angular_velocity()->set_y(angular_velocity(1));
+  pose->mutable_angular_velocity()->set_z(angular_velocity(2));
+}
+
+template <typename Function>
+void Time(const char* name, const int num_samples, const int iterations,
+          Function function) {
+  double total = 0.0;
+  double min = 1e9;
+  double checksum = 0.0;
+  for (int i = 0; i < iterations; ++i) {
+    auto start = std::chrono::steady_clock::now();
+    checksum += function();
+    std::chrono::duration<double, std::nano> elapsed =
+        std::chrono::steady_clock::now() - start;
+    total += elapsed.count();
+    min = std::min(min, elapsed.count());
+  }
+  std::printf("%-10s %12.1f %12.1f (checksum %g)\n", name,
+              total / iterations / num_samples, min / num_samples, checksum);
+}
+
+int Run(const int num_samples, const int iterations) {
+  const std::vector<Sample> samples = Samples(num_samples);
+  LocalizationIntegStatus integ_status;
+  integ_status.integ_state = LocalizationIntegState::OK;
+
+  std::printf("%d imu samples\n", num_samples);
+  std::printf("%-10s %12s %12s\n", "result", "mean(ns)", "min(ns)");
+  LocalizationResult fresh_result;
+  Time("fresh", num_samples, iterations, [&]() {
+    double sum = 0.0;
+    for (const auto& sample : samples) {
+      LocalizationEstimate localization;
+      Compose(sample, &localization);
+      fresh_result = LocalizationResult(LocalizationMeasureState::OK,
+                                        localization, integ_status);
+      LocalizationEstimate published = fresh_result.localization();
+      sum += published.pose().position().x();
+    }
+    return sum;
+  });
+
+  LocalizationResult reused_result;
+  LocalizationEstimate published;
+  Time("reused", num_samples, iterations, [&]() {
+    double sum = 0.0;
+    for (const auto& sample : samples) {
+      LocalizationEstimate* localization =
+          reused_result.mutable_localization();
+      localization->Clear();
+      Compose(sample, localization);
+      *reused_result.mutable_integ_status() = integ_status;
+      reused_result.set_state(LocalizationMeasureState::OK);
+      published.CopyFrom(reused_result.localization());
+      sum += published.pose().position().x();
+    }
+    return sum;
+  });
+  return 0;
+}
+
+}  // namespace msf
+}  // namespace localization
+}  // namespace apollo
+
+int main(int argc, char** argv) {
+  int num_samples = argc > 1 ? std::max(std::atoi(argv[1]), 1) : 2000;
+  int iterations = argc > 2 ? std::max(std::atoi(argv[2]), 1) : 20;
+  return apollo::localization::msf::Run(num_samples, iterations);
+}
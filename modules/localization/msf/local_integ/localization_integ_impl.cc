@@ -138,9 +138,12 @@ void LocalizationIntegImpl::ImuProcessImpl(const ImuData& imu_data) {
 
   expert_.AddImu(imu_data);
 
-  // integ
+  // integ, written into the latest result in place: this runs for every imu
+  // sample, and the message keeps its sub messages between the cycles.
   IntegState state;
-  LocalizationEstimate integ_localization;
+  LocalizationEstimate& integ_localization =
+      *lastest_integ_localization_.mutable_localization();
+  integ_localization.Clear();
   integ_process_->GetResult(&state, &integ_localization);
   ImuData corrected_imu;
   integ_process_->GetCorrectedImu(&corrected_imu);
@@ -148,11 +151,10 @@ void LocalizationIntegImpl::ImuProcessImpl(const ImuData& imu_data) {
   integ_process_->GetEarthParameter(&earth_param);
   // check msf running status and set msf_status in integ_localization
 
-  LocalizationIntegStatus integ_status;
   expert_.AddFusionLocalization(integ_localization);
   expert_.GetFusionStatus(integ_localization.mutable_msf_status(),
                           integ_localization.mutable_sensor_status(),
-                          &integ_status);
+                          lastest_integ_localization_.mutable_integ_status());
 
   apollo::localization::Pose* posepb_loc = integ_localization.mutable_pose();
 
@@ -162,14 +164,14 @@ void LocalizationIntegImpl::ImuProcessImpl(const ImuData& imu_data) {
   }
 
   // set linear acceleration
-  Eigen::Vector3d orig_acceleration(corrected_imu.fb[0], corrected_imu.fb[1],
-                                    corrected_imu.fb[2]);
+  const Eigen::Vector3d orig_acceleration(
+      corrected_imu.fb[0], corrected_imu.fb[1], corrected_imu.fb[2]);
   const apollo::common::Quaternion& orientation =
       integ_localization.pose().orientation();
-  Eigen::Quaternion<double> quaternion(orientation.qw(), orientation.qx(),
-                                       orientation.qy(), orientation.qz());
-  Eigen::Vector3d vec_acceleration =
-      static_cast<Eigen::Vector3d>(quaternion * orig_acceleration);
+  const Eigen::Quaterniond quaternion(orientation.qw(), orientation.qx(),
+                                      orientation.qy(), orientation.qz());
+  const Eigen::Matrix3d rotation = quaternion.toRotationMatrix();
+  Eigen::Vector3d vec_acceleration = rotation * orig_acceleration;
 
   // Remove gravity.
   vec_acceleration(2) -= earth_param.g;
@@ -180,8 +182,8 @@ void LocalizationIntegImpl::ImuProcessImpl(const ImuData& imu_data) {
   linear_acceleration->set_y(vec_acceleration(1));
   linear_acceleration->set_z(vec_acceleration(2));
 
-  Eigen::Vector3d vec_acceleration_vrf =
-      quaternion.inverse() * vec_acceleration;
+  const Eigen::Vector3d vec_acceleration_vrf =
+      rotation.transpose() * vec_acceleration;
 
   apollo::common::Point3D* linear_acceleration_vrf =
       posepb_loc->mutable_linear_acceleration_vrf();
@@ -190,10 +192,9 @@ void LocalizationIntegImpl::ImuProcessImpl(const ImuData& imu_data) {
   linear_acceleration_vrf->set_z(vec_acceleration_vrf(2));
 
   // set angular velocity
-  Eigen::Vector3d orig_angular_velocity(
+  const Eigen::Vector3d orig_angular_velocity(
       corrected_imu.wibb[0], corrected_imu.wibb[1], corrected_imu.wibb[2]);
-  Eigen::Vector3d vec_angular_velocity = static_cast<Eigen::Vector3d>(
-      quaternion.toRotationMatrix() * orig_angular_velocity);
+  const Eigen::Vector3d vec_angular_velocity = rotation * orig_angular_velocity;
   apollo::common::Point3D* angular_velocity =
       posepb_loc->mutable_angular_velocity();
   angular_velocity->set_x(vec_angular_velocity(0));
@@ -206,9 +207,8 @@ void LocalizationIntegImpl::ImuProcessImpl(const ImuData& imu_data) {
   angular_velocity_vrf->set_y(corrected_imu.wibb[1]);
   angular_velocity_vrf->set_z(corrected_imu.wibb[2]);
 
-  lastest_integ_localization_ =
-      LocalizationResult(LocalizationMeasureState(static_cast<int>(state)),
-                         integ_localization, integ_status);
+  lastest_integ_localization_.set_state(
+      LocalizationMeasureState(static_cast<int>(state)));
 
   InsPva integ_sins_pva;
   double covariance[9][9];
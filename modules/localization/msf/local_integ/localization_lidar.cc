@@ -16,6 +16,10 @@
 
 #include "modules/localization/msf/local_integ/localization_lidar.h"
 
+#include <algorithm>
+
+#include "modules/localization/common/point_cloud_preprocessor.h"
+
 namespace apollo {
 namespace localization {
 namespace msf {
@@ -115,6 +119,12 @@ void LocalizationLidar::SetDeltaPitchRollLimit(double limit) {
   lidar_locator_->SetDeltaPitchRollLimit(limit);
 }
 
+void LocalizationLidar::SetCoarseSearch(double search_range, int num_levels,
+                                        int num_candidates) {
+  coarse_search_range_ = search_range;
+  coarse_matcher_.Init(num_levels, num_candidates);
+}
+
 int LocalizationLidar::Update(const unsigned int frame_idx,
                               const Eigen::Affine3d& pose,
                               const Eigen::Vector3d velocity,
@@ -141,6 +151,12 @@ int LocalizationLidar::Update(const unsigned int frame_idx,
   // generate composed map for compare
   ComposeMapNode(pose_trans);
 
+  // search the wide window on the coarse map levels, the locator refines the
+  // best position in its own window
+  if (coarse_search_range_ > 0.0) {
+    CoarseSearch(imu_pose, lidar_frame, &pose_trans);
+  }
+
   // pass map node to locator
   int node_width = lidar_map_node_->width;
   int node_height = lidar_map_node_->height;
@@ -166,6 +182,16 @@ int LocalizationLidar::Update(const unsigned int frame_idx,
   return error;
 }
 
+void LocalizationLidar::PreloadMapAhead(const Eigen::Vector3d& location,
+                                        const Eigen::Vector3d& displacement) {
+  map_.PreloadMapAreaAhead(location, displacement, resolution_id_, zone_id_);
+}
+
+LocalizationLidar::MapNodeCacheStatistics
+LocalizationLidar::GetMapCacheStatistics() {
+  return map_.GetCacheStatistics();
+}
+
 void LocalizationLidar::GetResult(Eigen::Affine3d* location,
                                   Eigen::Matrix3d* covariance,
                                   double* location_score) {
@@ -270,6 +296,30 @@ void LocalizationLidar::RefineAltitudeFromMap(Eigen::Affine3d* pose) {
   pose->translation() = transform_tmp.translation();
 }
 
+void LocalizationLidar::CoarseSearch(const Eigen::Affine3d& pose,
+                                     const LidarFrame& lidar_frame,
+                                     Eigen::Vector3d* position) {
+  CHECK_NOTNULL(position);
+
+  coarse_matcher_.SetMap(map_left_top_corner_, resolution_,
+                         lidar_map_node_->width, lidar_map_node_->height,
+                         lidar_map_node_->intensities, lidar_map_node_->count);
+  map_xs_ = lidar_frame.pt_xs;
+  map_ys_ = lidar_frame.pt_ys;
+  map_zs_ = lidar_frame.pt_zs;
+  TransformPoints(pose * velodyne_extrinsic_, &map_xs_, &map_ys_, &map_zs_);
+
+  Eigen::Vector2d offset;
+  if (!coarse_matcher_.Match(map_xs_, map_ys_, lidar_frame.intensities,
+                             coarse_search_range_, &offset)) {
+    AWARN << "Coarse search found no position overlapping the map.";
+    return;
+  }
+  ADEBUG << "Coarse search offset: " << offset(0) << ", " << offset(1)
+         << ", cost: " << coarse_matcher_.GetBestCost();
+  position->head<2>() += offset;
+}
+
 void LocalizationLidar::ComposeMapNode(const Eigen::Vector3d& trans) {
   Eigen::Vector2d center(trans(0), trans(1));
   Eigen::Vector2d left_top_corner(center(0) - node_size_x_ * resolution_ / 2.0,
@@ -355,19 +405,22 @@ void LocalizationLidar::ComposeMapNode(const Eigen::Vector3d& trans) {
       FloatMatrix* intensity_var_matrix = map_cells.GetIntensityVarMatrix(0);
       FloatMatrix* altitude_matrix = map_cells.GetAltitudeMatrix(0);
       UIntMatrix* count_matrix = map_cells.GetCountMatrix(0);
+      // copy row by row, each row is contiguous in both source and target
       for (int y = 0; y < range_y; ++y) {
         int dst_base_x = (dst_y + y) * node_size_x_ + dst_x;
-        for (int x = 0; x < range_x; ++x) {
-          int dst_idx = dst_base_x + x;
-          lidar_map_node_->intensities[dst_idx] =
-              (*intensity_matrix)[src_y + y][src_x + x];
-          lidar_map_node_->intensities_var[dst_idx] =
-              (*intensity_var_matrix)[src_y + y][src_x + x];
-          lidar_map_node_->altitudes[dst_idx] =
-              (*altitude_matrix)[src_y + y][src_x + x];
-          lidar_map_node_->count[dst_idx] =
-              (*count_matrix)[src_y + y][src_x + x];
-        }
+        const float* intensity_row = (*intensity_matrix)[src_y + y] + src_x;
+        std::copy(intensity_row, intensity_row + range_x,
+                  lidar_map_node_->intensities + dst_base_x);
+        const float* intensity_var_row =
+            (*intensity_var_matrix)[src_y + y] + src_x;
+        std::copy(intensity_var_row, intensity_var_row + range_x,
+                  lidar_map_node_->intensities_var + dst_base_x);
+        const float* altitude_row = (*altitude_matrix)[src_y + y] + src_x;
+        std::copy(altitude_row, altitude_row + range_x,
+                  lidar_map_node_->altitudes + dst_base_x);
+        const unsigned int* count_row = (*count_matrix)[src_y + y] + src_x;
+        std::copy(count_row, count_row + range_x,
+                  lidar_map_node_->count + dst_base_x);
       }
     }
   }
@@ -21,6 +21,7 @@
 
 #include "cyber/common/log.h"
 #include "include/lidar_locator.h"
+#include "modules/localization/msf/local_integ/coarse_to_fine_matcher.h"
 #include "modules/localization/msf/local_integ/localization_params.h"
 #include "modules/localization/msf/local_pyramid_map/base_map/base_map_node_index.h"
 #include "modules/localization/msf/local_pyramid_map/pyramid_map/pyramid_map.h"
@@ -81,6 +82,8 @@ class LocalizationLidar {
       PyramidMapConfig;
   typedef apollo::localization::msf::pyramid_map::FloatMatrix FloatMatrix;
   typedef apollo::localization::msf::pyramid_map::UIntMatrix UIntMatrix;
+  typedef apollo::localization::msf::pyramid_map::MapNodeCacheStatistics
+      MapNodeCacheStatistics;
 
  public:
   /**@brief The constructor. */
@@ -106,10 +109,22 @@ class LocalizationLidar {
 
   void SetDeltaPitchRollLimit(double limit);
 
+  /**@brief Search the position within search_range meters on the coarse
+   * levels of the map before the locator refines it, 0 to disable. */
+  void SetCoarseSearch(double search_range, int num_levels,
+                       int num_candidates);
+
   int Update(const unsigned int frame_idx, const Eigen::Affine3d& pose,
              const Eigen::Vector3d velocity, const LidarFrame& lidar_frame,
              bool use_avx = false);
 
+  /**@brief Preload the map nodes the car will enter before it moves by
+   * displacement from location. */
+  void PreloadMapAhead(const Eigen::Vector3d& location,
+                       const Eigen::Vector3d& displacement);
+
+  MapNodeCacheStatistics GetMapCacheStatistics();
+
   void GetResult(Eigen::Affine3d* location, Eigen::Matrix3d* covariance,
                  double* location_score);
 
@@ -122,6 +137,10 @@ class LocalizationLidar {
 
   void RefineAltitudeFromMap(Eigen::Affine3d* pose);
 
+  /**@brief Shift the position by the offset of the coarse search. */
+  void CoarseSearch(const Eigen::Affine3d& pose, const LidarFrame& lidar_frame,
+                    Eigen::Vector3d* position);
+
  protected:
   LidarLocator* lidar_locator_;
   int search_range_x_ = 0;
@@ -143,6 +162,13 @@ class LocalizationLidar {
   double pre_vehicle_ground_height_ = 0.0;
   bool is_pre_ground_height_valid_ = false;
   Eigen::Affine3d velodyne_extrinsic_;
+
+  CoarseToFineMatcher coarse_matcher_;
+  double coarse_search_range_ = 0.0;
+  /**@brief The online points in the map frame. */
+  std::vector<double> map_xs_;
+  std::vector<double> map_ys_;
+  std::vector<double> map_zs_;
 };
 
 }  // namespace msf
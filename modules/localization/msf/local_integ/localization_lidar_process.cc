@@ -81,6 +81,7 @@ Status LocalizationLidarProcess::Init(const LocalizationIntegParam& params) {
   yaw_align_mode_ = params.lidar_yaw_align_mode;
   utm_zone_id_ = params.utm_zone_id;
   map_coverage_theshold_ = params.map_coverage_theshold;
+  map_preload_time_ = params.map_preload_time;
   imu_lidar_max_delay_time_ = params.imu_lidar_max_delay_time;
 
   lidar_filter_size_ = params.lidar_filter_size;
@@ -137,6 +138,9 @@ Status LocalizationLidarProcess::Init(const LocalizationIntegParam& params) {
   locator_->SetValidThreshold(static_cast<float>(map_coverage_theshold_));
   locator_->SetVehicleHeight(lidar_height_.height);
   locator_->SetDeltaPitchRollLimit(compensate_pitch_roll_limit_);
+  locator_->SetCoarseSearch(params.coarse_search_range,
+                            params.coarse_search_levels,
+                            params.coarse_search_candidates);
 
   const double deg_to_rad = 0.017453292519943;
   const double max_gyro_input = 200 * deg_to_rad;  // 200 degree
@@ -200,6 +204,19 @@ void LocalizationLidarProcess::PcdProcess(const LidarFrame& lidar_frame) {
   int ret = locator_->Update(pcd_index++, cur_predict_location_, velocity_,
                              lidar_frame, if_use_avx_);
 
+  // preload map nodes on the way of the next map_preload_time_ seconds
+  if (map_preload_time_ > 0.0 && pre_location_time_ > 0.0 &&
+      lidar_frame.measurement_time > pre_location_time_) {
+    const double ratio = map_preload_time_ / (lidar_frame.measurement_time -
+                                              pre_location_time_);
+    locator_->PreloadMapAhead(cur_predict_location_.translation(),
+                              velocity_ * ratio);
+  }
+  const auto cache_statistics = locator_->GetMapCacheStatistics();
+  AINFO_EVERY(100) << "Map node cache hits: " << cache_statistics.hit_count
+                   << ", misses: " << cache_statistics.miss_count
+                   << ", late loads: " << cache_statistics.late_load_count;
+
   UpdateState(ret, lidar_frame.measurement_time);
 
   timer.End("Lidar process");
@@ -122,6 +122,7 @@ class LocalizationLidarProcess {
   double compensate_pitch_roll_limit_ = 0.035;
   int utm_zone_id_ = 50;
   double map_coverage_theshold_ = 0.8;
+  double map_preload_time_ = 0.0;
   TransformD lidar_extrinsic_;
   LidarHeight lidar_height_;
 
@@ -85,6 +85,10 @@ struct LocalizationIntegParam {
   int lidar_yaw_align_mode = 2;
   int lidar_filter_size = 17;
   double map_coverage_theshold = 0.8;
+  double map_preload_time = 0.0;
+  double coarse_search_range = 0.0;
+  int coarse_search_levels = 4;
+  int coarse_search_candidates = 5;
   double imu_lidar_max_delay_time = 0.4;
   int utm_zone_id = 50;
   bool is_lidar_unstable_reset = true;
@@ -139,8 +143,13 @@ class LocalizationResult {
         localization_(localiztion),
         integ_status_(integ_status) {}
   LocalizationMeasureState state() const { return state_; }
-  LocalizationEstimate localization() const { return localization_; }
-  LocalizationIntegStatus integ_status() const { return integ_status_; }
+  const LocalizationEstimate& localization() const { return localization_; }
+  const LocalizationIntegStatus& integ_status() const { return integ_status_; }
+
+  // Update the result in place so that the messages keep their allocations.
+  void set_state(const LocalizationMeasureState& state) { state_ = state; }
+  LocalizationEstimate* mutable_localization() { return &localization_; }
+  LocalizationIntegStatus* mutable_integ_status() { return &integ_status_; }
 
  private:
   LocalizationMeasureState state_;
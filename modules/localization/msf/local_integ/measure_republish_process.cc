@@ -37,7 +37,6 @@ MeasureRepublishProcess::MeasureRepublishProcess()
     : pre_bestgnsspose_(),
       pre_bestgnsspose_valid_(false),
       send_init_bestgnsspose_(false),
-      pva_buffer_size_(150),
       local_utm_zone_id_(50),
       is_trans_gpstime_to_utctime_(true),
       map_height_time_(0.0),
@@ -50,8 +49,6 @@ Status MeasureRepublishProcess::Init(const LocalizationIntegParam& params) {
   is_trans_gpstime_to_utctime_ = params.is_trans_gpstime_to_utctime;
   gnss_mode_ = GnssMode(params.gnss_mode);
 
-  pva_buffer_size_ = 150;
-
   map_height_time_ = 0.0;
 
   novatel_heading_time_ = 0.0;
@@ -320,15 +317,7 @@ void MeasureRepublishProcess::GnssLocalProcess(
 }
 
 void MeasureRepublishProcess::IntegPvaProcess(const InsPva& inspva_msg) {
-  const InsPva& integ_pva = inspva_msg;
-
-  std::lock_guard<std::mutex> lock(integ_pva_mutex_);
-  if (integ_pva_list_.size() < pva_buffer_size_) {
-    integ_pva_list_.push_back(integ_pva);
-  } else {
-    integ_pva_list_.pop_front();
-    integ_pva_list_.push_back(integ_pva);
-  }
+  integ_pva_buffer_.Push(inspva_msg.time, inspva_msg);
 }
 
 bool MeasureRepublishProcess::LidarLocalProcess(
@@ -396,8 +385,9 @@ bool MeasureRepublishProcess::LidarLocalProcess(
 }
 
 bool MeasureRepublishProcess::IsSinsAlign() {
-  std::lock_guard<std::mutex> lock(integ_pva_mutex_);
-  return !integ_pva_list_.empty() && integ_pva_list_.back().init_and_alignment;
+  SeqlockRingBuffer<InsPva, 150>::Sample integ_pva;
+  return integ_pva_buffer_.GetLatest(&integ_pva) &&
+         integ_pva.value.init_and_alignment;
 }
 
 void MeasureRepublishProcess::TransferXYZFromBestgnsspose(
@@ -574,10 +564,10 @@ bool MeasureRepublishProcess::GnssHeadingProcess(
     return false;
   }
 
-  integ_pva_mutex_.lock();
-  bool is_sins_align =
-      integ_pva_list_.back().init_and_alignment && (integ_pva_list_.size() > 1);
-  integ_pva_mutex_.unlock();
+  SeqlockRingBuffer<InsPva, 150>::Sample integ_pva;
+  bool is_sins_align = integ_pva_buffer_.GetLatest(&integ_pva) &&
+                       integ_pva.value.init_and_alignment &&
+                       (integ_pva_buffer_.Size() > 1);
 
   if (is_sins_align) {
     static double pre_publish_time = 0.0;
@@ -21,7 +21,6 @@
 
 #pragma once
 
-#include <list>
 #include <mutex>
 #include <string>
 
@@ -31,6 +30,7 @@
 #include "modules/common/status/status.h"
 #include "modules/drivers/gnss/proto/gnss_best_pose.pb.h"
 #include "modules/drivers/gnss/proto/heading.pb.h"
+#include "modules/localization/common/seqlock_ring_buffer.h"
 #include "modules/localization/msf/common/util/frame_transform.h"
 #include "modules/localization/msf/local_integ/localization_params.h"
 #include "modules/localization/proto/localization.pb.h"
@@ -105,9 +105,7 @@ class MeasureRepublishProcess {
   bool pre_bestgnsspose_valid_;
   bool send_init_bestgnsspose_;
 
-  std::list<InsPva> integ_pva_list_;
-  size_t pva_buffer_size_;
-  std::mutex integ_pva_mutex_;
+  SeqlockRingBuffer<InsPva, 150> integ_pva_buffer_;
 
   int local_utm_zone_id_;
   bool is_trans_gpstime_to_utctime_;
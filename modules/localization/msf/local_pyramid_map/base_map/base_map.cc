@@ -16,6 +16,8 @@
 
 #include "modules/localization/msf/local_pyramid_map/base_map/base_map.h"
 
+#include <algorithm>
+#include <cmath>
 #include <set>
 #include <string>
 
@@ -80,6 +82,10 @@ BaseMapNode* BaseMap::GetMapNodeSafe(const MapNodeIndex& index) {
     lock2.unlock();
     return node;
   }
+  ++cache_statistics_.miss_count;
+  if (map_preloading_task_index_.count(index) > 0) {
+    ++cache_statistics_.late_load_count;
+  }
   lock2.unlock();
 
   // load from disk
@@ -126,6 +132,7 @@ void BaseMap::LoadMapNodes(std::set<MapNodeIndex>* map_ids) {
     return;
   }
 
+  const size_t num_requested = map_ids->size();
   // check in cacheL1
   std::set<MapNodeIndex>::iterator itr = map_ids->begin();
   while (itr != map_ids->end()) {
@@ -142,6 +149,15 @@ void BaseMap::LoadMapNodes(std::set<MapNodeIndex>* map_ids) {
   }
   // check and update cache
   CheckAndUpdateCache(map_ids);
+  boost::unique_lock<boost::recursive_mutex> lock2(map_load_mutex_);
+  cache_statistics_.hit_count += num_requested - map_ids->size();
+  cache_statistics_.miss_count += map_ids->size();
+  for (const auto& index : *map_ids) {
+    if (map_preloading_task_index_.count(index) > 0) {
+      ++cache_statistics_.late_load_count;
+    }
+  }
+  lock2.unlock();
   // load from disk sync
   std::vector<std::future<void>> load_futures_;
   itr = map_ids->begin();
@@ -391,6 +407,61 @@ void BaseMap::PreloadMapArea(const Eigen::Vector3d& location,
   this->PreloadMapNodes(&map_ids);
 }
 
+void BaseMap::PreloadMapAreaAhead(const Eigen::Vector3d& location,
+                                  const Eigen::Vector3d& displacement,
+                                  unsigned int resolution_id,
+                                  unsigned int zone_id) {
+  if (map_node_pool_ == nullptr) {
+    std::cerr << "Map node pool is nullptr!" << std::endl;
+    return;
+  }
+  const double map_pixel_resolution =
+      this->map_config_->map_resolutions_[resolution_id];
+  const double half_size_x =
+      this->map_config_->map_node_size_x_ * map_pixel_resolution / 2.0;
+  const double half_size_y =
+      this->map_config_->map_node_size_y_ * map_pixel_resolution / 2.0;
+  const double distance = std::hypot(displacement[0], displacement[1]);
+  if (distance < half_size_x && distance < half_size_y) {
+    // PreloadMapArea covers it.
+    return;
+  }
+  // Sample the way at most half a node apart, so no node is skipped.
+  const double step = std::min(half_size_x, half_size_y);
+  const int num_steps = static_cast<int>(std::ceil(distance / step));
+  if (map_node_cache_lvl2_->Capacity() <= map_node_cache_lvl1_->Capacity()) {
+    return;
+  }
+  const size_t max_num_nodes =
+      map_node_cache_lvl2_->Capacity() - map_node_cache_lvl1_->Capacity();
+
+  std::set<MapNodeIndex> map_ids;
+  for (int i = 1; i <= num_steps; ++i) {
+    const Eigen::Vector3d center =
+        location + displacement * static_cast<double>(i) / num_steps;
+    std::set<MapNodeIndex> step_map_ids;
+    for (const double dx : {-half_size_x, half_size_x}) {
+      for (const double dy : {-half_size_y, half_size_y}) {
+        Eigen::Vector3d pt(center[0] + dx, center[1] + dy, 0.0);
+        step_map_ids.insert(MapNodeIndex::GetMapNodeIndex(
+            *map_config_, pt, resolution_id, zone_id));
+      }
+    }
+    step_map_ids.insert(map_ids.begin(), map_ids.end());
+    if (step_map_ids.size() > max_num_nodes) {
+      break;
+    }
+    map_ids.swap(step_map_ids);
+  }
+
+  this->PreloadMapNodes(&map_ids);
+}
+
+MapNodeCacheStatistics BaseMap::GetCacheStatistics() {
+  boost::unique_lock<boost::recursive_mutex> lock(map_load_mutex_);
+  return cache_statistics_;
+}
+
 bool BaseMap::LoadMapArea(const Eigen::Vector3d& seed_pt3d,
                           unsigned int resolution_id, unsigned int zone_id,
                           int filter_size_x, int filter_size_y) {
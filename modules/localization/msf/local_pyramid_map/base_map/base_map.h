@@ -15,6 +15,7 @@
  *****************************************************************************/
 #pragma once
 
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <set>
@@ -34,6 +35,16 @@ namespace localization {
 namespace msf {
 namespace pyramid_map {
 
+/**@brief The statistics of the map nodes requested for location calculation. */
+struct MapNodeCacheStatistics {
+  /**@brief The number of requested nodes which are already in memory. */
+  uint64_t hit_count = 0;
+  /**@brief The number of requested nodes loaded from disk synchronously. */
+  uint64_t miss_count = 0;
+  /**@brief The missed nodes whose preloading task has not finished yet. */
+  uint64_t late_load_count = 0;
+};
+
 /**@brief The data structure of the base map. */
 class BaseMap {
  public:
@@ -75,6 +86,13 @@ class BaseMap {
   virtual void PreloadMapArea(const Eigen::Vector3d& location,
                               const Eigen::Vector3d& trans_diff,
                               unsigned int resolution_id, unsigned int zone_id);
+  /**@brief Preload map nodes the car will enter before it moves by
+   * displacement from location. The nodes covering the location calculation
+   * window along the way are preloaded, nearest first, and no more than the
+   * level 2 cache can hold beside the level 1 nodes. */
+  void PreloadMapAreaAhead(const Eigen::Vector3d& location,
+                           const Eigen::Vector3d& displacement,
+                           unsigned int resolution_id, unsigned int zone_id);
   /**@brief Load map nodes for the location calculate of this frame.
    * If the forecasts are correct in last frame, these nodes will be all in
    * cache, if not, then need to create loading tasks, and wait for the loading
@@ -85,6 +103,10 @@ class BaseMap {
                            unsigned int resolution_id, unsigned int zone_id,
                            int filter_size_x, int filter_size_y);
 
+  /**@brief Get the statistics of the nodes requested by LoadMapArea and
+   * GetMapNodeSafe. */
+  MapNodeCacheStatistics GetCacheStatistics();
+
   /**@brief Compute md5 for all map node file in map. */
   void ComputeMd5ForAllMapNodes();
 
@@ -138,6 +160,8 @@ class BaseMap {
   std::set<MapNodeIndex> map_preloading_task_index_;
   /**@brief The mutex for preload map node. **/
   boost::recursive_mutex map_load_mutex_;
+  /**@brief The statistics of requested nodes, guarded by map_load_mutex_. */
+  MapNodeCacheStatistics cache_statistics_;
 
   /**@brief All the map nodes in the Map (in the disk). */
   std::vector<MapNodeIndex> all_map_node_indices_;
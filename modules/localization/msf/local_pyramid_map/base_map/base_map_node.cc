@@ -271,11 +271,14 @@ size_t BaseMapNode::GetHeaderBinarySize() const {
 }
 
 size_t BaseMapNode::LoadBodyBinary(std::vector<unsigned char>* buf) {
-  if (compression_strategy_ == nullptr) {
+  if (compression_strategy_ == nullptr && !Lz4Strategy::IsEncoded(*buf)) {
     return map_matrix_handler_->LoadBinary(&(*buf)[0], map_matrix_);
   }
   std::vector<unsigned char> buf_uncompressed;
-  int ret = compression_strategy_->Decode(buf, &buf_uncompressed);
+  // lz4 nodes are loaded whatever strategy the node is saved with
+  int ret = Lz4Strategy::IsEncoded(*buf)
+                ? Lz4Strategy().Decode(buf, &buf_uncompressed)
+                : compression_strategy_->Decode(buf, &buf_uncompressed);
   if (ret < 0) {
     AERROR << "compression Decode error: " << ret;
     return 0;
@@ -347,6 +350,10 @@ Eigen::Vector2d BaseMapNode::GetCoordinate(unsigned int x,
   return coord;
 }
 
+void BaseMapNode::SetCompressionStrategy(CompressionStrategy* strategy) {
+  compression_strategy_.reset(strategy);
+}
+
 void BaseMapNode::SetMapNodeIndex(const MapNodeIndex& index) {
   map_node_config_->node_index_ = index;
   left_top_corner_ =
@@ -78,6 +78,10 @@ class BaseMapNode {
   /**@brief Set the map node index. */
   void SetMapNodeIndex(const MapNodeIndex& index);
 
+  /**@brief Set the compression strategy the node is saved with, nullptr to
+   * save it uncompressed. The node takes the ownership. */
+  void SetCompressionStrategy(CompressionStrategy* strategy);
+
   /**@brief Save intensity image of node. */
   bool SaveIntensityImage(const std::string& path) const;
   /**@brief Save altitude image of node. */
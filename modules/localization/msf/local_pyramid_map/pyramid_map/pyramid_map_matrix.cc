@@ -1245,7 +1245,8 @@ void PyramidMapMatrix::MergeCellSafe(
     return;
   }
 
-  if (count == nullptr || !has_count_) {
+  // An empty cell has nothing to merge, and would divide by a zero count.
+  if (count == nullptr || !has_count_ || *count == 0) {
     return;
   }
 
@@ -1285,7 +1286,7 @@ void PyramidMapMatrix::MergeCellSafe(
   count_matrixes_[level][row][col] = new_count;
 
   // for points on ground
-  if (ground_count == nullptr || !has_ground_count_) {
+  if (ground_count == nullptr || !has_ground_count_ || *ground_count == 0) {
     return;
   }
 
@@ -1484,7 +1485,12 @@ double PyramidMapMatrix::ComputeMeanIntensity(unsigned int level) {
 void PyramidMapMatrix::Reduce(std::shared_ptr<PyramidMapMatrix> cells,
                               const PyramidMapMatrix& new_cells,
                               unsigned int level, unsigned int new_level) {
-  if (level >= cells->resolution_num_) {
+  cells->Reduce(new_cells, level, new_level);
+}
+
+void PyramidMapMatrix::Reduce(const PyramidMapMatrix& new_cells,
+                              unsigned int level, unsigned int new_level) {
+  if (level >= resolution_num_) {
     AERROR << "PyramidMapMatrix: [Reduce] The level id is illegal.";
     return;
   }
@@ -1494,13 +1500,13 @@ void PyramidMapMatrix::Reduce(std::shared_ptr<PyramidMapMatrix> cells,
     return;
   }
 
-  if (cells->rows_mr_[level] != new_cells.rows_mr_[new_level] ||
-      cells->cols_mr_[level] != new_cells.cols_mr_[new_level]) {
+  if (rows_mr_[level] != new_cells.rows_mr_[new_level] ||
+      cols_mr_[level] != new_cells.cols_mr_[new_level]) {
     return;
   }
 
-  for (unsigned int r = 0; r < cells->rows_mr_[level]; r++) {
-    for (unsigned int c = 0; c < cells->cols_mr_[level]; c++) {
+  for (unsigned int r = 0; r < rows_mr_[level]; r++) {
+    for (unsigned int c = 0; c < cols_mr_[level]; c++) {
       const float* intensity = new_cells.GetIntensitySafe(r, c, new_level);
       const float* intensity_var =
           new_cells.GetIntensityVarSafe(r, c, new_level);
@@ -1512,8 +1518,8 @@ void PyramidMapMatrix::Reduce(std::shared_ptr<PyramidMapMatrix> cells,
       const unsigned int* ground_count =
           new_cells.GetGroundCountSafe(r, c, new_level);
 
-      cells->MergeCellSafe(intensity, intensity_var, altitude, altitude_var,
-                           ground_altitude, count, ground_count, r, c, level);
+      MergeCellSafe(intensity, intensity_var, altitude, altitude_var,
+                    ground_altitude, count, ground_count, r, c, level);
     }
   }
 }
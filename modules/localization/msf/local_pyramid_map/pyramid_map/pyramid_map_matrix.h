@@ -204,6 +204,9 @@ class PyramidMapMatrix : public BaseMapMatrix {
   static void Reduce(std::shared_ptr<PyramidMapMatrix> cells,
                      const PyramidMapMatrix& new_cells, unsigned int level = 0,
                      unsigned int new_level = 0);
+  /**@brief Merge the cells of another PyramidMapMatrix into this one. */
+  void Reduce(const PyramidMapMatrix& new_cells, unsigned int level = 0,
+              unsigned int new_level = 0);
 
   inline bool HasIntensity() const;
   inline bool HasIntensityVar() const;
@@ -430,6 +433,9 @@ inline void PyramidMapMatrix::MergeCellBase(const float* intensity,
                                             const unsigned int* count,
                                             unsigned int row, unsigned int col,
                                             unsigned int level) {
+  if (*count == 0) {
+    return;
+  }
   unsigned int new_count = count_matrixes_[level][row][col] + *count;
   float p0 = static_cast<float>(count_matrixes_[level][row][col]) /
              static_cast<float>(new_count);
@@ -638,6 +638,42 @@ TEST_F(PyramidMapMatrixTestSuite, merge_and_add_and_reduce) {
   PyramidMapMatrix::Reduce(pm_matrix, *pm_matrix2, 0, 1);
 }
 
+TEST_F(PyramidMapMatrixTestSuite, reduce_partial_matrixes) {
+  // map config
+  std::unique_ptr<PyramidMapConfig> config(
+      new PyramidMapConfig("lossy_full_alt"));
+  config->SetMapNodeSize(3, 3);
+  PyramidMapMatrix pm_matrix;
+  pm_matrix.Init(*config);
+  pm_matrix.Reset();
+  PyramidMapMatrix pm_matrix2;
+  pm_matrix2.Init(*config);
+  pm_matrix2.Reset();
+
+  // the samples of one cell split in two matrixes
+  pm_matrix.AddSampleSafe(10.f, 1.f, 1, 1, 0);
+  pm_matrix.AddSampleSafe(20.f, 2.f, 1, 1, 0);
+  pm_matrix2.AddSampleSafe(30.f, 3.f, 1, 1, 0);
+  pm_matrix2.AddGroundSample(3.f, 1, 1, 0);
+  pm_matrix2.AddSampleSafe(40.f, 4.f, 0, 2, 0);
+
+  pm_matrix.Reduce(pm_matrix2);
+  EXPECT_FLOAT_EQ(*pm_matrix.GetIntensitySafe(1, 1), 20.f);
+  // ((10 - 20)**2 + (20 - 20)**2 + (30 - 20)**2) / 3
+  EXPECT_NEAR(*pm_matrix.GetIntensityVarSafe(1, 1), 200.f / 3.f, 1e-4);
+  EXPECT_FLOAT_EQ(*pm_matrix.GetAltitudeSafe(1, 1), 2.f);
+  EXPECT_EQ(*pm_matrix.GetCountSafe(1, 1), 3);
+  EXPECT_FLOAT_EQ(*pm_matrix.GetGroundAltitudeSafe(1, 1), 3.f);
+  EXPECT_EQ(*pm_matrix.GetGroundCountSafe(1, 1), 1);
+  EXPECT_FLOAT_EQ(*pm_matrix.GetIntensitySafe(0, 2), 40.f);
+  EXPECT_EQ(*pm_matrix.GetCountSafe(0, 2), 1);
+
+  // empty cells in both matrixes stay empty
+  EXPECT_FLOAT_EQ(*pm_matrix.GetIntensitySafe(2, 2), 0.f);
+  EXPECT_FLOAT_EQ(*pm_matrix.GetAltitudeSafe(2, 2), 0.f);
+  EXPECT_EQ(*pm_matrix.GetCountSafe(2, 2), 0);
+}
+
 TEST_F(PyramidMapMatrixTestSuite, add_merge_get_base) {
   // map config
   std::unique_ptr<PyramidMapConfig> config(
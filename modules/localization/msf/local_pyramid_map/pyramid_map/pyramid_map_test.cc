@@ -111,6 +111,9 @@ TEST_F(PyramidMapTestSuite, pyramid_map_function) {
                          indexes.begin()->n_));
   EXPECT_TRUE(pyramid_map.IsMapNodeExist(*indexes.begin()));
   EXPECT_FALSE(pyramid_map.IsMapNodeExist(*(indexes.begin() + 1)));
+  EXPECT_EQ(pyramid_map.GetCacheStatistics().hit_count, 0u);
+  EXPECT_EQ(pyramid_map.GetCacheStatistics().miss_count, 1u);
+  EXPECT_EQ(pyramid_map.GetCacheStatistics().late_load_count, 0u);
 
   // load map area
   loc[0] = 0.125 * (config->map_node_size_x_ + 1);
@@ -120,7 +123,11 @@ TEST_F(PyramidMapTestSuite, pyramid_map_function) {
   loc_eigen[0] = loc[0];
   loc_eigen[1] = loc[1];
   EXPECT_TRUE(pyramid_map.LoadMapArea(loc, 0, 50, 0, 0));
+  const uint64_t miss_count = pyramid_map.GetCacheStatistics().miss_count;
   EXPECT_TRUE(pyramid_map.LoadMapArea(loc_eigen, 0, 50, 0, 0));
+  // the second load finds all the nodes in memory
+  EXPECT_EQ(pyramid_map.GetCacheStatistics().miss_count, miss_count);
+  EXPECT_GT(pyramid_map.GetCacheStatistics().hit_count, 0u);
   EXPECT_TRUE(pyramid_map.IsMapNodeExist(*(indexes.begin() + 5)));
   EXPECT_TRUE(pyramid_map.IsMapNodeExist(*(indexes.begin() + 6)));
   EXPECT_TRUE(pyramid_map.IsMapNodeExist(*(indexes.begin() + 9)));
@@ -142,6 +149,10 @@ TEST_F(PyramidMapTestSuite, pyramid_map_function) {
   trans_diff_eigen[2] = trans_diff[2];
   pyramid_map.PreloadMapArea(loc_eigen, trans_diff_eigen, 0, 50);
 
+  // preload the map area along the way of the next two nodes
+  Eigen::Vector3d displacement(0.5, 0.0, 0.0);
+  pyramid_map.PreloadMapAreaAhead(loc_eigen, displacement, 0, 50);
+
   // get path
   pyramid_map.ComputeMd5ForAllMapNodes();
   std::vector<std::string> paths = pyramid_map.GetAllMapNodePaths();
@@ -14,6 +14,15 @@
  * limitations under the License.
  *****************************************************************************/
 
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 
 #include <boost/filesystem.hpp>
@@ -25,6 +34,7 @@
 #include "modules/localization/msf/common/util/extract_ground_plane.h"
 #include "modules/localization/msf/common/util/file_utility.h"
 #include "modules/localization/msf/local_pyramid_map/pyramid_map/pyramid_map.h"
+#include "modules/localization/msf/local_pyramid_map/pyramid_map/pyramid_map_node.h"
 #include "modules/localization/msf/local_pyramid_map/pyramid_map/pyramid_map_pool.h"
 
 const unsigned int CAR_SENSOR_LASER_NUMBER = 64;
@@ -76,7 +86,21 @@ bool ParseCommandLine(int argc, char* argv[],
           "resolution",
           boost::program_options::value<float>()->default_value(0.125),
           "optional: resolution for single resolution generation, default: "
-          "0.125");
+          "0.125")(
+          "num_threads", boost::program_options::value<int>()->default_value(0),
+          "optional: number of threads, default: all the cores")(
+          "num_shards", boost::program_options::value<int>()->default_value(1),
+          "optional: split the frames by map node into shards, built by "
+          "separate runs (possibly on several machines), default: 1")(
+          "shard_id", boost::program_options::value<int>()->default_value(0),
+          "optional: the shard built by this run, in [0, num_shards)")(
+          "merge_shards",
+          boost::program_options::value<bool>()->default_value(false),
+          "optional: merge the built shards into the lossless map")(
+          "max_cached_nodes",
+          boost::program_options::value<int>()->default_value(256),
+          "optional: map nodes kept in memory before they are merged into "
+          "the nodes on disk, default: 256");
   try {
     boost::program_options::store(
         boost::program_options::parse_command_line(argc, argv, desc), *vm);
@@ -107,9 +131,353 @@ void VarianceOnline(double* mean, double* var, unsigned int* N, double x) {
 using ::apollo::common::EigenAffine3dVec;
 using ::apollo::common::EigenVector3dVec;
 
-int main(int argc, char** argv) {
-  FeatureXYPlane plane_extractor;
+namespace apollo {
+namespace localization {
+namespace msf {
+
+typedef std::map<MapNodeIndex, std::unique_ptr<PyramidMapNode>> MapNodes;
+
+// The frames are built in groups that cover a few map nodes, split so that the
+// frames of a long stop still spread over the threads.
+const size_t kMaxFramesPerGroup = 100;
+
+struct FrameId {
+  unsigned int trial = 0;
+  unsigned int frame_idx = 0;
+};
+
+// Run function(thread_id, i) for every i in [0, size) on num_threads threads.
+template <typename Function>
+void ParallelFor(size_t size, unsigned int num_threads, Function function) {
+  std::atomic<size_t> next(0);
+  auto worker = [&](unsigned int thread_id) {
+    for (size_t i = next++; i < size; i = next++) {
+      function(thread_id, i);
+    }
+  };
+  std::vector<std::thread> threads;
+  for (unsigned int i = 1; i < num_threads; ++i) {
+    threads.emplace_back(worker, i);
+  }
+  worker(0);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+std::string GetMapNodePath(const std::string& map_folder,
+                           const MapNodeIndex& index) {
+  char buf[1024];
+  snprintf(buf, sizeof(buf), "%s/map/%03u/%s/%02d/%08d/%08d",
+           map_folder.c_str(), index.resolution_id_,
+           index.zone_id_ > 0 ? "north" : "south", abs(index.zone_id_),
+           index.m_, index.n_);
+  return buf;
+}
+
+MapNodeIndex GetMapIndexFromMapPath(const std::string& map_path) {
+  MapNodeIndex index;
+  char buf[100];
+  sscanf(map_path.c_str(), "/%03u/%05s/%02d/%08u/%08u", &index.resolution_id_,
+         buf, &index.zone_id_, &index.m_, &index.n_);
+  std::string zone = buf;
+  if (zone == "south") {
+    index.zone_id_ = -index.zone_id_;
+  }
+  return index;
+}
+
+void GetAllMapNodeIndices(const std::string& map_folder,
+                          std::set<MapNodeIndex>* indices) {
+  const std::string map_path = map_folder + "/map";
+  if (!boost::filesystem::exists(map_path)) {
+    return;
+  }
+  boost::filesystem::recursive_directory_iterator end_iter;
+  boost::filesystem::recursive_directory_iterator iter(map_path);
+  for (; iter != end_iter; ++iter) {
+    if (!boost::filesystem::is_directory(*iter) &&
+        iter->path().extension() == "") {
+      indices->insert(GetMapIndexFromMapPath(
+          iter->path().string().substr(map_path.length())));
+    }
+  }
+}
+
+PyramidMapMatrix& GetMapMatrix(PyramidMapNode* map_node) {
+  return static_cast<PyramidMapMatrix&>(map_node->GetMapCellMatrix());
+}
+
+PyramidMapNode* GetMapNode(const PyramidMapConfig& config,
+                           const MapNodeIndex& index, MapNodes* map_nodes) {
+  std::unique_ptr<PyramidMapNode>& map_node = (*map_nodes)[index];
+  if (!map_node) {
+    map_node.reset(new PyramidMapNode());
+    map_node->Init(&config, index);
+    map_node->ResetMapNode();
+  }
+  return map_node.get();
+}
+
+// Merge a map node into the one saved in the map folder of the config, if
+// any, and save it.
+bool SaveMergedMapNode(const PyramidMapConfig& config,
+                       PyramidMapNode* map_node) {
+  const std::string path =
+      GetMapNodePath(config.map_folder_path_, map_node->GetMapNodeIndex());
+  if (apollo::cyber::common::PathExists(path)) {
+    PyramidMapNode saved_node;
+    saved_node.Init(&config, map_node->GetMapNodeIndex());
+    if (!saved_node.Load(path.c_str())) {
+      AERROR << "Fail to load map node: " << path;
+      return false;
+    }
+    GetMapMatrix(map_node).Reduce(GetMapMatrix(&saved_node));
+  }
+  return map_node->Save();
+}
+
+// Group the frames by the map node of their poses, and keep the groups of one
+// shard.
+std::vector<std::vector<FrameId>> PartitionFrames(
+    const PyramidMapConfig& config, int zone_id,
+    const std::vector<EigenAffine3dVec>& poses, int num_shards, int shard_id) {
+  std::map<MapNodeIndex, std::vector<FrameId>> node_frames;
+  for (unsigned int trial = 0; trial < poses.size(); ++trial) {
+    for (unsigned int frame_idx = 0; frame_idx < poses[trial].size();
+         ++frame_idx) {
+      FrameId frame;
+      frame.trial = trial;
+      frame.frame_idx = frame_idx;
+      node_frames[MapNodeIndex::GetMapNodeIndex(
+                      config, poses[trial][frame_idx].translation(), 0,
+                      zone_id)]
+          .push_back(frame);
+    }
+  }
+
+  std::vector<std::vector<FrameId>> groups;
+  int node_id = 0;
+  for (const auto& item : node_frames) {
+    if (node_id++ % num_shards != shard_id) {
+      continue;
+    }
+    const std::vector<FrameId>& frames = item.second;
+    for (size_t begin = 0; begin < frames.size();
+         begin += kMaxFramesPerGroup) {
+      const size_t end = std::min(frames.size(), begin + kMaxFramesPerGroup);
+      groups.emplace_back(frames.begin() + begin, frames.begin() + end);
+    }
+  }
+  return groups;
+}
+
+// Add the points of a frame to the map nodes of one thread.
+void AccumulateFrame(const PyramidMapConfig& config, int zone_id,
+                     bool use_plane_inliers_only,
+                     const velodyne::VelodyneFrame& velodyne_frame,
+                     FeatureXYPlane* plane_extractor, MapNodes* map_nodes) {
+  const unsigned int resolution_id = 0;
+  unsigned int row = 0;
+  unsigned int col = 0;
+  for (size_t i = 0; i < velodyne_frame.pt3ds.size(); ++i) {
+    const Eigen::Vector3d pt3d_global =
+        velodyne_frame.pose * velodyne_frame.pt3ds[i];
+    PyramidMapNode* map_node = GetMapNode(
+        config,
+        MapNodeIndex::GetMapNodeIndex(config, pt3d_global, resolution_id,
+                                      zone_id),
+        map_nodes);
+    map_node->GetCoordinate(pt3d_global, &col, &row);
+    GetMapMatrix(map_node).AddSampleSafe(
+        static_cast<float>(velodyne_frame.intensities[i]),
+        static_cast<float>(pt3d_global[2]), row, col, 0);
+  }
+
+  if (!use_plane_inliers_only) {
+    return;
+  }
+  PclPointCloudPtrT pcl_pc = PclPointCloudPtrT(new PclPointCloudT);
+  pcl_pc->resize(velodyne_frame.pt3ds.size());
+  for (size_t i = 0; i < velodyne_frame.pt3ds.size(); ++i) {
+    PclPointT& pt = pcl_pc->at(i);
+    pt.x = static_cast<float>(velodyne_frame.pt3ds[i][0]);
+    pt.y = static_cast<float>(velodyne_frame.pt3ds[i][1]);
+    pt.z = static_cast<float>(velodyne_frame.pt3ds[i][2]);
+    pt.intensity = static_cast<float>(velodyne_frame.intensities[i]);
+  }
+
+  plane_extractor->ExtractXYPlane(pcl_pc);
+  PclPointCloudPtrT& plane_pc = plane_extractor->GetXYPlaneCloud();
+  for (unsigned int k = 0; k < plane_pc->size(); ++k) {
+    const PclPointT& plane_pt = plane_pc->at(k);
+    const Eigen::Vector3d pt3d_global =
+        velodyne_frame.pose * Eigen::Vector3d(plane_pt.x, plane_pt.y,
+                                              plane_pt.z);
+    PyramidMapNode* map_node = GetMapNode(
+        config,
+        MapNodeIndex::GetMapNodeIndex(config, pt3d_global, resolution_id,
+                                      zone_id),
+        map_nodes);
+    map_node->GetCoordinate(pt3d_global, &col, &row);
+    GetMapMatrix(map_node).AddGroundSample(static_cast<float>(pt3d_global[2]),
+                                           row, col, 0);
+  }
+}
+
+// The map nodes merged from all the threads. They are merged into the nodes
+// on disk when there are too many of them, so the memory stays bounded.
+class SharedMapNodes {
+ public:
+  explicit SharedMapNodes(const PyramidMapConfig* config) : config_(config) {}
+
+  /**@brief Merge and release the map nodes of one thread. */
+  void Merge(MapNodes* map_nodes) {
+    for (auto& item : *map_nodes) {
+      Slot* slot = nullptr;
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::unique_ptr<Slot>& entry = slots_[item.first];
+        if (!entry) {
+          entry.reset(new Slot());
+          entry->map_node = std::move(item.second);
+          continue;
+        }
+        slot = entry.get();
+      }
+      std::lock_guard<std::mutex> lock(slot->mutex);
+      GetMapMatrix(slot->map_node.get())
+          .Reduce(GetMapMatrix(item.second.get()));
+    }
+    map_nodes->clear();
+  }
+
+  size_t Size() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return slots_.size();
+  }
+
+  /**@brief Save and release all the map nodes, while nothing is merged. */
+  bool Flush(unsigned int num_threads) {
+    std::vector<PyramidMapNode*> map_nodes;
+    for (const auto& item : slots_) {
+      map_nodes.push_back(item.second->map_node.get());
+    }
+    std::atomic<int> num_failed(0);
+    ParallelFor(map_nodes.size(), num_threads,
+                [&](unsigned int thread_id, size_t i) {
+                  if (!SaveMergedMapNode(*config_, map_nodes[i])) {
+                    ++num_failed;
+                  }
+                });
+    slots_.clear();
+    return num_failed == 0;
+  }
+
+ private:
+  struct Slot {
+    std::mutex mutex;
+    std::unique_ptr<PyramidMapNode> map_node;
+  };
+
+  const PyramidMapConfig* config_;
+  std::mutex mutex_;
+  std::map<MapNodeIndex, std::unique_ptr<Slot>> slots_;
+};
+
+// Build the map nodes of the frame groups on all the threads, into the map
+// folder of the config.
+bool BuildMapNodes(const PyramidMapConfig& config, int zone_id,
+                   bool use_plane_inliers_only,
+                   const std::vector<std::string>& pcd_folder_paths,
+                   const std::vector<EigenAffine3dVec>& poses,
+                   const std::vector<std::vector<unsigned int>>& pcd_indices,
+                   const std::vector<std::vector<FrameId>>& groups,
+                   unsigned int num_threads, size_t max_cached_nodes) {
+  std::vector<FeatureXYPlane> plane_extractors(num_threads);
+  SharedMapNodes shared_map_nodes(&config);
+  const size_t batch_size = 4 * num_threads;
+  for (size_t begin = 0; begin < groups.size(); begin += batch_size) {
+    const size_t end = std::min(groups.size(), begin + batch_size);
+    ParallelFor(end - begin, num_threads, [&](unsigned int thread_id,
+                                              size_t i) {
+      MapNodes map_nodes;
+      for (const FrameId& frame : groups[begin + i]) {
+        velodyne::VelodyneFrame velodyne_frame;
+        const std::string pcd_file_path =
+            absl::StrCat(pcd_folder_paths[frame.trial], "/",
+                         pcd_indices[frame.trial][frame.frame_idx], ".pcd");
+        velodyne::LoadPcds(pcd_file_path, frame.frame_idx,
+                           poses[frame.trial][frame.frame_idx],
+                           &velodyne_frame, false);
+        AINFO << "Loaded " << velodyne_frame.pt3ds.size()
+              << "3D Points at Trial: " << frame.trial
+              << " Frame: " << frame.frame_idx << ".";
+        AccumulateFrame(config, zone_id, use_plane_inliers_only,
+                        velodyne_frame, &plane_extractors[thread_id],
+                        &map_nodes);
+      }
+      shared_map_nodes.Merge(&map_nodes);
+    });
+    AINFO << "Built " << end << " of " << groups.size() << " frame groups.";
+
+    if (end == groups.size() || shared_map_nodes.Size() > max_cached_nodes) {
+      if (!shared_map_nodes.Flush(num_threads)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Merge the map nodes of all the shards into the map folder of the config.
+bool MergeShards(const PyramidMapConfig& config,
+                 const std::vector<std::string>& shard_folders,
+                 unsigned int num_threads) {
+  std::set<MapNodeIndex> index_set;
+  for (const auto& shard_folder : shard_folders) {
+    if (!boost::filesystem::exists(shard_folder)) {
+      AERROR << "Shard not found: " << shard_folder;
+      return false;
+    }
+    GetAllMapNodeIndices(shard_folder, &index_set);
+  }
+  const std::vector<MapNodeIndex> indices(index_set.begin(), index_set.end());
+  AINFO << "Merging " << indices.size() << " map nodes of "
+        << shard_folders.size() << " shards.";
+
+  std::atomic<int> num_failed(0);
+  ParallelFor(indices.size(), num_threads, [&](unsigned int thread_id,
+                                               size_t i) {
+    PyramidMapNode map_node;
+    map_node.Init(&config, indices[i]);
+    map_node.ResetMapNode();
+    for (const auto& shard_folder : shard_folders) {
+      const std::string path = GetMapNodePath(shard_folder, indices[i]);
+      if (!apollo::cyber::common::PathExists(path)) {
+        continue;
+      }
+      PyramidMapNode shard_node;
+      shard_node.Init(&config, indices[i]);
+      if (!shard_node.Load(path.c_str())) {
+        AERROR << "Fail to load map node: " << path;
+        ++num_failed;
+        return;
+      }
+      GetMapMatrix(&map_node).Reduce(GetMapMatrix(&shard_node));
+    }
+    if (!map_node.Save()) {
+      ++num_failed;
+    }
+  });
+  return num_failed == 0;
+}
+
+}  // namespace msf
+}  // namespace localization
+}  // namespace apollo
 
+int main(int argc, char** argv) {
   boost::program_options::variables_map boost_args;
   if (!ParseCommandLine(argc, argv, &boost_args)) {
     AERROR << "Parse input command line failed.";
@@ -162,6 +530,22 @@ int main(int argc, char** argv) {
           << "4.0, 8.0 or 16.0.";
   }
 
+  const int num_threads_arg = boost_args["num_threads"].as<int>();
+  const unsigned int num_threads =
+      num_threads_arg > 0
+          ? static_cast<unsigned int>(num_threads_arg)
+          : std::max(std::thread::hardware_concurrency(), 1u);
+  const int num_shards = boost_args["num_shards"].as<int>();
+  const int shard_id = boost_args["shard_id"].as<int>();
+  const bool merge_shards = boost_args["merge_shards"].as<bool>();
+  if (num_shards < 1 || shard_id < 0 || shard_id >= num_shards) {
+    AERROR << "Shard id invalid. (0 <= shard_id < num_shards)";
+    return -1;
+  }
+  const bool build_shard = num_shards > 1 && !merge_shards;
+  const size_t max_cached_nodes = static_cast<size_t>(
+      std::max(boost_args["max_cached_nodes"].as<int>(), 1));
+
   const size_t num_trials = pcd_folder_paths.size();
 
   // load all poses
@@ -181,7 +565,12 @@ int main(int argc, char** argv) {
   PyramidMap map(&conf);
   PyramidMapConfig& loss_less_config =
       static_cast<PyramidMapConfig&>(map.GetMapConfig());
-  std::string map_folder_path = map_base_folder + "/lossless_map";
+  // A shard is built into its own folder, and merged into the lossless map
+  // once all the shards are built.
+  std::string map_folder_path =
+      build_shard ? absl::StrCat(map_base_folder, "/lossless_map_shard_",
+                                 shard_id)
+                  : map_base_folder + "/lossless_map";
   apollo::cyber::common::EnsureDirectory(map_folder_path);
   map.SetMapFolderPath(map_folder_path);
   for (size_t i = 0; i < pcd_folder_paths.size(); ++i) {
@@ -203,12 +592,12 @@ int main(int argc, char** argv) {
 
   // Output Config file
   char file_buf[1024];
-  snprintf(file_buf, sizeof(file_buf), "%s/lossless_map/config.xml",
-           map_base_folder.c_str());
+  snprintf(file_buf, sizeof(file_buf), "%s/config.xml",
+           map_folder_path.c_str());
   loss_less_config.Save(file_buf);
 
-  snprintf(file_buf, sizeof(file_buf), "%s/lossless_map/config.txt",
-           map_base_folder.c_str());
+  snprintf(file_buf, sizeof(file_buf), "%s/config.txt",
+           map_folder_path.c_str());
   FILE* file = fopen(file_buf, "a");
 
   if (file) {
@@ -259,74 +648,34 @@ int main(int argc, char** argv) {
   map.InitMapNodeCaches(12, 24);
   map.AttachMapNodePool(&lossless_map_node_pool);
 
-  for (unsigned int trial = 0; trial < num_trials; ++trial) {
-    for (unsigned int frame_idx = 0; frame_idx < ieout_poses[trial].size();
-         ++frame_idx) {
-      unsigned int trial_frame_idx = frame_idx;
-      const EigenAffine3dVec& poses = ieout_poses[trial];
-      apollo::localization::msf::velodyne::VelodyneFrame velodyne_frame;
-      std::string pcd_file_path = absl::StrCat(
-          pcd_folder_paths[trial], "/", pcd_indices[trial][frame_idx], ".pcd");
-      const Eigen::Affine3d& pcd_pose = poses[trial_frame_idx];
-      apollo::localization::msf::velodyne::LoadPcds(
-          pcd_file_path, trial_frame_idx, pcd_pose, &velodyne_frame, false);
-      AINFO << "Loaded " << velodyne_frame.pt3ds.size()
-            << "3D Points at Trial: " << trial << " Frame: " << trial_frame_idx
-            << ".";
-
-      unsigned int resolution_id = 0;
-      unsigned int row = 0;
-      unsigned int col = 0;
-      for (size_t i = 0; i < velodyne_frame.pt3ds.size(); ++i) {
-        Eigen::Vector3d& pt3d_local = velodyne_frame.pt3ds[i];
-        unsigned char intensity = velodyne_frame.intensities[i];
-        Eigen::Vector3d pt3d_global = velodyne_frame.pose * pt3d_local;
-        MapNodeIndex map_node_index = MapNodeIndex::GetMapNodeIndex(
-            loss_less_config, pt3d_global, resolution_id, zone_id);
-        PyramidMapNode* map_node =
-            dynamic_cast<PyramidMapNode*>(map.GetMapNodeSafe(map_node_index));
-        map_node->GetCoordinate(pt3d_global, &col, &row);
-        PyramidMapMatrix& map_matrix =
-            dynamic_cast<PyramidMapMatrix&>(map_node->GetMapCellMatrix());
-        map_matrix.SetIntensitySafe(intensity, row, col);
-      }
-
-      if (use_plane_inliers_only) {
-        PclPointCloudPtrT pcl_pc = PclPointCloudPtrT(new PclPointCloudT);
-        pcl_pc->resize(velodyne_frame.pt3ds.size());
-        for (size_t i = 0; i < velodyne_frame.pt3ds.size(); ++i) {
-          PclPointT& pt = pcl_pc->at(i);
-          pt.x = static_cast<float>(velodyne_frame.pt3ds[i][0]);
-          pt.y = static_cast<float>(velodyne_frame.pt3ds[i][1]);
-          pt.z = static_cast<float>(velodyne_frame.pt3ds[i][2]);
-          pt.intensity = static_cast<float>(velodyne_frame.intensities[i]);
-        }
-
-        plane_extractor.ExtractXYPlane(pcl_pc);
-        PclPointCloudPtrT& plane_pc = plane_extractor.GetXYPlaneCloud();
-
-        for (unsigned int k = 0; k < plane_pc->size(); ++k) {
-          const PclPointT& plane_pt = plane_pc->at(k);
-          Eigen::Vector3d pt3d_local_double;
-          pt3d_local_double[0] = plane_pt.x;
-          pt3d_local_double[1] = plane_pt.y;
-          pt3d_local_double[2] = plane_pt.z;
-          unsigned char intensity =
-              static_cast<unsigned char>(plane_pt.intensity);
-          Eigen::Vector3d pt3d_global = velodyne_frame.pose * pt3d_local_double;
-          float ground_altitude = static_cast<float>(pt3d_global[2]);
-          MapNodeIndex map_node_index = MapNodeIndex::GetMapNodeIndex(
-              loss_less_config, pt3d_global, resolution_id, zone_id);
-          PyramidMapNode* map_node =
-              dynamic_cast<PyramidMapNode*>(map.GetMapNodeSafe(map_node_index));
-          map_node->GetCoordinate(pt3d_global, &col, &row);
-          PyramidMapMatrix& map_matrix =
-              dynamic_cast<PyramidMapMatrix&>(map_node->GetMapCellMatrix());
-          map_matrix.SetIntensitySafe(intensity, row, col);
-          map_matrix.SetGroundAltitudeSafe(ground_altitude, row, col);
-          map_node->SetIsChanged(true);
-        }
-      }
+  if (merge_shards) {
+    std::vector<std::string> shard_folders;
+    for (int i = 0; i < num_shards; ++i) {
+      shard_folders.push_back(
+          absl::StrCat(map_base_folder, "/lossless_map_shard_", i));
+    }
+    if (!apollo::localization::msf::MergeShards(loss_less_config,
+                                                shard_folders, num_threads)) {
+      AERROR << "Fail to merge the shards.";
+      return -1;
+    }
+  } else {
+    const std::vector<std::vector<apollo::localization::msf::FrameId>> groups =
+        apollo::localization::msf::PartitionFrames(
+            loss_less_config, zone_id, ieout_poses, num_shards, shard_id);
+    AINFO << "Building " << groups.size() << " frame groups on "
+          << num_threads << " threads.";
+    if (!apollo::localization::msf::BuildMapNodes(
+            loss_less_config, zone_id, use_plane_inliers_only,
+            pcd_folder_paths, ieout_poses, pcd_indices, groups, num_threads,
+            max_cached_nodes)) {
+      AERROR << "Fail to build the map nodes.";
+      return -1;
+    }
+    if (build_shard) {
+      AINFO << "Shard " << shard_id << " of " << num_shards
+            << " is built, merge the shards once they are all built.";
+      return 0;
     }
   }
 
@@ -14,20 +14,24 @@
  * limitations under the License.
  *****************************************************************************/
 
+#include <algorithm>
+#include <atomic>
+#include <list>
+#include <string>
+#include <thread>
+#include <vector>
+
 #include <boost/filesystem.hpp>
 #include <boost/program_options.hpp>
 
-#include "modules/localization/msf/local_pyramid_map/pyramid_map/pyramid_map.h"
 #include "modules/localization/msf/local_pyramid_map/pyramid_map/pyramid_map_config.h"
 #include "modules/localization/msf/local_pyramid_map/pyramid_map/pyramid_map_matrix.h"
-#include "modules/localization/msf/local_pyramid_map/pyramid_map/pyramid_map_pool.h"
+#include "modules/localization/msf/local_pyramid_map/pyramid_map/pyramid_map_node.h"
 
 using apollo::localization::msf::pyramid_map::MapNodeIndex;
-using apollo::localization::msf::pyramid_map::PyramidMap;
 using apollo::localization::msf::pyramid_map::PyramidMapConfig;
 using apollo::localization::msf::pyramid_map::PyramidMapMatrix;
 using apollo::localization::msf::pyramid_map::PyramidMapNode;
-using apollo::localization::msf::pyramid_map::PyramidMapNodePool;
 
 namespace apollo {
 namespace localization {
@@ -85,6 +89,66 @@ bool GetAllMapIndex(const std::string& src_map_folder,
   return true;
 }
 
+// Convert a lossless map node into a lossy one and save it.
+bool ConvertMapNode(const PyramidMapConfig& lossless_config,
+                    const PyramidMapConfig& lossy_config,
+                    const MapNodeIndex& index) {
+  PyramidMapNode lossless_node;
+  lossless_node.Init(&lossless_config, index);
+  if (!lossless_node.Load()) {
+    AWARN << "Fail to load lossless map node: " << index;
+    return false;
+  }
+  const PyramidMapMatrix& lossless_matrix =
+      static_cast<const PyramidMapMatrix&>(lossless_node.GetMapCellMatrix());
+
+  PyramidMapNode lossy_node;
+  lossy_node.Init(&lossy_config, index);
+  lossy_node.ResetMapNode();
+  PyramidMapMatrix& lossy_matrix =
+      static_cast<PyramidMapMatrix&>(lossy_node.GetMapCellMatrix());
+
+  int rows = lossless_config.map_node_size_y_;
+  int cols = lossless_config.map_node_size_x_;
+  for (int row = 0; row < rows; ++row) {
+    for (int col = 0; col < cols; ++col) {
+      const float* intensity = lossless_matrix.GetIntensitySafe(row, col);
+      const float* intensity_var =
+          lossless_matrix.GetIntensityVarSafe(row, col);
+      const unsigned int* count = lossless_matrix.GetCountSafe(row, col);
+      // Read altitude
+      const float* altitude_avg = lossless_matrix.GetAltitudeSafe(row, col);
+      const float* altitude_var = lossless_matrix.GetAltitudeVarSafe(row, col);
+      const float* altitude_ground =
+          lossless_matrix.GetGroundAltitudeSafe(row, col);
+      const unsigned int* ground_count =
+          lossless_matrix.GetGroundCountSafe(row, col);
+      if (intensity) {
+        lossy_matrix.SetIntensitySafe(*intensity, row, col);
+      }
+      if (intensity_var) {
+        lossy_matrix.SetIntensityVarSafe(*intensity_var, row, col);
+      }
+      if (count) {
+        lossy_matrix.SetCountSafe(*count, row, col);
+      }
+      if (altitude_avg) {
+        lossy_matrix.SetAltitudeSafe(*altitude_avg, row, col);
+      }
+      if (altitude_var) {
+        lossy_matrix.SetAltitudeVarSafe(*altitude_var, row, col);
+      }
+      if (altitude_ground) {
+        lossy_matrix.SetGroundAltitudeSafe(*altitude_ground, row, col);
+      }
+      if (ground_count) {
+        lossy_matrix.SetGroundCountSafe(*ground_count, row, col);
+      }
+    }
+  }
+  return lossy_node.Save();
+}
+
 }  // namespace msf
 }  // namespace localization
 }  // namespace apollo
@@ -95,7 +159,9 @@ int main(int argc, char** argv) {
       "srcdir", boost::program_options::value<std::string>(),
       "provide the data base dir")("dstdir",
                                    boost::program_options::value<std::string>(),
-                                   "provide the lossy map destination dir");
+                                   "provide the lossy map destination dir")(
+      "num_threads", boost::program_options::value<int>()->default_value(0),
+      "number of threads, default: all the cores");
 
   boost::program_options::variables_map boost_args;
   boost::program_options::store(
@@ -113,17 +179,18 @@ int main(int argc, char** argv) {
   const std::string dst_path = boost_args["dstdir"].as<std::string>();
   std::string src_map_folder = src_path + "/";
 
-  PyramidMapConfig lossless_config("lossless_map");
-  PyramidMapNodePool lossless_map_node_pool(25, 8);
-  lossless_map_node_pool.Initial(&lossless_config);
+  const int num_threads_arg = boost_args["num_threads"].as<int>();
+  const unsigned int num_threads =
+      num_threads_arg > 0
+          ? static_cast<unsigned int>(num_threads_arg)
+          : std::max(std::thread::hardware_concurrency(), 1u);
 
-  PyramidMap lossless_map(&lossless_config);
-  lossless_map.InitMapNodeCaches(12, 24);
-  lossless_map.AttachMapNodePool(&lossless_map_node_pool);
-  if (!lossless_map.SetMapFolderPath(src_map_folder)) {
+  PyramidMapConfig lossless_config("lossless_map");
+  if (!lossless_config.Load(src_map_folder + "config.xml")) {
     AERROR << "Reflectance map folder is invalid!";
     return -1;
   }
+  lossless_config.map_folder_path_ = src_map_folder;
 
   // create lossy map
   std::string dst_map_folder = dst_path + "/lossy_map/";
@@ -140,76 +207,32 @@ int main(int argc, char** argv) {
   config_transform_lossy.Load(src_map_folder + "config.xml");
   config_transform_lossy.map_version_ = "lossy_map";
   config_transform_lossy.Save(dst_map_folder + "config.xml");
+  config_transform_lossy.map_folder_path_ = dst_map_folder;
 
   AINFO << "lossy map directory structure has built.";
 
-  PyramidMapNodePool lossy_map_node_pool(25, 8);
-  lossy_map_node_pool.Initial(&config_transform_lossy);
-  PyramidMap lossy_map(&config_transform_lossy);
-  lossy_map.InitMapNodeCaches(12, 24);
-  lossy_map.AttachMapNodePool(&lossy_map_node_pool);
-  if (!lossy_map.SetMapFolderPath(dst_map_folder)) {
-    AINFO << "lossy_map config xml not exist";
-  }
-
-  int index = 0;
-  auto itr = buf.begin();
-  for (; itr != buf.end(); ++itr, ++index) {
-    PyramidMapNode* lossless_node =
-        static_cast<PyramidMapNode*>(lossless_map.GetMapNodeSafe(*itr));
-    if (lossless_node == nullptr) {
-      AWARN << "index: " << index << " is a nullptr pointer!";
-      continue;
-    }
-    PyramidMapMatrix& lossless_matrix =
-        static_cast<PyramidMapMatrix&>(lossless_node->GetMapCellMatrix());
-
-    PyramidMapNode* lossy_node =
-        static_cast<PyramidMapNode*>(lossy_map.GetMapNodeSafe(*itr));
-    PyramidMapMatrix& lossy_matrix =
-        static_cast<PyramidMapMatrix&>(lossy_node->GetMapCellMatrix());
-
-    int rows = lossless_config.map_node_size_y_;
-    int cols = lossless_config.map_node_size_x_;
-    for (int row = 0; row < rows; ++row) {
-      for (int col = 0; col < cols; ++col) {
-        const float* intensity = lossless_matrix.GetIntensitySafe(row, col);
-        const float* intensity_var =
-            lossless_matrix.GetIntensityVarSafe(row, col);
-        const unsigned int* count = lossless_matrix.GetCountSafe(row, col);
-        // Read altitude
-        const float* altitude_avg = lossless_matrix.GetAltitudeSafe(row, col);
-        const float* altitude_var =
-            lossless_matrix.GetAltitudeVarSafe(row, col);
-        const float* altitude_ground =
-            lossless_matrix.GetGroundAltitudeSafe(row, col);
-        const unsigned int* ground_count =
-            lossless_matrix.GetGroundCountSafe(row, col);
-        if (intensity) {
-          lossy_matrix.SetIntensitySafe(*intensity, row, col);
-        }
-        if (intensity_var) {
-          lossy_matrix.SetIntensityVarSafe(*intensity_var, row, col);
-        }
-        if (count) {
-          lossy_matrix.SetCountSafe(*count, row, col);
-        }
-        if (altitude_avg) {
-          lossy_matrix.SetAltitudeSafe(*altitude_avg, row, col);
-        }
-        if (altitude_var) {
-          lossy_matrix.SetAltitudeVarSafe(*altitude_var, row, col);
-        }
-        if (altitude_ground) {
-          lossy_matrix.SetGroundAltitudeSafe(*altitude_ground, row, col);
-        }
-        if (ground_count) {
-          lossy_matrix.SetGroundCountSafe(*ground_count, row, col);
-        }
+  // The nodes are independent, each thread converts its own ones.
+  const std::vector<MapNodeIndex> indices(buf.begin(), buf.end());
+  std::atomic<size_t> next(0);
+  std::atomic<int> num_failed(0);
+  auto worker = [&]() {
+    for (size_t i = next++; i < indices.size(); i = next++) {
+      if (!apollo::localization::msf::ConvertMapNode(
+              lossless_config, config_transform_lossy, indices[i])) {
+        ++num_failed;
       }
     }
-    lossy_node->SetIsChanged(true);
+  };
+  std::vector<std::thread> threads;
+  for (unsigned int i = 1; i < num_threads; ++i) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto& thread : threads) {
+    thread.join();
   }
+  AINFO << "Converted " << indices.size() - num_failed << " of "
+        << indices.size() << " map nodes.";
 
   return 0;
 }
@@ -0,0 +1,155 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Rewrite the nodes of a pyramid map with another compression, lz4 by
+ *        default, which is much cheaper to decode than zlib when the nodes are
+ *        loaded online.
+ */
+
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+
+#include "cyber/common/log.h"
+#include "modules/localization/msf/common/util/compression.h"
+#include "modules/localization/msf/local_pyramid_map/pyramid_map/pyramid_map_config.h"
+#include "modules/localization/msf/local_pyramid_map/pyramid_map/pyramid_map_node.h"
+
+using apollo::localization::msf::CompressionStrategy;
+using apollo::localization::msf::Lz4Strategy;
+using apollo::localization::msf::ZlibStrategy;
+using apollo::localization::msf::pyramid_map::MapNodeIndex;
+using apollo::localization::msf::pyramid_map::PyramidMapConfig;
+using apollo::localization::msf::pyramid_map::PyramidMapNode;
+
+namespace apollo {
+namespace localization {
+namespace msf {
+
+MapNodeIndex GetMapIndexFromMapPath(const std::string& map_path) {
+  MapNodeIndex index;
+  char buf[100];
+  sscanf(map_path.c_str(), "/%03u/%05s/%02d/%08u/%08u", &index.resolution_id_,
+         buf, &index.zone_id_, &index.m_, &index.n_);
+  std::string zone = buf;
+  if (zone == "south") {
+    index.zone_id_ = -index.zone_id_;
+  }
+  return index;
+}
+
+// Paths of all the node files in the map folder, relative to its map
+// directory.
+std::vector<std::string> GetAllMapNodePaths(const std::string& map_folder) {
+  std::vector<std::string> paths;
+  const std::string map_path = map_folder + "/map";
+  boost::filesystem::recursive_directory_iterator end_iter;
+  boost::filesystem::recursive_directory_iterator iter(map_path);
+  for (; iter != end_iter; ++iter) {
+    if (!boost::filesystem::is_directory(*iter) &&
+        iter->path().extension() == "") {
+      paths.push_back(iter->path().string().substr(map_path.length()));
+    }
+  }
+  return paths;
+}
+
+CompressionStrategy* CreateCompressionStrategy(const std::string& name) {
+  if (name == "lz4") {
+    return new Lz4Strategy();
+  }
+  if (name == "zlib") {
+    return new ZlibStrategy();
+  }
+  return nullptr;
+}
+
+}  // namespace msf
+}  // namespace localization
+}  // namespace apollo
+
+int main(int argc, char** argv) {
+  boost::program_options::options_description boost_desc("Allowed options");
+  boost_desc.add_options()("help", "produce help message")(
+      "srcdir", boost::program_options::value<std::string>(),
+      "provide the source map dir")(
+      "dstdir", boost::program_options::value<std::string>(),
+      "provide the converted map dir")(
+      "compression",
+      boost::program_options::value<std::string>()->default_value("lz4"),
+      "lz4, zlib or none");
+
+  boost::program_options::variables_map boost_args;
+  boost::program_options::store(
+      boost::program_options::parse_command_line(argc, argv, boost_desc),
+      boost_args);
+  boost::program_options::notify(boost_args);
+
+  if (boost_args.count("help") || !boost_args.count("srcdir") ||
+      !boost_args.count("dstdir")) {
+    AERROR << boost_desc;
+    return 0;
+  }
+
+  const std::string src_map_folder = boost_args["srcdir"].as<std::string>();
+  const std::string dst_map_folder = boost_args["dstdir"].as<std::string>();
+  const std::string compression = boost_args["compression"].as<std::string>();
+  if (compression != "lz4" && compression != "zlib" && compression != "none") {
+    AERROR << "Unknown compression: " << compression;
+    return -1;
+  }
+
+  PyramidMapConfig config("lossy_map");
+  if (!config.Load(src_map_folder + "/config.xml")) {
+    AERROR << "Fail to load the map config in " << src_map_folder;
+    return -1;
+  }
+  if (!boost::filesystem::exists(dst_map_folder)) {
+    boost::filesystem::create_directories(dst_map_folder);
+  }
+  config.map_folder_path_ = dst_map_folder;
+  config.Save(dst_map_folder + "/config.xml");
+
+  const std::vector<std::string> paths =
+      apollo::localization::msf::GetAllMapNodePaths(src_map_folder);
+  AINFO << "Map node number: " << paths.size();
+  int num_converted = 0;
+  for (const auto& path : paths) {
+    PyramidMapNode node;
+    node.Init(&config);
+    node.SetMapNodeIndex(
+        apollo::localization::msf::GetMapIndexFromMapPath(path));
+    const std::string src_path = src_map_folder + "/map" + path;
+    if (!node.Load(src_path.c_str())) {
+      AERROR << "Fail to load map node: " << src_path;
+      continue;
+    }
+    node.SetCompressionStrategy(
+        apollo::localization::msf::CreateCompressionStrategy(compression));
+    if (!node.Save()) {
+      AERROR << "Fail to save map node: " << path;
+      continue;
+    }
+    ++num_converted;
+  }
+  AINFO << "Converted " << num_converted << " of " << paths.size()
+        << " map nodes to " << compression << ".";
+  return num_converted == static_cast<int>(paths.size()) ? 0 : -1;
+}
@@ -71,6 +71,11 @@ void MSFLocalization::InitParams() {
   localization_param_.lidar_yaw_align_mode = FLAGS_lidar_yaw_align_mode;
   localization_param_.lidar_filter_size = FLAGS_lidar_filter_size;
   localization_param_.map_coverage_theshold = FLAGS_lidar_map_coverage_theshold;
+  localization_param_.map_preload_time = FLAGS_lidar_map_preload_time;
+  localization_param_.coarse_search_range = FLAGS_lidar_coarse_search_range;
+  localization_param_.coarse_search_levels = FLAGS_lidar_coarse_search_levels;
+  localization_param_.coarse_search_candidates =
+      FLAGS_lidar_coarse_search_candidates;
   localization_param_.imu_lidar_max_delay_time = FLAGS_lidar_imu_max_delay_time;
   localization_param_.if_use_avx = FLAGS_if_use_avx;
 
@@ -216,24 +221,23 @@ void MSFLocalization::OnRawImu(
   const auto &result = localization_integ_.GetLastestIntegLocalization();
 
   // compose localization status
-  LocalizationStatus status;
-  apollo::common::Header *status_headerpb = status.mutable_header();
+  apollo::common::Header *status_headerpb = imu_status_.mutable_header();
   status_headerpb->set_timestamp_sec(
       result.localization().header().timestamp_sec());
-  status.set_fusion_status(
+  imu_status_.set_fusion_status(
       static_cast<MeasureState>(result.integ_status().integ_state));
-  status.set_state_message(result.integ_status().state_message);
-  status.set_measurement_time(result.localization().measurement_time());
-  publisher_->PublishLocalizationStatus(status);
+  imu_status_.set_state_message(result.integ_status().state_message);
+  imu_status_.set_measurement_time(result.localization().measurement_time());
+  publisher_->PublishLocalizationStatus(imu_status_);
 
   if (result.state() == msf::LocalizationMeasureState::OK ||
       result.state() == msf::LocalizationMeasureState::VALID) {
     // calculate orientation_vehicle_world
-    LocalizationEstimate local_result = result.localization();
-    CompensateImuVehicleExtrinsic(&local_result);
+    imu_localization_.CopyFrom(result.localization());
+    CompensateImuVehicleExtrinsic(&imu_localization_);
 
-    publisher_->PublishPoseBroadcastTF(local_result);
-    publisher_->PublishPoseBroadcastTopic(local_result);
+    publisher_->PublishPoseBroadcastTF(imu_localization_);
+    publisher_->PublishPoseBroadcastTopic(imu_localization_);
   }
 
   localization_state_ = result.state();
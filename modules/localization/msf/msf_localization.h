@@ -105,6 +105,10 @@ class MSFLocalization {
   std::shared_ptr<LocalizationMsgPublisher> publisher_;
   std::shared_ptr<drivers::gnss::Imu> raw_imu_msg_;
   std::mutex mutex_imu_msg_;
+
+  // Reused by every imu message, so that publishing does not reallocate them.
+  LocalizationStatus imu_status_;
+  LocalizationEstimate imu_localization_;
 };
 
 }  // namespace localization
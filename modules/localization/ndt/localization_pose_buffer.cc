@@ -26,12 +26,8 @@ namespace apollo {
 namespace localization {
 namespace ndt {
 
-const unsigned int LocalizationPoseBuffer::s_buffer_size_ = 20;
-
 LocalizationPoseBuffer::LocalizationPoseBuffer() {
-  lidar_poses_.resize(s_buffer_size_);
-  used_buffer_size_ = 0;
-  head_index_ = 0;
+  lidar_pose_samples_.resize(s_buffer_size_);
   has_initialized_ = false;
 }
 
@@ -40,33 +36,27 @@ LocalizationPoseBuffer::~LocalizationPoseBuffer() {}
 void LocalizationPoseBuffer::UpdateLidarPose(
     double timestamp, const Eigen::Affine3d& locator_pose,
     const Eigen::Affine3d& novatel_pose) {
+  LocalizationStampedPosePair pose_pair;
+  pose_pair.timestamp = timestamp;
+  pose_pair.locator_pose = locator_pose;
+  pose_pair.novatel_pose = novatel_pose;
   if (!has_initialized_) {
-    lidar_poses_[head_index_].locator_pose = locator_pose;
-    lidar_poses_[head_index_].locator_pose.linear() = novatel_pose.linear();
-    lidar_poses_[head_index_].novatel_pose = novatel_pose;
-    lidar_poses_[head_index_].timestamp = timestamp;
-    ++used_buffer_size_;
+    pose_pair.locator_pose.linear() = novatel_pose.linear();
     has_initialized_ = true;
-  } else {
-    // add 10Hz pose
-    unsigned int empty_position =
-        (head_index_ + used_buffer_size_) % s_buffer_size_;
-    lidar_poses_[empty_position].locator_pose = locator_pose;
-    lidar_poses_[empty_position].novatel_pose = novatel_pose;
-    lidar_poses_[empty_position].timestamp = timestamp;
-
-    if (used_buffer_size_ == s_buffer_size_) {
-      head_index_ = (head_index_ + 1) % s_buffer_size_;
-    } else {
-      ++used_buffer_size_;
-    }
+  }
+  // add 10Hz pose
+  if (!lidar_poses_.Push(timestamp, pose_pair)) {
+    AWARN << "Drop lidar pose older than the latest one: "
+          << std::setprecision(15) << timestamp;
   }
 }
 
 Eigen::Affine3d LocalizationPoseBuffer::UpdateOdometryPose(
     double timestamp, const Eigen::Affine3d& novatel_pose) {
   Eigen::Affine3d pose = novatel_pose;
-  if (used_buffer_size_ > 0) {
+  const size_t used_buffer_size =
+      lidar_poses_.GetSamples(lidar_pose_samples_.data());
+  if (used_buffer_size > 0) {
     pose.translation()[0] = 0;
     pose.translation()[1] = 0;
     pose.translation()[2] = 0;
@@ -82,18 +72,17 @@ Eigen::Affine3d LocalizationPoseBuffer::UpdateOdometryPose(
     pose_ev[1] = 0;
     pose_ev[2] = 0;
 
-    for (unsigned int c = 0, i = head_index_; c < used_buffer_size_;
-         ++c, i = (i + 1) % s_buffer_size_) {
-      predict_pose.translation() = lidar_poses_[i].locator_pose.translation() -
-                                   lidar_poses_[i].novatel_pose.translation() +
+    for (size_t i = 0; i < used_buffer_size; ++i) {
+      const LocalizationStampedPosePair& pose_pair =
+          lidar_pose_samples_[i].value;
+      predict_pose.translation() = pose_pair.locator_pose.translation() -
+                                   pose_pair.novatel_pose.translation() +
                                    novatel_pose.translation();
       pose.translation() += predict_pose.translation();
 
-      Eigen::Quaterniond pair_locator_quat(
-          lidar_poses_[i].locator_pose.linear());
+      Eigen::Quaterniond pair_locator_quat(pose_pair.locator_pose.linear());
       pair_locator_quat.normalize();
-      Eigen::Quaterniond pair_novatel_quat(
-          lidar_poses_[i].novatel_pose.linear());
+      Eigen::Quaterniond pair_novatel_quat(pose_pair.novatel_pose.linear());
       pair_novatel_quat.normalize();
       Eigen::Quaterniond predict_pose_quat =
           pair_locator_quat * pair_novatel_quat.inverse() * novatel_quat;
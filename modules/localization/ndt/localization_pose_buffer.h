@@ -21,6 +21,8 @@
 #include "Eigen/Geometry"
 #include "Eigen/StdVector"
 
+#include "modules/localization/common/seqlock_ring_buffer.h"
+
 namespace apollo {
 namespace localization {
 namespace ndt {
@@ -48,19 +50,27 @@ class LocalizationPoseBuffer {
   Eigen::Affine3d UpdateOdometryPose(double timestamp,
                                      const Eigen::Affine3d& novatel_pose);
   /**@brief Get the used size of buffer*/
-  unsigned int GetUsedBufferSize() { return used_buffer_size_; }
+  unsigned int GetUsedBufferSize() {
+    return static_cast<unsigned int>(lidar_poses_.Size());
+  }
   /**@brief Get the current head of the buffer*/
-  unsigned int GetHeadIndex() { return head_index_; }
+  unsigned int GetHeadIndex() {
+    return static_cast<unsigned int>(
+        (lidar_poses_.TotalCount() - lidar_poses_.Size()) % s_buffer_size_);
+  }
 
  private:
-  static const unsigned int s_buffer_size_;
+  static constexpr unsigned int s_buffer_size_ = 20;
+  typedef SeqlockRingBuffer<LocalizationStampedPosePair, s_buffer_size_>
+      PosePairBuffer;
 
  private:
-  std::vector<LocalizationStampedPosePair,
-              Eigen::aligned_allocator<LocalizationStampedPosePair>>
-      lidar_poses_;
-  unsigned int used_buffer_size_;
-  unsigned int head_index_;
+  /**@brief Written by the lidar thread, read by the odometry thread. */
+  PosePairBuffer lidar_poses_;
+  /**@brief Copy of lidar_poses_ used by the odometry thread. */
+  std::vector<PosePairBuffer::Sample,
+              Eigen::aligned_allocator<PosePairBuffer::Sample>>
+      lidar_pose_samples_;
   bool has_initialized_;
 };
 
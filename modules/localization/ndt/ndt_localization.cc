@@ -16,6 +16,8 @@
 
 #include "modules/localization/ndt/ndt_localization.h"
 
+#include <algorithm>
+
 #include "Eigen/Geometry"
 #include "yaml-cpp/yaml.h"
 
@@ -26,6 +28,7 @@
 #include "modules/common/math/quaternion.h"
 #include "modules/drivers/gnss/proto/gnss_best_pose.pb.h"
 #include "modules/localization/common/localization_gflags.h"
+#include "modules/localization/common/point_cloud_preprocessor.h"
 
 namespace apollo {
 namespace localization {
@@ -88,8 +91,7 @@ void NDTLocalization::Init() {
   lidar_locator_.SetOnlineCloudResolution(
       static_cast<float>(online_resolution_));
 
-  odometry_buffer_.clear();
-  odometry_buffer_size_ = 0;
+  odometry_buffer_.Clear();
 
   is_service_started_ = false;
 }
@@ -128,18 +130,9 @@ void NDTLocalization::OdometryCallback(
     return;
   }
 
-  TimeStampPose timestamp_pose;
-  timestamp_pose.timestamp = odometry_time;
-  timestamp_pose.pose = odometry_pose;
-  {
-    std::lock_guard<std::mutex> lock(odometry_buffer_mutex_);
-    if (odometry_buffer_size_ < max_odometry_buffer_size_) {
-      odometry_buffer_.push_back(timestamp_pose);
-      odometry_buffer_size_++;
-    } else {
-      odometry_buffer_.pop_front();
-      odometry_buffer_.push_back(timestamp_pose);
-    }
+  if (!odometry_buffer_.Push(odometry_time, odometry_pose)) {
+    AWARN << "Drop odometry older than the latest one: "
+          << std::setprecision(15) << odometry_time;
   }
 
   if (ndt_debug_log_flag_) {
@@ -404,30 +397,17 @@ void NDTLocalization::ComposeLocalizationStatus(
 bool NDTLocalization::QueryPoseFromBuffer(double time, Eigen::Affine3d* pose) {
   CHECK_NOTNULL(pose);
 
-  TimeStampPose pre_pose;
-  TimeStampPose next_pose;
-  {
-    std::lock_guard<std::mutex> lock(odometry_buffer_mutex_);
-    TimeStampPose timestamp_pose = odometry_buffer_.back();
+  OdometryBuffer::Sample pre_pose;
+  OdometryBuffer::Sample next_pose;
+  if (!odometry_buffer_.FindBracket(time, &pre_pose, &next_pose)) {
     // check abnormal timestamp
-    if (time > timestamp_pose.timestamp) {
+    if (odometry_buffer_.GetLatest(&next_pose) && time > next_pose.timestamp) {
       AERROR << "query time is newer than latest odometry time, it doesn't "
                 "make sense!";
-      return false;
-    }
-    // search from reverse direction
-    auto iter = odometry_buffer_.crbegin();
-    for (; iter != odometry_buffer_.crend(); ++iter) {
-      if (iter->timestamp < time) {
-        break;
-      }
-    }
-    if (iter == odometry_buffer_.crend()) {
+    } else {
       AINFO << "Cannot find matching pose from odometry buffer";
-      return false;
     }
-    pre_pose = *iter;
-    next_pose = *(--iter);
+    return false;
   }
   // interpolation
   double v1 =
@@ -435,14 +415,14 @@ bool NDTLocalization::QueryPoseFromBuffer(double time, Eigen::Affine3d* pose) {
   double v2 =
       (time - pre_pose.timestamp) / (next_pose.timestamp - pre_pose.timestamp);
   pose->translation() =
-      pre_pose.pose.translation() * v1 + next_pose.pose.translation() * v2;
+      pre_pose.value.translation() * v1 + next_pose.value.translation() * v2;
 
-  Eigen::Quaterniond pre_quat(pre_pose.pose.linear());
+  Eigen::Quaterniond pre_quat(pre_pose.value.linear());
 
   common::math::EulerAnglesZXYd pre_euler(pre_quat.w(), pre_quat.x(),
                                           pre_quat.y(), pre_quat.z());
 
-  Eigen::Quaterniond next_quat(next_pose.pose.linear());
+  Eigen::Quaterniond next_quat(next_pose.value.linear());
   common::math::EulerAnglesZXYd next_euler(next_quat.w(), next_quat.x(),
                                            next_quat.y(), next_quat.z());
 
@@ -472,52 +452,33 @@ void NDTLocalization::LidarMsgTransfer(
     const std::shared_ptr<drivers::PointCloud>& msg, LidarFrame* lidar_frame) {
   CHECK_NOTNULL(lidar_frame);
 
+  int num_points = msg->point_size();
   if (msg->height() > 1 && msg->width() > 1) {
-    for (unsigned int i = 0; i < msg->height(); ++i) {
-      for (unsigned int j = 0; j < msg->width(); ++j) {
-        Eigen::Vector3f pt3d;
-        pt3d[0] = msg->point(i * msg->width() + j).x();
-        pt3d[1] = msg->point(i * msg->width() + j).y();
-        pt3d[2] = msg->point(i * msg->width() + j).z();
-        if (!std::isnan(pt3d[0])) {
-          Eigen::Vector3f pt3d_tem = pt3d;
-
-          if (pt3d_tem[2] > max_height_) {
-            continue;
-          }
-          unsigned char intensity = static_cast<unsigned char>(
-              msg->point(i * msg->width() + j).intensity());
-          lidar_frame->pt_xs.push_back(pt3d[0]);
-          lidar_frame->pt_ys.push_back(pt3d[1]);
-          lidar_frame->pt_zs.push_back(pt3d[2]);
-          lidar_frame->intensities.push_back(intensity);
-        }
-      }
-    }
+    num_points = std::min(num_points,
+                          static_cast<int>(msg->height() * msg->width()));
   } else {
     AINFO << "Receiving un-organized-point-cloud, width " << msg->width()
           << " height " << msg->height() << "size " << msg->point_size();
-    for (int i = 0; i < msg->point_size(); ++i) {
-      Eigen::Vector3f pt3d;
-      pt3d[0] = msg->point(i).x();
-      pt3d[1] = msg->point(i).y();
-      pt3d[2] = msg->point(i).z();
-      if (!std::isnan(pt3d[0])) {
-        Eigen::Vector3f pt3d_tem = pt3d;
-
-        if (pt3d_tem[2] > max_height_) {
-          continue;
-        }
-        unsigned char intensity =
-            static_cast<unsigned char>(msg->point(i).intensity());
-        lidar_frame->pt_xs.push_back(pt3d[0]);
-        lidar_frame->pt_ys.push_back(pt3d[1]);
-        lidar_frame->pt_zs.push_back(pt3d[2]);
-        lidar_frame->intensities.push_back(intensity);
-      }
-    }
   }
 
+  // Copy all the points at once, then drop the invalid ones in place.
+  lidar_frame->pt_xs.resize(num_points);
+  lidar_frame->pt_ys.resize(num_points);
+  lidar_frame->pt_zs.resize(num_points);
+  lidar_frame->intensities.resize(num_points);
+  for (int i = 0; i < num_points; ++i) {
+    const drivers::PointXYZIT& point = msg->point(i);
+    lidar_frame->pt_xs[i] = point.x();
+    lidar_frame->pt_ys[i] = point.y();
+    lidar_frame->pt_zs[i] = point.z();
+    lidar_frame->intensities[i] =
+        static_cast<unsigned char>(point.intensity());
+  }
+  PointFilterParams filter_params;
+  filter_params.max_height = max_height_;
+  FilterPoints(filter_params, &lidar_frame->pt_xs, &lidar_frame->pt_ys,
+               &lidar_frame->pt_zs, &lidar_frame->intensities);
+
   lidar_frame->measurement_time =
       cyber::Time(msg->measurement_time()).ToSecond();
   if (ndt_debug_log_flag_) {
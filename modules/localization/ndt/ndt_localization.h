@@ -22,6 +22,7 @@
 #include "Eigen/Geometry"
 #include "modules/drivers/gnss/proto/ins.pb.h"
 #include "modules/drivers/proto/pointcloud.pb.h"
+#include "modules/localization/common/seqlock_ring_buffer.h"
 #include "modules/localization/ndt/localization_pose_buffer.h"
 #include "modules/localization/ndt/ndt_locator/lidar_locator_ndt.h"
 #include "modules/localization/proto/gps.pb.h"
@@ -38,12 +39,6 @@ struct LidarHeight {
   double height_var;
 };
 
-struct TimeStampPose {
-  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
-  double timestamp = 0.0;
-  Eigen::Affine3d pose;
-};
-
 class NDTLocalization {
  public:
   EIGEN_MAKE_ALIGNED_OPERATOR_NEW
@@ -133,10 +128,8 @@ class NDTLocalization {
   double error_ndt_score_ = 2.0;
   bool is_service_started_ = false;
 
-  std::list<TimeStampPose> odometry_buffer_;
-  std::mutex odometry_buffer_mutex_;
-  unsigned int odometry_buffer_size_ = 0;
-  const unsigned int max_odometry_buffer_size_ = 100;
+  typedef SeqlockRingBuffer<Eigen::Affine3d, 100> OdometryBuffer;
+  OdometryBuffer odometry_buffer_;
 
   LocalizationEstimate localization_result_;
   LocalizationStatus localization_status_;
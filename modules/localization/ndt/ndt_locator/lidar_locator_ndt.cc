@@ -33,6 +33,12 @@ namespace apollo {
 namespace localization {
 namespace ndt {
 
+namespace {
+// Distance from the origin of the incremental target beyond which it is
+// rebuilt around the vehicle, to keep the precision of the float clouds.
+constexpr double kTargetOriginResetDistance = 1000.0;
+}  // namespace
+
 LidarLocatorNdt::LidarLocatorNdt()
     : config_("map_ndt_v01"), map_(&config_), map_preload_node_pool_(30, 12) {
   Eigen::Translation3d trans(0, 0, 0);
@@ -85,6 +91,7 @@ void LidarLocatorNdt::Init(const Eigen::Affine3d& init_location,
   reg_.SetResolution(static_cast<float>(ndt_target_resolution_));
   reg_.SetStepSize(ndt_line_search_step_size_);
   reg_.SetTransformationEpsilon(ndt_transformation_epsilon_);
+  reg_.SetNumThreads(FLAGS_ndt_num_threads);
 
   is_initialized_ = true;
 }
@@ -158,26 +165,22 @@ int LidarLocatorNdt::Update(unsigned int frame_idx, const Eigen::Affine3d& pose,
   lt_y -= (map_.GetMapConfig().map_node_size_y_ * map_resolution / 2.0);
 
   // Start Ndt method
-  // Convert online points to pcl pointcloud
   apollo::common::util::Timer online_filtered_timer;
   online_filtered_timer.Start();
-  pcl::PointCloud<pcl::PointXYZ>::Ptr online_points(
-      new pcl::PointCloud<pcl::PointXYZ>());
-  for (unsigned int i = 0; i < lidar_frame.pt_xs.size(); ++i) {
-    pcl::PointXYZ p(lidar_frame.pt_xs[i], lidar_frame.pt_ys[i],
-                    lidar_frame.pt_zs[i]);
-    online_points->push_back(p);
-  }
 
   // Filter online points
   AINFO << "Online point cloud leaf size: " << proj_reslution_;
+  downsampler_.SetLeafSize(proj_reslution_);
+  downsampler_.Filter(lidar_frame.pt_xs, lidar_frame.pt_ys, lidar_frame.pt_zs,
+                      &online_centroids_);
   pcl::PointCloud<pcl::PointXYZ>::Ptr online_points_filtered(
       new pcl::PointCloud<pcl::PointXYZ>());
-  pcl::VoxelGrid<pcl::PointXYZ> sor;
-  sor.setInputCloud(online_points);
-  sor.setLeafSize(proj_reslution_, proj_reslution_, proj_reslution_);
-  sor.filter(*online_points_filtered);
-  AINFO << "Online Pointcloud size: " << online_points->size() << "/"
+  online_points_filtered->reserve(online_centroids_.size());
+  for (const Eigen::Vector3f& centroid : online_centroids_) {
+    online_points_filtered->push_back(
+        pcl::PointXYZ(centroid.x(), centroid.y(), centroid.z()));
+  }
+  AINFO << "Online Pointcloud size: " << lidar_frame.pt_xs.size() << "/"
         << online_points_filtered->size();
   online_filtered_timer.End("online point calc end.");
 
@@ -185,25 +188,44 @@ int LidarLocatorNdt::Update(unsigned int frame_idx, const Eigen::Affine3d& pose,
   apollo::common::util::Timer map_timer;
   map_timer.Start();
   Eigen::Vector2d left_top_coord2d(lt_x, lt_y);
-  ComposeMapCells(left_top_coord2d, zone_id_, resolution_id_,
-                  map_.GetMapConfig().map_resolutions_[resolution_id_],
-                  transform.inverse());
-
-  // Convert map pointcloud to local corrdinate
-  pcl::PointCloud<pcl::PointXYZ>::Ptr pcl_map_point_cloud(
-      new pcl::PointCloud<pcl::PointXYZ>());
-  for (unsigned int i = 0; i < cell_map_.size(); ++i) {
-    Leaf& le = cell_map_[i];
-    float mean_0 = static_cast<float>(le.mean_(0));
-    float mean_1 = static_cast<float>(le.mean_(1));
-    float mean_2 = static_cast<float>(le.mean_(2));
-    pcl_map_point_cloud->push_back(pcl::PointXYZ(mean_0, mean_1, mean_2));
+  Eigen::Vector3d target_translation = Eigen::Vector3d::Zero();
+  if (FLAGS_ndt_incremental_target) {
+    // The target stays in the frame of a fixed origin, and only the map
+    // nodes entering or leaving the area are updated.
+    if (!is_target_origin_set_ ||
+        (transform.translation() - target_origin_).head<2>().norm() >
+            kTargetOriginResetDistance) {
+      reg_.ClearTarget();
+      reg_.SetLeftTopCorner(Eigen::Vector3d::Zero());
+      target_origin_ = transform.translation();
+      is_target_origin_set_ = true;
+    }
+    UpdateTargetMapNodes(left_top_coord2d, zone_id_, resolution_id_,
+                         map_.GetMapConfig().map_resolutions_[resolution_id_]);
+    target_translation = transform.translation() - target_origin_;
+    map_timer.End("Map update end.");
+  } else {
+    ComposeMapCells(left_top_coord2d, zone_id_, resolution_id_,
+                    map_.GetMapConfig().map_resolutions_[resolution_id_],
+                    transform.inverse());
+
+    // Convert map pointcloud to local corrdinate
+    pcl::PointCloud<pcl::PointXYZ>::Ptr pcl_map_point_cloud(
+        new pcl::PointCloud<pcl::PointXYZ>());
+    for (unsigned int i = 0; i < cell_map_.size(); ++i) {
+      Leaf& le = cell_map_[i];
+      float mean_0 = static_cast<float>(le.mean_(0));
+      float mean_1 = static_cast<float>(le.mean_(1));
+      float mean_2 = static_cast<float>(le.mean_(2));
+      pcl_map_point_cloud->push_back(pcl::PointXYZ(mean_0, mean_1, mean_2));
+    }
+    map_timer.End("Map create end.");
+    // Set left top corner for reg
+    reg_.SetLeftTopCorner(map_left_top_corner_);
+    // Ndt calculation
+    reg_.SetInputTarget(cell_map_, pcl_map_point_cloud);
+    is_target_origin_set_ = false;
   }
-  map_timer.End("Map create end.");
-  // Set left top corner for reg
-  reg_.SetLeftTopCorner(map_left_top_corner_);
-  // Ndt calculation
-  reg_.SetInputTarget(cell_map_, pcl_map_point_cloud);
   reg_.SetInputSource(online_points_filtered);
 
   apollo::common::util::Timer ndt_timer;
@@ -211,6 +233,7 @@ int LidarLocatorNdt::Update(unsigned int frame_idx, const Eigen::Affine3d& pose,
   Eigen::Matrix3d inv_R = transform.inverse().linear();
   Eigen::Matrix4d init_matrix = Eigen::Matrix4d::Identity();
   init_matrix.block<3, 3>(0, 0) = inv_R.inverse();
+  init_matrix.block<3, 1>(0, 3) = target_translation;
 
   pcl::PointCloud<pcl::PointXYZ>::Ptr output_cloud(
       new pcl::PointCloud<pcl::PointXYZ>);
@@ -449,48 +472,10 @@ void LidarLocatorNdt::ComposeMapCells(
           map_node_ptr = map_node_xy;
         }
 
-        // get map matrix
-        NdtMapMatrix& map_cells =
-            dynamic_cast<NdtMapMatrix&>(map_node_ptr->GetMapCellMatrix());
-
-        // start obtain cells in MapNdtMatrix
-        const Eigen::Vector2d& left_top_corner =
-            map_node_ptr->GetLeftTopCorner();
-        double resolution = map_node_ptr->GetMapResolution();
-        double resolution_z = map_node_ptr->GetMapResolutionZ();
-        for (int map_y = map_nodes_zones[y * 3 + x][1];
-             map_y <= map_nodes_zones[y * 3 + x][3]; ++map_y) {
-          for (int map_x = map_nodes_zones[y * 3 + x][0];
-               map_x <= map_nodes_zones[y * 3 + x][2]; ++map_x) {
-            const NdtMapCells& cell_ndt = map_cells.GetMapCell(map_y, map_x);
-            if (cell_ndt.cells_.size() > 0) {
-              for (auto it = cell_ndt.cells_.begin();
-                   it != cell_ndt.cells_.end(); ++it) {
-                unsigned int cell_count = it->second.count_;
-                if (cell_count >= 6) {
-                  Leaf leaf;
-                  leaf.nr_points_ = static_cast<int>(cell_count);
-
-                  Eigen::Vector3d eigen_point(Eigen::Vector3d::Zero());
-                  eigen_point(0) = left_top_corner[0] + map_x * resolution +
-                                   it->second.centroid_[0];
-                  eigen_point(1) = left_top_corner[1] + map_y * resolution +
-                                   it->second.centroid_[1];
-                  eigen_point(2) =
-                      resolution_z * it->first + it->second.centroid_[2];
-                  leaf.mean_ = (eigen_point + R_inv_t);
-                  if (it->second.is_icov_available_ == 1) {
-                    leaf.icov_ = it->second.centroid_icov_.cast<double>();
-                  } else {
-                    leaf.nr_points_ = -1;
-                  }
-
-                  cell_map_.push_back(leaf);
-                }
-              }
-            }
-          }
-        }
+        AppendMapNodeCells(*map_node_ptr, map_nodes_zones[y * 3 + x][0],
+                           map_nodes_zones[y * 3 + x][1],
+                           map_nodes_zones[y * 3 + x][2],
+                           map_nodes_zones[y * 3 + x][3], R_inv_t, &cell_map_);
       }
     }
   }
@@ -498,6 +483,111 @@ void LidarLocatorNdt::ComposeMapCells(
   timer.End("Compose map cells.");
 }
 
+void LidarLocatorNdt::UpdateTargetMapNodes(
+    const Eigen::Vector2d& left_top_coord2d, int zone_id,
+    unsigned int resolution_id, float map_pixel_resolution) {
+  apollo::common::util::Timer timer;
+  timer.Start();
+
+  // The map nodes overlapping the area composed by ComposeMapCells.
+  Eigen::Vector2d coord2d = left_top_coord2d;
+  coord2d[0] -= map_pixel_resolution * static_cast<float>(filter_x_ / 2);
+  coord2d[1] -= map_pixel_resolution * static_cast<float>(filter_y_ / 2);
+  Eigen::Vector2d coord2d_end = coord2d;
+  coord2d_end[0] +=
+      map_pixel_resolution * static_cast<float>(2 * (filter_x_ / 2) - 1);
+  coord2d_end[1] +=
+      map_pixel_resolution * static_cast<float>(2 * (filter_y_ / 2) - 1);
+  const MapNodeIndex index_begin = MapNodeIndex::GetMapNodeIndex(
+      map_.GetMapConfig(), coord2d, resolution_id, zone_id);
+  const MapNodeIndex index_end = MapNodeIndex::GetMapNodeIndex(
+      map_.GetMapConfig(), coord2d_end, resolution_id, zone_id);
+
+  std::vector<MapNodeIndex> map_ids;
+  std::vector<int64_t> block_ids;
+  for (unsigned int m = index_begin.m_; m <= index_end.m_; ++m) {
+    for (unsigned int n = index_begin.n_; n <= index_end.n_; ++n) {
+      MapNodeIndex map_id = index_begin;
+      map_id.m_ = m;
+      map_id.n_ = n;
+      map_ids.push_back(map_id);
+      block_ids.push_back((static_cast<int64_t>(m) << 32) | n);
+    }
+  }
+
+  // Drop the nodes left behind, then add the ones entering the area.
+  for (const int64_t block_id : reg_.GetTargetBlockIds()) {
+    if (std::find(block_ids.begin(), block_ids.end(), block_id) ==
+        block_ids.end()) {
+      reg_.RemoveTargetBlock(block_id);
+    }
+  }
+  const int map_node_size_x =
+      static_cast<int>(map_.GetMapConfig().map_node_size_x_);
+  const int map_node_size_y =
+      static_cast<int>(map_.GetMapConfig().map_node_size_y_);
+  for (size_t i = 0; i < map_ids.size(); ++i) {
+    if (reg_.HasTargetBlock(block_ids[i])) {
+      continue;
+    }
+    NdtMapNode* map_node =
+        dynamic_cast<NdtMapNode*>(map_.GetMapNodeSafe(map_ids[i]));
+    if (map_node == nullptr) {
+      AWARN << "Map node " << map_ids[i] << " is not available.";
+      continue;
+    }
+    std::vector<Leaf> cells;
+    AppendMapNodeCells(*map_node, 0, 0, map_node_size_x - 1,
+                       map_node_size_y - 1, -target_origin_, &cells);
+    reg_.AddTargetBlock(block_ids[i], &cells);
+  }
+
+  timer.End("Update target map nodes.");
+}
+
+void LidarLocatorNdt::AppendMapNodeCells(const NdtMapNode& map_node,
+                                         int start_x, int start_y, int end_x,
+                                         int end_y,
+                                         const Eigen::Vector3d& offset,
+                                         std::vector<Leaf>* cells) {
+  // get map matrix
+  const NdtMapMatrix& map_cells =
+      dynamic_cast<const NdtMapMatrix&>(map_node.GetMapCellMatrix());
+
+  // start obtain cells in MapNdtMatrix
+  const Eigen::Vector2d& left_top_corner = map_node.GetLeftTopCorner();
+  double resolution = map_node.GetMapResolution();
+  double resolution_z = map_node.GetMapResolutionZ();
+  for (int map_y = start_y; map_y <= end_y; ++map_y) {
+    for (int map_x = start_x; map_x <= end_x; ++map_x) {
+      const NdtMapCells& cell_ndt = map_cells.GetMapCell(map_y, map_x);
+      for (auto it = cell_ndt.cells_.begin(); it != cell_ndt.cells_.end();
+           ++it) {
+        unsigned int cell_count = it->second.count_;
+        if (cell_count >= 6) {
+          Leaf leaf;
+          leaf.nr_points_ = static_cast<int>(cell_count);
+
+          Eigen::Vector3d eigen_point(Eigen::Vector3d::Zero());
+          eigen_point(0) = left_top_corner[0] + map_x * resolution +
+                           it->second.centroid_[0];
+          eigen_point(1) = left_top_corner[1] + map_y * resolution +
+                           it->second.centroid_[1];
+          eigen_point(2) = resolution_z * it->first + it->second.centroid_[2];
+          leaf.mean_ = (eigen_point + offset);
+          if (it->second.is_icov_available_ == 1) {
+            leaf.icov_ = it->second.centroid_icov_.cast<double>();
+          } else {
+            leaf.nr_points_ = -1;
+          }
+
+          cells->push_back(leaf);
+        }
+      }
+    }
+  }
+}
+
 }  // namespace ndt
 }  // namespace localization
 }  // namespace apollo
@@ -24,6 +24,7 @@
 #include "pcl/point_cloud.h"
 #include "pcl/point_types.h"
 
+#include "modules/localization/common/point_cloud_preprocessor.h"
 #include "modules/localization/msf/local_pyramid_map/base_map/base_map_node_index.h"
 #include "modules/localization/msf/local_pyramid_map/ndt_map/ndt_map.h"
 #include "modules/localization/msf/local_pyramid_map/ndt_map/ndt_map_matrix.h"
@@ -105,6 +106,12 @@ class LidarLocatorNdt {
                        unsigned int resolution_id, float map_pixel_resolution,
                        const Eigen::Affine3d& inverse_transform);
 
+  /**@brief Add the map nodes entering the candidate map area to the target
+   * of ndt, and remove the ones leaving it. */
+  void UpdateTargetMapNodes(const Eigen::Vector2d& left_top_coord2d,
+                            int zone_id, unsigned int resolution_id,
+                            float map_pixel_resolution);
+
   /**@brief Set online cloud resolution. */
   void SetOnlineCloudResolution(const float& online_resolution);
 
@@ -129,6 +136,12 @@ class LidarLocatorNdt {
   inline double GetFitnessScore() const { return fitness_score_; }
 
  private:
+  /**@brief Append the cells of a map node in the given range of its matrix,
+   * with their means shifted by the offset. */
+  void AppendMapNodeCells(const NdtMapNode& map_node, int start_x, int start_y,
+                          int end_x, int end_y, const Eigen::Vector3d& offset,
+                          std::vector<Leaf>* cells);
+
   /**@brief Whether initialized. */
   bool is_initialized_ = false;
   /**@brief Whether map is loaded. */
@@ -162,6 +175,10 @@ class LidarLocatorNdt {
   int filter_y_ = 0;
   /**@brief Online pointclouds resoltion. */
   float proj_reslution_ = 1.0;
+  /**@brief Downsampler of the online pointclouds. */
+  VoxelGridDownsampler downsampler_;
+  /**@brief Downsampled online points, reused between the frames. */
+  std::vector<Eigen::Vector3f> online_centroids_;
 
   /**@brief The config file of map. */
   NdtMapConfig config_;
@@ -173,6 +190,10 @@ class LidarLocatorNdt {
   std::vector<Leaf> cell_map_;
   /**brief Map Left top corner.*/
   Eigen::Vector3d map_left_top_corner_;
+  /**@brief Origin of the incrementally updated target. */
+  Eigen::Vector3d target_origin_;
+  /**@brief Whether the target is updated incrementally around the origin. */
+  bool is_target_origin_set_ = false;
   /**@brief NDT transform class. */
   NormalDistributionsTransform<pcl::PointXYZ, pcl::PointXYZ> reg_;
 
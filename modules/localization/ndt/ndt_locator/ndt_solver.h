@@ -55,6 +55,7 @@
 
 #pragma once
 
+#include <future>
 #include <limits>
 #include <vector>
 
@@ -62,6 +63,7 @@
 #include "unsupported/Eigen/NonLinearOptimization"
 
 #include "cyber/common/log.h"
+#include "cyber/task/task.h"
 #include "modules/common/util/perf_util.h"
 #include "modules/localization/ndt/ndt_locator/ndt_voxel_grid_covariance.h"
 
@@ -127,6 +129,37 @@ class NormalDistributionsTransform {
     target_cells_.filter(cell_leaf, true);
   }
 
+  /**@brief Add the cells of a block, e.g. a map node, to the input target
+   * without rebuilding it. The cells are moved out of the given vector, and
+   * the resolution must not change while any block is in the target. */
+  inline void AddTargetBlock(int64_t block_id, std::vector<Leaf> *cell_leaf) {
+    target_cells_.SetVoxelGridResolution(resolution_, resolution_, resolution_);
+    target_cells_.AddBlock(block_id, cell_leaf);
+    target_.reset();
+  }
+
+  /**@brief Remove the cells of a block from the input target. */
+  inline void RemoveTargetBlock(int64_t block_id) {
+    target_cells_.RemoveBlock(block_id);
+    target_.reset();
+  }
+
+  /**@brief Whether the cells of a block are in the input target. */
+  inline bool HasTargetBlock(int64_t block_id) const {
+    return target_cells_.HasBlock(block_id);
+  }
+
+  /**@brief Get the ids of the blocks in the input target. */
+  inline std::vector<int64_t> GetTargetBlockIds() const {
+    return target_cells_.GetBlockIds();
+  }
+
+  /**@brief Remove all the cells from the input target. */
+  inline void ClearTarget() {
+    target_cells_.Clear();
+    target_.reset();
+  }
+
   /**@brief Provide a pointer to the input target. */
   inline void SetInputSource(const PointCloudTargetConstPtr &cloud) {
     if (cloud->points.empty()) {
@@ -158,6 +191,10 @@ class NormalDistributionsTransform {
    */
   inline void SetStepSize(double step_size) { step_size_ = step_size; }
 
+  /**@brief Set the number of threads computing the derivatives of the
+   * probability function. */
+  inline void SetNumThreads(int num_threads) { num_threads_ = num_threads; }
+
   /**@brief Get the point cloud outlier ratio. */
   inline double GetOulierRatio() const { return outlier_ratio_; }
 
@@ -254,6 +291,14 @@ class NormalDistributionsTransform {
                             Eigen::Matrix<double, 6, 1> *p,
                             bool ComputeHessian = true);
 
+  /**@brief Compute derivatives of probability function of the source points
+   * in [begin, end). */
+  double ComputeDerivatives(size_t begin, size_t end,
+                            const PointCloudSource &trans_cloud,
+                            Eigen::Matrix<double, 6, 1> *score_gradient,
+                            Eigen::Matrix<double, 6, 6> *hessian,
+                            bool ComputeHessian);
+
   /**@brief Compute individual point contributions to derivatives of
    * probability function w.r.t. the transformation vector. */
   double UpdateDerivatives(Eigen::Matrix<double, 6, 1> *score_gradient,
@@ -261,6 +306,13 @@ class NormalDistributionsTransform {
                            const Eigen::Vector3d &x_trans,
                            const Eigen::Matrix3d &c_inv,
                            bool ComputeHessian = true);
+  double UpdateDerivatives(Eigen::Matrix<double, 6, 1> *score_gradient,
+                           Eigen::Matrix<double, 6, 6> *hessian,
+                           const Eigen::Vector3d &x_trans,
+                           const Eigen::Matrix3d &c_inv,
+                           const Eigen::Matrix<double, 3, 6> &point_gradient,
+                           const Eigen::Matrix<double, 18, 6> &point_hessian,
+                           bool ComputeHessian) const;
 
   /**@brief Precompute anglular components of derivatives. */
   void ComputeAngleDerivatives(const Eigen::Matrix<double, 6, 1> &p,
@@ -269,6 +321,10 @@ class NormalDistributionsTransform {
   /**@brief Compute point derivatives. */
   void ComputePointDerivatives(const Eigen::Vector3d &x,
                                bool ComputeHessian = true);
+  void ComputePointDerivatives(const Eigen::Vector3d &x,
+                               Eigen::Matrix<double, 3, 6> *point_gradient,
+                               Eigen::Matrix<double, 18, 6> *point_hessian,
+                               bool ComputeHessian) const;
 
   /**@brief Compute hessian of probability function w.r.t. the transformation
    * vector. */
@@ -369,6 +425,8 @@ class NormalDistributionsTransform {
   /**@brief The second order derivative of the transformation of a point
    * w.r.t. the transform vector, Equation 6.20 [Magnusson 2009]. */
   Eigen::Matrix<double, 18, 6> point_hessian_;
+  /**@brief The number of threads computing the derivatives. */
+  int num_threads_ = 1;
 
  public:
   EIGEN_MAKE_ALIGNED_OPERATOR_NEW
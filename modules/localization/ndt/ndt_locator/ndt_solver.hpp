@@ -103,6 +103,13 @@ void NormalDistributionsTransform<PointSource, PointTarget>::Align(
 template <typename PointSource, typename PointTarget>
 double NormalDistributionsTransform<PointSource, PointTarget>::GetFitnessScore(
     double max_range) {
+  // The target built by blocks is their voxel centroids
+  if (!target_) {
+    target_ = target_cells_.GetCentroids();
+  }
+  if (target_->points.empty()) {
+    return std::numeric_limits<double>::max();
+  }
   // Set the target tree
   target_tree_->setInputCloud(target_);
   double fitness_score = 0.0;
@@ -324,59 +331,99 @@ NormalDistributionsTransform<PointSource, PointTarget>::ComputeDerivatives(
     Eigen::Matrix<double, 6, 1> *score_gradient,
     Eigen::Matrix<double, 6, 6> *hessian, PointCloudSourcePtr trans_cloud,
     Eigen::Matrix<double, 6, 1> *p, bool compute_hessian) {
-  // Original Point and Transformed Point
-  PointSource x_pt, x_trans_pt;
+  // Precompute Angular Derivatives (eq. 6.19 and 6.21)[Magnusson 2009]
+  ComputeAngleDerivatives(*p);
+
+  const size_t num_points = input_->points.size();
+  const size_t num_threads = std::min(
+      static_cast<size_t>(std::max(num_threads_, 1)), num_points / 1000 + 1);
+  if (num_threads == 1) {
+    return ComputeDerivatives(0, num_points, *trans_cloud, score_gradient,
+                              hessian, compute_hessian);
+  }
+
+  // Each thread accumulates the derivatives of a range of points, the sums
+  // are reduced in a fixed order so the result is deterministic.
+  std::vector<Eigen::Matrix<double, 6, 1>,
+              Eigen::aligned_allocator<Eigen::Matrix<double, 6, 1>>>
+      score_gradients(num_threads);
+  std::vector<Eigen::Matrix<double, 6, 6>,
+              Eigen::aligned_allocator<Eigen::Matrix<double, 6, 6>>>
+      hessians(num_threads);
+  std::vector<std::future<double>> scores;
+  for (size_t i = 0; i < num_threads; ++i) {
+    const size_t begin = num_points * i / num_threads;
+    const size_t end = num_points * (i + 1) / num_threads;
+    Eigen::Matrix<double, 6, 1> *thread_score_gradient = &score_gradients[i];
+    Eigen::Matrix<double, 6, 6> *thread_hessian = &hessians[i];
+    scores.emplace_back(cyber::Async([=]() {
+      return ComputeDerivatives(begin, end, *trans_cloud, thread_score_gradient,
+                                thread_hessian, compute_hessian);
+    }));
+  }
+
+  score_gradient->setZero();
+  hessian->setZero();
+  double score = 0;
+  for (size_t i = 0; i < num_threads; ++i) {
+    score += scores[i].get();
+    *score_gradient += score_gradients[i];
+    *hessian += hessians[i];
+  }
+  return score;
+}
+
+template <typename PointSource, typename PointTarget>
+double
+NormalDistributionsTransform<PointSource, PointTarget>::ComputeDerivatives(
+    size_t begin, size_t end, const PointCloudSource &trans_cloud,
+    Eigen::Matrix<double, 6, 1> *score_gradient,
+    Eigen::Matrix<double, 6, 6> *hessian, bool compute_hessian) {
   // Original Point and Transformed Point (for math)
   Eigen::Vector3d x, x_trans;
-  // Occupied Voxel
-  TargetGridLeafConstPtr cell;
-  // Inverse Covariance of Occupied Voxel
-  Eigen::Matrix3d c_inv;
+  // Point derivatives of this range, the constant parts are copied
+  Eigen::Matrix<double, 3, 6> point_gradient = point_gradient_;
+  Eigen::Matrix<double, 18, 6> point_hessian = point_hessian_;
+  std::vector<TargetGridLeafConstPtr> neighborhood;
+  std::vector<float> distances;
 
   score_gradient->setZero();
   hessian->setZero();
   double score = 0;
 
-  // Precompute Angular Derivatives (eq. 6.19 and 6.21)[Magnusson 2009]
-  ComputeAngleDerivatives(*p);
-
   // Update gradient and hessian for each point, line 17 in Algorithm 2
   // [Magnusson 2009]
-  for (size_t idx = 0; idx < input_->points.size(); idx++) {
-    x_trans_pt = trans_cloud->points[idx];
+  for (size_t idx = begin; idx < end; idx++) {
+    const PointSource &x_trans_pt = trans_cloud.points[idx];
 
     // Find neighbors (Radius search has been experimentally faster than
     // direct neighbor checking.
-    std::vector<TargetGridLeafConstPtr> neighborhood;
-    std::vector<float> distances;
     target_cells_.RadiusSearch(x_trans_pt, resolution_, &neighborhood,
                                &distances);
+    if (neighborhood.empty()) {
+      continue;
+    }
 
-    for (typename std::vector<TargetGridLeafConstPtr>::iterator
-             neighborhood_it = neighborhood.begin();
-         neighborhood_it != neighborhood.end(); neighborhood_it++) {
-      cell = *neighborhood_it;
-      x_pt = input_->points[idx];
-      x = Eigen::Vector3d(x_pt.x, x_pt.y, x_pt.z);
+    const PointSource &x_pt = input_->points[idx];
+    x = Eigen::Vector3d(x_pt.x, x_pt.y, x_pt.z);
+    // Compute derivative of transform function w.r.t. transform vector,
+    // J_E and H_E in Equations 6.18 and 6.20 [Magnusson 2009]
+    ComputePointDerivatives(x, &point_gradient, &point_hessian,
+                            compute_hessian);
 
+    for (const TargetGridLeafConstPtr cell : neighborhood) {
       x_trans = Eigen::Vector3d(x_trans_pt.x, x_trans_pt.y, x_trans_pt.z);
-
       // Denorm point, x_k' in Equations 6.12 and 6.13 [Magnusson 2009]
       x_trans -= cell->GetMean();
-      // Uses precomputed covariance for speed.
-      c_inv = cell->GetInverseCov();
-
-      // Compute derivative of transform function w.r.t. transform vector,
-      // J_E and H_E in Equations 6.18 and 6.20 [Magnusson 2009]
-      ComputePointDerivatives(x);
       // Update score, gradient and hessian, lines 19-21 in Algorithm 2,
       // according to Equations 6.10, 6.12 and 6.13, respectively [Magnusson
-      // 2009]
-      score += UpdateDerivatives(score_gradient, hessian, x_trans, c_inv,
-                                 compute_hessian);
+      // 2009]. Uses precomputed covariance for speed.
+      score += UpdateDerivatives(score_gradient, hessian, x_trans,
+                                 cell->GetInverseCov(), point_gradient,
+                                 point_hessian, compute_hessian);
     }
   }
-  return (score);
+  return score;
 }
 
 template <typename PointSource, typename PointTarget>
@@ -453,17 +500,27 @@ template <typename PointSource, typename PointTarget>
 void NormalDistributionsTransform<
     PointSource, PointTarget>::ComputePointDerivatives(const Eigen::Vector3d &x,
                                                        bool compute_hessian) {
+  ComputePointDerivatives(x, &point_gradient_, &point_hessian_,
+                          compute_hessian);
+}
+
+template <typename PointSource, typename PointTarget>
+void NormalDistributionsTransform<PointSource, PointTarget>::
+    ComputePointDerivatives(const Eigen::Vector3d &x,
+                            Eigen::Matrix<double, 3, 6> *point_gradient,
+                            Eigen::Matrix<double, 18, 6> *point_hessian,
+                            bool compute_hessian) const {
   // Calculate first derivative of Transformation Equation 6.17 w.r.t. transform
   // vector p. Derivative w.r.t. ith element of transform vector corresponds to
   // column i, Equation 6.18 and 6.19 [Magnusson 2009]
-  point_gradient_(1, 3) = x.dot(j_ang_a_);
-  point_gradient_(2, 3) = x.dot(j_ang_b_);
-  point_gradient_(0, 4) = x.dot(j_ang_c_);
-  point_gradient_(1, 4) = x.dot(j_ang_d_);
-  point_gradient_(2, 4) = x.dot(j_ang_e_);
-  point_gradient_(0, 5) = x.dot(j_ang_f_);
-  point_gradient_(1, 5) = x.dot(j_ang_g_);
-  point_gradient_(2, 5) = x.dot(j_ang_h_);
+  (*point_gradient)(1, 3) = x.dot(j_ang_a_);
+  (*point_gradient)(2, 3) = x.dot(j_ang_b_);
+  (*point_gradient)(0, 4) = x.dot(j_ang_c_);
+  (*point_gradient)(1, 4) = x.dot(j_ang_d_);
+  (*point_gradient)(2, 4) = x.dot(j_ang_e_);
+  (*point_gradient)(0, 5) = x.dot(j_ang_f_);
+  (*point_gradient)(1, 5) = x.dot(j_ang_g_);
+  (*point_gradient)(2, 5) = x.dot(j_ang_h_);
 
   if (compute_hessian) {
     // Vectors from Equation 6.21 [Magnusson 2009]
@@ -480,15 +537,15 @@ void NormalDistributionsTransform<
     // transform vector p. Derivative w.r.t. ith and jth elements of transform
     // vector corresponds to the 3x1 block matrix starting at (3i,j),
     // Equation 6.20 and 6.21 [Magnusson 2009]
-    point_hessian_.block<3, 1>(9, 3) = a;
-    point_hessian_.block<3, 1>(12, 3) = b;
-    point_hessian_.block<3, 1>(15, 3) = c;
-    point_hessian_.block<3, 1>(9, 4) = b;
-    point_hessian_.block<3, 1>(12, 4) = d;
-    point_hessian_.block<3, 1>(15, 4) = e;
-    point_hessian_.block<3, 1>(9, 5) = c;
-    point_hessian_.block<3, 1>(12, 5) = e;
-    point_hessian_.block<3, 1>(15, 5) = f;
+    point_hessian->block<3, 1>(9, 3) = a;
+    point_hessian->block<3, 1>(12, 3) = b;
+    point_hessian->block<3, 1>(15, 3) = c;
+    point_hessian->block<3, 1>(9, 4) = b;
+    point_hessian->block<3, 1>(12, 4) = d;
+    point_hessian->block<3, 1>(15, 4) = e;
+    point_hessian->block<3, 1>(9, 5) = c;
+    point_hessian->block<3, 1>(12, 5) = e;
+    point_hessian->block<3, 1>(15, 5) = f;
   }
 }
 
@@ -498,6 +555,19 @@ NormalDistributionsTransform<PointSource, PointTarget>::UpdateDerivatives(
     Eigen::Matrix<double, 6, 1> *score_gradient,
     Eigen::Matrix<double, 6, 6> *hessian, const Eigen::Vector3d &x_trans,
     const Eigen::Matrix3d &c_inv, bool compute_hessian) {
+  return UpdateDerivatives(score_gradient, hessian, x_trans, c_inv,
+                           point_gradient_, point_hessian_, compute_hessian);
+}
+
+template <typename PointSource, typename PointTarget>
+double
+NormalDistributionsTransform<PointSource, PointTarget>::UpdateDerivatives(
+    Eigen::Matrix<double, 6, 1> *score_gradient,
+    Eigen::Matrix<double, 6, 6> *hessian, const Eigen::Vector3d &x_trans,
+    const Eigen::Matrix3d &c_inv,
+    const Eigen::Matrix<double, 3, 6> &point_gradient,
+    const Eigen::Matrix<double, 18, 6> &point_hessian,
+    bool compute_hessian) const {
   Eigen::Vector3d cov_dxd_pi;
   // e^(-d_2/2 * (x_k - mu_k)^T Sigma_k^-1 (x_k - mu_k)) Equation 6.9 [Magnusson
   // 2009]
@@ -519,7 +589,7 @@ NormalDistributionsTransform<PointSource, PointTarget>::UpdateDerivatives(
   for (int i = 0; i < 6; i++) {
     // Sigma_k^-1 d(T(x,p))/dpi, Reusable portion of Equation 6.12 and 6.13
     // [Magnusson 2009]
-    cov_dxd_pi = c_inv * point_gradient_.col(i);
+    cov_dxd_pi = c_inv * point_gradient.col(i);
 
     // Update gradient, Equation 6.12 [Magnusson 2009]
     (*score_gradient)(i) += x_trans.dot(cov_dxd_pi) * e_x_cov_x;
@@ -530,9 +600,9 @@ NormalDistributionsTransform<PointSource, PointTarget>::UpdateDerivatives(
         (*hessian)(i, j) +=
             e_x_cov_x *
             (-gauss_d2_ * x_trans.dot(cov_dxd_pi) *
-                 x_trans.dot(c_inv * point_gradient_.col(j)) +
-             x_trans.dot(c_inv * point_hessian_.block<3, 1>(3 * i, j)) +
-             point_gradient_.col(j).dot(cov_dxd_pi));
+                 x_trans.dot(c_inv * point_gradient.col(j)) +
+             x_trans.dot(c_inv * point_hessian.block<3, 1>(3 * i, j)) +
+             point_gradient.col(j).dot(cov_dxd_pi));
       }
     }
   }
@@ -52,12 +52,14 @@
 
 #pragma once
 
+#include <cmath>
+#include <cstdint>
 #include <map>
+#include <unordered_map>
 #include <vector>
 
 #include "pcl/filters/boost.h"
 #include "pcl/filters/voxel_grid.h"
-#include "pcl/kdtree/kdtree_flann.h"
 #include "pcl/point_types.h"
 
 #include "cyber/common/log.h"
@@ -98,7 +100,10 @@ typedef Leaf *LeafPtr;
 typedef const Leaf *LeafConstPtr;
 
 /**@brief A searchable voxel structure containing the mean and covariance of the
- * data. */
+ * data. The usable leaves are found through a hashed index of the voxels
+ * containing their means. The grid is either built at once from a set of
+ * leaves by filter(), or kept up to date block by block, e.g. map node by map
+ * node, with AddBlock() and RemoveBlock(). */
 template <typename PointT>
 class VoxelGridCovariance {
  public:
@@ -126,10 +131,11 @@ class VoxelGridCovariance {
         leaves_(),
         voxel_centroids_(),
         voxel_centroids_leaf_indices_(),
-        kdtree_() {
+        is_centroids_dirty_(false) {
     leaf_size_.setZero();
     min_b_.setZero();
     max_b_.setZero();
+    map_left_top_corner_.setZero();
   }
 
   /**@brief Provide a pointer to the input dataset. */
@@ -153,15 +159,48 @@ class VoxelGridCovariance {
   /**@brief Initializes voxel structure. */
   inline void filter(const std::vector<Leaf> &cell_leaf,
                      bool searchable = true) {
+    Clear();
     voxel_centroids_ = PointCloudPtr(new PointCloud);
     SetMap(cell_leaf, voxel_centroids_);
-    if (voxel_centroids_->size() > 0) {
-      kdtree_.setInputCloud(voxel_centroids_);
+    for (size_t i = 0; i < voxel_centroids_leaf_indices_.size(); ++i) {
+      const PointT &centroid = voxel_centroids_->points[i];
+      const Eigen::Vector3d local_centroid =
+          Eigen::Vector3d(centroid.x, centroid.y, centroid.z) -
+          map_left_top_corner_;
+      voxel_index_[GetVoxelKey(local_centroid)].push_back(
+          &leaves_[voxel_centroids_leaf_indices_[i]]);
     }
   }
 
   void SetMap(const std::vector<Leaf> &map_leaves, PointCloudPtr output);
 
+  /**@brief Add the leaves of a block to the grid without rebuilding it, the
+   * leaves are moved out of the given vector. The leaves set by filter() are
+   * dropped, and the map left top corner must be kept while any block is in
+   * the grid. */
+  void AddBlock(int64_t block_id, std::vector<Leaf> *leaves);
+
+  /**@brief Remove the leaves of a block from the grid. */
+  void RemoveBlock(int64_t block_id);
+
+  /**@brief Whether the leaves of a block are in the grid. */
+  inline bool HasBlock(int64_t block_id) const {
+    return blocks_.find(block_id) != blocks_.end();
+  }
+
+  /**@brief Get the ids of the blocks in the grid. */
+  inline std::vector<int64_t> GetBlockIds() const {
+    std::vector<int64_t> block_ids;
+    block_ids.reserve(blocks_.size());
+    for (const auto &block : blocks_) {
+      block_ids.push_back(block.first);
+    }
+    return block_ids;
+  }
+
+  /**@brief Remove all the leaves and blocks from the grid. */
+  void Clear();
+
   /**@brief Get the voxel containing point p. */
   inline LeafConstPtr GetLeaf(int index) {
     typename std::map<size_t, Leaf>::iterator leaf_iter = leaves_.find(index);
@@ -232,14 +271,15 @@ class VoxelGridCovariance {
   inline const std::map<size_t, Leaf> &GetLeaves() { return leaves_; }
 
   /**@brief Get a pointcloud containing the voxel centroids. */
-  inline PointCloudPtr GetCentroids() { return voxel_centroids_; }
+  PointCloudPtr GetCentroids();
 
   /**@brief Search for all the nearest occupied voxels of the query point in a
-   * given radius. */
+   * given radius. At most max_nn voxels are returned if it is not 0, which
+   * are not necessarily the nearest ones. */
   int RadiusSearch(const PointT &point, double radius,
                    std::vector<LeafConstPtr> *k_leaves,
                    std::vector<float> *k_sqr_distances,
-                   unsigned int max_nn = 0);
+                   unsigned int max_nn = 0) const;
 
   void GetDisplayCloud(pcl::PointCloud<pcl::PointXYZ> *cell_cloud);
 
@@ -259,6 +299,21 @@ class VoxelGridCovariance {
   }
 
  protected:
+  /**@brief Get the hash key of the voxel containing a point given in the
+   * frame of the map left top corner, 21 bits per axis. Voxels far enough
+   * apart may share a key, the searches check the distances anyway. */
+  inline int64_t GetVoxelKey(int x, int y, int z) const {
+    return ((static_cast<int64_t>(x) & 0x1FFFFF) << 42) |
+           ((static_cast<int64_t>(y) & 0x1FFFFF) << 21) |
+           (static_cast<int64_t>(z) & 0x1FFFFF);
+  }
+  inline int64_t GetVoxelKey(const Eigen::Vector3d &local_point) const {
+    return GetVoxelKey(
+        static_cast<int>(std::floor(local_point(0) * inverse_leaf_size_[0])),
+        static_cast<int>(std::floor(local_point(1) * inverse_leaf_size_[1])),
+        static_cast<int>(std::floor(local_point(2) * inverse_leaf_size_[2])));
+  }
+
   /**@brief Minimum points contained with in a voxel to allow it to be usable.
    */
   int min_points_per_voxel_;
@@ -274,8 +329,15 @@ class VoxelGridCovariance {
   /**@brief Indices of leaf structurs associated with each point. */
   std::vector<int> voxel_centroids_leaf_indices_;
 
-  /**@brief KdTree generated using voxel_centroids_ (used for searching). */
-  pcl::KdTreeFLANN<PointT> kdtree_;
+  /**@brief Leaves added by blocks, keyed by the block id. */
+  std::unordered_map<int64_t, std::vector<Leaf>> blocks_;
+
+  /**@brief Usable leaves keyed by the voxel containing their means (used for
+   * searching). */
+  std::unordered_map<int64_t, std::vector<LeafConstPtr>> voxel_index_;
+
+  /**@brief Whether voxel_centroids_ is out of date with the blocks. */
+  bool is_centroids_dirty_;
 
   /**@brief Left top corner. */
   Eigen::Vector3d map_left_top_corner_;
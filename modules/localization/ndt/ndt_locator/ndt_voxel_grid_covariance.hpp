@@ -50,6 +50,7 @@
  *
  */
 
+#include <algorithm>
 #include <map>
 #include <vector>
 
@@ -139,24 +140,126 @@ void VoxelGridCovariance<PointT>::SetMap(const std::vector<Leaf>& map_leaves,
   output->width = static_cast<uint32_t>(output->points.size());
 }
 
+template <typename PointT>
+void VoxelGridCovariance<PointT>::AddBlock(int64_t block_id,
+                                          std::vector<Leaf>* leaves) {
+  if (!leaves_.empty()) {
+    Clear();
+  }
+  RemoveBlock(block_id);
+
+  std::vector<Leaf>& block = blocks_[block_id];
+  block.swap(*leaves);
+  for (const Leaf& leaf : block) {
+    if (leaf.nr_points_ >= min_points_per_voxel_) {
+      voxel_index_[GetVoxelKey(leaf.mean_ - map_left_top_corner_)].push_back(
+          &leaf);
+    }
+  }
+  is_centroids_dirty_ = true;
+}
+
+template <typename PointT>
+void VoxelGridCovariance<PointT>::RemoveBlock(int64_t block_id) {
+  auto block = blocks_.find(block_id);
+  if (block == blocks_.end()) {
+    return;
+  }
+  for (const Leaf& leaf : block->second) {
+    if (leaf.nr_points_ < min_points_per_voxel_) {
+      continue;
+    }
+    auto voxel =
+        voxel_index_.find(GetVoxelKey(leaf.mean_ - map_left_top_corner_));
+    if (voxel == voxel_index_.end()) {
+      continue;
+    }
+    std::vector<LeafConstPtr>& voxel_leaves = voxel->second;
+    voxel_leaves.erase(
+        std::remove(voxel_leaves.begin(), voxel_leaves.end(), &leaf),
+        voxel_leaves.end());
+    if (voxel_leaves.empty()) {
+      voxel_index_.erase(voxel);
+    }
+  }
+  blocks_.erase(block);
+  is_centroids_dirty_ = true;
+}
+
+template <typename PointT>
+void VoxelGridCovariance<PointT>::Clear() {
+  leaves_.clear();
+  voxel_centroids_leaf_indices_.clear();
+  blocks_.clear();
+  voxel_index_.clear();
+  voxel_centroids_ = PointCloudPtr(new PointCloud);
+  is_centroids_dirty_ = false;
+}
+
+template <typename PointT>
+typename VoxelGridCovariance<PointT>::PointCloudPtr
+VoxelGridCovariance<PointT>::GetCentroids() {
+  if (is_centroids_dirty_) {
+    // A new cloud, the previous one may still be held as a search target.
+    voxel_centroids_ = PointCloudPtr(new PointCloud);
+    for (const auto& block : blocks_) {
+      for (const Leaf& leaf : block.second) {
+        if (leaf.nr_points_ >= min_points_per_voxel_) {
+          voxel_centroids_->push_back(PointT());
+          voxel_centroids_->points.back().x = static_cast<float>(leaf.mean_[0]);
+          voxel_centroids_->points.back().y = static_cast<float>(leaf.mean_[1]);
+          voxel_centroids_->points.back().z = static_cast<float>(leaf.mean_[2]);
+        }
+      }
+    }
+    is_centroids_dirty_ = false;
+  }
+  return voxel_centroids_;
+}
+
 template <typename PointT>
 int VoxelGridCovariance<PointT>::RadiusSearch(
     const PointT& point, double radius, std::vector<LeafConstPtr>* k_leaves,
-    std::vector<float>* k_sqr_distances, unsigned int max_nn) {
+    std::vector<float>* k_sqr_distances, unsigned int max_nn) const {
   k_leaves->clear();
+  k_sqr_distances->clear();
 
-  // Find neighbors within radius in the occupied voxel centroid cloud
-  std::vector<int> k_indices;
-  int k =
-      kdtree_.radiusSearch(point, radius, k_indices, *k_sqr_distances, max_nn);
+  // Check the voxels which may contain a mean within the radius, 3 by 3 by 3
+  // of them when the radius is the leaf size.
+  const Eigen::Vector3d query(point.x, point.y, point.z);
+  const Eigen::Vector3d local_query = query - map_left_top_corner_;
+  int min_ijk[3];
+  int max_ijk[3];
+  for (int i = 0; i < 3; ++i) {
+    min_ijk[i] = static_cast<int>(
+        std::floor((local_query(i) - radius) * inverse_leaf_size_[i]));
+    max_ijk[i] = static_cast<int>(
+        std::floor((local_query(i) + radius) * inverse_leaf_size_[i]));
+  }
 
-  // Find leaves corresponding to neighbors
-  k_leaves->reserve(k);
-  for (std::vector<int>::iterator iter = k_indices.begin();
-       iter != k_indices.end(); iter++) {
-    k_leaves->push_back(&leaves_[voxel_centroids_leaf_indices_[*iter]]);
+  const double sqr_radius = radius * radius;
+  for (int k = min_ijk[2]; k <= max_ijk[2]; ++k) {
+    for (int j = min_ijk[1]; j <= max_ijk[1]; ++j) {
+      for (int i = min_ijk[0]; i <= max_ijk[0]; ++i) {
+        auto voxel = voxel_index_.find(GetVoxelKey(i, j, k));
+        if (voxel == voxel_index_.end()) {
+          continue;
+        }
+        for (const LeafConstPtr leaf : voxel->second) {
+          const double sqr_distance = (leaf->mean_ - query).squaredNorm();
+          if (sqr_distance > sqr_radius) {
+            continue;
+          }
+          k_leaves->push_back(leaf);
+          k_sqr_distances->push_back(static_cast<float>(sqr_distance));
+          if (max_nn > 0 && k_leaves->size() >= max_nn) {
+            return static_cast<int>(k_leaves->size());
+          }
+        }
+      }
+    }
   }
-  return k;
+  return static_cast<int>(k_leaves->size());
 }
 
 template <typename PointT>
@@ -176,10 +279,19 @@ void VoxelGridCovariance<PointT>::GetDisplayCloud(
   Eigen::Vector3d rand_point;
   Eigen::Vector3d dist_point;
 
+  std::vector<LeafConstPtr> leaves;
+  for (const auto& leaf : leaves_) {
+    leaves.push_back(&leaf.second);
+  }
+  for (const auto& block : blocks_) {
+    for (const Leaf& leaf : block.second) {
+      leaves.push_back(&leaf);
+    }
+  }
+
   // Generate points for each occupied voxel with sufficient points.
-  for (typename std::map<size_t, Leaf>::iterator it = leaves_.begin();
-       it != leaves_.end(); ++it) {
-    Leaf& leaf = it->second;
+  for (const LeafConstPtr leaf_ptr : leaves) {
+    const Leaf& leaf = *leaf_ptr;
 
     if (leaf.nr_points_ >= min_points_per_voxel_) {
       cell_mean = leaf.mean_;
@@ -0,0 +1,106 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/localization/ndt/ndt_locator/ndt_voxel_grid_covariance.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "pcl/point_types.h"
+
+namespace apollo {
+namespace localization {
+namespace ndt {
+
+namespace {
+
+Leaf CreateLeaf(double x, double y, double z) {
+  Leaf leaf;
+  leaf.nr_points_ = 10;
+  leaf.mean_ = Eigen::Vector3d(x, y, z);
+  leaf.icov_ = Eigen::Matrix3d::Identity();
+  return leaf;
+}
+
+}  // namespace
+
+TEST(VoxelGridCovarianceTest, AddAndRemoveBlocks) {
+  VoxelGridCovariance<pcl::PointXYZ> grid;
+  grid.SetVoxelGridResolution(1.0f, 1.0f, 1.0f);
+
+  std::vector<Leaf> block;
+  block.push_back(CreateLeaf(0.5, 0.5, 0.5));
+  block.push_back(CreateLeaf(1.2, 0.5, 0.5));
+  block.push_back(CreateLeaf(5.5, 0.5, 0.5));
+  grid.AddBlock(1, &block);
+  block.push_back(CreateLeaf(0.5, 1.4, 0.5));
+  Leaf sparse_leaf = CreateLeaf(0.4, 0.4, 0.4);
+  sparse_leaf.nr_points_ = 2;
+  block.push_back(sparse_leaf);
+  grid.AddBlock(2, &block);
+  EXPECT_TRUE(block.empty());
+  EXPECT_TRUE(grid.HasBlock(1));
+  EXPECT_TRUE(grid.HasBlock(2));
+  EXPECT_EQ(grid.GetBlockIds().size(), 2);
+  EXPECT_EQ(grid.GetCentroids()->size(), 4);
+
+  std::vector<LeafConstPtr> leaves;
+  std::vector<float> distances;
+  const pcl::PointXYZ point(0.5f, 0.5f, 0.5f);
+  EXPECT_EQ(grid.RadiusSearch(point, 1.0, &leaves, &distances), 3);
+  EXPECT_EQ(distances.size(), 3);
+  for (size_t i = 0; i < leaves.size(); ++i) {
+    EXPECT_LE(distances[i], 1.0f);
+    EXPECT_NEAR((leaves[i]->GetMean() - Eigen::Vector3d(0.5, 0.5, 0.5))
+                    .squaredNorm(),
+                distances[i], 1e-6);
+  }
+  EXPECT_EQ(grid.RadiusSearch(point, 1.0, &leaves, &distances, 1), 1);
+
+  grid.RemoveBlock(1);
+  EXPECT_FALSE(grid.HasBlock(1));
+  EXPECT_EQ(grid.RadiusSearch(point, 1.0, &leaves, &distances), 1);
+  EXPECT_DOUBLE_EQ(leaves[0]->GetMean()(1), 1.4);
+  EXPECT_EQ(grid.GetCentroids()->size(), 1);
+
+  grid.Clear();
+  EXPECT_TRUE(grid.GetBlockIds().empty());
+  EXPECT_EQ(grid.RadiusSearch(point, 1.0, &leaves, &distances), 0);
+}
+
+TEST(VoxelGridCovarianceTest, NegativeCoordinates) {
+  VoxelGridCovariance<pcl::PointXYZ> grid;
+  grid.SetVoxelGridResolution(1.0f, 1.0f, 1.0f);
+  grid.SetMapLeftTopCorner(Eigen::Vector3d(100.0, 200.0, 0.0));
+
+  std::vector<Leaf> block;
+  block.push_back(CreateLeaf(99.8, 199.9, -0.2));
+  block.push_back(CreateLeaf(100.2, 200.1, 0.2));
+  grid.AddBlock(0, &block);
+
+  std::vector<LeafConstPtr> leaves;
+  std::vector<float> distances;
+  EXPECT_EQ(grid.RadiusSearch(pcl::PointXYZ(100.0f, 200.0f, 0.0f), 0.5,
+                              &leaves, &distances),
+            2);
+  EXPECT_EQ(grid.RadiusSearch(pcl::PointXYZ(99.0f, 199.0f, -1.0f), 0.5,
+                              &leaves, &distances),
+            0);
+}
+
+}  // namespace ndt
+}  // namespace localization
+}  // namespace apollo
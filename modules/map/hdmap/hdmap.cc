@@ -67,6 +67,12 @@ OverlapInfoConstPtr HDMap::GetOverlapById(const Id& id) const {
   return impl_.GetOverlapById(id);
 }
 
+LaneInfoConstPtr HDMap::GetLaneByIndex(const int index) const {
+  return impl_.GetLaneByIndex(index);
+}
+
+int HDMap::NumLanes() const { return impl_.NumLanes(); }
+
 RoadInfoConstPtr HDMap::GetRoadById(const Id& id) const {
   return impl_.GetRoadById(id);
 }
@@ -145,6 +151,13 @@ int HDMap::GetNearestLane(const common::PointENU& point,
   return impl_.GetNearestLane(point, nearest_lane, nearest_s, nearest_l);
 }
 
+int HDMap::GetNearestLanes(const std::vector<apollo::common::PointENU>& points,
+                           std::vector<LaneInfoConstPtr>* nearest_lanes,
+                           std::vector<double>* nearest_s,
+                           std::vector<double>* nearest_l) const {
+  return impl_.GetNearestLanes(points, nearest_lanes, nearest_s, nearest_l);
+}
+
 int HDMap::GetNearestLaneWithHeading(const apollo::common::PointENU& point,
                                      const double distance,
                                      const double central_heading,
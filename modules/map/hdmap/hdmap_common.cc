@@ -177,8 +177,6 @@ void LaneInfo::Init() {
   for (const auto &sample : lane_.right_road_sample()) {
     sampled_right_road_width_.emplace_back(sample.s(), sample.width());
   }
-
-  CreateKDTree();
 }
 
 void LaneInfo::GetWidth(const double s, double *left_width,
@@ -356,7 +354,7 @@ PointENU LaneInfo::GetSmoothPoint(double s) const {
 }
 
 double LaneInfo::DistanceTo(const Vec2d &point) const {
-  const auto segment_box = lane_segment_kdtree_->GetNearestObject(point);
+  const auto segment_box = lane_segment_kdtree().GetNearestObject(point);
   RETURN_VAL_IF_NULL(segment_box, 0.0);
   return segment_box->DistanceTo(point);
 }
@@ -367,7 +365,7 @@ double LaneInfo::DistanceTo(const Vec2d &point, Vec2d *map_point,
   RETURN_VAL_IF_NULL(s_offset, 0.0);
   RETURN_VAL_IF_NULL(s_offset_index, 0.0);
 
-  const auto segment_box = lane_segment_kdtree_->GetNearestObject(point);
+  const auto segment_box = lane_segment_kdtree().GetNearestObject(point);
   RETURN_VAL_IF_NULL(segment_box, 0.0);
   int index = segment_box->id();
   double distance = segments_[index].DistanceTo(point, map_point);
@@ -381,7 +379,7 @@ PointENU LaneInfo::GetNearestPoint(const Vec2d &point, double *distance) const {
   PointENU empty_point;
   RETURN_VAL_IF_NULL(distance, empty_point);
 
-  const auto segment_box = lane_segment_kdtree_->GetNearestObject(point);
+  const auto segment_box = lane_segment_kdtree().GetNearestObject(point);
   RETURN_VAL_IF_NULL(segment_box, empty_point);
   int index = segment_box->id();
   Vec2d nearest_point;
@@ -436,6 +434,22 @@ bool LaneInfo::GetProjection(const Vec2d &point, double *accumulate_s,
 
 void LaneInfo::PostProcess(const HDMapImpl &map_instance) {
   UpdateOverlaps(map_instance);
+  UpdateTopology(map_instance);
+}
+
+void LaneInfo::UpdateTopology(const HDMapImpl &map_instance) {
+  for (const auto &successor_id : lane_.successor_id()) {
+    const auto successor = map_instance.GetLaneById(successor_id);
+    if (successor != nullptr) {
+      successor_indices_.push_back(successor->index());
+    }
+  }
+  for (const auto &predecessor_id : lane_.predecessor_id()) {
+    const auto predecessor = map_instance.GetLaneById(predecessor_id);
+    if (predecessor != nullptr) {
+      predecessor_indices_.push_back(predecessor->index());
+    }
+  }
 }
 
 void LaneInfo::UpdateOverlaps(const HDMapImpl &map_instance) {
@@ -486,7 +500,12 @@ void LaneInfo::UpdateOverlaps(const HDMapImpl &map_instance) {
   }
 }
 
-void LaneInfo::CreateKDTree() {
+const LaneSegmentKDTree &LaneInfo::lane_segment_kdtree() const {
+  std::call_once(lane_segment_kdtree_flag_, [this]() { CreateKDTree(); });
+  return *lane_segment_kdtree_;
+}
+
+void LaneInfo::CreateKDTree() const {
   apollo::common::math::AABoxKDTreeParams params;
   params.max_leaf_dimension = 5.0;  // meters.
   params.max_leaf_size = 16;
@@ -16,6 +16,7 @@ limitations under the License.
 #pragma once
 
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -146,6 +147,21 @@ class LaneInfo {
   const Id &road_id() const { return road_id_; }
   const Id &section_id() const { return section_id_; }
   const Lane &lane() const { return lane_; }
+  /**
+   * @brief dense index of the lane in the map, assigned at load time, so that
+   * callers can keep per lane data in a vector instead of a string map.
+   */
+  int index() const { return index_; }
+  /**
+   * @brief indices of the successor and predecessor lanes which exist in the
+   * map, resolved once at load time.
+   */
+  const std::vector<int> &successor_indices() const {
+    return successor_indices_;
+  }
+  const std::vector<int> &predecessor_indices() const {
+    return predecessor_indices_;
+  }
   const std::vector<apollo::common::math::Vec2d> &points() const {
     return points_;
   }
@@ -229,14 +245,20 @@ class LaneInfo {
   void Init();
   void PostProcess(const HDMapImpl &map_instance);
   void UpdateOverlaps(const HDMapImpl &map_instance);
+  void UpdateTopology(const HDMapImpl &map_instance);
   double GetWidthFromSample(const std::vector<LaneInfo::SampledWidth> &samples,
                             const double s) const;
-  void CreateKDTree();
+  void CreateKDTree() const;
+  const LaneSegmentKDTree &lane_segment_kdtree() const;
   void set_road_id(const Id &road_id) { road_id_ = road_id; }
   void set_section_id(const Id &section_id) { section_id_ = section_id; }
+  void set_index(const int index) { index_ = index; }
 
  private:
   const Lane &lane_;
+  int index_ = -1;
+  std::vector<int> successor_indices_;
+  std::vector<int> predecessor_indices_;
   std::vector<apollo::common::math::Vec2d> points_;
   std::vector<apollo::common::math::Vec2d> unit_directions_;
   std::vector<double> headings_;
@@ -261,8 +283,11 @@ class LaneInfo {
   std::vector<SampledWidth> sampled_left_road_width_;
   std::vector<SampledWidth> sampled_right_road_width_;
 
-  std::vector<LaneSegmentBox> segment_box_list_;
-  std::unique_ptr<LaneSegmentKDTree> lane_segment_kdtree_;
+  // Built on first use, most lanes of a large map are never searched by
+  // point in a process.
+  mutable std::once_flag lane_segment_kdtree_flag_;
+  mutable std::vector<LaneSegmentBox> segment_box_list_;
+  mutable std::unique_ptr<LaneSegmentKDTree> lane_segment_kdtree_;
 
   Id road_id_;
   Id section_id_;
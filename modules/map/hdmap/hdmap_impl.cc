@@ -67,8 +67,12 @@ int HDMapImpl::LoadMapFromProto(const Map& map_proto) {
     Clear();
     map_ = map_proto;
   }
+  lane_index_table_.reserve(map_.lane_size());
   for (const auto& lane : map_.lane()) {
-    lane_table_[lane.id().id()].reset(new LaneInfo(lane));
+    auto& lane_ptr = lane_table_[lane.id().id()];
+    lane_ptr.reset(new LaneInfo(lane));
+    lane_ptr->set_index(static_cast<int>(lane_index_table_.size()));
+    lane_index_table_.push_back(lane_ptr);
   }
   for (const auto& junction : map_.junction()) {
     junction_table_[junction.id().id()].reset(new JunctionInfo(junction));
@@ -112,9 +116,6 @@ int HDMapImpl::LoadMapFromProto(const Map& map_proto) {
   for (const auto& road : map_.road()) {
     road_table_[road.id().id()].reset(new RoadInfo(road));
   }
-  for (const auto& rsu : map_.rsu()) {
-    rsu_table_[rsu.id().id()].reset(new RSUInfo(rsu));
-  }
   for (const auto& road_ptr_pair : road_table_) {
     const auto& road_id = road_ptr_pair.second->id();
     for (const auto& road_section : road_ptr_pair.second->sections()) {
@@ -197,6 +198,17 @@ OverlapInfoConstPtr HDMapImpl::GetOverlapById(const Id& id) const {
   return it != overlap_table_.end() ? it->second : nullptr;
 }
 
+LaneInfoConstPtr HDMapImpl::GetLaneByIndex(const int index) const {
+  if (index < 0 || index >= NumLanes()) {
+    return nullptr;
+  }
+  return lane_index_table_[index];
+}
+
+int HDMapImpl::NumLanes() const {
+  return static_cast<int>(lane_index_table_.size());
+}
+
 RoadInfoConstPtr HDMapImpl::GetRoadById(const Id& id) const {
   RoadTable::const_iterator it = road_table_.find(id.id());
   return it != road_table_.end() ? it->second : nullptr;
@@ -513,18 +525,50 @@ int HDMapImpl::GetNearestLane(const Vec2d& point,
   if (segment_object == nullptr) {
     return -1;
   }
-  const Id& lane_id = segment_object->object()->id();
+  GetNearestLaneOnSegment(point, *segment_object, nearest_lane, nearest_s,
+                          nearest_l);
+  return 0;
+}
+
+int HDMapImpl::GetNearestLanes(const std::vector<PointENU>& points,
+                               std::vector<LaneInfoConstPtr>* nearest_lanes,
+                               std::vector<double>* nearest_s,
+                               std::vector<double>* nearest_l) const {
+  CHECK_NOTNULL(nearest_lanes);
+  CHECK_NOTNULL(nearest_s);
+  CHECK_NOTNULL(nearest_l);
+  nearest_lanes->resize(points.size());
+  nearest_s->resize(points.size());
+  nearest_l->resize(points.size());
+  const LaneSegmentBox* segment_object = nullptr;
+  for (size_t i = 0; i < points.size(); ++i) {
+    const Vec2d point(points[i].x(), points[i].y());
+    segment_object =
+        lane_segment_kdtree_->GetNearestObject(point, segment_object);
+    if (segment_object == nullptr) {
+      return -1;
+    }
+    GetNearestLaneOnSegment(point, *segment_object, &(*nearest_lanes)[i],
+                            &(*nearest_s)[i], &(*nearest_l)[i]);
+  }
+  return 0;
+}
+
+void HDMapImpl::GetNearestLaneOnSegment(const Vec2d& point,
+                                        const LaneSegmentBox& segment_object,
+                                        LaneInfoConstPtr* nearest_lane,
+                                        double* nearest_s,
+                                        double* nearest_l) const {
+  const Id& lane_id = segment_object.object()->id();
   *nearest_lane = GetLaneById(lane_id);
   ACHECK(*nearest_lane);
-  const int id = segment_object->id();
+  const int id = segment_object.id();
   const auto& segment = (*nearest_lane)->segments()[id];
   Vec2d nearest_pt;
   segment.DistanceTo(point, &nearest_pt);
   *nearest_s = (*nearest_lane)->accumulate_s()[id] +
                nearest_pt.DistanceTo(segment.start());
   *nearest_l = segment.unit_direction().CrossProd(point - segment.start());
-
-  return 0;
 }
 
 int HDMapImpl::GetNearestLaneWithHeading(
@@ -1442,6 +1486,7 @@ int HDMapImpl::SearchObjects(const Vec2d& center, const double radius,
 void HDMapImpl::Clear() {
   map_.Clear();
   lane_table_.clear();
+  lane_index_table_.clear();
   junction_table_.clear();
   signal_table_.clear();
   crosswalk_table_.clear();
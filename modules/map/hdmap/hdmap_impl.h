@@ -109,6 +109,15 @@ class HDMapImpl {
   PNCJunctionInfoConstPtr GetPNCJunctionById(const Id& id) const;
   RSUInfoConstPtr GetRSUById(const Id& id) const;
 
+  /**
+   * @brief get a lane by its dense index, see LaneInfo::index(). Indices
+   * are assigned at load time and are only valid for this map.
+   * @param index the lane index, in [0, NumLanes())
+   * @return the lane, nullptr if the index is out of range
+   */
+  LaneInfoConstPtr GetLaneByIndex(const int index) const;
+  int NumLanes() const;
+
   /**
    * @brief get all lanes in certain range
    * @param point the central point of the range
@@ -224,6 +233,20 @@ class HDMapImpl {
   int GetNearestLane(const apollo::common::PointENU& point,
                      LaneInfoConstPtr* nearest_lane, double* nearest_s,
                      double* nearest_l) const;
+  /**
+   * @brief get the nearest lane of each point, same as GetNearestLane. Each
+   * query starts from the result of the previous point, so a batch of nearby
+   * points, e.g. along a trajectory, is much cheaper than separate queries.
+   * @param points the target points
+   * @param nearest_lanes the nearest lane of each point
+   * @param nearest_s the offset of each point along its lane center line
+   * @param nearest_l the lateral offset of each point from its lane center line
+   * @return 0:success, otherwise, failed.
+   */
+  int GetNearestLanes(const std::vector<apollo::common::PointENU>& points,
+                      std::vector<LaneInfoConstPtr>* nearest_lanes,
+                      std::vector<double>* nearest_s,
+                      std::vector<double>* nearest_l) const;
   /**
    * @brief get the nearest lane within a certain range by pose
    * @param point the target position
@@ -367,6 +390,10 @@ class HDMapImpl {
   int GetPNCJunctions(
       const apollo::common::math::Vec2d& point, double distance,
       std::vector<PNCJunctionInfoConstPtr>* pnc_junctions) const;
+  void GetNearestLaneOnSegment(const apollo::common::math::Vec2d& point,
+                               const LaneSegmentBox& segment_object,
+                               LaneInfoConstPtr* nearest_lane,
+                               double* nearest_s, double* nearest_l) const;
   int GetNearestLane(const apollo::common::math::Vec2d& point,
                      LaneInfoConstPtr* nearest_lane, double* nearest_s,
                      double* nearest_l) const;
@@ -414,6 +441,8 @@ class HDMapImpl {
  private:
   Map map_;
   LaneTable lane_table_;
+  // lanes by LaneInfo::index()
+  std::vector<std::shared_ptr<LaneInfo>> lane_index_table_;
   JunctionTable junction_table_;
   CrosswalkTable crosswalk_table_;
   SignalTable signal_table_;
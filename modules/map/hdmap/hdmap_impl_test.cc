@@ -52,6 +52,25 @@ TEST_F(HDMapImplTestSuite, GetLaneById) {
   EXPECT_STREQ(lane_id.id().c_str(), lane_ptr->id().id().c_str());
 }
 
+TEST_F(HDMapImplTestSuite, GetLaneByIndex) {
+  EXPECT_GT(hdmap_impl_.NumLanes(), 0);
+  EXPECT_EQ(nullptr, hdmap_impl_.GetLaneByIndex(-1));
+  EXPECT_EQ(nullptr, hdmap_impl_.GetLaneByIndex(hdmap_impl_.NumLanes()));
+  Id lane_id;
+  lane_id.set_id("1272_1_-1");
+  LaneInfoConstPtr lane_ptr = hdmap_impl_.GetLaneById(lane_id);
+  ASSERT_NE(nullptr, lane_ptr);
+  EXPECT_EQ(lane_ptr, hdmap_impl_.GetLaneByIndex(lane_ptr->index()));
+  ASSERT_EQ(lane_ptr->lane().successor_id_size(),
+            lane_ptr->successor_indices().size());
+  for (int i = 0; i < lane_ptr->lane().successor_id_size(); ++i) {
+    EXPECT_EQ(lane_ptr->lane().successor_id(i).id(),
+              hdmap_impl_.GetLaneByIndex(lane_ptr->successor_indices()[i])
+                  ->id()
+                  .id());
+  }
+}
+
 TEST_F(HDMapImplTestSuite, GetJunctionById) {
   Id junction_id;
   junction_id.set_id("1");
@@ -325,6 +344,35 @@ TEST_F(HDMapImplTestSuite, GetNearestLane) {
   EXPECT_NEAR(l, -3.257, 1e-3);
 }
 
+TEST_F(HDMapImplTestSuite, GetNearestLanes) {
+  std::vector<apollo::common::PointENU> points;
+  for (int i = 0; i < 20; ++i) {
+    apollo::common::PointENU point;
+    point.set_x(586424.09 + i * 1.5);
+    point.set_y(4140727.02 + i * 0.5);
+    point.set_z(0.0);
+    points.push_back(point);
+  }
+  std::vector<LaneInfoConstPtr> lanes;
+  std::vector<double> s;
+  std::vector<double> l;
+  EXPECT_EQ(0, hdmap_impl_.GetNearestLanes(points, &lanes, &s, &l));
+  ASSERT_EQ(points.size(), lanes.size());
+  ASSERT_EQ(points.size(), s.size());
+  ASSERT_EQ(points.size(), l.size());
+  for (size_t i = 0; i < points.size(); ++i) {
+    LaneInfoConstPtr lane;
+    double expected_s = 0.0;
+    double expected_l = 0.0;
+    EXPECT_EQ(0,
+              hdmap_impl_.GetNearestLane(points[i], &lane, &expected_s,
+                                         &expected_l));
+    EXPECT_EQ(lane->id().id(), lanes[i]->id().id());
+    EXPECT_NEAR(expected_s, s[i], 1e-6);
+    EXPECT_NEAR(expected_l, l[i], 1e-6);
+  }
+}
+
 TEST_F(HDMapImplTestSuite, GetRoadBoundaries) {
   apollo::common::PointENU point;
   point.set_x(586427.58);
@@ -15,6 +15,7 @@ limitations under the License.
 #include "modules/map/hdmap/hdmap_util.h"
 
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "absl/strings/str_split.h"
@@ -91,6 +92,7 @@ std::unique_ptr<HDMap> CreateMap(const MapMsg& map_msg) {
 
 std::unique_ptr<HDMap> HDMapUtil::base_map_ = nullptr;
 uint64_t HDMapUtil::base_map_seq_ = 0;
+std::string HDMapUtil::base_map_content_;
 std::mutex HDMapUtil::base_map_mutex_;
 
 std::unique_ptr<HDMap> HDMapUtil::sim_map_ = nullptr;
@@ -102,10 +104,15 @@ const HDMap* HDMapUtil::BaseMapPtr(const MapMsg& map_msg) {
       base_map_seq_ == map_msg.header().sequence_num()) {
     // avoid re-create map in the same cycle.
     return base_map_.get();
-  } else {
+  }
+  // Rebuilding the tables and KD-trees costs far more than comparing the
+  // serialized map, and a relative map is unchanged while the vehicle stops.
+  std::string content = map_msg.hdmap().SerializeAsString();
+  if (base_map_ == nullptr || content != base_map_content_) {
     base_map_ = CreateMap(map_msg);
-    base_map_seq_ = map_msg.header().sequence_num();
+    base_map_content_ = base_map_ == nullptr ? "" : std::move(content);
   }
+  base_map_seq_ = map_msg.header().sequence_num();
   return base_map_.get();
 }
 
@@ -161,6 +168,7 @@ bool HDMapUtil::ReloadMaps() {
   {
     std::lock_guard<std::mutex> lock(base_map_mutex_);
     base_map_ = CreateMap(BaseMapFile());
+    base_map_content_.clear();
   }
   {
     std::lock_guard<std::mutex> lock(sim_map_mutex_);
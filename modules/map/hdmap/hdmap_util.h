@@ -98,6 +98,8 @@ class HDMapUtil {
 
   static std::unique_ptr<HDMap> base_map_;
   static uint64_t base_map_seq_;
+  // serialized hdmap of the relative map which base_map_ is loaded from
+  static std::string base_map_content_;
   static std::mutex base_map_mutex_;
 
   static std::unique_ptr<HDMap> sim_map_;
@@ -17,8 +17,10 @@
 #include "modules/map/pnc_map/path.h"
 
 #include <algorithm>
+#include <iterator>
 #include <limits>
 #include <unordered_map>
+#include <utility>
 
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_join.h"
@@ -313,25 +315,13 @@ Path::Path(const std::vector<MapPathPoint>& path_points,
 
 Path::Path(const std::vector<LaneSegment>& segments)
     : lane_segments_(segments) {
-  for (const auto& segment : lane_segments_) {
-    const auto points = MapPathPoint::GetPointsFromLane(
-        segment.lane, segment.start_s, segment.end_s);
-    path_points_.insert(path_points_.end(), points.begin(), points.end());
-  }
-  MapPathPoint::RemoveDuplicates(&path_points_);
-  CHECK_GE(path_points_.size(), 2);
+  InitPathPointsFromLaneSegments();
   Init();
 }
 
 Path::Path(std::vector<LaneSegment>&& segments)
     : lane_segments_(std::move(segments)) {
-  for (const auto& segment : lane_segments_) {
-    const auto points = MapPathPoint::GetPointsFromLane(
-        segment.lane, segment.start_s, segment.end_s);
-    path_points_.insert(path_points_.end(), points.begin(), points.end());
-  }
-  MapPathPoint::RemoveDuplicates(&path_points_);
-  CHECK_GE(path_points_.size(), 2);
+  InitPathPointsFromLaneSegments();
   Init();
 }
 
@@ -347,6 +337,22 @@ Path::Path(std::vector<MapPathPoint>&& path_points,
   }
 }
 
+void Path::InitPathPointsFromLaneSegments() {
+  for (const auto& segment : lane_segments_) {
+    auto points = MapPathPoint::GetPointsFromLane(segment.lane, segment.start_s,
+                                                  segment.end_s);
+    if (path_points_.empty()) {
+      path_points_ = std::move(points);
+    } else {
+      path_points_.insert(path_points_.end(),
+                          std::make_move_iterator(points.begin()),
+                          std::make_move_iterator(points.end()));
+    }
+  }
+  MapPathPoint::RemoveDuplicates(&path_points_);
+  CHECK_GE(path_points_.size(), 2);
+}
+
 void Path::Init() {
   InitPoints();
   InitLaneSegments();
@@ -755,28 +761,8 @@ bool Path::GetProjectionWithHueristicParams(const Vec2d& point,
     }
   }
   *min_distance = std::sqrt(*min_distance);
-  const auto& nearest_seg = segments_[min_index];
-  const auto prod = nearest_seg.ProductOntoUnit(point);
-  const auto proj = nearest_seg.ProjectOntoUnit(point);
-  if (min_index == 0) {
-    *accumulate_s = std::min(proj, nearest_seg.length());
-    if (proj < 0) {
-      *lateral = prod;
-    } else {
-      *lateral = (prod > 0.0 ? 1 : -1) * *min_distance;
-    }
-  } else if (min_index == num_segments_ - 1) {
-    *accumulate_s = accumulated_s_[min_index] + std::max(0.0, proj);
-    if (proj > 0) {
-      *lateral = prod;
-    } else {
-      *lateral = (prod > 0.0 ? 1 : -1) * *min_distance;
-    }
-  } else {
-    *accumulate_s = accumulated_s_[min_index] +
-                    std::max(0.0, std::min(proj, nearest_seg.length()));
-    *lateral = (prod > 0.0 ? 1 : -1) * *min_distance;
-  }
+  GetProjectionOnSegment(point, min_index, *min_distance, accumulate_s,
+                         lateral);
   return true;
 }
 
@@ -794,39 +780,97 @@ bool Path::GetProjection(const Vec2d& point, double* accumulate_s,
                                         min_distance);
   }
   CHECK_GE(num_points_, 2);
-  *min_distance = std::numeric_limits<double>::infinity();
+  const int min_index = FindNearestSegment(point, min_distance);
+  GetProjectionOnSegment(point, min_index, *min_distance, accumulate_s,
+                         lateral);
+  return true;
+}
+
+int Path::FindNearestSegment(const Vec2d& point, double* min_distance) const {
+  double min_distance_sqr = std::numeric_limits<double>::infinity();
   int min_index = 0;
   for (int i = 0; i < num_segments_; ++i) {
-    const double distance = segments_[i].DistanceSquareTo(point);
-    if (distance < *min_distance) {
+    const double distance_sqr = segments_[i].DistanceSquareTo(point);
+    if (distance_sqr < min_distance_sqr) {
       min_index = i;
-      *min_distance = distance;
+      min_distance_sqr = distance_sqr;
     }
   }
-  *min_distance = std::sqrt(*min_distance);
-  const auto& nearest_seg = segments_[min_index];
+  *min_distance = std::sqrt(min_distance_sqr);
+  return min_index;
+}
+
+bool Path::GetProjectionWithHint(const Vec2d& point, int* segment_hint,
+                                 double* accumulate_s, double* lateral,
+                                 double* min_distance) const {
+  if (segments_.empty()) {
+    return false;
+  }
+  if (segment_hint == nullptr || accumulate_s == nullptr ||
+      lateral == nullptr || min_distance == nullptr) {
+    return false;
+  }
+  if (*segment_hint < 0 || *segment_hint >= num_segments_) {
+    *segment_hint = FindNearestSegment(point, min_distance);
+    GetProjectionOnSegment(point, *segment_hint, *min_distance, accumulate_s,
+                           lateral);
+    return true;
+  }
+
+  // Segments are short compared to the curvature of a lane, so the distance
+  // is unimodal around the hint. A few more segments are checked past the
+  // first local minimum to step over small jitters of the polyline.
+  static constexpr int kMaxNonDecreasingSteps = 3;
+  int min_index = *segment_hint;
+  double min_distance_sqr = segments_[min_index].DistanceSquareTo(point);
+  for (const int step : {1, -1}) {
+    int non_decreasing_steps = 0;
+    for (int i = *segment_hint + step;
+         i >= 0 && i < num_segments_ &&
+         non_decreasing_steps < kMaxNonDecreasingSteps;
+         i += step) {
+      const double distance_sqr = segments_[i].DistanceSquareTo(point);
+      if (distance_sqr < min_distance_sqr) {
+        min_index = i;
+        min_distance_sqr = distance_sqr;
+        non_decreasing_steps = 0;
+      } else {
+        ++non_decreasing_steps;
+      }
+    }
+  }
+  *segment_hint = min_index;
+  *min_distance = std::sqrt(min_distance_sqr);
+  GetProjectionOnSegment(point, min_index, *min_distance, accumulate_s,
+                         lateral);
+  return true;
+}
+
+void Path::GetProjectionOnSegment(const Vec2d& point, const int index,
+                                  const double distance, double* accumulate_s,
+                                  double* lateral) const {
+  const auto& nearest_seg = segments_[index];
   const auto prod = nearest_seg.ProductOntoUnit(point);
   const auto proj = nearest_seg.ProjectOntoUnit(point);
-  if (min_index == 0) {
+  if (index == 0) {
     *accumulate_s = std::min(proj, nearest_seg.length());
     if (proj < 0) {
       *lateral = prod;
     } else {
-      *lateral = (prod > 0.0 ? 1 : -1) * *min_distance;
+      *lateral = (prod > 0.0 ? 1 : -1) * distance;
     }
-  } else if (min_index == num_segments_ - 1) {
-    *accumulate_s = accumulated_s_[min_index] + std::max(0.0, proj);
+  } else if (index == num_segments_ - 1) {
+    *accumulate_s = accumulated_s_[index] + std::max(0.0, proj);
     if (proj > 0) {
       *lateral = prod;
     } else {
-      *lateral = (prod > 0.0 ? 1 : -1) * *min_distance;
+      *lateral = (prod > 0.0 ? 1 : -1) * distance;
     }
   } else {
-    *accumulate_s = accumulated_s_[min_index] +
+    *accumulate_s = accumulated_s_[index] +
                     std::max(0.0, std::min(proj, nearest_seg.length()));
-    *lateral = (prod > 0.0 ? 1 : -1) * *min_distance;
+    *lateral = (prod > 0.0 ? 1 : -1) * distance;
   }
-  return true;
 }
 
 bool Path::GetHeadingAlongPath(const Vec2d& point, double* heading) const {
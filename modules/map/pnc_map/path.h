@@ -260,6 +260,16 @@ class Path {
                      double* lateral) const;
   bool GetProjection(const common::math::Vec2d& point, double* accumulate_s,
                      double* lateral, double* distance) const;
+  /**
+   * @brief Projection of a point close to the one of a previous query. The
+   * search starts at *segment_hint and walks to the nearest segment along the
+   * path, instead of scanning all segments. An invalid hint falls back to
+   * GetProjection. *segment_hint is updated to the nearest segment, to be
+   * passed to the next query of the same object.
+   */
+  bool GetProjectionWithHint(const common::math::Vec2d& point,
+                             int* segment_hint, double* accumulate_s,
+                             double* lateral, double* distance) const;
 
   bool GetHeadingAlongPath(const common::math::Vec2d& point,
                            double* heading) const;
@@ -334,7 +344,13 @@ class Path {
  protected:
   void Init();
   void InitPoints();
+  void InitPathPointsFromLaneSegments();
   void InitLaneSegments();
+  int FindNearestSegment(const common::math::Vec2d& point,
+                         double* min_distance) const;
+  void GetProjectionOnSegment(const common::math::Vec2d& point,
+                              const int index, const double distance,
+                              double* accumulate_s, double* lateral) const;
   void InitWidth();
   void InitPointIndex();
   void InitOverlaps();
@@ -500,6 +500,47 @@ TEST(TestSuite, hdmap_circle_path) {
   }
 }
 
+TEST(TestSuite, hdmap_path_projection_with_hint) {
+  const double kRadius = 50.0;
+  const int kNumSegments = 100;
+  std::vector<MapPathPoint> points;
+  for (int i = 0; i <= kNumSegments; ++i) {
+    const double p =
+        M_PI_2 * static_cast<double>(i) / static_cast<double>(kNumSegments);
+    points.push_back(MakeMapPathPoint(kRadius * cos(p), kRadius * sin(p)));
+  }
+  const Path path(points, {});
+
+  double accumulate_s;
+  double lateral;
+  double distance;
+  int segment_hint = -1;
+  for (int i = 0; i <= 200; ++i) {
+    const double p = M_PI_2 * static_cast<double>(i) / 200.0;
+    const double radius = kRadius + 1.0 + 0.5 * sin(static_cast<double>(i));
+    const Vec2d point(radius * cos(p), radius * sin(p));
+    double expected_s;
+    double expected_lateral;
+    double expected_distance;
+    EXPECT_TRUE(path.GetProjection(point, &expected_s, &expected_lateral,
+                                   &expected_distance));
+    EXPECT_TRUE(path.GetProjectionWithHint(point, &segment_hint, &accumulate_s,
+                                           &lateral, &distance));
+    EXPECT_NEAR(accumulate_s, expected_s, 1e-6);
+    EXPECT_NEAR(lateral, expected_lateral, 1e-6);
+    EXPECT_NEAR(distance, expected_distance, 1e-6);
+    EXPECT_GE(segment_hint, 0);
+    EXPECT_LT(segment_hint, kNumSegments);
+  }
+
+  // A hint far from the point still walks to the nearest segment.
+  segment_hint = 0;
+  EXPECT_TRUE(path.GetProjectionWithHint({-1, kRadius - 1}, &segment_hint,
+                                         &accumulate_s, &lateral, &distance));
+  EXPECT_EQ(segment_hint, kNumSegments - 1);
+  EXPECT_NEAR(distance, sqrt(2.0), 1e-6);
+}
+
 TEST(TestSuite, hdmap_jerky_path) {
   const int kNumPaths = 100;
   const int kCasesPerPath = 1000;
@@ -0,0 +1,111 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "gflags/gflags.h"
+
+#include "absl/strings/str_cat.h"
+#include "cyber/common/file.h"
+#include "cyber/common/log.h"
+#include "modules/map/hdmap/hdmap_util.h"
+#include "modules/map/proto/map.pb.h"
+
+/**
+ * A map tool to cut the base map into square tiles, so that a vehicle on a
+ * large map can be started with only the tiles around its route.
+ */
+
+DEFINE_string(output_dir, "/tmp", "output tile directory");
+DEFINE_double(tile_size, 1000.0, "side length of a square tile in meters");
+DEFINE_double(tile_margin, 100.0,
+              "map elements within this distance of a tile are also kept in "
+              "the tile, so queries near a tile border are not cut off");
+
+using apollo::common::PointENU;
+using apollo::hdmap::HDMapUtil;
+using apollo::hdmap::Map;
+
+int main(int argc, char *argv[]) {
+  google::InitGoogleLogging(argv[0]);
+  FLAGS_alsologtostderr = true;
+
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  ACHECK(FLAGS_tile_size > 0.0) << "tile_size must be positive";
+
+  const auto &base_map = HDMapUtil::BaseMap();
+  const auto map_file = apollo::hdmap::BaseMapFile();
+  Map map_pb;
+  ACHECK(apollo::cyber::common::GetProtoFromFile(map_file, &map_pb))
+      << "Fail to open: " << map_file;
+
+  double min_x = std::numeric_limits<double>::max();
+  double min_y = std::numeric_limits<double>::max();
+  double max_x = std::numeric_limits<double>::lowest();
+  double max_y = std::numeric_limits<double>::lowest();
+  for (const auto &lane : map_pb.lane()) {
+    for (const auto &segment : lane.central_curve().segment()) {
+      for (const auto &point : segment.line_segment().point()) {
+        min_x = std::min(min_x, point.x());
+        min_y = std::min(min_y, point.y());
+        max_x = std::max(max_x, point.x());
+        max_y = std::max(max_y, point.y());
+      }
+    }
+  }
+  if (min_x > max_x) {
+    AERROR << "No lane is found in " << map_file;
+    return -1;
+  }
+
+  // GetLocalMap keeps the elements within a radius of the center, which has
+  // to cover the corners of the tile.
+  const double radius = FLAGS_tile_size * M_SQRT1_2 + FLAGS_tile_margin;
+  const int num_tiles_x =
+      static_cast<int>(std::floor((max_x - min_x) / FLAGS_tile_size)) + 1;
+  const int num_tiles_y =
+      static_cast<int>(std::floor((max_y - min_y) / FLAGS_tile_size)) + 1;
+  int num_saved_tiles = 0;
+  for (int i = 0; i < num_tiles_x; ++i) {
+    for (int j = 0; j < num_tiles_y; ++j) {
+      PointENU center;
+      center.set_x(min_x + (i + 0.5) * FLAGS_tile_size);
+      center.set_y(min_y + (j + 0.5) * FLAGS_tile_size);
+      Map tile;
+      if (base_map.GetLocalMap(center, {radius, radius}, &tile) != 0) {
+        AERROR << "Failed to get tile [" << i << ", " << j << "]";
+        continue;
+      }
+      if (tile.lane_size() == 0) {
+        continue;
+      }
+      *tile.mutable_header() = map_pb.header();
+      const std::string tile_file =
+          absl::StrCat(FLAGS_output_dir, "/tile_", i, "_", j, ".bin");
+      ACHECK(apollo::cyber::common::SetProtoToBinaryFile(tile, tile_file))
+          << "Failed to write " << tile_file;
+      AINFO << "Tile [" << i << ", " << j << "] with " << tile.lane_size()
+            << " lanes: " << tile_file;
+      ++num_saved_tiles;
+    }
+  }
+
+  AINFO << "Cut " << map_file << " into " << num_saved_tiles << " tiles of "
+        << FLAGS_tile_size << " m, origin (" << min_x << ", " << min_y << ")";
+  return 0;
+}
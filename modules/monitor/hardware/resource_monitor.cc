@@ -16,16 +16,24 @@
 
 #include "modules/monitor/hardware/resource_monitor.h"
 
+#include <fcntl.h>
+#include <unistd.h>
+
 #include <algorithm>
+#include <chrono>
+#include <memory>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include <boost/filesystem.hpp>
 
 #include "absl/strings/match.h"
+#include "absl/strings/numbers.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_split.h"
+#include "absl/strings/string_view.h"
 #include "cyber/common/file.h"
 #include "cyber/common/log.h"
 #include "gflags/gflags.h"
@@ -44,6 +52,87 @@ namespace monitor {
 
 namespace {
 
+// Reads a file of /proc again and again through the same descriptor and
+// buffer, as procfs regenerates the content on every read from offset 0.
+class ProcFileReader {
+ public:
+  explicit ProcFileReader(const std::string& path) : path_(path) {}
+  ~ProcFileReader() { Close(); }
+
+  bool Open() {
+    Close();
+    fd_ = open(path_.c_str(), O_RDONLY | O_CLOEXEC);
+    return fd_ >= 0;
+  }
+
+  // Returns false if the file can not be read, e.g. its process has exited.
+  bool Read(absl::string_view* content) {
+    if (fd_ < 0 && !Open()) {
+      return false;
+    }
+    size_t size = 0;
+    while (true) {
+      if (buffer_.size() - size < kMinReadSize) {
+        buffer_.resize(std::max<size_t>(2 * buffer_.size(), kMinReadSize));
+      }
+      const ssize_t bytes = pread(fd_, &buffer_[size], buffer_.size() - size,
+                                  static_cast<off_t>(size));
+      if (bytes < 0) {
+        return false;
+      }
+      if (bytes == 0) {
+        break;
+      }
+      size += bytes;
+    }
+    *content = absl::string_view(buffer_.data(), size);
+    return size > 0;
+  }
+
+  void Close() {
+    if (fd_ >= 0) {
+      close(fd_);
+      fd_ = -1;
+    }
+  }
+
+ private:
+  static constexpr size_t kMinReadSize = 4096;
+
+  const std::string path_;
+  int fd_ = -1;
+  std::string buffer_;
+};
+
+// Get the line of the given index, or an empty one if there are fewer lines.
+absl::string_view GetStatsLine(absl::string_view content, int line_num) {
+  for (absl::string_view line : absl::StrSplit(content, '\n')) {
+    if (line_num-- == 0) {
+      return line;
+    }
+  }
+  return absl::string_view();
+}
+
+// Get the stats of a line separated by whitespace.
+std::vector<absl::string_view> SplitStats(absl::string_view line) {
+  return absl::StrSplit(line, ' ', absl::SkipWhitespace());
+}
+
+uint64_t ParseStat(absl::string_view stat) {
+  uint64_t value = 0;
+  if (!absl::SimpleAtoi(stat, &value)) {
+    return 0;
+  }
+  return value;
+}
+
+double NowInSeconds() {
+  return std::chrono::duration<double>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
 bool GetPIDByCmdLine(const std::string& process_dag_path, int* pid) {
   const std::string system_proc_path = "/proc";
   const std::string proc_cmdline_path = "/cmdline";
@@ -64,90 +153,115 @@ bool GetPIDByCmdLine(const std::string& process_dag_path, int* pid) {
   return false;
 }
 
-std::vector<std::string> GetStatsLines(const std::string& stat_file,
-                                       const int line_count) {
-  std::vector<std::string> stats_lines;
-  std::ifstream buffer(stat_file);
-  for (int line_num = 0; line_num < line_count; ++line_num) {
-    std::string line;
-    std::getline(buffer, line);
-    if (line.empty()) {
-      break;
-    }
-    stats_lines.push_back(line);
+// The stat files of a monitored process, kept open between the samples.
+// Unlike its PID, the descriptors are bound to the process, they fail to
+// read once it has exited.
+struct ProcessSampler {
+  explicit ProcessSampler(int pid)
+      : stat_reader(absl::StrCat("/proc/", pid, "/stat")),
+        statm_reader(absl::StrCat("/proc/", pid, "/statm")) {}
+
+  ProcFileReader stat_reader;
+  ProcFileReader statm_reader;
+  uint64_t prev_jiffies = 0;
+  double prev_time = 0.0;
+};
+
+// Get the sampler of a process, the /proc directory is only scanned for it
+// when it is not running yet or any more.
+ProcessSampler* GetProcessSampler(const std::string& process_dag_path) {
+  static std::unordered_map<std::string, std::unique_ptr<ProcessSampler>>
+      samplers;
+  auto& sampler = samplers[process_dag_path];
+  absl::string_view content;
+  if (sampler != nullptr && sampler->stat_reader.Read(&content)) {
+    return sampler.get();
+  }
+  sampler.reset();
+  int pid = 0;
+  if (!GetPIDByCmdLine(process_dag_path, &pid)) {
+    return nullptr;
   }
-  return stats_lines;
+  sampler.reset(new ProcessSampler(pid));
+  return sampler.get();
 }
 
-float GetMemoryUsage(const int pid, const std::string& process_name) {
-  const std::string memory_stat_file = absl::StrCat("/proc/", pid, "/statm");
+float GetMemoryUsage(ProcessSampler* sampler,
+                     const std::string& process_name) {
   const uint32_t page_size_kb = (sysconf(_SC_PAGE_SIZE) >> 10);
   const int resident_idx = 1, gb_2_kb = (1 << 20);
-  constexpr static int kMemoryInfo = 0;
 
-  const auto stat_lines = GetStatsLines(memory_stat_file, kMemoryInfo + 1);
-  if (stat_lines.size() <= kMemoryInfo) {
-    AERROR << "failed to load contents from " << memory_stat_file;
+  absl::string_view content;
+  if (!sampler->statm_reader.Read(&content)) {
+    AERROR << "failed to load memory stats of " << process_name;
     return 0.f;
   }
-  const std::vector<std::string> stats =
-      absl::StrSplit(stat_lines[kMemoryInfo], ' ', absl::SkipWhitespace());
+  const auto stats = SplitStats(GetStatsLine(content, 0));
   if (stats.size() <= resident_idx) {
     AERROR << "failed to get memory info for process " << process_name;
     return 0.f;
   }
-  return static_cast<float>(std::stoll(stats[resident_idx]) * page_size_kb) /
+  return static_cast<float>(ParseStat(stats[resident_idx]) * page_size_kb) /
          gb_2_kb;
 }
 
-float GetCPUUsage(const int pid, const std::string& process_name,
-                  std::unordered_map<std::string, uint64_t>* prev_jiffies_map) {
-  const std::string cpu_stat_file = absl::StrCat("/proc/", pid, "/stat");
+float GetCPUUsage(ProcessSampler* sampler, const std::string& process_name) {
   const int hertz = sysconf(_SC_CLK_TCK);
-  const int utime = 13, stime = 14, cutime = 15, cstime = 16;
-  constexpr static int kCpuInfo = 0;
+  // The indices of the stats after the command name, which may contain
+  // whitespace itself.
+  const int utime = 11, stime = 12, cutime = 13, cstime = 14;
 
-  const auto stat_lines = GetStatsLines(cpu_stat_file, kCpuInfo + 1);
-  if (stat_lines.size() <= kCpuInfo) {
-    AERROR << "failed to load contents from " << cpu_stat_file;
+  absl::string_view content;
+  if (!sampler->stat_reader.Read(&content)) {
+    AERROR << "failed to load CPU stats of " << process_name;
     return 0.f;
   }
-  const std::vector<std::string> stats =
-      absl::StrSplit(stat_lines[kCpuInfo], ' ', absl::SkipWhitespace());
+  const size_t comm_end = content.rfind(')');
+  if (comm_end == absl::string_view::npos) {
+    AERROR << "failed to get CPU info for process " << process_name;
+    return 0.f;
+  }
+  const auto stats = SplitStats(content.substr(comm_end + 1));
   if (stats.size() <= cstime) {
     AERROR << "failed to get CPU info for process " << process_name;
     return 0.f;
   }
-  const uint64_t jiffies = std::stoll(stats[utime]) + std::stoll(stats[stime]) +
-                           std::stoll(stats[cutime]) +
-                           std::stoll(stats[cstime]);
-  const uint64_t prev_jiffies = (*prev_jiffies_map)[process_name];
-  (*prev_jiffies_map)[process_name] = jiffies;
-  if (prev_jiffies == 0) {
+  const uint64_t jiffies = ParseStat(stats[utime]) + ParseStat(stats[stime]) +
+                           ParseStat(stats[cutime]) + ParseStat(stats[cstime]);
+  const double now = NowInSeconds();
+  const uint64_t prev_jiffies = sampler->prev_jiffies;
+  const double prev_time = sampler->prev_time;
+  sampler->prev_jiffies = jiffies;
+  sampler->prev_time = now;
+  if (prev_time == 0.0 || now <= prev_time) {
     return 0.f;
   }
-  return 100.f * (static_cast<float>(jiffies - prev_jiffies) / hertz /
-                  static_cast<float>(FLAGS_resource_monitor_interval));
+  return 100.f * static_cast<float>(static_cast<double>(jiffies -
+                                                        prev_jiffies) /
+                                    hertz / (now - prev_time));
 }
 
-uint64_t GetSystemMemoryValueFromLine(std::string stat_line) {
+uint64_t GetSystemMemoryValueFromLine(absl::string_view stat_line) {
   constexpr static int kMemoryValueIdx = 1;
-  const std::vector<std::string> stats =
-      absl::StrSplit(stat_line, ' ', absl::SkipWhitespace());
+  const auto stats = SplitStats(stat_line);
   if (stats.size() <= kMemoryValueIdx) {
     AERROR << "failed to parse memory from line " << stat_line;
     return 0;
   }
-  return std::stoll(stats[kMemoryValueIdx]);
+  return ParseStat(stats[kMemoryValueIdx]);
 }
 
 float GetSystemMemoryUsage() {
-  const std::string system_mem_stat_file = "/proc/meminfo";
+  static ProcFileReader reader("/proc/meminfo");
   const int mem_total = 0, mem_free = 1, buffers = 3, cached = 4,
             swap_total = 14, swap_free = 15, slab = 21;
-  const auto stat_lines = GetStatsLines(system_mem_stat_file, slab + 1);
+  absl::string_view content;
+  std::vector<absl::string_view> stat_lines;
+  if (reader.Read(&content)) {
+    stat_lines = absl::StrSplit(content, '\n');
+  }
   if (stat_lines.size() <= slab) {
-    AERROR << "failed to load contents from " << system_mem_stat_file;
+    AERROR << "failed to load contents from /proc/meminfo";
     return 0.f;
   }
   const auto total_memory =
@@ -164,25 +278,23 @@ float GetSystemMemoryUsage() {
 }
 
 float GetSystemCPUUsage() {
-  const std::string system_cpu_stat_file = "/proc/stat";
+  static ProcFileReader reader("/proc/stat");
   const int users = 1, system = 3, total = 7;
   constexpr static int kSystemCpuInfo = 0;
   static uint64_t prev_jiffies = 0, prev_work_jiffies = 0;
-  const auto stat_lines =
-      GetStatsLines(system_cpu_stat_file, kSystemCpuInfo + 1);
-  if (stat_lines.size() <= kSystemCpuInfo) {
-    AERROR << "failed to load contents from " << system_cpu_stat_file;
+  absl::string_view content;
+  if (!reader.Read(&content)) {
+    AERROR << "failed to load contents from /proc/stat";
     return 0.f;
   }
-  const std::vector<std::string> jiffies_stats =
-      absl::StrSplit(stat_lines[kSystemCpuInfo], ' ', absl::SkipWhitespace());
+  const auto jiffies_stats = SplitStats(GetStatsLine(content, kSystemCpuInfo));
   if (jiffies_stats.size() <= total) {
-    AERROR << "failed to get system CPU info from " << system_cpu_stat_file;
+    AERROR << "failed to get system CPU info from /proc/stat";
     return 0.f;
   }
   uint64_t jiffies = 0, work_jiffies = 0;
   for (int cur_stat = users; cur_stat <= total; ++cur_stat) {
-    const auto cur_stat_value = std::stoll(jiffies_stats[cur_stat]);
+    const auto cur_stat_value = ParseStat(jiffies_stats[cur_stat]);
     jiffies += cur_stat_value;
     if (cur_stat <= system) {
       work_jiffies += cur_stat_value;
@@ -192,7 +304,7 @@ float GetSystemCPUUsage() {
   const uint64_t tmp_prev_work_jiffies = prev_work_jiffies;
   prev_jiffies = jiffies;
   prev_work_jiffies = work_jiffies;
-  if (tmp_prev_jiffies == 0) {
+  if (tmp_prev_jiffies == 0 || jiffies == tmp_prev_jiffies) {
     return 0.f;
   }
   return 100.f * (static_cast<float>(work_jiffies - tmp_prev_work_jiffies) /
@@ -200,30 +312,36 @@ float GetSystemCPUUsage() {
 }
 
 float GetSystemDiskload(const std::string& device_name) {
-  const std::string disks_stat_file = "/proc/diskstats";
+  static ProcFileReader reader("/proc/diskstats");
   const int device = 2, in_out_ms = 12;
-  const int seconds_to_ms = 1000;
-  constexpr static int kDiskInfo = 128;
-  static uint64_t prev_disk_stats = 0;
+  static std::unordered_map<std::string, std::pair<uint64_t, double>>
+      prev_disk_stats;
 
-  const auto stat_lines = GetStatsLines(disks_stat_file, kDiskInfo);
+  absl::string_view content;
+  if (!reader.Read(&content)) {
+    AERROR << "failed to load contents from /proc/diskstats";
+    return 0.f;
+  }
   uint64_t disk_stats = 0;
-  for (const auto& line : stat_lines) {
-    const std::vector<std::string> stats =
-        absl::StrSplit(line, ' ', absl::SkipWhitespace());
-    if (stats[device] == device_name) {
-      disk_stats = std::stoll(stats[in_out_ms]);
+  for (absl::string_view line : absl::StrSplit(content, '\n')) {
+    const auto stats = SplitStats(line);
+    if (stats.size() > in_out_ms && stats[device] == device_name) {
+      disk_stats = ParseStat(stats[in_out_ms]);
       break;
     }
   }
-  const uint64_t tmp_prev_disk_stats = prev_disk_stats;
-  prev_disk_stats = disk_stats;
-  if (tmp_prev_disk_stats == 0) {
+  const double now = NowInSeconds();
+  auto& prev = prev_disk_stats[device_name];
+  const uint64_t tmp_prev_disk_stats = prev.first;
+  const double prev_time = prev.second;
+  prev = std::make_pair(disk_stats, now);
+  if (tmp_prev_disk_stats == 0 || now <= prev_time) {
     return 0.f;
   }
-  return 100.f *
-         (static_cast<float>(disk_stats - tmp_prev_disk_stats) /
-          static_cast<float>(FLAGS_resource_monitor_interval * seconds_to_ms));
+  // The time spent doing I/Os is in milliseconds.
+  return 100.f * static_cast<float>(
+                     static_cast<double>(disk_stats - tmp_prev_disk_stats) /
+                     ((now - prev_time) * 1000.0));
 }
 
 }  // namespace
@@ -290,13 +408,9 @@ void ResourceMonitor::CheckCPUUsage(
     if (process_dag_path.empty()) {
       cpu_usage_value = GetSystemCPUUsage();
     } else {
-      int pid = 0;
-      if (GetPIDByCmdLine(process_dag_path, &pid)) {
-        static std::unordered_map<std::string, uint64_t> prev_jiffies_map;
-        if (prev_jiffies_map.find(process_dag_path) == prev_jiffies_map.end()) {
-          prev_jiffies_map[process_dag_path] = 0;
-        }
-        cpu_usage_value = GetCPUUsage(pid, process_dag_path, &prev_jiffies_map);
+      auto* sampler = GetProcessSampler(process_dag_path);
+      if (sampler != nullptr) {
+        cpu_usage_value = GetCPUUsage(sampler, process_dag_path);
       }
     }
     const auto high_cpu_warning = cpu_usage.high_cpu_usage_warning();
@@ -324,9 +438,9 @@ void ResourceMonitor::CheckMemoryUsage(
     if (process_dag_path.empty()) {
       memory_usage_value = GetSystemMemoryUsage();
     } else {
-      int pid = 0;
-      if (GetPIDByCmdLine(process_dag_path, &pid)) {
-        memory_usage_value = GetMemoryUsage(pid, process_dag_path);
+      auto* sampler = GetProcessSampler(process_dag_path);
+      if (sampler != nullptr) {
+        memory_usage_value = GetMemoryUsage(sampler, process_dag_path);
       }
     }
     const auto high_memory_warning = memory_usage.high_memory_usage_warning();
@@ -17,6 +17,7 @@
 #include "modules/monitor/software/latency_monitor.h"
 
 #include <algorithm>
+#include <fstream>
 #include <memory>
 #include <unordered_set>
 #include <utility>
@@ -42,6 +43,11 @@ DEFINE_double(latency_report_interval, 15.0,
 DEFINE_int32(latency_reader_capacity, 30,
              "The max message numbers in latency reader queue.");
 
+DEFINE_string(latency_trace_file, "",
+              "File the per-stage breakdown of the end to end traces is "
+              "appended to as folded stacks, for flame graphs. Empty to "
+              "disable it.");
+
 namespace apollo {
 namespace monitor {
 
@@ -52,6 +58,8 @@ using apollo::common::LatencyReport;
 using apollo::common::LatencyStat;
 using apollo::common::LatencyTrack;
 
+using Span = std::tuple<uint64_t, uint64_t, std::string>;
+
 LatencyStat GenerateStat(const std::vector<uint64_t>& numbers) {
   LatencyStat stat;
   uint64_t min_number = (1UL << 63), max_number = 0, sum = 0;
@@ -84,6 +92,29 @@ void SetLatency(const std::string& latency_name,
   SetStat(GenerateStat(latency_values), latency_track->mutable_latency_stat());
 }
 
+// Fold the stages of a trace, in the order they begin, into stacks of the
+// stages before them. The time a stage waits for its predecessors and the time
+// it runs are added up separately, so that the stack of the first stage spans
+// the whole trace in a flame graph.
+void FoldCriticalPath(const std::vector<Span>& chain,
+                      std::map<std::string, uint64_t>* stacks) {
+  std::string stack;
+  uint64_t ready_time = std::get<0>(chain.front());
+  for (const auto& span : chain) {
+    const uint64_t begin_time = std::get<0>(span);
+    const uint64_t end_time = std::get<1>(span);
+    stack = stack.empty() ? std::get<2>(span)
+                          : absl::StrCat(stack, ";", std::get<2>(span));
+    if (begin_time > ready_time) {
+      (*stacks)[absl::StrCat(stack, ";queue")] += begin_time - ready_time;
+    }
+    if (end_time > begin_time) {
+      (*stacks)[absl::StrCat(stack, ";process")] += end_time - begin_time;
+    }
+    ready_time = std::max(ready_time, end_time);
+  }
+}
+
 }  // namespace
 
 LatencyMonitor::LatencyMonitor()
@@ -144,6 +175,7 @@ void LatencyMonitor::PublishLatencyReport() {
       FLAGS_latency_reporting_topic);
   apollo::common::util::FillHeader("LatencyReport", &latency_report_);
   AggregateLatency();
+  ExportCriticalPaths();
   writer->Write(latency_report_);
   latency_report_.clear_header();
   track_map_.clear();
@@ -170,23 +202,33 @@ void LatencyMonitor::AggregateLatency() {
     }
   }
   // Aggregate E2E latencies
+  // The message ids are the lidar timestamps the modules pass on in their
+  // headers, so that the first span of each module after the start point
+  // makes up the causal chain of the message.
   std::unordered_map<std::string, uint64_t> e2e_latencies;
+  std::vector<Span> chain;
   for (const auto& message : track_map_) {
     uint64_t e2e_begin_time = 0;
     auto iter = message.second.begin();
     e2e_latencies.clear();
+    chain.clear();
     while (iter != message.second.end()) {
       std::tie(begin_time, std::ignore, module_name) = *iter;
       if (e2e_begin_time == 0 && module_name == kE2EStartPoint) {
         e2e_begin_time = begin_time;
+        chain.push_back(*iter);
       } else if (module_name != kE2EStartPoint && e2e_begin_time != 0 &&
                  e2e_latencies.find(module_name) == e2e_latencies.end()) {
         const auto duration = begin_time - e2e_begin_time;
         e2e_latencies[module_name] = duration;
         e2es_track[module_name].push_back(duration);
+        chain.push_back(*iter);
       }
       ++iter;
     }
+    if (chain.size() > 1 && !FLAGS_latency_trace_file.empty()) {
+      FoldCriticalPath(chain, &critical_paths_);
+    }
   }
 
   // The results could be in the following fromat:
@@ -213,6 +255,23 @@ void LatencyMonitor::AggregateLatency() {
   }
 }
 
+void LatencyMonitor::ExportCriticalPaths() {
+  if (critical_paths_.empty()) {
+    return;
+  }
+  // One "stage;...;stage;queue|process microseconds" line per stack, which
+  // flamegraph.pl and speedscope read as they are.
+  std::ofstream out(FLAGS_latency_trace_file, std::ios::app);
+  if (!out) {
+    AERROR << "Failed to open latency trace file " << FLAGS_latency_trace_file;
+  } else {
+    for (const auto& stack : critical_paths_) {
+      out << stack.first << ' ' << stack.second / 1000 << '\n';
+    }
+  }
+  critical_paths_.clear();
+}
+
 bool LatencyMonitor::GetFrequency(const std::string& channel_name,
                                   double* freq) {
   if (freq_map_.find(channel_name) == freq_map_.end()) {
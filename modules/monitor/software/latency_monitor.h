@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <map>
 #include <memory>
 #include <set>
 #include <string>
@@ -39,11 +40,14 @@ class LatencyMonitor : public RecurrentRunner {
       const std::shared_ptr<apollo::common::LatencyRecordMap>& records);
   void PublishLatencyReport();
   void AggregateLatency();
+  void ExportCriticalPaths();
 
   apollo::common::LatencyReport latency_report_;
   std::unordered_map<uint64_t,
                      std::set<std::tuple<uint64_t, uint64_t, std::string>>>
       track_map_;
+  // Time spent in each stage of the traces, keyed by its folded stack.
+  std::map<std::string, uint64_t> critical_paths_;
   std::unordered_map<std::string, double> freq_map_;
   double flush_time_ = 0.0;
 };
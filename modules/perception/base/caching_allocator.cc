@@ -0,0 +1,214 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#include "modules/perception/base/caching_allocator.h"
+
+#include <algorithm>
+
+#include "absl/strings/str_cat.h"
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace perception {
+namespace base {
+
+namespace {
+
+constexpr size_t kMinBlockSize = 512;
+constexpr size_t kSmallSize = 1 << 20;
+constexpr size_t kLargeBlockGranularity = 2 << 20;
+
+}  // namespace
+
+CachingAllocator::CachingAllocator(AllocFunc alloc_func, FreeFunc free_func,
+                                   size_t max_cached_bytes)
+    : alloc_func_(std::move(alloc_func)),
+      free_func_(std::move(free_func)),
+      max_cached_bytes_(max_cached_bytes) {}
+
+CachingAllocator::~CachingAllocator() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  ReleaseCache();
+}
+
+size_t CachingAllocator::RoundSize(size_t size) {
+  if (size <= kMinBlockSize) {
+    return kMinBlockSize;
+  }
+  if (size <= kSmallSize) {
+    size_t rounded = kMinBlockSize;
+    while (rounded < size) {
+      rounded <<= 1;
+    }
+    return rounded;
+  }
+  return (size + kLargeBlockGranularity - 1) / kLargeBlockGranularity *
+         kLargeBlockGranularity;
+}
+
+void* CachingAllocator::Allocate(size_t size, const void* stream) {
+  const size_t rounded_size = RoundSize(size);
+  std::lock_guard<std::mutex> lock(mutex_);
+  ++stats_.num_allocs;
+
+  void* ptr = nullptr;
+  auto iter = cached_blocks_.find(BucketKey(stream, rounded_size));
+  if (iter != cached_blocks_.end() && !iter->second.empty()) {
+    ptr = iter->second.back();
+    iter->second.pop_back();
+    stats_.cached_bytes -= rounded_size;
+    ++stats_.num_cache_hits;
+  } else {
+    ptr = alloc_func_(rounded_size);
+    if (ptr == nullptr && stats_.cached_bytes > 0) {
+      // blocks of other size classes may be enough for the backend
+      AWARN << "Out of memory allocating " << rounded_size
+            << " bytes, release " << stats_.cached_bytes << " cached bytes.";
+      ReleaseCache();
+      ptr = alloc_func_(rounded_size);
+    }
+    if (ptr == nullptr) {
+      AERROR << "Failed to allocate " << rounded_size << " bytes.";
+      return nullptr;
+    }
+    ++stats_.num_backend_allocs;
+  }
+
+  Block& block = used_blocks_[ptr];
+  block.size = rounded_size;
+  block.stream = stream;
+  stats_.in_use_bytes += rounded_size;
+  stats_.peak_in_use_bytes =
+      std::max(stats_.peak_in_use_bytes, stats_.in_use_bytes);
+  return ptr;
+}
+
+void CachingAllocator::Free(void* ptr) {
+  if (ptr == nullptr) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = used_blocks_.find(ptr);
+  if (iter == used_blocks_.end()) {
+    AERROR << "Free a pointer not allocated by this allocator.";
+    return;
+  }
+  const Block block = iter->second;
+  used_blocks_.erase(iter);
+  stats_.in_use_bytes -= block.size;
+
+  if (stats_.cached_bytes + block.size > max_cached_bytes_) {
+    free_func_(ptr);
+    ++stats_.num_backend_frees;
+    return;
+  }
+  cached_blocks_[BucketKey(block.stream, block.size)].push_back(ptr);
+  stats_.cached_bytes += block.size;
+}
+
+void CachingAllocator::EmptyCache() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  ReleaseCache();
+}
+
+void CachingAllocator::set_max_cached_bytes(size_t max_cached_bytes) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  max_cached_bytes_ = max_cached_bytes;
+  if (stats_.cached_bytes > max_cached_bytes_) {
+    ReleaseCache();
+  }
+}
+
+CachingAllocatorStats CachingAllocator::stats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stats_;
+}
+
+std::string CachingAllocator::DebugString() const {
+  const CachingAllocatorStats stats = this->stats();
+  return absl::StrCat(
+      "in_use_bytes: ", stats.in_use_bytes,
+      " peak_in_use_bytes: ", stats.peak_in_use_bytes,
+      " cached_bytes: ", stats.cached_bytes, " num_allocs: ", stats.num_allocs,
+      " num_cache_hits: ", stats.num_cache_hits,
+      " num_backend_allocs: ", stats.num_backend_allocs,
+      " num_backend_frees: ", stats.num_backend_frees);
+}
+
+void CachingAllocator::ReleaseCache() {
+  for (auto& bucket : cached_blocks_) {
+    for (void* ptr : bucket.second) {
+      free_func_(ptr);
+      ++stats_.num_backend_frees;
+    }
+  }
+  cached_blocks_.clear();
+  stats_.cached_bytes = 0;
+}
+
+#if USE_GPU == 1
+
+namespace {
+
+constexpr size_t kMaxDeviceCachedBytes = size_t(1) << 30;
+constexpr size_t kMaxPinnedHostCachedBytes = size_t(256) << 20;
+
+}  // namespace
+
+CachingAllocator* DeviceCachingAllocator() {
+  static std::mutex mutex;
+  // never destroyed, blobs may be freed after static destruction started
+  static auto* allocators = new std::map<int, CachingAllocator*>();
+  int device = 0;
+  BASE_CUDA_CHECK(cudaGetDevice(&device));
+  std::lock_guard<std::mutex> lock(mutex);
+  CachingAllocator*& allocator = (*allocators)[device];
+  if (allocator == nullptr) {
+    allocator = new CachingAllocator(
+        [](size_t size) -> void* {
+          void* ptr = nullptr;
+          if (cudaMalloc(&ptr, size) != cudaSuccess) {
+            // clear the sticky error so that the retry can succeed
+            cudaGetLastError();
+            return nullptr;
+          }
+          return ptr;
+        },
+        [](void* ptr) { BASE_CUDA_CHECK(cudaFree(ptr)); },
+        kMaxDeviceCachedBytes);
+  }
+  return allocator;
+}
+
+CachingAllocator* PinnedHostCachingAllocator() {
+  static auto* allocator = new CachingAllocator(
+      [](size_t size) -> void* {
+        void* ptr = nullptr;
+        if (cudaMallocHost(&ptr, size) != cudaSuccess) {
+          cudaGetLastError();
+          return nullptr;
+        }
+        return ptr;
+      },
+      [](void* ptr) { BASE_CUDA_CHECK(cudaFreeHost(ptr)); },
+      kMaxPinnedHostCachedBytes);
+  return allocator;
+}
+
+#endif
+
+}  // namespace base
+}  // namespace perception
+}  // namespace apollo
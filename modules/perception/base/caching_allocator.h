@@ -0,0 +1,113 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "modules/perception/base/common.h"
+
+namespace apollo {
+namespace perception {
+namespace base {
+
+struct CachingAllocatorStats {
+  // bytes handed out to callers, after rounding to the size class
+  size_t in_use_bytes = 0;
+  size_t peak_in_use_bytes = 0;
+  // bytes freed by callers and kept for reuse
+  size_t cached_bytes = 0;
+  uint64_t num_allocs = 0;
+  uint64_t num_cache_hits = 0;
+  uint64_t num_backend_allocs = 0;
+  uint64_t num_backend_frees = 0;
+};
+
+/**
+ * @brief Keeps freed blocks and hands them out again for requests of the same
+ *        size class, so that steady state frames never reach the backend.
+ *        For the device this avoids cudaMalloc and cudaFree, which
+ *        synchronize the whole device.
+ *
+ * A block is only reused on the stream it was allocated for: work queued on
+ * one stream is ordered, so a new owner can not overwrite data an earlier
+ * kernel still reads. Pass nullptr as the stream for host memory and for the
+ * legacy default stream.
+ */
+class CachingAllocator {
+ public:
+  using AllocFunc = std::function<void*(size_t)>;
+  using FreeFunc = std::function<void(void*)>;
+
+  // @brief the backend returns nullptr if it is out of memory
+  CachingAllocator(AllocFunc alloc_func, FreeFunc free_func,
+                   size_t max_cached_bytes);
+  CachingAllocator(const CachingAllocator&) = delete;
+  CachingAllocator& operator=(const CachingAllocator&) = delete;
+  ~CachingAllocator();
+
+  void* Allocate(size_t size, const void* stream = nullptr);
+  void Free(void* ptr);
+
+  // @brief return every cached block to the backend
+  void EmptyCache();
+
+  void set_max_cached_bytes(size_t max_cached_bytes);
+
+  CachingAllocatorStats stats() const;
+  std::string DebugString() const;
+
+  // @brief size class of a request: powers of two up to 1MB, multiples of
+  //        2MB above, so that reshaped blobs of similar size share blocks
+  static size_t RoundSize(size_t size);
+
+ private:
+  using BucketKey = std::pair<const void*, size_t>;
+
+  struct Block {
+    size_t size = 0;
+    const void* stream = nullptr;
+  };
+
+  void ReleaseCache();
+
+  AllocFunc alloc_func_;
+  FreeFunc free_func_;
+  size_t max_cached_bytes_ = 0;
+
+  mutable std::mutex mutex_;
+  std::map<BucketKey, std::vector<void*>> cached_blocks_;
+  std::unordered_map<void*, Block> used_blocks_;
+  CachingAllocatorStats stats_;
+};
+
+#if USE_GPU == 1
+// @brief allocator of the current device
+CachingAllocator* DeviceCachingAllocator();
+// @brief allocator of page locked host memory
+CachingAllocator* PinnedHostCachingAllocator();
+#endif
+
+}  // namespace base
+}  // namespace perception
+}  // namespace apollo
@@ -0,0 +1,146 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#include "modules/perception/base/caching_allocator.h"
+
+#include <cstdlib>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace perception {
+namespace base {
+
+namespace {
+
+int num_live_blocks = 0;
+
+void* TestMalloc(size_t size) {
+  ++num_live_blocks;
+  return malloc(size);
+}
+
+void TestFree(void* ptr) {
+  --num_live_blocks;
+  free(ptr);
+}
+
+}  // namespace
+
+TEST(CachingAllocatorTest, round_size_test) {
+  EXPECT_EQ(CachingAllocator::RoundSize(1), 512);
+  EXPECT_EQ(CachingAllocator::RoundSize(512), 512);
+  EXPECT_EQ(CachingAllocator::RoundSize(513), 1024);
+  EXPECT_EQ(CachingAllocator::RoundSize(1 << 20), 1 << 20);
+  EXPECT_EQ(CachingAllocator::RoundSize((1 << 20) + 1), 2 << 20);
+  EXPECT_EQ(CachingAllocator::RoundSize((2 << 20) + 1), 4 << 20);
+  EXPECT_EQ(CachingAllocator::RoundSize((4 << 20) + 1), 6 << 20);
+}
+
+TEST(CachingAllocatorTest, reuse_test) {
+  num_live_blocks = 0;
+  {
+    CachingAllocator allocator(TestMalloc, TestFree, 1 << 20);
+    void* ptr = allocator.Allocate(1000);
+    EXPECT_NE(ptr, nullptr);
+    allocator.Free(ptr);
+    // same size class
+    void* reused = allocator.Allocate(600);
+    EXPECT_EQ(reused, ptr);
+    // another size class
+    void* other = allocator.Allocate(2000);
+    EXPECT_NE(other, ptr);
+    EXPECT_EQ(num_live_blocks, 2);
+
+    CachingAllocatorStats stats = allocator.stats();
+    EXPECT_EQ(stats.num_allocs, 3);
+    EXPECT_EQ(stats.num_cache_hits, 1);
+    EXPECT_EQ(stats.num_backend_allocs, 2);
+    EXPECT_EQ(stats.in_use_bytes, 1024 + 2048);
+    EXPECT_EQ(stats.cached_bytes, 0);
+
+    allocator.Free(reused);
+    allocator.Free(other);
+    stats = allocator.stats();
+    EXPECT_EQ(stats.in_use_bytes, 0);
+    EXPECT_EQ(stats.peak_in_use_bytes, 1024 + 2048);
+    EXPECT_EQ(stats.cached_bytes, 1024 + 2048);
+    EXPECT_EQ(num_live_blocks, 2);
+
+    allocator.EmptyCache();
+    EXPECT_EQ(allocator.stats().cached_bytes, 0);
+    EXPECT_EQ(num_live_blocks, 0);
+
+    allocator.Free(allocator.Allocate(100));
+  }
+  // the destructor releases the cache
+  EXPECT_EQ(num_live_blocks, 0);
+}
+
+TEST(CachingAllocatorTest, stream_test) {
+  num_live_blocks = 0;
+  CachingAllocator allocator(TestMalloc, TestFree, 1 << 20);
+  int stream1 = 0;
+  int stream2 = 0;
+  void* ptr = allocator.Allocate(1000, &stream1);
+  allocator.Free(ptr);
+  // blocks are not shared between streams
+  void* ptr2 = allocator.Allocate(1000, &stream2);
+  EXPECT_NE(ptr2, ptr);
+  EXPECT_EQ(allocator.Allocate(1000, &stream1), ptr);
+  EXPECT_EQ(num_live_blocks, 2);
+  allocator.Free(ptr);
+  allocator.Free(ptr2);
+}
+
+TEST(CachingAllocatorTest, max_cached_bytes_test) {
+  num_live_blocks = 0;
+  CachingAllocator allocator(TestMalloc, TestFree, 2048);
+  void* ptr1 = allocator.Allocate(2048);
+  void* ptr2 = allocator.Allocate(2048);
+  allocator.Free(ptr1);
+  // the cache is full, so the block goes back to the backend
+  allocator.Free(ptr2);
+  EXPECT_EQ(num_live_blocks, 1);
+  EXPECT_EQ(allocator.stats().num_backend_frees, 1);
+
+  allocator.set_max_cached_bytes(0);
+  EXPECT_EQ(num_live_blocks, 0);
+  EXPECT_EQ(allocator.stats().cached_bytes, 0);
+}
+
+TEST(CachingAllocatorTest, out_of_memory_test) {
+  num_live_blocks = 0;
+  bool out_of_memory = false;
+  CachingAllocator allocator(
+      [&out_of_memory](size_t size) -> void* {
+        return out_of_memory ? nullptr : TestMalloc(size);
+      },
+      TestFree, 1 << 20);
+  allocator.Free(allocator.Allocate(1000));
+  EXPECT_EQ(num_live_blocks, 1);
+  out_of_memory = true;
+  // the cache is released before giving up
+  EXPECT_EQ(allocator.Allocate(5000), nullptr);
+  EXPECT_EQ(num_live_blocks, 0);
+  // freeing an unknown pointer is ignored
+  int value = 0;
+  allocator.Free(&value);
+  EXPECT_EQ(allocator.stats().in_use_bytes, 0);
+}
+
+}  // namespace base
+}  // namespace perception
+}  // namespace apollo
@@ -15,29 +15,61 @@
  *****************************************************************************/
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <deque>
 #include <list>
 #include <memory>
 #include <mutex>
-#include <queue>
+#include <type_traits>
 #include <vector>
 
 #include "modules/perception/base/object_pool.h"
 
+// objects are malloc-ed per Get unless the build turns the pool on with
+// --copt=-DPERCEPTION_BASE_ENABLE_POOL
+#ifndef PERCEPTION_BASE_ENABLE_POOL
 #define PERCEPTION_BASE_DISABLE_POOL
+#endif
 namespace apollo {
 namespace perception {
 namespace base {
 
 static const size_t kPoolDefaultExtendNum = 10;
 static const size_t kPoolDefaultSize = 100;
+// objects moved at once between a thread cache and the shared free list
+static const size_t kPoolDefaultBatchSize = 16;
 
 // @brief default initializer used in concurrent object pool
 template <class T>
 struct ObjectPoolDefaultInitializer {
   void operator()(T* t) const {}
 };
+
+// @brief usage metrics of one concurrent object pool
+struct ObjectPoolStats {
+  // objects owned by the pool
+  size_t capacity = 0;
+  // objects handed out and not released yet
+  size_t in_use = 0;
+  // objects handed out since the pool was created
+  uint64_t gets = 0;
+  // gets served by the cache of the calling thread
+  uint64_t cache_hits = 0;
+  // times the pool allocated more objects
+  uint64_t extends = 0;
+};
+
 // @brief concurrent object pool with dynamic size
+//
+// Every thread keeps a small cache of free objects and only goes to the
+// shared free list, a lock-free stack of batches, when its cache runs empty
+// or full. The mutex is only taken to extend the pool and when a thread
+// first uses or leaves it. The shared_ptr control block of an object lives
+// next to it, so Get and BatchGet do not allocate once the pool is large
+// enough.
 template <class ObjectType, size_t N = kPoolDefaultSize,
           class Initializer = ObjectPoolDefaultInitializer<ObjectType>>
 class ConcurrentObjectPool : public BaseObjectPool<ObjectType> {
@@ -53,22 +85,9 @@ class ConcurrentObjectPool : public BaseObjectPool<ObjectType> {
   std::shared_ptr<ObjectType> Get() override {
 // TODO(All): remove conditional build
 #ifndef PERCEPTION_BASE_DISABLE_POOL
-    ObjectType* ptr = nullptr;
-    {
-      std::lock_guard<std::mutex> lock(mutex_);
-      if (queue_.empty()) {
-        Add(1 + kPoolDefaultExtendNum);
-      }
-      ptr = queue_.front();
-      queue_.pop();
-    }
-    // For efficiency consideration, initialization should be invoked
-    // after releasing the mutex
-    kInitializer(ptr);
-    return std::shared_ptr<ObjectType>(ptr, [&](ObjectType* obj_ptr) {
-      std::lock_guard<std::mutex> lock(mutex_);
-      queue_.push(obj_ptr);
-    });
+    Node* node = Acquire(LocalCache(), 1);
+    kInitializer(&node->object);
+    return MakeShared(node);
 #else
     return std::shared_ptr<ObjectType>(new ObjectType);
 #endif
@@ -79,26 +98,11 @@ class ConcurrentObjectPool : public BaseObjectPool<ObjectType> {
   void BatchGet(size_t num,
                 std::vector<std::shared_ptr<ObjectType>>* data) override {
 #ifndef PERCEPTION_BASE_DISABLE_POOL
-    std::vector<ObjectType*> buffer(num, nullptr);
-    {
-      std::lock_guard<std::mutex> lock(mutex_);
-      if (queue_.size() < num) {
-        Add(num - queue_.size() + kPoolDefaultExtendNum);
-      }
-      for (size_t i = 0; i < num; ++i) {
-        buffer[i] = queue_.front();
-        queue_.pop();
-      }
-    }
-    // For efficiency consideration, initialization should be invoked
-    // after releasing the mutex
+    ThreadCache* cache = LocalCache();
     for (size_t i = 0; i < num; ++i) {
-      kInitializer(buffer[i]);
-      data->emplace_back(
-          std::shared_ptr<ObjectType>(buffer[i], [&](ObjectType* obj_ptr) {
-            std::lock_guard<std::mutex> lock(mutex_);
-            queue_.push(obj_ptr);
-          }));
+      Node* node = Acquire(cache, num - i);
+      kInitializer(&node->object);
+      data->emplace_back(MakeShared(node));
     }
 #else
     for (size_t i = 0; i < num; ++i) {
@@ -113,32 +117,12 @@ class ConcurrentObjectPool : public BaseObjectPool<ObjectType> {
   void BatchGet(size_t num, bool is_front,
                 std::list<std::shared_ptr<ObjectType>>* data) override {
 #ifndef PERCEPTION_BASE_DISABLE_POOL
-    std::vector<ObjectType*> buffer(num, nullptr);
-    {
-      std::lock_guard<std::mutex> lock(mutex_);
-      if (queue_.size() < num) {
-        Add(num - queue_.size() + kPoolDefaultExtendNum);
-      }
-      for (size_t i = 0; i < num; ++i) {
-        buffer[i] = queue_.front();
-        queue_.pop();
-      }
-    }
-    // For efficiency consideration, initialization should be invoked
-    // after releasing the mutex
+    ThreadCache* cache = LocalCache();
     for (size_t i = 0; i < num; ++i) {
-      kInitializer(buffer[i]);
-      is_front ? data->emplace_front(std::shared_ptr<ObjectType>(
-                     buffer[i],
-                     [&](ObjectType* obj_ptr) {
-                       std::lock_guard<std::mutex> lock(mutex_);
-                       queue_.push(obj_ptr);
-                     }))
-               : data->emplace_back(std::shared_ptr<ObjectType>(
-                     buffer[i], [&](ObjectType* obj_ptr) {
-                       std::lock_guard<std::mutex> lock(mutex_);
-                       queue_.push(obj_ptr);
-                     }));
+      Node* node = Acquire(cache, num - i);
+      kInitializer(&node->object);
+      is_front ? data->emplace_front(MakeShared(node))
+               : data->emplace_back(MakeShared(node));
     }
 #else
     for (size_t i = 0; i < num; ++i) {
@@ -154,30 +138,12 @@ class ConcurrentObjectPool : public BaseObjectPool<ObjectType> {
   void BatchGet(size_t num, bool is_front,
                 std::deque<std::shared_ptr<ObjectType>>* data) override {
 #ifndef PERCEPTION_BASE_DISABLE_POOL
-    std::vector<ObjectType*> buffer(num, nullptr);
-    {
-      std::lock_guard<std::mutex> lock(mutex_);
-      if (queue_.size() < num) {
-        Add(num - queue_.size() + kPoolDefaultExtendNum);
-      }
-      for (size_t i = 0; i < num; ++i) {
-        buffer[i] = queue_.front();
-        queue_.pop();
-      }
-    }
+    ThreadCache* cache = LocalCache();
     for (size_t i = 0; i < num; ++i) {
-      kInitializer(buffer[i]);
-      is_front ? data->emplace_front(std::shared_ptr<ObjectType>(
-                     buffer[i],
-                     [&](ObjectType* obj_ptr) {
-                       std::lock_guard<std::mutex> lock(mutex_);
-                       queue_.push(obj_ptr);
-                     }))
-               : data->emplace_back(std::shared_ptr<ObjectType>(
-                     buffer[i], [&](ObjectType* obj_ptr) {
-                       std::lock_guard<std::mutex> lock(mutex_);
-                       queue_.push(obj_ptr);
-                     }));
+      Node* node = Acquire(cache, num - i);
+      kInitializer(&node->object);
+      is_front ? data->emplace_front(MakeShared(node))
+               : data->emplace_back(MakeShared(node));
     }
 #else
     for (size_t i = 0; i < num; ++i) {
@@ -191,11 +157,34 @@ class ConcurrentObjectPool : public BaseObjectPool<ObjectType> {
   void set_capacity(size_t capacity) override {
     std::lock_guard<std::mutex> lock(mutex_);
     if (capacity_ < capacity) {
-      Add(capacity - capacity_);
+      PushBatch(Add(capacity - capacity_));
     }
   }
   // @brief get remained object number
-  size_t RemainedNum() override { return queue_.size(); }
+  size_t RemainedNum() override {
+    ObjectPoolStats stats = Stats();
+    return stats.capacity - stats.in_use;
+  }
+  // @brief get usage metrics, counters of other threads may lag behind
+  //        until those threads are quiescent
+  ObjectPoolStats Stats() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    uint64_t gets = retired_gets_.load(std::memory_order_relaxed);
+    uint64_t hits = retired_hits_.load(std::memory_order_relaxed);
+    uint64_t puts = retired_puts_.load(std::memory_order_relaxed);
+    for (const ThreadCache* cache : caches_) {
+      gets += cache->gets.load(std::memory_order_relaxed);
+      hits += cache->hits.load(std::memory_order_relaxed);
+      puts += cache->puts.load(std::memory_order_relaxed);
+    }
+    ObjectPoolStats stats;
+    stats.capacity = capacity_;
+    stats.in_use = gets > puts ? static_cast<size_t>(gets - puts) : 0;
+    stats.gets = gets;
+    stats.cache_hits = hits;
+    stats.extends = extends_;
+    return stats;
+  }
 #endif
   // @brief destructor to release the cached memory
   ~ConcurrentObjectPool() override {
@@ -204,44 +193,287 @@ class ConcurrentObjectPool : public BaseObjectPool<ObjectType> {
       cache_ = nullptr;
     }
     for (auto& ptr : extended_cache_) {
-      delete ptr;
+      delete[] ptr;
     }
     extended_cache_.clear();
   }
 
  protected:
-// @brief add num objects, should add lock before invoke this function
+  // @brief storage of a pooled object with the shared_ptr control block
+  //        pointing to it
+  struct Node {
+    ObjectType object;
+    typename std::aligned_storage<8 * sizeof(void*),
+                                  alignof(std::max_align_t)>::type
+        control_block;
+    // next node of the same batch
+    Node* next = nullptr;
+    // next batch of the free list, only set on the first node of a batch
+    Node* next_batch = nullptr;
+  };
+
+  struct alignas(2 * sizeof(Node*)) Head {
+    uintptr_t count;
+    Node* node;
+  };
+
+  // @brief free objects of one thread, with usage counters that only the
+  //        owning thread writes
+  struct ThreadCache {
+    ~ThreadCache() {
+      if (pool != nullptr) {
+        pool->Retire(this);
+      }
+      ConcurrentObjectPool::ThreadExiting() = true;
+    }
+    ConcurrentObjectPool* pool = nullptr;
+    Node* nodes[2 * kPoolDefaultBatchSize];
+    size_t size = 0;
+    std::atomic<uint64_t> gets{0};
+    std::atomic<uint64_t> hits{0};
+    std::atomic<uint64_t> puts{0};
+  };
+
+  // @brief the object is not deleted, its node goes back to the pool when
+  //        the control block is deallocated
+  struct NodeDeleter {
+    void operator()(ObjectType* obj_ptr) const {}
+  };
+
+  // @brief places the control block in the node instead of the heap, the
+  //        node is released after the last shared and weak owner is gone
+  template <class T>
+  struct NodeAllocator {
+    using value_type = T;
+    template <class U>
+    struct rebind {
+      using other = NodeAllocator<U>;
+    };
+    NodeAllocator(ConcurrentObjectPool* pool, Node* node)
+        : pool(pool), node(node) {}
+    template <class U>
+    NodeAllocator(const NodeAllocator<U>& other)  // NOLINT
+        : pool(other.pool), node(other.node) {}
+    T* allocate(size_t n) {
+      static_assert(sizeof(T) <= sizeof(Node::control_block),
+                    "control block does not fit in the pool node");
+      static_assert(alignof(T) <= alignof(std::max_align_t),
+                    "control block is over aligned");
+      return reinterpret_cast<T*>(&node->control_block);
+    }
+    void deallocate(T* p, size_t n) { pool->Release(node); }
+    template <class U>
+    bool operator==(const NodeAllocator<U>& other) const {
+      return node == other.node;
+    }
+    template <class U>
+    bool operator!=(const NodeAllocator<U>& other) const {
+      return node != other.node;
+    }
+    ConcurrentObjectPool* pool;
+    Node* node;
+  };
+
 #ifndef PERCEPTION_BASE_DISABLE_POOL
-  void Add(size_t num) {
+  std::shared_ptr<ObjectType> MakeShared(Node* node) {
+    return std::shared_ptr<ObjectType>(&node->object, NodeDeleter(),
+                                       NodeAllocator<ObjectType>(this, node));
+  }
+
+  // @brief cache of the calling thread, nullptr once it is destroyed at
+  //        thread exit
+  ThreadCache* LocalCache() {
+    if (ThreadExiting()) {
+      return nullptr;
+    }
+    static thread_local ThreadCache thread_cache;
+    ThreadCache* cache = &thread_cache;
+    if (cache->pool == nullptr) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      cache->pool = this;
+      caches_.push_back(cache);
+    }
+    return cache;
+  }
+
+  // @brief returns the objects of an exiting thread to the free list and
+  //        keeps its counters
+  void Retire(ThreadCache* cache) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    while (cache->size > 0) {
+      Spill(cache, std::min(cache->size, kPoolDefaultBatchSize));
+    }
+    retired_gets_.fetch_add(cache->gets, std::memory_order_relaxed);
+    retired_hits_.fetch_add(cache->hits, std::memory_order_relaxed);
+    retired_puts_.fetch_add(cache->puts, std::memory_order_relaxed);
+    caches_.erase(std::find(caches_.begin(), caches_.end(), cache));
+  }
+
+  // @brief takes a free node, num is how many more the caller is about to
+  //        take and sizes the extension if the pool runs out
+  Node* Acquire(ThreadCache* cache, size_t num) {
+    if (cache == nullptr) {
+      Node* node = AcquireBatch(num);
+      if (node->next != nullptr) {
+        PushBatch(node->next);
+      }
+      retired_gets_.fetch_add(1, std::memory_order_relaxed);
+      return node;
+    }
+    if (cache->size == 0) {
+      for (Node* node = AcquireBatch(num); node != nullptr;
+           node = node->next) {
+        cache->nodes[cache->size++] = node;
+      }
+    } else {
+      Increment(&cache->hits);
+    }
+    Increment(&cache->gets);
+    return cache->nodes[--cache->size];
+  }
+
+  void Release(Node* node) {
+    ThreadCache* cache = LocalCache();
+    if (cache == nullptr) {
+      node->next = nullptr;
+      PushBatch(node);
+      retired_puts_.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    if (cache->size == 2 * kPoolDefaultBatchSize) {
+      Spill(cache, kPoolDefaultBatchSize);
+    }
+    cache->nodes[cache->size++] = node;
+    Increment(&cache->puts);
+  }
+
+  // @brief moves the num latest nodes of the cache to the free list
+  void Spill(ThreadCache* cache, size_t num) {
+    Node* batch = nullptr;
     for (size_t i = 0; i < num; ++i) {
-      ObjectType* ptr = new ObjectType;
-      extended_cache_.push_back(ptr);
-      queue_.push(ptr);
+      Node* node = cache->nodes[--cache->size];
+      node->next = batch;
+      batch = node;
+    }
+    PushBatch(batch);
+  }
+
+  // @brief pops a batch of the free list, extends the pool by num objects
+  //        and more when the free list is empty
+  Node* AcquireBatch(size_t num) {
+    Node* batch = PopBatch();
+    if (batch == nullptr) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      // another thread may have extended the pool in the meantime
+      batch = PopBatch();
+      if (batch == nullptr) {
+        batch = Add(num + kPoolDefaultExtendNum);
+      }
     }
-    capacity_ = kDefaultCacheSize + extended_cache_.size();
+    return batch;
+  }
+
+  Node* PopBatch() {
+    Head new_head;
+    Head old_head = free_head_.load(std::memory_order_acquire);
+    do {
+      if (old_head.node == nullptr) {
+        return nullptr;
+      }
+      new_head.node = old_head.node->next_batch;
+      new_head.count = old_head.count + 1;
+    } while (!free_head_.compare_exchange_weak(old_head, new_head,
+                                               std::memory_order_acq_rel,
+                                               std::memory_order_acquire));
+    return old_head.node;
+  }
+
+  void PushBatch(Node* batch) {
+    Head new_head;
+    Head old_head = free_head_.load(std::memory_order_acquire);
+    do {
+      batch->next_batch = old_head.node;
+      new_head.node = batch;
+      new_head.count = old_head.count + 1;
+    } while (!free_head_.compare_exchange_weak(old_head, new_head,
+                                               std::memory_order_acq_rel,
+                                               std::memory_order_acquire));
+  }
+
+  // @brief add num objects, should add lock before invoke this function,
+  //        returns their first batch and pushes the others to the free list
+  Node* Add(size_t num) {
+    Node* nodes = new Node[num];
+    extended_cache_.push_back(nodes);
+    capacity_ += num;
+    ++extends_;
+    return Link(nodes, num);
+  }
+
+  // @brief links num continuous nodes into batches, returns the first batch
+  //        and pushes the others to the free list
+  Node* Link(Node* nodes, size_t num) {
+    Node* first = nullptr;
+    for (size_t begin = 0; begin < num; begin += kPoolDefaultBatchSize) {
+      size_t end = std::min(num, begin + kPoolDefaultBatchSize);
+      for (size_t i = begin; i + 1 < end; ++i) {
+        nodes[i].next = &nodes[i + 1];
+      }
+      if (first == nullptr) {
+        first = &nodes[begin];
+      } else {
+        PushBatch(&nodes[begin]);
+      }
+    }
+    return first;
+  }
+
+  static bool& ThreadExiting() {
+    static thread_local bool exiting = false;
+    return exiting;
+  }
+
+  // @brief only the owning thread writes a cache counter, so a plain store
+  //        is enough
+  static void Increment(std::atomic<uint64_t>* counter) {
+    counter->store(counter->load(std::memory_order_relaxed) + 1,
+                   std::memory_order_relaxed);
   }
 #endif
   // @brief default constructor
   explicit ConcurrentObjectPool(const size_t default_size)
       : kDefaultCacheSize(default_size) {
 #ifndef PERCEPTION_BASE_DISABLE_POOL
-    cache_ = new ObjectType[kDefaultCacheSize];
-    for (size_t i = 0; i < kDefaultCacheSize; ++i) {
-      queue_.push(&cache_[i]);
+    free_head_.store({0, nullptr}, std::memory_order_relaxed);
+    cache_ = new Node[kDefaultCacheSize];
+    Node* first = Link(cache_, kDefaultCacheSize);
+    if (first != nullptr) {
+      PushBatch(first);
     }
     capacity_ = kDefaultCacheSize;
 #endif
   }
   std::mutex mutex_;
-  std::queue<ObjectType*> queue_;
+  // @brief lock-free stack of free batches
+  std::atomic<Head> free_head_;
+  // @brief caches of the live threads and the counters of the exited ones
+  std::vector<ThreadCache*> caches_;
+  std::atomic<uint64_t> retired_gets_ = {0};
+  std::atomic<uint64_t> retired_hits_ = {0};
+  std::atomic<uint64_t> retired_puts_ = {0};
+  uint64_t extends_ = 0;
   // @brief point to a continuous memory of default pool size
-  ObjectType* cache_ = nullptr;
+  Node* cache_ = nullptr;
   const size_t kDefaultCacheSize;
   // @brief list to store extended memory, not as efficient
-  std::list<ObjectType*> extended_cache_;
+  std::list<Node*> extended_cache_;
   static const Initializer kInitializer;
 };
 
+template <class ObjectType, size_t N, class Initializer>
+const Initializer ConcurrentObjectPool<ObjectType, N, Initializer>::
+    kInitializer{};
+
 }  // namespace base
 }  // namespace perception
 }  // namespace apollo
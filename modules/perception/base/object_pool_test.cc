@@ -15,6 +15,8 @@
  *****************************************************************************/
 #include "modules/perception/base/object_pool.h"
 
+#include <thread>
+
 #include "modules/perception/base/light_object_pool.h"
 #include "modules/perception/base/object.h"
 #include "modules/perception/base/object_pool_types.h"
@@ -253,7 +255,9 @@ TEST(ObjectPoolTest, concurrent_object_pool_initializer_test) {
   }
 #endif
   {
-    typedef ConcurrentObjectPool<Object> TestObjectPool;
+    // a pool of its own, the objects of ConcurrentObjectPool<Object> were
+    // modified by the tests above and the default initializer keeps them so
+    typedef ConcurrentObjectPool<Object, 10> TestObjectPool;
     std::shared_ptr<Object> ptr = TestObjectPool::Instance().Get();
     EXPECT_EQ(ptr->id, -1);
     {
@@ -462,6 +466,75 @@ TEST(ObjectPoolTest, light_object_pool_initializer_test) {
   }
 }
 
+TEST(ObjectPoolTest, concurrent_object_pool_stats_test) {
+#ifndef PERCEPTION_BASE_DISABLE_POOL
+  typedef ConcurrentObjectPool<Object, 20> TestObjectPool;
+  auto& instance = TestObjectPool::Instance();
+  ObjectPoolStats stats = instance.Stats();
+  EXPECT_EQ(stats.capacity, 20);
+  EXPECT_EQ(stats.in_use, 0);
+  EXPECT_EQ(stats.gets, 0);
+  EXPECT_EQ(stats.extends, 0);
+  {
+    std::shared_ptr<Object> first = instance.Get();
+    std::shared_ptr<Object> second = instance.Get();
+    stats = instance.Stats();
+    EXPECT_EQ(stats.in_use, 2);
+    EXPECT_EQ(stats.gets, 2);
+    // the first get fills the thread cache, the second one hits it
+    EXPECT_EQ(stats.cache_hits, 1);
+  }
+  EXPECT_EQ(instance.Stats().in_use, 0);
+
+  std::vector<std::shared_ptr<Object>> objects;
+  objects.reserve(40);
+  instance.BatchGet(40, &objects);
+  stats = instance.Stats();
+  EXPECT_EQ(stats.in_use, 40);
+  EXPECT_GE(stats.capacity, 40);
+  EXPECT_GE(stats.extends, 1);
+  objects.clear();
+  // the pool is large enough now, so the same batch does not extend it
+  instance.BatchGet(40, &objects);
+  EXPECT_EQ(instance.Stats().extends, stats.extends);
+  EXPECT_EQ(instance.Stats().capacity, stats.capacity);
+  objects.clear();
+  EXPECT_EQ(instance.RemainedNum(), stats.capacity);
+#endif
+}
+
+TEST(ObjectPoolTest, concurrent_object_pool_multi_thread_test) {
+  typedef ConcurrentObjectPool<Object, 50> TestObjectPool;
+  auto& instance = TestObjectPool::Instance();
+  std::vector<std::thread> threads;
+  for (int id = 0; id < 4; ++id) {
+    threads.emplace_back([&instance, id]() {
+      std::vector<std::shared_ptr<Object>> objects;
+      for (int round = 0; round < 100; ++round) {
+        instance.BatchGet(30, &objects);
+        for (auto& object : objects) {
+          object->id = id;
+        }
+        std::this_thread::yield();
+        // no other thread got the same objects
+        for (auto& object : objects) {
+          EXPECT_EQ(object->id, id);
+        }
+        objects.clear();
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+#ifndef PERCEPTION_BASE_DISABLE_POOL
+  ObjectPoolStats stats = instance.Stats();
+  EXPECT_EQ(stats.gets, 4 * 100 * 30);
+  EXPECT_EQ(stats.in_use, 0);
+  EXPECT_EQ(instance.RemainedNum(), stats.capacity);
+#endif
+}
+
 }  // namespace base
 }  // namespace perception
 }  // namespace apollo
@@ -0,0 +1,330 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "modules/perception/base/point.h"
+#include "modules/perception/base/point_cloud.h"
+
+namespace apollo {
+namespace perception {
+namespace base {
+
+// @brief allocator aligning every buffer to a cache line, so that a field
+// starts on its own line and can be loaded with aligned simd instructions
+template <typename T, std::size_t Alignment = 64>
+struct CacheAlignedAllocator {
+  using value_type = T;
+  template <typename U>
+  struct rebind {
+    using other = CacheAlignedAllocator<U, Alignment>;
+  };
+
+  CacheAlignedAllocator() = default;
+  template <typename U>
+  CacheAlignedAllocator(const CacheAlignedAllocator<U, Alignment>&) {}
+
+  T* allocate(std::size_t n) {
+    // aligned_alloc requires the size to be a multiple of the alignment
+    const std::size_t bytes =
+        (n * sizeof(T) + Alignment - 1) / Alignment * Alignment;
+    void* ptr = std::aligned_alloc(Alignment, bytes == 0 ? Alignment : bytes);
+    if (ptr == nullptr) {
+      throw std::bad_alloc();
+    }
+    return static_cast<T*>(ptr);
+  }
+  void deallocate(T* ptr, std::size_t) { std::free(ptr); }
+
+  template <typename U>
+  bool operator==(const CacheAlignedAllocator<U, Alignment>&) const {
+    return true;
+  }
+  template <typename U>
+  bool operator!=(const CacheAlignedAllocator<U, Alignment>&) const {
+    return false;
+  }
+};
+
+template <typename T>
+using CacheAlignedVector = std::vector<T, CacheAlignedAllocator<T>>;
+
+// @brief non-owning view of one field of a point cloud
+template <typename T>
+class PointFieldView {
+ public:
+  PointFieldView(T* data, size_t size) : data_(data), size_(size) {}
+
+  inline T* data() const { return data_; }
+  inline size_t size() const { return size_; }
+  inline bool empty() const { return size_ == 0; }
+  inline T& operator[](size_t n) const { return data_[n]; }
+  inline T* begin() const { return data_; }
+  inline T* end() const { return data_ + size_; }
+
+ private:
+  T* data_ = nullptr;
+  size_t size_ = 0;
+};
+
+// @brief Point cloud storing every field of PointXYZITHBL in its own cache
+// aligned buffer (structure of arrays). A pass touching a few fields, e.g.
+// the height of every point, only streams those fields through the cache,
+// and a field can be uploaded to the gpu with a single copy. The fields are
+// the ones of AttributePointCloud, which it converts from and to, so that
+// algorithms can adopt it one at a time.
+template <typename T>
+class SoaPointCloud {
+ public:
+  using Type = T;
+  using PointType = Point<T>;
+
+  // @brief default constructor
+  SoaPointCloud() = default;
+  // @brief construct from an array of structs point cloud
+  explicit SoaPointCloud(const AttributePointCloud<PointType>& pc) {
+    CopyFrom(pc);
+  }
+
+  // @brief accessor of point size
+  inline size_t size() const { return x_.size(); }
+  inline bool empty() const { return x_.empty(); }
+
+  inline void reserve(const size_t size) {
+    x_.reserve(size);
+    y_.reserve(size);
+    z_.reserve(size);
+    intensity_.reserve(size);
+    points_timestamp_.reserve(size);
+    points_height_.reserve(size);
+    points_beam_id_.reserve(size);
+    points_label_.reserve(size);
+  }
+  inline void resize(const size_t size) {
+    x_.resize(size, 0);
+    y_.resize(size, 0);
+    z_.resize(size, 0);
+    intensity_.resize(size, 0);
+    points_timestamp_.resize(size, 0.0);
+    points_height_.resize(size, std::numeric_limits<float>::max());
+    points_beam_id_.resize(size, -1);
+    points_label_.resize(size, 0);
+  }
+  inline void clear() {
+    x_.clear();
+    y_.clear();
+    z_.clear();
+    intensity_.clear();
+    points_timestamp_.clear();
+    points_height_.clear();
+    points_beam_id_.clear();
+    points_label_.clear();
+  }
+  inline void push_back(const T x, const T y, const T z, const T intensity,
+                        const double timestamp = 0.0,
+                        const float height = std::numeric_limits<float>::max(),
+                        const int32_t beam_id = -1, const uint8_t label = 0) {
+    x_.push_back(x);
+    y_.push_back(y);
+    z_.push_back(z);
+    intensity_.push_back(intensity);
+    points_timestamp_.push_back(timestamp);
+    points_height_.push_back(height);
+    points_beam_id_.push_back(beam_id);
+    points_label_.push_back(label);
+  }
+  inline void push_back(const PointType& point, const double timestamp = 0.0,
+                        const float height = std::numeric_limits<float>::max(),
+                        const int32_t beam_id = -1, const uint8_t label = 0) {
+    push_back(point.x, point.y, point.z, point.intensity, timestamp, height,
+              beam_id, label);
+  }
+
+  // @brief gather the point of the given index into a struct
+  inline PointType point(const size_t n) const {
+    PointType point;
+    point.x = x_[n];
+    point.y = y_[n];
+    point.z = z_[n];
+    point.intensity = intensity_[n];
+    return point;
+  }
+
+  // @brief field views
+  PointFieldView<const T> x() const { return {x_.data(), x_.size()}; }
+  PointFieldView<T> mutable_x() { return {x_.data(), x_.size()}; }
+  PointFieldView<const T> y() const { return {y_.data(), y_.size()}; }
+  PointFieldView<T> mutable_y() { return {y_.data(), y_.size()}; }
+  PointFieldView<const T> z() const { return {z_.data(), z_.size()}; }
+  PointFieldView<T> mutable_z() { return {z_.data(), z_.size()}; }
+  PointFieldView<const T> intensity() const {
+    return {intensity_.data(), intensity_.size()};
+  }
+  PointFieldView<T> mutable_intensity() {
+    return {intensity_.data(), intensity_.size()};
+  }
+  PointFieldView<const double> points_timestamp() const {
+    return {points_timestamp_.data(), points_timestamp_.size()};
+  }
+  PointFieldView<double> mutable_points_timestamp() {
+    return {points_timestamp_.data(), points_timestamp_.size()};
+  }
+  PointFieldView<const float> points_height() const {
+    return {points_height_.data(), points_height_.size()};
+  }
+  PointFieldView<float> mutable_points_height() {
+    return {points_height_.data(), points_height_.size()};
+  }
+  PointFieldView<const int32_t> points_beam_id() const {
+    return {points_beam_id_.data(), points_beam_id_.size()};
+  }
+  PointFieldView<int32_t> mutable_points_beam_id() {
+    return {points_beam_id_.data(), points_beam_id_.size()};
+  }
+  PointFieldView<const uint8_t> points_label() const {
+    return {points_label_.data(), points_label_.size()};
+  }
+  PointFieldView<uint8_t> mutable_points_label() {
+    return {points_label_.data(), points_label_.size()};
+  }
+
+  // @brief copy from an array of structs point cloud
+  void CopyFrom(const AttributePointCloud<PointType>& pc) {
+    const size_t size = pc.size();
+    resize(size);
+    for (size_t i = 0; i < size; ++i) {
+      const PointType& point = pc[i];
+      x_[i] = point.x;
+      y_[i] = point.y;
+      z_[i] = point.z;
+      intensity_[i] = point.intensity;
+    }
+    // the attributes are already stored per field
+    if (pc.CheckConsistency()) {
+      std::copy(pc.points_timestamp().begin(), pc.points_timestamp().end(),
+                points_timestamp_.begin());
+      std::copy(pc.points_height().begin(), pc.points_height().end(),
+                points_height_.begin());
+      std::copy(pc.points_beam_id().begin(), pc.points_beam_id().end(),
+                points_beam_id_.begin());
+      std::copy(pc.points_label().begin(), pc.points_label().end(),
+                points_label_.begin());
+    }
+  }
+  // @brief copy to an array of structs point cloud
+  void CopyTo(AttributePointCloud<PointType>* pc) const {
+    const size_t size = this->size();
+    pc->resize(size);
+    for (size_t i = 0; i < size; ++i) {
+      PointType& point = pc->at(i);
+      point.x = x_[i];
+      point.y = y_[i];
+      point.z = z_[i];
+      point.intensity = intensity_[i];
+    }
+    pc->mutable_points_timestamp()->assign(points_timestamp_.begin(),
+                                           points_timestamp_.end());
+    pc->mutable_points_height()->assign(points_height_.begin(),
+                                        points_height_.end());
+    pc->mutable_points_beam_id()->assign(points_beam_id_.begin(),
+                                         points_beam_id_.end());
+    pc->mutable_points_label()->assign(points_label_.begin(),
+                                       points_label_.end());
+  }
+
+  // @brief copy the points of the given indices from another cloud
+  template <typename IndexType>
+  void CopyPointCloud(const SoaPointCloud<T>& rhs,
+                      const std::vector<IndexType>& indices) {
+    resize(indices.size());
+    Gather(rhs.x_, indices, &x_);
+    Gather(rhs.y_, indices, &y_);
+    Gather(rhs.z_, indices, &z_);
+    Gather(rhs.intensity_, indices, &intensity_);
+    Gather(rhs.points_timestamp_, indices, &points_timestamp_);
+    Gather(rhs.points_height_, indices, &points_height_);
+    Gather(rhs.points_beam_id_, indices, &points_beam_id_);
+    Gather(rhs.points_label_, indices, &points_label_);
+  }
+
+  // @brief swap point cloud
+  void SwapPointCloud(SoaPointCloud<T>* rhs) {
+    x_.swap(rhs->x_);
+    y_.swap(rhs->y_);
+    z_.swap(rhs->z_);
+    intensity_.swap(rhs->intensity_);
+    points_timestamp_.swap(rhs->points_timestamp_);
+    points_height_.swap(rhs->points_height_);
+    points_beam_id_.swap(rhs->points_beam_id_);
+    points_label_.swap(rhs->points_label_);
+    std::swap(timestamp_, rhs->timestamp_);
+  }
+
+  // @brief check data member consistency
+  bool CheckConsistency() const {
+    const size_t size = x_.size();
+    return y_.size() == size && z_.size() == size &&
+           intensity_.size() == size && points_timestamp_.size() == size &&
+           points_height_.size() == size && points_beam_id_.size() == size &&
+           points_label_.size() == size;
+  }
+
+  // @brief cloud timestamp setter
+  void set_timestamp(const double timestamp) { timestamp_ = timestamp; }
+  // @brief cloud timestamp getter
+  double get_timestamp() const { return timestamp_; }
+
+ private:
+  template <typename FieldT, typename IndexType>
+  static void Gather(const CacheAlignedVector<FieldT>& source,
+                     const std::vector<IndexType>& indices,
+                     CacheAlignedVector<FieldT>* target) {
+    for (size_t i = 0; i < indices.size(); ++i) {
+      (*target)[i] = source[indices[i]];
+    }
+  }
+
+ private:
+  CacheAlignedVector<T> x_;
+  CacheAlignedVector<T> y_;
+  CacheAlignedVector<T> z_;
+  CacheAlignedVector<T> intensity_;
+  CacheAlignedVector<double> points_timestamp_;
+  CacheAlignedVector<float> points_height_;
+  CacheAlignedVector<int32_t> points_beam_id_;
+  CacheAlignedVector<uint8_t> points_label_;
+
+  double timestamp_ = 0.0;
+};
+
+typedef SoaPointCloud<float> SoaPointFCloud;
+typedef SoaPointCloud<double> SoaPointDCloud;
+
+typedef std::shared_ptr<SoaPointFCloud> SoaPointFCloudPtr;
+typedef std::shared_ptr<const SoaPointFCloud> SoaPointFCloudConstPtr;
+
+}  // namespace base
+}  // namespace perception
+}  // namespace apollo
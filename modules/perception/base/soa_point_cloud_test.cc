@@ -0,0 +1,121 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/perception/base/soa_point_cloud.h"
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace perception {
+namespace base {
+
+TEST(SoaPointCloudTest, push_back_test) {
+  SoaPointFCloud cloud;
+  EXPECT_TRUE(cloud.empty());
+  PointF point;
+  point.x = 1.f;
+  point.y = 2.f;
+  point.z = 3.f;
+  point.intensity = 4.f;
+  cloud.push_back(point, 0.5, 0.2f, 7, 1);
+  cloud.push_back(5.f, 6.f, 7.f, 8.f);
+  EXPECT_EQ(cloud.size(), 2);
+  EXPECT_TRUE(cloud.CheckConsistency());
+  EXPECT_EQ(cloud.x()[0], 1.f);
+  EXPECT_EQ(cloud.y()[1], 6.f);
+  EXPECT_EQ(cloud.z()[0], 3.f);
+  EXPECT_EQ(cloud.intensity()[1], 8.f);
+  EXPECT_EQ(cloud.points_timestamp()[0], 0.5);
+  EXPECT_EQ(cloud.points_height()[0], 0.2f);
+  EXPECT_EQ(cloud.points_height()[1], std::numeric_limits<float>::max());
+  EXPECT_EQ(cloud.points_beam_id()[0], 7);
+  EXPECT_EQ(cloud.points_beam_id()[1], -1);
+  EXPECT_EQ(cloud.points_label()[0], 1);
+  EXPECT_EQ(cloud.point(1).z, 7.f);
+
+  for (auto& z : cloud.mutable_z()) {
+    z += 1.f;
+  }
+  EXPECT_EQ(cloud.z()[0], 4.f);
+  EXPECT_EQ(cloud.z()[1], 8.f);
+
+  cloud.clear();
+  EXPECT_TRUE(cloud.empty());
+  EXPECT_TRUE(cloud.CheckConsistency());
+}
+
+TEST(SoaPointCloudTest, alignment_test) {
+  SoaPointDCloud cloud;
+  cloud.resize(3);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(cloud.x().data()) % 64, 0);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(cloud.intensity().data()) % 64, 0);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(cloud.points_label().data()) % 64, 0);
+}
+
+TEST(SoaPointCloudTest, conversion_test) {
+  PointFCloud aos_cloud;
+  for (int i = 0; i < 10; ++i) {
+    PointF point;
+    point.x = static_cast<float>(i);
+    point.y = static_cast<float>(i * 2);
+    point.z = static_cast<float>(i * 3);
+    point.intensity = static_cast<float>(i * 4);
+    aos_cloud.push_back(point, i * 0.1, static_cast<float>(i) * 0.5f, i,
+                        static_cast<uint8_t>(i % 3));
+  }
+  SoaPointFCloud cloud(aos_cloud);
+  ASSERT_EQ(cloud.size(), aos_cloud.size());
+  for (size_t i = 0; i < cloud.size(); ++i) {
+    EXPECT_EQ(cloud.x()[i], aos_cloud[i].x);
+    EXPECT_EQ(cloud.intensity()[i], aos_cloud[i].intensity);
+    EXPECT_EQ(cloud.points_timestamp()[i], aos_cloud.points_timestamp(i));
+    EXPECT_EQ(cloud.points_height()[i], aos_cloud.points_height(i));
+    EXPECT_EQ(cloud.points_beam_id()[i], aos_cloud.points_beam_id(i));
+    EXPECT_EQ(cloud.points_label()[i], aos_cloud.points_label(i));
+  }
+
+  std::vector<int> indices = {1, 3, 5};
+  SoaPointFCloud sub_cloud;
+  sub_cloud.CopyPointCloud(cloud, indices);
+  ASSERT_EQ(sub_cloud.size(), 3);
+  EXPECT_EQ(sub_cloud.y()[1], 6.f);
+  EXPECT_EQ(sub_cloud.points_beam_id()[2], 5);
+
+  PointFCloud back_cloud;
+  sub_cloud.CopyTo(&back_cloud);
+  EXPECT_TRUE(back_cloud.CheckConsistency());
+  ASSERT_EQ(back_cloud.size(), 3);
+  EXPECT_EQ(back_cloud.width(), 3);
+  EXPECT_EQ(back_cloud.height(), 1);
+  EXPECT_EQ(back_cloud[2].z, 15.f);
+  EXPECT_EQ(back_cloud.points_timestamp(0), 0.1);
+  EXPECT_EQ(back_cloud.points_label(2), 2);
+}
+
+TEST(SoaPointCloudTest, swap_test) {
+  SoaPointFCloud cloud1;
+  SoaPointFCloud cloud2;
+  cloud1.push_back(1.f, 1.f, 1.f, 1.f);
+  cloud1.set_timestamp(1.0);
+  cloud1.SwapPointCloud(&cloud2);
+  EXPECT_TRUE(cloud1.empty());
+  EXPECT_EQ(cloud2.size(), 1);
+  EXPECT_EQ(cloud2.get_timestamp(), 1.0);
+}
+
+}  // namespace base
+}  // namespace perception
+}  // namespace apollo
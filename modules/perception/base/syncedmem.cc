@@ -106,11 +106,26 @@ SyncedMemory::~SyncedMemory() {
 
 #if USE_GPU == 1
   if (gpu_ptr_ && own_gpu_data_) {
-    BASE_CUDA_CHECK(cudaFree(gpu_ptr_));
+    free_gpu();
   }
 #endif  // USE_GPU
 }
 
+#if USE_GPU == 1
+void SyncedMemory::malloc_gpu(const void* stream) {
+  gpu_allocator_ = DeviceCachingAllocator();
+  gpu_ptr_ = gpu_allocator_->Allocate(size_, stream);
+  ACHECK(gpu_ptr_) << "device allocation of size " << size_ << " failed";
+  own_gpu_data_ = true;
+}
+
+void SyncedMemory::free_gpu() {
+  gpu_allocator_->Free(gpu_ptr_);
+  gpu_ptr_ = nullptr;
+  own_gpu_data_ = false;
+}
+#endif
+
 inline void SyncedMemory::to_cpu() {
   check_device();
   switch (head_) {
@@ -147,15 +162,13 @@ inline void SyncedMemory::to_gpu() {
 #if USE_GPU == 1
   switch (head_) {
     case UNINITIALIZED:
-      BASE_CUDA_CHECK(cudaMalloc(&gpu_ptr_, size_));
+      malloc_gpu(nullptr);
       BASE_CUDA_CHECK(cudaMemset(gpu_ptr_, 0, size_));
       head_ = HEAD_AT_GPU;
-      own_gpu_data_ = true;
       break;
     case HEAD_AT_CPU:
       if (gpu_ptr_ == nullptr) {
-        BASE_CUDA_CHECK(cudaMalloc(&gpu_ptr_, size_));
-        own_gpu_data_ = true;
+        malloc_gpu(nullptr);
       }
       BASE_CUDA_CHECK(cudaMemcpy(gpu_ptr_, cpu_ptr_, size_, cudaMemcpyDefault));
       head_ = SYNCED;
@@ -202,7 +215,7 @@ void SyncedMemory::set_gpu_data(void* data) {
 #if USE_GPU == 1
   ACHECK(data);
   if (own_gpu_data_) {
-    BASE_CUDA_CHECK(cudaFree(gpu_ptr_));
+    free_gpu();
   }
   gpu_ptr_ = data;
   head_ = HEAD_AT_GPU;
@@ -236,8 +249,7 @@ void SyncedMemory::async_gpu_push(const cudaStream_t& stream) {
   check_device();
   CHECK_EQ(head_, HEAD_AT_CPU);
   if (gpu_ptr_ == nullptr) {
-    BASE_CUDA_CHECK(cudaMalloc(&gpu_ptr_, size_));
-    own_gpu_data_ = true;
+    malloc_gpu(stream);
   }
   const cudaMemcpyKind put = cudaMemcpyHostToDevice;
   BASE_CUDA_CHECK(cudaMemcpyAsync(gpu_ptr_, cpu_ptr_, size_, put, stream));
@@ -63,6 +63,7 @@ license and copyright terms herein.
 #pragma once
 
 #include "cyber/common/log.h"
+#include "modules/perception/base/caching_allocator.h"
 #include "modules/perception/base/common.h"
 
 namespace apollo {
@@ -72,7 +73,8 @@ namespace base {
 inline void PerceptionMallocHost(void** ptr, size_t size, bool use_cuda) {
 #if USE_GPU == 1
   if (use_cuda) {
-    BASE_CUDA_CHECK(cudaMallocHost(ptr, size));
+    *ptr = PinnedHostCachingAllocator()->Allocate(size);
+    ACHECK(*ptr) << "pinned host allocation of size " << size << " failed";
     return;
   }
 #endif
@@ -83,7 +85,7 @@ inline void PerceptionMallocHost(void** ptr, size_t size, bool use_cuda) {
 inline void PerceptionFreeHost(void* ptr, bool use_cuda) {
 #if USE_GPU == 1
   if (use_cuda) {
-    BASE_CUDA_CHECK(cudaFreeHost(ptr));
+    PinnedHostCachingAllocator()->Free(ptr);
     return;
   }
 #endif
@@ -127,6 +129,10 @@ class SyncedMemory {
   void check_device();
   void to_cpu();
   void to_gpu();
+#if USE_GPU == 1
+  void malloc_gpu(const void* stream);
+  void free_gpu();
+#endif
 
  private:
   void* cpu_ptr_;
@@ -137,6 +143,11 @@ class SyncedMemory {
   bool cpu_malloc_use_cuda_;
   bool own_gpu_data_;
   int device_;
+#if USE_GPU == 1
+  // the device blocks are returned to, which is the current device at the
+  // time of allocation
+  CachingAllocator* gpu_allocator_ = nullptr;
+#endif
 };  // class SyncedMemory
 
 }  // namespace base
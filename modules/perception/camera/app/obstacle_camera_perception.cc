@@ -16,6 +16,7 @@
 #include "modules/perception/camera/app/obstacle_camera_perception.h"
 
 #include <utility>
+#include <vector>
 
 #include "absl/strings/str_cat.h"
 #include "cyber/common/file.h"
@@ -52,7 +53,9 @@ bool ObstacleCameraPerception::Init(
   ACHECK(perception_param_.detector_param_size() > 0)
       << "Failed to init detector.";
   // Init detector
+  batch_detection_ = options.batch_detection;
   base::BaseCameraModelPtr model;
+  std::shared_ptr<BaseObstacleDetector> batch_detector;
   for (int i = 0; i < perception_param_.detector_param_size(); ++i) {
     ObstacleDetectorInitOptions detector_init_options;
     app::DetectorParam detector_param = perception_param_.detector_param(i);
@@ -68,6 +71,17 @@ bool ObstacleCameraPerception::Init(
     name_intrinsic_map_.insert(std::pair<std::string, Eigen::Matrix3f>(
         detector_param.camera_name(), pinhole->get_intrinsic_params()));
     detector_init_options.base_camera_model = model;
+    if (batch_detector != nullptr) {
+      // all cameras share the detector initialized for the first one
+      name_detector_map_.insert(
+          std::pair<std::string, std::shared_ptr<BaseObstacleDetector>>(
+              detector_param.camera_name(), batch_detector));
+      continue;
+    }
+    if (batch_detection_) {
+      detector_init_options.max_batch_size =
+          perception_param_.detector_param_size();
+    }
     std::shared_ptr<BaseObstacleDetector> detector_ptr(
         BaseObstacleDetectorRegisterer::GetInstanceByName(plugin_param.name()));
     name_detector_map_.insert(
@@ -77,6 +91,9 @@ bool ObstacleCameraPerception::Init(
     ACHECK(name_detector_map_.at(detector_param.camera_name())
                ->Init(detector_init_options))
         << "Failed to init: " << plugin_param.name();
+    if (batch_detection_) {
+      batch_detector = detector_ptr;
+    }
   }
 
   // Init tracker
@@ -308,6 +325,46 @@ bool ObstacleCameraPerception::GetCalibrationService(
 
 bool ObstacleCameraPerception::Perception(
     const CameraPerceptionOptions &options, CameraFrame *frame) {
+  return ProcessFrame(options, false, frame);
+}
+
+bool ObstacleCameraPerception::BatchPerception(
+    const CameraPerceptionOptions &options,
+    const std::vector<CameraFrame *> &frames) {
+  if (frames.empty()) {
+    return true;
+  }
+  if (!batch_detection_) {
+    for (auto *frame : frames) {
+      if (!ProcessFrame(options, false, frame)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  PERF_BLOCK_START();
+  inference::CudaUtil::set_device_id(perception_param_.gpu_id());
+  ObstacleDetectorOptions detector_options;
+  std::shared_ptr<BaseObstacleDetector> detector =
+      name_detector_map_.at(frames[0]->data_provider->sensor_name());
+  if (!detector->BatchDetect(detector_options, frames)) {
+    AERROR << "Failed to batch detect.";
+    return false;
+  }
+  PERF_BLOCK_END("batch_detect");
+
+  // tracking stays sequential, frames are processed in the given order
+  for (auto *frame : frames) {
+    if (!ProcessFrame(options, true, frame)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ObstacleCameraPerception::ProcessFrame(
+    const CameraPerceptionOptions &options, bool detected, CameraFrame *frame) {
   PERF_FUNCTION();
   inference::CudaUtil::set_device_id(perception_param_.gpu_id());
   ObstacleDetectorOptions detector_options;
@@ -370,14 +427,17 @@ bool ObstacleCameraPerception::Perception(
   }
   PERF_BLOCK_END_WITH_INDICATOR(frame->data_provider->sensor_name(), "Predict");
 
-  std::shared_ptr<BaseObstacleDetector> detector =
-      name_detector_map_.at(frame->data_provider->sensor_name());
+  if (!detected) {
+    std::shared_ptr<BaseObstacleDetector> detector =
+        name_detector_map_.at(frame->data_provider->sensor_name());
 
-  if (!detector->Detect(detector_options, frame)) {
-    AERROR << "Failed to detect.";
-    return false;
+    if (!detector->Detect(detector_options, frame)) {
+      AERROR << "Failed to detect.";
+      return false;
+    }
+    PERF_BLOCK_END_WITH_INDICATOR(frame->data_provider->sensor_name(),
+                                  "detect");
   }
-  PERF_BLOCK_END_WITH_INDICATOR(frame->data_provider->sensor_name(), "detect");
 
   // Save all detections results as kitti format
   WriteDetections(
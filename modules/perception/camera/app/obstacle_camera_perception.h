@@ -19,6 +19,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "modules/perception/camera/app/proto/perception.pb.h"
 #include "modules/perception/camera/common/camera_frame.h"
@@ -67,9 +68,16 @@ class ObstacleCameraPerception : public BaseCameraPerception {
   bool GetCalibrationService(BaseCalibrationService **calibration_service);
   bool Perception(const CameraPerceptionOptions &options,
                   CameraFrame *frame) override;
+  // @brief detect obstacles of time synchronized frames of all cameras in one
+  //        batch when batch_detection is set, then track them frame by frame
+  bool BatchPerception(const CameraPerceptionOptions &options,
+                       const std::vector<CameraFrame *> &frames);
   std::string Name() const override { return "ObstacleCameraPerception"; }
 
  private:
+  bool ProcessFrame(const CameraPerceptionOptions &options, bool detected,
+                    CameraFrame *frame);
+
   std::map<std::string, Eigen::Matrix3f> name_intrinsic_map_;
   std::map<std::string, std::shared_ptr<BaseObstacleDetector>>
       name_detector_map_;
@@ -88,6 +96,7 @@ class ObstacleCameraPerception : public BaseCameraPerception {
   bool write_out_calib_file_ = false;
   std::string out_lane_dir_;
   std::string out_calib_dir_;
+  bool batch_detection_ = false;
 
  protected:
   ObjectTemplateManager *object_template_manager_ = nullptr;
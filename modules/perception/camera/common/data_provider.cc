@@ -25,6 +25,45 @@ namespace apollo {
 namespace perception {
 namespace camera {
 
+#if USE_GPU == 1
+namespace {
+
+// @brief upload the compact yuv frame and convert it to rgb on the device,
+//        which copies 2 (yuyv) or 1.5 (nv12) bytes per pixel instead of 3
+bool DecodeYuvImage(const uint8_t *data, const std::string &encoding,
+                    base::Blob<uint8_t> *yuv, base::Image8U *rgb) {
+  const int rows = rgb->rows();
+  const int cols = rgb->cols();
+  NppiSize roi;
+  roi.height = rows;
+  roi.width = cols;
+  NppStatus status = NPP_SUCCESS;
+  if (encoding == "yuyv") {
+    yuv->Reshape({rows, cols, 2});
+    cudaMemcpy(yuv->mutable_gpu_data(), data, yuv->count() * sizeof(data[0]),
+               cudaMemcpyDefault);
+    status = nppiYUV422ToRGB_8u_C2C3R(yuv->gpu_data(), cols * 2,
+                                      rgb->mutable_gpu_data(),
+                                      rgb->width_step(), roi);
+  } else {
+    // full size luma plane followed by the interleaved chroma plane
+    yuv->Reshape({rows * 3 / 2, cols});
+    cudaMemcpy(yuv->mutable_gpu_data(), data, yuv->count() * sizeof(data[0]),
+               cudaMemcpyDefault);
+    const Npp8u *planes[2] = {yuv->gpu_data(), yuv->gpu_data() + rows * cols};
+    status = nppiNV12ToRGB_8u_P2C3R(planes, cols, rgb->mutable_gpu_data(),
+                                    rgb->width_step(), roi);
+  }
+  if (status != NPP_SUCCESS) {
+    AERROR << "Failed to decode " << encoding << " image: " << status;
+    return false;
+  }
+  return true;
+}
+
+}  // namespace
+#endif
+
 bool DataProvider::Init(const DataProvider::InitOptions &options) {
   src_height_ = options.image_height;
   src_width_ = options.image_width;
@@ -183,6 +222,15 @@ bool DataProvider::FillImageData(int rows, int cols, const uint8_t *data,
       success = true;
     }
     gray_ready_ = true;
+  } else if (encoding == "yuyv" || encoding == "nv12") {
+    if (handler_ != nullptr) {
+      success =
+          DecodeYuvImage(data, encoding, &temp_uint8_, ori_rgb_.get()) &&
+          handler_->Handle(*ori_rgb_, rgb_.get());
+    } else {
+      success = DecodeYuvImage(data, encoding, &temp_uint8_, rgb_.get());
+    }
+    rgb_ready_ = true;
   } else {
     AERROR << "Unrecognized image encoding: " << encoding;
   }
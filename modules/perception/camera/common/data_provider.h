@@ -83,6 +83,8 @@ class DataProvider {
   // @param [in]: options
   // @param [in/out]: blob
   // image blob with specified size should be filled, required.
+  // encoding: rgb8, bgr8, gray (or y), and in GPU mode yuyv and nv12, which
+  // are converted to rgb on the device.
   bool FillImageData(int rows, int cols, const uint8_t *data,
                      const std::string &encoding);
 
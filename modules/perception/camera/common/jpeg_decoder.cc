@@ -0,0 +1,108 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#include "modules/perception/camera/common/jpeg_decoder.h"
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace perception {
+namespace camera {
+
+bool JpegDecoder::Init(int device) {
+  Release();
+  device_ = device;
+  if (cudaSetDevice(device_) != cudaSuccess) {
+    AERROR << "Failed to set device to: " << device_;
+    return false;
+  }
+  if (nvjpegCreateSimple(&handle_) != NVJPEG_STATUS_SUCCESS ||
+      nvjpegJpegStateCreate(handle_, &state_) != NVJPEG_STATUS_SUCCESS) {
+    AERROR << "Failed to create nvjpeg decoder.";
+    Release();
+    return false;
+  }
+  if (cudaStreamCreate(&stream_) != cudaSuccess) {
+    AERROR << "Failed to create cuda stream.";
+    Release();
+    return false;
+  }
+  inited_ = true;
+  return true;
+}
+
+bool JpegDecoder::Decode(const uint8_t *data, size_t size,
+                         base::Image8U *image) {
+  if (!inited_ || data == nullptr || image == nullptr) {
+    return false;
+  }
+  if (cudaSetDevice(device_) != cudaSuccess) {
+    AERROR << "Failed to set device to: " << device_;
+    return false;
+  }
+  int num_components = 0;
+  nvjpegChromaSubsampling_t subsampling;
+  int widths[NVJPEG_MAX_COMPONENT];
+  int heights[NVJPEG_MAX_COMPONENT];
+  if (nvjpegGetImageInfo(handle_, data, size, &num_components, &subsampling,
+                         widths, heights) != NVJPEG_STATUS_SUCCESS) {
+    AERROR << "Invalid jpeg image.";
+    return false;
+  }
+  if (rgb_ == nullptr || rgb_->rows() != heights[0] ||
+      rgb_->cols() != widths[0]) {
+    rgb_.reset(new base::Image8U(heights[0], widths[0], base::Color::RGB));
+  }
+
+  // interleaved rgb into the single plane of the image
+  nvjpegImage_t output;
+  output.channel[0] = rgb_->mutable_gpu_data();
+  output.pitch[0] = rgb_->width_step();
+  for (int i = 1; i < NVJPEG_MAX_COMPONENT; ++i) {
+    output.channel[i] = nullptr;
+    output.pitch[i] = 0;
+  }
+  if (nvjpegDecode(handle_, state_, data, size, NVJPEG_OUTPUT_RGBI, &output,
+                   stream_) != NVJPEG_STATUS_SUCCESS) {
+    AERROR << "Failed to decode jpeg image.";
+    return false;
+  }
+  if (cudaStreamSynchronize(stream_) != cudaSuccess) {
+    AERROR << "Failed to synchronize the decoding stream.";
+    return false;
+  }
+  *image = *rgb_;
+  return true;
+}
+
+void JpegDecoder::Release() {
+  if (state_ != nullptr) {
+    nvjpegJpegStateDestroy(state_);
+    state_ = nullptr;
+  }
+  if (handle_ != nullptr) {
+    nvjpegDestroy(handle_);
+    handle_ = nullptr;
+  }
+  if (stream_ != nullptr) {
+    cudaStreamDestroy(stream_);
+    stream_ = nullptr;
+  }
+  inited_ = false;
+}
+
+}  // namespace camera
+}  // namespace perception
+}  // namespace apollo
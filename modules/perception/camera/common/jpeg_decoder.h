@@ -0,0 +1,60 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#pragma once
+
+#include <nvjpeg.h>
+
+#include <memory>
+
+#include "modules/perception/base/image.h"
+
+namespace apollo {
+namespace perception {
+namespace camera {
+
+/**
+ * @brief Decodes jpeg images with nvjpeg on the GPU into a device resident
+ *        RGB image, which DataProvider::FillImageData takes as rgb8 data
+ *        with a device to device copy, so the CPU never touches the pixels.
+ */
+class JpegDecoder {
+ public:
+  JpegDecoder() = default;
+  ~JpegDecoder() { Release(); }
+
+  JpegDecoder(const JpegDecoder &) = delete;
+  JpegDecoder &operator=(const JpegDecoder &) = delete;
+
+  bool Init(int device);
+  // @brief: decode a jpeg image, the result stays valid until the next call
+  // @param [in]: data, size - compressed image in host memory
+  // @param [out]: image - RGB image in device memory
+  bool Decode(const uint8_t *data, size_t size, base::Image8U *image);
+  void Release();
+
+ private:
+  nvjpegHandle_t handle_ = nullptr;
+  nvjpegJpegState_t state_ = nullptr;
+  cudaStream_t stream_ = nullptr;
+  // reused while the size of the images stays the same
+  std::shared_ptr<base::Image8U> rgb_;
+  int device_ = 0;
+  bool inited_ = false;
+};
+
+}  // namespace camera
+}  // namespace perception
+}  // namespace apollo
@@ -29,6 +29,8 @@ struct CameraPerceptionInitOptions : public BaseInitOptions {
   // TODO(Xun): modified to be configurable
   std::string lane_calibration_working_sensor_name = "front_6mm";
   std::string calibrator_method = "LaneLineCalibrator";
+  // share one detector between cameras and detect their frames in one batch
+  bool batch_detection = false;
 };
 
 struct CameraPerceptionOptions {};
@@ -42,6 +42,8 @@ struct FeatureExtractorInitOptions : public BaseInitOptions {
 
 struct FeatureExtractorOptions {
   bool normalized = true;
+  // index of the frame in a batched feature blob
+  int batch_index = 0;
 };
 class BaseFeatureExtractor {
  public:
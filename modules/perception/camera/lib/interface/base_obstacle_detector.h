@@ -17,6 +17,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "modules/perception/base/camera.h"
 #include "modules/perception/camera/common/camera_frame.h"
@@ -30,6 +31,8 @@ namespace camera {
 struct ObstacleDetectorInitOptions : public BaseInitOptions {
   std::shared_ptr<base::BaseCameraModel> base_camera_model = nullptr;
   Eigen::Matrix3f intrinsics;
+  // number of camera frames detected by one network forward
+  int max_batch_size = 1;
 
   EIGEN_MAKE_ALIGNED_OPERATOR_NEW
 } EIGEN_ALIGN16;
@@ -53,6 +56,21 @@ class BaseObstacleDetector {
   virtual bool Detect(const ObstacleDetectorOptions &options,
                       CameraFrame *frame) = 0;
 
+  // @brief: detect obstacle from images of several cameras.
+  // @param [in]: options
+  // @param [in/out]: frames
+  // detectors supporting batched inference detect all frames at once,
+  // the others one by one.
+  virtual bool BatchDetect(const ObstacleDetectorOptions &options,
+                           const std::vector<CameraFrame *> &frames) {
+    for (auto frame : frames) {
+      if (!Detect(options, frame)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
   virtual std::string Name() const = 0;
 
   BaseObstacleDetector(const BaseObstacleDetector &) = delete;
@@ -0,0 +1,118 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#include "modules/perception/camera/lib/lane/common/lane_map_ops.h"
+
+#include <cmath>
+#include <cstring>
+
+#include "modules/perception/camera/common/math_functions.h"
+
+namespace apollo {
+namespace perception {
+namespace camera {
+
+namespace {
+
+// @brief: inner edge of the lane line of value, 0 if it is not one.
+//         Values 1 to 4 and 11 are lines on the left, whose inner edge is
+//         the right one, the others are lines on the right.
+inline int LaneEdgeValue(int value, int left, int right, int lane_type_num) {
+  if ((value > 0 && value < 5) || value == 11) {
+    return value != right ? value : 0;
+  }
+  if (value >= 5 && value < lane_type_num) {
+    return value != left ? value : 0;
+  }
+  return 0;
+}
+
+}  // namespace
+
+void MarkLaneEdges(const float *lane_map, int width, const int *rows,
+                   int row_begin, int row_end, int lane_type_num,
+                   unsigned char *edges) {
+  for (int r = row_begin; r < row_end; ++r) {
+    const float *row = lane_map + rows[r] * width;
+    unsigned char *row_edges = edges + r * width;
+    memset(row_edges, 0, width);
+    for (int x = 1; x < width - 1; ++x) {
+      row_edges[x] = static_cast<unsigned char>(LaneEdgeValue(
+          static_cast<int>(std::round(row[x])),
+          static_cast<int>(std::round(row[x - 1])),
+          static_cast<int>(std::round(row[x + 1])), lane_type_num));
+    }
+  }
+}
+
+void CalDenselineLaneMap(const float *output_data, int width, int height,
+                         int row_begin, int row_end, float score_thresh,
+                         unsigned char *lane_map, float *lane_output) {
+  int out_dim = width * height;
+  for (int y = row_begin; y < row_end; y++) {
+    float score_channel[4];
+    int row_start = y * width;
+    int channel0_pos = row_start;
+    int channel1_pos = out_dim + row_start;
+    int channel2_pos = 2 * out_dim + row_start;
+    int channel3_pos = 3 * out_dim + row_start;
+    int channel5_pos = 5 * out_dim + row_start;
+    int channel6_pos = 6 * out_dim + row_start;
+
+    for (int x = 0; x < width; ++x) {
+      score_channel[0] = output_data[channel0_pos + x];
+      score_channel[1] = output_data[channel1_pos + x];
+      score_channel[2] = output_data[channel2_pos + x];
+      score_channel[3] = output_data[channel3_pos + x];
+      // Utilize softmax to get the probability
+      float sum_score = 0.0f;
+      for (int i = 0; i < 4; i++) {
+        score_channel[i] = static_cast<float>(exp(score_channel[i]));
+        sum_score += score_channel[i];
+      }
+      for (int i = 0; i < 4; i++) {
+        score_channel[i] /= sum_score;
+      }
+      // 1: ego-lane; 2: adj-left lane; 3: adj-right lane
+      //  find the score with max lane map
+      int max_channel_idx = 0;
+      float max_score = score_channel[0];
+      for (int channel_idx = 1; channel_idx < 4; channel_idx++) {
+        if (max_score < score_channel[channel_idx]) {
+          max_score = score_channel[channel_idx];
+          max_channel_idx = channel_idx;
+        }
+      }
+      //  if the channel 0 has the maximum probability
+      //  or the score is less than the setting value
+      //  omit it
+      if (max_channel_idx == 0 || max_score < score_thresh) {
+        continue;
+      }
+      int pixel_pos = row_start + x;
+      lane_map[pixel_pos] = 1;
+
+      float dist_left = sigmoid(output_data[channel5_pos + x]);
+      float dist_right = sigmoid(output_data[channel6_pos + x]);
+      lane_output[pixel_pos] = dist_left;
+      lane_output[out_dim + pixel_pos] = dist_right;
+      lane_output[out_dim * 2 + pixel_pos] = max_score;
+    }
+  }
+}
+
+}  // namespace camera
+}  // namespace perception
+}  // namespace apollo
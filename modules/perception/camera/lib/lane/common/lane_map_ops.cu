@@ -0,0 +1,135 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#include "modules/perception/camera/lib/lane/common/lane_map_ops.h"
+
+#include "modules/perception/base/common.h"
+
+namespace apollo {
+namespace perception {
+namespace camera {
+
+namespace {
+
+constexpr int kThreadsPerBlock = 256;
+
+// the same as LaneEdgeValue of lane_map_ops.cc
+__device__ int lane_edge_value(int value, int left, int right,
+                               int lane_type_num) {
+  if ((value > 0 && value < 5) || value == 11) {
+    return value != right ? value : 0;
+  }
+  if (value >= 5 && value < lane_type_num) {
+    return value != left ? value : 0;
+  }
+  return 0;
+}
+
+__global__ void mark_lane_edges_kernel(const float *lane_map, int width,
+                                       const int *rows, int num_rows,
+                                       int lane_type_num,
+                                       unsigned char *edges) {
+  int index = blockIdx.x * blockDim.x + threadIdx.x;
+  if (index >= num_rows * width) {
+    return;
+  }
+  int r = index / width;
+  int x = index % width;
+  if (x == 0 || x == width - 1) {
+    edges[index] = 0;
+    return;
+  }
+  const float *row = lane_map + rows[r] * width;
+  edges[index] = static_cast<unsigned char>(lane_edge_value(
+      static_cast<int>(roundf(row[x])), static_cast<int>(roundf(row[x - 1])),
+      static_cast<int>(roundf(row[x + 1])), lane_type_num));
+}
+
+__global__ void cal_denseline_lane_map_kernel(
+    const float *output_data, int width, int height, int valid_height,
+    float score_thresh, unsigned char *lane_map, float *lane_output) {
+  int out_dim = width * height;
+  int pixel_pos = blockIdx.x * blockDim.x + threadIdx.x;
+  if (pixel_pos >= out_dim) {
+    return;
+  }
+  lane_map[pixel_pos] = 0;
+  lane_output[pixel_pos] = 0.0f;
+  lane_output[out_dim + pixel_pos] = 0.0f;
+  lane_output[out_dim * 2 + pixel_pos] = 0.0f;
+  if (pixel_pos / width >= valid_height) {
+    return;
+  }
+
+  // softmax of the background and the three lane channels
+  float score_channel[4];
+  float sum_score = 0.0f;
+  for (int i = 0; i < 4; i++) {
+    score_channel[i] = expf(output_data[i * out_dim + pixel_pos]);
+    sum_score += score_channel[i];
+  }
+  int max_channel_idx = 0;
+  float max_score = score_channel[0] / sum_score;
+  for (int channel_idx = 1; channel_idx < 4; channel_idx++) {
+    float score = score_channel[channel_idx] / sum_score;
+    if (max_score < score) {
+      max_score = score;
+      max_channel_idx = channel_idx;
+    }
+  }
+  if (max_channel_idx == 0 || max_score < score_thresh) {
+    return;
+  }
+  lane_map[pixel_pos] = 1;
+  lane_output[pixel_pos] =
+      1.0f / (1.0f + expf(-output_data[5 * out_dim + pixel_pos]));
+  lane_output[out_dim + pixel_pos] =
+      1.0f / (1.0f + expf(-output_data[6 * out_dim + pixel_pos]));
+  lane_output[out_dim * 2 + pixel_pos] = max_score;
+}
+
+}  // namespace
+
+void MarkLaneEdgesGPU(const float *lane_map, int width, const int *rows,
+                      int num_rows, int lane_type_num, unsigned char *edges,
+                      cudaStream_t stream) {
+  int count = num_rows * width;
+  if (count <= 0) {
+    return;
+  }
+  int blocks = (count + kThreadsPerBlock - 1) / kThreadsPerBlock;
+  mark_lane_edges_kernel<<<blocks, kThreadsPerBlock, 0, stream>>>(
+      lane_map, width, rows, num_rows, lane_type_num, edges);
+  BASE_CUDA_CHECK(cudaGetLastError());
+}
+
+void CalDenselineLaneMapGPU(const float *output_data, int width, int height,
+                            int omit_bottom_line_num, float score_thresh,
+                            unsigned char *lane_map, float *lane_output,
+                            cudaStream_t stream) {
+  int count = width * height;
+  if (count <= 0) {
+    return;
+  }
+  int blocks = (count + kThreadsPerBlock - 1) / kThreadsPerBlock;
+  cal_denseline_lane_map_kernel<<<blocks, kThreadsPerBlock, 0, stream>>>(
+      output_data, width, height, height - omit_bottom_line_num, score_thresh,
+      lane_map, lane_output);
+  BASE_CUDA_CHECK(cudaGetLastError());
+}
+
+}  // namespace camera
+}  // namespace perception
+}  // namespace apollo
@@ -0,0 +1,53 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#pragma once
+
+#include <cuda_runtime.h>
+
+namespace apollo {
+namespace perception {
+namespace camera {
+
+// Per pixel steps of the lane postprocessors. Every output pixel only depends
+// on the network output, so the CPU versions work on a range of rows for the
+// threads to split the map, and the GPU versions on the whole map.
+
+// @brief: mark the inner edges of the lane lines of a darkSCNN lane map on
+//         the sampled rows. edges[r * width + x] gets the lane value of x on
+//         row rows[r] if it is an inner edge of its lane line, 0 otherwise.
+void MarkLaneEdges(const float *lane_map, int width, const int *rows,
+                   int row_begin, int row_end, int lane_type_num,
+                   unsigned char *edges);
+void MarkLaneEdgesGPU(const float *lane_map, int width, const int *rows,
+                      int num_rows, int lane_type_num, unsigned char *edges,
+                      cudaStream_t stream);
+
+// @brief: lane pixels of a denseline network output. lane_map gets 1 on the
+//         pixels of the lane lines, and the three planes of lane_output
+//         their left distance, right distance and score.
+//         The CPU version only writes the lane pixels of rows
+//         [row_begin, row_end), the GPU version writes every pixel.
+void CalDenselineLaneMap(const float *output_data, int width, int height,
+                         int row_begin, int row_end, float score_thresh,
+                         unsigned char *lane_map, float *lane_output);
+void CalDenselineLaneMapGPU(const float *output_data, int width, int height,
+                            int omit_bottom_line_num, float score_thresh,
+                            unsigned char *lane_map, float *lane_output,
+                            cudaStream_t stream);
+
+}  // namespace camera
+}  // namespace perception
+}  // namespace apollo
@@ -23,6 +23,8 @@
 
 #include "modules/perception/base/object_types.h"
 #include "modules/perception/camera/common/math_functions.h"
+#include "modules/perception/camera/lib/lane/common/lane_map_ops.h"
+#include "modules/perception/common/perception_gflags.h"
 #include "modules/perception/lib/utils/timer.h"
 
 namespace apollo {
@@ -113,6 +115,28 @@ bool DarkSCNNLanePostprocessor::Init(
 
   lane_type_num_ = static_cast<int>(spatialLUTind.size());
   AINFO << "lane_type_num_: " << lane_type_num_;
+
+  // TODO(techoe): Should be fixed
+  sample_rows_.clear();
+  int y = static_cast<int>(lane_map_height_ * 0.9 - 1);
+  while (y > 0) {
+    sample_rows_.push_back(y);
+    y -= (y - 45) * (y - 45) / 6400 + 1;
+  }
+  const int num_rows = static_cast<int>(sample_rows_.size());
+  sample_rows_blob_.Reshape({num_rows});
+  std::copy(sample_rows_.begin(), sample_rows_.end(),
+            sample_rows_blob_.mutable_cpu_data());
+  lane_edges_blob_.Reshape({num_rows, lane_map_width_});
+
+  const int num_threads = std::max(FLAGS_lane_postprocessor_num_threads, 1);
+  if (!FLAGS_lane_postprocessor_use_gpu && num_threads > 1 &&
+      thread_pool_ == nullptr) {
+    thread_pool_.reset(new lib::ThreadPool(num_threads - 1));
+    thread_pool_->Start();
+  }
+  num_edge_tasks_ = std::min(thread_pool_ == nullptr ? 1 : num_threads,
+                             std::max(num_rows, 1));
   return true;
 }
 
@@ -122,94 +146,47 @@ bool DarkSCNNLanePostprocessor::Process2D(
   frame->lane_objects.clear();
   auto start = std::chrono::high_resolution_clock::now();
 
-  cv::Mat lane_map(lane_map_height_, lane_map_width_, CV_32FC1);
-  memcpy(lane_map.data, frame->lane_detected_blob->cpu_data(),
-         lane_map_width_ * lane_map_height_ * sizeof(float));
-
   // if (options.use_lane_history &&
   //     (!use_history_ || time_stamp_ > options.timestamp)) {
   //   InitLaneHistory();
   // }
 
   // 1. Sample points on lane_map and project them onto world coordinate
-
-  // TODO(techoe): Should be fixed
-  int y = static_cast<int>(lane_map.rows * 0.9 - 1);
-  // TODO(techoe): Should be fixed
-  int step_y = (y - 40) * (y - 40) / 6400 + 1;
-
   xy_points.clear();
   xy_points.resize(lane_type_num_);
   uv_points.clear();
   uv_points.resize(lane_type_num_);
 
-  while (y > 0) {
-    for (int x = 1; x < lane_map.cols - 1; ++x) {
-      int value = static_cast<int>(round(lane_map.at<float>(y, x)));
-      // lane on left
-
-      if ((value > 0 && value < 5) || value == 11) {
-        // right edge (inner) of the lane
-        if (value != static_cast<int>(round(lane_map.at<float>(y, x + 1)))) {
-          Eigen::Matrix<float, 3, 1> img_point(
-              static_cast<float>(x * roi_width_ / lane_map.cols),
-              static_cast<float>(y * roi_height_ / lane_map.rows + roi_start_),
-              1.0);
-          Eigen::Matrix<float, 3, 1> xy_p;
-          xy_p = trans_mat_ * img_point;
-          Eigen::Matrix<float, 2, 1> xy_point;
-          Eigen::Matrix<float, 2, 1> uv_point;
-          if (std::fabs(xy_p(2)) < 1e-6) continue;
-          xy_point << xy_p(0) / xy_p(2), xy_p(1) / xy_p(2);
-
-          // Filter out lane line points
-          if (xy_point(0) < 0.0 ||  // This condition is only for front camera
-              xy_point(0) > max_longitudinal_distance_ ||
-              std::abs(xy_point(1)) > 30.0) {
-            continue;
-          }
-          uv_point << static_cast<float>(x * roi_width_ / lane_map.cols),
-              static_cast<float>(y * roi_height_ / lane_map.rows + roi_start_);
-          if (xy_points[value].size() < minNumPoints_ || xy_point(0) < 50.0f ||
-              std::fabs(xy_point(1) - xy_points[value].back()(1)) < 1.0f) {
-            xy_points[value].push_back(xy_point);
-            uv_points[value].push_back(uv_point);
-          }
-        }
-      } else if (value >= 5 && value < lane_type_num_) {
-        // Left edge (inner) of the lane
-        if (value != static_cast<int>(round(lane_map.at<float>(y, x - 1)))) {
-          Eigen::Matrix<float, 3, 1> img_point(
-              static_cast<float>(x * roi_width_ / lane_map.cols),
-              static_cast<float>(y * roi_height_ / lane_map.rows + roi_start_),
-              1.0);
-          Eigen::Matrix<float, 3, 1> xy_p;
-          xy_p = trans_mat_ * img_point;
-          Eigen::Matrix<float, 2, 1> xy_point;
-          Eigen::Matrix<float, 2, 1> uv_point;
-          if (std::fabs(xy_p(2)) < 1e-6) continue;
-          xy_point << xy_p(0) / xy_p(2), xy_p(1) / xy_p(2);
-          // Filter out lane line points
-          if (xy_point(0) < 0.0 ||  // This condition is only for front camera
-              xy_point(0) > max_longitudinal_distance_ ||
-              std::abs(xy_point(1)) > 30.0) {
-            continue;
-          }
-          uv_point << static_cast<float>(x * roi_width_ / lane_map.cols),
-              static_cast<float>(y * roi_height_ / lane_map.rows + roi_start_);
-          if (xy_points[value].size() < minNumPoints_ || xy_point(0) < 50.0f ||
-              std::fabs(xy_point(1) - xy_points[value].back()(1)) < 1.0f) {
-            xy_points[value].push_back(xy_point);
-            uv_points[value].push_back(uv_point);
-          }
-        } else if (value >= lane_type_num_) {
-          AWARN << "Lane line value shouldn't be equal or more than: "
-                << lane_type_num_;
-        }
+  // only the edges of the sampled rows are copied back from the gpu
+  if (FLAGS_lane_postprocessor_use_gpu) {
+    MarkLaneEdgesGPU(frame->lane_detected_blob->gpu_data(), lane_map_width_,
+                     sample_rows_blob_.gpu_data(),
+                     static_cast<int>(sample_rows_.size()), lane_type_num_,
+                     lane_edges_blob_.mutable_gpu_data(), nullptr);
+  } else {
+    lane_map_data_ = frame->lane_detected_blob->cpu_data();
+    lane_edges_data_ = lane_edges_blob_.mutable_cpu_data();
+    if (num_edge_tasks_ <= 1) {
+      MarkLaneEdgeRows(0, nullptr);
+    } else {
+      lib::BlockingCounter counter(num_edge_tasks_ - 1);
+      for (int i = 1; i < num_edge_tasks_; ++i) {
+        thread_pool_->Add(google::protobuf::NewCallback(
+            this, &DarkSCNNLanePostprocessor::MarkLaneEdgeRows, i, &counter));
+      }
+      MarkLaneEdgeRows(0, nullptr);
+      counter.Wait();
+    }
+  }
+  // points are kept in the order of the sampled rows, from the bottom up
+  const unsigned char* edges = lane_edges_blob_.cpu_data();
+  for (size_t r = 0; r < sample_rows_.size(); ++r) {
+    const unsigned char* row_edges = edges + r * lane_map_width_;
+    for (int x = 1; x < lane_map_width_ - 1; ++x) {
+      if (row_edges[x] != 0) {
+        AddLaneEdgePoint(x, sample_rows_[r], row_edges[x]);
       }
     }
-    step_y = (y - 45) * (y - 45) / 6400 + 1;
-    y -= step_y;
   }
 
   auto elapsed_1 = std::chrono::high_resolution_clock::now() - start;
@@ -404,6 +381,45 @@ bool DarkSCNNLanePostprocessor::Process2D(
 }
 
 // Produce laneline output in camera coordinates (optional)
+void DarkSCNNLanePostprocessor::MarkLaneEdgeRows(
+    int thread_id, lib::BlockingCounter* counter) {
+  const int num_rows = static_cast<int>(sample_rows_.size());
+  const int row_begin = num_rows * thread_id / num_edge_tasks_;
+  const int row_end = num_rows * (thread_id + 1) / num_edge_tasks_;
+  MarkLaneEdges(lane_map_data_, lane_map_width_, sample_rows_.data(),
+                row_begin, row_end, lane_type_num_, lane_edges_data_);
+  if (counter != nullptr) {
+    counter->Decrement();
+  }
+}
+
+void DarkSCNNLanePostprocessor::AddLaneEdgePoint(int x, int y, int value) {
+  Eigen::Matrix<float, 3, 1> img_point(
+      static_cast<float>(x * roi_width_ / lane_map_width_),
+      static_cast<float>(y * roi_height_ / lane_map_height_ + roi_start_),
+      1.0);
+  Eigen::Matrix<float, 3, 1> xy_p;
+  xy_p = trans_mat_ * img_point;
+  Eigen::Matrix<float, 2, 1> xy_point;
+  Eigen::Matrix<float, 2, 1> uv_point;
+  if (std::fabs(xy_p(2)) < 1e-6) return;
+  xy_point << xy_p(0) / xy_p(2), xy_p(1) / xy_p(2);
+
+  // Filter out lane line points
+  if (xy_point(0) < 0.0 ||  // This condition is only for front camera
+      xy_point(0) > max_longitudinal_distance_ ||
+      std::abs(xy_point(1)) > 30.0) {
+    return;
+  }
+  uv_point << static_cast<float>(x * roi_width_ / lane_map_width_),
+      static_cast<float>(y * roi_height_ / lane_map_height_ + roi_start_);
+  if (xy_points[value].size() < minNumPoints_ || xy_point(0) < 50.0f ||
+      std::fabs(xy_point(1) - xy_points[value].back()(1)) < 1.0f) {
+    xy_points[value].push_back(xy_point);
+    uv_points[value].push_back(uv_point);
+  }
+}
+
 bool DarkSCNNLanePostprocessor::Process3D(
     const LanePostprocessorOptions& options, CameraFrame* frame) {
   ConvertImagePoint2Camera(frame);
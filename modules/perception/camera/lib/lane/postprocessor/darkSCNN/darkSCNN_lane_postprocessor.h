@@ -15,6 +15,7 @@
  *****************************************************************************/
 #pragma once
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -28,6 +29,7 @@
 #include "modules/perception/camera/lib/lane/common/proto/darkSCNN.pb.h"
 #include "modules/perception/camera/lib/lane/postprocessor/darkSCNN/proto/darkSCNN_postprocessor.pb.h"
 #include "modules/perception/lib/registerer/registerer.h"
+#include "modules/perception/lib/thread/thread_pool.h"
 
 namespace apollo {
 namespace perception {
@@ -71,6 +73,10 @@ class DarkSCNNLanePostprocessor : public BaseLanePostprocessor {
   void ConvertImagePoint2Camera(CameraFrame* frame);
   // @brief: fit camera lane line using polynomial
   void PolyFitCameraLaneline(CameraFrame* frame);
+  // @brief: mark the lane edges of the sampled rows of one thread
+  void MarkLaneEdgeRows(int thread_id, lib::BlockingCounter* counter);
+  // @brief: project an inner edge of a lane line to the ground and keep it
+  void AddLaneEdgePoint(int x, int y, int value);
 
  private:
   int input_offset_x_ = 0;
@@ -105,6 +111,17 @@ class DarkSCNNLanePostprocessor : public BaseLanePostprocessor {
   // xy points for the ground plane, uv points for image plane
   std::vector<std::vector<Eigen::Matrix<float, 2, 1>>> xy_points;
   std::vector<std::vector<Eigen::Matrix<float, 2, 1>>> uv_points;
+
+  // rows of the lane map sampled for lane points, from the bottom up
+  std::vector<int> sample_rows_;
+  base::Blob<int> sample_rows_blob_;
+  // lane edges of the sampled rows, see MarkLaneEdges
+  base::Blob<uint8_t> lane_edges_blob_;
+  // host data of the frame being marked on the cpu
+  const float* lane_map_data_ = nullptr;
+  unsigned char* lane_edges_data_ = nullptr;
+  std::unique_ptr<lib::ThreadPool> thread_pool_;
+  int num_edge_tasks_ = 1;
 };
 
 }  // namespace camera
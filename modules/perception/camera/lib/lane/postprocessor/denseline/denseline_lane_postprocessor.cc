@@ -21,7 +21,9 @@
 #include "cyber/common/log.h"
 #include "modules/perception/base/object_types.h"
 #include "modules/perception/camera/common/math_functions.h"
+#include "modules/perception/camera/lib/lane/common/lane_map_ops.h"
 #include "modules/perception/camera/lib/lane/common/proto/denseline.pb.h"
+#include "modules/perception/common/perception_gflags.h"
 #include "modules/perception/lib/utils/timer.h"
 
 namespace apollo {
@@ -77,6 +79,13 @@ bool DenselineLanePostprocessor::Init(
   lane_map_dim_ = lane_map_width_ * lane_map_height_;
   lane_pos_blob_.Reshape({4, lane_map_dim_});
   lane_hist_blob_.Reshape({2, lane_map_dim_});
+
+  num_threads_ = std::max(FLAGS_lane_postprocessor_num_threads, 1);
+  if (!FLAGS_lane_postprocessor_use_gpu && num_threads_ > 1 &&
+      thread_pool_ == nullptr) {
+    thread_pool_.reset(new lib::ThreadPool(num_threads_ - 1));
+    thread_pool_->Start();
+  }
   return true;
 }
 
@@ -153,56 +162,36 @@ std::string DenselineLanePostprocessor::Name() const {
 void DenselineLanePostprocessor::CalLaneMap(
     const float* output_data, int width, int height,
     std::vector<unsigned char>* lane_map) {
-  int out_dim = width * height;
-  for (int y = 0; y < height - omit_bottom_line_num_; y++) {
-    float score_channel[4];
-    int row_start = y * width;
-    int channel0_pos = row_start;
-    int channel1_pos = out_dim + row_start;
-    int channel2_pos = 2 * out_dim + row_start;
-    int channel3_pos = 3 * out_dim + row_start;
-    int channel5_pos = 5 * out_dim + row_start;
-    int channel6_pos = 6 * out_dim + row_start;
-
-    for (int x = 0; x < width; ++x) {
-      score_channel[0] = output_data[channel0_pos + x];
-      score_channel[1] = output_data[channel1_pos + x];
-      score_channel[2] = output_data[channel2_pos + x];
-      score_channel[3] = output_data[channel3_pos + x];
-      // Utilize softmax to get the probability
-      float sum_score = 0.0f;
-      for (int i = 0; i < 4; i++) {
-        score_channel[i] = static_cast<float>(exp(score_channel[i]));
-        sum_score += score_channel[i];
-      }
-      for (int i = 0; i < 4; i++) {
-        score_channel[i] /= sum_score;
-      }
-      // 1: ego-lane; 2: adj-left lane; 3: adj-right lane
-      //  find the score with max lane map
-      int max_channel_idx = 0;
-      float max_score = score_channel[0];
-      for (int channel_idx = 1; channel_idx < 4; channel_idx++) {
-        if (max_score < score_channel[channel_idx]) {
-          max_score = score_channel[channel_idx];
-          max_channel_idx = channel_idx;
-        }
-      }
-      //  if the channel 0 has the maximum probability
-      //  or the score is less than the setting value
-      //  omit it
-      if (max_channel_idx == 0 || max_score < laneline_map_score_thresh_) {
-        continue;
-      }
-      int pixel_pos = row_start + x;
-      (*lane_map)[pixel_pos] = 1;
-
-      float dist_left = sigmoid(output_data[channel5_pos + x]);
-      float dist_right = sigmoid(output_data[channel6_pos + x]);
-      lane_output_[pixel_pos] = dist_left;
-      lane_output_[out_dim + pixel_pos] = dist_right;
-      lane_output_[out_dim * 2 + pixel_pos] = max_score;
-    }
+  //  rows are independent, each thread fills a band of them
+  lane_map_output_data_ = output_data;
+  lane_map_data_ = lane_map->data();
+  lane_map_rows_ = std::max(height - omit_bottom_line_num_, 0);
+  num_lane_map_tasks_ =
+      thread_pool_ == nullptr ? 1 : std::min(num_threads_, lane_map_rows_);
+  if (num_lane_map_tasks_ <= 1) {
+    num_lane_map_tasks_ = 1;
+    CalLaneMapRows(0, nullptr);
+    return;
+  }
+  lib::BlockingCounter counter(num_lane_map_tasks_ - 1);
+  for (int i = 1; i < num_lane_map_tasks_; ++i) {
+    thread_pool_->Add(google::protobuf::NewCallback(
+        this, &DenselineLanePostprocessor::CalLaneMapRows, i, &counter));
+  }
+  CalLaneMapRows(0, nullptr);
+  counter.Wait();
+}
+
+void DenselineLanePostprocessor::CalLaneMapRows(int thread_id,
+                                                lib::BlockingCounter* counter) {
+  int row_begin = lane_map_rows_ * thread_id / num_lane_map_tasks_;
+  int row_end = lane_map_rows_ * (thread_id + 1) / num_lane_map_tasks_;
+  CalDenselineLaneMap(lane_map_output_data_, lane_map_width_,
+                      lane_map_height_, row_begin, row_end,
+                      laneline_map_score_thresh_, lane_map_data_,
+                      lane_output_.data());
+  if (counter != nullptr) {
+    counter->Decrement();
   }
 }
 
@@ -396,7 +385,6 @@ bool DenselineLanePostprocessor::LocateLanelinePointSet(
 
   lane_map_height_ = frame->lane_detected_blob->height();
   lane_map_width_ = frame->lane_detected_blob->width();
-  const float* output_data = frame->lane_detected_blob->cpu_data();
   ADEBUG << "input_size: [" << input_image_width_ << "," << input_image_height_
          << "] "
          << "output_shape: channels=" << channels
@@ -406,11 +394,26 @@ bool DenselineLanePostprocessor::LocateLanelinePointSet(
   image_group_point_set_.resize(4);
 
   int out_dim = lane_map_width_ * lane_map_height_;
-  lane_map_.clear();
-  lane_output_.clear();
-  lane_map_.resize(out_dim, 0);
-  lane_output_.resize(out_dim * 3, 0);
-  CalLaneMap(output_data, lane_map_width_, lane_map_height_, &lane_map_);
+  if (FLAGS_lane_postprocessor_use_gpu) {
+    //  only the lane map and the lane output are copied back, not the
+    //  network channels
+    lane_map_blob_.Reshape({out_dim});
+    lane_output_blob_.Reshape({3, out_dim});
+    CalDenselineLaneMapGPU(frame->lane_detected_blob->gpu_data(),
+                           lane_map_width_, lane_map_height_,
+                           omit_bottom_line_num_, laneline_map_score_thresh_,
+                           lane_map_blob_.mutable_gpu_data(),
+                           lane_output_blob_.mutable_gpu_data(), nullptr);
+    const uint8_t* lane_map_data = lane_map_blob_.cpu_data();
+    const float* lane_output_data = lane_output_blob_.cpu_data();
+    lane_map_.assign(lane_map_data, lane_map_data + out_dim);
+    lane_output_.assign(lane_output_data, lane_output_data + out_dim * 3);
+  } else {
+    const float* output_data = frame->lane_detected_blob->cpu_data();
+    lane_map_.assign(out_dim, 0);
+    lane_output_.assign(out_dim * 3, 0);
+    CalLaneMap(output_data, lane_map_width_, lane_map_height_, &lane_map_);
+  }
   //  2.group the lane points
   base::RectI roi;
   roi.x = 0;
@@ -15,6 +15,7 @@
  *****************************************************************************/
 #pragma once
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -25,6 +26,7 @@
 #include "modules/perception/camera/lib/lane/common/common_functions.h"
 #include "modules/perception/camera/lib/lane/postprocessor/denseline/proto/denseline_postprocessor.pb.h"
 #include "modules/perception/lib/registerer/registerer.h"
+#include "modules/perception/lib/thread/thread_pool.h"
 
 namespace apollo {
 namespace perception {
@@ -75,6 +77,8 @@ class DenselineLanePostprocessor : public BaseLanePostprocessor {
   // @brief: calculate the map using network output(score map)
   void CalLaneMap(const float* output_data, int width, int height,
                   std::vector<unsigned char>* lane_map);
+  // @brief: calculate the lane map rows of one thread
+  void CalLaneMapRows(int thread_id, lib::BlockingCounter* counter);
   // @brief: select lane center ccs
   bool SelectLanecenterCCs(const std::vector<ConnectedComponent>& lane_ccs,
                            std::vector<ConnectedComponent>* select_lane_ccs);
@@ -164,6 +168,17 @@ class DenselineLanePostprocessor : public BaseLanePostprocessor {
 
   base::Blob<float> lane_pos_blob_;
   base::Blob<int> lane_hist_blob_;
+
+  //  lane map and lane output computed on the gpu
+  base::Blob<uint8_t> lane_map_blob_;
+  base::Blob<float> lane_output_blob_;
+  //  arguments of CalLaneMap for the threads
+  const float* lane_map_output_data_ = nullptr;
+  unsigned char* lane_map_data_ = nullptr;
+  int lane_map_rows_ = 0;
+  int num_lane_map_tasks_ = 1;
+  std::unique_ptr<lib::ThreadPool> thread_pool_;
+  int num_threads_ = 1;
 };
 
 }  // namespace camera
@@ -384,8 +384,9 @@ void apply_nms(const bool *overlapped, const int num,
   }
 }
 
-const float *get_gpu_data(bool flag, const base::Blob<float> &blob) {
-  return flag ? blob.gpu_data() : nullptr;
+const float *get_gpu_data(bool flag, const base::Blob<float> &blob,
+                          int batch_index) {
+  return flag ? blob.gpu_data() + blob.offset(batch_index) : nullptr;
 }
 
 void get_objects_gpu(const YoloBlobs &yolo_blobs, const cudaStream_t &stream,
@@ -394,7 +395,7 @@ void get_objects_gpu(const YoloBlobs &yolo_blobs, const cudaStream_t &stream,
                      float light_vis_conf_threshold,
                      float light_swt_conf_threshold,
                      base::Blob<bool> *overlapped, base::Blob<int> *idx_sm,
-                     std::vector<base::ObjectPtr> *objects) {
+                     int batch_index, std::vector<base::ObjectPtr> *objects) {
   bool multi_scale = false;
   if (yolo_blobs.det2_obj_blob) {
     multi_scale = true;
@@ -406,7 +407,8 @@ void get_objects_gpu(const YoloBlobs &yolo_blobs, const cudaStream_t &stream,
   if (multi_scale) {
     num_anchor_per_scale /= numScales;
   }
-  CHECK_EQ(batch, 1) << "batch size should be 1!";
+  CHECK_GE(batch_index, 0);
+  CHECK_LT(batch_index, batch) << "batch index out of range!";
 
   std::vector<int> height_vec, width_vec, num_candidates_vec;
   height_vec.push_back(yolo_blobs.det1_obj_blob->shape(1));
@@ -423,57 +425,73 @@ void get_objects_gpu(const YoloBlobs &yolo_blobs, const cudaStream_t &stream,
   }
 
   const float *loc_data_vec[3] = {
-      yolo_blobs.det1_loc_blob->gpu_data(),
-      yolo_blobs.det2_loc_blob ? yolo_blobs.det2_loc_blob->gpu_data() : nullptr,
-      yolo_blobs.det3_loc_blob ? yolo_blobs.det3_loc_blob->gpu_data()
-                               : nullptr};
+      get_gpu_data(true, *yolo_blobs.det1_loc_blob, batch_index),
+      yolo_blobs.det2_loc_blob
+          ? get_gpu_data(true, *yolo_blobs.det2_loc_blob, batch_index)
+          : nullptr,
+      yolo_blobs.det3_loc_blob
+          ? get_gpu_data(true, *yolo_blobs.det3_loc_blob, batch_index)
+          : nullptr};
   const float *obj_data_vec[3] = {
-      yolo_blobs.det1_obj_blob->gpu_data(),
-      yolo_blobs.det2_obj_blob ? yolo_blobs.det2_obj_blob->gpu_data() : nullptr,
-      yolo_blobs.det3_obj_blob ? yolo_blobs.det3_obj_blob->gpu_data()
-                               : nullptr};
+      get_gpu_data(true, *yolo_blobs.det1_obj_blob, batch_index),
+      yolo_blobs.det2_obj_blob
+          ? get_gpu_data(true, *yolo_blobs.det2_obj_blob, batch_index)
+          : nullptr,
+      yolo_blobs.det3_obj_blob
+          ? get_gpu_data(true, *yolo_blobs.det3_obj_blob, batch_index)
+          : nullptr};
   const float *cls_data_vec[3] = {
-      yolo_blobs.det1_cls_blob->gpu_data(),
-      yolo_blobs.det2_cls_blob ? yolo_blobs.det2_cls_blob->gpu_data() : nullptr,
-      yolo_blobs.det3_cls_blob ? yolo_blobs.det3_cls_blob->gpu_data()
-                               : nullptr};
+      get_gpu_data(true, *yolo_blobs.det1_cls_blob, batch_index),
+      yolo_blobs.det2_cls_blob
+          ? get_gpu_data(true, *yolo_blobs.det2_cls_blob, batch_index)
+          : nullptr,
+      yolo_blobs.det3_cls_blob
+          ? get_gpu_data(true, *yolo_blobs.det3_cls_blob, batch_index)
+          : nullptr};
+  const bool with_box3d = model_param.with_box3d();
   const float *ori_data_vec[3] = {
-      get_gpu_data(model_param.with_box3d(), *yolo_blobs.det1_ori_blob),
+      get_gpu_data(with_box3d, *yolo_blobs.det1_ori_blob, batch_index),
       multi_scale
-          ? get_gpu_data(model_param.with_box3d(), *yolo_blobs.det2_ori_blob)
+          ? get_gpu_data(with_box3d, *yolo_blobs.det2_ori_blob, batch_index)
           : nullptr,
       multi_scale
-          ? get_gpu_data(model_param.with_box3d(), *yolo_blobs.det3_ori_blob)
+          ? get_gpu_data(with_box3d, *yolo_blobs.det3_ori_blob, batch_index)
           : nullptr};
   const float *dim_data_vec[3] = {
-      get_gpu_data(model_param.with_box3d(), *yolo_blobs.det1_dim_blob),
+      get_gpu_data(with_box3d, *yolo_blobs.det1_dim_blob, batch_index),
       multi_scale
-          ? get_gpu_data(model_param.with_box3d(), *yolo_blobs.det2_dim_blob)
+          ? get_gpu_data(with_box3d, *yolo_blobs.det2_dim_blob, batch_index)
           : nullptr,
       multi_scale
-          ? get_gpu_data(model_param.with_box3d(), *yolo_blobs.det3_dim_blob)
+          ? get_gpu_data(with_box3d, *yolo_blobs.det3_dim_blob, batch_index)
           : nullptr};
 
   // TODO[KaWai]: add 3 scale frbox data and light data.
   const float *lof_data =
-      get_gpu_data(model_param.with_frbox(), *yolo_blobs.lof_blob);
+      get_gpu_data(model_param.with_frbox(), *yolo_blobs.lof_blob, batch_index);
   const float *lor_data =
-      get_gpu_data(model_param.with_frbox(), *yolo_blobs.lor_blob);
+      get_gpu_data(model_param.with_frbox(), *yolo_blobs.lor_blob, batch_index);
 
-  const float *area_id_data =
-      get_gpu_data(model_param.num_areas() > 0, *yolo_blobs.area_id_blob);
-  const float *visible_ratio_data =
-      get_gpu_data(model_param.with_ratios(), *yolo_blobs.visible_ratio_blob);
-  const float *cut_off_ratio_data =
-      get_gpu_data(model_param.with_ratios(), *yolo_blobs.cut_off_ratio_blob);
+  const float *area_id_data = get_gpu_data(
+      model_param.num_areas() > 0, *yolo_blobs.area_id_blob, batch_index);
+  const float *visible_ratio_data = get_gpu_data(
+      model_param.with_ratios(), *yolo_blobs.visible_ratio_blob, batch_index);
+  const float *cut_off_ratio_data = get_gpu_data(
+      model_param.with_ratios(), *yolo_blobs.cut_off_ratio_blob, batch_index);
 
   const auto &with_lights = model_param.with_lights();
-  const float *brvis_data = get_gpu_data(with_lights, *yolo_blobs.brvis_blob);
-  const float *brswt_data = get_gpu_data(with_lights, *yolo_blobs.brswt_blob);
-  const float *ltvis_data = get_gpu_data(with_lights, *yolo_blobs.ltvis_blob);
-  const float *ltswt_data = get_gpu_data(with_lights, *yolo_blobs.ltswt_blob);
-  const float *rtvis_data = get_gpu_data(with_lights, *yolo_blobs.rtvis_blob);
-  const float *rtswt_data = get_gpu_data(with_lights, *yolo_blobs.rtswt_blob);
+  const float *brvis_data =
+      get_gpu_data(with_lights, *yolo_blobs.brvis_blob, batch_index);
+  const float *brswt_data =
+      get_gpu_data(with_lights, *yolo_blobs.brswt_blob, batch_index);
+  const float *ltvis_data =
+      get_gpu_data(with_lights, *yolo_blobs.ltvis_blob, batch_index);
+  const float *ltswt_data =
+      get_gpu_data(with_lights, *yolo_blobs.ltswt_blob, batch_index);
+  const float *rtvis_data =
+      get_gpu_data(with_lights, *yolo_blobs.rtvis_blob, batch_index);
+  const float *rtswt_data =
+      get_gpu_data(with_lights, *yolo_blobs.rtswt_blob, batch_index);
 
   int all_scales_num_candidates = 0;
   for (size_t i = 0; i < num_candidates_vec.size(); i++) {
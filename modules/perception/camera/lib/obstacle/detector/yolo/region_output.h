@@ -168,7 +168,7 @@ void get_objects_gpu(const YoloBlobs &yolo_blobs, const cudaStream_t &stream,
                      float light_vis_conf_threshold,
                      float light_swt_conf_threshold,
                      base::Blob<bool> *overlapped, base::Blob<int> *idx_sm,
-                     std::vector<base::ObjectPtr> *objects);
+                     int batch_index, std::vector<base::ObjectPtr> *objects);
 
 void apply_softnms_fast(const std::vector<NormalizedBBox> &bboxes,
                         std::vector<float> *scores, const float score_threshold,
@@ -203,7 +203,9 @@ void fill_area_id(bool with_flag, base::ObjectPtr obj, const float *data);
 
 void fill_base(base::ObjectPtr obj, const float *bbox);
 
-const float *get_gpu_data(bool flag, const base::Blob<float> &blob);
+// @brief data of the given batch index, nullptr if the flag is not set
+const float *get_gpu_data(bool flag, const base::Blob<float> &blob,
+                          int batch_index = 0);
 
 int get_area_id(float visible_ratios[4]);
 
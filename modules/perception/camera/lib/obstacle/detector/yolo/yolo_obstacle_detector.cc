@@ -15,6 +15,8 @@
  *****************************************************************************/
 #include "modules/perception/camera/lib/obstacle/detector/yolo/yolo_obstacle_detector.h"
 
+#include <algorithm>
+
 #include "cyber/common/file.h"
 #include "cyber/common/log.h"
 
@@ -133,7 +135,7 @@ bool YoloObstacleDetector::InitNet(const yolo::YoloParam &yolo_param,
     return false;
   }
   inference_->set_gpu_id(gpu_id_);
-  std::vector<int> shape = {1, height_, width_, 3};
+  std::vector<int> shape = {max_batch_size_, height_, width_, 3};
   std::map<std::string, std::vector<int>> shape_map{
       {net_param.input_blob(), shape}};
 
@@ -183,7 +185,10 @@ void YoloObstacleDetector::InitYoloBlob(const yolo::NetworkParam &net_param) {
   memcpy(anchor_cpu_data, anchors_.data(), anchors_.size() * sizeof(float));
   yolo_blobs_.anchor_blob->gpu_data();
 
-  image_.reset(new base::Image8U(height_, width_, base::Color::RGB));
+  images_.resize(max_batch_size_);
+  for (auto &image : images_) {
+    image.reset(new base::Image8U(height_, width_, base::Color::RGB));
+  }
 
   yolo_blobs_.det1_loc_blob =
       inference_->get_blob(yolo_param_.net_param().det1_loc_blob());
@@ -250,6 +255,7 @@ void YoloObstacleDetector::InitYoloBlob(const yolo::NetworkParam &net_param) {
 
 bool YoloObstacleDetector::Init(const ObstacleDetectorInitOptions &options) {
   gpu_id_ = options.gpu_id;
+  max_batch_size_ = std::max(options.max_batch_size, 1);
   BASE_CUDA_CHECK(cudaSetDevice(gpu_id_));
   BASE_CUDA_CHECK(cudaStreamCreate(&stream_));
 
@@ -316,7 +322,26 @@ bool YoloObstacleDetector::Detect(const ObstacleDetectorOptions &options,
   if (frame == nullptr) {
     return false;
   }
+  return DetectBatch({frame});
+}
 
+bool YoloObstacleDetector::BatchDetect(
+    const ObstacleDetectorOptions &options,
+    const std::vector<CameraFrame *> &frames) {
+  for (size_t start = 0; start < frames.size();
+       start += static_cast<size_t>(max_batch_size_)) {
+    const size_t end =
+        std::min(frames.size(), start + static_cast<size_t>(max_batch_size_));
+    if (!DetectBatch(std::vector<CameraFrame *>(frames.begin() + start,
+                                                frames.begin() + end))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool YoloObstacleDetector::DetectBatch(
+    const std::vector<CameraFrame *> &frames) {
   Timer timer;
   if (cudaSetDevice(gpu_id_) != cudaSuccess) {
     AERROR << "Failed to set device to " << gpu_id_;
@@ -331,36 +356,60 @@ bool YoloObstacleDetector::Detect(const ObstacleDetectorOptions &options,
       0, offset_y_, static_cast<int>(base_camera_model_->get_width()),
       static_cast<int>(base_camera_model_->get_height()) - offset_y_);
   image_options.do_crop = true;
-  frame->data_provider->GetImage(image_options, image_.get());
-  AINFO << "GetImageBlob: " << static_cast<double>(timer.Toc()) * 0.001 << "ms";
-  inference::ResizeGPU(*image_, input_blob, frame->data_provider->src_width(),
-                       0);
-  AINFO << "Resize: " << static_cast<double>(timer.Toc()) * 0.001 << "ms";
+  for (size_t i = 0; i < frames.size(); ++i) {
+    CameraFrame *frame = frames[i];
+    if (frame == nullptr) {
+      return false;
+    }
+    // the crop and the input shape come from the camera model
+    if (frame->data_provider->src_width() !=
+            static_cast<int>(base_camera_model_->get_width()) ||
+        frame->data_provider->src_height() !=
+            static_cast<int>(base_camera_model_->get_height())) {
+      AERROR << "Image size of " << frame->data_provider->sensor_name()
+             << " differs from the camera model.";
+      return false;
+    }
+    frame->data_provider->GetImage(image_options, images_[i].get());
+    inference::ResizeGPU(*images_[i], input_blob,
+                         frame->data_provider->src_width(), 0,
+                         static_cast<int>(i));
+  }
+  AINFO << "Resize " << frames.size()
+        << " images: " << static_cast<double>(timer.Toc()) * 0.001 << "ms";
 
   /////////////////////////// detection part ///////////////////////////
   inference_->Infer();
   AINFO << "Network Forward: " << static_cast<double>(timer.Toc()) * 0.001
         << "ms";
+  for (size_t i = 0; i < frames.size(); ++i) {
+    GetObjects(static_cast<int>(i), frames[i]);
+  }
+  AINFO << "Post: " << static_cast<double>(timer.Toc()) * 0.001 << "ms";
+  return true;
+}
+
+void YoloObstacleDetector::GetObjects(int batch_index, CameraFrame *frame) {
   get_objects_gpu(yolo_blobs_, stream_, types_, nms_, yolo_param_.model_param(),
                   light_vis_conf_threshold_, light_swt_conf_threshold_,
-                  overlapped_.get(), idx_sm_.get(), &(frame->detected_objects));
+                  overlapped_.get(), idx_sm_.get(), batch_index,
+                  &(frame->detected_objects));
 
-  AINFO << "GetObj: " << static_cast<double>(timer.Toc()) * 0.001 << "ms";
   filter_bbox(min_dims_, &(frame->detected_objects));
   FeatureExtractorOptions feat_options;
   feat_options.normalized = true;
-  AINFO << "Post1: " << static_cast<double>(timer.Toc()) * 0.001 << "ms";
+  feat_options.batch_index = batch_index;
   feature_extractor_->Extract(feat_options, frame);
-  AINFO << "Extract: " << static_cast<double>(timer.Toc()) * 0.001 << "ms";
   recover_bbox(frame->data_provider->src_width(),
                frame->data_provider->src_height() - offset_y_, offset_y_,
                &frame->detected_objects);
 
   // post processing
+  const int cols = images_[batch_index]->cols();
   int left_boundary =
-      static_cast<int>(border_ratio_ * static_cast<float>(image_->cols()));
-  int right_boundary = static_cast<int>((1.0f - border_ratio_) *
-                                        static_cast<float>(image_->cols()));
+      static_cast<int>(border_ratio_ * static_cast<float>(cols));
+  int right_boundary =
+      static_cast<int>((1.0f - border_ratio_) * static_cast<float>(cols));
   for (auto &obj : frame->detected_objects) {
     // recover alpha
     obj->camera_supplement.alpha /= ori_cycle_;
@@ -378,9 +427,6 @@ bool YoloObstacleDetector::Detect(const ObstacleDetectorOptions &options,
       obj->camera_supplement.cut_off_ratios[3] = 0;
     }
   }
-  AINFO << "Post2: " << static_cast<double>(timer.Toc()) * 0.001 << "ms";
-
-  return true;
 }
 
 REGISTER_OBSTACLE_DETECTOR(YoloObstacleDetector);
@@ -50,6 +50,10 @@ class YoloObstacleDetector : public BaseObstacleDetector {
 
   bool Detect(const ObstacleDetectorOptions &options,
               CameraFrame *frame) override;
+  // @brief: detect frames of cameras sharing the image size, at most
+  //         max_batch_size of them per network forward
+  bool BatchDetect(const ObstacleDetectorOptions &options,
+                   const std::vector<CameraFrame *> &frames) override;
   std::string Name() const override { return "YoloObstacleDetector"; }
 
  protected:
@@ -59,6 +63,10 @@ class YoloObstacleDetector : public BaseObstacleDetector {
                const std::string &model_root);
   void InitYoloBlob(const yolo::NetworkParam &net_param);
   bool InitFeatureExtractor(const std::string &root_dir);
+  // @brief: preprocess the frames into one input blob and run the network
+  bool DetectBatch(const std::vector<CameraFrame *> &frames);
+  // @brief: decode the objects of the frame at batch_index of the outputs
+  void GetObjects(int batch_index, CameraFrame *frame);
 
  private:
   std::shared_ptr<BaseFeatureExtractor> feature_extractor_;
@@ -76,6 +84,7 @@ class YoloObstacleDetector : public BaseObstacleDetector {
   int offset_y_ = 0;
   int gpu_id_ = 0;
   int obj_k_ = kMaxObjSize;
+  int max_batch_size_ = 1;
 
   int ori_cycle_ = 1;
   float confidence_threshold_ = 0.f;
@@ -84,7 +93,8 @@ class YoloObstacleDetector : public BaseObstacleDetector {
   MinDims min_dims_;
   YoloBlobs yolo_blobs_;
 
-  std::shared_ptr<base::Image8U> image_ = nullptr;
+  // cropped image of every frame of a batch
+  std::vector<std::shared_ptr<base::Image8U>> images_;
   std::shared_ptr<base::Blob<bool>> overlapped_ = nullptr;
   std::shared_ptr<base::Blob<int>> idx_sm_ = nullptr;
 
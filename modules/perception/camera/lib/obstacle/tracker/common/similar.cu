@@ -17,6 +17,7 @@
 
 #include <cblas.h>
 #include <memory>
+#include <vector>
 
 #include "cyber/common/log.h"
 #include "modules/perception/camera/common/util.h"
@@ -50,6 +51,58 @@ bool GPUSimilar::Calc(CameraFrame *frame1, CameraFrame *frame2,
   return true;
 }
 
+bool GPUSimilar::CalcBatch(const std::vector<CameraFrame *> &frames,
+                           CameraFrame *frame, base::Blob<float> *features,
+                           std::vector<int> *row_offsets,
+                           base::Blob<float> *sim) {
+  int m = static_cast<int>(frame->detected_objects.size());
+  if (m == 0) {
+    return false;
+  }
+  if (frame->track_feature_blob == nullptr) {
+    AERROR << "No feature blob";
+    return false;
+  }
+  int dim = frame->track_feature_blob->count(1);
+
+  row_offsets->clear();
+  int n = 0;
+  for (auto *history : frames) {
+    row_offsets->push_back(n);
+    n += static_cast<int>(history->detected_objects.size());
+  }
+  if (n == 0) {
+    return false;
+  }
+
+  features->Reshape({n, dim});
+  float *stacked = features->mutable_gpu_data();
+  for (size_t i = 0; i < frames.size(); ++i) {
+    int rows = static_cast<int>(frames[i]->detected_objects.size());
+    if (rows == 0) {
+      continue;
+    }
+    if (frames[i]->track_feature_blob == nullptr ||
+        frames[i]->track_feature_blob->count(1) != dim) {
+      AERROR << "Invalid feature blob of frame " << frames[i]->frame_id;
+      return false;
+    }
+    // device to device, queued without waiting for the host
+    BASE_CUDA_CHECK(cudaMemcpyAsync(
+        stacked + static_cast<size_t>(row_offsets->at(i)) * dim,
+        frames[i]->track_feature_blob->gpu_data(),
+        static_cast<size_t>(rows) * dim * sizeof(float),
+        cudaMemcpyDeviceToDevice));
+  }
+
+  sim->Reshape({n, m});
+  inference::GPUGemmFloat(CblasNoTrans, CblasTrans, n, m, dim, 1.0,
+                          features->gpu_data(),
+                          frame->track_feature_blob->gpu_data(), 0.0,
+                          sim->mutable_gpu_data());
+  return true;
+}
+
 }  // namespace camera
 }  // namespace perception
 }  // namespace apollo
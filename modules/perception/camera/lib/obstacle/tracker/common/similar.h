@@ -15,6 +15,8 @@
  *****************************************************************************/
 #pragma once
 
+#include <vector>
+
 #include "modules/perception/camera/common/camera_frame.h"
 
 namespace apollo {
@@ -39,6 +41,14 @@ class GPUSimilar : public BaseSimilar {
  public:
   bool Calc(CameraFrame *frame1, CameraFrame *frame2,
             base::Blob<float> *sim) override;
+
+  // @brief: similarities of the objects of all frames against the objects of
+  //         frame in one GEMM. The features of frames are stacked on the
+  //         device into features, row_offsets gets the first row of each
+  //         frame in it and in sim.
+  bool CalcBatch(const std::vector<CameraFrame *> &frames, CameraFrame *frame,
+                 base::Blob<float> *features, std::vector<int> *row_offsets,
+                 base::Blob<float> *sim);
 };
 }  // namespace camera
 }  // namespace perception
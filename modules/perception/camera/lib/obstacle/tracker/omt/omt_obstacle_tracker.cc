@@ -50,8 +50,6 @@ bool OMTObstacleTracker::Init(const ObstacleTrackerInitOptions &options) {
   frame_num_ = 0;
   frame_list_.Init(omt_param_.img_capability());
   gpu_id_ = options.gpu_id;
-  similar_map_.Init(omt_param_.img_capability(), gpu_id_);
-  similar_.reset(new GPUSimilar);
   width_ = options.image_width;
   height_ = options.image_height;
   reference_.Init(omt_param_.reference(), width_, height_);
@@ -244,15 +242,21 @@ float OMTObstacleTracker::ScoreAppearance(const Target &target,
                                           TrackObjectPtr track_obj) {
   float energy = 0.0f;
   int count = 0;
+  if (history_sim_data_ == nullptr) {
+    return energy;
+  }
   auto sensor_name = track_obj->indicator.sensor_name;
+  const int num_latest = history_sim_.shape(1);
   for (int i = target.Size() - 1; i >= 0; --i) {
     if (target[i]->indicator.sensor_name != sensor_name) {
       continue;
     }
-    PatchIndicator p1 = target[i]->indicator;
-    PatchIndicator p2 = track_obj->indicator;
+    const PatchIndicator &p1 = target[i]->indicator;
+    const PatchIndicator &p2 = track_obj->indicator;
 
-    energy += similar_map_.sim(p1, p2);
+    int row = history_rows_[p1.frame_id % omt_param_.img_capability()] +
+              p1.patch_id;
+    energy += history_sim_data_[row * num_latest + p2.patch_id];
     count += 1;
   }
 
@@ -351,11 +355,16 @@ bool OMTObstacleTracker::Associate2D(const ObstacleTrackerOptions &options,
                                      CameraFrame *frame) {
   inference::CudaUtil::set_device_id(gpu_id_);
   frame_list_.Add(frame);
+  // one GEMM of the features of every cached frame against the latest ones,
+  // and one copy of the similarities back to the host
+  history_frames_.clear();
   for (int t = 0; t < frame_list_.Size(); t++) {
-    int frame1 = frame_list_[t]->frame_id;
-    int frame2 = frame_list_[-1]->frame_id;
-    similar_->Calc(frame_list_[frame1], frame_list_[frame2],
-                   similar_map_.get(frame1, frame2).get());
+    history_frames_.push_back(frame_list_[t]);
+  }
+  history_sim_data_ = nullptr;
+  if (similar_.CalcBatch(history_frames_, frame, &history_features_,
+                         &history_rows_, &history_sim_)) {
+    history_sim_data_ = history_sim_.cpu_data();
   }
 
   for (auto &target : targets_) {
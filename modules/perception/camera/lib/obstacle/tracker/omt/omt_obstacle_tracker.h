@@ -111,8 +111,16 @@ class OMTObstacleTracker : public BaseObstacleTracker {
  private:
   omt::OmtParam omt_param_;
   FrameList frame_list_;
-  SimilarMap similar_map_;
-  std::shared_ptr<BaseSimilar> similar_ = nullptr;
+  GPUSimilar similar_;
+  // features of the frames in frame_list_ stacked on the device, and their
+  // similarities to the objects of the latest frame, one row per object
+  base::Blob<float> history_features_;
+  base::Blob<float> history_sim_;
+  // first row of each frame in the stacked blobs, by frame slot
+  std::vector<int> history_rows_;
+  std::vector<CameraFrame *> history_frames_;
+  // host copy of history_sim_, nullptr if there is nothing to compare
+  const float *history_sim_data_ = nullptr;
   std::vector<Target> targets_;
   std::vector<bool> used_;
   ObstacleReference reference_;
@@ -161,30 +161,9 @@ bool TrafficLightDetection::Inference(
   resize_scale_list_.clear();
   int img_width = data_provider->src_width();
   int img_height = data_provider->src_height();
-  int resize_index = 0;
-  auto batch_num = lights->size();
   auto input_img_blob = rt_net_->get_blob(net_inputs_[0]);
-  auto input_param = rt_net_->get_blob(net_inputs_[1]);
 
-  input_img_blob->Reshape(static_cast<int>(batch_num),
-                          static_cast<int>(detection_param_.min_crop_size()),
-                          static_cast<int>(detection_param_.min_crop_size()),
-                          3);
-  param_blob_->Reshape(static_cast<int>(batch_num), 1, 3, 1);
-  float *param_data = param_blob_->mutable_cpu_data();
-  for (size_t i = 0; i < batch_num; ++i) {
-    auto offset = i * param_blob_length_;
-    param_data[offset + 0] =
-        static_cast<float>(detection_param_.min_crop_size());
-    param_data[offset + 1] =
-        static_cast<float>(detection_param_.min_crop_size());
-    param_data[offset + 2] = 1;
-  }
-
-  AINFO << "reshape inputblob " << input_img_blob->shape_string();
-
-  for (size_t i = 0; i < batch_num; ++i) {
-    base::TrafficLightPtr light = lights->at(i);
+  for (base::TrafficLightPtr light : *lights) {
     base::RectI cbox;
     crop_->getCropBox(img_width, img_height, light, &cbox);
     AINFO << "get crop box success " << cbox.x << " " << cbox.y << " "
@@ -194,32 +173,49 @@ bool TrafficLightDetection::Inference(
       crop_box_list_.push_back(cbox);
       light->region.debug_roi[0] = cbox;
       light->region.crop_roi = cbox;
-
-      data_provider_image_option_.do_crop = true;
-      data_provider_image_option_.crop_roi = cbox;
-      data_provider_image_option_.target_color = base::Color::BGR;
-      data_provider->GetImage(data_provider_image_option_, image_.get());
-      AINFO << "get image data success ";
-
-      float resize_scale =
+      resize_scale_list_.push_back(
           static_cast<float>(detection_param_.min_crop_size()) /
-          static_cast<float>(std::min(cbox.width, cbox.height));
-      resize_scale_list_.push_back(resize_scale);
+          static_cast<float>(std::min(cbox.width, cbox.height)));
+    }
+  }
 
-      inference::ResizeGPU(*image_, input_img_blob, img_width, resize_index,
-                            mean_[0], mean_[1], mean_[2], true, 1.0);
-      resize_index++;
+  // all crops go through the network in batches of at most max_batch_size_,
+  // the input blobs were sized for max_batch_size_ in Init, so reshaping
+  // them never reallocates and the im_param rows stay filled
+  data_provider_image_option_.do_crop = true;
+  data_provider_image_option_.target_color = base::Color::BGR;
+  const int num_crops = static_cast<int>(crop_box_list_.size());
+  for (int start = 0; start < num_crops; start += max_batch_size_) {
+    const int batch_size = std::min(max_batch_size_, num_crops - start);
+    input_img_blob->Reshape(batch_size,
+                            static_cast<int>(detection_param_.min_crop_size()),
+                            static_cast<int>(detection_param_.min_crop_size()),
+                            3);
+    param_blob_->Reshape(batch_size, 1, param_blob_length_, 1);
+    AINFO << "reshape inputblob " << input_img_blob->shape_string();
+
+    for (int i = 0; i < batch_size; ++i) {
+      data_provider_image_option_.crop_roi = crop_box_list_[start + i];
+      data_provider->GetImage(data_provider_image_option_, image_.get());
+      inference::ResizeGPU(*image_, input_img_blob, img_width, i, mean_[0],
+                           mean_[1], mean_[2], true, 1.0);
     }
+    // _detection
+    cudaDeviceSynchronize();
+    rt_net_->Infer();
+    cudaDeviceSynchronize();
+    AINFO << "rt_net run success, batch size " << batch_size;
+
+    // dump the output
+    const std::vector<base::RectI> crop_boxes(
+        crop_box_list_.begin() + start,
+        crop_box_list_.begin() + start + batch_size);
+    const std::vector<float> resize_scales(
+        resize_scale_list_.begin() + start,
+        resize_scale_list_.begin() + start + batch_size);
+    SelectOutputBoxes(crop_boxes, resize_scales, resize_scales,
+                      &detected_bboxes_);
   }
-  // _detection
-  cudaDeviceSynchronize();
-  rt_net_->Infer();
-  cudaDeviceSynchronize();
-  AINFO << "rt_net run success";
-
-  // dump the output
-  SelectOutputBoxes(crop_box_list_, resize_scale_list_, resize_scale_list_,
-                    &detected_bboxes_);
 
   ApplyNMS(&detected_bboxes_);
 
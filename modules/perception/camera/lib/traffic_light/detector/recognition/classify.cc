@@ -15,10 +15,12 @@
  *****************************************************************************/
 #include "modules/perception/camera/lib/traffic_light/detector/recognition/classify.h"
 
+#include <algorithm>
 #include <map>
 
 #include "cyber/common/file.h"
 #include "modules/perception/camera/common/util.h"
+#include "modules/perception/common/perception_gflags.h"
 #include "modules/perception/inference/inference_factory.h"
 #include "modules/perception/inference/utils/resize.h"
 
@@ -86,8 +88,10 @@ void ClassifyBySimple::Init(
   }
   scale_ = model_config.scale();
 
-  std::vector<int> shape = {1, resize_height_, resize_width_, 3};
-  mean_buffer_.reset(new base::Blob<float>(shape));
+  max_batch_size_ = std::max(FLAGS_tl_classify_max_batch_size, 1);
+  std::vector<int> shape = {max_batch_size_, resize_height_, resize_width_, 3};
+  mean_buffer_.reset(
+      new base::Blob<float>(1, resize_height_, resize_width_, 3));
 
   std::map<std::string, std::vector<int>> input_reshape{
       {net_inputs_[0], shape}};
@@ -112,36 +116,46 @@ void ClassifyBySimple::Perform(const CameraFrame* frame,
     AERROR << "Failed to set device to " << gpu_id_;
     return;
   }
-  std::shared_ptr<base::Blob<uint8_t>> rectified_blob;
-
   auto input_blob_recog = rt_net_->get_blob(net_inputs_[0]);
   auto output_blob_recog = rt_net_->get_blob(net_outputs_[0]);
 
+  std::vector<base::TrafficLightPtr> detected_lights;
   for (base::TrafficLightPtr light : *lights) {
-    if (!light->region.is_detected) {
-      continue;
+    if (light->region.is_detected) {
+      detected_lights.push_back(light);
     }
+  }
 
-    data_provider_image_option_.crop_roi = light->region.detection_roi;
-    data_provider_image_option_.do_crop = true;
-    data_provider_image_option_.target_color = base::Color::RGB;
-    frame->data_provider->GetImage(data_provider_image_option_, image_.get());
-
-    AINFO << "get img done";
-
-    const float* mean = mean_->cpu_data();
-    inference::ResizeGPU(*image_, input_blob_recog,
-                         frame->data_provider->src_width(), 0, mean[0],
-                         mean[1], mean[2], true, scale_);
+  data_provider_image_option_.do_crop = true;
+  data_provider_image_option_.target_color = base::Color::RGB;
+  const float* mean = mean_->cpu_data();
+  const int num_lights = static_cast<int>(detected_lights.size());
+  for (int start = 0; start < num_lights; start += max_batch_size_) {
+    // the input blob was sized for max_batch_size_ in Init, so this never
+    // reallocates
+    const int batch_size = std::min(max_batch_size_, num_lights - start);
+    input_blob_recog->Reshape({batch_size, resize_height_, resize_width_, 3});
+    for (int i = 0; i < batch_size; ++i) {
+      data_provider_image_option_.crop_roi =
+          detected_lights[start + i]->region.detection_roi;
+      frame->data_provider->GetImage(data_provider_image_option_,
+                                     image_.get());
+      inference::ResizeGPU(*image_, input_blob_recog,
+                           frame->data_provider->src_width(), i, mean[0],
+                           mean[1], mean[2], true, scale_);
+    }
 
-    AINFO << "resize gpu finish.";
     cudaDeviceSynchronize();
     rt_net_->Infer();
     cudaDeviceSynchronize();
-    AINFO << "infer finish.";
+    AINFO << "infer finish, batch size " << batch_size;
 
-    float* out_put_data = output_blob_recog->mutable_cpu_data();
-    Prob2Color(out_put_data, unknown_threshold_, light);
+    const float* out_put_data = output_blob_recog->cpu_data();
+    const int prob_length = output_blob_recog->count(1);
+    for (int i = 0; i < batch_size; ++i) {
+      Prob2Color(out_put_data + i * prob_length, unknown_threshold_,
+                 detected_lights[start + i]);
+    }
   }
 }
 
@@ -56,6 +56,7 @@ class ClassifyBySimple {
   float unknown_threshold_;
   float scale_;
   int gpu_id_ = 0;
+  int max_batch_size_ = 1;
 };
 
 }  // namespace camera
@@ -48,25 +48,25 @@ bool TrafficLightRecognition::Init(
 
 bool TrafficLightRecognition::Detect(const TrafficLightDetectorOptions& options,
                                      CameraFrame* frame) {
-  std::vector<base::TrafficLightPtr> candidate(1);
+  // lights of each shape are classified by their model in batches
+  std::vector<base::TrafficLightPtr> quadrate_lights;
+  std::vector<base::TrafficLightPtr> vertical_lights;
+  std::vector<base::TrafficLightPtr> horizontal_lights;
+  bool valid_class = true;
 
   for (base::TrafficLightPtr light : frame->traffic_lights) {
     if (light->region.is_detected) {
-      candidate[0] = light;
       if (light->region.detect_class_id ==
           base::TLDetectionClass::TL_QUADRATE_CLASS) {
-        AINFO << "Recognize Use Quadrate Model!";
-        classify_quadrate_->Perform(frame, &candidate);
+        quadrate_lights.push_back(light);
       } else if (light->region.detect_class_id ==
                  base::TLDetectionClass::TL_VERTICAL_CLASS) {
-        AINFO << "Recognize Use Vertical Model!";
-        classify_vertical_->Perform(frame, &candidate);
+        vertical_lights.push_back(light);
       } else if (light->region.detect_class_id ==
                  base::TLDetectionClass::TL_HORIZONTAL_CLASS) {
-        AINFO << "Recognize Use Horizonal Model!";
-        classify_horizontal_->Perform(frame, &candidate);
+        horizontal_lights.push_back(light);
       } else {
-        return false;
+        valid_class = false;
       }
     } else {
       light->status.color = base::TLColor::TL_UNKNOWN_COLOR;
@@ -74,7 +74,23 @@ bool TrafficLightRecognition::Detect(const TrafficLightDetectorOptions& options,
     }
   }
 
-  return true;
+  if (!quadrate_lights.empty()) {
+    AINFO << "Recognize " << quadrate_lights.size()
+          << " lights Use Quadrate Model!";
+    classify_quadrate_->Perform(frame, &quadrate_lights);
+  }
+  if (!vertical_lights.empty()) {
+    AINFO << "Recognize " << vertical_lights.size()
+          << " lights Use Vertical Model!";
+    classify_vertical_->Perform(frame, &vertical_lights);
+  }
+  if (!horizontal_lights.empty()) {
+    AINFO << "Recognize " << horizontal_lights.size()
+          << " lights Use Horizonal Model!";
+    classify_horizontal_->Perform(frame, &horizontal_lights);
+  }
+
+  return valid_class;
 }
 
 std::string TrafficLightRecognition::Name() const {
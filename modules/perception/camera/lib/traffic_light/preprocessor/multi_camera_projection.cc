@@ -108,6 +108,51 @@ bool MultiCamerasProjection::Project(const CarPose& pose,
   return true;
 }
 
+bool MultiCamerasProjection::ProjectLights(
+    const CarPose& pose, const ProjectOption& option,
+    const base::TrafficLightPtrs& lights, std::vector<bool>* projected) const {
+  projected->assign(lights.size(), false);
+  if (!HasCamera(option.camera_name)) {
+    AERROR << "no camera: " << option.camera_name;
+    return false;
+  }
+  auto iter = pose.c2w_poses_.find(option.camera_name);
+  if (iter == pose.c2w_poses_.end()) {
+    return false;
+  }
+  AINFO << "project " << lights.size()
+        << " lights use camera_name: " << option.camera_name;
+
+  // transform the boundary points of all lights into the camera frame
+  std::vector<size_t> offsets(lights.size() + 1, 0);
+  for (size_t i = 0; i < lights.size(); ++i) {
+    offsets[i + 1] = offsets[i] + lights[i]->region.points.size();
+  }
+  Eigen::Matrix4Xd points_world(4, offsets.back());
+  for (size_t i = 0; i < lights.size(); ++i) {
+    const auto& points = lights[i]->region.points;
+    for (size_t j = 0; j < points.size(); ++j) {
+      points_world.col(offsets[i] + j) << points[j].x, points[j].y,
+          points[j].z, 1.0;
+    }
+  }
+  const Eigen::Matrix4d w2c_pose = iter->second.inverse();
+  const Eigen::Matrix3Xd points_cam = w2c_pose.topRows<3>() * points_world;
+
+  const auto& camera_model = camera_models_.at(option.camera_name);
+  for (size_t i = 0; i < lights.size(); ++i) {
+    (*projected)[i] = BoundaryBasedProject(
+        camera_model, points_cam.middleCols(offsets[i], offsets[i + 1] -
+                                                            offsets[i]),
+        lights[i].get());
+    if (!(*projected)[i]) {
+      AWARN << "Projection failed projection the traffic light. "
+            << "camera_name: " << option.camera_name;
+    }
+  }
+  return true;
+}
+
 bool MultiCamerasProjection::HasCamera(const std::string& camera_name) const {
   auto iter =
       std::find(camera_names_.begin(), camera_names_.end(), camera_name);
@@ -138,30 +183,42 @@ bool MultiCamerasProjection::BoundaryBasedProject(
     const Eigen::Matrix4d& c2w_pose,
     const std::vector<base::PointXYZID>& points,
     base::TrafficLight* light) const {
+  const int bound_size = static_cast<int>(points.size());
+  Eigen::Matrix4Xd points_world(4, bound_size);
+  for (int i = 0; i < bound_size; ++i) {
+    const auto& pt3d_world = points.at(i);
+    points_world.col(i) << pt3d_world.x, pt3d_world.y, pt3d_world.z, 1.0;
+  }
+  const Eigen::Matrix4d w2c_pose = c2w_pose.inverse();
+  return BoundaryBasedProject(camera_model,
+                              w2c_pose.topRows<3>() * points_world, light);
+}
+
+bool MultiCamerasProjection::BoundaryBasedProject(
+    const base::BrownCameraDistortionModelPtr camera_model,
+    const Eigen::Ref<const Eigen::Matrix3Xd>& points_cam,
+    base::TrafficLight* light) const {
   if (camera_model.get() == nullptr) {
     AERROR << "camera_model is not available.";
     return false;
   }
   int width = static_cast<int>(camera_model->get_width());
   int height = static_cast<int>(camera_model->get_height());
-  int bound_size = static_cast<int>(points.size());
+  int bound_size = static_cast<int>(points_cam.cols());
   if (bound_size < 4) {
     AERROR << "invalid bound_size " << bound_size;
     return false;
   }
-  std::vector<Eigen::Vector2i> pts2d(bound_size);
-  auto c2w_pose_inverse = c2w_pose.inverse();
-
+  // reject the lights behind the camera before the distortion model
   for (int i = 0; i < bound_size; ++i) {
-    const auto& pt3d_world = points.at(i);
-    Eigen::Vector3d pt3d_cam =
-        (c2w_pose_inverse *
-         Eigen::Vector4d(pt3d_world.x, pt3d_world.y, pt3d_world.z, 1.0))
-            .head(3);
-    if (std::islessequal(pt3d_cam[2], 0.0)) {
-      AWARN << "light bound point behind the car: " << pt3d_cam;
+    if (std::islessequal(points_cam(2, i), 0.0)) {
+      AWARN << "light bound point behind the car: " << points_cam.col(i);
       return false;
     }
+  }
+  std::vector<Eigen::Vector2i> pts2d(bound_size);
+  for (int i = 0; i < bound_size; ++i) {
+    const Eigen::Vector3d pt3d_cam = points_cam.col(i);
     pts2d[i] = camera_model->Project(pt3d_cam.cast<float>()).cast<int>();
   }
 
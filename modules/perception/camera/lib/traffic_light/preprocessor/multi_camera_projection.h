@@ -19,6 +19,8 @@
 #include <string>
 #include <vector>
 
+#include "Eigen/Core"
+
 #include "modules/perception/base/distortion_model.h"
 #include "modules/perception/base/point.h"
 #include "modules/perception/base/traffic_light.h"
@@ -46,6 +48,12 @@ class MultiCamerasProjection {
   bool Init(const MultiCamerasInitOption& options);
   bool Project(const CarPose& pose, const ProjectOption& option,
                base::TrafficLight* light) const;
+  // @brief Project all the lights into the camera, transforming their
+  // boundary points in one pass; projected[i] is what Project() returns
+  // for lights[i].
+  bool ProjectLights(const CarPose& pose, const ProjectOption& option,
+                     const base::TrafficLightPtrs& lights,
+                     std::vector<bool>* projected) const;
   bool HasCamera(const std::string& camera_name) const;
 
   int getImageWidth(const std::string& camera_name) const;
@@ -61,6 +69,11 @@ class MultiCamerasProjection {
       const Eigen::Matrix4d& c2w_pose,
       const std::vector<base::PointXYZID>& point,
       base::TrafficLight* light) const;
+  // @param points_cam light boundary points in the camera frame
+  bool BoundaryBasedProject(
+      const base::BrownCameraDistortionModelPtr camera_model,
+      const Eigen::Ref<const Eigen::Matrix3Xd>& points_cam,
+      base::TrafficLight* light) const;
 
  private:
   // sorted by focal length in descending order
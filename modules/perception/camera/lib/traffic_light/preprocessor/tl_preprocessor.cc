@@ -15,9 +15,13 @@
  *****************************************************************************/
 #include "modules/perception/camera/lib/traffic_light/preprocessor/tl_preprocessor.h"
 
+#include <algorithm>
+#include <cmath>
+
 #include "cyber/common/file.h"
 #include "cyber/common/log.h"
 #include "modules/perception/camera/common/util.h"
+#include "modules/perception/common/perception_gflags.h"
 #include "modules/perception/lib/config_manager/config_manager.h"
 
 namespace apollo {
@@ -57,9 +61,17 @@ bool TLPreprocessor::UpdateCameraSelection(
     return true;
   }
 
+  if (CanReuseCameraSelection(pose, *lights)) {
+    selected_camera_name_.second = last_selected_camera_name_;
+    AINFO << "reuse camera selection: " << selected_camera_name_.second;
+    return true;
+  }
   if (!ProjectLightsAndSelectCamera(pose, option,
                                     &(selected_camera_name_.second), lights)) {
     AERROR << "project_lights_and_select_camera failed, ts: " << timestamp;
+    last_selection_valid_ = false;
+  } else {
+    SaveCameraSelection(pose, *lights);
   }
 
   AINFO << "selected_camera_id: " << selected_camera_name_.second;
@@ -256,10 +268,13 @@ bool TLPreprocessor::ProjectLights(
     return true;
   }
 
+  std::vector<bool> projected;
+  projection_.ProjectLights(pose, ProjectOption(camera_name), *lights,
+                            &projected);
   for (size_t i = 0; i < lights->size(); ++i) {
     base::TrafficLightPtr light_proj(new base::TrafficLight);
     auto light = lights->at(i);
-    if (!projection_.Project(pose, ProjectOption(camera_name), light.get())) {
+    if (!projected[i]) {
       light->region.outside_image = true;
       *light_proj = *light;
       lights_outside_image->push_back(light_proj);
@@ -328,6 +343,58 @@ bool TLPreprocessor::GetAlllightsOutsideFlag() const {
 
 std::string TLPreprocessor::Name() const { return "TLPreprocessor"; }
 
+bool TLPreprocessor::CanReuseCameraSelection(
+    const CarPose &pose,
+    const std::vector<base::TrafficLightPtr> &lights) const {
+  if (!last_selection_valid_ ||
+      FLAGS_tl_camera_selection_reuse_distance <= 0.0 ||
+      camera_is_working_flags_ != last_selection_working_flags_ ||
+      lights.size() != last_selection_light_ids_.size() ||
+      pose.c2w_poses_.size() != last_selection_c2w_poses_.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < lights.size(); ++i) {
+    if (lights[i]->id != last_selection_light_ids_[i]) {
+      return false;
+    }
+  }
+  // the signals are static, so the projections only move with the cameras
+  const double max_cos_angle = std::cos(
+      FLAGS_tl_camera_selection_reuse_angle * M_PI / 180.0);
+  for (const auto &c2w_pose : pose.c2w_poses_) {
+    auto iter = last_selection_c2w_poses_.find(c2w_pose.first);
+    if (iter == last_selection_c2w_poses_.end()) {
+      return false;
+    }
+    const Eigen::Vector3d offset =
+        c2w_pose.second.topRightCorner<3, 1>() -
+        iter->second.topRightCorner<3, 1>();
+    if (offset.norm() > FLAGS_tl_camera_selection_reuse_distance) {
+      return false;
+    }
+    // the angle of the relative rotation from its trace
+    const Eigen::Matrix3d rotation =
+        iter->second.topLeftCorner<3, 3>().transpose() *
+        c2w_pose.second.topLeftCorner<3, 3>();
+    if (0.5 * (rotation.trace() - 1.0) < max_cos_angle) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void TLPreprocessor::SaveCameraSelection(
+    const CarPose &pose, const std::vector<base::TrafficLightPtr> &lights) {
+  last_selection_valid_ = true;
+  last_selected_camera_name_ = selected_camera_name_.second;
+  last_selection_working_flags_ = camera_is_working_flags_;
+  last_selection_c2w_poses_ = pose.c2w_poses_;
+  last_selection_light_ids_.clear();
+  for (const auto &light : lights) {
+    last_selection_light_ids_.push_back(light->id);
+  }
+}
+
 std::string TLPreprocessor::GetMinFocalLenWorkingCameraName() const {
   const auto &camera_names = projection_.getCameraNamesByDescendingFocalLen();
   for (auto itr = camera_names.crbegin(); itr != camera_names.crend(); ++itr) {
@@ -92,6 +92,15 @@ class TLPreprocessor {
   std::string GetMinFocalLenWorkingCameraName() const;
   std::string GetMaxFocalLenWorkingCameraName() const;
 
+  // @brief Whether the last camera selection still holds, i.e. the same
+  // signals and working cameras, and every camera moved less than
+  // FLAGS_tl_camera_selection_reuse_distance/angle since then
+  bool CanReuseCameraSelection(
+      const CarPose& pose,
+      const std::vector<base::TrafficLightPtr>& lights) const;
+  void SaveCameraSelection(const CarPose& pose,
+                           const std::vector<base::TrafficLightPtr>& lights);
+
  private:
   MultiCamerasProjection projection_;
   double last_pub_img_ts_ = 0.0;
@@ -106,6 +115,14 @@ class TLPreprocessor {
   base::TrafficLightPtrs lights_on_image_;
   base::TrafficLightPtrs lights_outside_image_;
   bool projections_outside_all_images_ = false;
+
+  // the last camera selection from projections
+  bool last_selection_valid_ = false;
+  std::string last_selected_camera_name_;
+  std::vector<std::string> last_selection_light_ids_;
+  std::map<std::string, bool> last_selection_working_flags_;
+  apollo::common::EigenMap<std::string, Eigen::Matrix4d>
+      last_selection_c2w_poses_;
 };
 
 }  // namespace camera
@@ -14,6 +14,8 @@
  * limitations under the License.
  *****************************************************************************/
 
+#include <vector>
+
 #include "modules/perception/camera/common/data_provider.h"
 #include "modules/perception/camera/test/camera_common_io_util.h"
 
@@ -109,6 +111,41 @@ TEST(DataProvider, test_nodistortion) {
   EXPECT_FALSE(data_provider.GetImageBlob(image_options, &blob));
 }
 
+TEST(DataProvider, test_yuv_image) {
+  unsetenv("MODULE_PATH");
+  unsetenv("CYBER_PATH");
+  const int rows = 64;
+  const int cols = 128;
+  DataProvider data_provider;
+  DataProvider::InitOptions init_options;
+  init_options.image_height = rows;
+  init_options.image_width = cols;
+  init_options.device_id = 0;
+  EXPECT_TRUE(data_provider.Init(init_options));
+
+  base::Image8U image;
+  DataProvider::ImageOptions image_options;
+  image_options.target_color = base::Color::RGB;
+
+  // mid gray, luma 128 without chroma
+  std::vector<uint8_t> yuyv(rows * cols * 2, 128);
+  EXPECT_TRUE(data_provider.FillImageData(rows, cols, yuyv.data(), "yuyv"));
+  EXPECT_TRUE(data_provider.GetImage(image_options, &image));
+  for (int i = 0; i < image.total(); ++i) {
+    EXPECT_NEAR(image.cpu_data()[i], 128, 2);
+  }
+
+  std::vector<uint8_t> nv12(rows * cols * 3 / 2, 128);
+  EXPECT_TRUE(data_provider.FillImageData(rows, cols, nv12.data(), "nv12"));
+  image_options.target_color = base::Color::BGR;
+  EXPECT_TRUE(data_provider.GetImage(image_options, &image));
+  for (int i = 0; i < image.total(); ++i) {
+    EXPECT_NEAR(image.cpu_data()[i], 128, 2);
+  }
+
+  EXPECT_FALSE(data_provider.FillImageData(rows, cols, nv12.data(), "yuv420"));
+}
+
 TEST(DataProvider, test_fill_image_data) {
   unsetenv("MODULE_PATH");
   unsetenv("CYBER_PATH");
@@ -0,0 +1,63 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "opencv2/opencv.hpp"
+
+#include "modules/perception/camera/common/jpeg_decoder.h"
+
+namespace apollo {
+namespace perception {
+namespace camera {
+
+TEST(JpegDecoderTest, test_decode) {
+  cv::Mat img(48, 64, CV_8UC3);
+  for (int r = 0; r < img.rows; ++r) {
+    for (int c = 0; c < img.cols; ++c) {
+      img.at<cv::Vec3b>(r, c) = cv::Vec3b(static_cast<uint8_t>(r * 4),
+                                          static_cast<uint8_t>(c * 2), 100);
+    }
+  }
+  std::vector<uint8_t> jpeg;
+  ASSERT_TRUE(cv::imencode(".jpg", img, jpeg));
+  // opencv decodes to bgr, nvjpeg to rgb
+  cv::Mat expected = cv::imdecode(jpeg, cv::IMREAD_COLOR);
+  cv::cvtColor(expected, expected, cv::COLOR_BGR2RGB);
+
+  JpegDecoder decoder;
+  base::Image8U image;
+  EXPECT_FALSE(decoder.Decode(jpeg.data(), jpeg.size(), &image));
+  ASSERT_TRUE(decoder.Init(0));
+  EXPECT_FALSE(decoder.Decode(jpeg.data(), jpeg.size(), nullptr));
+  EXPECT_FALSE(decoder.Decode(jpeg.data(), 10, &image));
+
+  ASSERT_TRUE(decoder.Decode(jpeg.data(), jpeg.size(), &image));
+  EXPECT_EQ(image.rows(), img.rows);
+  EXPECT_EQ(image.cols(), img.cols);
+  EXPECT_EQ(image.type(), base::Color::RGB);
+  for (int r = 0; r < image.rows(); ++r) {
+    const uint8_t *row = image.cpu_ptr(r);
+    for (int c = 0; c < image.cols() * 3; ++c) {
+      EXPECT_NEAR(row[c], expected.ptr<uint8_t>(r)[c], 3);
+    }
+  }
+}
+
+}  // namespace camera
+}  // namespace perception
+}  // namespace apollo
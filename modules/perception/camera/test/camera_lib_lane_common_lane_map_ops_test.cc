@@ -0,0 +1,104 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#include "modules/perception/camera/lib/lane/common/lane_map_ops.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "modules/perception/base/blob.h"
+
+namespace apollo {
+namespace perception {
+namespace camera {
+
+TEST(LaneMapOpsTest, mark_lane_edges_test) {
+  const int width = 8;
+  // lane 2 on the left, lane 6 on the right
+  std::vector<float> lane_map = {0, 2, 2, 2, 0, 6.2f, 5.9f, 0,  //
+                                 0, 0, 0, 0, 0, 0,    0,    0,  //
+                                 2, 2, 0, 0, 0, 0,    6,    6};
+  std::vector<int> rows = {2, 0};
+  std::vector<unsigned char> edges(rows.size() * width, 255);
+  MarkLaneEdges(lane_map.data(), width, rows.data(), 0, 2, 13, edges.data());
+  // right edges of the left lanes, left edges of the right lanes
+  std::vector<unsigned char> expected = {0, 2, 0, 0, 0, 0, 6, 0,  //
+                                         0, 0, 0, 2, 0, 6, 0, 0};
+  EXPECT_EQ(edges, expected);
+
+  base::Blob<float> lane_map_blob;
+  lane_map_blob.Reshape({3, width});
+  std::copy(lane_map.begin(), lane_map.end(),
+            lane_map_blob.mutable_cpu_data());
+  base::Blob<int> rows_blob;
+  rows_blob.Reshape({2});
+  std::copy(rows.begin(), rows.end(), rows_blob.mutable_cpu_data());
+  base::Blob<uint8_t> edges_blob;
+  edges_blob.Reshape({2, width});
+  MarkLaneEdgesGPU(lane_map_blob.gpu_data(), width, rows_blob.gpu_data(), 2,
+                   13, edges_blob.mutable_gpu_data(), nullptr);
+  EXPECT_EQ(std::vector<unsigned char>(
+                edges_blob.cpu_data(), edges_blob.cpu_data() + 2 * width),
+            expected);
+}
+
+TEST(LaneMapOpsTest, cal_denseline_lane_map_test) {
+  const int width = 3;
+  const int height = 2;
+  const int dim = width * height;
+  // 7 channels: background, three lanes, unused, left and right distances
+  std::vector<float> output(7 * dim, 0.0f);
+  // pixel 0 is background
+  output[0] = 5.0f;
+  // pixel 1 is the ego lane
+  output[dim + 1] = 5.0f;
+  output[5 * dim + 1] = 1.0f;
+  output[6 * dim + 1] = -1.0f;
+  // pixel 2 is below the score threshold
+  output[2 * dim + 2] = 0.5f;
+  // pixel 4 is the left lane, in the omitted bottom row
+  output[2 * dim + 4] = 5.0f;
+
+  std::vector<unsigned char> lane_map(dim, 0);
+  std::vector<float> lane_output(3 * dim, 0.0f);
+  CalDenselineLaneMap(output.data(), width, height, 0, 1, 0.4f,
+                      lane_map.data(), lane_output.data());
+  EXPECT_EQ(lane_map, std::vector<unsigned char>({0, 1, 0, 0, 0, 0}));
+  EXPECT_NEAR(lane_output[1], 0.731f, 1e-3);
+  EXPECT_NEAR(lane_output[dim + 1], 0.269f, 1e-3);
+  EXPECT_NEAR(lane_output[2 * dim + 1], 0.980f, 1e-3);
+
+  base::Blob<float> output_blob;
+  output_blob.Reshape({7, dim});
+  std::copy(output.begin(), output.end(), output_blob.mutable_cpu_data());
+  base::Blob<uint8_t> lane_map_blob;
+  lane_map_blob.Reshape({dim});
+  base::Blob<float> lane_output_blob;
+  lane_output_blob.Reshape({3, dim});
+  CalDenselineLaneMapGPU(output_blob.gpu_data(), width, height, 1, 0.4f,
+                         lane_map_blob.mutable_gpu_data(),
+                         lane_output_blob.mutable_gpu_data(), nullptr);
+  for (int i = 0; i < dim; ++i) {
+    EXPECT_EQ(lane_map_blob.cpu_data()[i], lane_map[i]);
+  }
+  for (int i = 0; i < 3 * dim; ++i) {
+    EXPECT_NEAR(lane_output_blob.cpu_data()[i], lane_output[i], 1e-5);
+  }
+}
+
+}  // namespace camera
+}  // namespace perception
+}  // namespace apollo
@@ -250,6 +250,55 @@ TEST(SimilarTest, GPU_test) {
   ASSERT_TRUE(fabs(sim_data[2] - 0) < 1e-3);            // NOLINT
 }
 
+TEST(SimilarTest, GPU_batch_test) {
+  inference::CudaUtil::set_device_id(0);
+  GPUSimilar similar;
+  base::ObjectPtr object(new base::Object);
+  CameraFrame frame1;
+  CameraFrame frame2;
+  CameraFrame frame3;
+  base::Blob<float> features;
+  base::Blob<float> sim;
+  std::vector<int> row_offsets;
+  std::vector<CameraFrame *> frames = {&frame1, &frame2, &frame3};
+  ASSERT_FALSE(
+      similar.CalcBatch(frames, &frame3, &features, &row_offsets, &sim));
+
+  frame1.detected_objects.push_back(object);
+  frame1.track_feature_blob.reset(
+      new base::Blob<float>(std::vector<int>{1, 2}));
+  float *feature1 = frame1.track_feature_blob->mutable_cpu_data();
+  feature1[0] = 0.707f;
+  feature1[1] = 0.707f;
+  // frame2 has no object
+  frame3.detected_objects.push_back(object);
+  frame3.detected_objects.push_back(object);
+  frame3.track_feature_blob.reset(
+      new base::Blob<float>(std::vector<int>{2, 2}));
+  float *feature3 = frame3.track_feature_blob->mutable_cpu_data();
+  feature3[0] = 1.0f;
+  feature3[1] = 0.0f;
+  feature3[2] = -0.707f;
+  feature3[3] = 0.707f;
+
+  ASSERT_TRUE(
+      similar.CalcBatch(frames, &frame3, &features, &row_offsets, &sim));
+  ASSERT_EQ(row_offsets, std::vector<int>({0, 1, 1}));
+  ASSERT_EQ(sim.shape(0), 3);
+  ASSERT_EQ(sim.shape(1), 2);
+  // the same as pairwise Calc
+  base::Blob<float> pair_sim;
+  for (int i : {0, 2}) {
+    ASSERT_TRUE(similar.Calc(frames[i], &frame3, &pair_sim));
+    for (int j = 0; j < pair_sim.count(); ++j) {
+      EXPECT_NEAR(sim.cpu_data()[row_offsets[i] * 2 + j],
+                  pair_sim.cpu_data()[j], 1e-5);
+    }
+  }
+  EXPECT_NEAR(sim.cpu_data()[1], 0.0, 1e-3);
+  EXPECT_NEAR(sim.cpu_data()[2], 1.0, 1e-3);
+}
+
 TEST(AngleTest, angle_test) {
   HalfCircleAngle angle;
   angle.SetDirection(1.5f);
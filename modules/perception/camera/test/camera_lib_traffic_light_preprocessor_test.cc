@@ -18,6 +18,7 @@
 #include "gtest/gtest.h"
 #include "modules/perception/base/point.h"
 #include "modules/perception/camera/lib/traffic_light/preprocessor/tl_preprocessor.h"
+#include "modules/perception/common/perception_gflags.h"
 #include "modules/perception/common/sensor_manager/sensor_manager.h"
 
 namespace apollo {
@@ -606,6 +607,55 @@ TEST_F(TLPreprocessorTest, on_board) {
   }
 }
 
+TEST_F(TLPreprocessorTest, reuse_camera_selection) {
+  unsetenv("MODULE_PATH");
+  unsetenv("CYBER_PATH");
+  TrafficLightPreprocessorInitOptions init_options;
+  init_options.conf_file = "preprocess.pt";
+  init_options.root_dir =
+      "/apollo/modules/perception/testdata/"
+      "camera/lib/traffic_light/preprocessor/data/";
+  init_options.gpu_id = 0;
+  init_options.sync_interval_seconds = 0.5;
+  init_options.camera_names = camera_names_;
+  std::string long_cam_id = "onsemi_traffic";
+  std::string narrow_cam_id = "onsemi_narrow";
+  std::map<std::string, int> image_border_sizes = {{"onsemi_traffic", 100},
+                                                   {"onsemi_obstacle", 100},
+                                                   {"onsemi_narrow", 100},
+                                                   {"onsemi_wide", 100}};
+  ASSERT_TRUE(preprocessor_->Init(init_options));
+  ASSERT_TRUE(preprocessor_->SetCameraWorkingFlag(long_cam_id, true));
+  ASSERT_TRUE(preprocessor_->SetCameraWorkingFlag(narrow_cam_id, true));
+  FLAGS_tl_camera_selection_reuse_distance = 1.0;
+
+  TLPreprocessorOption option;
+  option.image_borders_size = &image_border_sizes;
+  CarPose pose;
+  std::vector<base::TrafficLightPtr> lights(1);
+  lights[0].reset(new base::TrafficLight);
+  PrepareTestDataLongFocus(&pose, &(lights[0]->region.points));
+  ASSERT_TRUE(preprocessor_->UpdateCameraSelection(pose, option, &lights));
+  EXPECT_TRUE(preprocessor_->SyncInformation(100, long_cam_id));
+
+  // a small move keeps the selection without projecting the lights
+  CarPose near_pose = pose;
+  near_pose.c2w_poses_[long_cam_id](0, 3) += 0.5;
+  lights[0]->region.outside_image = false;
+  ASSERT_TRUE(
+      preprocessor_->UpdateCameraSelection(near_pose, option, &lights));
+  EXPECT_FALSE(lights[0]->region.outside_image);
+  EXPECT_TRUE(preprocessor_->SyncInformation(200, long_cam_id));
+
+  // moving far away projects them again
+  CarPose far_pose = pose;
+  far_pose.c2w_poses_[long_cam_id](0, 3) += 100000;
+  ASSERT_TRUE(
+      preprocessor_->UpdateCameraSelection(far_pose, option, &lights));
+  EXPECT_TRUE(lights[0]->region.outside_image);
+  FLAGS_tl_camera_selection_reuse_distance = 0.0;
+}
+
 TEST_F(TLPreprocessorTest, UpdateLightsProjectionTest) {
   unsetenv("MODULE_PATH");
   unsetenv("CYBER_PATH");
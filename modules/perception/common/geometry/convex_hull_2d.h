@@ -17,7 +17,6 @@
 
 #include <algorithm>
 #include <limits>
-#include <numeric>
 #include <vector>
 
 #include "Eigen/Dense"
@@ -29,15 +28,15 @@ namespace common {
 template <class CLOUD_IN_TYPE, class CLOUD_OUT_TYPE>
 class ConvexHull2D {
  public:
-  ConvexHull2D() : in_cloud_(nullptr) {
+  ConvexHull2D() {
     points_.reserve(1000.0);
     polygon_indices_.reserve(1000.0);
   }
-  ~ConvexHull2D() { in_cloud_ = nullptr; }
+  ~ConvexHull2D() = default;
   // main interface to get polygon from input point cloud
   bool GetConvexHull(const CLOUD_IN_TYPE& in_cloud,
                      CLOUD_OUT_TYPE* out_polygon) {
-    SetPoints(in_cloud);
+    SetPoints(in_cloud, [](std::size_t) { return true; });
     if (!GetConvexHullMonotoneChain(out_polygon)) {
       return MockConvexHull(out_polygon);
     }
@@ -47,19 +46,14 @@ class ConvexHull2D {
   bool GetConvexHullWithoutGround(const CLOUD_IN_TYPE& in_cloud,
                                   const float& distance_above_ground_thres,
                                   CLOUD_OUT_TYPE* out_polygon) {
-    CLOUD_IN_TYPE in_cloud_without_ground;
-    in_cloud_without_ground.reserve(in_cloud.size());
-    for (std::size_t id = 0; id < in_cloud.size(); ++id) {
-      // compute point_heigh, note std::numeric_limits<float>::max() is the
-      // default value
-      if (in_cloud.points_height(id) >= distance_above_ground_thres) {
-        in_cloud_without_ground.push_back(in_cloud[id]);
-      }
-    }
-    if (in_cloud_without_ground.empty()) {
+    // compute point_heigh, note std::numeric_limits<float>::max() is the
+    // default value
+    SetPoints(in_cloud, [&](std::size_t id) {
+      return in_cloud.points_height(id) >= distance_above_ground_thres;
+    });
+    if (points_.empty()) {
       return GetConvexHull(in_cloud, out_polygon);
     } else {
-      SetPoints(in_cloud_without_ground);
       if (!GetConvexHullMonotoneChain(out_polygon)) {
         return MockConvexHull(out_polygon);
       }
@@ -71,21 +65,16 @@ class ConvexHull2D {
   bool GetConvexHullWithoutGroundAndHead(
       const CLOUD_IN_TYPE& in_cloud, const float& distance_above_ground_thres,
       const float& distance_beneath_head_thres, CLOUD_OUT_TYPE* out_polygon) {
-    CLOUD_IN_TYPE in_cloud_without_ground_and_head;
-    in_cloud_without_ground_and_head.reserve(in_cloud.size());
-    for (std::size_t id = 0; id < in_cloud.size(); ++id) {
-      // compute point_heigh, note std::numeric_limits<float>::max() is the
-      // default value
-      if (in_cloud.points_height(id) == std::numeric_limits<float>::max() ||
-          (in_cloud.points_height(id) >= distance_above_ground_thres &&
-           in_cloud.points_height(id) <= distance_beneath_head_thres)) {
-        in_cloud_without_ground_and_head.push_back(in_cloud[id]);
-      }
-    }
-    if (in_cloud_without_ground_and_head.empty()) {
+    // compute point_heigh, note std::numeric_limits<float>::max() is the
+    // default value
+    SetPoints(in_cloud, [&](std::size_t id) {
+      return in_cloud.points_height(id) == std::numeric_limits<float>::max() ||
+             (in_cloud.points_height(id) >= distance_above_ground_thres &&
+              in_cloud.points_height(id) <= distance_beneath_head_thres);
+    });
+    if (points_.empty()) {
       return GetConvexHull(in_cloud, out_polygon);
     } else {
-      SetPoints(in_cloud_without_ground_and_head);
       if (!GetConvexHullMonotoneChain(out_polygon)) {
         return MockConvexHull(out_polygon);
       }
@@ -94,8 +83,10 @@ class ConvexHull2D {
   }
 
  private:
-  // save points in local memory, and transform to double
-  void SetPoints(const CLOUD_IN_TYPE& in_cloud);
+  // project the selected points to local memory in double, and record their
+  // 3d bounds, so that the input cloud is neither copied nor read again
+  template <typename Selector>
+  void SetPoints(const CLOUD_IN_TYPE& in_cloud, const Selector& selected);
   // mock a polygon for some degenerate cases
   bool MockConvexHull(CLOUD_OUT_TYPE* out_polygon);
   // compute convex hull using Andrew's monotone chain algorithm
@@ -111,39 +102,38 @@ class ConvexHull2D {
  private:
   std::vector<Eigen::Vector2d> points_;
   std::vector<std::size_t> polygon_indices_;
-  const CLOUD_IN_TYPE* in_cloud_;
+  Eigen::Vector3d min_pt_;
+  Eigen::Vector3d max_pt_;
 };
 
 template <class CLOUD_IN_TYPE, class CLOUD_OUT_TYPE>
+template <typename Selector>
 void ConvexHull2D<CLOUD_IN_TYPE, CLOUD_OUT_TYPE>::SetPoints(
-    const CLOUD_IN_TYPE& in_cloud) {
-  points_.resize(in_cloud.size());
-  for (std::size_t i = 0; i < points_.size(); ++i) {
-    points_[i] << in_cloud[i].x, in_cloud[i].y;
+    const CLOUD_IN_TYPE& in_cloud, const Selector& selected) {
+  points_.clear();
+  min_pt_.setConstant(std::numeric_limits<double>::max());
+  max_pt_.setConstant(-std::numeric_limits<double>::max());
+  for (std::size_t i = 0; i < in_cloud.size(); ++i) {
+    if (!selected(i)) {
+      continue;
+    }
+    const auto& point = in_cloud[i];
+    points_.emplace_back(point.x, point.y);
+    const Eigen::Vector3d pt(point.x, point.y, point.z);
+    min_pt_ = min_pt_.cwiseMin(pt);
+    max_pt_ = max_pt_.cwiseMax(pt);
   }
-  in_cloud_ = &in_cloud;
 }
 
 template <class CLOUD_IN_TYPE, class CLOUD_OUT_TYPE>
 bool ConvexHull2D<CLOUD_IN_TYPE, CLOUD_OUT_TYPE>::MockConvexHull(
     CLOUD_OUT_TYPE* out_polygon) {
-  if (in_cloud_->size() == 0) {
+  if (points_.empty()) {
     return false;
   }
   out_polygon->resize(4);
-  Eigen::Matrix<double, 3, 1> maxv;
-  Eigen::Matrix<double, 3, 1> minv;
-  maxv << in_cloud_->at(0).x, in_cloud_->at(0).y, in_cloud_->at(0).z;
-  minv = maxv;
-  for (std::size_t i = 1; i < in_cloud_->size(); ++i) {
-    maxv(0) = std::max<double>(maxv(0), in_cloud_->at(i).x);
-    maxv(1) = std::max<double>(maxv(1), in_cloud_->at(i).y);
-    maxv(2) = std::max<double>(maxv(2), in_cloud_->at(i).z);
-
-    minv(0) = std::min<double>(minv(0), in_cloud_->at(i).x);
-    minv(1) = std::min<double>(minv(1), in_cloud_->at(i).y);
-    minv(2) = std::min<double>(minv(2), in_cloud_->at(i).z);
-  }
+  Eigen::Matrix<double, 3, 1> maxv = max_pt_;
+  Eigen::Matrix<double, 3, 1> minv = min_pt_;
 
   static const double eps = 1e-3;
   for (std::size_t i = 0; i < 3; ++i) {
@@ -178,17 +168,16 @@ bool ConvexHull2D<CLOUD_IN_TYPE, CLOUD_OUT_TYPE>::GetConvexHullMonotoneChain(
     return false;
   }
 
-  std::vector<std::size_t> sorted_indices(points_.size());
-  std::iota(sorted_indices.begin(), sorted_indices.end(), 0);
-
+  // sort the local copy itself, so that the chain walks the points in
+  // memory order instead of through an index array
   static const double eps = 1e-9;
-  std::sort(sorted_indices.begin(), sorted_indices.end(),
-            [&](const std::size_t& lhs, const std::size_t& rhs) {
-              double dx = points_[lhs](0) - points_[rhs](0);
+  std::sort(points_.begin(), points_.end(),
+            [&](const Eigen::Vector2d& lhs, const Eigen::Vector2d& rhs) {
+              double dx = lhs(0) - rhs(0);
               if (std::abs(dx) > eps) {
                 return dx < 0.0;
               }
-              return points_[lhs](1) < points_[rhs](1);
+              return lhs(1) < rhs(1);
             });
   int count = 0;
   int last_count = 1;
@@ -200,8 +189,7 @@ bool ConvexHull2D<CLOUD_IN_TYPE, CLOUD_OUT_TYPE>::GetConvexHullMonotoneChain(
     if (i == points_.size()) {
       last_count = count;
     }
-    const std::size_t& idx =
-        sorted_indices[(i < points_.size()) ? i : (size2 - 1 - i)];
+    const std::size_t idx = (i < points_.size()) ? i : (size2 - 1 - i);
     const auto& point = points_[idx];
     while (count > last_count &&
            !IsCounterClockWise(points_[polygon_indices_[count - 2]],
@@ -220,10 +208,7 @@ bool ConvexHull2D<CLOUD_IN_TYPE, CLOUD_OUT_TYPE>::GetConvexHullMonotoneChain(
   }
   out_polygon->clear();
   out_polygon->resize(polygon_indices_.size());
-  float min_z = static_cast<float>(in_cloud_->at(0).z);
-  for (std::size_t id = 0; id < in_cloud_->size(); ++id) {
-    min_z = std::min<float>(static_cast<float>(in_cloud_->at(id).z), min_z);
-  }
+  const float min_z = static_cast<float>(min_pt_(2));
   for (std::size_t i = 0; i < polygon_indices_.size(); ++i) {
     out_polygon->at(i).x = static_cast<float>(points_[polygon_indices_[i]](0));
     out_polygon->at(i).y = static_cast<float>(points_[polygon_indices_[i]](1));
@@ -17,8 +17,11 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
 #include <functional>
 #include <map>
+#include <memory>
+#include <numeric>
 #include <utility>
 #include <vector>
 
@@ -26,6 +29,7 @@
 
 #include "modules/perception/common/graph/connected_component_analysis.h"
 #include "modules/perception/common/graph/hungarian_optimizer.h"
+#include "modules/perception/lib/thread/thread_pool.h"
 
 namespace apollo {
 namespace perception {
@@ -36,12 +40,19 @@ class GatedHungarianMatcher {
  public:
   enum class OptimizeFlag { OPTMAX, OPTMIN };
 
-  explicit GatedHungarianMatcher(int max_matching_size = 1000) {
+  explicit GatedHungarianMatcher(int max_matching_size = 1000)
+      : max_matching_size_(max_matching_size) {
     global_costs_.Reserve(max_matching_size, max_matching_size);
-    optimizer_.costs()->Reserve(max_matching_size, max_matching_size);
+    optimizers_.emplace_back(new HungarianOptimizer<T>());
+    optimizers_[0]->costs()->Reserve(max_matching_size, max_matching_size);
   }
   ~GatedHungarianMatcher() {}
 
+  /* @brief: optimize the connected components on several threads, every one
+   * with its own optimizer. the assignments do not depend on the number of
+   * threads. */
+  void set_num_threads(int num_threads);
+
   /* @brief: global_costs is the memory we reserved for the updating of
    * costs of matching. it could & need be updated outside the matcher,
    * before each matching. use it carefully, and make sure all the
@@ -77,8 +88,15 @@ class GatedHungarianMatcher {
 
   /* Step 3:
    * optimize single connected component, which is part of the global one */
-  void OptimizeConnectedComponent(const std::vector<size_t>& row_component,
-                                  const std::vector<size_t>& col_component);
+  void OptimizeConnectedComponent(
+      const std::vector<size_t>& row_component,
+      const std::vector<size_t>& col_component, HungarianOptimizer<T>* optimizer,
+      std::vector<std::pair<size_t, size_t>>* assignments) const;
+
+  /* optimize the components taken from the shared index with the optimizer
+   * of the given thread, until all are done */
+  void OptimizeConnectedComponents(size_t thread_id,
+                                   lib::BlockingCounter* counter);
 
   /* Step 4:
    * generate the set of unassigned row or col index. */
@@ -92,13 +110,26 @@ class GatedHungarianMatcher {
    * @params[IN] col_component: the set of index of cols of sub-graph
    * @return: nothing */
   void UpdateGatingLocalCostsMat(const std::vector<size_t>& row_component,
-                                 const std::vector<size_t>& col_component);
+                                 const std::vector<size_t>& col_component,
+                                 SecureMat<T>* local_costs) const;
 
   void OptimizeAdapter(
-      std::vector<std::pair<size_t, size_t>>* local_assignments);
+      HungarianOptimizer<T>* optimizer,
+      std::vector<std::pair<size_t, size_t>>* local_assignments) const;
+
+  int max_matching_size_ = 1000;
 
-  /* Hungarian optimizer */
-  HungarianOptimizer<T> optimizer_;
+  /* Hungarian optimizer of every thread */
+  std::vector<std::unique_ptr<HungarianOptimizer<T>>> optimizers_;
+  std::unique_ptr<lib::ThreadPool> thread_pool_;
+
+  /* connected components, their assignments and the order of optimizing
+   * them, the largest first */
+  std::vector<std::vector<size_t>> row_components_;
+  std::vector<std::vector<size_t>> col_components_;
+  std::vector<std::vector<std::pair<size_t, size_t>>> component_assignments_;
+  std::vector<size_t> component_order_;
+  std::atomic<size_t> next_component_{0};
 
   /* global costs matrix */
   SecureMat<T> global_costs_;
@@ -120,6 +151,22 @@ class GatedHungarianMatcher {
   std::function<bool(T)> is_valid_cost_;
 };  // class GatedHungarianMatcher
 
+template <typename T>
+void GatedHungarianMatcher<T>::set_num_threads(int num_threads) {
+  const size_t threads_num = static_cast<size_t>(std::max(num_threads, 1));
+  while (optimizers_.size() < threads_num) {
+    optimizers_.emplace_back(new HungarianOptimizer<T>());
+    optimizers_.back()->costs()->Reserve(max_matching_size_,
+                                         max_matching_size_);
+  }
+  optimizers_.resize(threads_num);
+  thread_pool_.reset();
+  if (threads_num > 1) {
+    thread_pool_.reset(new lib::ThreadPool(static_cast<int>(threads_num) - 1));
+    thread_pool_->Start();
+  }
+}
+
 template <typename T>
 void GatedHungarianMatcher<T>::Match(
     T cost_thresh, OptimizeFlag opt_flag,
@@ -148,16 +195,44 @@ void GatedHungarianMatcher<T>::Match(
   MatchInit();
 
   /* compute components */
-  std::vector<std::vector<size_t>> row_components;
-  std::vector<std::vector<size_t>> col_components;
-  this->ComputeConnectedComponents(&row_components, &col_components);
-  CHECK_EQ(row_components.size(), col_components.size());
+  this->ComputeConnectedComponents(&row_components_, &col_components_);
+  CHECK_EQ(row_components_.size(), col_components_.size());
+
+  /* compute assignments, the costly components first so that they do not
+   * end up last on one thread */
+  const size_t components_num = row_components_.size();
+  component_assignments_.resize(components_num);
+  component_order_.resize(components_num);
+  std::iota(component_order_.begin(), component_order_.end(), 0);
+  std::stable_sort(component_order_.begin(), component_order_.end(),
+                   [this](size_t lhs, size_t rhs) {
+                     return row_components_[lhs].size() *
+                                col_components_[lhs].size() >
+                            row_components_[rhs].size() *
+                                col_components_[rhs].size();
+                   });
+  next_component_ = 0;
+  const size_t tasks_num = std::min(optimizers_.size(), components_num);
+  if (thread_pool_ == nullptr || tasks_num <= 1) {
+    this->OptimizeConnectedComponents(0, nullptr);
+  } else {
+    lib::BlockingCounter counter(tasks_num - 1);
+    for (size_t i = 1; i < tasks_num; ++i) {
+      thread_pool_->Add(google::protobuf::NewCallback(
+          this, &GatedHungarianMatcher<T>::OptimizeConnectedComponents, i,
+          &counter));
+    }
+    this->OptimizeConnectedComponents(0, nullptr);
+    counter.Wait();
+  }
 
-  /* compute assignments */
+  /* collect the assignments in the order of components */
   assignments_ptr_->clear();
   assignments_ptr_->reserve(std::max(rows_num_, cols_num_));
-  for (size_t i = 0; i < row_components.size(); ++i) {
-    this->OptimizeConnectedComponent(row_components[i], col_components[i]);
+  for (size_t i = 0; i < components_num; ++i) {
+    assignments_ptr_->insert(assignments_ptr_->end(),
+                             component_assignments_[i].begin(),
+                             component_assignments_[i].end());
   }
 
   this->GenerateUnassignedData(unassigned_rows, unassigned_cols);
@@ -220,10 +295,28 @@ void GatedHungarianMatcher<T>::ComputeConnectedComponents(
   }
 }
 
+template <typename T>
+void GatedHungarianMatcher<T>::OptimizeConnectedComponents(
+    size_t thread_id, lib::BlockingCounter* counter) {
+  HungarianOptimizer<T>* optimizer = optimizers_[thread_id].get();
+  for (size_t i = next_component_++; i < component_order_.size();
+       i = next_component_++) {
+    const size_t component = component_order_[i];
+    component_assignments_[component].clear();
+    this->OptimizeConnectedComponent(
+        row_components_[component], col_components_[component], optimizer,
+        &component_assignments_[component]);
+  }
+  if (counter != nullptr) {
+    counter->Decrement();
+  }
+}
+
 template <typename T>
 void GatedHungarianMatcher<T>::OptimizeConnectedComponent(
     const std::vector<size_t>& row_component,
-    const std::vector<size_t>& col_component) {
+    const std::vector<size_t>& col_component, HungarianOptimizer<T>* optimizer,
+    std::vector<std::pair<size_t, size_t>>* assignments) const {
   size_t local_rows_num = row_component.size();
   size_t local_cols_num = col_component.size();
 
@@ -236,17 +329,17 @@ void GatedHungarianMatcher<T>::OptimizeConnectedComponent(
     size_t idx_r = row_component[0];
     size_t idx_c = col_component[0];
     if (is_valid_cost_(global_costs_(idx_r, idx_c))) {
-      assignments_ptr_->push_back(std::make_pair(idx_r, idx_c));
+      assignments->push_back(std::make_pair(idx_r, idx_c));
     }
     return;
   }
 
   /* update local cost matrix */
-  UpdateGatingLocalCostsMat(row_component, col_component);
+  UpdateGatingLocalCostsMat(row_component, col_component, optimizer->costs());
 
   /* get local assignments */
   std::vector<std::pair<size_t, size_t>> local_assignments;
-  OptimizeAdapter(&local_assignments);
+  OptimizeAdapter(optimizer, &local_assignments);
 
   /* parse local assginments into global ones */
   for (size_t i = 0; i < local_assignments.size(); ++i) {
@@ -256,7 +349,7 @@ void GatedHungarianMatcher<T>::OptimizeConnectedComponent(
     if (!is_valid_cost_(global_costs_(global_row_idx, global_col_idx))) {
       continue;
     }
-    assignments_ptr_->push_back(std::make_pair(global_row_idx, global_col_idx));
+    assignments->push_back(std::make_pair(global_row_idx, global_col_idx));
   }
 }
 
@@ -291,13 +384,14 @@ void GatedHungarianMatcher<T>::GenerateUnassignedData(
 template <typename T>
 void GatedHungarianMatcher<T>::UpdateGatingLocalCostsMat(
     const std::vector<size_t>& row_component,
-    const std::vector<size_t>& col_component) {
+    const std::vector<size_t>& col_component,
+    SecureMat<T>* local_costs) const {
   /* set the invalid cost to bound value */
-  SecureMat<T>* local_costs = optimizer_.costs();
   local_costs->Resize(row_component.size(), col_component.size());
   for (size_t i = 0; i < row_component.size(); ++i) {
     for (size_t j = 0; j < col_component.size(); ++j) {
-      T& current_cost = global_costs_(row_component[i], col_component[j]);
+      const T& current_cost =
+          global_costs_(row_component[i], col_component[j]);
       if (is_valid_cost_(current_cost)) {
         (*local_costs)(i, j) = current_cost;
       } else {
@@ -309,12 +403,13 @@ void GatedHungarianMatcher<T>::UpdateGatingLocalCostsMat(
 
 template <typename T>
 void GatedHungarianMatcher<T>::OptimizeAdapter(
-    std::vector<std::pair<size_t, size_t>>* local_assignments) {
+    HungarianOptimizer<T>* optimizer,
+    std::vector<std::pair<size_t, size_t>>* local_assignments) const {
   CHECK_NOTNULL(local_assignments);
   if (opt_flag_ == OptimizeFlag::OPTMAX) {
-    optimizer_.Maximize(local_assignments);
+    optimizer->Maximize(local_assignments);
   } else {
-    optimizer_.Minimize(local_assignments);
+    optimizer->Minimize(local_assignments);
   }
 }
 
@@ -16,6 +16,8 @@
 
 #include "modules/perception/common/graph/gated_hungarian_bigraph_matcher.h"
 
+#include <random>
+
 #include "Eigen/Core"
 #include "gtest/gtest.h"
 
@@ -551,6 +553,53 @@ TEST_F(GatedHungarianMatcherTest, test_Match_Maximize) {
   EXPECT_EQ(0, unassigned_rows.size());
 }
 
+TEST_F(GatedHungarianMatcherTest, test_Match_MultiThreads) {
+  // tracks and objects spread along a road, only gated with close ones
+  const size_t size = 300;
+  std::mt19937 rng(0);
+  std::uniform_real_distribution<float> offset(-1.5f, 1.5f);
+  std::vector<float> rows_pos(size);
+  std::vector<float> cols_pos(size);
+  for (size_t i = 0; i < size; ++i) {
+    rows_pos[i] = static_cast<float>(i) + offset(rng);
+    cols_pos[i] = static_cast<float>(i) + offset(rng);
+  }
+  GatedHungarianMatcher<float> multi_threads_optimizer(1000);
+  multi_threads_optimizer.set_num_threads(4);
+  for (auto* matcher : {optimizer_, &multi_threads_optimizer}) {
+    SecureMat<float>* global_costs = matcher->mutable_global_costs();
+    global_costs->Resize(size, size);
+    for (size_t i = 0; i < size; ++i) {
+      for (size_t j = 0; j < size; ++j) {
+        (*global_costs)(i, j) = std::abs(rows_pos[i] - cols_pos[j]);
+      }
+    }
+  }
+
+  GatedHungarianMatcher<float>::OptimizeFlag opt_flag =
+      GatedHungarianMatcher<float>::OptimizeFlag::OPTMIN;
+  float cost_thresh = 2.0f;
+  float bound_value = 10.0f;
+  std::vector<std::pair<size_t, size_t>> assignments;
+  std::vector<size_t> unassigned_rows;
+  std::vector<size_t> unassigned_cols;
+  optimizer_->Match(cost_thresh, bound_value, opt_flag, &assignments,
+                    &unassigned_rows, &unassigned_cols);
+  std::vector<std::pair<size_t, size_t>> multi_threads_assignments;
+  std::vector<size_t> multi_threads_unassigned_rows;
+  std::vector<size_t> multi_threads_unassigned_cols;
+  // match twice to reuse the components of the last frame
+  for (int k = 0; k < 2; ++k) {
+    multi_threads_optimizer.Match(
+        cost_thresh, bound_value, opt_flag, &multi_threads_assignments,
+        &multi_threads_unassigned_rows, &multi_threads_unassigned_cols);
+    EXPECT_GT(assignments.size(), size / 2);
+    EXPECT_EQ(assignments, multi_threads_assignments);
+    EXPECT_EQ(unassigned_rows, multi_threads_unassigned_rows);
+    EXPECT_EQ(unassigned_cols, multi_threads_unassigned_cols);
+  }
+}
+
 }  // namespace common
 }  // namespace perception
 }  // namespace apollo
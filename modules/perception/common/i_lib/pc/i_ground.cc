@@ -44,6 +44,7 @@ void PlaneFitGroundDetectorParam::SetDefault() {
   nr_ransac_iter_threshold = 32;
   candidate_filter_threshold = 1.0f;  // 1 meter
   nr_smooth_iter = 1;
+  nr_threads = 1;
 }
 
 bool PlaneFitGroundDetectorParam::Validate() const {
@@ -51,6 +52,7 @@ bool PlaneFitGroundDetectorParam::Validate() const {
       nr_grids_coarse > nr_grids_fine || nr_points_max == 0 ||
       nr_samples_min_threshold == 0 || nr_samples_max_threshold == 0 ||
       nr_inliers_min_threshold == 0 || nr_ransac_iter_threshold == 0 ||
+      nr_threads == 0 ||
       roi_region_rad_x <= 0.f || roi_region_rad_y <= 0.f ||
       roi_region_rad_z <= 0.f ||
       planefit_dist_threshold_near > planefit_dist_threshold_far) {
@@ -129,6 +131,64 @@ void PlaneFitGroundDetector::InitOrderTable(const VoxelGridXY<float> *vg,
   }
 }
 
+void PlaneFitGroundDetector::InitFitWaves() {
+  const int nr_grids = static_cast<int>(param_.nr_grids_coarse);
+  // a grid is fitted after its neighbors preceding it in the order table
+  std::vector<int> waves(nr_grids * nr_grids, -1);
+  fit_waves_.clear();
+  for (unsigned int i = 0; i < vg_coarse_->NrVoxel(); ++i) {
+    const int r = order_table_[i].first;
+    const int c = order_table_[i].second;
+    int wave = 0;
+    for (int r_n = IMax(0, r - 1); r_n <= IMin(nr_grids - 1, r + 1); ++r_n) {
+      for (int c_n = IMax(0, c - 1); c_n <= IMin(nr_grids - 1, c + 1);
+           ++c_n) {
+        if (waves[r_n * nr_grids + c_n] >= 0) {
+          wave = IMax(wave, waves[r_n * nr_grids + c_n] + 1);
+        }
+      }
+    }
+    waves[r * nr_grids + c] = wave;
+    if (static_cast<int>(fit_waves_.size()) <= wave) {
+      fit_waves_.resize(wave + 1);
+    }
+    fit_waves_[wave].push_back(order_table_[i]);
+  }
+}
+
+namespace {
+
+struct ParallelForContext {
+  const std::function<void(unsigned int)> *task;
+  lib::BlockingCounter *counter;
+};
+
+void RunParallelForTask(ParallelForContext *context, unsigned int id) {
+  (*context->task)(id);
+  context->counter->Decrement();
+}
+
+}  // namespace
+
+void PlaneFitGroundDetector::ParallelFor(
+    unsigned int nr_tasks, const std::function<void(unsigned int)> &task) {
+  if (thread_pool_ == nullptr || nr_tasks <= 1) {
+    for (unsigned int i = 0; i < nr_tasks; ++i) {
+      task(i);
+    }
+    return;
+  }
+  lib::BlockingCounter counter(nr_tasks);
+  ParallelForContext context = {&task, &counter};
+  for (unsigned int i = 1; i < nr_tasks; ++i) {
+    thread_pool_->Add(
+        google::protobuf::NewCallback(&RunParallelForTask, &context, i));
+  }
+  task(0);
+  counter.Decrement();
+  counter.Wait();
+}
+
 bool PlaneFitGroundDetector::Init() {
   unsigned int r = 0;
   unsigned int c = 0;
@@ -166,6 +226,7 @@ bool PlaneFitGroundDetector::Init() {
   // Init order lookup table
   order_table_ = IAlloc<std::pair<int, int>>(vg_fine_->NrVoxel());
   InitOrderTable(vg_coarse_, order_table_);
+  InitFitWaves();
 
   // ground plane:
   ground_planes_ =
@@ -207,14 +268,20 @@ bool PlaneFitGroundDetector::Init() {
       local_candis_[r][c].Reserve(capacity);
     }
   }
-  // threeds in ransac, in inhomogeneous coordinates:
-  pf_threeds_ =
-      IAllocAligned<float>(param_.nr_samples_max_threshold * dim_point_, 4);
+  // threeds in ransac, in inhomogeneous coordinates, one block per thread:
+  pf_threeds_ = IAllocAligned<float>(
+      param_.nr_samples_max_threshold * dim_point_ * param_.nr_threads, 4);
   if (!pf_threeds_) {
     return false;
   }
   memset(reinterpret_cast<void *>(pf_threeds_), 0,
-         param_.nr_samples_max_threshold * dim_point_ * sizeof(float));
+         param_.nr_samples_max_threshold * dim_point_ * param_.nr_threads *
+             sizeof(float));
+  // the caller is one of the threads
+  if (param_.nr_threads > 1 && thread_pool_ == nullptr) {
+    thread_pool_ = new lib::ThreadPool(param_.nr_threads - 1);
+    thread_pool_->Start();
+  }
   // labels:
   labels_ = IAllocAligned<char>(param_.nr_points_max, 4);
   if (!labels_) {
@@ -279,6 +346,10 @@ void PlaneFitGroundDetector::CleanUp() {
   IFreeAligned<int>(&sampled_indices_);
   IFree2<float>(&pf_thresholds_);
   IFree<std::pair<int, int>>(&order_table_);
+  if (thread_pool_) {
+    delete thread_pool_;
+    thread_pool_ = nullptr;
+  }
 }
 
 int PlaneFitGroundDetector::CompareZ(const float *point_cloud,
@@ -810,7 +881,8 @@ inline float calculate_two_angles(const GroundPlaneLiDAR &p1,
 
 int PlaneFitGroundDetector::FitGridWithNeighbors(
     int r, int c, const float *point_cloud, GroundPlaneLiDAR *groundplane,
-    unsigned int nr_points, unsigned int nr_point_element, float dist_thre) {
+    unsigned int nr_points, unsigned int nr_point_element, float dist_thre,
+    float *pf_threeds) {
   // initialize the best plane
   groundplane->ForceInvalid();
   // not enough samples, failed and return
@@ -850,7 +922,7 @@ int PlaneFitGroundDetector::FitGridWithNeighbors(
   float samples[9];
   // copy 3D points
   float *psrc = nullptr;
-  float *pdst = pf_threeds_;
+  float *pdst = pf_threeds;
   int r_n = 0;
   int c_n = 0;
   float angle = -1.f;
@@ -863,9 +935,9 @@ int PlaneFitGroundDetector::FitGridWithNeighbors(
   for (int i = 0; i < param_.nr_ransac_iter_threshold; ++i) {
     IRandomSample(indices_trial, 3, nr_samples, &rseed);
     IScale3(indices_trial, dim_point_);
-    ICopy3(pf_threeds_ + indices_trial[0], samples);
-    ICopy3(pf_threeds_ + indices_trial[1], samples + 3);
-    ICopy3(pf_threeds_ + indices_trial[2], samples + 6);
+    ICopy3(pf_threeds + indices_trial[0], samples);
+    ICopy3(pf_threeds + indices_trial[1], samples + 3);
+    ICopy3(pf_threeds + indices_trial[2], samples + 6);
     IPlaneFitDestroyed(samples, hypothesis[i].params);
     // check if the plane hypothesis has valid geometry
     if (hypothesis[i].GetDegreeNormalToZ() > param_.planefit_orien_threshold) {
@@ -873,7 +945,7 @@ int PlaneFitGroundDetector::FitGridWithNeighbors(
     }
     // iterate samples and check if the point to plane distance is below
     // threshold
-    psrc = pf_threeds_;
+    psrc = pf_threeds;
     nr_inliers = 0;
     for (int j = 0; j < nr_samples; ++j) {
       ptp_dist = IPlaneToPointDistanceWUnitNorm(hypothesis[i].params, psrc);
@@ -896,7 +968,7 @@ int PlaneFitGroundDetector::FitGridWithNeighbors(
     if (ground_planes_[r_n][c_n].IsValid()) {
       hypothesis[i + param_.nr_ransac_iter_threshold] =
           ground_planes_[r_n][c_n];
-      psrc = pf_threeds_;
+      psrc = pf_threeds;
       nr_inliers = 0;
       for (int j = 0; j < nr_samples; ++j) {
         ptp_dist = IPlaneToPointDistanceWUnitNorm(
@@ -949,8 +1021,8 @@ int PlaneFitGroundDetector::FitGridWithNeighbors(
   // iterate samples and check if the point to plane distance is within
   // threshold
   nr_inliers = 0;
-  psrc = pf_threeds_;
-  pdst = pf_threeds_;
+  psrc = pf_threeds;
+  pdst = pf_threeds;
   for (int i = 0; i < nr_samples; ++i) {
     ptp_dist = IPlaneToPointDistanceWUnitNorm(groundplane->params, psrc);
     if (ptp_dist < dist_thre) {
@@ -962,8 +1034,8 @@ int PlaneFitGroundDetector::FitGridWithNeighbors(
   }
   groundplane->SetNrSupport(nr_inliers);
 
-  // note that pf_threeds_ will be destroyed after calling this routine
-  IPlaneFitTotalLeastSquare(pf_threeds_, groundplane->params, nr_inliers);
+  // note that pf_threeds will be destroyed after calling this routine
+  IPlaneFitTotalLeastSquare(pf_threeds, groundplane->params, nr_inliers);
   if (angle_best <= CalculateAngleDist(*groundplane, neighbors)) {
     *groundplane = hypothesis[best];
     groundplane->SetStatus(true);
@@ -1010,32 +1082,45 @@ float PlaneFitGroundDetector::CalculateAngleDist(
 }
 
 int PlaneFitGroundDetector::FitInOrder() {
-  int nr_grids = 0;
   unsigned int i = 0;
   unsigned int j = 0;
-  int r = 0;
-  int c = 0;
-  GroundPlaneLiDAR gp;
   for (i = 0; i < param_.nr_grids_coarse; ++i) {
     for (j = 0; j < param_.nr_grids_coarse; ++j) {
       ground_z_[i][j].first = 0.f;
       ground_z_[i][j].second = false;
     }
   }
-  for (i = 0; i < vg_coarse_->NrVoxel(); ++i) {
-    r = order_table_[i].first;
-    c = order_table_[i].second;
-    if (FitGridWithNeighbors(
-            r, c, vg_coarse_->const_data(), &gp, vg_coarse_->NrPoints(),
-            vg_coarse_->NrPointElement(), pf_thresholds_[r][c]) >=
-        static_cast<int>(param_.nr_inliers_min_threshold)) {
-      IPlaneEucliToSpher(gp, &ground_planes_sphe_[r][c]);
-      ground_planes_[r][c] = gp;
-      nr_grids++;
-    } else {
-      ground_planes_sphe_[r][c].ForceInvalid();
-      ground_planes_[r][c].ForceInvalid();
-    }
+  // grids of a wave only read the planes of earlier waves, the count of each
+  // thread is summed in order
+  std::vector<int> nr_grids_threads(param_.nr_threads, 0);
+  for (const auto &wave : fit_waves_) {
+    const unsigned int nr_tasks =
+        IMin(param_.nr_threads, static_cast<unsigned int>(wave.size()));
+    ParallelFor(nr_tasks, [&](unsigned int id) {
+      float *pf_threeds =
+          pf_threeds_ + id * param_.nr_samples_max_threshold * dim_point_;
+      GroundPlaneLiDAR gp;
+      for (size_t k = id; k < wave.size(); k += nr_tasks) {
+        const int r = wave[k].first;
+        const int c = wave[k].second;
+        if (FitGridWithNeighbors(r, c, vg_coarse_->const_data(), &gp,
+                                 vg_coarse_->NrPoints(),
+                                 vg_coarse_->NrPointElement(),
+                                 pf_thresholds_[r][c], pf_threeds) >=
+            static_cast<int>(param_.nr_inliers_min_threshold)) {
+          IPlaneEucliToSpher(gp, &ground_planes_sphe_[r][c]);
+          ground_planes_[r][c] = gp;
+          nr_grids_threads[id]++;
+        } else {
+          ground_planes_sphe_[r][c].ForceInvalid();
+          ground_planes_[r][c].ForceInvalid();
+        }
+      }
+    });
+  }
+  int nr_grids = 0;
+  for (i = 0; i < param_.nr_threads; ++i) {
+    nr_grids += nr_grids_threads[i];
   }
   return nr_grids;
 }
@@ -1214,16 +1299,23 @@ int PlaneFitGroundDetector::SmoothGrid(const GroundPlaneSpherical &g,
 }
 
 int PlaneFitGroundDetector::Smooth() {
-  int nr_grids = 0;
   unsigned int r = 0;
   unsigned int c = 0;
   unsigned int nm1 = param_.nr_grids_coarse - 1;
   assert(param_.nr_grids_coarse >= 2);
-  nr_grids += SmoothLine(0, 0, 1);
-  for (r = 1; r < nm1; ++r) {
-    nr_grids += SmoothLine(r - 1, r, r + 1);
+  // lines only read the spherical planes and write their own planes
+  const unsigned int nr_tasks = IMin(param_.nr_threads, param_.nr_grids_coarse);
+  std::vector<int> nr_grids_threads(nr_tasks, 0);
+  ParallelFor(nr_tasks, [&](unsigned int id) {
+    for (unsigned int line = id; line <= nm1; line += nr_tasks) {
+      nr_grids_threads[id] +=
+          SmoothLine(line == 0 ? 0 : line - 1, line, IMin(line + 1, nm1));
+    }
+  });
+  int nr_grids = 0;
+  for (r = 0; r < nr_tasks; ++r) {
+    nr_grids += nr_grids_threads[r];
   }
-  nr_grids += SmoothLine(nm1 - 1, nm1, nm1);
   for (r = 0; r < param_.nr_grids_coarse; ++r) {
     for (c = 0; c < param_.nr_grids_coarse; ++c) {
       IPlaneEucliToSpher(ground_planes_[r][c], &ground_planes_sphe_[r][c]);
@@ -15,6 +15,7 @@
  *****************************************************************************/
 #pragma once
 
+#include <functional>
 #include <utility>
 #include <vector>
 
@@ -22,6 +23,7 @@
 #include "modules/perception/common/i_lib/core/i_rand.h"
 #include "modules/perception/common/i_lib/geometry/i_plane.h"
 #include "modules/perception/common/i_lib/pc/i_struct_s.h"
+#include "modules/perception/lib/thread/thread_pool.h"
 
 namespace apollo {
 namespace perception {
@@ -189,6 +191,8 @@ struct PlaneFitGroundDetectorParam {
   float candidate_filter_threshold;
   int nr_ransac_iter_threshold;
   int nr_smooth_iter;
+  // threads fitting and smoothing the coarse grid, including the caller
+  unsigned int nr_threads;
 };
 
 struct PlaneFitPointCandIndices {
@@ -270,7 +274,15 @@ class PlaneFitGroundDetector : public BaseGroundDetector {
   int FitGridWithNeighbors(int r, int c, const float *point_cloud,
                            GroundPlaneLiDAR *groundplane,
                            unsigned int nr_points,
-                           unsigned int nr_point_element, float dist_thre);
+                           unsigned int nr_point_element, float dist_thre,
+                           float *pf_threeds);
+  // group the coarse grids into waves fitted one after another, no two grids
+  // of a wave are neighbors, so that a wave is fitted in parallel with the
+  // same result as fitting the grids one by one in the order table
+  void InitFitWaves();
+  // run task(0) ... task(nr_tasks - 1) on the thread pool and the caller
+  void ParallelFor(unsigned int nr_tasks,
+                   const std::function<void(unsigned int)> &task);
   void GetNeighbors(int r, int c, int rows, int cols,
                     std::vector<std::pair<int, int>> *neighbors);
   float CalculateAngleDist(const GroundPlaneLiDAR &plane,
@@ -320,6 +332,8 @@ class PlaneFitGroundDetector : public BaseGroundDetector {
   float *pf_threeds_;
   int *sampled_indices_;
   std::pair<int, int> *order_table_;
+  std::vector<std::vector<std::pair<int, int>>> fit_waves_;
+  lib::ThreadPool *thread_pool_ = nullptr;
 };
 
 }  // namespace common
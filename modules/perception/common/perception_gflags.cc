@@ -81,5 +81,64 @@ DEFINE_double(score_threshold, 0.5, "Classification score threshold.");
 DEFINE_double(nms_overlap_threshold, 0.5, "Nms overlap threshold.");
 DEFINE_int32(num_output_box_feature, 7, "Length of output box feature.");
 
+// hdmap_input
+DEFINE_bool(enable_hdmap_local_cache, false,
+            "Cache the converted road and junction polygons around the "
+            "vehicle across frames, and only convert the ones entering it.");
+DEFINE_double(hdmap_local_cache_margin, 30.0,
+              "Distance in meters the vehicle may move before the local map "
+              "is queried from the hdmap again.");
+
+// lidar_hdmap_roi_filter
+DEFINE_double(hdmap_roi_filter_cache_margin, 10.0,
+              "Distance in meters the vehicle may move before the roi bitmap "
+              "is rasterized again.");
+
+// lidar_spatio_temporal_ground_detector
+DEFINE_int32(ground_detector_num_threads, 1,
+             "Number of threads fitting the ground planes of the grid.");
+
+// lidar_object_builder
+DEFINE_int32(object_builder_num_threads, 1,
+             "Number of threads building the segmented objects.");
+
+// association
+DEFINE_int32(hungarian_matcher_num_threads, 1,
+             "Number of threads matching the connected components of the "
+             "tracks and objects.");
+DEFINE_int32(track_object_distance_num_threads, 1,
+             "Number of threads computing the track object distances of the "
+             "fusion association.");
+
+// lidar_multi_lidar_fusion
+DEFINE_int32(mlf_engine_num_threads, 1,
+             "Number of threads filtering the tracks of the multi lidar "
+             "fusion tracker.");
+
+// inference_tensorrt
+DEFINE_string(trt_engine_cache_dir, "",
+              "Directory caching the serialized TensorRT engines, which are "
+              "built at start up if empty.");
+DEFINE_bool(trt_fp16_mode, false,
+            "Run TensorRT networks in FP16 if INT8 is not available.");
+
+// camera_traffic_light
+DEFINE_int32(tl_classify_max_batch_size, 8,
+             "Max number of lights recognized in one network call.");
+DEFINE_double(tl_camera_selection_reuse_distance, 0.0,
+              "Distance in meters the cameras may move before the lights are "
+              "projected again to select the camera. 0 projects every time.");
+DEFINE_double(tl_camera_selection_reuse_angle, 0.1,
+              "Angle in degrees the cameras may turn before the lights are "
+              "projected again to select the camera.");
+
+// camera_lane
+DEFINE_bool(lane_postprocessor_use_gpu, false,
+            "Compute the lane pixels and edges of the lane postprocessors on "
+            "the gpu, and only copy those back.");
+DEFINE_int32(lane_postprocessor_num_threads, 1,
+             "Number of threads computing the lane pixels and edges of the "
+             "lane postprocessors on the cpu.");
+
 }  // namespace perception
 }  // namespace apollo
@@ -55,5 +55,38 @@ DECLARE_double(score_threshold);
 DECLARE_double(nms_overlap_threshold);
 DECLARE_int32(num_output_box_feature);
 
+// hdmap_input
+DECLARE_bool(enable_hdmap_local_cache);
+DECLARE_double(hdmap_local_cache_margin);
+
+// lidar_hdmap_roi_filter
+DECLARE_double(hdmap_roi_filter_cache_margin);
+
+// lidar_spatio_temporal_ground_detector
+DECLARE_int32(ground_detector_num_threads);
+
+// lidar_object_builder
+DECLARE_int32(object_builder_num_threads);
+
+// association
+DECLARE_int32(hungarian_matcher_num_threads);
+DECLARE_int32(track_object_distance_num_threads);
+
+// lidar_multi_lidar_fusion
+DECLARE_int32(mlf_engine_num_threads);
+
+// inference_tensorrt
+DECLARE_string(trt_engine_cache_dir);
+DECLARE_bool(trt_fp16_mode);
+
+// camera_traffic_light
+DECLARE_int32(tl_classify_max_batch_size);
+DECLARE_double(tl_camera_selection_reuse_distance);
+DECLARE_double(tl_camera_selection_reuse_angle);
+
+// camera_lane
+DECLARE_bool(lane_postprocessor_use_gpu);
+DECLARE_int32(lane_postprocessor_num_threads);
+
 }  // namespace perception
 }  // namespace apollo
@@ -31,10 +31,13 @@ void Sensor::QueryLatestFrames(double timestamp,
   }
 
   frames->clear();
-  for (size_t i = 0; i < frames_.size(); ++i) {
-    if (frames_[i]->GetTimestamp() > latest_query_timestamp_ &&
-        frames_[i]->GetTimestamp() <= timestamp) {
-      frames->push_back(frames_[i]);
+  frames_.Trim();
+  const size_t num_frames = frames_.size();
+  for (size_t i = 0; i < num_frames; ++i) {
+    const SensorFramePtr& frame = frames_.at(i);
+    if (frame->GetTimestamp() > latest_query_timestamp_ &&
+        frame->GetTimestamp() <= timestamp) {
+      frames->push_back(frame);
     }
   }
   latest_query_timestamp_ = timestamp;
@@ -42,11 +45,14 @@ void Sensor::QueryLatestFrames(double timestamp,
 
 SensorFramePtr Sensor::QueryLatestFrame(double timestamp) {
   SensorFramePtr latest_frame = nullptr;
-  for (size_t i = 0; i < frames_.size(); ++i) {
-    if (frames_[i]->GetTimestamp() > latest_query_timestamp_ &&
-        frames_[i]->GetTimestamp() <= timestamp) {
-      latest_frame = frames_[i];
-      latest_query_timestamp_ = frames_[i]->GetTimestamp();
+  frames_.Trim();
+  const size_t num_frames = frames_.size();
+  for (size_t i = 0; i < num_frames; ++i) {
+    const SensorFramePtr& frame = frames_.at(i);
+    if (frame->GetTimestamp() > latest_query_timestamp_ &&
+        frame->GetTimestamp() <= timestamp) {
+      latest_frame = frame;
+      latest_query_timestamp_ = frame->GetTimestamp();
     }
   }
   return latest_frame;
@@ -57,10 +63,11 @@ bool Sensor::GetPose(double timestamp, Eigen::Affine3d* pose) const {
     AERROR << "pose is not available";
     return false;
   }
+  // only the queries trim, the association calls this from several threads
   for (int i = static_cast<int>(frames_.size()) - 1; i >= 0; --i) {
-    double time_diff = timestamp - frames_[i]->GetTimestamp();
+    double time_diff = timestamp - frames_.at(i)->GetTimestamp();
     if (fabs(time_diff) < 1.0e-3) {  // > ?
-      return frames_[i]->GetPose(pose);
+      return frames_.at(i)->GetPose(pose);
     }
   }
 
@@ -70,10 +77,10 @@ bool Sensor::GetPose(double timestamp, Eigen::Affine3d* pose) const {
 
 void Sensor::AddFrame(const base::FrameConstPtr& frame_ptr) {
   SensorFramePtr frame(new SensorFrame(frame_ptr));
-  if (frames_.size() == kMaxCachedFrameNum) {
-    frames_.pop_front();
+  if (!frames_.Push(frame)) {
+    AWARN << "Drop frame of " << sensor_info_.name
+          << ", frames are not queried in time.";
   }
-  frames_.emplace_back(frame);
 }
 
 }  // namespace fusion
@@ -16,7 +16,6 @@
 
 #pragma once
 
-#include <deque>
 #include <memory>
 #include <string>
 #include <vector>
@@ -26,6 +25,7 @@
 #include "modules/perception/base/sensor_meta.h"
 #include "modules/perception/fusion/base/base_forward_declaration.h"
 #include "modules/perception/fusion/base/sensor_frame.h"
+#include "modules/perception/fusion/base/sensor_frame_ring.h"
 
 namespace apollo {
 namespace perception {
@@ -36,7 +36,7 @@ class Sensor {
   Sensor() = delete;
 
   explicit Sensor(const base::SensorInfo& sensor_info)
-      : sensor_info_(sensor_info) {}
+      : sensor_info_(sensor_info), frames_(kMaxCachedFrameNum) {}
 
   // query frames whose time stamp is in range
   // (_latest_fused_time_stamp, time_stamp]
@@ -46,6 +46,8 @@ class Sensor {
   // (_latest_fused_time_stamp, time_stamp]
   SensorFramePtr QueryLatestFrame(double timestamp);
 
+  // @brief pose of a frame kept by the latest query, may be called by
+  //        several threads at once but not concurrently with the queries
   bool GetPose(double timestamp, Eigen::Affine3d* pose) const;
 
   // Getter
@@ -54,8 +56,11 @@ class Sensor {
   // Getter
   inline base::SensorType GetSensorType() const { return sensor_info_.type; }
 
+  // frames are added by one thread and queried by another one without a
+  // lock, the queries must not run concurrently with each other
   void AddFrame(const base::FrameConstPtr& frame_ptr);
 
+  // @brief takes effect for sensors created afterwards
   inline static void SetMaxCachedFrameNumber(size_t number) {
     kMaxCachedFrameNum = number;
   }
@@ -71,7 +76,7 @@ class Sensor {
 
   double latest_query_timestamp_ = 0.0;
 
-  std::deque<SensorFramePtr> frames_;
+  SensorFrameRing frames_;
 
   static size_t kMaxCachedFrameNum;
 };
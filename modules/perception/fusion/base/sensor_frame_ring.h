@@ -0,0 +1,97 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+#include "modules/perception/fusion/base/base_forward_declaration.h"
+
+namespace apollo {
+namespace perception {
+namespace fusion {
+
+// @brief Frames of one sensor, written by the thread adding measurements
+// and read by the fusing thread without a lock.
+// The ring has twice as many slots as frames are kept. The producer only
+// writes free slots and publishes them with head_. The consumer only reads
+// slots in [tail_, head_), and frees the frames older than the newest
+// capacity ones by advancing tail_. So no slot is ever read and written at
+// the same time, and the slots are allocated once. Several threads may read
+// the kept frames at once, as long as only one of them trims.
+class SensorFrameRing {
+ public:
+  explicit SensorFrameRing(size_t capacity)
+      : capacity_(std::max(capacity, static_cast<size_t>(1))),
+        slots_(2 * capacity_) {}
+
+  SensorFrameRing(const SensorFrameRing&) = delete;
+  SensorFrameRing& operator=(const SensorFrameRing&) = delete;
+
+  // @brief producer: append a frame, false if the consumer fell so far
+  //        behind that all slots are in use
+  bool Push(const SensorFramePtr& frame) {
+    const size_t head = head_.load(std::memory_order_relaxed);
+    if (head - tail_.load(std::memory_order_acquire) == slots_.size()) {
+      return false;
+    }
+    slots_[head % slots_.size()] = frame;
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  // @brief consumer: release the frames older than the newest capacity ones
+  void Trim() const {
+    const size_t head = head_.load(std::memory_order_acquire);
+    size_t tail = tail_.load(std::memory_order_relaxed);
+    while (head - tail > capacity_) {
+      slots_[tail % slots_.size()].reset();
+      ++tail;
+    }
+    tail_.store(tail, std::memory_order_release);
+  }
+
+  // @brief consumer: number of frames kept, at most capacity
+  size_t size() const {
+    return std::min(head_.load(std::memory_order_acquire) -
+                        tail_.load(std::memory_order_relaxed),
+                    capacity_);
+  }
+
+  // @brief consumer: the index-th frame from the oldest one, valid for
+  //        index < size() after Trim()
+  const SensorFramePtr& at(size_t index) const {
+    return slots_[(tail_.load(std::memory_order_relaxed) + index) %
+                  slots_.size()];
+  }
+
+  size_t capacity() const { return capacity_; }
+
+ private:
+  const size_t capacity_;
+  // written by the producer in [head_, tail_ + slots), by the consumer when
+  // freeing frames in [tail_, head_)
+  mutable std::vector<SensorFramePtr> slots_;
+  // next slot to write, only stored by the producer
+  std::atomic<size_t> head_{0};
+  // oldest frame kept, only stored by the consumer
+  mutable std::atomic<size_t> tail_{0};
+};
+
+}  // namespace fusion
+}  // namespace perception
+}  // namespace apollo
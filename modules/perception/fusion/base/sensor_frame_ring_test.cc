@@ -0,0 +1,91 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#include "modules/perception/fusion/base/sensor_frame_ring.h"
+
+#include <algorithm>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+#include "modules/perception/fusion/base/sensor_frame.h"
+
+namespace apollo {
+namespace perception {
+namespace fusion {
+
+namespace {
+
+SensorFramePtr MakeFrame(double timestamp) {
+  base::FramePtr base_frame(new base::Frame());
+  base_frame->timestamp = timestamp;
+  return SensorFramePtr(new SensorFrame(base_frame));
+}
+
+}  // namespace
+
+TEST(SensorFrameRingTest, test) {
+  SensorFrameRing ring(2);
+  EXPECT_EQ(ring.capacity(), 2);
+  EXPECT_EQ(ring.size(), 0);
+  EXPECT_TRUE(ring.Push(MakeFrame(1.0)));
+  EXPECT_TRUE(ring.Push(MakeFrame(2.0)));
+  EXPECT_TRUE(ring.Push(MakeFrame(3.0)));
+  EXPECT_EQ(ring.size(), 2);
+  EXPECT_TRUE(ring.Push(MakeFrame(4.0)));
+  // all slots hold frames the consumer has not seen
+  EXPECT_FALSE(ring.Push(MakeFrame(5.0)));
+
+  ring.Trim();
+  EXPECT_EQ(ring.size(), 2);
+  EXPECT_DOUBLE_EQ(ring.at(0)->GetTimestamp(), 3.0);
+  EXPECT_DOUBLE_EQ(ring.at(1)->GetTimestamp(), 4.0);
+  EXPECT_TRUE(ring.Push(MakeFrame(6.0)));
+  ring.Trim();
+  EXPECT_DOUBLE_EQ(ring.at(0)->GetTimestamp(), 4.0);
+  EXPECT_DOUBLE_EQ(ring.at(1)->GetTimestamp(), 6.0);
+}
+
+TEST(SensorFrameRingTest, concurrent_test) {
+  SensorFrameRing ring(4);
+  const int num_frames = 10000;
+  std::thread producer([&ring, num_frames]() {
+    for (int i = 1; i <= num_frames;) {
+      if (ring.Push(MakeFrame(static_cast<double>(i)))) {
+        ++i;
+      } else {
+        std::this_thread::yield();
+      }
+    }
+  });
+  double last_timestamp = 0.0;
+  while (last_timestamp < num_frames) {
+    ring.Trim();
+    const size_t size = ring.size();
+    for (size_t i = 0; i < size; ++i) {
+      const double timestamp = ring.at(i)->GetTimestamp();
+      // the newest frames are kept in order
+      if (i > 0) {
+        EXPECT_DOUBLE_EQ(timestamp, ring.at(i - 1)->GetTimestamp() + 1.0);
+      }
+      last_timestamp = std::max(last_timestamp, timestamp);
+    }
+  }
+  producer.join();
+}
+
+}  // namespace fusion
+}  // namespace perception
+}  // namespace apollo
@@ -25,9 +25,8 @@ TEST(SensorTest, test) {
   base::SensorInfo sensor_info;
   sensor_info.name = "test";
   sensor_info.type = base::SensorType::VELODYNE_64;
-  SensorPtr sensor_ptr(new Sensor(sensor_info));
-
   Sensor::SetMaxCachedFrameNumber(2);
+  SensorPtr sensor_ptr(new Sensor(sensor_info));
 
   double timestamp = 7012;
   Eigen::Affine3d sensor2world_pose = Eigen::Affine3d::Identity();
@@ -15,6 +15,7 @@
  *****************************************************************************/
 #include "modules/perception/fusion/lib/data_association/hm_data_association/hm_tracks_objects_match.h"
 
+#include <algorithm>
 #include <map>
 #include <numeric>
 #include <utility>
@@ -44,6 +45,26 @@ void extract_vector(const std::vector<T>& vec,
   }
 }
 
+bool HMTrackersObjectsAssociation::Init() {
+  track_object_distance_.set_distance_thresh(
+      static_cast<float>(s_match_distance_thresh_));
+  optimizer_.set_num_threads(FLAGS_hungarian_matcher_num_threads);
+
+  const size_t num_threads = static_cast<size_t>(
+      std::max(FLAGS_track_object_distance_num_threads, 1));
+  worker_object_distances_.clear();
+  for (size_t i = 1; i < num_threads; ++i) {
+    worker_object_distances_.emplace_back(new TrackObjectDistance);
+    worker_object_distances_.back()->set_distance_thresh(
+        static_cast<float>(s_match_distance_thresh_));
+  }
+  if (num_threads > 1 && thread_pool_ == nullptr) {
+    thread_pool_.reset(new lib::ThreadPool(static_cast<int>(num_threads) - 1));
+    thread_pool_->Start();
+  }
+  return true;
+}
+
 bool HMTrackersObjectsAssociation::Associate(
     const AssociationOptions& options, SensorFramePtr sensor_measurements,
     ScenePtr scene, AssociationResult* association_result) {
@@ -65,6 +86,10 @@ bool HMTrackersObjectsAssociation::Associate(
   double measurement_timestamp = sensor_objects[0]->GetTimestamp();
   track_object_distance_.ResetProjectionCache(measurement_sensor_id,
                                               measurement_timestamp);
+  for (auto& object_distance : worker_object_distances_) {
+    object_distance->ResetProjectionCache(measurement_sensor_id,
+                                          measurement_timestamp);
+  }
   bool do_nothing = (sensor_objects[0]->GetSensorId() == "radar_front");
   IdAssign(fusion_tracks, sensor_objects, &association_result->assignments,
            &association_result->unassigned_tracks,
@@ -260,14 +285,16 @@ void HMTrackersObjectsAssociation::ComputeDistance(
       // just for return dist score, the dist score is
       // a similarity probability [0, 1] 1 is the best
       association_result->track2measurements_dist[track_ind] = 0.0;
+      TrackObjectDistance* track_object_distance =
+          RowTrackObjectDistance(static_cast<size_t>(track_ind_loc));
       for (size_t j = 0; j < association_mat[track_ind_loc].size(); ++j) {
         double dist_score = 0.0;
         if (lidar_object != nullptr) {
-          dist_score = track_object_distance_.ComputeLidarCameraSimilarity(
+          dist_score = track_object_distance->ComputeLidarCameraSimilarity(
               lidar_object, sensor_objects[measurement_ind_l2g[j]],
               IsLidar(sensor_objects[measurement_ind_l2g[j]]));
         } else if (radar_object != nullptr) {
-          dist_score = track_object_distance_.ComputeRadarCameraSimilarity(
+          dist_score = track_object_distance->ComputeRadarCameraSimilarity(
               radar_object, sensor_objects[measurement_ind_l2g[j]]);
         }
         association_result->track2measurements_dist[track_ind] = std::max(
@@ -300,14 +327,50 @@ void HMTrackersObjectsAssociation::ComputeAssociationDistanceMat(
     const std::vector<size_t>& unassigned_measurements,
     std::vector<std::vector<double>>* association_mat) {
   // if (sensor_objects.empty()) return;
+  association_mat->resize(unassigned_tracks.size());
+  for (auto& row : *association_mat) {
+    row.resize(unassigned_measurements.size());
+  }
+  distance_tracks_ = &fusion_tracks;
+  distance_objects_ = &sensor_objects;
+  distance_track_inds_ = &unassigned_tracks;
+  distance_object_inds_ = &unassigned_measurements;
+  distance_mat_ = association_mat;
+  num_distance_tasks_ = std::max(
+      std::min(worker_object_distances_.size() + 1, unassigned_tracks.size()),
+      static_cast<size_t>(1));
+  if (thread_pool_ == nullptr || num_distance_tasks_ <= 1) {
+    ComputeAssociationDistanceRows(0, nullptr);
+  } else {
+    lib::BlockingCounter counter(num_distance_tasks_ - 1);
+    for (size_t i = 1; i < num_distance_tasks_; ++i) {
+      thread_pool_->Add(google::protobuf::NewCallback(
+          this, &HMTrackersObjectsAssociation::ComputeAssociationDistanceRows,
+          i, &counter));
+    }
+    ComputeAssociationDistanceRows(0, nullptr);
+    counter.Wait();
+  }
+  distance_mat_ = nullptr;
+}
+
+void HMTrackersObjectsAssociation::ComputeAssociationDistanceRows(
+    size_t thread_id, lib::BlockingCounter* counter) {
+  const std::vector<TrackPtr>& fusion_tracks = *distance_tracks_;
+  const std::vector<SensorObjectPtr>& sensor_objects = *distance_objects_;
+  const std::vector<size_t>& unassigned_tracks = *distance_track_inds_;
+  const std::vector<size_t>& unassigned_measurements = *distance_object_inds_;
+  std::vector<std::vector<double>>& association_mat = *distance_mat_;
+  TrackObjectDistance* track_object_distance =
+      RowTrackObjectDistance(thread_id);
+
   TrackObjectDistanceOptions opt;
   // TODO(linjian) ref_point
   Eigen::Vector3d tmp = Eigen::Vector3d::Zero();
   opt.ref_point = &tmp;
-  association_mat->resize(unassigned_tracks.size());
-  for (size_t i = 0; i < unassigned_tracks.size(); ++i) {
+  for (size_t i = thread_id; i < unassigned_tracks.size();
+       i += num_distance_tasks_) {
     int fusion_idx = static_cast<int>(unassigned_tracks[i]);
-    (*association_mat)[i].resize(unassigned_measurements.size());
     const TrackPtr& fusion_track = fusion_tracks[fusion_idx];
     for (size_t j = 0; j < unassigned_measurements.size(); ++j) {
       int sensor_idx = static_cast<int>(unassigned_measurements[j]);
@@ -319,7 +382,7 @@ void HMTrackersObjectsAssociation::ComputeAssociationDistanceMat(
               .norm();
       if (center_dist < s_association_center_dist_threshold_) {
         distance =
-            track_object_distance_.Compute(fusion_track, sensor_object, opt);
+            track_object_distance->Compute(fusion_track, sensor_object, opt);
       } else {
         ADEBUG << "center_distance " << center_dist
                << " exceeds slack threshold "
@@ -327,12 +390,22 @@ void HMTrackersObjectsAssociation::ComputeAssociationDistanceMat(
                << ", track_id: " << fusion_track->GetTrackId()
                << ", obs_id: " << sensor_object->GetBaseObject()->track_id;
       }
-      (*association_mat)[i][j] = distance;
+      association_mat[i][j] = distance;
       ADEBUG << "track_id: " << fusion_track->GetTrackId()
              << ", obs_id: " << sensor_object->GetBaseObject()->track_id
              << ", distance: " << distance;
     }
   }
+  if (counter != nullptr) {
+    counter->Decrement();
+  }
+}
+
+TrackObjectDistance* HMTrackersObjectsAssociation::RowTrackObjectDistance(
+    size_t row) {
+  const size_t thread_id = row % num_distance_tasks_;
+  return thread_id == 0 ? &track_object_distance_
+                        : worker_object_distances_[thread_id - 1].get();
 }
 
 void HMTrackersObjectsAssociation::IdAssign(
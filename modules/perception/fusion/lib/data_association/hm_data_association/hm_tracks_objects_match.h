@@ -15,12 +15,15 @@
  *****************************************************************************/
 #pragma once
 
+#include <memory>
 #include <string>
 #include <vector>
 
 #include "modules/perception/common/graph/gated_hungarian_bigraph_matcher.h"
+#include "modules/perception/common/perception_gflags.h"
 #include "modules/perception/fusion/lib/data_association/hm_data_association/track_object_distance.h"
 #include "modules/perception/fusion/lib/interface/base_data_association.h"
+#include "modules/perception/lib/thread/thread_pool.h"
 
 namespace apollo {
 namespace perception {
@@ -34,11 +37,7 @@ class HMTrackersObjectsAssociation : public BaseDataAssociation {
   HMTrackersObjectsAssociation& operator=(const HMTrackersObjectsAssociation&) =
       delete;
 
-  bool Init() override {
-    track_object_distance_.set_distance_thresh(
-        static_cast<float>(s_match_distance_thresh_));
-    return true;
-  }
+  bool Init() override;
 
   bool Associate(const AssociationOptions& options,
                  SensorFramePtr sensor_measurements, ScenePtr scene,
@@ -55,6 +54,14 @@ class HMTrackersObjectsAssociation : public BaseDataAssociation {
       const std::vector<size_t>& unassigned_measurements,
       std::vector<std::vector<double>>* association_mat);
 
+  // @brief compute the rows of the distance matrix of one thread
+  void ComputeAssociationDistanceRows(size_t thread_id,
+                                      lib::BlockingCounter* counter);
+
+  // @brief distance of a row of the distance matrix, each thread keeps its
+  //        own projection cache
+  TrackObjectDistance* RowTrackObjectDistance(size_t row);
+
   void IdAssign(const std::vector<TrackPtr>& fusion_tracks,
                 const std::vector<SensorObjectPtr>& sensor_objects,
                 std::vector<TrackMeasurmentPair>* assignments,
@@ -94,6 +101,18 @@ class HMTrackersObjectsAssociation : public BaseDataAssociation {
  private:
   common::GatedHungarianMatcher<float> optimizer_;
   TrackObjectDistance track_object_distance_;
+  // distances of the threads other than the calling one
+  std::vector<std::unique_ptr<TrackObjectDistance>> worker_object_distances_;
+  std::unique_ptr<lib::ThreadPool> thread_pool_;
+  // rows of the distance matrix are interleaved over the tasks, so that the
+  // projections of a track stay in the cache of one thread
+  size_t num_distance_tasks_ = 1;
+  // inputs of the distance matrix being computed
+  const std::vector<TrackPtr>* distance_tracks_ = nullptr;
+  const std::vector<SensorObjectPtr>* distance_objects_ = nullptr;
+  const std::vector<size_t>* distance_track_inds_ = nullptr;
+  const std::vector<size_t>* distance_object_inds_ = nullptr;
+  std::vector<std::vector<double>>* distance_mat_ = nullptr;
   static double s_match_distance_thresh_;
   static double s_match_distance_bound_;
   static double s_association_center_dist_threshold_;
@@ -15,8 +15,8 @@
  *****************************************************************************/
 #pragma once
 
-#include <map>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "Eigen/StdVector"
@@ -86,7 +86,8 @@ class ProjectionCacheFrame {
   // sensor id of cached project frame
   std::string sensor_id_;
   double timestamp_;
-  std::map<int, ProjectionCacheObject> objects_;
+  // indexed by lidar object id
+  std::unordered_map<int, ProjectionCacheObject> objects_;
 };  // class ProjectionCacheFrame
 
 // @brief: project cache
@@ -172,37 +172,54 @@ ProjectionCacheObject* TrackObjectDistance::BuildProjectionCacheObject(
       every_n =
           cloud.size() / s_lidar2camera_projection_downsample_target_pts_num_;
     }
-    for (size_t i = 0; i < cloud.size(); ++i) {
-      if ((every_n > 1) && (i % every_n != 0)) {
-        continue;
-      }
+    // 5.2 transform the sampled points to the camera at once, the offset is
+    // folded into the translation
+    const size_t num_pts = (cloud.size() + every_n - 1) / every_n;
+    cloud_pts_.resize(3, num_pts);
+    for (size_t i = 0, k = 0; i < cloud.size(); i += every_n, ++k) {
       const base::PointF& pt = cloud.at(i);
-      Eigen::Vector4d project_pt =
-          static_cast<Eigen::Matrix<double, 4, 1, 0, 4, 1>>(
-              lidar2camera_pose * Eigen::Vector4d(pt.x + offset(0),
-                                                  pt.y + offset(1),
-                                                  pt.z + offset(2), 1.0));
-      if (project_pt(2) <= 0) {
+      cloud_pts_.col(k) << pt.x, pt.y, pt.z;
+    }
+    const Eigen::Matrix3d rotation = lidar2camera_pose.topLeftCorner<3, 3>();
+    const Eigen::Vector3d translation =
+        rotation * offset + lidar2camera_pose.topRightCorner<3, 1>();
+    camera_pts_.noalias() = rotation * cloud_pts_;
+    camera_pts_.colwise() += translation;
+    // 5.3 project them, the undistorted camera is a pinhole one, whose
+    // projection is done on whole rows instead of a virtual call per point
+    image_pts_.resize(2, num_pts);
+    const base::PinholeCameraModel* pinhole_model =
+        dynamic_cast<const base::PinholeCameraModel*>(camera_model.get());
+    if (pinhole_model != nullptr) {
+      const Eigen::Matrix3f intrinsic = pinhole_model->get_intrinsic_params();
+      const Eigen::Matrix3Xf camera_ptsf = camera_pts_.cast<float>();
+      image_pts_.row(0) = (camera_ptsf.row(0).array() /
+                               camera_ptsf.row(2).array() * intrinsic(0, 0) +
+                           intrinsic(0, 2))
+                              .matrix();
+      image_pts_.row(1) = (camera_ptsf.row(1).array() /
+                               camera_ptsf.row(2).array() * intrinsic(1, 1) +
+                           intrinsic(1, 2))
+                              .matrix();
+    } else {
+      for (size_t k = 0; k < num_pts; ++k) {
+        image_pts_.col(k) =
+            camera_model->Project(camera_pts_.col(k).cast<float>());
+      }
+    }
+    // 5.4 cache the points in front of the camera and inside the image
+    for (size_t k = 0; k < num_pts; ++k) {
+      if (camera_pts_(2, k) <= 0) {
         continue;
       }
-      Eigen::Vector2f project_pt2f = camera_model->Project(Eigen::Vector3f(
-          static_cast<float>(project_pt(0)), static_cast<float>(project_pt(1)),
-          static_cast<float>(project_pt(2))));
+      const Eigen::Vector2f project_pt2f = image_pts_.col(k);
       if (!IsPtInFrustum(project_pt2f, width, height)) {
         continue;
       }
-      if (project_pt2f.x() < xmin) {
-        xmin = project_pt2f.x();
-      }
-      if (project_pt2f.y() < ymin) {
-        ymin = project_pt2f.y();
-      }
-      if (project_pt2f.x() > xmax) {
-        xmax = project_pt2f.x();
-      }
-      if (project_pt2f.y() > ymax) {
-        ymax = project_pt2f.y();
-      }
+      xmin = std::min(xmin, project_pt2f.x());
+      ymin = std::min(ymin, project_pt2f.y());
+      xmax = std::max(xmax, project_pt2f.x());
+      ymax = std::max(ymax, project_pt2f.y());
       projection_cache_.AddPoint(project_pt2f);
     }
   }
@@ -171,6 +171,10 @@ class TrackObjectDistance {
       const SensorObjectConstPtr& lidar, const SensorObjectConstPtr& camera);
 
   ProjectionCache projection_cache_;
+  // buffers of the batched lidar cloud projection
+  Eigen::Matrix3Xd cloud_pts_;
+  Eigen::Matrix3Xd camera_pts_;
+  Eigen::Matrix2Xf image_pts_;
   float distance_thresh_ = 4.0f;
   const float vc_similarity2distance_penalize_thresh_ = 0.07f;
   const float vc_diff2distance_scale_factor_ = 0.8f;
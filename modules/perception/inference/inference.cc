@@ -24,6 +24,8 @@ void Inference::set_max_batch_size(const int &batch_size) {
   max_batch_size_ = batch_size;
 }
 
+void Inference::InferAsync(cudaStream_t stream) { Infer(); }
+
 void Inference::set_gpu_id(const int &gpu_id) { gpu_id_ = gpu_id; }
 
 }  // namespace inference
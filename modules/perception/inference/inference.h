@@ -36,6 +36,10 @@ typedef std::map<std::string,
 class Inference {
  public:
   virtual void Infer() = 0;
+  // @brief enqueue the inference on the given stream and return without
+  // waiting for it. The outputs are valid once the stream is synchronized.
+  // Networks without stream support run Infer() synchronously.
+  virtual void InferAsync(cudaStream_t stream);
   Inference() = default;
 
   virtual ~Inference() = default;
@@ -17,10 +17,15 @@
 #include "modules/perception/inference/tensorrt/rt_net.h"
 
 #include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <functional>
 #include <utility>
 
 #include "absl/strings/str_cat.h"
+#include "cyber/common/file.h"
 #include "cyber/common/log.h"
+#include "modules/perception/common/perception_gflags.h"
 #include "modules/perception/inference/tensorrt/plugins/argmax_plugin.h"
 #include "modules/perception/inference/tensorrt/plugins/leakyReLU_plugin.h"
 #include "modules/perception/inference/tensorrt/plugins/slice_plugin.h"
@@ -546,7 +551,10 @@ nvinfer1::Weights RTNet::loadLayerWeights(float data, int size) {
 RTNet::RTNet(const std::string &net_file, const std::string &model_file,
              const std::vector<std::string> &outputs,
              const std::vector<std::string> &inputs)
-    : output_names_(outputs), input_names_(inputs) {
+    : output_names_(outputs),
+      input_names_(inputs),
+      net_file_(net_file),
+      model_file_(model_file) {
   loadWeights(model_file, &weight_map_);
   net_param_.reset(new NetParameter);
   loadNetParams(net_file, net_param_.get());
@@ -555,7 +563,10 @@ RTNet::RTNet(const std::string &net_file, const std::string &model_file,
              const std::vector<std::string> &outputs,
              const std::vector<std::string> &inputs,
              nvinfer1::Int8EntropyCalibrator *calibrator)
-    : output_names_(outputs), input_names_(inputs) {
+    : output_names_(outputs),
+      input_names_(inputs),
+      net_file_(net_file),
+      model_file_(model_file) {
   loadWeights(model_file, &weight_map_);
   net_param_.reset(new NetParameter);
   loadNetParams(net_file, net_param_.get());
@@ -566,7 +577,11 @@ RTNet::RTNet(const std::string &net_file, const std::string &model_file,
              const std::vector<std::string> &outputs,
              const std::vector<std::string> &inputs,
              const std::string &model_root)
-    : output_names_(outputs), input_names_(inputs), is_own_calibrator_(true) {
+    : output_names_(outputs),
+      input_names_(inputs),
+      net_file_(net_file),
+      model_file_(model_file),
+      is_own_calibrator_(true) {
   loadWeights(model_file, &weight_map_);
   net_param_.reset(new NetParameter);
   loadNetParams(net_file, net_param_.get());
@@ -638,19 +653,117 @@ bool RTNet::Init(const std::map<std::string, std::vector<int>> &shapes) {
   cudaDeviceProp prop;
   cudaGetDeviceProperties(&prop, gpu_id_);
   bool int8_mode = checkInt8(prop.name, calibrator_);
-
-  builder_->setInt8Mode(int8_mode);
-  builder_->setInt8Calibrator(calibrator_);
-
-  builder_->setDebugSync(true);
-
-  nvinfer1::ICudaEngine *engine = builder_->buildCudaEngine(*network_);
-  context_ = engine->createExecutionContext();
+  bool fp16_mode = !int8_mode && FLAGS_trt_fp16_mode &&
+                   builder_->platformHasFastFp16();
+  if (fp16_mode) {
+    AINFO << "Device Works on FP16 Mode.";
+  }
+
+  // Engines with plugin layers can not be deserialized, as the plugins do
+  // not serialize their parameters.
+  std::string engine_file;
+  if (!FLAGS_trt_engine_cache_dir.empty() && !hasPluginLayer()) {
+    engine_file = engineCachePath(
+        shapes, prop, int8_mode ? "int8" : (fp16_mode ? "fp16" : "fp32"));
+  }
+  if (engine_file.empty() || !loadEngine(engine_file)) {
+    builder_->setInt8Mode(int8_mode);
+    builder_->setInt8Calibrator(calibrator_);
+    builder_->setFp16Mode(fp16_mode);
+
+    builder_->setDebugSync(true);
+
+    engine_ = builder_->buildCudaEngine(*network_);
+    if (engine_ == nullptr) {
+      AERROR << "Failed to build the TensorRT engine.";
+      return false;
+    }
+    if (!engine_file.empty()) {
+      saveEngine(engine_file);
+    }
+  }
+  context_ = engine_->createExecutionContext();
   buffers_.resize(input_names_.size() + output_names_.size());
   init_blob(&input_names_);
   init_blob(&output_names_);
   return true;
 }
+bool RTNet::hasPluginLayer() const {
+  for (int i = 0; i < network_->getNbLayers(); ++i) {
+    if (network_->getLayer(i)->getType() == nvinfer1::LayerType::kPLUGIN) {
+      return true;
+    }
+  }
+  return false;
+}
+std::string RTNet::engineCachePath(
+    const std::map<std::string, std::vector<int>> &shapes,
+    const cudaDeviceProp &prop, const std::string &precision) const {
+  // The key covers everything the built engine depends on: the network and
+  // its weights, the input shapes, the gpu and TensorRT version and the
+  // precision, so that a stale engine is never loaded.
+  std::string net_content;
+  std::string model_content;
+  if (!cyber::common::GetContent(net_file_, &net_content) ||
+      !cyber::common::GetContent(model_file_, &model_content)) {
+    AWARN << "Failed to read " << net_file_ << " or " << model_file_
+          << ", engine cache is disabled.";
+    return "";
+  }
+  std::string key = absl::StrCat(
+      std::hash<std::string>()(net_content), "_",
+      std::hash<std::string>()(model_content), "_", max_batch_size_, "_",
+      model_root_, "_", NV_TENSORRT_MAJOR, ".", NV_TENSORRT_MINOR, ".",
+      NV_TENSORRT_PATCH);
+  for (const auto &shape : shapes) {
+    absl::StrAppend(&key, "_", shape.first);
+    for (const int dim : shape.second) {
+      absl::StrAppend(&key, ",", dim);
+    }
+  }
+  std::string gpu_name = prop.name;
+  std::replace(gpu_name.begin(), gpu_name.end(), ' ', '_');
+  return absl::StrCat(FLAGS_trt_engine_cache_dir, "/",
+                      std::hash<std::string>()(key), "_", gpu_name, "_sm",
+                      prop.major, prop.minor, "_", precision, ".engine");
+}
+bool RTNet::loadEngine(const std::string &engine_file) {
+  std::string engine_data;
+  if (!cyber::common::PathExists(engine_file) ||
+      !cyber::common::GetContent(engine_file, &engine_data)) {
+    return false;
+  }
+  runtime_ = nvinfer1::createInferRuntime(rt_gLogger);
+  engine_ = runtime_->deserializeCudaEngine(engine_data.data(),
+                                            engine_data.size(), nullptr);
+  if (engine_ == nullptr) {
+    AWARN << "Failed to deserialize " << engine_file << ", rebuild it.";
+    return false;
+  }
+  AINFO << "Load TensorRT engine from " << engine_file;
+  return true;
+}
+void RTNet::saveEngine(const std::string &engine_file) const {
+  if (!cyber::common::EnsureDirectory(FLAGS_trt_engine_cache_dir)) {
+    AWARN << "Failed to create " << FLAGS_trt_engine_cache_dir;
+    return;
+  }
+  nvinfer1::IHostMemory *engine_data = engine_->serialize();
+  // Write to a temporary file first, so that processes starting at the same
+  // time never read a partial engine.
+  const std::string tmp_file = absl::StrCat(engine_file, ".tmp");
+  {
+    std::ofstream fout(tmp_file, std::ios::binary);
+    fout.write(reinterpret_cast<const char *>(engine_data->data()),
+               engine_data->size());
+  }
+  engine_data->destroy();
+  if (std::rename(tmp_file.c_str(), engine_file.c_str()) != 0) {
+    AWARN << "Failed to save TensorRT engine to " << engine_file;
+    return;
+  }
+  AINFO << "Save TensorRT engine to " << engine_file;
+}
 bool RTNet::checkInt8(const std::string &gpu_name,
                       nvinfer1::IInt8Calibrator *calibrator) {
   if (calibrator == nullptr) {
@@ -733,7 +846,15 @@ RTNet::~RTNet() {
     BASE_CUDA_CHECK(cudaStreamDestroy(stream_));
     network_->destroy();
     builder_->destroy();
-    context_->destroy();
+    if (context_ != nullptr) {
+      context_->destroy();
+    }
+    if (engine_ != nullptr) {
+      engine_->destroy();
+    }
+    if (runtime_ != nullptr) {
+      runtime_->destroy();
+    }
     for (auto buf : buffers_) {
       cudaFree(buf);
     }
@@ -743,9 +864,19 @@ RTNet::~RTNet() {
 void RTNet::Infer() {
   BASE_CUDA_CHECK(cudaSetDevice(gpu_id_));
   BASE_CUDA_CHECK(cudaStreamSynchronize(stream_));
+  InferAsync(stream_);
+  BASE_CUDA_CHECK(cudaStreamSynchronize(stream_));
+}
+void RTNet::InferAsync(cudaStream_t stream) {
+  BASE_CUDA_CHECK(cudaSetDevice(gpu_id_));
   for (auto name : input_names_) {
     auto blob = get_blob(name);
-    if (blob != nullptr) {
+    if (blob == nullptr) {
+      continue;
+    }
+    if (blob->head() == base::SyncedMemory::HEAD_AT_CPU) {
+      blob->data()->async_gpu_push(stream);
+    } else {
       blob->gpu_data();
     }
   }
@@ -761,8 +892,7 @@ void RTNet::Infer() {
       blob->gpu_data();
     }
   }
-  context_->enqueue(max_batch_size_, &buffers_[0], stream_, nullptr);
-  BASE_CUDA_CHECK(cudaStreamSynchronize(stream_));
+  context_->enqueue(max_batch_size_, &buffers_[0], stream, nullptr);
 
   for (auto name : output_names_) {
     auto blob = get_blob(name);
@@ -72,6 +72,11 @@ class RTNet : public Inference {
 
   void Infer() override;
 
+  // @brief enqueue the network on the given stream without synchronizing.
+  // Different networks may run on different streams concurrently, but one
+  // network must not be enqueued again before its last run finished.
+  void InferAsync(cudaStream_t stream) override;
+
   std::shared_ptr<apollo::perception::base::Blob<float>> get_blob(
       const std::string &name) override;
 
@@ -175,7 +180,16 @@ class RTNet : public Inference {
   bool loadWeights(const std::string &model_file, WeightMap *weight_map);
   void init_blob(std::vector<std::string> *names);
 
+  bool hasPluginLayer() const;
+  std::string engineCachePath(
+      const std::map<std::string, std::vector<int>> &shapes,
+      const cudaDeviceProp &prop, const std::string &precision) const;
+  bool loadEngine(const std::string &engine_file);
+  void saveEngine(const std::string &engine_file) const;
+
  private:
+  nvinfer1::IRuntime *runtime_ = nullptr;
+  nvinfer1::ICudaEngine *engine_ = nullptr;
   nvinfer1::IExecutionContext *context_ = nullptr;
   cudaStream_t stream_ = 0;
   std::vector<std::shared_ptr<ArgMax1Plugin>> argmax_plugins_;
@@ -185,6 +199,8 @@ class RTNet : public Inference {
   std::vector<std::string> output_names_;
   std::vector<std::string> input_names_;
   std::map<std::string, std::string> tensor_modify_map_;
+  std::string net_file_;
+  std::string model_file_;
 
   std::shared_ptr<NetParameter> net_param_;
   WeightMap weight_map_;
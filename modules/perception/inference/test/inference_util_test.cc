@@ -14,6 +14,8 @@
  * limitations under the License.
  *****************************************************************************/
 
+#include <algorithm>
+
 #include "gtest/gtest.h"
 #include "modules/perception/inference/utils/cuda_util.h"
 #include "modules/perception/inference/utils/gemm.h"
@@ -168,6 +170,28 @@ TEST(UtilTest, test_resize_gpu) {
     EXPECT_FALSE(inference::ResizeGPU(src_image, dst_blob, width, 0));
   }
 
+  {
+    std::vector<int> shape = {2, img.rows * 0.5, img.cols * 0.5,
+                              img.channels()};
+    std::shared_ptr<apollo::perception::base::Blob<float>> dst_blob(
+        new apollo::perception::base::Blob<float>(shape));
+    std::vector<int> single_shape = {1, shape[1], shape[2], shape[3]};
+    std::shared_ptr<apollo::perception::base::Blob<float>> single_blob(
+        new apollo::perception::base::Blob<float>(single_shape));
+    float *zero_data = dst_blob->mutable_cpu_data();
+    std::fill(zero_data, zero_data + dst_blob->count(), 0.0f);
+    EXPECT_TRUE(inference::ResizeGPU(src_image, dst_blob, width, 0, 1));
+    EXPECT_TRUE(inference::ResizeGPU(src_image, single_blob, width, 0));
+    EXPECT_FALSE(inference::ResizeGPU(src_image, dst_blob, width, 0, 2));
+    // only the second image of the batch is written
+    const float *dst_data = dst_blob->cpu_data();
+    const float *single_data = single_blob->cpu_data();
+    for (int i = 0; i < single_blob->count(); ++i) {
+      EXPECT_EQ(dst_data[i], 0.0f);
+      EXPECT_EQ(dst_data[dst_blob->offset(1) + i], single_data[i]);
+    }
+  }
+
   {
     std::vector<int> shape = {1, img.rows * 0.5, img.cols * 0.5,
                               img.channels()};
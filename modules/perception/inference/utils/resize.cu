@@ -145,7 +145,7 @@ __global__ void resize_linear_kernel_mean(const unsigned char *src, float *dst,
 
 bool ResizeGPU(const base::Image8U &src,
                std::shared_ptr<apollo::perception::base::Blob<float>> dst,
-               int stepwidth, int start_axis) {
+               int stepwidth, int start_axis, int batch_index) {
   int width = dst->shape(2);
   int height = dst->shape(1);
   int channel = dst->shape(3);
@@ -157,6 +157,10 @@ bool ResizeGPU(const base::Image8U &src,
     AERROR << "channel should be the same after resize.";
     return false;
   }
+  if (batch_index < 0 || batch_index >= dst->shape(0)) {
+    AERROR << "batch index " << batch_index << " out of range.";
+    return false;
+  }
   float fx = static_cast<float>(origin_width) / static_cast<float>(width);
   float fy = static_cast<float>(origin_height) / static_cast<float>(height);
   const dim3 block(32, 8);
@@ -164,8 +168,9 @@ bool ResizeGPU(const base::Image8U &src,
   const dim3 grid(divup(width, block.x), divup(height, block.y));
 
   resize_linear_kernel<<<grid, block>>>(
-      src.gpu_data(), dst->mutable_gpu_data(), origin_channel, origin_height,
-      origin_width, stepwidth, height, width, fx, fy);
+      src.gpu_data(), dst->mutable_gpu_data() + dst->offset(batch_index),
+      origin_channel, origin_height, origin_width, stepwidth, height, width, fx,
+      fy);
   return true;
 }
 
@@ -25,9 +25,10 @@ namespace apollo {
 namespace perception {
 namespace inference {
 
+// @brief resize into the image of the given index of a batched dst blob
 bool ResizeGPU(const base::Image8U &src,
                std::shared_ptr<apollo::perception::base::Blob<float>> dst,
-               int stepwidth, int start_axis);
+               int stepwidth, int start_axis, int batch_index = 0);
 
 bool ResizeGPU(const apollo::perception::base::Blob<uint8_t> &src_gpu,
                std::shared_ptr<apollo::perception::base::Blob<float>> dst,
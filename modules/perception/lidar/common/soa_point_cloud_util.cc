@@ -0,0 +1,69 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#include "modules/perception/lidar/common/soa_point_cloud_util.h"
+
+#include <cmath>
+
+namespace apollo {
+namespace perception {
+namespace lidar {
+
+void DriverPointCloudToSoa(const drivers::PointCloud& message,
+                           base::SoaPointFCloud* cloud) {
+  const int size = message.point_size();
+  cloud->resize(size);
+  cloud->set_timestamp(message.measurement_time());
+  auto x = cloud->mutable_x();
+  auto y = cloud->mutable_y();
+  auto z = cloud->mutable_z();
+  auto intensity = cloud->mutable_intensity();
+  auto timestamp = cloud->mutable_points_timestamp();
+  auto beam_id = cloud->mutable_points_beam_id();
+  for (int i = 0; i < size; ++i) {
+    const drivers::PointXYZIT& pt = message.point(i);
+    x[i] = pt.x();
+    y[i] = pt.y();
+    z[i] = pt.z();
+    intensity[i] = static_cast<float>(pt.intensity());
+    timestamp[i] = static_cast<double>(pt.timestamp()) * 1e-9;
+    beam_id[i] = i;
+  }
+}
+
+void SoaToDriverPointCloud(const base::SoaPointFCloud& cloud,
+                           drivers::PointCloud* message) {
+  message->clear_point();
+  message->set_measurement_time(cloud.get_timestamp());
+  const size_t size = cloud.size();
+  message->mutable_point()->Reserve(static_cast<int>(size));
+  const auto x = cloud.x();
+  const auto y = cloud.y();
+  const auto z = cloud.z();
+  const auto intensity = cloud.intensity();
+  const auto timestamp = cloud.points_timestamp();
+  for (size_t i = 0; i < size; ++i) {
+    drivers::PointXYZIT* pt = message->add_point();
+    pt->set_x(x[i]);
+    pt->set_y(y[i]);
+    pt->set_z(z[i]);
+    pt->set_intensity(static_cast<uint32_t>(intensity[i]));
+    pt->set_timestamp(static_cast<uint64_t>(std::llround(timestamp[i] * 1e9)));
+  }
+}
+
+}  // namespace lidar
+}  // namespace perception
+}  // namespace apollo
@@ -0,0 +1,41 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#pragma once
+
+#include "modules/drivers/proto/pointcloud.pb.h"
+#include "modules/perception/base/soa_point_cloud.h"
+
+namespace apollo {
+namespace perception {
+namespace lidar {
+
+// @brief: fill the soa cloud with the driver message in a single pass over
+// the points, without an intermediate array of structs cloud
+// @param [in]: message, driver point cloud
+// @param [out]: cloud, timestamps are converted to seconds and the beam id
+// of a point is its index in the message, as in PointCloudPreprocessor
+void DriverPointCloudToSoa(const drivers::PointCloud& message,
+                           base::SoaPointFCloud* cloud);
+
+// @brief: fill the driver message with the soa cloud
+// @param [in]: cloud
+// @param [out]: message, only the points and the measurement time are set
+void SoaToDriverPointCloud(const base::SoaPointFCloud& cloud,
+                           drivers::PointCloud* message);
+
+}  // namespace lidar
+}  // namespace perception
+}  // namespace apollo
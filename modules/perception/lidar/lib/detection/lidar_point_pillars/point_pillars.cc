@@ -102,12 +102,14 @@ PointPillars::PointPillars(const bool reproduce_result_mode,
                            const float score_threshold,
                            const float nms_overlap_threshold,
                            const std::string pfe_torch_file,
-                           const std::string rpn_onnx_file)
+                           const std::string rpn_onnx_file,
+                           const int max_batch_size)
     : reproduce_result_mode_(reproduce_result_mode),
       score_threshold_(score_threshold),
       nms_overlap_threshold_(nms_overlap_threshold),
       pfe_torch_file_(pfe_torch_file),
-      rpn_onnx_file_(rpn_onnx_file) {
+      rpn_onnx_file_(rpn_onnx_file),
+      max_batch_size_(std::max(max_batch_size, 1)) {
   if (reproduce_result_mode_) {
     preprocess_points_ptr_.reset(new PreprocessPoints(
         kMaxNumPillars, kMaxNumPointsPerPillar, kNumPointFeature, kGridXSize,
@@ -159,6 +161,7 @@ PointPillars::~PointPillars() {
   GPU_CHECK(cudaFree(dev_sparse_pillar_map_));
   GPU_CHECK(cudaFree(dev_pillar_point_feature_));
   GPU_CHECK(cudaFree(dev_pillar_coors_));
+  GPU_CHECK(cudaFree(dev_points_));
 
   GPU_CHECK(cudaFree(dev_cumsum_along_x_));
   GPU_CHECK(cudaFree(dev_cumsum_along_y_));
@@ -230,7 +233,7 @@ void PointPillars::DeviceMemoryMalloc() {
   GPU_CHECK(cudaMalloc(reinterpret_cast<void**>(&dev_box_anchors_max_y_),
                        kNumAnchor * sizeof(float)));
   GPU_CHECK(cudaMalloc(reinterpret_cast<void**>(&dev_anchor_mask_),
-                       kNumAnchor * sizeof(int)));
+                       max_batch_size_ * kNumAnchor * sizeof(int)));
 
   // for trt inference
   // create GPU buffers and a stream
@@ -240,14 +243,18 @@ void PointPillars::DeviceMemoryMalloc() {
   GPU_CHECK(cudaMalloc(&pfe_buffers_[1], kMaxNumPillars * sizeof(float)));
   GPU_CHECK(cudaMalloc(&pfe_buffers_[2], kMaxNumPillars * 4 * sizeof(float)));
 
-  GPU_CHECK(cudaMalloc(&rpn_buffers_[0], kRpnInputSize * sizeof(float)));
-  GPU_CHECK(cudaMalloc(&rpn_buffers_[1], kRpnBoxOutputSize * sizeof(float)));
-  GPU_CHECK(cudaMalloc(&rpn_buffers_[2], kRpnClsOutputSize * sizeof(float)));
-  GPU_CHECK(cudaMalloc(&rpn_buffers_[3], kRpnDirOutputSize * sizeof(float)));
+  GPU_CHECK(cudaMalloc(&rpn_buffers_[0],
+                       max_batch_size_ * kRpnInputSize * sizeof(float)));
+  GPU_CHECK(cudaMalloc(&rpn_buffers_[1],
+                       max_batch_size_ * kRpnBoxOutputSize * sizeof(float)));
+  GPU_CHECK(cudaMalloc(&rpn_buffers_[2],
+                       max_batch_size_ * kRpnClsOutputSize * sizeof(float)));
+  GPU_CHECK(cudaMalloc(&rpn_buffers_[3],
+                       max_batch_size_ * kRpnDirOutputSize * sizeof(float)));
 
   // for scatter kernel
   GPU_CHECK(cudaMalloc(reinterpret_cast<void**>(&dev_scattered_feature_),
-                       kNumThreads * kGridYSize * kGridXSize * sizeof(float)));
+                       max_batch_size_ * kRpnInputSize * sizeof(float)));
 
   // for filter
   GPU_CHECK(cudaMalloc(reinterpret_cast<void**>(&dev_anchors_px_),
@@ -508,6 +515,28 @@ void PointPillars::OnnxToTRTModel(
   builder->setMaxBatchSize(kBatchSize);
   nvinfer1::IBuilderConfig* config = builder->createBuilderConfig();
   config->setMaxWorkspaceSize(1 << 20);
+
+  // a model exported with a dynamic batch runs a whole batch at once
+  nvinfer1::ITensor* input = network->getInput(0);
+  rpn_input_dims_ = input->getDimensions();
+  rpn_dynamic_batch_ = rpn_input_dims_.d[0] < 0;
+  if (rpn_dynamic_batch_) {
+    nvinfer1::IOptimizationProfile* profile =
+        builder->createOptimizationProfile();
+    nvinfer1::Dims dims = rpn_input_dims_;
+    dims.d[0] = 1;
+    profile->setDimensions(input->getName(),
+                           nvinfer1::OptProfileSelector::kMIN, dims);
+    dims.d[0] = max_batch_size_;
+    profile->setDimensions(input->getName(),
+                           nvinfer1::OptProfileSelector::kOPT, dims);
+    profile->setDimensions(input->getName(),
+                           nvinfer1::OptProfileSelector::kMAX, dims);
+    config->addOptimizationProfile(profile);
+  } else if (max_batch_size_ > 1) {
+    AWARN << "RPN model has a fixed batch size, batched point clouds run "
+          << "the RPN one by one.";
+  }
   nvinfer1::ICudaEngine* engine =
       builder->buildEngineWithConfig(*network, *config);
 
@@ -573,10 +602,15 @@ void PointPillars::PreprocessCPU(const float* in_points_array,
 
 void PointPillars::PreprocessGPU(const float* in_points_array,
                                  const int in_num_points) {
-  float* dev_points;
-  GPU_CHECK(cudaMalloc(reinterpret_cast<void**>(&dev_points),
-                       in_num_points * kNumPointFeature * sizeof(float)));
-  GPU_CHECK(cudaMemcpy(dev_points, in_points_array,
+  // cudaMalloc and cudaFree synchronize the device, so the point buffer is
+  // only reallocated when it is too small
+  if (in_num_points > dev_points_capacity_) {
+    GPU_CHECK(cudaFree(dev_points_));
+    GPU_CHECK(cudaMalloc(reinterpret_cast<void**>(&dev_points_),
+                         in_num_points * kNumPointFeature * sizeof(float)));
+    dev_points_capacity_ = in_num_points;
+  }
+  GPU_CHECK(cudaMemcpy(dev_points_, in_points_array,
                        in_num_points * kNumPointFeature * sizeof(float),
                        cudaMemcpyHostToDevice));
 
@@ -593,14 +627,10 @@ void PointPillars::PreprocessGPU(const float* in_points_array,
                        kNumIndsForScan * kNumIndsForScan * sizeof(int)));
   host_pillar_count_[0] = 0;
 
-  GPU_CHECK(cudaMemset(dev_anchor_mask_, 0, kNumAnchor * sizeof(int)));
-
   preprocess_points_cuda_ptr_->DoPreprocessPointsCuda(
-      dev_points, in_num_points, dev_x_coors_, dev_y_coors_,
+      dev_points_, in_num_points, dev_x_coors_, dev_y_coors_,
       dev_num_points_per_pillar_, dev_pillar_point_feature_, dev_pillar_coors_,
       dev_sparse_pillar_map_, host_pillar_count_);
-
-  GPU_CHECK(cudaFree(dev_points));
 }
 
 void PointPillars::Preprocess(const float* in_points_array,
@@ -616,73 +646,131 @@ void PointPillars::DoInference(const float* in_points_array,
                                const int in_num_points,
                                std::vector<float>* out_detections,
                                std::vector<int>* out_labels) {
+  std::vector<std::vector<float>> detections;
+  std::vector<std::vector<int>> labels;
+  DoInference(std::vector<const float*>{in_points_array},
+              std::vector<int>{in_num_points}, &detections, &labels);
+  if (detections.empty()) {
+    return;
+  }
+  out_detections->insert(out_detections->end(), detections[0].begin(),
+                         detections[0].end());
+  out_labels->insert(out_labels->end(), labels[0].begin(), labels[0].end());
+}
+
+void PointPillars::DoInference(
+    const std::vector<const float*>& in_points_arrays,
+    const std::vector<int>& in_num_points,
+    std::vector<std::vector<float>>* out_detections,
+    std::vector<std::vector<int>>* out_labels) {
   if (device_id_ < 0) {
     AERROR << "Torch is not using GPU!";
     return;
   }
-
-  Preprocess(in_points_array, in_num_points);
-
-  anchor_mask_cuda_ptr_->DoAnchorMaskCuda(
-      dev_sparse_pillar_map_, dev_cumsum_along_x_, dev_cumsum_along_y_,
-      dev_box_anchors_min_x_, dev_box_anchors_min_y_, dev_box_anchors_max_x_,
-      dev_box_anchors_max_y_, dev_anchor_mask_);
+  const int batch_size = static_cast<int>(in_points_arrays.size());
+  if (batch_size > max_batch_size_ ||
+      in_num_points.size() != in_points_arrays.size()) {
+    AERROR << "Invalid batch of " << batch_size
+           << " point clouds, max batch size " << max_batch_size_;
+    return;
+  }
+  out_detections->clear();
+  out_detections->resize(batch_size);
+  out_labels->clear();
+  out_labels->resize(batch_size);
 
   cudaStream_t stream;
   GPU_CHECK(cudaStreamCreate(&stream));
-  GPU_CHECK(cudaMemcpyAsync(pfe_buffers_[0], dev_pillar_point_feature_,
-                            kMaxNumPillars * kMaxNumPointsPerPillar *
-                                kNumPointFeature * sizeof(float),
-                            cudaMemcpyDeviceToDevice, stream));
-  GPU_CHECK(cudaMemcpyAsync(pfe_buffers_[1], dev_num_points_per_pillar_,
-                            kMaxNumPillars * sizeof(float),
-                            cudaMemcpyDeviceToDevice, stream));
-  GPU_CHECK(cudaMemcpyAsync(pfe_buffers_[2], dev_pillar_coors_,
-                            kMaxNumPillars * 4 * sizeof(float),
-                            cudaMemcpyDeviceToDevice, stream));
-
-  torch::Tensor tensor_pillar_point_feature = torch::from_blob(pfe_buffers_[0],
-      {kMaxNumPillars, kMaxNumPointsPerPillar, kNumPointFeature},
-      torch::kCUDA);
-  torch::Tensor tensor_num_points_per_pillar = torch::from_blob(
-      pfe_buffers_[1], {kMaxNumPillars}, torch::kCUDA);
-  torch::Tensor tensor_pillar_coors = torch::from_blob(pfe_buffers_[2],
-      {kMaxNumPillars, 4}, torch::kCUDA);
-
+  GPU_CHECK(cudaMemset(dev_scattered_feature_, 0,
+                       batch_size * kRpnInputSize * sizeof(float)));
   torch::Device device(device_type_, device_id_);
-  tensor_pillar_point_feature.to(device);
-  tensor_num_points_per_pillar.to(device);
-  tensor_pillar_coors.to(device);
-
-  auto pfe_output = pfe_net_.forward({tensor_pillar_point_feature,
-                                      tensor_num_points_per_pillar,
-                                      tensor_pillar_coors}).toTensor();
 
-  GPU_CHECK(
-      cudaMemset(dev_scattered_feature_, 0, kRpnInputSize * sizeof(float)));
-  scatter_cuda_ptr_->DoScatterCuda(
-      host_pillar_count_[0], dev_x_coors_, dev_y_coors_,
-      pfe_output.data_ptr<float>(), dev_scattered_feature_);
+  // voxelize and extract the pillar features one point cloud at a time, each
+  // into its own slice of the rpn input
+  for (int i = 0; i < batch_size; ++i) {
+    Preprocess(in_points_arrays[i], in_num_points[i]);
+
+    int* dev_anchor_mask = dev_anchor_mask_ + i * kNumAnchor;
+    GPU_CHECK(cudaMemset(dev_anchor_mask, 0, kNumAnchor * sizeof(int)));
+    anchor_mask_cuda_ptr_->DoAnchorMaskCuda(
+        dev_sparse_pillar_map_, dev_cumsum_along_x_, dev_cumsum_along_y_,
+        dev_box_anchors_min_x_, dev_box_anchors_min_y_,
+        dev_box_anchors_max_x_, dev_box_anchors_max_y_, dev_anchor_mask);
+
+    GPU_CHECK(cudaMemcpyAsync(pfe_buffers_[0], dev_pillar_point_feature_,
+                              kMaxNumPillars * kMaxNumPointsPerPillar *
+                                  kNumPointFeature * sizeof(float),
+                              cudaMemcpyDeviceToDevice, stream));
+    GPU_CHECK(cudaMemcpyAsync(pfe_buffers_[1], dev_num_points_per_pillar_,
+                              kMaxNumPillars * sizeof(float),
+                              cudaMemcpyDeviceToDevice, stream));
+    GPU_CHECK(cudaMemcpyAsync(pfe_buffers_[2], dev_pillar_coors_,
+                              kMaxNumPillars * 4 * sizeof(float),
+                              cudaMemcpyDeviceToDevice, stream));
+
+    torch::Tensor tensor_pillar_point_feature = torch::from_blob(
+        pfe_buffers_[0],
+        {kMaxNumPillars, kMaxNumPointsPerPillar, kNumPointFeature},
+        torch::kCUDA);
+    torch::Tensor tensor_num_points_per_pillar =
+        torch::from_blob(pfe_buffers_[1], {kMaxNumPillars}, torch::kCUDA);
+    torch::Tensor tensor_pillar_coors =
+        torch::from_blob(pfe_buffers_[2], {kMaxNumPillars, 4}, torch::kCUDA);
+
+    tensor_pillar_point_feature.to(device);
+    tensor_num_points_per_pillar.to(device);
+    tensor_pillar_coors.to(device);
+
+    auto pfe_output = pfe_net_.forward({tensor_pillar_point_feature,
+                                        tensor_num_points_per_pillar,
+                                        tensor_pillar_coors}).toTensor();
+
+    float* dev_scattered_feature = dev_scattered_feature_ + i * kRpnInputSize;
+    scatter_cuda_ptr_->DoScatterCuda(
+        host_pillar_count_[0], dev_x_coors_, dev_y_coors_,
+        pfe_output.data_ptr<float>(), dev_scattered_feature);
+  }
 
   GPU_CHECK(cudaMemcpyAsync(rpn_buffers_[0], dev_scattered_feature_,
-                            kBatchSize * kRpnInputSize * sizeof(float),
+                            batch_size * kRpnInputSize * sizeof(float),
                             cudaMemcpyDeviceToDevice, stream));
-  rpn_context_->enqueueV2(rpn_buffers_, stream, nullptr);
-
-  GPU_CHECK(cudaMemset(dev_filter_count_, 0, sizeof(int)));
-  postprocess_cuda_ptr_->DoPostprocessCuda(
-      reinterpret_cast<float*>(rpn_buffers_[1]),
-      reinterpret_cast<float*>(rpn_buffers_[2]),
-      reinterpret_cast<float*>(rpn_buffers_[3]), dev_anchor_mask_,
-      dev_anchors_px_, dev_anchors_py_, dev_anchors_pz_, dev_anchors_dx_,
-      dev_anchors_dy_, dev_anchors_dz_, dev_anchors_ro_, dev_filtered_box_,
-      dev_filtered_score_, dev_filtered_label_, dev_filtered_dir_,
-      dev_box_for_nms_, dev_filter_count_, out_detections, out_labels);
+  EnqueueRpn(batch_size, stream);
+
+  for (int i = 0; i < batch_size; ++i) {
+    GPU_CHECK(cudaMemset(dev_filter_count_, 0, sizeof(int)));
+    postprocess_cuda_ptr_->DoPostprocessCuda(
+        reinterpret_cast<float*>(rpn_buffers_[1]) + i * kRpnBoxOutputSize,
+        reinterpret_cast<float*>(rpn_buffers_[2]) + i * kRpnClsOutputSize,
+        reinterpret_cast<float*>(rpn_buffers_[3]) + i * kRpnDirOutputSize,
+        dev_anchor_mask_ + i * kNumAnchor, dev_anchors_px_, dev_anchors_py_,
+        dev_anchors_pz_, dev_anchors_dx_, dev_anchors_dy_, dev_anchors_dz_,
+        dev_anchors_ro_, dev_filtered_box_, dev_filtered_score_,
+        dev_filtered_label_, dev_filtered_dir_, dev_box_for_nms_,
+        dev_filter_count_, &(*out_detections)[i], &(*out_labels)[i]);
+  }
 
   // release the stream and the buffers
   cudaStreamDestroy(stream);
 }
 
+void PointPillars::EnqueueRpn(const int batch_size, cudaStream_t stream) {
+  if (rpn_dynamic_batch_) {
+    nvinfer1::Dims input_dims = rpn_input_dims_;
+    input_dims.d[0] = batch_size;
+    rpn_context_->setBindingDimensions(0, input_dims);
+    rpn_context_->enqueueV2(rpn_buffers_, stream, nullptr);
+    return;
+  }
+  for (int i = 0; i < batch_size; ++i) {
+    void* buffers[] = {
+        reinterpret_cast<float*>(rpn_buffers_[0]) + i * kRpnInputSize,
+        reinterpret_cast<float*>(rpn_buffers_[1]) + i * kRpnBoxOutputSize,
+        reinterpret_cast<float*>(rpn_buffers_[2]) + i * kRpnClsOutputSize,
+        reinterpret_cast<float*>(rpn_buffers_[3]) + i * kRpnDirOutputSize};
+    rpn_context_->enqueueV2(buffers, stream, nullptr);
+  }
+}
+
 }  // namespace lidar
 }  // namespace perception
 }  // namespace apollo
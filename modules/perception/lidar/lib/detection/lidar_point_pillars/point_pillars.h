@@ -149,6 +149,7 @@ class PointPillars {
   const float nms_overlap_threshold_;
   const std::string pfe_torch_file_;
   const std::string rpn_onnx_file_;
+  const int max_batch_size_;
   // end initializer list
 
   int host_pillar_count_[1];
@@ -176,6 +177,10 @@ class PointPillars {
   float* dev_pillar_point_feature_;
   float* dev_pillar_coors_;
 
+  // input points, kept across frames and only grown when a frame has more
+  float* dev_points_ = nullptr;
+  int dev_points_capacity_ = 0;
+
   float* dev_box_anchors_min_x_;
   float* dev_box_anchors_min_y_;
   float* dev_box_anchors_max_x_;
@@ -215,6 +220,9 @@ class PointPillars {
   nvinfer1::IExecutionContext* rpn_context_;
   nvinfer1::IRuntime* rpn_runtime_;
   nvinfer1::ICudaEngine* rpn_engine_;
+  // whether the rpn input has a dynamic batch dimension
+  bool rpn_dynamic_batch_ = false;
+  nvinfer1::Dims rpn_input_dims_;
 
   /**
    * @brief Memory allocation for device memory
@@ -325,6 +333,15 @@ class PointPillars {
    */
   void PutAnchorsInDeviceMemory();
 
+  /**
+   * @brief Run the RPN on the scattered features of a batch
+   * @param[in] batch_size Number of point clouds in the batch
+   * @param[in] stream Stream to enqueue the RPN on
+   * @details A single execution if the RPN has a dynamic batch dimension,
+   * otherwise one execution per point cloud
+   */
+  void EnqueueRpn(const int batch_size, cudaStream_t stream);
+
  public:
   /**
    * @brief Constructor
@@ -334,12 +351,14 @@ class PointPillars {
    * @param[in] nms_overlap_threshold IOU threshold for NMS
    * @param[in] pfe_torch_file Pillar Feature Extractor Torch file path
    * @param[in] rpn_onnx_file Region Proposal Network ONNX file path
+   * @param[in] max_batch_size Max number of point clouds of a batched
+   * inference
    * @details Variables could be changed through point_pillars_detection
    */
   PointPillars(const bool reproduce_result_mode, const float score_threshold,
                const float nms_overlap_threshold,
                const std::string pfe_torch_file,
-               const std::string rpn_onnx_file);
+               const std::string rpn_onnx_file, const int max_batch_size = 1);
   ~PointPillars();
 
   /**
@@ -353,6 +372,22 @@ class PointPillars {
   void DoInference(const float* in_points_array, const int in_num_points,
                    std::vector<float>* out_detections,
                    std::vector<int>* out_labels);
+
+  /**
+   * @brief Call PointPillars for the inference of several point clouds, e.g.
+   * of several lidars or sweeps
+   * @param[in] in_points_arrays Point cloud arrays, at most max_batch_size
+   * @param[in] in_num_points Number of points of each array
+   * @param[out] out_detections Network output bounding boxes of each array
+   * @param[out] out_labels Network output object's labels of each array
+   * @details The point clouds are voxelized one by one into a batched RPN
+   * input, the RPN runs on the whole batch, and the anchor mask and NMS are
+   * computed per point cloud
+   */
+  void DoInference(const std::vector<const float*>& in_points_arrays,
+                   const std::vector<int>& in_num_points,
+                   std::vector<std::vector<float>>* out_detections,
+                   std::vector<std::vector<int>>* out_labels);
 };
 
 }  // namespace lidar
@@ -182,7 +182,9 @@ bool PointPillarsDetection::Detect(const DetectionOptions& options,
   shuffle_time_ = timer.toc(true);
 
   // point cloud to array
-  float* points_array = new float[num_points * FLAGS_num_point_feature]();
+  points_array_blob_.Reshape({num_points, FLAGS_num_point_feature});
+  float* points_array = points_array_blob_.mutable_cpu_data();
+  std::fill(points_array, points_array + points_array_blob_.count(), 0.0f);
   CloudToArray(cur_cloud_ptr_, points_array, FLAGS_normalizing_factor);
   cloud_to_array_time_ = timer.toc(true);
 
@@ -206,7 +208,6 @@ bool PointPillarsDetection::Detect(const DetectionOptions& options,
         << "inference: " << inference_time_ << "\t"
         << "collect: " << collect_time_;
 
-  delete[] points_array;
   return true;
 }
 
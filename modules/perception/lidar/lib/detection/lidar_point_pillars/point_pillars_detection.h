@@ -23,6 +23,7 @@
 #include "pcl/point_cloud.h"
 #include "pcl/point_types.h"
 
+#include "modules/perception/base/blob.h"
 #include "modules/perception/base/object.h"
 #include "modules/perception/base/point_cloud.h"
 #include "modules/perception/lidar/common/lidar_frame.h"
@@ -73,6 +74,8 @@ class PointPillarsDetection {
   std::unique_ptr<PointPillars> point_pillars_ptr_;
   std::deque<base::PointDCloudPtr> prev_world_clouds_;
   base::PointFCloudPtr cur_cloud_ptr_;
+  // page-locked input array of the network, kept across frames
+  base::Blob<float> points_array_blob_{true};
 
   // point cloud range
   float x_min_;
@@ -674,6 +674,62 @@ TEST(TestSuite, CheckDoInference) {
   }
 }
 
+TEST(TestSuite, CheckDoInferenceBatch) {
+  const int kNumPointFeature = 5;
+  const float kNormalizingFactor = 255.0;
+  const int kBatchSize = 2;
+  TestClass test_obj;
+
+  pcl::PointCloud<pcl::PointXYZI>::Ptr pcl_pc_ptr(
+      new pcl::PointCloud<pcl::PointXYZI>);
+  apollo::perception::benchmark::PointCloudPtr org_cloud_ptr(
+      new pcl::PointCloud<apollo::perception::benchmark::PointXYZIL>);
+  std::string file_name =
+      "/apollo/modules/perception/testdata/lidar/app/data/0001_00.pcd";
+
+  bool ret = apollo::perception::benchmark::load_pcl_pcds_xyzit(file_name,
+                                                                org_cloud_ptr);
+  ASSERT_TRUE(ret) << "Failed to load pcd file: " << file_name;
+
+  for (size_t i = 0; i < org_cloud_ptr->size(); ++i) {
+    pcl::PointXYZI point;
+    point.x = org_cloud_ptr->at(i).x;
+    point.y = org_cloud_ptr->at(i).y;
+    point.z = org_cloud_ptr->at(i).z;
+    point.intensity = org_cloud_ptr->at(i).intensity;
+    pcl_pc_ptr->push_back(point);
+  }
+  std::vector<float> points_array(pcl_pc_ptr->size() * kNumPointFeature);
+  test_obj.PclXYZITToArray(pcl_pc_ptr, points_array.data(),
+                           kNormalizingFactor);
+  // the second point cloud only keeps the first half of the points
+  const int num_points = static_cast<int>(pcl_pc_ptr->size());
+  const std::vector<int> batch_num_points = {num_points, num_points / 2};
+
+  // reproducible preprocessing, so that both runs see the same pillars
+  PointPillars point_pillars(true, 0.5, 0.5, FLAGS_pfe_torch_file,
+                             FLAGS_rpn_onnx_file, kBatchSize);
+  std::vector<std::vector<float>> batch_detections;
+  std::vector<std::vector<int>> batch_labels;
+  point_pillars.DoInference(
+      std::vector<const float*>(kBatchSize, points_array.data()),
+      batch_num_points, &batch_detections, &batch_labels);
+  ASSERT_EQ(batch_detections.size(), kBatchSize);
+  ASSERT_EQ(batch_labels.size(), kBatchSize);
+
+  for (int i = 0; i < kBatchSize; ++i) {
+    std::vector<float> out_detections;
+    std::vector<int> out_labels;
+    point_pillars.DoInference(points_array.data(), batch_num_points[i],
+                              &out_detections, &out_labels);
+    EXPECT_EQ(batch_labels[i], out_labels);
+    ASSERT_EQ(batch_detections[i].size(), out_detections.size());
+    for (size_t j = 0; j < out_detections.size(); ++j) {
+      EXPECT_NEAR(batch_detections[i][j], out_detections[j], 1e-4);
+    }
+  }
+}
+
 }  // namespace lidar
 }  // namespace perception
 }  // namespace apollo
@@ -16,7 +16,10 @@
 
 #include "modules/perception/lidar/lib/ground_detector/spatio_temporal_ground_detector/spatio_temporal_ground_detector.h"
 
+#include <algorithm>
+
 #include "cyber/common/file.h"
+#include "modules/perception/common/perception_gflags.h"
 #include "modules/perception/common/point_cloud_processing/common.h"
 #include "modules/perception/lib/config_manager/config_manager.h"
 #include "modules/perception/lidar/common/lidar_log.h"
@@ -60,6 +63,8 @@ bool SpatioTemporalGroundDetector::Init(
   param_->roi_region_rad_z = config_params.roi_rad_z();
   param_->nr_grids_coarse = config_params.grid_size();
   param_->nr_smooth_iter = config_params.nr_smooth_iter();
+  param_->nr_threads =
+      static_cast<unsigned int>(std::max(FLAGS_ground_detector_num_threads, 1));
 
   pfdetector_ = new common::PlaneFitGroundDetector(*param_);
   pfdetector_->Init();
@@ -18,7 +18,7 @@
 #include <algorithm>
 
 #include "modules/perception/common/geometry/common.h"
-#include "modules/perception/common/geometry/convex_hull_2d.h"
+#include "modules/perception/common/perception_gflags.h"
 #include "modules/perception/lib/config_manager/config_manager.h"
 // #include "modules/perception/lib/io/protobuf_util.h"
 
@@ -36,6 +36,13 @@ using PointFCloud = apollo::perception::base::PointCloud<PointF>;
 using PolygonDType = apollo::perception::base::PointCloud<PointD>;
 
 bool ObjectBuilder::Init(const ObjectBuilderInitOptions& options) {
+  num_threads_ =
+      static_cast<size_t>(std::max(FLAGS_object_builder_num_threads, 1));
+  hulls_ = std::vector<ConvexHull>(num_threads_);
+  if (num_threads_ > 1 && thread_pool_ == nullptr) {
+    thread_pool_.reset(new lib::ThreadPool(static_cast<int>(num_threads_) - 1));
+    thread_pool_->Start();
+  }
   return true;
 }
 
@@ -48,15 +55,43 @@ bool ObjectBuilder::Build(const ObjectBuilderOptions& options,
   for (size_t i = 0; i < objects->size(); ++i) {
     if (objects->at(i)) {
       objects->at(i)->id = static_cast<int>(i);
-      ComputePolygon2D(objects->at(i));
-      ComputePolygonSizeCenter(objects->at(i));
-      ComputeOtherObjectInformation(objects->at(i));
     }
   }
+  objects_ = objects;
+  next_object_ = 0;
+  const size_t num_tasks = std::min(num_threads_, objects->size());
+  if (thread_pool_ == nullptr || num_tasks <= 1) {
+    BuildObjects(0, nullptr);
+  } else {
+    lib::BlockingCounter counter(num_tasks - 1);
+    for (size_t i = 1; i < num_tasks; ++i) {
+      thread_pool_->Add(google::protobuf::NewCallback(
+          this, &ObjectBuilder::BuildObjects, i, &counter));
+    }
+    BuildObjects(0, nullptr);
+    counter.Wait();
+  }
+  objects_ = nullptr;
   return true;
 }
 
-void ObjectBuilder::ComputePolygon2D(ObjectPtr object) {
+void ObjectBuilder::BuildObjects(size_t thread_id,
+                                 lib::BlockingCounter* counter) {
+  ConvexHull* hull = &hulls_[thread_id];
+  for (size_t i = next_object_++; i < objects_->size(); i = next_object_++) {
+    const ObjectPtr& object = objects_->at(i);
+    if (object) {
+      ComputePolygon2D(object, hull);
+      ComputePolygonSizeCenter(object);
+      ComputeOtherObjectInformation(object);
+    }
+  }
+  if (counter != nullptr) {
+    counter->Decrement();
+  }
+}
+
+void ObjectBuilder::ComputePolygon2D(ObjectPtr object, ConvexHull* hull) {
   Eigen::Vector3f min_pt;
   Eigen::Vector3f max_pt;
   PointFCloud& cloud = object->lidar_supplement.cloud;
@@ -66,8 +101,7 @@ void ObjectBuilder::ComputePolygon2D(ObjectPtr object) {
     return;
   }
   LinePerturbation(&cloud);
-  common::ConvexHull2D<PointFCloud, PolygonDType> hull;
-  hull.GetConvexHull(cloud, &(object->polygon));
+  hull->GetConvexHull(cloud, &(object->polygon));
 }
 
 void ObjectBuilder::ComputeOtherObjectInformation(ObjectPtr object) {
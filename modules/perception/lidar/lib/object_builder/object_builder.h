@@ -15,6 +15,7 @@
  *****************************************************************************/
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <vector>
@@ -22,7 +23,9 @@
 #include "modules/perception/base/object.h"
 #include "modules/perception/base/point.h"
 #include "modules/perception/base/point_cloud.h"
+#include "modules/perception/common/geometry/convex_hull_2d.h"
 #include "modules/perception/lib/registerer/registerer.h"
+#include "modules/perception/lib/thread/thread_pool.h"
 #include "modules/perception/lidar/common/lidar_frame.h"
 
 namespace apollo {
@@ -53,11 +56,25 @@ class ObjectBuilder {
   std::string Name() const { return "ObjectBuilder"; }
 
  private:
+  typedef common::ConvexHull2D<
+      apollo::perception::base::PointCloud<apollo::perception::base::PointF>,
+      apollo::perception::base::PointCloud<apollo::perception::base::PointD>>
+      ConvexHull;
+
+  // @brief: build the objects taken from the shared index, until all are
+  //         built. Every thread runs one, so that large clusters do not
+  //         hold back the others.
+  // @param [in]: index of the thread.
+  // @param [in/out]: counter decremented when done, may be nullptr.
+  void BuildObjects(size_t thread_id, lib::BlockingCounter* counter);
+
   // @brief: calculate 2d polygon.
   //         and fill the convex hull vertices in object->polygon.
   // @param [in/out]: ObjectPtr.
+  // @param [in]: hull reused across the objects of a thread.
   void ComputePolygon2D(
-      std::shared_ptr<apollo::perception::base::Object> object);
+      std::shared_ptr<apollo::perception::base::Object> object,
+      ConvexHull* hull);
 
   // @brief: calculate the size, center of polygon.
   // @param [in/out]: ObjectPtr.
@@ -90,6 +107,14 @@ class ObjectBuilder {
   void GetMinMax3D(const apollo::perception::base::PointCloud<
                        apollo::perception::base::PointF>& cloud,
                    Eigen::Vector3f* min_pt, Eigen::Vector3f* max_pt);
+
+ private:
+  size_t num_threads_ = 1;
+  std::unique_ptr<lib::ThreadPool> thread_pool_;
+  std::vector<ConvexHull> hulls_ = std::vector<ConvexHull>(1);
+  std::vector<std::shared_ptr<apollo::perception::base::Object>>* objects_ =
+      nullptr;
+  std::atomic<size_t> next_object_{0};
 };  // class ObjectBuilder
 
 }  // namespace lidar
@@ -16,6 +16,8 @@
 
 #include "modules/perception/lidar/lib/roi_filter/hdmap_roi_filter/bitmap2d.h"
 
+#include <algorithm>
+
 #include "modules/perception/lidar/common/lidar_log.h"
 
 namespace apollo {
@@ -124,6 +126,56 @@ bool Bitmap2D::Check(const Eigen::Vector2d& p) const {
   return CheckBit(bit_p.z(), bitmap_[idx]);
 }
 
+void Bitmap2D::BatchCheck(const float* xs, const float* ys, const size_t size,
+                          const Eigen::Vector2d& offset,
+                          uint8_t* results) const {
+  const int major = dir_major();
+  const int minor = op_dir_major();
+  const float* major_coords = major == 0 ? xs : ys;
+  const float* minor_coords = major == 0 ? ys : xs;
+  const double major_offset = offset[major];
+  const double minor_offset = offset[minor];
+  const double major_min = min_range_[major];
+  const double major_max = max_range_[major];
+  const double minor_min = min_range_[minor];
+  const double minor_max = max_range_[minor];
+  const double major_cell = cell_size_[major];
+  const double minor_cell = cell_size_[minor];
+  const size_t blocks_per_row = map_size_[1];
+
+  static constexpr size_t kBatchSize = 16;
+  size_t major_pix[kBatchSize];
+  size_t minor_pix[kBatchSize];
+  uint8_t inside[kBatchSize];
+  for (size_t begin = 0; begin < size; begin += kBatchSize) {
+    const size_t batch_size = std::min(kBatchSize, size - begin);
+    // branch free, so that the compiler vectorizes the range check and the
+    // pixel computation of the batch
+    for (size_t i = 0; i < batch_size; ++i) {
+      const double p_major =
+          static_cast<double>(major_coords[begin + i]) + major_offset;
+      const double p_minor =
+          static_cast<double>(minor_coords[begin + i]) + minor_offset;
+      inside[i] = static_cast<uint8_t>(
+          (p_major >= major_min) & (p_major < major_max) &
+          (p_minor >= minor_min) & (p_minor < minor_max));
+      // points out of range look up the first block and are masked below
+      major_pix[i] = inside[i] ? static_cast<size_t>((p_major - major_min) /
+                                                     major_cell)
+                               : 0;
+      minor_pix[i] = inside[i] ? static_cast<size_t>((p_minor - minor_min) /
+                                                     minor_cell)
+                               : 0;
+    }
+    for (size_t i = 0; i < batch_size; ++i) {
+      const uint64_t block =
+          bitmap_[major_pix[i] * blocks_per_row + (minor_pix[i] >> 6)];
+      results[begin + i] = static_cast<uint8_t>(
+          inside[i] & ((block >> (minor_pix[i] & 63)) & 1));
+    }
+  }
+}
+
 // set and reset
 void Bitmap2D::Set(const Eigen::Vector2d& p) {
   const Vec3ui bit_p = RealToBitmap(p);
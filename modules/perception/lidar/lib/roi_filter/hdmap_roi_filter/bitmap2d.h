@@ -56,6 +56,10 @@ class Bitmap2D {
   bool IsExists(const Eigen::Vector2d& p) const;
 
   bool Check(const Eigen::Vector2d& p) const;
+  // check a batch of points given by separate coordinates, each shifted by
+  // offset, results[i] is 0 for a point out of range
+  void BatchCheck(const float* xs, const float* ys, const size_t size,
+                  const Eigen::Vector2d& offset, uint8_t* results) const;
   void Set(const Eigen::Vector2d& p);
   void Reset(const Eigen::Vector2d& p);
 
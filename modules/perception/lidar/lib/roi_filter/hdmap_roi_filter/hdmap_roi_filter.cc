@@ -17,8 +17,10 @@
 #include "modules/perception/lidar/lib/roi_filter/hdmap_roi_filter/hdmap_roi_filter.h"
 
 #include <algorithm>
+#include <functional>
 
 #include "cyber/common/file.h"
+#include "modules/perception/common/perception_gflags.h"
 #include "modules/perception/lib/config_manager/config_manager.h"
 #include "modules/perception/lidar/common/lidar_point_label.h"
 #include "modules/perception/lidar/lib/roi_filter/hdmap_roi_filter/polygon_mask.h"
@@ -54,24 +56,29 @@ bool HdmapROIFilter::Init(const ROIFilterInitOptions& options) {
   extend_dist_ = config.extend_dist();
   no_edge_table_ = config.no_edge_table();
   set_roi_service_ = config.set_roi_service();
+  cache_margin_ = std::max(FLAGS_hdmap_roi_filter_cache_margin, 0.0);
 
   // reserve mem
   const size_t KPolygonMaxNum = 100;
   polygons_world_.reserve(KPolygonMaxNum);
   polygons_local_.reserve(KPolygonMaxNum);
 
-  // init bitmap
-  Eigen::Vector2d min_range(-range_, -range_);
-  Eigen::Vector2d max_range(range_, range_);
+  // init bitmap, which covers the margin the vehicle may move before it is
+  // rasterized again
+  const double bitmap_range = range_ + cache_margin_;
+  Eigen::Vector2d min_range(-bitmap_range, -bitmap_range);
+  Eigen::Vector2d max_range(bitmap_range, bitmap_range);
   Eigen::Vector2d cell_size(cell_size_, cell_size_);
   bitmap_.Init(min_range, max_range, cell_size);
+  bitmap_valid_ = false;
 
   // output input parameters
   AINFO << " HDMap Roi Filter Parameters: "
         << " range: " << range_ << " cell_size: " << cell_size_
         << " extend_dist: " << extend_dist_
         << " no_edge_table: " << no_edge_table_
-        << " set_roi_service: " << set_roi_service_;
+        << " set_roi_service: " << set_roi_service_
+        << " cache_margin: " << cache_margin_;
   return true;
 }
 
@@ -101,13 +108,14 @@ bool HdmapROIFilter::Filter(const ROIFilterOptions& options,
     polygons_world_[i++] = &polygon;
   }
 
-  // transform to local
-  base::PointFCloudPtr cloud_local = base::PointFCloudPool::Instance().Get();
-  TransformFrame(frame->cloud, frame->lidar2world_pose, polygons_world_,
-                 &polygons_local_, &cloud_local);
-
-  bool ret = FilterWithPolygonMask(cloud_local, polygons_local_,
-                                   &(frame->roi_indices));
+  const Eigen::Vector2d vel_location =
+      frame->lidar2world_pose.translation().head<2>();
+  bool ret = UpdateBitmap(polygons_world_, vel_location);
+  if (ret) {
+    TransformFrame(frame->cloud, frame->lidar2world_pose);
+    ret = Bitmap2dFilter(vel_location - bitmap_origin_, bitmap_,
+                         &(frame->roi_indices));
+  }
 
   // set roi points label
   if (ret) {
@@ -123,13 +131,14 @@ bool HdmapROIFilter::Filter(const ROIFilterOptions& options,
   if (set_roi_service_) {
     auto roi_service = SceneManager::Instance().Service("ROIService");
     if (roi_service != nullptr) {
-      roi_service_content_.range_ = range_;
+      roi_service_content_.range_ = range_ + cache_margin_;
       roi_service_content_.cell_size_ = cell_size_;
       roi_service_content_.map_size_ = bitmap_.map_size();
       roi_service_content_.bitmap_ = bitmap_.bitmap();
       roi_service_content_.major_dir_ =
           static_cast<ROIServiceContent::DirectionMajor>(bitmap_.dir_major());
       roi_service_content_.transform_ = frame->lidar2world_pose.translation();
+      roi_service_content_.transform_.head<2>() = bitmap_origin_;
       if (!ret) {
         std::fill(roi_service_content_.bitmap_.begin(),
                   roi_service_content_.bitmap_.end(), -1);
@@ -142,14 +151,60 @@ bool HdmapROIFilter::Filter(const ROIFilterOptions& options,
   return ret;
 }
 
-bool HdmapROIFilter::FilterWithPolygonMask(
-    const base::PointFCloudPtr& cloud,
-    const std::vector<PolygonDType>& map_polygons,
-    base::PointIndices* roi_indices) {
+bool HdmapROIFilter::UpdateBitmap(
+    const std::vector<PolygonDType*>& polygons_world,
+    const Eigen::Vector2d& vel_location) {
+  const size_t signature = PolygonsSignature(polygons_world);
+  const Eigen::Vector2d vel_offset = vel_location - bitmap_origin_;
+  if (bitmap_valid_ && signature == polygons_signature_ &&
+      vel_offset.cwiseAbs().maxCoeff() <= cache_margin_) {
+    return true;
+  }
+
+  // transform polygons to the new origin
+  bitmap_origin_ = vel_location;
+  polygons_signature_ = signature;
+  polygons_local_.clear();
+  polygons_local_.resize(polygons_world.size());
+  for (size_t i = 0; i < polygons_local_.size(); ++i) {
+    const auto& polygon_world = *(polygons_world[i]);
+    auto& polygon_local = polygons_local_[i];
+    polygon_local.resize(polygon_world.size());
+    for (size_t j = 0; j < polygon_local.size(); ++j) {
+      polygon_local[j].x = polygon_world[j].x - bitmap_origin_.x();
+      polygon_local[j].y = polygon_world[j].y - bitmap_origin_.y();
+    }
+  }
+  bitmap_valid_ = DrawPolygons(polygons_local_);
+  return bitmap_valid_;
+}
+
+size_t HdmapROIFilter::PolygonsSignature(
+    const std::vector<PolygonDType*>& polygons_world) const {
+  std::hash<double> hasher;
+  size_t signature = polygons_world.size();
+  auto combine = [&signature](const size_t value) {
+    signature ^= value + 0x9e3779b9 + (signature << 6) + (signature >> 2);
+  };
+  combine(hasher(extend_dist_));
+  combine(static_cast<size_t>(no_edge_table_));
+  for (const auto* polygon : polygons_world) {
+    combine(polygon->size());
+    for (const auto& point : *polygon) {
+      combine(hasher(point.x));
+      combine(hasher(point.y));
+    }
+  }
+  return signature;
+}
+
+bool HdmapROIFilter::DrawPolygons(
+    const std::vector<PolygonDType>& map_polygons) {
   std::vector<Polygon<double>> raw_polygons;
   // convert and obtain the major direction
   raw_polygons.resize(map_polygons.size());
-  double min_x = range_;
+  const double bitmap_range = range_ + cache_margin_;
+  double min_x = bitmap_range;
   double max_x = -min_x;
   double min_y = min_x;
   double max_y = max_x;
@@ -167,10 +222,10 @@ bool HdmapROIFilter::FilterWithPolygonMask(
       max_y = std::max(raw_polygon[j].y(), max_y);
     }
   }
-  min_x = std::max(min_x, -range_);
-  max_x = std::min(max_x, range_);
-  min_y = std::max(min_y, -range_);
-  max_y = std::min(max_y, range_);
+  min_x = std::max(min_x, -bitmap_range);
+  max_x = std::min(max_x, bitmap_range);
+  min_y = std::max(min_y, -bitmap_range);
+  max_y = std::min(max_y, bitmap_range);
 
   DirectionMajor major_dir = DirectionMajor::XMAJOR;
   if ((max_y - min_y) < (max_x - min_x)) {
@@ -179,61 +234,46 @@ bool HdmapROIFilter::FilterWithPolygonMask(
   bitmap_.SetUp(major_dir);
 
   return DrawPolygonsMask<double>(raw_polygons, &bitmap_, extend_dist_,
-                                  no_edge_table_) &&
-         Bitmap2dFilter(cloud, bitmap_, roi_indices);
+                                  no_edge_table_);
 }
 
-void HdmapROIFilter::TransformFrame(
-    const base::PointFCloudPtr& cloud, const Eigen::Affine3d& vel_pose,
-    const std::vector<PolygonDType*>& polygons_world,
-    std::vector<PolygonDType>* polygons_local,
-    base::PointFCloudPtr* cloud_local) {
-  Eigen::Vector3d vel_location = vel_pose.translation();
+void HdmapROIFilter::TransformFrame(const base::PointFCloudPtr& cloud,
+                                    const Eigen::Affine3d& vel_pose) {
   Eigen::Matrix3d vel_rot = vel_pose.linear();
   Eigen::Vector3d x_axis = vel_rot.row(0);
   Eigen::Vector3d y_axis = vel_rot.row(1);
 
-  // transform polygons
-  polygons_local->clear();
-  polygons_local->resize(polygons_world.size());
-  for (size_t i = 0; i < polygons_local->size(); ++i) {
-    const auto& polygon_world = *(polygons_world[i]);
-    auto& polygon_local = (*polygons_local)[i];
-    polygon_local.resize(polygon_world.size());
-    for (size_t j = 0; j < polygon_local.size(); ++j) {
-      polygon_local[j].x = polygon_world[j].x - vel_location.x();
-      polygon_local[j].y = polygon_world[j].y - vel_location.y();
-    }
-  }
-
   // transform cloud
-  (*cloud_local)->clear();
-  (*cloud_local)->resize(cloud->size());
-  for (size_t i = 0; i < (*cloud_local)->size(); ++i) {
+  points_x_.resize(cloud->size());
+  points_y_.resize(cloud->size());
+  for (size_t i = 0; i < cloud->size(); ++i) {
     const auto& pt = cloud->at(i);
-    auto& local_pt = (*cloud_local)->at(i);
     Eigen::Vector3d e_pt(pt.x, pt.y, pt.z);
-    local_pt.x = static_cast<float>(x_axis.dot(e_pt));
-    local_pt.y = static_cast<float>(y_axis.dot(e_pt));
+    points_x_[i] = static_cast<float>(x_axis.dot(e_pt));
+    points_y_[i] = static_cast<float>(y_axis.dot(e_pt));
   }
 }
 
-bool HdmapROIFilter::Bitmap2dFilter(const base::PointFCloudPtr& in_cloud,
+bool HdmapROIFilter::Bitmap2dFilter(const Eigen::Vector2d& vel_offset,
                                     const Bitmap2D& bitmap,
                                     base::PointIndices* roi_indices) {
-  if (!bitmap.Check(Eigen::Vector2d(0.0, 0.0))) {
+  if (!bitmap.Check(vel_offset)) {
     AWARN << " Car is not in roi!!.";
     return false;
   }
+  const size_t size = points_x_.size();
+  roi_check_results_.resize(size);
+  bitmap.BatchCheck(points_x_.data(), points_y_.data(), size, vel_offset,
+                    roi_check_results_.data());
+
   roi_indices->indices.clear();
-  roi_indices->indices.reserve(in_cloud->size());
-  for (size_t i = 0; i < in_cloud->size(); ++i) {
-    const auto& pt = in_cloud->at(i);
-    Eigen::Vector2d e_pt(pt.x, pt.y);
-    if (!bitmap.IsExists(e_pt)) {
-      continue;
-    }
-    if (bitmap.Check(e_pt)) {
+  roi_indices->indices.reserve(size);
+  for (size_t i = 0; i < size; ++i) {
+    // only points within range_ of the vehicle, the cached bitmap is larger
+    const double x = points_x_[i];
+    const double y = points_y_[i];
+    if (roi_check_results_[i] && x >= -range_ && x < range_ && y >= -range_ &&
+        y < range_) {
       roi_indices->indices.push_back(static_cast<int>(i));
     }
   }
@@ -45,29 +45,41 @@ class HdmapROIFilter : public BaseROIFilter {
   bool Filter(const ROIFilterOptions& options, LidarFrame* frame) override;
 
  private:
+  // the bitmap is rasterized around bitmap_origin_ in the world frame and
+  // reused while the map polygons do not change and the vehicle stays within
+  // cache_margin_ of the origin
+  bool UpdateBitmap(const std::vector<base::PolygonDType*>& polygons_world,
+                    const Eigen::Vector2d& vel_location);
+
+  // rotate the cloud into the world frame around the vehicle, storing the
+  // coordinates in points_x_ and points_y_
   void TransformFrame(const base::PointFCloudPtr& cloud,
-                      const Eigen::Affine3d& vel_pose,
-                      const std::vector<base::PolygonDType*>& polygons_world,
-                      std::vector<base::PolygonDType>* polygons_local,
-                      base::PointFCloudPtr* cloud_local);
+                      const Eigen::Affine3d& vel_pose);
 
-  bool FilterWithPolygonMask(
-      const base::PointFCloudPtr& cloud,
-      const std::vector<base::PolygonDType>& map_polygons,
-      base::PointIndices* roi_indices);
+  bool DrawPolygons(const std::vector<base::PolygonDType>& map_polygons);
 
-  bool Bitmap2dFilter(const base::PointFCloudPtr& in_cloud,
+  bool Bitmap2dFilter(const Eigen::Vector2d& vel_offset,
                       const Bitmap2D& bitmap, base::PointIndices* roi_indices);
 
+  size_t PolygonsSignature(
+      const std::vector<base::PolygonDType*>& polygons_world) const;
+
   // parameters for polygons scans convert
   double range_ = 120.0;
   double cell_size_ = 0.25;
   double extend_dist_ = 0.0;
   bool no_edge_table_ = false;
   bool set_roi_service_ = false;
+  double cache_margin_ = 0.0;
   std::vector<base::PolygonDType*> polygons_world_;
   std::vector<base::PolygonDType> polygons_local_;
   Bitmap2D bitmap_;
+  bool bitmap_valid_ = false;
+  Eigen::Vector2d bitmap_origin_ = Eigen::Vector2d::Zero();
+  size_t polygons_signature_ = 0;
+  std::vector<float> points_x_;
+  std::vector<float> points_y_;
+  std::vector<uint8_t> roi_check_results_;
   ROIServiceContent roi_service_content_;
 
   // unit tests only
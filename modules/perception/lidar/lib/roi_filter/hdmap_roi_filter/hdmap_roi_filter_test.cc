@@ -84,6 +84,39 @@ TEST(hdmap_roi_filter_bitmap2d_test, test_bitmap) {
   AINFO << bitmap;
 }
 
+TEST(hdmap_roi_filter_bitmap2d_test, test_bitmap_batch_check) {
+  for (const auto major_dir :
+       {DirectionMajor::XMAJOR, DirectionMajor::YMAJOR}) {
+    Bitmap2D bitmap;
+    bitmap.Init(Eigen::Vector2d(-20.0, -20.0), Eigen::Vector2d(20.0, 20.0),
+                Eigen::Vector2d(0.25, 0.25));
+    bitmap.SetUp(major_dir);
+    bitmap.Set(-3.1, -15.2, 12.7);
+    bitmap.Set(5.6, 0.1, 19.9);
+    bitmap.Set(Eigen::Vector2d(10.3, -7.4));
+
+    const Eigen::Vector2d offset(1.5, -2.25);
+    std::vector<float> xs;
+    std::vector<float> ys;
+    for (float x = -25.0f; x < 25.0f; x += 0.37f) {
+      for (float y = -25.0f; y < 25.0f; y += 0.41f) {
+        xs.push_back(x);
+        ys.push_back(y);
+      }
+    }
+    std::vector<uint8_t> results(xs.size());
+    bitmap.BatchCheck(xs.data(), ys.data(), xs.size(), offset, results.data());
+    size_t inside_num = 0;
+    for (size_t i = 0; i < xs.size(); ++i) {
+      const Eigen::Vector2d p(xs[i] + offset.x(), ys[i] + offset.y());
+      const bool expected = bitmap.IsExists(p) && bitmap.Check(p);
+      EXPECT_EQ(expected, results[i] != 0);
+      inside_num += expected;
+    }
+    EXPECT_GT(inside_num, 0);
+  }
+}
+
 // polygon scan test
 TEST(hdmap_roi_filter_bitmap2d_test, test_polygon_scan_cvter) {
   Edge edge;
@@ -42,6 +42,10 @@ void SppEngine::Init(size_t width, size_t height, float range,
   range_ = range;
   // bind worker
   worker_.Bind([&]() {
+#if USE_GPU == 1
+    // clustered on gpu, the category data is only needed to filter clusters
+    data_.category_pt_blob->cpu_data();
+#endif
     data_.confidence_pt_blob->cpu_data();
     data_.classify_pt_blob->cpu_data();
     data_.heading_pt_blob->cpu_data();
@@ -54,11 +58,21 @@ void SppEngine::Init(size_t width, size_t height, float range,
 size_t SppEngine::ProcessConnectedComponentCluster(
     const base::PointFCloudConstPtr point_cloud, const CloudMask& mask) {
   Timer timer;
+#if USE_GPU == 1
+  // the instance data never leaves the gpu
+  const float* category_gpu_data = data_.category_pt_blob->gpu_data();
+  const float* instance_gpu_data = data_.instance_pt_blob->gpu_data();
+  double sync_time1 = timer.toc(true);
+  worker_.WakeUp();
+  size_t num = detector_2d_cc_.DetectGPU(category_gpu_data, instance_gpu_data,
+                                         &labels_2d_);
+#else
   data_.category_pt_blob->cpu_data();
   data_.instance_pt_blob->cpu_data();
   double sync_time1 = timer.toc(true);
   worker_.WakeUp();
   size_t num = detector_2d_cc_.Detect(&labels_2d_);
+#endif
   if (num == 0) {
     ADEBUG << "No object detected";
     // Later will decide if return this function here
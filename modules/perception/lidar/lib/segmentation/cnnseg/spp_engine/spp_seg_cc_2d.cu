@@ -0,0 +1,308 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#include <thrust/execution_policy.h>
+#include <thrust/scan.h>
+
+#include "modules/perception/lidar/common/lidar_log.h"
+#include "modules/perception/lidar/common/lidar_timer.h"
+#include "modules/perception/lidar/lib/segmentation/cnnseg/spp_engine/spp_seg_cc_2d.h"
+
+namespace apollo {
+namespace perception {
+namespace lidar {
+
+// The clusters are the same as the ones of SppCCDetector::Detect:
+// every node points to the center node given by its offset, the nodes on
+// the cycles reached from object nodes are centers, adjacent centers are
+// merged, and each object node takes the cluster of the cycle it reaches.
+// Labels are numbered by the first node of each cluster in row-major order.
+
+#define CUDA_KERNEL_LOOP(i, n)                                 \
+  for (int i = blockIdx.x * blockDim.x + threadIdx.x; i < (n); \
+       i += blockDim.x * gridDim.x)
+
+template <typename Dtype>
+__global__ void SetKernel(const int n, const Dtype alpha, Dtype* y) {
+  CUDA_KERNEL_LOOP(i, n) { y[i] = alpha; }
+}
+
+__global__ void BuildNodesKernel(const int rows, const int cols,
+                                 const float* prob_map,
+                                 const float* offset_map, const float scale,
+                                 const float objectness_threshold,
+                                 uint8_t* is_object, int* center,
+                                 int* min_node, int* parent) {
+  const int n = rows * cols;
+  CUDA_KERNEL_LOOP(i, n) {
+    const int row = i / cols;
+    const int col = i % cols;
+    is_object[i] = prob_map[i] >= objectness_threshold;
+    // rounded as on the host, without fused multiply-add
+    int center_row = static_cast<int>(__fadd_rn(
+        __fadd_rn(__fmul_rn(offset_map[i], scale), static_cast<float>(row)),
+        0.5f));
+    int center_col = static_cast<int>(__fadd_rn(
+        __fadd_rn(__fmul_rn(offset_map[n + i], scale), static_cast<float>(col)),
+        0.5f));
+    center_row = max(0, min(rows - 1, center_row));
+    center_col = max(0, min(cols - 1, center_col));
+    center[i] = center_row * cols + center_col;
+    min_node[i] = i;
+    parent[i] = i;
+  }
+}
+
+// doubles the steps each node has followed along its chain
+__global__ void JumpKernel(const int n, const int* center, const int* min_node,
+                           int* center_out, int* min_node_out) {
+  CUDA_KERNEL_LOOP(i, n) {
+    const int next = center[i];
+    center_out[i] = center[next];
+    min_node_out[i] = min(min_node[i], min_node[next]);
+  }
+}
+
+// after at least n steps every chain has reached its cycle, and the min node
+// followed from there is the smallest node of the cycle
+__global__ void CycleKernel(const int n, const int* center,
+                            const int* min_node, const uint8_t* is_object,
+                            int* cycle, uint8_t* on_cycle,
+                            uint8_t* cycle_reached) {
+  CUDA_KERNEL_LOOP(i, n) {
+    const int landing = center[i];
+    cycle[i] = min_node[landing];
+    on_cycle[landing] = 1;
+    if (is_object[i]) {
+      cycle_reached[cycle[i]] = 1;
+    }
+  }
+}
+
+__device__ bool IsCenter(const int i, const int* cycle,
+                         const uint8_t* on_cycle,
+                         const uint8_t* cycle_reached) {
+  return on_cycle[i] && cycle_reached[cycle[i]];
+}
+
+__device__ int DisjointSetFind(const int* parent, int x) {
+  const volatile int* volatile_parent = parent;
+  int p = volatile_parent[x];
+  while (p != x) {
+    x = p;
+    p = volatile_parent[x];
+  }
+  return x;
+}
+
+// the larger root is hooked under the smaller one, so every root ends up
+// the smallest node of its set
+__device__ void DisjointSetUnion(int* parent, int x, int y) {
+  while (true) {
+    x = DisjointSetFind(parent, x);
+    y = DisjointSetFind(parent, y);
+    if (x == y) {
+      return;
+    }
+    if (x > y) {
+      const int temp = x;
+      x = y;
+      y = temp;
+    }
+    const int old = atomicMin(&parent[y], x);
+    if (old == y) {
+      return;
+    }
+    y = old;
+  }
+}
+
+__global__ void UnionKernel(const int rows, const int cols, const int* cycle,
+                            const uint8_t* on_cycle,
+                            const uint8_t* cycle_reached, int* parent) {
+  CUDA_KERNEL_LOOP(i, rows * cols) {
+    if (!IsCenter(i, cycle, on_cycle, cycle_reached)) {
+      continue;
+    }
+    const int row = i / cols;
+    const int col = i % cols;
+    // the nodes of a cycle are in one set
+    DisjointSetUnion(parent, i, cycle[i]);
+    // right, down, right down and left down
+    if (col < cols - 1 && IsCenter(i + 1, cycle, on_cycle, cycle_reached)) {
+      DisjointSetUnion(parent, i, i + 1);
+    }
+    if (row < rows - 1) {
+      if (IsCenter(i + cols, cycle, on_cycle, cycle_reached)) {
+        DisjointSetUnion(parent, i, i + cols);
+      }
+      if (col < cols - 1 &&
+          IsCenter(i + cols + 1, cycle, on_cycle, cycle_reached)) {
+        DisjointSetUnion(parent, i, i + cols + 1);
+      }
+      if (col > 0 && IsCenter(i + cols - 1, cycle, on_cycle, cycle_reached)) {
+        DisjointSetUnion(parent, i, i + cols - 1);
+      }
+    }
+  }
+}
+
+__global__ void FirstNodeKernel(const int n, const uint8_t* is_object,
+                                const int* cycle, const int* parent,
+                                int* first_node) {
+  CUDA_KERNEL_LOOP(i, n) {
+    if (is_object[i]) {
+      atomicMin(&first_node[DisjointSetFind(parent, cycle[i])], i);
+    }
+  }
+}
+
+__global__ void HeadKernel(const int n, const uint8_t* is_object,
+                           const int* cycle, const int* parent,
+                           const int* first_node, int* is_head) {
+  CUDA_KERNEL_LOOP(i, n) {
+    is_head[i] =
+        is_object[i] && first_node[DisjointSetFind(parent, cycle[i])] == i;
+  }
+}
+
+__global__ void LabelKernel(const int n, const uint8_t* is_object,
+                            const int* cycle, const int* parent,
+                            const int* first_node, const int* label_id,
+                            uint16_t* labels) {
+  CUDA_KERNEL_LOOP(i, n) {
+    labels[i] =
+        is_object[i]
+            ? static_cast<uint16_t>(
+                  label_id[first_node[DisjointSetFind(parent, cycle[i])]])
+            : 0;
+  }
+}
+
+size_t SppCCDetector::DetectGPU(const float* prob_map_gpu,
+                                const float* offset_map_gpu,
+                                SppLabelImage* labels) {
+  Timer timer;
+  const int n = rows_ * cols_;
+  const int block_size = (n + kGPUThreadSize - 1) / kGPUThreadSize;
+  BuildNodesKernel<<<block_size, kGPUThreadSize>>>(
+      rows_, cols_, prob_map_gpu, offset_map_gpu, scale_,
+      objectness_threshold_, is_object_gpu_, center_gpu_[0], min_node_gpu_[0],
+      parent_gpu_);
+  BASE_CUDA_CHECK(cudaMemset(on_cycle_gpu_, 0, sizeof(uint8_t) * n));
+  BASE_CUDA_CHECK(cudaMemset(cycle_reached_gpu_, 0, sizeof(uint8_t) * n));
+  SetKernel<int><<<block_size, kGPUThreadSize>>>(n, n, first_node_gpu_);
+  double init_time = timer.toc(true);
+
+  int current = 0;
+  for (int steps = 1; steps < n; steps *= 2) {
+    JumpKernel<<<block_size, kGPUThreadSize>>>(
+        n, center_gpu_[current], min_node_gpu_[current],
+        center_gpu_[1 - current], min_node_gpu_[1 - current]);
+    current = 1 - current;
+  }
+  CycleKernel<<<block_size, kGPUThreadSize>>>(
+      n, center_gpu_[current], min_node_gpu_[current], is_object_gpu_,
+      cycle_gpu_, on_cycle_gpu_, cycle_reached_gpu_);
+  double traverse_time = timer.toc(true);
+
+  UnionKernel<<<block_size, kGPUThreadSize>>>(
+      rows_, cols_, cycle_gpu_, on_cycle_gpu_, cycle_reached_gpu_,
+      parent_gpu_);
+  double union_time = timer.toc(true);
+
+  // the head nodes are counted in place of the doubled min nodes
+  int* is_head_gpu = min_node_gpu_[0];
+  FirstNodeKernel<<<block_size, kGPUThreadSize>>>(
+      n, is_object_gpu_, cycle_gpu_, parent_gpu_, first_node_gpu_);
+  HeadKernel<<<block_size, kGPUThreadSize>>>(
+      n, is_object_gpu_, cycle_gpu_, parent_gpu_, first_node_gpu_,
+      is_head_gpu);
+  thrust::inclusive_scan(thrust::device, is_head_gpu, is_head_gpu + n,
+                         label_id_gpu_);
+  LabelKernel<<<block_size, kGPUThreadSize>>>(
+      n, is_object_gpu_, cycle_gpu_, parent_gpu_, first_node_gpu_,
+      label_id_gpu_, labels_gpu_);
+  int num = 0;
+  BASE_CUDA_CHECK(cudaMemcpy(&num, label_id_gpu_ + n - 1, sizeof(int),
+                             cudaMemcpyDeviceToHost));
+  BASE_CUDA_CHECK(cudaMemcpy((*labels)[0], labels_gpu_, sizeof(uint16_t) * n,
+                             cudaMemcpyDeviceToHost));
+  double label_time = timer.toc(true);
+
+  labels->ResetClusters(kDefaultReserveSize);
+  const uint16_t* label_ptr = (*labels)[0];
+  for (int i = 0; i < n; ++i) {
+    if (label_ptr[i]) {
+      labels->AddPixelSample(label_ptr[i] - 1, static_cast<uint32_t>(i));
+    }
+  }
+  labels->ResizeClusters(num);
+  double collect_time = timer.toc(true);
+
+  AINFO << "SppSegCC2D GPU: init: " << init_time
+        << "\ttraverse: " << traverse_time << "\tunion: " << union_time
+        << "\tlabel: " << label_time << "\tcollect: " << collect_time
+        << "\t#obj: " << num;
+
+  return static_cast<size_t>(num);
+}
+
+void SppCCDetector::AllocGPUMemory() {
+  const size_t n = static_cast<size_t>(rows_) * cols_;
+  for (int i = 0; i < 2; ++i) {
+    BASE_CUDA_CHECK(cudaMalloc(reinterpret_cast<void**>(&center_gpu_[i]),
+                               n * sizeof(int)));
+    BASE_CUDA_CHECK(cudaMalloc(reinterpret_cast<void**>(&min_node_gpu_[i]),
+                               n * sizeof(int)));
+  }
+  BASE_CUDA_CHECK(
+      cudaMalloc(reinterpret_cast<void**>(&cycle_gpu_), n * sizeof(int)));
+  BASE_CUDA_CHECK(
+      cudaMalloc(reinterpret_cast<void**>(&parent_gpu_), n * sizeof(int)));
+  BASE_CUDA_CHECK(cudaMalloc(reinterpret_cast<void**>(&first_node_gpu_),
+                             n * sizeof(int)));
+  BASE_CUDA_CHECK(
+      cudaMalloc(reinterpret_cast<void**>(&label_id_gpu_), n * sizeof(int)));
+  BASE_CUDA_CHECK(cudaMalloc(reinterpret_cast<void**>(&is_object_gpu_),
+                             n * sizeof(uint8_t)));
+  BASE_CUDA_CHECK(cudaMalloc(reinterpret_cast<void**>(&on_cycle_gpu_),
+                             n * sizeof(uint8_t)));
+  BASE_CUDA_CHECK(cudaMalloc(reinterpret_cast<void**>(&cycle_reached_gpu_),
+                             n * sizeof(uint8_t)));
+  BASE_CUDA_CHECK(cudaMalloc(reinterpret_cast<void**>(&labels_gpu_),
+                             n * sizeof(uint16_t)));
+}
+
+void SppCCDetector::ReleaseGPUMemory() {
+  void* buffers[] = {center_gpu_[0],    center_gpu_[1],     min_node_gpu_[0],
+                     min_node_gpu_[1],  cycle_gpu_,         parent_gpu_,
+                     first_node_gpu_,   label_id_gpu_,      is_object_gpu_,
+                     on_cycle_gpu_,     cycle_reached_gpu_, labels_gpu_};
+  for (void* buffer : buffers) {
+    if (buffer != nullptr) {
+      BASE_CUDA_CHECK(cudaFree(buffer));
+    }
+  }
+  center_gpu_[0] = center_gpu_[1] = nullptr;
+  min_node_gpu_[0] = min_node_gpu_[1] = nullptr;
+  cycle_gpu_ = parent_gpu_ = first_node_gpu_ = label_id_gpu_ = nullptr;
+  is_object_gpu_ = on_cycle_gpu_ = cycle_reached_gpu_ = nullptr;
+  labels_gpu_ = nullptr;
+}
+
+}  // namespace lidar
+}  // namespace perception
+}  // namespace apollo
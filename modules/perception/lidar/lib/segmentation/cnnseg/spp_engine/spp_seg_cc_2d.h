@@ -17,6 +17,7 @@
 
 #include <vector>
 
+#include "modules/perception/base/common.h"
 #include "modules/perception/common/i_lib/core/i_alloc.h"
 #include "modules/perception/lib/thread/thread_worker.h"
 #include "modules/perception/lidar/lib/segmentation/cnnseg/spp_engine/spp_label_image.h"
@@ -33,6 +34,9 @@ class SppCCDetector {
     if (nodes_ != nullptr) {
       common::IFree2(&nodes_);
     }
+#if USE_GPU == 1
+    ReleaseGPUMemory();
+#endif
   }
   // @brief: initialize detector
   // @param [in]: rows of feature map
@@ -45,6 +49,10 @@ class SppCCDetector {
       nodes_ = common::IAlloc2<Node>(rows, cols);
       rows_ = static_cast<int>(rows);
       cols_ = static_cast<int>(cols);
+#if USE_GPU == 1
+      ReleaseGPUMemory();
+      AllocGPUMemory();
+#endif
     }
     CleanNodes();
   }
@@ -59,6 +67,15 @@ class SppCCDetector {
   // @param [out]: label image
   // @return: label number
   size_t Detect(SppLabelImage* labels);
+#if USE_GPU == 1
+  // @brief: detect clusters on gpu, only the label image comes back
+  // @param [in]: probability map in device memory
+  // @param [in]: center offset map in device memory
+  // @param [out]: label image
+  // @return: label number
+  size_t DetectGPU(const float* prob_map_gpu, const float* offset_map_gpu,
+                   SppLabelImage* labels);
+#endif
 
  private:
   // @brief: build node matrix given start row index and end row index
@@ -74,6 +91,10 @@ class SppCCDetector {
   size_t ToLabelMap(SppLabelImage* labels);
   // @brief: clean node matrix
   bool CleanNodes();
+#if USE_GPU == 1
+  void AllocGPUMemory();
+  void ReleaseGPUMemory();
+#endif
 
  private:
   struct Node {
@@ -144,6 +165,25 @@ class SppCCDetector {
   lib::ThreadWorker worker_;
   bool first_process_ = true;
 
+#if USE_GPU == 1
+  // node matrix on gpu, one entry per node in each array;
+  // center nodes of the chains, doubled in place of the node matrix
+  int* center_gpu_[2] = {nullptr, nullptr};
+  // min node id along the chains
+  int* min_node_gpu_[2] = {nullptr, nullptr};
+  // smallest node of the cycle each chain ends in
+  int* cycle_gpu_ = nullptr;
+  int* parent_gpu_ = nullptr;
+  // first object node of each cluster root, then the label of each node
+  int* first_node_gpu_ = nullptr;
+  int* label_id_gpu_ = nullptr;
+  uint8_t* is_object_gpu_ = nullptr;
+  uint8_t* on_cycle_gpu_ = nullptr;
+  uint8_t* cycle_reached_gpu_ = nullptr;
+  uint16_t* labels_gpu_ = nullptr;
+  const int kGPUThreadSize = 512;
+#endif
+
  private:
   static const size_t kDefaultReserveSize = 500;
 };  // class SppCCDetector
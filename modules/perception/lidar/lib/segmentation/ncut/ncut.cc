@@ -18,13 +18,17 @@
 #include <algorithm>
 #include <ctime>
 #include <functional>
+#include <numeric>
 #include <queue>
+#include <random>
 #include <stack>
 #include <string>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include "Eigen/Eigenvalues"
+
 #include "cyber/common/file.h"
 #include "cyber/common/log.h"
 #include "modules/perception/base/point_cloud_util.h"
@@ -40,7 +44,28 @@ namespace lidar {
 
 namespace {
 const int OBSTACLE_MINIMUM_NUM_POINTS = 50;
+const int kLanczosMaxSteps = 48;
+const int kLanczosMaxRestarts = 8;
+const double kLanczosTolerance = 1e-8;
+
+// Runs func(i) for i in [begin, end) as tasks of the enclosing parallel
+// region, which its idle threads pick up, otherwise in a new one.
+template <typename Func>
+void ParallelFor(int begin, int end, const Func &func) {
+  const Func *task = &func;
+  if (omp_in_parallel()) {
+#pragma omp taskloop
+    for (int i = begin; i < end; ++i) {
+      (*task)(i);
+    }
+  } else {
+#pragma omp parallel for schedule(dynamic)
+    for (int i = begin; i < end; ++i) {
+      (*task)(i);
+    }
+  }
 }
+}  // namespace
 
 using apollo::cyber::common::GetAbsolutePath;
 using apollo::cyber::common::GetProtoFromFile;
@@ -358,104 +383,48 @@ void NCut::NormalizedCut(float ncuts_threshold, bool use_classifier,
             << " clusters +++++++++++++++++++++++++++\n";
 // visualize_segments_from_cluster(_cluster_points);
 #endif
-  MatrixXf weights;
+  SparseMatrixXf weights;
   ComputeSkeletonWeights(&weights);
-  std::vector<int> *curr = new std::vector<int>(num_clusters);
+  // the cuts make a binary tree, the jobs of one level are cut in parallel
+  std::vector<CutJob> jobs(1);
+  jobs[0].clusters.resize(num_clusters);
   for (int i = 0; i < num_clusters; ++i) {
-    (*curr)[i] = i;
+    jobs[0].clusters[i] = i;
+  }
+  int level_begin = 0;
+  while (level_begin < static_cast<int>(jobs.size())) {
+    const int level_end = static_cast<int>(jobs.size());
+    ParallelFor(level_begin, level_end, [&](int i) {
+      CutSegment(weights, ncuts_threshold, use_classifier, &jobs[i]);
+    });
+    for (int i = level_begin; i < level_end; ++i) {
+      if (jobs[i].halves[0].empty()) {
+        continue;
+      }
+      for (int k = 0; k < 2; ++k) {
+        jobs[i].children[k] = static_cast<int>(jobs.size());
+        jobs.emplace_back();
+        jobs.back().clusters = std::move(jobs[i].halves[k]);
+      }
+    }
+    level_begin = level_end;
   }
-  std::stack<std::vector<int> *> job_stack;
-  job_stack.push(curr);
+  // segments in the order of cutting the second half first, depth first
+  std::stack<int> job_stack;
+  job_stack.push(0);
   while (!job_stack.empty()) {
-    curr = job_stack.top();
+    const CutJob &job = jobs[job_stack.top()];
     job_stack.pop();
-#ifdef DEBUG_NCUT
-    AINFO << "curr size " << curr->size();
-// visualize_cluster(curr);
-#endif
-    std::string seg_label;
-    if (curr->size() == 1) {
-      segment_clusters.push_back(*curr);
-      segment_labels.push_back(_cluster_labels[(*curr)[0]]);
-    } else if (use_classifier && IsMovableObstacle(*curr, &seg_label)) {
-      segment_clusters.push_back(*curr);
-      segment_labels.push_back(seg_label);
-#ifdef DEBUG_NCUT
-      std::cout << "cluster: ";
-      for (size_t i = 0; i < curr->size(); ++i) {
-        std::cout << (*curr)[i] << " ";
-      }
-      std::cout << " as a segment (" << seg_label << ")" << std::endl;
-#endif
-    } else {
-      std::vector<int> *seg1 = new std::vector<int>();
-      std::vector<int> *seg2 = new std::vector<int>();
-      MatrixXf my_weights(curr->size(), curr->size());
-      for (size_t i = 0; i < curr->size(); ++i) {
-        const int ci = curr->at(i);
-        for (size_t j = 0; j < curr->size(); ++j) {
-          const int cj = curr->at(j);
-          my_weights.coeffRef(i, j) = weights.coeffRef(ci, cj);
-        }
-      }
-      double cost = GetMinNcuts(my_weights, curr, seg1, seg2);
-#ifdef DEBUG_NCUT
-      AINFO << "N cut cost is " << cost << ", seg1 size " << seg1->size()
-            << ", seg2 size " << seg2->size();
-      if (curr->size() < 50) {
-        std::cout << "seg1: ";
-        for (size_t i = 0; i < seg1->size(); ++i) {
-          std::cout << (*seg1)[i] << " ";
-        }
-        std::cout << std::endl;
-        std::cout << "seg2: ";
-        for (size_t i = 0; i < seg2->size(); ++i) {
-          std::cout << (*seg2)[i] << " ";
-        }
-        std::cout << std::endl;
-      }
-// visualize_graph_cut(seg1, seg2);
-#endif
-      if (cost > ncuts_threshold || 0 == seg1->size() || 0 == seg2->size()) {
-        std::vector<int> buffer;
-        for (size_t i = 0; i < curr->size(); ++i) {
-          const int cid = (*curr)[i];
-          if (_cluster_labels[cid] != "unknown") {
-#ifdef DEBUG_NCUT
-            std::cout << "cluster: " << cid << " as a segment (hit, "
-                      << _cluster_labels[cid] << ")" << std::endl;
-#endif
-            std::vector<int> tmp(1, cid);
-            segment_clusters.push_back(tmp);
-            segment_labels.push_back(_cluster_labels[cid]);
-          } else {
-            buffer.push_back(cid);
-          }
-        }
-        if (buffer.size() > 0) {
-          segment_clusters.push_back(buffer);
-          segment_labels.push_back("unknown");
-        }
-#ifdef DEBUG_NCUT
-        std::cout << "cluster: ";
-        for (size_t i = 0; i < buffer.size(); ++i) {
-          std::cout << buffer[i] << " ";
-        }
-        std::cout << " as a segment (hit, unknown)" << std::endl;
-#endif
-        delete seg1;
-        delete seg2;
-      } else {
-        job_stack.push(seg1);
-        job_stack.push(seg2);
-      }
+    if (job.children[0] >= 0) {
+      job_stack.push(job.children[0]);
+      job_stack.push(job.children[1]);
+      continue;
     }
-#ifdef DEBUG_NCUT
-    LOG_DEBUG << "============================================================="
-                 "================";
-#endif
-    delete curr;
-  }  // end of while
+    segment_clusters.insert(segment_clusters.end(), job.segments.begin(),
+                            job.segments.end());
+    segment_labels.insert(segment_labels.end(), job.labels.begin(),
+                          job.labels.end());
+  }
 #ifdef DEBUG_NCUT
   std::cout << "graph cut return segments: " << std::endl;
   for (size_t i = 0; i < segment_clusters.size(); ++i) {
@@ -471,35 +440,131 @@ void NCut::NormalizedCut(float ncuts_threshold, bool use_classifier,
 #endif
 }
 
-void NCut::ComputeSkeletonWeights(Eigen::MatrixXf *weights_in) {
-  Eigen::MatrixXf &weights = *weights_in;
+void NCut::CutSegment(const SparseMatrixXf &weights, float ncuts_threshold,
+                      bool use_classifier, CutJob *job) {
+  const std::vector<int> &curr = job->clusters;
+#ifdef DEBUG_NCUT
+  AINFO << "curr size " << curr.size();
+#endif
+  std::string seg_label;
+  if (curr.size() == 1) {
+    job->segments.push_back(curr);
+    job->labels.push_back(_cluster_labels[curr[0]]);
+    return;
+  }
+  if (use_classifier && IsMovableObstacle(curr, &seg_label)) {
+    job->segments.push_back(curr);
+    job->labels.push_back(seg_label);
+    return;
+  }
+  // weights among the clusters of the job
+  std::unordered_map<int, int> local_ids;
+  local_ids.reserve(curr.size());
+  for (size_t i = 0; i < curr.size(); ++i) {
+    local_ids[curr[i]] = static_cast<int>(i);
+  }
+  std::vector<Eigen::Triplet<float>> triplets;
+  for (size_t i = 0; i < curr.size(); ++i) {
+    for (SparseMatrixXf::InnerIterator it(weights, curr[i]); it; ++it) {
+      auto found = local_ids.find(static_cast<int>(it.col()));
+      if (found != local_ids.end()) {
+        triplets.emplace_back(static_cast<int>(i), found->second, it.value());
+      }
+    }
+  }
+  SparseMatrixXf my_weights(curr.size(), curr.size());
+  my_weights.setFromTriplets(triplets.begin(), triplets.end());
+  std::vector<int> seg1;
+  std::vector<int> seg2;
+  double cost = GetMinNcuts(my_weights, &curr, &seg1, &seg2);
+#ifdef DEBUG_NCUT
+  AINFO << "N cut cost is " << cost << ", seg1 size " << seg1.size()
+        << ", seg2 size " << seg2.size();
+#endif
+  if (cost > ncuts_threshold || seg1.empty() || seg2.empty()) {
+    std::vector<int> buffer;
+    for (size_t i = 0; i < curr.size(); ++i) {
+      const int cid = curr[i];
+      if (_cluster_labels[cid] != "unknown") {
+        std::vector<int> tmp(1, cid);
+        job->segments.push_back(tmp);
+        job->labels.push_back(_cluster_labels[cid]);
+      } else {
+        buffer.push_back(cid);
+      }
+    }
+    if (buffer.size() > 0) {
+      job->segments.push_back(buffer);
+      job->labels.push_back("unknown");
+    }
+  } else {
+    job->halves[0] = std::move(seg1);
+    job->halves[1] = std::move(seg2);
+  }
+}
+
+void NCut::ComputeSkeletonWeights(SparseMatrixXf *weights_in) {
+  SparseMatrixXf &weights = *weights_in;
   const int num_clusters = static_cast<int>(_cluster_points.size());
   const double hs2 = _sigma_space * _sigma_space;
   const double hf2 = _sigma_feature * _sigma_feature;
   const double radius2 = _connect_radius * _connect_radius;
-  weights.resize(num_clusters, num_clusters);
-  for (int i = 0; i < num_clusters; ++i) {
-    weights.coeffRef(i, i) = 1.f;
-    for (int j = i + 1; j < num_clusters; ++j) {
+  // the skeleton points of a cluster are inside its bounding box, so only the
+  // clusters whose boxes are within the connect radius can be connected,
+  // which are found sweeping along x
+  std::vector<int> order(num_clusters);
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [this](int a, int b) {
+    return std::get<0>(_cluster_bounding_box[a]) <
+           std::get<0>(_cluster_bounding_box[b]);
+  });
+  std::vector<std::vector<std::pair<int, float>>> neighbors(num_clusters);
+  ParallelFor(0, num_clusters, [&](int k) {
+    const int i = order[k];
+    const NcutBoundingBox &box_i = _cluster_bounding_box[i];
+    for (int t = k + 1; t < num_clusters; ++t) {
+      const int j = order[t];
+      const NcutBoundingBox &box_j = _cluster_bounding_box[j];
+      const float gap_x = std::get<0>(box_j) - std::get<1>(box_i);
+      if (gap_x > _connect_radius) {
+        break;
+      }
+      const float gap_y = std::max(std::get<2>(box_j) - std::get<3>(box_i),
+                                   std::get<2>(box_i) - std::get<3>(box_j));
+      const float gap_z = std::max(std::get<4>(box_j) - std::get<5>(box_i),
+                                   std::get<4>(box_i) - std::get<5>(box_j));
+      const float gap2 = std::pow(std::max(gap_x, 0.f), 2.f) +
+                         std::pow(std::max(gap_y, 0.f), 2.f) +
+                         std::pow(std::max(gap_z, 0.f), 2.f);
+      if (gap2 > radius2) {
+        continue;
+      }
       float dist_point = std::numeric_limits<float>::max();
       float dist_feature = std::numeric_limits<float>::max();
       ComputeSquaredSkeletonDistance(
           _cluster_skeleton_points[i], _cluster_skeleton_features[i],
           _cluster_skeleton_points[j], _cluster_skeleton_features[j],
           &dist_point, &dist_feature);
-      if (dist_point > radius2) {
-        weights.coeffRef(i, j) = 0.f;
-        weights.coeffRef(j, i) = 0.f;
-      } else {
-        weights.coeffRef(i, j) = static_cast<float>(exp(-dist_point / hs2) *
-                                                    exp(-dist_feature / hf2));
-        weights.coeffRef(j, i) = weights.coeffRef(i, j);
+      if (dist_point <= radius2) {
+        neighbors[i].emplace_back(j, static_cast<float>(
+                                         exp(-dist_point / hs2) *
+                                         exp(-dist_feature / hf2)));
       }
     }
+  });
+  std::vector<Eigen::Triplet<float>> triplets;
+  for (int i = 0; i < num_clusters; ++i) {
+    triplets.emplace_back(i, i, 1.f);
+    for (const auto &neighbor : neighbors[i]) {
+      triplets.emplace_back(i, neighbor.first, neighbor.second);
+      triplets.emplace_back(neighbor.first, i, neighbor.second);
+    }
   }
+  weights.resize(num_clusters, num_clusters);
+  weights.setFromTriplets(triplets.begin(), triplets.end());
 }
 
-float NCut::GetMinNcuts(const Eigen::MatrixXf &in_weights,
+float NCut::GetMinNcuts(const SparseMatrixXf &in_weights,
                         const std::vector<int> *in_clusters,
                         std::vector<int> *seg1, std::vector<int> *seg2) {
   // .0 initialization
@@ -507,23 +572,22 @@ float NCut::GetMinNcuts(const Eigen::MatrixXf &in_weights,
   seg1->resize(num_clusters);
   seg2->resize(num_clusters);
   // .1 eigen decompostion
-  Eigen::MatrixXf eigenvectors;
-  LaplacianDecomposition(in_weights, &eigenvectors);
-// std::cout << "\nweights: " << in_weights << std::endl;
-// std::cout << "\neigv: " << eigenvectors << std::endl;
-#ifdef DEBUG_NCUT
-// std::cout << "weights:\n " << in_weights << std::endl << std::endl;
-// std::cout << "eigen vectors:\n " << eigenvectors << std::endl << std::endl;
-#endif
+  Eigen::VectorXf eigenvector;
+  LaplacianDecomposition(in_weights, &eigenvector);
+  std::vector<double> degrees(num_clusters);
+  for (int i = 0; i < num_clusters; ++i) {
+    degrees[i] = in_weights.row(i).sum();
+  }
   // .2 search for best split
-  const float minval = eigenvectors.col(1).minCoeff();
-  const float maxval = eigenvectors.col(1).maxCoeff();
+  const float minval = eigenvector.minCoeff();
+  const float maxval = eigenvector.maxCoeff();
   const float increment = static_cast<float>(
       (maxval - minval) / (static_cast<float>(_num_cuts) + 1.0f));
   int num_seg1 = 0;
   int num_seg2 = 0;
   float opt_split = 0.0;
   float opt_cost = std::numeric_limits<float>::max();
+  std::vector<bool> in_seg1(num_clusters);
   for (int i = 0; i < _num_cuts; ++i) {
     num_seg1 = 0;
     num_seg2 = 0;
@@ -531,7 +595,8 @@ float NCut::GetMinNcuts(const Eigen::MatrixXf &in_weights,
     float split =
         static_cast<float>(minval + static_cast<float>(i + 1) * increment);
     for (int j = 0; j < num_clusters; ++j) {
-      if (eigenvectors.coeffRef(j, 1) > split) {
+      in_seg1[j] = eigenvector.coeffRef(j) > split;
+      if (in_seg1[j]) {
         (*seg1)[num_seg1++] = j;
       } else {
         (*seg2)[num_seg2++] = j;
@@ -542,14 +607,17 @@ float NCut::GetMinNcuts(const Eigen::MatrixXf &in_weights,
     double assoc2 = 0.0;
     double cut = 0.0;
     for (int j = 0; j < num_seg1; ++j) {
-      assoc1 += in_weights.row(seg1->at(j)).sum();
+      assoc1 += degrees[seg1->at(j)];
     }
     for (int j = 0; j < num_seg2; ++j) {
-      assoc2 += in_weights.row(seg2->at(j)).sum();
+      assoc2 += degrees[seg2->at(j)];
     }
     for (int j = 0; j < num_seg1; ++j) {
-      for (int t = 0; t < num_seg2; ++t) {
-        cut += in_weights.coeffRef(seg1->at(j), seg2->at(t));
+      for (SparseMatrixXf::InnerIterator it(in_weights, seg1->at(j)); it;
+           ++it) {
+        if (!in_seg1[it.col()]) {
+          cut += it.value();
+        }
       }
     }
     float cost = static_cast<float>(cut / assoc1 + cut / assoc2);
@@ -568,7 +636,7 @@ float NCut::GetMinNcuts(const Eigen::MatrixXf &in_weights,
   num_seg1 = 0;
   num_seg2 = 0;
   for (int i = 0; i < num_clusters; ++i) {
-    if (eigenvectors.coeffRef(i, 1) > opt_split) {
+    if (eigenvector.coeffRef(i) > opt_split) {
       (*seg1)[num_seg1++] = in_clusters->at(i);
     } else {
       (*seg2)[num_seg2++] = in_clusters->at(i);
@@ -579,73 +647,68 @@ float NCut::GetMinNcuts(const Eigen::MatrixXf &in_weights,
   return opt_cost;
 }
 
-void NCut::LaplacianDecomposition(const Eigen::MatrixXf &weights,
-                                  Eigen::MatrixXf *eigenvectors_in) {
-#ifdef DEBUG_NCUT
-// std::cout << "laplacian 0:\n " << weights << std::endl << std::endl;
-#endif
-  Eigen::MatrixXf &eigenvectors = *eigenvectors_in;
-  // .1 degree matrix: D = sum(W, 2)
-  Eigen::VectorXf diag(weights.rows());
-  for (int i = 0; i < weights.rows(); ++i) {
-    diag.coeffRef(i) = weights.row(i).sum();
-  }
-  // .2 graph laplacian L = D - W
-  Eigen::MatrixXf laplacian(weights.rows(), weights.cols());
-  for (int i = 0; i < laplacian.rows(); ++i) {
-    for (int j = 0; j < laplacian.cols(); ++j) {
-      if (i == j) {
-        laplacian.coeffRef(i, j) = diag.coeffRef(i) - weights.coeffRef(i, j);
-      } else {
-        laplacian.coeffRef(i, j) = 0.f - weights.coeffRef(i, j);
+void NCut::LaplacianDecomposition(const SparseMatrixXf &weights,
+                                  Eigen::VectorXf *eigenvector) {
+  const int num_clusters = static_cast<int>(weights.rows());
+  // .1 D^(-1/2) of the degree matrix D = sum(W, 2)
+  Eigen::VectorXd diag_half(num_clusters);
+  for (int i = 0; i < num_clusters; ++i) {
+    diag_half.coeffRef(i) =
+        std::sqrt(static_cast<double>(weights.row(i).sum()));
+  }
+  const Eigen::VectorXd diag_halfinv = diag_half.cwiseInverse();
+  // .2 the second smallest eigenvector of the normalized laplacian
+  // I - D^(-1/2) * W * D^(-1/2) is the largest one of
+  // A = D^(-1/2) * W * D^(-1/2) orthogonal to its largest one D^(1/2) * 1,
+  // found by lanczos iterations with that one deflated
+  const Eigen::SparseMatrix<double, Eigen::RowMajor> affinity =
+      diag_halfinv.asDiagonal() * weights.cast<double>() *
+      diag_halfinv.asDiagonal();
+  const Eigen::VectorXd trivial = diag_half.normalized();
+  const int num_steps = std::min(num_clusters - 1, kLanczosMaxSteps);
+  Eigen::MatrixXd basis(num_clusters, num_steps);
+  Eigen::VectorXd alpha(num_steps);
+  Eigen::VectorXd beta(num_steps);
+  std::mt19937 generator(0);
+  std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+  Eigen::VectorXd ritz(num_clusters);
+  for (int i = 0; i < num_clusters; ++i) {
+    ritz.coeffRef(i) = distribution(generator);
+  }
+  for (int restart = 0; restart < kLanczosMaxRestarts; ++restart) {
+    Eigen::VectorXd q = ritz - trivial * trivial.dot(ritz);
+    q.normalize();
+    int steps = 0;
+    while (steps < num_steps) {
+      basis.col(steps) = q;
+      Eigen::VectorXd w = affinity * q;
+      alpha.coeffRef(steps) = q.dot(w);
+      // full reorthogonalization, twice is enough
+      for (int k = 0; k < 2; ++k) {
+        w -= trivial * trivial.dot(w);
+        w -= basis.leftCols(steps + 1) *
+             (basis.leftCols(steps + 1).transpose() * w);
       }
+      beta.coeffRef(steps) = w.norm();
+      ++steps;
+      if (beta.coeffRef(steps - 1) < kLanczosTolerance) {
+        break;
+      }
+      q = w / beta.coeffRef(steps - 1);
+    }
+    Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> tridiagonal;
+    tridiagonal.computeFromTridiagonal(alpha.head(steps),
+                                       beta.head(steps - 1));
+    const Eigen::VectorXd s = tridiagonal.eigenvectors().col(steps - 1);
+    ritz = basis.leftCols(steps) * s;
+    if (steps == num_clusters - 1 ||
+        std::abs(beta.coeffRef(steps - 1) * s.coeffRef(steps - 1)) <
+            kLanczosTolerance) {
+      break;
     }
   }
-#ifdef DEBUG_NCUT
-// std::cout << "laplacian 1:\n " << laplacian << std::endl << std::endl;
-#endif
-  // .3 D^(-1/2)
-  Eigen::VectorXf diag_halfinv(weights.rows());
-  for (int i = 0; i < weights.rows(); ++i) {
-    diag_halfinv.coeffRef(i) =
-        static_cast<float>(1.0 / std::sqrt(diag.coeffRef(i)));
-  }
-  // .4 normalized laplacian D^(-1/2) * L * D^(-1/2)
-  for (int i = 0; i < laplacian.rows(); ++i) {
-    laplacian.row(i) *= diag_halfinv.coeffRef(i);
-  }
-  for (int j = 0; j < laplacian.cols(); ++j) {
-    laplacian.col(j) *= diag_halfinv.coeffRef(j);
-  }
-  // .4.2 for numerical stability, add eps to the diagonal of laplacian
-  float eps = 1e-10f;
-  for (int i = 0; i < laplacian.rows(); ++i) {
-    laplacian.coeffRef(i, i) += eps;
-  }
-#ifdef DEBUG_NCUT
-// std::cout << "laplacian 2:\n " << laplacian << std::endl << std::endl;
-#endif
-  // .5 solve eigen decompostion: TODO: lanczos
-  Eigen::EigenSolver<MatrixXf> eig_solver(laplacian);
-#ifdef DEBUG_NCUT
-// std::cout << "eigvec 1:\n " << eig_solver.eigenvectors() << std::endl <<
-// std::endl;
-#endif
-  // .6 sort eigen values
-  std::vector<std::pair<float, int>> eigval(laplacian.rows());
-  for (size_t i = 0; i < eigval.size(); ++i) {
-    eigval[i] = std::make_pair(eig_solver.eigenvalues()[i].real(), i);
-  }
-  std::sort(eigval.begin(), eigval.end(), std::less<std::pair<float, int>>());
-  // .7 get sorted eigen vectors
-  eigenvectors.resize(weights.rows(), weights.cols());
-  for (int i = 0; i < eigenvectors.cols(); ++i) {
-    eigenvectors.col(i) =
-        eig_solver.eigenvectors().col(eigval[i].second).real();
-  }
-  for (int i = 0; i < eigenvectors.rows(); ++i) {
-    eigenvectors.row(i) *= diag_halfinv.coeffRef(i);
-  }
+  // .3 back to the eigenvector of the generalized problem (D - W) y = l D y
+  *eigenvector = ritz.cwiseProduct(diag_halfinv).cast<float>();
 }
 
 bool NCut::ComputeSquaredSkeletonDistance(const Eigen::MatrixXf &in1_points,
@@ -26,6 +26,7 @@
 
 #include <opencv2/opencv.hpp>
 #include "Eigen/Core"
+#include "Eigen/Sparse"
 
 #include "modules/perception/lidar/lib/segmentation/ncut/common/flood_fill.h"
 #include "modules/perception/lidar/lib/segmentation/ncut/common/lr_classifier.h"
@@ -75,6 +76,16 @@ class NCut {
 
   // x_min, x_max, y_min, y_max, z_min, z_max;
   typedef std::tuple<float, float, float, float, float, float> NcutBoundingBox;
+  typedef Eigen::SparseMatrix<float, Eigen::RowMajor> SparseMatrixXf;
+  // a set of clusters to cut, either into segments or into two halves
+  // which become the jobs of its children
+  struct CutJob {
+    std::vector<int> clusters;
+    std::vector<std::vector<int>> segments;
+    std::vector<std::string> labels;
+    std::vector<int> halves[2];
+    int children[2] = {-1, -1};
+  };
   base::PointFCloudPtr _cloud_obstacles;
   // super pixels related
   float _grid_radius;
@@ -141,14 +152,19 @@ class NCut {
                      std::vector<std::vector<int>>* segment_clusters,
                      std::vector<std::string>* segment_labels);
 
-  void ComputeSkeletonWeights(Eigen::MatrixXf* weights);
+  void CutSegment(const SparseMatrixXf& weights, float ncuts_threshold,
+                  bool use_classifier, CutJob* job);
+
+  void ComputeSkeletonWeights(SparseMatrixXf* weights);
 
-  float GetMinNcuts(const Eigen::MatrixXf& in_weights,
+  float GetMinNcuts(const SparseMatrixXf& in_weights,
                     const std::vector<int>* in_clusters, std::vector<int>* seg1,
                     std::vector<int>* seg2);
 
-  void LaplacianDecomposition(const Eigen::MatrixXf& weights,
-                              Eigen::MatrixXf* eigenvectors);
+  // the eigenvector of the second smallest eigenvalue of the generalized
+  // problem (D - W) y = l D y
+  void LaplacianDecomposition(const SparseMatrixXf& weights,
+                              Eigen::VectorXf* eigenvector);
 
   bool ComputeSquaredSkeletonDistance(const Eigen::MatrixXf& in1_points,
                                       const Eigen::MatrixXf& in1_features,
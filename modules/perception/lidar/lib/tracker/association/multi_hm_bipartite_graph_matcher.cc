@@ -18,6 +18,7 @@
 
 #include "cyber/common/log.h"
 #include "modules/perception/common/graph/gated_hungarian_bigraph_matcher.h"
+#include "modules/perception/common/perception_gflags.h"
 
 namespace apollo {
 namespace perception {
@@ -25,6 +26,7 @@ namespace lidar {
 
 MultiHmBipartiteGraphMatcher::MultiHmBipartiteGraphMatcher() {
   cost_matrix_ = optimizer_.mutable_global_costs();
+  optimizer_.set_num_threads(FLAGS_hungarian_matcher_num_threads);
 }
 
 MultiHmBipartiteGraphMatcher::~MultiHmBipartiteGraphMatcher() {
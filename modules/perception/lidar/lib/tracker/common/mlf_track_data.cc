@@ -32,7 +32,10 @@ void MlfTrackData::Reset() {
   latest_cached_time_ = 0.0;
   first_tracked_time_ = 0.0;
   is_current_state_predicted_ = true;
-  sensor_history_objects_.clear();
+  // keep the rings of every sensor, pooled track data reuse their slots
+  for (auto& sensor_history_objects : sensor_history_objects_) {
+    sensor_history_objects.second.clear();
+  }
   cached_objects_.clear();
   predict_.Reset();
 //  feature_.reset();
@@ -162,14 +165,13 @@ void MlfTrackData::PredictState(double timestamp) const {
 void MlfTrackData::GetAndCleanCachedObjectsInTimeInterval(
     std::vector<TrackedObjectPtr>* objects) {
   objects->clear();
-  auto iter = cached_objects_.begin();
-  while (iter != cached_objects_.end()) {
-    const auto& timestamp = iter->first;
-    if (timestamp <= latest_visible_time_) {
-      cached_objects_.erase(iter++);
-    } else if (timestamp <= latest_cached_time_) {
-      objects->push_back(iter->second);
-      cached_objects_.erase(iter++);
+  while (!cached_objects_.empty()) {
+    const auto& front = cached_objects_.front();
+    if (front.first <= latest_visible_time_) {
+      cached_objects_.pop_front();
+    } else if (front.first <= latest_cached_time_) {
+      objects->push_back(front.second);
+      cached_objects_.pop_front();
     } else {
       break;
     }
@@ -177,14 +179,9 @@ void MlfTrackData::GetAndCleanCachedObjectsInTimeInterval(
 }
 
 void RemoveStaleDataFromMap(double timestamp,
-                            std::map<double, TrackedObjectPtr>* data) {
-  auto iter = data->begin();
-  while (iter != data->end()) {
-    if (iter->first < timestamp) {
-      data->erase(iter++);
-    } else {
-      break;
-    }
+                            MlfTrackData::TimedObjects* data) {
+  while (!data->empty() && data->front().first < timestamp) {
+    data->pop_front();
   }
 }
 
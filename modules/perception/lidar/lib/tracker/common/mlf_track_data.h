@@ -93,7 +93,7 @@ class MlfTrackData : public TrackData {
   }
 
  public:
-  typedef std::map<double, TrackedObjectPtr> TimedObjects;
+  typedef TimedObjectRing TimedObjects;
   std::map<std::string, TimedObjects> sensor_history_objects_;
   TimedObjects cached_objects_;
 
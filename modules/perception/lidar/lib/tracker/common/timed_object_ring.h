@@ -0,0 +1,225 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "modules/perception/lidar/lib/tracker/common/tracked_object.h"
+
+namespace apollo {
+namespace perception {
+namespace lidar {
+
+// @brief Objects of a track sorted by timestamp, stored in a ring of slots.
+// It keeps the interface of the std::map it replaces, but objects arrive
+// almost always in time order and leave from the oldest end, so insertion
+// is an append, removal pops the front and lookup is a binary search, all
+// without a node allocation per frame. The ring grows when it is full, and
+// keeps its slots when cleared so that pooled track data reuse them.
+class TimedObjectRing {
+ public:
+  typedef std::pair<double, TrackedObjectPtr> value_type;
+
+  template <bool IsConst>
+  class Iterator {
+   public:
+    typedef std::bidirectional_iterator_tag iterator_category;
+    typedef TimedObjectRing::value_type value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef typename std::conditional<IsConst, const value_type*,
+                                      value_type*>::type pointer;
+    typedef typename std::conditional<IsConst, const value_type&,
+                                      value_type&>::type reference;
+    typedef typename std::conditional<IsConst, const TimedObjectRing*,
+                                      TimedObjectRing*>::type RingPointer;
+
+    Iterator() = default;
+    Iterator(RingPointer ring, size_t index) : ring_(ring), index_(index) {}
+    // @brief iterator converts to const_iterator
+    template <bool OtherConst,
+              typename = typename std::enable_if<IsConst && !OtherConst>::type>
+    Iterator(const Iterator<OtherConst>& other)  // NOLINT
+        : ring_(other.ring_), index_(other.index_) {}
+
+    reference operator*() const { return ring_->at(index_); }
+    pointer operator->() const { return &ring_->at(index_); }
+
+    Iterator& operator++() {
+      ++index_;
+      return *this;
+    }
+    Iterator operator++(int) {
+      Iterator old = *this;
+      ++index_;
+      return old;
+    }
+    Iterator& operator--() {
+      --index_;
+      return *this;
+    }
+    Iterator operator--(int) {
+      Iterator old = *this;
+      --index_;
+      return old;
+    }
+
+    bool operator==(const Iterator& rhs) const {
+      return ring_ == rhs.ring_ && index_ == rhs.index_;
+    }
+    bool operator!=(const Iterator& rhs) const { return !(*this == rhs); }
+
+   private:
+    friend class TimedObjectRing;
+    friend class Iterator<!IsConst>;
+
+    RingPointer ring_ = nullptr;
+    // index from the oldest object
+    size_t index_ = 0;
+  };
+
+  typedef Iterator<false> iterator;
+  typedef Iterator<true> const_iterator;
+  typedef std::reverse_iterator<iterator> reverse_iterator;
+  typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+  TimedObjectRing() = default;
+
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  size_t capacity() const { return slots_.size(); }
+
+  iterator begin() { return iterator(this, 0); }
+  iterator end() { return iterator(this, size_); }
+  const_iterator begin() const { return const_iterator(this, 0); }
+  const_iterator end() const { return const_iterator(this, size_); }
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const { return end(); }
+  reverse_iterator rbegin() { return reverse_iterator(end()); }
+  reverse_iterator rend() { return reverse_iterator(begin()); }
+  const_reverse_iterator rbegin() const {
+    return const_reverse_iterator(end());
+  }
+  const_reverse_iterator rend() const {
+    return const_reverse_iterator(begin());
+  }
+  const_reverse_iterator crbegin() const { return rbegin(); }
+  const_reverse_iterator crend() const { return rend(); }
+
+  // @brief object of the given index from the oldest one
+  value_type& at(size_t index) { return slots_[Slot(index)]; }
+  const value_type& at(size_t index) const { return slots_[Slot(index)]; }
+  value_type& front() { return at(0); }
+  const value_type& front() const { return at(0); }
+  value_type& back() { return at(size_ - 1); }
+  const value_type& back() const { return at(size_ - 1); }
+
+  iterator find(double timestamp) {
+    const size_t index = LowerBound(timestamp);
+    return index < size_ && at(index).first == timestamp
+               ? iterator(this, index)
+               : end();
+  }
+  const_iterator find(double timestamp) const {
+    const size_t index = LowerBound(timestamp);
+    return index < size_ && at(index).first == timestamp
+               ? const_iterator(this, index)
+               : end();
+  }
+
+  // @brief insert keeping timestamps sorted, like std::map an existing
+  //        timestamp is not overwritten and the bool is false
+  std::pair<iterator, bool> insert(const value_type& value) {
+    size_t index = size_;
+    if (size_ > 0 && !(back().first < value.first)) {
+      index = LowerBound(value.first);
+      if (at(index).first == value.first) {
+        return std::make_pair(iterator(this, index), false);
+      }
+    }
+    if (size_ == slots_.size()) {
+      Grow();
+    }
+    ++size_;
+    // shift the newer objects, empty when appending in time order
+    for (size_t i = size_ - 1; i > index; --i) {
+      at(i) = std::move(at(i - 1));
+    }
+    at(index) = value;
+    return std::make_pair(iterator(this, index), true);
+  }
+
+  // @brief remove the oldest object
+  void pop_front() {
+    front().second.reset();
+    head_ = Slot(1);
+    --size_;
+  }
+
+  // @brief remove objects, slots are kept for reuse
+  void clear() {
+    for (size_t i = 0; i < size_; ++i) {
+      at(i).second.reset();
+    }
+    head_ = 0;
+    size_ = 0;
+  }
+
+ private:
+  static constexpr size_t kInitialCapacity = 16;
+
+  size_t Slot(size_t index) const {
+    const size_t slot = head_ + index;
+    return slot < slots_.size() ? slot : slot - slots_.size();
+  }
+
+  // @brief index of the first object not older than timestamp
+  size_t LowerBound(double timestamp) const {
+    size_t first = 0;
+    size_t count = size_;
+    while (count > 0) {
+      const size_t step = count / 2;
+      if (at(first + step).first < timestamp) {
+        first += step + 1;
+        count -= step + 1;
+      } else {
+        count = step;
+      }
+    }
+    return first;
+  }
+
+  void Grow() {
+    std::vector<value_type> slots(
+        slots_.empty() ? kInitialCapacity : slots_.size() * 2);
+    for (size_t i = 0; i < size_; ++i) {
+      slots[i] = std::move(at(i));
+    }
+    slots_.swap(slots);
+    head_ = 0;
+  }
+
+  std::vector<value_type> slots_;
+  size_t head_ = 0;
+  size_t size_ = 0;
+};
+
+}  // namespace lidar
+}  // namespace perception
+}  // namespace apollo
@@ -37,15 +37,13 @@ std::pair<double, TrackedObjectPtr> TrackData::GetHistoryObject(int idx) {
                     : abs(idx);
   // from oldest
   if (idx > 0) {
-    std::map<double, TrackedObjectPtr>::iterator cur_obj =
-        history_objects_.begin();
+    auto cur_obj = history_objects_.begin();
     for (int i = 0; i < max_idx; ++i) {
       ++cur_obj;
     }
     return *cur_obj;
   } else {
-    std::map<double, TrackedObjectPtr>::reverse_iterator cur_obj =
-        history_objects_.rbegin();
+    auto cur_obj = history_objects_.rbegin();
     for (int i = 0; i < max_idx; ++i) {
       ++cur_obj;
     }
@@ -64,15 +62,13 @@ std::pair<double, TrackedObjectConstPtr> TrackData::GetHistoryObject(
                     : abs(idx);
   // from oldest
   if (idx > 0) {
-    std::map<double, TrackedObjectPtr>::const_iterator cur_obj =
-        history_objects_.cbegin();
+    auto cur_obj = history_objects_.cbegin();
     for (int i = 0; i < max_idx; ++i) {
       ++cur_obj;
     }
     return *cur_obj;
   } else {
-    std::map<double, TrackedObjectPtr>::const_reverse_iterator cur_obj =
-        history_objects_.crbegin();
+    auto cur_obj = history_objects_.crbegin();
     for (int i = 0; i < max_idx; ++i) {
       ++cur_obj;
     }
@@ -115,7 +111,7 @@ void TrackData::PushTrackedObjectToTrack(TrackedObjectPtr obj, double time) {
       ++total_visible_count_;
     }
     if (history_objects_.size() > kMaxHistorySize) {
-      history_objects_.erase(history_objects_.begin());
+      history_objects_.pop_front();
     }
   } else {
     AWARN << "push object time " << time
@@ -16,10 +16,10 @@
 #pragma once
 
 #include <deque>
-#include <map>
 #include <memory>
 #include <utility>
 
+#include "modules/perception/lidar/lib/tracker/common/timed_object_ring.h"
 #include "modules/perception/lidar/lib/tracker/common/tracked_object.h"
 
 namespace apollo {
@@ -81,7 +81,7 @@ class TrackData {
   int consecutive_invisible_count_ = 0;
   int total_visible_count_ = 0;
   static const int kMaxHistorySize;
-  std::map<double, TrackedObjectPtr> history_objects_;
+  TimedObjectRing history_objects_;
   int max_history_size_ = 40;
   // motion state related
   // used for judge object is static or not
@@ -16,12 +16,14 @@
 
 #include "modules/perception/lidar/lib/tracker/multi_lidar_fusion/mlf_engine.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "Eigen/Geometry"
 
 #include "cyber/common/file.h"
 #include "modules/localization/proto/localization.pb.h"
+#include "modules/perception/common/perception_gflags.h"
 #include "modules/perception/lib/config_manager/config_manager.h"
 #include "modules/perception/lidar/lib/tracker/common/track_pool_types.h"
 #include "modules/perception/lidar/lib/tracker/multi_lidar_fusion/proto/multi_lidar_fusion_config.pb.h"
@@ -73,6 +75,14 @@ bool MlfEngine::Init(const MultiTargetTrackerInitOptions& options) {
   tracker_.reset(new MlfTracker);
   MlfTrackerInitOptions tracker_init_options;
   ACHECK(tracker_->Init(tracker_init_options));
+
+  num_threads_ =
+      static_cast<size_t>(std::max(FLAGS_mlf_engine_num_threads, 1));
+  track_cached_objects_.resize(num_threads_);
+  if (num_threads_ > 1 && thread_pool_ == nullptr) {
+    thread_pool_.reset(new lib::ThreadPool(static_cast<int>(num_threads_) - 1));
+    thread_pool_->Start();
+  }
   evaluator_.Init();
   return true;
 }
@@ -176,16 +186,42 @@ void MlfEngine::TrackObjectMatchAndAssign(
 
 void MlfEngine::TrackStateFilter(const std::vector<MlfTrackDataPtr>& tracks,
                                  double frame_timestamp) {
-  std::vector<TrackedObjectPtr> objects;
-  for (auto& track_data : tracks) {
+  filter_tracks_ = &tracks;
+  filter_timestamp_ = frame_timestamp;
+  next_track_ = 0;
+  const size_t num_tasks = std::min(num_threads_, tracks.size());
+  if (thread_pool_ == nullptr || num_tasks <= 1) {
+    FilterTracks(0, nullptr);
+  } else {
+    lib::BlockingCounter counter(num_tasks - 1);
+    for (size_t i = 1; i < num_tasks; ++i) {
+      thread_pool_->Add(google::protobuf::NewCallback(
+          this, &MlfEngine::FilterTracks, i, &counter));
+    }
+    FilterTracks(0, nullptr);
+    counter.Wait();
+  }
+  filter_tracks_ = nullptr;
+}
+
+void MlfEngine::FilterTracks(size_t thread_id, lib::BlockingCounter* counter) {
+  std::vector<TrackedObjectPtr>& objects = track_cached_objects_[thread_id];
+  const std::vector<MlfTrackDataPtr>& tracks = *filter_tracks_;
+  for (size_t i = next_track_++; i < tracks.size(); i = next_track_++) {
+    const MlfTrackDataPtr& track_data = tracks[i];
     track_data->GetAndCleanCachedObjectsInTimeInterval(&objects);
     for (auto& obj : objects) {
       tracker_->UpdateTrackDataWithObject(track_data, obj);
     }
     if (objects.empty()) {
-      tracker_->UpdateTrackDataWithoutObject(frame_timestamp, track_data);
+      tracker_->UpdateTrackDataWithoutObject(filter_timestamp_, track_data);
     }
   }
+  // do not hold the objects until the next frame
+  objects.clear();
+  if (counter != nullptr) {
+    counter->Decrement();
+  }
 }
 
 void convertPoseToLoc(const Eigen::Affine3d& pose,
@@ -15,11 +15,13 @@
  *****************************************************************************/
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <set>
 #include <string>
 #include <vector>
 
+#include "modules/perception/lib/thread/thread_pool.h"
 #include "modules/perception/lidar/lib/interface/base_multi_target_tracker.h"
 #include "modules/perception/lidar/lib/tracker/multi_lidar_fusion/mlf_track_object_matcher.h"
 #include "modules/perception/lidar/lib/tracker/multi_lidar_fusion/mlf_tracker.h"
@@ -76,6 +78,12 @@ class MlfEngine : public BaseMultiTargetTracker {
   void TrackStateFilter(const std::vector<MlfTrackDataPtr>& tracks,
                         double frame_timestamp);
 
+  // @brief: filter tracks taken one by one from the shared index, every
+  //         thread runs one, tracks do not share state with each other
+  // @params [in]: index of the thread
+  // @params [in/out]: counter decremented when done, may be nullptr
+  void FilterTracks(size_t thread_id, lib::BlockingCounter* counter);
+
   // @brief: collect track results and store in frame tracked objects
   // @params [in/out]: lidar frame
   void CollectTrackedResult(LidarFrame* frame);
@@ -104,6 +112,16 @@ class MlfEngine : public BaseMultiTargetTracker {
   std::unique_ptr<MlfTracker> tracker_;
   // track object matcher
   std::unique_ptr<MlfTrackObjectMatcher> matcher_;
+  // thread pool filtering tracks in parallel
+  size_t num_threads_ = 1;
+  std::unique_ptr<lib::ThreadPool> thread_pool_;
+  // tracks being filtered and index of the next one
+  const std::vector<MlfTrackDataPtr>* filter_tracks_ = nullptr;
+  double filter_timestamp_ = 0.0;
+  std::atomic<size_t> next_track_{0};
+  // cached objects of a track, one buffer per thread
+  std::vector<std::vector<TrackedObjectPtr>> track_cached_objects_ =
+      std::vector<std::vector<TrackedObjectPtr>>(1);
   // offset maintained for numeric issues
   Eigen::Vector3d global_to_local_offset_;
   Eigen::Affine3d sensor_to_local_pose_;
@@ -48,12 +48,14 @@ bool MlfShapeFilter::Init(const MlfFilterInitOptions& options) {
 void MlfShapeFilter::UpdateWithObject(const MlfFilterOptions& options,
                                       const MlfTrackDataConstPtr& track_data,
                                       TrackedObjectPtr new_object) {
+  // tracks may be filtered in parallel, every thread owns its hull buffers
+  thread_local ConvexHull hull;
   // compute tight object polygon
   auto& obj = new_object->object_ptr;
   if (new_object->is_background) {
-    hull_.GetConvexHull(obj->lidar_supplement.cloud_world, &obj->polygon);
+    hull.GetConvexHull(obj->lidar_supplement.cloud_world, &obj->polygon);
   } else {
-    hull_.GetConvexHullWithoutGroundAndHead(
+    hull.GetConvexHullWithoutGroundAndHead(
         obj->lidar_supplement.cloud_world,
         static_cast<float>(bottom_points_ignore_threshold_),
         static_cast<float>(top_points_ignore_threshold_), &obj->polygon);
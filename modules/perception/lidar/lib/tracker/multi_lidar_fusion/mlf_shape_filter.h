@@ -50,7 +50,9 @@ class MlfShapeFilter : public MlfBaseFilter {
   std::string Name() const override { return "MlfShapeFilter"; }
 
  protected:
-  common::ConvexHull2D<base::PointDCloud, base::PolygonDType> hull_;
+  typedef common::ConvexHull2D<base::PointDCloud, base::PolygonDType>
+      ConvexHull;
+
   double bottom_points_ignore_threshold_ = 0.1;
   double top_points_ignore_threshold_ = 1.6;
 };  // class MlfShapeFilter
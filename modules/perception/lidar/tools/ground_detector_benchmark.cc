@@ -0,0 +1,154 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+// Times the plane fit ground detector on recorded frames, e.g. a folder of
+// 64 beam and a folder of 128 beam pcd files, with several thread numbers:
+//   ground_detector_benchmark --pcd_path=/data/hdl128/ --thread_nums=1,4,8
+// The heights of every thread number are compared to the first one, which
+// must match exactly.
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "absl/strings/str_split.h"
+#include "gflags/gflags.h"
+
+#include "modules/perception/base/point_cloud.h"
+#include "modules/perception/common/i_lib/pc/i_ground.h"
+#include "modules/perception/common/io/io_util.h"
+#include "modules/perception/lidar/common/lidar_log.h"
+#include "modules/perception/lidar/common/pcl_util.h"
+
+DEFINE_string(pcd_path, "./pcd/", "pcd path");
+DEFINE_string(thread_nums, "1,2,4,8", "comma separated thread numbers");
+DEFINE_int32(grid_size, 16, "coarse grid size of the ground detector");
+DEFINE_double(roi_rad_x, 120.0, "roi radius in x");
+DEFINE_double(roi_rad_y, 120.0, "roi radius in y");
+DEFINE_double(roi_rad_z, 100.0, "roi radius in z");
+DEFINE_int32(repeat, 3, "times every frame is detected");
+
+namespace apollo {
+namespace perception {
+namespace lidar {
+
+class GroundDetectorBenchmark {
+ public:
+  bool LoadFrames() {
+    std::vector<std::string> pcd_file_names;
+    if (!common::GetFileList(FLAGS_pcd_path, ".pcd", &pcd_file_names)) {
+      AERROR << "pcd_path: " << FLAGS_pcd_path << " get file list error.";
+      return false;
+    }
+    std::sort(pcd_file_names.begin(), pcd_file_names.end());
+    for (const auto& pcd_file_name : pcd_file_names) {
+      base::PointFCloud cloud;
+      if (!LoadPCLPCD(pcd_file_name, &cloud)) {
+        return false;
+      }
+      std::vector<float> frame(cloud.size() * 3);
+      for (size_t i = 0; i < cloud.size(); ++i) {
+        frame[i * 3] = cloud[i].x;
+        frame[i * 3 + 1] = cloud[i].y;
+        frame[i * 3 + 2] = cloud[i].z;
+      }
+      max_frame_size_ = std::max(max_frame_size_, cloud.size());
+      frames_.push_back(std::move(frame));
+    }
+    AINFO << "Loaded " << frames_.size() << " frames, at most "
+          << max_frame_size_ << " points.";
+    return !frames_.empty();
+  }
+
+  void Run(const unsigned int nr_threads) {
+    common::PlaneFitGroundDetectorParam param;
+    param.nr_points_max = std::max(param.nr_points_max,
+                                   static_cast<unsigned int>(max_frame_size_));
+    param.roi_region_rad_x = static_cast<float>(FLAGS_roi_rad_x);
+    param.roi_region_rad_y = static_cast<float>(FLAGS_roi_rad_y);
+    param.roi_region_rad_z = static_cast<float>(FLAGS_roi_rad_z);
+    param.nr_grids_coarse = FLAGS_grid_size;
+    param.nr_threads = nr_threads;
+    common::PlaneFitGroundDetector detector(param);
+    detector.Init();
+
+    std::vector<double> latencies_ms;
+    std::vector<std::vector<float>> heights(frames_.size());
+    for (size_t i = 0; i < frames_.size(); ++i) {
+      const unsigned int nr_points =
+          static_cast<unsigned int>(frames_[i].size() / 3);
+      heights[i].resize(nr_points);
+      for (int k = 0; k < FLAGS_repeat; ++k) {
+        const auto start = std::chrono::steady_clock::now();
+        detector.Detect(frames_[i].data(), heights[i].data(), nr_points, 3);
+        const auto end = std::chrono::steady_clock::now();
+        latencies_ms.push_back(
+            std::chrono::duration<double, std::milli>(end - start).count());
+      }
+    }
+
+    size_t nr_mismatches = 0;
+    if (expected_heights_.empty()) {
+      expected_heights_ = heights;
+    } else {
+      for (size_t i = 0; i < heights.size(); ++i) {
+        nr_mismatches += heights[i] != expected_heights_[i];
+      }
+    }
+
+    std::sort(latencies_ms.begin(), latencies_ms.end());
+    double sum_ms = 0.0;
+    for (const double latency_ms : latencies_ms) {
+      sum_ms += latency_ms;
+    }
+    AINFO << "threads: " << nr_threads
+          << " mean: " << sum_ms / static_cast<double>(latencies_ms.size())
+          << " ms p50: " << Percentile(latencies_ms, 0.5)
+          << " ms p99: " << Percentile(latencies_ms, 0.99)
+          << " ms mismatched frames: " << nr_mismatches;
+  }
+
+ private:
+  static double Percentile(const std::vector<double>& sorted, double ratio) {
+    const size_t index = std::min(
+        sorted.size() - 1,
+        static_cast<size_t>(ratio * static_cast<double>(sorted.size())));
+    return sorted[index];
+  }
+
+  std::vector<std::vector<float>> frames_;
+  size_t max_frame_size_ = 0;
+  std::vector<std::vector<float>> expected_heights_;
+};
+
+}  // namespace lidar
+}  // namespace perception
+}  // namespace apollo
+
+int main(int argc, char** argv) {
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  apollo::perception::lidar::GroundDetectorBenchmark benchmark;
+  if (!benchmark.LoadFrames()) {
+    return -1;
+  }
+  for (const auto& thread_num :
+       absl::StrSplit(FLAGS_thread_nums, ',', absl::SkipEmpty())) {
+    const int nr_threads = std::max(std::stoi(std::string(thread_num)), 1);
+    benchmark.Run(static_cast<unsigned int>(nr_threads));
+  }
+  return 0;
+}
@@ -17,13 +17,16 @@
 #include "modules/perception/map/hdmap/hdmap_input.h"
 
 #include <algorithm>
+#include <cmath>
 #include <limits>
+#include <unordered_map>
 
 #include "cyber/common/file.h"
 #include "cyber/common/log.h"
 #include "modules/map/hdmap/hdmap_util.h"
 #include "modules/perception/base/object_pool_types.h"
 #include "modules/perception/common/geometry/common.h"
+#include "modules/perception/common/perception_gflags.h"
 #include "modules/perception/lib/config_manager/config_manager.h"
 
 namespace apollo {
@@ -70,6 +73,7 @@ bool HDMapInput::Reset() {
 
 bool HDMapInput::InitHDMap() {
   hdmap_.reset(new apollo::hdmap::HDMap());
+  local_map_ = LocalMap();
   const std::string model_name = "HDMapInput";
   const lib::ModelConfig* model_config = nullptr;
   if (!lib::ConfigManager::Instance()->GetModelConfig(model_name,
@@ -111,6 +115,11 @@ bool HDMapInput::GetRoiHDMapStruct(
     AERROR << "hdmap is not available";
     return false;
   }
+  if (FLAGS_enable_hdmap_local_cache) {
+    return hdmap_struct_ptr != nullptr &&
+           GetRoiHDMapStructFromLocalMap(pointd, distance,
+                                         hdmap_struct_ptr.get());
+  }
   // Get original road boundary and junction
   std::vector<RoadRoiPtr> road_boundary_vec;
   std::vector<JunctionInfoConstPtr> junctions_vec;
@@ -143,6 +152,152 @@ bool HDMapInput::GetRoiHDMapStruct(
   return true;
 }
 
+bool HDMapInput::GetRoiHDMapStructFromLocalMap(
+    const base::PointD& pointd, const double distance,
+    base::HdmapStruct* hdmap_struct_ptr) {
+  if (!UpdateLocalMap(pointd, distance)) {
+    return false;
+  }
+  hdmap_struct_ptr->hole_polygons.clear();
+  hdmap_struct_ptr->junction_polygons.clear();
+  hdmap_struct_ptr->road_boundary.clear();
+  hdmap_struct_ptr->road_polygons.clear();
+
+  // The hdmap returns the road sections with a lane within distance, the
+  // bounding boxes keep a superset of them.
+  for (size_t i = 0; i < local_map_.road_ids.size(); ++i) {
+    if (local_map_.road_boxes[i].IsFartherThan(pointd, distance)) {
+      continue;
+    }
+    hdmap_struct_ptr->road_polygons.push_back(local_map_.road_polygons[i]);
+    const auto& filtered = local_map_.filtered_road_boundaries[i];
+    hdmap_struct_ptr->road_boundary.insert(
+        hdmap_struct_ptr->road_boundary.end(), filtered.begin(),
+        filtered.end());
+  }
+  for (size_t i = 0; i < local_map_.junction_ids.size(); ++i) {
+    if (local_map_.junction_boxes[i].IsFartherThan(pointd, distance)) {
+      continue;
+    }
+    hdmap_struct_ptr->junction_polygons.push_back(
+        local_map_.junction_polygons[i]);
+  }
+  return true;
+}
+
+bool HDMapInput::UpdateLocalMap(const base::PointD& pointd,
+                                const double distance) {
+  const double moved = std::hypot(pointd.x - local_map_.center_x,
+                                  pointd.y - local_map_.center_y);
+  if (local_map_.valid && moved + distance <= local_map_.radius) {
+    return true;
+  }
+
+  const double radius =
+      distance + std::max(FLAGS_hdmap_local_cache_margin, 0.0);
+  std::vector<RoadRoiPtr> road_boundary_vec;
+  std::vector<JunctionInfoConstPtr> junctions_vec;
+  apollo::common::PointENU point;
+  point.set_x(pointd.x);
+  point.set_y(pointd.y);
+  point.set_z(pointd.z);
+  if (hdmap_->GetRoadBoundaries(point, radius, &road_boundary_vec,
+                                &junctions_vec) != 0) {
+    AERROR << "Failed to get road boundary, point: " << point.DebugString();
+    local_map_.valid = false;
+    return false;
+  }
+
+  LocalMap local_map;
+  local_map.valid = true;
+  local_map.center_x = pointd.x;
+  local_map.center_y = pointd.y;
+  local_map.radius = radius;
+
+  // Keep the junctions already converted and convert the new ones.
+  std::unordered_map<std::string, size_t> old_junctions;
+  for (size_t i = 0; i < local_map_.junction_ids.size(); ++i) {
+    old_junctions.emplace(local_map_.junction_ids[i], i);
+  }
+  std::vector<JunctionInfoConstPtr> new_junctions;
+  for (const auto& junction : junctions_vec) {
+    const std::string& id = junction->id().id();
+    auto iter = old_junctions.find(id);
+    if (iter == old_junctions.end()) {
+      new_junctions.push_back(junction);
+      continue;
+    }
+    local_map.junction_ids.push_back(id);
+    local_map.junction_polygons.push_back(
+        local_map_.junction_polygons[iter->second]);
+    local_map.junction_boxes.push_back(
+        local_map_.junction_boxes[iter->second]);
+    // a duplicate id is converted again
+    old_junctions.erase(iter);
+  }
+  // the split road boundaries stay valid while the junctions are the same
+  const bool junctions_changed =
+      !new_junctions.empty() ||
+      local_map.junction_ids.size() != local_map_.junction_ids.size();
+
+  // Keep the road sections already converted and convert the new ones.
+  std::unordered_map<std::string, size_t> old_roads;
+  for (size_t i = 0; i < local_map_.road_ids.size(); ++i) {
+    old_roads.emplace(local_map_.road_ids[i], i);
+  }
+  std::vector<RoadRoiPtr> new_roads;
+  std::vector<size_t> reused_roads;
+  for (const auto& road : road_boundary_vec) {
+    const std::string& id = road->id.id();
+    auto iter = old_roads.find(id);
+    if (iter == old_roads.end()) {
+      new_roads.push_back(road);
+      continue;
+    }
+    local_map.road_ids.push_back(id);
+    local_map.road_boundaries.push_back(
+        local_map_.road_boundaries[iter->second]);
+    local_map.road_polygons.push_back(local_map_.road_polygons[iter->second]);
+    local_map.road_boxes.push_back(local_map_.road_boxes[iter->second]);
+    reused_roads.push_back(iter->second);
+    old_roads.erase(iter);
+  }
+
+  EigenVector<RoadBoundary> new_road_boundaries;
+  EigenVector<base::PointCloud<PointD>> new_road_polygons;
+  EigenVector<base::PointCloud<PointD>> new_junction_polygons;
+  MergeBoundaryJunction(new_roads, new_junctions, &new_road_boundaries,
+                        &new_road_polygons, &new_junction_polygons);
+  for (size_t i = 0; i < new_roads.size(); ++i) {
+    local_map.road_ids.push_back(new_roads[i]->id.id());
+    local_map.road_boundaries.push_back(new_road_boundaries[i]);
+    local_map.road_polygons.push_back(new_road_polygons[i]);
+    local_map.road_boxes.emplace_back(new_road_polygons[i]);
+  }
+  for (size_t i = 0; i < new_junctions.size(); ++i) {
+    local_map.junction_ids.push_back(new_junctions[i]->id().id());
+    local_map.junction_polygons.push_back(new_junction_polygons[i]);
+    local_map.junction_boxes.emplace_back(new_junction_polygons[i]);
+  }
+
+  local_map.filtered_road_boundaries.resize(local_map.road_ids.size());
+  for (size_t i = 0; i < local_map.road_ids.size(); ++i) {
+    auto* filtered = &local_map.filtered_road_boundaries[i];
+    if (!junctions_changed && i < reused_roads.size()) {
+      *filtered = local_map_.filtered_road_boundaries[reused_roads[i]];
+      continue;
+    }
+    GetRoadBoundaryFilteredByJunctions(
+        EigenVector<RoadBoundary>(1, local_map.road_boundaries[i]),
+        local_map.junction_polygons, filtered);
+  }
+  ADEBUG << "Local map updated with " << new_roads.size() << " of "
+         << local_map.road_ids.size() << " roads and " << new_junctions.size()
+         << " of " << local_map.junction_ids.size() << " junctions converted";
+  local_map_ = std::move(local_map);
+  return true;
+}
+
 void HDMapInput::MergeBoundaryJunction(
     const std::vector<apollo::hdmap::RoadRoiPtr>& boundary,
     const std::vector<apollo::hdmap::JunctionInfoConstPtr>& junctions,
@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <algorithm>
+#include <limits>
 #include <memory>
 #include <string>
 #include <vector>
@@ -77,11 +79,65 @@ class HDMapInput {
                            double forward_distance,
                            std::vector<apollo::hdmap::Signal>* signals);
 
+  // Serves GetRoiHDMapStruct from local_map_ when
+  // FLAGS_enable_hdmap_local_cache is on.
+  bool GetRoiHDMapStructFromLocalMap(const base::PointD& pointd,
+                                     const double distance,
+                                     base::HdmapStruct* hdmap_struct_ptr);
+
+  // Queries the hdmap again once the vehicle gets within distance of the
+  // edge of the local map, converting only the new roads and junctions.
+  bool UpdateLocalMap(const base::PointD& pointd, const double distance);
+
+  struct BoundingBox {
+    double min_x = std::numeric_limits<double>::max();
+    double min_y = std::numeric_limits<double>::max();
+    double max_x = std::numeric_limits<double>::lowest();
+    double max_y = std::numeric_limits<double>::lowest();
+
+    explicit BoundingBox(const base::PointCloud<base::PointD>& points) {
+      for (size_t i = 0; i < points.size(); ++i) {
+        min_x = std::min(min_x, points[i].x);
+        min_y = std::min(min_y, points[i].y);
+        max_x = std::max(max_x, points[i].x);
+        max_y = std::max(max_y, points[i].y);
+      }
+    }
+    // true for an empty box
+    bool IsFartherThan(const base::PointD& point, const double dist) const {
+      const double dx = std::max({min_x - point.x, point.x - max_x, 0.0});
+      const double dy = std::max({min_y - point.y, point.y - max_y, 0.0});
+      return dx * dx + dy * dy > dist * dist;
+    }
+  };
+
+  // The converted road sections and junctions within radius of the center.
+  struct LocalMap {
+    bool valid = false;
+    double center_x = 0.0;
+    double center_y = 0.0;
+    double radius = 0.0;
+
+    std::vector<std::string> road_ids;
+    apollo::common::EigenVector<base::RoadBoundary> road_boundaries;
+    apollo::common::EigenVector<base::PointCloud<base::PointD>> road_polygons;
+    // road_boundaries[i] split by all junctions of the local map
+    std::vector<apollo::common::EigenVector<base::RoadBoundary>>
+        filtered_road_boundaries;
+    std::vector<BoundingBox> road_boxes;
+
+    std::vector<std::string> junction_ids;
+    apollo::common::EigenVector<base::PointCloud<base::PointD>>
+        junction_polygons;
+    std::vector<BoundingBox> junction_boxes;
+  };
+
   bool inited_ = false;
   lib::Mutex mutex_;
   std::unique_ptr<apollo::hdmap::HDMap> hdmap_;
   int hdmap_sample_step_ = 5;
   std::string hdmap_file_;
+  LocalMap local_map_;
 
   DECLARE_SINGLETON(HDMapInput)
 };
@@ -29,6 +29,12 @@ DEFINE_bool(obs_benchmark_mode, false,
 DEFINE_bool(obs_save_fusion_supplement, false,
             "whether save fusion supplement data, default false");
 DEFINE_bool(start_visualizer, false, "Whether to start visualizer");
+DEFINE_bool(obs_enable_batch_camera_detection, false,
+            "whether to detect synchronized camera images in one batch");
+DEFINE_double(obs_camera_batch_sync_time_diff, 0.02,
+              "max timestamp difference in seconds of images in one batch");
+DEFINE_bool(obs_camera_compressed_input, false,
+            "whether camera channels are jpeg images decoded on the gpu");
 
 }  // namespace onboard
 }  // namespace perception
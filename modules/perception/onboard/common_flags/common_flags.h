@@ -27,6 +27,9 @@ DECLARE_string(obs_screen_output_dir);
 DECLARE_bool(obs_benchmark_mode);
 DECLARE_bool(obs_save_fusion_supplement);
 DECLARE_bool(start_visualizer);
+DECLARE_bool(obs_enable_batch_camera_detection);
+DECLARE_double(obs_camera_batch_sync_time_diff);
+DECLARE_bool(obs_camera_compressed_input);
 
 }  // namespace onboard
 }  // namespace perception
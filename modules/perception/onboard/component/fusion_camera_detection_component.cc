@@ -15,6 +15,8 @@
  *****************************************************************************/
 #include "modules/perception/onboard/component/fusion_camera_detection_component.h"
 
+#include <algorithm>
+
 #include <boost/algorithm/string.hpp>
 #include <boost/format.hpp>
 
@@ -263,6 +265,44 @@ void FusionCameraDetectionComponent::OnReceiveImage(
     const std::shared_ptr<apollo::drivers::Image> &message,
     const std::string &camera_name) {
   std::lock_guard<std::mutex> lock(mutex_);
+  HandleImage(message, camera_name);
+}
+
+void FusionCameraDetectionComponent::OnReceiveCompressedImage(
+    const std::shared_ptr<apollo::drivers::CompressedImage> &message,
+    const std::string &camera_name) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  base::Image8U &decoded_image = decoded_images_map_[camera_name];
+  if (!jpeg_decoders_map_[camera_name]->Decode(
+          reinterpret_cast<const uint8_t *>(message->data().data()),
+          message->data().size(), &decoded_image)) {
+    AERROR << "Failed to decode image of " << camera_name;
+    return;
+  }
+  if (decoded_image.rows() != image_height_ ||
+      decoded_image.cols() != image_width_) {
+    AERROR << "Wrong image size of " << camera_name << ": "
+           << decoded_image.cols() << "x" << decoded_image.rows();
+    return;
+  }
+  // the pixels stay on the device, the message only carries the meta data
+  auto image = std::make_shared<apollo::drivers::Image>();
+  image->mutable_header()->CopyFrom(message->header());
+  if (message->has_measurement_time()) {
+    image->set_measurement_time(message->measurement_time());
+  } else {
+    image->set_measurement_time(message->header().timestamp_sec());
+  }
+  image->set_width(decoded_image.cols());
+  image->set_height(decoded_image.rows());
+  image->set_encoding("rgb8");
+  image->set_step(decoded_image.width_step());
+  HandleImage(image, camera_name);
+}
+
+void FusionCameraDetectionComponent::HandleImage(
+    const std::shared_ptr<apollo::drivers::Image> &message,
+    const std::string &camera_name) {
   const double msg_timestamp = message->measurement_time() + timestamp_offset_;
   AINFO << "Enter FusionCameraDetectionComponent::Proc(), "
         << " camera_name: " << camera_name << " image ts: " << msg_timestamp;
@@ -274,57 +314,144 @@ void FusionCameraDetectionComponent::OnReceiveImage(
     return;
   }
   last_timestamp_ = msg_timestamp;
-  ++seq_num_;
-
-  // for e2e lantency statistics
-  {
-    const double cur_time = apollo::common::time::Clock::NowInSeconds();
-    const double start_latency = (cur_time - message->measurement_time()) * 1e3;
-    AINFO << "FRAME_STATISTICS:Camera:Start:msg_time[" << camera_name << "-"
-          << FORMAT_TIMESTAMP(message->measurement_time()) << "]:cur_time["
-          << FORMAT_TIMESTAMP(cur_time) << "]:cur_latency[" << start_latency
-          << "]";
-  }
-
-  // protobuf msg
-  std::shared_ptr<apollo::perception::PerceptionObstacles> out_message(
-      new (std::nothrow) apollo::perception::PerceptionObstacles);
-  apollo::common::ErrorCode error_code = apollo::common::OK;
-
-  // prefused msg
-  std::shared_ptr<SensorFrameMessage> prefused_message(new (std::nothrow)
-                                                           SensorFrameMessage);
-
-  if (InternalProc(message, camera_name, &error_code, prefused_message.get(),
-                   out_message.get()) != cyber::SUCC) {
-    AERROR << "InternalProc failed, error_code: " << error_code;
-    if (MakeProtobufMsg(msg_timestamp, seq_num_, {}, {}, error_code,
-                        out_message.get()) != cyber::SUCC) {
-      AERROR << "MakeProtobufMsg failed";
-      return;
-    }
-    if (output_final_obstacles_) {
-      writer_->Write(out_message);
+
+  if (!FLAGS_obs_enable_batch_camera_detection) {
+    ProcessImages({message}, {camera_name});
+    return;
+  }
+
+  // wait for the images of all cameras, keeping the latest one of each
+  batch_images_[camera_name] = message;
+  if (batch_images_.size() < camera_names_.size()) {
+    return;
+  }
+  double min_timestamp = msg_timestamp;
+  double max_timestamp = msg_timestamp;
+  for (const auto &image : batch_images_) {
+    const double timestamp =
+        image.second->measurement_time() + timestamp_offset_;
+    min_timestamp = std::min(min_timestamp, timestamp);
+    max_timestamp = std::max(max_timestamp, timestamp);
+  }
+  if (max_timestamp - min_timestamp > FLAGS_obs_camera_batch_sync_time_diff) {
+    // drop the images which can not be synchronized with the newest one
+    for (auto iter = batch_images_.begin(); iter != batch_images_.end();) {
+      if (max_timestamp - iter->second->measurement_time() - timestamp_offset_ >
+          FLAGS_obs_camera_batch_sync_time_diff) {
+        AINFO << "Drop unsynchronized image of " << iter->first;
+        iter = batch_images_.erase(iter);
+      } else {
+        ++iter;
+      }
     }
     return;
   }
+  std::vector<std::shared_ptr<apollo::drivers::Image>> messages;
+  for (const auto &name : camera_names_) {
+    messages.push_back(batch_images_[name]);
+  }
+  batch_images_.clear();
+  ProcessImages(messages, camera_names_);
+}
+
+void FusionCameraDetectionComponent::ProcessImages(
+    const std::vector<std::shared_ptr<apollo::drivers::Image>> &messages,
+    const std::vector<std::string> &camera_names) {
+  const size_t num_images = messages.size();
+  std::vector<std::shared_ptr<apollo::perception::PerceptionObstacles>>
+      out_messages(num_images);
+  std::vector<std::shared_ptr<SensorFrameMessage>> prefused_messages(
+      num_images);
+  std::vector<apollo::common::ErrorCode> error_codes(num_images,
+                                                     apollo::common::OK);
+  std::vector<camera::CameraFrame *> camera_frames(num_images, nullptr);
+  std::vector<camera::CameraFrame *> prepared_frames;
+
+  for (size_t i = 0; i < num_images; ++i) {
+    ++seq_num_;
+    // for e2e lantency statistics
+    {
+      const double cur_time = apollo::common::time::Clock::NowInSeconds();
+      const double start_latency =
+          (cur_time - messages[i]->measurement_time()) * 1e3;
+      AINFO << "FRAME_STATISTICS:Camera:Start:msg_time[" << camera_names[i]
+            << "-" << FORMAT_TIMESTAMP(messages[i]->measurement_time())
+            << "]:cur_time[" << FORMAT_TIMESTAMP(cur_time) << "]:cur_latency["
+            << start_latency << "]";
+    }
+
+    // protobuf msg
+    out_messages[i].reset(new (std::nothrow)
+                              apollo::perception::PerceptionObstacles);
+    // prefused msg
+    prefused_messages[i].reset(new (std::nothrow) SensorFrameMessage);
+
+    camera_frames[i] =
+        PrepareFrame(messages[i], camera_names[i], &error_codes[i],
+                     prefused_messages[i].get());
+    if (camera_frames[i] != nullptr) {
+      prepared_frames.push_back(camera_frames[i]);
+    }
+  }
 
-  bool send_sensorframe_ret = sensorframe_writer_->Write(prefused_message);
-  AINFO << "send out prefused msg, ts: " << msg_timestamp
-        << "ret: " << send_sensorframe_ret;
-  // Send output msg
-  if (output_final_obstacles_) {
-    writer_->Write(out_message);
+  // Run camera perception pipeline
+  bool perception_ret = true;
+  if (prepared_frames.size() == 1) {
+    perception_ret = camera_obstacle_pipeline_->Perception(
+        camera_perception_options_, prepared_frames[0]);
+  } else if (prepared_frames.size() > 1) {
+    perception_ret = camera_obstacle_pipeline_->BatchPerception(
+        camera_perception_options_, prepared_frames);
   }
-  // for e2e lantency statistics
-  {
-    const double end_timestamp = apollo::common::time::Clock::NowInSeconds();
-    const double end_latency =
-        (end_timestamp - message->measurement_time()) * 1e3;
-    AINFO << "FRAME_STATISTICS:Camera:End:msg_time[" << camera_name << "-"
-          << FORMAT_TIMESTAMP(message->measurement_time()) << "]:cur_time["
-          << FORMAT_TIMESTAMP(end_timestamp) << "]:cur_latency[" << end_latency
-          << "]";
+
+  for (size_t i = 0; i < num_images; ++i) {
+    const double msg_timestamp =
+        messages[i]->measurement_time() + timestamp_offset_;
+    int ret = cyber::FAIL;
+    if (camera_frames[i] != nullptr) {
+      if (!perception_ret) {
+        AERROR << "camera_obstacle_pipeline_->Perception() failed"
+               << " msg_timestamp: " << msg_timestamp;
+        error_codes[i] = apollo::common::ErrorCode::PERCEPTION_ERROR_PROCESS;
+        prefused_messages[i]->error_code_ = error_codes[i];
+      } else {
+        ret = FinishFrame(camera_names[i], camera_frames[i], &error_codes[i],
+                          prefused_messages[i].get(), out_messages[i].get());
+      }
+    }
+
+    if (ret != cyber::SUCC) {
+      AERROR << "Failed to process image, error_code: " << error_codes[i];
+      if (MakeProtobufMsg(msg_timestamp, prefused_messages[i]->seq_num_, {},
+                          {}, error_codes[i],
+                          out_messages[i].get()) != cyber::SUCC) {
+        AERROR << "MakeProtobufMsg failed";
+        continue;
+      }
+      if (output_final_obstacles_) {
+        writer_->Write(out_messages[i]);
+      }
+      continue;
+    }
+
+    bool send_sensorframe_ret =
+        sensorframe_writer_->Write(prefused_messages[i]);
+    AINFO << "send out prefused msg, ts: " << msg_timestamp
+          << "ret: " << send_sensorframe_ret;
+    // Send output msg
+    if (output_final_obstacles_) {
+      writer_->Write(out_messages[i]);
+    }
+    // for e2e lantency statistics
+    {
+      const double end_timestamp = apollo::common::time::Clock::NowInSeconds();
+      const double end_latency =
+          (end_timestamp - messages[i]->measurement_time()) * 1e3;
+      AINFO << "FRAME_STATISTICS:Camera:End:msg_time[" << camera_names[i]
+            << "-" << FORMAT_TIMESTAMP(messages[i]->measurement_time())
+            << "]:cur_time[" << FORMAT_TIMESTAMP(end_timestamp)
+            << "]:cur_latency[" << end_latency << "]";
+    }
   }
 }
 
@@ -363,6 +490,8 @@ int FusionCameraDetectionComponent::InitConfig() {
   camera_perception_init_options_.lane_calibration_working_sensor_name =
       fusion_camera_detection_param.lane_calibration_working_sensor_name();
   camera_perception_init_options_.use_cyber_work_root = true;
+  camera_perception_init_options_.batch_detection =
+      FLAGS_obs_enable_batch_camera_detection;
   frame_capacity_ = fusion_camera_detection_param.frame_capacity();
   image_channel_num_ = fusion_camera_detection_param.image_channel_num();
   enable_undistortion_ = fusion_camera_detection_param.enable_undistortion();
@@ -526,6 +655,16 @@ int FusionCameraDetectionComponent::InitCameraFrames() {
         new camera::DataProvider);
     data_provider->Init(data_provider_init_options);
     data_providers_map_[camera_name] = data_provider;
+
+    if (FLAGS_obs_camera_compressed_input) {
+      std::shared_ptr<camera::JpegDecoder> jpeg_decoder(
+          new camera::JpegDecoder);
+      if (!jpeg_decoder->Init(gpu_id)) {
+        AERROR << "Failed to init jpeg decoder of " << camera_name;
+        return cyber::FAIL;
+      }
+      jpeg_decoders_map_[camera_name] = jpeg_decoder;
+    }
   }
 
   //  init extrinsic/intrinsic
@@ -585,6 +724,15 @@ int FusionCameraDetectionComponent::InitCameraListeners() {
     const std::string &listener_name = camera_name + "_fusion_camera_listener";
     AINFO << "listener name: " << listener_name;
 
+    if (FLAGS_obs_camera_compressed_input) {
+      typedef std::shared_ptr<apollo::drivers::CompressedImage>
+          CompressedImageMsgType;
+      std::function<void(const CompressedImageMsgType &)> camera_callback =
+          std::bind(&FusionCameraDetectionComponent::OnReceiveCompressedImage,
+                    this, std::placeholders::_1, camera_name);
+      node_->CreateReader(channel_name, camera_callback);
+      continue;
+    }
     typedef std::shared_ptr<apollo::drivers::Image> ImageMsgType;
     std::function<void(const ImageMsgType &)> camera_callback =
         std::bind(&FusionCameraDetectionComponent::OnReceiveImage, this,
@@ -656,11 +804,10 @@ void FusionCameraDetectionComponent::SetCameraHeightAndPitch() {
       default_camera_pitch_);
 }
 
-int FusionCameraDetectionComponent::InternalProc(
+camera::CameraFrame *FusionCameraDetectionComponent::PrepareFrame(
     const std::shared_ptr<apollo::drivers::Image const> &in_message,
     const std::string &camera_name, apollo::common::ErrorCode *error_code,
-    SensorFrameMessage *prefused_message,
-    apollo::perception::PerceptionObstacles *out_message) {
+    SensorFrameMessage *prefused_message) {
   const double msg_timestamp =
       in_message->measurement_time() + timestamp_offset_;
   const int frame_size = static_cast<int>(camera_frames_.size());
@@ -684,9 +831,8 @@ int FusionCameraDetectionComponent::InternalProc(
     AERROR << err_str;
     *error_code = apollo::common::ErrorCode::PERCEPTION_ERROR_TF;
     prefused_message->error_code_ = *error_code;
-    return cyber::FAIL;
+    return nullptr;
   }
-  Eigen::Affine3d world2camera = camera2world_trans.inverse();
 
   prefused_message->frame_->sensor2world_pose = camera2world_trans;
 
@@ -694,10 +840,14 @@ int FusionCameraDetectionComponent::InternalProc(
   // frame_size != 0, see InitCameraFrames()
   camera_frame.camera2world_pose = camera2world_trans;
   camera_frame.data_provider = data_providers_map_[camera_name].get();
-  camera_frame.data_provider->FillImageData(
-      image_height_, image_width_,
-      reinterpret_cast<const uint8_t *>(in_message->data().data()),
-      in_message->encoding());
+  const uint8_t *image_data =
+      reinterpret_cast<const uint8_t *>(in_message->data().data());
+  if (FLAGS_obs_camera_compressed_input) {
+    // decoded on the device, filled with a device to device copy
+    image_data = decoded_images_map_[camera_name].gpu_data();
+  }
+  camera_frame.data_provider->FillImageData(image_height_, image_width_,
+                                            image_data, in_message->encoding());
 
   camera_frame.frame_id = frame_id_;
   camera_frame.timestamp = msg_timestamp;
@@ -709,18 +859,21 @@ int FusionCameraDetectionComponent::InternalProc(
   }
 
   ++frame_id_;
-  // Run camera perception pipeline
   camera_obstacle_pipeline_->GetCalibrationService(
       &camera_frame.calibration_service);
+  return &camera_frame;
+}
+
+int FusionCameraDetectionComponent::FinishFrame(
+    const std::string &camera_name, camera::CameraFrame *frame,
+    apollo::common::ErrorCode *error_code,
+    SensorFrameMessage *prefused_message,
+    apollo::perception::PerceptionObstacles *out_message) {
+  camera::CameraFrame &camera_frame = *frame;
+  const double msg_timestamp = camera_frame.timestamp;
+  const Eigen::Affine3d &camera2world_trans = camera_frame.camera2world_pose;
+  Eigen::Affine3d world2camera = camera2world_trans.inverse();
 
-  if (!camera_obstacle_pipeline_->Perception(camera_perception_options_,
-                                             &camera_frame)) {
-    AERROR << "camera_obstacle_pipeline_->Perception() failed"
-           << " msg_timestamp: " << msg_timestamp;
-    *error_code = apollo::common::ErrorCode::PERCEPTION_ERROR_PROCESS;
-    prefused_message->error_code_ = *error_code;
-    return cyber::FAIL;
-  }
   AINFO << "##" << camera_name << ": pitch "
         << camera_frame.calibration_service->QueryPitchAngle()
         << " | camera_grond_height "
@@ -737,9 +890,9 @@ int FusionCameraDetectionComponent::InternalProc(
 
   // process success, make pb msg
   if (output_final_obstacles_ &&
-      MakeProtobufMsg(msg_timestamp, seq_num_, camera_frame.tracked_objects,
-                      camera_frame.lane_objects, *error_code,
-                      out_message) != cyber::SUCC) {
+      MakeProtobufMsg(msg_timestamp, prefused_message->seq_num_,
+                      camera_frame.tracked_objects, camera_frame.lane_objects,
+                      *error_code, out_message) != cyber::SUCC) {
     AERROR << "MakeProtobufMsg failed ts: " << msg_timestamp;
     *error_code = apollo::common::ErrorCode::PERCEPTION_ERROR_UNKNOWN;
     prefused_message->error_code_ = *error_code;
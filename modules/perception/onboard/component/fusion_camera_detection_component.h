@@ -28,6 +28,7 @@
 #include "modules/perception/camera/app/cipv_camera.h"
 #include "modules/perception/camera/app/obstacle_camera_perception.h"
 #include "modules/perception/camera/app/proto/perception.pb.h"
+#include "modules/perception/camera/common/jpeg_decoder.h"
 #include "modules/perception/camera/common/util.h"
 #include "modules/perception/camera/lib/interface/base_camera_perception.h"
 #include "modules/perception/camera/tools/offline/visualizer.h"
@@ -64,6 +65,11 @@ class FusionCameraDetectionComponent : public apollo::cyber::Component<> {
  private:
   void OnReceiveImage(const std::shared_ptr<apollo::drivers::Image>& in_message,
                       const std::string& camera_name);
+  void OnReceiveCompressedImage(
+      const std::shared_ptr<apollo::drivers::CompressedImage>& in_message,
+      const std::string& camera_name);
+  void HandleImage(const std::shared_ptr<apollo::drivers::Image>& in_message,
+                   const std::string& camera_name);
   int InitConfig();
   int InitSensorInfo();
   int InitAlgorithmPlugin();
@@ -74,11 +80,23 @@ class FusionCameraDetectionComponent : public apollo::cyber::Component<> {
   void SetCameraHeightAndPitch();
   void OnMotionService(const MotionServiceMsgType& message);
 
-  int InternalProc(
+  // @brief run the pipeline on the images, in one detection batch when
+  //        there are several, and send out the results of each camera
+  void ProcessImages(
+      const std::vector<std::shared_ptr<apollo::drivers::Image>>& messages,
+      const std::vector<std::string>& camera_names);
+
+  // @brief fill the next camera frame, nullptr on failure
+  camera::CameraFrame* PrepareFrame(
       const std::shared_ptr<apollo::drivers::Image const>& in_message,
       const std::string& camera_name, apollo::common::ErrorCode* error_code,
-      SensorFrameMessage* prefused_message,
-      apollo::perception::PerceptionObstacles* out_message);
+      SensorFrameMessage* prefused_message);
+
+  // @brief make the messages of a frame after the perception pipeline
+  int FinishFrame(const std::string& camera_name, camera::CameraFrame* frame,
+                  apollo::common::ErrorCode* error_code,
+                  SensorFrameMessage* prefused_message,
+                  apollo::perception::PerceptionObstacles* out_message);
 
   int MakeProtobufMsg(double msg_timestamp, int seq_num,
                       const std::vector<base::ObjectPtr>& objects,
@@ -130,6 +148,11 @@ class FusionCameraDetectionComponent : public apollo::cyber::Component<> {
   std::map<std::string, std::shared_ptr<camera::DataProvider>>
       data_providers_map_;
 
+  // jpeg decoders and their device images, for compressed input
+  std::map<std::string, std::shared_ptr<camera::JpegDecoder>>
+      jpeg_decoders_map_;
+  std::map<std::string, base::Image8U> decoded_images_map_;
+
   // map for store params
   std::map<std::string, Eigen::Matrix4d> extrinsic_map_;
   std::map<std::string, Eigen::Matrix3f> intrinsic_map_;
@@ -145,6 +168,10 @@ class FusionCameraDetectionComponent : public apollo::cyber::Component<> {
   int frame_id_ = 0;
   std::vector<camera::CameraFrame> camera_frames_;
 
+  // latest image of each camera waiting for a detection batch
+  std::map<std::string, std::shared_ptr<apollo::drivers::Image>>
+      batch_images_;
+
   // image info.
   int image_width_ = 1920;
   int image_height_ = 1080;
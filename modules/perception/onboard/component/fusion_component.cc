@@ -16,6 +16,8 @@
 #include "modules/perception/onboard/component/fusion_component.h"
 
 #include "cyber/time/clock.h"
+#include "modules/common/adapters/adapter_gflags.h"
+#include "modules/common/latency_recorder/latency_recorder.h"
 #include "modules/common/util/perf_util.h"
 #include "modules/perception/base/object_pool_types.h"
 #include "modules/perception/onboard/common_flags/common_flags.h"
@@ -54,6 +56,7 @@ bool FusionComponent::Proc(const std::shared_ptr<SensorFrameMessage>& message) {
   if (message->process_stage_ == ProcessStage::SENSOR_FUSION) {
     return true;
   }
+  const auto start_time = ::apollo::cyber::Clock::Now();
   std::shared_ptr<PerceptionObstacles> out_message(new (std::nothrow)
                                                        PerceptionObstacles);
   std::shared_ptr<SensorFrameMessage> viz_message(new (std::nothrow)
@@ -65,6 +68,13 @@ bool FusionComponent::Proc(const std::shared_ptr<SensorFrameMessage>& message) {
       AINFO << "Fusion receive from " << message->sensor_id_ << "not from "
             << fusion_main_sensor_ << ". Skip send.";
     } else {
+      // measure latency
+      static apollo::common::LatencyRecorder latency_recorder(
+          FLAGS_perception_obstacle_topic);
+      latency_recorder.AppendLatencyRecord(message->lidar_timestamp_,
+                                           start_time,
+                                           ::apollo::cyber::Clock::Now());
+
       // Send("/apollo/perception/obstacles", out_message);
       writer_->Write(out_message);
       AINFO << "Send fusion processing output message.";
@@ -17,6 +17,7 @@
 
 #include "cyber/time/clock.h"
 #include "modules/common/util/perf_util.h"
+#include "modules/perception/base/object_pool_types.h"
 #include "modules/perception/common/sensor_manager/sensor_manager.h"
 
 using Clock = apollo::cyber::Clock;
@@ -102,7 +103,7 @@ bool RadarDetectionComponent::InternalProc(
     const std::shared_ptr<ContiRadar>& in_message,
     std::shared_ptr<SensorFrameMessage> out_message) {
   PERF_FUNCTION_WITH_INDICATOR(radar_info_.name);
-  ContiRadar raw_obstacles = *in_message;
+  const ContiRadar& raw_obstacles = *in_message;
   {
     std::unique_lock<std::mutex> lock(_mutex);
     ++seq_num_;
@@ -116,7 +117,9 @@ bool RadarDetectionComponent::InternalProc(
   PERF_BLOCK_START();
   // Init preprocessor_options
   radar::PreprocessorOptions preprocessor_options;
-  ContiRadar corrected_obstacles;
+  // cleared messages keep their obstacles for the next frame
+  ContiRadar& corrected_obstacles = corrected_obstacles_;
+  corrected_obstacles.Clear();
   radar_preprocessor_->Preprocess(raw_obstacles, preprocessor_options,
                                   &corrected_obstacles);
   PERF_BLOCK_END_WITH_INDICATOR(radar_info_.name, "radar_preprocessor");
@@ -170,19 +173,18 @@ bool RadarDetectionComponent::InternalProc(
   // Init object_filter_options
   // Init track_options
   // Init object_builder_options
-  std::vector<base::ObjectPtr> radar_objects;
+  base::FramePtr frame = base::FramePool::Instance().Get();
   if (!radar_perception_->Perceive(corrected_obstacles, options,
-                                   &radar_objects)) {
+                                   &frame->objects)) {
     out_message->error_code_ =
         apollo::common::ErrorCode::PERCEPTION_ERROR_PROCESS;
     AERROR << "RadarDetector Proc failed.";
     return true;
   }
-  out_message->frame_.reset(new base::Frame());
+  out_message->frame_ = frame;
   out_message->frame_->sensor_info = radar_info_;
   out_message->frame_->timestamp = timestamp;
   out_message->frame_->sensor2world_pose = radar_trans;
-  out_message->frame_->objects = radar_objects;
 
   const double end_timestamp = Clock::NowInSeconds();
   const double end_latency =
@@ -84,6 +84,7 @@ class RadarDetectionComponent : public cyber::Component<ContiRadar> {
   std::shared_ptr<radar::BasePreprocessor> radar_preprocessor_;
   std::shared_ptr<radar::BaseRadarObstaclePerception> radar_perception_;
   MsgBuffer<LocalizationEstimate> localization_subscriber_;
+  ContiRadar corrected_obstacles_;
   std::shared_ptr<apollo::cyber::Writer<SensorFrameMessage>> writer_;
 };
 
@@ -16,6 +16,7 @@
 #include "modules/perception/radar/app/radar_obstacle_perception.h"
 
 #include "modules/common/util/perf_util.h"
+#include "modules/perception/base/object_pool_types.h"
 #include "modules/perception/lib/config_manager/config_manager.h"
 #include "modules/perception/lib/registerer/registerer.h"
 
@@ -62,6 +63,9 @@ bool RadarObstaclePerception::Init(const std::string& pipeline_name) {
   ACHECK(roi_filter_->Init()) << "radar roi filter init error";
   ACHECK(tracker_->Init()) << "radar tracker init error";
 
+  detect_frame_ = base::FramePool::Instance().Get();
+  tracker_frame_ = base::FramePool::Instance().Get();
+
   return true;
 }
 
@@ -72,7 +76,10 @@ bool RadarObstaclePerception::Perceive(
   PERF_FUNCTION();
   const std::string& sensor_name = options.sensor_name;
   PERF_BLOCK_START();
-  base::FramePtr detect_frame_ptr(new base::Frame());
+  // release the objects of the last frame, so that they can be reused
+  detect_frame_->Reset();
+  tracker_frame_->Reset();
+  const base::FramePtr& detect_frame_ptr = detect_frame_;
 
   if (!detector_->Detect(corrected_obstacles, options.detector_options,
                          detect_frame_ptr)) {
@@ -89,7 +96,7 @@ bool RadarObstaclePerception::Perceive(
          << detect_frame_ptr->objects.size();
   PERF_BLOCK_END_WITH_INDICATOR(sensor_name, "roi_filter");
 
-  base::FramePtr tracker_frame_ptr(new base::Frame);
+  const base::FramePtr& tracker_frame_ptr = tracker_frame_;
   if (!tracker_->Track(*detect_frame_ptr, options.track_options,
                        tracker_frame_ptr)) {
     AERROR << "radar track error";
@@ -41,6 +41,9 @@ class RadarObstaclePerception : public BaseRadarObstaclePerception {
   std::shared_ptr<BaseDetector> detector_;
   std::shared_ptr<BaseRoiFilter> roi_filter_;
   std::shared_ptr<BaseTracker> tracker_;
+  // reused by every frame
+  base::FramePtr detect_frame_;
+  base::FramePtr tracker_frame_;
 };
 
 }  // namespace radar
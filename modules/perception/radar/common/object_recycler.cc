@@ -0,0 +1,44 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#include "modules/perception/radar/common/object_recycler.h"
+
+#include <atomic>
+
+#include "modules/perception/base/object_pool_types.h"
+
+namespace apollo {
+namespace perception {
+namespace radar {
+
+base::ObjectPtr ObjectRecycler::Get() {
+  for (size_t i = 0; i < objects_.size(); ++i) {
+    const base::ObjectPtr& object = objects_[next_];
+    next_ = (next_ + 1) % objects_.size();
+    if (object.use_count() == 1) {
+      // order the writes of the last holder before ours
+      std::atomic_thread_fence(std::memory_order_acquire);
+      object->Reset();
+      return object;
+    }
+  }
+  objects_.push_back(base::ObjectPool::Instance().Get());
+  next_ = 0;
+  return objects_.back();
+}
+
+}  // namespace radar
+}  // namespace perception
+}  // namespace apollo
@@ -0,0 +1,45 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#pragma once
+
+#include <vector>
+
+#include "modules/perception/base/object.h"
+
+namespace apollo {
+namespace perception {
+namespace radar {
+
+// @brief Objects handed out frame after frame. An object is handed out again,
+// reset, once every other holder released it, so in steady state no object
+// is allocated. New objects come from base::ObjectPool.
+class ObjectRecycler {
+ public:
+  ObjectRecycler() = default;
+
+  base::ObjectPtr Get();
+
+  size_t size() const { return objects_.size(); }
+
+ private:
+  std::vector<base::ObjectPtr> objects_;
+  // where the search for a released object starts
+  size_t next_ = 0;
+};
+
+}  // namespace radar
+}  // namespace perception
+}  // namespace apollo
@@ -0,0 +1,46 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#include "modules/perception/radar/common/object_recycler.h"
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace perception {
+namespace radar {
+
+TEST(ObjectRecyclerTest, test) {
+  ObjectRecycler recycler;
+  base::ObjectPtr object1 = recycler.Get();
+  object1->track_id = 1;
+  base::ObjectPtr object2 = recycler.Get();
+  EXPECT_NE(object1, object2);
+  EXPECT_EQ(recycler.size(), 2);
+
+  base::Object* released = object1.get();
+  object1.reset();
+  base::ObjectPtr object3 = recycler.Get();
+  EXPECT_EQ(object3.get(), released);
+  EXPECT_EQ(object3->track_id, -1);
+  EXPECT_EQ(recycler.size(), 2);
+
+  // every object is still held
+  base::ObjectPtr object4 = recycler.Get();
+  EXPECT_EQ(recycler.size(), 3);
+}
+
+}  // namespace radar
+}  // namespace perception
+}  // namespace apollo
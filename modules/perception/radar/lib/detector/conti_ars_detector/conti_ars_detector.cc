@@ -52,8 +52,8 @@ void ContiArsDetector::RawObs2Frame(
   ADEBUG << "radar2novatel: " << radar2novatel;
   ADEBUG << "angular_speed: " << angular_speed;
   ADEBUG << "rotation_radar: " << rotation_radar;
-  for (const auto radar_obs : corrected_obstacles.contiobs()) {
-    base::ObjectPtr radar_object(new base::Object);
+  for (const auto& radar_obs : corrected_obstacles.contiobs()) {
+    base::ObjectPtr radar_object = detected_objects_.Get();
     radar_object->id = radar_obs.obstacle_id();
     radar_object->track_id = radar_obs.obstacle_id();
     Eigen::Vector4d local_loc(radar_obs.longitude_dist(),
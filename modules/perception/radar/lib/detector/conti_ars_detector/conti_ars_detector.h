@@ -19,6 +19,7 @@
 
 #include "cyber/common/macros.h"
 
+#include "modules/perception/radar/common/object_recycler.h"
 #include "modules/perception/radar/common/radar_util.h"
 #include "modules/perception/radar/lib/interface/base_detector.h"
 
@@ -43,6 +44,9 @@ class ContiArsDetector : public BaseDetector {
   void RawObs2Frame(const drivers::ContiRadar& corrected_obstacles,
                     const DetectorOptions& options, base::FramePtr radar_frame);
 
+  // objects of the detected frames
+  ObjectRecycler detected_objects_;
+
   DISALLOW_COPY_AND_ASSIGN(ContiArsDetector);
 };
 
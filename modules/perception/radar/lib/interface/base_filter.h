@@ -29,8 +29,9 @@ class BaseFilter {
   BaseFilter() : name_("BaseFilter") {}
   virtual ~BaseFilter() {}
   virtual void Init(const base::Object& object) = 0;
-  virtual Eigen::VectorXd Predict(double time_diff) = 0;
-  virtual Eigen::VectorXd UpdateWithObject(const base::Object& new_object,
+  // @brief the states are x, y, vx and vy
+  virtual Eigen::Vector4d Predict(double time_diff) = 0;
+  virtual Eigen::Vector4d UpdateWithObject(const base::Object& new_object,
                                            double time_diff) = 0;
   virtual void GetState(Eigen::Vector3d* anchor_point,
                         Eigen::Vector3d* velocity) = 0;
@@ -51,8 +51,10 @@ void BaseMatcher::IDMatch(const std::vector<RadarTrackPtr> &radar_tracks,
     std::iota(unassigned_objects->begin(), unassigned_objects->end(), 0);
     return;
   }
-  std::vector<bool> track_used(num_track, false);
-  std::vector<bool> object_used(num_obj, false);
+  std::vector<bool> &track_used = track_used_;
+  std::vector<bool> &object_used = object_used_;
+  track_used.assign(num_track, false);
+  object_used.assign(num_obj, false);
   for (size_t i = 0; i < num_track; ++i) {
     const auto &track_object = radar_tracks[i]->GetObsRadar();
     double track_timestamp = radar_tracks[i]->GetTimestamp();
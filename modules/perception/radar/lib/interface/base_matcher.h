@@ -76,6 +76,9 @@ class BaseMatcher {
                             double track_timestamp,
                             const base::ObjectPtr &radar_object,
                             double radar_timestamp);
+  // kept between frames to avoid reallocation
+  std::vector<bool> track_used_;
+  std::vector<bool> object_used_;
   FRIEND_TEST(BaseMatcherTest, base_matcher_test);
 
  private:
@@ -23,9 +23,12 @@ namespace radar {
 
 bool HdmapRadarRoiFilter::RoiFilter(const RoiFilterOptions& options,
                                     base::FramePtr radar_frame) {
-  std::vector<base::ObjectPtr> origin_objects = radar_frame->objects;
-  return common::ObjectInRoiCheck(options.roi, origin_objects,
-                                  &radar_frame->objects);
+  origin_objects_.swap(radar_frame->objects);
+  const bool state = common::ObjectInRoiCheck(options.roi, origin_objects_,
+                                              &radar_frame->objects);
+  // do not hold the filtered out objects until the next frame
+  origin_objects_.clear();
+  return state;
 }
 
 std::string HdmapRadarRoiFilter::Name() const { return "HdmapRadarRoiFilter"; }
@@ -50,8 +50,8 @@ void RadarTrack::UpdataObsRadar(const base::ObjectPtr& obs_radar,
   *obs_ = *obs_radar;
   double time_diff = timestamp - timestamp_;
   if (s_use_filter_) {
-    Eigen::VectorXd state;
-    state = filter_->UpdateWithObject(*obs_radar_, time_diff);
+    const Eigen::Vector4d state =
+        filter_->UpdateWithObject(*obs_radar_, time_diff);
     obs_->center(0) = static_cast<float>(state(0));
     obs_->center(1) = static_cast<float>(state(1));
     obs_->velocity(0) = static_cast<float>(state(2));
@@ -20,6 +20,7 @@
 
 #include "cyber/common/macros.h"
 
+#include "modules/perception/radar/common/object_recycler.h"
 #include "modules/perception/radar/lib/interface/base_tracker.h"
 #include "modules/perception/radar/lib/tracker/common/radar_track_manager.h"
 #include "modules/perception/radar/lib/tracker/matcher/hm_matcher.h"
@@ -43,7 +44,7 @@ class ContiArsTracker : public BaseTracker {
   static double s_tracking_time_win_;
   void TrackObjects(const base::Frame &radar_frame);
   void UpdateAssignedTracks(const base::Frame &radar_frame,
-                            std::vector<TrackObjectPair> assignments);
+                            const std::vector<TrackObjectPair> &assignments);
   void UpdateUnassignedTracks(const base::Frame &radar_frame,
                               const std::vector<size_t> &unassigned_tracks);
   void DeleteLostTracks();
@@ -51,6 +52,13 @@ class ContiArsTracker : public BaseTracker {
                        const std::vector<size_t> &unassigned_objects);
   void CollectTrackedFrame(base::FramePtr tracked_frame);
 
+  // kept between frames to avoid reallocation
+  std::vector<TrackObjectPair> assignments_;
+  std::vector<size_t> unassigned_tracks_;
+  std::vector<size_t> unassigned_objects_;
+  // objects of the tracked frames
+  ObjectRecycler tracked_objects_;
+
   DISALLOW_COPY_AND_ASSIGN(ContiArsTracker);
 };
 }  // namespace radar
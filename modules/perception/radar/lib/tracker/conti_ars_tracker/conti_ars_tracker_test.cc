@@ -16,6 +16,7 @@
 #include "gtest/gtest.h"
 
 #include "cyber/common/log.h"
+#include "modules/control/common/allocation_counter.h"
 #include "modules/perception/common/perception_gflags.h"
 
 #define private public
@@ -121,6 +122,36 @@ TEST(ContiArsTrackerTest, conti_ars_tracker_unassigned_test) {
   EXPECT_EQ(tracker->track_manager_->GetTracks().size(), 0);
 }
 
+TEST(ContiArsTrackerTest, conti_ars_tracker_allocation_test) {
+  std::unique_ptr<ContiArsTracker> tracker(new ContiArsTracker());
+  FLAGS_work_root = "./radar_test_data/conti_ars_tracker";
+  tracker->Init();
+  RadarTrack::SetTrackedTimesThreshold(0);
+  base::Frame radar_frame;
+  radar_frame.objects.resize(2);
+  radar_frame.objects[0].reset(new base::Object);
+  radar_frame.objects[0]->track_id = 100;
+  radar_frame.objects[0]->center << 12.0, 15.0, 0.0;
+  radar_frame.objects[1].reset(new base::Object);
+  radar_frame.objects[1]->track_id = 200;
+  radar_frame.objects[1]->center << 50.3, 100.4, 0.0;
+  TrackerOptions options;
+  base::FramePtr tracked_frame(new base::Frame);
+
+  // the first frames create the tracks and fill the buffers
+  const int warmup_frames = 3;
+  for (int i = 0; i < 20; ++i) {
+    radar_frame.timestamp = 123456789.0 + 0.05 * i;
+    tracked_frame->Reset();
+    control::ScopedAllocationCounter counter;
+    EXPECT_TRUE(tracker->Track(radar_frame, options, tracked_frame));
+    EXPECT_EQ(tracked_frame->objects.size(), 2);
+    if (i >= warmup_frames) {
+      EXPECT_EQ(counter.count(), 0) << "frame " << i;
+    }
+  }
+}
+
 }  // namespace radar
 }  // namespace perception
 }  // namespace apollo
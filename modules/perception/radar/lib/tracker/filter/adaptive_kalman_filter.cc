@@ -48,16 +48,15 @@ void AdaptiveKalmanFilter::Init(const base::Object& object) {
       object.velocity_uncertainty.topLeftCorner(2, 2).cast<double>();
   c_matrix_.setIdentity();
 }
-Eigen::VectorXd AdaptiveKalmanFilter::Predict(const double time_diff) {
-  Eigen::VectorXd state;
-  state.resize(4);
+Eigen::Vector4d AdaptiveKalmanFilter::Predict(const double time_diff) {
+  Eigen::Vector4d state;
   state[0] = belief_anchor_point_[0] + belief_velocity_[0] * time_diff;
   state[1] = belief_anchor_point_[1] + belief_velocity_[1] * time_diff;
   state[2] = belief_velocity_[0];
   state[3] = belief_velocity_[1];
   return state;
 }
-Eigen::VectorXd AdaptiveKalmanFilter::UpdateWithObject(
+Eigen::Vector4d AdaptiveKalmanFilter::UpdateWithObject(
     const base::Object& new_object, double time_diff) {
   // predict and then correct
   a_matrix_.setIdentity();
@@ -92,8 +91,7 @@ Eigen::VectorXd AdaptiveKalmanFilter::UpdateWithObject(
   belief_anchor_point_(1) = posteriori_state_(1);
   belief_velocity_(0) = posteriori_state_(2);
   belief_velocity_(1) = posteriori_state_(3);
-  Eigen::VectorXd state;
-  state.resize(4);
+  Eigen::Vector4d state;
   state[0] = belief_anchor_point_[0];
   state[1] = belief_anchor_point_[1];
   state[2] = belief_velocity_[0];
@@ -28,8 +28,8 @@ class AdaptiveKalmanFilter : public BaseFilter {
   AdaptiveKalmanFilter();
   ~AdaptiveKalmanFilter();
   void Init(const base::Object& object) override;
-  Eigen::VectorXd Predict(const double time_diff) override;
-  Eigen::VectorXd UpdateWithObject(const base::Object& new_object,
+  Eigen::Vector4d Predict(const double time_diff) override;
+  Eigen::Vector4d UpdateWithObject(const base::Object& new_object,
                                    double time_diff) override;
   void GetState(Eigen::Vector3d* anchor_point, Eigen::Vector3d* velocity);
   Eigen::Matrix4d GetCovarianceMatrix() override { return p_matrix_; }
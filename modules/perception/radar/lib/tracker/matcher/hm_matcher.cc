@@ -100,9 +100,10 @@ void HMMatcher::TrackObjectPropertyMatch(
   if (unassigned_tracks->empty() || unassigned_objects->empty()) {
     return;
   }
-  std::vector<std::vector<double>> association_mat(unassigned_tracks->size());
+  std::vector<std::vector<double>> &association_mat = association_mat_;
+  association_mat.resize(unassigned_tracks->size());
   for (size_t i = 0; i < association_mat.size(); ++i) {
-    association_mat[i].resize(unassigned_objects->size(), 0);
+    association_mat[i].assign(unassigned_objects->size(), 0);
   }
   ComputeAssociationMat(radar_tracks, radar_frame, *unassigned_tracks,
                         *unassigned_objects, &association_mat);
@@ -116,9 +117,14 @@ void HMMatcher::TrackObjectPropertyMatch(
       (*global_costs)(i, j) = association_mat[i][j];
     }
   }
-  std::vector<TrackObjectPair> property_assignments;
-  std::vector<size_t> property_unassigned_tracks;
-  std::vector<size_t> property_unassigned_objects;
+  std::vector<TrackObjectPair> &property_assignments = property_assignments_;
+  std::vector<size_t> &property_unassigned_tracks =
+      property_unassigned_tracks_;
+  std::vector<size_t> &property_unassigned_objects =
+      property_unassigned_objects_;
+  property_assignments.clear();
+  property_unassigned_tracks.clear();
+  property_unassigned_objects.clear();
   hungarian_matcher_.Match(
       BaseMatcher::GetMaxMatchDistance(), BaseMatcher::GetBoundMatchDistance(),
       common::GatedHungarianMatcher<double>::OptimizeFlag::OPTMIN,
@@ -130,18 +136,17 @@ void HMMatcher::TrackObjectPropertyMatch(
     size_t go_idx = unassigned_objects->at(property_assignments[i].second);
     assignments->push_back(std::pair<size_t, size_t>(gt_idx, go_idx));
   }
-  std::vector<size_t> temp_unassigned_tracks;
-  std::vector<size_t> temp_unassigned_objects;
+  // map to the global indices in place, the local ones are sorted
   for (size_t i = 0; i < property_unassigned_tracks.size(); ++i) {
-    size_t gt_idx = unassigned_tracks->at(property_unassigned_tracks[i]);
-    temp_unassigned_tracks.push_back(gt_idx);
+    (*unassigned_tracks)[i] =
+        unassigned_tracks->at(property_unassigned_tracks[i]);
   }
+  unassigned_tracks->resize(property_unassigned_tracks.size());
   for (size_t i = 0; i < property_unassigned_objects.size(); ++i) {
-    size_t go_idx = unassigned_objects->at(property_unassigned_objects[i]);
-    temp_unassigned_objects.push_back(go_idx);
+    (*unassigned_objects)[i] =
+        unassigned_objects->at(property_unassigned_objects[i]);
   }
-  *unassigned_tracks = temp_unassigned_tracks;
-  *unassigned_objects = temp_unassigned_objects;
+  unassigned_objects->resize(property_unassigned_objects.size());
 }
 void HMMatcher::ComputeAssociationMat(
     const std::vector<RadarTrackPtr> &radar_tracks,
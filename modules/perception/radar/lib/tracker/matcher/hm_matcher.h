@@ -65,6 +65,12 @@ class HMMatcher : public BaseMatcher {
                              std::vector<std::vector<double>> *association_mat);
   double DistanceBetweenObs(const base::ObjectPtr &obs1, double timestamp1,
                             const base::ObjectPtr &obs2, double timestamp2);
+
+  // kept between frames to avoid reallocation
+  std::vector<std::vector<double>> association_mat_;
+  std::vector<TrackObjectPair> property_assignments_;
+  std::vector<size_t> property_unassigned_tracks_;
+  std::vector<size_t> property_unassigned_objects_;
 };
 
 }  // namespace radar
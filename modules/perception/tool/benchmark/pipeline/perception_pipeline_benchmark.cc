@@ -0,0 +1,790 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+// Replays the lidar, camera and radar frames of cyber records through the
+// perception pipeline as fast as it goes, outside of the components and their
+// timing: LidarObstacleSegmentation and LidarObstacleTracking for every
+// lidar, ObstacleCameraPerception for the cameras, the radar perception for
+// every radar, and ProbabilisticFusion of them all. Frames are decoded from
+// the records before anything is timed, e.g.
+//   perception_pipeline_benchmark --record_path=/data/a.record,/data/b.record
+//       --sensor_scales=1,2,4
+// Every scale runs that many copies of the recorded sensors at once, each
+// copy with its own pipelines, all sharing the cores, the gpu and the fusion.
+// The copies keep the sensor names of the calibration, so fusion gets every
+// frame once per copy, as it would from that many sensors. For every scale
+// the latency percentiles of every stage, the frames/s of all sensors and the
+// gpu utilization are reported.
+// No tf is replayed: every sensor sits at the world origin and the hdmap roi
+// is off, which leaves the work of the stages the same.
+
+#include <dlfcn.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/str_split.h"
+#include "gflags/gflags.h"
+
+#include "cyber/base/thread_safe_queue.h"
+#include "cyber/common/log.h"
+#include "cyber/record/record_reader.h"
+#include "modules/drivers/proto/conti_radar.pb.h"
+#include "modules/drivers/proto/pointcloud.pb.h"
+#include "modules/drivers/proto/sensor_image.pb.h"
+#include "modules/perception/base/frame.h"
+#include "modules/perception/camera/app/obstacle_camera_perception.h"
+#include "modules/perception/camera/lib/calibration_service/online_calibration_service/online_calibration_service.h"
+#include "modules/perception/camera/lib/calibrator/laneline/laneline_calibrator.h"
+#include "modules/perception/camera/lib/feature_extractor/tfe/external_feature_extractor.h"
+#include "modules/perception/camera/lib/feature_extractor/tfe/project_feature.h"
+#include "modules/perception/camera/lib/feature_extractor/tfe/tracking_feat_extractor.h"
+#include "modules/perception/camera/lib/lane/detector/darkSCNN/darkSCNN_lane_detector.h"
+#include "modules/perception/camera/lib/lane/detector/denseline/denseline_lane_detector.h"
+#include "modules/perception/camera/lib/lane/postprocessor/darkSCNN/darkSCNN_lane_postprocessor.h"
+#include "modules/perception/camera/lib/lane/postprocessor/denseline/denseline_lane_postprocessor.h"
+#include "modules/perception/camera/lib/obstacle/detector/yolo/yolo_obstacle_detector.h"
+#include "modules/perception/camera/lib/obstacle/postprocessor/location_refiner/location_refiner_obstacle_postprocessor.h"
+#include "modules/perception/camera/lib/obstacle/tracker/omt/omt_obstacle_tracker.h"
+#include "modules/perception/camera/lib/obstacle/transformer/multicue/multicue_obstacle_transformer.h"
+#include "modules/perception/common/sensor_manager/sensor_manager.h"
+#include "modules/perception/fusion/app/obstacle_multi_sensor_fusion.h"
+#include "modules/perception/lidar/app/lidar_obstacle_segmentation.h"
+#include "modules/perception/lidar/app/lidar_obstacle_tracking.h"
+#include "modules/perception/lidar/common/lidar_frame_pool.h"
+#include "modules/perception/radar/lib/interface/base_preprocessor.h"
+#include "modules/perception/radar/lib/interface/base_radar_obstacle_perception.h"
+
+DEFINE_string(record_path, "", "comma separated cyber records to replay");
+DEFINE_string(lidar_channels,
+              "velodyne128=/apollo/sensor/lidar128/compensator/PointCloud2",
+              "comma separated sensor_name=channel of the lidars");
+DEFINE_string(camera_channels,
+              "front_6mm=/apollo/sensor/camera/front_6mm/image,"
+              "front_12mm=/apollo/sensor/camera/front_12mm/image",
+              "comma separated sensor_name=channel of the cameras");
+DEFINE_string(radar_channels, "radar_front=/apollo/sensor/radar/front",
+              "comma separated sensor_name=channel of the radars");
+DEFINE_string(sensor_scales, "1,2,4",
+              "comma separated numbers of copies of the recorded sensors");
+DEFINE_int32(max_frames, 0, "frames loaded per sensor, 0 for all of them");
+DEFINE_int32(warmup_frames, 5,
+             "first frames of every sensor left out of the latencies");
+DEFINE_string(camera_config_root,
+              "/apollo/modules/perception/production/conf/perception/camera",
+              "root of the camera perception config");
+DEFINE_string(camera_config_file, "obstacle.pt", "camera perception config");
+DEFINE_int32(image_width, 1920, "width of the camera images");
+DEFINE_int32(image_height, 1080, "height of the camera images");
+DEFINE_double(camera_height, 1.5, "height of the cameras above the ground");
+DEFINE_string(radar_preprocessor, "ContiArsPreprocessor", "radar preprocessor");
+DEFINE_string(radar_perception, "RadarObstaclePerception", "radar perception");
+DEFINE_string(radar_pipeline, "FrontRadarPipeline", "radar pipeline");
+DEFINE_string(fusion_method, "ProbabilisticFusion", "fusion method");
+DEFINE_string(fusion_main_sensor, "velodyne128", "main sensor of fusion");
+DEFINE_int32(gpu_id, 0, "gpu the pipelines run on");
+DEFINE_int32(gpu_sample_ms, 50, "period of the gpu utilization samples");
+
+namespace apollo {
+namespace perception {
+namespace camera {
+
+// the camera libraries are not always linked, as in offline_obstacle_pipeline
+REGISTER_OBSTACLE_DETECTOR(YoloObstacleDetector);
+REGISTER_OBSTACLE_TRACKER(OMTObstacleTracker);
+REGISTER_FEATURE_EXTRACTOR(TrackingFeatureExtractor);
+REGISTER_OBSTACLE_TRANSFORMER(MultiCueObstacleTransformer);
+REGISTER_OBSTACLE_POSTPROCESSOR(LocationRefinerObstaclePostprocessor);
+REGISTER_FEATURE_EXTRACTOR(ProjectFeature);
+REGISTER_FEATURE_EXTRACTOR(ExternalFeatureExtractor);
+REGISTER_LANE_POSTPROCESSOR(DenselineLanePostprocessor);
+REGISTER_LANE_DETECTOR(DenselineLaneDetector);
+REGISTER_CALIBRATOR(LaneLineCalibrator);
+REGISTER_CALIBRATION_SERVICE(OnlineCalibrationService);
+REGISTER_LANE_DETECTOR(DarkSCNNLaneDetector);
+REGISTER_LANE_POSTPROCESSOR(DarkSCNNLanePostprocessor);
+
+}  // namespace camera
+
+namespace benchmark {
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+double ElapsedMs(const Clock::time_point& start) {
+  return std::chrono::duration<double, std::milli>(Clock::now() - start)
+      .count();
+}
+
+double Percentile(const std::vector<double>& sorted, double ratio) {
+  const size_t index = std::min(
+      sorted.size() - 1,
+      static_cast<size_t>(ratio * static_cast<double>(sorted.size())));
+  return sorted[index];
+}
+
+std::vector<std::pair<std::string, std::string>> ParseSensors(
+    const std::string& sensors) {
+  std::vector<std::pair<std::string, std::string>> names_channels;
+  for (const auto& sensor : absl::StrSplit(sensors, ',', absl::SkipEmpty())) {
+    const std::vector<std::string> name_channel = absl::StrSplit(sensor, '=');
+    if (name_channel.size() != 2) {
+      AERROR << "Invalid sensor " << sensor << ", expect name=channel.";
+      continue;
+    }
+    names_channels.emplace_back(name_channel[0], name_channel[1]);
+  }
+  return names_channels;
+}
+
+}  // namespace
+
+class LatencyStats {
+ public:
+  void Add(const std::string& stage, const double latency_ms) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    latencies_ms_[stage].push_back(latency_ms);
+  }
+
+  void Report() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& stage_latencies : latencies_ms_) {
+      auto& latencies_ms = stage_latencies.second;
+      std::sort(latencies_ms.begin(), latencies_ms.end());
+      double sum_ms = 0.0;
+      for (const double latency_ms : latencies_ms) {
+        sum_ms += latency_ms;
+      }
+      AINFO << "  " << stage_latencies.first
+            << " frames: " << latencies_ms.size()
+            << " mean: " << sum_ms / static_cast<double>(latencies_ms.size())
+            << " ms p50: " << Percentile(latencies_ms, 0.5)
+            << " ms p90: " << Percentile(latencies_ms, 0.9)
+            << " ms p99: " << Percentile(latencies_ms, 0.99)
+            << " ms max: " << latencies_ms.back() << " ms";
+    }
+  }
+
+ private:
+  std::mutex mutex_;
+  std::map<std::string, std::vector<double>> latencies_ms_;
+};
+
+// Samples the gpu utilization with nvml, which is loaded at run time so the
+// benchmark also runs where the driver does not ship it.
+class GpuUtilizationMonitor {
+ public:
+  ~GpuUtilizationMonitor() {
+    Stop();
+    if (shutdown_ != nullptr) {
+      shutdown_();
+    }
+    if (lib_ != nullptr) {
+      dlclose(lib_);
+    }
+  }
+
+  bool Init(const int gpu_id) {
+    lib_ = dlopen("libnvidia-ml.so.1", RTLD_LAZY);
+    if (lib_ == nullptr) {
+      AWARN << "No nvml, gpu utilization is not sampled.";
+      return false;
+    }
+    auto init = reinterpret_cast<InitFunc>(dlsym(lib_, "nvmlInit_v2"));
+    auto get_handle = reinterpret_cast<GetHandleFunc>(
+        dlsym(lib_, "nvmlDeviceGetHandleByIndex_v2"));
+    get_utilization_ = reinterpret_cast<GetUtilizationFunc>(
+        dlsym(lib_, "nvmlDeviceGetUtilizationRates"));
+    auto shutdown = reinterpret_cast<ShutdownFunc>(dlsym(lib_, "nvmlShutdown"));
+    if (init == nullptr || get_handle == nullptr ||
+        get_utilization_ == nullptr || shutdown == nullptr || init() != 0) {
+      AWARN << "Failed to init nvml, gpu utilization is not sampled.";
+      return false;
+    }
+    shutdown_ = shutdown;
+    if (get_handle(static_cast<unsigned int>(gpu_id), &device_) != 0) {
+      AWARN << "No gpu " << gpu_id << " in nvml.";
+      device_ = nullptr;
+      return false;
+    }
+    return true;
+  }
+
+  void Start(const int period_ms) {
+    if (device_ == nullptr) {
+      return;
+    }
+    samples_.clear();
+    running_ = true;
+    thread_ = std::thread([this, period_ms]() {
+      while (running_.load(std::memory_order_relaxed)) {
+        Utilization utilization;
+        if (get_utilization_(device_, &utilization) == 0) {
+          samples_.push_back(utilization.gpu);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(period_ms));
+      }
+    });
+  }
+
+  void Stop() {
+    running_ = false;
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+  }
+
+  // percent busy of the sampling periods, after Stop()
+  bool GetUtilization(double* mean, unsigned int* max) const {
+    if (samples_.empty()) {
+      return false;
+    }
+    double sum = 0.0;
+    *max = 0;
+    for (const unsigned int sample : samples_) {
+      sum += sample;
+      *max = std::max(*max, sample);
+    }
+    *mean = sum / static_cast<double>(samples_.size());
+    return true;
+  }
+
+ private:
+  // nvmlUtilization_t
+  struct Utilization {
+    unsigned int gpu;
+    unsigned int memory;
+  };
+  using InitFunc = int (*)();
+  using GetHandleFunc = int (*)(unsigned int, void**);
+  using GetUtilizationFunc = int (*)(void*, Utilization*);
+  using ShutdownFunc = int (*)();
+
+  void* lib_ = nullptr;
+  void* device_ = nullptr;
+  GetUtilizationFunc get_utilization_ = nullptr;
+  ShutdownFunc shutdown_ = nullptr;
+  std::atomic<bool> running_ = {false};
+  std::thread thread_;
+  std::vector<unsigned int> samples_;
+};
+
+struct CameraMessage {
+  std::string camera_name;
+  std::shared_ptr<const drivers::Image> image;
+};
+
+struct Recording {
+  std::vector<std::string> lidar_names;
+  std::vector<std::vector<std::shared_ptr<const drivers::PointCloud>>> lidars;
+  std::vector<std::string> camera_names;
+  // all cameras in the order they were recorded, they share one pipeline
+  std::vector<CameraMessage> cameras;
+  std::vector<std::string> radar_names;
+  std::vector<std::vector<std::shared_ptr<const drivers::ContiRadar>>> radars;
+};
+
+// A frame for fusion, nullptr once a sensor is done.
+struct TimedFrame {
+  base::FramePtr frame;
+  Clock::time_point start;
+  bool warmup = false;
+};
+
+using FrameQueue = cyber::base::ThreadSafeQueue<TimedFrame>;
+
+template <typename MessageT>
+bool Parse(const std::string& content,
+           std::vector<std::shared_ptr<const MessageT>>* messages) {
+  if (FLAGS_max_frames > 0 &&
+      messages->size() >= static_cast<size_t>(FLAGS_max_frames)) {
+    return true;
+  }
+  auto message = std::make_shared<MessageT>();
+  if (!message->ParseFromString(content)) {
+    return false;
+  }
+  messages->push_back(message);
+  return true;
+}
+
+bool LoadRecords(Recording* recording) {
+  std::map<std::string, std::function<bool(const std::string&)>> parsers;
+  const auto lidars = ParseSensors(FLAGS_lidar_channels);
+  recording->lidars.resize(lidars.size());
+  for (size_t i = 0; i < lidars.size(); ++i) {
+    recording->lidar_names.push_back(lidars[i].first);
+    parsers[lidars[i].second] = [recording, i](const std::string& content) {
+      return Parse(content, &recording->lidars[i]);
+    };
+  }
+  std::map<std::string, size_t> camera_frame_nums;
+  for (const auto& camera : ParseSensors(FLAGS_camera_channels)) {
+    const std::string camera_name = camera.first;
+    recording->camera_names.push_back(camera_name);
+    parsers[camera.second] = [recording, camera_name, &camera_frame_nums](
+                                 const std::string& content) {
+      size_t& frame_num = camera_frame_nums[camera_name];
+      if (FLAGS_max_frames > 0 &&
+          frame_num >= static_cast<size_t>(FLAGS_max_frames)) {
+        return true;
+      }
+      auto image = std::make_shared<drivers::Image>();
+      if (!image->ParseFromString(content)) {
+        return false;
+      }
+      ++frame_num;
+      recording->cameras.push_back({camera_name, image});
+      return true;
+    };
+  }
+  const auto radars = ParseSensors(FLAGS_radar_channels);
+  recording->radars.resize(radars.size());
+  for (size_t i = 0; i < radars.size(); ++i) {
+    recording->radar_names.push_back(radars[i].first);
+    parsers[radars[i].second] = [recording, i](const std::string& content) {
+      return Parse(content, &recording->radars[i]);
+    };
+  }
+
+  for (const auto& record_path :
+       absl::StrSplit(FLAGS_record_path, ',', absl::SkipEmpty())) {
+    cyber::record::RecordReader reader{std::string(record_path)};
+    if (!reader.IsValid()) {
+      AERROR << "Failed to open record " << record_path;
+      return false;
+    }
+    cyber::record::RecordMessage message;
+    while (reader.ReadMessage(&message)) {
+      auto parser = parsers.find(message.channel_name);
+      if (parser != parsers.end() && !parser->second(message.content)) {
+        AERROR << "Failed to parse a message of " << message.channel_name;
+        return false;
+      }
+    }
+  }
+  for (size_t i = 0; i < recording->lidars.size(); ++i) {
+    AINFO << "Loaded " << recording->lidars[i].size() << " frames of "
+          << recording->lidar_names[i];
+  }
+  AINFO << "Loaded " << recording->cameras.size() << " camera frames.";
+  for (size_t i = 0; i < recording->radars.size(); ++i) {
+    AINFO << "Loaded " << recording->radars[i].size() << " frames of "
+          << recording->radar_names[i];
+  }
+  return true;
+}
+
+class LidarPipeline {
+ public:
+  bool Init(const std::string& sensor_name) {
+    if (!common::SensorManager::Instance()->GetSensorInfo(sensor_name,
+                                                          &sensor_info_)) {
+      AERROR << "Failed to get sensor info of " << sensor_name;
+      return false;
+    }
+    lidar::LidarObstacleSegmentationInitOptions segmentation_init_options;
+    segmentation_init_options.sensor_name = sensor_name;
+    segmentation_init_options.enable_hdmap_input = false;
+    lidar::LidarObstacleTrackingInitOptions tracking_init_options;
+    tracking_init_options.sensor_name = sensor_name;
+    return segmentation_.Init(segmentation_init_options) &&
+           tracking_.Init(tracking_init_options);
+  }
+
+  base::FramePtr Process(
+      const std::shared_ptr<const drivers::PointCloud>& message,
+      LatencyStats* stats) {
+    auto lidar_frame = lidar::LidarFramePool::Instance().Get();
+    lidar_frame->cloud = base::PointFCloudPool::Instance().Get();
+    lidar_frame->timestamp = message->measurement_time();
+    lidar_frame->sensor_info = sensor_info_;
+
+    auto start = Clock::now();
+    lidar::LidarObstacleSegmentationOptions segmentation_options;
+    segmentation_options.sensor_name = sensor_info_.name;
+    segmentation_options.sensor2novatel_extrinsics =
+        Eigen::Affine3d::Identity();
+    auto result =
+        segmentation_.Process(segmentation_options, message, lidar_frame.get());
+    if (result.error_code != lidar::LidarErrorCode::Succeed) {
+      AERROR << "Lidar segmentation failed, " << result.log;
+      return nullptr;
+    }
+    if (stats != nullptr) {
+      stats->Add("lidar_segmentation", ElapsedMs(start));
+    }
+
+    start = Clock::now();
+    lidar::LidarObstacleTrackingOptions tracking_options;
+    tracking_options.sensor_name = sensor_info_.name;
+    result = tracking_.Process(tracking_options, lidar_frame.get());
+    if (result.error_code != lidar::LidarErrorCode::Succeed) {
+      AERROR << "Lidar tracking failed, " << result.log;
+      return nullptr;
+    }
+    if (stats != nullptr) {
+      stats->Add("lidar_tracking", ElapsedMs(start));
+    }
+
+    auto frame = base::FramePool::Instance().Get();
+    frame->sensor_info = sensor_info_;
+    frame->timestamp = lidar_frame->timestamp;
+    frame->objects = lidar_frame->tracked_objects;
+    frame->sensor2world_pose = lidar_frame->lidar2world_pose;
+    frame->lidar_frame_supplement.on_use = true;
+    frame->lidar_frame_supplement.cloud_ptr = lidar_frame->cloud;
+    return frame;
+  }
+
+ private:
+  base::SensorInfo sensor_info_;
+  lidar::LidarObstacleSegmentation segmentation_;
+  lidar::LidarObstacleTracking tracking_;
+};
+
+class CameraPipeline {
+ public:
+  bool Init(const std::vector<std::string>& camera_names) {
+    camera::CameraPerceptionInitOptions init_options;
+    init_options.root_dir = FLAGS_camera_config_root;
+    init_options.conf_file = FLAGS_camera_config_file;
+    init_options.lane_calibration_working_sensor_name = camera_names.front();
+    init_options.use_cyber_work_root = true;
+    if (!perception_.Init(init_options)) {
+      AERROR << "Failed to init camera perception.";
+      return false;
+    }
+
+    std::map<std::string, float> camera_heights;
+    std::map<std::string, float> pitch_angle_diffs;
+    for (const auto& camera_name : camera_names) {
+      if (!common::SensorManager::Instance()->GetSensorInfo(
+              camera_name, &sensor_infos_[camera_name])) {
+        AERROR << "Failed to get sensor info of " << camera_name;
+        return false;
+      }
+      camera::DataProvider::InitOptions data_provider_init_options;
+      data_provider_init_options.image_height = FLAGS_image_height;
+      data_provider_init_options.image_width = FLAGS_image_width;
+      data_provider_init_options.sensor_name = camera_name;
+      data_provider_init_options.device_id = FLAGS_gpu_id;
+      auto& data_provider = data_providers_[camera_name];
+      data_provider.reset(new camera::DataProvider);
+      if (!data_provider->Init(data_provider_init_options)) {
+        AERROR << "Failed to init data provider of " << camera_name;
+        return false;
+      }
+      camera_heights[camera_name] = static_cast<float>(FLAGS_camera_height);
+      pitch_angle_diffs[camera_name] = 0.0f;
+    }
+    perception_.SetCameraHeightAndPitch(camera_heights, pitch_angle_diffs,
+                                        0.0f);
+
+    frames_.resize(kFrameCapacity);
+    for (auto& frame : frames_) {
+      frame.track_feature_blob.reset(new base::Blob<float>());
+      frame.lane_detected_blob.reset(new base::Blob<float>());
+    }
+    return true;
+  }
+
+  base::FramePtr Process(const CameraMessage& message, LatencyStats* stats) {
+    camera::CameraFrame& camera_frame = frames_[frame_id_ % kFrameCapacity];
+    camera_frame.frame_id = frame_id_++;
+    camera_frame.timestamp = message.image->measurement_time();
+    camera_frame.camera2world_pose = Eigen::Affine3d::Identity();
+    camera_frame.project_matrix.setIdentity();
+    camera_frame.data_provider = data_providers_[message.camera_name].get();
+
+    const auto start = Clock::now();
+    if (!camera_frame.data_provider->FillImageData(
+            FLAGS_image_height, FLAGS_image_width,
+            reinterpret_cast<const uint8_t*>(message.image->data().data()),
+            message.image->encoding())) {
+      AERROR << "Failed to fill the image of " << message.camera_name;
+      return nullptr;
+    }
+    perception_.GetCalibrationService(&camera_frame.calibration_service);
+    if (!perception_.Perception(options_, &camera_frame)) {
+      AERROR << "Camera perception failed.";
+      return nullptr;
+    }
+    if (stats != nullptr) {
+      stats->Add("camera_perception", ElapsedMs(start));
+    }
+
+    auto frame = base::FramePool::Instance().Get();
+    frame->sensor_info = sensor_infos_[message.camera_name];
+    frame->timestamp = camera_frame.timestamp;
+    frame->sensor2world_pose = camera_frame.camera2world_pose;
+    frame->objects.clear();
+    for (const auto& object : camera_frame.tracked_objects) {
+      const auto& box = object->camera_supplement.box;
+      if (box.xmin < box.xmax && box.ymin < box.ymax) {
+        frame->objects.push_back(object);
+      }
+    }
+    frame->camera_frame_supplement.on_use = true;
+    return frame;
+  }
+
+ private:
+  static constexpr int kFrameCapacity = 20;
+
+  camera::ObstacleCameraPerception perception_;
+  camera::CameraPerceptionOptions options_;
+  std::map<std::string, base::SensorInfo> sensor_infos_;
+  std::map<std::string, std::unique_ptr<camera::DataProvider>> data_providers_;
+  std::vector<camera::CameraFrame> frames_;
+  int frame_id_ = 0;
+};
+
+class RadarPipeline {
+ public:
+  bool Init(const std::string& sensor_name) {
+    if (!common::SensorManager::Instance()->GetSensorInfo(sensor_name,
+                                                          &sensor_info_)) {
+      AERROR << "Failed to get sensor info of " << sensor_name;
+      return false;
+    }
+    preprocessor_.reset(radar::BasePreprocessorRegisterer::GetInstanceByName(
+        FLAGS_radar_preprocessor));
+    perception_.reset(
+        radar::BaseRadarObstaclePerceptionRegisterer::GetInstanceByName(
+            FLAGS_radar_perception));
+    if (preprocessor_ == nullptr || perception_ == nullptr) {
+      AERROR << "No radar preprocessor " << FLAGS_radar_preprocessor
+             << " or perception " << FLAGS_radar_perception;
+      return false;
+    }
+    return preprocessor_->Init() && perception_->Init(FLAGS_radar_pipeline);
+  }
+
+  base::FramePtr Process(
+      const std::shared_ptr<const drivers::ContiRadar>& message,
+      LatencyStats* stats) {
+    const auto start = Clock::now();
+    corrected_obstacles_.Clear();
+    preprocessor_->Preprocess(*message, radar::PreprocessorOptions(),
+                              &corrected_obstacles_);
+    Eigen::Matrix4d radar2world_pose = Eigen::Matrix4d::Identity();
+    Eigen::Matrix4d radar2novatel_trans = Eigen::Matrix4d::Identity();
+    radar::RadarPerceptionOptions options;
+    options.sensor_name = sensor_info_.name;
+    options.detector_options.radar2world_pose = &radar2world_pose;
+    options.detector_options.radar2novatel_trans = &radar2novatel_trans;
+    options.roi_filter_options.roi.reset(new base::HdmapStruct());
+    auto frame = base::FramePool::Instance().Get();
+    if (!perception_->Perceive(corrected_obstacles_, options,
+                               &frame->objects)) {
+      AERROR << "Radar perception failed.";
+      return nullptr;
+    }
+    if (stats != nullptr) {
+      stats->Add("radar_perception", ElapsedMs(start));
+    }
+
+    frame->sensor_info = sensor_info_;
+    frame->timestamp = corrected_obstacles_.header().timestamp_sec();
+    frame->sensor2world_pose = Eigen::Affine3d::Identity();
+    return frame;
+  }
+
+ private:
+  base::SensorInfo sensor_info_;
+  std::unique_ptr<radar::BasePreprocessor> preprocessor_;
+  std::unique_ptr<radar::BaseRadarObstaclePerception> perception_;
+  drivers::ContiRadar corrected_obstacles_;
+};
+
+// The pipelines of one copy of the recorded sensors.
+struct SensorCopy {
+  std::vector<std::unique_ptr<LidarPipeline>> lidars;
+  std::unique_ptr<CameraPipeline> camera;
+  std::vector<std::unique_ptr<RadarPipeline>> radars;
+};
+
+class PerceptionPipelineBenchmark {
+ public:
+  explicit PerceptionPipelineBenchmark(const Recording* recording)
+      : recording_(recording) {}
+
+  bool Init() {
+    gpu_monitor_.Init(FLAGS_gpu_id);
+    fusion::ObstacleMultiSensorFusionParam param;
+    param.main_sensor = FLAGS_fusion_main_sensor;
+    param.fusion_method = FLAGS_fusion_method;
+    return fusion_.Init(param);
+  }
+
+  bool Run(const int scale) {
+    std::vector<std::unique_ptr<SensorCopy>> copies;
+    for (int i = 0; i < scale; ++i) {
+      copies.emplace_back(new SensorCopy);
+      if (!InitCopy(copies.back().get())) {
+        return false;
+      }
+    }
+
+    LatencyStats stats;
+    FrameQueue queue;
+    std::atomic<size_t> frame_num = {0};
+    std::vector<std::thread> threads;
+    gpu_monitor_.Start(FLAGS_gpu_sample_ms);
+    const auto start = Clock::now();
+    auto run_sensor = [&](const auto& messages, auto* pipeline) {
+      threads.emplace_back([&, pipeline, messages = &messages]() {
+        RunSensor(*messages, pipeline, &queue, &stats, &frame_num);
+      });
+    };
+    for (auto& copy : copies) {
+      for (size_t i = 0; i < copy->lidars.size(); ++i) {
+        run_sensor(recording_->lidars[i], copy->lidars[i].get());
+      }
+      if (copy->camera != nullptr) {
+        run_sensor(recording_->cameras, copy->camera.get());
+      }
+      for (size_t i = 0; i < copy->radars.size(); ++i) {
+        run_sensor(recording_->radars[i], copy->radars[i].get());
+      }
+    }
+    RunFusion(threads.size(), &queue, &stats);
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    const double elapsed_s = ElapsedMs(start) * 1e-3;
+    gpu_monitor_.Stop();
+
+    AINFO << "sensor copies: " << scale << " frames: " << frame_num.load()
+          << " seconds: " << elapsed_s
+          << " frames/s: " << static_cast<double>(frame_num.load()) / elapsed_s;
+    double gpu_mean = 0.0;
+    unsigned int gpu_max = 0;
+    if (gpu_monitor_.GetUtilization(&gpu_mean, &gpu_max)) {
+      AINFO << "  gpu utilization mean: " << gpu_mean << "% max: " << gpu_max
+            << "%";
+    }
+    stats.Report();
+    return true;
+  }
+
+ private:
+  bool InitCopy(SensorCopy* copy) {
+    for (const auto& lidar_name : recording_->lidar_names) {
+      copy->lidars.emplace_back(new LidarPipeline);
+      if (!copy->lidars.back()->Init(lidar_name)) {
+        return false;
+      }
+    }
+    if (!recording_->cameras.empty()) {
+      copy->camera.reset(new CameraPipeline);
+      if (!copy->camera->Init(recording_->camera_names)) {
+        return false;
+      }
+    }
+    for (const auto& radar_name : recording_->radar_names) {
+      copy->radars.emplace_back(new RadarPipeline);
+      if (!copy->radars.back()->Init(radar_name)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  template <typename MessageT, typename PipelineT>
+  static void RunSensor(const std::vector<MessageT>& messages,
+                        PipelineT* pipeline, FrameQueue* queue,
+                        LatencyStats* stats, std::atomic<size_t>* frame_num) {
+    for (size_t i = 0; i < messages.size(); ++i) {
+      TimedFrame timed_frame;
+      timed_frame.warmup = i < static_cast<size_t>(FLAGS_warmup_frames);
+      timed_frame.start = Clock::now();
+      timed_frame.frame =
+          pipeline->Process(messages[i], timed_frame.warmup ? nullptr : stats);
+      if (timed_frame.frame != nullptr) {
+        ++*frame_num;
+        queue->Enqueue(timed_frame);
+      }
+    }
+    queue->Enqueue(TimedFrame());
+  }
+
+  // fuses the frames of all sensors in the order they are done, until every
+  // sensor is
+  void RunFusion(const size_t sensor_num, FrameQueue* queue,
+                 LatencyStats* stats) {
+    size_t done_sensor_num = 0;
+    TimedFrame timed_frame;
+    while (done_sensor_num < sensor_num && queue->WaitDequeue(&timed_frame)) {
+      if (timed_frame.frame == nullptr) {
+        ++done_sensor_num;
+        continue;
+      }
+      const auto start = Clock::now();
+      std::vector<base::ObjectPtr> fused_objects;
+      if (!fusion_.Process(timed_frame.frame, &fused_objects)) {
+        AERROR << "Fusion failed.";
+        continue;
+      }
+      if (!timed_frame.warmup) {
+        stats->Add("fusion", ElapsedMs(start));
+        // from the start of the sensor stage, waiting for fusion included
+        stats->Add("end_to_end", ElapsedMs(timed_frame.start));
+      }
+    }
+  }
+
+  const Recording* recording_;
+  fusion::ObstacleMultiSensorFusion fusion_;
+  GpuUtilizationMonitor gpu_monitor_;
+};
+
+}  // namespace benchmark
+}  // namespace perception
+}  // namespace apollo
+
+int main(int argc, char** argv) {
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  apollo::perception::benchmark::Recording recording;
+  if (!apollo::perception::benchmark::LoadRecords(&recording)) {
+    return -1;
+  }
+  apollo::perception::benchmark::PerceptionPipelineBenchmark benchmark(
+      &recording);
+  if (!benchmark.Init()) {
+    AERROR << "Failed to init fusion.";
+    return -1;
+  }
+  for (const auto& scale :
+       absl::StrSplit(FLAGS_sensor_scales, ',', absl::SkipEmpty())) {
+    const int sensor_scale = std::max(std::stoi(std::string(scale)), 1);
+    if (!benchmark.Run(sensor_scale)) {
+      return -1;
+    }
+  }
+  return 0;
+}
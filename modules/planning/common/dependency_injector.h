@@ -21,6 +21,7 @@
 #include "modules/planning/common/frame.h"
 #include "modules/planning/common/history.h"
 #include "modules/planning/common/learning_based_data.h"
+#include "modules/planning/common/obstacle_cache.h"
 #include "modules/planning/common/planning_context.h"
 
 namespace apollo {
@@ -32,7 +33,9 @@ class DependencyInjector {
   ~DependencyInjector() = default;
 
   PlanningContext* planning_context() {
-    return &planning_context_;
+    PlanningContext* local_planning_context = LocalPlanningContext();
+    return local_planning_context != nullptr ? local_planning_context
+                                             : &planning_context_;
   }
   FrameHistory* frame_history() {
     return &frame_history_;
@@ -49,14 +52,40 @@ class DependencyInjector {
   LearningBasedData* learning_based_data() {
     return &learning_based_data_;
   }
+  ObstacleCache* obstacle_cache() {
+    return &obstacle_cache_;
+  }
+
+  /**
+   * @brief Redirects planning_context() to a private context on the calling
+   * thread while in scope, so that tasks planning different reference lines
+   * concurrently do not write to the shared planning status.
+   */
+  class ScopedPlanningContext {
+   public:
+    explicit ScopedPlanningContext(PlanningContext* planning_context)
+        : previous_(LocalPlanningContext()) {
+      LocalPlanningContext() = planning_context;
+    }
+    ~ScopedPlanningContext() { LocalPlanningContext() = previous_; }
+
+   private:
+    PlanningContext* previous_;
+  };
 
  private:
+  static PlanningContext*& LocalPlanningContext() {
+    static thread_local PlanningContext* local_planning_context = nullptr;
+    return local_planning_context;
+  }
+
   PlanningContext planning_context_;
   FrameHistory frame_history_;
   History history_;
   EgoInfo ego_info_;
   apollo::common::VehicleStateProvider vehicle_state_;
   LearningBasedData learning_based_data_;
+  ObstacleCache obstacle_cache_;
 };
 
 }  // namespace planning
@@ -18,6 +18,7 @@
 
 #include "absl/strings/str_cat.h"
 #include "cyber/common/file.h"
+#include "cyber/common/log.h"
 #include "modules/planning/common/planning_gflags.h"
 
 namespace apollo {
@@ -25,8 +26,18 @@ namespace planning {
 
 LearningData FeatureOutput::learning_data_;
 int FeatureOutput::learning_data_file_index_ = 0;
+std::unique_ptr<common::util::AsyncProtoWriter> FeatureOutput::writer_;
 
-void FeatureOutput::Close() { Clear(); }
+void FeatureOutput::Close() {
+  if (writer_ != nullptr) {
+    writer_->Flush();
+    if (writer_->NumFailed() > 0) {
+      AERROR << writer_->NumFailed() << " learning data files failed to write";
+    }
+    writer_.reset();
+  }
+  Clear();
+}
 
 void FeatureOutput::Clear() {
   learning_data_.Clear();
@@ -35,6 +46,9 @@ void FeatureOutput::Clear() {
 
 bool FeatureOutput::Ready() {
   Clear();
+  if (FLAGS_planning_offline_async_write && writer_ == nullptr) {
+    writer_.reset(new common::util::AsyncProtoWriter());
+  }
   return true;
 }
 
@@ -65,9 +79,13 @@ void FeatureOutput::WriteLearningData(const std::string& record_file) {
   const std::string dest_file =
       absl::StrCat(FLAGS_planning_data_dir, "/", src_file_name, ".",
                    learning_data_file_index_, ".bin");
-  cyber::common::SetProtoToBinaryFile(learning_data_, dest_file);
-  // cyber::common::SetProtoToASCIIFile(learning_data_, dest_file + ".txt");
-  learning_data_.Clear();
+  if (writer_ != nullptr) {
+    writer_->WriteAndClear(dest_file, &learning_data_);
+  } else {
+    cyber::common::SetProtoToBinaryFile(learning_data_, dest_file);
+    // cyber::common::SetProtoToASCIIFile(learning_data_, dest_file + ".txt");
+    learning_data_.Clear();
+  }
   learning_data_file_index_++;
 }
 
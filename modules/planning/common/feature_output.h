@@ -16,8 +16,10 @@
 
 #pragma once
 
+#include <memory>
 #include <string>
 
+#include "modules/common/util/async_proto_writer.h"
 #include "modules/planning/proto/learning_data.pb.h"
 
 namespace apollo {
@@ -31,7 +33,7 @@ class FeatureOutput {
   FeatureOutput() = delete;
 
   /**
-   * @brief Close the output stream
+   * @brief Close the output stream, waiting for pending writes
    */
   static void Close();
 
@@ -73,6 +75,8 @@ class FeatureOutput {
  private:
   static LearningData learning_data_;
   static int learning_data_file_index_;
+  // set when FLAGS_planning_offline_async_write is on
+  static std::unique_ptr<common::util::AsyncProtoWriter> writer_;
 };
 
 }  // namespace planning
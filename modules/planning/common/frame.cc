@@ -363,8 +363,9 @@ Status Frame::InitFrameData(
     AlignPredictionTime(vehicle_state_.timestamp(), &prediction);
     local_view_.prediction_obstacles->CopyFrom(prediction);
   }
-  for (auto &ptr :
-       Obstacle::CreateObstacles(*local_view_.prediction_obstacles)) {
+  for (auto &ptr : Obstacle::CreateObstacles(
+           *local_view_.prediction_obstacles,
+           FLAGS_enable_obstacle_cache ? obstacle_cache_ : nullptr)) {
     AddObstacle(*ptr);
   }
   if (planning_start_point_.v() < 1e-3) {
@@ -38,6 +38,7 @@
 #include "modules/planning/common/indexed_queue.h"
 #include "modules/planning/common/local_view.h"
 #include "modules/planning/common/obstacle.h"
+#include "modules/planning/common/obstacle_cache.h"
 #include "modules/planning/common/open_space_info.h"
 #include "modules/planning/common/reference_line_info.h"
 #include "modules/planning/common/trajectory/publishable_trajectory.h"
@@ -168,6 +169,14 @@ class Frame {
     return &obstacles_;
   }
 
+  /**
+   * @brief Reuse the obstacle geometry of the previous frames from
+   * obstacle_cache in Init(), if FLAGS_enable_obstacle_cache is set.
+   */
+  void set_obstacle_cache(ObstacleCache *obstacle_cache) {
+    obstacle_cache_ = obstacle_cache;
+  }
+
   const OpenSpaceInfo &open_space_info() const {
     return open_space_info_;
   }
@@ -228,6 +237,7 @@ class Frame {
   const ReferenceLineInfo *drive_reference_line_info_ = nullptr;
 
   ThreadSafeIndexedObstacles obstacles_;
+  ObstacleCache *obstacle_cache_ = nullptr;
 
   std::unordered_map<std::string, const perception::TrafficLight *>
       traffic_lights_;
@@ -91,7 +91,7 @@ bool MessageProcess::Init(const PlanningConfig& planning_config,
 }
 
 void MessageProcess::Close() {
-  FeatureOutput::Clear();
+  FeatureOutput::Close();
 
   if (FLAGS_planning_offline_learning) {
     // offline process logging
@@ -28,6 +28,7 @@
 #include "modules/common/math/linear_interpolation.h"
 #include "modules/common/util/map_util.h"
 #include "modules/common/util/util.h"
+#include "modules/planning/common/obstacle_cache.h"
 #include "modules/planning/common/planning_gflags.h"
 #include "modules/planning/common/speed/st_boundary.h"
 
@@ -63,19 +64,57 @@ Obstacle::Obstacle(const std::string& id,
                    const PerceptionObstacle& perception_obstacle,
                    const ObstaclePriority::Priority& obstacle_priority,
                    const bool is_static)
+    : Obstacle(id, perception_obstacle, prediction::Trajectory(),
+               obstacle_priority, is_static) {}
+
+Obstacle::Obstacle(const std::string& id,
+                   const PerceptionObstacle& perception_obstacle,
+                   const prediction::Trajectory& trajectory,
+                   const ObstaclePriority::Priority& obstacle_priority,
+                   const bool is_static)
+    : Obstacle(id, perception_obstacle, trajectory, obstacle_priority,
+               is_static,
+               ComputeGeometry(id, perception_obstacle, trajectory)) {}
+
+Obstacle::Obstacle(const std::string& id,
+                   const PerceptionObstacle& perception_obstacle,
+                   const prediction::Trajectory& trajectory,
+                   const ObstaclePriority::Priority& obstacle_priority,
+                   const bool is_static, const Geometry& geometry)
     : id_(id),
       perception_id_(perception_obstacle.id()),
+      trajectory_(trajectory),
       perception_obstacle_(perception_obstacle),
-      perception_bounding_box_({perception_obstacle_.position().x(),
-                                perception_obstacle_.position().y()},
-                               perception_obstacle_.theta(),
-                               perception_obstacle_.length(),
-                               perception_obstacle_.width()) {
+      perception_bounding_box_(geometry.perception_bounding_box),
+      perception_polygon_(geometry.perception_polygon),
+      trajectory_point_boxes_(geometry.trajectory_point_boxes) {
+  auto& trajectory_points = *trajectory_.mutable_trajectory_point();
+  ACHECK(static_cast<size_t>(trajectory_points.size()) ==
+         geometry.trajectory_s.size())
+      << "object[" << id << "] geometry does not match its trajectory.";
+  for (int i = 0; i < trajectory_points.size(); ++i) {
+    trajectory_points[i].mutable_path_point()->set_s(geometry.trajectory_s[i]);
+  }
+
   is_caution_level_obstacle_ = (obstacle_priority == ObstaclePriority::CAUTION);
+  is_static_ = (is_static || obstacle_priority == ObstaclePriority::IGNORE);
+  is_virtual_ = (perception_obstacle.id() < 0);
+  speed_ = std::hypot(perception_obstacle.velocity().x(),
+                      perception_obstacle.velocity().y());
+}
+
+Obstacle::Geometry Obstacle::ComputeGeometry(
+    const std::string& id, const PerceptionObstacle& perception_obstacle,
+    const prediction::Trajectory& trajectory) {
+  Geometry geometry;
+  geometry.perception_bounding_box = common::math::Box2d(
+      {perception_obstacle.position().x(), perception_obstacle.position().y()},
+      perception_obstacle.theta(), perception_obstacle.length(),
+      perception_obstacle.width());
   std::vector<common::math::Vec2d> polygon_points;
   if (FLAGS_use_navigation_mode ||
       perception_obstacle.polygon_point_size() <= 2) {
-    perception_bounding_box_.GetAllCorners(&polygon_points);
+    geometry.perception_bounding_box.GetAllCorners(&polygon_points);
   } else {
     ACHECK(perception_obstacle.polygon_point_size() > 2)
         << "object " << id << "has less than 3 polygon points";
@@ -83,41 +122,37 @@ Obstacle::Obstacle(const std::string& id,
       polygon_points.emplace_back(point.x(), point.y());
     }
   }
-  ACHECK(common::math::Polygon2d::ComputeConvexHull(polygon_points,
-                                                    &perception_polygon_))
+  ACHECK(common::math::Polygon2d::ComputeConvexHull(
+      polygon_points, &geometry.perception_polygon))
       << "object[" << id << "] polygon is not a valid convex hull.\n"
       << perception_obstacle.DebugString();
 
-  is_static_ = (is_static || obstacle_priority == ObstaclePriority::IGNORE);
-  is_virtual_ = (perception_obstacle.id() < 0);
-  speed_ = std::hypot(perception_obstacle.velocity().x(),
-                      perception_obstacle.velocity().y());
-}
-
-Obstacle::Obstacle(const std::string& id,
-                   const PerceptionObstacle& perception_obstacle,
-                   const prediction::Trajectory& trajectory,
-                   const ObstaclePriority::Priority& obstacle_priority,
-                   const bool is_static)
-    : Obstacle(id, perception_obstacle, obstacle_priority, is_static) {
-  trajectory_ = trajectory;
-  auto& trajectory_points = *trajectory_.mutable_trajectory_point();
+  const auto& trajectory_points = trajectory.trajectory_point();
+  geometry.trajectory_s.reserve(trajectory_points.size());
+  auto trajectory_point_boxes =
+      std::make_shared<std::vector<common::math::Box2d>>();
+  trajectory_point_boxes->reserve(trajectory_points.size());
   double cumulative_s = 0.0;
-  if (trajectory_points.size() > 0) {
-    trajectory_points[0].mutable_path_point()->set_s(0.0);
-  }
-  for (int i = 1; i < trajectory_points.size(); ++i) {
-    const auto& prev = trajectory_points[i - 1];
+  for (int i = 0; i < trajectory_points.size(); ++i) {
     const auto& cur = trajectory_points[i];
-    if (prev.relative_time() >= cur.relative_time()) {
-      AERROR << "prediction time is not increasing."
-             << "current point: " << cur.ShortDebugString()
-             << "previous point: " << prev.ShortDebugString();
+    if (i > 0) {
+      const auto& prev = trajectory_points[i - 1];
+      if (prev.relative_time() >= cur.relative_time()) {
+        AERROR << "prediction time is not increasing."
+               << "current point: " << cur.ShortDebugString()
+               << "previous point: " << prev.ShortDebugString();
+      }
+      cumulative_s +=
+          common::util::DistanceXY(prev.path_point(), cur.path_point());
     }
-    cumulative_s +=
-        common::util::DistanceXY(prev.path_point(), cur.path_point());
-    trajectory_points[i].mutable_path_point()->set_s(cumulative_s);
+    geometry.trajectory_s.push_back(cumulative_s);
+    trajectory_point_boxes->emplace_back(
+        common::math::Vec2d(cur.path_point().x(), cur.path_point().y()),
+        cur.path_point().theta(), perception_obstacle.length(),
+        perception_obstacle.width());
   }
+  geometry.trajectory_point_boxes = std::move(trajectory_point_boxes);
+  return geometry;
 }
 
 common::TrajectoryPoint Obstacle::GetPointAtTime(
@@ -163,6 +198,15 @@ common::math::Box2d Obstacle::GetBoundingBox(
                              perception_obstacle_.width());
 }
 
+common::math::Box2d Obstacle::GetTrajectoryPointBoundingBox(
+    const int index) const {
+  if (trajectory_point_boxes_ != nullptr &&
+      index < static_cast<int>(trajectory_point_boxes_->size())) {
+    return (*trajectory_point_boxes_)[index];
+  }
+  return GetBoundingBox(trajectory_.trajectory_point(index));
+}
+
 bool Obstacle::IsValidPerceptionObstacle(const PerceptionObstacle& obstacle) {
   if (obstacle.length() <= 0.0) {
     AERROR << "invalid obstacle length:" << obstacle.length();
@@ -194,7 +238,24 @@ bool Obstacle::IsValidPerceptionObstacle(const PerceptionObstacle& obstacle) {
 }
 
 std::list<std::unique_ptr<Obstacle>> Obstacle::CreateObstacles(
-    const prediction::PredictionObstacles& predictions) {
+    const prediction::PredictionObstacles& predictions,
+    ObstacleCache* obstacle_cache) {
+  auto create_obstacle = [obstacle_cache](
+                             const std::string& id,
+                             const PerceptionObstacle& perception_obstacle,
+                             const prediction::Trajectory& trajectory,
+                             const ObstaclePriority::Priority& priority,
+                             const bool is_static) {
+    if (obstacle_cache == nullptr) {
+      return new Obstacle(id, perception_obstacle, trajectory, priority,
+                          is_static);
+    }
+    const auto geometry =
+        obstacle_cache->GetGeometry(id, perception_obstacle, trajectory);
+    return new Obstacle(id, perception_obstacle, trajectory, priority,
+                        is_static, *geometry);
+  };
+
   std::list<std::unique_ptr<Obstacle>> obstacles;
   for (const auto& prediction_obstacle : predictions.prediction_obstacle()) {
     if (!IsValidPerceptionObstacle(prediction_obstacle.perception_obstacle())) {
@@ -205,10 +266,10 @@ std::list<std::unique_ptr<Obstacle>> Obstacle::CreateObstacles(
     const auto perception_id =
         std::to_string(prediction_obstacle.perception_obstacle().id());
     if (prediction_obstacle.trajectory().empty()) {
-      obstacles.emplace_back(
-          new Obstacle(perception_id, prediction_obstacle.perception_obstacle(),
-                       prediction_obstacle.priority().priority(),
-                       prediction_obstacle.is_static()));
+      obstacles.emplace_back(create_obstacle(
+          perception_id, prediction_obstacle.perception_obstacle(),
+          prediction::Trajectory(), prediction_obstacle.priority().priority(),
+          prediction_obstacle.is_static()));
       continue;
     }
 
@@ -230,13 +291,16 @@ std::list<std::unique_ptr<Obstacle>> Obstacle::CreateObstacles(
 
       const std::string obstacle_id =
           absl::StrCat(perception_id, "_", trajectory_index);
-      obstacles.emplace_back(
-          new Obstacle(obstacle_id, prediction_obstacle.perception_obstacle(),
-                       trajectory, prediction_obstacle.priority().priority(),
-                       prediction_obstacle.is_static()));
+      obstacles.emplace_back(create_obstacle(
+          obstacle_id, prediction_obstacle.perception_obstacle(), trajectory,
+          prediction_obstacle.priority().priority(),
+          prediction_obstacle.is_static()));
       ++trajectory_index;
     }
   }
+  if (obstacle_cache != nullptr) {
+    obstacle_cache->EvictUnused();
+  }
   return obstacles;
 }
 
@@ -57,8 +57,24 @@ namespace planning {
  * Ignore decision belongs to both lateral decision and longitudinal decision,
  * and it has the lowest priority.
  */
+class ObstacleCache;
+
 class Obstacle {
  public:
+  /**
+   * @brief The geometry derived from the perception shape and the predicted
+   * path of an obstacle. It is shared by the obstacles of consecutive frames
+   * as long as both stay the same, see ObstacleCache.
+   */
+  struct Geometry {
+    common::math::Box2d perception_bounding_box;
+    common::math::Polygon2d perception_polygon;
+    // the accumulated s of the trajectory points
+    std::vector<double> trajectory_s;
+    std::shared_ptr<const std::vector<common::math::Box2d>>
+        trajectory_point_boxes;
+  };
+
   Obstacle() = default;
   Obstacle(const std::string& id,
            const perception::PerceptionObstacle& perception_obstacle,
@@ -69,6 +85,16 @@ class Obstacle {
            const prediction::Trajectory& trajectory,
            const prediction::ObstaclePriority::Priority& obstacle_priority,
            const bool is_static);
+  Obstacle(const std::string& id,
+           const perception::PerceptionObstacle& perception_obstacle,
+           const prediction::Trajectory& trajectory,
+           const prediction::ObstaclePriority::Priority& obstacle_priority,
+           const bool is_static, const Geometry& geometry);
+
+  static Geometry ComputeGeometry(
+      const std::string& id,
+      const perception::PerceptionObstacle& perception_obstacle,
+      const prediction::Trajectory& trajectory);
 
   const std::string& Id() const { return id_; }
   void SetId(const std::string& id) { id_ = id; }
@@ -85,6 +111,12 @@ class Obstacle {
   common::math::Box2d GetBoundingBox(
       const common::TrajectoryPoint& point) const;
 
+  /**
+   * @brief The bounding box at the index-th point of Trajectory(), which is
+   * computed once when the obstacle is created.
+   */
+  common::math::Box2d GetTrajectoryPointBoundingBox(const int index) const;
+
   const common::math::Box2d& PerceptionBoundingBox() const {
     return perception_bounding_box_;
   }
@@ -93,6 +125,7 @@ class Obstacle {
   }
   const prediction::Trajectory& Trajectory() const { return trajectory_; }
   common::TrajectoryPoint* AddTrajectoryPoint() {
+    trajectory_point_boxes_.reset();
     return trajectory_.add_trajectory_point();
   }
   bool HasTrajectory() const {
@@ -108,10 +141,13 @@ class Obstacle {
    * data.  The original prediction may have multiple trajectories for each
    * obstacle. But this function will create one obstacle for each trajectory.
    * @param predictions The prediction results
+   * @param obstacle_cache If not null, the geometry of the obstacles whose
+   * shape and path did not change since the last call is reused from it.
    * @return obstacles The output obstacles saved in a list of unique_ptr.
    */
   static std::list<std::unique_ptr<Obstacle>> CreateObstacles(
-      const prediction::PredictionObstacles& predictions);
+      const prediction::PredictionObstacles& predictions,
+      ObstacleCache* obstacle_cache = nullptr);
 
   static std::unique_ptr<Obstacle> CreateStaticVirtualObstacles(
       const std::string& id, const common::math::Box2d& obstacle_box);
@@ -247,6 +283,8 @@ class Obstacle {
   perception::PerceptionObstacle perception_obstacle_;
   common::math::Box2d perception_bounding_box_;
   common::math::Polygon2d perception_polygon_;
+  std::shared_ptr<const std::vector<common::math::Box2d>>
+      trajectory_point_boxes_;
 
   std::vector<ObjectDecisionType> decisions_;
   std::vector<std::string> decider_tags_;
@@ -0,0 +1,109 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/common/obstacle_cache.h"
+
+#include <utility>
+
+#include "modules/planning/common/planning_gflags.h"
+
+namespace apollo {
+namespace planning {
+
+std::shared_ptr<const Obstacle::Geometry> ObstacleCache::GetGeometry(
+    const std::string& id,
+    const perception::PerceptionObstacle& perception_obstacle,
+    const prediction::Trajectory& trajectory) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  BuildKey(perception_obstacle, trajectory, &key_);
+  auto& entry = entries_[id];
+  entry.is_used = true;
+  if (entry.geometry != nullptr && entry.key == key_) {
+    ++hit_count_;
+    return entry.geometry;
+  }
+  ++miss_count_;
+  entry.key.swap(key_);
+  entry.geometry = std::make_shared<const Obstacle::Geometry>(
+      Obstacle::ComputeGeometry(id, perception_obstacle, trajectory));
+  return entry.geometry;
+}
+
+void ObstacleCache::EvictUnused() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto iter = entries_.begin(); iter != entries_.end();) {
+    if (!iter->second.is_used) {
+      iter = entries_.erase(iter);
+    } else {
+      iter->second.is_used = false;
+      ++iter;
+    }
+  }
+}
+
+void ObstacleCache::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_.clear();
+  hit_count_ = 0;
+  miss_count_ = 0;
+}
+
+size_t ObstacleCache::size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return entries_.size();
+}
+
+int64_t ObstacleCache::hit_count() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return hit_count_;
+}
+
+int64_t ObstacleCache::miss_count() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return miss_count_;
+}
+
+void ObstacleCache::BuildKey(
+    const perception::PerceptionObstacle& perception_obstacle,
+    const prediction::Trajectory& trajectory, std::vector<double>* key) {
+  key->clear();
+  key->reserve(7 + 2 * perception_obstacle.polygon_point_size() +
+               3 * trajectory.trajectory_point_size());
+  // the polygon is built from the bounding box in navigation mode
+  key->push_back(FLAGS_use_navigation_mode ? 1.0 : 0.0);
+  key->push_back(perception_obstacle.position().x());
+  key->push_back(perception_obstacle.position().y());
+  key->push_back(perception_obstacle.theta());
+  key->push_back(perception_obstacle.length());
+  key->push_back(perception_obstacle.width());
+  key->push_back(perception_obstacle.polygon_point_size());
+  for (const auto& point : perception_obstacle.polygon_point()) {
+    key->push_back(point.x());
+    key->push_back(point.y());
+  }
+  for (const auto& point : trajectory.trajectory_point()) {
+    key->push_back(point.path_point().x());
+    key->push_back(point.path_point().y());
+    key->push_back(point.path_point().theta());
+  }
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -0,0 +1,82 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "modules/planning/common/obstacle.h"
+
+namespace apollo {
+namespace planning {
+
+/**
+ * @class ObstacleCache
+ *
+ * @brief ObstacleCache keeps the geometry of the obstacles of the last frame
+ * by obstacle id, so that the convex hull and the trajectory point boxes are
+ * only computed again for obstacles whose perception shape or predicted path
+ * changed. Only the inputs of the geometry are compared, and they have to be
+ * exactly equal for the geometry to be reused.
+ */
+class ObstacleCache {
+ public:
+  ObstacleCache() = default;
+
+  std::shared_ptr<const Obstacle::Geometry> GetGeometry(
+      const std::string& id,
+      const perception::PerceptionObstacle& perception_obstacle,
+      const prediction::Trajectory& trajectory);
+
+  /**
+   * @brief Drops the obstacles that were not requested since the last call.
+   */
+  void EvictUnused();
+
+  void Clear();
+
+  size_t size() const;
+  int64_t hit_count() const;
+  int64_t miss_count() const;
+
+ private:
+  struct Entry {
+    std::vector<double> key;
+    std::shared_ptr<const Obstacle::Geometry> geometry;
+    bool is_used = false;
+  };
+
+  static void BuildKey(
+      const perception::PerceptionObstacle& perception_obstacle,
+      const prediction::Trajectory& trajectory, std::vector<double>* key);
+
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string, Entry> entries_;
+  std::vector<double> key_;
+  int64_t hit_count_ = 0;
+  int64_t miss_count_ = 0;
+};
+
+}  // namespace planning
+}  // namespace apollo
@@ -0,0 +1,120 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/*
+ * @file
+ * Times Obstacle::CreateObstacles() with and without an ObstacleCache on a
+ * static scene of obstacles, followed by one pass over the bounding boxes of
+ * all trajectory points as the st boundary mapper does.
+ *
+ *   obstacle_cache_benchmark [num_obstacles] [iterations]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+#include "modules/planning/common/obstacle_cache.h"
+
+namespace apollo {
+namespace planning {
+
+prediction::PredictionObstacles Scene(const int num_obstacles) {
+  prediction::PredictionObstacles predictions;
+  for (int i = 0; i < num_obstacles; ++i) {
+    auto* prediction_obstacle = predictions.add_prediction_obstacle();
+    auto* perception_obstacle =
+        prediction_obstacle->mutable_perception_obstacle();
+    perception_obstacle->set_id(i);
+    perception_obstacle->mutable_position()->set_x(5.0 * i);
+    perception_obstacle->mutable_position()->set_y(3.5 * (i % 3));
+    perception_obstacle->set_theta(0.1 * i);
+    perception_obstacle->set_length(4.5);
+    perception_obstacle->set_width(1.8);
+    perception_obstacle->set_height(1.5);
+    for (int k = 0; k < 16; ++k) {
+      const double angle = 2.0 * M_PI * k / 16;
+      auto* point = perception_obstacle->add_polygon_point();
+      point->set_x(5.0 * i + 2.0 * std::cos(angle));
+      point->set_y(3.5 * (i % 3) + std::sin(angle));
+    }
+    for (int j = 0; j < 2; ++j) {
+      auto* trajectory = prediction_obstacle->add_trajectory();
+      for (int k = 0; k < 80; ++k) {
+        auto* point = trajectory->add_trajectory_point();
+        point->mutable_path_point()->set_x(5.0 * i + 0.5 * k);
+        point->mutable_path_point()->set_y(3.5 * (i % 3) + 0.02 * j * k);
+        point->mutable_path_point()->set_theta(0.02 * j);
+        point->set_v(5.0);
+        point->set_relative_time(0.1 * k);
+      }
+    }
+  }
+  return predictions;
+}
+
+double Cycle(const prediction::PredictionObstacles& predictions,
+             ObstacleCache* obstacle_cache) {
+  double sum = 0.0;
+  for (const auto& obstacle :
+       Obstacle::CreateObstacles(predictions, obstacle_cache)) {
+    for (int i = 0; i < obstacle->Trajectory().trajectory_point_size(); ++i) {
+      sum += obstacle->GetTrajectoryPointBoundingBox(i).max_x();
+    }
+  }
+  return sum;
+}
+
+int Run(const int num_obstacles, const int iterations) {
+  const auto predictions = Scene(num_obstacles);
+  ObstacleCache obstacle_cache;
+  std::printf("%-12s %10s %10s %10s\n", "mode", "mean(ms)", "min(ms)",
+              "max(ms)");
+  for (ObstacleCache* cache : {static_cast<ObstacleCache*>(nullptr),
+                               &obstacle_cache}) {
+    double total = 0.0;
+    double min = 1e9;
+    double max = 0.0;
+    double checksum = 0.0;
+    for (int i = 0; i < iterations; ++i) {
+      auto start = std::chrono::steady_clock::now();
+      checksum += Cycle(predictions, cache);
+      std::chrono::duration<double, std::milli> elapsed =
+          std::chrono::steady_clock::now() - start;
+      total += elapsed.count();
+      min = std::min(min, elapsed.count());
+      max = std::max(max, elapsed.count());
+    }
+    std::printf("%-12s %10.3f %10.3f %10.3f (checksum %g)\n",
+                cache == nullptr ? "uncached" : "cached", total / iterations,
+                min, max, checksum);
+  }
+  std::printf("cache hits %ld, misses %ld\n",
+              static_cast<long>(obstacle_cache.hit_count()),
+              static_cast<long>(obstacle_cache.miss_count()));
+  return 0;
+}
+
+}  // namespace planning
+}  // namespace apollo
+
+int main(int argc, char** argv) {
+  int num_obstacles = argc > 1 ? std::max(std::atoi(argv[1]), 1) : 50;
+  int iterations = argc > 2 ? std::max(std::atoi(argv[2]), 1) : 100;
+  return apollo::planning::Run(num_obstacles, iterations);
+}
@@ -0,0 +1,144 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/common/obstacle_cache.h"
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace planning {
+
+namespace {
+
+prediction::PredictionObstacles MakePredictions(const int num_points) {
+  prediction::PredictionObstacles predictions;
+  auto* prediction_obstacle = predictions.add_prediction_obstacle();
+  auto* perception_obstacle =
+      prediction_obstacle->mutable_perception_obstacle();
+  perception_obstacle->set_id(7);
+  perception_obstacle->mutable_position()->set_x(10.0);
+  perception_obstacle->mutable_position()->set_y(2.0);
+  perception_obstacle->mutable_velocity()->set_x(5.0);
+  perception_obstacle->mutable_velocity()->set_y(0.0);
+  perception_obstacle->set_theta(0.0);
+  perception_obstacle->set_length(4.0);
+  perception_obstacle->set_width(2.0);
+  perception_obstacle->set_height(1.5);
+  auto* trajectory = prediction_obstacle->add_trajectory();
+  for (int i = 0; i < num_points; ++i) {
+    auto* point = trajectory->add_trajectory_point();
+    point->mutable_path_point()->set_x(10.0 + 0.5 * i);
+    point->mutable_path_point()->set_y(2.0);
+    point->mutable_path_point()->set_theta(0.0);
+    point->set_v(5.0);
+    point->set_relative_time(0.1 * i);
+  }
+  return predictions;
+}
+
+}  // namespace
+
+TEST(ObstacleCache, ReuseUnchangedGeometry) {
+  ObstacleCache obstacle_cache;
+  auto predictions = MakePredictions(10);
+  auto first = Obstacle::CreateObstacles(predictions, &obstacle_cache);
+  ASSERT_EQ(1, first.size());
+  EXPECT_EQ(0, obstacle_cache.hit_count());
+  EXPECT_EQ(1, obstacle_cache.miss_count());
+
+  // only the speed changes, which is not part of the geometry
+  predictions.mutable_prediction_obstacle(0)
+      ->mutable_trajectory(0)
+      ->mutable_trajectory_point(3)
+      ->set_v(6.0);
+  auto second = Obstacle::CreateObstacles(predictions, &obstacle_cache);
+  ASSERT_EQ(1, second.size());
+  EXPECT_EQ(1, obstacle_cache.hit_count());
+  EXPECT_DOUBLE_EQ(6.0, second.front()->Trajectory().trajectory_point(3).v());
+
+  const auto uncached = Obstacle::CreateObstacles(predictions);
+  const auto& obstacle = *second.front();
+  const auto& expected = *uncached.front();
+  EXPECT_EQ(expected.Id(), obstacle.Id());
+  EXPECT_EQ(expected.PerceptionPolygon().num_points(),
+            obstacle.PerceptionPolygon().num_points());
+  EXPECT_DOUBLE_EQ(expected.PerceptionPolygon().area(),
+                   obstacle.PerceptionPolygon().area());
+  ASSERT_EQ(10, obstacle.Trajectory().trajectory_point_size());
+  for (int i = 0; i < obstacle.Trajectory().trajectory_point_size(); ++i) {
+    EXPECT_DOUBLE_EQ(
+        expected.Trajectory().trajectory_point(i).path_point().s(),
+        obstacle.Trajectory().trajectory_point(i).path_point().s());
+    const auto box = obstacle.GetTrajectoryPointBoundingBox(i);
+    const auto expected_box =
+        expected.GetBoundingBox(expected.Trajectory().trajectory_point(i));
+    EXPECT_DOUBLE_EQ(expected_box.center_x(), box.center_x());
+    EXPECT_DOUBLE_EQ(expected_box.center_y(), box.center_y());
+    EXPECT_DOUBLE_EQ(expected_box.heading(), box.heading());
+  }
+}
+
+TEST(ObstacleCache, RecomputeChangedGeometry) {
+  ObstacleCache obstacle_cache;
+  auto predictions = MakePredictions(10);
+  Obstacle::CreateObstacles(predictions, &obstacle_cache);
+
+  predictions.mutable_prediction_obstacle(0)
+      ->mutable_trajectory(0)
+      ->mutable_trajectory_point(9)
+      ->mutable_path_point()
+      ->set_y(3.0);
+  auto obstacles = Obstacle::CreateObstacles(predictions, &obstacle_cache);
+  EXPECT_EQ(0, obstacle_cache.hit_count());
+  EXPECT_EQ(2, obstacle_cache.miss_count());
+  EXPECT_DOUBLE_EQ(
+      3.0, obstacles.front()->GetTrajectoryPointBoundingBox(9).center_y());
+
+  predictions.mutable_prediction_obstacle(0)
+      ->mutable_perception_obstacle()
+      ->set_length(5.0);
+  obstacles = Obstacle::CreateObstacles(predictions, &obstacle_cache);
+  EXPECT_EQ(3, obstacle_cache.miss_count());
+  EXPECT_DOUBLE_EQ(
+      5.0, obstacles.front()->GetTrajectoryPointBoundingBox(0).length());
+}
+
+TEST(ObstacleCache, EvictDisappearedObstacles) {
+  ObstacleCache obstacle_cache;
+  Obstacle::CreateObstacles(MakePredictions(10), &obstacle_cache);
+  EXPECT_EQ(1, obstacle_cache.size());
+
+  Obstacle::CreateObstacles(prediction::PredictionObstacles(),
+                            &obstacle_cache);
+  EXPECT_EQ(0, obstacle_cache.size());
+}
+
+TEST(ObstacleCache, AddTrajectoryPointFallsBack) {
+  auto obstacles = Obstacle::CreateObstacles(MakePredictions(2));
+  auto& obstacle = *obstacles.front();
+  auto* point = obstacle.AddTrajectoryPoint();
+  point->mutable_path_point()->set_x(20.0);
+  point->mutable_path_point()->set_y(1.0);
+  EXPECT_DOUBLE_EQ(20.0, obstacle.GetTrajectoryPointBoundingBox(2).center_x());
+  EXPECT_DOUBLE_EQ(10.5, obstacle.GetTrajectoryPointBoundingBox(1).center_x());
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -0,0 +1,135 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/common/obstacle_spatial_index.h"
+
+#include <algorithm>
+
+namespace apollo {
+namespace planning {
+
+using apollo::common::math::AABox2d;
+using apollo::common::math::AABoxKDTreeParams;
+using apollo::common::math::Box2d;
+using apollo::common::math::Vec2d;
+
+namespace {
+constexpr int kMaxLeafSize = 4;
+}  // namespace
+
+ObstacleSpatialIndex& ObstacleSpatialIndex::operator=(
+    const ObstacleSpatialIndex& other) {
+  if (this != &other) {
+    sl_kdtree_.reset();
+    xy_kdtree_.reset();
+    sl_boxes_.clear();
+    xy_boxes_.clear();
+    num_indexed_obstacles_ = 0;
+    is_stale_ = true;
+  }
+  return *this;
+}
+
+bool ObstacleSpatialIndex::IsStale(const IndexedObstacles& obstacles) const {
+  return is_stale_ || num_indexed_obstacles_ != obstacles.Items().size();
+}
+
+void ObstacleSpatialIndex::Build(const IndexedObstacles& obstacles) {
+  const auto& items = obstacles.Items();
+  sl_boxes_.clear();
+  xy_boxes_.clear();
+  sl_boxes_.reserve(items.size());
+  xy_boxes_.reserve(items.size());
+  for (size_t i = 0; i < items.size(); ++i) {
+    const auto* obstacle = items[i];
+    const auto& sl_boundary = obstacle->PerceptionSLBoundary();
+    sl_boxes_.emplace_back(
+        Box2d(AABox2d({sl_boundary.start_s(), sl_boundary.start_l()},
+                      {sl_boundary.end_s(), sl_boundary.end_l()})),
+        obstacle, i);
+    xy_boxes_.emplace_back(obstacle->PerceptionBoundingBox(), obstacle, i);
+  }
+
+  AABoxKDTreeParams params;
+  params.max_leaf_size = kMaxLeafSize;
+  sl_kdtree_.reset(new ObstacleBoxKDTree(sl_boxes_, params));
+  xy_kdtree_.reset(new ObstacleBoxKDTree(xy_boxes_, params));
+  num_indexed_obstacles_ = items.size();
+  is_stale_ = false;
+}
+
+std::vector<const Obstacle*> ObstacleSpatialIndex::GetObstaclesInSLRange(
+    const double start_s, const double end_s, const double start_l,
+    const double end_l) const {
+  if (sl_kdtree_ == nullptr) {
+    return {};
+  }
+  return ToObstacles(
+      sl_kdtree_->GetObjects(AABox2d({start_s, start_l}, {end_s, end_l})));
+}
+
+std::vector<const Obstacle*> ObstacleSpatialIndex::GetObstaclesInSRange(
+    const double start_s, const double end_s) const {
+  if (sl_kdtree_ == nullptr) {
+    return {};
+  }
+  const AABox2d sl_bound = sl_kdtree_->GetBoundingBox();
+  // clamp open ranges, e.g. from lowest(), which AABox2d can not represent
+  const double min_s = std::max(start_s, sl_bound.min_x());
+  const double max_s = std::min(end_s, sl_bound.max_x());
+  if (min_s > max_s) {
+    return {};
+  }
+  return GetObstaclesInSLRange(min_s, max_s, sl_bound.min_y(),
+                               sl_bound.max_y());
+}
+
+std::vector<const Obstacle*> ObstacleSpatialIndex::GetObstaclesInXYRange(
+    const AABox2d& box) const {
+  if (xy_kdtree_ == nullptr) {
+    return {};
+  }
+  return ToObstacles(xy_kdtree_->GetObjects(box));
+}
+
+std::vector<const Obstacle*> ObstacleSpatialIndex::GetObstaclesNearXY(
+    const Vec2d& point, const double distance) const {
+  if (xy_kdtree_ == nullptr) {
+    return {};
+  }
+  return ToObstacles(xy_kdtree_->GetObjects(point, distance));
+}
+
+std::vector<const Obstacle*> ObstacleSpatialIndex::ToObstacles(
+    std::vector<const ObstacleBox*> boxes) {
+  std::sort(boxes.begin(), boxes.end(),
+            [](const ObstacleBox* lhs, const ObstacleBox* rhs) {
+              return lhs->index() < rhs->index();
+            });
+  std::vector<const Obstacle*> obstacles;
+  obstacles.reserve(boxes.size());
+  for (const auto* box : boxes) {
+    obstacles.push_back(box->obstacle());
+  }
+  return obstacles;
+}
+
+}  // namespace planning
+}  // namespace apollo
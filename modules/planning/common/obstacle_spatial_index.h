@@ -0,0 +1,136 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "modules/common/math/aabox2d.h"
+#include "modules/common/math/aaboxkdtree2d.h"
+#include "modules/common/math/box2d.h"
+#include "modules/common/math/vec2d.h"
+#include "modules/planning/common/obstacle.h"
+
+namespace apollo {
+namespace planning {
+
+/**
+ * @class ObstacleSpatialIndex
+ *
+ * @brief ObstacleSpatialIndex answers range queries over the obstacles of one
+ * path decision, in the SL frame of its reference line and in the XY frame.
+ * Every query returns obstacles in the order of IndexedObstacles::Items(), so
+ * callers see the same order as when they iterate over all obstacles.
+ */
+class ObstacleSpatialIndex {
+ public:
+  ObstacleSpatialIndex() = default;
+
+  /**
+   * @brief The indexed pointers belong to the obstacles of the source, so a
+   * copy starts out stale and is rebuilt against its own obstacles.
+   */
+  ObstacleSpatialIndex(const ObstacleSpatialIndex& other) {}
+  ObstacleSpatialIndex& operator=(const ObstacleSpatialIndex& other);
+
+  /**
+   * @brief Mark the index stale, e.g. when an obstacle is overwritten.
+   */
+  void Invalidate() { is_stale_ = true; }
+
+  bool IsStale(const IndexedObstacles& obstacles) const;
+
+  /**
+   * @brief Build the index over the perception SL boundaries and perception
+   * bounding boxes of the obstacles.
+   */
+  void Build(const IndexedObstacles& obstacles);
+
+  /**
+   * @brief Get the obstacles whose perception SL boundaries overlap the
+   * range [start_s, end_s] x [start_l, end_l].
+   */
+  std::vector<const Obstacle*> GetObstaclesInSLRange(
+      const double start_s, const double end_s, const double start_l,
+      const double end_l) const;
+
+  /**
+   * @brief Get the obstacles whose perception SL boundaries overlap the
+   * range [start_s, end_s], at any l. Either end may be open, e.g.
+   * std::numeric_limits<double>::lowest().
+   */
+  std::vector<const Obstacle*> GetObstaclesInSRange(const double start_s,
+                                                    const double end_s) const;
+
+  /**
+   * @brief Get the obstacles whose perception bounding boxes overlap the box.
+   */
+  std::vector<const Obstacle*> GetObstaclesInXYRange(
+      const common::math::AABox2d& box) const;
+
+  /**
+   * @brief Get the obstacles whose perception bounding boxes are within the
+   * distance to the point.
+   */
+  std::vector<const Obstacle*> GetObstaclesNearXY(
+      const common::math::Vec2d& point, const double distance) const;
+
+ private:
+  class ObstacleBox {
+   public:
+    ObstacleBox(const common::math::Box2d& box, const Obstacle* obstacle,
+                const size_t index)
+        : box_(box), aabox_(box.GetAABox()), obstacle_(obstacle),
+          index_(index) {}
+    const common::math::AABox2d& aabox() const { return aabox_; }
+    double DistanceTo(const common::math::Vec2d& point) const {
+      return box_.DistanceTo(point);
+    }
+    double DistanceSquareTo(const common::math::Vec2d& point) const {
+      const double distance = box_.DistanceTo(point);
+      return distance * distance;
+    }
+    const Obstacle* obstacle() const { return obstacle_; }
+    size_t index() const { return index_; }
+
+   private:
+    common::math::Box2d box_;
+    common::math::AABox2d aabox_;
+    const Obstacle* obstacle_;
+    size_t index_;
+  };
+  using ObstacleBoxKDTree = common::math::AABoxKDTree2d<ObstacleBox>;
+
+  static std::vector<const Obstacle*> ToObstacles(
+      std::vector<const ObstacleBox*> boxes);
+
+ private:
+  std::vector<ObstacleBox> sl_boxes_;
+  std::vector<ObstacleBox> xy_boxes_;
+  std::unique_ptr<ObstacleBoxKDTree> sl_kdtree_;
+  std::unique_ptr<ObstacleBoxKDTree> xy_kdtree_;
+  size_t num_indexed_obstacles_ = 0;
+  std::atomic<bool> is_stale_{true};
+};
+
+}  // namespace planning
+}  // namespace apollo
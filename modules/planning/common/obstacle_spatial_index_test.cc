@@ -0,0 +1,115 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/common/obstacle_spatial_index.h"
+
+#include <limits>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace planning {
+
+using apollo::common::math::AABox2d;
+using apollo::common::math::Box2d;
+using apollo::common::math::Vec2d;
+
+class ObstacleSpatialIndexTest : public ::testing::Test {
+ public:
+  virtual void SetUp() {
+    // Obstacle i occupies x in [10 * i, 10 * i + 4] and y in [-1, 1], and is
+    // projected to the same range in the SL frame.
+    for (int i = 0; i < 10; ++i) {
+      const std::string id = std::to_string(i);
+      const Box2d box(Vec2d(10.0 * i + 2.0, 0.0), 0.0, 4.0, 2.0);
+      auto obstacle = Obstacle::CreateStaticVirtualObstacles(id, box);
+      auto* added = obstacles_.Add(id, *obstacle);
+      SLBoundary sl_boundary;
+      sl_boundary.set_start_s(10.0 * i);
+      sl_boundary.set_end_s(10.0 * i + 4.0);
+      sl_boundary.set_start_l(-1.0);
+      sl_boundary.set_end_l(1.0);
+      added->SetPerceptionSlBoundary(sl_boundary);
+    }
+  }
+
+ protected:
+  IndexedObstacles obstacles_;
+};
+
+TEST_F(ObstacleSpatialIndexTest, GetObstaclesInSLRange) {
+  ObstacleSpatialIndex index;
+  EXPECT_TRUE(index.IsStale(obstacles_));
+  EXPECT_TRUE(index.GetObstaclesInSLRange(0.0, 100.0, -1.0, 1.0).empty());
+
+  index.Build(obstacles_);
+  EXPECT_FALSE(index.IsStale(obstacles_));
+
+  const auto result = index.GetObstaclesInSLRange(15.0, 42.0, -0.5, 0.5);
+  ASSERT_EQ(3, result.size());
+  EXPECT_EQ("2", result[0]->Id());
+  EXPECT_EQ("3", result[1]->Id());
+  EXPECT_EQ("4", result[2]->Id());
+
+  EXPECT_TRUE(index.GetObstaclesInSLRange(15.0, 42.0, 2.0, 3.0).empty());
+  EXPECT_EQ(3, index.GetObstaclesInSRange(15.0, 42.0).size());
+  EXPECT_EQ(5, index.GetObstaclesInSRange(
+                   std::numeric_limits<double>::lowest(), 42.0)
+                   .size());
+  EXPECT_EQ(10, index.GetObstaclesInSLRange(-10.0, 200.0, -5.0, 5.0).size());
+}
+
+TEST_F(ObstacleSpatialIndexTest, GetObstaclesInXYRange) {
+  ObstacleSpatialIndex index;
+  index.Build(obstacles_);
+
+  const auto in_box =
+      index.GetObstaclesInXYRange(AABox2d({5.0, 0.5}, {25.0, 3.0}));
+  ASSERT_EQ(2, in_box.size());
+  EXPECT_EQ("1", in_box[0]->Id());
+  EXPECT_EQ("2", in_box[1]->Id());
+
+  const auto near = index.GetObstaclesNearXY(Vec2d(37.0, 0.0), 3.5);
+  ASSERT_EQ(2, near.size());
+  EXPECT_EQ("3", near[0]->Id());
+  EXPECT_EQ("4", near[1]->Id());
+}
+
+TEST_F(ObstacleSpatialIndexTest, Stale) {
+  ObstacleSpatialIndex index;
+  index.Build(obstacles_);
+
+  const Box2d box(Vec2d(200.0, 0.0), 0.0, 4.0, 2.0);
+  auto obstacle = Obstacle::CreateStaticVirtualObstacles("10", box);
+  obstacles_.Add("10", *obstacle);
+  EXPECT_TRUE(index.IsStale(obstacles_));
+
+  index.Build(obstacles_);
+  EXPECT_FALSE(index.IsStale(obstacles_));
+  index.Invalidate();
+  EXPECT_TRUE(index.IsStale(obstacles_));
+
+  ObstacleSpatialIndex copy(index);
+  EXPECT_TRUE(copy.IsStale(obstacles_));
+  EXPECT_TRUE(copy.GetObstaclesNearXY(Vec2d(200.0, 0.0), 1.0).empty());
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -116,6 +116,11 @@ DEFINE_bool(enable_scenario_traffic_light, true,
 DEFINE_bool(enable_scenario_yield_sign, true,
             "enable yield_sign scenarios in planning");
 
+DEFINE_bool(enable_scenario_event_horizon, false,
+            "Skip the intersection scenario selectors while no intersection "
+            "overlap is within their start distances, and cache the lane "
+            "checks of the pull over scenario selector.");
+
 DEFINE_bool(enable_force_pull_over_open_space_parking_test, false,
             "enable force_pull_over_open_space_parking_test");
 
@@ -148,6 +153,12 @@ DEFINE_double(look_forward_extend_distance, 50,
 DEFINE_double(reference_line_stitch_overlap_distance, 20,
               "The overlap distance with the existing reference line when "
               "stitching the existing reference line");
+DEFINE_bool(enable_reference_line_segment_cache, false,
+            "Reuse the smoothed reference lines of recent cycles, keyed by "
+            "their lane segments, instead of smoothing them again");
+DEFINE_int32(reference_line_segment_cache_cycles, 10,
+             "The number of cycles an unused smoothed reference line stays in "
+             "the segment cache");
 
 DEFINE_bool(enable_smooth_reference_line, true,
             "enable smooth the map reference line");
@@ -283,6 +294,9 @@ DEFINE_int32(long_term_blocking_obstacle_cycle_threshold, 3,
 DEFINE_double(prediction_total_time, 5.0, "Total prediction time");
 DEFINE_bool(align_prediction_time, false,
             "enable align prediction data based planning time");
+DEFINE_bool(enable_obstacle_cache, true,
+            "True to reuse the polygon and the trajectory point boxes of an "
+            "obstacle across frames while its shape and path do not change");
 
 // Trajectory
 
@@ -318,8 +332,26 @@ DEFINE_bool(enable_sqp_solver, true, "True to enable SQP solver.");
 /// thread pool
 DEFINE_bool(use_multi_thread_to_add_obstacles, false,
             "use multiple thread to add obstacles.");
+DEFINE_bool(enable_obstacle_spatial_index, false,
+            "Query obstacles through the per reference line spatial index "
+            "instead of scanning all of them in deciders.");
+DEFINE_bool(enable_traffic_rule_index, false,
+            "Index the map overlaps once per reference line and let traffic "
+            "rules visit only the overlaps and obstacles near them.");
 DEFINE_bool(enable_multi_thread_in_dp_st_graph, false,
             "Enable multiple thread to calculation curve cost in dp_st_graph.");
+DEFINE_bool(enable_dp_st_graph_column_kernel, false,
+            "Evaluate dp_st_graph costs a column at a time with vectorizable "
+            "kernels; takes precedence over "
+            "enable_multi_thread_in_dp_st_graph.");
+DEFINE_bool(enable_multi_thread_in_lattice_evaluation, false,
+            "Enable multiple thread to evaluate lattice trajectory pairs.");
+DEFINE_bool(enable_multi_thread_in_reference_line_planning, false,
+            "Enable multiple thread to run the lane follow task pipeline on "
+            "each reference line candidate.");
+DEFINE_bool(enable_multi_thread_in_path_candidates, false,
+            "Enable multiple thread to generate, optimize and assess the "
+            "path candidates of each path boundary.");
 
 /// Lattice Planner
 DEFINE_double(numerical_epsilon, 1e-6, "Epsilon in lattice planner.");
@@ -342,6 +374,9 @@ DEFINE_double(lon_collision_buffer, 2.0,
               "The longitudinal buffer to keep distance to other vehicles");
 DEFINE_double(lat_collision_buffer, 0.1,
               "The lateral buffer to keep distance to other vehicles");
+DEFINE_double(collision_grid_cell_size, 10.0,
+              "The cell size of the grid the lattice collision checker "
+              "buckets the predicted obstacle boxes in");
 DEFINE_uint64(num_sample_follow_per_timestamp, 3,
               "The number of sample points for each timestamp to follow");
 
@@ -379,6 +414,11 @@ DEFINE_double(polynomial_minimal_param, 0.01,
               "Minimal time parameter in polynomials.");
 DEFINE_double(lattice_stop_buffer, 0.02,
               "The buffer before the stop s to check trajectories.");
+DEFINE_bool(enable_lazy_lattice_trajectory_evaluation, false,
+            "Only compute the lateral costs of a lattice trajectory pair "
+            "when its longitudinal cost bound can beat the current best.");
+DEFINE_int32(lattice_trajectory_evaluation_batch_size, 16,
+             "Number of lattice trajectory pairs evaluated per batch.");
 
 DEFINE_bool(lateral_optimization, true,
             "whether using optimization for lateral trajectory generation");
@@ -443,6 +483,10 @@ DEFINE_bool(enable_perception_obstacles, true,
 DEFINE_bool(enable_open_space_planner_thread, true,
             "Enable thread in open space planner for trajectory publish.");
 
+DEFINE_bool(enable_open_space_roi_cache, false,
+            "Reuse the map boundary of the open space roi and its hyperplanes "
+            "while the target parking spot is unchanged.");
+
 DEFINE_bool(use_dual_variable_warm_start, true,
             "whether or not enable dual variable warm start ");
 
@@ -469,12 +513,29 @@ DEFINE_bool(
     enable_parallel_trajectory_smoothing, false,
     "Whether to partition the trajectory first and do smoothing in parallel");
 
+DEFINE_bool(use_banded_fem_pos_deviation_solver, false,
+            "Whether to solve the fem_pos_deviation qp with the banded admm "
+            "solver instead of osqp");
+
 DEFINE_bool(enable_osqp_debug, false,
             "True to turn on OSQP verbose debug output in log.");
+DEFINE_bool(enable_persistent_osqp_workspace, false,
+            "True to keep the piecewise jerk OSQP workspaces across planning "
+            "cycles and warm start them from the previous solution.");
 
 DEFINE_bool(export_chart, false, "export chart in planning");
 DEFINE_bool(enable_record_debug, true,
             "True to enable record debug info in chart format");
+DEFINE_bool(enable_planning_profiler, false,
+            "True to profile every planning cycle by scenario, stage, task "
+            "and solver step, and publish the profile.");
+DEFINE_double(planning_profile_budget_ms, 100.0,
+              "The planning cycle time budget the profiler checks against.");
+DEFINE_int32(planning_profile_history_size, 50,
+             "The number of recent cycle profiles kept in memory.");
+DEFINE_string(planning_profile_dump_dir, "",
+              "If set, dump the recent cycle profiles as Chrome trace json to "
+              "this directory whenever a cycle is over budget.");
 
 DEFINE_double(
     default_front_clear_distance, 300.0,
@@ -497,6 +558,10 @@ DEFINE_double(smoother_stop_distance, 10.0,
 DEFINE_bool(enable_parallel_hybrid_a, false,
             "True to enable hybrid a* parallel implementation.");
 
+DEFINE_int32(max_analytic_expansion_candidates, 1,
+             "Number of Reeds Shepp paths, shortest first, that hybrid a* "
+             "collision checks in one analytic expansion before giving up");
+
 DEFINE_double(open_space_standstill_acceleration, 0.0,
               "(unit: meter/sec^2) for open space stand still at destination");
 
@@ -517,6 +582,10 @@ DEFINE_double(side_pass_driving_width_l_buffer, 0.1,
 
 DEFINE_bool(use_st_drivable_boundary, false,
             "True to use st_drivable boundary in speed planning");
+DEFINE_bool(enable_interval_st_boundary_mapping, false,
+            "True to map moving obstacles onto the st graph by intersecting "
+            "them with path segment bounding boxes and bisecting the "
+            "boundaries, instead of stepping along the whole path");
 
 DEFINE_bool(enable_reuse_path_in_lane_follow, false,
             "True to enable reuse path in lane follow");
@@ -540,6 +609,14 @@ DEFINE_string(planning_data_dir, "/apollo/modules/planning/data/",
 DEFINE_string(planning_offline_bags, "",
               "a list of source files or directories for offline mode. "
               "The items need to be separated by colon ':'. ");
+DEFINE_int32(planning_offline_shard_num, 1,
+             "Number of processes sharing the offline bags. Each process "
+             "takes every shard_num-th bag.");
+DEFINE_int32(planning_offline_shard_index, 0,
+             "Shard of the offline bags this process takes, in "
+             "[0, planning_offline_shard_num)");
+DEFINE_bool(planning_offline_async_write, false,
+            "Write the learning data files on a background thread");
 DEFINE_int32(learning_data_obstacle_history_time_sec, 3.0,
              "time sec (second) of history trajectory points for a obstacle");
 DEFINE_int32(learning_data_frame_num_per_file, 100,
@@ -559,3 +636,9 @@ DEFINE_bool(
 DEFINE_int32(min_past_history_points_len, 0,
              "minimun past history points length for trainsition from "
              "rule-based planning to learning-based planning");
+DEFINE_bool(enable_async_learning_model_inference, false,
+            "True to render and run the learning model off the planning "
+            "thread and use its latest finished output");
+DEFINE_double(learning_model_inference_max_result_age, 0.3,
+              "(unit: sec) the oldest learning model output, relative to the "
+              "current learning data frame, that async inference may use");
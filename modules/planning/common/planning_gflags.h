@@ -48,6 +48,7 @@ DECLARE_bool(enable_scenario_pull_over);
 DECLARE_bool(enable_scenario_stop_sign);
 DECLARE_bool(enable_scenario_traffic_light);
 DECLARE_bool(enable_scenario_yield_sign);
+DECLARE_bool(enable_scenario_event_horizon);
 
 DECLARE_bool(enable_scenario_side_pass_multiple_parked_obstacles);
 DECLARE_bool(enable_force_pull_over_open_space_parking_test);
@@ -61,6 +62,8 @@ DECLARE_double(rtk_trajectory_resolution);
 DECLARE_bool(enable_reference_line_stitching);
 DECLARE_double(look_forward_extend_distance);
 DECLARE_double(reference_line_stitch_overlap_distance);
+DECLARE_bool(enable_reference_line_segment_cache);
+DECLARE_int32(reference_line_segment_cache_cycles);
 
 DECLARE_bool(enable_smooth_reference_line);
 
@@ -138,6 +141,7 @@ DECLARE_double(virtual_stop_wall_height);
 
 DECLARE_double(prediction_total_time);
 DECLARE_bool(align_prediction_time);
+DECLARE_bool(enable_obstacle_cache);
 DECLARE_int32(trajectory_point_num_for_debug);
 DECLARE_double(lane_change_prepare_length);
 DECLARE_double(min_lane_change_prepare_length);
@@ -153,7 +157,13 @@ DECLARE_bool(enable_sqp_solver);
 
 /// thread pool
 DECLARE_bool(use_multi_thread_to_add_obstacles);
+DECLARE_bool(enable_obstacle_spatial_index);
+DECLARE_bool(enable_traffic_rule_index);
 DECLARE_bool(enable_multi_thread_in_dp_st_graph);
+DECLARE_bool(enable_dp_st_graph_column_kernel);
+DECLARE_bool(enable_multi_thread_in_lattice_evaluation);
+DECLARE_bool(enable_multi_thread_in_reference_line_planning);
+DECLARE_bool(enable_multi_thread_in_path_candidates);
 
 DECLARE_double(numerical_epsilon);
 DECLARE_double(default_cruise_speed);
@@ -168,6 +178,7 @@ DECLARE_double(backup_trajectory_cost);
 DECLARE_double(min_velocity_sample_gap);
 DECLARE_double(lon_collision_buffer);
 DECLARE_double(lat_collision_buffer);
+DECLARE_double(collision_grid_cell_size);
 DECLARE_uint64(num_sample_follow_per_timestamp);
 
 DECLARE_bool(lateral_optimization);
@@ -200,6 +211,8 @@ DECLARE_double(time_min_density);
 DECLARE_double(comfort_acceleration_factor);
 DECLARE_double(polynomial_minimal_param);
 DECLARE_double(lattice_stop_buffer);
+DECLARE_bool(enable_lazy_lattice_trajectory_evaluation);
+DECLARE_int32(lattice_trajectory_evaluation_batch_size);
 DECLARE_double(max_s_lateral_optimization);
 DECLARE_double(default_delta_s_lateral_optimization);
 DECLARE_double(bound_buffer);
@@ -221,6 +234,7 @@ DECLARE_double(open_space_planning_period);
 DECLARE_double(open_space_prediction_time_horizon);
 DECLARE_bool(enable_perception_obstacles);
 DECLARE_bool(enable_open_space_planner_thread);
+DECLARE_bool(enable_open_space_roi_cache);
 DECLARE_bool(use_dual_variable_warm_start);
 DECLARE_bool(use_gear_shift_trajectory);
 DECLARE_uint64(open_space_trajectory_stitching_preserved_length);
@@ -228,10 +242,16 @@ DECLARE_bool(enable_smoother_failsafe);
 DECLARE_bool(use_s_curve_speed_smooth);
 DECLARE_bool(use_iterative_anchoring_smoother);
 DECLARE_bool(enable_parallel_trajectory_smoothing);
+DECLARE_bool(use_banded_fem_pos_deviation_solver);
 
 DECLARE_bool(enable_osqp_debug);
+DECLARE_bool(enable_persistent_osqp_workspace);
 DECLARE_bool(export_chart);
 DECLARE_bool(enable_record_debug);
+DECLARE_bool(enable_planning_profiler);
+DECLARE_double(planning_profile_budget_ms);
+DECLARE_int32(planning_profile_history_size);
+DECLARE_string(planning_profile_dump_dir);
 
 DECLARE_double(default_front_clear_distance);
 
@@ -246,6 +266,7 @@ DECLARE_double(smoother_stop_distance);
 DECLARE_double(side_pass_driving_width_l_buffer);
 
 DECLARE_bool(enable_parallel_hybrid_a);
+DECLARE_int32(max_analytic_expansion_candidates);
 
 DECLARE_double(open_space_standstill_acceleration);
 
@@ -258,6 +279,7 @@ DECLARE_double(short_path_length_threshold);
 DECLARE_uint64(trajectory_stitching_preserved_length);
 
 DECLARE_bool(use_st_drivable_boundary);
+DECLARE_bool(enable_interval_st_boundary_mapping);
 
 DECLARE_bool(use_smoothed_dp_guide_line);
 
@@ -271,10 +293,15 @@ DECLARE_bool(use_road_boundary_from_map);
 DECLARE_bool(planning_offline_learning);
 DECLARE_string(planning_data_dir);
 DECLARE_string(planning_offline_bags);
+DECLARE_int32(planning_offline_shard_num);
+DECLARE_int32(planning_offline_shard_index);
+DECLARE_bool(planning_offline_async_write);
 DECLARE_int32(learning_data_obstacle_history_time_sec);
 DECLARE_int32(learning_data_frame_num_per_file);
 DECLARE_string(planning_birdview_img_feature_renderer_config_file);
 DECLARE_int32(min_past_history_points_len);
+DECLARE_bool(enable_async_learning_model_inference);
+DECLARE_double(learning_model_inference_max_result_age);
 
 // hybrid model
 DECLARE_bool(skip_path_reference_in_side_pass);
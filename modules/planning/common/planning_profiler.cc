@@ -0,0 +1,267 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/common/planning_profiler.h"
+
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+
+#include "cyber/common/log.h"
+#include "modules/planning/common/planning_gflags.h"
+
+namespace apollo {
+namespace planning {
+
+namespace {
+
+// ids of the open spans of this thread, innermost last
+thread_local std::vector<int64_t> span_stack;
+
+int64_t NowNs(const clockid_t clock_id) {
+  struct timespec ts;
+  clock_gettime(clock_id, &ts);
+  return static_cast<int64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
+
+int64_t WallClockUs() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+
+uint64_t ThreadId() { return static_cast<uint64_t>(syscall(SYS_gettid)); }
+
+std::string EscapeJson(const std::string& str) {
+  std::string escaped;
+  escaped.reserve(str.size());
+  for (const char c : str) {
+    if (c == '"' || c == '\\') {
+      escaped.push_back('\\');
+      escaped.push_back(c);
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      escaped.push_back(' ');
+    } else {
+      escaped.push_back(c);
+    }
+  }
+  return escaped;
+}
+
+}  // namespace
+
+PlanningProfiler::PlanningProfiler() {}
+
+void PlanningProfiler::BeginCycle() {
+  if (!FLAGS_enable_planning_profiler) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  in_cycle_ = true;
+  cycle_first_span_id_ = next_span_id_;
+  cycle_start_wall_ns_ = NowNs(CLOCK_MONOTONIC);
+  cycle_start_cpu_ns_ = NowNs(CLOCK_PROCESS_CPUTIME_ID);
+  open_spans_.clear();
+  current_.Clear();
+  current_.set_start_time_us(WallClockUs());
+}
+
+bool PlanningProfiler::EndCycle(const uint32_t sequence_num,
+                                PlanningProfile* const profile) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!in_cycle_) {
+    return false;
+  }
+  in_cycle_ = false;
+  current_.set_sequence_num(sequence_num);
+  const double wall_time_ms =
+      static_cast<double>(NowNs(CLOCK_MONOTONIC) - cycle_start_wall_ns_) *
+      1e-6;
+  current_.set_wall_time_ms(wall_time_ms);
+  current_.set_cpu_time_ms(
+      static_cast<double>(NowNs(CLOCK_PROCESS_CPUTIME_ID) -
+                          cycle_start_cpu_ns_) *
+      1e-6);
+  current_.set_budget_ms(FLAGS_planning_profile_budget_ms);
+  current_.set_over_budget(wall_time_ms > FLAGS_planning_profile_budget_ms);
+
+  if (current_.over_budget()) {
+    const PlanningProfileSpan* slowest_task = nullptr;
+    for (const auto& span : current_.span()) {
+      if (span.level() == PlanningProfileSpan::TASK &&
+          (slowest_task == nullptr ||
+           span.wall_time_ms() > slowest_task->wall_time_ms())) {
+        slowest_task = &span;
+      }
+    }
+    AWARN << "Planning cycle " << current_.sequence_num() << " took "
+          << wall_time_ms << " ms, over the budget of "
+          << FLAGS_planning_profile_budget_ms << " ms. Slowest task: "
+          << (slowest_task == nullptr ? "none" : slowest_task->name())
+          << " ("
+          << (slowest_task == nullptr ? 0.0 : slowest_task->wall_time_ms())
+          << " ms)";
+  }
+
+  history_.push_back(current_);
+  while (static_cast<int>(history_.size()) >
+         std::max(1, FLAGS_planning_profile_history_size)) {
+    history_.pop_front();
+  }
+  if (profile != nullptr) {
+    *profile = current_;
+  }
+  if (current_.over_budget() && !FLAGS_planning_profile_dump_dir.empty()) {
+    const std::string file_name = FLAGS_planning_profile_dump_dir +
+                                  "/planning_profile_" +
+                                  std::to_string(current_.sequence_num()) +
+                                  ".json";
+    std::ofstream ofs(file_name);
+    if (ofs.is_open()) {
+      ofs << ToChromeTrace(
+          std::vector<PlanningProfile>(history_.begin(), history_.end()));
+    } else {
+      AERROR << "Failed to dump planning profile to " << file_name;
+    }
+  }
+  return true;
+}
+
+int64_t PlanningProfiler::BeginSpan(const std::string& name,
+                                    const PlanningProfileSpan::Level level) {
+  const int64_t start_wall_ns = NowNs(CLOCK_MONOTONIC);
+  const int64_t start_cpu_ns = NowNs(CLOCK_THREAD_CPUTIME_ID);
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!in_cycle_) {
+    return -1;
+  }
+  const int64_t span_id = next_span_id_++;
+  int parent_id = -1;
+  if (!span_stack.empty() && span_stack.back() >= cycle_first_span_id_) {
+    parent_id = static_cast<int>(span_stack.back() - cycle_first_span_id_);
+  }
+  auto* span = current_.add_span();
+  span->set_id(static_cast<int>(span_id - cycle_first_span_id_));
+  span->set_parent_id(parent_id);
+  span->set_name(name);
+  span->set_level(level);
+  span->set_thread_id(ThreadId());
+  span->set_start_time_us((start_wall_ns - cycle_start_wall_ns_) / 1000);
+  open_spans_.push_back({start_wall_ns, start_cpu_ns});
+  span_stack.push_back(span_id);
+  return span_id;
+}
+
+void PlanningProfiler::EndSpan(const int64_t span_id) {
+  if (span_id < 0) {
+    return;
+  }
+  if (!span_stack.empty() && span_stack.back() == span_id) {
+    span_stack.pop_back();
+  }
+  const int64_t end_wall_ns = NowNs(CLOCK_MONOTONIC);
+  const int64_t end_cpu_ns = NowNs(CLOCK_THREAD_CPUTIME_ID);
+  std::lock_guard<std::mutex> lock(mutex_);
+  const int64_t index = span_id - cycle_first_span_id_;
+  if (!in_cycle_ || index < 0 || index >= current_.span_size()) {
+    // the span outlived its cycle
+    return;
+  }
+  const auto& open_span = open_spans_[index];
+  auto* span = current_.mutable_span(static_cast<int>(index));
+  span->set_wall_time_ms(
+      static_cast<double>(end_wall_ns - open_span.start_wall_ns) * 1e-6);
+  span->set_cpu_time_ms(
+      static_cast<double>(end_cpu_ns - open_span.start_cpu_ns) * 1e-6);
+}
+
+std::vector<PlanningProfile> PlanningProfiler::History() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return {history_.begin(), history_.end()};
+}
+
+void PlanningProfiler::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  in_cycle_ = false;
+  open_spans_.clear();
+  current_.Clear();
+  history_.clear();
+}
+
+std::string PlanningProfiler::ToChromeTrace(
+    const std::vector<PlanningProfile>& profiles) {
+  std::ostringstream oss;
+  oss << "{\"traceEvents\":[";
+  bool first = true;
+  for (const auto& profile : profiles) {
+    if (!first) {
+      oss << ",";
+    }
+    first = false;
+    oss << "{\"name\":\"cycle " << profile.sequence_num()
+        << "\",\"cat\":\"CYCLE\",\"ph\":\"X\",\"pid\":0,\"tid\":0,\"ts\":"
+        << profile.start_time_us()
+        << ",\"dur\":" << static_cast<int64_t>(profile.wall_time_ms() * 1e3)
+        << ",\"args\":{\"cpu_ms\":" << profile.cpu_time_ms()
+        << ",\"over_budget\":" << (profile.over_budget() ? "true" : "false")
+        << "}}";
+    for (const auto& span : profile.span()) {
+      oss << ",{\"name\":\"" << EscapeJson(span.name()) << "\",\"cat\":\""
+          << PlanningProfileSpan::Level_Name(span.level())
+          << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << span.thread_id()
+          << ",\"ts\":" << profile.start_time_us() + span.start_time_us()
+          << ",\"dur\":" << static_cast<int64_t>(span.wall_time_ms() * 1e3)
+          << ",\"args\":{\"cpu_ms\":" << span.cpu_time_ms() << "}}";
+    }
+  }
+  oss << "]}";
+  return oss.str();
+}
+
+bool PlanningProfiler::DumpChromeTrace(const std::string& file_name) const {
+  std::ofstream ofs(file_name);
+  if (!ofs.is_open()) {
+    AERROR << "Failed to open " << file_name;
+    return false;
+  }
+  ofs << ToChromeTrace(History());
+  return true;
+}
+
+ScopedPlanningProfile::ScopedPlanningProfile(
+    const std::string& name, const PlanningProfileSpan::Level level) {
+  if (FLAGS_enable_planning_profiler) {
+    span_id_ = PlanningProfiler::Instance()->BeginSpan(name, level);
+  }
+}
+
+ScopedPlanningProfile::~ScopedPlanningProfile() {
+  if (span_id_ >= 0) {
+    PlanningProfiler::Instance()->EndSpan(span_id_);
+  }
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -0,0 +1,108 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "cyber/common/macros.h"
+#include "modules/planning/proto/planning_profile.pb.h"
+
+namespace apollo {
+namespace planning {
+
+/**
+ * @class PlanningProfiler
+ *
+ * @brief PlanningProfiler records a tree of wall and cpu time spans for every
+ * planning cycle: scenario -> stage -> task -> solver step. The profiles of
+ * recent cycles are kept in a ring buffer and can be dumped as Chrome trace
+ * json. Nothing is recorded unless FLAGS_enable_planning_profiler is set.
+ */
+class PlanningProfiler {
+ public:
+  void BeginCycle();
+
+  /**
+   * @brief Close the current cycle and move it into the history.
+   * @param sequence_num The sequence number of the cycle's trajectory.
+   * @return false if no cycle was open.
+   */
+  bool EndCycle(const uint32_t sequence_num, PlanningProfile* const profile);
+
+  /**
+   * @brief Open a span nested in the innermost open span of this thread.
+   * @return the span id, or -1 if no cycle is open.
+   */
+  int64_t BeginSpan(const std::string& name,
+                    const PlanningProfileSpan::Level level);
+  void EndSpan(const int64_t span_id);
+
+  std::vector<PlanningProfile> History() const;
+  void Clear();
+
+  static std::string ToChromeTrace(
+      const std::vector<PlanningProfile>& profiles);
+  bool DumpChromeTrace(const std::string& file_name) const;
+
+ private:
+  struct OpenSpan {
+    int64_t start_wall_ns = 0;
+    int64_t start_cpu_ns = 0;
+  };
+
+  mutable std::mutex mutex_;
+  bool in_cycle_ = false;
+  // span ids keep increasing across cycles, so a span that outlives its
+  // cycle is recognized and dropped
+  int64_t next_span_id_ = 0;
+  int64_t cycle_first_span_id_ = 0;
+  int64_t cycle_start_wall_ns_ = 0;
+  int64_t cycle_start_cpu_ns_ = 0;
+  PlanningProfile current_;
+  std::vector<OpenSpan> open_spans_;
+  std::deque<PlanningProfile> history_;
+
+  DECLARE_SINGLETON(PlanningProfiler)
+};
+
+/**
+ * @class ScopedPlanningProfile
+ *
+ * @brief Records a span of the current planning cycle for its lifetime.
+ */
+class ScopedPlanningProfile {
+ public:
+  ScopedPlanningProfile(const std::string& name,
+                        const PlanningProfileSpan::Level level);
+  ~ScopedPlanningProfile();
+
+ private:
+  int64_t span_id_ = -1;
+
+  DISALLOW_COPY_AND_ASSIGN(ScopedPlanningProfile)
+};
+
+}  // namespace planning
+}  // namespace apollo
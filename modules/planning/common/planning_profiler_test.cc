@@ -0,0 +1,92 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/common/planning_profiler.h"
+
+#include "gtest/gtest.h"
+#include "modules/planning/common/planning_gflags.h"
+
+namespace apollo {
+namespace planning {
+
+class PlanningProfilerTest : public ::testing::Test {
+ public:
+  virtual void SetUp() {
+    FLAGS_enable_planning_profiler = true;
+    FLAGS_planning_profile_history_size = 2;
+    PlanningProfiler::Instance()->Clear();
+  }
+  virtual void TearDown() { FLAGS_enable_planning_profiler = false; }
+};
+
+TEST_F(PlanningProfilerTest, SpanTree) {
+  auto* profiler = PlanningProfiler::Instance();
+  profiler->BeginCycle();
+  {
+    ScopedPlanningProfile scenario("LANE_FOLLOW",
+                                   PlanningProfileSpan::SCENARIO);
+    {
+      ScopedPlanningProfile task("PATH_BOUNDS_DECIDER",
+                                 PlanningProfileSpan::TASK);
+    }
+    ScopedPlanningProfile step("osqp_solve", PlanningProfileSpan::STEP);
+  }
+  PlanningProfile profile;
+  ASSERT_TRUE(profiler->EndCycle(7, &profile));
+  EXPECT_FALSE(profiler->EndCycle(8, &profile));
+
+  EXPECT_EQ(7, profile.sequence_num());
+  ASSERT_EQ(3, profile.span_size());
+  EXPECT_EQ("LANE_FOLLOW", profile.span(0).name());
+  EXPECT_EQ(-1, profile.span(0).parent_id());
+  EXPECT_EQ(PlanningProfileSpan::TASK, profile.span(1).level());
+  EXPECT_EQ(0, profile.span(1).parent_id());
+  EXPECT_EQ(0, profile.span(2).parent_id());
+  EXPECT_GE(profile.span(0).wall_time_ms(), profile.span(1).wall_time_ms());
+}
+
+TEST_F(PlanningProfilerTest, History) {
+  auto* profiler = PlanningProfiler::Instance();
+  for (uint32_t i = 0; i < 3; ++i) {
+    profiler->BeginCycle();
+    ScopedPlanningProfile task("task", PlanningProfileSpan::TASK);
+    profiler->EndCycle(i, nullptr);
+  }
+  const auto history = profiler->History();
+  ASSERT_EQ(2, history.size());
+  EXPECT_EQ(1, history[0].sequence_num());
+  EXPECT_EQ(2, history[1].sequence_num());
+
+  const std::string trace = PlanningProfiler::ToChromeTrace(history);
+  EXPECT_EQ(0, trace.find("{\"traceEvents\":["));
+  EXPECT_NE(std::string::npos, trace.find("\"cat\":\"TASK\""));
+}
+
+TEST_F(PlanningProfilerTest, Disabled) {
+  FLAGS_enable_planning_profiler = false;
+  auto* profiler = PlanningProfiler::Instance();
+  profiler->BeginCycle();
+  ScopedPlanningProfile task("task", PlanningProfileSpan::TASK);
+  EXPECT_FALSE(profiler->EndCycle(0, nullptr));
+  EXPECT_TRUE(profiler->History().empty());
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -335,6 +335,13 @@ const PathDecision& ReferenceLineInfo::path_decision() const {
   return path_decision_;
 }
 
+const ObstacleSpatialIndex& ReferenceLineInfo::obstacle_spatial_index() const {
+  if (obstacle_spatial_index_.IsStale(path_decision_.obstacles())) {
+    obstacle_spatial_index_.Build(path_decision_.obstacles());
+  }
+  return obstacle_spatial_index_;
+}
+
 const ReferenceLine& ReferenceLineInfo::reference_line() const {
   return reference_line_;
 }
@@ -363,6 +370,7 @@ Obstacle* ReferenceLineInfo::AddObstacle(const Obstacle* obstacle) {
     AERROR << "failed to add obstacle " << obstacle->Id();
     return nullptr;
   }
+  obstacle_spatial_index_.Invalidate();
 
   SLBoundary perception_sl;
   if (!reference_line_.GetSLBoundary(obstacle->PerceptionBoundingBox(),
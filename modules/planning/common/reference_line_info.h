@@ -33,6 +33,7 @@
 #include "modules/common/vehicle_state/proto/vehicle_state.pb.h"
 #include "modules/map/hdmap/hdmap_common.h"
 #include "modules/map/pnc_map/pnc_map.h"
+#include "modules/planning/common/obstacle_spatial_index.h"
 #include "modules/planning/common/path/path_data.h"
 #include "modules/planning/common/path_boundary.h"
 #include "modules/planning/common/path_decision.h"
@@ -71,6 +72,13 @@ class ReferenceLineInfo {
   PathDecision* path_decision();
   const PathDecision& path_decision() const;
 
+  /**
+   * @brief The spatial index over the obstacles of path_decision(). It is
+   * (re)built on the first call after obstacles are added, which is not
+   * thread safe, so call it from the thread that plans this reference line.
+   */
+  const ObstacleSpatialIndex& obstacle_spatial_index() const;
+
   const ReferenceLine& reference_line() const;
   ReferenceLine* mutable_reference_line();
 
@@ -292,6 +300,7 @@ class ReferenceLineInfo {
   bool is_drivable_ = true;
 
   PathDecision path_decision_;
+  mutable ObstacleSpatialIndex obstacle_spatial_index_;
 
   Obstacle* blocking_obstacle_;
 
@@ -20,6 +20,7 @@
 
 #include "modules/planning/constraint_checker/collision_checker.h"
 
+#include <cmath>
 #include <utility>
 
 #include "cyber/common/log.h"
@@ -84,30 +85,42 @@ bool CollisionChecker::InCollision(
 
 bool CollisionChecker::InCollision(
     const DiscretizedTrajectory& discretized_trajectory) {
-  CHECK_LE(discretized_trajectory.NumOfPoints(),
-           predicted_bounding_rectangles_.size());
+  CHECK_LE(discretized_trajectory.NumOfPoints(), predicted_environment_.size());
   const auto& vehicle_config =
       common::VehicleConfigHelper::Instance()->GetConfig();
   double ego_length = vehicle_config.vehicle_param().length();
   double ego_width = vehicle_config.vehicle_param().width();
+  double shift_distance =
+      ego_length / 2.0 - vehicle_config.vehicle_param().back_edge_to_center();
 
   for (size_t i = 0; i < discretized_trajectory.NumOfPoints(); ++i) {
     const auto& trajectory_point =
         discretized_trajectory.TrajectoryPointAt(static_cast<std::uint32_t>(i));
     double ego_theta = trajectory_point.path_point().theta();
-    Box2d ego_box(
-        {trajectory_point.path_point().x(), trajectory_point.path_point().y()},
-        ego_theta, ego_length, ego_width);
-    double shift_distance =
-        ego_length / 2.0 - vehicle_config.vehicle_param().back_edge_to_center();
-    Vec2d shift_vec{shift_distance * std::cos(ego_theta),
-                    shift_distance * std::sin(ego_theta)};
-    ego_box.Shift(shift_vec);
+    const double cos_theta = std::cos(ego_theta);
+    const double sin_theta = std::sin(ego_theta);
+    const double center_x =
+        trajectory_point.path_point().x() + shift_distance * cos_theta;
+    const double center_y =
+        trajectory_point.path_point().y() + shift_distance * sin_theta;
+
+    // Most points are clear of every obstacle, so the grid is queried with
+    // the axis aligned extent first and the ego box is only built for the
+    // points that are close to an obstacle.
+    const double half_extent_x = std::abs(cos_theta) * ego_length / 2.0 +
+                                 std::abs(sin_theta) * ego_width / 2.0;
+    const double half_extent_y = std::abs(sin_theta) * ego_length / 2.0 +
+                                 std::abs(cos_theta) * ego_width / 2.0;
+    const auto& predicted_env = predicted_environment_[i];
+    if (!predicted_env.MayOverlap(
+            center_x - half_extent_x, center_y - half_extent_y,
+            center_x + half_extent_x, center_y + half_extent_y)) {
+      continue;
+    }
 
-    for (const auto& obstacle_box : predicted_bounding_rectangles_[i]) {
-      if (ego_box.HasOverlap(obstacle_box)) {
-        return true;
-      }
+    Box2d ego_box({center_x, center_y}, ego_theta, ego_length, ego_width);
+    if (predicted_env.HasOverlap(ego_box)) {
+      return true;
     }
   }
   return false;
@@ -117,7 +130,7 @@ void CollisionChecker::BuildPredictedEnvironment(
     const std::vector<const Obstacle*>& obstacles, const double ego_vehicle_s,
     const double ego_vehicle_d,
     const std::vector<PathPoint>& discretized_reference_line) {
-  ACHECK(predicted_bounding_rectangles_.empty());
+  ACHECK(predicted_environment_.empty());
 
   // If the ego vehicle is in lane,
   // then, ignore all obstacles from the same lane.
@@ -149,7 +162,8 @@ void CollisionChecker::BuildPredictedEnvironment(
       box.LateralExtend(2.0 * FLAGS_lat_collision_buffer);
       predicted_env.push_back(std::move(box));
     }
-    predicted_bounding_rectangles_.push_back(std::move(predicted_env));
+    predicted_environment_.emplace_back(std::move(predicted_env),
+                                        FLAGS_collision_grid_cell_size);
     relative_time += FLAGS_trajectory_time_resolution;
   }
 }
@@ -0,0 +1,126 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/constraint_checker/obstacle_box_grid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace planning {
+
+using apollo::common::math::Box2d;
+
+namespace {
+// Queries covering more cells than this scan all boxes instead
+constexpr int64_t kMaxQueryCells = 64;
+}  // namespace
+
+ObstacleBoxGrid::ObstacleBoxGrid(std::vector<Box2d> boxes,
+                                 const double cell_size)
+    : boxes_(std::move(boxes)), cell_size_(cell_size) {
+  CHECK_GT(cell_size_, 0.0);
+  extents_.reserve(boxes_.size());
+  for (size_t i = 0; i < boxes_.size(); ++i) {
+    const auto& box = boxes_[i];
+    extents_.push_back({box.min_x(), box.min_y(), box.max_x(), box.max_y()});
+    const int min_ix = CellIndex(box.min_x());
+    const int max_ix = CellIndex(box.max_x());
+    const int min_iy = CellIndex(box.min_y());
+    const int max_iy = CellIndex(box.max_y());
+    for (int ix = min_ix; ix <= max_ix; ++ix) {
+      for (int iy = min_iy; iy <= max_iy; ++iy) {
+        cells_[CellKey(ix, iy)].push_back(static_cast<int>(i));
+      }
+    }
+  }
+}
+
+template <typename Visitor>
+bool ObstacleBoxGrid::AnyCandidate(const Extent& extent,
+                                   const Visitor& visitor) const {
+  if (boxes_.empty()) {
+    return false;
+  }
+  auto intersects = [&extent](const Extent& other) {
+    return other.max_x >= extent.min_x && other.min_x <= extent.max_x &&
+           other.max_y >= extent.min_y && other.min_y <= extent.max_y;
+  };
+
+  const int min_ix = CellIndex(extent.min_x);
+  const int max_ix = CellIndex(extent.max_x);
+  const int min_iy = CellIndex(extent.min_y);
+  const int max_iy = CellIndex(extent.max_y);
+  const int64_t num_cells = (static_cast<int64_t>(max_ix) - min_ix + 1) *
+                            (static_cast<int64_t>(max_iy) - min_iy + 1);
+  if (num_cells > std::max(kMaxQueryCells,
+                           static_cast<int64_t>(cells_.size()))) {
+    for (size_t i = 0; i < extents_.size(); ++i) {
+      if (intersects(extents_[i]) && visitor(static_cast<int>(i))) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  for (int ix = min_ix; ix <= max_ix; ++ix) {
+    for (int iy = min_iy; iy <= max_iy; ++iy) {
+      const auto iter = cells_.find(CellKey(ix, iy));
+      if (iter == cells_.end()) {
+        continue;
+      }
+      for (const int index : iter->second) {
+        if (intersects(extents_[index]) && visitor(index)) {
+          return true;
+        }
+      }
+    }
+  }
+  return false;
+}
+
+bool ObstacleBoxGrid::MayOverlap(const double min_x, const double min_y,
+                                 const double max_x,
+                                 const double max_y) const {
+  return AnyCandidate({min_x, min_y, max_x, max_y},
+                      [](const int) { return true; });
+}
+
+bool ObstacleBoxGrid::HasOverlap(const Box2d& box) const {
+  return AnyCandidate(
+      {box.min_x(), box.min_y(), box.max_x(), box.max_y()},
+      [this, &box](const int index) { return box.HasOverlap(boxes_[index]); });
+}
+
+int ObstacleBoxGrid::CellIndex(const double value) const {
+  return static_cast<int>(std::floor(value / cell_size_));
+}
+
+int64_t ObstacleBoxGrid::CellKey(const int ix, const int iy) {
+  return static_cast<int64_t>(
+      (static_cast<uint64_t>(static_cast<uint32_t>(ix)) << 32) |
+      static_cast<uint32_t>(iy));
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -0,0 +1,79 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "modules/common/math/box2d.h"
+
+namespace apollo {
+namespace planning {
+
+/**
+ * @class ObstacleBoxGrid
+ *
+ * @brief Buckets the obstacle boxes of one time slice into a uniform grid of
+ * square cells by their axis aligned extents, so that an overlap query only
+ * tests the boxes sharing a cell with the query box.
+ */
+class ObstacleBoxGrid {
+ public:
+  ObstacleBoxGrid(std::vector<common::math::Box2d> boxes,
+                  const double cell_size);
+
+  const std::vector<common::math::Box2d>& boxes() const { return boxes_; }
+
+  /**
+   * @brief Whether the axis aligned extent of any box intersects the given
+   * one. It is a cheap necessary condition of HasOverlap().
+   */
+  bool MayOverlap(const double min_x, const double min_y, const double max_x,
+                  const double max_y) const;
+
+  bool HasOverlap(const common::math::Box2d& box) const;
+
+ private:
+  struct Extent {
+    double min_x;
+    double min_y;
+    double max_x;
+    double max_y;
+  };
+
+  int CellIndex(const double value) const;
+  static int64_t CellKey(const int ix, const int iy);
+
+  // Calls the visitor with the index of every box whose extent intersects
+  // the query extent, possibly more than once, until it returns true.
+  template <typename Visitor>
+  bool AnyCandidate(const Extent& extent, const Visitor& visitor) const;
+
+ private:
+  std::vector<common::math::Box2d> boxes_;
+  std::vector<Extent> extents_;
+  double cell_size_ = 1.0;
+  std::unordered_map<int64_t, std::vector<int>> cells_;
+};
+
+}  // namespace planning
+}  // namespace apollo
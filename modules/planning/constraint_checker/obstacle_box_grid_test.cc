@@ -0,0 +1,77 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/constraint_checker/obstacle_box_grid.h"
+
+#include <cmath>
+#include <random>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace planning {
+
+using apollo::common::math::Box2d;
+
+TEST(ObstacleBoxGrid, Empty) {
+  ObstacleBoxGrid grid({}, 10.0);
+  EXPECT_FALSE(grid.MayOverlap(-1.0, -1.0, 1.0, 1.0));
+  EXPECT_FALSE(grid.HasOverlap(Box2d({0.0, 0.0}, 0.0, 4.0, 2.0)));
+}
+
+TEST(ObstacleBoxGrid, BoxesAcrossCells) {
+  // the second box covers cells on both sides of the origin
+  ObstacleBoxGrid grid({Box2d({25.0, 5.0}, 0.0, 4.0, 2.0),
+                        Box2d({0.0, 0.0}, M_PI_4, 30.0, 2.0)},
+                       10.0);
+  EXPECT_TRUE(grid.HasOverlap(Box2d({26.0, 5.5}, 0.3, 4.0, 2.0)));
+  EXPECT_TRUE(grid.HasOverlap(Box2d({-9.0, -9.0}, 0.0, 1.0, 1.0)));
+  EXPECT_FALSE(grid.HasOverlap(Box2d({-9.0, 9.0}, 0.0, 1.0, 1.0)));
+  // inside the extent of the diagonal box but off the box itself
+  EXPECT_TRUE(grid.MayOverlap(-9.5, 8.5, -8.5, 9.5));
+  EXPECT_FALSE(grid.MayOverlap(40.0, 40.0, 41.0, 41.0));
+}
+
+TEST(ObstacleBoxGrid, MatchesLinearScan) {
+  std::mt19937 gen(7);
+  std::uniform_real_distribution<double> position(-100.0, 100.0);
+  std::uniform_real_distribution<double> heading(-M_PI, M_PI);
+  std::uniform_real_distribution<double> size(0.5, 15.0);
+  std::vector<Box2d> boxes;
+  for (int i = 0; i < 200; ++i) {
+    boxes.emplace_back(common::math::Vec2d(position(gen), position(gen)),
+                       heading(gen), size(gen), size(gen));
+  }
+  ObstacleBoxGrid grid(boxes, 10.0);
+  for (int i = 0; i < 2000; ++i) {
+    const Box2d query({position(gen), position(gen)}, heading(gen), size(gen),
+                      size(gen));
+    bool expected = false;
+    for (const auto& box : boxes) {
+      expected = expected || query.HasOverlap(box);
+    }
+    EXPECT_EQ(expected, grid.HasOverlap(query));
+  }
+  // a query covering the whole map scans all boxes
+  EXPECT_TRUE(grid.HasOverlap(Box2d({0.0, 0.0}, 0.0, 500.0, 500.0)));
+}
+
+}  // namespace planning
+}  // namespace apollo
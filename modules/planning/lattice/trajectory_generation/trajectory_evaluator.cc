@@ -21,9 +21,11 @@
 #include "modules/planning/lattice/trajectory_generation/trajectory_evaluator.h"
 
 #include <algorithm>
+#include <future>
 #include <limits>
 
 #include "cyber/common/log.h"
+#include "cyber/task/task.h"
 #include "modules/common/math/path_matcher.h"
 #include "modules/planning/common/planning_gflags.h"
 #include "modules/planning/common/trajectory1d/piecewise_acceleration_trajectory1d.h"
@@ -64,6 +66,7 @@ TrajectoryEvaluator::TrajectoryEvaluator(
   if (planning_target.has_stop_point()) {
     stop_point = planning_target.stop_point().s();
   }
+  std::vector<PtrTrajectory1d> valid_lon_trajectories;
   for (const auto& lon_trajectory : lon_trajectories) {
     double lon_end_s = lon_trajectory->Evaluate(0, end_time);
     if (init_s[0] < stop_point &&
@@ -74,6 +77,16 @@ TrajectoryEvaluator::TrajectoryEvaluator(
     if (!ConstraintChecker1d::IsValidLongitudinalTrajectory(*lon_trajectory)) {
       continue;
     }
+    valid_lon_trajectories.push_back(lon_trajectory);
+  }
+
+  if (FLAGS_enable_lazy_lattice_trajectory_evaluation) {
+    EvaluateLazily(planning_target, valid_lon_trajectories, lat_trajectories);
+    ADEBUG << "Number of valid 1d trajectory pairs: " << lazy_queue_.size();
+    return;
+  }
+
+  for (const auto& lon_trajectory : valid_lon_trajectories) {
     for (const auto& lat_trajectory : lat_trajectories) {
       /**
        * The validity of the code needs to be verified.
@@ -87,29 +100,171 @@ TrajectoryEvaluator::TrajectoryEvaluator(
                           cost);
     }
   }
+  num_of_evaluated_trajectory_pairs_ = cost_queue_.size();
   ADEBUG << "Number of valid 1d trajectory pairs: " << cost_queue_.size();
 }
 
 bool TrajectoryEvaluator::has_more_trajectory_pairs() const {
+  if (lazy_evaluation_) {
+    return !lazy_queue_.empty();
+  }
   return !cost_queue_.empty();
 }
 
 size_t TrajectoryEvaluator::num_of_trajectory_pairs() const {
+  if (lazy_evaluation_) {
+    return lazy_queue_.size();
+  }
   return cost_queue_.size();
 }
 
+size_t TrajectoryEvaluator::num_of_evaluated_trajectory_pairs() const {
+  return num_of_evaluated_trajectory_pairs_;
+}
+
 std::pair<PtrTrajectory1d, PtrTrajectory1d>
 TrajectoryEvaluator::next_top_trajectory_pair() {
   ACHECK(has_more_trajectory_pairs());
+  if (lazy_evaluation_) {
+    const LazyPairCost top = lazy_queue_.top();
+    lazy_queue_.pop();
+    ResolveTopLazyPair();
+    return Trajectory1dPair(lazy_lon_trajectories_[top.lon_index],
+                            lazy_lat_trajectories_[top.lat_index]);
+  }
   auto top = cost_queue_.top();
   cost_queue_.pop();
   return top.first;
 }
 
 double TrajectoryEvaluator::top_trajectory_pair_cost() const {
+  if (lazy_evaluation_) {
+    return lazy_queue_.top().cost;
+  }
   return cost_queue_.top().second;
 }
 
+void TrajectoryEvaluator::EvaluateLazily(
+    const PlanningTarget& planning_target,
+    const std::vector<PtrTrajectory1d>& lon_trajectories,
+    const std::vector<PtrTrajectory1d>& lat_trajectories) {
+  lazy_evaluation_ = true;
+  lazy_lon_trajectories_ = lon_trajectories;
+  lazy_lat_trajectories_ = lat_trajectories;
+  lazy_lon_costs_.resize(lon_trajectories.size());
+  lazy_lon_s_values_.resize(lon_trajectories.size());
+
+  // the task queue is bounded, so tasks are submitted one batch at a time.
+  const size_t batch_size = static_cast<size_t>(
+      std::max(FLAGS_lattice_trajectory_evaluation_batch_size, 1));
+  for (size_t begin = 0; begin < lon_trajectories.size();
+       begin += batch_size) {
+    const size_t end = std::min(begin + batch_size, lon_trajectories.size());
+    if (FLAGS_enable_multi_thread_in_lattice_evaluation) {
+      std::vector<std::future<void>> results;
+      for (size_t i = begin; i < end; ++i) {
+        results.push_back(cyber::Async(
+            &TrajectoryEvaluator::EvaluateLazyLonCost, this, &planning_target,
+            i));
+      }
+      for (auto& result : results) {
+        result.get();
+      }
+    } else {
+      for (size_t i = begin; i < end; ++i) {
+        EvaluateLazyLonCost(&planning_target, i);
+      }
+    }
+  }
+
+  std::vector<LazyPairCost> pair_costs;
+  pair_costs.reserve(lon_trajectories.size() * lat_trajectories.size());
+  for (size_t i = 0; i < lon_trajectories.size(); ++i) {
+    for (size_t j = 0; j < lat_trajectories.size(); ++j) {
+      pair_costs.push_back({i, j, lazy_lon_costs_[i], false});
+    }
+  }
+  lazy_queue_ = std::priority_queue<LazyPairCost, std::vector<LazyPairCost>,
+                                    LazyCostComparator>(
+      LazyCostComparator(), std::move(pair_costs));
+  ResolveTopLazyPair();
+}
+
+void TrajectoryEvaluator::ResolveTopLazyPair() {
+  const size_t batch_size = static_cast<size_t>(
+      std::max(FLAGS_lattice_trajectory_evaluation_batch_size, 1));
+  std::vector<LazyPairCost> batch;
+  while (!lazy_queue_.empty() && !lazy_queue_.top().exact) {
+    // every full cost is at least its bound, so once the top of the queue
+    // carries a full cost, no bounded pair behind it can beat it.
+    batch.clear();
+    while (!lazy_queue_.empty() && !lazy_queue_.top().exact &&
+           batch.size() < batch_size) {
+      batch.push_back(lazy_queue_.top());
+      lazy_queue_.pop();
+    }
+    if (FLAGS_enable_multi_thread_in_lattice_evaluation && batch.size() > 1) {
+      std::vector<std::future<double>> results;
+      for (const auto& pair_cost : batch) {
+        results.push_back(cyber::Async(&TrajectoryEvaluator::LazyPairFullCost,
+                                       this, pair_cost));
+      }
+      for (size_t i = 0; i < batch.size(); ++i) {
+        batch[i].cost = results[i].get();
+      }
+    } else {
+      for (auto& pair_cost : batch) {
+        pair_cost.cost = LazyPairFullCost(pair_cost);
+      }
+    }
+    for (auto& pair_cost : batch) {
+      pair_cost.exact = true;
+      lazy_queue_.push(pair_cost);
+    }
+    num_of_evaluated_trajectory_pairs_ += batch.size();
+  }
+}
+
+void TrajectoryEvaluator::EvaluateLazyLonCost(
+    const PlanningTarget* planning_target, size_t lon_index) {
+  const auto& lon_trajectory = lazy_lon_trajectories_[lon_index];
+  // same terms and summation order as the longitudinal part of Evaluate()
+  lazy_lon_costs_[lon_index] =
+      LonObjectiveCost(lon_trajectory, *planning_target, reference_s_dot_) *
+          FLAGS_weight_lon_objective +
+      LonComfortCost(lon_trajectory) * FLAGS_weight_lon_jerk +
+      LonCollisionCost(lon_trajectory) * FLAGS_weight_lon_collision +
+      CentripetalAccelerationCost(lon_trajectory) *
+          FLAGS_weight_centripetal_acceleration;
+  lazy_lon_s_values_[lon_index] = EvaluationSValues(lon_trajectory);
+}
+
+double TrajectoryEvaluator::LazyPairFullCost(
+    const LazyPairCost& pair_cost) const {
+  const auto& lon_trajectory = lazy_lon_trajectories_[pair_cost.lon_index];
+  const auto& lat_trajectory = lazy_lat_trajectories_[pair_cost.lat_index];
+  return lazy_lon_costs_[pair_cost.lon_index] +
+         LatOffsetCost(lat_trajectory,
+                       lazy_lon_s_values_[pair_cost.lon_index]) *
+             FLAGS_weight_lat_offset +
+         LatComfortCost(lon_trajectory, lat_trajectory) *
+             FLAGS_weight_lat_comfort;
+}
+
+std::vector<double> TrajectoryEvaluator::EvaluationSValues(
+    const PtrTrajectory1d& lon_trajectory) const {
+  // decides the longitudinal evaluation horizon for lateral trajectories.
+  double evaluation_horizon =
+      std::min(FLAGS_speed_lon_decision_horizon,
+               lon_trajectory->Evaluate(0, lon_trajectory->ParamLength()));
+  std::vector<double> s_values;
+  for (double s = 0.0; s < evaluation_horizon;
+       s += FLAGS_trajectory_space_resolution) {
+    s_values.emplace_back(s);
+  }
+  return s_values;
+}
+
 double TrajectoryEvaluator::Evaluate(
     const PlanningTarget& planning_target,
     const PtrTrajectory1d& lon_trajectory,
@@ -132,15 +287,7 @@ double TrajectoryEvaluator::Evaluate(
 
   double centripetal_acc_cost = CentripetalAccelerationCost(lon_trajectory);
 
-  // decides the longitudinal evaluation horizon for lateral trajectories.
-  double evaluation_horizon =
-      std::min(FLAGS_speed_lon_decision_horizon,
-               lon_trajectory->Evaluate(0, lon_trajectory->ParamLength()));
-  std::vector<double> s_values;
-  for (double s = 0.0; s < evaluation_horizon;
-       s += FLAGS_trajectory_space_resolution) {
-    s_values.emplace_back(s);
-  }
+  std::vector<double> s_values = EvaluationSValues(lon_trajectory);
 
   // Lateral costs
   double lat_offset_cost = LatOffsetCost(lat_trajectory, s_values);
@@ -20,6 +20,7 @@
 
 #pragma once
 
+#include <array>
 #include <functional>
 #include <memory>
 #include <queue>
@@ -68,7 +69,48 @@ class TrajectoryEvaluator {
 
   std::vector<double> top_trajectory_pair_component_cost() const;
 
+  // number of pairs whose full cost has been computed so far; with lazy
+  // evaluation this stays below num_of_trajectory_pairs() when a feasible
+  // pair is found early.
+  size_t num_of_evaluated_trajectory_pairs() const;
+
  private:
+  // Lazy evaluation: the longitudinal part of the cost is computed once per
+  // longitudinal trajectory, and each pair is queued with it as a lower
+  // bound since the lateral costs are non-negative. A pair's lateral costs
+  // are only computed, in batches on the cyber thread pool, when its bound
+  // reaches the top of the queue.
+  struct LazyPairCost {
+    size_t lon_index;
+    size_t lat_index;
+    double cost;
+    bool exact;
+  };
+
+  struct LazyCostComparator {
+    bool operator()(const LazyPairCost& left,
+                    const LazyPairCost& right) const {
+      return left.cost > right.cost;
+    }
+  };
+
+  void EvaluateLazily(
+      const PlanningTarget& planning_target,
+      const std::vector<std::shared_ptr<Curve1d>>& lon_trajectories,
+      const std::vector<std::shared_ptr<Curve1d>>& lat_trajectories);
+
+  // evaluates bounded pairs from the top of the lazy queue until the top one
+  // carries its full cost.
+  void ResolveTopLazyPair();
+
+  void EvaluateLazyLonCost(const PlanningTarget* planning_target,
+                           size_t lon_index);
+
+  double LazyPairFullCost(const LazyPairCost& pair_cost) const;
+
+  std::vector<double> EvaluationSValues(
+      const std::shared_ptr<Curve1d>& lon_trajectory) const;
+
   double Evaluate(const PlanningTarget& planning_target,
                   const std::shared_ptr<Curve1d>& lon_trajectory,
                   const std::shared_ptr<Curve1d>& lat_trajectory,
@@ -117,6 +159,22 @@ class TrajectoryEvaluator {
   std::array<double, 3> init_s_;
 
   std::vector<double> reference_s_dot_;
+
+  bool lazy_evaluation_ = false;
+
+  std::priority_queue<LazyPairCost, std::vector<LazyPairCost>,
+                      LazyCostComparator>
+      lazy_queue_;
+
+  std::vector<std::shared_ptr<Curve1d>> lazy_lon_trajectories_;
+
+  std::vector<std::shared_ptr<Curve1d>> lazy_lat_trajectories_;
+
+  std::vector<double> lazy_lon_costs_;
+
+  std::vector<std::vector<double>> lazy_lon_s_values_;
+
+  size_t num_of_evaluated_trajectory_pairs_ = 0;
 };
 
 }  // namespace planning
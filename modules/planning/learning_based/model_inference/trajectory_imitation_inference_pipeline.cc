@@ -0,0 +1,143 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/learning_based/model_inference/trajectory_imitation_inference_pipeline.h"
+
+#include <utility>
+
+#include "cyber/common/log.h"
+#include "cyber/task/task.h"
+
+namespace apollo {
+namespace planning {
+
+TrajectoryImitationInferencePipeline::TrajectoryImitationInferencePipeline(
+    TrajectoryImitationLibtorchInference* inference)
+    : inference_(inference) {
+  CHECK_NOTNULL(inference_);
+  prepare_input_future_ = cyber::Async(
+      &TrajectoryImitationInferencePipeline::PrepareInputThread, this);
+  inference_future_ = cyber::Async(
+      &TrajectoryImitationInferencePipeline::InferenceThread, this);
+}
+
+TrajectoryImitationInferencePipeline::~TrajectoryImitationInferencePipeline() {
+  Stop();
+}
+
+void TrajectoryImitationInferencePipeline::Submit(
+    const LearningDataFrame& learning_data_frame) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (pending_frame_ == nullptr) {
+      pending_frame_ = std::make_unique<LearningDataFrame>();
+    } else {
+      ADEBUG << "drop learning data frame[" << pending_frame_->frame_num()
+             << "] before rendering";
+    }
+    pending_frame_->CopyFrom(learning_data_frame);
+  }
+  condition_.notify_all();
+}
+
+std::shared_ptr<const LearningDataFrame>
+TrajectoryImitationInferencePipeline::LatestResult() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return latest_result_;
+}
+
+void TrajectoryImitationInferencePipeline::Stop() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (is_stopped_) {
+      return;
+    }
+    is_stopped_ = true;
+  }
+  condition_.notify_all();
+  if (prepare_input_future_.valid()) {
+    prepare_input_future_.get();
+  }
+  if (inference_future_.valid()) {
+    inference_future_.get();
+  }
+}
+
+void TrajectoryImitationInferencePipeline::PrepareInputThread() {
+  while (true) {
+    std::unique_ptr<LearningDataFrame> learning_data_frame;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      condition_.wait(lock, [this] { return is_stopped_ || pending_frame_; });
+      if (is_stopped_) {
+        return;
+      }
+      learning_data_frame = std::move(pending_frame_);
+    }
+
+    auto prepared_input = std::make_unique<PreparedInput>();
+    if (!inference_->PrepareInput(*learning_data_frame,
+                                  &prepared_input->torch_inputs)) {
+      AERROR << "Failed to prepare model input of learning data frame["
+             << learning_data_frame->frame_num() << "]";
+      continue;
+    }
+    prepared_input->learning_data_frame.Swap(learning_data_frame.get());
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (prepared_input_ != nullptr) {
+        ADEBUG << "drop learning data frame["
+               << prepared_input_->learning_data_frame.frame_num()
+               << "] before inference";
+      }
+      prepared_input_ = std::move(prepared_input);
+    }
+    condition_.notify_all();
+  }
+}
+
+void TrajectoryImitationInferencePipeline::InferenceThread() {
+  while (true) {
+    std::unique_ptr<PreparedInput> prepared_input;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      condition_.wait(lock, [this] { return is_stopped_ || prepared_input_; });
+      if (is_stopped_) {
+        return;
+      }
+      prepared_input = std::move(prepared_input_);
+    }
+
+    auto result = std::make_shared<LearningDataFrame>();
+    result->Swap(&prepared_input->learning_data_frame);
+    if (!inference_->RunModel(prepared_input->torch_inputs, result.get())) {
+      AERROR << "Failed to run model on learning data frame["
+             << result->frame_num() << "]";
+      continue;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    latest_result_ = std::move(result);
+  }
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -0,0 +1,96 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Define the trajectory_imitation_inference_pipeline class
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "modules/planning/learning_based/model_inference/trajectory_imitation_libtorch_inference.h"
+
+namespace apollo {
+namespace planning {
+
+/**
+ * @class TrajectoryImitationInferencePipeline
+ *
+ * @brief Runs TrajectoryImitationLibtorchInference off the planning thread in
+ * two stages: one thread renders and preprocesses the latest submitted frame
+ * while another runs the model on the previously prepared one. Each stage
+ * only keeps the newest pending frame, so a slow model drops frames instead
+ * of queuing them, and planning reads the latest finished result without
+ * waiting.
+ */
+class TrajectoryImitationInferencePipeline {
+ public:
+  /**
+   * @brief Constructor
+   * @param inference a loaded model, which must outlive the pipeline
+   */
+  explicit TrajectoryImitationInferencePipeline(
+      TrajectoryImitationLibtorchInference* inference);
+
+  /**
+   * @brief Destructor
+   */
+  ~TrajectoryImitationInferencePipeline();
+
+  /**
+   * @brief queue a frame, replacing the one waiting to be rendered if any
+   */
+  void Submit(const LearningDataFrame& learning_data_frame);
+
+  /**
+   * @brief the latest frame the model ran on, with its output
+   * @return nullptr if no inference finished yet
+   */
+  std::shared_ptr<const LearningDataFrame> LatestResult() const;
+
+  void Stop();
+
+ private:
+  struct PreparedInput {
+    LearningDataFrame learning_data_frame;
+    std::vector<torch::jit::IValue> torch_inputs;
+  };
+
+  void PrepareInputThread();
+  void InferenceThread();
+
+ private:
+  TrajectoryImitationLibtorchInference* inference_ = nullptr;
+
+  mutable std::mutex mutex_;
+  std::condition_variable condition_;
+  bool is_stopped_ = false;
+  std::unique_ptr<LearningDataFrame> pending_frame_;
+  std::unique_ptr<PreparedInput> prepared_input_;
+  std::shared_ptr<const LearningDataFrame> latest_result_;
+
+  std::future<void> prepare_input_future_;
+  std::future<void> inference_future_;
+};
+
+}  // namespace planning
+}  // namespace apollo
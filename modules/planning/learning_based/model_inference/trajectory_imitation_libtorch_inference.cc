@@ -150,9 +150,10 @@ void TrajectoryImitationLibtorchInference::output_postprocessing(
   }
 }
 
-bool TrajectoryImitationLibtorchInference::DoCNNMODELInference(
-    LearningDataFrame* const learning_data_frame) {
-  const int past_points_size = learning_data_frame->adc_trajectory_point_size();
+bool TrajectoryImitationLibtorchInference::PrepareInput(
+    const LearningDataFrame& learning_data_frame,
+    std::vector<torch::jit::IValue>* const torch_inputs) {
+  const int past_points_size = learning_data_frame.adc_trajectory_point_size();
   if (past_points_size == 0) {
     AERROR << "No current trajectory point status";
     return false;
@@ -162,7 +163,7 @@ bool TrajectoryImitationLibtorchInference::DoCNNMODELInference(
 
   cv::Mat input_feature;
   if (!BirdviewImgFeatureRenderer::Instance()->RenderMultiChannelEnv(
-          *learning_data_frame, &input_feature)) {
+          learning_data_frame, &input_feature)) {
     AERROR << "Render multi-channel input image failed";
     return false;
   }
@@ -181,9 +182,32 @@ bool TrajectoryImitationLibtorchInference::DoCNNMODELInference(
       torch::from_blob(input_feature_float.data,
                        {1, input_feature_float.rows, input_feature_float.cols,
                         input_feature_float.channels()});
-  input_feature_tensor = input_feature_tensor.permute({0, 3, 1, 2});
-  for (int i = 0; i < input_feature_float.channels(); ++i) {
-    input_feature_tensor[0][i] = input_feature_tensor[0][i].sub(0.5).div(0.5);
+  // normalizing every channel to [-1, 1] also copies the image out of
+  // input_feature_float, so the tensor outlives this function
+  input_feature_tensor =
+      input_feature_tensor.permute({0, 3, 1, 2}).sub(0.5).div(0.5).contiguous();
+
+  torch_inputs->clear();
+  switch (config_.model_type()) {
+    case LearningModelInferenceTaskConfig::CNN: {
+      torch_inputs->push_back(ToDeviceInput(input_feature_tensor));
+      break;
+    }
+    case LearningModelInferenceTaskConfig::CNN_LSTM: {
+      const auto& current_traj_point =
+          learning_data_frame.adc_trajectory_point(past_points_size - 1)
+              .trajectory_point();
+      torch::Tensor current_v_tensor = torch::zeros({1, 1});
+      current_v_tensor[0][0] = current_traj_point.v();
+      torch_inputs->push_back(c10::ivalue::Tuple::create(
+          {ToDeviceInput(input_feature_tensor),
+           ToDeviceInput(current_v_tensor)}));
+      break;
+    }
+    default: {
+      AERROR << "Configured model type not defined and implemented";
+      return false;
+    }
   }
 
   auto input_preprocessing_end_time = std::chrono::system_clock::now();
@@ -191,86 +215,23 @@ bool TrajectoryImitationLibtorchInference::DoCNNMODELInference(
       input_preprocessing_end_time - input_preprocessing_start_time;
   ADEBUG << "trajectory imitation model input preprocessing used time: "
          << preprocessing_diff.count() * 1000 << " ms.";
-
-  auto inference_start_time = std::chrono::system_clock::now();
-
-  std::vector<torch::jit::IValue> torch_inputs;
-  torch_inputs.push_back(input_feature_tensor.to(device_));
-  at::Tensor torch_output_tensor =
-      model_.forward(torch_inputs).toTensor().to(torch::kCPU);
-
-  auto inference_end_time = std::chrono::system_clock::now();
-  std::chrono::duration<double> inference_diff =
-      inference_end_time - inference_start_time;
-  ADEBUG << "trajectory imitation model inference used time: "
-         << inference_diff.count() * 1000 << " ms.";
-
-  output_postprocessing(torch_output_tensor, learning_data_frame);
-
   return true;
 }
 
-bool TrajectoryImitationLibtorchInference::DoCNNLSTMMODELInference(
+bool TrajectoryImitationLibtorchInference::RunModel(
+    const std::vector<torch::jit::IValue>& torch_inputs,
     LearningDataFrame* const learning_data_frame) {
-  const int past_points_size = learning_data_frame->adc_trajectory_point_size();
-  if (past_points_size == 0) {
-    AERROR << "No current trajectory point status";
-    return false;
-  }
-
-  auto input_renderering_start_time = std::chrono::system_clock::now();
+  auto inference_start_time = std::chrono::system_clock::now();
 
-  cv::Mat input_feature;
-  if (!BirdviewImgFeatureRenderer::Instance()->RenderMultiChannelEnv(
-          *learning_data_frame, &input_feature)) {
-    AERROR << "Render multi-channel input image failed";
+  at::Tensor torch_output_tensor;
+  try {
+    torch_output_tensor =
+        model_.forward(torch_inputs).toTensor().to(torch::kCPU);
+  } catch (const c10::Error& e) {
+    AERROR << "Trajectory imitation model inference failed: " << e.what();
     return false;
   }
 
-  auto input_renderering_end_time = std::chrono::system_clock::now();
-  std::chrono::duration<double> rendering_diff =
-      input_renderering_end_time - input_renderering_start_time;
-  ADEBUG << "trajectory imitation model input renderer used time: "
-         << rendering_diff.count() * 1000 << " ms.";
-
-  auto input_preprocessing_start_time = std::chrono::system_clock::now();
-
-  cv::Mat input_feature_float;
-  input_feature.convertTo(input_feature_float, CV_32F, 1.0 / 255);
-  torch::Tensor input_feature_tensor =
-      torch::from_blob(input_feature_float.data,
-                       {1, input_feature_float.rows, input_feature_float.cols,
-                        input_feature_float.channels()});
-  input_feature_tensor = input_feature_tensor.permute({0, 3, 1, 2});
-  for (int i = 0; i < input_feature_float.channels(); ++i) {
-    input_feature_tensor[0][i] = input_feature_tensor[0][i].sub(0.5).div(0.5);
-  }
-
-  const auto& current_traj_point =
-      learning_data_frame
-          ->adc_trajectory_point(
-              learning_data_frame->adc_trajectory_point_size() - 1)
-          .trajectory_point();
-
-  torch::Tensor current_v_tensor = torch::zeros({1, 1});
-  const double current_v = current_traj_point.v();
-  current_v_tensor[0][0] = current_v;
-
-  auto input_preprocessing_end_time = std::chrono::system_clock::now();
-  std::chrono::duration<double> preprocessing_diff =
-      input_preprocessing_end_time - input_preprocessing_start_time;
-  ADEBUG << "trajectory imitation model input preprocessing used time: "
-         << preprocessing_diff.count() * 1000 << " ms.";
-
-  auto inference_start_time = std::chrono::system_clock::now();
-
-  std::vector<torch::jit::IValue> torch_inputs;
-  torch_inputs.push_back(
-      c10::ivalue::Tuple::create({std::move(input_feature_tensor.to(device_)),
-                                  std::move(current_v_tensor.to(device_))}));
-  at::Tensor torch_output_tensor =
-      model_.forward(torch_inputs).toTensor().to(torch::kCPU);
-
   auto inference_end_time = std::chrono::system_clock::now();
   std::chrono::duration<double> inference_diff =
       inference_end_time - inference_start_time;
@@ -278,31 +239,27 @@ bool TrajectoryImitationLibtorchInference::DoCNNLSTMMODELInference(
          << inference_diff.count() * 1000 << " ms.";
 
   output_postprocessing(torch_output_tensor, learning_data_frame);
-
   return true;
 }
 
 bool TrajectoryImitationLibtorchInference::DoInference(
     LearningDataFrame* const learning_data_frame) {
-  switch (config_.model_type()) {
-    case LearningModelInferenceTaskConfig::CNN: {
-      if (!DoCNNMODELInference(learning_data_frame)) {
-        return false;
-      }
-      break;
-    }
-    case LearningModelInferenceTaskConfig::CNN_LSTM: {
-      if (!DoCNNLSTMMODELInference(learning_data_frame)) {
-        return false;
-      }
-      break;
-    }
-    default: {
-      AERROR << "Configured model type not defined and implemented";
-      break;
-    }
+  std::vector<torch::jit::IValue> torch_inputs;
+  if (!PrepareInput(*learning_data_frame, &torch_inputs)) {
+    return false;
   }
-  return true;
+  return RunModel(torch_inputs, learning_data_frame);
 }
+
+torch::Tensor TrajectoryImitationLibtorchInference::ToDeviceInput(
+    const torch::Tensor& tensor) const {
+  if (!device_.is_cuda()) {
+    return tensor;
+  }
+  // a copy from page locked memory does not block the calling thread, so it
+  // overlaps with the model running on the inputs of the previous frame
+  return tensor.pin_memory().to(device_, /*non_blocking=*/true);
+}
+
 }  // namespace planning
 }  // namespace apollo
@@ -22,6 +22,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include "torch/extension.h"
 #include "torch/script.h"
@@ -60,6 +61,22 @@ class TrajectoryImitationLibtorchInference : public ModelInference {
    */
   bool DoInference(LearningDataFrame* const learning_data_frame) override;
 
+  /**
+   * @brief render the birdview image of a frame and convert it to the
+   * inputs of the model on the model device
+   * @param learning_data_frame the frame to render
+   * @param torch_inputs the model inputs
+   */
+  bool PrepareInput(const LearningDataFrame& learning_data_frame,
+                    std::vector<torch::jit::IValue>* const torch_inputs);
+
+  /**
+   * @brief run the model on inputs from PrepareInput() and write its
+   * trajectory to the output of learning_data_frame
+   */
+  bool RunModel(const std::vector<torch::jit::IValue>& torch_inputs,
+                LearningDataFrame* const learning_data_frame);
+
  private:
   /**
    * @brief load a CNN model
@@ -72,16 +89,10 @@ class TrajectoryImitationLibtorchInference : public ModelInference {
   bool LoadCNNLSTMModel();
 
   /**
-   * @brief inference a CNN model
-   * @param learning_data_frame input and output intermediate for inference
-   */
-  bool DoCNNMODELInference(LearningDataFrame* const learning_data_frame);
-
-  /**
-   * @brief inference a CNN_LSTM like model
-   * @param learning_data_frame input and output intermediate for inference
+   * @brief move a host tensor to device_, through page locked memory if
+   * device_ is a gpu
    */
-  bool DoCNNLSTMMODELInference(LearningDataFrame* const learning_data_frame);
+  torch::Tensor ToDeviceInput(const torch::Tensor& tensor) const;
 
   /**
    * @brief postprocessing model trajectory output
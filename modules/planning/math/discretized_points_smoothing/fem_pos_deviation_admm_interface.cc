@@ -0,0 +1,343 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/math/discretized_points_smoothing/fem_pos_deviation_admm_interface.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace planning {
+
+namespace {
+
+// Same admm parameters as the osqp defaults
+constexpr double kSigma = 1.0e-6;
+constexpr double kAlpha = 1.6;
+constexpr double kInitialRho = 0.1;
+constexpr double kMinRho = 1.0e-6;
+constexpr double kMaxRho = 1.0e6;
+// Refactorize only when rho changes by more than this factor
+constexpr double kRhoUpdateTolerance = 5.0;
+constexpr int kCheckTerminationInterval = 10;
+constexpr int kAdaptiveRhoInterval = 50;
+constexpr double kEpsAbs = 1.0e-5;
+constexpr double kEpsRel = 1.0e-5;
+constexpr double kEpsilon = 1.0e-12;
+
+double InfNorm(const std::vector<double>& v) {
+  double norm = 0.0;
+  for (const double value : v) {
+    norm = std::max(norm, std::abs(value));
+  }
+  return norm;
+}
+
+}  // namespace
+
+bool FemPosDeviationAdmmInterface::Solve() {
+  // Sanity Check
+  if (ref_points_.empty()) {
+    AERROR << "reference points empty, solver early terminates";
+    return false;
+  }
+
+  if (ref_points_.size() != bounds_around_refs_.size()) {
+    AERROR << "ref_points and bounds size not equal, solver early terminates";
+    return false;
+  }
+
+  if (ref_points_.size() < 3) {
+    AERROR << "ref_points size smaller than 3, solver early terminates";
+    return false;
+  }
+
+  if (ref_points_.size() > std::numeric_limits<int>::max()) {
+    AERROR << "ref_points size too large, solver early terminates";
+    return false;
+  }
+
+  num_of_points_ = static_cast<int>(ref_points_.size());
+  CalculateKernel();
+
+  // The cost only depends on point differences and on the deviation from the
+  // reference points, so solve around the centroid to keep map coordinates
+  // from swamping the residuals.
+  double center_x = 0.0;
+  double center_y = 0.0;
+  for (const auto& ref_point_xy : ref_points_) {
+    center_x += ref_point_xy.first;
+    center_y += ref_point_xy.second;
+  }
+  center_x /= num_of_points_;
+  center_y /= num_of_points_;
+
+  std::vector<double> ref(num_of_points_);
+  std::vector<double> lower_bounds(num_of_points_);
+  std::vector<double> upper_bounds(num_of_points_);
+
+  for (int i = 0; i < num_of_points_; ++i) {
+    ref[i] = ref_points_[i].first - center_x;
+    lower_bounds[i] = ref[i] - bounds_around_refs_[i];
+    upper_bounds[i] = ref[i] + bounds_around_refs_[i];
+  }
+  if (!SolveCoordinate(ref, lower_bounds, upper_bounds, &x_)) {
+    AERROR << "Failed to find solution of x.";
+    return false;
+  }
+
+  for (int i = 0; i < num_of_points_; ++i) {
+    ref[i] = ref_points_[i].second - center_y;
+    lower_bounds[i] = ref[i] - bounds_around_refs_[i];
+    upper_bounds[i] = ref[i] + bounds_around_refs_[i];
+  }
+  if (!SolveCoordinate(ref, lower_bounds, upper_bounds, &y_)) {
+    AERROR << "Failed to find solution of y.";
+    return false;
+  }
+
+  for (int i = 0; i < num_of_points_; ++i) {
+    x_[i] += center_x;
+    y_[i] += center_y;
+  }
+  return true;
+}
+
+void FemPosDeviationAdmmInterface::CalculateKernel() {
+  const int n = num_of_points_;
+  p_diag_.assign(n, 0.0);
+  p_off1_.assign(n, 0.0);
+  p_off2_.assign(n, 0.0);
+
+  // 1. Penalty on distance between middle point and point by finite element
+  // estimate, (p[i - 1] - 2 * p[i] + p[i + 1])^2
+  for (int i = 1; i + 1 < n; ++i) {
+    p_diag_[i - 1] += weight_fem_pos_deviation_;
+    p_diag_[i] += 4.0 * weight_fem_pos_deviation_;
+    p_diag_[i + 1] += weight_fem_pos_deviation_;
+    p_off1_[i - 1] += -2.0 * weight_fem_pos_deviation_;
+    p_off1_[i] += -2.0 * weight_fem_pos_deviation_;
+    p_off2_[i - 1] += weight_fem_pos_deviation_;
+  }
+
+  // 2. Penalty on path length, (p[i + 1] - p[i])^2
+  for (int i = 0; i + 1 < n; ++i) {
+    p_diag_[i] += weight_path_length_;
+    p_diag_[i + 1] += weight_path_length_;
+    p_off1_[i] += -weight_path_length_;
+  }
+
+  // 3. Penalty on difference between points and reference points
+  for (int i = 0; i < n; ++i) {
+    p_diag_[i] += weight_ref_deviation_;
+  }
+
+  // Rescale by 2.0 as the quadratic term is (1/2) * x' * P * x, then
+  // normalize the cost so that the largest diagonal entry is 1.0. This does
+  // not move the optimum, and keeps the admm penalty independent of the
+  // weights.
+  double max_diag = 0.0;
+  for (const double value : p_diag_) {
+    max_diag = std::max(max_diag, 2.0 * value);
+  }
+  cost_scale_ = max_diag > kEpsilon ? 1.0 / max_diag : 1.0;
+  for (int i = 0; i < n; ++i) {
+    p_diag_[i] *= 2.0 * cost_scale_;
+    p_off1_[i] *= 2.0 * cost_scale_;
+    p_off2_[i] *= 2.0 * cost_scale_;
+  }
+}
+
+bool FemPosDeviationAdmmInterface::Factorize(const double shift) {
+  const int n = num_of_points_;
+  l1_.assign(n, 0.0);
+  l2_.assign(n, 0.0);
+  d_.assign(n, 0.0);
+  for (int i = 0; i < n; ++i) {
+    double d = p_diag_[i] + shift;
+    if (i >= 2) {
+      l2_[i] = p_off2_[i - 2] / d_[i - 2];
+      d -= l2_[i] * l2_[i] * d_[i - 2];
+    }
+    if (i >= 1) {
+      double a = p_off1_[i - 1];
+      if (i >= 2) {
+        a -= l2_[i] * l1_[i - 1] * d_[i - 2];
+      }
+      l1_[i] = a / d_[i - 1];
+      d -= l1_[i] * l1_[i] * d_[i - 1];
+    }
+    if (d <= kEpsilon) {
+      return false;
+    }
+    d_[i] = d;
+  }
+  return true;
+}
+
+void FemPosDeviationAdmmInterface::SolveFactorized(
+    std::vector<double>* rhs) const {
+  auto& b = *rhs;
+  const int n = num_of_points_;
+  for (int i = 1; i < n; ++i) {
+    b[i] -= l1_[i] * b[i - 1];
+    if (i >= 2) {
+      b[i] -= l2_[i] * b[i - 2];
+    }
+  }
+  for (int i = 0; i < n; ++i) {
+    b[i] /= d_[i];
+  }
+  for (int i = n - 2; i >= 0; --i) {
+    b[i] -= l1_[i + 1] * b[i + 1];
+    if (i + 2 < n) {
+      b[i] -= l2_[i + 2] * b[i + 2];
+    }
+  }
+}
+
+void FemPosDeviationAdmmInterface::MultiplyKernel(
+    const std::vector<double>& x, std::vector<double>* result) const {
+  const int n = num_of_points_;
+  result->assign(n, 0.0);
+  auto& r = *result;
+  for (int i = 0; i < n; ++i) {
+    r[i] += p_diag_[i] * x[i];
+    if (i + 1 < n) {
+      r[i] += p_off1_[i] * x[i + 1];
+      r[i + 1] += p_off1_[i] * x[i];
+    }
+    if (i + 2 < n) {
+      r[i] += p_off2_[i] * x[i + 2];
+      r[i + 2] += p_off2_[i] * x[i];
+    }
+  }
+}
+
+bool FemPosDeviationAdmmInterface::SolveCoordinate(
+    const std::vector<double>& ref, const std::vector<double>& lower_bounds,
+    const std::vector<double>& upper_bounds, std::vector<double>* opt) {
+  const int n = num_of_points_;
+  std::vector<double> q(n);
+  for (int i = 0; i < n; ++i) {
+    q[i] = -2.0 * weight_ref_deviation_ * cost_scale_ * ref[i];
+  }
+
+  // The unconstrained optimum is a single banded solve, and is the answer
+  // whenever it already stays within the bounds.
+  if (Factorize(0.0)) {
+    std::vector<double> unconstrained(n);
+    for (int i = 0; i < n; ++i) {
+      unconstrained[i] = -q[i];
+    }
+    SolveFactorized(&unconstrained);
+    bool is_within_bounds = true;
+    for (int i = 0; i < n; ++i) {
+      if (unconstrained[i] < lower_bounds[i] ||
+          unconstrained[i] > upper_bounds[i]) {
+        is_within_bounds = false;
+        break;
+      }
+    }
+    if (is_within_bounds) {
+      *opt = std::move(unconstrained);
+      return true;
+    }
+  }
+
+  // Admm on min 0.5 * x' * P * x + q' * x, s.t. l <= z <= u, x = z, warm
+  // started from the reference points.
+  std::vector<double> x(n);
+  for (int i = 0; i < n; ++i) {
+    x[i] = std::min(std::max(ref[i], lower_bounds[i]), upper_bounds[i]);
+  }
+  std::vector<double> z = x;
+  std::vector<double> y(n, 0.0);
+  std::vector<double> x_tilde(n);
+  std::vector<double> Px(n);
+
+  double rho = kInitialRho;
+  if (!Factorize(kSigma + rho)) {
+    AERROR << "Failed to factorize the kernel";
+    return false;
+  }
+
+  for (int iter = 1; iter <= max_iter_; ++iter) {
+    for (int i = 0; i < n; ++i) {
+      x_tilde[i] = kSigma * x[i] - q[i] + rho * z[i] - y[i];
+    }
+    SolveFactorized(&x_tilde);
+    for (int i = 0; i < n; ++i) {
+      const double relaxed = kAlpha * x_tilde[i] + (1.0 - kAlpha) * z[i];
+      x[i] = kAlpha * x_tilde[i] + (1.0 - kAlpha) * x[i];
+      z[i] = std::min(std::max(relaxed + y[i] / rho, lower_bounds[i]),
+                      upper_bounds[i]);
+      y[i] += rho * (relaxed - z[i]);
+    }
+
+    if (iter % kCheckTerminationInterval != 0) {
+      continue;
+    }
+    MultiplyKernel(x, &Px);
+    double prim_res = 0.0;
+    double dual_res = 0.0;
+    for (int i = 0; i < n; ++i) {
+      prim_res = std::max(prim_res, std::abs(x[i] - z[i]));
+      dual_res = std::max(dual_res, std::abs(Px[i] + q[i] + y[i]));
+    }
+    const double prim_scale = std::max(InfNorm(x), InfNorm(z));
+    const double dual_scale =
+        std::max(std::max(InfNorm(Px), InfNorm(y)), InfNorm(q));
+    if (prim_res <= kEpsAbs + kEpsRel * prim_scale &&
+        dual_res <= kEpsAbs + kEpsRel * dual_scale) {
+      ADEBUG << "admm converged in " << iter << " iterations";
+      *opt = std::move(z);
+      return true;
+    }
+
+    if (iter % kAdaptiveRhoInterval != 0) {
+      continue;
+    }
+    const double new_rho = std::min(
+        std::max(rho * std::sqrt((prim_res / (prim_scale + kEpsilon)) /
+                                 (dual_res / (dual_scale + kEpsilon) +
+                                  kEpsilon)),
+                 kMinRho),
+        kMaxRho);
+    if (new_rho > rho * kRhoUpdateTolerance ||
+        new_rho < rho / kRhoUpdateTolerance) {
+      rho = new_rho;
+      if (!Factorize(kSigma + rho)) {
+        AERROR << "Failed to factorize the kernel";
+        return false;
+      }
+    }
+  }
+
+  AERROR << "admm did not converge in " << max_iter_ << " iterations";
+  return false;
+}
+
+}  // namespace planning
+}  // namespace apollo
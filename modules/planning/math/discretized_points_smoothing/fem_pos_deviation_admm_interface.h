@@ -0,0 +1,123 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#pragma once
+
+#include <utility>
+#include <vector>
+
+namespace apollo {
+namespace planning {
+
+/*
+ * @brief:
+ * Solves the same box constrained qp as FemPosDeviationOsqpInterface. The x
+ * and y coordinates do not interact, and the kernel of each of them is
+ * pentadiagonal, so every linear system is solved with a banded LDL^T in
+ * O(n). Box constraints are handled by ADMM in the form osqp uses, with the
+ * constraint matrix being the identity.
+ */
+class FemPosDeviationAdmmInterface {
+ public:
+  FemPosDeviationAdmmInterface() = default;
+
+  virtual ~FemPosDeviationAdmmInterface() = default;
+
+  void set_ref_points(
+      const std::vector<std::pair<double, double>>& ref_points) {
+    ref_points_ = ref_points;
+  }
+
+  void set_bounds_around_refs(const std::vector<double>& bounds_around_refs) {
+    bounds_around_refs_ = bounds_around_refs;
+  }
+
+  void set_weight_fem_pos_deviation(const double weight_fem_pos_deviation) {
+    weight_fem_pos_deviation_ = weight_fem_pos_deviation;
+  }
+
+  void set_weight_path_length(const double weight_path_length) {
+    weight_path_length_ = weight_path_length;
+  }
+
+  void set_weight_ref_deviation(const double weight_ref_deviation) {
+    weight_ref_deviation_ = weight_ref_deviation;
+  }
+
+  void set_max_iter(const int max_iter) { max_iter_ = max_iter; }
+
+  bool Solve();
+
+  const std::vector<double>& opt_x() const { return x_; }
+
+  const std::vector<double>& opt_y() const { return y_; }
+
+ private:
+  // Normalized kernel of one coordinate, in the 0.5 * x' * P * x form of osqp
+  void CalculateKernel();
+
+  // Factorizes P + shift * I into l1_, l2_ and d_
+  bool Factorize(const double shift);
+
+  // Solves (P + shift * I) * x = rhs with the last factorization, in place
+  void SolveFactorized(std::vector<double>* rhs) const;
+
+  void MultiplyKernel(const std::vector<double>& x,
+                      std::vector<double>* result) const;
+
+  bool SolveCoordinate(const std::vector<double>& ref,
+                       const std::vector<double>& lower_bounds,
+                       const std::vector<double>& upper_bounds,
+                       std::vector<double>* opt);
+
+ private:
+  // Reference points and deviation bounds
+  std::vector<std::pair<double, double>> ref_points_;
+  std::vector<double> bounds_around_refs_;
+
+  // Weights in optimization cost function
+  double weight_fem_pos_deviation_ = 1.0e5;
+  double weight_path_length_ = 1.0;
+  double weight_ref_deviation_ = 1.0;
+
+  int max_iter_ = 4000;
+
+  int num_of_points_ = 0;
+
+  // Factor the cost is normalized by
+  double cost_scale_ = 1.0;
+
+  // Pentadiagonal kernel: diagonal, first and second super diagonals
+  std::vector<double> p_diag_;
+  std::vector<double> p_off1_;
+  std::vector<double> p_off2_;
+
+  // Unit lower triangular factor (first and second sub diagonals) and the
+  // diagonal of the last LDL^T factorization
+  std::vector<double> l1_;
+  std::vector<double> l2_;
+  std::vector<double> d_;
+
+  // Optimized_result
+  std::vector<double> x_;
+  std::vector<double> y_;
+};
+}  // namespace planning
+}  // namespace apollo
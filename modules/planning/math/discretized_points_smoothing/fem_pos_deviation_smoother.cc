@@ -24,6 +24,8 @@
 #include <coin/IpSolveStatistics.hpp>
 
 #include "cyber/common/log.h"
+#include "modules/planning/common/planning_gflags.h"
+#include "modules/planning/math/discretized_points_smoothing/fem_pos_deviation_admm_interface.h"
 #include "modules/planning/math/discretized_points_smoothing/fem_pos_deviation_ipopt_interface.h"
 #include "modules/planning/math/discretized_points_smoothing/fem_pos_deviation_osqp_interface.h"
 #include "modules/planning/math/discretized_points_smoothing/fem_pos_deviation_sqp_osqp_interface.h"
@@ -44,6 +46,8 @@ bool FemPosDeviationSmoother::Solve(
     } else {
       return NlpWithIpopt(raw_point2d, bounds, opt_x, opt_y);
     }
+  } else if (FLAGS_use_banded_fem_pos_deviation_solver) {
+    return QpWithBandedAdmm(raw_point2d, bounds, opt_x, opt_y);
   } else {
     return QpWithOsqp(raw_point2d, bounds, opt_x, opt_y);
   }
@@ -83,6 +87,35 @@ bool FemPosDeviationSmoother::QpWithOsqp(
   return true;
 }
 
+bool FemPosDeviationSmoother::QpWithBandedAdmm(
+    const std::vector<std::pair<double, double>>& raw_point2d,
+    const std::vector<double>& bounds, std::vector<double>* opt_x,
+    std::vector<double>* opt_y) {
+  if (opt_x == nullptr || opt_y == nullptr) {
+    AERROR << "opt_x or opt_y is nullptr";
+    return false;
+  }
+
+  FemPosDeviationAdmmInterface solver;
+
+  solver.set_weight_fem_pos_deviation(config_.weight_fem_pos_deviation());
+  solver.set_weight_path_length(config_.weight_path_length());
+  solver.set_weight_ref_deviation(config_.weight_ref_deviation());
+
+  solver.set_max_iter(config_.max_iter());
+
+  solver.set_ref_points(raw_point2d);
+  solver.set_bounds_around_refs(bounds);
+
+  if (!solver.Solve()) {
+    return false;
+  }
+
+  *opt_x = solver.opt_x();
+  *opt_y = solver.opt_y();
+  return true;
+}
+
 bool FemPosDeviationSmoother::SqpWithOsqp(
     const std::vector<std::pair<double, double>>& raw_point2d,
     const std::vector<double>& bounds, std::vector<double>* opt_x,
@@ -56,6 +56,11 @@ class FemPosDeviationSmoother {
                   const std::vector<double>& bounds, std::vector<double>* opt_x,
                   std::vector<double>* opt_y);
 
+  bool QpWithBandedAdmm(
+      const std::vector<std::pair<double, double>>& raw_point2d,
+      const std::vector<double>& bounds, std::vector<double>* opt_x,
+      std::vector<double>* opt_y);
+
   bool NlpWithIpopt(const std::vector<std::pair<double, double>>& raw_point2d,
                     const std::vector<double>& bounds,
                     std::vector<double>* opt_x, std::vector<double>* opt_y);
@@ -18,6 +18,7 @@
 
 #include "cyber/common/log.h"
 #include "modules/planning/common/planning_gflags.h"
+#include "modules/planning/common/planning_profiler.h"
 
 namespace apollo {
 namespace planning {
@@ -26,6 +27,25 @@ namespace {
 constexpr double kMaxVariableRange = 1.0e10;
 }  // namespace
 
+PiecewiseJerkWorkspace::~PiecewiseJerkWorkspace() { Reset(); }
+
+void PiecewiseJerkWorkspace::Reset() {
+  if (work_ != nullptr) {
+    osqp_cleanup(work_);
+    work_ = nullptr;
+  }
+  P_data_.clear();
+  P_indices_.clear();
+  P_indptr_.clear();
+  A_data_.clear();
+  A_indices_.clear();
+  A_indptr_.clear();
+  delta_s_ = 0.0;
+  x_.clear();
+  dx_.clear();
+  ddx_.clear();
+}
+
 PiecewiseJerkProblem::PiecewiseJerkProblem(
     const size_t num_of_knots, const double delta_s,
     const std::array<double, 3>& x_init) {
@@ -88,16 +108,28 @@ OSQPData* PiecewiseJerkProblem::FormulateProblem() {
 }
 
 bool PiecewiseJerkProblem::Optimize(const int max_iter) {
+  if (workspace_ != nullptr) {
+    return OptimizeWithWorkspace(max_iter);
+  }
+
   OSQPData* data = FormulateProblem();
 
   OSQPSettings* settings = SolverDefaultSettings();
   settings->max_iter = max_iter;
 
   OSQPWorkspace* osqp_work = nullptr;
-  osqp_work = osqp_setup(data, settings);
-  // osqp_setup(&osqp_work, data, settings);
+  {
+    ScopedPlanningProfile setup_profile("osqp_setup",
+                                        PlanningProfileSpan::STEP);
+    osqp_work = osqp_setup(data, settings);
+    // osqp_setup(&osqp_work, data, settings);
+  }
 
-  osqp_solve(osqp_work);
+  {
+    ScopedPlanningProfile solve_profile("osqp_solve",
+                                        PlanningProfileSpan::STEP);
+    osqp_solve(osqp_work);
+  }
 
   auto status = osqp_work->info->status_val;
 
@@ -116,15 +148,7 @@ bool PiecewiseJerkProblem::Optimize(const int max_iter) {
   }
 
   // extract primal results
-  x_.resize(num_of_knots_);
-  dx_.resize(num_of_knots_);
-  ddx_.resize(num_of_knots_);
-  for (size_t i = 0; i < num_of_knots_; ++i) {
-    x_.at(i) = osqp_work->solution->x[i] / scale_factor_[0];
-    dx_.at(i) = osqp_work->solution->x[i + num_of_knots_] / scale_factor_[1];
-    ddx_.at(i) =
-        osqp_work->solution->x[i + 2 * num_of_knots_] / scale_factor_[2];
-  }
+  ExtractSolution(osqp_work->solution->x);
 
   // Cleanup
   osqp_cleanup(osqp_work);
@@ -133,6 +157,173 @@ bool PiecewiseJerkProblem::Optimize(const int max_iter) {
   return true;
 }
 
+bool PiecewiseJerkProblem::OptimizeWithWorkspace(const int max_iter) {
+  std::vector<c_float> P_data;
+  std::vector<c_int> P_indices;
+  std::vector<c_int> P_indptr;
+  CalculateKernel(&P_data, &P_indices, &P_indptr);
+
+  std::vector<c_float> A_data;
+  std::vector<c_int> A_indices;
+  std::vector<c_int> A_indptr;
+  std::vector<c_float> lower_bounds;
+  std::vector<c_float> upper_bounds;
+  CalculateAffineConstraint(&A_data, &A_indices, &A_indptr, &lower_bounds,
+                            &upper_bounds);
+  CHECK_EQ(lower_bounds.size(), upper_bounds.size());
+
+  std::vector<c_float> q;
+  CalculateOffset(&q);
+
+  PiecewiseJerkWorkspace* workspace = workspace_;
+  const bool same_pattern = workspace->initialized() &&
+                            P_indices == workspace->P_indices_ &&
+                            P_indptr == workspace->P_indptr_ &&
+                            A_indices == workspace->A_indices_ &&
+                            A_indptr == workspace->A_indptr_;
+  if (!same_pattern) {
+    workspace->Reset();
+
+    const size_t kernel_dim = 3 * num_of_knots_;
+    const size_t num_affine_constraint = lower_bounds.size();
+    OSQPData* data = reinterpret_cast<OSQPData*>(c_malloc(sizeof(OSQPData)));
+    data->n = kernel_dim;
+    data->m = num_affine_constraint;
+    data->P = csc_matrix(kernel_dim, kernel_dim, P_data.size(),
+                         CopyData(P_data), CopyData(P_indices),
+                         CopyData(P_indptr));
+    data->q = CopyData(q);
+    data->A =
+        csc_matrix(num_affine_constraint, kernel_dim, A_data.size(),
+                   CopyData(A_data), CopyData(A_indices), CopyData(A_indptr));
+    data->l = CopyData(lower_bounds);
+    data->u = CopyData(upper_bounds);
+
+    OSQPSettings* settings = SolverDefaultSettings();
+    settings->max_iter = max_iter;
+    settings->warm_start = true;
+
+    // osqp_setup() keeps its own copies of the data and the settings
+    {
+      ScopedPlanningProfile setup_profile("osqp_setup",
+                                          PlanningProfileSpan::STEP);
+      workspace->work_ = osqp_setup(data, settings);
+    }
+    FreeData(data);
+    c_free(data->A);
+    c_free(data->P);
+    c_free(data);
+    c_free(settings);
+    if (workspace->work_ == nullptr) {
+      AERROR << "Failed to set up the osqp workspace";
+      return false;
+    }
+    workspace->P_data_ = std::move(P_data);
+    workspace->P_indices_ = std::move(P_indices);
+    workspace->P_indptr_ = std::move(P_indptr);
+    workspace->A_data_ = std::move(A_data);
+    workspace->A_indices_ = std::move(A_indices);
+    workspace->A_indptr_ = std::move(A_indptr);
+  } else {
+    OSQPWorkspace* work = workspace->work_;
+    // updating P or A refactorizes the KKT system, skip it when possible
+    if (P_data != workspace->P_data_ || A_data != workspace->A_data_) {
+      osqp_update_P_A(work, P_data.data(), OSQP_NULL,
+                      static_cast<c_int>(P_data.size()), A_data.data(),
+                      OSQP_NULL, static_cast<c_int>(A_data.size()));
+      workspace->P_data_ = std::move(P_data);
+      workspace->A_data_ = std::move(A_data);
+    }
+    osqp_update_lin_cost(work, q.data());
+    if (osqp_update_bounds(work, lower_bounds.data(), upper_bounds.data()) !=
+        0) {
+      AERROR << "Invalid bounds for the osqp workspace";
+      workspace->Reset();
+      return false;
+    }
+    osqp_update_max_iter(work, max_iter);
+
+    std::vector<c_float> primal_warm_start;
+    SetPrimalWarmStart(&primal_warm_start);
+    osqp_warm_start_x(work, primal_warm_start.data());
+  }
+
+  OSQPWorkspace* work = workspace->work_;
+  {
+    ScopedPlanningProfile solve_profile("osqp_solve",
+                                        PlanningProfileSpan::STEP);
+    osqp_solve(work);
+  }
+
+  auto status = work->info->status_val;
+  if (status < 0 || (status != 1 && status != 2)) {
+    AERROR << "failed optimization status:\t" << work->info->status;
+    workspace->Reset();
+    return false;
+  } else if (work->solution == nullptr) {
+    AERROR << "The solution from OSQP is nullptr";
+    workspace->Reset();
+    return false;
+  }
+
+  ExtractSolution(work->solution->x);
+  workspace->delta_s_ = delta_s_;
+  workspace->x_ = x_;
+  workspace->dx_ = dx_;
+  workspace->ddx_ = ddx_;
+  return true;
+}
+
+void PiecewiseJerkProblem::SetPrimalWarmStart(
+    std::vector<c_float>* primal_warm_start) const {
+  const PiecewiseJerkWorkspace& workspace = *workspace_;
+  CHECK_GT(workspace.x_.size(), 1);
+  CHECK_GT(workspace.delta_s_, 0.0);
+
+  // linear interpolation of the previous solution at knot position pos
+  const double max_pos = static_cast<double>(workspace.x_.size() - 1);
+  auto sample = [max_pos](const std::vector<double>& values,
+                          const double pos) {
+    if (pos <= 0.0) {
+      return values.front();
+    }
+    if (pos >= max_pos) {
+      return values.back();
+    }
+    const size_t index = static_cast<size_t>(pos);
+    const double ratio = pos - static_cast<double>(index);
+    return values[index] + ratio * (values[index + 1] - values[index]);
+  };
+
+  const size_t n = num_of_knots_;
+  const double x_offset =
+      x_init_[0] -
+      sample(workspace.x_, warm_start_shift_ / workspace.delta_s_);
+  primal_warm_start->resize(3 * n);
+  for (size_t i = 0; i < n; ++i) {
+    const double pos =
+        (static_cast<double>(i) * delta_s_ + warm_start_shift_) /
+        workspace.delta_s_;
+    (*primal_warm_start)[i] =
+        (sample(workspace.x_, pos) + x_offset) * scale_factor_[0];
+    (*primal_warm_start)[n + i] =
+        sample(workspace.dx_, pos) * scale_factor_[1];
+    (*primal_warm_start)[2 * n + i] =
+        sample(workspace.ddx_, pos) * scale_factor_[2];
+  }
+}
+
+void PiecewiseJerkProblem::ExtractSolution(const c_float* solution) {
+  x_.resize(num_of_knots_);
+  dx_.resize(num_of_knots_);
+  ddx_.resize(num_of_knots_);
+  for (size_t i = 0; i < num_of_knots_; ++i) {
+    x_.at(i) = solution[i] / scale_factor_[0];
+    dx_.at(i) = solution[i + num_of_knots_] / scale_factor_[1];
+    ddx_.at(i) = solution[i + 2 * num_of_knots_] / scale_factor_[2];
+  }
+}
+
 void PiecewiseJerkProblem::CalculateAffineConstraint(
     std::vector<c_float>* A_data, std::vector<c_int>* A_indices,
     std::vector<c_int>* A_indptr, std::vector<c_float>* lower_bounds,
@@ -20,6 +20,7 @@
 
 #pragma once
 
+#include <array>
 #include <tuple>
 #include <utility>
 #include <vector>
@@ -29,6 +30,48 @@
 namespace apollo {
 namespace planning {
 
+/*
+ * @brief:
+ * Keeps an OSQP workspace alive across PiecewiseJerkProblem::Optimize() calls.
+ * As long as the number of knots, hence the sparsity pattern, stays the same,
+ * the next problem only pushes the changed P/A values, q and the bounds into
+ * the workspace instead of setting it up again, and is warm started from the
+ * previous solution shifted by PiecewiseJerkProblem::set_warm_start_shift().
+ * A workspace must only be used by one problem at a time.
+ */
+class PiecewiseJerkWorkspace {
+ public:
+  PiecewiseJerkWorkspace() = default;
+
+  PiecewiseJerkWorkspace(const PiecewiseJerkWorkspace&) = delete;
+
+  PiecewiseJerkWorkspace& operator=(const PiecewiseJerkWorkspace&) = delete;
+
+  ~PiecewiseJerkWorkspace();
+
+  void Reset();
+
+  bool initialized() const { return work_ != nullptr; }
+
+ private:
+  friend class PiecewiseJerkProblem;
+
+  OSQPWorkspace* work_ = nullptr;
+
+  std::vector<c_float> P_data_;
+  std::vector<c_int> P_indices_;
+  std::vector<c_int> P_indptr_;
+  std::vector<c_float> A_data_;
+  std::vector<c_int> A_indices_;
+  std::vector<c_int> A_indptr_;
+
+  // previous solution, unscaled
+  double delta_s_ = 0.0;
+  std::vector<double> x_;
+  std::vector<double> dx_;
+  std::vector<double> ddx_;
+};
+
 /*
  * @brief:
  * This class solve an optimization problem:
@@ -108,6 +151,26 @@ class PiecewiseJerkProblem {
   void set_end_state_ref(const std::array<double, 3>& weight_end_state,
                          const std::array<double, 3>& end_state_ref);
 
+  /**
+   * @brief Solve with a persistent workspace instead of a one-shot one.
+   *
+   * @param workspace: kept by the caller across planning cycles, nullptr to
+   * go back to setting up and cleaning up the solver on every call
+   */
+  void set_workspace(PiecewiseJerkWorkspace* workspace) {
+    workspace_ = workspace;
+  }
+
+  /**
+   * @brief Set where the first knot of this problem lies on the knot axis of
+   * the previous problem solved in the workspace, e.g. the travelled
+   * distance or the elapsed time. The previous solution is sampled from
+   * there to warm start the solver, with x offset to match x_init.
+   */
+  void set_warm_start_shift(const double warm_start_shift) {
+    warm_start_shift_ = warm_start_shift;
+  }
+
   virtual bool Optimize(const int max_iter = 4000);
 
   const std::vector<double>& opt_x() const { return x_; }
@@ -136,6 +199,12 @@ class PiecewiseJerkProblem {
 
   void FreeData(OSQPData* data);
 
+  bool OptimizeWithWorkspace(const int max_iter);
+
+  void SetPrimalWarmStart(std::vector<c_float>* primal_warm_start) const;
+
+  void ExtractSolution(const c_float* solution);
+
   template <typename T>
   T* CopyData(const std::vector<T>& vec) {
     T* data = new T[vec.size()];
@@ -175,6 +244,9 @@ class PiecewiseJerkProblem {
   bool has_end_state_ref_ = false;
   std::array<double, 3> weight_end_state_ = {{0.0, 0.0, 0.0}};
   std::array<double, 3> end_state_ref_;
+
+  PiecewiseJerkWorkspace* workspace_ = nullptr;
+  double warm_start_shift_ = 0.0;
 };
 
 }  // namespace planning
@@ -23,6 +23,7 @@
 #include <vector>
 
 #include "modules/common/math/qp_solver/qp_solver.h"
+#include "modules/planning/math/smoothing_spline/osqp_spline_workspace.h"
 #include "modules/planning/math/smoothing_spline/spline_1d_solver.h"
 #include "osqp/osqp.h"
 
@@ -42,8 +43,7 @@ class OsqpSpline1dSolver : public Spline1dSolver {
 
  private:
   OSQPSettings* settings_ = nullptr;
-  OSQPWorkspace* work_ = nullptr;  // Workspace
-  OSQPData* data_ = nullptr;       // OSQPData
+  OsqpSplineWorkspace workspace_;
 };
 
 }  // namespace planning
@@ -67,6 +67,12 @@ TEST(OsqpSpline1dSolver, one) {
   EXPECT_TRUE(pg.Solve());
   // extract parameters
   auto params = pg.spline();
+
+  // solving again reuses the osqp workspace, warm started
+  EXPECT_TRUE(pg.Solve());
+  for (const double x : x_coord) {
+    EXPECT_NEAR(params(x), pg.spline()(x), 1e-2);
+  }
 }
 
 TEST(OsqpSpline1dSolver, two) {
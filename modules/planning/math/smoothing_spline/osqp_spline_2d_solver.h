@@ -23,6 +23,7 @@
 #include <vector>
 
 #include "gtest/gtest_prod.h"
+#include "modules/planning/math/smoothing_spline/osqp_spline_workspace.h"
 #include "modules/planning/math/smoothing_spline/spline_2d.h"
 #include "modules/planning/math/smoothing_spline/spline_2d_solver.h"
 #include "osqp/osqp.h"
@@ -51,9 +52,7 @@ class OsqpSpline2dSolver final : public Spline2dSolver {
   FRIEND_TEST(OSQPSolverTest, basic_test);
 
  private:
-  OSQPSettings* osqp_settings_ = nullptr;
-  OSQPWorkspace* work_ = nullptr;  // Workspace
-  OSQPData* data_ = nullptr;       // OSQPData
+  OsqpSplineWorkspace workspace_;
 
   int last_num_constraint_ = 0;
   int last_num_param_ = 0;
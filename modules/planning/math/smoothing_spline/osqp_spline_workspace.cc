@@ -0,0 +1,220 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/math/smoothing_spline/osqp_spline_workspace.h"
+
+#include <cmath>
+#include <utility>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace planning {
+namespace {
+
+using Eigen::MatrixXd;
+
+// The entries dropped from the CSC, as DenseToCSCMatrix() drops them.
+constexpr double kZeroEpsilon = 1e-9;
+constexpr double kEqualityEpsilon = 1e-9;
+constexpr double kUpperLimit = 1e9;
+
+void AppendColumn(const MatrixXd& matrix, const int col, const int num_rows,
+                  const int row_offset, std::vector<c_float>* data,
+                  std::vector<c_int>* indices) {
+  for (int r = 0; r < num_rows; ++r) {
+    const double value = matrix(r, col);
+    if (std::fabs(value) < kZeroEpsilon) {
+      continue;
+    }
+    data->push_back(value);
+    indices->push_back(row_offset + r);
+  }
+}
+
+// OSQP only takes the upper triangle of P.
+void UpperTriangleToCSC(const MatrixXd& matrix, std::vector<c_float>* data,
+                        std::vector<c_int>* indices,
+                        std::vector<c_int>* indptr) {
+  indptr->push_back(0);
+  for (int c = 0; c < matrix.cols(); ++c) {
+    AppendColumn(matrix, c, c + 1, 0, data, indices);
+    indptr->push_back(static_cast<c_int>(data->size()));
+  }
+}
+
+void StackedToCSC(const MatrixXd& top, const MatrixXd& bottom,
+                  const int num_cols, std::vector<c_float>* data,
+                  std::vector<c_int>* indices, std::vector<c_int>* indptr) {
+  const int num_top_rows = static_cast<int>(top.rows());
+  indptr->push_back(0);
+  for (int c = 0; c < num_cols; ++c) {
+    AppendColumn(top, c, num_top_rows, 0, data, indices);
+    AppendColumn(bottom, c, static_cast<int>(bottom.rows()), num_top_rows,
+                 data, indices);
+    indptr->push_back(static_cast<c_int>(data->size()));
+  }
+}
+
+}  // namespace
+
+OsqpSplineWorkspace::~OsqpSplineWorkspace() { Reset(); }
+
+void OsqpSplineWorkspace::Reset() {
+  if (work_ != nullptr) {
+    osqp_cleanup(work_);
+    work_ = nullptr;
+  }
+  P_data_.clear();
+  P_indices_.clear();
+  P_indptr_.clear();
+  A_data_.clear();
+  A_indices_.clear();
+  A_indptr_.clear();
+}
+
+bool OsqpSplineWorkspace::Solve(const MatrixXd& kernel, const MatrixXd& offset,
+                                const AffineConstraint& inequality_constraint,
+                                const AffineConstraint& equality_constraint,
+                                const OSQPSettings& settings,
+                                MatrixXd* solution) {
+  // Namings here are following osqp convention.
+  // For details, visit: https://osqp.org/docs/examples/demo.html
+  const MatrixXd& inequality_constraint_matrix =
+      inequality_constraint.constraint_matrix();
+  const MatrixXd& equality_constraint_matrix =
+      equality_constraint.constraint_matrix();
+  const int num_param = static_cast<int>(kernel.rows());
+  const int num_inequality =
+      static_cast<int>(inequality_constraint_matrix.rows());
+  const int num_constraint =
+      num_inequality + static_cast<int>(equality_constraint_matrix.rows());
+  ADEBUG << "P: " << num_param << ", A: " << num_constraint;
+  if (num_param == 0 || num_constraint == 0) {
+    return false;
+  }
+  const bool has_equality = num_constraint > num_inequality;
+  if ((num_inequality > 0 &&
+       inequality_constraint_matrix.cols() != num_param) ||
+      (has_equality && equality_constraint_matrix.cols() != num_param)) {
+    AERROR << "The constraints don't match the " << num_param << " params";
+    return false;
+  }
+
+  std::vector<c_float> P_data;
+  std::vector<c_int> P_indices;
+  std::vector<c_int> P_indptr;
+  UpperTriangleToCSC(kernel, &P_data, &P_indices, &P_indptr);
+
+  std::vector<c_float> A_data;
+  std::vector<c_int> A_indices;
+  std::vector<c_int> A_indptr;
+  StackedToCSC(inequality_constraint_matrix, equality_constraint_matrix,
+               num_param, &A_data, &A_indices, &A_indptr);
+
+  // set q, l, u: l < A < u
+  std::vector<c_float> q(offset.data(), offset.data() + num_param);
+  const MatrixXd& inequality_constraint_boundary =
+      inequality_constraint.constraint_boundary();
+  const MatrixXd& equality_constraint_boundary =
+      equality_constraint.constraint_boundary();
+  std::vector<c_float> l(num_constraint);
+  std::vector<c_float> u(num_constraint);
+  for (int i = 0; i < num_inequality; ++i) {
+    l[i] = inequality_constraint_boundary(i, 0);
+    u[i] = kUpperLimit;
+  }
+  for (int i = num_inequality; i < num_constraint; ++i) {
+    const double boundary = equality_constraint_boundary(i - num_inequality, 0);
+    l[i] = boundary - kEqualityEpsilon;
+    u[i] = boundary + kEqualityEpsilon;
+  }
+
+  const bool same_pattern =
+      work_ != nullptr && work_->data->n == num_param &&
+      work_->data->m == num_constraint && P_indices == P_indices_ &&
+      P_indptr == P_indptr_ && A_indices == A_indices_ && A_indptr == A_indptr_;
+  if (!same_pattern) {
+    Reset();
+    OSQPData data;
+    data.n = num_param;
+    data.m = num_constraint;
+    data.P = csc_matrix(num_param, num_param, P_data.size(), P_data.data(),
+                        P_indices.data(), P_indptr.data());
+    data.q = q.data();
+    data.A = csc_matrix(num_constraint, num_param, A_data.size(),
+                        A_data.data(), A_indices.data(), A_indptr.data());
+    data.l = l.data();
+    data.u = u.data();
+    OSQPSettings workspace_settings = settings;
+    // osqp_setup() keeps its own copies of the data and the settings
+    work_ = osqp_setup(&data, &workspace_settings);
+    c_free(data.A);
+    c_free(data.P);
+    if (work_ == nullptr) {
+      AERROR << "Failed to set up the osqp workspace";
+      return false;
+    }
+    P_data_ = std::move(P_data);
+    P_indices_ = std::move(P_indices);
+    P_indptr_ = std::move(P_indptr);
+    A_data_ = std::move(A_data);
+    A_indices_ = std::move(A_indices);
+    A_indptr_ = std::move(A_indptr);
+  } else {
+    // updating P or A refactorizes the KKT system, skip it when possible
+    if (P_data != P_data_ || A_data != A_data_) {
+      osqp_update_P_A(work_, P_data.data(), OSQP_NULL,
+                      static_cast<c_int>(P_data.size()), A_data.data(),
+                      OSQP_NULL, static_cast<c_int>(A_data.size()));
+      P_data_ = std::move(P_data);
+      A_data_ = std::move(A_data);
+    }
+    osqp_update_lin_cost(work_, q.data());
+    if (osqp_update_bounds(work_, l.data(), u.data()) != 0) {
+      AERROR << "Invalid bounds for the osqp workspace";
+      Reset();
+      return false;
+    }
+  }
+
+  // Solve Problem
+  osqp_solve(work_);
+  if (work_->solution == nullptr) {
+    AERROR << "The solution from OSQP is nullptr";
+    Reset();
+    return false;
+  }
+
+  *solution = MatrixXd::Zero(num_param, 1);
+  for (int i = 0; i < num_param; ++i) {
+    (*solution)(i, 0) = work_->solution->x[i];
+  }
+  // Not to warm start the next solve from a failed one
+  const c_int status = work_->info->status_val;
+  if (status != OSQP_SOLVED && status != OSQP_SOLVED_INACCURATE) {
+    ADEBUG << "osqp status: " << work_->info->status;
+    Reset();
+  }
+  return true;
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -0,0 +1,78 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#pragma once
+
+#include <vector>
+
+#include "Eigen/Core"
+#include "modules/planning/math/smoothing_spline/affine_constraint.h"
+#include "osqp/osqp.h"
+
+namespace apollo {
+namespace planning {
+
+/*
+ * @brief:
+ * Solves the QP of a spline solver with OSQP, and keeps the OSQP workspace
+ * across solves. The kernel and the constraints are converted to CSC column
+ * by column, without stacking the constraint matrices into another dense one.
+ * As long as their sparsity pattern stays the same, which it does for the
+ * same knots and constraint types, the next solve only pushes the changed
+ * values, q and the bounds into the workspace, instead of setting it up and
+ * factorizing the KKT system from scratch, and is warm started from the
+ * previous solution.
+ */
+class OsqpSplineWorkspace {
+ public:
+  OsqpSplineWorkspace() = default;
+
+  OsqpSplineWorkspace(const OsqpSplineWorkspace&) = delete;
+
+  OsqpSplineWorkspace& operator=(const OsqpSplineWorkspace&) = delete;
+
+  ~OsqpSplineWorkspace();
+
+  /*
+   * @brief: minimizes 1/2 x' kernel x + offset' x subject to
+   * inequality_constraint x >= its boundary and equality_constraint x = its
+   * boundary. The settings only take effect when the workspace is set up.
+   */
+  bool Solve(const Eigen::MatrixXd& kernel, const Eigen::MatrixXd& offset,
+             const AffineConstraint& inequality_constraint,
+             const AffineConstraint& equality_constraint,
+             const OSQPSettings& settings, Eigen::MatrixXd* solution);
+
+  // Drops the workspace, so that the next solve sets it up again.
+  void Reset();
+
+ private:
+  OSQPWorkspace* work_ = nullptr;
+  // The CSC of the upper triangle of P and of A in the workspace.
+  std::vector<c_float> P_data_;
+  std::vector<c_int> P_indices_;
+  std::vector<c_int> P_indptr_;
+  std::vector<c_float> A_data_;
+  std::vector<c_int> A_indices_;
+  std::vector<c_int> A_indptr_;
+};
+
+}  // namespace planning
+}  // namespace apollo
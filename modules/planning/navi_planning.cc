@@ -96,6 +96,7 @@ Status NaviPlanning::InitFrame(const uint32_t sequence_num,
                                const VehicleState& vehicle_state) {
   frame_.reset(new Frame(sequence_num, local_view_, planning_start_point,
                          vehicle_state, reference_line_provider_.get()));
+  frame_->set_obstacle_cache(injector_->obstacle_cache());
 
   std::list<ReferenceLine> reference_lines;
   std::list<hdmap::RouteSegments> segments;
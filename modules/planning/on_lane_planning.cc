@@ -138,6 +138,7 @@ Status OnLanePlanning::InitFrame(const uint32_t sequence_num,
   if (frame_ == nullptr) {
     return Status(ErrorCode::PLANNING_ERROR, "Fail to init frame: nullptr.");
   }
+  frame_->set_obstacle_cache(injector_->obstacle_cache());
 
   std::list<ReferenceLine> reference_lines;
   std::list<hdmap::RouteSegments> segments;
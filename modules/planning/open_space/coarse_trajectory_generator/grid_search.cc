@@ -20,6 +20,9 @@
 
 #include "modules/planning/open_space/coarse_trajectory_generator/grid_search.h"
 
+#include <algorithm>
+#include <iterator>
+
 namespace apollo {
 namespace planning {
 
@@ -169,65 +172,258 @@ bool GridSearch::GenerateAStarPath(
   return true;
 }
 
+namespace {
+
+constexpr double kInf = std::numeric_limits<double>::infinity();
+constexpr int kNeighborNum = 8;
+constexpr int kNeighborDx[kNeighborNum] = {0, 1, 1, 1, 0, -1, -1, -1};
+constexpr int kNeighborDy[kNeighborNum] = {1, 1, 0, -1, -1, -1, 0, 1};
+const double kNeighborCost[kNeighborNum] = {1.0, std::sqrt(2.0), 1.0,
+                                            std::sqrt(2.0), 1.0,
+                                            std::sqrt(2.0), 1.0,
+                                            std::sqrt(2.0)};
+
+}  // namespace
+
+bool GridSearch::IsDpGridBlocked(int grid_x, int grid_y) const {
+  // grids are checked at their center
+  const common::math::Vec2d center(
+      XYbounds_[0] + (grid_x + 0.5) * xy_grid_resolution_,
+      XYbounds_[2] + (grid_y + 0.5) * xy_grid_resolution_);
+  for (const auto& obstacle_linesegments : obstacles_linesegments_vec_) {
+    for (const common::math::LineSegment2d& linesegment :
+         obstacle_linesegments) {
+      if (linesegment.DistanceTo(center) < node_radius_) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+void GridSearch::ResetDpMap(int width, int height, size_t goal) {
+  dp_width_ = width;
+  dp_height_ = height;
+  dp_goal_ = goal;
+  dp_bounds_ = XYbounds_;
+  const size_t grid_num = static_cast<size_t>(width) * height;
+  dp_g_.assign(grid_num, kInf);
+  dp_rhs_.assign(grid_num, kInf);
+  dp_blocked_.assign(grid_num, 0);
+  for (int y = 0; y < height; ++y) {
+    for (int x = 0; x < width; ++x) {
+      dp_blocked_[static_cast<size_t>(y) * width + x] = IsDpGridBlocked(x, y);
+    }
+  }
+  // the goal is taken as reachable, as the search is asked to end there
+  dp_blocked_[goal] = 0;
+
+  // plain Dijkstra, leaves every grid with g == rhs
+  dp_queue_.Clear();
+  dp_queue_.Reserve(grid_num);
+  dp_g_[goal] = 0.0;
+  dp_queue_.Push(goal, 0.0);
+  while (!dp_queue_.Empty()) {
+    const size_t index = dp_queue_.Pop();
+    ++dp_updated_num_;
+    const double g = dp_g_[index];
+    dp_rhs_[index] = g;
+    const int x = static_cast<int>(index % width);
+    const int y = static_cast<int>(index / width);
+    for (int i = 0; i < kNeighborNum; ++i) {
+      const int nx = x + kNeighborDx[i];
+      const int ny = y + kNeighborDy[i];
+      if (nx < 0 || nx >= width || ny < 0 || ny >= height) {
+        continue;
+      }
+      const size_t next = static_cast<size_t>(ny) * width + nx;
+      const double cost = g + kNeighborCost[i];
+      if (dp_blocked_[next] || cost >= dp_g_[next]) {
+        continue;
+      }
+      if (dp_queue_.Contains(next)) {
+        dp_queue_.DecreaseKey(next, cost);
+      } else {
+        dp_queue_.Push(next, cost);
+      }
+      dp_g_[next] = cost;
+    }
+  }
+}
+
+void GridSearch::UpdateDpGrid(size_t index) {
+  if (index != dp_goal_) {
+    double rhs = kInf;
+    if (!dp_blocked_[index]) {
+      const int x = static_cast<int>(index % dp_width_);
+      const int y = static_cast<int>(index / dp_width_);
+      for (int i = 0; i < kNeighborNum; ++i) {
+        const int nx = x + kNeighborDx[i];
+        const int ny = y + kNeighborDy[i];
+        if (nx < 0 || nx >= dp_width_ || ny < 0 || ny >= dp_height_) {
+          continue;
+        }
+        const size_t next = static_cast<size_t>(ny) * dp_width_ + nx;
+        if (!dp_blocked_[next]) {
+          rhs = std::min(rhs, dp_g_[next] + kNeighborCost[i]);
+        }
+      }
+    }
+    dp_rhs_[index] = rhs;
+  }
+  if (dp_g_[index] != dp_rhs_[index]) {
+    dp_queue_.Update(index, std::min(dp_g_[index], dp_rhs_[index]));
+  } else {
+    dp_queue_.Remove(index);
+  }
+}
+
+void GridSearch::ComputeDpMap() {
+  // no start to focus on, every inconsistent grid is settled
+  while (!dp_queue_.Empty()) {
+    const size_t index = dp_queue_.Pop();
+    ++dp_updated_num_;
+    if (dp_g_[index] > dp_rhs_[index]) {
+      dp_g_[index] = dp_rhs_[index];
+    } else {
+      dp_g_[index] = kInf;
+      UpdateDpGrid(index);
+    }
+    const int x = static_cast<int>(index % dp_width_);
+    const int y = static_cast<int>(index / dp_width_);
+    for (int i = 0; i < kNeighborNum; ++i) {
+      const int nx = x + kNeighborDx[i];
+      const int ny = y + kNeighborDy[i];
+      if (nx >= 0 && nx < dp_width_ && ny >= 0 && ny < dp_height_) {
+        UpdateDpGrid(static_cast<size_t>(ny) * dp_width_ + nx);
+      }
+    }
+  }
+}
+
+void GridSearch::RepairDpMap(const std::vector<Segment>& segments) {
+  std::vector<Segment> changed;
+  std::set_symmetric_difference(dp_segments_.begin(), dp_segments_.end(),
+                                segments.begin(), segments.end(),
+                                std::back_inserter(changed));
+  if (changed.empty()) {
+    return;
+  }
+
+  // grids whose center is within node_radius_ of the bounding box of a
+  // changed segment
+  std::vector<uint8_t> touched(dp_blocked_.size(), 0);
+  std::vector<size_t> touched_grids;
+  for (const auto& segment : changed) {
+    const double min_x = std::min(segment[0], segment[2]) - node_radius_;
+    const double max_x = std::max(segment[0], segment[2]) + node_radius_;
+    const double min_y = std::min(segment[1], segment[3]) - node_radius_;
+    const double max_y = std::max(segment[1], segment[3]) + node_radius_;
+    const int begin_x = std::max(
+        0, static_cast<int>(std::ceil(
+               (min_x - XYbounds_[0]) / xy_grid_resolution_ - 0.5)));
+    const int end_x = std::min(
+        dp_width_ - 1, static_cast<int>(std::floor(
+                           (max_x - XYbounds_[0]) / xy_grid_resolution_ - 0.5)));
+    const int begin_y = std::max(
+        0, static_cast<int>(std::ceil(
+               (min_y - XYbounds_[2]) / xy_grid_resolution_ - 0.5)));
+    const int end_y = std::min(
+        dp_height_ - 1, static_cast<int>(std::floor(
+                            (max_y - XYbounds_[2]) / xy_grid_resolution_ -
+                            0.5)));
+    for (int y = begin_y; y <= end_y; ++y) {
+      for (int x = begin_x; x <= end_x; ++x) {
+        const size_t index = static_cast<size_t>(y) * dp_width_ + x;
+        if (!touched[index]) {
+          touched[index] = 1;
+          touched_grids.push_back(index);
+        }
+      }
+    }
+  }
+
+  for (const size_t index : touched_grids) {
+    if (index == dp_goal_) {
+      continue;
+    }
+    const uint8_t blocked =
+        IsDpGridBlocked(static_cast<int>(index % dp_width_),
+                        static_cast<int>(index / dp_width_));
+    if (blocked == dp_blocked_[index]) {
+      continue;
+    }
+    dp_blocked_[index] = blocked;
+    // the grid and the edges into it changed
+    UpdateDpGrid(index);
+    const int x = static_cast<int>(index % dp_width_);
+    const int y = static_cast<int>(index / dp_width_);
+    for (int i = 0; i < kNeighborNum; ++i) {
+      const int nx = x + kNeighborDx[i];
+      const int ny = y + kNeighborDy[i];
+      if (nx >= 0 && nx < dp_width_ && ny >= 0 && ny < dp_height_) {
+        UpdateDpGrid(static_cast<size_t>(ny) * dp_width_ + nx);
+      }
+    }
+  }
+  ComputeDpMap();
+}
+
 bool GridSearch::GenerateDpMap(
     const double ex, const double ey, const std::vector<double>& XYbounds,
     const std::vector<std::vector<common::math::LineSegment2d>>&
         obstacles_linesegments_vec) {
-  std::priority_queue<std::pair<std::string, double>,
-                      std::vector<std::pair<std::string, double>>, cmp>
-      open_pq;
-  std::unordered_map<std::string, std::shared_ptr<Node2d>> open_set;
-  dp_map_ = decltype(dp_map_)();
   XYbounds_ = XYbounds;
   // XYbounds with xmin, xmax, ymin, ymax
   max_grid_y_ = std::round((XYbounds_[3] - XYbounds_[2]) / xy_grid_resolution_);
   max_grid_x_ = std::round((XYbounds_[1] - XYbounds_[0]) / xy_grid_resolution_);
-  std::shared_ptr<Node2d> end_node =
-      std::make_shared<Node2d>(ex, ey, xy_grid_resolution_, XYbounds_);
   obstacles_linesegments_vec_ = obstacles_linesegments_vec;
-  open_set.emplace(end_node->GetIndex(), end_node);
-  open_pq.emplace(end_node->GetIndex(), end_node->GetCost());
+  dp_updated_num_ = 0;
 
-  // Grid a star begins
-  size_t explored_node_num = 0;
-  while (!open_pq.empty()) {
-    const std::string current_id = open_pq.top().first;
-    open_pq.pop();
-    std::shared_ptr<Node2d> current_node = open_set[current_id];
-    dp_map_.emplace(current_node->GetIndex(), current_node);
-    std::vector<std::shared_ptr<Node2d>> next_nodes =
-        std::move(GenerateNextNodes(current_node));
-    for (auto& next_node : next_nodes) {
-      if (!CheckConstraints(next_node)) {
-        continue;
-      }
-      if (dp_map_.find(next_node->GetIndex()) != dp_map_.end()) {
-        continue;
-      }
-      if (open_set.find(next_node->GetIndex()) == open_set.end()) {
-        ++explored_node_num;
-        next_node->SetPreNode(current_node);
-        open_set.emplace(next_node->GetIndex(), next_node);
-        open_pq.emplace(next_node->GetIndex(), next_node->GetCost());
-      } else {
-        if (open_set[next_node->GetIndex()]->GetCost() > next_node->GetCost()) {
-          open_set[next_node->GetIndex()]->SetCost(next_node->GetCost());
-          open_set[next_node->GetIndex()]->SetPreNode(current_node);
-        }
-      }
+  const int width = static_cast<int>(max_grid_x_) + 1;
+  const int height = static_cast<int>(max_grid_y_) + 1;
+  const int goal_x = static_cast<int>((ex - XYbounds_[0]) / xy_grid_resolution_);
+  const int goal_y = static_cast<int>((ey - XYbounds_[2]) / xy_grid_resolution_);
+  if (goal_x < 0 || goal_x >= width || goal_y < 0 || goal_y >= height) {
+    AERROR << "end point (" << ex << ", " << ey << ") out of XYbounds";
+    dp_g_.clear();
+    dp_bounds_.clear();
+    return false;
+  }
+  const size_t goal = static_cast<size_t>(goal_y) * width + goal_x;
+
+  std::vector<Segment> segments;
+  for (const auto& obstacle_linesegments : obstacles_linesegments_vec_) {
+    for (const auto& linesegment : obstacle_linesegments) {
+      segments.push_back({linesegment.start().x(), linesegment.start().y(),
+                          linesegment.end().x(), linesegment.end().y()});
     }
   }
-  ADEBUG << "explored node num is " << explored_node_num;
+  std::sort(segments.begin(), segments.end());
+
+  if (dp_g_.empty() || dp_bounds_ != XYbounds_ || dp_width_ != width ||
+      dp_height_ != height || dp_goal_ != goal) {
+    ResetDpMap(width, height, goal);
+  } else {
+    RepairDpMap(segments);
+  }
+  dp_segments_ = std::move(segments);
+  ADEBUG << "dp map updated grid num is " << dp_updated_num_;
   return true;
 }
 
 double GridSearch::CheckDpMap(const double sx, const double sy) {
-  std::string index = Node2d::CalcIndex(sx, sy, xy_grid_resolution_, XYbounds_);
-  if (dp_map_.find(index) != dp_map_.end()) {
-    return dp_map_[index]->GetCost() * xy_grid_resolution_;
-  } else {
-    return std::numeric_limits<double>::infinity();
+  if (dp_g_.empty()) {
+    return kInf;
+  }
+  const int grid_x = static_cast<int>((sx - dp_bounds_[0]) / xy_grid_resolution_);
+  const int grid_y = static_cast<int>((sy - dp_bounds_[2]) / xy_grid_resolution_);
+  if (grid_x < 0 || grid_x >= dp_width_ || grid_y < 0 ||
+      grid_y >= dp_height_) {
+    return kInf;
   }
+  return dp_g_[static_cast<size_t>(grid_y) * dp_width_ + grid_x] *
+         xy_grid_resolution_;
 }
 
 void GridSearch::LoadGridAStarResult(GridAStartResult* result) {
@@ -20,6 +20,8 @@
 
 #pragma once
 
+#include <array>
+#include <cstdint>
 #include <limits>
 #include <memory>
 #include <queue>
@@ -31,6 +33,7 @@
 #include "absl/strings/str_cat.h"
 #include "cyber/common/log.h"
 #include "modules/common/math/line_segment2d.h"
+#include "modules/planning/open_space/coarse_trajectory_generator/indexed_min_heap.h"
 #include "modules/planning/proto/planner_open_space_config.pb.h"
 
 namespace apollo {
@@ -111,11 +114,20 @@ class GridSearch {
       const std::vector<std::vector<common::math::LineSegment2d>>&
           obstacles_linesegments_vec,
       GridAStartResult* result);
+  /**
+   * @brief Obstacle aware cost to go from every grid to (ex, ey). The map is
+   * kept between calls: with the same bounds and goal grid only the grids
+   * near obstacle segments that appeared or disappeared are collision
+   * checked again, and the costs are repaired from there the way D* Lite
+   * repairs them instead of running the whole Dijkstra again.
+   */
   bool GenerateDpMap(
       const double ex, const double ey, const std::vector<double>& XYbounds,
       const std::vector<std::vector<common::math::LineSegment2d>>&
           obstacles_linesegments_vec);
   double CheckDpMap(const double sx, const double sy);
+  // grids whose cost the last GenerateDpMap() call had to (re)compute
+  size_t dp_map_updated_num() const { return dp_updated_num_; }
 
  private:
   double EuclidDistance(const double x1, const double y1, const double x2,
@@ -125,6 +137,14 @@ class GridSearch {
   bool CheckConstraints(std::shared_ptr<Node2d> node);
   void LoadGridAStarResult(GridAStartResult* result);
 
+  // dense DP map
+  using Segment = std::array<double, 4>;
+  void ResetDpMap(int width, int height, size_t goal);
+  void RepairDpMap(const std::vector<Segment>& segments);
+  bool IsDpGridBlocked(int grid_x, int grid_y) const;
+  void UpdateDpGrid(size_t index);
+  void ComputeDpMap();
+
  private:
   double xy_grid_resolution_ = 0.0;
   double node_radius_ = 0.0;
@@ -143,7 +163,19 @@ class GridSearch {
       return left.second >= right.second;
     }
   };
-  std::unordered_map<std::string, std::shared_ptr<Node2d>> dp_map_;
+  // cost to go (g) and one step lookahead (rhs) of every grid in grid units,
+  // row major with dp_width_ grids per row
+  std::vector<double> dp_g_;
+  std::vector<double> dp_rhs_;
+  std::vector<uint8_t> dp_blocked_;
+  IndexedMinHeap dp_queue_;
+  std::vector<double> dp_bounds_;
+  int dp_width_ = 0;
+  int dp_height_ = 0;
+  size_t dp_goal_ = 0;
+  // sorted obstacle segments the map was last computed for
+  std::vector<Segment> dp_segments_;
+  size_t dp_updated_num_ = 0;
 };
 }  // namespace planning
 }  // namespace apollo
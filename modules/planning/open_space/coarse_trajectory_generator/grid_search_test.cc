@@ -0,0 +1,103 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/*
+ * @file
+ */
+
+#include "modules/planning/open_space/coarse_trajectory_generator/grid_search.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace planning {
+
+using apollo::common::math::LineSegment2d;
+using apollo::common::math::Vec2d;
+
+class GridSearchTest : public ::testing::Test {
+ public:
+  virtual void SetUp() {
+    config_.mutable_warm_start_config()->set_grid_a_star_xy_resolution(0.5);
+    config_.mutable_warm_start_config()->set_node_radius(0.8);
+  }
+
+ protected:
+  // a wall at x = wall_x between y = -6 and y = 6
+  static std::vector<std::vector<LineSegment2d>> Wall(double wall_x) {
+    return {{LineSegment2d(Vec2d(wall_x, -6.0), Vec2d(wall_x, 6.0))}};
+  }
+
+  void ExpectSameMap(GridSearch* lhs, GridSearch* rhs) {
+    for (double x = -9.9; x < 10.0; x += 0.5) {
+      for (double y = -9.9; y < 10.0; y += 0.5) {
+        double expected = rhs->CheckDpMap(x, y);
+        double actual = lhs->CheckDpMap(x, y);
+        if (std::isinf(expected)) {
+          EXPECT_TRUE(std::isinf(actual)) << x << ", " << y;
+        } else {
+          EXPECT_NEAR(expected, actual, 1e-9) << x << ", " << y;
+        }
+      }
+    }
+  }
+
+  PlannerOpenSpaceConfig config_;
+  std::vector<double> XYbounds_ = {-10.0, 10.0, -10.0, 10.0};
+};
+
+TEST_F(GridSearchTest, DpMap) {
+  GridSearch grid_search(config_);
+  ASSERT_TRUE(grid_search.GenerateDpMap(5.0, 0.0, XYbounds_, Wall(0.0)));
+  EXPECT_DOUBLE_EQ(0.0, grid_search.CheckDpMap(5.1, 0.1));
+  EXPECT_DOUBLE_EQ(2.0, grid_search.CheckDpMap(7.1, 0.1));
+  // the wall is in the way
+  EXPECT_GT(grid_search.CheckDpMap(-5.0, 0.0), 10.0);
+  EXPECT_TRUE(std::isinf(grid_search.CheckDpMap(0.1, 0.1)));
+  EXPECT_TRUE(std::isinf(grid_search.CheckDpMap(20.0, 0.0)));
+  EXPECT_FALSE(grid_search.GenerateDpMap(15.0, 0.0, XYbounds_, Wall(0.0)));
+}
+
+TEST_F(GridSearchTest, RepairMatchesRebuild) {
+  GridSearch cached(config_);
+  ASSERT_TRUE(cached.GenerateDpMap(5.0, 0.0, XYbounds_, Wall(0.0)));
+  const size_t full_num = cached.dp_map_updated_num();
+
+  // nothing changed, nothing to repair
+  ASSERT_TRUE(cached.GenerateDpMap(5.1, 0.1, XYbounds_, Wall(0.0)));
+  EXPECT_EQ(0, cached.dp_map_updated_num());
+
+  // the wall moves and then goes away
+  for (const auto& obstacles :
+       {Wall(-1.0), Wall(-1.5), std::vector<std::vector<LineSegment2d>>()}) {
+    ASSERT_TRUE(cached.GenerateDpMap(5.0, 0.0, XYbounds_, obstacles));
+    EXPECT_LT(cached.dp_map_updated_num(), full_num);
+    GridSearch rebuilt(config_);
+    ASSERT_TRUE(rebuilt.GenerateDpMap(5.0, 0.0, XYbounds_, obstacles));
+    ExpectSameMap(&cached, &rebuilt);
+  }
+
+  // a wall appears right next to the goal
+  ASSERT_TRUE(cached.GenerateDpMap(5.0, 0.0, XYbounds_, Wall(6.5)));
+  GridSearch rebuilt(config_);
+  ASSERT_TRUE(rebuilt.GenerateDpMap(5.0, 0.0, XYbounds_, Wall(6.5)));
+  ExpectSameMap(&cached, &rebuilt);
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -56,29 +56,44 @@ HybridAStar::HybridAStar(const PlannerOpenSpaceConfig& open_space_conf) {
 }
 
 bool HybridAStar::AnalyticExpansion(std::shared_ptr<Node3d> current_node) {
-  std::shared_ptr<ReedSheppPath> reeds_shepp_to_check =
-      std::make_shared<ReedSheppPath>();
-  if (!reed_shepp_generator_->ShortestRSP(current_node, end_node_,
-                                          reeds_shepp_to_check)) {
+  std::vector<ReedSheppPath> sorted_paths;
+  if (!reed_shepp_generator_->GenerateSortedRSPs(current_node, end_node_,
+                                                 &sorted_paths)) {
     ADEBUG << "ShortestRSP failed";
     return false;
   }
 
-  if (!RSPCheck(reeds_shepp_to_check)) {
-    return false;
-  }
+  // Only candidates that are checked get interpolated, and the first one
+  // that is collision free is taken.
+  const size_t max_candidates =
+      static_cast<size_t>(std::max(1, FLAGS_max_analytic_expansion_candidates));
+  const size_t num_candidates = std::min(sorted_paths.size(), max_candidates);
+  for (size_t i = 0; i < num_candidates; ++i) {
+    std::shared_ptr<ReedSheppPath> reeds_shepp_to_check =
+        std::make_shared<ReedSheppPath>(std::move(sorted_paths[i]));
+    if (!reed_shepp_generator_->InterpolateRSP(current_node, end_node_,
+                                               reeds_shepp_to_check.get())) {
+      ADEBUG << "Interpolating RSP failed";
+      continue;
+    }
 
-  ADEBUG << "Reach the end configuration with Reed Sharp";
-  // load the whole RSP as nodes and add to the close set
-  final_node_ = LoadRSPinCS(reeds_shepp_to_check, current_node);
-  return true;
+    if (!RSPCheck(reeds_shepp_to_check)) {
+      continue;
+    }
+
+    ADEBUG << "Reach the end configuration with Reed Sharp";
+    // load the whole RSP as nodes and add to the close set
+    final_node_ = LoadRSPinCS(reeds_shepp_to_check, current_node);
+    return true;
+  }
+  return false;
 }
 
 bool HybridAStar::RSPCheck(
     const std::shared_ptr<ReedSheppPath> reeds_shepp_to_end) {
-  std::shared_ptr<Node3d> node = std::shared_ptr<Node3d>(new Node3d(
-      reeds_shepp_to_end->x, reeds_shepp_to_end->y, reeds_shepp_to_end->phi,
-      XYbounds_, planner_open_space_config_));
+  std::shared_ptr<Node3d> node = node_pool_.Create(
+      nullptr, reeds_shepp_to_end->x, reeds_shepp_to_end->y,
+      reeds_shepp_to_end->phi, XYbounds_, planner_open_space_config_);
   return ValidityCheck(node);
 }
 
@@ -130,16 +145,17 @@ bool HybridAStar::ValidityCheck(std::shared_ptr<Node3d> node) {
 std::shared_ptr<Node3d> HybridAStar::LoadRSPinCS(
     const std::shared_ptr<ReedSheppPath> reeds_shepp_to_end,
     std::shared_ptr<Node3d> current_node) {
-  std::shared_ptr<Node3d> end_node = std::shared_ptr<Node3d>(new Node3d(
-      reeds_shepp_to_end->x, reeds_shepp_to_end->y, reeds_shepp_to_end->phi,
-      XYbounds_, planner_open_space_config_));
+  std::shared_ptr<Node3d> end_node = node_pool_.Create(
+      nullptr, reeds_shepp_to_end->x, reeds_shepp_to_end->y,
+      reeds_shepp_to_end->phi, XYbounds_, planner_open_space_config_);
   end_node->SetPre(current_node);
-  close_set_.emplace(end_node->GetIndex(), end_node);
+  close_set_.insert(end_node->GetGridIndex());
   return end_node;
 }
 
 std::shared_ptr<Node3d> HybridAStar::Next_node_generator(
-    std::shared_ptr<Node3d> current_node, size_t next_node_index) {
+    std::shared_ptr<Node3d> current_node, size_t next_node_index,
+    size_t* node_id) {
   double steering = 0.0;
   double traveled_distance = 0.0;
   if (next_node_index < static_cast<double>(next_node_num_) / 2) {
@@ -188,9 +204,9 @@ std::shared_ptr<Node3d> HybridAStar::Next_node_generator(
       intermediate_y.back() < XYbounds_[2]) {
     return nullptr;
   }
-  std::shared_ptr<Node3d> next_node = std::shared_ptr<Node3d>(
-      new Node3d(intermediate_x, intermediate_y, intermediate_phi, XYbounds_,
-                 planner_open_space_config_));
+  std::shared_ptr<Node3d> next_node =
+      node_pool_.Create(node_id, intermediate_x, intermediate_y,
+                        intermediate_phi, XYbounds_, planner_open_space_config_);
   next_node->SetPre(current_node);
   next_node->SetDirec(traveled_distance > 0.0);
   next_node->SetSteer(steering);
@@ -637,11 +653,15 @@ bool HybridAStar::Plan(
     const std::vector<double>& XYbounds,
     const std::vector<std::vector<common::math::Vec2d>>& obstacles_vertices_vec,
     HybridAStartResult* result) {
-  // clear containers
+  // clear containers, the nodes of the last plan go with the pool
   open_set_.clear();
   close_set_.clear();
-  open_pq_ = decltype(open_pq_)();
+  open_pq_.Clear();
+  open_nodes_.clear();
+  start_node_ = nullptr;
+  end_node_ = nullptr;
   final_node_ = nullptr;
+  node_pool_.Reset();
 
   std::vector<std::vector<common::math::LineSegment2d>>
       obstacles_linesegments_vec;
@@ -660,10 +680,13 @@ bool HybridAStar::Plan(
   // load XYbounds
   XYbounds_ = XYbounds;
   // load nodes and obstacles
-  start_node_.reset(
-      new Node3d({sx}, {sy}, {sphi}, XYbounds_, planner_open_space_config_));
-  end_node_.reset(
-      new Node3d({ex}, {ey}, {ephi}, XYbounds_, planner_open_space_config_));
+  size_t start_id = 0;
+  start_node_ = node_pool_.Create(
+      &start_id, std::vector<double>{sx}, std::vector<double>{sy},
+      std::vector<double>{sphi}, XYbounds_, planner_open_space_config_);
+  end_node_ = node_pool_.Create(
+      nullptr, std::vector<double>{ex}, std::vector<double>{ey},
+      std::vector<double>{ephi}, XYbounds_, planner_open_space_config_);
   if (!ValidityCheck(start_node_)) {
     ADEBUG << "start_node in collision with obstacles";
     return false;
@@ -677,19 +700,19 @@ bool HybridAStar::Plan(
                                                   obstacles_linesegments_vec_);
   ADEBUG << "map time " << Clock::NowInSeconds() - map_time;
   // load open set, pq
-  open_set_.emplace(start_node_->GetIndex(), start_node_);
-  open_pq_.emplace(start_node_->GetIndex(), start_node_->GetCost());
+  open_set_.emplace(start_node_->GetGridIndex(), 0);
+  open_nodes_.push_back(start_id);
+  open_pq_.Push(0, start_node_->GetCost());
 
   // Hybrid A* begins
   size_t explored_node_num = 0;
   double astar_start_time = Clock::NowInSeconds();
   double heuristic_time = 0.0;
   double rs_time = 0.0;
-  while (!open_pq_.empty()) {
+  while (!open_pq_.Empty()) {
     // take out the lowest cost neighboring node
-    const std::string current_id = open_pq_.top().first;
-    open_pq_.pop();
-    std::shared_ptr<Node3d> current_node = open_set_[current_id];
+    std::shared_ptr<Node3d> current_node =
+        node_pool_.Get(open_nodes_[open_pq_.Pop()]);
     // check if an analystic curve could be connected from current
     // configuration to the end configuration without collision. if so, search
     // ends.
@@ -699,29 +722,39 @@ bool HybridAStar::Plan(
     }
     const double rs_end_time = Clock::NowInSeconds();
     rs_time += rs_end_time - rs_start_time;
-    close_set_.emplace(current_node->GetIndex(), current_node);
+    close_set_.insert(current_node->GetGridIndex());
     for (size_t i = 0; i < next_node_num_; ++i) {
-      std::shared_ptr<Node3d> next_node = Next_node_generator(current_node, i);
+      size_t next_id = 0;
+      std::shared_ptr<Node3d> next_node =
+          Next_node_generator(current_node, i, &next_id);
       // boundary check failure handle
       if (next_node == nullptr) {
         continue;
       }
       // check if the node is already in the close set
-      if (close_set_.find(next_node->GetIndex()) != close_set_.end()) {
+      const uint64_t grid_index = next_node->GetGridIndex();
+      if (close_set_.count(grid_index) > 0) {
         continue;
       }
       // collision check
       if (!ValidityCheck(next_node)) {
         continue;
       }
-      if (open_set_.find(next_node->GetIndex()) == open_set_.end()) {
+      const double start_time = Clock::NowInSeconds();
+      CalculateNodeCost(current_node, next_node);
+      const double end_time = Clock::NowInSeconds();
+      heuristic_time += end_time - start_time;
+      auto open_iter = open_set_.find(grid_index);
+      if (open_iter == open_set_.end()) {
         explored_node_num++;
-        const double start_time = Clock::NowInSeconds();
-        CalculateNodeCost(current_node, next_node);
-        const double end_time = Clock::NowInSeconds();
-        heuristic_time += end_time - start_time;
-        open_set_.emplace(next_node->GetIndex(), next_node);
-        open_pq_.emplace(next_node->GetIndex(), next_node->GetCost());
+        const size_t slot = open_nodes_.size();
+        open_set_.emplace(grid_index, slot);
+        open_nodes_.push_back(next_id);
+        open_pq_.Push(slot, next_node->GetCost());
+      } else if (next_node->GetCost() < open_pq_.Priority(open_iter->second)) {
+        // a cheaper way into a grid that is still queued
+        open_nodes_[open_iter->second] = next_id;
+        open_pq_.DecreaseKey(open_iter->second, next_node->GetCost());
       }
     }
   }
@@ -22,9 +22,9 @@
 
 #include <algorithm>
 #include <memory>
-#include <queue>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -37,7 +37,9 @@
 #include "modules/planning/common/obstacle.h"
 #include "modules/planning/common/planning_gflags.h"
 #include "modules/planning/open_space/coarse_trajectory_generator/grid_search.h"
+#include "modules/planning/open_space/coarse_trajectory_generator/indexed_min_heap.h"
 #include "modules/planning/open_space/coarse_trajectory_generator/node3d.h"
+#include "modules/planning/open_space/coarse_trajectory_generator/node_pool.h"
 #include "modules/planning/open_space/coarse_trajectory_generator/reeds_shepp_path.h"
 #include "modules/planning/proto/planner_open_space_config.pb.h"
 
@@ -76,8 +78,10 @@ class HybridAStar {
   std::shared_ptr<Node3d> LoadRSPinCS(
       const std::shared_ptr<ReedSheppPath> reeds_shepp_to_end,
       std::shared_ptr<Node3d> current_node);
+  // node_id receives the pool id of the generated node
   std::shared_ptr<Node3d> Next_node_generator(
-      std::shared_ptr<Node3d> current_node, size_t next_node_index);
+      std::shared_ptr<Node3d> current_node, size_t next_node_index,
+      size_t* node_id);
   void CalculateNodeCost(std::shared_ptr<Node3d> current_node,
                          std::shared_ptr<Node3d> next_node);
   double TrajCost(std::shared_ptr<Node3d> current_node,
@@ -108,23 +112,21 @@ class HybridAStar {
   double heu_rs_steer_penalty_ = 0.0;
   double heu_rs_steer_change_penalty_ = 0.0;
   std::vector<double> XYbounds_;
+  // every node of the current Plan(), declared before the node handles below
+  // so that they are released before the pool goes away
+  NodePool<Node3d> node_pool_;
   std::shared_ptr<Node3d> start_node_;
   std::shared_ptr<Node3d> end_node_;
   std::shared_ptr<Node3d> final_node_;
   std::vector<std::vector<common::math::LineSegment2d>>
       obstacles_linesegments_vec_;
 
-  struct cmp {
-    bool operator()(const std::pair<std::string, double>& left,
-                    const std::pair<std::string, double>& right) const {
-      return left.second >= right.second;
-    }
-  };
-  std::priority_queue<std::pair<std::string, double>,
-                      std::vector<std::pair<std::string, double>>, cmp>
-      open_pq_;
-  std::unordered_map<std::string, std::shared_ptr<Node3d>> open_set_;
-  std::unordered_map<std::string, std::shared_ptr<Node3d>> close_set_;
+  // open nodes get dense slots, the heap orders the slots by cost and a
+  // cheaper node for an open grid takes over its slot with a decrease-key
+  IndexedMinHeap open_pq_;
+  std::vector<size_t> open_nodes_;  // slot -> pool id
+  std::unordered_map<uint64_t, size_t> open_set_;  // grid index -> slot
+  std::unordered_set<uint64_t> close_set_;
   std::unique_ptr<ReedShepp> reed_shepp_generator_;
   std::unique_ptr<GridSearch> grid_a_star_heuristic_generator_;
 };
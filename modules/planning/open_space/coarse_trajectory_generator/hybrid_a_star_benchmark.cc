@@ -0,0 +1,127 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/*
+ * @file
+ * Times HybridAStar::Plan() on the hybrid_a_star_test scenario and on a
+ * perpendicular parking slot between two parked cars.
+ *
+ *   hybrid_a_star_benchmark [iterations]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "cyber/common/file.h"
+#include "modules/common/math/vec2d.h"
+#include "modules/planning/common/planning_gflags.h"
+#include "modules/planning/open_space/coarse_trajectory_generator/hybrid_a_star.h"
+
+namespace apollo {
+namespace planning {
+
+using apollo::common::math::Vec2d;
+
+struct Scenario {
+  std::string name;
+  double sx, sy, sphi;
+  double ex, ey, ephi;
+  std::vector<double> XYbounds;
+  std::vector<std::vector<Vec2d>> obstacles;
+};
+
+std::vector<Vec2d> Box(double xmin, double xmax, double ymin, double ymax) {
+  return {Vec2d(xmin, ymin), Vec2d(xmax, ymin), Vec2d(xmax, ymax),
+          Vec2d(xmin, ymax), Vec2d(xmin, ymin)};
+}
+
+std::vector<Scenario> Scenarios() {
+  std::vector<Scenario> scenarios;
+  scenarios.push_back({"straight",
+                       -15.0,
+                       0.0,
+                       0.0,
+                       15.0,
+                       0.0,
+                       0.0,
+                       {-50.0, 50.0, -50.0, 50.0},
+                       {{Vec2d(1.0, 0.0), Vec2d(-1.0, 0.0)}}});
+  scenarios.push_back({"perpendicular_parking",
+                       -10.0,
+                       3.0,
+                       0.0,
+                       0.0,
+                       -4.0,
+                       M_PI_2,
+                       {-20.0, 20.0, -8.0, 8.0},
+                       {Box(-5.0, -1.8, -7.0, -1.5), Box(1.8, 5.0, -7.0, -1.5),
+                        Box(-20.0, 20.0, -8.0, -7.6)}});
+  return scenarios;
+}
+
+int Run(int iterations) {
+  PlannerOpenSpaceConfig config;
+  FLAGS_planner_open_space_config_filename =
+      "/apollo/modules/planning/testdata/conf/"
+      "open_space_standard_parking_lot.pb.txt";
+  if (!cyber::common::GetProtoFromFile(
+          FLAGS_planner_open_space_config_filename, &config)) {
+    std::fprintf(stderr, "failed to load %s\n",
+                 FLAGS_planner_open_space_config_filename.c_str());
+    return 1;
+  }
+
+  HybridAStar hybrid_a_star(config);
+  std::printf("%-24s %8s %10s %10s %10s\n", "scenario", "success", "mean(ms)",
+              "min(ms)", "max(ms)");
+  for (const auto& scenario : Scenarios()) {
+    int success = 0;
+    double total = 0.0;
+    double min = 1e9;
+    double max = 0.0;
+    for (int i = 0; i < iterations; ++i) {
+      HybridAStartResult result;
+      auto start = std::chrono::steady_clock::now();
+      if (hybrid_a_star.Plan(scenario.sx, scenario.sy, scenario.sphi,
+                             scenario.ex, scenario.ey, scenario.ephi,
+                             scenario.XYbounds, scenario.obstacles,
+                             &result)) {
+        ++success;
+      }
+      std::chrono::duration<double, std::milli> elapsed =
+          std::chrono::steady_clock::now() - start;
+      total += elapsed.count();
+      min = std::min(min, elapsed.count());
+      max = std::max(max, elapsed.count());
+    }
+    std::printf("%-24s %4d/%-3d %10.2f %10.2f %10.2f\n", scenario.name.c_str(),
+                success, iterations, total / iterations, min, max);
+  }
+  return 0;
+}
+
+}  // namespace planning
+}  // namespace apollo
+
+int main(int argc, char** argv) {
+  int iterations = argc > 1 ? std::max(std::atoi(argv[1]), 1) : 20;
+  return apollo::planning::Run(iterations);
+}
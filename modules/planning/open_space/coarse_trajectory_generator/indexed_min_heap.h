@@ -0,0 +1,181 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/*
+ * @file
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace planning {
+
+/**
+ * @class IndexedMinHeap
+ * @brief Binary min heap over dense ids in [0, n) that remembers where every
+ * id sits, so a queued id can have its priority lowered in place instead of
+ * pushing a duplicate entry.
+ */
+class IndexedMinHeap {
+ public:
+  void Clear() {
+    heap_.clear();
+    position_.clear();
+  }
+
+  void Reserve(size_t num) {
+    heap_.reserve(num);
+    position_.reserve(num);
+  }
+
+  bool Empty() const { return heap_.empty(); }
+  size_t Size() const { return heap_.size(); }
+
+  bool Contains(size_t id) const {
+    return id < position_.size() && position_[id] != kNotQueued;
+  }
+
+  double Priority(size_t id) const {
+    DCHECK(Contains(id));
+    return heap_[position_[id]].first;
+  }
+
+  void Push(size_t id, double priority) {
+    DCHECK(!Contains(id));
+    if (id >= position_.size()) {
+      position_.resize(id + 1, kNotQueued);
+    }
+    position_[id] = heap_.size();
+    heap_.emplace_back(priority, id);
+    SiftUp(heap_.size() - 1);
+  }
+
+  // lowers the priority of a queued id, higher priorities are ignored
+  void DecreaseKey(size_t id, double priority) {
+    DCHECK(Contains(id));
+    size_t pos = position_[id];
+    if (priority >= heap_[pos].first) {
+      return;
+    }
+    heap_[pos].first = priority;
+    SiftUp(pos);
+  }
+
+  // queues id or moves it to its new priority in either direction
+  void Update(size_t id, double priority) {
+    if (!Contains(id)) {
+      Push(id, priority);
+      return;
+    }
+    size_t pos = position_[id];
+    double old_priority = heap_[pos].first;
+    heap_[pos].first = priority;
+    if (priority < old_priority) {
+      SiftUp(pos);
+    } else {
+      SiftDown(pos);
+    }
+  }
+
+  void Remove(size_t id) {
+    if (!Contains(id)) {
+      return;
+    }
+    size_t pos = position_[id];
+    position_[id] = kNotQueued;
+    if (pos + 1 == heap_.size()) {
+      heap_.pop_back();
+      return;
+    }
+    size_t moved = heap_.back().second;
+    Place(pos, heap_.back());
+    heap_.pop_back();
+    SiftUp(pos);
+    SiftDown(position_[moved]);
+  }
+
+  size_t Top() const { return heap_.front().second; }
+
+  size_t Pop() {
+    size_t id = heap_.front().second;
+    position_[id] = kNotQueued;
+    if (heap_.size() > 1) {
+      heap_.front() = heap_.back();
+      position_[heap_.front().second] = 0;
+      heap_.pop_back();
+      SiftDown(0);
+    } else {
+      heap_.pop_back();
+    }
+    return id;
+  }
+
+ private:
+  static constexpr size_t kNotQueued = std::numeric_limits<size_t>::max();
+
+  void Place(size_t pos, const std::pair<double, size_t>& entry) {
+    heap_[pos] = entry;
+    position_[entry.second] = pos;
+  }
+
+  void SiftUp(size_t pos) {
+    auto entry = heap_[pos];
+    while (pos > 0) {
+      size_t parent = (pos - 1) / 2;
+      if (heap_[parent].first <= entry.first) {
+        break;
+      }
+      Place(pos, heap_[parent]);
+      pos = parent;
+    }
+    Place(pos, entry);
+  }
+
+  void SiftDown(size_t pos) {
+    auto entry = heap_[pos];
+    const size_t size = heap_.size();
+    while (true) {
+      size_t child = 2 * pos + 1;
+      if (child >= size) {
+        break;
+      }
+      if (child + 1 < size && heap_[child + 1].first < heap_[child].first) {
+        ++child;
+      }
+      if (entry.first <= heap_[child].first) {
+        break;
+      }
+      Place(pos, heap_[child]);
+      pos = child;
+    }
+    Place(pos, entry);
+  }
+
+  // (priority, id)
+  std::vector<std::pair<double, size_t>> heap_;
+  // id -> index in heap_, kNotQueued once popped
+  std::vector<size_t> position_;
+};
+
+}  // namespace planning
+}  // namespace apollo
@@ -0,0 +1,99 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/*
+ * @file
+ */
+
+#include "modules/planning/open_space/coarse_trajectory_generator/indexed_min_heap.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace planning {
+
+TEST(IndexedMinHeapTest, PopInOrder) {
+  IndexedMinHeap heap;
+  std::mt19937 rng(7);
+  std::uniform_real_distribution<double> dist(0.0, 100.0);
+  std::vector<double> priorities;
+  for (size_t i = 0; i < 200; ++i) {
+    priorities.push_back(dist(rng));
+    heap.Push(i, priorities.back());
+  }
+  EXPECT_EQ(200, heap.Size());
+
+  double last = -1.0;
+  while (!heap.Empty()) {
+    size_t id = heap.Top();
+    EXPECT_EQ(id, heap.Pop());
+    EXPECT_FALSE(heap.Contains(id));
+    EXPECT_LE(last, priorities[id]);
+    last = priorities[id];
+  }
+}
+
+TEST(IndexedMinHeapTest, DecreaseKey) {
+  IndexedMinHeap heap;
+  heap.Push(0, 5.0);
+  heap.Push(1, 3.0);
+  heap.Push(2, 4.0);
+  heap.Push(3, 9.0);
+
+  heap.DecreaseKey(3, 1.0);
+  EXPECT_DOUBLE_EQ(1.0, heap.Priority(3));
+  // raising is not what decrease-key does
+  heap.DecreaseKey(1, 8.0);
+  EXPECT_DOUBLE_EQ(3.0, heap.Priority(1));
+
+  std::vector<size_t> order;
+  while (!heap.Empty()) {
+    order.push_back(heap.Pop());
+  }
+  EXPECT_EQ(std::vector<size_t>({3, 1, 2, 0}), order);
+
+  // popped ids can be queued again after Clear()
+  heap.Clear();
+  EXPECT_FALSE(heap.Contains(3));
+  heap.Push(3, 2.0);
+  EXPECT_TRUE(heap.Contains(3));
+}
+
+TEST(IndexedMinHeapTest, UpdateAndRemove) {
+  IndexedMinHeap heap;
+  for (size_t i = 0; i < 6; ++i) {
+    heap.Push(i, static_cast<double>(i));
+  }
+  heap.Update(0, 10.0);
+  heap.Update(5, -1.0);
+  heap.Update(7, 2.5);
+  heap.Remove(2);
+  heap.Remove(2);
+  EXPECT_FALSE(heap.Contains(2));
+
+  std::vector<size_t> order;
+  while (!heap.Empty()) {
+    order.push_back(heap.Pop());
+  }
+  EXPECT_EQ(std::vector<size_t>({5, 1, 7, 3, 4, 0}), order);
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -57,7 +57,7 @@ Node3d::Node3d(double x, double y, double phi,
   traversed_y_.push_back(y);
   traversed_phi_.push_back(phi);
 
-  index_ = ComputeStringIndex(x_grid_, y_grid_, phi_grid_);
+  grid_index_ = ComputeGridIndex(x_grid_, y_grid_, phi_grid_);
 }
 
 Node3d::Node3d(const std::vector<double>& traversed_x,
@@ -89,7 +89,7 @@ Node3d::Node3d(const std::vector<double>& traversed_x,
   traversed_y_ = traversed_y;
   traversed_phi_ = traversed_phi;
 
-  index_ = ComputeStringIndex(x_grid_, y_grid_, phi_grid_);
+  grid_index_ = ComputeGridIndex(x_grid_, y_grid_, phi_grid_);
   step_size_ = traversed_x.size();
 }
 
@@ -106,12 +106,30 @@ Box2d Node3d::GetBoundingBox(const common::VehicleParam& vehicle_param_,
 }
 
 bool Node3d::operator==(const Node3d& right) const {
-  return right.GetIndex() == index_;
+  return right.GetGridIndex() == grid_index_;
+}
+
+const std::string& Node3d::GetIndex() const {
+  if (index_.empty()) {
+    index_ = ComputeStringIndex(x_grid_, y_grid_, phi_grid_);
+  }
+  return index_;
 }
 
 std::string Node3d::ComputeStringIndex(int x_grid, int y_grid, int phi_grid) {
   return absl::StrCat(x_grid, "_", y_grid, "_", phi_grid);
 }
 
+uint64_t Node3d::ComputeGridIndex(int x_grid, int y_grid, int phi_grid) {
+  // 24 bits for x and y and 16 for phi, biased so that grids just outside
+  // the bounds still get keys of their own
+  constexpr int64_t kXYBias = 1 << 23;
+  constexpr int64_t kPhiBias = 1 << 15;
+  const uint64_t x = static_cast<uint64_t>(x_grid + kXYBias) & 0xFFFFFF;
+  const uint64_t y = static_cast<uint64_t>(y_grid + kXYBias) & 0xFFFFFF;
+  const uint64_t phi = static_cast<uint64_t>(phi_grid + kPhiBias) & 0xFFFF;
+  return x << 40 | y << 16 | phi;
+}
+
 }  // namespace planning
 }  // namespace apollo
@@ -20,6 +20,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
@@ -56,7 +57,10 @@ class Node3d {
   double GetY() const { return y_; }
   double GetPhi() const { return phi_; }
   bool operator==(const Node3d& right) const;
-  const std::string& GetIndex() const { return index_; }
+  // x, y and phi grid packed into one integer, the key of the search sets
+  uint64_t GetGridIndex() const { return grid_index_; }
+  // "x_y_phi" form of the grid, built on first use
+  const std::string& GetIndex() const;
   size_t GetStepSize() const { return step_size_; }
   bool GetDirec() const { return direction_; }
   double GetSteer() const { return steering_; }
@@ -72,6 +76,7 @@ class Node3d {
 
  private:
   static std::string ComputeStringIndex(int x_grid, int y_grid, int phi_grid);
+  static uint64_t ComputeGridIndex(int x_grid, int y_grid, int phi_grid);
 
  private:
   double x_ = 0.0;
@@ -84,7 +89,8 @@ class Node3d {
   int x_grid_ = 0;
   int y_grid_ = 0;
   int phi_grid_ = 0;
-  std::string index_;
+  uint64_t grid_index_ = 0;
+  mutable std::string index_;
   double traj_cost_ = 0.0;
   double heuristic_cost_ = 0.0;
   double cost_ = 0.0;
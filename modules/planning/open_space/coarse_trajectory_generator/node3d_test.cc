@@ -60,5 +60,21 @@ TEST_F(Node3dTest, GetBoundingBox) {
   ASSERT_EQ(test_box.width(), gold_box.width());
 }
 
+TEST_F(Node3dTest, GridIndex) {
+  PlannerOpenSpaceConfig config;
+  config.mutable_warm_start_config()->set_xy_grid_resolution(0.5);
+  config.mutable_warm_start_config()->set_phi_grid_resolution(0.1);
+  std::vector<double> XYbounds = {-10.0, 10.0, -10.0, 10.0};
+  Node3d node_a(1.1, 2.1, 0.3, XYbounds, config);
+  Node3d node_b(1.2, 2.2, 0.31, XYbounds, config);
+  Node3d node_c(1.2, -2.2, 0.31, XYbounds, config);
+  EXPECT_EQ(node_a.GetGridIndex(), node_b.GetGridIndex());
+  EXPECT_TRUE(node_a == node_b);
+  EXPECT_NE(node_a.GetGridIndex(), node_c.GetGridIndex());
+  EXPECT_FALSE(node_a == node_c);
+  EXPECT_EQ("22_24_34", node_a.GetIndex());
+  EXPECT_EQ(node_a.GetIndex(), node_b.GetIndex());
+}
+
 }  // namespace planning
 }  // namespace apollo
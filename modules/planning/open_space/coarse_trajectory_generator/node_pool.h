@@ -0,0 +1,103 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/*
+ * @file
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace planning {
+
+/**
+ * @class NodePool
+ * @brief Arena for the nodes of one search. Nodes are constructed in place
+ * in blocks that are kept across Reset(), and the handles Create() returns
+ * share one control block owned by the pool, so creating a node costs no
+ * allocation for the node or its shared_ptr. Every id returned by Create()
+ * is dense in [0, Size()) and valid until the next Reset().
+ *
+ * Handles do not keep nodes alive: Reset() destroys all of them and checks
+ * that no handle is still held outside the pool.
+ */
+template <typename T>
+class NodePool {
+ public:
+  explicit NodePool(size_t block_size = 1024)
+      : block_size_(block_size), token_(std::make_shared<char>(0)) {}
+
+  ~NodePool() { Destroy(); }
+
+  // id, when not null, receives the dense id of the new node
+  template <typename... Args>
+  std::shared_ptr<T> Create(size_t* id, Args&&... args) {
+    if (size_ == blocks_.size() * block_size_) {
+      blocks_.emplace_back(new Storage[block_size_]);
+    }
+    T* node = new (Slot(size_)) T(std::forward<Args>(args)...);
+    if (id != nullptr) {
+      *id = size_;
+    }
+    ++size_;
+    return std::shared_ptr<T>(token_, node);
+  }
+
+  std::shared_ptr<T> Get(size_t id) const {
+    DCHECK_LT(id, size_);
+    return std::shared_ptr<T>(token_, reinterpret_cast<T*>(Slot(id)));
+  }
+
+  size_t Size() const { return size_; }
+
+  void Reset() {
+    Destroy();
+    ACHECK(token_.use_count() == 1)
+        << "NodePool reset with " << token_.use_count() - 1
+        << " node handles still held";
+  }
+
+ private:
+  using Storage = typename std::aligned_storage<sizeof(T), alignof(T)>::type;
+
+  void* Slot(size_t id) const {
+    return &blocks_[id / block_size_][id % block_size_];
+  }
+
+  void Destroy() {
+    for (size_t i = 0; i < size_; ++i) {
+      reinterpret_cast<T*>(Slot(i))->~T();
+    }
+    size_ = 0;
+  }
+
+  const size_t block_size_;
+  std::vector<std::unique_ptr<Storage[]>> blocks_;
+  size_t size_ = 0;
+  // control block shared by every handle, released with the pool
+  std::shared_ptr<char> token_;
+};
+
+}  // namespace planning
+}  // namespace apollo
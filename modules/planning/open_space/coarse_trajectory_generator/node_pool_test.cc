@@ -0,0 +1,83 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/*
+ * @file
+ */
+
+#include "modules/planning/open_space/coarse_trajectory_generator/node_pool.h"
+
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace planning {
+
+namespace {
+
+struct TestNode {
+  TestNode(int value, std::shared_ptr<TestNode> pre, int* destroyed)
+      : value(value), pre(pre), destroyed(destroyed) {}
+  ~TestNode() { ++*destroyed; }
+
+  int value;
+  std::shared_ptr<TestNode> pre;
+  std::vector<double> payload = std::vector<double>(8, 1.0);
+  int* destroyed;
+};
+
+}  // namespace
+
+TEST(NodePoolTest, CreateAndReset) {
+  int destroyed = 0;
+  NodePool<TestNode> pool(4);
+  std::shared_ptr<TestNode> last;
+  for (int i = 0; i < 10; ++i) {
+    size_t id = 0;
+    last = pool.Create(&id, i, last, &destroyed);
+    EXPECT_EQ(static_cast<size_t>(i), id);
+  }
+  EXPECT_EQ(10, pool.Size());
+  EXPECT_EQ(7, pool.Get(7)->value);
+  EXPECT_EQ(6, pool.Get(7)->pre->value);
+  EXPECT_EQ(pool.Get(9), last);
+
+  last = nullptr;
+  pool.Reset();
+  EXPECT_EQ(10, destroyed);
+  EXPECT_EQ(0, pool.Size());
+
+  // blocks are reused, ids start over
+  size_t id = 1;
+  auto node = pool.Create(&id, 42, nullptr, &destroyed);
+  EXPECT_EQ(0, id);
+  EXPECT_EQ(42, node->value);
+  node = nullptr;
+  pool.Create(nullptr, 43, nullptr, &destroyed);
+  EXPECT_EQ(2, pool.Size());
+}
+
+TEST(NodePoolTest, ResetWithHeldHandleDies) {
+  int destroyed = 0;
+  NodePool<TestNode> pool;
+  auto node = pool.Create(nullptr, 1, nullptr, &destroyed);
+  EXPECT_DEATH(pool.Reset(), "still held");
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -20,6 +20,8 @@
 
 #include "modules/planning/open_space/coarse_trajectory_generator/reeds_shepp_path.h"
 
+#include <algorithm>
+
 namespace apollo {
 namespace planning {
 
@@ -57,60 +59,67 @@ std::pair<double, double> ReedShepp::calc_tau_omega(const double u,
 bool ReedShepp::ShortestRSP(const std::shared_ptr<Node3d> start_node,
                             const std::shared_ptr<Node3d> end_node,
                             std::shared_ptr<ReedSheppPath> optimal_path) {
-  std::vector<ReedSheppPath> all_possible_paths;
-  if (!GenerateRSPs(start_node, end_node, &all_possible_paths)) {
+  std::vector<ReedSheppPath> sorted_paths;
+  if (!GenerateSortedRSPs(start_node, end_node, &sorted_paths)) {
+    return false;
+  }
+  if (!InterpolateRSP(start_node, end_node, &sorted_paths.front())) {
+    return false;
+  }
+  *optimal_path = std::move(sorted_paths.front());
+  return true;
+}
+
+bool ReedShepp::GenerateSortedRSPs(const std::shared_ptr<Node3d> start_node,
+                                   const std::shared_ptr<Node3d> end_node,
+                                   std::vector<ReedSheppPath>* sorted_paths) {
+  sorted_paths->clear();
+  if (!GenerateRSPs(start_node, end_node, sorted_paths)) {
     ADEBUG << "Fail to generate different combination of Reed Shepp "
               "paths";
     return false;
   }
 
-  double optimal_path_length = std::numeric_limits<double>::infinity();
-  size_t optimal_path_index = 0;
-  size_t paths_size = all_possible_paths.size();
-  for (size_t i = 0; i < paths_size; ++i) {
-    if (all_possible_paths.at(i).total_length > 0 &&
-        all_possible_paths.at(i).total_length < optimal_path_length) {
-      optimal_path_index = i;
-      optimal_path_length = all_possible_paths.at(i).total_length;
-    }
+  sorted_paths->erase(
+      std::remove_if(sorted_paths->begin(), sorted_paths->end(),
+                     [](const ReedSheppPath& path) {
+                       return !(path.total_length > 0.0);
+                     }),
+      sorted_paths->end());
+  if (sorted_paths->empty()) {
+    ADEBUG << "No Reed Shepp path of positive length";
+    return false;
   }
+  // stable, so that the shortest path is the first one generated among
+  // paths of equal length
+  std::stable_sort(sorted_paths->begin(), sorted_paths->end(),
+                   [](const ReedSheppPath& lhs, const ReedSheppPath& rhs) {
+                     return lhs.total_length < rhs.total_length;
+                   });
+  return true;
+}
 
-  if (!GenerateLocalConfigurations(start_node, end_node,
-                                   &(all_possible_paths[optimal_path_index]))) {
+bool ReedShepp::InterpolateRSP(const std::shared_ptr<Node3d> start_node,
+                               const std::shared_ptr<Node3d> end_node,
+                               ReedSheppPath* path) {
+  if (!GenerateLocalConfigurations(start_node, end_node, path)) {
     ADEBUG << "Fail to generate local configurations(x, y, phi) in SetRSP";
     return false;
   }
 
-  if (std::abs(all_possible_paths[optimal_path_index].x.back() -
-               end_node->GetX()) > 1e-3 ||
-      std::abs(all_possible_paths[optimal_path_index].y.back() -
-               end_node->GetY()) > 1e-3 ||
-      std::abs(all_possible_paths[optimal_path_index].phi.back() -
-               end_node->GetPhi()) > 1e-3) {
+  if (std::abs(path->x.back() - end_node->GetX()) > 1e-3 ||
+      std::abs(path->y.back() - end_node->GetY()) > 1e-3 ||
+      std::abs(path->phi.back() - end_node->GetPhi()) > 1e-3) {
     ADEBUG << "RSP end position not right";
-    for (size_t i = 0;
-         i < all_possible_paths[optimal_path_index].segs_types.size(); ++i) {
-      ADEBUG << "types are "
-             << all_possible_paths[optimal_path_index].segs_types[i];
+    for (size_t i = 0; i < path->segs_types.size(); ++i) {
+      ADEBUG << "types are " << path->segs_types[i];
     }
-    ADEBUG << "x, y, phi are: "
-           << all_possible_paths[optimal_path_index].x.back() << ", "
-           << all_possible_paths[optimal_path_index].y.back() << ", "
-           << all_possible_paths[optimal_path_index].phi.back();
+    ADEBUG << "x, y, phi are: " << path->x.back() << ", " << path->y.back()
+           << ", " << path->phi.back();
     ADEBUG << "end x, y, phi are: " << end_node->GetX() << ", "
            << end_node->GetY() << ", " << end_node->GetPhi();
     return false;
   }
-  (*optimal_path).x = all_possible_paths[optimal_path_index].x;
-  (*optimal_path).y = all_possible_paths[optimal_path_index].y;
-  (*optimal_path).phi = all_possible_paths[optimal_path_index].phi;
-  (*optimal_path).gear = all_possible_paths[optimal_path_index].gear;
-  (*optimal_path).total_length =
-      all_possible_paths[optimal_path_index].total_length;
-  (*optimal_path).segs_types =
-      all_possible_paths[optimal_path_index].segs_types;
-  (*optimal_path).segs_lengths =
-      all_possible_paths[optimal_path_index].segs_lengths;
   return true;
 }
 
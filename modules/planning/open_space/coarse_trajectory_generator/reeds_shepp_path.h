@@ -67,6 +67,16 @@ class ReedShepp {
   bool ShortestRSP(const std::shared_ptr<Node3d> start_node,
                    const std::shared_ptr<Node3d> end_node,
                    std::shared_ptr<ReedSheppPath> optimal_path);
+  // Generate the general profiles of all combinations of movement primitives,
+  // shortest first, without interpolating them
+  bool GenerateSortedRSPs(const std::shared_ptr<Node3d> start_node,
+                          const std::shared_ptr<Node3d> end_node,
+                          std::vector<ReedSheppPath>* sorted_paths);
+  // Interpolate a path generated by GenerateSortedRSPs() and check that it
+  // reaches the end node
+  bool InterpolateRSP(const std::shared_ptr<Node3d> start_node,
+                      const std::shared_ptr<Node3d> end_node,
+                      ReedSheppPath* path);
 
  protected:
   // Generate all possible combination of movement primitives by Reed Shepp and
@@ -137,5 +137,30 @@ TEST_F(reeds_shepp, test_set_5) {
   }
   check(start_node, end_node, optimal_path);
 }
+TEST_F(reeds_shepp, test_sorted_paths) {
+  std::shared_ptr<Node3d> start_node = std::shared_ptr<Node3d>(new Node3d(
+      0.0, 0.0, 10.0 * M_PI / 180.0, XYbounds_, planner_open_space_config_));
+  std::shared_ptr<Node3d> end_node = std::shared_ptr<Node3d>(new Node3d(
+      7.0, -8.0, 50.0 * M_PI / 180.0, XYbounds_, planner_open_space_config_));
+  std::vector<ReedSheppPath> sorted_paths;
+  ASSERT_TRUE(
+      reedshepp_test->GenerateSortedRSPs(start_node, end_node, &sorted_paths));
+  ASSERT_GT(sorted_paths.size(), 1);
+  for (size_t i = 1; i < sorted_paths.size(); ++i) {
+    EXPECT_GT(sorted_paths[i - 1].total_length, 0.0);
+    EXPECT_LE(sorted_paths[i - 1].total_length, sorted_paths[i].total_length);
+    EXPECT_TRUE(sorted_paths[i].x.empty());
+  }
+
+  std::shared_ptr<ReedSheppPath> optimal_path =
+      std::shared_ptr<ReedSheppPath>(new ReedSheppPath());
+  ASSERT_TRUE(reedshepp_test->ShortestRSP(start_node, end_node, optimal_path));
+  ASSERT_TRUE(reedshepp_test->InterpolateRSP(start_node, end_node,
+                                             &sorted_paths.front()));
+  EXPECT_EQ(optimal_path->segs_types, sorted_paths.front().segs_types);
+  EXPECT_DOUBLE_EQ(optimal_path->total_length,
+                   sorted_paths.front().total_length);
+  check(start_node, end_node, optimal_path);
+}
 }  // namespace planning
 }  // namespace apollo
@@ -2274,7 +2274,12 @@ bool DistanceApproachIPOPTCUDAInterface::eval_h(int n, const double* x,
     // return the structure. This is a symmetric matrix, fill the lower left
     // triangle only.
 #if USE_GPU == 1
-    fill_lower_left(iRow, jCol, rind_L, cind_L, nnz_L);
+    if (!fill_lower_left(iRow, jCol, rind_L, cind_L, nnz_L)) {
+      for (int idx = 0; idx < nnz_L; idx++) {
+        iRow[idx] = rind_L[idx];
+        jCol[idx] = cind_L[idx];
+      }
+    }
 #else
     AFATAL << "CUDA enabled without GPU!";
 #endif
@@ -2284,7 +2289,11 @@ bool DistanceApproachIPOPTCUDAInterface::eval_h(int n, const double* x,
 
     obj_lam[0] = obj_factor;
 #if USE_GPU == 1
-    data_transfer(&obj_lam[1], lambda, m);
+    if (!data_transfer(&obj_lam[1], lambda, m)) {
+      for (int idx = 0; idx < m; idx++) {
+        obj_lam[1 + idx] = lambda[idx];
+      }
+    }
 #else
     AFATAL << "CUDA enabled without GPU!";
 #endif
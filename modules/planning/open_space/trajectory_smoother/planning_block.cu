@@ -14,23 +14,64 @@
  * limitations under the License.
  *****************************************************************************/
 
-#include <iostream>
+#include <cstdio>
+#include <mutex>
 
 #include "planning_block.h"
 
 namespace apollo {
 namespace planning {
-bool InitialCuda() {
+
+namespace {
+
+// Device memory is kept across calls, as ipopt asks for the hessian of a
+// problem of the same size at every iteration. Setting the device up and
+// resetting it on every call used to take longer than the transfers.
+struct DeviceBuffer {
+  void *data = nullptr;
+  size_t capacity = 0;
+};
+
+std::mutex device_mutex;
+bool is_device_ready = false;
+DeviceBuffer device_buffers[4];
+
+bool InitialCudaLocked() {
+  if (is_device_ready) {
+    return true;
+  }
   int dev = 0;
   cudaDeviceProp deviceProp;
   CUDA_CHECK(cudaGetDeviceProperties(&deviceProp, dev));
   CUDA_CHECK(cudaSetDevice(dev));
+  is_device_ready = true;
   return true;
 }
 
+bool ReserveDeviceBuffer(const size_t nBytes, DeviceBuffer *buffer) {
+  if (buffer->capacity >= nBytes) {
+    return true;
+  }
+  if (buffer->data != nullptr) {
+    cudaFree(buffer->data);
+    buffer->data = nullptr;
+    buffer->capacity = 0;
+  }
+  CUDA_CHECK(cudaMalloc(&buffer->data, nBytes));
+  buffer->capacity = nBytes;
+  return true;
+}
+
+}  // namespace
+
+bool InitialCuda() {
+  std::lock_guard<std::mutex> lock(device_mutex);
+  return InitialCudaLocked();
+}
+
 __global__ void fill_lower_left_gpu(int *iRow, int *jCol, unsigned int *rind_L,
                                     unsigned int *cind_L, const int nnz_L) {
-  int i = threadIdx.x;
+  int i = blockIdx.x * blockDim.x + threadIdx.x;
 
   if (i < nnz_L) {
     iRow[i] = rind_L[i];
@@ -40,7 +81,7 @@ __global__ void fill_lower_left_gpu(int *iRow, int *jCol, unsigned int *rind_L,
 
 template <typename T>
 __global__ void data_transfer_gpu(T *dst, const T *src, const int size) {
-  int i = threadIdx.x;
+  int i = blockIdx.x * blockDim.x + threadIdx.x;
 
   if (i < size) {
     dst[i] = src[i];
@@ -49,59 +90,64 @@ __global__ void data_transfer_gpu(T *dst, const T *src, const int size) {
 
 bool fill_lower_left(int *iRow, int *jCol, unsigned int *rind_L,
                      unsigned int *cind_L, const int nnz_L) {
-  if (!InitialCuda()) return false;
-  int *d_iRow, *d_jCol;
-  unsigned int *d_rind_L, *d_cind_L;
-
-  unsigned int nBytes = nnz_L * sizeof(int);
-  unsigned int nUBytes = nnz_L * sizeof(unsigned int);
-  cudaMalloc((void **)&d_iRow, nBytes);
-  cudaMalloc((void **)&d_jCol, nBytes);
-  cudaMalloc((void **)&d_rind_L, nUBytes);
-  cudaMalloc((void **)&d_cind_L, nUBytes);
+  if (nnz_L <= 0) {
+    return true;
+  }
+  std::lock_guard<std::mutex> lock(device_mutex);
+  if (!InitialCudaLocked()) return false;
+
+  const size_t nBytes = nnz_L * sizeof(int);
+  const size_t nUBytes = nnz_L * sizeof(unsigned int);
+  if (!ReserveDeviceBuffer(nBytes, &device_buffers[0]) ||
+      !ReserveDeviceBuffer(nBytes, &device_buffers[1]) ||
+      !ReserveDeviceBuffer(nUBytes, &device_buffers[2]) ||
+      !ReserveDeviceBuffer(nUBytes, &device_buffers[3])) {
+    return false;
+  }
+  int *d_iRow = static_cast<int *>(device_buffers[0].data);
+  int *d_jCol = static_cast<int *>(device_buffers[1].data);
+  unsigned int *d_rind_L = static_cast<unsigned int *>(device_buffers[2].data);
+  unsigned int *d_cind_L = static_cast<unsigned int *>(device_buffers[3].data);
 
-  cudaMemcpy(d_iRow, iRow, nBytes, cudaMemcpyHostToDevice);
-  cudaMemcpy(d_jCol, jCol, nBytes, cudaMemcpyHostToDevice);
+  CUDA_CHECK(cudaMemcpy(d_rind_L, rind_L, nUBytes, cudaMemcpyHostToDevice));
+  CUDA_CHECK(cudaMemcpy(d_cind_L, cind_L, nUBytes, cudaMemcpyHostToDevice));
 
   dim3 block(BLOCK_1);
   dim3 grid((nnz_L + block.x - 1) / block.x);
 
   fill_lower_left_gpu<<<grid, block>>>(d_iRow, d_jCol, d_rind_L, d_cind_L,
                                        nnz_L);
-  cudaDeviceSynchronize();
+  CUDA_CHECK(cudaGetLastError());
 
-  cudaMemcpy(rind_L, d_rind_L, nUBytes, cudaMemcpyDeviceToHost);
-  cudaMemcpy(cind_L, d_cind_L, nUBytes, cudaMemcpyDeviceToHost);
-
-  cudaFree(d_iRow);
-  cudaFree(d_jCol);
-  cudaFree(d_rind_L);
-  cudaFree(d_cind_L);
-  cudaDeviceReset();
+  CUDA_CHECK(cudaMemcpy(iRow, d_iRow, nBytes, cudaMemcpyDeviceToHost));
+  CUDA_CHECK(cudaMemcpy(jCol, d_jCol, nBytes, cudaMemcpyDeviceToHost));
   return true;
 }
 
 template <typename T>
 bool data_transfer(T *dst, const T *src, const int size) {
-  if (!InitialCuda()) return false;
-  T *d_dst, *d_src;
-  size_t nBytes = size * sizeof(T);
-  cudaMalloc((void **)&d_dst, nBytes);
-  cudaMalloc((void **)&d_src, nBytes);
-  cudaMemcpy(d_src, src, nBytes, cudaMemcpyHostToDevice);
-  cudaMemcpy(d_dst, dst, nBytes, cudaMemcpyHostToDevice);
+  if (size <= 0) {
+    return true;
+  }
+  std::lock_guard<std::mutex> lock(device_mutex);
+  if (!InitialCudaLocked()) return false;
+
+  const size_t nBytes = size * sizeof(T);
+  if (!ReserveDeviceBuffer(nBytes, &device_buffers[0]) ||
+      !ReserveDeviceBuffer(nBytes, &device_buffers[1])) {
+    return false;
+  }
+  T *d_dst = static_cast<T *>(device_buffers[0].data);
+  T *d_src = static_cast<T *>(device_buffers[1].data);
+  CUDA_CHECK(cudaMemcpy(d_src, src, nBytes, cudaMemcpyHostToDevice));
 
   dim3 block(BLOCK_1);
   dim3 grid((size + block.x - 1) / block.x);
 
-  data_transfer_gpu<<<grid, block>>>(dst, src, size);
-  cudaDeviceSynchronize();
-
-  cudaMemcpy(dst, d_dst, nBytes, cudaMemcpyDeviceToHost);
+  data_transfer_gpu<<<grid, block>>>(d_dst, d_src, size);
+  CUDA_CHECK(cudaGetLastError());
 
-  cudaFree(d_dst);
-  cudaFree(d_src);
-  cudaDeviceReset();
+  CUDA_CHECK(cudaMemcpy(dst, d_dst, nBytes, cudaMemcpyDeviceToHost));
   return true;
 }
 
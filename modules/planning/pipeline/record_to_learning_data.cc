@@ -34,6 +34,13 @@ void GenerateLearningData() {
   if (FLAGS_planning_offline_bags.empty()) {
     return;
   }
+  if (FLAGS_planning_offline_shard_num < 1 ||
+      FLAGS_planning_offline_shard_index < 0 ||
+      FLAGS_planning_offline_shard_index >= FLAGS_planning_offline_shard_num) {
+    AERROR << "Invalid shard " << FLAGS_planning_offline_shard_index << " of "
+           << FLAGS_planning_offline_shard_num;
+    return;
+  }
 
   if (!FeatureOutput::Ready()) {
     AERROR << "Feature output is not ready.";
@@ -60,7 +67,9 @@ void GenerateLearningData() {
     std::sort(offline_bags.begin(), offline_bags.end());
     AINFO << "For input " << input << ", found " << offline_bags.size()
           << " rosbags to process";
-    for (std::size_t i = 0; i < offline_bags.size(); ++i) {
+    // with several shards, each process takes every shard_num-th bag
+    for (std::size_t i = FLAGS_planning_offline_shard_index;
+         i < offline_bags.size(); i += FLAGS_planning_offline_shard_num) {
       AINFO << "\tProcessing: [ " << i + 1 << " / " << offline_bags.size()
             << " ]: " << offline_bags[i];
       message_process.ProcessOfflineData(offline_bags[i]);
@@ -336,6 +336,8 @@ Status LatticePlanner::PlanOnReferenceLine(
 
   ADEBUG << "Trajectory_Evaluation_Time = "
          << (Clock::NowInSeconds() - current_time) * 1000;
+  ADEBUG << "number of fully evaluated trajectory pairs = "
+         << trajectory_evaluator.num_of_evaluated_trajectory_pairs();
 
   ADEBUG << "Step CombineTrajectory Succeeded";
 
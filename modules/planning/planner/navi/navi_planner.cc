@@ -36,6 +36,7 @@
 #include "modules/planning/common/ego_info.h"
 #include "modules/planning/common/frame.h"
 #include "modules/planning/common/planning_gflags.h"
+#include "modules/planning/common/planning_profiler.h"
 #include "modules/planning/constraint_checker/constraint_checker.h"
 #include "modules/planning/navi/decider/navi_obstacle_decider.h"
 #include "modules/planning/navi/decider/navi_path_decider.h"
@@ -162,6 +163,7 @@ Status NaviPlanner::PlanOnReferenceLine(
   auto ret = Status::OK();
 
   for (auto& task : tasks_) {
+    ScopedPlanningProfile task_profile(task->Name(), PlanningProfileSpan::TASK);
     const double start_timestamp = Clock::NowInSeconds();
     ret = task->Execute(frame, reference_line_info);
     if (!ret.ok()) {
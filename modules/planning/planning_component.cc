@@ -16,14 +16,17 @@
 #include "modules/planning/planning_component.h"
 
 #include "cyber/common/file.h"
+#include "cyber/time/clock.h"
 #include "modules/common/adapters/adapter_gflags.h"
 #include "modules/common/configs/config_gflags.h"
+#include "modules/common/latency_recorder/latency_recorder.h"
 #include "modules/common/util/message_util.h"
 #include "modules/common/util/util.h"
 #include "modules/map/hdmap/hdmap_util.h"
 #include "modules/map/pnc_map/pnc_map.h"
 #include "modules/planning/common/history.h"
 #include "modules/planning/common/planning_context.h"
+#include "modules/planning/common/planning_profiler.h"
 #include "modules/planning/navi_planning.h"
 #include "modules/planning/on_lane_planning.h"
 
@@ -112,6 +115,11 @@ bool PlanningComponent::Init() {
   planning_learning_data_writer_ = node_->CreateWriter<PlanningLearningData>(
       config_.topic_config().planning_learning_data_topic());
 
+  if (FLAGS_enable_planning_profiler) {
+    planning_profile_writer_ =
+        node_->CreateWriter<PlanningProfile>(FLAGS_planning_profile_topic);
+  }
+
   return true;
 }
 
@@ -122,6 +130,7 @@ bool PlanningComponent::Proc(
     const std::shared_ptr<localization::LocalizationEstimate>&
         localization_estimate) {
   ACHECK(prediction_obstacles != nullptr);
+  const auto start_time = apollo::cyber::Clock::Now();
 
   // check and process possible rerouting request
   CheckRerouting();
@@ -186,8 +195,16 @@ bool PlanningComponent::Proc(
   }
 
   ADCTrajectory adc_trajectory_pb;
+  PlanningProfiler::Instance()->BeginCycle();
   planning_base_->RunOnce(local_view_, &adc_trajectory_pb);
   common::util::FillHeader(node_->Name(), &adc_trajectory_pb);
+  PlanningProfile planning_profile;
+  if (PlanningProfiler::Instance()->EndCycle(
+          adc_trajectory_pb.header().sequence_num(), &planning_profile) &&
+      planning_profile_writer_ != nullptr) {
+    common::util::FillHeader(node_->Name(), &planning_profile);
+    planning_profile_writer_->Write(planning_profile);
+  }
 
   // modify trajectory relative time due to the timestamp change in header
   auto start_time = adc_trajectory_pb.header().timestamp_sec();
@@ -195,6 +212,14 @@ bool PlanningComponent::Proc(
   for (auto& p : *adc_trajectory_pb.mutable_trajectory_point()) {
     p.set_relative_time(p.relative_time() + dt);
   }
+
+  // measure latency
+  static apollo::common::LatencyRecorder latency_recorder(
+      FLAGS_planning_trajectory_topic);
+  latency_recorder.AppendLatencyRecord(
+      adc_trajectory_pb.header().lidar_timestamp(), start_time,
+      apollo::cyber::Clock::Now());
+
   planning_writer_->Write(adc_trajectory_pb);
 
   // record in history
@@ -31,6 +31,7 @@
 #include "modules/planning/proto/pad_msg.pb.h"
 #include "modules/planning/proto/planning.pb.h"
 #include "modules/planning/proto/planning_config.pb.h"
+#include "modules/planning/proto/planning_profile.pb.h"
 #include "modules/prediction/proto/prediction_obstacle.pb.h"
 #include "modules/routing/proto/routing.pb.h"
 #include "modules/storytelling/proto/story.pb.h"
@@ -71,6 +72,7 @@ class PlanningComponent final
   std::shared_ptr<cyber::Writer<routing::RoutingRequest>> rerouting_writer_;
   std::shared_ptr<cyber::Writer<PlanningLearningData>>
       planning_learning_data_writer_;
+  std::shared_ptr<cyber::Writer<PlanningProfile>> planning_profile_writer_;
 
   std::mutex mutex_;
   perception::TrafficLightDetection traffic_light_;
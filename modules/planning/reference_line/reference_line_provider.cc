@@ -22,7 +22,9 @@
 #include "modules/planning/reference_line/reference_line_provider.h"
 
 #include <algorithm>
+#include <cmath>
 #include <limits>
+#include <string>
 #include <utility>
 
 #include "cyber/common/file.h"
@@ -56,6 +58,26 @@ using apollo::hdmap::MapPathPoint;
 using apollo::hdmap::PncMap;
 using apollo::hdmap::RouteSegments;
 
+namespace {
+// lane segment boundaries closer than this share a smoothed segment cache key
+constexpr double kSegmentCacheKeyResolution = 0.1;
+
+std::string LaneSegmentsKey(const RouteSegments &segments) {
+  std::string key;
+  for (const auto &lane_segment : segments) {
+    key += lane_segment.lane->id().id();
+    key += ':';
+    key += std::to_string(
+        std::lround(lane_segment.start_s / kSegmentCacheKeyResolution));
+    key += ':';
+    key += std::to_string(
+        std::lround(lane_segment.end_s / kSegmentCacheKeyResolution));
+    key += ';';
+  }
+  return key;
+}
+}  // namespace
+
 ReferenceLineProvider::~ReferenceLineProvider() {}
 
 ReferenceLineProvider::ReferenceLineProvider(
@@ -551,6 +573,8 @@ bool ReferenceLineProvider::CreateReferenceLine(
     std::list<hdmap::RouteSegments> *segments) {
   CHECK_NOTNULL(reference_lines);
   CHECK_NOTNULL(segments);
+  ++num_of_cycles_;
+  PruneSmoothedSegmentCache();
 
   common::VehicleState vehicle_state;
   {
@@ -619,16 +643,21 @@ bool ReferenceLineProvider::ExtendReferenceLine(const VehicleState &state,
                                                 ReferenceLine *reference_line) {
   RouteSegments segment_properties;
   segment_properties.SetProperties(*segments);
-  auto prev_segment = route_segments_.begin();
-  auto prev_ref = reference_lines_.begin();
-  while (prev_segment != route_segments_.end()) {
-    if (prev_segment->IsConnectedSegment(*segments)) {
+  const RouteSegments *prev_segment = nullptr;
+  const ReferenceLine *prev_ref = nullptr;
+  auto prev_segment_iter = route_segments_.begin();
+  auto prev_ref_iter = reference_lines_.begin();
+  while (prev_segment_iter != route_segments_.end()) {
+    if (prev_segment_iter->IsConnectedSegment(*segments)) {
+      prev_segment = &(*prev_segment_iter);
+      prev_ref = &(*prev_ref_iter);
       break;
     }
-    ++prev_segment;
-    ++prev_ref;
+    ++prev_segment_iter;
+    ++prev_ref_iter;
   }
-  if (prev_segment == route_segments_.end()) {
+  if (prev_segment == nullptr &&
+      !FindCachedConnectedSegment(*segments, &prev_segment, &prev_ref)) {
     if (!route_segments_.empty() && segments->IsOnSegment()) {
       AWARN << "Current route segment is not connected with previous route "
                "segment";
@@ -870,8 +899,76 @@ void ReferenceLineProvider::GetAnchorPoints(
 
 bool ReferenceLineProvider::SmoothRouteSegment(const RouteSegments &segments,
                                                ReferenceLine *reference_line) {
+  if (!FLAGS_enable_reference_line_segment_cache) {
+    hdmap::Path path(segments);
+    return SmoothReferenceLine(ReferenceLine(path), reference_line);
+  }
+  const std::string key = LaneSegmentsKey(segments);
+  auto iter = smoothed_segment_cache_.find(key);
+  if (iter != smoothed_segment_cache_.end()) {
+    ADEBUG << "Reuse smoothed reference line of segments: " << key;
+    iter->second.last_used_cycle = num_of_cycles_;
+    *reference_line = iter->second.reference_line;
+    return true;
+  }
   hdmap::Path path(segments);
-  return SmoothReferenceLine(ReferenceLine(path), reference_line);
+  if (!SmoothReferenceLine(ReferenceLine(path), reference_line)) {
+    return false;
+  }
+  auto &smoothed_segment = smoothed_segment_cache_[key];
+  smoothed_segment.segments = segments;
+  smoothed_segment.reference_line = *reference_line;
+  smoothed_segment.last_used_cycle = num_of_cycles_;
+  return true;
+}
+
+bool ReferenceLineProvider::FindCachedConnectedSegment(
+    const RouteSegments &segments, const RouteSegments **prev_segment,
+    const ReferenceLine **prev_ref) {
+  if (!FLAGS_enable_reference_line_segment_cache) {
+    return false;
+  }
+  // pick the most recently used one, ties broken by key to stay
+  // deterministic over the unordered cache
+  const std::string *best_key = nullptr;
+  SmoothedSegment *best = nullptr;
+  for (auto &entry : smoothed_segment_cache_) {
+    if (!entry.second.segments.IsConnectedSegment(segments)) {
+      continue;
+    }
+    if (best == nullptr ||
+        entry.second.last_used_cycle > best->last_used_cycle ||
+        (entry.second.last_used_cycle == best->last_used_cycle &&
+         entry.first < *best_key)) {
+      best_key = &entry.first;
+      best = &entry.second;
+    }
+  }
+  if (best == nullptr) {
+    return false;
+  }
+  ADEBUG << "Extend cached reference line of segments: " << *best_key;
+  best->last_used_cycle = num_of_cycles_;
+  *prev_segment = &best->segments;
+  *prev_ref = &best->reference_line;
+  return true;
+}
+
+void ReferenceLineProvider::PruneSmoothedSegmentCache() {
+  if (!FLAGS_enable_reference_line_segment_cache) {
+    smoothed_segment_cache_.clear();
+    return;
+  }
+  const uint64_t max_unused_cycles =
+      std::max(0, FLAGS_reference_line_segment_cache_cycles);
+  for (auto iter = smoothed_segment_cache_.begin();
+       iter != smoothed_segment_cache_.end();) {
+    if (iter->second.last_used_cycle + max_unused_cycles < num_of_cycles_) {
+      iter = smoothed_segment_cache_.erase(iter);
+    } else {
+      ++iter;
+    }
+  }
 }
 
 bool ReferenceLineProvider::SmoothPrefixedReferenceLine(
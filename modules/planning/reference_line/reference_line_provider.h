@@ -26,6 +26,7 @@
 #include <memory>
 #include <queue>
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
@@ -154,7 +155,24 @@ class ReferenceLineProvider {
   bool Shrink(const common::SLPoint& sl, ReferenceLine* ref,
               hdmap::RouteSegments* segments);
 
+  /**
+   * @brief Finds a recently smoothed reference line whose route segments are
+   * connected with the given ones, so that it can be extended instead of
+   * smoothing the whole segments again.
+   */
+  bool FindCachedConnectedSegment(const hdmap::RouteSegments& segments,
+                                  const hdmap::RouteSegments** prev_segment,
+                                  const ReferenceLine** prev_ref);
+
+  void PruneSmoothedSegmentCache();
+
  private:
+  struct SmoothedSegment {
+    hdmap::RouteSegments segments;
+    ReferenceLine reference_line;
+    uint64_t last_used_cycle = 0;
+  };
+
   bool is_initialized_ = false;
   std::atomic<bool> is_stop_{false};
 
@@ -184,6 +202,10 @@ class ReferenceLineProvider {
 
   std::future<void> task_future_;
 
+  // smoothed reference lines of recent cycles, keyed by their lane segments
+  std::unordered_map<std::string, SmoothedSegment> smoothed_segment_cache_;
+  uint64_t num_of_cycles_ = 0;
+
   std::atomic<bool> is_reference_line_updated_{true};
 
   const common::VehicleStateProvider* vehicle_state_provider_ = nullptr;
@@ -20,9 +20,12 @@
 
 #include "modules/planning/scenarios/lane_follow/lane_follow_stage.h"
 
+#include <future>
 #include <utility>
+#include <vector>
 
 #include "cyber/common/log.h"
+#include "cyber/task/task.h"
 #include "cyber/time/clock.h"
 #include "modules/common/math/math_utils.h"
 #include "modules/common/util/point_factory.h"
@@ -33,6 +36,7 @@
 #include "modules/planning/common/ego_info.h"
 #include "modules/planning/common/frame.h"
 #include "modules/planning/common/planning_gflags.h"
+#include "modules/planning/common/planning_profiler.h"
 #include "modules/planning/constraint_checker/constraint_checker.h"
 #include "modules/planning/tasks/deciders/lane_change_decider/lane_change_decider.h"
 #include "modules/planning/tasks/deciders/path_decider/path_decider.h"
@@ -97,6 +101,18 @@ Stage::StageStatus LaneFollowStage::Process(
   ADEBUG << "Number of reference lines:\t"
          << frame->mutable_reference_line_info()->size();
 
+  // Plan all the reference lines up front when running concurrently; the
+  // loop below then only merges the results in reference line order.
+  const bool plan_concurrently =
+      FLAGS_enable_multi_thread_in_reference_line_planning &&
+      frame->mutable_reference_line_info()->size() > 1;
+  std::vector<Status> plan_status;
+  std::vector<PlanningContext> planning_contexts;
+  if (plan_concurrently) {
+    PlanReferenceLinesConcurrently(planning_start_point, frame, &plan_status,
+                                   &planning_contexts);
+  }
+
   unsigned int count = 0;
 
   for (auto& reference_line_info : *frame->mutable_reference_line_info()) {
@@ -109,11 +125,24 @@ Stage::StageStatus LaneFollowStage::Process(
 
     if (has_drivable_reference_line) {
       reference_line_info.SetDrivable(false);
+      if (plan_concurrently) {
+        // already planned, keep it from being picked over the selected one
+        continue;
+      }
       break;
     }
 
-    auto cur_status =
-        PlanOnReferenceLine(planning_start_point, frame, &reference_line_info);
+    Status cur_status;
+    if (plan_concurrently) {
+      // adopt the planning status this reference line ended with, as if it
+      // had been planned after the previous ones
+      *injector_->planning_context()->mutable_planning_status() =
+          planning_contexts[count - 1].planning_status();
+      cur_status = plan_status[count - 1];
+    } else {
+      cur_status = PlanOnReferenceLine(planning_start_point, frame,
+                                       &reference_line_info);
+    }
 
     if (cur_status.ok()) {
       if (reference_line_info.IsChangeLanePath()) {
@@ -150,9 +179,55 @@ Stage::StageStatus LaneFollowStage::Process(
                                      : StageStatus::ERROR;
 }
 
+void LaneFollowStage::PlanReferenceLinesConcurrently(
+    const TrajectoryPoint& planning_start_point, Frame* frame,
+    std::vector<Status>* plan_status,
+    std::vector<PlanningContext>* planning_contexts) {
+  auto* reference_line_infos = frame->mutable_reference_line_info();
+  const size_t num_reference_lines = reference_line_infos->size();
+  // every reference line starts from the same planning status
+  planning_contexts->assign(num_reference_lines,
+                            *injector_->planning_context());
+  plan_status->assign(num_reference_lines, Status::OK());
+
+  // create the task instances of all reference lines before any of them runs
+  TaskListOnReferenceLine(num_reference_lines - 1);
+
+  std::vector<std::future<Status>> results;
+  size_t index = 0;
+  for (auto& reference_line_info : *reference_line_infos) {
+    results.push_back(cyber::Async(
+        &LaneFollowStage::PlanOnReferenceLineWithContext, this,
+        planning_start_point, frame, &reference_line_info,
+        &TaskListOnReferenceLine(index), &(*planning_contexts)[index]));
+    ++index;
+  }
+  for (size_t i = 0; i < results.size(); ++i) {
+    (*plan_status)[i] = results[i].get();
+  }
+}
+
+Status LaneFollowStage::PlanOnReferenceLineWithContext(
+    const TrajectoryPoint& planning_start_point, Frame* frame,
+    ReferenceLineInfo* reference_line_info, const std::vector<Task*>* task_list,
+    PlanningContext* planning_context) {
+  DependencyInjector::ScopedPlanningContext scoped_planning_context(
+      planning_context);
+  return PlanOnReferenceLine(planning_start_point, frame, reference_line_info,
+                             *task_list);
+}
+
 Status LaneFollowStage::PlanOnReferenceLine(
     const TrajectoryPoint& planning_start_point, Frame* frame,
     ReferenceLineInfo* reference_line_info) {
+  return PlanOnReferenceLine(planning_start_point, frame, reference_line_info,
+                             task_list_);
+}
+
+Status LaneFollowStage::PlanOnReferenceLine(
+    const TrajectoryPoint& planning_start_point, Frame* frame,
+    ReferenceLineInfo* reference_line_info,
+    const std::vector<Task*>& task_list) {
   if (!reference_line_info->IsChangeLanePath()) {
     reference_line_info->AddCost(kStraightForwardLineCost);
   }
@@ -161,7 +236,8 @@ Status LaneFollowStage::PlanOnReferenceLine(
          << reference_line_info->IsChangeLanePath();
 
   auto ret = Status::OK();
-  for (auto* task : task_list_) {
+  for (auto* task : task_list) {
+    ScopedPlanningProfile task_profile(task->Name(), PlanningProfileSpan::TASK);
     const double start_timestamp = Clock::NowInSeconds();
 
     ret = task->Execute(frame, reference_line_info);
@@ -27,6 +27,7 @@
 #include "modules/common/proto/pnc_point.pb.h"
 #include "modules/common/status/status.h"
 #include "modules/common/util/factory.h"
+#include "modules/planning/common/planning_context.h"
 #include "modules/planning/common/reference_line_info.h"
 #include "modules/planning/common/speed_profile_generator.h"
 #include "modules/planning/proto/planning.pb.h"
@@ -69,6 +70,26 @@ class LaneFollowStage : public Stage {
 
   void RecordObstacleDebugInfo(ReferenceLineInfo* reference_line_info);
 
+ private:
+  /**
+   * @brief Runs the task pipeline of every reference line on its own thread,
+   * with its own task instances and a private copy of the planning context.
+   */
+  void PlanReferenceLinesConcurrently(
+      const common::TrajectoryPoint& planning_start_point, Frame* frame,
+      std::vector<common::Status>* plan_status,
+      std::vector<PlanningContext>* planning_contexts);
+
+  common::Status PlanOnReferenceLineWithContext(
+      const common::TrajectoryPoint& planning_start_point, Frame* frame,
+      ReferenceLineInfo* reference_line_info,
+      const std::vector<Task*>* task_list, PlanningContext* planning_context);
+
+  common::Status PlanOnReferenceLine(
+      const common::TrajectoryPoint& planning_start_point, Frame* frame,
+      ReferenceLineInfo* reference_line_info,
+      const std::vector<Task*>& task_list);
+
  private:
   ScenarioConfig config_;
   std::unique_ptr<Stage> stage_;
@@ -22,6 +22,7 @@
 
 #include "cyber/common/file.h"
 #include "modules/planning/common/frame.h"
+#include "modules/planning/common/planning_profiler.h"
 
 namespace apollo {
 namespace planning {
@@ -65,6 +66,8 @@ void Scenario::Init() {
 
 Scenario::ScenarioStatus Scenario::Process(
     const common::TrajectoryPoint& planning_init_point, Frame* frame) {
+  ScopedPlanningProfile scenario_profile(Name(),
+                                         PlanningProfileSpan::SCENARIO);
   if (current_stage_ == nullptr) {
     AWARN << "Current stage is a null pointer.";
     return STATUS_UNKNOWN;
@@ -73,7 +76,12 @@ Scenario::ScenarioStatus Scenario::Process(
     scenario_status_ = STATUS_DONE;
     return scenario_status_;
   }
-  auto ret = current_stage_->Process(planning_init_point, frame);
+  Stage::StageStatus ret;
+  {
+    ScopedPlanningProfile stage_profile(current_stage_->Name(),
+                                        PlanningProfileSpan::STAGE);
+    ret = current_stage_->Process(planning_init_point, frame);
+  }
   switch (ret) {
     case Stage::ERROR: {
       AERROR << "Stage '" << current_stage_->Name() << "' returns error";
@@ -16,6 +16,7 @@
 
 #include "modules/planning/scenarios/scenario_manager.h"
 
+#include <algorithm>
 #include <string>
 #include <vector>
 
@@ -49,6 +50,11 @@ namespace scenario {
 using apollo::hdmap::HDMapUtil;
 using apollo::hdmap::PathOverlap;
 
+namespace {
+// traffic lights within this distance of each other form one group
+constexpr double kTrafficLightGroupingMaxDist = 2.0;  // unit: m
+}  // namespace
+
 ScenarioManager::ScenarioManager(
     const std::shared_ptr<DependencyInjector>& injector)
     : injector_(injector) {}
@@ -56,6 +62,25 @@ ScenarioManager::ScenarioManager(
 bool ScenarioManager::Init(const PlanningConfig& planning_config) {
   planning_config_.CopyFrom(planning_config);
   RegisterScenarios();
+  intersection_horizon_ = std::max(
+      {config_map_[ScenarioConfig::BARE_INTERSECTION_UNPROTECTED]
+           .bare_intersection_unprotected_config()
+           .start_bare_intersection_scenario_distance(),
+       config_map_[ScenarioConfig::STOP_SIGN_UNPROTECTED]
+           .stop_sign_unprotected_config()
+           .start_stop_sign_scenario_distance(),
+       config_map_[ScenarioConfig::TRAFFIC_LIGHT_PROTECTED]
+           .traffic_light_protected_config()
+           .start_traffic_light_scenario_distance(),
+       config_map_[ScenarioConfig::TRAFFIC_LIGHT_UNPROTECTED_LEFT_TURN]
+           .traffic_light_unprotected_left_turn_config()
+           .start_traffic_light_scenario_distance(),
+       config_map_[ScenarioConfig::TRAFFIC_LIGHT_UNPROTECTED_RIGHT_TURN]
+           .traffic_light_unprotected_right_turn_config()
+           .start_traffic_light_scenario_distance(),
+       config_map_[ScenarioConfig::YIELD_SIGN]
+           .yield_sign_config()
+           .start_yield_sign_scenario_distance()});
   default_scenario_type_ = ScenarioConfig::LANE_FOLLOW;
   current_scenario_ = CreateScenario(default_scenario_type_);
   return true;
@@ -200,13 +225,9 @@ ScenarioConfig::ScenarioType ScenarioManager::SelectPullOverScenario(
   const auto& scenario_config =
       config_map_[ScenarioConfig::PULL_OVER].pull_over_config();
 
-  const auto& routing = frame.local_view().routing;
-  const auto& routing_end = *(routing->routing_request().waypoint().rbegin());
-
-  common::SLPoint dest_sl;
+  const common::SLPoint& dest_sl = DestinationSL(frame);
   const auto& reference_line_info = frame.reference_line_info().front();
   const auto& reference_line = reference_line_info.reference_line();
-  reference_line.XYToSL(routing_end.pose(), &dest_sl);
   const double adc_front_edge_s = reference_line_info.AdcSlBoundary().end_s();
 
   const double adc_distance_to_dest = dest_sl.s() - adc_front_edge_s;
@@ -265,31 +286,9 @@ ScenarioConfig::ScenarioType ScenarioManager::SelectPullOverScenario(
         continue;
       }
       const hdmap::LaneInfoConstPtr lane = lanes[0];
-      const std::string lane_id = lane->lane().id().id();
-      ADEBUG << "check_s[" << check_s << "] lane[" << lane_id << "]";
-
-      // check neighbor lanes type: NONE/CITY_DRIVING/BIKING/SIDEWALK/PARKING
-      bool rightmost_driving_lane = true;
-      for (const auto& neighbor_lane_id :
-           lane->lane().right_neighbor_forward_lane_id()) {
-        const auto hdmap_ptr = HDMapUtil::BaseMapPtr();
-        CHECK_NOTNULL(hdmap_ptr);
-        const auto neighbor_lane = hdmap_ptr->GetLaneById(neighbor_lane_id);
-        if (neighbor_lane == nullptr) {
-          ADEBUG << "Failed to find neighbor lane[" << neighbor_lane_id.id()
-                 << "]";
-          continue;
-        }
-        const auto& lane_type = neighbor_lane->lane().type();
-        if (lane_type == hdmap::Lane::CITY_DRIVING) {
-          ADEBUG << "lane[" << lane_id << "]'s right neighbor forward lane["
-                 << neighbor_lane_id.id() << "] type["
-                 << Lane_LaneType_Name(lane_type) << "] can't pull over";
-          rightmost_driving_lane = false;
-          break;
-        }
-      }
-      if (!rightmost_driving_lane) {
+      ADEBUG << "check_s[" << check_s << "] lane[" << lane->lane().id().id()
+             << "]";
+      if (!IsRightmostDrivingLane(lane)) {
         pull_over_scenario = false;
         break;
       }
@@ -495,7 +494,6 @@ ScenarioConfig::ScenarioType ScenarioManager::SelectTrafficLightScenario(
   // find all the traffic light belong to
   // the same group as first encountered traffic light
   std::vector<hdmap::PathOverlap> next_traffic_lights;
-  static constexpr double kTrafficLightGroupingMaxDist = 2.0;  // unit: m
   const std::vector<PathOverlap>& traffic_light_overlaps =
       reference_line_info.reference_line().map_path().signal_overlaps();
   for (const auto& overlap : traffic_light_overlaps) {
@@ -751,12 +749,8 @@ ScenarioConfig::ScenarioType ScenarioManager::SelectParkAndGoScenario(
   hdmap::LaneInfoConstPtr lane;
 
   // check ego vehicle distance to destination
-  const auto& routing = frame.local_view().routing;
-  const auto& routing_end = *(routing->routing_request().waypoint().rbegin());
-  common::SLPoint dest_sl;
+  const common::SLPoint& dest_sl = DestinationSL(frame);
   const auto& reference_line_info = frame.reference_line_info().front();
-  const auto& reference_line = reference_line_info.reference_line();
-  reference_line.XYToSL(routing_end.pose(), &dest_sl);
   const double adc_front_edge_s = reference_line_info.AdcSlBoundary().end_s();
 
   const double adc_distance_to_dest = dest_sl.s() - adc_front_edge_s;
@@ -780,6 +774,8 @@ ScenarioConfig::ScenarioType ScenarioManager::SelectParkAndGoScenario(
 }
 
 void ScenarioManager::Observe(const Frame& frame) {
+  has_dest_sl_ = false;
+
   // init first_encountered_overlap_map_
   first_encountered_overlap_map_.clear();
   const auto& reference_line_info = frame.reference_line_info().front();
@@ -795,6 +791,83 @@ void ScenarioManager::Observe(const Frame& frame) {
   }
 }
 
+bool ScenarioManager::IsIntersectionInHorizon(const Frame& frame) const {
+  // a stop sign, yield sign or junction must start within its start distance
+  // ahead; a traffic light picks up its group within the grouping distance
+  const auto& reference_line_info = frame.reference_line_info().front();
+  const double adc_front_edge_s = reference_line_info.AdcSlBoundary().end_s();
+  for (const auto& overlap : reference_line_info.FirstEncounteredOverlaps()) {
+    if (overlap.first != ReferenceLineInfo::PNC_JUNCTION &&
+        overlap.first != ReferenceLineInfo::SIGNAL &&
+        overlap.first != ReferenceLineInfo::STOP_SIGN &&
+        overlap.first != ReferenceLineInfo::YIELD_SIGN) {
+      continue;
+    }
+    const double distance = overlap.second.start_s - adc_front_edge_s;
+    if (distance > -kTrafficLightGroupingMaxDist &&
+        distance <= intersection_horizon_ + kTrafficLightGroupingMaxDist) {
+      return true;
+    }
+  }
+  return false;
+}
+
+const common::SLPoint& ScenarioManager::DestinationSL(const Frame& frame) {
+  if (!has_dest_sl_) {
+    const auto& routing = frame.local_view().routing;
+    const auto& routing_end =
+        *(routing->routing_request().waypoint().rbegin());
+    dest_sl_.Clear();
+    frame.reference_line_info().front().reference_line().XYToSL(
+        routing_end.pose(), &dest_sl_);
+    has_dest_sl_ = true;
+  }
+  return dest_sl_;
+}
+
+bool ScenarioManager::IsRightmostDrivingLane(
+    const hdmap::LaneInfoConstPtr& lane) {
+  const auto hdmap_ptr = HDMapUtil::BaseMapPtr();
+  const std::string& lane_id = lane->lane().id().id();
+  if (FLAGS_enable_scenario_event_horizon) {
+    // the answer only changes with the map
+    if (rightmost_lane_map_ != hdmap_ptr) {
+      rightmost_driving_lane_cache_.clear();
+      rightmost_lane_map_ = hdmap_ptr;
+    }
+    const auto iter = rightmost_driving_lane_cache_.find(lane_id);
+    if (iter != rightmost_driving_lane_cache_.end()) {
+      return iter->second;
+    }
+  }
+
+  // check neighbor lanes type: NONE/CITY_DRIVING/BIKING/SIDEWALK/PARKING
+  bool rightmost_driving_lane = true;
+  for (const auto& neighbor_lane_id :
+       lane->lane().right_neighbor_forward_lane_id()) {
+    CHECK_NOTNULL(hdmap_ptr);
+    const auto neighbor_lane = hdmap_ptr->GetLaneById(neighbor_lane_id);
+    if (neighbor_lane == nullptr) {
+      ADEBUG << "Failed to find neighbor lane[" << neighbor_lane_id.id()
+             << "]";
+      continue;
+    }
+    const auto& lane_type = neighbor_lane->lane().type();
+    if (lane_type == hdmap::Lane::CITY_DRIVING) {
+      ADEBUG << "lane[" << lane_id << "]'s right neighbor forward lane["
+             << neighbor_lane_id.id() << "] type["
+             << Lane_LaneType_Name(lane_type) << "] can't pull over";
+      rightmost_driving_lane = false;
+      break;
+    }
+  }
+
+  if (FLAGS_enable_scenario_event_horizon) {
+    rightmost_driving_lane_cache_[lane_id] = rightmost_driving_lane;
+  }
+  return rightmost_driving_lane;
+}
+
 void ScenarioManager::Update(const common::TrajectoryPoint& ego_point,
                              const Frame& frame) {
   ACHECK(!frame.reference_line_info().empty());
@@ -890,7 +963,11 @@ ScenarioConfig::ScenarioType ScenarioManager::ScenarioDispatchNonLearning(
   ////////////////////////////////////////
   // intersection scenarios
   if (scenario_type == default_scenario_type_) {
-    scenario_type = SelectInterceptionScenario(frame);
+    // selectors only pick an intersection scenario within its start distance
+    if (!FLAGS_enable_scenario_event_horizon ||
+        IsIntersectionInHorizon(frame)) {
+      scenario_type = SelectInterceptionScenario(frame);
+    }
   }
 
   ////////////////////////////////////////
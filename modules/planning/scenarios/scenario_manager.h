@@ -17,8 +17,10 @@
 #pragma once
 
 #include <memory>
+#include <string>
 #include <unordered_map>
 
+#include "modules/common/proto/pnc_point.pb.h"
 #include "modules/common/status/status.h"
 #include "modules/planning/common/planning_context.h"
 #include "modules/planning/proto/planning_config.pb.h"
@@ -45,6 +47,24 @@ class ScenarioManager final {
  private:
   void Observe(const Frame& frame);
 
+  /**
+   * @brief Whether a first encountered intersection overlap is close enough
+   * for SelectInterceptionScenario to pick an intersection scenario.
+   */
+  bool IsIntersectionInHorizon(const Frame& frame) const;
+
+  /**
+   * @brief The routing destination on the first reference line, projected
+   * once per frame.
+   */
+  const common::SLPoint& DestinationSL(const Frame& frame);
+
+  /**
+   * @brief Whether no right forward neighbor of the lane is a CITY_DRIVING
+   * lane, so the vehicle may pull over from it.
+   */
+  bool IsRightmostDrivingLane(const hdmap::LaneInfoConstPtr& lane);
+
   std::unique_ptr<Scenario> CreateScenario(
       ScenarioConfig::ScenarioType scenario_type);
 
@@ -116,6 +136,14 @@ class ScenarioManager final {
   std::unordered_map<ReferenceLineInfo::OverlapType, hdmap::PathOverlap,
                      std::hash<int>>
       first_encountered_overlap_map_;
+
+  // the largest distance ahead at which an intersection scenario may start
+  double intersection_horizon_ = 0.0;
+  common::SLPoint dest_sl_;
+  bool has_dest_sl_ = false;
+  // IsRightmostDrivingLane results by lane id of the map they came from
+  const hdmap::HDMap* rightmost_lane_map_ = nullptr;
+  std::unordered_map<std::string, bool> rightmost_driving_lane_cache_;
 };
 
 }  // namespace scenario
@@ -25,6 +25,7 @@
 
 #include "cyber/time/clock.h"
 #include "modules/planning/common/planning_context.h"
+#include "modules/planning/common/planning_profiler.h"
 #include "modules/planning/common/speed_profile_generator.h"
 #include "modules/planning/common/trajectory/publishable_trajectory.h"
 #include "modules/planning/tasks/task_factory.h"
@@ -75,6 +76,35 @@ Stage::Stage(const ScenarioConfig::StageConfig& config,
 
 const std::string& Stage::Name() const { return name_; }
 
+const std::vector<Task*>& Stage::TaskListOnReferenceLine(
+    const size_t index) {
+  if (index == 0) {
+    return task_list_;
+  }
+  if (reference_line_task_lists_.size() < index) {
+    std::unordered_map<TaskConfig::TaskType, const TaskConfig*, std::hash<int>>
+        config_map;
+    for (const auto& task_config : config_.task_config()) {
+      config_map[task_config.task_type()] = &task_config;
+    }
+    while (reference_line_task_lists_.size() < index) {
+      reference_line_tasks_.emplace_back();
+      reference_line_task_lists_.emplace_back();
+      auto& tasks = reference_line_tasks_.back();
+      auto& task_list = reference_line_task_lists_.back();
+      for (int i = 0; i < config_.task_type_size(); ++i) {
+        auto task_type = config_.task_type(i);
+        auto& task = tasks[task_type];
+        if (task == nullptr) {
+          task = TaskFactory::CreateTask(*config_map[task_type], injector_);
+        }
+        task_list.push_back(task.get());
+      }
+    }
+  }
+  return reference_line_task_lists_[index - 1];
+}
+
 Task* Stage::FindTask(TaskConfig::TaskType task_type) const {
   auto iter = tasks_.find(task_type);
   if (iter == tasks_.end()) {
@@ -93,6 +123,8 @@ bool Stage::ExecuteTaskOnReferenceLine(
     }
 
     for (auto* task : task_list_) {
+      ScopedPlanningProfile task_profile(task->Name(),
+                                         PlanningProfileSpan::TASK);
       const double start_timestamp = Clock::NowInSeconds();
 
       const auto ret = task->Execute(frame, &reference_line_info);
@@ -145,6 +177,7 @@ bool Stage::ExecuteTaskOnReferenceLineForOnlineLearning(
   auto& picked_reference_line_info =
       frame->mutable_reference_line_info()->front();
   for (auto* task : task_list_) {
+    ScopedPlanningProfile task_profile(task->Name(), PlanningProfileSpan::TASK);
     const double start_timestamp = Clock::NowInSeconds();
 
     const auto ret = task->Execute(frame, &picked_reference_line_info);
@@ -178,6 +211,7 @@ bool Stage::ExecuteTaskOnReferenceLineForOnlineLearning(
 bool Stage::ExecuteTaskOnOpenSpace(Frame* frame) {
   auto ret = common::Status::OK();
   for (auto* task : task_list_) {
+    ScopedPlanningProfile task_profile(task->Name(), PlanningProfileSpan::TASK);
     ret = task->Execute(frame);
     if (!ret.ok()) {
       AERROR << "Failed to run tasks[" << task->Name()
@@ -94,9 +94,19 @@ class Stage {
   void RecordDebugInfo(ReferenceLineInfo* reference_line_info,
                        const std::string& name, const double time_diff_ms);
 
+  /**
+   * @brief The task sequence used on the index-th reference line. The first
+   * reference line uses TaskList(); every other one gets its own task
+   * instances so that reference lines can be planned concurrently.
+   */
+  const std::vector<Task*>& TaskListOnReferenceLine(const size_t index);
+
  protected:
   std::map<TaskConfig::TaskType, std::unique_ptr<Task>> tasks_;
   std::vector<Task*> task_list_;
+  std::vector<std::map<TaskConfig::TaskType, std::unique_ptr<Task>>>
+      reference_line_tasks_;
+  std::vector<std::vector<Task*>> reference_line_task_lists_;
   ScenarioConfig::StageConfig config_;
   ScenarioConfig::StageType next_stage_;
   void* context_ = nullptr;
@@ -81,20 +81,43 @@ Status OpenSpaceRoiDecider::Process(Frame *frame) {
       return Status(ErrorCode::PLANNING_ERROR, msg);
     }
 
-    if (!GetParkingSpot(frame, &spot_vertices, &nearby_path)) {
-      const std::string msg = "Fail to get parking boundary from map";
-      AERROR << msg;
-      return Status(ErrorCode::PLANNING_ERROR, msg);
-    }
+    if (FLAGS_enable_open_space_roi_cache &&
+        !roi_cache_.parking_spot_id.empty() &&
+        roi_cache_.parking_spot_id == target_parking_spot_id_) {
+      if (!GetCachedParkingBoundary(frame, &spot_vertices, &roi_boundary)) {
+        const std::string msg = "Fail to get parking boundary from cache";
+        AERROR << msg;
+        return Status(ErrorCode::PLANNING_ERROR, msg);
+      }
+    } else {
+      roi_cache_ = ParkingRoiCache();
+      if (!GetParkingSpot(frame, &spot_vertices, &nearby_path)) {
+        const std::string msg = "Fail to get parking boundary from map";
+        AERROR << msg;
+        return Status(ErrorCode::PLANNING_ERROR, msg);
+      }
 
-    SetOrigin(frame, spot_vertices);
+      SetOrigin(frame, spot_vertices);
 
-    SetParkingSpotEndPose(frame, spot_vertices);
+      SetParkingSpotEndPose(frame, spot_vertices);
 
-    if (!GetParkingBoundary(frame, spot_vertices, nearby_path, &roi_boundary)) {
-      const std::string msg = "Fail to get parking boundary from map";
-      AERROR << msg;
-      return Status(ErrorCode::PLANNING_ERROR, msg);
+      if (!GetParkingBoundary(frame, spot_vertices, nearby_path,
+                              &roi_boundary)) {
+        const std::string msg = "Fail to get parking boundary from map";
+        AERROR << msg;
+        return Status(ErrorCode::PLANNING_ERROR, msg);
+      }
+
+      if (FLAGS_enable_open_space_roi_cache) {
+        roi_cache_.parking_spot_id = target_parking_spot_id_;
+        roi_cache_.parking_lane =
+            frame->open_space_info().target_parking_lane();
+        roi_cache_.nearby_path = std::move(nearby_path);
+        roi_cache_.vertices = spot_vertices;
+        roi_cache_.roi_boundary = roi_boundary;
+        roi_cache_.roi_xy_boundary =
+            frame->open_space_info().ROI_xy_boundary();
+      }
     }
   } else if (roi_type == OpenSpaceRoiDeciderConfig::PULL_OVER) {
     if (!GetPullOverSpot(frame, &spot_vertices, &nearby_path)) {
@@ -947,19 +970,58 @@ bool OpenSpaceRoiDecider::GetParkingBoundary(
       frame->mutable_open_space_info()->mutable_ROI_xy_boundary();
   xy_boundary->assign(ROI_xy_boundary.begin(), ROI_xy_boundary.end());
 
-  Vec2d vehicle_xy = Vec2d(vehicle_state_.x(), vehicle_state_.y());
-  vehicle_xy -= origin_point;
-  vehicle_xy.SelfRotate(-origin_heading);
-  if (vehicle_xy.x() < ROI_xy_boundary[0] ||
-      vehicle_xy.x() > ROI_xy_boundary[1] ||
-      vehicle_xy.y() < ROI_xy_boundary[2] ||
-      vehicle_xy.y() > ROI_xy_boundary[3]) {
+  if (!IsVehicleInRoiXYBoundary(*frame)) {
+    AERROR << "vehicle outside of xy boundary of parking ROI";
+    return false;
+  }
+  return true;
+}
+
+bool OpenSpaceRoiDecider::GetCachedParkingBoundary(
+    Frame *const frame, std::array<Vec2d, 4> *vertices,
+    std::vector<std::vector<common::math::Vec2d>> *const roi_parking_boundary) {
+  frame->mutable_open_space_info()->set_target_parking_lane(
+      roi_cache_.parking_lane);
+  hdmap::Id id;
+  id.set_id(roi_cache_.parking_spot_id);
+  const auto target_parking_spot = hdmap_->GetParkingSpaceById(id);
+  if (target_parking_spot == nullptr ||
+      !CheckDistanceToParkingSpot(roi_cache_.nearby_path,
+                                  target_parking_spot)) {
+    AERROR << "target parking spot found, but too far, distance larger than "
+              "pre-defined distance";
+    return false;
+  }
+
+  *vertices = roi_cache_.vertices;
+  SetOrigin(frame, *vertices);
+  SetParkingSpotEndPose(frame, *vertices);
+
+  *roi_parking_boundary = roi_cache_.roi_boundary;
+  auto *xy_boundary =
+      frame->mutable_open_space_info()->mutable_ROI_xy_boundary();
+  xy_boundary->assign(roi_cache_.roi_xy_boundary.begin(),
+                      roi_cache_.roi_xy_boundary.end());
+  if (!IsVehicleInRoiXYBoundary(*frame)) {
     AERROR << "vehicle outside of xy boundary of parking ROI";
     return false;
   }
   return true;
 }
 
+bool OpenSpaceRoiDecider::IsVehicleInRoiXYBoundary(const Frame &frame) {
+  const auto &open_space_info = frame.open_space_info();
+  // xy_boundary in xmin, xmax, ymin, ymax.
+  const auto &roi_xy_boundary = open_space_info.ROI_xy_boundary();
+  Vec2d vehicle_xy = Vec2d(vehicle_state_.x(), vehicle_state_.y());
+  vehicle_xy -= open_space_info.origin_point();
+  vehicle_xy.SelfRotate(-open_space_info.origin_heading());
+  return !(vehicle_xy.x() < roi_xy_boundary[0] ||
+           vehicle_xy.x() > roi_xy_boundary[1] ||
+           vehicle_xy.y() < roi_xy_boundary[2] ||
+           vehicle_xy.y() > roi_xy_boundary[3]);
+}
+
 bool OpenSpaceRoiDecider::GetPullOverBoundary(
     Frame *const frame, const std::array<common::math::Vec2d, 4> &vertices,
     const hdmap::Path &nearby_path,
@@ -1569,6 +1631,9 @@ bool OpenSpaceRoiDecider::FilterOutObstacle(const Frame &frame,
 }
 
 bool OpenSpaceRoiDecider::LoadObstacleInHyperPlanes(Frame *const frame) {
+  if (!roi_cache_.parking_spot_id.empty()) {
+    return LoadCachedObstacleInHyperPlanes(frame);
+  }
   *(frame->mutable_open_space_info()->mutable_obstacles_A()) =
       Eigen::MatrixXd::Zero(
           frame->open_space_info().obstacles_edges_num().sum(), 2);
@@ -1588,6 +1653,57 @@ bool OpenSpaceRoiDecider::LoadObstacleInHyperPlanes(Frame *const frame) {
   return true;
 }
 
+bool OpenSpaceRoiDecider::LoadCachedObstacleInHyperPlanes(
+    Frame *const frame) {
+  const auto &open_space_info = frame->open_space_info();
+  const size_t obstacles_num = open_space_info.obstacles_num();
+  const Eigen::MatrixXi &obstacles_edges_num =
+      open_space_info.obstacles_edges_num();
+  const auto &obstacles_vertices_vec = open_space_info.obstacles_vertices_vec();
+  // the roi boundary comes first, followed by the perception obstacles
+  const size_t boundaries_num = roi_cache_.roi_boundary.size();
+  if (obstacles_num < boundaries_num ||
+      obstacles_vertices_vec.size() != obstacles_num) {
+    AERROR << "obstacles_num != obstacles_vertices_vec.size()";
+    return false;
+  }
+  if (roi_cache_.obstacles_A.rows() == 0 &&
+      !GetHyperPlanes(boundaries_num, obstacles_edges_num.topRows(
+                                          static_cast<int>(boundaries_num)),
+                      roi_cache_.roi_boundary, &roi_cache_.obstacles_A,
+                      &roi_cache_.obstacles_b)) {
+    AERROR << "Fail to present roi boundary in hyperplane";
+    return false;
+  }
+
+  const size_t perception_obstacles_num = obstacles_num - boundaries_num;
+  const std::vector<std::vector<Vec2d>> perception_obstacles_vertices(
+      obstacles_vertices_vec.begin() + boundaries_num,
+      obstacles_vertices_vec.end());
+  Eigen::MatrixXd perception_obstacles_A;
+  Eigen::MatrixXd perception_obstacles_b;
+  if (!GetHyperPlanes(perception_obstacles_num,
+                      obstacles_edges_num.bottomRows(
+                          static_cast<int>(perception_obstacles_num)),
+                      perception_obstacles_vertices, &perception_obstacles_A,
+                      &perception_obstacles_b)) {
+    AERROR << "Fail to present obstacle in hyperplane";
+    return false;
+  }
+
+  const Eigen::Index boundaries_rows = roi_cache_.obstacles_A.rows();
+  const Eigen::Index perception_obstacles_rows = perception_obstacles_A.rows();
+  auto *obstacles_A = frame->mutable_open_space_info()->mutable_obstacles_A();
+  auto *obstacles_b = frame->mutable_open_space_info()->mutable_obstacles_b();
+  obstacles_A->resize(boundaries_rows + perception_obstacles_rows, 2);
+  obstacles_b->resize(boundaries_rows + perception_obstacles_rows, 1);
+  obstacles_A->topRows(boundaries_rows) = roi_cache_.obstacles_A;
+  obstacles_b->topRows(boundaries_rows) = roi_cache_.obstacles_b;
+  obstacles_A->bottomRows(perception_obstacles_rows) = perception_obstacles_A;
+  obstacles_b->bottomRows(perception_obstacles_rows) = perception_obstacles_b;
+  return true;
+}
+
 bool OpenSpaceRoiDecider::GetHyperPlanes(
     const size_t &obstacles_num, const Eigen::MatrixXi &obstacles_edges_num,
     const std::vector<std::vector<Vec2d>> &obstacles_vertices_vec,
@@ -100,6 +100,16 @@ class OpenSpaceRoiDecider : public Decider {
       std::vector<double> *left_lane_road_width,
       std::vector<double> *right_lane_road_width);
 
+  // @brief Reuse the parking spot and roi boundary of the cached target
+  // parking spot, only checking them against the vehicle
+  bool GetCachedParkingBoundary(
+      Frame *const frame, std::array<common::math::Vec2d, 4> *vertices,
+      std::vector<std::vector<common::math::Vec2d>> *const
+          roi_parking_boundary);
+
+  // @brief whether the vehicle is inside ROI_xy_boundary of the frame
+  bool IsVehicleInRoiXYBoundary(const Frame &frame);
+
   // @brief Check single-side curb and add key points to the boundary
   void AddBoundaryKeyPoint(
       const hdmap::Path &nearby_path, const double check_point_s,
@@ -172,6 +182,10 @@ class OpenSpaceRoiDecider : public Decider {
   // inequality as Ax>b
   bool LoadObstacleInHyperPlanes(Frame *const frame);
 
+  // @brief LoadObstacleInHyperPlanes() with the hyperplanes of the roi
+  // boundary taken from roi_cache_
+  bool LoadCachedObstacleInHyperPlanes(Frame *const frame);
+
   // @brief Helper function for LoadObstacleInHyperPlanes()
   bool GetHyperPlanes(const size_t &obstacles_num,
                       const Eigen::MatrixXi &obstacles_edges_num,
@@ -207,6 +221,22 @@ class OpenSpaceRoiDecider : public Decider {
   ThreadSafeIndexedObstacles *obstacles_by_frame_;
 
   common::VehicleState vehicle_state_;
+
+  // @brief the static roi of the target parking spot, which the map
+  // boundary and its hyperplanes are built once for
+  struct ParkingRoiCache {
+    std::string parking_spot_id;
+    hdmap::LaneInfoConstPtr parking_lane;
+    hdmap::Path nearby_path;
+    std::array<common::math::Vec2d, 4> vertices;
+    std::vector<std::vector<common::math::Vec2d>> roi_boundary;
+    std::vector<double> roi_xy_boundary;
+    // hyperplanes of roi_boundary, filled by the first
+    // LoadObstacleInHyperPlanes() of the spot
+    Eigen::MatrixXd obstacles_A;
+    Eigen::MatrixXd obstacles_b;
+  };
+  ParkingRoiCache roi_cache_;
 };
 
 }  // namespace planning
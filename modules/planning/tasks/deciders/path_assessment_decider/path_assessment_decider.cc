@@ -17,14 +17,17 @@
 #include "modules/planning/tasks/deciders/path_assessment_decider/path_assessment_decider.h"
 
 #include <algorithm>
+#include <future>
 #include <limits>
 #include <memory>
 #include <utility>
 
+#include "cyber/task/task.h"
 #include "modules/common/configs/vehicle_config_helper.h"
 #include "modules/common/proto/pnc_point.pb.h"
 #include "modules/map/hdmap/hdmap_util.h"
 #include "modules/planning/common/planning_context.h"
+#include "modules/planning/common/planning_gflags.h"
 #include "modules/planning/tasks/deciders/path_bounds_decider/path_bounds_decider.h"
 #include "modules/planning/tasks/deciders/utils/path_decider_obstacle_utils.h"
 
@@ -68,18 +71,33 @@ Status PathAssessmentDecider::Process(
   const auto& end_time0 = std::chrono::system_clock::now();
 
   // 1. Remove invalid path.
+  std::vector<bool> is_valid(candidate_path_data.size(), false);
+  if (FLAGS_enable_multi_thread_in_path_candidates &&
+      candidate_path_data.size() > 1) {
+    // the candidates are checked against the reference line info alone, the
+    // calling thread takes the first one
+    std::vector<std::future<bool>> results;
+    for (size_t i = 1; i < candidate_path_data.size(); ++i) {
+      results.push_back(cyber::Async(&PathAssessmentDecider::IsValidPath, this,
+                                     std::cref(*reference_line_info),
+                                     std::cref(candidate_path_data[i])));
+    }
+    is_valid[0] = IsValidPath(*reference_line_info, candidate_path_data[0]);
+    for (size_t i = 1; i < candidate_path_data.size(); ++i) {
+      is_valid[i] = results[i - 1].get();
+    }
+  } else {
+    for (size_t i = 0; i < candidate_path_data.size(); ++i) {
+      is_valid[i] = IsValidPath(*reference_line_info, candidate_path_data[i]);
+    }
+  }
   std::vector<PathData> valid_path_data;
-  for (const auto& curr_path_data : candidate_path_data) {
-    // RecordDebugInfo(curr_path_data, curr_path_data.path_label(),
+  for (size_t i = 0; i < candidate_path_data.size(); ++i) {
+    // RecordDebugInfo(candidate_path_data[i],
+    //                 candidate_path_data[i].path_label(),
     //                 reference_line_info);
-    if (curr_path_data.path_label().find("fallback") != std::string::npos) {
-      if (IsValidFallbackPath(*reference_line_info, curr_path_data)) {
-        valid_path_data.push_back(curr_path_data);
-      }
-    } else {
-      if (IsValidRegularPath(*reference_line_info, curr_path_data)) {
-        valid_path_data.push_back(curr_path_data);
-      }
+    if (is_valid[i]) {
+      valid_path_data.push_back(candidate_path_data[i]);
     }
   }
   const auto& end_time1 = std::chrono::system_clock::now();
@@ -88,6 +106,24 @@ Status PathAssessmentDecider::Process(
          << " msec.";
 
   // 2. Analyze and add important info for speed decider to use
+  if (FLAGS_enable_multi_thread_in_path_candidates &&
+      valid_path_data.size() > 1) {
+    std::vector<std::future<void>> results;
+    for (size_t i = 1; i < valid_path_data.size(); ++i) {
+      results.push_back(cyber::Async(&PathAssessmentDecider::LabelPath, this,
+                                     std::cref(*reference_line_info),
+                                     &valid_path_data[i]));
+    }
+    LabelPath(*reference_line_info, &valid_path_data[0]);
+    for (auto& result : results) {
+      result.get();
+    }
+  } else {
+    for (auto& curr_path_data : valid_path_data) {
+      LabelPath(*reference_line_info, &curr_path_data);
+    }
+  }
+
   size_t cnt = 0;
   const Obstacle* blocking_obstacle_on_selflane = nullptr;
   for (size_t i = 0; i != valid_path_data.size(); ++i) {
@@ -102,13 +138,6 @@ Status PathAssessmentDecider::Process(
       }
       continue;
     }
-    SetPathInfo(*reference_line_info, &curr_path_data);
-    // Trim all the lane-borrowing paths so that it ends with an in-lane
-    // position.
-    if (curr_path_data.path_label().find("pullover") == std::string::npos) {
-      TrimTailingOutLanePoints(&curr_path_data);
-    }
-
     // find blocking_obstacle_on_selflane, to be used for lane selection later
     if (curr_path_data.path_label().find("self") != std::string::npos) {
       const auto blocking_obstacle_id = curr_path_data.blocking_obstacle_id();
@@ -342,6 +371,27 @@ bool ComparePathData(const PathData& lhs, const PathData& rhs,
   return false;
 }
 
+bool PathAssessmentDecider::IsValidPath(
+    const ReferenceLineInfo& reference_line_info, const PathData& path_data) {
+  if (path_data.path_label().find("fallback") != std::string::npos) {
+    return IsValidFallbackPath(reference_line_info, path_data);
+  }
+  return IsValidRegularPath(reference_line_info, path_data);
+}
+
+void PathAssessmentDecider::LabelPath(
+    const ReferenceLineInfo& reference_line_info, PathData* const path_data) {
+  if (path_data->path_label().find("fallback") != std::string::npos) {
+    return;
+  }
+  SetPathInfo(reference_line_info, path_data);
+  // Trim all the lane-borrowing paths so that it ends with an in-lane
+  // position.
+  if (path_data->path_label().find("pullover") == std::string::npos) {
+    TrimTailingOutLanePoints(path_data);
+  }
+}
+
 bool PathAssessmentDecider::IsValidRegularPath(
     const ReferenceLineInfo& reference_line_info, const PathData& path_data) {
   // Basic sanity checks.
@@ -44,6 +44,10 @@ class PathAssessmentDecider : public Decider {
   /////////////////////////////////////////////////////////////////////////////
   // Below are functions called when executing PathAssessmentDecider.
 
+  // Check a regular or fallback path by its label.
+  bool IsValidPath(const ReferenceLineInfo& reference_line_info,
+                   const PathData& path_data);
+
   bool IsValidRegularPath(const ReferenceLineInfo& reference_line_info,
                           const PathData& path_data);
 
@@ -55,6 +59,10 @@ class PathAssessmentDecider : public Decider {
 
   void TrimTailingOutLanePoints(PathData* const path_data);
 
+  // Set the path info of a regular path and trim its out-lane tail.
+  void LabelPath(const ReferenceLineInfo& reference_line_info,
+                 PathData* const path_data);
+
   /////////////////////////////////////////////////////////////////////////////
   // Below are functions used when checking validity of path.
 
@@ -18,12 +18,14 @@
 
 #include <algorithm>
 #include <functional>
+#include <future>
 #include <limits>
 #include <memory>
 #include <set>
 
 #include "absl/strings/str_cat.h"
 
+#include "cyber/task/task.h"
 #include "modules/common/configs/vehicle_config_helper.h"
 #include "modules/common/util/point_factory.h"
 #include "modules/map/hdmap/hdmap_util.h"
@@ -208,14 +210,47 @@ Status PathBoundsDecider::Process(
   // Try every possible lane-borrow option:
   // PathBound regular_self_path_bound;
   // bool exist_self_path_bound = false;
-  for (const auto& lane_borrow_info : lane_borrow_info_list) {
-    PathBound regular_path_bound;
-    std::string blocking_obstacle_id = "";
-    std::string borrow_lane_type = "";
-    Status ret = GenerateRegularPathBound(
-        *reference_line_info, lane_borrow_info, &regular_path_bound,
-        &blocking_obstacle_id, &borrow_lane_type);
-    if (!ret.ok()) {
+  const size_t num_lane_borrow_info = lane_borrow_info_list.size();
+  std::vector<PathBound> regular_path_bounds(num_lane_borrow_info);
+  std::vector<std::string> blocking_obstacle_ids(num_lane_borrow_info);
+  std::vector<std::string> borrow_lane_types(num_lane_borrow_info);
+  std::vector<Status> rets(num_lane_borrow_info);
+  if (FLAGS_enable_multi_thread_in_path_candidates &&
+      num_lane_borrow_info > 1) {
+    // the lane-borrow options only read the reference line info, whose
+    // obstacle index is built here before they share it
+    if (FLAGS_enable_obstacle_spatial_index) {
+      reference_line_info->obstacle_spatial_index();
+    }
+    std::vector<std::future<Status>> results;
+    for (size_t i = 1; i < num_lane_borrow_info; ++i) {
+      results.push_back(cyber::Async(
+          &PathBoundsDecider::GenerateRegularPathBound, this,
+          std::cref(*reference_line_info), std::cref(lane_borrow_info_list[i]),
+          &regular_path_bounds[i], &blocking_obstacle_ids[i],
+          &borrow_lane_types[i]));
+    }
+    rets[0] = GenerateRegularPathBound(
+        *reference_line_info, lane_borrow_info_list[0], &regular_path_bounds[0],
+        &blocking_obstacle_ids[0], &borrow_lane_types[0]);
+    for (size_t i = 1; i < num_lane_borrow_info; ++i) {
+      rets[i] = results[i - 1].get();
+    }
+  } else {
+    for (size_t i = 0; i < num_lane_borrow_info; ++i) {
+      rets[i] = GenerateRegularPathBound(
+          *reference_line_info, lane_borrow_info_list[i],
+          &regular_path_bounds[i], &blocking_obstacle_ids[i],
+          &borrow_lane_types[i]);
+    }
+  }
+
+  for (size_t i = 0; i < num_lane_borrow_info; ++i) {
+    const auto& lane_borrow_info = lane_borrow_info_list[i];
+    const auto& regular_path_bound = regular_path_bounds[i];
+    const auto& blocking_obstacle_id = blocking_obstacle_ids[i];
+    const auto& borrow_lane_type = borrow_lane_types[i];
+    if (!rets[i].ok()) {
       continue;
     }
     if (regular_path_bound.empty()) {
@@ -347,8 +382,8 @@ Status PathBoundsDecider::GenerateRegularPathBound(
 
   // 3. Fine-tune the boundary based on static obstacles
   PathBound temp_path_bound = *path_bound;
-  if (!GetBoundaryFromStaticObstacles(reference_line_info.path_decision(),
-                                      path_bound, blocking_obstacle_id)) {
+  if (!GetBoundaryFromStaticObstacles(reference_line_info, path_bound,
+                                      blocking_obstacle_id)) {
     const std::string msg =
         "Failed to decide fine tune the boundaries after "
         "taking into consideration all static obstacles.";
@@ -401,8 +436,8 @@ Status PathBoundsDecider::GenerateLaneChangePathBound(
 
   PathBound temp_path_bound = *path_bound;
   std::string blocking_obstacle_id;
-  if (!GetBoundaryFromStaticObstacles(reference_line_info.path_decision(),
-                                      path_bound, &blocking_obstacle_id)) {
+  if (!GetBoundaryFromStaticObstacles(reference_line_info, path_bound,
+                                      &blocking_obstacle_id)) {
     const std::string msg =
         "Failed to decide fine tune the boundaries after "
         "taking into consideration all static obstacles.";
@@ -458,8 +493,8 @@ Status PathBoundsDecider::GeneratePullOverPathBound(
   // 3. Fine-tune the boundary based on static obstacles
   PathBound temp_path_bound = *path_bound;
   std::string blocking_obstacle_id;
-  if (!GetBoundaryFromStaticObstacles(reference_line_info.path_decision(),
-                                      path_bound, &blocking_obstacle_id)) {
+  if (!GetBoundaryFromStaticObstacles(reference_line_info, path_bound,
+                                      &blocking_obstacle_id)) {
     const std::string msg =
         "Failed to decide fine tune the boundaries after "
         "taking into consideration all static obstacles.";
@@ -1405,11 +1440,20 @@ void PathBoundsDecider::GetBoundaryFromLaneChangeForbiddenZone(
 // obstacles whose headings differ from road-headings a lot.
 // TODO(all): (future work) this can be improved in the future.
 bool PathBoundsDecider::GetBoundaryFromStaticObstacles(
-    const PathDecision& path_decision, PathBound* const path_boundaries,
-    std::string* const blocking_obstacle_id) {
+    const ReferenceLineInfo& reference_line_info,
+    PathBound* const path_boundaries, std::string* const blocking_obstacle_id) {
   // Preprocessing.
-  auto indexed_obstacles = path_decision.obstacles();
-  auto sorted_obstacles = SortObstaclesForSweepLine(indexed_obstacles);
+  std::vector<const Obstacle*> obstacles;
+  if (FLAGS_enable_obstacle_spatial_index && !path_boundaries->empty()) {
+    // Obstacles starting beyond the last path point never enter the sweep.
+    obstacles =
+        reference_line_info.obstacle_spatial_index().GetObstaclesInSRange(
+            adc_frenet_s_, std::get<0>(path_boundaries->back()) +
+                               FLAGS_obstacle_lon_start_buffer);
+  } else {
+    obstacles = reference_line_info.path_decision().obstacles().Items();
+  }
+  auto sorted_obstacles = SortObstaclesForSweepLine(obstacles);
   ADEBUG << "There are " << sorted_obstacles.size() << " obstacles.";
   double center_line = adc_frenet_l_;
   size_t obs_idx = 0;
@@ -1531,11 +1575,11 @@ bool PathBoundsDecider::GetBoundaryFromStaticObstacles(
 
 // The tuple contains (is_start_s, s, l_min, l_max, obstacle_id)
 std::vector<ObstacleEdge> PathBoundsDecider::SortObstaclesForSweepLine(
-    const IndexedList<std::string, Obstacle>& indexed_obstacles) {
+    const std::vector<const Obstacle*>& obstacles) {
   std::vector<ObstacleEdge> sorted_obstacles;
 
   // Go through every obstacle and preprocess it.
-  for (const auto* obstacle : indexed_obstacles.Items()) {
+  for (const auto* obstacle : obstacles) {
     // Only focus on those within-scope obstacles.
     if (!IsWithinPathDeciderScopeObstacle(*obstacle)) {
       continue;
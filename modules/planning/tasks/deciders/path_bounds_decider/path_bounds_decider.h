@@ -218,13 +218,12 @@ class PathBoundsDecider : public Decider {
    *   generated by optimizer won't collide with any static obstacle.
    */
   bool GetBoundaryFromStaticObstacles(
-      const PathDecision& path_decision,
+      const ReferenceLineInfo& reference_line_info,
       std::vector<std::tuple<double, double, double>>* const path_boundaries,
       std::string* const blocking_obstacle_id);
 
   std::vector<std::tuple<int, double, double, double, std::string>>
-  SortObstaclesForSweepLine(
-      const IndexedList<std::string, Obstacle>& indexed_obstacles);
+  SortObstaclesForSweepLine(const std::vector<const Obstacle*>& obstacles);
 
   std::vector<std::vector<std::tuple<double, double, double>>>
   ConstructSubsequentPathBounds(
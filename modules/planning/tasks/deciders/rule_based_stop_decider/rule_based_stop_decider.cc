@@ -16,6 +16,7 @@
 
 #include "modules/planning/tasks/deciders/rule_based_stop_decider/rule_based_stop_decider.h"
 
+#include <mutex>
 #include <string>
 #include <tuple>
 #include <vector>
@@ -134,6 +135,10 @@ void RuleBasedStopDecider::AddPathEndStop(
 
 void RuleBasedStopDecider::StopOnSidePass(
     Frame *const frame, ReferenceLineInfo *const reference_line_info) {
+  // the side pass state is shared by every reference line, which may be
+  // planned concurrently
+  static std::mutex side_pass_mutex;
+  std::lock_guard<std::mutex> lock(side_pass_mutex);
   static bool check_clear;
   static common::PathPoint change_lane_stop_path_point;
 
@@ -21,12 +21,14 @@
 #include "modules/planning/tasks/deciders/speed_bounds_decider/st_boundary_mapper.h"
 
 #include <algorithm>
+#include <cmath>
 #include <limits>
 #include <memory>
 #include <utility>
 
 #include "cyber/common/log.h"
 #include "modules/common/configs/vehicle_config_helper.h"
+#include "modules/common/math/aabox2d.h"
 #include "modules/common/math/line_segment2d.h"
 #include "modules/common/math/vec2d.h"
 #include "modules/common/proto/pnc_point.pb.h"
@@ -44,6 +46,7 @@ namespace planning {
 using apollo::common::ErrorCode;
 using apollo::common::PathPoint;
 using apollo::common::Status;
+using apollo::common::math::AABox2d;
 using apollo::common::math::Box2d;
 using apollo::common::math::Vec2d;
 
@@ -260,10 +263,16 @@ bool STBoundaryMapper::GetOverlapBoundaryPoints(
     } else {
       discretized_path = DiscretizedPath(path_points);
     }
+    if (FLAGS_enable_interval_st_boundary_mapping) {
+      GetOverlapBoundaryPointsByInterval(discretized_path, obstacle, l_buffer,
+                                         upper_points, lower_points);
+      DCHECK_EQ(lower_points->size(), upper_points->size());
+      return (lower_points->size() > 1 && upper_points->size() > 1);
+    }
     // 2. Go through every point of the predicted obstacle trajectory.
     for (int i = 0; i < trajectory.trajectory_point_size(); ++i) {
       const auto& trajectory_point = trajectory.trajectory_point(i);
-      const Box2d obs_box = obstacle.GetBoundingBox(trajectory_point);
+      const Box2d obs_box = obstacle.GetTrajectoryPointBoundingBox(i);
 
       double trajectory_point_time = trajectory_point.relative_time();
       static constexpr double kNegtiveTimeThreshold = -1.0;
@@ -338,6 +347,139 @@ bool STBoundaryMapper::GetOverlapBoundaryPoints(
   return (lower_points->size() > 1 && upper_points->size() > 1);
 }
 
+void STBoundaryMapper::GetOverlapBoundaryPointsByInterval(
+    const DiscretizedPath& discretized_path, const Obstacle& obstacle,
+    const double l_buffer, std::vector<STPoint>* upper_points,
+    std::vector<STPoint>* lower_points) const {
+  static constexpr double kPathSegmentLength = 5.0;  // in meters
+  const double step_length = vehicle_param_.front_edge_to_center();
+  const double path_len =
+      std::min(FLAGS_max_trajectory_len, discretized_path.Length());
+  const double front_s = discretized_path.front().s();
+  const double default_min_step = 0.1;  // in meters
+  const double fine_tuning_step_length =
+      std::fmin(default_min_step, discretized_path.Length() / 50);
+  const double forward_distance_base =
+      vehicle_param_.length() + vehicle_param_.width();
+
+  // 1. Bound the ADC boxes along every path segment: the rear axle center
+  // stays inside the box of the segment points, and every corner of the ADC
+  // is within adc_radius of it.
+  const double adc_radius = std::hypot(
+      std::fmax(vehicle_param_.front_edge_to_center(),
+                vehicle_param_.back_edge_to_center()),
+      std::fmax(vehicle_param_.left_edge_to_center(),
+                vehicle_param_.right_edge_to_center()) +
+          l_buffer);
+  std::vector<AABox2d> segment_boxes;
+  size_t point_index = 0;
+  for (double seg_s = 0.0; seg_s < path_len; seg_s += kPathSegmentLength) {
+    const double seg_end = std::fmin(seg_s + kPathSegmentLength, path_len);
+    std::vector<Vec2d> points;
+    for (const double s : {seg_s, seg_end}) {
+      const auto point = discretized_path.Evaluate(s + front_s);
+      points.emplace_back(point.x(), point.y());
+    }
+    while (point_index < discretized_path.size() &&
+           discretized_path[point_index].s() - front_s < seg_end) {
+      const auto& point = discretized_path[point_index++];
+      points.emplace_back(point.x(), point.y());
+    }
+    const AABox2d box(points);
+    segment_boxes.emplace_back(
+        Vec2d(box.min_x() - adc_radius, box.min_y() - adc_radius),
+        Vec2d(box.max_x() + adc_radius, box.max_y() + adc_radius));
+  }
+  if (segment_boxes.empty()) {
+    return;
+  }
+
+  const auto& trajectory = obstacle.Trajectory();
+  std::vector<bool> candidates(segment_boxes.size());
+  for (int i = 0; i < trajectory.trajectory_point_size(); ++i) {
+    const double trajectory_point_time =
+        trajectory.trajectory_point(i).relative_time();
+    static constexpr double kNegtiveTimeThreshold = -1.0;
+    if (trajectory_point_time < kNegtiveTimeThreshold) {
+      continue;
+    }
+    const Box2d obs_box = obstacle.GetTrajectoryPointBoundingBox(i);
+    const AABox2d obs_aabox = obs_box.GetAABox();
+
+    // 2. Only the segments whose boxes meet the obstacle box can overlap.
+    bool has_candidate = false;
+    for (size_t k = 0; k < segment_boxes.size(); ++k) {
+      candidates[k] = segment_boxes[k].HasOverlap(obs_aabox);
+      has_candidate = has_candidate || candidates[k];
+    }
+    if (!has_candidate) {
+      continue;
+    }
+    const auto is_candidate = [&](const double s) {
+      const auto k = static_cast<size_t>(s / kPathSegmentLength);
+      return s >= path_len || candidates[std::min(k, candidates.size() - 1)];
+    };
+    const auto overlaps = [&](const double s) {
+      return CheckOverlap(discretized_path.Evaluate(s + front_s), obs_box,
+                          l_buffer);
+    };
+    // the last s of the transition from no overlap at `s_out` to overlap at
+    // `s_in`, within the fine tuning resolution
+    const auto bisect = [&](double s_out, double s_in) {
+      while (std::fabs(s_in - s_out) > fine_tuning_step_length) {
+        const double s_mid = 0.5 * (s_out + s_in);
+        if (overlaps(s_mid)) {
+          s_in = s_mid;
+        } else {
+          s_out = s_mid;
+        }
+      }
+      return s_in;
+    };
+
+    // 3. The first overlapping s on the coarse steps of the path.
+    double path_s = 0.0;
+    bool found = false;
+    for (; path_s < path_len; path_s += step_length) {
+      if (is_candidate(path_s) && overlaps(path_s)) {
+        found = true;
+        break;
+      }
+    }
+    if (!found) {
+      continue;
+    }
+
+    // 4. Bisect the lower boundary after the previous coarse step, which
+    // has no overlap, and the upper one from the far end of the window.
+    const double low_s =
+        path_s > 0.0 ? bisect(path_s - step_length, path_s) : 0.0;
+    const double forward_distance =
+        forward_distance_base + obs_box.length() + obs_box.width();
+    const double high_end =
+        std::fmin(discretized_path.Length(), path_s + forward_distance);
+    double high_s = path_s;
+    if (overlaps(high_end)) {
+      high_s = high_end;
+    } else {
+      double s_out = high_end;
+      for (double s = high_end - step_length; s > path_s; s -= step_length) {
+        if (is_candidate(s) && overlaps(s)) {
+          high_s = s;
+          break;
+        }
+        s_out = s;
+      }
+      high_s = bisect(s_out, high_s);
+    }
+
+    lower_points->emplace_back(low_s - speed_bounds_config_.point_extension(),
+                               trajectory_point_time);
+    upper_points->emplace_back(high_s + speed_bounds_config_.point_extension(),
+                               trajectory_point_time);
+  }
+}
+
 void STBoundaryMapper::ComputeSTBoundaryWithDecision(
     Obstacle* obstacle, const ObjectDecisionType& decision) const {
   DCHECK(decision.has_follow() || decision.has_yield() ||
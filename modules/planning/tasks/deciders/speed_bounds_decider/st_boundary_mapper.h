@@ -28,6 +28,7 @@
 #include "modules/common/status/status.h"
 #include "modules/planning/common/dependency_injector.h"
 #include "modules/planning/common/obstacle.h"
+#include "modules/planning/common/path/discretized_path.h"
 #include "modules/planning/common/path/path_data.h"
 #include "modules/planning/common/path_decision.h"
 #include "modules/planning/common/speed/st_boundary.h"
@@ -68,6 +69,17 @@ class STBoundaryMapper {
       const Obstacle& obstacle, std::vector<STPoint>* upper_points,
       std::vector<STPoint>* lower_points) const;
 
+  /** @brief Finds the same boundary points as the stepping search of
+   * GetOverlapBoundaryPoints for an obstacle with predicted trajectory, with
+   * fewer overlap checks: the obstacle boxes are first intersected with the
+   * bounding boxes the ADC sweeps along coarse path segments, and the
+   * boundaries are then bisected within the candidate s-intervals only.
+   */
+  void GetOverlapBoundaryPointsByInterval(
+      const DiscretizedPath& discretized_path, const Obstacle& obstacle,
+      const double l_buffer, std::vector<STPoint>* upper_points,
+      std::vector<STPoint>* lower_points) const;
+
   /** @brief Given a path-point and an obstacle bounding box, check if the
    *        ADC, when at that path-point, will collide with the obstacle.
    * @param The path-point of the center of rear-axis for ADC.
@@ -505,12 +505,13 @@ bool STObstaclesProcessor::ComputeObstacleSTBoundary(
     // Go through every occurrence of the obstacle at all timesteps, and
     // figure out the overlapping s-max and s-min one by one.
     bool is_obs_first_traj_pt = true;
-    for (const auto& obs_traj_pt : obs_trajectory.trajectory_point()) {
+    for (int i = 0; i < obs_trajectory.trajectory_point_size(); ++i) {
+      const auto& obs_traj_pt = obs_trajectory.trajectory_point(i);
       // TODO(jiacheng): Currently, if the obstacle overlaps with ADC at
       // disjoint segments (happens very rarely), we merge them into one.
       // In the future, this could be considered in greater details rather
       // than being approximated.
-      const Box2d& obs_box = obstacle.GetBoundingBox(obs_traj_pt);
+      const Box2d obs_box = obstacle.GetTrajectoryPointBoundingBox(i);
       ADEBUG << obs_box.DebugString();
       std::pair<double, double> overlapping_s;
       if (GetOverlappingS(adc_path_points, obs_box, kADCSafetyLBuffer,
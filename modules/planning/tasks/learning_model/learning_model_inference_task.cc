@@ -25,6 +25,7 @@
 #include <string>
 
 #include "absl/strings/str_cat.h"
+#include "modules/planning/common/planning_gflags.h"
 #include "modules/planning/learning_based/model_inference/trajectory_imitation_libtorch_inference.h"
 #include "modules/planning/proto/learning_data.pb.h"
 #include "modules/planning/proto/planning_config.pb.h"
@@ -116,14 +117,48 @@ Status LearningModelInferenceTask::Process(Frame* frame) {
       start_point_timestamp_sec, config.trajectory_delta_t(),
       &learning_data_frame);
 
-  if (!trajectory_imitation_inference_->LoadModel()) {
-    const std::string msg = absl::StrCat(
-        "TrajectoryImitationInference LoadModel() failed. frame_num[",
-        learning_data_frame.frame_num(), "]");
-    AERROR << msg;
-    return Status(ErrorCode::PLANNING_ERROR, msg);
+  // the model is loaded once, the first time the task runs
+  if (!is_model_loaded_) {
+    if (!trajectory_imitation_inference_->LoadModel()) {
+      const std::string msg = absl::StrCat(
+          "TrajectoryImitationInference LoadModel() failed. frame_num[",
+          learning_data_frame.frame_num(), "]");
+      AERROR << msg;
+      return Status(ErrorCode::PLANNING_ERROR, msg);
+    }
+    is_model_loaded_ = true;
+    if (FLAGS_enable_async_learning_model_inference) {
+      inference_pipeline_ =
+          std::make_unique<TrajectoryImitationInferencePipeline>(
+              trajectory_imitation_inference_.get());
+    }
   }
-  if (!trajectory_imitation_inference_->DoInference(&learning_data_frame)) {
+
+  if (inference_pipeline_ != nullptr) {
+    inference_pipeline_->Submit(learning_data_frame);
+    const auto result = inference_pipeline_->LatestResult();
+    double result_age = std::numeric_limits<double>::infinity();
+    if (result != nullptr) {
+      const int result_last = result->adc_trajectory_point_size() - 1;
+      result_age = start_point_timestamp_sec -
+                   result->adc_trajectory_point(result_last).timestamp_sec();
+    }
+    if (result_age > FLAGS_learning_model_inference_max_result_age) {
+      const std::string msg = absl::StrCat(
+          "no recent enough learning model output. frame_num[",
+          learning_data_frame.frame_num(), "]");
+      AERROR << msg;
+      if (config.allow_empty_output_trajectory()) {
+        return Status::OK();
+      }
+      return Status(ErrorCode::PLANNING_ERROR, msg);
+    }
+    ADEBUG << "use learning model output of frame_num[" << result->frame_num()
+           << "] in frame_num[" << learning_data_frame.frame_num() << "]";
+    // the output is relative to the frame the model ran on
+    learning_data_frame.CopyFrom(*result);
+  } else if (!trajectory_imitation_inference_->DoInference(
+                 &learning_data_frame)) {
     const std::string msg = absl::StrCat(
         "TrajectoryImitationLibtorchInference Inference failed. frame_num[",
         learning_data_frame.frame_num(), "]");
@@ -25,6 +25,7 @@
 #include <vector>
 
 #include "modules/planning/common/trajectory_evaluator.h"
+#include "modules/planning/learning_based/model_inference/trajectory_imitation_inference_pipeline.h"
 #include "modules/planning/learning_based/model_inference/trajectory_imitation_libtorch_inference.h"
 #include "modules/planning/tasks/task.h"
 
@@ -49,6 +50,10 @@ class LearningModelInferenceTask : public Task {
 
   std::unique_ptr<TrajectoryImitationLibtorchInference>
       trajectory_imitation_inference_;
+  bool is_model_loaded_ = false;
+  // runs the model off the planning thread if
+  // FLAGS_enable_async_learning_model_inference is set
+  std::unique_ptr<TrajectoryImitationInferencePipeline> inference_pipeline_;
 };
 
 }  // namespace planning
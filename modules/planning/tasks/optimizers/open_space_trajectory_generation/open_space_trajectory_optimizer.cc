@@ -22,6 +22,8 @@
 
 #include <utility>
 
+#include "modules/planning/common/planning_profiler.h"
+
 namespace apollo {
 namespace planning {
 
@@ -102,14 +104,18 @@ Status OpenSpaceTrajectoryOptimizer::Plan(
   // now)
   HybridAStartResult result;
 
-  if (warm_start_->Plan(init_x, init_y, init_phi, end_pose[0], end_pose[1],
-                        end_pose[2], XYbounds, obstacles_vertices_vec,
-                        &result)) {
-    ADEBUG << "State warm start problem solved successfully!";
-  } else {
-    ADEBUG << "State warm start problem failed to solve";
-    return Status(ErrorCode::PLANNING_ERROR,
-                  "State warm start problem failed to solve");
+  {
+    ScopedPlanningProfile warm_start_profile("hybrid_a_star",
+                                             PlanningProfileSpan::STEP);
+    if (warm_start_->Plan(init_x, init_y, init_phi, end_pose[0], end_pose[1],
+                          end_pose[2], XYbounds, obstacles_vertices_vec,
+                          &result)) {
+      ADEBUG << "State warm start problem solved successfully!";
+    } else {
+      ADEBUG << "State warm start problem failed to solve";
+      return Status(ErrorCode::PLANNING_ERROR,
+                    "State warm start problem failed to solve");
+    }
   }
 
   // Containers for distance approach trajectory smoothing problem
@@ -125,8 +131,13 @@ Status OpenSpaceTrajectoryOptimizer::Plan(
 
   if (FLAGS_enable_parallel_trajectory_smoothing) {
     std::vector<HybridAStartResult> partition_trajectories;
-    if (!warm_start_->TrajectoryPartition(result, &partition_trajectories)) {
-      return Status(ErrorCode::PLANNING_ERROR, "Hybrid Astar partition failed");
+    {
+      ScopedPlanningProfile partition_profile("trajectory_partition",
+                                              PlanningProfileSpan::STEP);
+      if (!warm_start_->TrajectoryPartition(result, &partition_trajectories)) {
+        return Status(ErrorCode::PLANNING_ERROR,
+                      "Hybrid Astar partition failed");
+      }
     }
     size_t size = partition_trajectories.size();
     std::vector<Eigen::MatrixXd> xWS_vec;
@@ -574,6 +585,8 @@ bool OpenSpaceTrajectoryOptimizer::GenerateDistanceApproachTraj(
 
   // Dual variable warm start for distance approach problem
   if (FLAGS_use_dual_variable_warm_start) {
+    ScopedPlanningProfile dual_variable_profile("dual_variable_warm_start",
+                                                PlanningProfileSpan::STEP);
     if (dual_variable_warm_start_->Solve(
             horizon, ts, ego, obstacles_num, obstacles_edges_num, obstacles_A,
             obstacles_b, xWS, l_warm_up, n_warm_up, &s_warm_up)) {
@@ -589,11 +602,17 @@ bool OpenSpaceTrajectoryOptimizer::GenerateDistanceApproachTraj(
   }
 
   // Distance approach trajectory smoothing
-  if (distance_approach_->Solve(
-          x0, xF, last_time_u, horizon, ts, ego, xWS, uWS, *l_warm_up,
-          *n_warm_up, s_warm_up, XYbounds, obstacles_num, obstacles_edges_num,
-          obstacles_A, obstacles_b, state_result_ds, control_result_ds,
-          time_result_ds, dual_l_result_ds, dual_n_result_ds)) {
+  bool is_distance_approach_solved = false;
+  {
+    ScopedPlanningProfile distance_approach_profile("distance_approach",
+                                                    PlanningProfileSpan::STEP);
+    is_distance_approach_solved = distance_approach_->Solve(
+        x0, xF, last_time_u, horizon, ts, ego, xWS, uWS, *l_warm_up,
+        *n_warm_up, s_warm_up, XYbounds, obstacles_num, obstacles_edges_num,
+        obstacles_A, obstacles_b, state_result_ds, control_result_ds,
+        time_result_ds, dual_l_result_ds, dual_n_result_ds);
+  }
+  if (is_distance_approach_solved) {
     ADEBUG << "Distance approach problem solved successfully!";
   } else {
     ADEBUG << "Distance approach problem failed to solve";
@@ -841,6 +860,8 @@ bool OpenSpaceTrajectoryOptimizer::GenerateDecoupledTraj(
     Eigen::MatrixXd* state_result_dc, Eigen::MatrixXd* control_result_dc,
     Eigen::MatrixXd* time_result_dc) {
   DiscretizedTrajectory smoothed_trajectory;
+  ScopedPlanningProfile smoother_profile("iterative_anchoring_smoother",
+                                         PlanningProfileSpan::STEP);
   if (!iterative_anchoring_smoother_->Smooth(
           xWS, init_a, init_v, obstacles_vertices_vec, &smoothed_trajectory)) {
     return false;
@@ -31,7 +31,15 @@ namespace apollo {
 namespace planning {
 namespace {
 constexpr double kInf = std::numeric_limits<double>::infinity();
+
+// common::math::CrossProd(STPoint(s, t), first, second) spelled out with t as
+// the x-axis and s as the y-axis, so that it can take the s of many points.
+inline double CrossProdAt(const double first_dt, const double second_dt,
+                          const double s, const STPoint& first,
+                          const STPoint& second) {
+  return first_dt * (second.s() - s) - (first.s() - s) * second_dt;
 }
+}  // namespace
 
 DpStCost::DpStCost(const DpStSpeedOptimizerConfig& config, const double total_t,
                    const double total_s,
@@ -191,6 +199,116 @@ double DpStCost::GetObstacleCost(const StGraphPoint& st_graph_point) {
   return cost * unit_t_;
 }
 
+void DpStCost::GetObstacleCostColumn(const uint32_t index_t, const double t,
+                                     const double* s, const size_t size,
+                                     double* costs) {
+  std::vector<uint8_t> blocked(size, 0);
+  std::fill(costs, costs + size, 0.0);
+
+  if (FLAGS_use_st_drivable_boundary) {
+    // TODO(Jiancheng): move to configs
+    static constexpr double boundary_resolution = 0.1;
+    int index = static_cast<int>(t / boundary_resolution);
+    const double lower_bound =
+        st_drivable_boundary_.st_boundary(index).s_lower();
+    const double upper_bound =
+        st_drivable_boundary_.st_boundary(index).s_upper();
+    for (size_t i = 0; i < size; ++i) {
+      blocked[i] |= (s[i] > upper_bound || s[i] < lower_bound);
+    }
+  }
+
+  const double weight =
+      config_.obstacle_weight() * config_.default_obstacle_cost();
+  const double follow_distance_s = config_.safe_distance();
+  const double overtake_distance_s =
+      StGapEstimator::EstimateSafeOvertakingGap();
+  for (const auto* obstacle : obstacles_) {
+    // same filters as GetObstacleCost(), they only depend on the column.
+    if (obstacle->IsVirtual()) {
+      continue;
+    }
+    if (obstacle->LongitudinalDecision().has_stop()) {
+      continue;
+    }
+    const auto& boundary = obstacle->path_st_boundary();
+    if (boundary.min_s() > FLAGS_speed_lon_decision_horizon) {
+      continue;
+    }
+    if (t < boundary.min_t() || t > boundary.max_t()) {
+      continue;
+    }
+
+    // STBoundary::IsPointInBoundary() with the segment lookup hoisted
+    if (t > boundary.min_t() && t < boundary.max_t()) {
+      const std::vector<STPoint> lower_points = boundary.lower_points();
+      const std::vector<STPoint> upper_points = boundary.upper_points();
+      if (!lower_points.empty() && t >= lower_points.front().t() &&
+          t <= lower_points.back().t()) {
+        auto comp = [](const STPoint& p, const double t) { return p.t() < t; };
+        auto first_ge = std::lower_bound(lower_points.begin(),
+                                         lower_points.end(), t, comp);
+        size_t left = std::distance(lower_points.begin(), first_ge);
+        size_t right = left;
+        if (left == 0) {
+          right = 0;
+        } else if (first_ge == lower_points.end()) {
+          left = right = lower_points.size() - 1;
+        } else {
+          left = left - 1;
+        }
+        const STPoint& upper_left = upper_points[left];
+        const STPoint& upper_right = upper_points[right];
+        const STPoint& lower_left = lower_points[left];
+        const STPoint& lower_right = lower_points[right];
+        const double upper_left_dt = upper_left.t() - t;
+        const double upper_right_dt = upper_right.t() - t;
+        const double lower_left_dt = lower_left.t() - t;
+        const double lower_right_dt = lower_right.t() - t;
+        for (size_t i = 0; i < size; ++i) {
+          const double check_upper = CrossProdAt(
+              upper_left_dt, upper_right_dt, s[i], upper_left, upper_right);
+          const double check_lower = CrossProdAt(
+              lower_left_dt, lower_right_dt, s[i], lower_left, lower_right);
+          blocked[i] |= (check_upper * check_lower < 0);
+        }
+      }
+    }
+
+    double s_upper = 0.0;
+    double s_lower = 0.0;
+    int boundary_index = boundary_map_[boundary.id()];
+    if (boundary_cost_[boundary_index][index_t].first < 0.0) {
+      boundary.GetBoundarySRange(t, &s_upper, &s_lower);
+      boundary_cost_[boundary_index][index_t] =
+          std::make_pair(s_upper, s_lower);
+    } else {
+      s_upper = boundary_cost_[boundary_index][index_t].first;
+      s_lower = boundary_cost_[boundary_index][index_t].second;
+    }
+    const double s_upper_overtake = s_upper + overtake_distance_s;
+    for (size_t i = 0; i < size; ++i) {
+      const double follow_diff = follow_distance_s - s_lower + s[i];
+      const double overtake_diff = overtake_distance_s + s_upper - s[i];
+      double cost = 0.0;
+      if (s[i] < s_lower) {
+        cost = s[i] + follow_distance_s < s_lower
+                   ? 0.0
+                   : weight * follow_diff * follow_diff;
+      } else if (s[i] > s_upper) {
+        cost = s[i] > s_upper_overtake
+                   ? 0.0
+                   : weight * overtake_diff * overtake_diff;
+      }
+      costs[i] += cost;
+    }
+  }
+
+  for (size_t i = 0; i < size; ++i) {
+    costs[i] = blocked[i] ? kInf : costs[i] * unit_t_;
+  }
+}
+
 double DpStCost::GetSpatialPotentialCost(const StGraphPoint& point) {
   return (total_s_ - point.point().s()) * config_.spatial_potential_penalty();
 }
@@ -238,6 +356,49 @@ double DpStCost::GetSpeedCost(const STPoint& first, const STPoint& second,
   return cost;
 }
 
+void DpStCost::GetSpeedCostColumn(const double curr_s, const double* pre_s,
+                                  const double* speed_limits,
+                                  const size_t size, const double cruise_speed,
+                                  double* costs) const {
+  const double max_adc_stop_speed = common::VehicleConfigHelper::Instance()
+                                        ->GetConfig()
+                                        .vehicle_param()
+                                        .max_abs_speed_when_stopped();
+  // all edges end at curr_s
+  const bool in_keep_clear_range = InKeepClearRange(curr_s);
+  const double keep_clear_cost = config_.keep_clear_low_speed_penalty() *
+                                 unit_t_ * config_.default_speed_cost();
+  const double exceed_speed_weight =
+      config_.exceed_speed_penalty() * config_.default_speed_cost();
+  const double low_speed_weight =
+      config_.low_speed_penalty() * config_.default_speed_cost();
+  const double reference_speed_weight =
+      config_.reference_speed_penalty() * config_.default_speed_cost();
+  const bool use_reference_speed = FLAGS_enable_dp_reference_speed;
+
+  for (size_t i = 0; i < size; ++i) {
+    const double speed = (curr_s - pre_s[i]) / unit_t_;
+    const double speed_limit = speed_limits[i];
+    double cost = 0.0;
+    if (speed < max_adc_stop_speed && in_keep_clear_range) {
+      cost += keep_clear_cost;
+    }
+    const double det_speed = (speed - speed_limit) / speed_limit;
+    const double exceed_speed_cost =
+        exceed_speed_weight * (det_speed * det_speed) * unit_t_;
+    const double low_speed_cost = low_speed_weight * -det_speed * unit_t_;
+    if (det_speed > 0) {
+      cost += exceed_speed_cost;
+    } else if (det_speed < 0) {
+      cost += low_speed_cost;
+    }
+    if (use_reference_speed) {
+      cost += reference_speed_weight * fabs(speed - cruise_speed) * unit_t_;
+    }
+    costs[i] = speed < 0 ? kInf : cost;
+  }
+}
+
 double DpStCost::GetAccelCost(const double accel) {
   double cost = 0.0;
   static constexpr double kEpsilon = 0.1;
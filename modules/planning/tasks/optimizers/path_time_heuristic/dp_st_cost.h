@@ -70,6 +70,21 @@ class DpStCost {
   double GetJerkCostByFourPoints(const STPoint& first, const STPoint& second,
                                  const STPoint& third, const STPoint& fourth);
 
+  // Column kernels. They evaluate the same costs as GetObstacleCost() and
+  // GetSpeedCost() for a run of points at once over plain arrays, with the
+  // same operations in the same order, so the results are bit-identical.
+  // The loops are branch-free per lane so that they vectorize.
+
+  // obstacle costs of the points (s[i], t), i < size, of column index_t.
+  void GetObstacleCostColumn(const uint32_t index_t, const double t,
+                             const double* s, const size_t size,
+                             double* costs);
+
+  // speed costs of the edges from (pre_s[i], t - unit_t) to (curr_s, t).
+  void GetSpeedCostColumn(const double curr_s, const double* pre_s,
+                          const double* speed_limits, const size_t size,
+                          const double cruise_speed, double* costs) const;
+
  private:
   double GetAccelCost(const double accel);
   double JerkCost(const double jerk);
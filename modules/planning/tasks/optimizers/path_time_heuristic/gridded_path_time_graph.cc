@@ -229,13 +229,28 @@ Status GriddedPathTimeGraph::CalculateTotalCost() {
   size_t next_highest_row = 0;
   size_t next_lowest_row = 0;
 
+  if (FLAGS_enable_dp_st_graph_column_kernel) {
+    total_cost_table_.assign(
+        dimension_t_,
+        std::vector<double>(dimension_s_,
+                            std::numeric_limits<double>::infinity()));
+    optimal_speed_table_.assign(dimension_t_,
+                                std::vector<double>(dimension_s_, 0.0));
+    pre_index_table_.assign(dimension_t_,
+                            std::vector<int32_t>(dimension_s_, -1));
+  }
+
   for (size_t c = 0; c < cost_table_.size(); ++c) {
     size_t highest_row = 0;
     size_t lowest_row = cost_table_.back().size() - 1;
 
     int count = static_cast<int>(next_highest_row) -
                 static_cast<int>(next_lowest_row) + 1;
-    if (count > 0) {
+    if (count > 0 && FLAGS_enable_dp_st_graph_column_kernel) {
+      CalculateCostColumn(static_cast<uint32_t>(c),
+                          static_cast<uint32_t>(next_lowest_row),
+                          static_cast<uint32_t>(next_highest_row));
+    } else if (count > 0) {
       std::vector<std::future<void>> results;
       for (size_t r = next_lowest_row; r <= next_highest_row; ++r) {
         auto msg = std::make_shared<StGraphMessage>(c, r);
@@ -321,6 +336,43 @@ void GriddedPathTimeGraph::CalculateCostAt(
   auto& cost_cr = cost_table_[c][r];
 
   cost_cr.SetObstacleCost(dp_st_cost_.GetObstacleCost(cost_cr));
+  CalculateCostWithObstacleCostAt(c, r);
+}
+
+void GriddedPathTimeGraph::CalculateCostColumn(const uint32_t c,
+                                               const uint32_t lowest_row,
+                                               const uint32_t highest_row) {
+  auto& cost_col = cost_table_[c];
+  const uint32_t size = highest_row - lowest_row + 1;
+  column_obstacle_cost_.resize(size);
+  dp_st_cost_.GetObstacleCostColumn(
+      c, cost_col[lowest_row].point().t(),
+      spatial_distance_by_index_.data() + lowest_row, size,
+      column_obstacle_cost_.data());
+  for (uint32_t r = lowest_row; r <= highest_row; ++r) {
+    cost_col[r].SetObstacleCost(column_obstacle_cost_[r - lowest_row]);
+    CalculateCostWithObstacleCostAt(c, r);
+  }
+  UpdateColumnTables(c, lowest_row, highest_row);
+}
+
+void GriddedPathTimeGraph::UpdateColumnTables(const uint32_t c,
+                                              const uint32_t lowest_row,
+                                              const uint32_t highest_row) {
+  const auto& cost_col = cost_table_[c];
+  for (uint32_t r = lowest_row; r <= highest_row; ++r) {
+    total_cost_table_[c][r] = cost_col[r].total_cost();
+    optimal_speed_table_[c][r] = cost_col[r].GetOptimalSpeed();
+    pre_index_table_[c][r] =
+        cost_col[r].pre_point() == nullptr
+            ? -1
+            : static_cast<int32_t>(cost_col[r].pre_point()->index_s());
+  }
+}
+
+void GriddedPathTimeGraph::CalculateCostWithObstacleCostAt(const uint32_t c,
+                                                           const uint32_t r) {
+  auto& cost_cr = cost_table_[c][r];
   if (cost_cr.obstacle_cost() > std::numeric_limits<double>::max()) {
     return;
   }
@@ -436,6 +488,12 @@ void GriddedPathTimeGraph::CalculateCostAt(
     return;
   }
 
+  if (FLAGS_enable_dp_st_graph_column_kernel) {
+    CalculateEdgeCostByKernelAt(c, r, r_low, speed_limit, cruise_speed,
+                                min_s_consider_speed);
+    return;
+  }
+
   for (uint32_t i = 0; i < r_pre_size; ++i) {
     uint32_t r_pre = r - i;
     if (std::isinf(pre_col[r_pre].total_cost()) ||
@@ -494,6 +552,109 @@ void GriddedPathTimeGraph::CalculateCostAt(
   }
 }
 
+void GriddedPathTimeGraph::CalculateEdgeCostByKernelAt(
+    const uint32_t c, const uint32_t r, const uint32_t r_low,
+    const double speed_limit, const double cruise_speed,
+    const double min_s_consider_speed) {
+  auto& cost_cr = cost_table_[c][r];
+  const auto& pre_col = cost_table_[c - 1];
+  const auto& prepre_col = cost_table_[c - 2];
+  const double* s = spatial_distance_by_index_.data();
+  const double* pre_total_cost = total_cost_table_[c - 1].data();
+  const double* pre_speed = optimal_speed_table_[c - 1].data();
+  const int32_t* pre_index = pre_index_table_[c - 1].data();
+  const double* prepre_total_cost = total_cost_table_[c - 2].data();
+  const int32_t* prepre_index = pre_index_table_[c - 2].data();
+  const double curr_s = s[r];
+  const uint32_t size = r - r_low + 1;
+
+  lane_pre_s_.resize(size);
+  lane_curr_a_.resize(size);
+  lane_speed_limit_.assign(size, speed_limit);
+  lane_speed_cost_.resize(size);
+  lane_accel_cost_.assign(size, 0.0);
+  lane_jerk_cost_.assign(size, 0.0);
+  lane_cost_.resize(size);
+  lane_valid_.resize(size);
+
+  // the checks of the per-point loop that only need the previous column
+  for (uint32_t i = 0; i < size; ++i) {
+    const uint32_t r_pre = r - i;
+    const double curr_a =
+        2 * ((curr_s - s[r_pre]) / unit_t_ - pre_speed[r_pre]) / unit_t_;
+    lane_pre_s_[i] = s[r_pre];
+    lane_curr_a_[i] = curr_a;
+    lane_valid_[i] =
+        !std::isinf(pre_total_cost[r_pre]) && pre_index[r_pre] >= 0 &&
+        !(curr_a > max_acceleration_ || curr_a < max_deceleration_) &&
+        !(pre_speed[r_pre] + curr_a * unit_t_ < -kDoubleEpsilon &&
+          curr_s > min_s_consider_speed);
+  }
+
+  // Overlap checks, the running speed limit and the lazily filled accel and
+  // jerk cost tables depend on the visiting order, so they stay sequential.
+  double curr_speed_limit = speed_limit;
+  for (uint32_t i = 0; i < size; ++i) {
+    if (!lane_valid_[i]) {
+      continue;
+    }
+    const uint32_t r_pre = r - i;
+    if (CheckOverlapOnDpStGraph(st_graph_data_.st_boundaries(), cost_cr,
+                                pre_col[r_pre])) {
+      lane_valid_[i] = 0;
+      continue;
+    }
+    const int32_t r_prepre = pre_index[r_pre];
+    if (std::isinf(prepre_total_cost[r_prepre]) ||
+        prepre_index[r_prepre] < 0) {
+      lane_valid_[i] = 0;
+      continue;
+    }
+    const StGraphPoint& prepre_graph_point = prepre_col[r_prepre];
+    const STPoint& triple_pre_point = prepre_graph_point.pre_point()->point();
+    const STPoint& prepre_point = prepre_graph_point.point();
+    const STPoint& pre_point = pre_col[r_pre].point();
+    const STPoint& curr_point = cost_cr.point();
+    curr_speed_limit =
+        std::fmin(curr_speed_limit, speed_limit_by_index_[r_pre]);
+    lane_speed_limit_[i] = curr_speed_limit;
+    lane_accel_cost_[i] = dp_st_cost_.GetAccelCostByThreePoints(
+        prepre_point, pre_point, curr_point);
+    lane_jerk_cost_[i] = dp_st_cost_.GetJerkCostByFourPoints(
+        triple_pre_point, prepre_point, pre_point, curr_point);
+  }
+
+  dp_st_cost_.GetSpeedCostColumn(curr_s, lane_pre_s_.data(),
+                                 lane_speed_limit_.data(), size, cruise_speed,
+                                 lane_speed_cost_.data());
+
+  const double point_cost =
+      cost_cr.obstacle_cost() + cost_cr.spatial_potential_cost();
+  for (uint32_t i = 0; i < size; ++i) {
+    const double edge_cost =
+        lane_speed_cost_[i] + lane_accel_cost_[i] + lane_jerk_cost_[i];
+    const double cost = point_cost + pre_total_cost[r - i] + edge_cost;
+    lane_cost_[i] =
+        lane_valid_[i] ? cost : std::numeric_limits<double>::infinity();
+  }
+
+  // first lane with the minimal cost, as the strict < of the per-point loop
+  uint32_t best = size;
+  double best_cost = cost_cr.total_cost();
+  for (uint32_t i = 0; i < size; ++i) {
+    if (lane_cost_[i] < best_cost) {
+      best_cost = lane_cost_[i];
+      best = i;
+    }
+  }
+  if (best < size) {
+    const uint32_t r_pre = r - best;
+    cost_cr.SetTotalCost(best_cost);
+    cost_cr.SetPrePoint(pre_col[r_pre]);
+    cost_cr.SetOptimalSpeed(pre_speed[r_pre] + lane_curr_a_[best] * unit_t_);
+  }
+}
+
 Status GriddedPathTimeGraph::RetrieveSpeedProfile(SpeedData* const speed_data) {
   double min_cost = std::numeric_limits<double>::infinity();
   const StGraphPoint* best_end_point = nullptr;
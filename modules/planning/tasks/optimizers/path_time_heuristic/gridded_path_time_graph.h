@@ -20,6 +20,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <vector>
 
@@ -66,6 +67,23 @@ class GriddedPathTimeGraph {
   };
   void CalculateCostAt(const std::shared_ptr<StGraphMessage>& msg);
 
+  // cost of point (c, r) once its obstacle cost is set
+  void CalculateCostWithObstacleCostAt(const uint32_t c, const uint32_t r);
+
+  // Column kernel mode: obstacle costs of a whole column are computed at once
+  // and edges into a point are evaluated lane by lane over the
+  // structure-of-arrays tables below. Results match the per-point path
+  // bit-for-bit.
+  void CalculateCostColumn(const uint32_t c, const uint32_t lowest_row,
+                           const uint32_t highest_row);
+  void CalculateEdgeCostByKernelAt(const uint32_t c, const uint32_t r,
+                                   const uint32_t r_low,
+                                   const double speed_limit,
+                                   const double cruise_speed,
+                                   const double min_s_consider_speed);
+  void UpdateColumnTables(const uint32_t c, const uint32_t lowest_row,
+                          const uint32_t highest_row);
+
   double CalculateEdgeCost(const STPoint& first, const STPoint& second,
                            const STPoint& third, const STPoint& forth,
                            const double speed_limit, const double cruise_speed);
@@ -121,6 +139,24 @@ class GriddedPathTimeGraph {
   // cost_table_[t][s]
   // row: s, col: t --- NOTICE: Please do NOT change.
   std::vector<std::vector<StGraphPoint>> cost_table_;
+
+  // structure-of-arrays copies of the total cost, optimal speed and
+  // pre point row of cost_table_, indexed the same way; -1 means no pre point.
+  std::vector<std::vector<double>> total_cost_table_;
+  std::vector<std::vector<double>> optimal_speed_table_;
+  std::vector<std::vector<int32_t>> pre_index_table_;
+
+  // per lane scratch of the column kernel, lane i is row r - i of the
+  // previous column
+  std::vector<double> column_obstacle_cost_;
+  std::vector<double> lane_pre_s_;
+  std::vector<double> lane_curr_a_;
+  std::vector<double> lane_speed_limit_;
+  std::vector<double> lane_speed_cost_;
+  std::vector<double> lane_accel_cost_;
+  std::vector<double> lane_jerk_cost_;
+  std::vector<double> lane_cost_;
+  std::vector<uint8_t> lane_valid_;
 };
 
 }  // namespace planning
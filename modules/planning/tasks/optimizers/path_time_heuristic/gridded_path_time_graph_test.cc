@@ -134,5 +134,57 @@ TEST_F(DpStGraphTest, simple) {
   EXPECT_TRUE(ret.ok());
 }
 
+TEST_F(DpStGraphTest, column_kernel) {
+  // one obstacle to follow and one close enough to be overtaken
+  std::vector<std::vector<std::pair<STPoint, STPoint>>> boundary_points = {
+      {{STPoint(30.0, 1.0), STPoint(40.0, 1.0)},
+       {STPoint(36.0, 7.0), STPoint(46.0, 7.0)}},
+      {{STPoint(2.0, 0.5), STPoint(6.0, 0.5)},
+       {STPoint(8.0, 2.5), STPoint(12.0, 2.5)}}};
+  for (size_t i = 0; i < boundary_points.size(); ++i) {
+    Obstacle obstacle;
+    obstacle.SetId("o" + std::to_string(i));
+    obstacle_list_.push_back(obstacle);
+    obstacle_list_.back().set_path_st_boundary(
+        STBoundary(boundary_points[i]));
+  }
+
+  std::vector<const Obstacle*> obstacles;
+  std::vector<const STBoundary*> boundaries;
+  for (const auto& obstacle : obstacle_list_) {
+    obstacles.push_back(&obstacle);
+    boundaries.push_back(&obstacle.path_st_boundary());
+  }
+
+  init_point_.mutable_path_point()->set_x(0.0);
+  init_point_.mutable_path_point()->set_y(0.0);
+  init_point_.mutable_path_point()->set_z(0.0);
+  init_point_.mutable_path_point()->set_kappa(0.0);
+  init_point_.set_v(10.0);
+  init_point_.set_a(0.0);
+
+  planning_internal::STGraphDebug st_graph_debug;
+  st_graph_data_ = StGraphData();
+  st_graph_data_.LoadData(boundaries, 30.0, init_point_, speed_limit_, 5.0,
+                          120.0, 7.0, &st_graph_debug);
+
+  // the kernel must reproduce the per-point search bit-for-bit
+  std::vector<SpeedData> speed_data(2);
+  for (size_t i = 0; i < speed_data.size(); ++i) {
+    FLAGS_enable_dp_st_graph_column_kernel = (i == 1);
+    GriddedPathTimeGraph dp_st_graph(st_graph_data_, dp_config_, obstacles,
+                                     init_point_);
+    EXPECT_TRUE(dp_st_graph.Search(&speed_data[i]).ok());
+  }
+  FLAGS_enable_dp_st_graph_column_kernel = false;
+
+  ASSERT_EQ(speed_data[0].size(), speed_data[1].size());
+  for (size_t i = 0; i < speed_data[0].size(); ++i) {
+    EXPECT_EQ(speed_data[0][i].s(), speed_data[1][i].s());
+    EXPECT_EQ(speed_data[0][i].t(), speed_data[1][i].t());
+    EXPECT_EQ(speed_data[0][i].v(), speed_data[1][i].v());
+  }
+}
+
 }  // namespace planning
 }  // namespace apollo
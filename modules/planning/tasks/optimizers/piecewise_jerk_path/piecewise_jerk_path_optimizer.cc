@@ -20,9 +20,12 @@
 
 #include "modules/planning/tasks/optimizers/piecewise_jerk_path/piecewise_jerk_path_optimizer.h"
 
+#include <future>
 #include <memory>
 #include <string>
+#include <unordered_set>
 
+#include "cyber/task/task.h"
 #include "modules/common/math/math_utils.h"
 #include "modules/common/util/point_factory.h"
 #include "modules/planning/common/planning_context.h"
@@ -83,115 +86,84 @@ common::Status PiecewiseJerkPathOptimizer::Process(
   const auto& path_boundaries =
       reference_line_info_->GetCandidatePathBoundaries();
   ADEBUG << "There are " << path_boundaries.size() << " path boundaries.";
-  const auto& reference_path_data = reference_line_info_->path_data();
 
-  std::vector<PathData> candidate_path_data;
+  // skip the regular path boundaries with less than 2 points, and take the
+  // solver workspaces of the others before any of them is optimized
+  std::vector<const PathBoundary*> valid_path_boundaries;
+  std::vector<PiecewiseJerkWorkspace*> workspaces;
+  std::vector<double> warm_start_shifts;
+  std::unordered_set<std::string> path_boundary_labels;
   for (const auto& path_boundary : path_boundaries) {
-    size_t path_boundary_size = path_boundary.boundary().size();
-
     // if the path_boundary is normal, it is possible to have less than 2 points
     // skip path boundary of this kind
     if (path_boundary.label().find("regular") != std::string::npos &&
-        path_boundary_size < 2) {
+        path_boundary.boundary().size() < 2) {
       continue;
     }
-
-    int max_iter = 4000;
-    // lower max_iter for regular/self/
-    if (path_boundary.label().find("self") != std::string::npos) {
-      max_iter = 4000;
+    CHECK_GT(path_boundary.boundary().size(), 1U);
+
+    PiecewiseJerkWorkspace* workspace = nullptr;
+    double warm_start_shift = 0.0;
+    // a label seen twice does not share its workspace, so that no two
+    // boundaries solve in the same one
+    if (FLAGS_enable_persistent_osqp_workspace &&
+        path_boundary_labels.insert(path_boundary.label()).second) {
+      auto& boundary_workspace = workspaces_[path_boundary.label()];
+      workspace = &boundary_workspace.workspace;
+      warm_start_shift = path_boundary.start_s() - boundary_workspace.start_s;
+      boundary_workspace.start_s = path_boundary.start_s();
     }
+    valid_path_boundaries.push_back(&path_boundary);
+    workspaces.push_back(workspace);
+    warm_start_shifts.push_back(warm_start_shift);
+  }
 
-    CHECK_GT(path_boundary_size, 1);
-
-    std::vector<double> opt_l;
-    std::vector<double> opt_dl;
-    std::vector<double> opt_ddl;
-
-    std::array<double, 3> end_state = {0.0, 0.0, 0.0};
-
-    if (!FLAGS_enable_force_pull_over_open_space_parking_test) {
-      // pull over scenario
-      // set end lateral to be at the desired pull over destination
-      const auto& pull_over_status =
-          injector_->planning_context()->planning_status().pull_over();
-      if (pull_over_status.has_position() &&
-          pull_over_status.position().has_x() &&
-          pull_over_status.position().has_y() &&
-          path_boundary.label().find("pullover") != std::string::npos) {
-        common::SLPoint pull_over_sl;
-        reference_line.XYToSL(pull_over_status.position(), &pull_over_sl);
-        end_state[0] = pull_over_sl.l();
-      }
+  // TODO(all): double-check this;
+  // final_path_data might carry info from upper stream
+  std::vector<PathData> path_data_list(valid_path_boundaries.size(),
+                                       *final_path_data);
+  std::vector<bool> res_opts(valid_path_boundaries.size(), false);
+  if (FLAGS_enable_multi_thread_in_path_candidates &&
+      valid_path_boundaries.size() > 1) {
+    // every boundary has its own problem and workspace, the calling thread
+    // takes the first one
+    std::vector<std::future<bool>> results;
+    for (size_t i = 1; i < valid_path_boundaries.size(); ++i) {
+      results.push_back(cyber::Async(
+          &PiecewiseJerkPathOptimizer::OptimizePathBoundary, this,
+          std::cref(*valid_path_boundaries[i]), std::cref(reference_line),
+          std::cref(init_frenet_state.second), std::cref(w), workspaces[i],
+          warm_start_shifts[i], &path_data_list[i]));
     }
-
-    // TODO(all): double-check this;
-    // final_path_data might carry info from upper stream
-    PathData path_data = *final_path_data;
-
-    // updated cost function for path reference
-    std::vector<double> path_reference_l(path_boundary_size, 0.0);
-    bool is_valid_path_reference = false;
-    size_t path_reference_size = reference_path_data.path_reference().size();
-
-    if (path_boundary.label().find("regular") != std::string::npos &&
-        reference_path_data.is_valid_path_reference()) {
-      ADEBUG << "path label is: " << path_boundary.label();
-      // when path reference is ready
-      for (size_t i = 0; i < path_reference_size; ++i) {
-        common::SLPoint path_reference_sl;
-        reference_line.XYToSL(
-            common::util::PointFactory::ToPointENU(
-                reference_path_data.path_reference().at(i).x(),
-                reference_path_data.path_reference().at(i).y()),
-            &path_reference_sl);
-        path_reference_l[i] = path_reference_sl.l();
-      }
-      end_state[0] = path_reference_l.back();
-      path_data.set_is_optimized_towards_trajectory_reference(true);
-      is_valid_path_reference = true;
+    res_opts[0] = OptimizePathBoundary(
+        *valid_path_boundaries[0], reference_line, init_frenet_state.second, w,
+        workspaces[0], warm_start_shifts[0], &path_data_list[0]);
+    for (size_t i = 1; i < valid_path_boundaries.size(); ++i) {
+      res_opts[i] = results[i - 1].get();
     }
-
-    const auto& veh_param =
-        common::VehicleConfigHelper::GetConfig().vehicle_param();
-    const double lat_acc_bound =
-        std::tan(veh_param.max_steer_angle() / veh_param.steer_ratio()) /
-        veh_param.wheel_base();
-    std::vector<std::pair<double, double>> ddl_bounds;
-    for (size_t i = 0; i < path_boundary_size; ++i) {
-      double s = static_cast<double>(i) * path_boundary.delta_s() +
-                 path_boundary.start_s();
-      double kappa = reference_line.GetNearestReferencePoint(s).kappa();
-      ddl_bounds.emplace_back(-lat_acc_bound - kappa, lat_acc_bound - kappa);
+  } else {
+    for (size_t i = 0; i < valid_path_boundaries.size(); ++i) {
+      res_opts[i] = OptimizePathBoundary(
+          *valid_path_boundaries[i], reference_line, init_frenet_state.second,
+          w, workspaces[i], warm_start_shifts[i], &path_data_list[i]);
     }
+  }
 
-    bool res_opt = OptimizePath(
-        init_frenet_state.second, end_state, std::move(path_reference_l),
-        path_reference_size, path_boundary.delta_s(), is_valid_path_reference,
-        path_boundary.boundary(), ddl_bounds, w, max_iter, &opt_l, &opt_dl,
-        &opt_ddl);
-
-    if (res_opt) {
-      for (size_t i = 0; i < path_boundary_size; i += 4) {
-        ADEBUG << "for s[" << static_cast<double>(i) * path_boundary.delta_s()
-               << "], l = " << opt_l[i] << ", dl = " << opt_dl[i];
-      }
-      auto frenet_frame_path =
-          ToPiecewiseJerkPath(opt_l, opt_dl, opt_ddl, path_boundary.delta_s(),
-                              path_boundary.start_s());
-
-      path_data.SetReferenceLine(&reference_line);
-      path_data.SetFrenetPath(std::move(frenet_frame_path));
-      if (FLAGS_use_front_axe_center_in_path_planning) {
-        auto discretized_path = DiscretizedPath(
-            ConvertPathPointRefFromFrontAxeToRearAxe(path_data));
-        path_data.SetDiscretizedPath(discretized_path);
-      }
-      path_data.set_path_label(path_boundary.label());
-      path_data.set_blocking_obstacle_id(path_boundary.blocking_obstacle_id());
-      candidate_path_data.push_back(std::move(path_data));
+  std::vector<PathData> candidate_path_data;
+  for (size_t i = 0; i < valid_path_boundaries.size(); ++i) {
+    if (res_opts[i]) {
+      candidate_path_data.push_back(std::move(path_data_list[i]));
     }
   }
+  // drop the workspaces of path boundaries that went away
+  for (auto it = workspaces_.begin(); it != workspaces_.end();) {
+    if (path_boundary_labels.count(it->first) == 0) {
+      it = workspaces_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
   if (candidate_path_data.empty()) {
     return Status(ErrorCode::PLANNING_ERROR,
                   "Path Optimizer failed to generate path");
@@ -200,6 +172,105 @@ common::Status PiecewiseJerkPathOptimizer::Process(
   return Status::OK();
 }
 
+bool PiecewiseJerkPathOptimizer::OptimizePathBoundary(
+    const PathBoundary& path_boundary, const ReferenceLine& reference_line,
+    const std::array<double, 3>& init_state, const std::array<double, 5>& w,
+    PiecewiseJerkWorkspace* workspace, const double warm_start_shift,
+    PathData* const path_data) {
+  const size_t path_boundary_size = path_boundary.boundary().size();
+  const auto& reference_path_data = reference_line_info_->path_data();
+
+  int max_iter = 4000;
+  // lower max_iter for regular/self/
+  if (path_boundary.label().find("self") != std::string::npos) {
+    max_iter = 4000;
+  }
+
+  std::vector<double> opt_l;
+  std::vector<double> opt_dl;
+  std::vector<double> opt_ddl;
+
+  std::array<double, 3> end_state = {0.0, 0.0, 0.0};
+
+  if (!FLAGS_enable_force_pull_over_open_space_parking_test) {
+    // pull over scenario
+    // set end lateral to be at the desired pull over destination
+    const auto& pull_over_status =
+        injector_->planning_context()->planning_status().pull_over();
+    if (pull_over_status.has_position() &&
+        pull_over_status.position().has_x() &&
+        pull_over_status.position().has_y() &&
+        path_boundary.label().find("pullover") != std::string::npos) {
+      common::SLPoint pull_over_sl;
+      reference_line.XYToSL(pull_over_status.position(), &pull_over_sl);
+      end_state[0] = pull_over_sl.l();
+    }
+  }
+
+  // updated cost function for path reference
+  std::vector<double> path_reference_l(path_boundary_size, 0.0);
+  bool is_valid_path_reference = false;
+  size_t path_reference_size = reference_path_data.path_reference().size();
+
+  if (path_boundary.label().find("regular") != std::string::npos &&
+      reference_path_data.is_valid_path_reference()) {
+    ADEBUG << "path label is: " << path_boundary.label();
+    // when path reference is ready
+    for (size_t i = 0; i < path_reference_size; ++i) {
+      common::SLPoint path_reference_sl;
+      reference_line.XYToSL(
+          common::util::PointFactory::ToPointENU(
+              reference_path_data.path_reference().at(i).x(),
+              reference_path_data.path_reference().at(i).y()),
+          &path_reference_sl);
+      path_reference_l[i] = path_reference_sl.l();
+    }
+    end_state[0] = path_reference_l.back();
+    path_data->set_is_optimized_towards_trajectory_reference(true);
+    is_valid_path_reference = true;
+  }
+
+  const auto& veh_param =
+      common::VehicleConfigHelper::GetConfig().vehicle_param();
+  const double lat_acc_bound =
+      std::tan(veh_param.max_steer_angle() / veh_param.steer_ratio()) /
+      veh_param.wheel_base();
+  std::vector<std::pair<double, double>> ddl_bounds;
+  for (size_t i = 0; i < path_boundary_size; ++i) {
+    double s = static_cast<double>(i) * path_boundary.delta_s() +
+               path_boundary.start_s();
+    double kappa = reference_line.GetNearestReferencePoint(s).kappa();
+    ddl_bounds.emplace_back(-lat_acc_bound - kappa, lat_acc_bound - kappa);
+  }
+
+  bool res_opt = OptimizePath(
+      init_state, end_state, std::move(path_reference_l),
+      path_reference_size, path_boundary.delta_s(), is_valid_path_reference,
+      path_boundary.boundary(), ddl_bounds, w, max_iter, workspace,
+      warm_start_shift, &opt_l, &opt_dl, &opt_ddl);
+
+  if (res_opt) {
+    for (size_t i = 0; i < path_boundary_size; i += 4) {
+      ADEBUG << "for s[" << static_cast<double>(i) * path_boundary.delta_s()
+             << "], l = " << opt_l[i] << ", dl = " << opt_dl[i];
+    }
+    auto frenet_frame_path =
+        ToPiecewiseJerkPath(opt_l, opt_dl, opt_ddl, path_boundary.delta_s(),
+                            path_boundary.start_s());
+
+    path_data->SetReferenceLine(&reference_line);
+    path_data->SetFrenetPath(std::move(frenet_frame_path));
+    if (FLAGS_use_front_axe_center_in_path_planning) {
+      auto discretized_path = DiscretizedPath(
+          ConvertPathPointRefFromFrontAxeToRearAxe(*path_data));
+      path_data->SetDiscretizedPath(discretized_path);
+    }
+    path_data->set_path_label(path_boundary.label());
+    path_data->set_blocking_obstacle_id(path_boundary.blocking_obstacle_id());
+  }
+  return res_opt;
+}
+
 common::TrajectoryPoint
 PiecewiseJerkPathOptimizer::InferFrontAxeCenterFromRearAxeCenter(
     const common::TrajectoryPoint& traj_point) {
@@ -239,8 +310,10 @@ bool PiecewiseJerkPathOptimizer::OptimizePath(
     const double delta_s, const bool is_valid_path_reference,
     const std::vector<std::pair<double, double>>& lat_boundaries,
     const std::vector<std::pair<double, double>>& ddl_bounds,
-    const std::array<double, 5>& w, const int max_iter, std::vector<double>* x,
-    std::vector<double>* dx, std::vector<double>* ddx) {
+    const std::array<double, 5>& w, const int max_iter,
+    PiecewiseJerkWorkspace* workspace, const double warm_start_shift,
+    std::vector<double>* x, std::vector<double>* dx,
+    std::vector<double>* ddx) {
   // num of knots
   const size_t kNumKnots = lat_boundaries.size();
   PiecewiseJerkPathProblem piecewise_jerk_problem(kNumKnots, delta_s,
@@ -307,6 +380,9 @@ bool PiecewiseJerkPathOptimizer::OptimizePath(
                                                  axis_distance, max_yaw_rate);
   piecewise_jerk_problem.set_dddx_bound(jerk_bound);
 
+  piecewise_jerk_problem.set_workspace(workspace);
+  piecewise_jerk_problem.set_warm_start_shift(warm_start_shift);
+
   bool success = piecewise_jerk_problem.Optimize(max_iter);
 
   auto end_time = std::chrono::system_clock::now();
@@ -21,9 +21,13 @@
 #pragma once
 
 #include <memory>
+#include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include "modules/planning/common/path_boundary.h"
+#include "modules/planning/math/piecewise_jerk/piecewise_jerk_problem.h"
 #include "modules/planning/tasks/optimizers/path_optimizer.h"
 
 namespace apollo {
@@ -50,6 +54,20 @@ class PiecewiseJerkPathOptimizer : public PathOptimizer {
   std::vector<common::PathPoint> ConvertPathPointRefFromFrontAxeToRearAxe(
       const PathData& path_data);
 
+  /**
+   * @brief Optimize the path within `path_boundary`. Only reads the shared
+   * state besides `workspace`, so different boundaries run concurrently.
+   *
+   * @return true if `path_data` is set to the optimized path
+   */
+  bool OptimizePathBoundary(const PathBoundary& path_boundary,
+                            const ReferenceLine& reference_line,
+                            const std::array<double, 3>& init_state,
+                            const std::array<double, 5>& w,
+                            PiecewiseJerkWorkspace* workspace,
+                            const double warm_start_shift,
+                            PathData* const path_data);
+
   /**
    * @brief
    *
@@ -63,6 +81,8 @@ class PiecewiseJerkPathOptimizer : public PathOptimizer {
    * @param ddl_bounds: constains
    * @param w: weighting scales
    * @param max_iter: optimization max interations
+   * @param workspace: persistent solver workspace, nullptr for none
+   * @param warm_start_shift: start s offset from the previous solution
    * @param ptr_x: optimization result of x
    * @param ptr_dx: optimization result of dx
    * @param ptr_ddx: optimization result of ddx
@@ -78,6 +98,7 @@ class PiecewiseJerkPathOptimizer : public PathOptimizer {
       const std::vector<std::pair<double, double>>& lat_boundaries,
       const std::vector<std::pair<double, double>>& ddl_bounds,
       const std::array<double, 5>& w, const int max_iter,
+      PiecewiseJerkWorkspace* workspace, const double warm_start_shift,
       std::vector<double>* ptr_x, std::vector<double>* ptr_dx,
       std::vector<double>* ptr_ddx);
 
@@ -93,6 +114,14 @@ class PiecewiseJerkPathOptimizer : public PathOptimizer {
 
   double GaussianWeighting(const double x, const double peak_weighting,
                            const double peak_weighting_x) const;
+
+  // persistent solver state per path boundary label, used with
+  // FLAGS_enable_persistent_osqp_workspace
+  struct PathBoundaryWorkspace {
+    double start_s = 0.0;
+    PiecewiseJerkWorkspace workspace;
+  };
+  std::unordered_map<std::string, PathBoundaryWorkspace> workspaces_;
 };
 
 }  // namespace planning
@@ -157,6 +157,15 @@ Status PiecewiseJerkSpeedOptimizer::Process(const PathData& path_data,
   piecewise_jerk_problem.set_penalty_dx(penalty_dx);
   piecewise_jerk_problem.set_dx_bounds(std::move(s_dot_bounds));
 
+  if (FLAGS_enable_persistent_osqp_workspace) {
+    // the previous profile started one planning cycle ago
+    piecewise_jerk_problem.set_workspace(&workspace_);
+    piecewise_jerk_problem.set_warm_start_shift(
+        1.0 / static_cast<double>(FLAGS_planning_loop_rate));
+  } else {
+    workspace_.Reset();
+  }
+
   // Solve the problem
   if (!piecewise_jerk_problem.Optimize()) {
     const std::string msg = "Piecewise jerk speed optimizer failed!";
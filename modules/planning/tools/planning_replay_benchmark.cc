@@ -0,0 +1,385 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Replays the planning inputs of a cyber record through
+ * OnLanePlanning or NaviPlanning on the mock clock, one planning cycle per
+ * prediction message, and reports the latency distribution of every
+ * profiled span and the heap allocations per cycle. The report can be stored
+ * as a baseline and later replays compared against it.
+ *
+ * Usage:
+ *   planning_replay_benchmark \
+ *     --flagfile=/apollo/modules/planning/conf/planning.conf \
+ *     --replay_record_file=<record> \
+ *     [--replay_baseline_file=<file> [--replay_update_baseline]]
+ **/
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "gflags/gflags.h"
+
+#include "cyber/common/file.h"
+#include "cyber/common/log.h"
+#include "cyber/record/record_reader.h"
+#include "cyber/time/clock.h"
+#include "modules/common/configs/config_gflags.h"
+#include "modules/planning/common/dependency_injector.h"
+#include "modules/planning/common/local_view.h"
+#include "modules/planning/common/planning_gflags.h"
+#include "modules/planning/common/planning_profiler.h"
+#include "modules/planning/navi_planning.h"
+#include "modules/planning/on_lane_planning.h"
+#include "modules/planning/proto/planning_profile.pb.h"
+
+DEFINE_string(replay_record_file, "", "The cyber record to replay.");
+DEFINE_string(replay_planning_config_file,
+              "/apollo/modules/planning/conf/planning_config.pb.txt",
+              "The planning config the replay runs with.");
+DEFINE_int32(replay_warmup_frames, 10,
+             "The number of first planning cycles left out of the report.");
+DEFINE_int32(replay_max_frames, 0,
+             "Stop after this many planning cycles, 0 to replay the record.");
+DEFINE_string(replay_baseline_file, "",
+              "The baseline in PlanningReplayBaseline text format to compare "
+              "the replay against.");
+DEFINE_bool(replay_update_baseline, false,
+            "True to write the replay report to replay_baseline_file instead "
+            "of comparing against it.");
+DEFINE_double(replay_regression_ratio, 0.2,
+              "A latency percentile or the allocations per cycle regress if "
+              "they grow by more than this ratio of the baseline.");
+DEFINE_double(replay_regression_min_ms, 0.5,
+              "Latency growth below this many milliseconds is never "
+              "reported, so that tiny spans do not regress on noise.");
+
+namespace {
+std::atomic<uint64_t> allocation_count{0};
+}  // namespace
+
+// count the heap allocations of the replay; everything below pairs with
+// malloc and free
+void* operator new(std::size_t size) {
+  allocation_count.fetch_add(1, std::memory_order_relaxed);
+  void* ptr = std::malloc(size == 0 ? 1 : size);
+  if (ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+void* operator new[](std::size_t size) { return operator new(size); }
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+namespace apollo {
+namespace planning {
+
+using apollo::cyber::Clock;
+using apollo::cyber::record::RecordMessage;
+using apollo::cyber::record::RecordReader;
+using apollo::perception::TrafficLightDetection;
+using apollo::relative_map::MapMsg;
+using apollo::routing::RoutingResponse;
+using apollo::storytelling::Stories;
+
+namespace {
+
+constexpr char kCycleEntryName[] = "cycle";
+
+double Percentile(const std::vector<double>& sorted_values,
+                  const double ratio) {
+  if (sorted_values.empty()) {
+    return 0.0;
+  }
+  const size_t rank = static_cast<size_t>(
+      std::ceil(ratio * static_cast<double>(sorted_values.size())));
+  return sorted_values[std::min(sorted_values.size() - 1,
+                                rank == 0 ? 0 : rank - 1)];
+}
+
+class PlanningReplay {
+ public:
+  bool Init() {
+    if (!cyber::common::GetProtoFromFile(FLAGS_replay_planning_config_file,
+                                         &config_)) {
+      AERROR << "failed to load planning config file "
+             << FLAGS_replay_planning_config_file;
+      return false;
+    }
+    injector_ = std::make_shared<DependencyInjector>();
+    if (FLAGS_use_navigation_mode) {
+      planning_ = std::make_unique<NaviPlanning>(injector_);
+    } else {
+      planning_ = std::make_unique<OnLanePlanning>(injector_);
+    }
+    Clock::SetMode(apollo::cyber::proto::MODE_MOCK);
+    if (!planning_->Init(config_).ok()) {
+      AERROR << "failed to init " << planning_->Name();
+      return false;
+    }
+
+    local_view_.traffic_light = std::make_shared<TrafficLightDetection>();
+    local_view_.routing = std::make_shared<RoutingResponse>();
+    local_view_.relative_map = std::make_shared<MapMsg>();
+    local_view_.pad_msg = std::make_shared<PadMessage>();
+    local_view_.stories = std::make_shared<Stories>();
+    return true;
+  }
+
+  bool Replay(const std::string& record_file) {
+    RecordReader reader(record_file);
+    if (!reader.IsValid()) {
+      AERROR << "failed to open " << record_file;
+      return false;
+    }
+    const auto& topic_config = config_.topic_config();
+    RecordMessage message;
+    while (reader.ReadMessage(&message)) {
+      if (FLAGS_replay_max_frames > 0 &&
+          frame_count_ >= FLAGS_replay_max_frames) {
+        break;
+      }
+      if (message.channel_name == topic_config.chassis_topic()) {
+        Parse(message, &local_view_.chassis);
+      } else if (message.channel_name == topic_config.localization_topic()) {
+        Parse(message, &local_view_.localization_estimate);
+      } else if (message.channel_name ==
+                 topic_config.routing_response_topic()) {
+        Parse(message, &local_view_.routing);
+      } else if (message.channel_name ==
+                 topic_config.traffic_light_detection_topic()) {
+        Parse(message, &local_view_.traffic_light);
+      } else if (message.channel_name == topic_config.relative_map_topic()) {
+        Parse(message, &local_view_.relative_map);
+      } else if (message.channel_name == topic_config.planning_pad_topic()) {
+        Parse(message, &local_view_.pad_msg);
+      } else if (message.channel_name == topic_config.story_telling_topic()) {
+        Parse(message, &local_view_.stories);
+      } else if (message.channel_name == topic_config.prediction_topic() &&
+                 Parse(message, &local_view_.prediction_obstacles)) {
+        // prediction triggers a planning cycle, as in PlanningComponent
+        RunOnce(static_cast<double>(message.time) * 1e-9);
+      }
+    }
+    return true;
+  }
+
+  int frame_count() const { return frame_count_; }
+
+  PlanningReplayBaseline Report() const {
+    PlanningReplayBaseline report;
+    report.set_record_file(FLAGS_replay_record_file);
+    report.set_frame_count(frame_count_);
+    for (const auto& latency : latencies_ms_) {
+      auto sorted_values = latency.second;
+      std::sort(sorted_values.begin(), sorted_values.end());
+      auto* entry = report.add_entry();
+      entry->set_name(latency.first);
+      entry->set_count(static_cast<int>(sorted_values.size()));
+      entry->set_p50_ms(Percentile(sorted_values, 0.5));
+      entry->set_p90_ms(Percentile(sorted_values, 0.9));
+      entry->set_p99_ms(Percentile(sorted_values, 0.99));
+      if (latency.first == kCycleEntryName && !allocations_.empty()) {
+        double total_allocations = 0.0;
+        for (const uint64_t allocations : allocations_) {
+          total_allocations += static_cast<double>(allocations);
+        }
+        entry->set_mean_allocations(total_allocations /
+                                    static_cast<double>(allocations_.size()));
+      }
+    }
+    return report;
+  }
+
+ private:
+  template <typename T>
+  bool Parse(const RecordMessage& message, std::shared_ptr<T>* local_msg) {
+    auto msg = std::make_shared<T>();
+    if (!msg->ParseFromString(message.content)) {
+      AERROR << "failed to parse message on " << message.channel_name;
+      return false;
+    }
+    *local_msg = msg;
+    return true;
+  }
+
+  void RunOnce(const double timestamp) {
+    if (local_view_.localization_estimate == nullptr ||
+        local_view_.chassis == nullptr ||
+        (FLAGS_use_navigation_mode ? !local_view_.relative_map->has_header()
+                                   : !local_view_.routing->has_header())) {
+      ADEBUG << "skip prediction at " << timestamp << " for missing input";
+      return;
+    }
+    Clock::SetNowInSeconds(timestamp);
+
+    ADCTrajectory adc_trajectory;
+    auto* profiler = PlanningProfiler::Instance();
+    profiler->BeginCycle();
+    const uint64_t allocations_before =
+        allocation_count.load(std::memory_order_relaxed);
+    planning_->RunOnce(local_view_, &adc_trajectory);
+    const uint64_t allocations =
+        allocation_count.load(std::memory_order_relaxed) - allocations_before;
+    PlanningProfile profile;
+    profiler->EndCycle(static_cast<uint32_t>(frame_count_), &profile);
+    injector_->history()->Add(adc_trajectory);
+
+    if (frame_count_++ < FLAGS_replay_warmup_frames) {
+      return;
+    }
+    latencies_ms_[kCycleEntryName].push_back(profile.wall_time_ms());
+    // a span may run several times in a cycle, e.g. once per reference line
+    std::map<std::string, double> span_ms;
+    for (const auto& span : profile.span()) {
+      span_ms[span.name()] += span.wall_time_ms();
+    }
+    for (const auto& span : span_ms) {
+      latencies_ms_[span.first].push_back(span.second);
+    }
+    allocations_.push_back(allocations);
+  }
+
+ private:
+  PlanningConfig config_;
+  std::shared_ptr<DependencyInjector> injector_;
+  std::unique_ptr<PlanningBase> planning_;
+  LocalView local_view_;
+  int frame_count_ = 0;
+  std::map<std::string, std::vector<double>> latencies_ms_;
+  std::vector<uint64_t> allocations_;
+};
+
+void PrintReport(const PlanningReplayBaseline& report) {
+  std::cout << "replayed " << report.frame_count() << " planning cycles of "
+            << report.record_file() << std::endl;
+  std::cout << std::left << std::setw(48) << "name" << std::right
+            << std::setw(8) << "count" << std::setw(10) << "p50_ms"
+            << std::setw(10) << "p90_ms" << std::setw(10) << "p99_ms"
+            << std::setw(14) << "allocations" << std::endl;
+  std::cout << std::fixed << std::setprecision(3);
+  for (const auto& entry : report.entry()) {
+    std::cout << std::left << std::setw(48) << entry.name() << std::right
+              << std::setw(8) << entry.count() << std::setw(10)
+              << entry.p50_ms() << std::setw(10) << entry.p90_ms()
+              << std::setw(10) << entry.p99_ms();
+    if (entry.has_mean_allocations()) {
+      std::cout << std::setw(14) << entry.mean_allocations();
+    }
+    std::cout << std::endl;
+  }
+}
+
+bool IsRegression(const double value, const double baseline_value,
+                  const double min_increase) {
+  return value > baseline_value * (1.0 + FLAGS_replay_regression_ratio) &&
+         value - baseline_value > min_increase;
+}
+
+// @return the number of regressions against the baseline
+int CompareWithBaseline(const PlanningReplayBaseline& report,
+                        const PlanningReplayBaseline& baseline) {
+  std::map<std::string, const PlanningReplayBaseline::Entry*> entries;
+  for (const auto& entry : report.entry()) {
+    entries[entry.name()] = &entry;
+  }
+  int num_regressions = 0;
+  for (const auto& baseline_entry : baseline.entry()) {
+    const auto iter = entries.find(baseline_entry.name());
+    if (iter == entries.end()) {
+      AWARN << baseline_entry.name() << " of the baseline did not run";
+      continue;
+    }
+    const auto& entry = *iter->second;
+    if (IsRegression(entry.p50_ms(), baseline_entry.p50_ms(),
+                     FLAGS_replay_regression_min_ms) ||
+        IsRegression(entry.p90_ms(), baseline_entry.p90_ms(),
+                     FLAGS_replay_regression_min_ms)) {
+      std::cout << "REGRESSION " << entry.name() << ": p50 "
+                << baseline_entry.p50_ms() << " -> " << entry.p50_ms()
+                << " ms, p90 " << baseline_entry.p90_ms() << " -> "
+                << entry.p90_ms() << " ms" << std::endl;
+      ++num_regressions;
+    }
+    if (baseline_entry.has_mean_allocations() &&
+        IsRegression(entry.mean_allocations(),
+                     baseline_entry.mean_allocations(), 0.0)) {
+      std::cout << "REGRESSION " << entry.name() << ": allocations "
+                << baseline_entry.mean_allocations() << " -> "
+                << entry.mean_allocations() << std::endl;
+      ++num_regressions;
+    }
+  }
+  return num_regressions;
+}
+
+}  // namespace
+}  // namespace planning
+}  // namespace apollo
+
+int main(int argc, char** argv) {
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  if (FLAGS_replay_record_file.empty()) {
+    AERROR << "Requires FLAGS_replay_record_file to be set";
+    return -1;
+  }
+  // the replay runs synchronously on this thread, without cyber timing
+  FLAGS_enable_reference_line_provider_thread = false;
+  FLAGS_enable_planning_profiler = true;
+
+  apollo::planning::PlanningReplay replay;
+  if (!replay.Init() || !replay.Replay(FLAGS_replay_record_file)) {
+    return -1;
+  }
+  const auto report = replay.Report();
+  apollo::planning::PrintReport(report);
+
+  if (FLAGS_replay_baseline_file.empty()) {
+    return 0;
+  }
+  if (FLAGS_replay_update_baseline) {
+    if (!apollo::cyber::common::SetProtoToASCIIFile(
+            report, FLAGS_replay_baseline_file)) {
+      AERROR << "failed to write baseline " << FLAGS_replay_baseline_file;
+      return -1;
+    }
+    return 0;
+  }
+  apollo::planning::PlanningReplayBaseline baseline;
+  if (!apollo::cyber::common::GetProtoFromFile(FLAGS_replay_baseline_file,
+                                               &baseline)) {
+    AERROR << "failed to load baseline " << FLAGS_replay_baseline_file;
+    return -1;
+  }
+  const int num_regressions =
+      apollo::planning::CompareWithBaseline(report, baseline);
+  std::cout << num_regressions << " regressions against "
+            << FLAGS_replay_baseline_file << std::endl;
+  return num_regressions == 0 ? 0 : 1;
+}
@@ -20,6 +20,8 @@
 
 #include "modules/planning/traffic_rules/backside_vehicle.h"
 
+#include <limits>
+
 namespace apollo {
 namespace planning {
 
@@ -29,12 +31,14 @@ BacksideVehicle::BacksideVehicle(const TrafficRuleConfig& config)
     : TrafficRule(config) {}
 
 void BacksideVehicle::MakeLaneKeepingObstacleDecision(
-    const SLBoundary& adc_sl_boundary, PathDecision* path_decision) {
+    const SLBoundary& adc_sl_boundary,
+    const std::vector<const Obstacle*>& obstacles,
+    PathDecision* path_decision) {
   ObjectDecisionType ignore;
   ignore.mutable_ignore();
   const double adc_length_s =
       adc_sl_boundary.end_s() - adc_sl_boundary.start_s();
-  for (const auto* obstacle : path_decision->obstacles().Items()) {
+  for (const auto* obstacle : obstacles) {
     if (obstacle->PerceptionSLBoundary().end_s() >= adc_sl_boundary.end_s() ||
         obstacle->IsCautionLevelObstacle()) {
       // don't ignore such vehicles.
@@ -79,7 +83,14 @@ Status BacksideVehicle::ApplyRule(
   const auto& adc_sl_boundary = reference_line_info->AdcSlBoundary();
   // The lane keeping reference line.
   if (reference_line_info->Lanes().IsOnSegment()) {
-    MakeLaneKeepingObstacleDecision(adc_sl_boundary, path_decision);
+    // only obstacles starting behind adc front can end behind it
+    const std::vector<const Obstacle*> obstacles =
+        index_ != nullptr
+            ? reference_line_info->obstacle_spatial_index()
+                  .GetObstaclesInSRange(std::numeric_limits<double>::lowest(),
+                                        adc_sl_boundary.end_s())
+            : path_decision->obstacles().Items();
+    MakeLaneKeepingObstacleDecision(adc_sl_boundary, obstacles, path_decision);
   }
   return Status::OK();
 }
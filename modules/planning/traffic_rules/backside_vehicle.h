@@ -20,6 +20,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "modules/planning/traffic_rules/traffic_rule.h"
 
 namespace apollo {
@@ -38,8 +40,10 @@ class BacksideVehicle : public TrafficRule {
    * @brief When the reference line info indicates that there is no lane change,
    * use lane keeping strategy for back side vehicles.
    */
-  void MakeLaneKeepingObstacleDecision(const SLBoundary& adc_sl_boundary,
-                                       PathDecision* path_decision);
+  void MakeLaneKeepingObstacleDecision(
+      const SLBoundary& adc_sl_boundary,
+      const std::vector<const Obstacle*>& obstacles,
+      PathDecision* path_decision);
 };
 
 }  // namespace planning
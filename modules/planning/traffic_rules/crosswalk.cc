@@ -130,14 +130,28 @@ void Crosswalk::MakeDecisions(Frame* const frame,
       continue;
     }
 
-    std::vector<std::string> pedestrians;
-    for (const auto* obstacle : path_decision->obstacles().Items()) {
-      const double stop_deceleration = util::GetADCStopDeceleration(
-          injector_->vehicle_state(), adc_front_edge_s,
-          crosswalk_overlap->start_s);
+    const double stop_deceleration = util::GetADCStopDeceleration(
+        injector_->vehicle_state(), adc_front_edge_s,
+        crosswalk_overlap->start_s);
+
+    // expand crosswalk polygon
+    // note: crosswalk expanded area will include sideway area
+    const Polygon2d crosswalk_exp_poly =
+        crosswalk_ptr->polygon().ExpandByDistance(
+            config_.crosswalk().expand_s_distance());
+
+    // only obstacles centered in the expanded area may need a stop
+    const std::vector<const Obstacle*> obstacles =
+        index_ != nullptr
+            ? reference_line_info->obstacle_spatial_index()
+                  .GetObstaclesInXYRange(crosswalk_exp_poly.AABoundingBox())
+            : path_decision->obstacles().Items();
 
+    std::vector<std::string> pedestrians;
+    for (const auto* obstacle : obstacles) {
       bool stop = CheckStopForObstacle(reference_line_info, crosswalk_ptr,
-                                       *obstacle, stop_deceleration);
+                                       crosswalk_exp_poly, *obstacle,
+                                       stop_deceleration);
 
       const std::string& obstacle_id = obstacle->Id();
       const PerceptionObstacle& perception_obstacle = obstacle->Perception();
@@ -259,7 +273,8 @@ bool Crosswalk::FindCrosswalks(ReferenceLineInfo* const reference_line_info) {
 
 bool Crosswalk::CheckStopForObstacle(
     ReferenceLineInfo* const reference_line_info,
-    const CrosswalkInfoConstPtr crosswalk_ptr, const Obstacle& obstacle,
+    const CrosswalkInfoConstPtr crosswalk_ptr,
+    const Polygon2d& crosswalk_exp_poly, const Obstacle& obstacle,
     const double stop_deceleration) {
   CHECK_NOTNULL(reference_line_info);
 
@@ -281,13 +296,8 @@ bool Crosswalk::CheckStopForObstacle(
     return false;
   }
 
-  // expand crosswalk polygon
-  // note: crosswalk expanded area will include sideway area
   Vec2d point(perception_obstacle.position().x(),
               perception_obstacle.position().y());
-  const Polygon2d crosswalk_exp_poly =
-      crosswalk_ptr->polygon().ExpandByDistance(
-          config_.crosswalk().expand_s_distance());
   bool in_expanded_crosswalk = crosswalk_exp_poly.IsPointIn(point);
 
   if (!in_expanded_crosswalk) {
@@ -45,6 +45,7 @@ class Crosswalk : public TrafficRule {
   bool FindCrosswalks(ReferenceLineInfo* const reference_line_info);
   bool CheckStopForObstacle(ReferenceLineInfo* const reference_line_info,
                             const hdmap::CrosswalkInfoConstPtr crosswalk_ptr,
+                            const common::math::Polygon2d& crosswalk_exp_poly,
                             const Obstacle& obstacle,
                             const double stop_deceleration);
 
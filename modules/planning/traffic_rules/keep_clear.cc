@@ -46,9 +46,15 @@ Status KeepClear::ApplyRule(Frame* const frame,
 
   // keep_clear zone
   if (config_.keep_clear().enable_keep_clear_zone()) {
-    const std::vector<PathOverlap>& keep_clear_overlaps =
-        reference_line_info->reference_line().map_path().clear_area_overlaps();
-    for (const auto& keep_clear_overlap : keep_clear_overlaps) {
+    // zones ending this far behind adc front also start too far behind it
+    // for BuildKeepClearObstacle
+    static constexpr double kEpsilon = 1e-6;
+    const double min_end_s = reference_line_info->AdcSlBoundary().end_s() -
+                             config_.keep_clear().min_pass_s_distance() -
+                             kEpsilon;
+    for (const auto* overlap : OverlapsAhead(
+             *reference_line_info, ReferenceLineInfo::CLEAR_AREA, min_end_s)) {
+      const PathOverlap& keep_clear_overlap = *overlap;
       const auto obstacle_id =
           KEEP_CLEAR_VO_ID_PREFIX + keep_clear_overlap.object_id;
 
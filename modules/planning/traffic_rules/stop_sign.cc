@@ -56,13 +56,10 @@ void StopSign::MakeDecisions(Frame* const frame,
       injector_->planning_context()->planning_status().stop_sign();
   const double adc_back_edge_s = reference_line_info->AdcSlBoundary().start_s();
 
-  const std::vector<PathOverlap>& stop_sign_overlaps =
-      reference_line_info->reference_line().map_path().stop_sign_overlaps();
-  for (const auto& stop_sign_overlap : stop_sign_overlaps) {
-    if (stop_sign_overlap.end_s <= adc_back_edge_s) {
-      continue;
-    }
-
+  for (const auto* overlap : OverlapsAhead(
+           *reference_line_info, ReferenceLineInfo::STOP_SIGN,
+           adc_back_edge_s)) {
+    const PathOverlap& stop_sign_overlap = *overlap;
     if (stop_sign_overlap.object_id ==
         stop_sign_status.done_stop_sign_overlap_id()) {
       continue;
@@ -33,6 +33,7 @@
 #include "modules/planning/traffic_rules/rerouting.h"
 #include "modules/planning/traffic_rules/stop_sign.h"
 #include "modules/planning/traffic_rules/traffic_light.h"
+#include "modules/planning/traffic_rules/traffic_rule_index.h"
 #include "modules/planning/traffic_rules/yield_sign.h"
 
 namespace apollo {
@@ -158,6 +159,12 @@ Status TrafficDecider::Execute(
   CHECK_NOTNULL(frame);
   CHECK_NOTNULL(reference_line_info);
 
+  std::unique_ptr<TrafficRuleIndex> index;
+  if (FLAGS_enable_traffic_rule_index) {
+    index.reset(new TrafficRuleIndex(
+        reference_line_info->reference_line().map_path()));
+  }
+
   for (const auto &rule_config : rule_configs_.config()) {
     if (!rule_config.enabled()) {
       ADEBUG << "Rule " << rule_config.rule_id() << " not enabled";
@@ -169,6 +176,7 @@ Status TrafficDecider::Execute(
       AERROR << "Could not find rule " << rule_config.DebugString();
       continue;
     }
+    rule->SetIndex(index.get());
     rule->ApplyRule(frame, reference_line_info);
     ADEBUG << "Applied rule "
            << TrafficRuleConfig::RuleId_Name(rule_config.rule_id());
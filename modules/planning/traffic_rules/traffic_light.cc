@@ -74,12 +74,10 @@ void TrafficLight::MakeDecisions(Frame* const frame,
   signal_light_debug->set_adc_speed(
       injector_->vehicle_state()->linear_velocity());
 
-  const std::vector<PathOverlap>& traffic_light_overlaps =
-      reference_line_info->reference_line().map_path().signal_overlaps();
-  for (const auto& traffic_light_overlap : traffic_light_overlaps) {
-    if (traffic_light_overlap.end_s <= adc_back_edge_s) {
-      continue;
-    }
+  for (const auto* overlap :
+       OverlapsAhead(*reference_line_info, ReferenceLineInfo::SIGNAL,
+                     adc_back_edge_s)) {
+    const PathOverlap& traffic_light_overlap = *overlap;
 
     // check if traffic-light-stop already finished, set by scenario/stage
     bool traffic_light_done = false;
@@ -21,11 +21,13 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include "modules/planning/common/dependency_injector.h"
 #include "modules/planning/common/frame.h"
 #include "modules/planning/common/reference_line_info.h"
 #include "modules/planning/proto/traffic_rule_config.pb.h"
+#include "modules/planning/traffic_rules/traffic_rule_index.h"
 
 namespace apollo {
 namespace planning {
@@ -41,10 +43,37 @@ class TrafficRule {
   const TrafficRuleConfig& GetConfig() const { return config_; }
   virtual common::Status ApplyRule(
       Frame* const frame, ReferenceLineInfo* const reference_line_info) = 0;
+  // the index outlives ApplyRule, nullptr makes the rule scan everything
+  void SetIndex(const TrafficRuleIndex* index) { index_ = index; }
 
  protected:
+  /**
+   * @brief The map overlaps of the type whose end_s is larger than s, from
+   * the index if there is one.
+   */
+  std::vector<const hdmap::PathOverlap*> OverlapsAhead(
+      const ReferenceLineInfo& reference_line_info,
+      const ReferenceLineInfo::OverlapType type, const double s) const {
+    if (index_ != nullptr) {
+      return index_->OverlapsAhead(type, s);
+    }
+    std::vector<const hdmap::PathOverlap*> overlaps;
+    const auto* map_overlaps = TrafficRuleIndex::MapOverlaps(
+        reference_line_info.reference_line().map_path(), type);
+    if (map_overlaps == nullptr) {
+      return overlaps;
+    }
+    for (const auto& overlap : *map_overlaps) {
+      if (overlap.end_s > s) {
+        overlaps.push_back(&overlap);
+      }
+    }
+    return overlaps;
+  }
+
   TrafficRuleConfig config_;
   std::shared_ptr<DependencyInjector> injector_;
+  const TrafficRuleIndex* index_ = nullptr;
 };
 
 }  // namespace planning
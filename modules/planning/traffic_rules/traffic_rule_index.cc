@@ -0,0 +1,99 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/traffic_rules/traffic_rule_index.h"
+
+#include <algorithm>
+
+namespace apollo {
+namespace planning {
+
+using apollo::hdmap::PathOverlap;
+
+constexpr int TrafficRuleIndex::kNumOverlapTypes;
+
+TrafficRuleIndex::TrafficRuleIndex(const hdmap::Path& map_path) {
+  for (int i = ReferenceLineInfo::CLEAR_AREA; i < kNumOverlapTypes; ++i) {
+    const auto* map_overlaps = MapOverlaps(
+        map_path, static_cast<ReferenceLineInfo::OverlapType>(i));
+    if (map_overlaps == nullptr) {
+      continue;
+    }
+    auto& sorted = sorted_overlaps_[i];
+    sorted.overlaps.reserve(map_overlaps->size());
+    for (const auto& overlap : *map_overlaps) {
+      sorted.overlaps.push_back(&overlap);
+    }
+    // the map path already keeps them by start_s, so this rarely moves any
+    std::stable_sort(sorted.overlaps.begin(), sorted.overlaps.end(),
+                     [](const PathOverlap* lhs, const PathOverlap* rhs) {
+                       return lhs->start_s < rhs->start_s;
+                     });
+    sorted.max_end_s.reserve(sorted.overlaps.size());
+    for (const auto* overlap : sorted.overlaps) {
+      sorted.max_end_s.push_back(
+          sorted.max_end_s.empty()
+              ? overlap->end_s
+              : std::max(sorted.max_end_s.back(), overlap->end_s));
+    }
+  }
+}
+
+std::vector<const PathOverlap*> TrafficRuleIndex::OverlapsAhead(
+    const ReferenceLineInfo::OverlapType type, const double s) const {
+  std::vector<const PathOverlap*> overlaps;
+  if (type < 0 || type >= kNumOverlapTypes) {
+    return overlaps;
+  }
+  const auto& sorted = sorted_overlaps_[type];
+  // every overlap before the first max_end_s beyond s ends at or before s
+  const size_t begin =
+      std::upper_bound(sorted.max_end_s.begin(), sorted.max_end_s.end(), s) -
+      sorted.max_end_s.begin();
+  for (size_t i = begin; i < sorted.overlaps.size(); ++i) {
+    if (sorted.overlaps[i]->end_s > s) {
+      overlaps.push_back(sorted.overlaps[i]);
+    }
+  }
+  return overlaps;
+}
+
+const std::vector<PathOverlap>* TrafficRuleIndex::MapOverlaps(
+    const hdmap::Path& map_path, const ReferenceLineInfo::OverlapType type) {
+  switch (type) {
+    case ReferenceLineInfo::CLEAR_AREA:
+      return &map_path.clear_area_overlaps();
+    case ReferenceLineInfo::CROSSWALK:
+      return &map_path.crosswalk_overlaps();
+    case ReferenceLineInfo::PNC_JUNCTION:
+      return &map_path.pnc_junction_overlaps();
+    case ReferenceLineInfo::SIGNAL:
+      return &map_path.signal_overlaps();
+    case ReferenceLineInfo::STOP_SIGN:
+      return &map_path.stop_sign_overlaps();
+    case ReferenceLineInfo::YIELD_SIGN:
+      return &map_path.yield_sign_overlaps();
+    default:
+      return nullptr;
+  }
+}
+
+}  // namespace planning
+}  // namespace apollo
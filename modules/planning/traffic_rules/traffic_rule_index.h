@@ -0,0 +1,71 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include "modules/map/pnc_map/path.h"
+#include "modules/planning/common/reference_line_info.h"
+
+namespace apollo {
+namespace planning {
+
+/**
+ * @class TrafficRuleIndex
+ *
+ * @brief TrafficRuleIndex sorts the map overlaps of one reference line by
+ * type and start_s, so traffic rules only visit the overlaps ahead of a given
+ * s. TrafficDecider builds it once per reference line and hands it to every
+ * rule. Obstacle queries go to ReferenceLineInfo::obstacle_spatial_index(),
+ * which follows the virtual obstacles the rules add.
+ */
+class TrafficRuleIndex {
+ public:
+  explicit TrafficRuleIndex(const hdmap::Path& map_path);
+
+  /**
+   * @brief Get the overlaps of the type whose end_s is larger than s, in the
+   * order of their start_s.
+   */
+  std::vector<const hdmap::PathOverlap*> OverlapsAhead(
+      const ReferenceLineInfo::OverlapType type, const double s) const;
+
+  /**
+   * @brief The overlaps of the type on the map path, or nullptr if the map
+   * path has none of the type, e.g. OBSTACLE.
+   */
+  static const std::vector<hdmap::PathOverlap>* MapOverlaps(
+      const hdmap::Path& map_path, const ReferenceLineInfo::OverlapType type);
+
+ private:
+  struct SortedOverlaps {
+    std::vector<const hdmap::PathOverlap*> overlaps;
+    // the largest end_s among overlaps[0..i]
+    std::vector<double> max_end_s;
+  };
+
+  static constexpr int kNumOverlapTypes = ReferenceLineInfo::YIELD_SIGN + 1;
+  std::array<SortedOverlaps, kNumOverlapTypes> sorted_overlaps_;
+};
+
+}  // namespace planning
+}  // namespace apollo
@@ -56,12 +56,10 @@ void YieldSign::MakeDecisions(Frame* const frame,
       injector_->planning_context()->planning_status().yield_sign();
   const double adc_front_edge_s = reference_line_info->AdcSlBoundary().end_s();
 
-  const std::vector<PathOverlap>& yield_sign_overlaps =
-      reference_line_info->reference_line().map_path().yield_sign_overlaps();
-  for (const auto& yield_sign_overlap : yield_sign_overlaps) {
-    if (yield_sign_overlap.end_s <= adc_front_edge_s) {
-      continue;
-    }
+  for (const auto* overlap :
+       OverlapsAhead(*reference_line_info, ReferenceLineInfo::YIELD_SIGN,
+                     adc_front_edge_s)) {
+    const PathOverlap& yield_sign_overlap = *overlap;
 
     // check if yield-sign-stop already finished, set by scenario/stage
     bool yield_sign_done = false;
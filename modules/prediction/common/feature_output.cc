@@ -25,6 +25,22 @@ namespace apollo {
 namespace prediction {
 
 using apollo::common::TrajectoryPoint;
+using apollo::common::util::AsyncProtoWriter;
+
+namespace {
+
+template <typename T>
+void WriteAndClear(const std::string& file_name, T* message,
+                   AsyncProtoWriter* writer) {
+  if (writer != nullptr) {
+    writer->WriteAndClear(file_name, message);
+    return;
+  }
+  cyber::common::SetProtoToBinaryFile(*message, file_name);
+  message->Clear();
+}
+
+}  // namespace
 
 Features FeatureOutput::features_;
 ListDataForLearning FeatureOutput::list_data_for_learning_;
@@ -37,6 +53,7 @@ std::size_t FeatureOutput::idx_prediction_result_ = 0;
 std::size_t FeatureOutput::idx_frame_env_ = 0;
 std::size_t FeatureOutput::idx_tuning_ = 0;
 std::mutex FeatureOutput::mutex_feature_;
+std::unique_ptr<AsyncProtoWriter> FeatureOutput::writer_;
 
 void FeatureOutput::Close() {
   ADEBUG << "Close feature output";
@@ -66,6 +83,16 @@ void FeatureOutput::Close() {
       break;
     }
   }
+  {
+    UNIQUE_LOCK_MULTITHREAD(mutex_feature_);
+    if (writer_ != nullptr) {
+      writer_->Flush();
+      if (writer_->NumFailed() > 0) {
+        AERROR << "Failed to write " << writer_->NumFailed() << " dump files.";
+      }
+      writer_.reset();
+    }
+  }
   Clear();
 }
 
@@ -85,6 +112,10 @@ void FeatureOutput::Clear() {
 
 bool FeatureOutput::Ready() {
   Clear();
+  UNIQUE_LOCK_MULTITHREAD(mutex_feature_);
+  if (FLAGS_prediction_offline_async_write && writer_ == nullptr) {
+    writer_.reset(new AsyncProtoWriter());
+  }
   return true;
 }
 
@@ -174,10 +205,8 @@ void FeatureOutput::WriteFeatureProto() {
   if (features_.feature().empty()) {
     ADEBUG << "Skip writing empty feature.";
   } else {
-    const std::string file_name = absl::StrCat(
-        FLAGS_prediction_data_dir, "/feature.", idx_feature_, ".bin");
-    cyber::common::SetProtoToBinaryFile(features_, file_name);
-    features_.Clear();
+    WriteAndClear(DataFileName("feature", idx_feature_), &features_,
+                  writer_.get());
     ++idx_feature_;
   }
 }
@@ -187,10 +216,8 @@ void FeatureOutput::WriteDataForLearning() {
   if (list_data_for_learning_.data_for_learning().empty()) {
     ADEBUG << "Skip writing empty data_for_learning.";
   } else {
-    const std::string file_name = absl::StrCat(
-        FLAGS_prediction_data_dir, "/datalearn.", idx_learning_, ".bin");
-    cyber::common::SetProtoToBinaryFile(list_data_for_learning_, file_name);
-    list_data_for_learning_.Clear();
+    WriteAndClear(DataFileName("datalearn", idx_learning_),
+                  &list_data_for_learning_, writer_.get());
     ++idx_learning_;
   }
 }
@@ -200,11 +227,8 @@ void FeatureOutput::WritePredictionResult() {
   if (list_prediction_result_.prediction_result().empty()) {
     ADEBUG << "Skip writing empty prediction_result.";
   } else {
-    const std::string file_name =
-        absl::StrCat(FLAGS_prediction_data_dir, "/prediction_result.",
-                     idx_prediction_result_, ".bin");
-    cyber::common::SetProtoToBinaryFile(list_prediction_result_, file_name);
-    list_prediction_result_.Clear();
+    WriteAndClear(DataFileName("prediction_result", idx_prediction_result_),
+                  &list_prediction_result_, writer_.get());
     ++idx_prediction_result_;
   }
 }
@@ -214,10 +238,8 @@ void FeatureOutput::WriteFrameEnv() {
   if (list_frame_env_.frame_env().empty()) {
     ADEBUG << "Skip writing empty prediction_result.";
   } else {
-    const std::string file_name = absl::StrCat(
-        FLAGS_prediction_data_dir, "/frame_env.", idx_frame_env_, ".bin");
-    cyber::common::SetProtoToBinaryFile(list_frame_env_, file_name);
-    list_frame_env_.Clear();
+    WriteAndClear(DataFileName("frame_env", idx_frame_env_),
+                  &list_frame_env_, writer_.get());
     ++idx_frame_env_;
   }
 }
@@ -228,13 +250,21 @@ void FeatureOutput::WriteDataForTuning() {
     ADEBUG << "Skip writing empty data_for_tuning.";
     return;
   }
-  const std::string file_name = absl::StrCat(
-      FLAGS_prediction_data_dir, "/datatuning.", idx_tuning_, ".bin");
-  cyber::common::SetProtoToBinaryFile(list_data_for_tuning_, file_name);
-  list_data_for_tuning_.Clear();
+  WriteAndClear(DataFileName("datatuning", idx_tuning_),
+                &list_data_for_tuning_, writer_.get());
   ++idx_tuning_;
 }
 
+std::string FeatureOutput::DataFileName(const std::string& kind,
+                                        std::size_t idx) {
+  if (FLAGS_prediction_offline_shard_num > 1) {
+    return absl::StrCat(FLAGS_prediction_data_dir, "/", kind, ".shard",
+                        FLAGS_prediction_offline_shard_index, ".", idx,
+                        ".bin");
+  }
+  return absl::StrCat(FLAGS_prediction_data_dir, "/", kind, ".", idx, ".bin");
+}
+
 int FeatureOutput::Size() {
   UNIQUE_LOCK_MULTITHREAD(mutex_feature_);
   return features_.feature_size();
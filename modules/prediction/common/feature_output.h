@@ -16,10 +16,12 @@
 
 #pragma once
 
+#include <memory>
 #include <mutex>
 #include <string>
 #include <vector>
 
+#include "modules/common/util/async_proto_writer.h"
 #include "modules/prediction/container/obstacles/obstacle.h"
 #include "modules/prediction/proto/offline_features.pb.h"
 #include "modules/prediction/proto/prediction_obstacle.pb.h"
@@ -156,6 +158,12 @@ class FeatureOutput {
   static int SizeOfDataForTuning();
 
  private:
+  /**
+   * @brief The dump file of the given kind and index; each shard of a
+   * parallel offline run gets its own files.
+   */
+  static std::string DataFileName(const std::string& kind, std::size_t idx);
+
   static Features features_;
   static std::size_t idx_feature_;
   static ListDataForLearning list_data_for_learning_;
@@ -167,6 +175,8 @@ class FeatureOutput {
   static ListDataForTuning list_data_for_tuning_;
   static std::size_t idx_tuning_;
   static std::mutex mutex_feature_;
+  // writes the dumps in the background with --prediction_offline_async_write
+  static std::unique_ptr<common::util::AsyncProtoWriter> writer_;
 };
 
 }  // namespace prediction
@@ -18,6 +18,9 @@
 
 #include "gtest/gtest.h"
 
+#include "cyber/common/file.h"
+#include "modules/prediction/common/prediction_system_gflags.h"
+
 namespace apollo {
 namespace prediction {
 
@@ -50,5 +53,31 @@ TEST_F(FeatureOutputTest, clear) {
   EXPECT_EQ(0, FeatureOutput::Size());
 }
 
+TEST_F(FeatureOutputTest, async_write) {
+  FLAGS_prediction_data_dir = "/tmp";
+  FLAGS_prediction_offline_mode = 1;
+  FLAGS_prediction_offline_shard_num = 2;
+  FLAGS_prediction_offline_shard_index = 1;
+  FLAGS_prediction_offline_async_write = true;
+  const std::string file_name = "/tmp/feature.shard1.0.bin";
+  cyber::common::DeleteFile(file_name);
+  EXPECT_TRUE(FeatureOutput::Ready());
+  Feature feature;
+  feature.set_id(7);
+  FeatureOutput::InsertFeatureProto(feature);
+  FeatureOutput::WriteFeatureProto();
+  EXPECT_EQ(0, FeatureOutput::Size());
+  FeatureOutput::Close();
+
+  Features features;
+  ASSERT_TRUE(cyber::common::GetProtoFromBinaryFile(file_name, &features));
+  ASSERT_EQ(1, features.feature_size());
+  EXPECT_EQ(7, features.feature(0).id());
+  FLAGS_prediction_offline_mode = 0;
+  FLAGS_prediction_offline_shard_num = 1;
+  FLAGS_prediction_offline_shard_index = 0;
+  FLAGS_prediction_offline_async_write = false;
+}
+
 }  // namespace prediction
 }  // namespace apollo
@@ -16,6 +16,7 @@
 
 #include <algorithm>
 #include <limits>
+#include <mutex>
 #include <queue>
 #include <unordered_set>
 #include <utility>
@@ -31,6 +32,17 @@ using apollo::hdmap::JunctionInfo;
 using apollo::hdmap::LaneInfo;
 using ConstLaneInfoPtr = std::shared_ptr<const LaneInfo>;
 
+struct JunctionAnalyzer::JunctionTable {
+  // the junction it was built for, a new map gives a new junction info
+  std::shared_ptr<const JunctionInfo> junction_info_ptr;
+  // Hashtable: exit_lane_id -> junction_exit
+  std::unordered_map<std::string, JunctionExit> junction_exits;
+  double junction_range = 0.0;
+  // Hashtable: start_lane_id -> junction_feature, filled on first use
+  std::unordered_map<std::string, JunctionFeature> junction_features;
+  std::mutex junction_features_mutex;
+};
+
 void JunctionAnalyzer::Init(const std::string& junction_id) {
   if (junction_info_ptr_ != nullptr &&
       junction_info_ptr_->id().id() == junction_id) {
@@ -38,16 +50,30 @@ void JunctionAnalyzer::Init(const std::string& junction_id) {
   }
   Clear();
   junction_info_ptr_ = PredictionMap::JunctionById(junction_id);
+
+  // Hashtable: junction_id -> junction_table of every junction met so far
+  static std::unordered_map<std::string, std::shared_ptr<JunctionTable>>
+      junction_tables;
+  static std::mutex mutex;
+  std::lock_guard<std::mutex> lock(mutex);
+  std::shared_ptr<JunctionTable>& junction_table = junction_tables[junction_id];
+  if (junction_table != nullptr &&
+      junction_table->junction_info_ptr == junction_info_ptr_) {
+    junction_table_ = junction_table;
+    return;
+  }
+  junction_table_ = std::make_shared<JunctionTable>();
+  junction_table_->junction_info_ptr = junction_info_ptr_;
   SetAllJunctionExits();
+  junction_table_->junction_range = ComputeJunctionRange();
+  junction_table = junction_table_;
 }
 
 void JunctionAnalyzer::Clear() {
   // Clear all data
   junction_info_ptr_ = nullptr;
-  junction_exits_.clear();
-  junction_features_.clear();
+  junction_table_ = nullptr;
 }
-
 void JunctionAnalyzer::SetAllJunctionExits() {
   CHECK_NOTNULL(junction_info_ptr_);
   // Go through everything that the junction overlaps with.
@@ -73,7 +99,7 @@ void JunctionAnalyzer::SetAllJunctionExits() {
           junction_exit.set_exit_heading(lane_info_ptr->Heading(s));
           junction_exit.set_exit_width(lane_info_ptr->GetWidth(s));
           // add junction_exit to hashtable
-          junction_exits_[lane_id] = junction_exit;
+          junction_table_->junction_exits[lane_id] = junction_exit;
         }
       }
     }
@@ -99,7 +125,8 @@ std::vector<JunctionExit> JunctionAnalyzer::GetJunctionExits(
     // Stop if this is already an exit lane.
     if (IsExitLane(curr_lane_id) &&
         visited_exit_lanes.find(curr_lane_id) == visited_exit_lanes.end()) {
-      junction_exits.push_back(junction_exits_[curr_lane_id]);
+      junction_exits.push_back(
+          junction_table_->junction_exits.at(curr_lane_id));
       visited_exit_lanes.insert(curr_lane_id);
       continue;
     }
@@ -118,12 +145,16 @@ std::vector<JunctionExit> JunctionAnalyzer::GetJunctionExits(
 
 const JunctionFeature& JunctionAnalyzer::GetJunctionFeature(
     const std::string& start_lane_id) {
-  if (junction_features_.find(start_lane_id) != junction_features_.end()) {
-    return junction_features_[start_lane_id];
+  CHECK_NOTNULL(junction_table_);
+  std::lock_guard<std::mutex> lock(junction_table_->junction_features_mutex);
+  auto& junction_features = junction_table_->junction_features;
+  auto iter = junction_features.find(start_lane_id);
+  if (iter != junction_features.end()) {
+    return iter->second;
   }
-  JunctionFeature junction_feature;
+  JunctionFeature& junction_feature = junction_features[start_lane_id];
   junction_feature.set_junction_id(GetJunctionId());
-  junction_feature.set_junction_range(ComputeJunctionRange());
+  junction_feature.set_junction_range(junction_table_->junction_range);
   // Find all junction-exit-lanes that are successors of the start_lane_id.
   std::vector<JunctionExit> junction_exits = GetJunctionExits(start_lane_id);
 
@@ -132,8 +163,7 @@ const JunctionFeature& JunctionAnalyzer::GetJunctionFeature(
   }
   junction_feature.mutable_enter_lane()->set_lane_id(start_lane_id);
   junction_feature.add_start_lane_id(start_lane_id);
-  junction_features_[start_lane_id] = junction_feature;
-  return junction_features_[start_lane_id];
+  return junction_feature;
 }
 
 JunctionFeature JunctionAnalyzer::GetJunctionFeature(
@@ -142,7 +172,8 @@ JunctionFeature JunctionAnalyzer::GetJunctionFeature(
   bool initialized = false;
   std::unordered_map<std::string, JunctionExit> junction_exits_map;
   for (const std::string& start_lane_id : start_lane_ids) {
-    JunctionFeature junction_feature = GetJunctionFeature(start_lane_id);
+    const JunctionFeature& junction_feature =
+        GetJunctionFeature(start_lane_id);
     if (!initialized) {
       merged_junction_feature.set_junction_id(junction_feature.junction_id());
       merged_junction_feature.set_junction_range(
@@ -164,7 +195,8 @@ JunctionFeature JunctionAnalyzer::GetJunctionFeature(
 }
 
 bool JunctionAnalyzer::IsExitLane(const std::string& lane_id) {
-  return junction_exits_.find(lane_id) != junction_exits_.end();
+  return junction_table_->junction_exits.find(lane_id) !=
+         junction_table_->junction_exits.end();
 }
 
 const std::string& JunctionAnalyzer::GetJunctionId() {
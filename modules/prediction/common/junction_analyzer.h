@@ -68,8 +68,10 @@ class JunctionAnalyzer {
       const std::vector<std::string>& start_lane_ids);
 
  private:
+  struct JunctionTable;
+
   /**
-   * @brief Set all junction exits in the hashtable junction_exits_
+   * @brief Set all junction exits in the hashtable of the junction table
    */
   void SetAllJunctionExits();
 
@@ -90,10 +92,9 @@ class JunctionAnalyzer {
  private:
   // junction_info pointer associated to the input junction_id
   std::shared_ptr<const apollo::hdmap::JunctionInfo> junction_info_ptr_;
-  // Hashtable: exit_lane_id -> junction_exit
-  std::unordered_map<std::string, JunctionExit> junction_exits_;
-  // Hashtable: start_lane_id -> junction_feature
-  std::unordered_map<std::string, JunctionFeature> junction_features_;
+  // Junction exits and features of the junction, which only depend on the
+  // map, so they are shared across frames and containers
+  std::shared_ptr<JunctionTable> junction_table_;
 };
 
 }  // namespace prediction
@@ -46,5 +46,25 @@ TEST_F(JunctionAnalyzerTest, MultiLane) {
   junction_analyzer.Clear();
 }
 
+TEST_F(JunctionAnalyzerTest, SharedJunctionTable) {
+  JunctionAnalyzer junction_analyzer;
+  junction_analyzer.Init("j2");
+  const JunctionFeature& junction_feature =
+      junction_analyzer.GetJunctionFeature("l61");
+
+  // another analyzer of the same junction reuses the junction features
+  JunctionAnalyzer other_junction_analyzer;
+  other_junction_analyzer.Init("j2");
+  const JunctionFeature& other_junction_feature =
+      other_junction_analyzer.GetJunctionFeature("l61");
+  EXPECT_EQ(&other_junction_feature, &junction_feature);
+  EXPECT_EQ(other_junction_feature.junction_range(),
+            junction_analyzer.ComputeJunctionRange());
+
+  junction_analyzer.Clear();
+  junction_analyzer.Init("j2");
+  EXPECT_EQ(&junction_analyzer.GetJunctionFeature("l61"), &junction_feature);
+}
+
 }  // namespace prediction
 }  // namespace apollo
@@ -218,6 +218,23 @@ void MessageProcess::OnPerception(
     return;
   }
 
+  if (FLAGS_enable_obstacle_pipeline &&
+      FLAGS_prediction_offline_mode !=
+          PredictionConstants::kDumpDataForLearning &&
+      FLAGS_prediction_offline_mode != PredictionConstants::kDumpFrameEnv) {
+    // Make evaluations and predictions obstacle by obstacle
+    evaluator_manager->PrepareFrame(ptr_obstacles_container);
+    predictor_manager->RunPipelined(
+        [&](Obstacle* obstacle) {
+          evaluator_manager->EvaluateObstacle(obstacle,
+                                              ptr_obstacles_container);
+        },
+        perception_obstacles, ptr_ego_trajectory_container,
+        ptr_obstacles_container);
+    *prediction_obstacles = predictor_manager->prediction_obstacles();
+    return;
+  }
+
   // Make evaluations
   evaluator_manager->Run(ptr_obstacles_container);
   if (FLAGS_prediction_offline_mode ==
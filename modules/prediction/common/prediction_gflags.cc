@@ -59,6 +59,9 @@ DEFINE_double(surrounding_lane_search_radius, 3.0,
 // Semantic Map
 DEFINE_double(base_image_half_range, 100.0, "The half range of base image.");
 DEFINE_bool(img_show_semantic_map, false, "If show the image of semantic map.");
+DEFINE_double(base_image_redraw_distance, 0.0,
+              "The base image is kept until the ego vehicle moves this far "
+              "from its center.");
 
 // Scenario
 DEFINE_double(junction_distance_threshold, 10.0,
@@ -154,6 +157,10 @@ DEFINE_string(evaluator_vehicle_rnn_file,
 DEFINE_string(torch_vehicle_junction_mlp_file,
               "/apollo/modules/prediction/data/junction_mlp_vehicle_model.pt",
               "Vehicle junction MLP model file");
+DEFINE_string(
+    torch_vehicle_junction_mlp_quantized_file,
+    "/apollo/modules/prediction/data/junction_mlp_vehicle_quantized_model.pt",
+    "Vehicle junction MLP int8 quantized model file for cpu");
 DEFINE_string(torch_vehicle_junction_map_file,
               "/apollo/modules/prediction/data/junction_map_vehicle_model.pt",
               "Vehicle junction map model file");
@@ -170,6 +177,14 @@ DEFINE_string(torch_vehicle_cruise_go_file,
 DEFINE_string(torch_vehicle_cruise_cutin_file,
               "/apollo/modules/prediction/data/cruise_cutin_vehicle_model.pt",
               "Vehicle cruise cutin model file");
+DEFINE_string(
+    torch_vehicle_cruise_go_quantized_file,
+    "/apollo/modules/prediction/data/cruise_go_vehicle_quantized_model.pt",
+    "Vehicle cruise go int8 quantized model file for cpu");
+DEFINE_string(
+    torch_vehicle_cruise_cutin_quantized_file,
+    "/apollo/modules/prediction/data/cruise_cutin_vehicle_quantized_model.pt",
+    "Vehicle cruise cutin int8 quantized model file for cpu");
 DEFINE_string(torch_vehicle_lane_scanning_file,
               "/apollo/modules/prediction/data/lane_scanning_vehicle_model.pt",
               "Vehicle lane scanning model file");
@@ -46,6 +46,7 @@ DECLARE_double(surrounding_lane_search_radius);
 // Semantic Map
 DECLARE_double(base_image_half_range);
 DECLARE_bool(img_show_semantic_map);
+DECLARE_double(base_image_redraw_distance);
 
 // Scenario
 DECLARE_double(junction_distance_threshold);
@@ -98,11 +99,14 @@ DECLARE_double(pedestrian_max_acc);
 DECLARE_double(still_speed);
 DECLARE_string(evaluator_vehicle_mlp_file);
 DECLARE_string(torch_vehicle_junction_mlp_file);
+DECLARE_string(torch_vehicle_junction_mlp_quantized_file);
 DECLARE_string(torch_vehicle_junction_map_file);
 DECLARE_string(torch_vehicle_semantic_lstm_file);
 DECLARE_string(torch_vehicle_semantic_lstm_cpu_file);
 DECLARE_string(torch_vehicle_cruise_go_file);
 DECLARE_string(torch_vehicle_cruise_cutin_file);
+DECLARE_string(torch_vehicle_cruise_go_quantized_file);
+DECLARE_string(torch_vehicle_cruise_cutin_quantized_file);
 DECLARE_string(torch_vehicle_lane_scanning_file);
 DECLARE_string(torch_pedestrian_interaction_position_embedding_file);
 DECLARE_string(torch_pedestrian_interaction_social_embedding_file);
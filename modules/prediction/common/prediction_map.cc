@@ -71,6 +71,10 @@ std::shared_ptr<const LaneInfo> PredictionMap::LaneById(
   return HDMapUtil::BaseMap().GetLaneById(hdmap::MakeMapId(str_id));
 }
 
+std::shared_ptr<const LaneInfo> PredictionMap::LaneByIndex(const int index) {
+  return HDMapUtil::BaseMap().GetLaneByIndex(index);
+}
+
 std::shared_ptr<const JunctionInfo> PredictionMap::JunctionById(
     const std::string& str_id) {
   return HDMapUtil::BaseMap().GetJunctionById(hdmap::MakeMapId(str_id));
@@ -574,12 +578,9 @@ bool PredictionMap::IsSuccessorLane(std::shared_ptr<const LaneInfo> target_lane,
   if (target_lane == nullptr) {
     return false;
   }
-  for (const auto& successor_lane_id : curr_lane->lane().successor_id()) {
-    if (target_lane->id().id() == successor_lane_id.id()) {
-      return true;
-    }
-  }
-  return false;
+  const auto& successor_indices = curr_lane->successor_indices();
+  return std::find(successor_indices.begin(), successor_indices.end(),
+                   target_lane->index()) != successor_indices.end();
 }
 
 bool PredictionMap::IsSuccessorLane(
@@ -605,12 +606,9 @@ bool PredictionMap::IsPredecessorLane(
   if (target_lane == nullptr) {
     return false;
   }
-  for (const auto& predecessor_lane_id : curr_lane->lane().predecessor_id()) {
-    if (target_lane->id().id() == predecessor_lane_id.id()) {
-      return true;
-    }
-  }
-  return false;
+  const auto& predecessor_indices = curr_lane->predecessor_indices();
+  return std::find(predecessor_indices.begin(), predecessor_indices.end(),
+                   target_lane->index()) != predecessor_indices.end();
 }
 
 bool PredictionMap::IsPredecessorLane(
@@ -75,6 +75,13 @@ class PredictionMap {
    */
   static std::shared_ptr<const hdmap::LaneInfo> LaneById(const std::string& id);
 
+  /**
+   * @brief Get a shared pointer to a lane by its dense index in the map.
+   * @param index The index of the target lane, see LaneInfo::index().
+   * @return A shared pointer to the lane with the input index.
+   */
+  static std::shared_ptr<const hdmap::LaneInfo> LaneByIndex(const int index);
+
   /**
    * @brief Get a shared pointer to a junction by junction ID.
    * @param id The ID of the target junction ID in the form of string.
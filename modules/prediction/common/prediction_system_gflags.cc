@@ -54,6 +54,14 @@ DEFINE_int32(prediction_offline_mode, 0,
              "3: dump predicted trajectory to predict_result.*.bin"
              "4: dump frame environment info to frame_env.*.bin"
              "5: dump data for tuning to datatuning.*.bin");
+DEFINE_int32(prediction_offline_shard_num, 1,
+             "Number of processes sharing the offline bags. Each process "
+             "takes every shard_num-th bag and dumps *.shard<index>.*.bin");
+DEFINE_int32(prediction_offline_shard_index, 0,
+             "Shard of the offline bags this process takes, in "
+             "[0, prediction_offline_shard_num)");
+DEFINE_bool(prediction_offline_async_write, false,
+            "Write the offline dump files on a background thread");
 DEFINE_bool(enable_multi_thread, true, "If enable multi-thread.");
 DEFINE_int32(max_thread_num, 8, "Maximal number of threads.");
 DEFINE_int32(max_caution_thread_num, 2,
@@ -61,6 +69,19 @@ DEFINE_int32(max_caution_thread_num, 2,
 DEFINE_bool(enable_async_draw_base_image, true,
             "If enable async to draw base image");
 DEFINE_bool(use_cuda, true, "If use cuda for torch.");
+DEFINE_bool(use_quantized_cpu_model, false,
+            "If use the int8 quantized MLP models when torch runs on cpu.");
+DEFINE_bool(enable_batch_evaluation, false,
+            "If evaluate the obstacles sharing an evaluator together, so "
+            "that each model runs once per frame.");
+DEFINE_bool(enable_obstacle_pipeline, false,
+            "If evaluate and predict each obstacle in one task, caution "
+            "obstacles first, instead of evaluating all obstacles before "
+            "predicting any.");
+DEFINE_double(prediction_time_budget, 0.0,
+              "Time budget in seconds of the semantic map based evaluators "
+              "in a frame, 0 for no budget. Obstacles left once it is used "
+              "up are predicted by the free move predictor.");
 
 // Bag replay timestamp gap
 DEFINE_double(replay_timestamp_gap, 10.0,
@@ -32,11 +32,18 @@ DECLARE_double(prediction_test_duration);
 
 DECLARE_string(prediction_offline_bags);
 DECLARE_int32(prediction_offline_mode);
+DECLARE_int32(prediction_offline_shard_num);
+DECLARE_int32(prediction_offline_shard_index);
+DECLARE_bool(prediction_offline_async_write);
 DECLARE_bool(enable_multi_thread);
 DECLARE_int32(max_thread_num);
 DECLARE_int32(max_caution_thread_num);
 DECLARE_bool(enable_async_draw_base_image);
 DECLARE_bool(use_cuda);
+DECLARE_bool(use_quantized_cpu_model);
+DECLARE_bool(enable_batch_evaluation);
+DECLARE_bool(enable_obstacle_pipeline);
+DECLARE_double(prediction_time_budget);
 
 // Bag replay timestamp gap
 DECLARE_double(replay_timestamp_gap);
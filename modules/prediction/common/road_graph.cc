@@ -17,7 +17,9 @@
 #include "modules/prediction/common/road_graph.h"
 
 #include <algorithm>
+#include <mutex>
 #include <set>
+#include <unordered_map>
 #include <utility>
 
 #include "modules/prediction/common/prediction_constants.h"
@@ -81,6 +83,62 @@ bool IsAtLeft(std::shared_ptr<const LaneInfo> lane1,
   return HeadingIsAtLeft(lane1->headings(), lane2->headings(), 0);
 }
 
+// The lanes to expand from a lane only depend on the map, so they are
+// computed once and shared by all obstacles and frames.
+struct CandidateLanes {
+  // the lane they were computed for, a new map gives a new lane info
+  std::shared_ptr<const LaneInfo> lane_info_ptr;
+  std::vector<std::shared_ptr<const LaneInfo>> lanes;
+};
+
+std::vector<std::shared_ptr<const LaneInfo>> ComputeCandidateLanes(
+    std::shared_ptr<const LaneInfo> lane_info_ptr,
+    const bool search_forward_direction, const bool consider_lane_split) {
+  std::vector<std::shared_ptr<const LaneInfo>> candidate_lanes;
+  std::set<int> set_lane_indices;
+  if (search_forward_direction) {
+    // Reundancy removal.
+    set_lane_indices.insert(lane_info_ptr->successor_indices().begin(),
+                            lane_info_ptr->successor_indices().end());
+    for (const int unique_index : set_lane_indices) {
+      candidate_lanes.push_back(PredictionMap::LaneByIndex(unique_index));
+    }
+    // Sort the successor lane_segments from left to right.
+    std::sort(candidate_lanes.begin(), candidate_lanes.end(), IsAtLeft);
+    // Based on other conditions, select what successor lanes should be used.
+    if (!consider_lane_split) {
+      candidate_lanes = {
+          PredictionMap::LaneWithSmallestAverageCurvature(candidate_lanes)};
+    }
+  } else {
+    // Redundancy removal.
+    set_lane_indices.insert(lane_info_ptr->predecessor_indices().begin(),
+                            lane_info_ptr->predecessor_indices().end());
+    for (const int unique_index : set_lane_indices) {
+      candidate_lanes.push_back(PredictionMap::LaneByIndex(unique_index));
+    }
+  }
+  return candidate_lanes;
+}
+
+std::vector<std::shared_ptr<const LaneInfo>> GetCandidateLanes(
+    std::shared_ptr<const LaneInfo> lane_info_ptr,
+    const bool search_forward_direction, const bool consider_lane_split) {
+  // successors with and without lane split, then predecessors
+  static std::unordered_map<std::string, CandidateLanes> cache[3];
+  static std::mutex mutex;
+  const int index =
+      search_forward_direction ? (consider_lane_split ? 0 : 1) : 2;
+  std::lock_guard<std::mutex> lock(mutex);
+  CandidateLanes& entry = cache[index][lane_info_ptr->id().id()];
+  if (entry.lane_info_ptr != lane_info_ptr) {
+    entry.lane_info_ptr = lane_info_ptr;
+    entry.lanes = ComputeCandidateLanes(
+        lane_info_ptr, search_forward_direction, consider_lane_split);
+  }
+  return entry.lanes;
+}
+
 }  // namespace
 
 RoadGraph::RoadGraph(const double start_s, const double length,
@@ -231,7 +289,7 @@ void RoadGraph::ConstructLaneSequence(
   lane_segment.set_adc_s(curr_s);
   lane_segment.set_lane_id(lane_info_ptr->id().id());
   lane_segment.set_lane_turn_type(
-      PredictionMap::LaneTurnType(lane_info_ptr->id().id()));
+      static_cast<int>(lane_info_ptr->lane().turn()));
   lane_segment.set_total_length(lane_info_ptr->total_length());
   if (search_forward_direction) {
     lane_segment.set_start_s(curr_s);
@@ -275,36 +333,15 @@ void RoadGraph::ConstructLaneSequence(
   // Otherwise, continue searching for subsequent lane_segments.
   double new_accumulated_s = 0.0;
   double new_lane_seg_s = 0.0;
-  std::vector<std::shared_ptr<const hdmap::LaneInfo>> candidate_lanes;
-  std::set<std::string> set_lane_ids;
   if (search_forward_direction) {
     new_accumulated_s = accumulated_s + lane_info_ptr->total_length() - curr_s;
-    // Reundancy removal.
-    for (const auto& successor_lane_id : lane_info_ptr->lane().successor_id()) {
-      set_lane_ids.insert(successor_lane_id.id());
-    }
-    for (const auto& unique_id : set_lane_ids) {
-      candidate_lanes.push_back(PredictionMap::LaneById(unique_id));
-    }
-    // Sort the successor lane_segments from left to right.
-    std::sort(candidate_lanes.begin(), candidate_lanes.end(), IsAtLeft);
-    // Based on other conditions, select what successor lanes should be used.
-    if (!consider_lane_split) {
-      candidate_lanes = {
-          PredictionMap::LaneWithSmallestAverageCurvature(candidate_lanes)};
-    }
   } else {
     new_accumulated_s = accumulated_s + curr_s;
     new_lane_seg_s = -0.1;
-    // Redundancy removal.
-    for (const auto& predecessor_lane_id :
-         lane_info_ptr->lane().predecessor_id()) {
-      set_lane_ids.insert(predecessor_lane_id.id());
-    }
-    for (const auto& unique_id : set_lane_ids) {
-      candidate_lanes.push_back(PredictionMap::LaneById(unique_id));
-    }
   }
+  const std::vector<std::shared_ptr<const hdmap::LaneInfo>> candidate_lanes =
+      GetCandidateLanes(lane_info_ptr, search_forward_direction,
+                        consider_lane_split);
   bool consider_further_lane_split =
       !search_forward_direction ||
       (FLAGS_prediction_offline_mode ==
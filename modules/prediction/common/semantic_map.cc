@@ -16,6 +16,7 @@
 
 #include "modules/prediction/common/semantic_map.h"
 
+#include <cmath>
 #include <utility>
 #include <vector>
 
@@ -72,9 +73,11 @@ void SemanticMap::RunCurrFrame(
   if (!FLAGS_enable_async_draw_base_image) {
     double x = ego_feature_.position().x();
     double y = ego_feature_.position().y();
-    curr_base_x_ = x - FLAGS_base_image_half_range;
-    curr_base_y_ = y - FLAGS_base_image_half_range;
-    DrawBaseMap(x, y, curr_base_x_, curr_base_y_);
+    if (!KeepBaseMap(base_img_, x, y, curr_base_x_, curr_base_y_)) {
+      curr_base_x_ = x - FLAGS_base_image_half_range;
+      curr_base_y_ = y - FLAGS_base_image_half_range;
+      DrawBaseMap(x, y, curr_base_x_, curr_base_y_);
+    }
     base_img_.copyTo(curr_img_);
   } else {
     base_img_.copyTo(curr_img_);
@@ -107,6 +110,17 @@ void SemanticMap::RunCurrFrame(
   }
 }
 
+bool SemanticMap::KeepBaseMap(const cv::Mat& img, const double x,
+                              const double y, const double base_x,
+                              const double base_y) const {
+  if (img.empty() || FLAGS_base_image_redraw_distance <= 0.0) {
+    return false;
+  }
+  return std::hypot(x - base_x - FLAGS_base_image_half_range,
+                    y - base_y - FLAGS_base_image_half_range) <
+         FLAGS_base_image_redraw_distance;
+}
+
 void SemanticMap::DrawBaseMap(const double x, const double y,
                               const double base_x, const double base_y) {
   base_img_ = cv::Mat(2000, 2000, CV_8UC3, cv::Scalar(0, 0, 0));
@@ -121,6 +135,9 @@ void SemanticMap::DrawBaseMapThread() {
   std::lock_guard<std::mutex> lock(draw_base_map_thread_mutex_);
   double x = ego_feature_.position().x();
   double y = ego_feature_.position().y();
+  if (KeepBaseMap(base_img_, x, y, base_x_, base_y_)) {
+    return;
+  }
   base_x_ = x - FLAGS_base_image_half_range;
   base_y_ = y - FLAGS_base_image_half_range;
   DrawBaseMap(x, y, base_x_, base_y_);
@@ -283,7 +300,7 @@ cv::Scalar SemanticMap::HSVtoRGB(double H, double S, double V) {
 
 void SemanticMap::DrawRect(const Feature& feature, const cv::Scalar& color,
                            const double base_x, const double base_y,
-                           cv::Mat* img) {
+                           cv::Mat* img, const cv::Point2i& offset) {
   double obs_l = feature.length();
   double obs_w = feature.width();
   double obs_x = feature.position().x();
@@ -308,36 +325,37 @@ void SemanticMap::DrawRect(const Feature& feature, const cv::Scalar& color,
       obs_x + (cos(theta) * obs_l - sin(theta) * -obs_w) / 2,
       obs_y + (sin(theta) * obs_l + cos(theta) * -obs_w) / 2, base_x, base_y)));
   cv::fillPoly(*img, std::vector<std::vector<cv::Point>>({std::move(polygon)}),
-               color);
+               color, cv::LINE_8, 0, offset);
 }
 
 void SemanticMap::DrawPoly(const Feature& feature, const cv::Scalar& color,
                            const double base_x, const double base_y,
-                           cv::Mat* img) {
+                           cv::Mat* img, const cv::Point2i& offset) {
   std::vector<cv::Point> polygon;
   for (auto& polygon_point : feature.polygon_point()) {
     polygon.push_back(std::move(
         GetTransPoint(polygon_point.x(), polygon_point.y(), base_x, base_y)));
   }
   cv::fillPoly(*img, std::vector<std::vector<cv::Point>>({std::move(polygon)}),
-               color);
+               color, cv::LINE_8, 0, offset);
 }
 
 void SemanticMap::DrawHistory(const ObstacleHistory& history,
                               const cv::Scalar& color, const double base_x,
-                              const double base_y, cv::Mat* img) {
+                              const double base_y, cv::Mat* img,
+                              const cv::Point2i& offset) {
   for (int i = history.feature_size() - 1; i >= 0; --i) {
     const Feature& feature = history.feature(i);
     double time_decay = 1.0 - ego_feature_.timestamp() + feature.timestamp();
     cv::Scalar decay_color = color * time_decay;
     if (feature.id() == FLAGS_ego_vehicle_id) {
-      DrawRect(feature, decay_color, base_x, base_y, img);
+      DrawRect(feature, decay_color, base_x, base_y, img, offset);
     } else {
       if (feature.polygon_point_size() == 0) {
         AERROR << "No polygon points in feature, please check!";
         continue;
       }
-      DrawPoly(feature, decay_color, base_x, base_y, img);
+      DrawPoly(feature, decay_color, base_x, base_y, img, offset);
     }
   }
 }
@@ -345,25 +363,38 @@ void SemanticMap::DrawHistory(const ObstacleHistory& history,
 cv::Mat SemanticMap::CropArea(const cv::Mat& input_img,
                               const cv::Point2i& center_point,
                               const double heading) {
+  // Rotate around the center, cut the 400x400 area and scale it to 224x224
+  // in a single warp of the output pixels only.
   cv::Mat rotation_mat =
       cv::getRotationMatrix2D(center_point, 90.0 - heading * 180.0 / M_PI, 1.0);
-  cv::Mat rotated_mat;
-  cv::warpAffine(input_img, rotated_mat, rotation_mat, input_img.size());
-  cv::Rect rect(center_point.x - 200, center_point.y - 300, 400, 400);
+  rotation_mat.at<double>(0, 2) -= center_point.x - 200;
+  rotation_mat.at<double>(1, 2) -= center_point.y - 300;
+  rotation_mat *= 224.0 / 400.0;
   cv::Mat output_img;
-  cv::resize(rotated_mat(rect), output_img, cv::Size(224, 224));
+  cv::warpAffine(input_img, output_img, rotation_mat, cv::Size(224, 224));
   return output_img;
 }
 
 cv::Mat SemanticMap::CropByHistory(const ObstacleHistory& history,
                                    const cv::Scalar& color, const double base_x,
                                    const double base_y) {
-  cv::Mat feature_map = curr_img_.clone();
-  DrawHistory(history, color, base_x, base_y, &feature_map);
   const Feature& curr_feature = history.feature(0);
   const cv::Point2i& center_point = GetTransPoint(
       curr_feature.position().x(), curr_feature.position().y(), base_x, base_y);
-  return CropArea(feature_map, center_point, curr_feature.theta());
+  // Only the area the rotated crop can reach is copied and drawn on, the
+  // farthest corner of the crop is sqrt(200^2 + 300^2) < 361 pixels away.
+  constexpr int kCropRadius = 361;
+  const cv::Rect area =
+      cv::Rect(center_point.x - kCropRadius, center_point.y - kCropRadius,
+               2 * kCropRadius + 1, 2 * kCropRadius + 1) &
+      cv::Rect(0, 0, curr_img_.cols, curr_img_.rows);
+  if (area.empty()) {
+    return cv::Mat(224, 224, curr_img_.type(), cv::Scalar(0, 0, 0));
+  }
+  cv::Mat feature_map = curr_img_(area).clone();
+  const cv::Point2i offset(-area.x, -area.y);
+  DrawHistory(history, color, base_x, base_y, &feature_map, offset);
+  return CropArea(feature_map, center_point + offset, curr_feature.theta());
 }
 
 bool SemanticMap::GetMapById(const int obstacle_id, cv::Mat* feature_map) {
@@ -377,10 +408,9 @@ bool SemanticMap::GetMapById(const int obstacle_id, cv::Mat* feature_map) {
     return false;
   }
 
-  cv::Mat output_img =
-      CropByHistory(obstacle_id_history_map_[obstacle_id],
-                    cv::Scalar(0, 0, 255), curr_base_x_, curr_base_y_);
-  output_img.copyTo(*feature_map);
+  *feature_map = CropByHistory(obstacle_id_history_map_[obstacle_id],
+                               cv::Scalar(0, 0, 255), curr_base_x_,
+                               curr_base_y_);
   return true;
 }
 
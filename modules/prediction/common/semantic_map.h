@@ -70,14 +70,23 @@ class SemanticMap {
 
   cv::Scalar HSVtoRGB(double H = 1.0, double S = 1.0, double V = 1.0);
 
+  // If the base image centered at base_x and base_y can be kept for the
+  // ego vehicle at x and y
+  bool KeepBaseMap(const cv::Mat& img, const double x, const double y,
+                   const double base_x, const double base_y) const;
+
+  // Points are shifted by offset, to draw on an area cut from the full image
   void DrawRect(const Feature& feature, const cv::Scalar& color,
-                const double base_x, const double base_y, cv::Mat* img);
+                const double base_x, const double base_y, cv::Mat* img,
+                const cv::Point2i& offset = cv::Point2i());
 
   void DrawPoly(const Feature& feature, const cv::Scalar& color,
-                const double base_x, const double base_y, cv::Mat* img);
+                const double base_x, const double base_y, cv::Mat* img,
+                const cv::Point2i& offset = cv::Point2i());
 
   void DrawHistory(const ObstacleHistory& history, const cv::Scalar& color,
-                   const double base_x, const double base_y, cv::Mat* img);
+                   const double base_x, const double base_y, cv::Mat* img,
+                   const cv::Point2i& offset = cv::Point2i());
 
   cv::Mat CropArea(const cv::Mat& input_img, const cv::Point2i& center_point,
                    const double heading);
@@ -34,13 +34,22 @@ ADCTrajectoryContainer::ADCTrajectoryContainer()
 
 void ADCTrajectoryContainer::Insert(
     const ::google::protobuf::Message& message) {
+  const ADCTrajectory& adc_trajectory =
+      dynamic_cast<const ADCTrajectory&>(message);
+  adc_junction_polygon_ = std::move(Polygon2d());
+  // The latest planning message is inserted every prediction frame, the lane
+  // sequences only need to be found again for a new one.
+  if (IsLatestTrajectory(adc_trajectory)) {
+    ADEBUG << "Planning message [" << adc_trajectory.header().sequence_num()
+           << "] is already inserted.";
+    return;
+  }
   adc_lane_ids_.clear();
   adc_lane_seq_.clear();
   adc_target_lane_ids_.clear();
   adc_target_lane_seq_.clear();
-  adc_junction_polygon_ = std::move(Polygon2d());
 
-  adc_trajectory_.CopyFrom(dynamic_cast<const ADCTrajectory&>(message));
+  adc_trajectory_.CopyFrom(adc_trajectory);
   ADEBUG << "Received a planning message ["
          << adc_trajectory_.ShortDebugString() << "].";
 
@@ -55,6 +64,18 @@ void ADCTrajectoryContainer::Insert(
          << ToString(adc_target_lane_seq_) << "].";
 }
 
+bool ADCTrajectoryContainer::IsLatestTrajectory(
+    const ADCTrajectory& adc_trajectory) const {
+  if (!adc_trajectory.header().has_sequence_num() ||
+      !adc_trajectory_.header().has_sequence_num()) {
+    return false;
+  }
+  return adc_trajectory.header().sequence_num() ==
+             adc_trajectory_.header().sequence_num() &&
+         adc_trajectory.header().timestamp_sec() ==
+             adc_trajectory_.header().timestamp_sec();
+}
+
 bool ADCTrajectoryContainer::IsPointInJunction(const PathPoint& point) const {
   if (adc_junction_polygon_.points().size() < 3) {
     return false;
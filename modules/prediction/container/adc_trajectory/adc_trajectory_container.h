@@ -109,6 +109,8 @@ class ADCTrajectoryContainer : public Container {
   void SetJunction(const std::string& junction_id, const double distance);
 
  private:
+  bool IsLatestTrajectory(const planning::ADCTrajectory& adc_trajectory) const;
+
   void SetJunctionPolygon();
 
   void SetLaneSequence();
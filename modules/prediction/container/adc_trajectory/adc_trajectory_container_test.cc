@@ -84,5 +84,23 @@ TEST_F(ADCTrajectoryTest, InsertionWithoutProtection) {
   EXPECT_FALSE(container_.IsProtected());
 }
 
+TEST_F(ADCTrajectoryTest, InsertionOfLatestTrajectory) {
+  trajectory_.mutable_header()->set_sequence_num(1);
+  trajectory_.mutable_header()->set_timestamp_sec(1.0);
+  trajectory_.set_right_of_way_status(ADCTrajectory::PROTECTED);
+  container_.Insert(trajectory_);
+  EXPECT_TRUE(container_.IsProtected());
+
+  // the same planning message is not inserted again
+  ADCTrajectory same_trajectory = trajectory_;
+  same_trajectory.set_right_of_way_status(ADCTrajectory::UNPROTECTED);
+  container_.Insert(same_trajectory);
+  EXPECT_TRUE(container_.IsProtected());
+
+  same_trajectory.mutable_header()->set_sequence_num(2);
+  container_.Insert(same_trajectory);
+  EXPECT_FALSE(container_.IsProtected());
+}
+
 }  // namespace prediction
 }  // namespace apollo
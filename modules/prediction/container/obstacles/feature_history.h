@@ -0,0 +1,124 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Feature history of an obstacle, stored in a ring of reused messages
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "modules/prediction/proto/feature.pb.h"
+
+namespace apollo {
+namespace prediction {
+
+/**
+ * @brief Features of an obstacle from the latest to the earliest. New
+ *        features are written into the slot of a discarded one, Clear() keeps
+ *        the memory of its sub-messages and repeated fields, so steady state
+ *        frames neither allocate nor destroy protobuf messages.
+ */
+class FeatureHistory {
+ public:
+  FeatureHistory() = default;
+
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  /**
+   * @brief Feature of the given index, 0 is the latest
+   */
+  const Feature& operator[](const size_t i) const { return slots_[Slot(i)]; }
+  Feature& operator[](const size_t i) { return slots_[Slot(i)]; }
+
+  const Feature& front() const { return (*this)[0]; }
+  Feature& front() { return (*this)[0]; }
+  const Feature& back() const { return (*this)[size_ - 1]; }
+  Feature& back() { return (*this)[size_ - 1]; }
+
+  /**
+   * @brief Cleared slot of the next latest feature. The current features are
+   *        unchanged until it is added by PushFront.
+   */
+  Feature* NextFront() {
+    if (size_ == slots_.size()) {
+      Grow();
+    }
+    Feature* feature = &slots_[Slot(slots_.size() - 1)];
+    feature->Clear();
+    return feature;
+  }
+
+  /**
+   * @brief Add the slot returned by NextFront as the latest feature
+   */
+  void PushFront() {
+    head_ = Slot(slots_.size() - 1);
+    ++size_;
+  }
+
+  /**
+   * @brief Add a copy of the feature as the latest one
+   */
+  void PushFront(const Feature& feature) {
+    NextFront()->CopyFrom(feature);
+    PushFront();
+  }
+
+  /**
+   * @brief Discard the earliest feature, its slot is kept for reuse
+   */
+  void PopBack() { --size_; }
+
+  /**
+   * @brief Keep the latest features only
+   */
+  void Truncate(const size_t size) {
+    if (size < size_) {
+      size_ = size;
+    }
+  }
+
+ private:
+  static constexpr size_t kInitialCapacity = 8;
+
+  size_t Slot(const size_t i) const {
+    const size_t slot = head_ + i;
+    return slot < slots_.size() ? slot : slot - slots_.size();
+  }
+
+  void Grow() {
+    std::vector<Feature> slots(slots_.empty() ? kInitialCapacity
+                                              : slots_.size() * 2);
+    for (size_t i = 0; i < size_; ++i) {
+      slots[i].Swap(&(*this)[i]);
+    }
+    slots_.swap(slots);
+    head_ = 0;
+  }
+
+  std::vector<Feature> slots_;
+  // slot of the latest feature
+  size_t head_ = 0;
+  size_t size_ = 0;
+};
+
+}  // namespace prediction
+}  // namespace apollo
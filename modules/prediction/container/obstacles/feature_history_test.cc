@@ -0,0 +1,90 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/prediction/container/obstacles/feature_history.h"
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace prediction {
+
+namespace {
+
+void PushFeature(const double timestamp, FeatureHistory* history) {
+  Feature* feature = history->NextFront();
+  feature->set_timestamp(timestamp);
+  history->PushFront();
+}
+
+}  // namespace
+
+TEST(FeatureHistoryTest, PushAndPop) {
+  FeatureHistory history;
+  EXPECT_TRUE(history.empty());
+  for (int i = 0; i < 20; ++i) {
+    PushFeature(static_cast<double>(i), &history);
+  }
+  EXPECT_EQ(history.size(), 20);
+  EXPECT_DOUBLE_EQ(history.front().timestamp(), 19.0);
+  EXPECT_DOUBLE_EQ(history.back().timestamp(), 0.0);
+  for (size_t i = 0; i < history.size(); ++i) {
+    EXPECT_DOUBLE_EQ(history[i].timestamp(), 19.0 - static_cast<double>(i));
+  }
+
+  history.PopBack();
+  history.PopBack();
+  EXPECT_EQ(history.size(), 18);
+  EXPECT_DOUBLE_EQ(history.back().timestamp(), 2.0);
+
+  history.Truncate(5);
+  EXPECT_EQ(history.size(), 5);
+  EXPECT_DOUBLE_EQ(history.back().timestamp(), 15.0);
+  history.Truncate(10);
+  EXPECT_EQ(history.size(), 5);
+}
+
+TEST(FeatureHistoryTest, ReuseSlots) {
+  FeatureHistory history;
+  Feature feature;
+  feature.set_id(1);
+  feature.set_timestamp(0.0);
+  feature.mutable_position()->set_x(1.0);
+  history.PushFront(feature);
+
+  // the next slot is cleared and the latest feature is unchanged
+  Feature* next = history.NextFront();
+  EXPECT_FALSE(next->has_id());
+  EXPECT_EQ(history.size(), 1);
+  EXPECT_EQ(history.front().id(), 1);
+  next->set_timestamp(0.1);
+  history.PushFront();
+  EXPECT_EQ(history.size(), 2);
+  EXPECT_DOUBLE_EQ(history.front().timestamp(), 0.1);
+  EXPECT_DOUBLE_EQ(history.back().position().x(), 1.0);
+
+  // slots of discarded features are cleared before being reused
+  for (int i = 0; i < 100; ++i) {
+    PushFeature(1.0 + i, &history);
+    history.PopBack();
+  }
+  EXPECT_EQ(history.size(), 2);
+  EXPECT_DOUBLE_EQ(history.front().timestamp(), 100.0);
+  EXPECT_DOUBLE_EQ(history.back().timestamp(), 99.0);
+  EXPECT_FALSE(history.back().has_position());
+}
+
+}  // namespace prediction
+}  // namespace apollo
@@ -154,7 +154,9 @@ bool Obstacle::Insert(const PerceptionObstacle& perception_obstacle,
   }
 
   // Set ID, Type, and Status of the feature.
-  Feature feature;
+  // The feature is written into the slot of a discarded frame, the latest
+  // frame stays readable as the previous one until it is inserted.
+  Feature& feature = *feature_history_.NextFront();
   if (!SetId(perception_obstacle, &feature, prediction_obstacle_id)) {
     return false;
   }
@@ -180,7 +182,9 @@ bool Obstacle::Insert(const PerceptionObstacle& perception_obstacle,
   }
 
   // Insert obstacle feature to history
-  InsertFeatureToHistory(feature);
+  feature_history_.PushFront();
+  ADEBUG << "Obstacle [" << id_ << "] inserted a frame into the history.";
+  degraded_ = false;
 
   // Set obstacle motion status
   if (FLAGS_use_navigation_mode) {
@@ -215,7 +219,7 @@ void Obstacle::ClearOldInformation() {
 
 void Obstacle::TrimHistory(const size_t remain_size) {
   if (feature_history_.size() > remain_size) {
-    feature_history_.resize(remain_size);
+    feature_history_.Truncate(remain_size);
   }
 }
 
@@ -1338,14 +1342,12 @@ void Obstacle::SetMotionStatus() {
   len = std::max(len, FLAGS_min_still_obstacle_history_length);
   CHECK_GT(len, 1);
 
-  auto feature_riter = feature_history_.rbegin();
-  start_x = feature_riter->position().x();
-  start_y = feature_riter->position().y();
-  ++feature_riter;
-  while (feature_riter != feature_history_.rend()) {
-    avg_drift_x += (feature_riter->position().x() - start_x) / (len - 1);
-    avg_drift_y += (feature_riter->position().y() - start_y) / (len - 1);
-    ++feature_riter;
+  start_x = feature_history_.back().position().x();
+  start_y = feature_history_.back().position().y();
+  for (size_t i = feature_history_.size() - 1; i > 0; --i) {
+    const Feature& feature = feature_history_[i - 1];
+    avg_drift_x += (feature.position().x() - start_x) / (len - 1);
+    avg_drift_y += (feature.position().y() - start_y) / (len - 1);
   }
 
   double delta_ts = feature_history_.front().timestamp() -
@@ -1397,7 +1399,7 @@ void Obstacle::SetMotionStatusBySpeed() {
 }
 
 void Obstacle::InsertFeatureToHistory(const Feature& feature) {
-  feature_history_.emplace_front(feature);
+  feature_history_.PushFront(feature);
   ADEBUG << "Obstacle [" << id_ << "] inserted a frame into the history.";
 }
 
@@ -1433,7 +1435,7 @@ void Obstacle::DiscardOutdatedHistory() {
   const double latest_ts = feature_history_.front().timestamp();
   while (latest_ts - feature_history_.back().timestamp() >=
          FLAGS_max_history_time) {
-    feature_history_.pop_back();
+    feature_history_.PopBack();
   }
   auto num_of_discarded_frames = num_of_frames - feature_history_.size();
   if (num_of_discarded_frames > 0) {
@@ -1456,6 +1458,10 @@ bool Obstacle::IsCaution() const {
   return feature.priority().priority() == ObstaclePriority::CAUTION;
 }
 
+void Obstacle::SetDegraded() { degraded_ = true; }
+
+bool Obstacle::IsDegraded() const { return degraded_; }
+
 void Obstacle::SetEvaluatorType(
     const ObstacleConf::EvaluatorType& evaluator_type) {
   obstacle_conf_.set_evaluator_type(evaluator_type);
@@ -21,7 +21,6 @@
 
 #pragma once
 
-#include <deque>
 #include <list>
 #include <memory>
 #include <string>
@@ -33,6 +32,7 @@
 #include "modules/map/hdmap/hdmap_common.h"
 #include "modules/prediction/common/junction_analyzer.h"
 #include "modules/prediction/common/prediction_gflags.h"
+#include "modules/prediction/container/obstacles/feature_history.h"
 #include "modules/prediction/container/obstacles/obstacle_clusters.h"
 #include "modules/prediction/proto/feature.pb.h"
 #include "modules/prediction/proto/prediction_conf.pb.h"
@@ -228,6 +228,18 @@ class Obstacle {
 
   bool IsCaution() const;
 
+  /**
+   * @brief Mark that the evaluation of the current frame is skipped to keep
+   *        the frame in its time budget
+   */
+  void SetDegraded();
+
+  /**
+   * @brief If the evaluation of the current frame is skipped, so the obstacle
+   *        is predicted by a fast predictor
+   */
+  bool IsDegraded() const;
+
   void SetEvaluatorType(const ObstacleConf::EvaluatorType& evaluator_type);
 
   void SetPredictorType(const ObstacleConf::PredictorType& predictor_type);
@@ -331,12 +343,15 @@ class Obstacle {
   perception::PerceptionObstacle::Type type_ =
       perception::PerceptionObstacle::UNKNOWN_UNMOVABLE;
 
-  std::deque<Feature> feature_history_;
+  FeatureHistory feature_history_;
 
   std::vector<std::shared_ptr<const hdmap::LaneInfo>> current_lanes_;
 
   ObstacleConf obstacle_conf_;
 
+  // reset by each new frame
+  bool degraded_ = false;
+
   ObstacleClusters* clusters_ptr_ = nullptr;
   JunctionAnalyzer* junction_analyzer_ = nullptr;
 };
@@ -28,9 +28,7 @@ using apollo::perception::PerceptionObstacle;
 using Point = apollo::common::Point3D;
 
 void PoseContainer::Insert(const ::google::protobuf::Message& message) {
-  localization::LocalizationEstimate localization;
-  localization.CopyFrom(dynamic_cast<const LocalizationEstimate&>(message));
-  Update(localization);
+  Update(dynamic_cast<const LocalizationEstimate&>(message));
 }
 
 void PoseContainer::Update(
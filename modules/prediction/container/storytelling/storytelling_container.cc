@@ -22,7 +22,7 @@ namespace prediction {
 using apollo::storytelling::Stories;
 
 void StoryTellingContainer::Insert(const ::google::protobuf::Message& message) {
-  Stories story_message = dynamic_cast<const Stories&>(message);
+  const Stories& story_message = dynamic_cast<const Stories&>(message);
   close_to_junction_.CopyFrom(story_message.close_to_junction());
 }
 
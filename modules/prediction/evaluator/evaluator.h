@@ -71,6 +71,22 @@ class Evaluator {
     return Evaluate(obstacle, obstacles_container);
   }
 
+  /**
+   * @brief Evaluate obstacles together, so that a model runs once for all of
+   *        them. Evaluates them one by one unless overridden.
+   * @param Obstacle pointers
+   * @param Obstacles container
+   * @param If each obstacle is evaluated successfully
+   */
+  virtual void EvaluateBatch(const std::vector<Obstacle*>& obstacles,
+                             ObstaclesContainer* obstacles_container,
+                             std::vector<bool>* evaluated) {
+    evaluated->clear();
+    for (Obstacle* obstacle : obstacles) {
+      evaluated->push_back(Evaluate(obstacle, obstacles_container));
+    }
+  }
+
   /**
    * @brief Get the name of evaluator
    */
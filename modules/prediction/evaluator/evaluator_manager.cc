@@ -44,6 +44,13 @@ using IdObstacleListMap = std::unordered_map<int, std::list<Obstacle*>>;
 
 namespace {
 
+// Caution vehicles try their caution evaluator first, and are downgraded to
+// the normal one if it fails.
+bool UseCautionEvaluator(const Obstacle* obstacle) {
+  return obstacle->type() == PerceptionObstacle::VEHICLE &&
+         obstacle->IsCaution() && !obstacle->IsSlow();
+}
+
 bool IsTrainable(const Feature& feature) {
   if (feature.id() == FLAGS_ego_vehicle_id) {
     return false;
@@ -190,7 +197,8 @@ Evaluator* EvaluatorManager::GetEvaluator(
   return it != evaluators_.end() ? it->second.get() : nullptr;
 }
 
-void EvaluatorManager::Run(ObstaclesContainer* obstacles_container) {
+bool EvaluatorManager::PrepareFrame(ObstaclesContainer* obstacles_container) {
+  frame_start_time_ = std::chrono::steady_clock::now();
   if (FLAGS_enable_semantic_map ||
       FLAGS_prediction_offline_mode == PredictionConstants::kDumpFrameEnv) {
     size_t max_num_frame = 10;
@@ -200,14 +208,37 @@ void EvaluatorManager::Run(ObstaclesContainer* obstacles_container) {
     BuildObstacleIdHistoryMap(obstacles_container, max_num_frame);
     DumpCurrentFrameEnv(obstacles_container);
     if (FLAGS_prediction_offline_mode == PredictionConstants::kDumpFrameEnv) {
-      return;
+      return false;
     }
     semantic_map_->RunCurrFrame(obstacle_id_history_map_);
   }
+  return true;
+}
+
+void EvaluatorManager::Run(ObstaclesContainer* obstacles_container) {
+  if (!PrepareFrame(obstacles_container)) {
+    return;
+  }
 
   std::vector<Obstacle*> dynamic_env;
 
-  if (FLAGS_enable_multi_thread) {
+  if (FLAGS_enable_batch_evaluation) {
+    std::vector<Obstacle*> obstacles;
+    for (int id : obstacles_container->curr_frame_considered_obstacle_ids()) {
+      Obstacle* obstacle = obstacles_container->GetObstacle(id);
+      if (obstacle == nullptr || obstacle->IsStill()) {
+        continue;
+      }
+      obstacles.push_back(obstacle);
+    }
+    std::vector<Obstacle*> failed_caution_obstacles;
+    EvaluateBatches(obstacles, true, obstacles_container,
+                    &failed_caution_obstacles);
+    if (!failed_caution_obstacles.empty()) {
+      EvaluateBatches(failed_caution_obstacles, false, obstacles_container,
+                      nullptr);
+    }
+  } else if (FLAGS_enable_multi_thread) {
     IdObstacleListMap id_obstacle_map;
     GroupObstaclesByObstacleIds(obstacles_container, &id_obstacle_map);
     PredictionThreadPool::ForEach(
@@ -218,6 +249,7 @@ void EvaluatorManager::Run(ObstaclesContainer* obstacles_container) {
           }
         });
   } else {
+    std::vector<Obstacle*> obstacles;
     for (int id : obstacles_container->curr_frame_considered_obstacle_ids()) {
       Obstacle* obstacle = obstacles_container->GetObstacle(id);
 
@@ -228,7 +260,15 @@ void EvaluatorManager::Run(ObstaclesContainer* obstacles_container) {
         ADEBUG << "Ignore still obstacle [" << id << "] in evaluator_manager";
         continue;
       }
-
+      obstacles.push_back(obstacle);
+    }
+    if (FLAGS_prediction_time_budget > 0.0) {
+      // Caution obstacles get the time budget first.
+      std::stable_partition(
+          obstacles.begin(), obstacles.end(),
+          [](const Obstacle* obstacle) { return obstacle->IsCaution(); });
+    }
+    for (Obstacle* obstacle : obstacles) {
       EvaluateObstacle(obstacle, obstacles_container, dynamic_env);
     }
   }
@@ -237,11 +277,35 @@ void EvaluatorManager::Run(ObstaclesContainer* obstacles_container) {
 void EvaluatorManager::EvaluateObstacle(Obstacle* obstacle,
                                         ObstaclesContainer* obstacles_container,
                                         std::vector<Obstacle*> dynamic_env) {
+  Evaluator* evaluator = SelectEvaluator(obstacle, true);
+  if (evaluator == nullptr) {
+    return;
+  }
+  if (OverTimeBudget(evaluator)) {
+    ADEBUG << "Obstacle [" << obstacle->id() << "] skips "
+           << evaluator->GetName() << " over the time budget.";
+    obstacle->SetDegraded();
+    return;
+  }
+  if (evaluator->Evaluate(obstacle, obstacles_container, dynamic_env) ||
+      !UseCautionEvaluator(obstacle)) {
+    return;
+  }
+  AERROR << "Obstacle: " << obstacle->id()
+         << " caution evaluator failed, downgrade to normal level!";
+  evaluator = SelectEvaluator(obstacle, false);
+  if (evaluator != nullptr) {
+    evaluator->Evaluate(obstacle, obstacles_container, dynamic_env);
+  }
+}
+
+Evaluator* EvaluatorManager::SelectEvaluator(Obstacle* obstacle,
+                                             bool use_caution_evaluator) {
   Evaluator* evaluator = nullptr;
   // Select different evaluators depending on the obstacle's type.
   switch (obstacle->type()) {
     case PerceptionObstacle::VEHICLE: {
-      if (obstacle->IsCaution() && !obstacle->IsSlow()) {
+      if (use_caution_evaluator && UseCautionEvaluator(obstacle)) {
         if (obstacle->IsNearJunction()) {
           evaluator = GetEvaluator(vehicle_in_junction_caution_evaluator_);
         } else if (obstacle->IsOnLane()) {
@@ -250,13 +314,7 @@ void EvaluatorManager::EvaluateObstacle(Obstacle* obstacle,
           evaluator = GetEvaluator(vehicle_default_caution_evaluator_);
         }
         CHECK_NOTNULL(evaluator);
-        // Evaluate and break if success
-        if (evaluator->Evaluate(obstacle, obstacles_container)) {
-          break;
-        } else {
-          AERROR << "Obstacle: " << obstacle->id()
-                 << " caution evaluator failed, downgrade to normal level!";
-        }
+        break;
       }
       // if obstacle is not caution or caution_evaluator run failed
       if (obstacle->HasJunctionFeatureWithExits() &&
@@ -270,18 +328,12 @@ void EvaluatorManager::EvaluateObstacle(Obstacle* obstacle,
         break;
       }
       CHECK_NOTNULL(evaluator);
-      if (evaluator->GetName() == "LANE_SCANNING_EVALUATOR") {
-        evaluator->Evaluate(obstacle, obstacles_container, dynamic_env);
-      } else {
-        evaluator->Evaluate(obstacle, obstacles_container);
-      }
       break;
     }
     case PerceptionObstacle::BICYCLE: {
       if (obstacle->IsOnLane()) {
         evaluator = GetEvaluator(cyclist_on_lane_evaluator_);
         CHECK_NOTNULL(evaluator);
-        evaluator->Evaluate(obstacle, obstacles_container);
       }
       break;
     }
@@ -292,7 +344,6 @@ void EvaluatorManager::EvaluateObstacle(Obstacle* obstacle,
               ObstaclePriority::CAUTION) {
         evaluator = GetEvaluator(pedestrian_evaluator_);
         CHECK_NOTNULL(evaluator);
-        evaluator->Evaluate(obstacle, obstacles_container);
         break;
       }
     }
@@ -300,11 +351,62 @@ void EvaluatorManager::EvaluateObstacle(Obstacle* obstacle,
       if (obstacle->IsOnLane()) {
         evaluator = GetEvaluator(default_on_lane_evaluator_);
         CHECK_NOTNULL(evaluator);
-        evaluator->Evaluate(obstacle, obstacles_container);
       }
       break;
     }
   }
+  return evaluator;
+}
+
+bool EvaluatorManager::OverTimeBudget(Evaluator* evaluator) {
+  if (FLAGS_prediction_time_budget <= 0.0 ||
+      (evaluator != GetEvaluator(ObstacleConf::SEMANTIC_LSTM_EVALUATOR) &&
+       evaluator != GetEvaluator(ObstacleConf::JUNCTION_MAP_EVALUATOR))) {
+    return false;
+  }
+  const std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - frame_start_time_;
+  return elapsed.count() > FLAGS_prediction_time_budget;
+}
+
+void EvaluatorManager::EvaluateBatches(
+    const std::vector<Obstacle*>& obstacles, bool use_caution_evaluator,
+    ObstaclesContainer* obstacles_container,
+    std::vector<Obstacle*>* failed_caution_obstacles) {
+  for (auto& batch : evaluator_batches_) {
+    batch.second.clear();
+  }
+  for (Obstacle* obstacle : obstacles) {
+    Evaluator* evaluator = SelectEvaluator(obstacle, use_caution_evaluator);
+    if (evaluator != nullptr) {
+      evaluator_batches_[evaluator].push_back(obstacle);
+    }
+  }
+
+  std::vector<bool> evaluated;
+  for (const auto& batch : evaluator_batches_) {
+    if (batch.second.empty()) {
+      continue;
+    }
+    if (OverTimeBudget(batch.first)) {
+      for (Obstacle* obstacle : batch.second) {
+        obstacle->SetDegraded();
+      }
+      continue;
+    }
+    batch.first->EvaluateBatch(batch.second, obstacles_container, &evaluated);
+    if (failed_caution_obstacles == nullptr) {
+      continue;
+    }
+    for (size_t i = 0; i < batch.second.size(); ++i) {
+      Obstacle* obstacle = batch.second[i];
+      if (!evaluated[i] && UseCautionEvaluator(obstacle)) {
+        AERROR << "Obstacle: " << obstacle->id()
+               << " caution evaluator failed, downgrade to normal level!";
+        failed_caution_obstacles->push_back(obstacle);
+      }
+    }
+  }
 }
 
 void EvaluatorManager::EvaluateObstacle(
@@ -21,6 +21,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <list>
 #include <map>
 #include <memory>
@@ -68,6 +69,13 @@ class EvaluatorManager {
    */
   void Run(ObstaclesContainer* obstacles_container);
 
+  /**
+   * @brief Build the semantic map of the frame, must be called before
+   *        evaluating obstacles one by one
+   * @return False if the frame is only dumped and not evaluated
+   */
+  bool PrepareFrame(ObstaclesContainer* obstacles_container);
+
   void EvaluateObstacle(Obstacle* obstacle,
                         ObstaclesContainer* obstacles_container,
                         std::vector<Obstacle*> dynamic_env);
@@ -81,6 +89,33 @@ class EvaluatorManager {
 
   void DumpCurrentFrameEnv(ObstaclesContainer* obstacles_container);
 
+  /**
+   * @brief Select the evaluator of an obstacle
+   * @param Obstacle pointer
+   * @param If the caution evaluators can be selected
+   * @return The evaluator, nullptr if the obstacle is not evaluated
+   */
+  Evaluator* SelectEvaluator(Obstacle* obstacle, bool use_caution_evaluator);
+
+  /**
+   * @brief If the evaluator runs on the semantic map and the time budget of
+   *        the frame is used up
+   * @param Evaluator pointer
+   */
+  bool OverTimeBudget(Evaluator* evaluator);
+
+  /**
+   * @brief Evaluate the obstacles sharing an evaluator in one batch
+   * @param Obstacle pointers
+   * @param If the caution evaluators can be selected
+   * @param Obstacles container
+   * @param Caution obstacles whose caution evaluator failed
+   */
+  void EvaluateBatches(const std::vector<Obstacle*>& obstacles,
+                       bool use_caution_evaluator,
+                       ObstaclesContainer* obstacles_container,
+                       std::vector<Obstacle*>* failed_caution_obstacles);
+
   /**
    * @brief Register an evaluator by type
    * @param Evaluator type
@@ -129,7 +164,12 @@ class EvaluatorManager {
 
   std::unordered_map<int, ObstacleHistory> obstacle_id_history_map_;
 
+  // obstacles of each evaluator in batch evaluation
+  std::unordered_map<Evaluator*, std::vector<Obstacle*>> evaluator_batches_;
+
   std::unique_ptr<SemanticMap> semantic_map_;
+
+  std::chrono::steady_clock::time_point frame_start_time_;
 };
 
 }  // namespace prediction
@@ -48,15 +48,46 @@ CruiseMLPEvaluator::CruiseMLPEvaluator() : device_(torch::kCPU) {
   LoadModels();
 }
 
-void CruiseMLPEvaluator::Clear() {}
+void CruiseMLPEvaluator::ModelRows::Clear() {
+  go_inputs.clear();
+  go_lane_sequences.clear();
+  cutin_inputs.clear();
+  cutin_lane_sequences.clear();
+}
+
+void CruiseMLPEvaluator::Clear() { batch_rows_.Clear(); }
 
 bool CruiseMLPEvaluator::Evaluate(Obstacle* obstacle_ptr,
                                   ObstaclesContainer* obstacles_container) {
   // Sanity checks.
   omp_set_num_threads(1);
+  // Local rows, obstacles may be evaluated in parallel.
+  ModelRows rows;
+  if (!CollectLaneSequences(obstacle_ptr, obstacles_container, &rows)) {
+    return false;
+  }
+  RunModels(rows);
+  return true;
+}
+
+void CruiseMLPEvaluator::EvaluateBatch(
+    const std::vector<Obstacle*>& obstacles,
+    ObstaclesContainer* obstacles_container, std::vector<bool>* evaluated) {
+  omp_set_num_threads(1);
   Clear();
-  CHECK_NOTNULL(obstacle_ptr);
+  evaluated->clear();
+  // The lane sequences of all obstacles go through each model at once.
+  for (Obstacle* obstacle_ptr : obstacles) {
+    evaluated->push_back(
+        CollectLaneSequences(obstacle_ptr, obstacles_container, &batch_rows_));
+  }
+  RunModels(batch_rows_);
+}
 
+bool CruiseMLPEvaluator::CollectLaneSequences(
+    Obstacle* obstacle_ptr, ObstaclesContainer* obstacles_container,
+    ModelRows* rows) {
+  CHECK_NOTNULL(obstacle_ptr);
   obstacle_ptr->SetEvaluatorType(evaluator_type_);
 
   int id = obstacle_ptr->id();
@@ -120,23 +151,25 @@ bool CruiseMLPEvaluator::Evaluate(Obstacle* obstacle_ptr,
       return true;  // Skip Compute probability for offline mode
     }
 
-    std::vector<torch::jit::IValue> torch_inputs;
-    int input_dim = static_cast<int>(
-        OBSTACLE_FEATURE_SIZE + SINGLE_LANE_FEATURE_SIZE * LANE_POINTS_SIZE);
-    torch::Tensor torch_input = torch::zeros({1, input_dim});
-    for (size_t i = 0; i < feature_values.size(); ++i) {
-      torch_input[0][i] = static_cast<float>(feature_values[i]);
-    }
-    torch_inputs.push_back(std::move(torch_input.to(device_)));
     if (lane_sequence_ptr->vehicle_on_lane()) {
-      ModelInference(torch_inputs, torch_go_model_, lane_sequence_ptr);
+      rows->go_inputs.insert(rows->go_inputs.end(), feature_values.begin(),
+                             feature_values.end());
+      rows->go_lane_sequences.push_back(lane_sequence_ptr);
     } else {
-      ModelInference(torch_inputs, torch_cutin_model_, lane_sequence_ptr);
+      rows->cutin_inputs.insert(rows->cutin_inputs.end(),
+                                feature_values.begin(), feature_values.end());
+      rows->cutin_lane_sequences.push_back(lane_sequence_ptr);
     }
   }
   return true;
 }
 
+void CruiseMLPEvaluator::RunModels(const ModelRows& rows) {
+  ModelInference(rows.go_inputs, torch_go_model_, rows.go_lane_sequences);
+  ModelInference(rows.cutin_inputs, torch_cutin_model_,
+                 rows.cutin_lane_sequences);
+}
+
 void CruiseMLPEvaluator::ExtractFeatureValues(
     Obstacle* obstacle_ptr, LaneSequence* lane_sequence_ptr,
     std::vector<double>* feature_values) {
@@ -529,11 +562,17 @@ void CruiseMLPEvaluator::SetLaneFeatureValues(
 }
 
 void CruiseMLPEvaluator::LoadModels() {
+  torch::set_num_threads(1);
   if (FLAGS_use_cuda && torch::cuda::is_available()) {
     ADEBUG << "CUDA is available";
     device_ = torch::Device(torch::kCUDA);
+  } else if (FLAGS_use_quantized_cpu_model) {
+    torch_go_model_ =
+        torch::jit::load(FLAGS_torch_vehicle_cruise_go_quantized_file, device_);
+    torch_cutin_model_ = torch::jit::load(
+        FLAGS_torch_vehicle_cruise_cutin_quantized_file, device_);
+    return;
   }
-  torch::set_num_threads(1);
   torch_go_model_ =
       torch::jit::load(FLAGS_torch_vehicle_cruise_go_file, device_);
   torch_cutin_model_ =
@@ -541,18 +580,33 @@ void CruiseMLPEvaluator::LoadModels() {
 }
 
 void CruiseMLPEvaluator::ModelInference(
-    const std::vector<torch::jit::IValue>& torch_inputs,
-    torch::jit::script::Module torch_model_ptr,
-    LaneSequence* lane_sequence_ptr) {
-  auto torch_output_tuple = torch_model_ptr.forward(torch_inputs).toTuple();
+    const std::vector<float>& inputs, torch::jit::script::Module torch_model,
+    const std::vector<LaneSequence*>& lane_sequences) {
+  if (lane_sequences.empty()) {
+    return;
+  }
+  int input_dim = static_cast<int>(
+      OBSTACLE_FEATURE_SIZE + SINGLE_LANE_FEATURE_SIZE * LANE_POINTS_SIZE);
+  int num_rows = static_cast<int>(lane_sequences.size());
+  CHECK_EQ(inputs.size(), static_cast<size_t>(num_rows * input_dim));
+  // from_blob does not copy, the inputs outlive the forward pass
+  torch::Tensor torch_input = torch::from_blob(
+      const_cast<float*>(inputs.data()), {num_rows, input_dim});
+  std::vector<torch::jit::IValue> torch_inputs;
+  torch_inputs.push_back(std::move(torch_input.to(device_)));
+  auto torch_output_tuple = torch_model.forward(torch_inputs).toTuple();
   auto probability_tensor =
       torch_output_tuple->elements()[0].toTensor().to(torch::kCPU);
   auto finish_time_tensor =
       torch_output_tuple->elements()[1].toTensor().to(torch::kCPU);
-  lane_sequence_ptr->set_probability(apollo::common::math::Sigmoid(
-      static_cast<double>(probability_tensor.accessor<float, 2>()[0][0])));
-  lane_sequence_ptr->set_time_to_lane_center(
-      static_cast<double>(finish_time_tensor.accessor<float, 2>()[0][0]));
+  auto probability = probability_tensor.accessor<float, 2>();
+  auto finish_time = finish_time_tensor.accessor<float, 2>();
+  for (int i = 0; i < num_rows; ++i) {
+    lane_sequences[i]->set_probability(apollo::common::math::Sigmoid(
+        static_cast<double>(probability[i][0])));
+    lane_sequences[i]->set_time_to_lane_center(
+        static_cast<double>(finish_time[i][0]));
+  }
 }
 
 }  // namespace prediction
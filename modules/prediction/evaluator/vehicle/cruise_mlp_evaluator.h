@@ -49,6 +49,17 @@ class CruiseMLPEvaluator : public Evaluator {
   bool Evaluate(Obstacle* obstacle_ptr,
                 ObstaclesContainer* obstacles_container) override;
 
+  /**
+   * @brief Override EvaluateBatch, the lane sequences of all obstacles run
+   *        through each model at once
+   * @param Obstacle pointers
+   * @param Obstacles container
+   * @param If each obstacle is evaluated successfully
+   */
+  void EvaluateBatch(const std::vector<Obstacle*>& obstacles,
+                     ObstaclesContainer* obstacles_container,
+                     std::vector<bool>* evaluated) override;
+
   /**
    * @brief Extract feature vector
    * @param Obstacle pointer
@@ -66,6 +77,16 @@ class CruiseMLPEvaluator : public Evaluator {
   void Clear();
 
  private:
+  // model inputs of the collected lane sequences, one row per sequence
+  struct ModelRows {
+    void Clear();
+
+    std::vector<float> go_inputs;
+    std::vector<LaneSequence*> go_lane_sequences;
+    std::vector<float> cutin_inputs;
+    std::vector<LaneSequence*> cutin_lane_sequences;
+  };
+
   /**
    * @brief Set obstacle feature vector
    * @param Obstacle pointer
@@ -96,14 +117,35 @@ class CruiseMLPEvaluator : public Evaluator {
                             const LaneSequence* lane_sequence_ptr,
                             std::vector<double>* feature_values);
 
+  /**
+   * @brief Extract the features of the lane sequences of an obstacle into
+   *        the inputs of their model
+   * @param Obstacle pointer
+   * @param Obstacles container
+   * @param Model rows to append to
+   * @return If the obstacle can be evaluated
+   */
+  bool CollectLaneSequences(Obstacle* obstacle_ptr,
+                            ObstaclesContainer* obstacles_container,
+                            ModelRows* rows);
+
+  /**
+   * @brief Run the models on the collected lane sequences
+   */
+  void RunModels(const ModelRows& rows);
+
   /**
    * @brief Load model files
    */
   void LoadModels();
 
-  void ModelInference(const std::vector<torch::jit::IValue>& torch_inputs,
-                      torch::jit::script::Module torch_model_ptr,
-                      LaneSequence* lane_sequence_ptr);
+  /**
+   * @brief Run a model on the features of lane sequences, one row each, and
+   *        set their probabilities and times to lane center
+   */
+  void ModelInference(const std::vector<float>& inputs,
+                      torch::jit::script::Module torch_model,
+                      const std::vector<LaneSequence*>& lane_sequences);
 
  private:
   static const size_t OBSTACLE_FEATURE_SIZE = 23 + 5 * 9;
@@ -114,6 +156,9 @@ class CruiseMLPEvaluator : public Evaluator {
   torch::jit::script::Module torch_go_model_;
   torch::jit::script::Module torch_cutin_model_;
   torch::Device device_;
+
+  // rows of EvaluateBatch, kept to reuse their capacity
+  ModelRows batch_rows_;
 };
 
 }  // namespace prediction
@@ -59,13 +59,82 @@ JunctionMLPEvaluator::JunctionMLPEvaluator() : device_(torch::kCPU) {
   LoadModel();
 }
 
-void JunctionMLPEvaluator::Clear() {}
+void JunctionMLPEvaluator::Clear() { batch_inputs_.clear(); }
 
 bool JunctionMLPEvaluator::Evaluate(Obstacle* obstacle_ptr,
                                     ObstaclesContainer* obstacles_container) {
   // Sanity checks.
   omp_set_num_threads(1);
+  std::vector<double> feature_values;
+  if (!PrepareObstacle(obstacle_ptr, obstacles_container, &feature_values)) {
+    return false;
+  }
+
+  // Insert features to DataForLearning
+  if (FLAGS_prediction_offline_mode ==
+      PredictionConstants::kDumpDataForLearning) {
+    FeatureOutput::InsertDataForLearning(obstacle_ptr->latest_feature(),
+                                         feature_values, "junction", nullptr);
+    ADEBUG << "Save extracted features for learning locally.";
+    return true;  // Skip Compute probability for offline mode
+  }
+  at::Tensor torch_output_tensor;
+  int row = -1;
+  if (UseModel(*obstacle_ptr)) {
+    // Local input, obstacles may be evaluated in parallel.
+    std::vector<float> inputs;
+    AppendModelInput(feature_values, &inputs);
+    torch_output_tensor = ModelInference(1, &inputs);
+    row = 0;
+  }
+  return SetProbabilities(obstacle_ptr, feature_values, torch_output_tensor,
+                          row);
+}
+
+void JunctionMLPEvaluator::EvaluateBatch(
+    const std::vector<Obstacle*>& obstacles,
+    ObstaclesContainer* obstacles_container, std::vector<bool>* evaluated) {
+  if (FLAGS_prediction_offline_mode ==
+      PredictionConstants::kDumpDataForLearning) {
+    Evaluator::EvaluateBatch(obstacles, obstacles_container, evaluated);
+    return;
+  }
+  omp_set_num_threads(1);
   Clear();
+  const size_t num_obstacles = obstacles.size();
+  evaluated->assign(num_obstacles, false);
+  batch_feature_values_.resize(num_obstacles);
+  batch_rows_.assign(num_obstacles, -1);
+  // Obstacles with more than one junction exit run through the model at once.
+  int num_rows = 0;
+  for (size_t i = 0; i < num_obstacles; ++i) {
+    batch_feature_values_[i].clear();
+    if (!PrepareObstacle(obstacles[i], obstacles_container,
+                         &batch_feature_values_[i])) {
+      continue;
+    }
+    (*evaluated)[i] = true;
+    if (UseModel(*obstacles[i])) {
+      AppendModelInput(batch_feature_values_[i], &batch_inputs_);
+      batch_rows_[i] = num_rows++;
+    }
+  }
+  at::Tensor torch_output_tensor;
+  if (num_rows > 0) {
+    torch_output_tensor = ModelInference(num_rows, &batch_inputs_);
+  }
+  for (size_t i = 0; i < num_obstacles; ++i) {
+    if ((*evaluated)[i]) {
+      (*evaluated)[i] =
+          SetProbabilities(obstacles[i], batch_feature_values_[i],
+                           torch_output_tensor, batch_rows_[i]);
+    }
+  }
+}
+
+bool JunctionMLPEvaluator::PrepareObstacle(
+    Obstacle* obstacle_ptr, ObstaclesContainer* obstacles_container,
+    std::vector<double>* feature_values) {
   CHECK_NOTNULL(obstacle_ptr);
 
   obstacle_ptr->SetEvaluatorType(evaluator_type_);
@@ -85,32 +154,48 @@ bool JunctionMLPEvaluator::Evaluate(Obstacle* obstacle_ptr,
     return false;
   }
 
-  std::vector<double> feature_values;
-  ExtractFeatureValues(obstacle_ptr, obstacles_container, &feature_values);
+  ExtractFeatureValues(obstacle_ptr, obstacles_container, feature_values);
+  return true;
+}
 
-  // Insert features to DataForLearning
-  if (FLAGS_prediction_offline_mode ==
-      PredictionConstants::kDumpDataForLearning) {
-    FeatureOutput::InsertDataForLearning(*latest_feature_ptr, feature_values,
-                                         "junction", nullptr);
-    ADEBUG << "Save extracted features for learning locally.";
-    return true;  // Skip Compute probability for offline mode
+bool JunctionMLPEvaluator::UseModel(const Obstacle& obstacle) const {
+  return obstacle.latest_feature().junction_feature().junction_exit_size() > 1;
+}
+
+void JunctionMLPEvaluator::AppendModelInput(
+    const std::vector<double>& feature_values, std::vector<float>* inputs) {
+  const size_t input_dim =
+      OBSTACLE_FEATURE_SIZE + EGO_VEHICLE_FEATURE_SIZE + JUNCTION_FEATURE_SIZE;
+  // features missing from an incomplete extraction stay zero
+  const size_t row_start = inputs->size();
+  inputs->resize(row_start + input_dim, 0.0f);
+  for (size_t i = 0; i < feature_values.size() && i < input_dim; ++i) {
+    (*inputs)[row_start + i] = static_cast<float>(feature_values[i]);
   }
-  std::vector<torch::jit::IValue> torch_inputs;
+}
+
+at::Tensor JunctionMLPEvaluator::ModelInference(int num_rows,
+                                                std::vector<float>* inputs) {
   int input_dim = static_cast<int>(
       OBSTACLE_FEATURE_SIZE + EGO_VEHICLE_FEATURE_SIZE + JUNCTION_FEATURE_SIZE);
-  torch::Tensor torch_input = torch::zeros({1, input_dim});
-  for (size_t i = 0; i < feature_values.size(); ++i) {
-    torch_input[0][i] = static_cast<float>(feature_values[i]);
-  }
+  // from_blob does not copy, inputs outlive the forward pass
+  torch::Tensor torch_input =
+      torch::from_blob(inputs->data(), {num_rows, input_dim});
+  std::vector<torch::jit::IValue> torch_inputs;
   torch_inputs.push_back(std::move(torch_input.to(device_)));
+  return torch_model_.forward(torch_inputs).toTensor().to(torch::kCPU);
+}
+
+bool JunctionMLPEvaluator::SetProbabilities(
+    Obstacle* obstacle_ptr, const std::vector<double>& feature_values,
+    const at::Tensor& torch_output_tensor, int row) {
+  int id = obstacle_ptr->id();
+  Feature* latest_feature_ptr = obstacle_ptr->mutable_latest_feature();
   std::vector<double> probability;
-  if (latest_feature_ptr->junction_feature().junction_exit_size() > 1) {
-    at::Tensor torch_output_tensor =
-        torch_model_.forward(torch_inputs).toTensor().to(torch::kCPU);
+  if (row >= 0) {
     auto torch_output = torch_output_tensor.accessor<float, 2>();
     for (int i = 0; i < torch_output.size(1); ++i) {
-      probability.push_back(static_cast<double>(torch_output[0][i]));
+      probability.push_back(static_cast<double>(torch_output[row][i]));
     }
   } else {
     for (int i = 0; i < 12; ++i) {
@@ -359,11 +444,15 @@ void JunctionMLPEvaluator::SetJunctionFeatureValues(
 }
 
 void JunctionMLPEvaluator::LoadModel() {
+  torch::set_num_threads(1);
   if (FLAGS_use_cuda && torch::cuda::is_available()) {
     ADEBUG << "CUDA is available";
     device_ = torch::Device(torch::kCUDA);
+  } else if (FLAGS_use_quantized_cpu_model) {
+    torch_model_ = torch::jit::load(
+        FLAGS_torch_vehicle_junction_mlp_quantized_file, device_);
+    return;
   }
-  torch::set_num_threads(1);
   torch_model_ =
       torch::jit::load(FLAGS_torch_vehicle_junction_mlp_file, device_);
 }
@@ -53,6 +53,17 @@ class JunctionMLPEvaluator : public Evaluator {
   bool Evaluate(Obstacle* obstacle_ptr,
                 ObstaclesContainer* obstacles_container) override;
 
+  /**
+   * @brief Override EvaluateBatch, obstacles with more than one junction exit
+   *        run through the model in a single forward pass
+   * @param Obstacles sharing this evaluator
+   * @param Obstacles container
+   * @param If each obstacle is evaluated
+   */
+  void EvaluateBatch(const std::vector<Obstacle*>& obstacles,
+                     ObstaclesContainer* obstacles_container,
+                     std::vector<bool>* evaluated) override;
+
   /**
    * @brief Extract feature vector
    * @param Obstacle pointer
@@ -100,6 +111,50 @@ class JunctionMLPEvaluator : public Evaluator {
    */
   void LoadModel();
 
+  /**
+   * @brief Sanity checks and feature extraction of an obstacle
+   * @param Obstacle pointer
+   * @param Obstacles container
+   * @param Feature container in a vector for receiving the feature values
+   * @return If the obstacle can be evaluated
+   */
+  bool PrepareObstacle(Obstacle* obstacle_ptr,
+                       ObstaclesContainer* obstacles_container,
+                       std::vector<double>* feature_values);
+
+  /**
+   * @brief If the probabilities of an obstacle come from the model
+   */
+  bool UseModel(const Obstacle& obstacle) const;
+
+  /**
+   * @brief Append a row of model input
+   * @param Feature values of an obstacle
+   * @param Model input rows
+   */
+  void AppendModelInput(const std::vector<double>& feature_values,
+                        std::vector<float>* inputs);
+
+  /**
+   * @brief Run the model on the appended rows
+   * @param Number of rows
+   * @param Model input rows
+   * @return Probabilities of the 12 fan areas for each row
+   */
+  at::Tensor ModelInference(int num_rows, std::vector<float>* inputs);
+
+  /**
+   * @brief Set junction and lane sequence probabilities of an obstacle
+   * @param Obstacle pointer
+   * @param Feature values of the obstacle
+   * @param Model output
+   * @param Row of the obstacle in the model output, -1 if not from the model
+   * @return If any lane sequence is assigned
+   */
+  bool SetProbabilities(Obstacle* obstacle_ptr,
+                        const std::vector<double>& feature_values,
+                        const at::Tensor& torch_output_tensor, int row);
+
  private:
   // obstacle feature with 4 basic features and 5 frames of history position
   static const size_t OBSTACLE_FEATURE_SIZE = 4 + 2 * 5;
@@ -110,6 +165,12 @@ class JunctionMLPEvaluator : public Evaluator {
 
   torch::jit::script::Module torch_model_;
   torch::Device device_;
+
+  // model input rows, feature values and model row of each obstacle in a
+  // batch
+  std::vector<float> batch_inputs_;
+  std::vector<std::vector<double>> batch_feature_values_;
+  std::vector<int> batch_rows_;
 };
 
 }  // namespace prediction
@@ -43,17 +43,89 @@ bool SemanticLSTMEvaluator::Evaluate(Obstacle* obstacle_ptr,
                                      ObstaclesContainer* obstacles_container) {
   omp_set_num_threads(1);
 
-  obstacle_ptr->SetEvaluatorType(evaluator_type_);
+  Clear();
+  torch::Tensor img_tensor;
+  torch::Tensor obstacle_pos;
+  torch::Tensor obstacle_pos_step;
+  if (!ExtractModelInputs(obstacle_ptr, &img_tensor, &obstacle_pos,
+                          &obstacle_pos_step)) {
+    return false;
+  }
+
+  // Compute pred_traj
+  auto start_time = std::chrono::system_clock::now();
+  at::Tensor torch_output_tensor =
+      ModelInference(obstacle_ptr->IsPedestrian(), {img_tensor},
+                     {obstacle_pos}, {obstacle_pos_step});
+
+  auto end_time = std::chrono::system_clock::now();
+  std::chrono::duration<double> diff = end_time - start_time;
+  ADEBUG << "Semantic_LSTM_evaluator used time: " << diff.count() * 1000
+         << " ms.";
+  SetTrajectory(torch_output_tensor, 0, obstacle_ptr);
+  return true;
+}
+
+void SemanticLSTMEvaluator::EvaluateBatch(
+    const std::vector<Obstacle*>& obstacles,
+    ObstaclesContainer* obstacles_container, std::vector<bool>* evaluated) {
+  omp_set_num_threads(1);
 
   Clear();
+  evaluated->assign(obstacles.size(), false);
+  // Pedestrians and vehicles have their own model, each runs once.
+  for (const bool is_pedestrian : {true, false}) {
+    std::vector<size_t> indices;
+    std::vector<torch::Tensor> img_tensors;
+    std::vector<torch::Tensor> obstacle_poses;
+    std::vector<torch::Tensor> obstacle_pos_steps;
+    for (size_t i = 0; i < obstacles.size(); ++i) {
+      if (obstacles[i]->IsPedestrian() != is_pedestrian) {
+        continue;
+      }
+      torch::Tensor img_tensor;
+      torch::Tensor obstacle_pos;
+      torch::Tensor obstacle_pos_step;
+      if (!ExtractModelInputs(obstacles[i], &img_tensor, &obstacle_pos,
+                              &obstacle_pos_step)) {
+        continue;
+      }
+      indices.push_back(i);
+      img_tensors.push_back(std::move(img_tensor));
+      obstacle_poses.push_back(std::move(obstacle_pos));
+      obstacle_pos_steps.push_back(std::move(obstacle_pos_step));
+    }
+    if (indices.empty()) {
+      continue;
+    }
+
+    auto start_time = std::chrono::system_clock::now();
+    at::Tensor torch_output_tensor = ModelInference(
+        is_pedestrian, img_tensors, obstacle_poses, obstacle_pos_steps);
+    auto end_time = std::chrono::system_clock::now();
+    std::chrono::duration<double> diff = end_time - start_time;
+    ADEBUG << "Semantic_LSTM_evaluator used time: " << diff.count() * 1000
+           << " ms for " << indices.size() << " obstacles.";
+
+    for (size_t row = 0; row < indices.size(); ++row) {
+      SetTrajectory(torch_output_tensor, static_cast<int>(row),
+                    obstacles[indices[row]]);
+      (*evaluated)[indices[row]] = true;
+    }
+  }
+}
+
+bool SemanticLSTMEvaluator::ExtractModelInputs(
+    Obstacle* obstacle_ptr, torch::Tensor* img_tensor,
+    torch::Tensor* obstacle_pos, torch::Tensor* obstacle_pos_step) {
   CHECK_NOTNULL(obstacle_ptr);
+  obstacle_ptr->SetEvaluatorType(evaluator_type_);
+
   int id = obstacle_ptr->id();
   if (!obstacle_ptr->latest_feature().IsInitialized()) {
     AERROR << "Obstacle [" << id << "] has no latest feature.";
     return false;
   }
-  Feature* latest_feature_ptr = obstacle_ptr->mutable_latest_feature();
-  CHECK_NOTNULL(latest_feature_ptr);
 
   if (!FLAGS_enable_semantic_map) {
     ADEBUG << "Not enable semantic map, exit semantic_lstm_evaluator.";
@@ -67,11 +139,12 @@ bool SemanticLSTMEvaluator::Evaluate(Obstacle* obstacle_ptr,
   cv::cvtColor(feature_map, feature_map, cv::COLOR_BGR2RGB);
   cv::Mat img_float;
   feature_map.convertTo(img_float, CV_32F, 1.0 / 255);
-  torch::Tensor img_tensor = torch::from_blob(img_float.data, {1, 224, 224, 3});
-  img_tensor = img_tensor.permute({0, 3, 1, 2});
-  img_tensor[0][0] = img_tensor[0][0].sub(0.485).div(0.229);
-  img_tensor[0][1] = img_tensor[0][1].sub(0.456).div(0.224);
-  img_tensor[0][2] = img_tensor[0][2].sub(0.406).div(0.225);
+  // clone since img_float is released on return
+  *img_tensor = torch::from_blob(img_float.data, {1, 224, 224, 3}).clone();
+  *img_tensor = img_tensor->permute({0, 3, 1, 2});
+  (*img_tensor)[0][0] = (*img_tensor)[0][0].sub(0.485).div(0.229);
+  (*img_tensor)[0][1] = (*img_tensor)[0][1].sub(0.456).div(0.224);
+  (*img_tensor)[0][2] = (*img_tensor)[0][2].sub(0.406).div(0.225);
 
   // Extract features of pos_history
   std::vector<std::pair<double, double>> pos_history(20, {0.0, 0.0});
@@ -81,48 +154,46 @@ bool SemanticLSTMEvaluator::Evaluate(Obstacle* obstacle_ptr,
   }
   // Process obstacle_history
   // TODO(Hongyi): move magic numbers to parameters and gflags
-  torch::Tensor obstacle_pos = torch::zeros({1, 20, 2});
-  torch::Tensor obstacle_pos_step = torch::zeros({1, 20, 2});
+  *obstacle_pos = torch::zeros({1, 20, 2});
+  *obstacle_pos_step = torch::zeros({1, 20, 2});
   for (int i = 0; i < 20; ++i) {
-    obstacle_pos[0][19 - i][0] = pos_history[i].first;
-    obstacle_pos[0][19 - i][1] = pos_history[i].second;
+    (*obstacle_pos)[0][19 - i][0] = pos_history[i].first;
+    (*obstacle_pos)[0][19 - i][1] = pos_history[i].second;
     if (i == 19 || (i > 0 && pos_history[i].first == 0.0)) {
       break;
     }
-    obstacle_pos_step[0][19 - i][0] =
+    (*obstacle_pos_step)[0][19 - i][0] =
         pos_history[i].first - pos_history[i + 1].first;
-    obstacle_pos_step[0][19 - i][1] =
+    (*obstacle_pos_step)[0][19 - i][1] =
         pos_history[i].second - pos_history[i + 1].second;
   }
+  return true;
+}
 
-  // Build input features for torch
+at::Tensor SemanticLSTMEvaluator::ModelInference(
+    bool is_pedestrian, const std::vector<torch::Tensor>& img_tensors,
+    const std::vector<torch::Tensor>& obstacle_poses,
+    const std::vector<torch::Tensor>& obstacle_pos_steps) {
+  // Build input features for torch, obstacles are stacked along dim 0
   std::vector<torch::jit::IValue> torch_inputs;
-
   torch_inputs.push_back(c10::ivalue::Tuple::create(
-      {std::move(img_tensor.to(device_)), std::move(obstacle_pos.to(device_)),
-       std::move(obstacle_pos_step.to(device_))}));
-
-  // Compute pred_traj
-  std::vector<double> pred_traj;
-
-  auto start_time = std::chrono::system_clock::now();
-  at::Tensor torch_output_tensor = torch_default_output_tensor_;
-  if (obstacle_ptr->IsPedestrian()) {
-    torch_output_tensor = torch_pedestrian_model_.forward(torch_inputs)
-                              .toTensor()
-                              .to(torch::kCPU);
-  } else {
-    torch_output_tensor =
-        torch_vehicle_model_.forward(torch_inputs).toTensor().to(torch::kCPU);
+      {torch::cat(img_tensors, 0).to(device_),
+       torch::cat(obstacle_poses, 0).to(device_),
+       torch::cat(obstacle_pos_steps, 0).to(device_)}));
+  if (is_pedestrian) {
+    return torch_pedestrian_model_.forward(torch_inputs)
+        .toTensor()
+        .to(torch::kCPU);
   }
+  return torch_vehicle_model_.forward(torch_inputs).toTensor().to(torch::kCPU);
+}
 
-  auto end_time = std::chrono::system_clock::now();
-  std::chrono::duration<double> diff = end_time - start_time;
-  ADEBUG << "Semantic_LSTM_evaluator used time: " << diff.count() * 1000
-         << " ms.";
+void SemanticLSTMEvaluator::SetTrajectory(
+    const at::Tensor& torch_output_tensor, int row, Obstacle* obstacle_ptr) {
   auto torch_output = torch_output_tensor.accessor<float, 3>();
 
   // Get the trajectory
+  Feature* latest_feature_ptr = obstacle_ptr->mutable_latest_feature();
   double pos_x = latest_feature_ptr->position().x();
   double pos_y = latest_feature_ptr->position().y();
   Trajectory* trajectory = latest_feature_ptr->add_predicted_trajectory();
@@ -137,8 +208,8 @@ bool SemanticLSTMEvaluator::Evaluate(Obstacle* obstacle_ptr,
       prev_y = last_point.y();
     }
     TrajectoryPoint* point = trajectory->add_trajectory_point();
-    double dx = static_cast<double>(torch_output[0][i][0]);
-    double dy = static_cast<double>(torch_output[0][i][1]);
+    double dx = static_cast<double>(torch_output[row][i][0]);
+    double dy = static_cast<double>(torch_output[row][i][1]);
 
     double heading = latest_feature_ptr->velocity_heading();
     Vec2d offset(dx, dy);
@@ -149,9 +220,9 @@ bool SemanticLSTMEvaluator::Evaluate(Obstacle* obstacle_ptr,
     point->mutable_path_point()->set_y(point_y);
 
     if (torch_output_tensor.sizes()[2] == 5) {
-      double sigma_xr = std::abs(static_cast<double>(torch_output[0][i][2]));
-      double sigma_yr = std::abs(static_cast<double>(torch_output[0][i][3]));
-      double corr_r = static_cast<double>(torch_output[0][i][4]);
+      double sigma_xr = std::abs(static_cast<double>(torch_output[row][i][2]));
+      double sigma_yr = std::abs(static_cast<double>(torch_output[row][i][3]));
+      double corr_r = static_cast<double>(torch_output[row][i][4]);
       Eigen::Matrix2d cov_matrix_r;
       cov_matrix_r(0, 0) = sigma_xr * sigma_xr;
       cov_matrix_r(0, 1) = corr_r * sigma_xr * sigma_yr;
@@ -213,7 +284,6 @@ bool SemanticLSTMEvaluator::Evaluate(Obstacle* obstacle_ptr,
     }
   }
 
-  return true;
 }
 
 bool SemanticLSTMEvaluator::ExtractObstacleHistory(
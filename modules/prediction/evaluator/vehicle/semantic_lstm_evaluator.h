@@ -54,6 +54,17 @@ class SemanticLSTMEvaluator : public Evaluator {
   bool Evaluate(Obstacle* obstacle_ptr,
                 ObstaclesContainer* obstacles_container) override;
 
+  /**
+   * @brief Override EvaluateBatch, pedestrians and vehicles each run through
+   *        their model in a single forward pass
+   * @param Obstacles sharing this evaluator
+   * @param Obstacles container
+   * @param If each obstacle is evaluated
+   */
+  void EvaluateBatch(const std::vector<Obstacle*>& obstacles,
+                     ObstaclesContainer* obstacles_container,
+                     std::vector<bool>* evaluated) override;
+
   /**
    * @brief Extract obstacle history
    * @param Obstacle pointer
@@ -74,6 +85,36 @@ class SemanticLSTMEvaluator : public Evaluator {
    */
   void LoadModel();
 
+  /**
+   * @brief Sanity checks and model inputs of an obstacle
+   * @param Obstacle pointer
+   * @param Normalized semantic map of shape [1, 3, 224, 224]
+   * @param Position history of shape [1, 20, 2]
+   * @param Position steps of shape [1, 20, 2]
+   * @return If the obstacle can be evaluated
+   */
+  bool ExtractModelInputs(Obstacle* obstacle_ptr, torch::Tensor* img_tensor,
+                          torch::Tensor* obstacle_pos,
+                          torch::Tensor* obstacle_pos_step);
+
+  /**
+   * @brief Run the pedestrian or vehicle model on stacked inputs
+   * @return Trajectory output with one row per input
+   */
+  at::Tensor ModelInference(
+      bool is_pedestrian, const std::vector<torch::Tensor>& img_tensors,
+      const std::vector<torch::Tensor>& obstacle_poses,
+      const std::vector<torch::Tensor>& obstacle_pos_steps);
+
+  /**
+   * @brief Add the predicted trajectory of an obstacle
+   * @param Model output
+   * @param Row of the obstacle in the model output
+   * @param Obstacle pointer
+   */
+  void SetTrajectory(const at::Tensor& torch_output_tensor, int row,
+                     Obstacle* obstacle_ptr);
+
  private:
   torch::jit::script::Module torch_vehicle_model_;
   torch::jit::script::Module torch_pedestrian_model_;
@@ -0,0 +1,247 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Replay records through the float and the int8 quantized cpu models,
+ *        and compare their predictions and latencies.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <unordered_map>
+
+#include "cyber/common/file.h"
+#include "cyber/record/record_reader.h"
+
+#include "absl/strings/str_split.h"
+#include "modules/prediction/common/message_process.h"
+#include "modules/prediction/common/prediction_gflags.h"
+#include "modules/prediction/common/prediction_map.h"
+#include "modules/prediction/common/prediction_system_gflags.h"
+#include "modules/prediction/proto/prediction_conf.pb.h"
+#include "modules/prediction/util/data_extraction.h"
+
+namespace apollo {
+namespace prediction {
+
+using apollo::cyber::record::RecordMessage;
+using apollo::cyber::record::RecordReader;
+using apollo::localization::LocalizationEstimate;
+using apollo::perception::PerceptionObstacles;
+using apollo::planning::ADCTrajectory;
+
+namespace {
+
+struct Pipeline {
+  std::shared_ptr<ContainerManager> container_manager =
+      std::make_shared<ContainerManager>();
+  EvaluatorManager evaluator_manager;
+  PredictorManager predictor_manager;
+  ScenarioManager scenario_manager;
+  // total OnPerception time in msec
+  double total_time = 0.0;
+};
+
+struct Comparison {
+  int num_frames = 0;
+  int num_trajectories = 0;
+  int num_mismatched_obstacles = 0;
+  double sum_probability_diff = 0.0;
+  double max_probability_diff = 0.0;
+  double sum_end_point_diff = 0.0;
+  double max_end_point_diff = 0.0;
+};
+
+std::unique_ptr<Pipeline> CreatePipeline(const PredictionConf& prediction_conf,
+                                         const bool use_quantized_model) {
+  FLAGS_use_quantized_cpu_model = use_quantized_model;
+  std::unique_ptr<Pipeline> pipeline(new Pipeline());
+  if (!MessageProcess::Init(pipeline->container_manager.get(),
+                            &pipeline->evaluator_manager,
+                            &pipeline->predictor_manager, prediction_conf)) {
+    return nullptr;
+  }
+  return pipeline;
+}
+
+void RunPerception(const PerceptionObstacles& perception_obstacles,
+                   Pipeline* pipeline,
+                   PredictionObstacles* prediction_obstacles) {
+  const auto start_time = std::chrono::steady_clock::now();
+  MessageProcess::OnPerception(
+      perception_obstacles, pipeline->container_manager,
+      &pipeline->evaluator_manager, &pipeline->predictor_manager,
+      &pipeline->scenario_manager, prediction_obstacles);
+  const std::chrono::duration<double, std::milli> diff =
+      std::chrono::steady_clock::now() - start_time;
+  pipeline->total_time += diff.count();
+}
+
+void Compare(const PredictionObstacles& reference,
+             const PredictionObstacles& quantized, Comparison* comparison) {
+  ++comparison->num_frames;
+  std::unordered_map<int, const PredictionObstacle*> quantized_obstacles;
+  for (const auto& obstacle : quantized.prediction_obstacle()) {
+    quantized_obstacles[obstacle.perception_obstacle().id()] = &obstacle;
+  }
+  for (const auto& obstacle : reference.prediction_obstacle()) {
+    auto iter = quantized_obstacles.find(obstacle.perception_obstacle().id());
+    if (iter == quantized_obstacles.end() ||
+        iter->second->trajectory_size() != obstacle.trajectory_size()) {
+      ++comparison->num_mismatched_obstacles;
+      continue;
+    }
+    for (int i = 0; i < obstacle.trajectory_size(); ++i) {
+      const auto& trajectory = obstacle.trajectory(i);
+      const auto& quantized_trajectory = iter->second->trajectory(i);
+      const double probability_diff = std::fabs(
+          trajectory.probability() - quantized_trajectory.probability());
+      comparison->sum_probability_diff += probability_diff;
+      comparison->max_probability_diff =
+          std::max(comparison->max_probability_diff, probability_diff);
+      ++comparison->num_trajectories;
+
+      if (trajectory.trajectory_point_size() == 0 ||
+          quantized_trajectory.trajectory_point_size() == 0) {
+        continue;
+      }
+      const auto& end_point =
+          trajectory
+              .trajectory_point(trajectory.trajectory_point_size() - 1)
+              .path_point();
+      const auto& quantized_end_point =
+          quantized_trajectory
+              .trajectory_point(
+                  quantized_trajectory.trajectory_point_size() - 1)
+              .path_point();
+      const double end_point_diff =
+          std::hypot(end_point.x() - quantized_end_point.x(),
+                     end_point.y() - quantized_end_point.y());
+      comparison->sum_end_point_diff += end_point_diff;
+      comparison->max_end_point_diff =
+          std::max(comparison->max_end_point_diff, end_point_diff);
+    }
+  }
+}
+
+void ProcessRecord(const PredictionConf& prediction_conf,
+                   const std::string& record_filepath, Pipeline* reference,
+                   Pipeline* quantized, Comparison* comparison) {
+  RecordReader reader(record_filepath);
+  RecordMessage message;
+  while (reader.ReadMessage(&message)) {
+    if (message.channel_name ==
+        prediction_conf.topic_conf().perception_obstacle_topic()) {
+      PerceptionObstacles perception_obstacles;
+      if (perception_obstacles.ParseFromString(message.content)) {
+        PredictionObstacles reference_obstacles;
+        RunPerception(perception_obstacles, reference, &reference_obstacles);
+        PredictionObstacles quantized_obstacles;
+        RunPerception(perception_obstacles, quantized, &quantized_obstacles);
+        Compare(reference_obstacles, quantized_obstacles, comparison);
+      }
+    } else if (message.channel_name ==
+               prediction_conf.topic_conf().localization_topic()) {
+      LocalizationEstimate localization;
+      if (localization.ParseFromString(message.content)) {
+        MessageProcess::OnLocalization(reference->container_manager.get(),
+                                       localization);
+        MessageProcess::OnLocalization(quantized->container_manager.get(),
+                                       localization);
+      }
+    } else if (message.channel_name ==
+               prediction_conf.topic_conf().planning_trajectory_topic()) {
+      ADCTrajectory adc_trajectory;
+      if (adc_trajectory.ParseFromString(message.content)) {
+        MessageProcess::OnPlanning(reference->container_manager.get(),
+                                   adc_trajectory);
+        MessageProcess::OnPlanning(quantized->container_manager.get(),
+                                   adc_trajectory);
+      }
+    }
+  }
+}
+
+}  // namespace
+
+void CompareQuantizedModels() {
+  apollo::hdmap::HDMapUtil::ReloadMaps();
+  if (FLAGS_prediction_offline_bags.empty()) {
+    return;
+  }
+
+  PredictionConf prediction_conf;
+  if (!cyber::common::GetProtoFromFile(FLAGS_prediction_conf_file,
+                                       &prediction_conf)) {
+    AERROR << "Unable to load prediction conf file: "
+           << FLAGS_prediction_conf_file;
+    return;
+  }
+
+  // Both pipelines run on cpu, only the model files differ.
+  FLAGS_use_cuda = false;
+  std::unique_ptr<Pipeline> reference = CreatePipeline(prediction_conf, false);
+  std::unique_ptr<Pipeline> quantized = CreatePipeline(prediction_conf, true);
+  if (reference == nullptr || quantized == nullptr) {
+    return;
+  }
+
+  Comparison comparison;
+  const std::vector<std::string> inputs =
+      absl::StrSplit(FLAGS_prediction_offline_bags, ':');
+  for (const auto& input : inputs) {
+    std::vector<std::string> offline_bags;
+    GetRecordFileNames(boost::filesystem::path(input), &offline_bags);
+    std::sort(offline_bags.begin(), offline_bags.end());
+    for (std::size_t i = 0; i < offline_bags.size(); ++i) {
+      AINFO << "\tProcessing: [ " << i << " / " << offline_bags.size()
+            << " ]: " << offline_bags[i];
+      ProcessRecord(prediction_conf, offline_bags[i], reference.get(),
+                    quantized.get(), &comparison);
+    }
+  }
+
+  if (comparison.num_frames == 0) {
+    AERROR << "No perception message is found.";
+    return;
+  }
+  const int num_trajectories = std::max(comparison.num_trajectories, 1);
+  AINFO << "Frames: " << comparison.num_frames
+        << ", trajectories: " << comparison.num_trajectories
+        << ", mismatched obstacles: " << comparison.num_mismatched_obstacles;
+  AINFO << "Probability diff mean: "
+        << comparison.sum_probability_diff / num_trajectories
+        << ", max: " << comparison.max_probability_diff;
+  AINFO << "End point diff mean: "
+        << comparison.sum_end_point_diff / num_trajectories
+        << " m, max: " << comparison.max_end_point_diff << " m";
+  AINFO << "Frame time float: "
+        << reference->total_time / comparison.num_frames
+        << " msec, quantized: "
+        << quantized->total_time / comparison.num_frames << " msec";
+}
+
+}  // namespace prediction
+}  // namespace apollo
+
+int main(int argc, char* argv[]) {
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  apollo::prediction::CompareQuantizedModels();
+  return 0;
+}
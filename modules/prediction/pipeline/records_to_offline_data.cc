@@ -36,6 +36,14 @@ void GenerateDataForLearning() {
   if (FLAGS_prediction_offline_bags.empty()) {
     return;
   }
+  if (FLAGS_prediction_offline_shard_num < 1 ||
+      FLAGS_prediction_offline_shard_index < 0 ||
+      FLAGS_prediction_offline_shard_index >=
+          FLAGS_prediction_offline_shard_num) {
+    AERROR << "Invalid shard " << FLAGS_prediction_offline_shard_index
+           << " of " << FLAGS_prediction_offline_shard_num;
+    return;
+  }
 
   PredictionConf prediction_conf;
   if (!cyber::common::GetProtoFromFile(FLAGS_prediction_conf_file,
@@ -64,7 +72,9 @@ void GenerateDataForLearning() {
     std::sort(offline_bags.begin(), offline_bags.end());
     AINFO << "For input " << input << ", found " << offline_bags.size()
           << "  rosbags to process";
-    for (std::size_t i = 0; i < offline_bags.size(); ++i) {
+    // with several shards, each process takes every shard_num-th bag
+    for (std::size_t i = FLAGS_prediction_offline_shard_index;
+         i < offline_bags.size(); i += FLAGS_prediction_offline_shard_num) {
       AINFO << "\tProcessing: [ " << i << " / " << offline_bags.size()
             << " ]: " << offline_bags[i];
       MessageProcess::ProcessOfflineData(prediction_conf, container_manager,
@@ -20,6 +20,7 @@
 #include "cyber/record/record_reader.h"
 #include "cyber/time/clock.h"
 #include "modules/common/adapters/adapter_gflags.h"
+#include "modules/common/latency_recorder/latency_recorder.h"
 #include "modules/common/util/message_util.h"
 
 #include "modules/prediction/common/feature_output.h"
@@ -188,7 +189,8 @@ bool PredictionComponent::PredictionEndToEndProc(
     return false;
   }
 
-  frame_start_time_ = Clock::NowInSeconds();
+  const auto start_time = Clock::Now();
+  frame_start_time_ = start_time.ToSecond();
   auto end_time1 = std::chrono::system_clock::now();
 
   // Read localization info. and call OnLocalization to update
@@ -270,6 +272,13 @@ bool PredictionComponent::PredictionEndToEndProc(
   diff = end_time5 - end_time1;
   ADEBUG << "End to end time elapsed: " << diff.count() * 1000 << " msec.";
 
+  // measure latency
+  static apollo::common::LatencyRecorder latency_recorder(
+      FLAGS_prediction_topic);
+  latency_recorder.AppendLatencyRecord(
+      prediction_obstacles.header().lidar_timestamp(), start_time,
+      Clock::Now());
+
   // Publish output
   common::util::FillHeader(node_->Name(), &prediction_obstacles);
   prediction_writer_->Write(prediction_obstacles);
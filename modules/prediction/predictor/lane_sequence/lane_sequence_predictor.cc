@@ -147,40 +147,15 @@ void LaneSequencePredictor::DrawLaneSequenceTrajectoryPoints(
     approach_rate = FLAGS_cutin_approach_rate;
   }
   size_t total_num = static_cast<size_t>(total_time / period);
+  std::vector<LaneState> lane_states(total_num);
   for (size_t i = 0; i < total_num; ++i) {
-    double relative_time = static_cast<double>(i) * period;
-    Eigen::Vector2d point;
-    double theta = M_PI;
-    if (!PredictionMap::SmoothPointFromLane(lane_id, lane_s, lane_l, &point,
-                                            &theta)) {
-      AERROR << "Unable to get smooth point from lane [" << lane_id
-             << "] with s [" << lane_s << "] and l [" << lane_l << "]";
-      break;
-    }
-    TrajectoryPoint trajectory_point;
-    PathPoint path_point;
-    path_point.set_x(point.x());
-    path_point.set_y(point.y());
-    path_point.set_z(0.0);
-    path_point.set_theta(theta);
-    path_point.set_lane_id(lane_id);
-    trajectory_point.mutable_path_point()->CopyFrom(path_point);
-    trajectory_point.set_v(speed);
-    trajectory_point.set_a(0.0);
-    trajectory_point.set_relative_time(relative_time);
-    points->emplace_back(std::move(trajectory_point));
-
-    lane_s += speed * period;
-
-    while (lane_s > PredictionMap::LaneById(lane_id)->total_length() &&
-           lane_segment_index + 1 < lane_sequence.lane_segment_size()) {
-      lane_segment_index += 1;
-      lane_s = lane_s - PredictionMap::LaneById(lane_id)->total_length();
-      lane_id = lane_sequence.lane_segment(lane_segment_index).lane_id();
-    }
-
+    lane_states[i].ds = i > 0 ? speed * period : 0.0;
+    lane_states[i].l = lane_l;
+    lane_states[i].v = speed;
     lane_l *= approach_rate;
   }
+  DrawLaneSequenceTrajectory(lane_sequence, lane_segment_index, lane_s, period,
+                             lane_states, points);
 }
 
 }  // namespace prediction
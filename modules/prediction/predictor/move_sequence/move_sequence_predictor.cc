@@ -174,61 +174,37 @@ bool MoveSequencePredictor::DrawMoveSequenceTrajectoryPoints(
   }
   double prev_lane_l = lane_l;
 
-  // Draw each trajectory point within the total time of prediction
+  // Evaluate the polynomials at each trajectory point within the total time
+  // of prediction
   size_t total_num = static_cast<size_t>(total_time / period);
+  std::vector<LaneState> lane_states(total_num);
+  double prev_s = 0.0;
   for (size_t i = 0; i < total_num; ++i) {
     double relative_time = static_cast<double>(i) * period;
-    Eigen::Vector2d point;
-    double theta = M_PI;
+    LaneState& lane_state = lane_states[i];
 
     lane_l = EvaluateCubicPolynomial(lateral_coeffs, relative_time, 0,
                                      time_to_lat_end_state, 0.0);
     double curr_s =
         EvaluateQuarticPolynomial(longitudinal_coeffs, relative_time, 0,
                                   lon_end_vt.second, lon_end_vt.first);
-    double prev_s = (i > 0) ? EvaluateQuarticPolynomial(
-                                  longitudinal_coeffs, relative_time - period,
-                                  0, lon_end_vt.second, lon_end_vt.first)
-                            : 0.0;
-    lane_s += std::max(0.0, (curr_s - prev_s));
+    lane_state.ds = std::max(0.0, (curr_s - prev_s));
     if (curr_s + FLAGS_double_precision < prev_s) {
       lane_l = prev_lane_l;
     }
-    if (!PredictionMap::SmoothPointFromLane(lane_id, lane_s, lane_l, &point,
-                                            &theta)) {
-      AERROR << "Unable to get smooth point from lane [" << lane_id
-             << "] with s [" << lane_s << "] and l [" << lane_l << "]";
-      break;
-    }
-
+    lane_state.l = lane_l;
     prev_lane_l = lane_l;
-    double lane_speed =
+    prev_s = curr_s;
+
+    lane_state.v =
         EvaluateQuarticPolynomial(longitudinal_coeffs, relative_time, 1,
                                   lon_end_vt.second, lon_end_vt.first);
-    double lane_acc =
+    lane_state.a =
         EvaluateQuarticPolynomial(longitudinal_coeffs, relative_time, 2,
                                   lon_end_vt.second, lon_end_vt.first);
-
-    TrajectoryPoint trajectory_point;
-    PathPoint path_point;
-    path_point.set_x(point.x());
-    path_point.set_y(point.y());
-    path_point.set_z(0.0);
-    path_point.set_theta(theta);
-    path_point.set_lane_id(lane_id);
-    trajectory_point.mutable_path_point()->CopyFrom(path_point);
-    trajectory_point.set_v(lane_speed);
-    trajectory_point.set_a(lane_acc);
-    trajectory_point.set_relative_time(relative_time);
-    points->emplace_back(std::move(trajectory_point));
-
-    while (lane_s > PredictionMap::LaneById(lane_id)->total_length() &&
-           lane_segment_index + 1 < lane_sequence.lane_segment_size()) {
-      lane_segment_index += 1;
-      lane_s = lane_s - PredictionMap::LaneById(lane_id)->total_length();
-      lane_id = lane_sequence.lane_segment(lane_segment_index).lane_id();
-    }
   }
+  DrawLaneSequenceTrajectory(lane_sequence, lane_segment_index, lane_s, period,
+                             lane_states, points);
   return true;
 }
 
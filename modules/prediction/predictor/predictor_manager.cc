@@ -16,8 +16,12 @@
 
 #include "modules/prediction/predictor/predictor_manager.h"
 
+#include <algorithm>
 #include <list>
 #include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include "modules/prediction/common/feature_output.h"
 #include "modules/prediction/common/prediction_constants.h"
@@ -55,6 +59,18 @@ void GroupObstaclesByObstacleId(const int obstacle_id,
   (*id_obstacle_map)[id_mod].push_back(obstacle_ptr);
 }
 
+// Lower ranks are queued first.
+int PriorityRank(const Obstacle* obstacle) {
+  switch (obstacle->latest_feature().priority().priority()) {
+    case ObstaclePriority::CAUTION:
+      return 0;
+    case ObstaclePriority::IGNORE:
+      return 2;
+    default:
+      return 1;
+  }
+}
+
 }  // namespace
 
 PredictorManager::PredictorManager() { RegisterPredictors(); }
@@ -229,6 +245,87 @@ void PredictorManager::PredictObstaclesInParallel(
   }
 }
 
+void PredictorManager::RunPipelined(
+    const std::function<void(Obstacle*)>& evaluate,
+    const PerceptionObstacles& perception_obstacles,
+    const ADCTrajectoryContainer* adc_trajectory_container,
+    ObstaclesContainer* obstacles_container) {
+  prediction_obstacles_.Clear();
+
+  const int num_obstacles = perception_obstacles.perception_obstacle_size();
+  std::vector<PredictionObstacle> prediction_obstacles(num_obstacles);
+  // Index in perception obstacles and obstacle of each task.
+  std::vector<std::pair<int, Obstacle*>> tasks;
+  for (int i = 0; i < num_obstacles; ++i) {
+    const PerceptionObstacle& perception_obstacle =
+        perception_obstacles.perception_obstacle(i);
+    int id = perception_obstacle.id();
+    if (id < 0) {
+      ADEBUG << "The obstacle has invalid id [" << id << "].";
+      continue;
+    }
+    Obstacle* obstacle = obstacles_container->GetObstacle(id);
+    if (obstacle == nullptr) {
+      prediction_obstacles[i].set_timestamp(perception_obstacle.timestamp());
+      prediction_obstacles[i].set_is_static(true);
+      continue;
+    }
+    tasks.emplace_back(i, obstacle);
+  }
+  std::stable_sort(tasks.begin(), tasks.end(),
+                   [](const std::pair<int, Obstacle*>& task0,
+                      const std::pair<int, Obstacle*>& task1) {
+                     return PriorityRank(task0.second) <
+                            PriorityRank(task1.second);
+                   });
+
+  // Same obstacles as the evaluator manager evaluates in parallel.
+  const std::vector<int>& considered_ids =
+      obstacles_container->curr_frame_considered_obstacle_ids();
+  const std::unordered_set<int> evaluated_ids(considered_ids.begin(),
+                                              considered_ids.end());
+  // The pool takes tasks in order, an idle worker picks the next obstacle.
+  BaseThreadPool* thread_pool = PredictionThreadPool::Instance();
+  std::vector<std::future<void>> futures;
+  futures.reserve(tasks.size());
+  for (const auto& task : tasks) {
+    const int index = task.first;
+    Obstacle* obstacle = task.second;
+    auto evaluate_and_predict = [&, index, obstacle] {
+      if (evaluated_ids.count(obstacle->id()) > 0 && !obstacle->IsStill() &&
+          obstacle->latest_feature().priority().priority() !=
+              ObstaclePriority::IGNORE) {
+        evaluate(obstacle);
+      }
+      PredictObstacle(adc_trajectory_container, obstacle, obstacles_container,
+                      &prediction_obstacles[index]);
+    };
+    futures.push_back(thread_pool->Post(std::move(evaluate_and_predict)));
+  }
+  for (auto& future : futures) {
+    if (future.valid()) {
+      future.get();
+    } else {
+      AERROR << "Future is invalid.";
+    }
+  }
+
+  for (int i = 0; i < num_obstacles; ++i) {
+    const PerceptionObstacle& perception_obstacle =
+        perception_obstacles.perception_obstacle(i);
+    if (perception_obstacle.id() < 0) {
+      continue;
+    }
+    PredictionObstacle* prediction_obstacle =
+        prediction_obstacles_.add_prediction_obstacle();
+    prediction_obstacle->Swap(&prediction_obstacles[i]);
+    prediction_obstacle->set_predicted_period(
+        FLAGS_prediction_trajectory_time_length);
+    prediction_obstacle->mutable_perception_obstacle()->CopyFrom(
+        perception_obstacle);
+  }
+}
+
 void PredictorManager::PredictObstacle(
     const ADCTrajectoryContainer* adc_trajectory_container, Obstacle* obstacle,
     ObstaclesContainer* obstacles_container,
@@ -244,6 +341,10 @@ void PredictorManager::PredictObstacle(
   } else if (obstacle->IsStill()) {
     ADEBUG << "Still obstacle [" << obstacle->id() << "]";
     RunEmptyPredictor(adc_trajectory_container, obstacle, obstacles_container);
+  } else if (obstacle->IsDegraded()) {
+    ADEBUG << "Degraded obstacle [" << obstacle->id() << "]";
+    RunFreeMovePredictor(adc_trajectory_container, obstacle,
+                         obstacles_container);
   } else {
     switch (obstacle->type()) {
       case PerceptionObstacle::VEHICLE: {
@@ -476,6 +577,17 @@ void PredictorManager::RunDefaultPredictor(
   predictor->Predict(adc_trajectory_container, obstacle, obstacles_container);
 }
 
+void PredictorManager::RunFreeMovePredictor(
+    const ADCTrajectoryContainer* adc_trajectory_container, Obstacle* obstacle,
+    ObstaclesContainer* obstacles_container) {
+  Predictor* predictor = GetPredictor(ObstacleConf::FREE_MOVE_PREDICTOR);
+  if (predictor == nullptr) {
+    AERROR << "Nullptr found for obstacle [" << obstacle->id() << "]";
+    return;
+  }
+  predictor->Predict(adc_trajectory_container, obstacle, obstacles_container);
+}
+
 void PredictorManager::RunEmptyPredictor(
     const ADCTrajectoryContainer* adc_trajectory_container, Obstacle* obstacle,
     ObstaclesContainer* obstacles_container) {
@@ -21,6 +21,7 @@
 
 #pragma once
 
+#include <functional>
 #include <map>
 #include <memory>
 
@@ -68,6 +69,21 @@ class PredictorManager {
            const ADCTrajectoryContainer* adc_trajectory_container,
            ObstaclesContainer* obstacles_container);
 
+  /**
+   * @brief Evaluate and predict each obstacle in its own task, so that an
+   *        obstacle is predicted as soon as it is evaluated. Caution
+   *        obstacles are queued first.
+   * @param Evaluation of a single obstacle
+   * @param Perception obstacles
+   * @param Adc trajectory container
+   * @param Obstacles container
+   */
+  void RunPipelined(
+      const std::function<void(Obstacle*)>& evaluate,
+      const apollo::perception::PerceptionObstacles& perception_obstacles,
+      const ADCTrajectoryContainer* adc_trajectory_container,
+      ObstaclesContainer* obstacles_container);
+
   /**
    * @brief Predict a single obstacle
    * @param A pointer to adc_trajectory_container
@@ -138,6 +154,10 @@ class PredictorManager {
       const ADCTrajectoryContainer* adc_trajectory_container,
       Obstacle* obstacle, ObstaclesContainer* obstacles_container);
 
+  void RunFreeMovePredictor(
+      const ADCTrajectoryContainer* adc_trajectory_container,
+      Obstacle* obstacle, ObstaclesContainer* obstacles_container);
+
   void RunEmptyPredictor(const ADCTrajectoryContainer* adc_trajectory_container,
                          Obstacle* obstacle,
                          ObstaclesContainer* obstacles_container);
@@ -19,6 +19,7 @@
 #include <limits>
 #include <memory>
 
+#include "modules/common/math/math_utils.h"
 #include "modules/common/proto/geometry.pb.h"
 #include "modules/prediction/common/prediction_gflags.h"
 #include "modules/prediction/container/container_manager.h"
@@ -283,44 +284,76 @@ void SequencePredictor::DrawConstantAccelerationTrajectory(
     return;
   }
   size_t total_num = static_cast<size_t>(total_time / period);
-  for (size_t i = 0; i < total_num; ++i) {
-    double relative_time = static_cast<double>(i) * period;
-    Eigen::Vector2d point;
-    double theta = M_PI;
-    if (!PredictionMap::SmoothPointFromLane(lane_id, lane_s, lane_l, &point,
-                                            &theta)) {
-      AERROR << "Unable to get smooth point from lane [" << lane_id
-             << "] with s [" << lane_s << "] and l [" << lane_l << "]";
-      break;
-    }
-    TrajectoryPoint trajectory_point;
-    PathPoint path_point;
-    path_point.set_x(point.x());
-    path_point.set_y(point.y());
-    path_point.set_z(0.0);
-    path_point.set_theta(theta);
-    path_point.set_lane_id(lane_id);
-    trajectory_point.mutable_path_point()->CopyFrom(path_point);
-    trajectory_point.set_v(speed);
-    trajectory_point.set_a(0.0);
-    trajectory_point.set_relative_time(relative_time);
-    points->emplace_back(std::move(trajectory_point));
-
+  std::vector<LaneState> lane_states(total_num);
+  double ds = 0.0;
+  for (LaneState& lane_state : lane_states) {
+    lane_state.ds = ds;
+    lane_state.l = lane_l;
+    lane_state.v = speed;
     if (speed < FLAGS_double_precision) {
+      ds = 0.0;
       continue;
     }
-
-    lane_s += speed * period + 0.5 * acceleration * period * period;
+    ds = speed * period + 0.5 * acceleration * period * period;
     speed += acceleration * period;
+    lane_l *= FLAGS_go_approach_rate;
+  }
+  DrawLaneSequenceTrajectory(lane_sequence, lane_segment_index, lane_s, period,
+                             lane_states, points);
+}
+
+void SequencePredictor::DrawLaneSequenceTrajectory(
+    const LaneSequence& lane_sequence, const int lane_segment_index,
+    const double lane_s, const double period,
+    const std::vector<LaneState>& lane_states,
+    std::vector<TrajectoryPoint>* points) {
+  std::vector<std::shared_ptr<const LaneInfo>> lanes;
+  lanes.reserve(lane_sequence.lane_segment_size() - lane_segment_index);
+  for (int i = lane_segment_index; i < lane_sequence.lane_segment_size();
+       ++i) {
+    const std::string& lane_id = lane_sequence.lane_segment(i).lane_id();
+    std::shared_ptr<const LaneInfo> lane_info =
+        PredictionMap::LaneById(lane_id);
+    if (lane_info == nullptr) {
+      AERROR << "Unable to find lane [" << lane_id << "]";
+      break;
+    }
+    lanes.push_back(std::move(lane_info));
+  }
+  if (lanes.empty()) {
+    return;
+  }
 
-    while (lane_s > PredictionMap::LaneById(lane_id)->total_length() &&
-           lane_segment_index + 1 < lane_sequence.lane_segment_size()) {
-      lane_segment_index += 1;
-      lane_s = lane_s - PredictionMap::LaneById(lane_id)->total_length();
-      lane_id = lane_sequence.lane_segment(lane_segment_index).lane_id();
+  points->reserve(points->size() + lane_states.size());
+  size_t lane_index = 0;
+  double s = lane_s;
+  for (size_t i = 0; i < lane_states.size(); ++i) {
+    const LaneState& lane_state = lane_states[i];
+    s += lane_state.ds;
+    while (s > lanes[lane_index]->total_length() &&
+           lane_index + 1 < lanes.size()) {
+      s -= lanes[lane_index]->total_length();
+      ++lane_index;
     }
+    const LaneInfo& lane_info = *lanes[lane_index];
+    // the smooth point is on the center line, so the heading at its s is the
+    // one its projection would give
+    const double point_s =
+        common::math::Clamp(s, 0.0, lane_info.total_length());
+    const common::PointENU center = lane_info.GetSmoothPoint(point_s);
+    const double theta = lane_info.Heading(point_s);
 
-    lane_l *= FLAGS_go_approach_rate;
+    TrajectoryPoint trajectory_point;
+    PathPoint* path_point = trajectory_point.mutable_path_point();
+    path_point->set_x(center.x() - std::sin(theta) * lane_state.l);
+    path_point->set_y(center.y() + std::cos(theta) * lane_state.l);
+    path_point->set_z(0.0);
+    path_point->set_theta(theta);
+    path_point->set_lane_id(lane_info.id().id());
+    trajectory_point.set_v(lane_state.v);
+    trajectory_point.set_a(lane_state.a);
+    trajectory_point.set_relative_time(static_cast<double>(i) * period);
+    points->emplace_back(std::move(trajectory_point));
   }
 }
 
@@ -42,6 +42,17 @@ class SequencePredictor : public Predictor {
     INVALID,
   };
 
+  /**
+   * @brief State of a trajectory point along a lane sequence
+   */
+  struct LaneState {
+    // distance along the lane sequence from the previous point
+    double ds = 0.0;
+    double l = 0.0;
+    double v = 0.0;
+    double a = 0.0;
+  };
+
  public:
   /**
    * @brief Constructor
@@ -124,6 +135,22 @@ class SequencePredictor : public Predictor {
       const double total_time, const double period, const double acceleration,
       std::vector<apollo::common::TrajectoryPoint>* points);
 
+  /**
+   * @brief Draw trajectory points along a lane sequence from their states,
+   *        the lanes are looked up once for all the points
+   * @param Lane sequence
+   * @param Index of the lane segment of the first point
+   * @param Lane s of the first point before its distance is added
+   * @param Prediction period
+   * @param Lane states of the trajectory points
+   * @param A vector of generated trajectory points
+   */
+  static void DrawLaneSequenceTrajectory(
+      const LaneSequence& lane_sequence, const int lane_segment_index,
+      const double lane_s, const double period,
+      const std::vector<LaneState>& lane_states,
+      std::vector<apollo::common::TrajectoryPoint>* points);
+
   /**
    * @brief Get lane sequence curvature by s
    * @param lane sequence
@@ -30,5 +30,17 @@ DEFINE_double(min_length_for_lane_change, 1.0,
 DEFINE_bool(enable_change_lane_in_result, true,
             "contain change lane operator in result");
 
+DEFINE_bool(enable_landmark_heuristic, false,
+            "precompute costs to and from landmark lanes when the topo graph "
+            "is loaded, and search with the landmark lower bounds as the A* "
+            "heuristic");
+
+DEFINE_int32(routing_landmark_num, 8,
+             "number of landmark lanes for the landmark heuristic");
+
+DEFINE_bool(enable_routing_leg_reuse, true,
+            "reuse the route between two way points from the previous "
+            "request when both way points and the black list are unchanged");
+
 DEFINE_uint32(routing_response_history_interval_ms, 1000,
               "ms, emit routing resposne for this time interval");
@@ -16,10 +16,13 @@
 
 #include "modules/routing/core/navigator.h"
 
+#include <utility>
+
 #include "cyber/common/file.h"
 #include "modules/routing/common/routing_gflags.h"
 #include "modules/routing/graph/sub_topo_graph.h"
 #include "modules/routing/strategy/a_star_strategy.h"
+#include "modules/routing/strategy/landmark_a_star_strategy.h"
 
 namespace apollo {
 namespace routing {
@@ -105,6 +108,13 @@ Navigator::Navigator(const std::string& topo_file_path) {
           << topo_file_path;
     return;
   }
+  if (FLAGS_enable_landmark_heuristic) {
+    landmarks_.reset(new TopoLandmarks());
+    if (!landmarks_->Build(*graph_, FLAGS_routing_landmark_num)) {
+      AWARN << "Failed to build routing landmarks, fall back to A* search.";
+      landmarks_.reset();
+    }
+  }
   black_list_generator_.reset(new BlackListRangeGenerator);
   result_generator_.reset(new ResultGenerator);
   is_ready_ = true;
@@ -127,9 +137,29 @@ bool Navigator::Init(const RoutingRequest& request, const TopoGraph* graph,
   }
   black_list_generator_->GenerateBlackMapFromRequest(request, graph_.get(),
                                                      &topo_range_manager_);
+  RoutingRequest black_list;
+  *black_list.mutable_blacklisted_lane() = request.blacklisted_lane();
+  *black_list.mutable_blacklisted_road() = request.blacklisted_road();
+  black_list_key_ = black_list.SerializeAsString();
   return true;
 }
 
+const Navigator::RouteLeg* Navigator::FindPreviousLeg(
+    const TopoNode* start_node, double start_s, const TopoNode* end_node,
+    double end_s) const {
+  if (!FLAGS_enable_routing_leg_reuse ||
+      black_list_key_ != previous_black_list_key_) {
+    return nullptr;
+  }
+  for (const auto& leg : previous_legs_) {
+    if (leg.start_node == start_node && leg.start_s == start_s &&
+        leg.end_node == end_node && leg.end_s == end_s) {
+      return &leg;
+    }
+  }
+  return nullptr;
+}
+
 bool Navigator::MergeRoute(
     const std::vector<NodeWithRange>& node_vec,
     std::vector<NodeWithRange>* const result_node_vec) const {
@@ -151,18 +181,41 @@ bool Navigator::MergeRoute(
 bool Navigator::SearchRouteByStrategy(
     const TopoGraph* graph, const std::vector<const TopoNode*>& way_nodes,
     const std::vector<double>& way_s,
-    std::vector<NodeWithRange>* const result_nodes) const {
+    std::vector<NodeWithRange>* const result_nodes) {
   std::unique_ptr<Strategy> strategy_ptr;
-  strategy_ptr.reset(new AStarStrategy(FLAGS_enable_change_lane_in_result));
+  if (landmarks_ != nullptr) {
+    strategy_ptr.reset(new LandmarkAStarStrategy(
+        FLAGS_enable_change_lane_in_result, landmarks_.get()));
+  } else {
+    strategy_ptr.reset(new AStarStrategy(FLAGS_enable_change_lane_in_result));
+  }
 
   result_nodes->clear();
   std::vector<NodeWithRange> node_vec;
+  std::vector<RouteLeg> legs;
   for (size_t i = 1; i < way_nodes.size(); ++i) {
     const auto* way_start = way_nodes[i - 1];
     const auto* way_end = way_nodes[i];
     double way_start_s = way_s[i - 1];
     double way_end_s = way_s[i];
 
+    RouteLeg leg;
+    leg.start_node = way_start;
+    leg.start_s = way_start_s;
+    leg.end_node = way_end;
+    leg.end_s = way_end_s;
+    const auto* previous_leg =
+        FindPreviousLeg(way_start, way_start_s, way_end, way_end_s);
+    if (previous_leg != nullptr) {
+      ADEBUG << "Reuse route from " << way_start->LaneId() << " to "
+             << way_end->LaneId();
+      leg.result_nodes = previous_leg->result_nodes;
+      node_vec.insert(node_vec.end(), leg.result_nodes.begin(),
+                      leg.result_nodes.end());
+      legs.push_back(std::move(leg));
+      continue;
+    }
+
     TopoRangeManager full_range_manager = topo_range_manager_;
     black_list_generator_->AddBlackMapFromTerminal(
         way_start, way_end, way_start_s, way_end_s, &full_range_manager);
@@ -191,7 +244,11 @@ bool Navigator::SearchRouteByStrategy(
 
     node_vec.insert(node_vec.end(), cur_result_nodes.begin(),
                     cur_result_nodes.end());
+    leg.result_nodes = std::move(cur_result_nodes);
+    legs.push_back(std::move(leg));
   }
+  previous_legs_ = std::move(legs);
+  previous_black_list_key_ = black_list_key_;
 
   if (!MergeRoute(node_vec, result_nodes)) {
     AERROR << "Failed to merge route.";
@@ -22,6 +22,7 @@
 
 #include "modules/routing/core/black_list_range_generator.h"
 #include "modules/routing/core/result_generator.h"
+#include "modules/routing/graph/topo_landmarks.h"
 
 namespace apollo {
 namespace routing {
@@ -43,20 +44,42 @@ class Navigator {
 
   void Clear();
 
-  bool SearchRouteByStrategy(
-      const TopoGraph* graph, const std::vector<const TopoNode*>& way_nodes,
-      const std::vector<double>& way_s,
-      std::vector<NodeWithRange>* const result_nodes) const;
+  bool SearchRouteByStrategy(const TopoGraph* graph,
+                             const std::vector<const TopoNode*>& way_nodes,
+                             const std::vector<double>& way_s,
+                             std::vector<NodeWithRange>* const result_nodes);
 
   bool MergeRoute(const std::vector<NodeWithRange>& node_vec,
                   std::vector<NodeWithRange>* const result_node_vec) const;
 
+ private:
+  // The route between two consecutive way points of a request.
+  struct RouteLeg {
+    const TopoNode* start_node = nullptr;
+    double start_s = 0.0;
+    const TopoNode* end_node = nullptr;
+    double end_s = 0.0;
+    std::vector<NodeWithRange> result_nodes;
+  };
+
+  const RouteLeg* FindPreviousLeg(const TopoNode* start_node, double start_s,
+                                  const TopoNode* end_node,
+                                  double end_s) const;
+
  private:
   bool is_ready_ = false;
   std::unique_ptr<TopoGraph> graph_;
+  // only built when FLAGS_enable_landmark_heuristic is set
+  std::unique_ptr<TopoLandmarks> landmarks_;
 
   TopoRangeManager topo_range_manager_;
 
+  // Legs of the previous request, reused by a rerouting request with the same
+  // black list, which usually only moves the first way point.
+  std::vector<RouteLeg> previous_legs_;
+  std::string previous_black_list_key_;
+  std::string black_list_key_;
+
   std::unique_ptr<BlackListRangeGenerator> black_list_generator_;
   std::unique_ptr<ResultGenerator> result_generator_;
 };
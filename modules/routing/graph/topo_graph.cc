@@ -88,6 +88,10 @@ const std::string& TopoGraph::MapVersion() const { return map_version_; }
 
 const std::string& TopoGraph::MapDistrict() const { return map_district_; }
 
+const std::vector<std::shared_ptr<TopoNode> >& TopoGraph::Nodes() const {
+  return topo_nodes_;
+}
+
 const TopoNode* TopoGraph::GetNode(const std::string& id) const {
   const auto& iter = node_index_map_.find(id);
   if (iter == node_index_map_.end()) {
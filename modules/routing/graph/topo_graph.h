@@ -38,6 +38,7 @@ class TopoGraph {
   const std::string& MapVersion() const;
   const std::string& MapDistrict() const;
   const TopoNode* GetNode(const std::string& id) const;
+  const std::vector<std::shared_ptr<TopoNode> >& Nodes() const;
   void GetNodesByRoadId(
       const std::string& road_id,
       std::unordered_set<const TopoNode*>* const node_in_road) const;
@@ -0,0 +1,167 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/routing/graph/topo_landmarks.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+
+namespace apollo {
+namespace routing {
+
+namespace {
+
+constexpr double kInfinity = std::numeric_limits<double>::infinity();
+
+// The cost of an edge as accumulated by AStarStrategy. Lane changes subtract
+// half of the node costs there, which may turn negative, so they are
+// clamped at zero to keep Dijkstra valid and the bound a lower one.
+double EdgeCost(const TopoEdge* edge) {
+  double cost = edge->Cost() + edge->ToNode()->Cost();
+  if (edge->Type() != TopoEdgeType::TET_FORWARD) {
+    cost -= (edge->FromNode()->Cost() + edge->ToNode()->Cost()) / 2;
+  }
+  return std::max(0.0, cost);
+}
+
+double SquaredDistance(const TopoNode* node_1, const TopoNode* node_2) {
+  const double dx = node_1->AnchorPoint().x() - node_2->AnchorPoint().x();
+  const double dy = node_1->AnchorPoint().y() - node_2->AnchorPoint().y();
+  return dx * dx + dy * dy;
+}
+
+}  // namespace
+
+bool TopoLandmarks::Build(const TopoGraph& graph, const int num_landmarks) {
+  node_index_.clear();
+  landmarks_.clear();
+  cost_from_landmark_.clear();
+  cost_to_landmark_.clear();
+  const auto& nodes = graph.Nodes();
+  if (nodes.empty() || num_landmarks <= 0) {
+    return false;
+  }
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    node_index_[nodes[i].get()] = static_cast<int>(i);
+  }
+
+  // Farthest point selection on anchor points spreads the landmarks to the
+  // border of the map, where they bound the most queries.
+  std::vector<double> min_squared_distance(nodes.size(), kInfinity);
+  std::vector<bool> selected(nodes.size(), false);
+  const TopoNode* reference = nodes.front().get();
+  const size_t max_landmarks =
+      std::min(nodes.size(), static_cast<size_t>(num_landmarks));
+  while (landmarks_.size() < max_landmarks) {
+    int best = -1;
+    double best_distance = -1.0;
+    for (size_t i = 0; i < nodes.size(); ++i) {
+      if (selected[i]) {
+        continue;
+      }
+      const double distance =
+          landmarks_.empty() ? SquaredDistance(nodes[i].get(), reference)
+                             : min_squared_distance[i];
+      if (distance > best_distance) {
+        best = static_cast<int>(i);
+        best_distance = distance;
+      }
+    }
+    selected[best] = true;
+    const TopoNode* landmark = nodes[best].get();
+    landmarks_.push_back(landmark);
+    for (size_t i = 0; i < nodes.size(); ++i) {
+      min_squared_distance[i] = std::min(
+          min_squared_distance[i], SquaredDistance(nodes[i].get(), landmark));
+    }
+  }
+
+  cost_from_landmark_.resize(landmarks_.size());
+  cost_to_landmark_.resize(landmarks_.size());
+  for (size_t i = 0; i < landmarks_.size(); ++i) {
+    ComputeCosts(landmarks_[i], true, &cost_from_landmark_[i]);
+    ComputeCosts(landmarks_[i], false, &cost_to_landmark_[i]);
+  }
+  AINFO << "Built " << landmarks_.size() << " routing landmarks over "
+        << nodes.size() << " nodes.";
+  return true;
+}
+
+void TopoLandmarks::ComputeCosts(const TopoNode* landmark, const bool forward,
+                                 std::vector<double>* const costs) const {
+  costs->assign(node_index_.size(), kInfinity);
+  using QueueItem = std::pair<double, const TopoNode*>;
+  std::priority_queue<QueueItem, std::vector<QueueItem>,
+                      std::greater<QueueItem>>
+      open_set;
+  (*costs)[node_index_.at(landmark)] = 0.0;
+  open_set.emplace(0.0, landmark);
+  while (!open_set.empty()) {
+    const auto item = open_set.top();
+    open_set.pop();
+    if (item.first > (*costs)[node_index_.at(item.second)]) {
+      continue;
+    }
+    const auto& edges =
+        forward ? item.second->OutToAllEdge() : item.second->InFromAllEdge();
+    for (const auto* edge : edges) {
+      const auto* next_node = forward ? edge->ToNode() : edge->FromNode();
+      const auto iter = node_index_.find(next_node);
+      if (iter == node_index_.end()) {
+        continue;
+      }
+      const double cost = item.first + EdgeCost(edge);
+      if (cost < (*costs)[iter->second]) {
+        (*costs)[iter->second] = cost;
+        open_set.emplace(cost, next_node);
+      }
+    }
+  }
+}
+
+double TopoLandmarks::LowerBound(const TopoNode* from_node,
+                                 const TopoNode* to_node) const {
+  const auto from_iter = node_index_.find(from_node->OriginNode());
+  const auto to_iter = node_index_.find(to_node->OriginNode());
+  if (from_iter == node_index_.end() || to_iter == node_index_.end()) {
+    return 0.0;
+  }
+  const int from = from_iter->second;
+  const int to = to_iter->second;
+  double bound = 0.0;
+  for (size_t i = 0; i < landmarks_.size(); ++i) {
+    // cost(from, to) >= cost(from, landmark) - cost(to, landmark)
+    const double to_landmark_from = cost_to_landmark_[i][from];
+    const double to_landmark_to = cost_to_landmark_[i][to];
+    if (std::isfinite(to_landmark_from) && std::isfinite(to_landmark_to)) {
+      bound = std::max(bound, to_landmark_from - to_landmark_to);
+    }
+    // cost(from, to) >= cost(landmark, to) - cost(landmark, from)
+    const double from_landmark_from = cost_from_landmark_[i][from];
+    const double from_landmark_to = cost_from_landmark_[i][to];
+    if (std::isfinite(from_landmark_from) && std::isfinite(from_landmark_to)) {
+      bound = std::max(bound, from_landmark_to - from_landmark_from);
+    }
+  }
+  return bound;
+}
+
+}  // namespace routing
+}  // namespace apollo
@@ -0,0 +1,63 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+
+#include "modules/routing/graph/topo_graph.h"
+
+namespace apollo {
+namespace routing {
+
+/**
+ * @brief Costs from and to a few landmark nodes, computed once per topo
+ * graph. By the triangle inequality they give a lower bound of the cost
+ * between any two nodes, which is a far tighter A* heuristic than the
+ * distance between anchor points on a large map.
+ */
+class TopoLandmarks {
+ public:
+  TopoLandmarks() = default;
+
+  bool Build(const TopoGraph& graph, const int num_landmarks);
+
+  /**
+   * @brief Lower bound of the cost from one node to another. Sub nodes use
+   * the bound of their origin nodes. Lanes blacklisted at query time only
+   * remove edges, which never lowers the true cost, so no rebuild is needed.
+   */
+  double LowerBound(const TopoNode* from_node, const TopoNode* to_node) const;
+
+  size_t NumLandmarks() const { return landmarks_.size(); }
+
+ private:
+  // costs[i] of node i from or to the landmark, infinity if unreachable
+  void ComputeCosts(const TopoNode* landmark, const bool forward,
+                    std::vector<double>* const costs) const;
+
+ private:
+  std::unordered_map<const TopoNode*, int> node_index_;
+  std::vector<const TopoNode*> landmarks_;
+  // [landmark][node], cost from the landmark to the node
+  std::vector<std::vector<double>> cost_from_landmark_;
+  // [landmark][node], cost from the node to the landmark
+  std::vector<std::vector<double>> cost_to_landmark_;
+};
+
+}  // namespace routing
+}  // namespace apollo
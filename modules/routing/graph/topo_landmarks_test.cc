@@ -0,0 +1,81 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/routing/graph/topo_landmarks.h"
+
+#include "gtest/gtest.h"
+#include "modules/routing/graph/topo_test_utils.h"
+
+namespace apollo {
+namespace routing {
+
+namespace {
+
+// forward edges cost the edge and the lane, lane changes the edge only
+constexpr double kForwardCost = TEST_EDGE_COST + TEST_LANE_COST;
+constexpr double kLaneChangeCost = TEST_EDGE_COST;
+
+}  // namespace
+
+TEST(TopoLandmarksTestSuit, exact_bound_with_all_landmarks) {
+  Graph graph;
+  GetGraph3ForTest(&graph);
+  TopoGraph topo_graph;
+  ASSERT_TRUE(topo_graph.LoadGraph(graph));
+
+  TopoLandmarks landmarks;
+  ASSERT_TRUE(landmarks.Build(topo_graph, 10));
+  EXPECT_EQ(6, landmarks.NumLandmarks());
+
+  const auto* node_1 = topo_graph.GetNode(TEST_L1);
+  const auto* node_4 = topo_graph.GetNode(TEST_L4);
+  const auto* node_6 = topo_graph.GetNode(TEST_L6);
+  EXPECT_DOUBLE_EQ(0.0, landmarks.LowerBound(node_1, node_1));
+  EXPECT_NEAR(kForwardCost + kLaneChangeCost,
+              landmarks.LowerBound(node_1, node_4), 1e-9);
+  EXPECT_NEAR(2 * kForwardCost + kLaneChangeCost,
+              landmarks.LowerBound(node_1, node_6), 1e-9);
+  // unreachable nodes have no bound
+  EXPECT_DOUBLE_EQ(0.0, landmarks.LowerBound(node_6, node_1));
+}
+
+TEST(TopoLandmarksTestSuit, lower_bound_with_few_landmarks) {
+  Graph graph;
+  GetGraph3ForTest(&graph);
+  TopoGraph topo_graph;
+  ASSERT_TRUE(topo_graph.LoadGraph(graph));
+
+  TopoLandmarks landmarks;
+  ASSERT_FALSE(landmarks.Build(topo_graph, 0));
+  ASSERT_TRUE(landmarks.Build(topo_graph, 2));
+  EXPECT_EQ(2, landmarks.NumLandmarks());
+
+  const auto* node_1 = topo_graph.GetNode(TEST_L1);
+  const auto* node_3 = topo_graph.GetNode(TEST_L3);
+  const auto* node_4 = topo_graph.GetNode(TEST_L4);
+  const auto* node_6 = topo_graph.GetNode(TEST_L6);
+  constexpr double kEpsilon = 1e-9;
+  EXPECT_LE(landmarks.LowerBound(node_1, node_3), kForwardCost + kEpsilon);
+  EXPECT_LE(landmarks.LowerBound(node_1, node_4),
+            kForwardCost + kLaneChangeCost + kEpsilon);
+  EXPECT_LE(landmarks.LowerBound(node_3, node_6),
+            kForwardCost + kLaneChangeCost + kEpsilon);
+  EXPECT_LE(landmarks.LowerBound(node_1, node_6),
+            2 * kForwardCost + kLaneChangeCost + kEpsilon);
+}
+
+}  // namespace routing
+}  // namespace apollo
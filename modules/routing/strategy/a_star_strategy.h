@@ -28,15 +28,18 @@ namespace routing {
 class AStarStrategy : public Strategy {
  public:
   explicit AStarStrategy(bool enable_change);
-  ~AStarStrategy() = default;
+  virtual ~AStarStrategy() = default;
 
   virtual bool Search(const TopoGraph* graph, const SubTopoGraph* sub_graph,
                       const TopoNode* src_node, const TopoNode* dest_node,
                       std::vector<NodeWithRange>* const result_nodes);
 
+ protected:
+  virtual double HeuristicCost(const TopoNode* src_node,
+                               const TopoNode* dest_node);
+
  private:
   void Clear();
-  double HeuristicCost(const TopoNode* src_node, const TopoNode* dest_node);
   double GetResidualS(const TopoNode* node);
   double GetResidualS(const TopoEdge* edge, const TopoNode* to_node);
 
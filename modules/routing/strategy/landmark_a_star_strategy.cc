@@ -0,0 +1,32 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/routing/strategy/landmark_a_star_strategy.h"
+
+namespace apollo {
+namespace routing {
+
+LandmarkAStarStrategy::LandmarkAStarStrategy(bool enable_change,
+                                             const TopoLandmarks* landmarks)
+    : AStarStrategy(enable_change), landmarks_(landmarks) {}
+
+double LandmarkAStarStrategy::HeuristicCost(const TopoNode* src_node,
+                                            const TopoNode* dest_node) {
+  return landmarks_->LowerBound(src_node, dest_node);
+}
+
+}  // namespace routing
+}  // namespace apollo
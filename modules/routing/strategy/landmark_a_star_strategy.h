@@ -0,0 +1,46 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include <vector>
+
+#include "modules/routing/graph/topo_landmarks.h"
+#include "modules/routing/strategy/a_star_strategy.h"
+
+namespace apollo {
+namespace routing {
+
+/**
+ * @brief A* search guided by the landmark lower bounds of the topo graph.
+ * Blacklisted lanes are filtered by the sub graph at query time, the same way
+ * as AStarStrategy.
+ */
+class LandmarkAStarStrategy : public AStarStrategy {
+ public:
+  LandmarkAStarStrategy(bool enable_change, const TopoLandmarks* landmarks);
+  ~LandmarkAStarStrategy() = default;
+
+ protected:
+  double HeuristicCost(const TopoNode* src_node,
+                       const TopoNode* dest_node) override;
+
+ private:
+  const TopoLandmarks* landmarks_ = nullptr;
+};
+
+}  // namespace routing
+}  // namespace apollo
@@ -20,3 +20,7 @@ DEFINE_double(search_radius, 1.0, "Search radius for a junction");
 
 DEFINE_double(adc_trajectory_search_distance, 10.0,
               "How far to search junction along adc planning trajectory");
+
+DEFINE_double(map_element_prefetch_distance, 50.0,
+              "Extra distance to fetch map elements around adc planning "
+              "trajectory for, so that they are reused while adc moves");
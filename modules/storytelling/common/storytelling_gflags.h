@@ -20,3 +20,4 @@
 
 DECLARE_double(search_radius);
 DECLARE_double(adc_trajectory_search_distance);
+DECLARE_double(map_element_prefetch_distance);
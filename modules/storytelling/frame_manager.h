@@ -21,6 +21,7 @@
 
 #include "cyber/common/macros.h"
 #include "modules/common/monitor_log/monitor_log_buffer.h"
+#include "modules/storytelling/trajectory_map_context.h"
 
 namespace apollo {
 namespace storytelling {
@@ -35,6 +36,7 @@ class FrameManager {
 
   // Getters.
   apollo::common::monitor::MonitorLogBuffer& LogBuffer() { return log_buffer_; }
+  TrajectoryMapContext& MapContext() { return map_context_; }
 
   // Cyber reader / writer creator.
   template <class T>
@@ -51,6 +53,7 @@ class FrameManager {
 
  private:
   apollo::common::monitor::MonitorLogBuffer log_buffer_;
+  TrajectoryMapContext map_context_;
   std::shared_ptr<cyber::Node> node_;
 };
 
@@ -17,7 +17,6 @@
 #pragma once
 
 #include <memory>
-#include <string>
 
 #include "modules/planning/proto/planning.pb.h"
 #include "modules/storytelling/story_tellers/base_teller.h"
@@ -35,23 +34,6 @@ class CloseToJunctionTeller : public BaseTeller {
   void Update(Stories* stories) override;
 
  private:
-  void GetOverlaps(const apollo::planning::ADCTrajectory& adc_trajectory);
-
- private:
-  std::string clear_area_id_;
-  double clear_area_distance_;
-  std::string crosswalk_id_;
-  double crosswalk_distance_;
-  std::string junction_id_;
-  double junction_distance_;
-  std::string pnc_junction_id_;
-  double pnc_junction_distance_;
-  std::string signal_id_;
-  double signal_distance_;
-  std::string stop_sign_id_;
-  double stop_sign_distance_;
-  std::string yield_sign_id_;
-  double yield_sign_distance_;
   StorytellingConfig config_;
 };
 
@@ -0,0 +1,193 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/storytelling/trajectory_map_context.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "cyber/common/log.h"
+#include "modules/map/hdmap/hdmap_util.h"
+#include "modules/storytelling/common/storytelling_gflags.h"
+
+namespace apollo {
+namespace storytelling {
+namespace {
+
+using apollo::common::math::Vec2d;
+using apollo::hdmap::ClearAreaInfoConstPtr;
+using apollo::hdmap::CrosswalkInfoConstPtr;
+using apollo::hdmap::HDMapUtil;
+using apollo::hdmap::JunctionInfoConstPtr;
+using apollo::hdmap::PNCJunctionInfoConstPtr;
+using apollo::hdmap::SignalInfoConstPtr;
+using apollo::hdmap::StopSignInfoConstPtr;
+using apollo::hdmap::YieldSignInfoConstPtr;
+using apollo::planning::ADCTrajectory;
+
+// The distances are the ones HDMap queries use, to the polygon of junctions,
+// crosswalks and clear areas, and to the stop lines of signals and signs.
+template <class InfoConstPtr>
+double PolygonDistanceSquare(const InfoConstPtr& info, const Vec2d& point) {
+  return info->polygon().DistanceSquareTo(point);
+}
+
+template <class InfoConstPtr>
+double SegmentsDistanceSquare(const InfoConstPtr& info, const Vec2d& point) {
+  double distance_square = std::numeric_limits<double>::infinity();
+  for (const auto& segment : info->segments()) {
+    distance_square =
+        std::min(distance_square, segment.DistanceSquareTo(point));
+  }
+  return distance_square;
+}
+
+/**
+ * @brief Finds the first trajectory point within search radius of any of the
+ * candidates, and the nearest candidate to it.
+ */
+template <class InfoConstPtr, class DistanceSquare>
+void FindFirst(const std::vector<InfoConstPtr>& candidates,
+               const std::vector<Vec2d>& points,
+               const std::vector<double>& distances,
+               const DistanceSquare& distance_square,
+               TrajectoryMapElement* element) {
+  *element = TrajectoryMapElement();
+  if (candidates.empty()) {
+    return;
+  }
+  const double search_radius_square = FLAGS_search_radius * FLAGS_search_radius;
+  for (size_t i = 0; i < points.size(); ++i) {
+    const InfoConstPtr* nearest = nullptr;
+    double nearest_distance_square = search_radius_square;
+    for (const auto& candidate : candidates) {
+      const double candidate_distance_square =
+          distance_square(candidate, points[i]);
+      if (candidate_distance_square <= nearest_distance_square) {
+        nearest = &candidate;
+        nearest_distance_square = candidate_distance_square;
+      }
+    }
+    if (nearest != nullptr) {
+      element->id = (*nearest)->id().id();
+      element->distance = distances[i];
+      return;
+    }
+  }
+}
+
+}  // namespace
+
+void TrajectoryMapContext::Update(const ADCTrajectory& adc_trajectory) {
+  const auto& header = adc_trajectory.header();
+  if (header.timestamp_sec() == trajectory_timestamp_ &&
+      header.sequence_num() == trajectory_sequence_num_) {
+    return;
+  }
+  trajectory_timestamp_ = header.timestamp_sec();
+  trajectory_sequence_num_ = header.sequence_num();
+
+  // The trajectory points to search from, and their distance from the start.
+  std::vector<Vec2d> points;
+  std::vector<double> distances;
+  if (adc_trajectory.trajectory_point_size() > 0) {
+    const double s_start = adc_trajectory.trajectory_point(0).path_point().s();
+    for (const auto& point : adc_trajectory.trajectory_point()) {
+      const auto& path_point = point.path_point();
+      if (path_point.s() > FLAGS_adc_trajectory_search_distance) {
+        break;
+      }
+      points.emplace_back(path_point.x(), path_point.y());
+      distances.push_back(path_point.s() - s_start);
+    }
+  }
+  if (points.empty()) {
+    clear_area_ = TrajectoryMapElement();
+    crosswalk_ = TrajectoryMapElement();
+    junction_ = TrajectoryMapElement();
+    pnc_junction_ = TrajectoryMapElement();
+    signal_ = TrajectoryMapElement();
+    stop_sign_ = TrajectoryMapElement();
+    yield_sign_ = TrajectoryMapElement();
+    return;
+  }
+
+  // Every element within search radius of the points is within this radius
+  // of the first point, so the candidates fetched before still cover them if
+  // this circle is inside the fetched one.
+  double radius = 0.0;
+  for (const auto& point : points) {
+    radius = std::max(radius, point.DistanceTo(points.front()));
+  }
+  radius += FLAGS_search_radius;
+  if (!fetched_ ||
+      points.front().DistanceTo(fetch_center_) + radius > fetch_radius_) {
+    FetchCandidates(points.front(),
+                    radius + FLAGS_map_element_prefetch_distance);
+  }
+
+  FindFirst(clear_areas_, points, distances,
+            PolygonDistanceSquare<ClearAreaInfoConstPtr>, &clear_area_);
+  FindFirst(crosswalks_, points, distances,
+            PolygonDistanceSquare<CrosswalkInfoConstPtr>, &crosswalk_);
+  FindFirst(junctions_, points, distances,
+            PolygonDistanceSquare<JunctionInfoConstPtr>, &junction_);
+  FindFirst(pnc_junctions_, points, distances,
+            PolygonDistanceSquare<PNCJunctionInfoConstPtr>, &pnc_junction_);
+  FindFirst(signals_, points, distances,
+            SegmentsDistanceSquare<SignalInfoConstPtr>, &signal_);
+  FindFirst(stop_signs_, points, distances,
+            SegmentsDistanceSquare<StopSignInfoConstPtr>, &stop_sign_);
+  FindFirst(yield_signs_, points, distances,
+            SegmentsDistanceSquare<YieldSignInfoConstPtr>, &yield_sign_);
+}
+
+void TrajectoryMapContext::FetchCandidates(const Vec2d& center,
+                                           const double radius) {
+  const auto& hdmap = HDMapUtil::BaseMap();
+  common::PointENU hdmap_point;
+  hdmap_point.set_x(center.x());
+  hdmap_point.set_y(center.y());
+  if (hdmap.GetClearAreas(hdmap_point, radius, &clear_areas_) != 0) {
+    clear_areas_.clear();
+  }
+  if (hdmap.GetCrosswalks(hdmap_point, radius, &crosswalks_) != 0) {
+    crosswalks_.clear();
+  }
+  if (hdmap.GetJunctions(hdmap_point, radius, &junctions_) != 0) {
+    junctions_.clear();
+  }
+  if (hdmap.GetPNCJunctions(hdmap_point, radius, &pnc_junctions_) != 0) {
+    pnc_junctions_.clear();
+  }
+  if (hdmap.GetSignals(hdmap_point, radius, &signals_) != 0) {
+    signals_.clear();
+  }
+  if (hdmap.GetStopSigns(hdmap_point, radius, &stop_signs_) != 0) {
+    stop_signs_.clear();
+  }
+  if (hdmap.GetYieldSigns(hdmap_point, radius, &yield_signs_) != 0) {
+    yield_signs_.clear();
+  }
+  fetched_ = true;
+  fetch_center_ = center;
+  fetch_radius_ = radius;
+  ADEBUG << "Fetched map elements within " << radius << "m of "
+         << center.DebugString();
+}
+
+}  // namespace storytelling
+}  // namespace apollo
@@ -0,0 +1,93 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "modules/common/math/vec2d.h"
+#include "modules/map/hdmap/hdmap_common.h"
+#include "modules/planning/proto/planning.pb.h"
+
+namespace apollo {
+namespace storytelling {
+
+/**
+ * @brief The first map element of a type along the ADC trajectory.
+ */
+struct TrajectoryMapElement {
+  std::string id;
+  // Distance along the trajectory, or negative if there is none.
+  double distance = -1.0;
+
+  bool found() const { return !id.empty() && distance >= 0.0; }
+};
+
+/**
+ * @brief The map elements along the ADC trajectory, shared by all tellers.
+ *
+ * The elements around the trajectory are fetched from the HDMap with one
+ * query per type, over a radius which leaves some room to move, and are kept
+ * as long as the searched part of the trajectory stays within it. The
+ * trajectory points are then matched against these few candidates only.
+ * Updating with the trajectory of the last update is free, so every teller
+ * may update the context in the same frame.
+ */
+class TrajectoryMapContext {
+ public:
+  void Update(const apollo::planning::ADCTrajectory& adc_trajectory);
+
+  const TrajectoryMapElement& clear_area() const { return clear_area_; }
+  const TrajectoryMapElement& crosswalk() const { return crosswalk_; }
+  const TrajectoryMapElement& junction() const { return junction_; }
+  const TrajectoryMapElement& pnc_junction() const { return pnc_junction_; }
+  const TrajectoryMapElement& signal() const { return signal_; }
+  const TrajectoryMapElement& stop_sign() const { return stop_sign_; }
+  const TrajectoryMapElement& yield_sign() const { return yield_sign_; }
+
+ private:
+  void FetchCandidates(const apollo::common::math::Vec2d& center,
+                       const double radius);
+
+ private:
+  // The trajectory of the last update.
+  double trajectory_timestamp_ = -1.0;
+  uint32_t trajectory_sequence_num_ = 0;
+
+  // The map elements within fetch_radius_ of fetch_center_.
+  bool fetched_ = false;
+  apollo::common::math::Vec2d fetch_center_;
+  double fetch_radius_ = 0.0;
+  std::vector<apollo::hdmap::ClearAreaInfoConstPtr> clear_areas_;
+  std::vector<apollo::hdmap::CrosswalkInfoConstPtr> crosswalks_;
+  std::vector<apollo::hdmap::JunctionInfoConstPtr> junctions_;
+  std::vector<apollo::hdmap::PNCJunctionInfoConstPtr> pnc_junctions_;
+  std::vector<apollo::hdmap::SignalInfoConstPtr> signals_;
+  std::vector<apollo::hdmap::StopSignInfoConstPtr> stop_signs_;
+  std::vector<apollo::hdmap::YieldSignInfoConstPtr> yield_signs_;
+
+  TrajectoryMapElement clear_area_;
+  TrajectoryMapElement crosswalk_;
+  TrajectoryMapElement junction_;
+  TrajectoryMapElement pnc_junction_;
+  TrajectoryMapElement signal_;
+  TrajectoryMapElement stop_sign_;
+  TrajectoryMapElement yield_sign_;
+};
+
+}  // namespace storytelling
+}  // namespace apollo
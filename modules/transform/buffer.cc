@@ -31,7 +31,7 @@ constexpr float kSecondToNanoFactor = 1e9f;
 namespace apollo {
 namespace transform {
 
-Buffer::Buffer() : BufferCore() { Init(); }
+Buffer::Buffer() : BufferCore(), cache_(getCacheLength()) { Init(); }
 
 int Buffer::Init() {
   const std::string node_name =
@@ -74,9 +74,10 @@ void Buffer::SubscriptionCallbackImpl(
   if (now.ToNanosecond() < last_update_.ToNanosecond()) {
     AINFO << "Detected jump back in time. Clearing TF buffer.";
     clear();
+    cache_.Clear();
     // cache static transform stamped again.
     for (auto& msg : static_msgs_) {
-      setTransform(msg, authority, true);
+      SetTransform(msg, authority, true);
     }
   }
   last_update_ = now;
@@ -110,7 +111,7 @@ void Buffer::SubscriptionCallbackImpl(
       if (is_static) {
         static_msgs_.push_back(trans_stamped);
       }
-      setTransform(trans_stamped, authority, is_static);
+      SetTransform(trans_stamped, authority, is_static);
     } catch (tf2::TransformException& ex) {
       std::string temp = ex.what();
       AERROR << "Failure to set received transform:" << temp.c_str();
@@ -118,6 +119,14 @@ void Buffer::SubscriptionCallbackImpl(
   }
 }
 
+void Buffer::SetTransform(
+    const geometry_msgs::TransformStamped& trans_stamped,
+    const std::string& authority, bool is_static) {
+  if (setTransform(trans_stamped, authority, is_static)) {
+    cache_.SetTransform(trans_stamped, is_static);
+  }
+}
+
 bool Buffer::GetLatestStaticTF(const std::string& frame_id,
                                const std::string& child_frame_id,
                                TransformStamped* tf) {
@@ -168,8 +177,24 @@ TransformStamped Buffer::lookupTransform(const std::string& target_frame,
                                          const cyber::Time& time,
                                          const float timeout_second) const {
   tf2::Time tf2_time(time.ToNanosecond());
-  geometry_msgs::TransformStamped tf2_trans_stamped =
-      tf2::BufferCore::lookupTransform(target_frame, source_frame, tf2_time);
+  geometry_msgs::TransformStamped tf2_trans_stamped;
+  tf2::Transform transform;
+  if (cache_.LookupTransform(target_frame, source_frame, tf2_time, &transform,
+                             &tf2_trans_stamped.header.stamp)) {
+    tf2_trans_stamped.header.frame_id = target_frame;
+    tf2_trans_stamped.child_frame_id = source_frame;
+    const tf2::Quaternion rotation = transform.getRotation();
+    tf2_trans_stamped.transform.translation.x = transform.getOrigin().x();
+    tf2_trans_stamped.transform.translation.y = transform.getOrigin().y();
+    tf2_trans_stamped.transform.translation.z = transform.getOrigin().z();
+    tf2_trans_stamped.transform.rotation.x = rotation.x();
+    tf2_trans_stamped.transform.rotation.y = rotation.y();
+    tf2_trans_stamped.transform.rotation.z = rotation.z();
+    tf2_trans_stamped.transform.rotation.w = rotation.w();
+  } else {
+    tf2_trans_stamped =
+        tf2::BufferCore::lookupTransform(target_frame, source_frame, tf2_time);
+  }
   TransformStamped trans_stamped;
   TF2MsgToCyber(tf2_trans_stamped, trans_stamped);
   return trans_stamped;
@@ -194,6 +219,12 @@ bool Buffer::canTransform(const std::string& target_frame,
                           const std::string& source_frame,
                           const cyber::Time& time, const float timeout_second,
                           std::string* errstr) const {
+  tf2::Transform transform;
+  uint64_t stamp = 0;
+  if (cache_.LookupTransform(target_frame, source_frame, time.ToNanosecond(),
+                             &transform, &stamp)) {
+    return true;
+  }
   uint64_t timeout_ns =
       static_cast<uint64_t>(timeout_second * kSecondToNanoFactor);
   uint64_t start_time = Clock::Now().ToNanosecond();  // time.ToNanosecond();
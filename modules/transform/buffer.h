@@ -25,6 +25,7 @@
 
 #include "cyber/node/node.h"
 #include "modules/transform/buffer_interface.h"
+#include "modules/transform/transform_cache.h"
 
 namespace apollo {
 namespace transform {
@@ -127,6 +128,8 @@ class Buffer : public BufferInterface, public tf2::BufferCore {
 
   void TF2MsgToCyber(const geometry_msgs::TransformStamped& tf2_trans_stamped,
                      TransformStamped& trans_stamped) const;  // NOLINT
+  void SetTransform(const geometry_msgs::TransformStamped& trans_stamped,
+                    const std::string& authority, bool is_static);
 
   std::unique_ptr<cyber::Node> node_;
   std::shared_ptr<cyber::Reader<TransformStampeds>> message_subscriber_tf_;
@@ -136,6 +139,9 @@ class Buffer : public BufferInterface, public tf2::BufferCore {
   cyber::Time last_update_;
   std::vector<geometry_msgs::TransformStamped> static_msgs_;
 
+  // Answers the lookups without the lock of the BufferCore where it can.
+  TransformCache cache_;
+
   DECLARE_SINGLETON(Buffer)
 };  // class
 
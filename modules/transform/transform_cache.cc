@@ -0,0 +1,379 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/transform/transform_cache.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace apollo {
+namespace transform {
+
+namespace {
+
+// A reader retries this many times while the ring is written.
+constexpr int kMaxReadAttempts = 16;
+
+tf2::Transform ToTransform(const double values[7]) {
+  return tf2::Transform(
+      tf2::Quaternion(values[3], values[4], values[5], values[6]),
+      tf2::Vector3(values[0], values[1], values[2]));
+}
+
+bool IsSameTransform(const tf2::Transform& lhs, const tf2::Transform& rhs) {
+  return lhs.getOrigin() == rhs.getOrigin() &&
+         lhs.getBasis() == rhs.getBasis();
+}
+
+}  // namespace
+
+TransformRing::TransformRing()
+    : slots_(new Slot[kSize]), sequence_(0), count_(0) {}
+
+void TransformRing::Push(uint64_t stamp, const tf2::Transform& transform) {
+  uint64_t count = count_.load(std::memory_order_relaxed);
+  if (count > 0 &&
+      slots_[(count - 1) % kSize].stamp.load(std::memory_order_relaxed) >
+          stamp) {
+    count = 0;
+  }
+  const tf2::Quaternion rotation = transform.getRotation();
+  const tf2::Vector3& translation = transform.getOrigin();
+  const double values[7] = {translation.x(), translation.y(), translation.z(),
+                            rotation.x(),    rotation.y(),    rotation.z(),
+                            rotation.w()};
+
+  const uint64_t sequence = sequence_.load(std::memory_order_relaxed);
+  sequence_.store(sequence + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  Slot& slot = slots_[count % kSize];
+  slot.stamp.store(stamp, std::memory_order_relaxed);
+  for (int i = 0; i < 7; ++i) {
+    slot.values[i].store(values[i], std::memory_order_relaxed);
+  }
+  count_.store(count + 1, std::memory_order_relaxed);
+  sequence_.store(sequence + 2, std::memory_order_release);
+}
+
+void TransformRing::Reset() {
+  const uint64_t sequence = sequence_.load(std::memory_order_relaxed);
+  sequence_.store(sequence + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  count_.store(0, std::memory_order_relaxed);
+  sequence_.store(sequence + 2, std::memory_order_release);
+}
+
+bool TransformRing::GetLatestStamp(uint64_t* stamp) const {
+  for (int attempt = 0; attempt < kMaxReadAttempts; ++attempt) {
+    const uint64_t sequence = sequence_.load(std::memory_order_acquire);
+    if (sequence & 1) {
+      continue;
+    }
+    const uint64_t count = count_.load(std::memory_order_relaxed);
+    const uint64_t latest =
+        count == 0
+            ? 0
+            : slots_[(count - 1) % kSize].stamp.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (sequence_.load(std::memory_order_relaxed) == sequence) {
+      *stamp = latest;
+      return count > 0;
+    }
+  }
+  return false;
+}
+
+bool TransformRing::Interpolate(uint64_t time, uint64_t max_age,
+                                tf2::Transform* transform) const {
+  double one[7];
+  double two[7];
+  uint64_t one_stamp = 0;
+  uint64_t two_stamp = 0;
+  for (int attempt = 0; attempt < kMaxReadAttempts; ++attempt) {
+    const uint64_t sequence = sequence_.load(std::memory_order_acquire);
+    if (sequence & 1) {
+      continue;
+    }
+    // The slots from the oldest to the latest transform.
+    const uint64_t count = count_.load(std::memory_order_relaxed);
+    const uint64_t size = std::min<uint64_t>(count, kSize);
+    const auto slot = [&](uint64_t i) -> const Slot& {
+      return slots_[(count - size + i) % kSize];
+    };
+    const auto stamp = [&](uint64_t i) {
+      return slot(i).stamp.load(std::memory_order_relaxed);
+    };
+
+    bool found = false;
+    if (size > 0) {
+      // Find the first transform at or after the time.
+      uint64_t low = 0;
+      uint64_t high = size;
+      while (low < high) {
+        const uint64_t middle = (low + high) / 2;
+        if (stamp(middle) < time) {
+          low = middle + 1;
+        } else {
+          high = middle;
+        }
+      }
+      const uint64_t latest = stamp(size - 1);
+      const uint64_t oldest = latest > max_age ? latest - max_age : 0;
+      if (low < size) {
+        two_stamp = stamp(low);
+        one_stamp = two_stamp;
+        uint64_t one_index = low;
+        if (two_stamp != time && low > 0) {
+          one_index = low - 1;
+          one_stamp = stamp(one_index);
+        }
+        found = (two_stamp == time || low > 0) && one_stamp >= oldest;
+        for (int i = 0; found && i < 7; ++i) {
+          one[i] = slot(one_index).values[i].load(std::memory_order_relaxed);
+          two[i] = slot(low).values[i].load(std::memory_order_relaxed);
+        }
+      }
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (sequence_.load(std::memory_order_relaxed) != sequence) {
+      continue;
+    }
+    if (!found) {
+      return false;
+    }
+    if (one_stamp == two_stamp) {
+      *transform = ToTransform(two);
+      return true;
+    }
+    const tf2Scalar ratio = static_cast<tf2Scalar>(time - one_stamp) /
+                            static_cast<tf2Scalar>(two_stamp - one_stamp);
+    tf2::Vector3 translation;
+    translation.setInterpolate3(tf2::Vector3(one[0], one[1], one[2]),
+                                tf2::Vector3(two[0], two[1], two[2]), ratio);
+    const tf2::Quaternion rotation =
+        tf2::slerp(tf2::Quaternion(one[3], one[4], one[5], one[6]),
+                   tf2::Quaternion(two[3], two[4], two[5], two[6]), ratio);
+    *transform = tf2::Transform(rotation, translation);
+    return true;
+  }
+  return false;
+}
+
+TransformCache::TransformCache(uint64_t cache_time)
+    : cache_time_(cache_time), frames_(nullptr) {
+  Publish(std::unique_ptr<FrameMap>(new FrameMap()));
+}
+
+void TransformCache::SetTransform(
+    const geometry_msgs::TransformStamped& transform, bool is_static) {
+  const std::string& frame_id = transform.child_frame_id;
+  const std::string& parent_id = transform.header.frame_id;
+  // tf2 strips the leading slashes, the lookups of such frames are left to it.
+  if (frame_id[0] == '/' || parent_id[0] == '/') {
+    return;
+  }
+  const tf2::Transform value(
+      tf2::Quaternion(transform.transform.rotation.x,
+                      transform.transform.rotation.y,
+                      transform.transform.rotation.z,
+                      transform.transform.rotation.w),
+      tf2::Vector3(transform.transform.translation.x,
+                   transform.transform.translation.y,
+                   transform.transform.translation.z));
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  const FrameMap& frames = *frames_.load(std::memory_order_relaxed);
+  const auto iter = frames.find(frame_id);
+  const Frame* frame = iter == frames.end() ? nullptr : &iter->second;
+
+  if (frame != nullptr && frame->type == FrameType::DYNAMIC && !is_static &&
+      frame->parent == parent_id) {
+    frame->ring->Push(transform.header.stamp, value);
+    return;
+  }
+  if (frame != nullptr &&
+      (frame->type == FrameType::UNSUPPORTED ||
+       (frame->type == FrameType::STATIC && is_static &&
+        frame->parent == parent_id &&
+        IsSameTransform(frame->transform, value)))) {
+    return;
+  }
+
+  std::unique_ptr<FrameMap> updated(new FrameMap(frames));
+  Frame& updated_frame = (*updated)[frame_id];
+  if (frame != nullptr && frame->type != FrameType::ROOT &&
+      (frame->type == FrameType::STATIC) != is_static) {
+    // tf2 keeps the type of the first transform of a frame, the later ones of
+    // the other type are left to it.
+    updated_frame.type = FrameType::UNSUPPORTED;
+  } else if (is_static) {
+    updated_frame.type = FrameType::STATIC;
+    updated_frame.parent = parent_id;
+    updated_frame.transform = value;
+  } else {
+    auto& ring = rings_[std::make_pair(frame_id, parent_id)];
+    if (ring == nullptr) {
+      ring.reset(new TransformRing());
+    } else {
+      ring->Reset();
+    }
+    ring->Push(transform.header.stamp, value);
+    updated_frame.type = FrameType::DYNAMIC;
+    updated_frame.parent = parent_id;
+    updated_frame.ring = ring.get();
+  }
+  // The parent is a root until it has a transform itself.
+  updated->emplace(parent_id, Frame());
+  UpdateStaticRoots(updated.get());
+  Publish(std::move(updated));
+}
+
+void TransformCache::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto& ring : rings_) {
+    ring.second->Reset();
+  }
+}
+
+bool TransformCache::LookupTransform(const std::string& target_frame,
+                                     const std::string& source_frame,
+                                     uint64_t time, tf2::Transform* transform,
+                                     uint64_t* stamp) const {
+  if (target_frame == source_frame) {
+    return false;
+  }
+  const FrameMap& frames = *frames_.load(std::memory_order_acquire);
+  const auto target_iter = frames.find(target_frame);
+  const auto source_iter = frames.find(source_frame);
+  if (target_iter == frames.end() || source_iter == frames.end()) {
+    return false;
+  }
+
+  // Both frames are linked to a common ancestor by static transforms.
+  const Frame& target = target_iter->second;
+  const Frame& source = source_iter->second;
+  if (!source.static_root.empty() &&
+      source.static_root == target.static_root) {
+    *transform = target.static_transform.inverseTimes(source.static_transform);
+    *stamp = time;
+    return true;
+  }
+
+  const Frame* target_chain[kMaxDepth + 1];
+  const Frame* source_chain[kMaxDepth + 1];
+  int target_length = GetChain(frames, target_frame, target_chain);
+  int source_length = GetChain(frames, source_frame, source_chain);
+  if (target_length == 0 || source_length == 0 ||
+      target_chain[target_length - 1] != source_chain[source_length - 1]) {
+    return false;
+  }
+  // Keep the frames below the closest common ancestor.
+  while (target_length > 1 && source_length > 1 &&
+         target_chain[target_length - 2] == source_chain[source_length - 2]) {
+    --target_length;
+    --source_length;
+  }
+  --target_length;
+  --source_length;
+
+  if (time == 0) {
+    uint64_t common_time = std::numeric_limits<uint64_t>::max();
+    for (const auto& chain : {std::make_pair(target_chain, target_length),
+                              std::make_pair(source_chain, source_length)}) {
+      for (int i = 0; i < chain.second; ++i) {
+        uint64_t latest = 0;
+        if (chain.first[i]->type != FrameType::DYNAMIC) {
+          continue;
+        }
+        if (!chain.first[i]->ring->GetLatestStamp(&latest)) {
+          return false;
+        }
+        common_time = std::min(common_time, latest);
+      }
+    }
+    if (common_time != std::numeric_limits<uint64_t>::max()) {
+      time = common_time;
+    }
+  }
+
+  tf2::Transform target_transform;
+  tf2::Transform source_transform;
+  if (!Evaluate(target_chain, target_length, time, &target_transform) ||
+      !Evaluate(source_chain, source_length, time, &source_transform)) {
+    return false;
+  }
+  *transform = target_transform.inverseTimes(source_transform);
+  *stamp = time;
+  return true;
+}
+
+int TransformCache::GetChain(const FrameMap& frames,
+                             const std::string& frame_id,
+                             const Frame** chain) {
+  const std::string* id = &frame_id;
+  for (size_t length = 0; length <= kMaxDepth; ++length) {
+    const auto iter = frames.find(*id);
+    if (iter == frames.end() || iter->second.type == FrameType::UNSUPPORTED) {
+      return 0;
+    }
+    chain[length] = &iter->second;
+    if (iter->second.type == FrameType::ROOT) {
+      return static_cast<int>(length + 1);
+    }
+    id = &iter->second.parent;
+  }
+  return 0;
+}
+
+bool TransformCache::Evaluate(const Frame* const* chain, int length,
+                              uint64_t time, tf2::Transform* transform) const {
+  tf2::Transform edge;
+  transform->setIdentity();
+  for (int i = 0; i < length; ++i) {
+    if (chain[i]->type == FrameType::STATIC) {
+      edge = chain[i]->transform;
+    } else if (!chain[i]->ring->Interpolate(time, cache_time_, &edge)) {
+      return false;
+    }
+    *transform = edge * (*transform);
+  }
+  return true;
+}
+
+void TransformCache::UpdateStaticRoots(FrameMap* frames) {
+  for (auto& frame : *frames) {
+    tf2::Transform static_transform = tf2::Transform::getIdentity();
+    const std::string* root = &frame.first;
+    const Frame* ancestor = &frame.second;
+    size_t depth = 0;
+    while (ancestor->type == FrameType::STATIC && depth++ <= kMaxDepth) {
+      static_transform = ancestor->transform * static_transform;
+      root = &ancestor->parent;
+      ancestor = &frames->at(*root);
+    }
+    // A loop of static transforms is left to tf2.
+    frame.second.static_root = depth > kMaxDepth ? "" : *root;
+    frame.second.static_transform = static_transform;
+  }
+}
+
+void TransformCache::Publish(std::unique_ptr<FrameMap> frames) {
+  frames_.store(frames.get(), std::memory_order_release);
+  snapshots_.emplace_back(std::move(frames));
+}
+
+}  // namespace transform
+}  // namespace apollo
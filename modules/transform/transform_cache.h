@@ -0,0 +1,156 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "geometry_msgs/transform_stamped.h"
+#include "tf2/LinearMath/Transform.h"
+
+namespace apollo {
+namespace transform {
+
+/**
+ * @class TransformRing
+ * @brief The latest transforms of a frame to its parent, written by a single
+ *        thread and read without locks under a sequence counter.
+ */
+class TransformRing {
+ public:
+  static constexpr size_t kSize = 1024;
+
+  TransformRing();
+
+  /**@brief Append a transform, the ring restarts when it goes back in time. */
+  void Push(uint64_t stamp, const tf2::Transform& transform);
+
+  /**@brief Drop all the transforms. */
+  void Reset();
+
+  /**@brief Get the stamp of the latest transform. */
+  bool GetLatestStamp(uint64_t* stamp) const;
+
+  /**
+   * @brief Interpolate the transform at a time between the stored ones as
+   *        tf2::TimeCache does.
+   * @param max_age How far before the latest transform, in nanoseconds, the
+   *        time may be.
+   * @return False when the time is out of the stored ones.
+   */
+  bool Interpolate(uint64_t time, uint64_t max_age,
+                   tf2::Transform* transform) const;
+
+ private:
+  struct Slot {
+    std::atomic<uint64_t> stamp;
+    std::atomic<double> values[7];
+  };
+
+  std::unique_ptr<Slot[]> slots_;
+  std::atomic<uint64_t> sequence_;
+  std::atomic<uint64_t> count_;
+};
+
+/**
+ * @class TransformCache
+ * @brief A copy of the transform tree of a tf2::BufferCore which is looked up
+ *        without locks.
+ *
+ * The structure of the tree and its static transforms are kept in immutable
+ * snapshots, in which every frame also holds its transform to the farthest
+ * ancestor linked by static transforms only. Frames whose static chains meet
+ * are then transformed into each other by composing two precomputed
+ * transforms, and the dynamic transforms of the other chains are
+ * interpolated from a ring per frame.
+ *
+ * The cache is written by the transform subscribers and answers the lookups
+ * it is sure of, the others are left to the tf2::BufferCore.
+ */
+class TransformCache {
+ public:
+  explicit TransformCache(uint64_t cache_time);
+
+  /**@brief Add a transform accepted by tf2::BufferCore::setTransform(). */
+  void SetTransform(const geometry_msgs::TransformStamped& transform,
+                    bool is_static);
+
+  /**@brief Drop the dynamic transforms, as tf2::BufferCore::clear(). */
+  void Clear();
+
+  /**
+   * @brief Look up the transform from the source frame to the target frame.
+   * @param time The time of the transform in nanoseconds, 0 for the latest
+   *        time all the transforms of the chain are known at.
+   * @param transform The transform of the source frame in the target frame.
+   * @param stamp The time the transform was looked up at.
+   * @return False when the transform has to be looked up in tf2.
+   */
+  bool LookupTransform(const std::string& target_frame,
+                       const std::string& source_frame, uint64_t time,
+                       tf2::Transform* transform, uint64_t* stamp) const;
+
+ private:
+  enum class FrameType { ROOT, STATIC, DYNAMIC, UNSUPPORTED };
+
+  struct Frame {
+    FrameType type = FrameType::ROOT;
+    std::string parent;
+    // The static transform of the frame in its parent.
+    tf2::Transform transform = tf2::Transform::getIdentity();
+    // The dynamic transforms of the frame in its parent.
+    TransformRing* ring = nullptr;
+    // The farthest ancestor linked by static transforms, and the transform of
+    // the frame in it.
+    std::string static_root;
+    tf2::Transform static_transform = tf2::Transform::getIdentity();
+  };
+  using FrameMap = std::unordered_map<std::string, Frame>;
+
+  static constexpr size_t kMaxDepth = 64;
+
+  static int GetChain(const FrameMap& frames, const std::string& frame_id,
+                      const Frame** chain);
+  bool Evaluate(const Frame* const* chain, int length, uint64_t time,
+                tf2::Transform* transform) const;
+
+  static void UpdateStaticRoots(FrameMap* frames);
+  void Publish(std::unique_ptr<FrameMap> frames);
+
+  const uint64_t cache_time_;
+
+  // The current snapshot, the former ones are kept until destruction since
+  // readers may still hold them. They only change with the structure of the
+  // tree or its static transforms.
+  std::atomic<const FrameMap*> frames_;
+  std::vector<std::unique_ptr<const FrameMap>> snapshots_;
+
+  // The rings by frame and parent, which are kept as well.
+  std::mutex mutex_;
+  std::map<std::pair<std::string, std::string>, std::unique_ptr<TransformRing>>
+      rings_;
+};
+
+}  // namespace transform
+}  // namespace apollo
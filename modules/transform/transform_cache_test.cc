@@ -0,0 +1,130 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/transform/transform_cache.h"
+
+#include <cmath>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "tf2/buffer_core.h"
+
+namespace apollo {
+namespace transform {
+
+constexpr uint64_t kCacheTime = 10000000000UL;
+
+class TransformCacheTest : public ::testing::Test {
+ protected:
+  TransformCacheTest() : core_(kCacheTime), cache_(kCacheTime) {}
+
+  void SetTransform(const std::string& frame_id,
+                    const std::string& child_frame_id, uint64_t stamp,
+                    double x, double yaw, bool is_static) {
+    geometry_msgs::TransformStamped transform;
+    transform.header.stamp = stamp;
+    transform.header.frame_id = frame_id;
+    transform.child_frame_id = child_frame_id;
+    transform.transform.translation.x = x;
+    transform.transform.translation.y = 0.5 * x;
+    transform.transform.translation.z = 1.0;
+    transform.transform.rotation.z = std::sin(yaw / 2.0);
+    transform.transform.rotation.w = std::cos(yaw / 2.0);
+    ASSERT_TRUE(core_.setTransform(transform, "test", is_static));
+    cache_.SetTransform(transform, is_static);
+  }
+
+  // Check the cache against tf2, or that it leaves the lookup to tf2.
+  void ExpectLookup(const std::string& target_frame,
+                    const std::string& source_frame, uint64_t time,
+                    bool cached) {
+    tf2::Transform transform;
+    uint64_t stamp = 0;
+    ASSERT_EQ(cached, cache_.LookupTransform(target_frame, source_frame, time,
+                                             &transform, &stamp));
+    if (!cached) {
+      return;
+    }
+    const auto expected =
+        core_.lookupTransform(target_frame, source_frame, time);
+    const tf2::Quaternion rotation = transform.getRotation();
+    EXPECT_EQ(expected.header.stamp, stamp);
+    EXPECT_NEAR(expected.transform.translation.x, transform.getOrigin().x(),
+                1e-9);
+    EXPECT_NEAR(expected.transform.translation.y, transform.getOrigin().y(),
+                1e-9);
+    EXPECT_NEAR(expected.transform.translation.z, transform.getOrigin().z(),
+                1e-9);
+    // q and -q are the same rotation.
+    const double dot = expected.transform.rotation.x * rotation.x() +
+                       expected.transform.rotation.y * rotation.y() +
+                       expected.transform.rotation.z * rotation.z() +
+                       expected.transform.rotation.w * rotation.w();
+    EXPECT_NEAR(1.0, std::abs(dot), 1e-9);
+  }
+
+  tf2::BufferCore core_;
+  TransformCache cache_;
+};
+
+TEST_F(TransformCacheTest, StaticChains) {
+  SetTransform("novatel", "velodyne64", 0, 1.0, 0.1, true);
+  SetTransform("velodyne64", "front_camera", 0, 0.2, -0.3, true);
+  SetTransform("novatel", "radar", 0, 3.0, 0.0, true);
+
+  ExpectLookup("novatel", "front_camera", 0, true);
+  ExpectLookup("front_camera", "radar", 5, true);
+  ExpectLookup("velodyne64", "novatel", 5, true);
+  ExpectLookup("novatel", "unknown", 0, false);
+}
+
+TEST_F(TransformCacheTest, DynamicChains) {
+  SetTransform("novatel", "velodyne64", 0, 1.0, 0.1, true);
+  SetTransform("world", "localization", 1000, 10.0, 0.0, false);
+  SetTransform("world", "localization", 2000, 20.0, 0.4, false);
+  SetTransform("localization", "novatel", 1000, 0.0, 0.0, true);
+
+  ExpectLookup("world", "velodyne64", 1000, true);
+  ExpectLookup("world", "velodyne64", 1500, true);
+  ExpectLookup("velodyne64", "world", 1999, true);
+  ExpectLookup("world", "velodyne64", 0, true);
+  ExpectLookup("novatel", "velodyne64", 1500, true);
+
+  // Out of the stored transforms.
+  ExpectLookup("world", "velodyne64", 999, false);
+  ExpectLookup("world", "velodyne64", 2001, false);
+
+  // Old transforms are dropped, as in tf2.
+  SetTransform("world", "localization", 1500 + kCacheTime, 30.0, 0.0, false);
+  ExpectLookup("world", "velodyne64", 1500, false);
+  ExpectLookup("world", "velodyne64", 2000, true);
+
+  cache_.Clear();
+  ExpectLookup("world", "velodyne64", 2000, false);
+  ExpectLookup("novatel", "velodyne64", 2000, true);
+}
+
+TEST_F(TransformCacheTest, ParentChange) {
+  SetTransform("world", "localization", 1000, 10.0, 0.0, false);
+  SetTransform("map", "localization", 2000, 20.0, 0.4, false);
+  SetTransform("map", "localization", 3000, 30.0, 0.2, false);
+
+  ExpectLookup("map", "localization", 2500, true);
+  ExpectLookup("world", "localization", 1000, false);
+}
+
+}  // namespace transform
+}  // namespace apollo
@@ -399,9 +399,7 @@ void Object2Pb(const base::Object &object, PerceptionObstacle *obstacle) {
 }
 
 void Object2V2xPb(const base::Object &object, V2XObstacle *obstacle) {
-  PerceptionObstacle perception_obstacle;
-  Object2Pb(object, &perception_obstacle);
-  obstacle->mutable_perception_obstacle()->CopyFrom(perception_obstacle);
+  Object2Pb(object, obstacle->mutable_perception_obstacle());
 }
 
 double Pbs2Objects(const PerceptionObstacles &obstacles,
@@ -419,11 +417,12 @@ double Pbs2Objects(const PerceptionObstacles &obstacles,
       timestamp_object = obstacles.header().lidar_timestamp() / 1.0e9;
     }
   }
+  objects->reserve(obstacles.perception_obstacle_size());
   for (int j = 0; j < obstacles.perception_obstacle_size(); ++j) {
-    base::Object object;
+    objects->emplace_back();
+    base::Object &object = objects->back();
     Pb2Object(obstacles.perception_obstacle(j), &object, frame_id,
               timestamp_object);
-    objects->push_back(object);
     if (timestamp > object.timestamp) {
       timestamp = object.timestamp;
     }
@@ -475,11 +474,12 @@ double V2xPbs2Objects(const V2XObstacles &obstacles,
       timestamp_object = obstacles.header().lidar_timestamp() / 1000000000.0;
     }
   }
+  objects->reserve(obstacles.v2x_obstacle_size());
   for (int j = 0; j < obstacles.v2x_obstacle_size(); ++j) {
-    base::Object object;
+    objects->emplace_back();
+    base::Object &object = objects->back();
     V2xPb2Object(obstacles.v2x_obstacle(j), &object, frame_id,
                  timestamp_object);
-    objects->push_back(object);
     if (timestamp > object.timestamp) {
       timestamp = object.timestamp;
     }
@@ -499,9 +499,7 @@ void Objects2Pbs(const std::vector<base::Object> &objects,
     if (object.v2x_type == base::V2xType::HOST_VEHICLE) {
       continue;
     }
-    PerceptionObstacle obstacle;
-    Object2Pb(object, &obstacle);
-    obstacles->add_perception_obstacle()->CopyFrom(obstacle);
+    Object2Pb(object, obstacles->add_perception_obstacle());
   }
 }
 
@@ -515,9 +513,7 @@ void Objects2V2xPbs(const std::vector<base::Object> &objects,
     if (object.v2x_type == base::V2xType::HOST_VEHICLE) {
       continue;
     }
-    V2XObstacle obstacle;
-    Object2V2xPb(object, &obstacle);
-    obstacles->add_v2x_obstacle()->CopyFrom(obstacle);
+    Object2V2xPb(object, obstacles->add_v2x_obstacle());
   }
 }
 
@@ -17,11 +17,21 @@
 #include "modules/v2x/fusion/libs/fusion/fusion.h"
 
 #include <cmath>
+#include <unordered_map>
 #include <utility>
 
 namespace apollo {
 namespace v2x {
 namespace ft {
+namespace {
+
+struct CellHash {
+  std::size_t operator()(const std::pair<int64_t, int64_t> &cell) const {
+    return std::hash<int64_t>()(cell.first * 73856093 ^ cell.second * 19349663);
+  }
+};
+
+}  // namespace
 
 Fusion::Fusion() {
   ft_config_manager_ptr_ = FTConfigManager::Instance();
@@ -178,20 +188,62 @@ bool Fusion::ComputeAssociateMatrix(
     const std::vector<base::Object> &in1_objects,  // fused
     const std::vector<base::Object> &in2_objects,  // new
     Eigen::MatrixXf *association_mat) {
+  association_mat->setZero();
+  // The distance score, and so the whole score, is zero from the max match
+  // distance on, so only the pairs in neighboring cells of a grid of that
+  // size are scored, instead of all of them.
+  const double cell_size = score_params_.max_match_distance();
+  if (!(cell_size > 0.0)) {
+    return true;
+  }
+  const auto cell_of = [cell_size](const base::Object &object, int64_t *row,
+                                   int64_t *col) {
+    const double x = object.position.x();
+    const double y = object.position.y();
+    if (!std::isfinite(x) || !std::isfinite(y)) {
+      return false;
+    }
+    *row = static_cast<int64_t>(std::floor(x / cell_size));
+    *col = static_cast<int64_t>(std::floor(y / cell_size));
+    return true;
+  };
+  std::unordered_map<std::pair<int64_t, int64_t>, std::vector<unsigned int>,
+                     CellHash>
+      grid;
   for (unsigned int i = 0; i < in1_objects.size(); ++i) {
-    for (unsigned int j = 0; j < in2_objects.size(); ++j) {
-      const base::Object &obj1_ptr = in1_objects[i];
-      const base::Object &obj2_ptr = in2_objects[j];
-      double score = 0;
-      if (!CheckDisScore(obj1_ptr, obj2_ptr, &score)) {
-        AERROR << "V2X Fusion: check dis score failed";
-      }
-      if (score_params_.check_type() &&
-          !CheckTypeScore(obj1_ptr, obj2_ptr, &score)) {
-        AERROR << "V2X Fusion: check type failed";
+    int64_t row = 0;
+    int64_t col = 0;
+    if (cell_of(in1_objects[i], &row, &col)) {
+      grid[std::make_pair(row, col)].push_back(i);
+    }
+  }
+  for (unsigned int j = 0; j < in2_objects.size(); ++j) {
+    int64_t row = 0;
+    int64_t col = 0;
+    if (!cell_of(in2_objects[j], &row, &col)) {
+      continue;
+    }
+    for (int64_t r = row - 1; r <= row + 1; ++r) {
+      for (int64_t c = col - 1; c <= col + 1; ++c) {
+        const auto cell = grid.find(std::make_pair(r, c));
+        if (cell == grid.end()) {
+          continue;
+        }
+        for (const unsigned int i : cell->second) {
+          const base::Object &obj1_ptr = in1_objects[i];
+          const base::Object &obj2_ptr = in2_objects[j];
+          double score = 0;
+          if (!CheckDisScore(obj1_ptr, obj2_ptr, &score)) {
+            AERROR << "V2X Fusion: check dis score failed";
+          }
+          if (score_params_.check_type() &&
+              !CheckTypeScore(obj1_ptr, obj2_ptr, &score)) {
+            AERROR << "V2X Fusion: check type failed";
+          }
+          (*association_mat)(i, j) =
+              (score >= score_params_.min_score()) ? score : 0;
+        }
       }
-      (*association_mat)(i, j) =
-          (score >= score_params_.min_score()) ? score : 0;
     }
   }
   return true;